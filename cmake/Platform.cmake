@@ -13,6 +13,9 @@ function(reactormq_set_defaults)
     option(REACTORMQ_BUILD_SHARED "Build shared library" OFF)
     option(REACTORMQ_BUILD_TESTS "Build tests" ON)
     option(REACTORMQ_BUILD_FUZZERS "Build libFuzzer-based fuzz tests" OFF)
+    option(REACTORMQ_BUILD_BENCHMARKS "Build Google Benchmark microbenchmarks (reactormq_bench)" OFF)
+    option(REACTORMQ_BUILD_TOOLS "Build the reactormq_loadgen load generator" OFF)
+    option(REACTORMQ_TEST_COUNT_ALLOCATIONS "Replace global operator new/delete in tests and benchmarks to count allocations" ON)
     option(REACTORMQ_WITH_THREADS "Enable threading support" ON)
     option(REACTORMQ_WITH_EXCEPTIONS "Enable C++ exceptions" OFF)
     option(REACTORMQ_WITH_RTTI "Enable RTTI (typeid/dynamic_cast)" OFF)
@@ -20,11 +23,22 @@ function(reactormq_set_defaults)
     option(REACTORMQ_WITH_FILE_SINK "Enable built-in file log sink" ON)
     option(REACTORMQ_ENABLE_UE5 "Enable UE5 integration" OFF)
 
+    set(REACTORMQ_LOG_MIN_LEVEL "trace" CACHE STRING "Lowest log level compiled in; calls below it compile to nothing (trace|debug|info|warn|error|critical|off)")
+    set_property(CACHE REACTORMQ_LOG_MIN_LEVEL PROPERTY STRINGS trace debug info warn error critical off)
+    set(REACTORMQ_TRACE_BACKEND "none" CACHE STRING "Profiler that receives scoped trace markers; none compiles them out (none|tracy|unreal|perfetto)")
+    set_property(CACHE REACTORMQ_TRACE_BACKEND PROPERTY STRINGS none tracy unreal perfetto)
+    set(REACTORMQ_MQTT_VERSION "all" CACHE STRING "MQTT version the client speaks; a single one is fixed at compile time (all|3.1.1|5)")
+    set_property(CACHE REACTORMQ_MQTT_VERSION PROPERTY STRINGS all 3.1.1 5)
+
     set(REACTORMQ_SSL_PROVIDER "libressl" CACHE STRING "TLS provider (system|libressl|awslc|none)")
     set_property(CACHE REACTORMQ_SSL_PROVIDER PROPERTY STRINGS system awslc libressl none)
     option(REACTORMQ_OPENSSL_USE_SHARED_LIBS "Use shared OpenSSL libraries" OFF)
 
     option(REACTORMQ_WITH_SOCKET_POLYFILL "Enable BSD socket polyfill header" OFF)
+    option(REACTORMQ_WITH_IO_URING "Use io_uring for socket readiness on Linux (falls back to epoll at runtime)" OFF)
+    option(REACTORMQ_WITH_ZLIB "Use zlib for WebSocket permessage-deflate and the deflate payload codec" OFF)
+    option(REACTORMQ_WITH_QUIC "Build the MQTT over QUIC transport (needs OpenSSL 3.2 or newer and POSIX sockets)" OFF)
+    option(REACTORMQ_FIXED_CAPACITY "Reserve every client's working memory when it is created (FixedCapacityOptions)" OFF)
 
     option(ENABLE_ASAN "Enable AddressSanitizer" OFF)
     option(ENABLE_MSAN "Enable MemorySanitizer" OFF)
@@ -36,6 +50,7 @@ function(reactormq_set_defaults)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_SONY_SOCKET 0)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_IOCTL 1)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_POLL 0)
+    set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_IO_URING 0)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_SELECT 1)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_GETHOSTNAME 1)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_GETADDRINFO 1)
@@ -349,6 +364,7 @@ function(reactormq_target_sockets target)
     get_property(_with_sony GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_SONY_SOCKET)
     get_property(_with_ioctl GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_IOCTL)
     get_property(_with_poll GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_POLL)
+    get_property(_with_io_uring GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_IO_URING)
     get_property(_with_select GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_SELECT)
     get_property(_with_gethostname GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_GETHOSTNAME)
     get_property(_with_getaddrinfo GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_GETADDRINFO)
@@ -387,6 +403,7 @@ function(reactormq_target_sockets target)
             REACTORMQ_SOCKET_WITH_SONY_SOCKET=${_with_sony}
             REACTORMQ_SOCKET_WITH_IOCTL=${_with_ioctl}
             REACTORMQ_SOCKET_WITH_POLL=${_with_poll}
+            REACTORMQ_SOCKET_WITH_IO_URING=${_with_io_uring}
             REACTORMQ_SOCKET_WITH_SELECT=${_with_select}
             REACTORMQ_SOCKET_WITH_GETHOSTNAME=${_with_gethostname}
             REACTORMQ_SOCKET_WITH_GETADDRINFO=${_with_getaddrinfo}
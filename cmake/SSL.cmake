@@ -158,6 +158,9 @@ function(reactormq_configure_ssl)
         if (OpenSSL_FOUND)
             set(REACTORMQ_SSL_AVAILABLE TRUE)
             message(STATUS "Found OpenSSL ${OPENSSL_VERSION}")
+            if (REACTORMQ_WITH_QUIC AND OPENSSL_VERSION VERSION_LESS 3.2)
+                message(FATAL_ERROR "REACTORMQ_WITH_QUIC needs OpenSSL 3.2 or newer for its QUIC client (found ${OPENSSL_VERSION})")
+            endif ()
             if (DEFINED OPENSSL_INCLUDE_DIR)
                 message(STATUS "  Include dir: ${OPENSSL_INCLUDE_DIR}")
             endif ()
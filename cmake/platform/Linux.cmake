@@ -16,4 +16,8 @@ function(reactormq_platform_configure target)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_RECVMMSG 1)
     set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_TIMESTAMP 1)
     set_property(GLOBAL PROPERTY REACTORMQ_PLATFORM_LINUX 1)
+
+    if (REACTORMQ_WITH_IO_URING)
+        set_property(GLOBAL PROPERTY REACTORMQ_SOCKET_WITH_IO_URING 1)
+    endif ()
 endfunction()
@@ -0,0 +1,71 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/inline_function.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Handle that acknowledges one inbound QoS 1/2 message to the broker, for manual acknowledgement mode.
+     *
+     * Copies share one acknowledgement: the first acknowledge() on any of them queues the PUBACK (QoS 1) or PUBCOMP
+     * (QoS 2), and the reactor writes every acknowledgement queued since its last tick in one go. Safe to use from any
+     * thread and to outlive the client; acknowledging after the connection the message arrived on has closed does
+     * nothing, as the broker resends the message on the next connection. A default-constructed token acknowledges
+     * nothing.
+     */
+    class AckToken final
+    {
+    public:
+        AckToken() = default;
+
+        /// @brief Token that runs acknowledge once, on the first acknowledge() of any copy.
+        explicit AckToken(InlineFunction<void()> acknowledge)
+            : m_state(std::make_shared<State>(std::move(acknowledge)))
+        {
+        }
+
+        /**
+         * @brief Acknowledge the message to the broker.
+         * @return True if this call queued the acknowledgement; false if it was already acknowledged or the token is
+         * empty.
+         */
+        bool acknowledge() const
+        {
+            if (!m_state || m_state->isAcknowledged.exchange(true, std::memory_order_acq_rel))
+            {
+                return false;
+            }
+
+            m_state->acknowledge();
+            return true;
+        }
+
+        /// @brief Whether the message still waits for acknowledge(); false for an empty token.
+        [[nodiscard]] bool isPending() const
+        {
+            return m_state && !m_state->isAcknowledged.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct State
+        {
+            explicit State(InlineFunction<void()> function)
+                : acknowledge(std::move(function))
+            {
+            }
+
+            InlineFunction<void()> acknowledge;
+            std::atomic<bool> isAcknowledged{ false };
+        };
+
+        std::shared_ptr<State> m_state;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,29 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Another node of the same broker cluster to fail over to, added with
+     * ConnectionSettingsBuilder::addFailoverEndpoint().
+     *
+     * The endpoint shares every other setting (protocol, path, credentials, TLS) with the primary host and port.
+     */
+    struct BrokerEndpoint
+    {
+        /// Host name or IP address.
+        std::string host;
+
+        /// Port; 0 uses the primary endpoint's port.
+        std::uint16_t port = 0;
+
+        /// Preference among healthy endpoints: a heavier one is picked first. Equal weights keep the list order.
+        std::uint32_t weight = 1;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,50 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Where a client's inbound socket ring takes its storage from. By default it comes from the heap.
+     *
+     * Either option moves the ring onto a process-wide pool of 2 MiB chunks, carved into power-of-two blocks and kept
+     * for reuse when a connection closes. Storage is taken by the reactor thread that reads the socket, so with a
+     * ThreadPlacement that pins reactor threads to cores both options keep the I/O path on local, TLB-friendly memory.
+     * Linux only; elsewhere the ring stays on the heap.
+     */
+    struct BufferMemoryOptions
+    {
+        /**
+         * Back pool chunks with 2 MiB huge pages (MAP_HUGETLB). If none are reserved in vm.nr_hugepages the chunk
+         * is asked to be a transparent huge page instead. A chunk is committed in full, so each pool holds at least
+         * 2 MiB once a connection uses it.
+         */
+        bool hugePages = false;
+
+        /**
+         * Keep one pool per NUMA node and take storage from the node of the CPU the reactor thread is on; the pool's
+         * chunks are bound to that node (mbind, MPOL_PREFERRED).
+         */
+        bool numaLocal = false;
+
+        /// @brief Whether the ring uses the pool rather than the heap.
+        [[nodiscard]] bool isPooled() const
+        {
+            return hugePages || numaLocal;
+        }
+
+        /**
+         * @brief Options for a gateway with many connections on a multi-socket machine.
+         * @return Huge pages on, NUMA-local pools on.
+         */
+        static BufferMemoryOptions server()
+        {
+            BufferMemoryOptions options;
+            options.hugePages = true;
+            options.numaLocal = true;
+            return options;
+        }
+    };
+} // namespace reactormq::mqtt
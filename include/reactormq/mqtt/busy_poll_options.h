@@ -0,0 +1,52 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Busy-poll run mode for a reactor loop: it never sleeps in the kernel, but keeps reading its sockets
+     * without blocking and checking its command queue, backing off with CPU pause instructions and then yields while
+     * nothing arrives. Work is picked up within a poll instead of after a futex or epoll wakeup, at the price of a
+     * core spent spinning. Pair it with SocketOptions::busyPollMicroseconds (SO_BUSY_POLL) on Linux so the socket
+     * reads also poll the device queue, and with a ThreadPlacement that gives the loop a core of its own.
+     */
+    struct BusyPollOptions
+    {
+        /// Spin instead of sleeping between ticks.
+        bool isEnabled = false;
+
+        /// Most pause instructions between two idle polls; the count doubles from 1 with each idle poll up to this.
+        uint32_t maxPauseIterations = 64;
+
+        /// Idle polls in a row after which the loop also yields its time slice between polls; 0 never yields.
+        uint32_t yieldAfterIdlePolls = 1024;
+
+        /**
+         * @brief Options that keep the loop on its core: pause backoff only, never yielding.
+         * @return Busy polling on, no yields.
+         */
+        static BusyPollOptions spin()
+        {
+            BusyPollOptions options;
+            options.isEnabled = true;
+            options.yieldAfterIdlePolls = 0;
+            return options;
+        }
+
+        /**
+         * @brief Options that spin through short gaps and yield through long ones, for a core shared with other work.
+         * @return Busy polling on with the default backoff.
+         */
+        static BusyPollOptions spinThenYield()
+        {
+            BusyPollOptions options;
+            options.isEnabled = true;
+            return options;
+        }
+    };
+} // namespace reactormq::mqtt
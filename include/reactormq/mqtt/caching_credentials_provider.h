@@ -0,0 +1,183 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "reactormq/mqtt/credentials.h"
+#include "reactormq/mqtt/credentials_provider.h"
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Credentials provider for short-lived tokens that are expensive to get, such as OAuth or cloud IAM tokens.
+     *
+     * Fetches run on a worker thread the provider owns, never on the client's reactor thread. While the cached token is
+     * valid a connect gets it immediately; once it is within the refresh window of expiring, the next request still gets
+     * it and starts a refresh in the background, so a steady stream of reconnects never waits on a fetch. Only a connect
+     * with no valid token waits, without blocking the reactor, for the fetch in flight. One provider may be shared by
+     * many clients; concurrent requests share one fetch.
+     */
+    class CachingCredentialsProvider final : public ICredentialsProvider
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief Credentials and how long they stay valid from the moment they were fetched.
+        struct Token
+        {
+            Credentials credentials;
+            Clock::duration lifetime{};
+        };
+
+        /// @brief Gets a fresh token; may block. Called on the provider's worker thread only.
+        using FetchFunction = std::function<Token()>;
+
+        /**
+         * @brief Create a provider and start its worker thread. Nothing is fetched until credentials are first asked for.
+         * @param fetch Gets a fresh token. If it throws, waiting requests get the last token fetched, if any.
+         * @param refreshAhead How long before expiry a request starts a background refresh.
+         */
+        explicit CachingCredentialsProvider(FetchFunction fetch, const Clock::duration refreshAhead = std::chrono::seconds(30))
+            : m_fetch(std::move(fetch))
+            , m_refreshAhead(refreshAhead)
+        {
+            m_worker = std::thread([this] { run(); });
+        }
+
+        CachingCredentialsProvider(const CachingCredentialsProvider&) = delete;
+
+        CachingCredentialsProvider& operator=(const CachingCredentialsProvider&) = delete;
+
+        /// @brief Stop the worker after any fetch in progress; requests still waiting are dropped.
+        ~CachingCredentialsProvider() override
+        {
+            {
+                const std::lock_guard lock(m_mutex);
+                m_isStopping = true;
+            }
+            m_wake.notify_one();
+            m_worker.join();
+        }
+
+        /**
+         * @brief Return the cached credentials, or wait for a fetch if there are none that are valid.
+         * Blocks; the client itself uses getCredentialsAsync().
+         */
+        Credentials getCredentials() override
+        {
+            std::promise<Credentials> promise;
+            auto future = promise.get_future();
+            getCredentialsAsync([&promise](Credentials credentials) { promise.set_value(std::move(credentials)); });
+            return future.get();
+        }
+
+        /**
+         * @brief Deliver the cached credentials inline if valid, otherwise from the worker once the fetch completes.
+         * @param onReady Called with the credentials.
+         */
+        void getCredentialsAsync(CredentialsCallback onReady) override
+        {
+            std::unique_lock lock(m_mutex);
+            const auto now = Clock::now();
+            if (m_hasToken && now < m_expiresAt)
+            {
+                if (now >= m_expiresAt - m_refreshAhead)
+                {
+                    requestFetch();
+                }
+                Credentials credentials = m_token.credentials;
+                lock.unlock();
+                onReady(std::move(credentials));
+                return;
+            }
+
+            m_waiters.push_back(std::move(onReady));
+            requestFetch();
+        }
+
+        /// @brief Drop the cached token, as after the broker rejected it; the next request fetches a new one.
+        void invalidate()
+        {
+            const std::lock_guard lock(m_mutex);
+            m_hasToken = false;
+        }
+
+    private:
+        /// @brief Caller holds m_mutex.
+        void requestFetch()
+        {
+            if (!m_isFetchRequested)
+            {
+                m_isFetchRequested = true;
+                m_wake.notify_one();
+            }
+        }
+
+        void run()
+        {
+            std::unique_lock lock(m_mutex);
+            while (true)
+            {
+                m_wake.wait(lock, [this] { return m_isStopping || m_isFetchRequested; });
+                if (m_isStopping)
+                {
+                    return;
+                }
+
+                lock.unlock();
+                const auto fetchedAt = Clock::now();
+                bool wasFetched = false;
+                Token token;
+                try
+                {
+                    token = m_fetch();
+                    wasFetched = true;
+                }
+                catch (...)
+                {
+                }
+                lock.lock();
+
+                if (wasFetched)
+                {
+                    m_token = std::move(token);
+                    m_expiresAt = fetchedAt + m_token.lifetime;
+                    m_hasToken = true;
+                }
+                m_isFetchRequested = false;
+
+                // The broker rejects stale or empty credentials, which fails the connect instead of leaving it waiting.
+                std::vector<CredentialsCallback> waiters = std::exchange(m_waiters, {});
+                const Credentials credentials = m_token.credentials;
+                lock.unlock();
+                for (CredentialsCallback& waiter : waiters)
+                {
+                    waiter(credentials);
+                }
+                lock.lock();
+            }
+        }
+
+        const FetchFunction m_fetch;
+        const Clock::duration m_refreshAhead;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        Token m_token;
+        Clock::time_point m_expiresAt{};
+        bool m_hasToken = false;
+        bool m_isFetchRequested = false;
+        bool m_isStopping = false;
+        std::vector<CredentialsCallback> m_waiters;
+        std::thread m_worker;
+    };
+} // namespace reactormq::mqtt
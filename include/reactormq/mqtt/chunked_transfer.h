@@ -0,0 +1,51 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/quality_of_service.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Size of the header each chunk of a chunked transfer starts with, ahead of its share of the payload.
+     *
+     * The header travels in the payload rather than in MQTT 5 User Properties, so transfers work on MQTT 3.1.1 too
+     * and survive brokers that rewrite properties. All fields are big-endian:
+     *
+     * | Offset | Size | Field                                                  |
+     * |--------|------|--------------------------------------------------------|
+     * | 0      | 4    | Magic "RMQC"                                           |
+     * | 4      | 1    | Format version, 1                                      |
+     * | 5      | 3    | Reserved, zero                                         |
+     * | 8      | 8    | Transfer ID, random per transfer                       |
+     * | 16     | 4    | Sequence number of the chunk, from 0                   |
+     * | 20     | 4    | Number of chunks in the transfer                       |
+     * | 24     | 8    | Total payload size the chunks add up to                |
+     */
+    inline constexpr size_t kChunkHeaderSize = 32;
+
+    /**
+     * @brief How IPublishableAsync::publishChunked() splits a payload too large for one PUBLISH.
+     *
+     * Each chunk is an ordinary PUBLISH to the transfer's topic, small enough for the broker's Maximum Packet Size, and
+     * at most window of them are unacknowledged at once; the next chunk is read from the source as each one is
+     * acknowledged. Memory on the sending side is therefore about window * chunkSize, whatever the payload size.
+     */
+    struct ChunkedTransferOptions
+    {
+        /// Most payload bytes per chunk, header excluded. Lowered to what the broker's Maximum Packet Size allows.
+        std::uint32_t chunkSize = 64 * 1024;
+
+        /// Most chunks published and not yet acknowledged; at least 1.
+        std::uint32_t window = 8;
+
+        /// Quality of service of every chunk. With AtMostOnce a chunk the broker drops fails the transfer on the
+        /// receiving side, so AtLeastOnce is the usual choice; duplicates are discarded by the receiver.
+        QualityOfService qualityOfService = QualityOfService::AtLeastOnce;
+    };
+} // namespace reactormq::mqtt
@@ -5,14 +5,21 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/client_metrics.h"
 #include "reactormq/mqtt/connectable_async.h"
 #include "reactormq/mqtt/delegates.h"
 #include "reactormq/mqtt/disconnectable_async.h"
+#include "reactormq/mqtt/message.h"
 #include "reactormq/mqtt/publishable_async.h"
+#include "reactormq/mqtt/requestable_async.h"
 #include "reactormq/mqtt/subscribable_async.h"
 #include "reactormq/mqtt/unsubscribable_async.h"
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace reactormq::mqtt
 {
@@ -24,6 +31,7 @@ namespace reactormq::mqtt
         : public IConnectableAsync
         , public IDisconnectableAsync
         , public IPublishableAsync
+        , public IRequestableAsync
         , public ISubscribableAsync
         , public IUnsubscribableAsync
     {
@@ -66,6 +74,13 @@ namespace reactormq::mqtt
          */
         virtual OnMessage& onMessage() = 0;
 
+        /**
+         * @brief Access the zero-copy incoming message event callback.
+         * The view handed to the handler is only valid during the call; see OnMessageView.
+         * @return Reference to the OnMessageView delegate to assign a handler.
+         */
+        virtual OnMessageView& onMessageView() = 0;
+
         /**
          * @brief Check whether the client is currently connected to the broker.
          * @return True if connected, false otherwise.
@@ -84,5 +99,82 @@ namespace reactormq::mqtt
          * Call this periodically from your main loop if not using a background thread.
          */
         virtual void tick() = 0;
+
+        /**
+         * @brief Block until the client has work, then tick once (blocking run mode).
+         * Returns as soon as socket data arrives, a timer (keepalive, retry, timeout) is due, or another thread
+         * issues a command, and otherwise after at most maxWait. Call it in a loop from a dedicated thread to run
+         * the client without spinning a core.
+         * @param maxWait Upper bound on the time spent waiting before the tick.
+         */
+        virtual void waitAndTick(const std::chrono::milliseconds /*maxWait*/)
+        {
+            tick();
+        }
+
+        /**
+         * @brief Number of API calls (publish, subscribe, ...) queued for the reactor but not yet processed.
+         * Intended for monitoring producer backlog; safe to call from any thread.
+         * @return Approximate command queue depth.
+         */
+        [[nodiscard]] virtual size_t getCommandQueueDepth() const
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Received bytes left for a later tick because the inbound budget (getMaxInboundPacketsPerTick(),
+         * getMaxInboundProcessingTimeUs()) ran out. Hosts that tick from a frame loop can watch it to see a flood
+         * draining; safe to call from any thread.
+         * @return Inbound backlog in bytes as of the last tick.
+         */
+        [[nodiscard]] virtual size_t getInboundBacklogBytes() const
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Snapshot of the client's traffic, connection and reactor metrics, for dashboards and capacity
+         * planning. Cheap enough to poll every second; safe to call from any thread. See formatPrometheusMetrics().
+         * @return Current metrics; all zero for implementations that do not collect them.
+         */
+        [[nodiscard]] virtual ClientMetrics getMetrics() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Rolling per-phase cost of the reactor's recent ticks, so a host ticking the client from its game
+         * loop can budget the client's share of the frame and spot spikes. Safe to call from any thread, as often as
+         * once a frame.
+         * @return The profile; empty unless ConnectionSettingsBuilder::setTickProfiling() was enabled.
+         */
+        [[nodiscard]] virtual TickProfile getTickProfile() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Received messages, bytes and drops per subscription, and the busiest topic prefixes, for capacity
+         * planning and for finding the subscriptions that cost the most. Safe to call from any thread.
+         * @return The counts since the client was created; empty unless ConnectionSettingsBuilder::setTrafficAccounting()
+         * was enabled.
+         */
+        [[nodiscard]] virtual InboundTraffic getInboundTraffic() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Latest message received on a topic, for code that polls current values instead of handling every
+         * update. Safe to call from any thread, as often as once a frame; the message stays valid while it is held.
+         * @param topic Exact topic name; wildcards are not matched.
+         * @return The message, or nullptr if none was kept: ConnectionSettingsBuilder::setLastValueCacheSize() was not
+         * set, nothing arrived on the topic yet, or the cache was already full when it first did.
+         */
+        [[nodiscard]] virtual std::shared_ptr<const Message> getLastValue(const std::string_view /*topic*/) const
+        {
+            return nullptr;
+        }
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
@@ -0,0 +1,218 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Awaitable connect: `co_await awaitConnect(*client, true)`.
+     * Like every awaitable here, the coroutine resumes on the reactor thread, or on the CallbackExecutor if one is
+     * set, so no thread waits on a future.
+     */
+    [[nodiscard]] inline auto awaitConnect(IClient& client, const bool cleanSession)
+    {
+        return awaitCompletion<void>([&client, cleanSession](CompletionHandler<void> onComplete)
+                                     { client.connectAsync(cleanSession, std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable disconnect.
+    [[nodiscard]] inline auto awaitDisconnect(IClient& client)
+    {
+        return awaitCompletion<void>([&client](CompletionHandler<void> onComplete) { client.disconnectAsync(std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable disconnect that lets outstanding work drain first.
+    [[nodiscard]] inline auto awaitDisconnect(IClient& client, const DrainOptions& drain)
+    {
+        return awaitCompletion<void>([&client, drain](CompletionHandler<void> onComplete)
+                                     { client.disconnectAsync(drain, std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable publish; resolves once the publish has completed for its QoS.
+    [[nodiscard]] inline auto awaitPublish(IClient& client, Message&& message)
+    {
+        return awaitCompletion<void>([&client, message = std::move(message)](CompletionHandler<void> onComplete) mutable
+                                     { client.publish(std::move(message), std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable request; resolves with the response, or fails once the timeout passes without one.
+    [[nodiscard]] inline auto awaitRequest(
+        IClient& client, std::string topic, std::vector<std::uint8_t> payload, const std::chrono::milliseconds timeout)
+    {
+        return awaitCompletion<Message>(
+            [&client, topic = std::move(topic), payload = std::move(payload), timeout](CompletionHandler<Message> onComplete) mutable
+            { client.requestAsync(std::move(topic), std::move(payload), timeout, std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable subscribe to one filter.
+    [[nodiscard]] inline auto awaitSubscribe(IClient& client, TopicFilter&& topicFilter)
+    {
+        return awaitCompletion<SubscribeResult>(
+            [&client, topicFilter = std::move(topicFilter)](CompletionHandler<SubscribeResult> onComplete) mutable
+            { client.subscribeAsync(std::move(topicFilter), MessageHandler{}, std::move(onComplete)); });
+    }
+
+    /// @brief Awaitable unsubscribe.
+    [[nodiscard]] inline auto awaitUnsubscribe(IClient& client, std::vector<std::string> topicFilters)
+    {
+        return awaitCompletion<std::vector<UnsubscribeResult>>(
+            [&client, topicFilters = std::move(topicFilters)](CompletionHandler<std::vector<UnsubscribeResult>> onComplete)
+            { client.unsubscribeAsync(topicFilters, std::move(onComplete)); });
+    }
+
+    /**
+     * @brief Messages of one subscription, read one at a time from a coroutine.
+     *
+     * @code
+     * auto stream = subscribeStream(*client, TopicFilter("sensors/#"));
+     * while (auto message = co_await stream.next())
+     * {
+     *     handle(*message);
+     * }
+     * @endcode
+     *
+     * Messages that arrive while nobody is waiting are queued. The stream ends (next() yields nullopt) if the
+     * subscription is refused or close() is called; unsubscribing the filter stops new messages but does not close it.
+     */
+    class MessageStream
+    {
+        struct Shared
+        {
+            std::mutex mutex;
+            std::deque<Message> messages;
+            std::coroutine_handle<> waiter;
+            bool closed = false;
+        };
+
+    public:
+        MessageStream()
+            : m_shared(std::make_shared<Shared>())
+        {
+        }
+
+        /// @brief Awaitable for the next message; nullopt once the stream has ended and its queue is drained.
+        class NextAwaitable
+        {
+        public:
+            explicit NextAwaitable(std::shared_ptr<Shared> shared)
+                : m_shared(std::move(shared))
+            {
+            }
+
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(const std::coroutine_handle<> handle)
+            {
+                const std::scoped_lock lock(m_shared->mutex);
+                if (!m_shared->messages.empty() || m_shared->closed)
+                {
+                    return false;
+                }
+                m_shared->waiter = handle;
+                return true;
+            }
+
+            std::optional<Message> await_resume()
+            {
+                const std::scoped_lock lock(m_shared->mutex);
+                if (m_shared->messages.empty())
+                {
+                    return std::nullopt;
+                }
+
+                std::optional<Message> message(std::move(m_shared->messages.front()));
+                m_shared->messages.pop_front();
+                return message;
+            }
+
+        private:
+            std::shared_ptr<Shared> m_shared;
+        };
+
+        /// @brief Wait for the next message; only one coroutine may wait at a time.
+        [[nodiscard]] NextAwaitable next() const
+        {
+            return NextAwaitable(m_shared);
+        }
+
+        /// @brief End the stream, waking a waiting coroutine once the queued messages are read.
+        void close() const
+        {
+            resume(m_shared, [](Shared& shared) { shared.closed = true; });
+        }
+
+        /// @brief Handler to subscribe with; it queues each message and wakes the waiting coroutine.
+        [[nodiscard]] MessageHandler getHandler() const
+        {
+            return [shared = m_shared](const Message& message)
+            { resume(shared, [&message](Shared& state) { state.messages.push_back(message); }); };
+        }
+
+    private:
+        template<typename Update>
+        static void resume(const std::shared_ptr<Shared>& shared, Update update)
+        {
+            std::coroutine_handle<> waiter;
+            {
+                const std::scoped_lock lock(shared->mutex);
+                if (shared->closed)
+                {
+                    return;
+                }
+                update(*shared);
+                waiter = std::exchange(shared->waiter, nullptr);
+            }
+
+            if (waiter)
+            {
+                waiter.resume();
+            }
+        }
+
+        std::shared_ptr<Shared> m_shared;
+    };
+
+    /**
+     * @brief Subscribe to a filter and read its messages from a MessageStream.
+     * @param client Client to subscribe with.
+     * @param topicFilter The topic filter to subscribe to (moved).
+     * @return Stream of the subscription's messages; it ends at once if the broker refuses the subscription.
+     */
+    [[nodiscard]] inline MessageStream subscribeStream(IClient& client, TopicFilter&& topicFilter)
+    {
+        MessageStream stream;
+        client.subscribeAsync(
+            std::move(topicFilter),
+            stream.getHandler(),
+            [stream](const Result<SubscribeResult>& result)
+            {
+                const auto subscribed = result.getResult();
+                if (!result.isSuccess() || !subscribed || !subscribed->wasSuccessful())
+                {
+                    stream.close();
+                }
+            });
+        return stream;
+    }
+} // namespace reactormq::mqtt
@@ -4,10 +4,21 @@
 
 #pragma once
 
+#include "reactormq/mqtt/busy_poll_options.h"
 #include "reactormq/mqtt/client.h"
 #include "reactormq/mqtt/connection_settings.h"
+#include "reactormq/mqtt/consumer_group.h"
+#include "reactormq/mqtt/reactor_group.h"
+#include "reactormq/mqtt/rebalance_options.h"
+#include "reactormq/mqtt/session_store.h"
+#include "reactormq/mqtt/sharded_client.h"
+#include "reactormq/mqtt/thread_placement.h"
+#include "reactormq/mqtt/topic_filter.h"
 
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <string_view>
 
 namespace reactormq::mqtt::client
 {
@@ -17,4 +28,62 @@ namespace reactormq::mqtt::client
      * @return Shared pointer to the client interface.
      */
     std::shared_ptr<IClient> createClient(const ConnectionSettingsPtr& settings);
+
+    /**
+     * @brief Create a group of event-loop threads that multiplexes many clients.
+     * @param threadCount Number of threads; 0 uses one per hardware thread.
+     * @param placement Name, cores and priority of the threads. Thread i is named "<name>-i" and pinned to the i-th
+     * listed core, wrapping around, so a group can be kept on cores the application leaves free for I/O.
+     * @param busyPoll Run mode of the threads: BusyPollOptions::spin() makes each one spin on non-blocking socket
+     * polls and its command queues instead of sleeping, which takes the kernel wakeup out of the latency.
+     * @param rebalance When clients move between the threads; by default a thread that stays busier than the others
+     * hands clients to the least busy one.
+     * @return Shared pointer to the group interface.
+     */
+    std::shared_ptr<IReactorGroup> createReactorGroup(
+        size_t threadCount = 0,
+        const ThreadPlacement& placement = {},
+        const BusyPollOptions& busyPoll = {},
+        const RebalanceOptions& rebalance = {});
+
+    /**
+     * @brief Create a client that spreads publishes over several connections to the broker by topic.
+     * @param settings Connection settings for every connection; the others get derived client IDs.
+     * @param shardCount Number of connections; 0 is treated as 1.
+     * @param group Group whose threads drive the connections; null to drive them with IShardedClient::tick().
+     * @return Shared pointer to the sharded client interface.
+     */
+    std::shared_ptr<IShardedClient> createShardedClient(
+        const ConnectionSettingsPtr& settings,
+        size_t shardCount,
+        const std::shared_ptr<IReactorGroup>& group = nullptr);
+
+    /**
+     * @brief Create a group of connections that consume one shared subscription, so consumption scales with the
+     * number of connections while the broker balances messages across them.
+     * @param settings Connection settings for every connection; the others get derived client IDs. The broker must
+     * support MQTT 5 shared subscriptions.
+     * @param shareName Share name of the subscription, the {group} in $share/{group}/{filter}.
+     * @param topicFilter Filter to share and its subscribe options; No Local is cleared, as shared subscriptions forbid it.
+     * @param consumerCount Number of connections; 0 is treated as 1.
+     * @param group Group whose threads drive the connections; null to drive them with IConsumerGroup::tick().
+     * @param dispatchLanes Threads OnMessage handlers run on; messages on one topic always use the same one.
+     * @return Shared pointer to the consumer group interface.
+     */
+    std::shared_ptr<IConsumerGroup> createConsumerGroup(
+        const ConnectionSettingsPtr& settings,
+        std::string_view shareName,
+        const TopicFilter& topicFilter,
+        size_t consumerCount,
+        const std::shared_ptr<IReactorGroup>& group = nullptr,
+        size_t dispatchLanes = 1);
+
+    /**
+     * @brief Create a session store that keeps QoS 1/2 state in a memory-mapped log file (POSIX only).
+     * Pass it to ConnectionSettingsBuilder::setSessionStore(); a client created with it resumes what the file holds.
+     * @param path Log file path; created if missing.
+     * @param capacityBytes Initial log size; the log grows on its own when the live state needs more.
+     * @return The store, or nullptr if the file cannot be opened and mapped or the platform has no mmap.
+     */
+    SessionStorePtr createMappedSessionStore(const std::string& path, size_t capacityBytes = 1024 * 1024);
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -0,0 +1,316 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Log-linear histogram of durations in microseconds, in the style of HdrHistogram.
+     *
+     * Each power-of-two range is split into kSubBucketCount equal buckets, so any recorded value is known to within
+     * 1/kSubBucketCount (12.5%) of itself from 0 us up to about 71 minutes, in a fixed 240 buckets. Longer values
+     * count in the last bucket.
+     */
+    struct LatencyHistogram
+    {
+        static constexpr size_t kSubBucketBits = 3;
+        static constexpr size_t kSubBucketCount = size_t{ 1 } << kSubBucketBits;
+        static constexpr size_t kValueBits = 32;
+        static constexpr size_t kBucketCount = (kValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+        std::array<std::uint64_t, kBucketCount> counts{};
+        std::uint64_t count = 0; ///< Values recorded.
+        std::uint64_t sumUs = 0; ///< Sum of the values recorded.
+        std::uint64_t maxUs = 0; ///< Largest value recorded.
+
+        /// @brief Bucket a value in microseconds falls into.
+        [[nodiscard]] static constexpr size_t getBucketIndex(const std::uint64_t us)
+        {
+            if (us < kSubBucketCount)
+            {
+                return static_cast<size_t>(us);
+            }
+
+            const auto shift = static_cast<size_t>(std::bit_width(us)) - 1 - kSubBucketBits;
+            const size_t index = (shift + 1) * kSubBucketCount + static_cast<size_t>((us >> shift) - kSubBucketCount);
+            return index < kBucketCount ? index : kBucketCount - 1;
+        }
+
+        /// @brief Largest value, in microseconds, that falls into a bucket.
+        [[nodiscard]] static constexpr std::uint64_t getBucketUpperBound(const size_t index)
+        {
+            if (index < kSubBucketCount)
+            {
+                return index;
+            }
+
+            const size_t shift = index / kSubBucketCount - 1;
+            return ((kSubBucketCount + index % kSubBucketCount + 1) << shift) - 1;
+        }
+
+        /**
+         * @brief Value at or below which @p percentile percent of the recorded values fall, to bucket precision.
+         * @param percentile 0 to 100, e.g. 99.9.
+         * @return Microseconds; 0 when nothing was recorded.
+         */
+        [[nodiscard]] std::uint64_t getValueAtPercentile(const double percentile) const
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            const double clamped = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+            auto target = static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count)));
+            target = target == 0 ? 1 : target;
+
+            std::uint64_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; ++i)
+            {
+                seen += counts[i];
+                if (seen >= target)
+                {
+                    const std::uint64_t bound = getBucketUpperBound(i);
+                    return bound < maxUs ? bound : maxUs;
+                }
+            }
+
+            return maxUs;
+        }
+
+        /// @brief Add another histogram's values to this one.
+        void merge(const LatencyHistogram& other)
+        {
+            for (size_t i = 0; i < kBucketCount; ++i)
+            {
+                counts[i] += other.counts[i];
+            }
+            count += other.count;
+            sumUs += other.sumUs;
+            maxUs = maxUs > other.maxUs ? maxUs : other.maxUs;
+        }
+    };
+
+    /**
+     * @brief Latency of publishes of one QoS, split by where the time went.
+     * queued runs from the publish call to the PUBLISH being handed to the socket, so it covers the command queue,
+     * Receive Maximum holds and offline queueing. acknowledged runs from there to the PUBACK or PUBCOMP, so it covers
+     * the network and the broker; it stays empty for QoS 0. total is the two together, and equals queued for QoS 0.
+     */
+    struct PublishLatency
+    {
+        LatencyHistogram queued;
+        LatencyHistogram acknowledged;
+        LatencyHistogram total;
+    };
+
+    /**
+     * @brief Point-in-time view of a client's reactor, returned by IClient::getMetrics().
+     *
+     * Counters only grow for the life of the client, across reconnects. Gauges are as of the reactor's last tick.
+     * Values are read with relaxed atomics, so fields taken together may be a tick apart.
+     */
+    struct ClientMetrics
+    {
+        /// Buckets of tickDurationsUs: bucket i counts ticks shorter than 2^i microseconds; the last takes the rest.
+        static constexpr size_t kTickDurationBuckets = 16;
+
+        // Gauges.
+        size_t commandQueueDepth = 0; ///< API calls queued for the reactor but not yet processed.
+        size_t inFlightCommands = 0; ///< Publishes, subscribes and unsubscribes awaiting an acknowledgement or held.
+        size_t outboundQueueBytes = 0; ///< Bytes held against getMaxOutboundQueueBytes(): unacknowledged or unwritten.
+        size_t inboundBacklogBytes = 0; ///< Received bytes held back by the inbound budget.
+        size_t pendingDeliveries = 0; ///< Messages handed to handlers that have not finished.
+        size_t offlinePublishes = 0; ///< Publishes queued while disconnected.
+
+        // Counters.
+        std::uint64_t bytesSent = 0; ///< Bytes handed to the transport.
+        std::uint64_t bytesReceived = 0; ///< Bytes of complete MQTT packets received.
+        std::uint64_t packetsSent = 0; ///< MQTT packets handed to the transport.
+        std::uint64_t packetsReceived = 0; ///< Complete MQTT packets received.
+        std::uint64_t messagesPublished = 0; ///< PUBLISH packets sent, retransmissions excluded.
+        std::uint64_t messagesReceived = 0; ///< Incoming messages delivered to handlers.
+        std::uint64_t messagesExpired = 0; ///< Publishes found expired when their turn to be sent came.
+        std::uint64_t messagesDeduplicated = 0; ///< Publishes skipped because they repeated the last payload on their topic.
+        std::uint64_t messagesRateLimited = 0; ///< Publishes rejected or replaced by a newer one under a rate limit.
+        std::uint64_t connectAttempts = 0; ///< Connection attempts started.
+        std::uint64_t connections = 0; ///< Connections that reached the ready state; more than one means reconnects.
+        std::uint64_t disconnects = 0; ///< Ready connections that ended, for any reason.
+        std::uint64_t reauthentications = 0; ///< MQTT 5 re-authentications the broker accepted while connected.
+        std::uint64_t parseFailures = 0; ///< Received packets that could not be decoded or were invalid.
+
+        // Histograms.
+        std::array<std::uint64_t, kTickDurationBuckets> tickDurationsUs{}; ///< Reactor tick durations.
+        std::uint64_t tickDurationSumUs = 0; ///< Total time spent in reactor ticks.
+        std::array<PublishLatency, 3> publishLatency{}; ///< Publish latency, indexed by QoS level.
+
+        /// @brief Add another client's gauges, counters and histograms to these, for totals over several clients.
+        void merge(const ClientMetrics& other)
+        {
+            commandQueueDepth += other.commandQueueDepth;
+            inFlightCommands += other.inFlightCommands;
+            outboundQueueBytes += other.outboundQueueBytes;
+            inboundBacklogBytes += other.inboundBacklogBytes;
+            pendingDeliveries += other.pendingDeliveries;
+            offlinePublishes += other.offlinePublishes;
+
+            bytesSent += other.bytesSent;
+            bytesReceived += other.bytesReceived;
+            packetsSent += other.packetsSent;
+            packetsReceived += other.packetsReceived;
+            messagesPublished += other.messagesPublished;
+            messagesReceived += other.messagesReceived;
+            messagesExpired += other.messagesExpired;
+            messagesDeduplicated += other.messagesDeduplicated;
+            messagesRateLimited += other.messagesRateLimited;
+            connectAttempts += other.connectAttempts;
+            connections += other.connections;
+            disconnects += other.disconnects;
+            reauthentications += other.reauthentications;
+            parseFailures += other.parseFailures;
+
+            for (size_t i = 0; i < kTickDurationBuckets; ++i)
+            {
+                tickDurationsUs[i] += other.tickDurationsUs[i];
+            }
+            tickDurationSumUs += other.tickDurationSumUs;
+
+            for (size_t qos = 0; qos < publishLatency.size(); ++qos)
+            {
+                publishLatency[qos].queued.merge(other.publishLatency[qos].queued);
+                publishLatency[qos].acknowledged.merge(other.publishLatency[qos].acknowledged);
+                publishLatency[qos].total.merge(other.publishLatency[qos].total);
+            }
+        }
+    };
+
+    /**
+     * @brief Parts of a reactor tick timed when tick profiling is on (ConnectionSettingsBuilder::setTickProfiling()).
+     * Phases are exclusive: a message handler run while a packet is handled counts as Dispatch, not Parse or
+     * SocketRead. Total is the whole tick, so it also covers writing the tick's output and committing the session.
+     */
+    enum class TickPhase : std::uint8_t
+    {
+        Commands, ///< Draining the API command queue and completing finished deliveries.
+        StateTick, ///< The connection state's onTick, state transitions and expired timers.
+        SocketRead, ///< Reading and decrypting received bytes and framing them into packets.
+        Parse, ///< Decoding received packets and acting on them: acknowledgements, routing, state changes.
+        Dispatch, ///< Running callbacks and message handlers, or handing them to the executor or dispatch lanes.
+        Total, ///< The whole tick.
+    };
+
+    /// @brief Time spent in one TickPhase per tick, over the ticks in a TickProfile's window.
+    struct TickPhaseStats
+    {
+        std::uint64_t meanNs = 0;
+        std::uint64_t p99Ns = 0;
+        std::uint64_t maxNs = 0;
+    };
+
+    /**
+     * @brief Per-tick cost of the reactor over its last kWindowTicks ticks, returned by IClient::getTickProfile().
+     *
+     * Meant for hosts that tick the client from a frame loop: mean and p99 give the client's share of the frame
+     * budget, and max with slowestTickNs shows what a spike (a message flood, a reconnect) was spent on. Values are
+     * read with relaxed atomics while the reactor may be writing, so the newest tick can be partly recorded.
+     */
+    struct TickProfile
+    {
+        static constexpr size_t kPhaseCount = 6;
+        /// About 17 seconds of ticks at 60 frames per second.
+        static constexpr size_t kWindowTicks = 1024;
+
+        std::uint64_t ticksRecorded = 0; ///< Ticks profiled since the client was created.
+        size_t windowTicks = 0; ///< Ticks the statistics cover: ticksRecorded, up to kWindowTicks.
+        std::array<TickPhaseStats, kPhaseCount> phases{}; ///< Indexed by TickPhase.
+        std::array<std::uint64_t, kPhaseCount> slowestTickNs{}; ///< Phase breakdown of the window's longest tick.
+
+        /// @brief Statistics of one phase.
+        [[nodiscard]] const TickPhaseStats& getPhase(const TickPhase phase) const
+        {
+            return phases[static_cast<size_t>(phase)];
+        }
+    };
+
+    /// @brief Received messages that matched one subscription, in an InboundTraffic report.
+    struct SubscriptionTraffic
+    {
+        std::string filter; ///< Topic filter as subscribed.
+        std::uint64_t messages = 0; ///< Messages routed to the subscription's handler.
+        std::uint64_t bytes = 0; ///< Topic and payload bytes of those messages.
+        std::uint64_t dropped = 0; ///< Of those, messages a newer one replaced before the handler ran (LatestPerTopic).
+    };
+
+    /// @brief One of the busiest topic prefixes, in an InboundTraffic report.
+    struct TopicPrefixTraffic
+    {
+        std::string prefix; ///< Leading topic levels; see TrafficAccountingOptions::prefixLevels.
+        std::uint64_t messages = 0; ///< Messages received on topics under the prefix, overstated by at most overcount.
+        std::uint64_t bytes = 0; ///< Topic and payload bytes received since the prefix last entered the top list.
+        std::uint64_t overcount = 0; ///< Count inherited from the prefix it displaced; messages - overcount is exact or low.
+    };
+
+    /**
+     * @brief Which subscriptions and topic prefixes drive a client's inbound load, returned by
+     * IClient::getInboundTraffic(). Counters only grow for the life of a subscription, across reconnects; an
+     * unsubscribed filter leaves the report.
+     */
+    struct InboundTraffic
+    {
+        std::vector<SubscriptionTraffic> subscriptions; ///< In the order they were subscribed.
+        std::vector<TopicPrefixTraffic> topPrefixes; ///< Busiest first.
+
+        /// @brief Add another client's traffic to this, for totals over several clients; filters and prefixes they
+        /// share are summed.
+        void merge(const InboundTraffic& other)
+        {
+            for (const SubscriptionTraffic& traffic : other.subscriptions)
+            {
+                const auto it = std::ranges::find(subscriptions, traffic.filter, &SubscriptionTraffic::filter);
+                if (it == subscriptions.end())
+                {
+                    subscriptions.push_back(traffic);
+                    continue;
+                }
+                it->messages += traffic.messages;
+                it->bytes += traffic.bytes;
+                it->dropped += traffic.dropped;
+            }
+
+            for (const TopicPrefixTraffic& traffic : other.topPrefixes)
+            {
+                const auto it = std::ranges::find(topPrefixes, traffic.prefix, &TopicPrefixTraffic::prefix);
+                if (it == topPrefixes.end())
+                {
+                    topPrefixes.push_back(traffic);
+                    continue;
+                }
+                it->messages += traffic.messages;
+                it->bytes += traffic.bytes;
+                it->overcount += traffic.overcount;
+            }
+            std::ranges::stable_sort(topPrefixes, std::ranges::greater{}, &TopicPrefixTraffic::messages);
+        }
+    };
+
+    /**
+     * @brief Render metrics in the Prometheus text exposition format.
+     * Every sample carries a client_id label, so the output of several clients can be concatenated.
+     * @param metrics Snapshot to render.
+     * @param clientId Value of the client_id label.
+     * @return Text ready to serve from a /metrics endpoint.
+     */
+    std::string formatPrometheusMetrics(const ClientMetrics& metrics, std::string_view clientId);
+} // namespace reactormq::mqtt
@@ -0,0 +1,77 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/result.h"
+
+#include <coroutine>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Called with the outcome of an asynchronous operation, instead of setting a future.
+     * Runs through the connection's CallbackExecutor when one is set, otherwise on the reactor thread.
+     */
+    template<typename T>
+    using CompletionHandler = std::function<void(const Result<T>&)>;
+
+    /**
+     * @brief Awaitable over any operation that takes a CompletionHandler, for use in C++20 coroutines.
+     *
+     * @code
+     * const auto result = co_await awaitCompletion<void>([&](auto onComplete) { client->connectAsync(true, onComplete); });
+     * @endcode
+     *
+     * The coroutine resumes on whichever thread runs the handler (the executor or the reactor thread). The
+     * operation must complete exactly once.
+     */
+    template<typename T, typename Start>
+    class CompletionAwaitable
+    {
+    public:
+        explicit CompletionAwaitable(Start start)
+            : m_start(std::move(start))
+        {
+        }
+
+        [[nodiscard]] bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            m_start(CompletionHandler<T>(
+                [this, handle](const Result<T>& result)
+                {
+                    m_result.emplace(result);
+                    handle.resume();
+                }));
+        }
+
+        Result<T> await_resume()
+        {
+            return std::move(m_result.value());
+        }
+
+    private:
+        Start m_start;
+        std::optional<Result<T>> m_result;
+    };
+
+    /**
+     * @brief Make a CompletionAwaitable.
+     * @tparam T Result value type of the operation.
+     * @param start Called with the CompletionHandler to pass to the operation.
+     */
+    template<typename T, typename Start>
+    [[nodiscard]] CompletionAwaitable<T, Start> awaitCompletion(Start start)
+    {
+        return CompletionAwaitable<T, Start>(std::move(start));
+    }
+} // namespace reactormq::mqtt
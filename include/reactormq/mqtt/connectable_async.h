@@ -5,6 +5,7 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/completion_handler.h"
 #include "reactormq/mqtt/result.h"
 
 #include <future>
@@ -27,5 +28,12 @@ namespace reactormq::mqtt
          * @return A future that resolves to the result of the connection attempt.
          */
         virtual ConnectFuture connectAsync(bool cleanSession) = 0;
+
+        /**
+         * @brief Connect to the MQTT broker and report the result to a handler instead of a future.
+         * @param cleanSession Whether to start a clean session (true) or attempt to resume (false).
+         * @param onComplete Called with the result of the connection attempt.
+         */
+        virtual void connectAsync(bool cleanSession, CompletionHandler<void> onComplete) = 0;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
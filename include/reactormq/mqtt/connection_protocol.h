@@ -12,7 +12,7 @@ namespace reactormq::mqtt
     /**
      * @brief Supported transport protocols for establishing the MQTT connection.
      *
-     * These are transport options (TCP/TLS/WebSocket), not the MQTT wire version.
+     * These are transport options (TCP/TLS/WebSocket/QUIC/Unix domain socket), not the MQTT wire version.
      */
     enum class ConnectionProtocol : uint8_t
     {
@@ -20,6 +20,8 @@ namespace reactormq::mqtt
         Tls, ///< MQTT over TLS/SSL.
         Ws, ///< MQTT over WebSocket.
         Wss, ///< MQTT over secure WebSocket (TLS).
+        Quic, ///< MQTT over QUIC (TLS 1.3, ALPN "mqtt"); needs a build with REACTORMQ_WITH_QUIC.
+        Unix, ///< MQTT over a Unix domain socket whose path is the host; for a broker on the same machine, POSIX only.
         Unknown = std::numeric_limits<uint8_t>::max(), ///< Sentinel for an unknown or unsupported protocol.
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
@@ -7,11 +7,29 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <vector>
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/broker_endpoint.h"
+#include "reactormq/mqtt/buffer_memory_options.h"
+#include "reactormq/mqtt/busy_poll_options.h"
 #include "reactormq/mqtt/connection_protocol.h"
 #include "reactormq/mqtt/credentials_provider.h"
+#include "reactormq/mqtt/fixed_capacity_options.h"
+#include "reactormq/mqtt/offline_queue_policy.h"
+#include "reactormq/mqtt/packet_tap.h"
+#include "reactormq/mqtt/payload_codec.h"
+#include "reactormq/mqtt/publish_dedup_options.h"
+#include "reactormq/mqtt/publish_rate_limit.h"
+#include "reactormq/mqtt/reconnect_jitter.h"
+#include "reactormq/mqtt/reconnect_throttle.h"
+#include "reactormq/mqtt/session_store.h"
+#include "reactormq/mqtt/socket_options.h"
+#include "reactormq/mqtt/tls_tuning_options.h"
+#include "reactormq/mqtt/traffic_accounting_options.h"
+#include "reactormq/mqtt/websocket_deflate_options.h"
 
 namespace reactormq::mqtt
 {
@@ -62,7 +80,7 @@ namespace reactormq::mqtt
          * @param packetRetryIntervalSeconds Minimum seconds to wait before retrying a packet (default: 5).
          * @param packetRetryBackoffMultiplier Backoff multiplier for packet retry interval (default: 1.5).
          * @param maxPacketRetryIntervalSeconds Maximum seconds to wait before retrying a packet (default: 60).
-         * @param socketConnectionTimeoutSeconds Timeout for socket connection attempts in seconds (default: 30).
+         * @param socketConnectionTimeoutSeconds Timeout for socket connection attempts in seconds, covering DNS, TCP and TLS (default: 30; 0 never gives up).
          * @param keepAliveIntervalSeconds MQTT keep-alive interval in seconds (default: 60).
          * @param mqttConnectionTimeoutSeconds Timeout for MQTT connection handshake in seconds (default: 30).
          * @param initialRetryConnectionIntervalSeconds Initial retry interval for connection attempts in seconds (default: 5).
@@ -83,6 +101,75 @@ namespace reactormq::mqtt
          * @param callbackExecutor Optional executor for marshalling callbacks to another thread (default: nullptr = immediate execution on
          * reactor thread).
          * @param sslVerifyCallback Optional custom SSL/TLS certificate verification callback (default: nullptr = use default verification).
+         * @param outboundCoalesceMaxBytes Outbound bytes gathered per reactor tick before they are written early (default: 64KB; 0
+         * disables coalescing).
+         * @param outboundCoalesceMaxDelayMs Longest time in milliseconds coalesced bytes may wait before being written (default: 1).
+         * @param packetArenaSize Size in bytes of the per-client arena that backs packets decoded during a tick (default: 16KB; 0
+         * allocates each packet on the heap).
+         * @param maxOutboundTopicAliases Most MQTT 5 topic aliases the client assigns to outgoing topics, further capped by the
+         * broker's Topic Alias Maximum (default: 32; 0 always sends the full topic).
+         * @param maxInboundTopicAliases Topic Alias Maximum advertised to an MQTT 5 broker in CONNECT (default: 16; 0 asks the
+         * broker to always send the full topic).
+         * @param maxOfflinePublishes Most publishes queued while the client is not connected, sent once it is (default: 0; 0 fails
+         * such publishes straight away).
+         * @param maxOfflineQueueBytes Most topic and payload bytes held by the offline queue (default: 4MB).
+         * @param offlineQueuePolicy What to drop when the offline queue is full (default: DropOldest).
+         * @param sessionStore Persistent store for QoS 1/2 session state, resumed when the client is created (default: nullptr = state
+         * is kept in memory only).
+         * @param pipelineSubscribesOnConnect Send subscribes made while connecting straight after CONNECT instead of waiting for CONNACK
+         * (default: false).
+         * @param maxInboundProcessingTimeUs Longest time in microseconds spent dispatching inbound packets per tick; frames left over
+         * wait for the next tick (default: 0 = no time limit).
+         * @param maxCommandsPerTick Most queued API commands processed per tick; the rest wait for the next tick (default: 0 = no
+         * limit).
+         * @param maxCommandProcessingTimeUs Longest time in microseconds spent processing queued commands per tick (default: 0 = no
+         * time limit).
+         * @param batchCallbacks Hand every callback produced during one reactor tick to the CallbackExecutor as a single task
+         * (default: false).
+         * @param messageDispatchLanes Worker threads that run OnMessage and subscription handlers, ordered per topic (default: 0 = run
+         * them on the reactor thread or the CallbackExecutor).
+         * @param maxPendingDeliveries Most messages queued on the CallbackExecutor or dispatch lanes before reading from the socket
+         * pauses (default: 0 = unlimited).
+         * @param maxPendingDeliveryBytes Most topic and payload bytes queued on the CallbackExecutor or dispatch lanes before reading
+         * from the socket pauses (default: 0 = unlimited).
+         * @param manualAcknowledgement Hold the PUBACK or PUBCOMP of inbound QoS 1/2 messages until the application calls
+         * Message::acknowledge() (default: false = acknowledge once the handlers have been called).
+         * @param receiveMaximum Receive Maximum advertised to an MQTT 5 broker (default: 0 = leave it out, allowing 65535).
+         * @param tickProfiling Time each reactor tick by phase for IClient::getTickProfile() (default: false).
+         * @param kernelTlsOffload Ask the TLS library to hand record encryption to the kernel (kTLS) after the handshake
+         * where both support it (default: false).
+         * @param dnsCacheTtlSeconds How long a resolved broker address is reused by later connects in the process
+         * (default: 60; 0 = resolve on every connect).
+         * @param socketOptions TCP options applied to the socket before it connects (default: SocketOptions{}).
+         * @param webSocketDeflate permessage-deflate offer for Ws and Wss connections (default: not offered).
+         * @param payloadCodecs MQTT 5 payload codecs and the topics they encode (default: none).
+         * @param maxInternedTopics Most distinct inbound topics whose strings are shared by every Message delivered on them
+         * (default: 0 = each Message owns its topic).
+         * @param memoryResource Memory resource that backs the client's inbound payloads and decoded-packet arena (default:
+         * nullptr = the global heap).
+         * @param inboundStreamingThreshold PUBLISH size above which the payload is passed on as it arrives instead of
+         * buffered whole (default: 0 = off).
+         * @param resubscribeOnReconnect Subscribe again to the active subscriptions when a reconnect finds no session on
+         * the broker (default: true).
+         * @param lastValueCacheSize Most topics whose latest message IClient::getLastValue() keeps (default: 0 = off).
+         * @param failoverEndpoints Other nodes tried when the host cannot be reached (default: none).
+         * @param warmStandby Keep a transport open to the next failover node while connected (default: false).
+         * @param reconnectJitter How reconnect delays are randomised (default: Proportional).
+         * @param reconnectThrottle Rate limit on reconnect attempts, shared by the clients holding it (default: none).
+         * @param busyPoll Spin in IClient::waitAndTick() instead of sleeping (default: off).
+         * @param publishDedup Suppression of publishes that repeat the last payload sent on their topic (default: off).
+         * @param publishRateLimits Token-bucket limits on outbound publishes (default: none).
+         * @param bufferMemory Where the inbound socket ring takes its storage from (default: the heap).
+         * @param deliverQos2OnPublish Deliver inbound QoS 2 messages on PUBLISH instead of on PUBREL (default: false).
+         * @param reauthenticateIntervalMs Interval between MQTT 5 re-authentications while connected (default: 0 = off).
+         * @param fixedCapacity Whether the client reserves its memory when it is created (default: off).
+         * @param packetTap Observer of the raw packets sent and received (default: none).
+         * @param tlsTuning Cipher order and record sizing of TLS connections (default: the TLS library's).
+         * @param encodePublishesOnCallingThread Encode small publishes on the thread that publishes them rather than the
+         * reactor thread (default: false).
+         * @param adaptiveTimeouts Derive the publish retry interval and PINGRESP timeout from the measured round-trip
+         * time (default: false).
+         * @param trafficAccounting Per-subscription and per-topic-prefix inbound counters (default: off).
          */
         ConnectionSettings(
             std::string host,
@@ -114,7 +201,53 @@ namespace reactormq::mqtt
             const uint32_t maxInboundPacketsPerTick = 100,
             const uint32_t maxPendingCommands = 1000,
             CallbackExecutor callbackExecutor = nullptr,
-            SslVerifyCallback sslVerifyCallback = nullptr)
+            SslVerifyCallback sslVerifyCallback = nullptr,
+            const uint32_t outboundCoalesceMaxBytes = 64 * 1024,
+            const uint32_t outboundCoalesceMaxDelayMs = 1,
+            const uint32_t packetArenaSize = 16 * 1024,
+            const uint16_t maxOutboundTopicAliases = 32,
+            const uint16_t maxInboundTopicAliases = 16,
+            const uint32_t maxOfflinePublishes = 0,
+            const uint32_t maxOfflineQueueBytes = 4 * 1024 * 1024,
+            const OfflineQueuePolicy offlineQueuePolicy = OfflineQueuePolicy::DropOldest,
+            SessionStorePtr sessionStore = nullptr,
+            const bool pipelineSubscribesOnConnect = false,
+            const uint32_t maxInboundProcessingTimeUs = 0,
+            const uint32_t maxCommandsPerTick = 0,
+            const uint32_t maxCommandProcessingTimeUs = 0,
+            const bool batchCallbacks = false,
+            const uint32_t messageDispatchLanes = 0,
+            const uint32_t maxPendingDeliveries = 0,
+            const uint32_t maxPendingDeliveryBytes = 0,
+            const bool manualAcknowledgement = false,
+            const uint16_t receiveMaximum = 0,
+            const bool tickProfiling = false,
+            const bool kernelTlsOffload = false,
+            const uint32_t dnsCacheTtlSeconds = 60,
+            const SocketOptions socketOptions = SocketOptions{},
+            const WebSocketDeflateOptions webSocketDeflate = WebSocketDeflateOptions{},
+            std::vector<PayloadCodecBinding> payloadCodecs = {},
+            const uint32_t maxInternedTopics = 0,
+            std::shared_ptr<std::pmr::memory_resource> memoryResource = nullptr,
+            const uint32_t inboundStreamingThreshold = 0,
+            const bool resubscribeOnReconnect = true,
+            const uint32_t lastValueCacheSize = 0,
+            std::vector<BrokerEndpoint> failoverEndpoints = {},
+            const bool warmStandby = false,
+            const ReconnectJitter reconnectJitter = ReconnectJitter::Proportional,
+            ReconnectThrottlePtr reconnectThrottle = nullptr,
+            const BusyPollOptions busyPoll = BusyPollOptions{},
+            const PublishDedupOptions publishDedup = PublishDedupOptions{},
+            std::vector<PublishRateLimit> publishRateLimits = {},
+            const BufferMemoryOptions bufferMemory = BufferMemoryOptions{},
+            const bool deliverQos2OnPublish = false,
+            const uint32_t reauthenticateIntervalMs = 0,
+            const FixedCapacityOptions fixedCapacity = FixedCapacityOptions{},
+            PacketTapPtr packetTap = nullptr,
+            const TlsTuningOptions tlsTuning = TlsTuningOptions{},
+            const bool encodePublishesOnCallingThread = false,
+            const bool adaptiveTimeouts = false,
+            const TrafficAccountingOptions trafficAccounting = TrafficAccountingOptions{})
             : m_host(std::move(host))
             , m_port(port)
             , m_protocol(protocol)
@@ -145,6 +278,52 @@ namespace reactormq::mqtt
             , m_maxPendingCommands(maxPendingCommands)
             , m_callbackExecutor(std::move(callbackExecutor))
             , m_sslVerifyCallback(std::move(sslVerifyCallback))
+            , m_outboundCoalesceMaxBytes(outboundCoalesceMaxBytes)
+            , m_outboundCoalesceMaxDelayMs(outboundCoalesceMaxDelayMs)
+            , m_packetArenaSize(packetArenaSize)
+            , m_maxOutboundTopicAliases(maxOutboundTopicAliases)
+            , m_maxInboundTopicAliases(maxInboundTopicAliases)
+            , m_maxOfflinePublishes(maxOfflinePublishes)
+            , m_maxOfflineQueueBytes(maxOfflineQueueBytes)
+            , m_offlineQueuePolicy(offlineQueuePolicy)
+            , m_sessionStore(std::move(sessionStore))
+            , m_pipelineSubscribesOnConnect(pipelineSubscribesOnConnect)
+            , m_maxInboundProcessingTimeUs(maxInboundProcessingTimeUs)
+            , m_maxCommandsPerTick(maxCommandsPerTick)
+            , m_maxCommandProcessingTimeUs(maxCommandProcessingTimeUs)
+            , m_batchCallbacks(batchCallbacks)
+            , m_messageDispatchLanes(messageDispatchLanes)
+            , m_maxPendingDeliveries(maxPendingDeliveries)
+            , m_maxPendingDeliveryBytes(maxPendingDeliveryBytes)
+            , m_manualAcknowledgement(manualAcknowledgement)
+            , m_receiveMaximum(receiveMaximum)
+            , m_tickProfiling(tickProfiling)
+            , m_kernelTlsOffload(kernelTlsOffload)
+            , m_dnsCacheTtlSeconds(dnsCacheTtlSeconds)
+            , m_socketOptions(socketOptions)
+            , m_webSocketDeflate(webSocketDeflate)
+            , m_payloadCodecs(std::move(payloadCodecs))
+            , m_maxInternedTopics(maxInternedTopics)
+            , m_memoryResource(std::move(memoryResource))
+            , m_inboundStreamingThreshold(inboundStreamingThreshold)
+            , m_resubscribeOnReconnect(resubscribeOnReconnect)
+            , m_lastValueCacheSize(lastValueCacheSize)
+            , m_failoverEndpoints(std::move(failoverEndpoints))
+            , m_warmStandby(warmStandby)
+            , m_reconnectJitter(reconnectJitter)
+            , m_reconnectThrottle(std::move(reconnectThrottle))
+            , m_busyPoll(busyPoll)
+            , m_publishDedup(publishDedup)
+            , m_publishRateLimits(std::move(publishRateLimits))
+            , m_bufferMemory(bufferMemory)
+            , m_deliverQos2OnPublish(deliverQos2OnPublish)
+            , m_reauthenticateIntervalMs(reauthenticateIntervalMs)
+            , m_fixedCapacity(fixedCapacity)
+            , m_packetTap(std::move(packetTap))
+            , m_tlsTuning(tlsTuning)
+            , m_encodePublishesOnCallingThread(encodePublishesOnCallingThread)
+            , m_adaptiveTimeouts(adaptiveTimeouts)
+            , m_trafficAccounting(trafficAccounting)
         {
         }
 
@@ -202,6 +381,20 @@ namespace reactormq::mqtt
             return m_clientId;
         }
 
+        /**
+         * @brief Copy these settings for another session on the same broker.
+         * A session store holds one session's state, so the copy has none; everything else is shared or copied.
+         * @param clientId Client ID of the copy; empty to have one generated.
+         * @return The copy.
+         */
+        [[nodiscard]] ConnectionSettingsPtr withClientId(std::string clientId) const
+        {
+            auto copy = std::make_shared<ConnectionSettings>(*this);
+            copy->m_clientId = std::move(clientId);
+            copy->m_sessionStore = nullptr;
+            return copy;
+        }
+
         /**
          * @brief Get the maximum packet size in bytes.
          * @return The max packet size.
@@ -234,7 +427,8 @@ namespace reactormq::mqtt
         }
 
         /**
-         * @brief Get the minimum packet retry interval in seconds.
+         * @brief Get the minimum packet retry interval in seconds; with shouldAdaptTimeouts(), only until a round-trip
+         * time has been measured.
          * @return The packet retry interval.
          */
         [[nodiscard]] uint16_t getPacketRetryIntervalSeconds() const
@@ -368,6 +562,33 @@ namespace reactormq::mqtt
             return m_autoReconnectMultiplier;
         }
 
+        /**
+         * @brief Get how the delay before each reconnect attempt is randomised.
+         * @return The reconnect jitter mode.
+         */
+        [[nodiscard]] ReconnectJitter getReconnectJitter() const
+        {
+            return m_reconnectJitter;
+        }
+
+        /**
+         * @brief Get the rate limit automatic reconnect attempts wait for.
+         * @return The throttle; null when attempts go as soon as their delay is up.
+         */
+        [[nodiscard]] const ReconnectThrottlePtr& getReconnectThrottle() const
+        {
+            return m_reconnectThrottle;
+        }
+
+        /**
+         * @brief Get how IClient::waitAndTick() waits for work.
+         * @return Busy-poll options; disabled when the client sleeps until woken.
+         */
+        [[nodiscard]] const BusyPollOptions& getBusyPoll() const
+        {
+            return m_busyPoll;
+        }
+
         /**
          * @brief Check if strict error handling mode is enabled.
          * In strict mode, protocol violations cause immediate disconnect.
@@ -390,7 +611,10 @@ namespace reactormq::mqtt
 
         /**
          * @brief Get the maximum number of inbound packets to process per tick.
-         * @return The max inbound packets per tick.
+         * While a subscription has a delivery priority (TopicFilter::getDeliveryPriority()), every complete packet is
+         * read each tick and the limit counts delivered messages instead: higher-priority messages go first, and the
+         * rest wait, unacknowledged, for later ticks. Reading pauses once 64 ticks' worth of messages are waiting.
+         * @return The max inbound packets per tick; 0 means no limit.
          */
         [[nodiscard]] uint32_t getMaxInboundPacketsPerTick() const
         {
@@ -427,6 +651,420 @@ namespace reactormq::mqtt
             return m_sslVerifyCallback;
         }
 
+        /**
+         * @brief Get the outbound coalescing cap in bytes.
+         * Packets produced during one reactor tick are gathered and written together at the end of the tick; once this
+         * many bytes are waiting they are written immediately. 0 disables coalescing.
+         * @return The coalescing cap in bytes.
+         */
+        [[nodiscard]] uint32_t getOutboundCoalesceMaxBytes() const
+        {
+            return m_outboundCoalesceMaxBytes;
+        }
+
+        /**
+         * @brief Get the longest time coalesced outbound bytes may wait before being written.
+         * @return The coalescing delay cap in milliseconds.
+         */
+        [[nodiscard]] uint32_t getOutboundCoalesceMaxDelayMs() const
+        {
+            return m_outboundCoalesceMaxDelayMs;
+        }
+
+        /**
+         * @brief Get the size of the tick-scoped arena that backs decoded inbound packets.
+         * Packet objects decoded during a reactor tick are bump-allocated from this block and reclaimed together at
+         * the end of the tick. 0 allocates each packet on the heap.
+         * @return The arena size in bytes.
+         */
+        [[nodiscard]] uint32_t getPacketArenaSize() const
+        {
+            return m_packetArenaSize;
+        }
+
+        /**
+         * @brief Get the most MQTT 5 topic aliases the client assigns to outgoing PUBLISH topics.
+         * The broker's Topic Alias Maximum from CONNACK caps this further. 0 always sends the full topic.
+         * @return The maximum number of outbound topic aliases.
+         */
+        [[nodiscard]] uint16_t getMaxOutboundTopicAliases() const
+        {
+            return m_maxOutboundTopicAliases;
+        }
+
+        /**
+         * @brief Get the Topic Alias Maximum advertised to an MQTT 5 broker, i.e. how many aliases it may use for
+         * PUBLISH packets sent to this client. 0 asks the broker to always send the full topic.
+         * @return The maximum number of inbound topic aliases.
+         */
+        [[nodiscard]] uint16_t getMaxInboundTopicAliases() const
+        {
+            return m_maxInboundTopicAliases;
+        }
+
+        /**
+         * @brief Get the most publishes queued while the client is not connected. They are sent, oldest first, once the
+         * client is ready again. 0 fails publishes made while not connected.
+         * @return The maximum number of offline publishes.
+         */
+        [[nodiscard]] uint32_t getMaxOfflinePublishes() const
+        {
+            return m_maxOfflinePublishes;
+        }
+
+        /**
+         * @brief Get the most topic and payload bytes the offline queue may hold.
+         * @return The offline queue byte limit.
+         */
+        [[nodiscard]] uint32_t getMaxOfflineQueueBytes() const
+        {
+            return m_maxOfflineQueueBytes;
+        }
+
+        /**
+         * @brief Get what is dropped when a publish arrives while the offline queue is full.
+         * @return The offline queue policy.
+         */
+        [[nodiscard]] OfflineQueuePolicy getOfflineQueuePolicy() const
+        {
+            return m_offlineQueuePolicy;
+        }
+
+        /**
+         * @brief Get the store that persists QoS 1/2 session state across restarts.
+         * @return The session store, or nullptr if session state is kept in memory only.
+         */
+        [[nodiscard]] const SessionStorePtr& getSessionStore() const
+        {
+            return m_sessionStore;
+        }
+
+        /**
+         * @brief Whether subscribes made while connecting are sent straight after CONNECT.
+         * @return True if SUBSCRIBE is pipelined behind CONNECT.
+         */
+        [[nodiscard]] bool shouldPipelineSubscribesOnConnect() const
+        {
+            return m_pipelineSubscribesOnConnect;
+        }
+
+        /**
+         * @brief Get the longest time spent dispatching inbound packets per tick.
+         * Works alongside getMaxInboundPacketsPerTick(): whichever limit is reached first ends the tick's dispatch.
+         * @return The time budget in microseconds; 0 means no time limit.
+         */
+        [[nodiscard]] uint32_t getMaxInboundProcessingTimeUs() const
+        {
+            return m_maxInboundProcessingTimeUs;
+        }
+
+        /**
+         * @brief Get the most queued API commands (publish, subscribe, ...) processed per tick.
+         * @return The per-tick command budget; 0 means no limit.
+         */
+        [[nodiscard]] uint32_t getMaxCommandsPerTick() const
+        {
+            return m_maxCommandsPerTick;
+        }
+
+        /**
+         * @brief Get the longest time spent processing queued API commands per tick.
+         * @return The time budget in microseconds; 0 means no time limit.
+         */
+        [[nodiscard]] uint32_t getMaxCommandProcessingTimeUs() const
+        {
+            return m_maxCommandProcessingTimeUs;
+        }
+
+        /**
+         * @brief Whether callbacks are handed to the CallbackExecutor once per reactor tick rather than one by one.
+         * @return True if a tick's callbacks are batched into one executor task.
+         */
+        [[nodiscard]] bool shouldBatchCallbacks() const
+        {
+            return m_batchCallbacks;
+        }
+
+        /**
+         * @brief Get the number of worker lanes that run OnMessage and subscription handlers.
+         * @return Lane count; 0 runs them on the reactor thread or the CallbackExecutor.
+         */
+        [[nodiscard]] uint32_t getMessageDispatchLanes() const
+        {
+            return m_messageDispatchLanes;
+        }
+
+        /**
+         * @brief Get the number of messages that may wait for their handlers before the client stops reading.
+         * @return Message count; 0 means unlimited.
+         */
+        [[nodiscard]] uint32_t getMaxPendingDeliveries() const
+        {
+            return m_maxPendingDeliveries;
+        }
+
+        /**
+         * @brief Get the topic and payload bytes that may wait for their handlers before the client stops reading.
+         * @return Byte count; 0 means unlimited.
+         */
+        [[nodiscard]] uint32_t getMaxPendingDeliveryBytes() const
+        {
+            return m_maxPendingDeliveryBytes;
+        }
+
+        /**
+         * @brief Check whether inbound QoS 1/2 messages wait for the application to acknowledge them.
+         * @return True if acknowledgements are manual.
+         */
+        [[nodiscard]] bool shouldAcknowledgeManually() const
+        {
+            return m_manualAcknowledgement;
+        }
+
+        /**
+         * @brief Get the Receive Maximum advertised to an MQTT 5 broker.
+         * @return Most unacknowledged QoS 1/2 messages the broker may send; 0 leaves the property out.
+         */
+        [[nodiscard]] uint16_t getReceiveMaximum() const
+        {
+            return m_receiveMaximum;
+        }
+
+        /**
+         * @brief Check whether the reactor times each tick by phase for IClient::getTickProfile().
+         * @return True if tick profiling is enabled.
+         */
+        [[nodiscard]] bool shouldProfileTicks() const
+        {
+            return m_tickProfiling;
+        }
+
+        /**
+         * @brief Check whether TLS record encryption should be offloaded to the kernel (kTLS) where supported.
+         * @return True if kernel TLS offload was requested.
+         */
+        [[nodiscard]] bool shouldOffloadTlsToKernel() const
+        {
+            return m_kernelTlsOffload;
+        }
+
+        /**
+         * @brief Get the cipher order and record sizing of TLS connections.
+         * @return TLS tuning options.
+         */
+        [[nodiscard]] const TlsTuningOptions& getTlsTuning() const
+        {
+            return m_tlsTuning;
+        }
+
+        /**
+         * @brief Get how long a resolved broker address may be reused without asking the resolver again.
+         * @return Cache lifetime in seconds; 0 means every connect resolves the host.
+         */
+        [[nodiscard]] uint32_t getDnsCacheTtlSeconds() const
+        {
+            return m_dnsCacheTtlSeconds;
+        }
+
+        /**
+         * @brief Get the TCP options applied to the socket before it connects.
+         * @return Socket options.
+         */
+        [[nodiscard]] const SocketOptions& getSocketOptions() const
+        {
+            return m_socketOptions;
+        }
+
+        /**
+         * @brief Get the permessage-deflate offer made by Ws and Wss connections.
+         * @return WebSocket deflate options.
+         */
+        [[nodiscard]] const WebSocketDeflateOptions& getWebSocketDeflate() const
+        {
+            return m_webSocketDeflate;
+        }
+
+        /**
+         * @brief Get the MQTT 5 payload codecs, in the order their topic filters are tried.
+         * @return Codec bindings; empty when payloads are sent as they are.
+         */
+        [[nodiscard]] const std::vector<PayloadCodecBinding>& getPayloadCodecs() const
+        {
+            return m_payloadCodecs;
+        }
+
+        /**
+         * @brief Get the number of distinct inbound topics interned, so their messages share one topic string.
+         * @return Topic count; 0 means every Message owns its topic.
+         */
+        [[nodiscard]] uint32_t getMaxInternedTopics() const
+        {
+            return m_maxInternedTopics;
+        }
+
+        /**
+         * @brief Get the memory resource the client allocates inbound payloads and its decoded-packet arena from.
+         * @return The resource; std::pmr::new_delete_resource() when none was set.
+         */
+        [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const
+        {
+            return m_memoryResource ? m_memoryResource.get() : std::pmr::new_delete_resource();
+        }
+
+        /**
+         * @brief Get the PUBLISH size, in bytes, above which the socket passes the packet on in pieces as it arrives.
+         * The payload of such a message goes to the IPayloadSink of the subscription it matches. Without one, it is
+         * gathered and delivered as usual if it fits getMaxBufferSize(), and dropped otherwise.
+         * @return The threshold; 0 when every packet is buffered whole.
+         */
+        [[nodiscard]] uint32_t getInboundStreamingThreshold() const
+        {
+            return m_inboundStreamingThreshold;
+        }
+
+        /**
+         * @brief Whether a reconnect that finds no session on the broker subscribes again to the active subscriptions.
+         * Skipped when CONNACK reports a session present, since the broker kept them.
+         * @return True if the client resubscribes on its own.
+         */
+        [[nodiscard]] bool shouldResubscribeOnReconnect() const
+        {
+            return m_resubscribeOnReconnect;
+        }
+
+        /**
+         * @brief Get the most topics whose latest message the client keeps for IClient::getLastValue().
+         * @return Number of topics; 0 when no message is kept.
+         */
+        [[nodiscard]] uint32_t getLastValueCacheSize() const
+        {
+            return m_lastValueCacheSize;
+        }
+
+        /**
+         * @brief Get how publishes that repeat the last payload sent on their topic are suppressed.
+         * @return Dedup options; disabled when every publish is sent.
+         */
+        [[nodiscard]] const PublishDedupOptions& getPublishDedup() const
+        {
+            return m_publishDedup;
+        }
+
+        /**
+         * @brief Get the limits on outbound publish rates.
+         * @return Limits, per topic prefix or client-wide; empty when publishes go out as fast as they are made.
+         */
+        [[nodiscard]] const std::vector<PublishRateLimit>& getPublishRateLimits() const
+        {
+            return m_publishRateLimits;
+        }
+
+        /**
+         * @brief Get where the inbound socket ring takes its storage from.
+         * @return Buffer memory options; not pooled when the ring uses the heap.
+         */
+        [[nodiscard]] const BufferMemoryOptions& getBufferMemory() const
+        {
+            return m_bufferMemory;
+        }
+
+        /**
+         * @brief Check whether inbound QoS 2 messages are delivered as soon as their PUBLISH arrives.
+         * @return True if they are delivered on PUBLISH and only their packet ID is kept until PUBREL; false if the
+         * message is kept and delivered on PUBREL.
+         */
+        [[nodiscard]] bool shouldDeliverQos2OnPublish() const
+        {
+            return m_deliverQos2OnPublish;
+        }
+
+        /**
+         * @brief Get the interval between MQTT 5 re-authentications (AUTH with reason code 0x19) while connected.
+         * Only used with a credentials provider that has an authentication method.
+         * @return Interval in milliseconds; 0 if the client never re-authenticates.
+         */
+        [[nodiscard]] uint32_t getReauthenticateIntervalMs() const
+        {
+            return m_reauthenticateIntervalMs;
+        }
+
+        /**
+         * @brief Get whether the client reserves its working memory when it is created, and how much.
+         * @return Fixed capacity options; isEnabled is false when memory grows on demand.
+         */
+        [[nodiscard]] const FixedCapacityOptions& getFixedCapacity() const
+        {
+            return m_fixedCapacity;
+        }
+
+        /**
+         * @brief Get the observer of the raw packets the client sends and receives.
+         * @return The tap; null when packets are not tapped.
+         */
+        [[nodiscard]] const PacketTapPtr& getPacketTap() const
+        {
+            return m_packetTap;
+        }
+
+        /**
+         * @brief Check whether small publishes are encoded on the thread that publishes them.
+         * @return True if the reactor thread only patches in packet identifiers and appends the packets.
+         */
+        [[nodiscard]] bool shouldEncodePublishesOnCallingThread() const
+        {
+            return m_encodePublishesOnCallingThread;
+        }
+
+        /**
+         * @brief Check whether timeouts follow the measured round-trip time.
+         * @return True if the publish retry interval and the PINGRESP timeout are derived from a smoothed round-trip
+         * time once one has been measured; false if they are the fixed ones.
+         */
+        [[nodiscard]] bool shouldAdaptTimeouts() const
+        {
+            return m_adaptiveTimeouts;
+        }
+
+        /**
+         * @brief Get the inbound traffic accounting options.
+         * @return Whether received messages are counted per subscription, and how many topic prefixes are tracked.
+         */
+        [[nodiscard]] const TrafficAccountingOptions& getTrafficAccounting() const
+        {
+            return m_trafficAccounting;
+        }
+
+        /**
+         * @brief Get the nodes tried after getHost() and getPort(), in order of preference.
+         * @return Endpoints; empty when the client only ever connects to the host.
+         */
+        [[nodiscard]] const std::vector<BrokerEndpoint>& getFailoverEndpoints() const
+        {
+            return m_failoverEndpoints;
+        }
+
+        /**
+         * @brief Check whether a standby transport to a failover node is kept open while connected.
+         * @return True if a dropped connection can be replaced without a cold connect.
+         */
+        [[nodiscard]] bool isWarmStandbyEnabled() const
+        {
+            return m_warmStandby;
+        }
+
+        /**
+         * @brief Copy these settings to connect to another node; everything but the host and port is shared or copied.
+         * @param endpoint Node to connect to; a port of 0 keeps getPort().
+         * @return The copy.
+         */
+        [[nodiscard]] ConnectionSettingsPtr withEndpoint(const BrokerEndpoint& endpoint) const
+        {
+            auto copy = std::make_shared<ConnectionSettings>(*this);
+            copy->m_host = endpoint.host;
+            copy->m_port = endpoint.port != 0 ? endpoint.port : m_port;
+            return copy;
+        }
+
     private:
         std::string m_host;
         uint16_t m_port;
@@ -458,5 +1096,51 @@ namespace reactormq::mqtt
         uint32_t m_maxPendingCommands;
         CallbackExecutor m_callbackExecutor;
         SslVerifyCallback m_sslVerifyCallback;
+        uint32_t m_outboundCoalesceMaxBytes;
+        uint32_t m_outboundCoalesceMaxDelayMs;
+        uint32_t m_packetArenaSize;
+        uint16_t m_maxOutboundTopicAliases;
+        uint16_t m_maxInboundTopicAliases;
+        uint32_t m_maxOfflinePublishes;
+        uint32_t m_maxOfflineQueueBytes;
+        OfflineQueuePolicy m_offlineQueuePolicy;
+        SessionStorePtr m_sessionStore;
+        bool m_pipelineSubscribesOnConnect;
+        uint32_t m_maxInboundProcessingTimeUs;
+        uint32_t m_maxCommandsPerTick;
+        uint32_t m_maxCommandProcessingTimeUs;
+        bool m_batchCallbacks;
+        uint32_t m_messageDispatchLanes;
+        uint32_t m_maxPendingDeliveries;
+        uint32_t m_maxPendingDeliveryBytes;
+        bool m_manualAcknowledgement;
+        uint16_t m_receiveMaximum;
+        bool m_tickProfiling;
+        bool m_kernelTlsOffload;
+        uint32_t m_dnsCacheTtlSeconds;
+        SocketOptions m_socketOptions;
+        WebSocketDeflateOptions m_webSocketDeflate;
+        std::vector<PayloadCodecBinding> m_payloadCodecs;
+        uint32_t m_maxInternedTopics;
+        std::shared_ptr<std::pmr::memory_resource> m_memoryResource;
+        uint32_t m_inboundStreamingThreshold;
+        bool m_resubscribeOnReconnect;
+        uint32_t m_lastValueCacheSize;
+        std::vector<BrokerEndpoint> m_failoverEndpoints;
+        bool m_warmStandby;
+        ReconnectJitter m_reconnectJitter;
+        ReconnectThrottlePtr m_reconnectThrottle;
+        BusyPollOptions m_busyPoll;
+        PublishDedupOptions m_publishDedup;
+        std::vector<PublishRateLimit> m_publishRateLimits;
+        BufferMemoryOptions m_bufferMemory;
+        bool m_deliverQos2OnPublish;
+        uint32_t m_reauthenticateIntervalMs;
+        FixedCapacityOptions m_fixedCapacity;
+        PacketTapPtr m_packetTap;
+        TlsTuningOptions m_tlsTuning;
+        bool m_encodePublishesOnCallingThread;
+        bool m_adaptiveTimeouts;
+        TrafficAccountingOptions m_trafficAccounting;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
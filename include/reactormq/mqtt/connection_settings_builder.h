@@ -5,12 +5,19 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <string>
 
 #include "reactormq/export.h"
 #include "reactormq/mqtt/connection_protocol.h"
 #include "reactormq/mqtt/connection_settings.h"
 #include "reactormq/mqtt/credentials_provider.h"
+#include "reactormq/mqtt/payload_codec.h"
+#include "reactormq/mqtt/performance_profile.h"
+#include "reactormq/mqtt/socket_options.h"
+#include "reactormq/mqtt/tls_tuning_options.h"
+#include "reactormq/mqtt/traffic_accounting_options.h"
+#include "reactormq/mqtt/websocket_deflate_options.h"
 
 namespace reactormq::mqtt
 {
@@ -33,9 +40,19 @@ namespace reactormq::mqtt
         {
         }
 
+        /**
+         * @brief Set the tuning knobs of a workload together; see PerformanceProfile for what each profile sets.
+         * Call it before the individual setters, which then override single knobs of the profile. Every profile sets
+         * the same knobs, so applying a second profile replaces the first entirely. The host, port, protocol, client
+         * id, timeouts and everything else a profile does not cover are left as they are.
+         * @param profile Profile to apply; PerformanceProfile::Default puts its knobs back to their defaults.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& applyProfile(PerformanceProfile profile);
+
         /**
          * @brief Set the host name or IP address.
-         * @param host The host name or IP address.
+         * @param host The host name or IP address; for ConnectionProtocol::Unix, the path of the broker's socket.
          * @return Reference to this builder for chaining.
          */
         ConnectionSettingsBuilder& setHost(std::string host)
@@ -57,7 +74,7 @@ namespace reactormq::mqtt
 
         /**
          * @brief Set the transport protocol.
-         * @param protocol The transport: Tcp, Tls, Ws, or Wss.
+         * @param protocol The transport: Tcp, Tls, Ws, Wss, Quic, or Unix.
          * @return Reference to this builder for chaining.
          */
         ConnectionSettingsBuilder& setProtocol(const ConnectionProtocol protocol)
@@ -167,6 +184,7 @@ namespace reactormq::mqtt
 
         /**
          * @brief Set the socket connection timeout in seconds.
+         * A connect that has not finished DNS, TCP and TLS by then is reported as failed; 0 never gives up.
          * @param seconds The socket connection timeout.
          * @return Reference to this builder for chaining.
          */
@@ -297,6 +315,44 @@ namespace reactormq::mqtt
             return *this;
         }
 
+        /**
+         * @brief Set how the delay before each reconnect attempt is randomised.
+         * ReconnectJitter::Decorrelated spreads clients that dropped together over the whole delay range, so a fleet
+         * does not come back in synchronised waves after a broker restart.
+         * @param jitter The reconnect jitter mode.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setAutoReconnectJitter(const ReconnectJitter jitter)
+        {
+            m_reconnectJitter = jitter;
+            return *this;
+        }
+
+        /**
+         * @brief Limit the rate of automatic reconnect attempts; give every client of a fleet the same instance to
+         * share one budget across the process. An attempt whose delay is up waits for the next free slot.
+         * @param throttle Shared throttle; nullptr for none.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setReconnectThrottle(ReconnectThrottlePtr throttle)
+        {
+            m_reconnectThrottle = std::move(throttle);
+            return *this;
+        }
+
+        /**
+         * @brief Make IClient::waitAndTick() spin on non-blocking socket reads and the command queue instead of
+         * sleeping, for the lowest wakeup latency at the cost of a busy core. Clients in a reactor group follow the
+         * group's mode instead; see createReactorGroup().
+         * @param options Busy-poll options; BusyPollOptions::spin() or BusyPollOptions::spinThenYield() to enable.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setBusyPoll(const BusyPollOptions& options)
+        {
+            m_busyPoll = options;
+            return *this;
+        }
+
         /**
          * @brief Set strict error handling mode.
          * In strict mode, protocol violations cause immediate disconnect.
@@ -323,7 +379,8 @@ namespace reactormq::mqtt
 
         /**
          * @brief Set the maximum number of inbound packets to process per tick.
-         * @param maxPackets The max inbound packets per tick.
+         * Frames beyond it stay buffered for the next tick, and the socket reads nothing new until they are handled.
+         * @param maxPackets The max inbound packets per tick; 0 means no limit.
          * @return Reference to this builder for chaining.
          */
         ConnectionSettingsBuilder& setMaxInboundPacketsPerTick(const uint32_t maxPackets)
@@ -382,6 +439,8 @@ namespace reactormq::mqtt
          * - Rejects self-signed certificates
          * - Accepts intermediate certificates despite verification failures
          * - Logs all verification attempts
+         * A reconnect that presents a leaf certificate the callback accepted within the last few minutes, while the
+         * certificate is still valid, is accepted without building the chain or calling the callback again.
          * @param callback Custom verification callback function, or nullptr for default behavior.
          * @return Reference to this builder for chaining.
          */
@@ -391,6 +450,588 @@ namespace reactormq::mqtt
             return *this;
         }
 
+        /**
+         * @brief Set the outbound coalescing cap.
+         * Packets produced during one reactor tick are written together at the end of the tick, or as soon as this
+         * many bytes are waiting.
+         * @param maxBytes The coalescing cap in bytes; 0 writes every packet immediately.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setOutboundCoalesceMaxBytes(const uint32_t maxBytes)
+        {
+            m_outboundCoalesceMaxBytes = maxBytes;
+            return *this;
+        }
+
+        /**
+         * @brief Set the longest time coalesced outbound bytes may wait before being written.
+         * @param delayMs The coalescing delay cap in milliseconds.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setOutboundCoalesceMaxDelayMs(const uint32_t delayMs)
+        {
+            m_outboundCoalesceMaxDelayMs = delayMs;
+            return *this;
+        }
+
+        /**
+         * @brief Set the size of the tick-scoped arena that backs decoded inbound packets.
+         * @param bytes Arena size in bytes; 0 allocates each packet on the heap.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setPacketArenaSize(const uint32_t bytes)
+        {
+            m_packetArenaSize = bytes;
+            return *this;
+        }
+
+        /**
+         * @brief Set the most MQTT 5 topic aliases the client assigns to outgoing PUBLISH topics.
+         * @param maxAliases Maximum number of aliases, capped by the broker's Topic Alias Maximum; 0 disables aliasing.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxOutboundTopicAliases(const uint16_t maxAliases)
+        {
+            m_maxOutboundTopicAliases = maxAliases;
+            return *this;
+        }
+
+        /**
+         * @brief Set the Topic Alias Maximum advertised to an MQTT 5 broker for PUBLISH packets sent to this client.
+         * @param maxAliases Maximum number of aliases the broker may use; 0 asks it to always send the full topic.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxInboundTopicAliases(const uint16_t maxAliases)
+        {
+            m_maxInboundTopicAliases = maxAliases;
+            return *this;
+        }
+
+        /**
+         * @brief Set the most publishes queued while the client is not connected.
+         * @param maxPublishes Maximum number of queued publishes; 0 fails publishes made while not connected.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxOfflinePublishes(const uint32_t maxPublishes)
+        {
+            m_maxOfflinePublishes = maxPublishes;
+            return *this;
+        }
+
+        /**
+         * @brief Set the most topic and payload bytes the offline queue may hold.
+         * @param maxBytes Byte limit of the offline queue.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxOfflineQueueBytes(const uint32_t maxBytes)
+        {
+            m_maxOfflineQueueBytes = maxBytes;
+            return *this;
+        }
+
+        /**
+         * @brief Set what is dropped when a publish arrives while the offline queue is full.
+         * @param policy Offline queue policy.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setOfflineQueuePolicy(const OfflineQueuePolicy policy)
+        {
+            m_offlineQueuePolicy = policy;
+            return *this;
+        }
+
+        /**
+         * @brief Set a store that persists QoS 1/2 session state, so in-flight messages survive a process restart.
+         * See createMappedSessionStore().
+         * @param store Session store, or nullptr to keep session state in memory only.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setSessionStore(SessionStorePtr store)
+        {
+            m_sessionStore = std::move(store);
+            return *this;
+        }
+
+        /**
+         * @brief Send subscribes made while connecting straight after CONNECT instead of waiting for CONNACK.
+         * Saves a round trip before the first message; if the broker refuses the connection, those subscribes fail.
+         * @param enabled True to pipeline SUBSCRIBE behind CONNECT.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setPipelineSubscribesOnConnect(const bool enabled)
+        {
+            m_pipelineSubscribesOnConnect = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Set the longest time spent dispatching inbound packets per tick.
+         * Frames still buffered when the budget runs out are dispatched on the next tick, so a flood (for example
+         * retained messages after a subscribe) cannot stall a game-thread tick.
+         * @param timeUs The time budget in microseconds; 0 means no time limit.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxInboundProcessingTimeUs(const uint32_t timeUs)
+        {
+            m_maxInboundProcessingTimeUs = timeUs;
+            return *this;
+        }
+
+        /**
+         * @brief Set the most queued API commands (publish, subscribe, ...) processed per tick.
+         * Commands over the budget stay queued, so a burst of publishes cannot hold back inbound acknowledgements and
+         * keepalive for the rest of the tick. A publish batch counts as one command.
+         * @param maxCommands The per-tick command budget; 0 means no limit.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxCommandsPerTick(const uint32_t maxCommands)
+        {
+            m_maxCommandsPerTick = maxCommands;
+            return *this;
+        }
+
+        /**
+         * @brief Set the longest time spent processing queued API commands per tick.
+         * Works alongside setMaxCommandsPerTick(): whichever limit is reached first ends the tick's command processing.
+         * @param timeUs The time budget in microseconds; 0 means no time limit.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxCommandProcessingTimeUs(const uint32_t timeUs)
+        {
+            m_maxCommandProcessingTimeUs = timeUs;
+            return *this;
+        }
+
+        /**
+         * @brief Hand every callback produced during one reactor tick to the CallbackExecutor as a single task.
+         * The task runs the callbacks in the order they were produced, so a busy subscription costs one marshalled
+         * task per tick instead of one per message. Completion handlers passed to the async APIs are still handed
+         * over one by one. Has no effect without a CallbackExecutor.
+         * @param enabled True to batch callbacks per tick.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setBatchCallbacks(const bool enabled)
+        {
+            m_batchCallbacks = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Run OnMessage and subscription handlers on a pool of worker lanes instead of one thread.
+         * Each topic is hashed onto one lane, so messages of a topic are still handled in order while different
+         * topics are handled in parallel. Handlers then bypass the CallbackExecutor and must be safe to run
+         * concurrently with each other. OnMessageView handlers are unaffected and still run on the reactor thread.
+         * @param laneCount Number of lanes; 0 disables the lanes (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMessageDispatchLanes(const uint32_t laneCount)
+        {
+            m_messageDispatchLanes = laneCount;
+            return *this;
+        }
+
+        /**
+         * @brief Bound the messages waiting for their handlers on the CallbackExecutor or the dispatch lanes.
+         * Once the bound is reached the client stops reading from the socket until a handler finishes, so TCP flow
+         * control pushes back on the broker, and a QoS 1 PUBACK is only sent after the message's handlers have run.
+         * Has no effect when handlers run on the reactor thread, which already waits for them.
+         * @param maxDeliveries Most pending messages; 0 leaves the queue unbounded (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxPendingDeliveries(const uint32_t maxDeliveries)
+        {
+            m_maxPendingDeliveries = maxDeliveries;
+            return *this;
+        }
+
+        /**
+         * @brief Cap the memory held by messages waiting for their handlers, for memory-constrained consumers.
+         * Counted as topic plus payload bytes; reaching the cap pauses reading and defers QoS 1 PUBACKs exactly as
+         * setMaxPendingDeliveries() does. A single message larger than the cap is still delivered.
+         * @param maxBytes Most pending bytes; 0 leaves them unbounded (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxPendingDeliveryBytes(const uint32_t maxBytes)
+        {
+            m_maxPendingDeliveryBytes = maxBytes;
+            return *this;
+        }
+
+        /**
+         * @brief Acknowledge inbound QoS 1/2 messages only when the application says so, as after committing them.
+         * Messages reaching an OnMessage or subscription handler then carry an AckToken; the PUBACK (QoS 1) or PUBCOMP
+         * (QoS 2) is held until Message::acknowledge() is called, from any thread. Acknowledgements made between two
+         * reactor ticks are written together. The broker stops sending once the advertised Receive Maximum of
+         * messages is unacknowledged, so a consumer that falls behind needs no buffer of its own. Messages that reach
+         * only OnMessageView handlers are acknowledged as before.
+         * @param enabled True for manual acknowledgement; false acknowledges once the handlers have been called (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setManualAcknowledgement(const bool enabled)
+        {
+            m_manualAcknowledgement = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Set the Receive Maximum advertised to an MQTT 5 broker: the most QoS 1/2 messages it may send before
+         * this client acknowledges them. Pairs with manual acknowledgement to bound what the application holds.
+         * @param maxMessages Most unacknowledged messages; 0 leaves the property out, allowing 65535 (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setReceiveMaximum(const uint16_t maxMessages)
+        {
+            m_receiveMaximum = maxMessages;
+            return *this;
+        }
+
+        /**
+         * @brief Time each reactor tick by phase (commands, state, socket read, parse, dispatch) and keep the last
+         * TickProfile::kWindowTicks ticks for IClient::getTickProfile(). Meant for hosts that tick from a game loop
+         * and budget the client's share of the frame; costs a few clock reads per tick and per packet.
+         * @param enabled True to profile ticks; false to skip the clock reads (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setTickProfiling(const bool enabled)
+        {
+            m_tickProfiling = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Offload TLS record encryption and decryption to the kernel (Linux kTLS) after the handshake, where
+         * OpenSSL was built with kTLS, the kernel has the tls module loaded and the negotiated cipher is one it
+         * implements (AES-GCM, and ChaCha20-Poly1305 on newer kernels). Otherwise the connection silently keeps
+         * encrypting in user space. Only the socket-descriptor TLS backend can offload; the BIO backend ignores it.
+         * @param enabled True to request kTLS; false to always encrypt in user space (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setKernelTlsOffload(const bool enabled)
+        {
+            m_kernelTlsOffload = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Set the cipher order and record sizing of Ssl and Wss connections, for example
+         * TlsTuningOptions::lowLatency() for control traffic, whose small first records arrive in one TCP segment, or
+         * TlsTuningOptions::highThroughput() for bulk telemetry. The defaults leave both to the TLS library.
+         * @param options TLS tuning options.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setTlsTuning(const TlsTuningOptions& options)
+        {
+            m_tlsTuning = options;
+            return *this;
+        }
+
+        /**
+         * @brief Set how long a resolved broker address is reused by later connects in this process, so reconnects skip
+         * DNS. Lookups run off the reactor thread either way. The platform resolver does not report record TTLs, so this
+         * bounds how stale a cached address may get; a failed connect also drops the address.
+         * @param seconds Cache lifetime; 0 resolves the host on every connect (default: 60).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setDnsCacheTtlSeconds(const uint32_t seconds)
+        {
+            m_dnsCacheTtlSeconds = seconds;
+            return *this;
+        }
+
+        /**
+         * @brief Set the TCP options applied to the client's socket before it connects, for example
+         * SocketOptions::lowLatency() for control traffic or SocketOptions::highThroughput() for bulk telemetry.
+         * The defaults only turn Nagle's algorithm off.
+         * @param options Socket options.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setSocketOptions(const SocketOptions& options)
+        {
+            m_socketOptions = options;
+            return *this;
+        }
+
+        /**
+         * @brief Offer the WebSocket permessage-deflate extension on Ws and Wss connections, so the broker and the
+         * client compress every frame they exchange. Only builds with REACTORMQ_WITH_ZLIB make the offer.
+         * @param options Window sizes, context takeover and the smallest packet worth compressing.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setWebSocketDeflate(const WebSocketDeflateOptions& options)
+        {
+            m_webSocketDeflate = options;
+            return *this;
+        }
+
+        /**
+         * @brief Encode the payloads of messages published to matching topics with a codec, on MQTT 5 connections.
+         * Each encoded PUBLISH names the codec in a "payload-codec" User Property, and received ones naming a
+         * registered codec are decoded before delivery. A payload that does not get smaller is sent as it is.
+         * Filters are tried in the order they were added.
+         * @param topicFilter Topic filter selecting the messages to encode.
+         * @param codec Codec to encode them with, for example createDeflatePayloadCodec().
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& addPayloadCodec(const std::string& topicFilter, PayloadCodecPtr codec)
+        {
+            if (codec)
+            {
+                m_payloadCodecs.push_back(PayloadCodecBinding{ topicFilter, std::move(codec) });
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Share one topic string between the inbound messages of each of the most frequent topics.
+         * Messages on an interned topic hold a SharedTopic instead of a copy of their topic, routing for a topic seen
+         * on the previous message skips the lookup, and telemetry streams that repeat a few hundred topics stop
+         * allocating one string per message. The table starts over once it holds this many topics.
+         * @param maxTopics Most distinct topics interned; 0 turns interning off.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMaxInternedTopics(const uint32_t maxTopics)
+        {
+            m_maxInternedTopics = maxTopics;
+            return *this;
+        }
+
+        /**
+         * @brief Draw the client's inbound payloads and its decoded-packet arena from a memory resource.
+         * Gives each client its own pool, e.g. a std::pmr::monotonic_buffer_resource over a budgeted block or an
+         * adapter to an engine allocator, and lets the resource account for what the client holds. The resource is
+         * called from the reactor thread, and payloads delivered to handlers release their bytes back to it from
+         * whichever thread drops the last copy, so it must be thread-safe unless both happen on one thread.
+         * @param resource Memory resource, or nullptr for the global heap.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setMemoryResource(std::shared_ptr<std::pmr::memory_resource> resource)
+        {
+            m_memoryResource = std::move(resource);
+            return *this;
+        }
+
+        /**
+         * @brief Pass PUBLISH packets larger than a threshold on as they arrive, instead of buffering them whole.
+         * Their payloads go chunk by chunk to the IPayloadSink of the subscription they match (see
+         * ISubscribableAsync::subscribeAsync() with a sink), so a message can be far larger than the max buffer size.
+         * Matching no sink, one that fits the max buffer size is gathered and delivered as usual; a larger one is
+         * acknowledged and dropped. The max packet size still bounds every packet, so raise it to match.
+         * @param thresholdBytes Packet size above which payloads are streamed; 0 turns streaming off.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setInboundStreamingThreshold(const uint32_t thresholdBytes)
+        {
+            m_inboundStreamingThreshold = thresholdBytes;
+            return *this;
+        }
+
+        /**
+         * @brief Subscribe again to the active subscriptions when a reconnect finds no session on the broker.
+         * The client keeps every filter the broker granted, with its QoS and options, and sends them in as few
+         * SUBSCRIBE packets as the broker's maximum packet size allows once CONNACK reports no session present. Turn it
+         * off when the application replays its own subscribes.
+         * @param enabled True to resubscribe on reconnect (the default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setResubscribeOnReconnect(const bool enabled)
+        {
+            m_resubscribeOnReconnect = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Keep the latest message received on each topic, for IClient::getLastValue().
+         * Lets code that only wants current values, such as a UI polling once a frame, read them from any thread
+         * without a handler or a queue of every intermediate update. Every delivered message is kept, whether or not
+         * a handler matches it; once this many topics are held, messages on new topics are not.
+         * @param maxTopics Most distinct topics kept; 0 turns the cache off.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setLastValueCacheSize(const uint32_t maxTopics)
+        {
+            m_lastValueCacheSize = maxTopics;
+            return *this;
+        }
+
+        /**
+         * @brief Skip publishes whose payload is the same as the last one sent on their topic, such as retained state
+         * a device republishes on a timer whether or not it changed. A skipped publish completes successfully without
+         * reaching the broker; an unchanged payload still goes out once the refresh interval has passed, and after
+         * every reconnect.
+         * @param options Dedup options; set isEnabled to turn it on.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setPublishDedup(const PublishDedupOptions& options)
+        {
+            m_publishDedup = options;
+            return *this;
+        }
+
+        /**
+         * @brief Limit how fast publishes go out, in messages and bytes per second, for topics starting with a prefix
+         * or, with an empty prefix, for the whole client. Protects a constrained uplink from a noisy producer: over
+         * the limit, a publish is held and replaced by newer ones on its topic until the limit allows it, or rejected.
+         * Call once per limit; a publish obeys its longest matching prefix and the client-wide limit.
+         * @param limit Limit to add.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& addPublishRateLimit(PublishRateLimit limit)
+        {
+            m_publishRateLimits.push_back(std::move(limit));
+            return *this;
+        }
+
+        /**
+         * @brief Take the inbound socket ring's storage from a pool of 2 MiB huge pages and/or from memory on the
+         * NUMA node of the reactor thread reading the socket, for gateways holding many connections on multi-socket
+         * machines. Pair it with a ThreadPlacement that pins the reactor threads. Linux only.
+         * @param options Buffer memory options.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setBufferMemory(const BufferMemoryOptions& options)
+        {
+            m_bufferMemory = options;
+            return *this;
+        }
+
+        /**
+         * @brief Deliver inbound QoS 2 messages as soon as their PUBLISH arrives, keeping only the packet ID until
+         * PUBREL so a resent PUBLISH is not delivered twice. Both flows are allowed by the MQTT specification; this one
+         * saves a round trip of latency and does not hold payloads in memory, but the PUBREC does not wait for the
+         * handlers, and the packet IDs are not kept in the session store.
+         * @param deliverOnPublish True to deliver on PUBLISH; false (default) to deliver on PUBREL.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setDeliverQos2OnPublish(const bool deliverOnPublish)
+        {
+            m_deliverQos2OnPublish = deliverOnPublish;
+            return *this;
+        }
+
+        /**
+         * @brief Re-authenticate periodically while connected, with MQTT 5 AUTH packets rather than a reconnect.
+         * Each time the interval elapses the client asks the credentials provider for fresh authentication data with
+         * ICredentialsProvider::getReauthenticationDataAsync() and sends it in an AUTH packet with reason code 0x19;
+         * any challenge the broker answers with goes to ICredentialsProvider::onAuthChallengeAsync(). Publishes and
+         * acknowledgements keep flowing throughout. Needs MQTT 5 and a provider whose getAuthMethod() is not empty.
+         * @param intervalMs Interval in milliseconds, such as a little less than the token lifetime; 0 (default) turns
+         * re-authentication off.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setReauthenticateIntervalMs(const uint32_t intervalMs)
+        {
+            m_reauthenticateIntervalMs = intervalMs;
+            return *this;
+        }
+
+        /**
+         * @brief Reserve the client's working memory when it is created, so sending and receiving never grow it;
+         * see FixedCapacityOptions. Pair it with small setMaxBufferSize(), setMaxOutboundQueueBytes() and
+         * setMaxPendingCommands() limits sized for the device, since each is reserved in full.
+         * @param options Fixed capacity options.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setFixedCapacity(const FixedCapacityOptions& options)
+        {
+            m_fixedCapacity = options;
+            return *this;
+        }
+
+        /**
+         * @brief Show every packet the client sends and receives to a tap, as when debugging a production link.
+         * createPacketCapture() gives one that writes a pcapng or JSON file from its own thread. Without a tap the
+         * send and receive paths test one pointer and do nothing else.
+         * @param tap Tap to call on the reactor thread; nullptr to tap nothing.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setPacketTap(PacketTapPtr tap)
+        {
+            m_packetTap = std::move(tap);
+            return *this;
+        }
+
+        /**
+         * @brief Encode publishes on the thread that calls publish() or publishAsync() instead of the reactor thread.
+         * The publishing thread writes the whole packet, and the reactor thread only patches in the packet identifier
+         * and appends it, so with many producers on one reactor the encoding spreads over their cores. Applies to
+         * payloads under 512 bytes without a payload codec; larger payloads are already sent from their own buffer.
+         * A publish that waits long enough for its expiry interval to change, or that gets a Topic Alias, is encoded
+         * again on the reactor thread.
+         * @param enabled True to encode on the publishing thread; false to encode everything on the reactor (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setEncodePublishesOnCallingThread(const bool enabled)
+        {
+            m_encodePublishesOnCallingThread = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Derive timeouts from the round-trip time measured on the connection instead of fixed values.
+         * The client times each PINGREQ to its PINGRESP and each first send of a QoS 1 or 2 PUBLISH to its PUBACK or
+         * PUBREC, skipping publishes that were sent more than once, and keeps a smoothed round-trip time and its
+         * variance as TCP does (RFC 6298). The publish retry interval then starts at the smoothed time plus four
+         * times the variance, at least 1 second and at most setMaxPacketRetryIntervalSeconds(), and backs off from
+         * there; a PINGRESP is waited for that long too, at most one and a half keepalive intervals. Until the first
+         * measurement the fixed values apply. A slow link then stops retrying early, and a fast one notices a dead
+         * broker well before the keepalive runs out.
+         * @param enabled True to adapt the timeouts; false to keep them fixed (default).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setAdaptiveTimeouts(const bool enabled)
+        {
+            m_adaptiveTimeouts = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Count received messages per subscription and per busy topic prefix, for IClient::getInboundTraffic().
+         * Each subscription with a message handler gets counters of the messages and bytes routed to it and of those
+         * HandlerDelivery::LatestPerTopic replaced before its handler ran; with topPrefixCount, the busiest topic
+         * prefixes are tracked in that many slots as well, with the space-saving algorithm, so memory stays fixed
+         * however many topics arrive. Counting
+         * costs a hash lookup per matched subscription and, with prefixes, one per message.
+         * @param options Options; isEnabled turns the accounting on (default: off).
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setTrafficAccounting(const TrafficAccountingOptions& options)
+        {
+            m_trafficAccounting = options;
+            return *this;
+        }
+
+        /**
+         * @brief Add a node to fail over to when the host set with setHost() cannot be reached.
+         * With failover endpoints, a connection that fails or drops moves straight on to the healthiest other node
+         * instead of waiting out the reconnect backoff; the backoff only applies once every node has failed recently.
+         * Nodes are scored on recent failures and connect latency; weight breaks ties between healthy ones.
+         * @param host Host name or IP address.
+         * @param port Port; 0 uses the port set with setPort().
+         * @param weight Preference among healthy endpoints; the primary host has a weight of 1.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& addFailoverEndpoint(std::string host, const uint16_t port = 0, const uint32_t weight = 1)
+        {
+            m_failoverEndpoints.push_back(BrokerEndpoint{ std::move(host), port, weight });
+            return *this;
+        }
+
+        /**
+         * @brief Keep a second connection to a failover node resolved, connected and through its TLS handshake while
+         * the client is connected, so losing the current node costs one CONNECT round trip instead of a cold connect.
+         * The standby does not send CONNECT: MQTT allows one CONNECT per network connection, so the promoted standby
+         * sends the client's own, with its client ID and session, and subscriptions are restored as on any reconnect.
+         * Brokers that close connections which stay silent before CONNECT make the standby reopen periodically.
+         * Has no effect without failover endpoints or with auto-reconnect disabled.
+         * @param enabled True to keep a standby connection.
+         * @return Reference to this builder for chaining.
+         */
+        ConnectionSettingsBuilder& setWarmStandby(const bool enabled)
+        {
+            m_warmStandby = enabled;
+            return *this;
+        }
+
         /**
          * @brief Build the ConnectionSettings instance.
          * @return Shared a pointer to the constructed ConnectionSettings.
@@ -509,5 +1150,143 @@ namespace reactormq::mqtt
 
         /// @brief Optional custom SSL/TLS certificate verification callback.
         SslVerifyCallback m_sslVerifyCallback;
+
+        /// @brief Outbound bytes gathered per tick before they are written early; 0 disables coalescing.
+        uint32_t m_outboundCoalesceMaxBytes = 64 * 1024;
+
+        /// @brief Longest time in milliseconds coalesced outbound bytes may wait.
+        uint32_t m_outboundCoalesceMaxDelayMs = 1;
+
+        /// @brief Size of the tick-scoped arena for decoded inbound packets; 0 disables it.
+        uint32_t m_packetArenaSize = 16 * 1024;
+
+        /// @brief Most outbound MQTT 5 topic aliases; 0 disables aliasing.
+        uint16_t m_maxOutboundTopicAliases = 32;
+
+        /// @brief Topic Alias Maximum advertised in CONNECT; 0 asks the broker for full topics only.
+        uint16_t m_maxInboundTopicAliases = 16;
+
+        /// @brief Most publishes queued while not connected; 0 disables the offline queue.
+        uint32_t m_maxOfflinePublishes = 0;
+
+        /// @brief Most topic and payload bytes held by the offline queue.
+        uint32_t m_maxOfflineQueueBytes = 4 * 1024 * 1024;
+
+        /// @brief What is dropped when the offline queue is full.
+        OfflineQueuePolicy m_offlineQueuePolicy = OfflineQueuePolicy::DropOldest;
+
+        /// @brief Store that persists QoS 1/2 session state; nullptr keeps it in memory only.
+        SessionStorePtr m_sessionStore = nullptr;
+
+        /// @brief Whether SUBSCRIBE is pipelined behind CONNECT.
+        bool m_pipelineSubscribesOnConnect = false;
+
+        /// @brief Inbound dispatch time budget per tick in microseconds; 0 means no time limit.
+        uint32_t m_maxInboundProcessingTimeUs = 0;
+
+        /// @brief Per-tick command budget; 0 means no limit.
+        uint32_t m_maxCommandsPerTick = 0;
+
+        /// @brief Per-tick command processing time budget in microseconds; 0 means no time limit.
+        uint32_t m_maxCommandProcessingTimeUs = 0;
+
+        /// @brief Batch a tick's callbacks into one executor task.
+        bool m_batchCallbacks = false;
+
+        /// @brief Worker lanes for message handlers; 0 disables them.
+        uint32_t m_messageDispatchLanes = 0;
+
+        /// @brief Messages waiting for their handlers before reading pauses; 0 is unlimited.
+        uint32_t m_maxPendingDeliveries = 0;
+
+        /// @brief Topic and payload bytes waiting for their handlers before reading pauses; 0 is unlimited.
+        uint32_t m_maxPendingDeliveryBytes = 0;
+
+        /// @brief Whether inbound QoS 1/2 messages wait for Message::acknowledge().
+        bool m_manualAcknowledgement = false;
+
+        /// @brief Receive Maximum advertised in CONNECT; 0 leaves it out.
+        uint16_t m_receiveMaximum = 0;
+
+        /// @brief Whether reactor ticks are timed by phase.
+        bool m_tickProfiling = false;
+
+        /// @brief Whether kernel TLS offload is requested.
+        bool m_kernelTlsOffload = false;
+
+        /// @brief Cipher order and record sizing of TLS connections.
+        TlsTuningOptions m_tlsTuning;
+
+        /// @brief Seconds a resolved broker address is reused by later connects.
+        uint32_t m_dnsCacheTtlSeconds = 60;
+
+        /// @brief TCP options applied to the socket before it connects.
+        SocketOptions m_socketOptions;
+
+        /// @brief permessage-deflate offer for Ws and Wss connections.
+        WebSocketDeflateOptions m_webSocketDeflate;
+
+        /// @brief MQTT 5 payload codecs and the topics they encode.
+        std::vector<PayloadCodecBinding> m_payloadCodecs;
+
+        /// @brief Most distinct inbound topics interned; 0 = off.
+        uint32_t m_maxInternedTopics = 0;
+
+        /// @brief Resource for inbound payloads and the packet arena; nullptr = global heap.
+        std::shared_ptr<std::pmr::memory_resource> m_memoryResource;
+
+        /// @brief PUBLISH size above which payloads are streamed to sinks; 0 = off.
+        uint32_t m_inboundStreamingThreshold = 0;
+
+        /// @brief Resubscribe to the active subscriptions when a reconnect finds no session.
+        bool m_resubscribeOnReconnect = true;
+
+        /// @brief Most topics whose latest message is kept; 0 = off.
+        uint32_t m_lastValueCacheSize = 0;
+
+        /// @brief Nodes tried after the host.
+        std::vector<BrokerEndpoint> m_failoverEndpoints;
+
+        /// @brief Keep a standby connection to a failover node.
+        bool m_warmStandby = false;
+
+        /// @brief How reconnect delays are randomised.
+        ReconnectJitter m_reconnectJitter = ReconnectJitter::Proportional;
+
+        /// @brief Rate limit on reconnect attempts; shared between clients.
+        ReconnectThrottlePtr m_reconnectThrottle;
+
+        /// @brief How waitAndTick() waits for work.
+        BusyPollOptions m_busyPoll;
+
+        /// @brief Suppression of publishes that repeat the last payload on their topic.
+        PublishDedupOptions m_publishDedup;
+
+        /// @brief Token-bucket limits on outbound publishes.
+        std::vector<PublishRateLimit> m_publishRateLimits;
+
+        /// @brief Where the inbound socket ring takes its storage from.
+        BufferMemoryOptions m_bufferMemory;
+
+        /// @brief Deliver inbound QoS 2 messages on PUBLISH rather than on PUBREL.
+        bool m_deliverQos2OnPublish = false;
+
+        /// @brief Interval between MQTT 5 re-authentications while connected; 0 is off.
+        uint32_t m_reauthenticateIntervalMs = 0;
+
+        /// @brief Whether the client reserves its memory when it is created.
+        FixedCapacityOptions m_fixedCapacity;
+
+        /// @brief Observer of the raw packets sent and received; null when none.
+        PacketTapPtr m_packetTap;
+
+        /// @brief Whether small publishes are encoded on the publishing thread.
+        bool m_encodePublishesOnCallingThread = false;
+
+        /// @brief Whether timeouts follow the measured round-trip time.
+        bool m_adaptiveTimeouts = false;
+
+        /// @brief Inbound traffic accounting options.
+        TrafficAccountingOptions m_trafficAccounting;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
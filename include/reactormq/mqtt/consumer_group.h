@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connectable_async.h"
+#include "reactormq/mqtt/delegates.h"
+#include "reactormq/mqtt/disconnectable_async.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Several connections that consume one MQTT 5 shared subscription ($share/{group}/{filter}) together, so
+     * the broker spreads the messages over them, behind a single message callback.
+     *
+     * The first successful connect subscribes every connection to the shared filter; reconnects restore it as they do
+     * any subscription. Messages from all connections go through one dispatch stage whose lanes are keyed by topic,
+     * so OnMessage handlers for one topic run one at a time in the order the messages arrived, while different
+     * topics run in parallel on the lanes. A message is acknowledged once it is queued on its lane, not once its
+     * handlers have run.
+     */
+    class REACTORMQ_API IConsumerGroup
+        : public IConnectableAsync
+        , public IDisconnectableAsync
+    {
+    public:
+        ~IConsumerGroup() override = default;
+
+        /// @brief Number of connections.
+        [[nodiscard]] virtual size_t getConsumerCount() const = 0;
+
+        /// @brief One of the connections, for its event callbacks and metrics.
+        [[nodiscard]] virtual const std::shared_ptr<IClient>& getConsumer(size_t index) const = 0;
+
+        /// @brief The filter every connection subscribes to, "$share/{group}/{filter}".
+        [[nodiscard]] virtual const std::string& getSharedFilter() const = 0;
+
+        /**
+         * @brief Delegate called with every message from every connection, on the message's dispatch lane.
+         * @return Reference to the OnMessage delegate to assign a handler.
+         */
+        virtual OnMessage& onMessage() = 0;
+
+        /// @brief Whether every connection is connected to the broker.
+        [[nodiscard]] virtual bool isConnected() const = 0;
+
+        /**
+         * @brief Tick every connection once (polling mode).
+         * Not needed, and not to be called, when the connections were created through a reactor group.
+         */
+        virtual void tick() = 0;
+
+        /// @brief Metrics of all connections added together; see ClientMetrics::merge().
+        [[nodiscard]] virtual ClientMetrics getMetrics() const = 0;
+
+        /// @brief Inbound traffic of all connections added together; see InboundTraffic::merge().
+        [[nodiscard]] virtual InboundTraffic getInboundTraffic() const = 0;
+    };
+} // namespace reactormq::mqtt
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -13,9 +14,20 @@
 
 namespace reactormq::mqtt
 {
+    /// @brief Receives the credentials for CONNECT; may be called on any thread, once.
+    using CredentialsCallback = std::function<void(Credentials credentials)>;
+
+    /// @brief Receives the client's response to an AUTH challenge; may be called on any thread, once.
+    using AuthResponseCallback = std::function<void(std::vector<uint8_t> clientData)>;
+
     /**
      * @brief Source of MQTT credentials and optional enhanced-auth data.
      * Supports static or dynamic credentials and MQTT 5 enhanced authentication flows.
+     *
+     * The client calls the asynchronous methods on its reactor thread, which every client in a reactor group shares,
+     * so a provider that has to fetch anything (a token over HTTP, a secret from a vault) should override them and
+     * complete from its own thread; see CachingCredentialsProvider. Their defaults call the synchronous methods inline.
+     * Until credentials arrive the connect waits without blocking, bounded by the MQTT connection timeout.
      */
     class REACTORMQ_API ICredentialsProvider
     {
@@ -56,5 +68,38 @@ namespace reactormq::mqtt
             (void)serverData; // Suppress unused parameter warning
             return {};
         }
+
+        /**
+         * @brief Deliver credentials for CONNECT without blocking the caller.
+         * The default calls getCredentials() inline.
+         * @param onReady Called with the credentials, from any thread.
+         */
+        virtual void getCredentialsAsync(CredentialsCallback onReady)
+        {
+            onReady(getCredentials());
+        }
+
+        /**
+         * @brief Answer an AUTH challenge from the server without blocking the caller.
+         * The default calls onAuthChallenge() inline.
+         * @param serverData Challenge payload from the server.
+         * @param onReady Called with the next client response payload, from any thread.
+         */
+        virtual void onAuthChallengeAsync(const std::vector<uint8_t>& serverData, AuthResponseCallback onReady)
+        {
+            onReady(onAuthChallenge(serverData));
+        }
+
+        /**
+         * @brief Deliver fresh authentication data for an MQTT 5 re-authentication without blocking the caller.
+         * Called while connected, each time ConnectionSettings::getReauthenticateIntervalMs() elapses; the data goes out
+         * in an AUTH packet with the method from getAuthMethod(). The default calls getInitialAuthData() inline, so a
+         * provider whose initial data is the current token rotates it with no further code.
+         * @param onReady Called with the authentication data, from any thread.
+         */
+        virtual void getReauthenticationDataAsync(AuthResponseCallback onReady)
+        {
+            onReady(getInitialAuthData());
+        }
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
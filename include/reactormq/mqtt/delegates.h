@@ -4,18 +4,23 @@
 
 #pragma once
 
+#include "reactormq/mqtt/inline_function.h"
+
+#include <algorithm>
 #include <atomic>
-#include <functional>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
 namespace reactormq::mqtt
 {
     struct Message;
+    struct MessageView;
     struct SubscribeResult;
     struct UnsubscribeResult;
 
@@ -25,11 +30,29 @@ namespace reactormq::mqtt
         Manual
     };
 
+    namespace delegate
+    {
+        /// @brief What a DelegateHandle needs from the delegate that issued it, whatever the delegate's signature.
+        class SlotOwner
+        {
+        public:
+            /// @brief Remove the slot if @p generation is still the one at @p index; otherwise do nothing.
+            virtual void removeSlot(std::uint32_t index, std::uint32_t generation) noexcept = 0;
+
+            /// @brief Whether @p generation is still the one registered at @p index.
+            [[nodiscard]] virtual bool isSlotLive(std::uint32_t index, std::uint32_t generation) const noexcept = 0;
+
+        protected:
+            ~SlotOwner() = default;
+        };
+    } // namespace delegate
+
     /**
      * @brief Handle object for a registered delegate callback.
      *
      * Owns the connection to a MulticastDelegate. Depending on policy,
      * the callback disconnects on destruction or only when disconnect() is called.
+     * The handle names its slot by index and generation, so disconnecting is a lookup in the delegate's slot map.
      */
     class DelegateHandle
     {
@@ -39,15 +62,21 @@ namespace reactormq::mqtt
         /**
          * @brief Construct a handle bound to a specific delegate slot.
          * @param owner Weak reference guarding the delegate lifetime.
-         * @param token Weak reference guarding this slot.
-         * @param disconnect Callable that removes the slot from the delegate.
+         * @param slots Delegate that issued the slot.
+         * @param index Slot map entry of the slot.
+         * @param generation Generation of the entry when the slot was added.
          * @param policy Disconnect behavior on destruction.
          */
         DelegateHandle(
-            std::weak_ptr<void> owner, std::weak_ptr<void> token, std::function<void()> disconnect, const DisconnectPolicy policy)
+            std::weak_ptr<void> owner,
+            delegate::SlotOwner& slots,
+            const std::uint32_t index,
+            const std::uint32_t generation,
+            const DisconnectPolicy policy)
             : m_owner(std::move(owner))
-            , m_token(std::move(token))
-            , m_disconnect(std::move(disconnect))
+            , m_slots(&slots)
+            , m_index(index)
+            , m_generation(generation)
             , m_policy(policy)
         {
         }
@@ -66,34 +95,30 @@ namespace reactormq::mqtt
 
         DelegateHandle(DelegateHandle&& other) noexcept
             : m_owner(std::move(other.m_owner))
-            , m_token(std::move(other.m_token))
-            , m_disconnect(std::move(other.m_disconnect))
-            , m_policy(other.m_policy)
+            , m_slots(std::exchange(other.m_slots, nullptr))
+            , m_index(other.m_index)
+            , m_generation(other.m_generation)
+            , m_policy(std::exchange(other.m_policy, DisconnectPolicy::Manual))
         {
             other.m_owner.reset();
-            other.m_token.reset();
-            other.m_disconnect = nullptr;
-            other.m_policy = DisconnectPolicy::Manual;
         }
 
         DelegateHandle& operator=(DelegateHandle&& other) noexcept
         {
             if (this != &other)
             {
-                if (m_disconnect && !m_owner.expired())
+                if (m_slots != nullptr && !m_owner.expired())
                 {
-                    m_disconnect();
+                    m_slots->removeSlot(m_index, m_generation);
                 }
 
                 m_owner = std::move(other.m_owner);
-                m_token = std::move(other.m_token);
-                m_disconnect = std::move(other.m_disconnect);
-                m_policy = other.m_policy;
+                m_slots = std::exchange(other.m_slots, nullptr);
+                m_index = other.m_index;
+                m_generation = other.m_generation;
+                m_policy = std::exchange(other.m_policy, DisconnectPolicy::Manual);
 
                 other.m_owner.reset();
-                other.m_token.reset();
-                other.m_disconnect = nullptr;
-                other.m_policy = DisconnectPolicy::Manual;
             }
             return *this;
         }
@@ -103,21 +128,13 @@ namespace reactormq::mqtt
          */
         void disconnect() noexcept
         {
-            if (!m_disconnect)
+            if (m_slots != nullptr && !m_owner.expired())
             {
-                m_owner.reset();
-                m_token.reset();
-                return;
+                m_slots->removeSlot(m_index, m_generation);
             }
 
-            if (!m_owner.expired())
-            {
-                m_disconnect();
-            }
-
-            m_disconnect = nullptr;
+            m_slots = nullptr;
             m_owner.reset();
-            m_token.reset();
         }
 
         /**
@@ -126,13 +143,14 @@ namespace reactormq::mqtt
          */
         [[nodiscard]] bool isValid() const noexcept
         {
-            return m_disconnect && !m_owner.expired() && !m_token.expired();
+            return m_slots != nullptr && !m_owner.expired() && m_slots->isSlotLive(m_index, m_generation);
         }
 
     private:
         std::weak_ptr<void> m_owner;
-        std::weak_ptr<void> m_token;
-        std::function<void()> m_disconnect;
+        delegate::SlotOwner* m_slots{ nullptr };
+        std::uint32_t m_index{ 0 };
+        std::uint32_t m_generation{ 0 };
         DisconnectPolicy m_policy{ DisconnectPolicy::Manual };
     };
 
@@ -150,25 +168,60 @@ namespace reactormq::mqtt
      *
      * Supports adding free functions, lambdas, and member functions. Broadcast
      * invokes live callbacks in registration order and prunes expired ones.
+     *
+     * Slots live in a generational slot map: each handle names its slot by map index and generation, so removing a
+     * callback is a lookup rather than a search, and a handle to a removed slot cannot reach whatever reuses its index.
+     * Broadcast walks a dense array of slot pointers in registration order without locking, allocating or copying.
+     * Adding appends to that array in place; removing only marks the slot, and the array is compacted into a new one
+     * once removed slots outnumber live ones or it runs out of room, so both are amortised O(1). A replaced array and
+     * the callables of removed slots are freed by the next change that finds no broadcast in progress, or by the
+     * destructor. Callables are stored inline in their slot (see InlineFunction), so registering a typical lambda
+     * allocates only the slot itself.
      * @tparam Signature Function signature R(Args...).
      */
     template<class Signature>
     class MulticastDelegate;
 
     template<class R, class... Args>
-    class MulticastDelegate<R(Args...)>
+    class MulticastDelegate<R(Args...)> final : private delegate::SlotOwner
     {
         using OptionalR = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
 
         struct SlotBase
         {
-            size_t id{};
-            std::function<std::optional<OptionalR>(Args...)> call;
-            std::function<bool()> expired;
-            std::shared_ptr<void> keeper;
-            std::shared_ptr<void> token;
+            InlineFunction<std::optional<OptionalR>(Args...)> call;
+            InlineFunction<bool()> expired; ///< Empty for slots that own their callable and never expire.
+            std::atomic<bool> isLive{ true }; ///< Cleared on removal; broadcast checks it before every call.
+            std::uint32_t index{}; ///< Slot map entry, so that pruning can remove the slot.
+        };
+
+        /// @brief Slots in registration order, removed ones included. Appended to in place; never otherwise changed.
+        struct SlotArray
+        {
+            explicit SlotArray(const size_t slotCapacity)
+                : slots(std::make_unique<SlotBase*[]>(slotCapacity))
+                , capacity(slotCapacity)
+            {
+            }
+
+            std::unique_ptr<SlotBase*[]> slots;
+            size_t capacity;
+            std::atomic<size_t> size{ 0 }; ///< Stored after the slot it counts, so a broadcast never reads past it.
+        };
+
+        /// @brief Slot map entry. The generation changes on every removal, so it tells successive slots at one index apart.
+        struct SlotRecord
+        {
+            std::unique_ptr<SlotBase> slot; ///< Null while the entry is free.
+            std::uint32_t generation{ 0 };
+            std::uint32_t nextFree{ kNoIndex };
         };
 
+        static constexpr std::uint32_t kNoIndex = UINT32_MAX;
+
+        /// @brief Smallest array allocated, and the fewest removed slots worth compacting away.
+        static constexpr size_t kMinCapacity = 8;
+
     public:
         MulticastDelegate() = default;
 
@@ -184,52 +237,26 @@ namespace reactormq::mqtt
             using Fn = std::decay_t<F>;
             static_assert(std::is_invocable_r_v<R, Fn&, Args...>, "Callable must be invocable with Args... and return R");
 
-            auto sp = std::make_shared<Fn>(std::forward<F>(f));
-            auto wsp = std::weak_ptr<Fn>(sp);
-
-            SlotBase slot;
-            slot.id = m_nextId++;
-            slot.token = std::make_shared<std::atomic<bool>>(true);
-            std::weak_ptr<void> wtoken = slot.token;
-            slot.keeper = sp;
-            slot.expired = [wsp]
-            {
-                return wsp.expired();
-            };
+            auto slot = std::make_unique<SlotBase>();
 
+            // The slot owns the callable for as long as any slot array holds it, so no lock is needed per call.
             if constexpr (std::is_void_v<R>)
             {
-                slot.call = [wsp](Args... args) -> std::optional<OptionalR>
+                slot->call = [fn = Fn(std::forward<F>(f))](Args... args) mutable -> std::optional<OptionalR>
                 {
-                    if (auto fShared = wsp.lock())
-                    {
-                        (*fShared)(args...);
-                        return std::optional<OptionalR>{ std::monostate{} };
-                    }
-                    return std::nullopt;
+                    fn(args...);
+                    return std::optional<OptionalR>{ std::monostate{} };
                 };
             }
             else
             {
-                slot.call = [wsp](Args... args) -> std::optional<OptionalR>
+                slot->call = [fn = Fn(std::forward<F>(f))](Args... args) mutable -> std::optional<OptionalR>
                 {
-                    if (auto fShared = wsp.lock())
-                    {
-                        return std::optional<OptionalR>((*fShared)(args...));
-                    }
-                    return std::nullopt;
+                    return std::optional<OptionalR>(fn(args...));
                 };
             }
 
-            auto id = addSlot(std::move(slot));
-            return DelegateHandle(
-                m_self,
-                wtoken,
-                [this, id]
-                {
-                    this->remove(id);
-                },
-                DisconnectPolicy::Manual);
+            return addSlot(std::move(slot));
         }
 
         /**
@@ -244,18 +271,15 @@ namespace reactormq::mqtt
             static_assert(std::is_invocable_r_v<R, Callable&, Args...>, "Callable must be invocable with Args... and return R");
             auto wcb = std::weak_ptr<Callable>(cb);
 
-            SlotBase slot;
-            slot.id = m_nextId++;
-            slot.token = std::make_shared<std::atomic<bool>>(true);
-            std::weak_ptr<void> wtoken = slot.token;
-            slot.expired = [wcb]
+            auto slot = std::make_unique<SlotBase>();
+            slot->expired = [wcb]
             {
                 return wcb.expired();
             };
 
             if constexpr (std::is_void_v<R>)
             {
-                slot.call = [wcb](Args... args) -> std::optional<OptionalR>
+                slot->call = [wcb](Args... args) -> std::optional<OptionalR>
                 {
                     if (auto sp = wcb.lock())
                     {
@@ -267,7 +291,7 @@ namespace reactormq::mqtt
             }
             else
             {
-                slot.call = [wcb](Args... args) -> std::optional<OptionalR>
+                slot->call = [wcb](Args... args) -> std::optional<OptionalR>
                 {
                     if (auto sp = wcb.lock())
                     {
@@ -277,15 +301,7 @@ namespace reactormq::mqtt
                 };
             }
 
-            auto handle = addSlot(std::move(slot));
-            return DelegateHandle(
-                m_self,
-                wtoken,
-                [this, id = handle]
-                {
-                    this->remove(id);
-                },
-                DisconnectPolicy::Manual);
+            return addSlot(std::move(slot));
         }
 
         /**
@@ -315,60 +331,39 @@ namespace reactormq::mqtt
             std::shared_ptr<T> sharedObj = obj->shared_from_this();
 
             using Fn = std::decay_t<F>;
-            auto lambdaPtr = std::make_shared<Fn>(std::forward<F>(lambda));
-            auto wlambda = std::weak_ptr<Fn>(lambdaPtr);
             auto wobj = std::weak_ptr<T>(sharedObj);
 
-            SlotBase slot;
-            slot.id = m_nextId++;
-            slot.token = std::make_shared<std::atomic<bool>>(true);
-            std::weak_ptr<void> wtoken = slot.token;
-            slot.keeper = lambdaPtr;
-
-            slot.expired = [wobj, wlambda]
+            auto slot = std::make_unique<SlotBase>();
+            slot->expired = [wobj]
             {
-                return wobj.expired() || wlambda.expired();
+                return wobj.expired();
             };
 
             if constexpr (std::is_void_v<R>)
             {
-                slot.call = [wobj, wlambda](Args... args) -> std::optional<OptionalR>
+                slot->call = [wobj, fn = Fn(std::forward<F>(lambda))](Args... args) mutable -> std::optional<OptionalR>
                 {
                     if (auto objPtr = wobj.lock())
                     {
-                        if (auto fnPtr = wlambda.lock())
-                        {
-                            (*fnPtr)(args...);
-                            return std::optional<OptionalR>{ std::monostate{} };
-                        }
+                        fn(args...);
+                        return std::optional<OptionalR>{ std::monostate{} };
                     }
                     return std::nullopt;
                 };
             }
             else
             {
-                slot.call = [wobj, wlambda](Args... args) -> std::optional<OptionalR>
+                slot->call = [wobj, fn = Fn(std::forward<F>(lambda))](Args... args) mutable -> std::optional<OptionalR>
                 {
                     if (auto objPtr = wobj.lock())
                     {
-                        if (auto fnPtr = wlambda.lock())
-                        {
-                            return std::optional<OptionalR>((*fnPtr)(args...));
-                        }
+                        return std::optional<OptionalR>(fn(args...));
                     }
                     return std::nullopt;
                 };
             }
 
-            auto handle = addSlot(std::move(slot));
-            return DelegateHandle(
-                m_self,
-                wtoken,
-                [this, id = handle]
-                {
-                    this->remove(id);
-                },
-                DisconnectPolicy::Manual);
+            return addSlot(std::move(slot));
         }
 
         /**
@@ -412,18 +407,15 @@ namespace reactormq::mqtt
 
             auto wobj = std::weak_ptr<T>(obj);
 
-            SlotBase slot;
-            slot.id = m_nextId++;
-            slot.token = std::make_shared<std::atomic<bool>>(true);
-            std::weak_ptr<void> wtoken = slot.token;
-            slot.expired = [wobj]
+            auto slot = std::make_unique<SlotBase>();
+            slot->expired = [wobj]
             {
                 return wobj.expired();
             };
 
             if constexpr (std::is_void_v<R>)
             {
-                slot.call = [wobj, mf](Args... args) -> std::optional<OptionalR>
+                slot->call = [wobj, mf](Args... args) -> std::optional<OptionalR>
                 {
                     if (auto sp = wobj.lock())
                     {
@@ -442,7 +434,7 @@ namespace reactormq::mqtt
             }
             else
             {
-                slot.call = [wobj, mf](Args... args) -> std::optional<OptionalR>
+                slot->call = [wobj, mf](Args... args) -> std::optional<OptionalR>
                 {
                     if (auto sp = wobj.lock())
                     {
@@ -459,15 +451,7 @@ namespace reactormq::mqtt
                 };
             }
 
-            auto handle = addSlot(std::move(slot));
-            return DelegateHandle(
-                m_self,
-                wtoken,
-                [this, id = handle]
-                {
-                    this->remove(id);
-                },
-                DisconnectPolicy::Manual);
+            return addSlot(std::move(slot));
         }
 
         /**
@@ -483,42 +467,25 @@ namespace reactormq::mqtt
         }
 
         /**
-         * @brief Remove a callback by its internal id.
-         * @param id Identifier returned when the slot was added.
+         * @brief Remove all registered callbacks.
          */
-        void remove(size_t id) noexcept
+        void clear() noexcept
         {
             std::scoped_lock lock(m_mutex);
-            for (auto it = m_slots.begin(); it != m_slots.end(); ++it)
+            if (m_liveCount == 0)
             {
-                if (it->id == id)
-                {
-                    if (it->token)
-                    {
-                        *std::static_pointer_cast<std::atomic<bool>>(it->token) = false;
-                        it->token.reset();
-                    }
-                    m_slots.erase(it);
-                    break;
-                }
+                return;
             }
-        }
 
-        /**
-         * @brief Remove all registered callbacks.
-         */
-        void clear() noexcept
-        {
-            std::scoped_lock lock(m_mutex);
-            for (auto& s : m_slots)
+            for (std::uint32_t index = 0; index < m_records.size(); ++index)
             {
-                if (s.token)
+                if (m_records[index].slot)
                 {
-                    *std::static_pointer_cast<std::atomic<bool>>(s.token) = false;
-                    s.token.reset();
+                    markRemoved(index);
                 }
             }
-            m_slots.clear();
+            compact(0);
+            reclaim();
         }
 
         /**
@@ -531,75 +498,288 @@ namespace reactormq::mqtt
          */
         std::conditional_t<std::is_void_v<R>, void, std::vector<R>> broadcast(Args... args)
         {
-            std::vector<SlotBase> snapshot;
+            bool foundExpired = false;
+            ReadGuard guard(m_readers);
+
+            // Slots appended from here on, by a callback or another thread, are not part of this broadcast.
+            const SlotArray* array = m_current.load();
+            const size_t size = array != nullptr ? array->size.load() : 0;
+
+            if constexpr (std::is_void_v<R>)
             {
-                std::scoped_lock lock(m_mutex);
-                snapshot.reserve(m_slots.size());
-                for (auto it = m_slots.begin(); it != m_slots.end();)
+                for (size_t i = 0; i < size; ++i)
                 {
-                    if (it->expired())
+                    const SlotBase& s = *array->slots[i];
+                    if (!s.isLive.load())
                     {
-                        it = m_slots.erase(it);
+                        continue;
                     }
-                    else
+                    if (isExpired(s))
                     {
-                        snapshot.push_back(*it);
-                        ++it;
+                        foundExpired = true;
                     }
-                }
-            }
-
-            if constexpr (std::is_void_v<R>)
-            {
-                for (auto& s : snapshot)
-                {
-                    if (s.token && *std::static_pointer_cast<std::atomic<bool>>(s.token))
+                    else
                     {
                         auto res = s.call(args...);
                         (void)res;
                     }
                 }
+
+                guard.release();
+                if (foundExpired)
+                {
+                    pruneExpired();
+                }
                 return;
             }
             else
             {
                 std::vector<R> out;
-                out.reserve(snapshot.size());
-                for (auto& s : snapshot)
+                out.reserve(size);
+                for (size_t i = 0; i < size; ++i)
                 {
-                    if (s.token && *std::static_pointer_cast<std::atomic<bool>>(s.token))
+                    const SlotBase& s = *array->slots[i];
+                    if (!s.isLive.load())
                     {
-                        if (auto res = s.call(args...))
-                        {
-                            out.push_back(std::move(*res));
-                        }
+                        continue;
+                    }
+                    if (isExpired(s))
+                    {
+                        foundExpired = true;
                     }
+                    else if (auto res = s.call(args...))
+                    {
+                        out.push_back(std::move(*res));
+                    }
+                }
+
+                guard.release();
+                if (foundExpired)
+                {
+                    pruneExpired();
                 }
                 return out;
             }
         }
 
         /**
-         * @brief Approximate count of currently registered callbacks.
-         * @return Number of slots; stale entries are pruned on add/remove/broadcast.
+         * @brief Count of currently registered callbacks.
+         * @return Number of slots; callbacks whose object has expired count until a broadcast prunes them.
          */
         size_t getSize() const noexcept
         {
             std::scoped_lock lock(m_mutex);
-            return m_slots.size();
+            return m_liveCount;
         }
 
     private:
-        size_t addSlot(SlotBase&& slot)
+        /// @brief Counts a broadcast as reading the current slot array until released or destroyed.
+        class ReadGuard final
+        {
+        public:
+            explicit ReadGuard(std::atomic<size_t>& readers)
+                : m_readers(&readers)
+            {
+                m_readers->fetch_add(1);
+            }
+
+            ~ReadGuard()
+            {
+                release();
+            }
+
+            ReadGuard(const ReadGuard&) = delete;
+
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            void release()
+            {
+                if (m_readers != nullptr)
+                {
+                    m_readers->fetch_sub(1);
+                    m_readers = nullptr;
+                }
+            }
+
+        private:
+            std::atomic<size_t>* m_readers;
+        };
+
+        static bool isExpired(const SlotBase& slot)
+        {
+            return slot.expired && slot.expired();
+        }
+
+        void removeSlot(const std::uint32_t index, const std::uint32_t generation) noexcept override
         {
             std::scoped_lock lock(m_mutex);
-            m_slots.push_back(std::move(slot));
-            return m_slots.back().id;
+            if (index >= m_records.size() || m_records[index].generation != generation || !m_records[index].slot)
+            {
+                return;
+            }
+
+            markRemoved(index);
+            compactIfSparse();
+            reclaim();
+        }
+
+        [[nodiscard]] bool isSlotLive(const std::uint32_t index, const std::uint32_t generation) const noexcept override
+        {
+            std::scoped_lock lock(m_mutex);
+            return index < m_records.size() && m_records[index].generation == generation && m_records[index].slot;
+        }
+
+        DelegateHandle addSlot(std::unique_ptr<SlotBase> slot)
+        {
+            std::scoped_lock lock(m_mutex);
+            std::uint32_t index = m_freeHead;
+            if (index != kNoIndex)
+            {
+                m_freeHead = m_records[index].nextFree;
+            }
+            else
+            {
+                index = static_cast<std::uint32_t>(m_records.size());
+                m_records.emplace_back();
+            }
+
+            SlotRecord& record = m_records[index];
+            slot->index = index;
+            SlotBase* const raw = slot.get();
+            record.slot = std::move(slot);
+            ++m_liveCount;
+
+            if (!m_array || m_array->size.load() == m_array->capacity)
+            {
+                // Room for as many again as are live, so the copy is paid for by the adds that fill it.
+                compact(std::max(kMinCapacity, 2 * m_liveCount));
+            }
+            const size_t size = m_array->size.load();
+            m_array->slots[size] = raw;
+            m_array->size.store(size + 1);
+            reclaim();
+            return DelegateHandle(m_self, *this, index, record.generation, DisconnectPolicy::Manual);
+        }
+
+        void pruneExpired()
+        {
+            std::scoped_lock lock(m_mutex);
+            if (!m_array)
+            {
+                return;
+            }
+
+            const size_t size = m_array->size.load();
+            for (size_t i = 0; i < size; ++i)
+            {
+                const SlotBase& s = *m_array->slots[i];
+                if (s.isLive.load() && isExpired(s))
+                {
+                    markRemoved(s.index);
+                }
+            }
+            compactIfSparse();
+            reclaim();
+        }
+
+        /**
+         * @brief Take a live slot out of the map. It stays in the current array, marked so broadcast skips it, until
+         * the array is compacted. Bumping the generation makes handles to it miss. Caller holds m_mutex.
+         */
+        void markRemoved(const std::uint32_t index)
+        {
+            SlotRecord& record = m_records[index];
+            record.slot->isLive.store(false);
+            m_removed.push_back(std::move(record.slot));
+            ++record.generation;
+            record.nextFree = m_freeHead;
+            m_freeHead = index;
+            --m_liveCount;
+        }
+
+        /// @brief Compact once removed slots outnumber live ones, so broadcast never walks more than twice the live count.
+        void compactIfSparse()
+        {
+            if (m_removed.size() >= kMinCapacity && m_removed.size() > m_liveCount)
+            {
+                compact(m_liveCount > 0 ? std::max(kMinCapacity, 2 * m_liveCount) : 0);
+            }
+        }
+
+        /**
+         * @brief Replace the current array with one holding only its live slots, in order, with room for @p capacity;
+         * with a capacity of 0 and nothing live the delegate is left without an array. The old array and the removed
+         * slots it held are retired. Caller holds m_mutex.
+         */
+        void compact(const size_t capacity)
+        {
+            std::unique_ptr<SlotArray> next;
+            if (capacity > 0)
+            {
+                next = std::make_unique<SlotArray>(capacity);
+                size_t count = 0;
+                if (m_array)
+                {
+                    const size_t size = m_array->size.load();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (m_array->slots[i]->isLive.load())
+                        {
+                            next->slots[count++] = m_array->slots[i];
+                        }
+                    }
+                }
+                next->size.store(count);
+            }
+
+            if (m_array)
+            {
+                m_retiredArrays.push_back(std::move(m_array));
+            }
+            m_retiredSlots.insert(
+                m_retiredSlots.end(), std::make_move_iterator(m_removed.begin()), std::make_move_iterator(m_removed.end()));
+            m_removed.clear();
+            m_released = 0;
+
+            m_array = std::move(next);
+            m_current.store(m_array.get());
+        }
+
+        /**
+         * @brief Free what no broadcast can be reading any more, if no broadcast is in progress.
+         * A broadcast counts itself in m_readers before loading m_current and a slot's live flag, and all three are
+         * sequentially consistent, so seeing no readers after a store means every later broadcast loads the new array
+         * and finds removed slots marked. Retired arrays and their slots are freed outright; removed slots still in the
+         * current array only have their callables released, since a later broadcast still reads their flag.
+         * Caller holds m_mutex.
+         */
+        void reclaim()
+        {
+            if (m_readers.load() != 0)
+            {
+                return;
+            }
+
+            m_retiredArrays.clear();
+            m_retiredSlots.clear();
+            for (; m_released < m_removed.size(); ++m_released)
+            {
+                m_removed[m_released]->call = nullptr;
+                m_removed[m_released]->expired = nullptr;
+            }
         }
 
         mutable std::mutex m_mutex;
-        std::vector<SlotBase> m_slots;
-        std::atomic<size_t> m_nextId{ 1 };
+        std::vector<SlotRecord> m_records; ///< The slot map; owns live slots.
+        std::uint32_t m_freeHead{ kNoIndex }; ///< First free entry of m_records, linked through nextFree.
+        size_t m_liveCount{ 0 };
+        std::unique_ptr<SlotArray> m_array; ///< Current array; only replaced under m_mutex.
+        std::vector<std::unique_ptr<SlotBase>> m_removed; ///< Removed slots the current array still points to.
+        size_t m_released{ 0 }; ///< Leading entries of m_removed whose callables have been released.
+        std::vector<std::unique_ptr<SlotArray>> m_retiredArrays; ///< Replaced arrays a broadcast may still be reading.
+        std::vector<std::unique_ptr<SlotBase>> m_retiredSlots; ///< Removed slots only replaced arrays point to.
+        std::atomic<const SlotArray*> m_current{ nullptr }; ///< m_array, read by broadcast() without the mutex.
+        std::atomic<size_t> m_readers{ 0 }; ///< Broadcasts in progress.
         std::shared_ptr<void> m_self{ std::make_shared<int>(0) };
     };
 
@@ -643,6 +823,17 @@ namespace reactormq::mqtt
      */
     using OnMessage = MulticastDelegate<void(const Message& message)>;
 
+    /**
+     * @brief Multicast delegate invoked with a non-owning view of each received message.
+     *
+     * Handlers run synchronously on the reactor thread, bypassing any callback executor, and the view is only valid
+     * until the handler returns. While at least one handler is bound, inbound PUBLISH packets are decoded without
+     * copying the topic or payload; OnMessage handlers still receive an owning copy.
+     *
+     * @param message The received message view.
+     */
+    using OnMessageView = MulticastDelegate<void(const MessageView& message)>;
+
     /**
      * @brief Multicast delegate invoked after a subscribe operation completes.
      *
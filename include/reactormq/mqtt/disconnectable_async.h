@@ -5,6 +5,8 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/drain_options.h"
 #include "reactormq/mqtt/result.h"
 
 #include <future>
@@ -26,5 +28,25 @@ namespace reactormq::mqtt
          * @return A future that resolves to the result of the disconnection.
          */
         virtual DisconnectFuture disconnectAsync() = 0;
+
+        /**
+         * @brief Disconnect from the MQTT broker and report the result to a handler instead of a future.
+         * @param onComplete Called with the result of the disconnection.
+         */
+        virtual void disconnectAsync(CompletionHandler<void> onComplete) = 0;
+
+        /**
+         * @brief Disconnect from the MQTT broker once outstanding work has drained, or its deadline has passed.
+         * @param drain What to wait for, and for how long.
+         * @return A future that resolves to the result of the disconnection.
+         */
+        virtual DisconnectFuture disconnectAsync(const DrainOptions& drain) = 0;
+
+        /**
+         * @brief Disconnect once outstanding work has drained, and report the result to a handler instead of a future.
+         * @param drain What to wait for, and for how long.
+         * @param onComplete Called with the result of the disconnection.
+         */
+        virtual void disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete) = 0;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
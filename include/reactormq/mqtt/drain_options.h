@@ -0,0 +1,26 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief How IDisconnectableAsync::disconnectAsync(const DrainOptions&) lets a connection finish its work before
+     * DISCONNECT. New publishes, subscribes and requests made while it drains fail; messages keep being received and
+     * acknowledged. DISCONNECT goes out as soon as the work is done, or when timeoutMs passes with some of it left.
+     */
+    struct DrainOptions
+    {
+        /// Also wait for the PUBACK or PUBCOMP of QoS 1/2 publishes in flight, and for the publishes held back by the
+        /// broker's Receive Maximum or an outbound rate limit to go out and be acknowledged. When false, only the bytes
+        /// already queued on the socket are flushed.
+        bool shouldWaitForAcknowledgements = true;
+
+        /// Most time the drain may take, in milliseconds; DISCONNECT is sent then whatever is outstanding.
+        uint32_t timeoutMs = 5000;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,31 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Reserve a client's working memory up front instead of growing it on demand, for long-running devices
+     * that need deterministic latency and no heap fragmentation.
+     *
+     * When the client is created, its in-flight table, packet IDs, inbound QoS 2 table, subscription table, outbound
+     * batches and a node for every command it may queue are reserved; each socket reserves its inbound ring at the
+     * max buffer size and its send queue at the max outbound queue bytes when it is created. Packet IDs are limited
+     * to 1 through the max pending commands, so the in-flight table never outgrows it. Size those limits for the
+     * device: the defaults (64 MiB of buffer, 10 MiB of outbound queue) are meant for servers. What the application
+     * hands over (topics, payloads, handlers) and each reconnect's socket are still allocated, once, when they are made.
+     * Builds configured with -DREACTORMQ_FIXED_CAPACITY=ON turn this on for every client.
+     */
+    struct FixedCapacityOptions
+    {
+        /// Reserve the client's memory when it is created.
+        bool isEnabled = false;
+
+        /// Subscriptions the subscription table holds without growing.
+        uint32_t maxSubscriptions = 64;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,217 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    /// @brief Default inline capacity of InlineFunction, enough for a lambda capturing a few pointers or a weak_ptr.
+    inline constexpr size_t kInlineFunctionCapacity = 48;
+
+    /**
+     * @brief Move-only callable wrapper that stores its target inline.
+     *
+     * A callable no larger than Capacity (and no more aligned than std::max_align_t, with a non-throwing move) is
+     * kept in the wrapper itself, so wrapping it never allocates; a larger one falls back to the heap. Invocation
+     * is a single indirect call. Like std::function, calling through a const wrapper may modify the target.
+     * @tparam Signature Function signature R(Args...).
+     * @tparam Capacity Bytes of inline storage.
+     */
+    template<class Signature, size_t Capacity = kInlineFunctionCapacity>
+    class InlineFunction;
+
+    template<class R, class... Args, size_t Capacity>
+    class InlineFunction<R(Args...), Capacity>
+    {
+        static_assert(Capacity >= sizeof(void*), "Capacity must hold at least a pointer for the heap fallback");
+
+    public:
+        InlineFunction() noexcept = default;
+
+        InlineFunction(std::nullptr_t) noexcept
+        {
+        }
+
+        /**
+         * @brief Wrap a callable.
+         * @tparam F Callable type compatible with R(Args...).
+         * @param f Callable to store; moved or copied into the wrapper.
+         */
+        template<class F>
+            requires(!std::is_same_v<std::decay_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InlineFunction(F&& f)
+        {
+            using Fn = std::decay_t<F>;
+            if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn>)
+            {
+                if (f == nullptr)
+                {
+                    return;
+                }
+            }
+
+            if constexpr (kFitsInline<Fn>)
+            {
+                ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(f));
+                m_invoke = &invokeInline<Fn>;
+                m_manage = &manageInline<Fn>;
+            }
+            else
+            {
+                ::new (static_cast<void*>(m_storage)) Fn*(new Fn(std::forward<F>(f)));
+                m_invoke = &invokeHeap<Fn>;
+                m_manage = &manageHeap<Fn>;
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept
+        {
+            moveFrom(other);
+        }
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        InlineFunction& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction()
+        {
+            reset();
+        }
+
+        /// @brief Whether a callable is stored.
+        explicit operator bool() const noexcept
+        {
+            return m_invoke != nullptr;
+        }
+
+        /**
+         * @brief Invoke the stored callable; it must not be empty.
+         * @param args Arguments forwarded to the callable.
+         * @return Whatever the callable returns.
+         */
+        R operator()(Args... args) const
+        {
+            return m_invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        /// @brief Whether a callable of this type is stored inline rather than on the heap.
+        template<class F>
+        static constexpr bool isStoredInline()
+        {
+            return kFitsInline<std::decay_t<F>>;
+        }
+
+    private:
+        enum class Operation
+        {
+            Move,
+            Destroy
+        };
+
+        using InvokeFn = R (*)(void* storage, Args&&... args);
+        using ManageFn = void (*)(Operation operation, void* storage, void* source) noexcept;
+
+        template<class Fn>
+        static constexpr bool kFitsInline
+            = sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>;
+
+        template<class Fn>
+        static R invokeTarget(Fn& fn, Args&&... args)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(fn, std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(fn, std::forward<Args>(args)...);
+            }
+        }
+
+        template<class Fn>
+        static R invokeInline(void* storage, Args&&... args)
+        {
+            return invokeTarget(*static_cast<Fn*>(storage), std::forward<Args>(args)...);
+        }
+
+        template<class Fn>
+        static R invokeHeap(void* storage, Args&&... args)
+        {
+            return invokeTarget(**static_cast<Fn**>(storage), std::forward<Args>(args)...);
+        }
+
+        template<class Fn>
+        static void manageInline(const Operation operation, void* storage, void* source) noexcept
+        {
+            if (operation == Operation::Move)
+            {
+                ::new (storage) Fn(std::move(*static_cast<Fn*>(source)));
+                static_cast<Fn*>(source)->~Fn();
+            }
+            else
+            {
+                static_cast<Fn*>(storage)->~Fn();
+            }
+        }
+
+        template<class Fn>
+        static void manageHeap(const Operation operation, void* storage, void* source) noexcept
+        {
+            if (operation == Operation::Move)
+            {
+                ::new (storage) Fn*(*static_cast<Fn**>(source));
+            }
+            else
+            {
+                delete *static_cast<Fn**>(storage);
+            }
+        }
+
+        void moveFrom(InlineFunction& other) noexcept
+        {
+            if (other.m_manage != nullptr)
+            {
+                other.m_manage(Operation::Move, m_storage, other.m_storage);
+                m_invoke = std::exchange(other.m_invoke, nullptr);
+                m_manage = std::exchange(other.m_manage, nullptr);
+            }
+        }
+
+        void reset() noexcept
+        {
+            if (m_manage != nullptr)
+            {
+                m_manage(Operation::Destroy, m_storage, nullptr);
+                m_invoke = nullptr;
+                m_manage = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) mutable std::byte m_storage[Capacity]{};
+        InvokeFn m_invoke = nullptr;
+        ManageFn m_manage = nullptr;
+    };
+} // namespace reactormq::mqtt
@@ -5,9 +5,14 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/ack_token.h"
 #include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/shared_payload.h"
+#include "reactormq/mqtt/shared_topic.h"
 
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <span>
 #include <string>
 #include <utility>
@@ -15,7 +20,12 @@
 
 namespace reactormq::mqtt
 {
-    /// @brief Immutable MQTT message with topic, payload, retain flag, and QoS.
+    /**
+     * @brief MQTT message with topic, payload, retain flag, and QoS.
+     * The payload is a SharedPayload, so copies of a message share its bytes instead of duplicating them. A received
+     * message on an interned topic holds a SharedTopic instead of its own copy of the topic string. A message has no
+     * setters; it can be assigned as a whole, so it relocates cheaply in containers.
+     */
     struct REACTORMQ_API Message final
     {
     public:
@@ -39,6 +49,36 @@ namespace reactormq::mqtt
         {
         }
 
+        /**
+         * @brief Construct a message that shares an existing payload buffer.
+         * @param topic Topic to publish to.
+         * @param payload Payload bytes (shared, not copied).
+         * @param shouldRetain Whether the broker should retain the message.
+         * @param qualityOfService The QoS level for delivery.
+         */
+        Message(std::string topic, SharedPayload payload, const bool shouldRetain, const QualityOfService qualityOfService) noexcept
+            : m_topic{ std::move(topic) }
+            , m_payload{ std::move(payload) }
+            , m_shouldRetain{ shouldRetain }
+            , m_qualityOfService{ qualityOfService }
+        {
+        }
+
+        /**
+         * @brief Construct a message around an interned topic and a shared payload buffer.
+         * @param topic Topic to publish to (shared, not copied).
+         * @param payload Payload bytes (shared, not copied).
+         * @param shouldRetain Whether the broker should retain the message.
+         * @param qualityOfService The QoS level for delivery.
+         */
+        Message(SharedTopic topic, SharedPayload payload, const bool shouldRetain, const QualityOfService qualityOfService) noexcept
+            : m_sharedTopic{ std::move(topic) }
+            , m_payload{ std::move(payload) }
+            , m_shouldRetain{ shouldRetain }
+            , m_qualityOfService{ qualityOfService }
+        {
+        }
+
         /**
          * @brief Construct a message from copied topic and payload.
          * @param topic Topic to publish to.
@@ -48,7 +88,7 @@ namespace reactormq::mqtt
          */
         Message(const std::string& topic, const Payload& payload, const bool shouldRetain, const QualityOfService qualityOfService) noexcept
             : m_topic{ topic }
-            , m_payload{ payload }
+            , m_payload{ Payload{ payload } }
             , m_shouldRetain{ shouldRetain }
             , m_qualityOfService{ qualityOfService }
         {
@@ -67,23 +107,48 @@ namespace reactormq::mqtt
             const bool shouldRetain,
             const QualityOfService qualityOfService) noexcept
             : m_topic{ std::move(topic) }
-            , m_payload{ payload.begin(), payload.end() }
+            , m_payload{ SharedPayload::copyOf(payload) }
             , m_shouldRetain{ shouldRetain }
             , m_qualityOfService{ qualityOfService }
         {
         }
 
+        /**
+         * @brief Construct a message that the application acknowledges itself, as delivered in manual
+         * acknowledgement mode.
+         * @param message Message to take the contents of.
+         * @param ackToken Token that acknowledges the message to the broker.
+         */
+        Message(Message&& message, AckToken ackToken) noexcept
+            : Message(std::move(message))
+        {
+            m_ackToken = std::move(ackToken);
+        }
+
+        /**
+         * @brief Construct a message stamped with the time it was received.
+         * @param message Message to take the contents of.
+         * @param timestampUtc Time to report from getTimestampUtc().
+         */
+        Message(Message&& message, const Clock::time_point timestampUtc) noexcept
+            : Message(std::move(message))
+        {
+            m_timestampUtc = timestampUtc;
+        }
+
         Message(const Message&) = default;
 
         Message(Message&&) noexcept = default;
 
-        Message& operator=(const Message&) = delete;
+        Message& operator=(const Message&) = default;
 
-        Message& operator=(Message&&) = delete;
+        Message& operator=(Message&&) noexcept = default;
 
         /**
-         * @brief Get the message creation timestamp in UTC.
-         * @return Timestamp when the message object was constructed.
+         * @brief Get the time the client received the message, in UTC.
+         * The clock is read once per reactor tick, so messages received in the same tick share a timestamp. Messages
+         * built by the application carry no timestamp and report the clock's epoch.
+         * @return Receive timestamp, or Clock::time_point{} when there is none.
          */
         [[nodiscard]] Clock::time_point getTimestampUtc() const noexcept
         {
@@ -96,16 +161,26 @@ namespace reactormq::mqtt
          */
         [[nodiscard]] const std::string& getTopic() const noexcept
         {
-            return m_topic;
+            return m_sharedTopic.isEmpty() ? m_topic : m_sharedTopic.get();
+        }
+
+        /**
+         * @brief Get the interned topic this message was received on.
+         * @return The shared topic; empty when the message owns its topic.
+         */
+        [[nodiscard]] const SharedTopic& getSharedTopic() const noexcept
+        {
+            return m_sharedTopic;
         }
 
         /**
          * @brief Get the message payload bytes.
+         * Copies once if the payload adopted caller memory; see SharedPayload::asVector().
          * @return Reference to the payload buffer.
          */
-        [[nodiscard]] const Payload& getPayload() const noexcept
+        [[nodiscard]] const Payload& getPayload() const
         {
-            return m_payload;
+            return m_payload.asVector();
         }
 
         /**
@@ -114,7 +189,16 @@ namespace reactormq::mqtt
          */
         [[nodiscard]] std::span<const std::uint8_t> getPayloadView() const noexcept
         {
-            return { m_payload.data(), m_payload.size() };
+            return m_payload.getView();
+        }
+
+        /**
+         * @brief Get the shared payload buffer, e.g. to build another message around the same bytes.
+         * @return The shared payload.
+         */
+        [[nodiscard]] const SharedPayload& getSharedPayload() const noexcept
+        {
+            return m_payload;
         }
 
         /**
@@ -135,11 +219,55 @@ namespace reactormq::mqtt
             return m_qualityOfService;
         }
 
+        /**
+         * @brief Give the message a lifetime: if it cannot be sent within this many seconds of being published, as when
+         * it waits in the offline queue or behind the broker's Receive Maximum, it is dropped unsent and its publish
+         * completes with Result::hasExpired(). On MQTT 5 the lifetime left is sent as the Message Expiry Interval, so
+         * the broker discards the message once it runs out as well.
+         * @param seconds Lifetime in seconds; 0 means the message does not expire.
+         */
+        void setMessageExpiryInterval(const std::uint32_t seconds) noexcept
+        {
+            m_messageExpiryInterval = seconds;
+        }
+
+        /**
+         * @brief Get the lifetime set with setMessageExpiryInterval().
+         * @return Lifetime in seconds, or nullopt when the message does not expire.
+         */
+        [[nodiscard]] std::optional<std::uint32_t> getMessageExpiryInterval() const noexcept
+        {
+            return m_messageExpiryInterval != 0 ? std::optional<std::uint32_t>(m_messageExpiryInterval) : std::nullopt;
+        }
+
+        /**
+         * @brief Get the token that acknowledges this message to the broker.
+         * Empty unless the message was delivered with manual acknowledgement enabled and carries a PUBACK or PUBCOMP.
+         * @return The acknowledgement token.
+         */
+        [[nodiscard]] const AckToken& getAckToken() const noexcept
+        {
+            return m_ackToken;
+        }
+
+        /**
+         * @brief Acknowledge this message to the broker; see AckToken::acknowledge().
+         * @return True if this call queued the acknowledgement.
+         */
+        bool acknowledge() const
+        {
+            return m_ackToken.acknowledge();
+        }
+
     private:
-        const Clock::time_point m_timestampUtc{ Clock::now() };
-        const std::string m_topic{};
-        const Payload m_payload{};
-        const bool m_shouldRetain{ false };
-        const QualityOfService m_qualityOfService{ QualityOfService::AtMostOnce };
+        // Not const: const members would turn the defaulted move constructor into a deep copy and forbid assignment.
+        Clock::time_point m_timestampUtc{};
+        std::string m_topic{};
+        SharedTopic m_sharedTopic{};
+        SharedPayload m_payload{};
+        bool m_shouldRetain{ false };
+        QualityOfService m_qualityOfService{ QualityOfService::AtMostOnce };
+        std::uint32_t m_messageExpiryInterval{ 0 };
+        AckToken m_ackToken{};
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
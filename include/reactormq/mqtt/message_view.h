@@ -0,0 +1,186 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/inline_function.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief One MQTT 5 property of a received message, read in place.
+     * Which fields are meaningful depends on the identifier's data type (MQTT 5 section 2.2.2.2); the others are
+     * zero or empty. Views are only valid for as long as the MessageView they came from.
+     */
+    struct MessageProperty final
+    {
+        /// @brief Property identifier, e.g. 0x26 for a User Property.
+        std::uint8_t identifier = 0;
+
+        /// @brief Value of a Byte, Two Byte Integer, Four Byte Integer or Variable Byte Integer property.
+        std::uint32_t integer = 0;
+
+        /// @brief Value of a UTF-8 string property, or the name of a User Property.
+        std::string_view string;
+
+        /// @brief Value of a User Property.
+        std::string_view value;
+
+        /// @brief Value of a Binary Data property.
+        std::span<const std::uint8_t> binary;
+    };
+
+    /**
+     * @brief Non-owning view of a received MQTT message.
+     *
+     * Topic and payload point into the client's receive buffer (or into a stored Message for QoS 2) and are only
+     * valid for the duration of the callback that receives the view. Copy into a Message with toMessage() to keep
+     * the data beyond that.
+     *
+     * MQTT 5 properties are not decoded up front: the view keeps the property block as received and the accessors
+     * below walk it when called, so handlers that ignore properties pay nothing for them.
+     */
+    struct REACTORMQ_API MessageView final
+    {
+    public:
+        MessageView() = default;
+
+        /**
+         * @brief Construct a view over externally owned topic and payload bytes.
+         * @param topic Topic the message was published to.
+         * @param payload Message payload bytes.
+         * @param shouldRetain Whether the message was retained by the broker.
+         * @param qualityOfService The QoS level the message was delivered with.
+         */
+        MessageView(
+            const std::string_view topic,
+            const std::span<const std::uint8_t> payload,
+            const bool shouldRetain,
+            const QualityOfService qualityOfService) noexcept
+            : m_topic{ topic }
+            , m_payload{ payload }
+            , m_shouldRetain{ shouldRetain }
+            , m_qualityOfService{ qualityOfService }
+        {
+        }
+
+        /**
+         * @brief Construct a view that also carries the message's MQTT 5 property block.
+         * @param topic Topic the message was published to.
+         * @param payload Message payload bytes.
+         * @param shouldRetain Whether the message was retained by the broker.
+         * @param qualityOfService The QoS level the message was delivered with.
+         * @param rawProperties Property block as on the wire, Property Length prefix included.
+         */
+        MessageView(
+            const std::string_view topic,
+            const std::span<const std::uint8_t> payload,
+            const bool shouldRetain,
+            const QualityOfService qualityOfService,
+            const std::span<const std::uint8_t> rawProperties) noexcept
+            : MessageView(topic, payload, shouldRetain, qualityOfService)
+        {
+            m_rawProperties = rawProperties;
+        }
+
+        /**
+         * @brief Construct a view over an owning message.
+         * @param message Message that must outlive the view.
+         */
+        explicit MessageView(const Message& message) noexcept
+            : MessageView(message.getTopic(), message.getPayloadView(), message.shouldRetain(), message.getQualityOfService())
+        {
+        }
+
+        /**
+         * @brief Get the message topic.
+         * @return View of the topic string.
+         */
+        [[nodiscard]] std::string_view getTopic() const noexcept
+        {
+            return m_topic;
+        }
+
+        /**
+         * @brief Get the message payload bytes.
+         * @return View of the payload bytes.
+         */
+        [[nodiscard]] std::span<const std::uint8_t> getPayload() const noexcept
+        {
+            return m_payload;
+        }
+
+        /**
+         * @brief Whether the broker retained this message.
+         * @return True if the retain flag is set.
+         */
+        [[nodiscard]] bool shouldRetain() const noexcept
+        {
+            return m_shouldRetain;
+        }
+
+        /**
+         * @brief Get the Quality of Service level for this message.
+         * @return The QoS level the message was delivered with.
+         */
+        [[nodiscard]] QualityOfService getQualityOfService() const noexcept
+        {
+            return m_qualityOfService;
+        }
+
+        /**
+         * @brief Get the MQTT 5 property block as received.
+         * @return Property block with its length prefix; empty for MQTT 3.1.1 and for messages delivered after PUBREL.
+         */
+        [[nodiscard]] std::span<const std::uint8_t> getRawProperties() const noexcept
+        {
+            return m_rawProperties;
+        }
+
+        /**
+         * @brief Call a visitor with each MQTT 5 property, in wire order.
+         * @param visitor Called once per property.
+         * @return False if the property block is malformed; properties before the fault have been visited.
+         */
+        bool forEachProperty(const InlineFunction<void(const MessageProperty&)>& visitor) const;
+
+        /**
+         * @brief Value of the first User Property with a name.
+         * @param name User Property name.
+         * @return The value, or nullopt when absent.
+         */
+        [[nodiscard]] std::optional<std::string_view> findUserProperty(std::string_view name) const;
+
+        /**
+         * @brief Get the Message Expiry Interval the broker forwarded.
+         * @return Remaining lifetime in seconds, or nullopt when the message does not expire.
+         */
+        [[nodiscard]] std::optional<std::uint32_t> getMessageExpiryInterval() const;
+
+        /**
+         * @brief Copy the viewed topic and payload into an owning message.
+         * Properties are not copied.
+         * @return Message that stays valid after the callback returns.
+         */
+        [[nodiscard]] Message toMessage() const
+        {
+            return Message{ std::string{ m_topic }, m_payload, m_shouldRetain, m_qualityOfService };
+        }
+
+    private:
+        std::string_view m_topic{};
+        std::span<const std::uint8_t> m_payload{};
+        std::span<const std::uint8_t> m_rawProperties{};
+        bool m_shouldRetain{ false };
+        QualityOfService m_qualityOfService{ QualityOfService::AtMostOnce };
+    };
+} // namespace reactormq::mqtt
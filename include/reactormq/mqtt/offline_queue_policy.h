@@ -0,0 +1,41 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief What happens to a publish made while the client is not connected and the offline queue is full.
+     */
+    enum class OfflineQueuePolicy : uint8_t
+    {
+        Reject = 0, ///< Fail the new publish; everything already queued is kept.
+        DropOldest = 1, ///< Fail the oldest queued publish to make room for the new one.
+        DropNewest = 2 ///< Fail the most recently queued publish to make room for the new one.
+    };
+
+    /**
+     * @brief Convert an offline queue policy to a human-readable string.
+     * @param policy Policy to convert.
+     * @return String view of the policy.
+     */
+    inline const char* offlineQueuePolicyToString(const OfflineQueuePolicy policy)
+    {
+        switch (policy)
+        {
+            using enum OfflineQueuePolicy;
+        case Reject:
+            return "Reject";
+        case DropOldest:
+            return "Drop oldest";
+        case DropNewest:
+            return "Drop newest";
+        default:
+            return "Invalid offline queue policy";
+        }
+    }
+} // namespace reactormq::mqtt
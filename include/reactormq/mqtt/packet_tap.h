@@ -0,0 +1,102 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "reactormq/export.h"
+
+namespace reactormq::mqtt
+{
+    /// @brief Which way bytes seen by an IPacketTap crossed the socket.
+    enum class PacketDirection : std::uint8_t
+    {
+        Received,
+        Sent,
+    };
+
+    /**
+     * @brief Observer of the raw MQTT bytes a client sends and receives, for diagnostics.
+     *
+     * A client without a tap pays one pointer test per send and per received packet. With one, onPacket() is called on
+     * the client's reactor thread for every complete packet the framing dispatches and for every write handed to the
+     * transport, with the MQTT bytes as they are before TLS or WebSocket framing and after it is removed. It runs in
+     * the I/O path, so it should copy what it needs and return; createPacketCapture() does exactly that.
+     */
+    class REACTORMQ_API IPacketTap
+    {
+    public:
+        virtual ~IPacketTap() = default;
+
+        /**
+         * @brief Bytes crossed the socket.
+         * @param direction Whether they were received or sent.
+         * @param parts The bytes, in order; valid for this call only. Received bytes are one packet, or one fragment of
+         * a PUBLISH over the inbound streaming threshold. Sent bytes are one write: a packet or a batch of them.
+         * @param originalSize Size of what the parts stand for; more than their total when a streamed payload is read
+         * from its source after the call and so is not in them.
+         */
+        virtual void onPacket(PacketDirection direction, std::span<const std::span<const std::uint8_t>> parts, size_t originalSize) = 0;
+    };
+
+    using PacketTapPtr = std::shared_ptr<IPacketTap>;
+
+    /// @brief File format written by createPacketCapture().
+    enum class PacketCaptureFormat : std::uint8_t
+    {
+        /// pcapng with link type USER0 (147) and each packet's direction in its flags; map USER0 to "mqtt" in
+        /// Wireshark's DLT_USER table to decode it.
+        Pcapng,
+        /// One JSON object per line: {"ts_us":..,"dir":"in"|"out","len":..,"hex":".."}.
+        JsonLines,
+        /// Compact binary records of direction, timestamp delta and bytes, which the replay benchmark
+        /// (tests/bench/bench_replay.cpp) feeds back through a client. Set snapLength to at least the largest packet;
+        /// packets cut short are not replayed.
+        Recording,
+    };
+
+    /// @brief Options for createPacketCapture().
+    struct PacketCaptureOptions
+    {
+        /// File to write; created or truncated.
+        std::string path;
+
+        PacketCaptureFormat format = PacketCaptureFormat::Pcapng;
+
+        /// Packets the ring holds between the reactor and the writer thread; rounded up to a power of two. When the
+        /// writer falls behind, further packets are dropped and counted rather than waited for.
+        std::uint32_t ringSlots = 1024;
+
+        /// Most bytes kept of each packet; the rest is cut off, and the original length still recorded.
+        std::uint32_t snapLength = 2048;
+    };
+
+    /// @brief An IPacketTap that writes what it sees to a file from its own thread.
+    class REACTORMQ_API IPacketCapture : public IPacketTap
+    {
+    public:
+        /// @brief Packets written to the file so far.
+        [[nodiscard]] virtual std::uint64_t getWrittenCount() const = 0;
+
+        /// @brief Packets dropped because the ring was full.
+        [[nodiscard]] virtual std::uint64_t getDroppedCount() const = 0;
+    };
+
+    using PacketCapturePtr = std::shared_ptr<IPacketCapture>;
+
+    /**
+     * @brief Capture a client's packets to a file, for ConnectionSettingsBuilder::setPacketTap().
+     * onPacket() copies up to snapLength bytes into a lock-free ring with one compare-exchange and returns; a writer
+     * thread formats and writes them, so capturing adds no system calls or formatting to the reactor. One capture may
+     * be shared by several clients. Destroying it writes what is still queued and closes the file.
+     * @param options Where and how to write.
+     * @return The capture; nullptr if the file could not be opened.
+     */
+    REACTORMQ_API PacketCapturePtr createPacketCapture(const PacketCaptureOptions& options);
+} // namespace reactormq::mqtt
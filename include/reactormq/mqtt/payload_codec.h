@@ -0,0 +1,77 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "reactormq/export.h"
+
+namespace reactormq::mqtt
+{
+    /// Key of the MQTT 5 User Property that names the codec a PUBLISH payload was encoded with.
+    inline constexpr std::string_view kPayloadCodecPropertyKey = "payload-codec";
+
+    /**
+     * @brief Transform applied to PUBLISH payloads on the wire, such as compression, for MQTT 5 connections.
+     *
+     * Outbound messages are encoded on the reactor thread and sent with a "payload-codec" User Property naming the
+     * codec; received PUBLISHes that carry the property are decoded before any handler sees them, so applications
+     * always deal in plain payloads. A codec may be shared by several clients, each calling it from its own reactor
+     * thread, so both methods must be safe to call concurrently.
+     */
+    class REACTORMQ_API IPayloadCodec
+    {
+    public:
+        virtual ~IPayloadCodec() = default;
+
+        /**
+         * @brief Name sent in the User Property; the receiving side looks its codec up by it.
+         * @return A short ASCII name such as "zstd".
+         */
+        [[nodiscard]] virtual std::string_view getName() const = 0;
+
+        /**
+         * @brief Encode a payload.
+         * @param payload Plain payload.
+         * @param out Receives the encoded payload.
+         * @return False to send the payload plain instead.
+         */
+        virtual bool encode(std::span<const std::uint8_t> payload, std::vector<std::uint8_t>& out) const = 0;
+
+        /**
+         * @brief Decode a received payload.
+         * @param payload Encoded payload.
+         * @param maxSize Largest plain payload to accept; larger ones must fail.
+         * @param out Receives the plain payload.
+         * @return False if the payload cannot be decoded; the message is dropped.
+         */
+        virtual bool decode(std::span<const std::uint8_t> payload, size_t maxSize, std::vector<std::uint8_t>& out) const = 0;
+    };
+
+    using PayloadCodecPtr = std::shared_ptr<const IPayloadCodec>;
+
+    /// @brief A codec and the topics it encodes outbound messages for.
+    struct PayloadCodecBinding
+    {
+        /// Topic filter, with '+' and '#' wildcards, selecting the outbound messages to encode.
+        std::string topicFilter;
+
+        /// Codec for those messages; also decodes inbound messages that name it.
+        PayloadCodecPtr codec;
+    };
+
+    /**
+     * @brief Built-in codec that compresses payloads with zlib, named "deflate".
+     * @param level zlib compression level, 1 (fastest) to 9 (smallest).
+     * @return The codec, or nullptr in builds without REACTORMQ_WITH_ZLIB.
+     */
+    REACTORMQ_API PayloadCodecPtr createDeflatePayloadCodec(int level = 6);
+} // namespace reactormq::mqtt
@@ -0,0 +1,52 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/message_view.h"
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Receiver of a subscription's large messages, handed the payload chunk by chunk as it arrives.
+     *
+     * Messages over ConnectionSettings::getInboundStreamingThreshold() are not gathered into one buffer: the socket
+     * passes their bytes on as they are read, so receiving one holds a receive buffer's worth at most. For each message
+     * the sink sees onBegin(), then onChunk() until the whole payload has been passed, then onEnd(). Payload codecs
+     * do not apply; the payload arrives as it was sent. All methods are called on the client's reactor thread.
+     */
+    class REACTORMQ_API IPayloadSink
+    {
+    public:
+        virtual ~IPayloadSink() = default;
+
+        /**
+         * @brief A message starts.
+         * @param header Topic, retain flag, QoS and MQTT 5 properties; its payload is empty. Valid for this call only.
+         * @param payloadSize Total payload size the chunks will add up to.
+         */
+        virtual void onBegin(const MessageView& header, size_t payloadSize) = 0;
+
+        /**
+         * @brief The next payload bytes, in order.
+         * @param chunk Bytes in the receive buffer; valid for this call only.
+         */
+        virtual void onChunk(std::span<const std::uint8_t> chunk) = 0;
+
+        /**
+         * @brief The message ended.
+         * @param isComplete True once the whole payload was passed on. False when the connection closed first; a
+         * QoS 1/2 message is then sent again from the start on the next connection.
+         */
+        virtual void onEnd(bool isComplete) = 0;
+    };
+
+    using PayloadSinkPtr = std::shared_ptr<IPayloadSink>;
+} // namespace reactormq::mqtt
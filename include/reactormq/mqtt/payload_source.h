@@ -0,0 +1,82 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/shared_payload.h"
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Payload of known length that a streamed publish pulls in chunks while the connection takes them.
+     *
+     * The socket reads the next chunk only once the previous ones have gone to the transport, so sending a payload
+     * costs a few socket buffers instead of the whole payload. All methods are called on the client's reactor thread.
+     */
+    class REACTORMQ_API IPayloadSource
+    {
+    public:
+        virtual ~IPayloadSource() = default;
+
+        /**
+         * @brief Total payload size; fixed, since the PUBLISH header carries it before any payload byte.
+         * @return Size in bytes.
+         */
+        [[nodiscard]] virtual size_t getSize() const = 0;
+
+        /**
+         * @brief Copy the next payload bytes.
+         * @param out Buffer to fill; never larger than what is left of the payload.
+         * @return Bytes copied. Fewer than out.size() only when the source failed, which closes the connection, since
+         * a PUBLISH cannot be cut short once its header is sent.
+         */
+        virtual size_t read(std::span<std::uint8_t> out) = 0;
+
+        /**
+         * @brief Start over from the first byte, so a QoS 1/2 publish can be sent again after a reconnect.
+         * @return False if the source cannot be read again; the publish then fails instead of being resent.
+         */
+        virtual bool rewind()
+        {
+            return false;
+        }
+    };
+
+    using PayloadSourcePtr = std::shared_ptr<IPayloadSource>;
+
+    /// @brief Reader for createPayloadSource(): fills the buffer with the next bytes and returns how many it copied.
+    using PayloadReader = std::function<size_t(std::span<std::uint8_t> out)>;
+
+    /**
+     * @brief Source over a reader callback, for payloads produced on the fly.
+     * @param size Total payload size.
+     * @param reader Copies the next bytes; see IPayloadSource::read().
+     * @param rewind Restarts the reader from the first byte and returns true, or nullptr if it cannot.
+     * @return The source.
+     */
+    REACTORMQ_API PayloadSourcePtr createPayloadSource(size_t size, PayloadReader reader, std::function<bool()> rewind = nullptr);
+
+    /**
+     * @brief Source over bytes already in memory, such as a memory-mapped file adopted with SharedPayload::adopt().
+     * The payload is never duplicated; each chunk is copied out of it only as the connection takes it. Rewindable.
+     * @param payload The payload.
+     * @return The source.
+     */
+    REACTORMQ_API PayloadSourcePtr createPayloadSource(SharedPayload payload);
+
+    /**
+     * @brief Source that reads a file as it is sent. Rewindable.
+     * @param path Path of the file; its size when opened is the payload size.
+     * @return The source, or nullptr if the file cannot be opened.
+     */
+    REACTORMQ_API PayloadSourcePtr createFilePayloadSource(const std::string& path);
+} // namespace reactormq::mqtt
@@ -0,0 +1,71 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief A named set of tuning knobs for a kind of workload, applied with ConnectionSettingsBuilder::applyProfile().
+     *
+     * Every profile sets the same knobs: outbound coalescing, the per-tick inbound and command budgets, socket options,
+     * busy polling, the inbound buffer, packet and queue sizes, the packet arena, TLS tuning, callback batching,
+     * dispatch lanes and publish encoding. A knob a profile has no opinion on goes back to its default, so applying one
+     * profile after another leaves nothing of the first. tests/bench/bench_profiles.cpp measures each profile against
+     * Default on the workload it is meant for.
+     */
+    enum class PerformanceProfile : uint8_t
+    {
+        /// The builder's defaults.
+        Default = 0,
+
+        /// Small messages that must arrive soon: every packet is written as it is produced instead of coalesced until
+        /// the end of the tick, the socket acknowledges at once and busy-polls (SocketOptions::lowLatency()), and TLS
+        /// records start small. The reactor does not spin, since that costs a core; add setBusyPoll() on a core of
+        /// its own.
+        LowLatency = 1,
+
+        /// Bulk telemetry: writes coalesce up to 256 KiB or 2 ms, 4 MiB kernel socket buffers, full-size TLS records, a
+        /// 256 KiB packet arena, 1000 inbound packets per tick, and small publishes encoded on the publishing thread.
+        /// Handlers stay on one thread; add setMessageDispatchLanes() once they are safe to run concurrently.
+        HighThroughput = 2,
+
+        /// Constrained devices: 256 KiB packets in a buffer of at most 512 KiB, a 256 KiB outbound queue, 4 KiB write
+        /// coalescing and packet arena, 2 KiB TLS fragments asked of the broker, and 16 inbound packets and commands
+        /// per tick.
+        Embedded = 3,
+
+        /// A client ticked from a game loop: each tick handles at most 64 inbound packets in 1 ms and 64 commands in
+        /// 0.5 ms, so a flood or a burst of publishes spreads over frames, and a tick's callbacks reach the
+        /// CallbackExecutor as one task.
+        GameThread = 4
+    };
+
+    /**
+     * @brief Convert a performance profile to a human-readable string.
+     * @param profile Profile to convert.
+     * @return String view of the profile.
+     */
+    inline const char* performanceProfileToString(const PerformanceProfile profile)
+    {
+        switch (profile)
+        {
+            using enum PerformanceProfile;
+        case Default:
+            return "Default";
+        case LowLatency:
+            return "LowLatency";
+        case HighThroughput:
+            return "HighThroughput";
+        case Embedded:
+            return "Embedded";
+        case GameThread:
+            return "GameThread";
+        default:
+            return "Invalid performance profile";
+        }
+    }
+} // namespace reactormq::mqtt
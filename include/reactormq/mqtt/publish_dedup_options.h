@@ -0,0 +1,34 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Suppression of publishes that repeat what the broker already has, such as retained state a device
+     * republishes every few seconds whether or not it changed.
+     *
+     * The client keeps a 64-bit hash of the last payload sent on each topic. A publish whose payload, QoS and retain
+     * flag match the last one sent on its topic is not sent; it completes successfully at once. Once refreshIntervalMs
+     * has passed since a topic was last sent, the next publish goes out even if unchanged, and the hashes are cleared on
+     * every new connection, so a broker that lost the state gets it again.
+     */
+    struct PublishDedupOptions
+    {
+        /// Suppress unchanged publishes.
+        bool isEnabled = false;
+
+        /// Only retained publishes are compared; others, which may be events that repeat on purpose, always go out.
+        bool isRetainedOnly = true;
+
+        /// Most topics with a remembered hash; once this many are held the client starts over.
+        uint32_t maxTopics = 1024;
+
+        /// Time after which an unchanged payload is sent again; 0 suppresses repeats until the next connection.
+        uint32_t refreshIntervalMs = 60000;
+    };
+} // namespace reactormq::mqtt
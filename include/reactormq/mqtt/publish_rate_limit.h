@@ -0,0 +1,47 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief What happens to a publish that arrives while its rate limit is used up.
+     */
+    enum class RateLimitAction : uint8_t
+    {
+        CoalesceLatest = 0, ///< Hold it until the limit allows; a newer publish on the same topic replaces a held one.
+        Reject = 1 ///< Fail it at once.
+    };
+
+    /**
+     * @brief Token-bucket limit on outbound publishes, for a topic prefix or for the whole client.
+     *
+     * Each limit refills at its rate and holds up to burstMs worth of it, so a producer that was quiet may send a
+     * short burst at once. A publish is governed by the limit with the longest prefix its topic starts with, and by
+     * the client-wide limit (an empty prefix) as well; it goes out only when both allow it. Publishes held under
+     * CoalesceLatest go out oldest topic first as the buckets refill, each carrying the newest value published on its
+     * topic, and the ones they replaced fail.
+     */
+    struct PublishRateLimit
+    {
+        /// Topics the limit applies to, by leading characters; empty for every publish of the client.
+        std::string topicPrefix;
+
+        /// Most publishes per second; 0 for no limit on the count.
+        uint32_t messagesPerSecond = 0;
+
+        /// Most topic and payload bytes per second; 0 for no limit on the volume.
+        uint32_t bytesPerSecond = 0;
+
+        /// Size of the burst allowance, as time at the full rate.
+        uint32_t burstMs = 1000;
+
+        /// What happens to a publish over the limit.
+        RateLimitAction action = RateLimitAction::CoalesceLatest;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,92 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Writable payload buffer for one publish, for serialising a message in place instead of copying it in.
+     *
+     * Get one from IPublishableAsync::allocatePublish(), write the payload into getPayload() (a FlatBuffers or
+     * protobuf serialiser can target it directly), then commit() it and publish the message. The buffer comes from
+     * the client's memory resource, so a pooling resource recycles it, and room for the PUBLISH header is reserved in
+     * front of the payload: a payload of 512 bytes or more is sent with its header as one region and never copied.
+     * The payload starts 16-byte aligned. Move-only; not thread-safe until committed.
+     */
+    class REACTORMQ_API PublishReservation final
+    {
+    public:
+        /// @brief Alignment of the first payload byte.
+        static constexpr size_t kPayloadAlignment = 16;
+
+        PublishReservation() = default;
+
+        /**
+         * @brief Reserve a buffer for a publish.
+         * @param topic Topic to publish to.
+         * @param payloadCapacity Most payload bytes the application may write.
+         * @param qualityOfService Quality of service of the message.
+         * @param shouldRetain Whether the broker should retain the message.
+         * @param resource Memory resource to allocate the buffer and its bookkeeping from; must outlive the message.
+         */
+        PublishReservation(
+            std::string topic,
+            size_t payloadCapacity,
+            QualityOfService qualityOfService,
+            bool shouldRetain,
+            std::pmr::memory_resource* resource = std::pmr::new_delete_resource());
+
+        PublishReservation(PublishReservation&&) noexcept = default;
+        PublishReservation& operator=(PublishReservation&&) noexcept = default;
+        PublishReservation(const PublishReservation&) = delete;
+        PublishReservation& operator=(const PublishReservation&) = delete;
+
+        /// @brief Where to write the payload; empty once committed.
+        [[nodiscard]] std::span<std::uint8_t> getPayload() const noexcept
+        {
+            return m_block ? std::span<std::uint8_t>{ m_block.get() + m_headroom, m_capacity } : std::span<std::uint8_t>{};
+        }
+
+        /// @brief Topic the message will be published to.
+        [[nodiscard]] const std::string& getTopic() const noexcept
+        {
+            return m_topic;
+        }
+
+        /**
+         * @brief Turn the written bytes into a message that shares the buffer, and leave this reservation empty.
+         * @param payloadSize Bytes written at the start of getPayload(); clamped to the capacity.
+         * @return Message to pass to IPublishableAsync::publish() or publishAsync().
+         */
+        [[nodiscard]] Message commit(size_t payloadSize);
+
+        /**
+         * @brief Bytes reserved in front of the payload for a PUBLISH header to a topic.
+         * @param topicSize Topic length in bytes.
+         * @return Headroom, a multiple of kPayloadAlignment.
+         */
+        [[nodiscard]] static size_t getHeadroom(size_t topicSize) noexcept;
+
+    private:
+        std::string m_topic;
+        std::shared_ptr<std::uint8_t> m_block;
+        std::pmr::memory_resource* m_resource = nullptr;
+        size_t m_headroom = 0;
+        size_t m_capacity = 0;
+        QualityOfService m_qualityOfService = QualityOfService::AtMostOnce;
+        bool m_shouldRetain = false;
+    };
+} // namespace reactormq::mqtt
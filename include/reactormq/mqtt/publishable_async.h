@@ -5,14 +5,24 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/chunked_transfer.h"
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/payload_source.h"
+#include "reactormq/mqtt/publish_reservation.h"
 #include "reactormq/mqtt/result.h"
 
 #include <future>
+#include <string>
+#include <vector>
 
 namespace reactormq::mqtt
 {
     using PublishFuture = std::future<Result<void>>;
 
+    /// @brief Called with the outcome of a publish; see CompletionHandler.
+    using PublishCallback = CompletionHandler<void>;
+
     /**
      * @brief Interface for a client that can publish messages.
      */
@@ -27,5 +37,86 @@ namespace reactormq::mqtt
          * @return A future that resolves to a Result<void> indicating success.
          */
         virtual PublishFuture publishAsync(Message&& message) = 0;
+
+        /**
+         * @brief Publish several messages, in order, as one command behind one future.
+         * Cheaper than a publishAsync() per message for high-rate streams: the batch crosses to the reactor thread
+         * once, and its publishes are written back to back in the same tick.
+         * @param messages The messages to publish (moved).
+         * @return A future that resolves once every message has completed: success only if all of them succeeded.
+         */
+        virtual PublishFuture publishBatchAsync(std::vector<Message>&& messages) = 0;
+
+        /**
+         * @brief Publish several messages as one command and report the aggregate result to a handler.
+         * @param messages The messages to publish (moved).
+         * @param onComplete Called once every message has completed: success only if all of them succeeded.
+         */
+        virtual void publishBatchAsync(std::vector<Message>&& messages, PublishCallback onComplete) = 0;
+
+        /**
+         * @brief Publish a message without being told the outcome.
+         * No promise or future is created, so a QoS 0 publish costs no allocation beyond the message itself.
+         * @param message The message to publish (moved).
+         */
+        virtual void publish(Message&& message) = 0;
+
+        /**
+         * @brief Publish a message and have a callback told the outcome instead of a future.
+         * @param message The message to publish (moved).
+         * @param onComplete Called once the publish has completed; see CompletionHandler.
+         */
+        virtual void publish(Message&& message, PublishCallback onComplete) = 0;
+
+        /**
+         * @brief Publish a payload read from a source while the connection takes it, for payloads too large to hold.
+         * The socket pulls a chunk at a time once everything queued ahead of the PUBLISH has been written, so memory
+         * stays at a few chunks however large the payload. Payload codecs and session stores do not apply, and the
+         * retry timer does not resend it on MQTT 3.1.1; after a reconnect a QoS 1/2 publish is resent only if the
+         * source can be rewound, and fails otherwise.
+         * @param topic Topic to publish to.
+         * @param source Payload; read on the client's reactor thread.
+         * @param qualityOfService Quality of service.
+         * @param shouldRetain Whether the broker should retain the message.
+         * @param onComplete Called once the publish has completed; see CompletionHandler.
+         */
+        virtual void publishStream(
+            std::string topic,
+            PayloadSourcePtr source,
+            QualityOfService qualityOfService,
+            bool shouldRetain,
+            PublishCallback onComplete) = 0;
+
+        /**
+         * @brief Publish a payload larger than the broker accepts in one PUBLISH as a chunked transfer: a run of
+         * PUBLISHes to @p topic, each sized for the broker's Maximum Packet Size and starting with a small header (see
+         * kChunkHeaderSize), with at most options.window unacknowledged at once. A client subscribed with
+         * ISubscribableAsync::subscribeChunked() passes the payload to its sink as the chunks arrive, so neither end
+         * holds more than a window of chunks. Other subscribers receive the chunks as ordinary messages.
+         * @param topic Topic to publish every chunk to.
+         * @param source Payload; read on the client's reactor thread as the window opens. Need not be rewindable.
+         * @param options Chunk size, window and quality of service.
+         * @param onComplete Called once every chunk has completed, or with the first chunk's error.
+         */
+        virtual void publishChunked(
+            std::string topic,
+            PayloadSourcePtr source,
+            const ChunkedTransferOptions& options,
+            PublishCallback onComplete) = 0;
+
+        /**
+         * @brief Reserve a payload buffer to serialise a message into, so its bytes are written once and sent as they
+         * are; see PublishReservation. Commit it and publish the message like any other.
+         * @param topic Topic to publish to.
+         * @param payloadSize Most payload bytes that will be written.
+         * @param qualityOfService Quality of service.
+         * @param shouldRetain Whether the broker should retain the message.
+         * @return The reservation, allocated from ConnectionSettings::getMemoryResource().
+         */
+        [[nodiscard]] virtual PublishReservation allocatePublish(
+            std::string topic,
+            size_t payloadSize,
+            QualityOfService qualityOfService,
+            bool shouldRetain) = 0;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
@@ -0,0 +1,52 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/connection_settings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Pool of event-loop threads that drive many MQTT clients.
+     * Clients created through the group are sharded across its threads; each thread ticks its clients and sleeps
+     * until the nearest timer deadline or a command from any of them wakes it. Unless rebalancing is turned off, a
+     * client may move to another thread between two of its ticks when the load is skewed (see RebalanceOptions).
+     * Do not call tick() or waitAndTick() on a client owned by a group.
+     */
+    class REACTORMQ_API IReactorGroup
+    {
+    public:
+        virtual ~IReactorGroup() = default;
+
+        /**
+         * @brief Create a client and assign it to the least-loaded thread.
+         * The client is driven until it is released by the caller or the group is stopped.
+         * @param settings Connection settings for the client.
+         * @return Shared pointer to the client interface.
+         */
+        virtual std::shared_ptr<IClient> createClient(const ConnectionSettingsPtr& settings) = 0;
+
+        /// @brief Number of event-loop threads.
+        [[nodiscard]] virtual size_t getThreadCount() const = 0;
+
+        /// @brief Number of live clients currently driven by the group.
+        [[nodiscard]] virtual size_t getClientCount() const = 0;
+
+        /// @brief Number of times a client was moved to another thread to even out the load.
+        [[nodiscard]] virtual std::uint64_t getMigrationCount() const = 0;
+
+        /**
+         * @brief Stop and join all event-loop threads.
+         * Clients stay valid but are no longer ticked. Called automatically on destruction.
+         */
+        virtual void stop() = 0;
+    };
+} // namespace reactormq::mqtt
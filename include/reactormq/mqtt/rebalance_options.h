@@ -0,0 +1,32 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief How a reactor group moves clients between its threads when their load is skewed.
+     * Each thread times the ticks of its clients over a window. When its busy share of the window stays ahead of the
+     * least busy thread's for several windows in a row, it hands that thread the costliest client whose move narrows
+     * the gap, between two ticks, together with its socket's poller registration. A single client too hot for one
+     * thread stays put; the clients sharing its thread are moved away from it instead.
+     */
+    struct RebalanceOptions
+    {
+        /// Move clients between threads; off keeps each client on the thread it was created on.
+        bool isEnabled = true;
+
+        /// Length of one measurement window, in milliseconds.
+        uint32_t windowMs = 250;
+
+        /// Windows in a row a thread must stay ahead of the least busy one before it hands a client over.
+        uint32_t imbalancedWindows = 4;
+
+        /// Smallest gap in busy share, in percent of a window, that counts as an imbalance.
+        uint32_t minImbalancePercent = 20;
+    };
+} // namespace reactormq::mqtt
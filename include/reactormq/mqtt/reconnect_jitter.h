@@ -0,0 +1,42 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief How the delay before each automatic reconnect attempt is randomised.
+     */
+    enum class ReconnectJitter : uint8_t
+    {
+        /// Exponential delays (initial delay times the multiplier per attempt, up to the maximum), each within ±10%.
+        Proportional = 0,
+
+        /// Each delay drawn between the initial delay and three times the previous one, up to the maximum. Clients that
+        /// dropped together drift apart instead of retrying in waves; the multiplier is not used.
+        Decorrelated = 1
+    };
+
+    /**
+     * @brief Convert a reconnect jitter mode to a human-readable string.
+     * @param jitter Mode to convert.
+     * @return String view of the mode.
+     */
+    inline const char* reconnectJitterToString(const ReconnectJitter jitter)
+    {
+        switch (jitter)
+        {
+            using enum ReconnectJitter;
+        case Proportional:
+            return "Proportional";
+        case Decorrelated:
+            return "Decorrelated";
+        default:
+            return "Invalid reconnect jitter";
+        }
+    }
+} // namespace reactormq::mqtt
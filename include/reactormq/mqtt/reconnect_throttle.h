@@ -0,0 +1,72 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Token bucket that admits automatic reconnect attempts at a bounded rate, shared by every client whose
+     * settings hold the same instance (ConnectionSettingsBuilder::setReconnectThrottle()).
+     *
+     * When a broker restarts, a fleet of clients in one process would otherwise reconnect together and queue up on its
+     * TLS termination. Each attempt reserves the next free slot: up to the burst size go at once, the rest are spaced
+     * at the configured rate in the order they asked, so no client polls for a token and none starves. User-initiated
+     * connects are not throttled. Safe to use from any thread.
+     */
+    class ReconnectThrottle final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Create a throttle.
+         * @param attemptsPerSecond Sustained connect attempts per second; 0 is treated as 1.
+         * @param burst Attempts allowed back to back after a quiet period; 0 is treated as 1.
+         */
+        explicit ReconnectThrottle(const double attemptsPerSecond, const std::uint32_t burst = 1)
+            : m_interval(std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<double>(1.0 / (attemptsPerSecond > 0.0 ? attemptsPerSecond : 1.0))))
+            , m_burst(std::max<std::uint32_t>(burst, 1))
+        {
+        }
+
+        /**
+         * @brief Reserve the next connect slot.
+         * @param now Current time.
+         * @return When the attempt may start; now if a slot is free.
+         */
+        [[nodiscard]] Clock::time_point reserve(const Clock::time_point now)
+        {
+            const std::lock_guard lock(m_mutex);
+
+            // A quiet bucket refills to the burst size and no further, so an idle period does not bank more slots.
+            const Clock::time_point earliest = now - m_interval * (m_burst - 1);
+            m_next = std::max(m_next, earliest);
+            const Clock::time_point admittedAt = std::max(m_next, now);
+            m_next += m_interval;
+            return admittedAt;
+        }
+
+        /// @brief Time between attempts once the burst is used up.
+        [[nodiscard]] Clock::duration getInterval() const
+        {
+            return m_interval;
+        }
+
+    private:
+        const Clock::duration m_interval;
+        const std::uint32_t m_burst;
+        std::mutex m_mutex;
+        Clock::time_point m_next{};
+    };
+
+    using ReconnectThrottlePtr = std::shared_ptr<ReconnectThrottle>;
+} // namespace reactormq::mqtt
@@ -0,0 +1,56 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/result.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    using RequestFuture = std::future<Result<Message>>;
+
+    /**
+     * @brief Interface for a client that can make MQTT 5 requests and wait for their responses.
+     *
+     * A request is a QoS 0 PUBLISH carrying a Response Topic and Correlation Data. The client subscribes to one
+     * response topic of its own the first time it makes a request, and the responder is expected to publish its answer
+     * there with the Correlation Data copied back. Responses complete their request without passing through
+     * OnMessage or subscription handlers.
+     */
+    class REACTORMQ_API IRequestableAsync
+    {
+    public:
+        virtual ~IRequestableAsync() = default;
+
+        /**
+         * @brief Publish a request and resolve with its response.
+         * @param topic Topic the responder listens on.
+         * @param payload Request payload (moved).
+         * @param timeout How long to wait for the response.
+         * @return A future resolving to the response, or to a failure when the request could not be sent, the
+         * connection is not MQTT 5, or no response came in time.
+         */
+        virtual RequestFuture requestAsync(std::string topic, std::vector<std::uint8_t> payload, std::chrono::milliseconds timeout) = 0;
+
+        /**
+         * @brief Publish a request and report its response to a handler instead of a future.
+         * @param topic Topic the responder listens on.
+         * @param payload Request payload (moved).
+         * @param timeout How long to wait for the response.
+         * @param onComplete Called with the response or the failure, as for the future overload.
+         */
+        virtual void requestAsync(
+            std::string topic, std::vector<std::uint8_t> payload, std::chrono::milliseconds timeout, CompletionHandler<Message> onComplete)
+            = 0;
+    };
+} // namespace reactormq::mqtt
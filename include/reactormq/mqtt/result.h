@@ -4,12 +4,121 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace reactormq::mqtt
 {
     /**
-     * @brief Result type that carries a success flag and an optional value.
+     * @brief Why an operation failed.
+     *
+     * A failed Result carries one of these rather than a string, so completing an operation with a failure costs no
+     * more than completing it with success, which matters when the client is rejecting work because it is overloaded.
+     */
+    enum class ResultError : std::uint8_t
+    {
+        None, ///< The operation succeeded.
+        Unspecified, ///< Failed without saying why.
+        NotConnected, ///< The client was not connected.
+        Closing, ///< The client was shutting down.
+        PendingCommandsLimit, ///< Too many commands were waiting for the broker.
+        PendingRequestsLimit, ///< Too many requests were waiting for a response.
+        PacketIdsExhausted, ///< Every packet identifier was in use.
+        OutboundQueueFull, ///< The outbound queue had no room for the packet.
+        OfflineQueueFull, ///< The offline queue had no room for the publish.
+        DroppedFromOfflineQueue, ///< Evicted from the offline queue to make room for a newer publish.
+        RateLimited, ///< Over the publish rate limit.
+        Superseded, ///< Replaced by a newer publish to the same topic before it was sent.
+        Expired, ///< The Message Expiry Interval ran out before the publish was sent.
+        TimedOut, ///< No reply from the broker in time.
+        InvalidTopicName, ///< The topic name was empty, too long or contained wildcards.
+        InvalidTopicFilter, ///< A topic filter was malformed.
+        PacketTooLarge, ///< The packet would exceed the maximum packet size.
+        PayloadSourceFailed, ///< The payload source could not supply the payload.
+        UnsupportedByProtocol, ///< Not available in the negotiated MQTT version.
+        MalformedPacket, ///< The broker sent a packet that could not be decoded.
+        ProtocolViolation, ///< The broker sent a packet it should not have sent.
+        ConnectionFailed, ///< The transport could not connect.
+        ConnectionRefused, ///< The broker refused the connection.
+        ConnectionLost, ///< The connection dropped before the operation completed.
+        AuthenticationFailed, ///< The broker rejected the authentication exchange.
+        NotConfigured, ///< Something the operation needs was not configured.
+        Cancelled, ///< Abandoned because its owner went away.
+        PartialFailure, ///< Part of a batched or fanned-out operation failed.
+    };
+
+    /**
+     * @brief Static description of an error.
+     * @param error Error to describe.
+     * @return Null-terminated text with static storage duration.
+     */
+    [[nodiscard]] constexpr const char* resultErrorToString(const ResultError error) noexcept
+    {
+        switch (error)
+        {
+            using enum ResultError;
+        case None:
+            return "No error";
+        case Unspecified:
+            return "Unspecified failure";
+        case NotConnected:
+            return "Not connected";
+        case Closing:
+            return "Client is closing";
+        case PendingCommandsLimit:
+            return "Max pending commands limit exceeded";
+        case PendingRequestsLimit:
+            return "Too many pending requests";
+        case PacketIdsExhausted:
+            return "Packet ID pool exhausted";
+        case OutboundQueueFull:
+            return "Outbound queue full";
+        case OfflineQueueFull:
+            return "Offline queue full";
+        case DroppedFromOfflineQueue:
+            return "Dropped from offline queue";
+        case RateLimited:
+            return "Publish rate limit exceeded";
+        case Superseded:
+            return "Replaced by a newer publish";
+        case Expired:
+            return "Message expired before it was sent";
+        case TimedOut:
+            return "Timed out";
+        case InvalidTopicName:
+            return "Invalid topic name";
+        case InvalidTopicFilter:
+            return "Invalid topic filter";
+        case PacketTooLarge:
+            return "Packet too large";
+        case PayloadSourceFailed:
+            return "Payload source failed";
+        case UnsupportedByProtocol:
+            return "Not supported by the MQTT version in use";
+        case MalformedPacket:
+            return "Malformed packet from broker";
+        case ProtocolViolation:
+            return "Unexpected packet from broker";
+        case ConnectionFailed:
+            return "Connection failed";
+        case ConnectionRefused:
+            return "Connection refused by broker";
+        case ConnectionLost:
+            return "Connection interrupted";
+        case AuthenticationFailed:
+            return "Authentication failed";
+        case NotConfigured:
+            return "Not configured";
+        case Cancelled:
+            return "Cancelled";
+        case PartialFailure:
+            return "Part of the operation failed";
+        }
+        return "Unknown error";
+    }
+
+    /**
+     * @brief Result type that carries a success flag, an optional value and, on failure, a ResultError.
      */
     template<typename T>
     class Result
@@ -21,6 +130,7 @@ namespace reactormq::mqtt
          */
         explicit Result(const bool success)
             : m_success(success)
+            , m_error(success ? ResultError::None : ResultError::Unspecified)
         {
         }
 
@@ -32,6 +142,7 @@ namespace reactormq::mqtt
         Result(const bool success, T&& value)
             : m_value(std::make_shared<T>(std::move(value)))
             , m_success(success)
+            , m_error(success ? ResultError::None : ResultError::Unspecified)
         {
         }
 
@@ -56,6 +167,20 @@ namespace reactormq::mqtt
 
         /**
          * @brief Create a failed result.
+         * @param error Why the operation failed.
+         * @param detail Optional extra text; must have static storage duration, as it is kept as a pointer.
+         * @return Failure result.
+         */
+        static Result failure(const ResultError error, const char* detail = nullptr)
+        {
+            Result result(false);
+            result.m_error = error;
+            result.m_detail = detail;
+            return result;
+        }
+
+        /**
+         * @brief Create a failed result with ResultError::Unspecified; prefer failure(ResultError).
          * @param reason Human-readable reason (not stored).
          * @return Failure result.
          */
@@ -91,9 +216,29 @@ namespace reactormq::mqtt
             return hasSucceeded();
         }
 
+        /**
+         * @brief Why the operation failed.
+         * @return ResultError::None on success.
+         */
+        [[nodiscard]] ResultError getError() const
+        {
+            return m_error;
+        }
+
+        /**
+         * @brief Extra text given with the error, if any.
+         * @return Static text, or null when there is none.
+         */
+        [[nodiscard]] const char* getErrorDetail() const
+        {
+            return m_detail;
+        }
+
     private:
         std::shared_ptr<T> m_value;
+        const char* m_detail{ nullptr };
         bool m_success{ false };
+        ResultError m_error{ ResultError::Unspecified };
     };
 
     template<>
@@ -106,6 +251,7 @@ namespace reactormq::mqtt
          */
         explicit Result(const bool success)
             : m_success(success)
+            , m_error(success ? ResultError::None : ResultError::Unspecified)
         {
         }
 
@@ -120,15 +266,38 @@ namespace reactormq::mqtt
 
         /**
          * @brief Create a failed result.
+         * @param error Why the operation failed.
+         * @param detail Optional extra text; must have static storage duration, as it is kept as a pointer.
+         * @return Failure result.
+         */
+        static Result failure(const ResultError error, const char* detail = nullptr)
+        {
+            Result result(false);
+            result.m_error = error;
+            result.m_detail = detail;
+            return result;
+        }
+
+        /**
+         * @brief Create a failed result with ResultError::Unspecified; prefer failure(ResultError).
          * @param reason Human-readable reason (not stored).
          * @return Failure result.
          */
         static Result failure(const char* reason)
         {
-            (void)reason; // Not stored in current simple design
+            (void)reason;
             return Result(false);
         }
 
+        /**
+         * @brief Create the failed result of a publish dropped unsent because its Message Expiry Interval ran out.
+         * @return Failure result that reports hasExpired().
+         */
+        static Result expired()
+        {
+            return failure(ResultError::Expired);
+        }
+
         /**
          * @brief Whether the associated operation succeeded.
          * @return True on success.
@@ -146,7 +315,36 @@ namespace reactormq::mqtt
             return hasSucceeded();
         }
 
+        /**
+         * @brief Whether a publish failed because its message expired before it could be sent.
+         * @return True for results made by expired().
+         */
+        [[nodiscard]] bool hasExpired() const
+        {
+            return m_error == ResultError::Expired;
+        }
+
+        /**
+         * @brief Why the operation failed.
+         * @return ResultError::None on success.
+         */
+        [[nodiscard]] ResultError getError() const
+        {
+            return m_error;
+        }
+
+        /**
+         * @brief Extra text given with the error, if any.
+         * @return Static text, or null when there is none.
+         */
+        [[nodiscard]] const char* getErrorDetail() const
+        {
+            return m_detail;
+        }
+
     private:
+        const char* m_detail{ nullptr };
         bool m_success{ false };
+        ResultError m_error{ ResultError::Unspecified };
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/message.h"
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief A QoS 1/2 message recorded in a session store, with the packet ID it travels under.
+     */
+    struct REACTORMQ_API StoredPublish
+    {
+        std::uint16_t packetId = 0;
+        Message message;
+    };
+
+    /**
+     * @brief Persistent copy of the QoS 1/2 session state, so in-flight messages survive a process restart.
+     *
+     * The client calls the store from its reactor thread only. Adds and removes may be buffered; commit() is called
+     * once per reactor tick and must make everything recorded before it durable, so the cost of syncing is shared by
+     * every message of the tick. On construction the client loads what the store holds and resumes it: outbound
+     * publishes are retransmitted with DUP set and inbound QoS 2 messages are delivered when their PUBREL arrives.
+     */
+    class REACTORMQ_API ISessionStore
+    {
+    public:
+        virtual ~ISessionStore() = default;
+
+        /**
+         * @brief Record an outbound QoS 1/2 publish that has been sent and not yet acknowledged.
+         * @param packetId Packet ID of the publish.
+         * @param message The published message.
+         */
+        virtual void addOutboundPublish(std::uint16_t packetId, const Message& message) = 0;
+
+        /**
+         * @brief Forget an outbound publish once it is acknowledged or has failed.
+         * @param packetId Packet ID of the publish.
+         */
+        virtual void removeOutboundPublish(std::uint16_t packetId) = 0;
+
+        /**
+         * @brief Record an inbound QoS 2 message that has been acknowledged with PUBREC and awaits PUBREL.
+         * @param packetId The broker's packet ID.
+         * @param message The received message, delivered once PUBREL arrives.
+         */
+        virtual void addInboundQos2(std::uint16_t packetId, const Message& message) = 0;
+
+        /**
+         * @brief Forget an inbound QoS 2 message once it has been delivered.
+         * @param packetId The broker's packet ID.
+         */
+        virtual void removeInboundQos2(std::uint16_t packetId) = 0;
+
+        /**
+         * @brief Make every add and remove recorded so far durable.
+         */
+        virtual void commit() = 0;
+
+        /**
+         * @brief Outbound publishes recorded and not removed, oldest first.
+         */
+        [[nodiscard]] virtual std::vector<StoredPublish> loadOutboundPublishes() const = 0;
+
+        /**
+         * @brief Inbound QoS 2 messages recorded and not removed, oldest first.
+         */
+        [[nodiscard]] virtual std::vector<StoredPublish> loadInboundQos2() const = 0;
+    };
+
+    using SessionStorePtr = std::shared_ptr<ISessionStore>;
+} // namespace reactormq::mqtt
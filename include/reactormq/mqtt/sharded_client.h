@@ -0,0 +1,61 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connectable_async.h"
+#include "reactormq/mqtt/disconnectable_async.h"
+#include "reactormq/mqtt/publishable_async.h"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Several connections to one broker behind a single publishing interface, for throughput beyond one
+     * TCP stream and one broker session.
+     *
+     * Each publish goes to the connection picked by a hash of its topic, so messages on one topic keep their order
+     * while different topics spread over all connections. Connect, disconnect and batch publishes fan out to the
+     * connections they concern and complete once all of them have, failing if any did. Subscribe and read events on
+     * the individual connections through getShard().
+     */
+    class REACTORMQ_API IShardedClient
+        : public IConnectableAsync
+        , public IDisconnectableAsync
+        , public IPublishableAsync
+    {
+    public:
+        ~IShardedClient() override = default;
+
+        /// @brief Number of connections.
+        [[nodiscard]] virtual size_t getShardCount() const = 0;
+
+        /// @brief Connection that carries publishes to a topic.
+        [[nodiscard]] virtual size_t getShardIndex(std::string_view topic) const = 0;
+
+        /// @brief One of the connections, for subscribing and for its event callbacks.
+        [[nodiscard]] virtual const std::shared_ptr<IClient>& getShard(size_t index) const = 0;
+
+        /// @brief Whether every connection is connected to the broker.
+        [[nodiscard]] virtual bool isConnected() const = 0;
+
+        /**
+         * @brief Tick every connection once (polling mode).
+         * Not needed, and not to be called, when the connections were created through a reactor group.
+         */
+        virtual void tick() = 0;
+
+        /// @brief Metrics of all connections added together; see ClientMetrics::merge().
+        [[nodiscard]] virtual ClientMetrics getMetrics() const = 0;
+
+        /// @brief Inbound traffic of all connections added together; see InboundTraffic::merge().
+        [[nodiscard]] virtual InboundTraffic getInboundTraffic() const = 0;
+    };
+} // namespace reactormq::mqtt
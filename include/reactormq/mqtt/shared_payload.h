@@ -0,0 +1,264 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Immutable, reference-counted payload bytes.
+     *
+     * Copies share one buffer, so a payload handed over once can be queued, retransmitted and delivered to several
+     * listeners without being duplicated. The buffer is either a vector adopted by move, or caller memory released
+     * through a custom deleter when the last copy goes away. Safe to copy and read from several threads.
+     */
+    class REACTORMQ_API SharedPayload final
+    {
+    public:
+        using Bytes = std::vector<std::uint8_t>;
+
+        SharedPayload() = default;
+
+        /**
+         * @brief Adopt a vector without copying it.
+         * @param bytes Payload bytes (moved).
+         */
+        explicit SharedPayload(Bytes&& bytes)
+            : m_storage{ std::make_shared<Storage>(std::move(bytes)) }
+        {
+        }
+
+        /**
+         * @brief Copy bytes into a new shared buffer.
+         * @param bytes Payload bytes (copied).
+         * @return Payload owning a copy of bytes.
+         */
+        [[nodiscard]] static SharedPayload copyOf(const std::span<const std::uint8_t> bytes)
+        {
+            return SharedPayload{ Bytes(bytes.begin(), bytes.end()) };
+        }
+
+        /**
+         * @brief Copy bytes into a new shared buffer drawn from a memory resource.
+         * The bytes, the reference count and the bookkeeping all come from resource, and go back to it when the last
+         * copy is destroyed, from whichever thread that happens on. The global heap resource takes the copyOf() path.
+         * @param bytes Payload bytes (copied).
+         * @param resource Memory resource to allocate from; must outlive every copy of the payload.
+         * @return Payload owning a copy of bytes.
+         */
+        [[nodiscard]] static SharedPayload copyOf(const std::span<const std::uint8_t> bytes, std::pmr::memory_resource* resource)
+        {
+            if (nullptr == resource || resource == std::pmr::new_delete_resource())
+            {
+                return copyOf(bytes);
+            }
+
+            const size_t size = bytes.size();
+            auto* data = static_cast<std::uint8_t*>(resource->allocate(size, alignof(std::uint8_t)));
+            if (size > 0)
+            {
+                std::memcpy(data, bytes.data(), size);
+            }
+
+            const std::pmr::polymorphic_allocator<std::byte> allocator{ resource };
+            std::shared_ptr<const std::uint8_t> owned(
+                data,
+                [resource, size](const std::uint8_t* adopted)
+                {
+                    resource->deallocate(const_cast<std::uint8_t*>(adopted), size, alignof(std::uint8_t));
+                },
+                allocator);
+
+            SharedPayload payload;
+            payload.m_storage = std::allocate_shared<Storage>(allocator, std::move(owned), size);
+            return payload;
+        }
+
+        /**
+         * @brief Share bytes kept alive by an existing owner, without copying them.
+         * The bookkeeping comes from resource like copyOf() does, so with a pooled resource nothing is allocated from
+         * the heap. The owner is released when the last copy is destroyed, from whichever thread that happens on.
+         * @param owner Owner of the first payload byte; the bytes must not change while it is held.
+         * @param size Payload size in bytes.
+         * @param resource Memory resource for the bookkeeping; must outlive every copy of the payload.
+         * @return Payload viewing the owner's bytes.
+         */
+        [[nodiscard]] static SharedPayload share(
+            std::shared_ptr<const std::uint8_t> owner,
+            const size_t size,
+            std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+        {
+            SharedPayload payload;
+            if (nullptr == resource || resource == std::pmr::new_delete_resource())
+            {
+                payload.m_storage = std::make_shared<Storage>(std::move(owner), size);
+                return payload;
+            }
+            const std::pmr::polymorphic_allocator<std::byte> allocator{ resource };
+            payload.m_storage = std::allocate_shared<Storage>(allocator, std::move(owner), size);
+            return payload;
+        }
+
+        /**
+         * @brief Share a block whose payload starts headroom bytes in, so a packet header can be written in front of it.
+         * Used by PublishReservation: the application fills the payload in place, and the client encodes the PUBLISH
+         * header into the headroom so header and payload leave as one region. Bookkeeping comes from resource as for
+         * share().
+         * @param block Start of the block; the bytes from headroom on must not change once shared.
+         * @param headroom Bytes before the payload that only claimHeadroom() writes to.
+         * @param size Payload size in bytes.
+         * @param resource Memory resource for the bookkeeping; must outlive every copy of the payload.
+         * @return Payload viewing the block past its headroom.
+         */
+        [[nodiscard]] static SharedPayload shareWithHeadroom(
+            std::shared_ptr<std::uint8_t> block,
+            const size_t headroom,
+            const size_t size,
+            std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+        {
+            std::uint8_t* const start = block.get();
+            SharedPayload payload = share(std::shared_ptr<const std::uint8_t>(std::move(block), start + headroom), size, resource);
+            payload.m_storage->headroom = start;
+            payload.m_storage->headroomSize = headroom;
+            return payload;
+        }
+
+        /**
+         * @brief Adopt caller-owned memory without copying it.
+         * The memory must stay unmodified until deleter is invoked, which happens once, when the last copy of the
+         * payload is destroyed.
+         * @tparam Deleter Callable invoked as deleter(data).
+         * @param data First payload byte.
+         * @param size Payload size in bytes.
+         * @param deleter Releases data.
+         * @return Payload viewing data.
+         */
+        template<typename Deleter>
+        [[nodiscard]] static SharedPayload adopt(const std::uint8_t* data, const size_t size, Deleter deleter)
+        {
+            SharedPayload payload;
+            payload.m_storage = std::make_shared<Storage>(std::shared_ptr<const std::uint8_t>(data, std::move(deleter)), size);
+            return payload;
+        }
+
+        /// @brief First payload byte, or nullptr when empty.
+        [[nodiscard]] const std::uint8_t* getData() const noexcept
+        {
+            return m_storage ? m_storage->data : nullptr;
+        }
+
+        /// @brief Payload size in bytes.
+        [[nodiscard]] size_t getSize() const noexcept
+        {
+            return m_storage ? m_storage->size : 0;
+        }
+
+        /// @brief Whether the payload has no bytes.
+        [[nodiscard]] bool isEmpty() const noexcept
+        {
+            return getSize() == 0;
+        }
+
+        /// @brief Non-owning view over the payload bytes.
+        [[nodiscard]] std::span<const std::uint8_t> getView() const noexcept
+        {
+            return { getData(), getSize() };
+        }
+
+        /// @brief Number of payloads sharing this buffer (0 when empty).
+        [[nodiscard]] long getUseCount() const noexcept
+        {
+            return m_storage.use_count();
+        }
+
+        /**
+         * @brief Claim the bytes just before the payload, to write a packet header into.
+         * One claim holds at a time, across every copy of the payload and every thread, so two packets queued with
+         * the same payload never share a header; the second one gets nullptr and sends its header separately.
+         * @param bytes Header size.
+         * @return Where the header starts, bytes before getData(); nullptr if the headroom is too small or claimed.
+         */
+        [[nodiscard]] std::uint8_t* claimHeadroom(const size_t bytes) const noexcept
+        {
+            if (!m_storage || bytes > m_storage->headroomSize || m_storage->isHeadroomClaimed.exchange(true, std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return m_storage->headroom + m_storage->headroomSize - bytes;
+        }
+
+        /// @brief Give back a claim from claimHeadroom() once the header written there has been sent.
+        void releaseHeadroom() const noexcept
+        {
+            if (m_storage)
+            {
+                m_storage->isHeadroomClaimed.store(false, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief The payload as a vector.
+         * Free for vector-backed payloads. Adopted caller memory is copied into a vector the first time this is
+         * called, and that copy is shared by every copy of the payload; prefer getView() to avoid it.
+         * @return Reference valid for as long as this payload.
+         */
+        [[nodiscard]] const Bytes& asVector() const
+        {
+            static const Bytes kEmpty;
+            if (!m_storage)
+            {
+                return kEmpty;
+            }
+
+            Storage& storage = *m_storage;
+            if (storage.external)
+            {
+                std::call_once(storage.materialized, [&storage] { storage.bytes.assign(storage.data, storage.data + storage.size); });
+            }
+            return storage.bytes;
+        }
+
+    private:
+        struct Storage
+        {
+            explicit Storage(Bytes&& owned)
+                : bytes{ std::move(owned) }
+                , data{ bytes.data() }
+                , size{ bytes.size() }
+            {
+            }
+
+            Storage(std::shared_ptr<const std::uint8_t> adopted, const size_t adoptedSize)
+                : external{ std::move(adopted) }
+                , data{ external.get() }
+                , size{ adoptedSize }
+            {
+            }
+
+            Bytes bytes; ///< Owned bytes, or the lazily materialized copy of external memory.
+            std::shared_ptr<const std::uint8_t> external; ///< Adopted caller memory, if any.
+            const std::uint8_t* data = nullptr;
+            size_t size = 0;
+            std::once_flag materialized;
+            std::uint8_t* headroom = nullptr; ///< Writable bytes before data; see shareWithHeadroom().
+            size_t headroomSize = 0;
+            std::atomic<bool> isHeadroomClaimed{ false };
+        };
+
+        std::shared_ptr<Storage> m_storage;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,66 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Immutable, reference-counted topic string.
+     *
+     * Handed out by a client's topic interning table (see ConnectionSettingsBuilder::setMaxInternedTopics()), so
+     * every message received on an interned topic shares one string. Two handles from the same table name the same
+     * topic exactly when they share it, which isSameAs() tests with one pointer comparison. Safe to copy and read
+     * from several threads.
+     */
+    class REACTORMQ_API SharedTopic final
+    {
+    public:
+        SharedTopic() = default;
+
+        /**
+         * @brief Adopt a topic string.
+         * @param topic Topic name (moved).
+         */
+        explicit SharedTopic(std::string topic)
+            : m_topic{ std::make_shared<const std::string>(std::move(topic)) }
+        {
+        }
+
+        /// @brief Whether this handle holds no topic.
+        [[nodiscard]] bool isEmpty() const noexcept
+        {
+            return !m_topic;
+        }
+
+        /// @brief The topic, or an empty string for an empty handle.
+        [[nodiscard]] const std::string& get() const noexcept
+        {
+            static const std::string kEmpty;
+            return m_topic ? *m_topic : kEmpty;
+        }
+
+        /// @brief Whether both handles share one string; false when either is empty.
+        [[nodiscard]] bool isSameAs(const SharedTopic& other) const noexcept
+        {
+            return m_topic && m_topic == other.m_topic;
+        }
+
+        /// @brief Number of handles sharing this string (0 when empty).
+        [[nodiscard]] long getUseCount() const noexcept
+        {
+            return m_topic.use_count();
+        }
+
+    private:
+        std::shared_ptr<const std::string> m_topic;
+    };
+} // namespace reactormq::mqtt
@@ -0,0 +1,62 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief TCP socket options applied when the client creates its socket, before it connects.
+     *
+     * A value of 0 leaves the operating system default in place. Options a platform does not support are ignored; one
+     * the platform rejects is logged and the connect goes ahead without it.
+     */
+    struct SocketOptions
+    {
+        /// Disable Nagle's algorithm (TCP_NODELAY). The client coalesces its own writes, so this is on by default.
+        bool noDelay = true;
+
+        /// Kernel send buffer (SO_SNDBUF). Linux doubles it, caps it at net.core.wmem_max and stops autotuning it.
+        uint32_t sendBufferBytes = 0;
+
+        /// Kernel receive buffer (SO_RCVBUF). Linux doubles it, caps it at net.core.rmem_max and stops autotuning it.
+        uint32_t receiveBufferBytes = 0;
+
+        /// Linux only: busy-poll the device queue for this long on a blocking read (SO_BUSY_POLL); needs CAP_NET_ADMIN.
+        uint32_t busyPollMicroseconds = 0;
+
+        /// Linux only: acknowledge received segments at once instead of delaying the ACK (TCP_QUICKACK).
+        bool quickAck = false;
+
+        /// Linux only: drop the connection when sent data stays unacknowledged this long (TCP_USER_TIMEOUT).
+        uint32_t userTimeoutMs = 0;
+
+        /**
+         * @brief Options for small, latency-sensitive messages such as control topics.
+         * @return Nagle off, immediate ACKs, 50 us busy polling and a 10 second user timeout.
+         */
+        static SocketOptions lowLatency()
+        {
+            SocketOptions options;
+            options.quickAck = true;
+            options.busyPollMicroseconds = 50;
+            options.userTimeoutMs = 10000;
+            return options;
+        }
+
+        /**
+         * @brief Options for bulk transfers such as telemetry.
+         * @return 4 MiB send and receive buffers.
+         */
+        static SocketOptions highThroughput()
+        {
+            SocketOptions options;
+            options.sendBufferBytes = 4 * 1024 * 1024;
+            options.receiveBufferBytes = 4 * 1024 * 1024;
+            return options;
+        }
+    };
+} // namespace reactormq::mqtt
@@ -5,11 +5,17 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/payload_sink.h"
 #include "reactormq/mqtt/result.h"
 #include "reactormq/mqtt/subscribe_result.h"
 #include "reactormq/mqtt/topic_filter.h"
 
+#include <cstdint>
+#include <functional>
 #include <future>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -18,6 +24,18 @@ namespace reactormq::mqtt
     using SubscribesFuture = std::future<Result<std::vector<SubscribeResult>>>;
     using SubscribeFuture = std::future<Result<SubscribeResult>>;
 
+    /// @brief Handler for the messages of one subscription; called the same way as OnMessage handlers.
+    using MessageHandler = std::function<void(const Message& message)>;
+
+    /// @brief Which messages a subscription's handler is called with when they arrive faster than it runs.
+    enum class HandlerDelivery : std::uint8_t
+    {
+        /// Every message, in arrival order.
+        Every,
+        /// Only the newest message on each topic: one still waiting for the handler is replaced by a newer one.
+        LatestPerTopic
+    };
+
     /**
      * @brief Interface for a client that can subscribe to topics.
      */
@@ -40,6 +58,92 @@ namespace reactormq::mqtt
          */
         virtual SubscribeFuture subscribeAsync(TopicFilter&& topicFilter) = 0;
 
+        /**
+         * @brief Subscribe to a single topic filter and route the messages matching it to a handler.
+         * Messages are still broadcast to OnMessage as well. The handler is dropped when the filter is unsubscribed.
+         * @param topicFilter The topic filter to subscribe to (moved).
+         * @param handler Handler called for each message whose topic matches the filter.
+         * @return A future resolving to the result for the single subscription.
+         */
+        virtual SubscribeFuture subscribeAsync(TopicFilter&& topicFilter, MessageHandler handler) = 0;
+
+        /**
+         * @brief Subscribe to multiple topic filters and report the results to a handler instead of a future.
+         * @param topicFilters The set of topic filters to subscribe to.
+         * @param onComplete Called with the per-topic results for the subscribe request.
+         */
+        virtual void subscribeAsync(
+            const std::vector<TopicFilter>& topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete) = 0;
+
+        /**
+         * @brief Subscribe to a single topic filter and report the result to a handler instead of a future.
+         * @param topicFilter The topic filter to subscribe to (moved).
+         * @param handler Handler for the messages matching the filter, as for subscribeAsync(filter, handler); may be
+         * empty.
+         * @param onComplete Called with the result for the single subscription.
+         */
+        virtual void subscribeAsync(
+            TopicFilter&& topicFilter, MessageHandler handler, CompletionHandler<SubscribeResult> onComplete) = 0;
+
+        /**
+         * @brief Subscribe to a single topic filter and route its messages to a handler that may skip stale ones.
+         * With HandlerDelivery::LatestPerTopic, messages arriving on a topic while the handler's call for it is still
+         * queued replace the message that call delivers, so the handler sees only the newest; this suits state such as
+         * prices or positions where an older value is worthless once a newer one exists. The messages are
+         * acknowledged without waiting for the handler. OnMessage still gets every message.
+         * @param topicFilter The topic filter to subscribe to (moved).
+         * @param handler Handler for the messages matching the filter.
+         * @param delivery Whether the handler gets every message or only the newest per topic.
+         * @param onComplete Called with the result for the single subscription.
+         */
+        virtual void subscribeAsync(
+            TopicFilter&& topicFilter, MessageHandler handler, HandlerDelivery delivery, CompletionHandler<SubscribeResult> onComplete) = 0;
+
+        /**
+         * @brief Subscribe to a single topic filter and stream the payloads of its large messages to a sink.
+         * Matching messages over ConnectionSettings::getInboundStreamingThreshold() go to the sink chunk by chunk and
+         * skip every other handler; smaller ones are delivered as usual. The sink is dropped when the filter is
+         * unsubscribed.
+         * @param topicFilter The topic filter to subscribe to (moved).
+         * @param sink Sink for the large messages matching the filter.
+         * @param onComplete Called with the result for the single subscription.
+         */
+        virtual void subscribeAsync(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete) = 0;
+
+        /**
+         * @brief Subscribe to a single topic filter and reassemble the chunked transfers published to it with
+         * IPublishableAsync::publishChunked() into a sink. Each transfer reaches the sink as one message: onBegin()
+         * with the total size, onChunk() per chunk in order, then onEnd(true); a missing chunk, or a new transfer on
+         * the same topic before the last one finished, ends it with onEnd(false). Chunks sent again after a reconnect
+         * are passed on once. Messages that are not chunks are delivered as usual. The sink is dropped when the filter
+         * is unsubscribed.
+         * @param topicFilter The topic filter to subscribe to (moved).
+         * @param sink Sink for the transfers on topics matching the filter.
+         * @param onComplete Called with the result for the single subscription.
+         */
+        virtual void subscribeChunked(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete) = 0;
+
+        /**
+         * @brief Make the client's subscriptions exactly @p topicFilters, sending only what changed: one SUBSCRIBE for
+         * the filters not yet subscribed or subscribed with other options, then one UNSUBSCRIBE for the subscribed
+         * filters no longer listed, including those subscribed through subscribeAsync(). Filters already subscribed
+         * as listed cost nothing, so an app can call this with its whole interest set whenever that set changes. The
+         * set is what a reconnect without a session resubscribes to. Requires a connection, as subscribeAsync() does.
+         * @param topicFilters Every filter to be subscribed; a filter listed twice keeps its last options.
+         * @return A future resolving to the results of the filters that had to be subscribed, which is empty when
+         * none did, or to the first error of either packet.
+         */
+        virtual SubscribesFuture setSubscriptions(std::span<const TopicFilter> topicFilters) = 0;
+
+        /**
+         * @brief Make the client's subscriptions exactly @p topicFilters, as setSubscriptions(topicFilters) does, and
+         * report the outcome to a handler instead of a future.
+         * @param topicFilters Every filter to be subscribed; a filter listed twice keeps its last options.
+         * @param onComplete Called with the results of the filters that had to be subscribed, or the first error.
+         */
+        virtual void setSubscriptions(
+            std::span<const TopicFilter> topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete) = 0;
+
         /**
          * @brief Convenience overload: subscribe using a single filter string.
          * @param topicFilter The topic filter string (e.g., "sensors/+/temp").
@@ -0,0 +1,79 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Scheduling priority of a library thread, mapped onto the platform's own levels.
+     */
+    enum class ThreadPriority : uint8_t
+    {
+        Normal = 0, ///< Left as the platform created it.
+        BelowNormal = 1,
+        AboveNormal = 2,
+        Highest = 3,
+        /// Real-time where the platform has it (SCHED_FIFO on Linux); usually needs elevated rights.
+        TimeCritical = 4
+    };
+
+    /**
+     * @brief Where a thread the library starts runs and what it is called, so I/O threads can be kept off the cores
+     * application workers use and told apart in top, perf and debuggers.
+     *
+     * Every field is optional and applied by the thread itself as it starts. A setting the platform refuses (affinity
+     * on Darwin, a real-time priority without the rights for it) is logged and skipped; the thread runs regardless.
+     */
+    struct REACTORMQ_API ThreadPlacement final
+    {
+        /// Thread name; empty keeps the platform default. Linux cuts names to 15 characters.
+        std::string name;
+
+        /**
+         * Logical CPUs to run on; empty leaves the choice to the scheduler. A pool of threads spreads them one per
+         * thread in order, wrapping around; a single thread may run on any of them.
+         */
+        std::vector<std::uint32_t> cores;
+
+        ThreadPriority priority = ThreadPriority::Normal;
+
+        /// @brief Whether nothing is asked for, so starting a thread with it costs nothing.
+        [[nodiscard]] bool isDefault() const
+        {
+            return name.empty() && cores.empty() && priority == ThreadPriority::Normal;
+        }
+    };
+
+    /**
+     * @brief Convert a thread priority to a human-readable string.
+     * @param priority Priority to convert.
+     * @return String view of the priority.
+     */
+    inline const char* threadPriorityToString(const ThreadPriority priority)
+    {
+        switch (priority)
+        {
+            using enum ThreadPriority;
+        case Normal:
+            return "Normal";
+        case BelowNormal:
+            return "BelowNormal";
+        case AboveNormal:
+            return "AboveNormal";
+        case Highest:
+            return "Highest";
+        case TimeCritical:
+            return "TimeCritical";
+        default:
+            return "Invalid thread priority";
+        }
+    }
+} // namespace reactormq::mqtt
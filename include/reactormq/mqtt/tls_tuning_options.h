@@ -0,0 +1,80 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Which AEAD cipher suites a TLS connection offers first. The server has the last word; most honour the
+     * client's order, or at least its preference for ChaCha20-Poly1305, which servers use to serve clients without AES
+     * instructions.
+     */
+    enum class TlsCipherPreference : uint8_t
+    {
+        LibraryDefault, ///< The TLS library's own list and order.
+        Auto, ///< AES-GCM first where the CPU has AES instructions, ChaCha20-Poly1305 first where it does not.
+        AesGcm, ///< AES-GCM first: the fastest suite on x86 with AES-NI and ARMv8 with the crypto extensions.
+        ChaCha20, ///< ChaCha20-Poly1305 first: faster than software AES on CPUs without AES instructions.
+    };
+
+    /**
+     * @brief Cipher order and record sizes of Ssl and Wss connections.
+     *
+     * A TLS record can only be decrypted once all of it has arrived, so a 16 KiB record spread over a dozen TCP
+     * segments holds back its first byte until the last segment lands, and longer after a loss. Small records let
+     * control packets through at the first segment; large ones spend less CPU and framing per byte on bulk transfers.
+     * Dynamic record sizing gets both: records start at one TCP segment and grow to the full size once a burst has
+     * sent growAfterBytes, returning to small records after idleResetMs without sending.
+     */
+    struct TlsTuningOptions
+    {
+        /// Order of the cipher suites offered in the ClientHello.
+        TlsCipherPreference cipherPreference = TlsCipherPreference::LibraryDefault;
+
+        /**
+         * Maximum Fragment Length extension (RFC 6066) asked of the server: 512, 1024, 2048 or 4096; 0 does not ask.
+         * When the server agrees, records in both directions are capped there, which also shrinks the buffers a
+         * constrained device needs. Servers that do not implement the extension ignore it.
+         */
+        uint16_t maxFragmentLength = 0;
+
+        /// Start each burst with small records and grow them under sustained throughput; false leaves the size alone.
+        bool dynamicRecordSizing = false;
+
+        /// Plaintext bytes per record at the start of a burst; clamped to 512..16384. 1400 fits one TCP segment.
+        uint16_t initialRecordSize = 1400;
+
+        /// Bytes sent in small records before they grow to the full size (or maxFragmentLength).
+        uint32_t growAfterBytes = 1024 * 1024;
+
+        /// Milliseconds without sending after which records start small again.
+        uint32_t idleResetMs = 1000;
+
+        /**
+         * @brief Options for connections that mostly carry small, latency-sensitive messages.
+         * @return Cipher picked for the CPU and dynamic record sizing.
+         */
+        static TlsTuningOptions lowLatency()
+        {
+            TlsTuningOptions options;
+            options.cipherPreference = TlsCipherPreference::Auto;
+            options.dynamicRecordSizing = true;
+            return options;
+        }
+
+        /**
+         * @brief Options for bulk transfers, where full-size records keep the per-byte cost down.
+         * @return Cipher picked for the CPU and the library's full-size records.
+         */
+        static TlsTuningOptions highThroughput()
+        {
+            TlsTuningOptions options;
+            options.cipherPreference = TlsCipherPreference::Auto;
+            return options;
+        }
+    };
+} // namespace reactormq::mqtt
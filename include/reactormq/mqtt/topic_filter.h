@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -117,11 +118,29 @@ namespace reactormq::mqtt
             return m_retainHandlingOptions;
         }
 
+        /**
+         * @brief Delivery priority of the messages matching this filter; kept by the client and never sent to the broker.
+         * When the per-tick inbound packet budget runs out, messages on higher-priority topics are delivered first and
+         * the rest wait for later ticks, so a flood on a bulk topic does not hold up a critical one. 0, the default,
+         * is the lowest; a topic matched by several filters takes the highest of their priorities.
+         */
+        [[nodiscard]] std::uint8_t getDeliveryPriority() const
+        {
+            return m_deliveryPriority;
+        }
+
+        /// @brief Set the delivery priority; see getDeliveryPriority().
+        void setDeliveryPriority(const std::uint8_t priority)
+        {
+            m_deliveryPriority = priority;
+        }
+
     private:
         std::string m_filter;
         QualityOfService m_qualityOfService;
         bool m_noLocal;
         bool m_retainAsPublished;
         RetainHandlingOptions m_retainHandlingOptions;
+        std::uint8_t m_deliveryPriority = 0;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
@@ -0,0 +1,17 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/export.h"
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Register the library's "reactormq" Perfetto track-event category.
+     * Call once after perfetto::Tracing::Initialize() when the library is built with REACTORMQ_TRACE_BACKEND=perfetto;
+     * with any other backend (Tracy, Unreal Insights, none) there is nothing to register and this does nothing.
+     */
+    REACTORMQ_API void registerTraceCategories();
+} // namespace reactormq::mqtt
@@ -0,0 +1,30 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Accounting of received messages per subscription and per busy topic prefix, reported by
+     * IClient::getInboundTraffic() for capacity planning. Memory and work per message stay fixed however many
+     * topics arrive: one set of counters per subscription, and a fixed number of prefix slots.
+     */
+    struct TrafficAccountingOptions
+    {
+        /// Count messages, bytes and drops for each subscription with a message handler.
+        bool isEnabled = false;
+
+        /// Busiest topic prefixes tracked, by message count; 0 tracks none. Uses the space-saving algorithm, so a
+        /// prefix that is among the busiest this many is always reported, with its count overstated by at most the
+        /// count of the quietest slot.
+        uint32_t topPrefixCount = 0;
+
+        /// Topic levels a prefix keeps: with 2, "sensors/kitchen/temp" counts towards "sensors/kitchen"; 0 keeps the
+        /// whole topic.
+        uint32_t prefixLevels = 2;
+    };
+} // namespace reactormq::mqtt
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "reactormq/export.h"
+#include "reactormq/mqtt/completion_handler.h"
 #include "reactormq/mqtt/result.h"
 #include "reactormq/mqtt/unsubscribe_result.h"
 
@@ -30,5 +31,13 @@ namespace reactormq::mqtt
          * @return A future resolving to the per-topic unsubscribe results.
          */
         virtual UnsubscribesFuture unsubscribeAsync(const std::vector<std::string>& topicFilters) = 0;
+
+        /**
+         * @brief Unsubscribe from the provided topic filters and report the results to a handler instead of a future.
+         * @param topicFilters The topic filters to unsubscribe from (order preserved for result mapping).
+         * @param onComplete Called with the per-topic unsubscribe results.
+         */
+        virtual void unsubscribeAsync(
+            const std::vector<std::string>& topicFilters, CompletionHandler<std::vector<UnsubscribeResult>> onComplete) = 0;
     };
 } // namespace reactormq::mqtt
\ No newline at end of file
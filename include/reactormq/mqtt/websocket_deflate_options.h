@@ -0,0 +1,38 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::mqtt
+{
+    /**
+     * @brief Offer of the WebSocket permessage-deflate extension (RFC 7692) for Ws and Wss connections.
+     *
+     * The upgrade request offers the extension with these parameters and the server picks what it accepts; when it
+     * declines, the connection carries uncompressed frames as usual. Needs a build with REACTORMQ_WITH_ZLIB; other
+     * builds never offer it.
+     */
+    struct WebSocketDeflateOptions
+    {
+        /// Offer permessage-deflate in the upgrade request.
+        bool enabled = false;
+
+        /// LZ77 window the client compresses with, as a power of two (client_max_window_bits); clamped to 9..15.
+        std::uint8_t clientMaxWindowBits = 15;
+
+        /// Largest window the server may compress with (server_max_window_bits); clamped to 9..15. Offered below 15.
+        std::uint8_t serverMaxWindowBits = 15;
+
+        /// Let the client keep its compression window across messages; false offers client_no_context_takeover.
+        bool clientContextTakeover = true;
+
+        /// Let the server keep its compression window across messages; false offers server_no_context_takeover.
+        bool serverContextTakeover = true;
+
+        /// Packets smaller than this go out uncompressed; deflate rarely pays for itself on a few bytes.
+        std::uint32_t minCompressBytes = 64;
+    };
+} // namespace reactormq::mqtt
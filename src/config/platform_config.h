@@ -38,6 +38,12 @@ namespace reactormq::config
     inline constexpr bool kIsPosixFamily = false;
 #endif // REACTORMQ_PLATFORM_POSIX_FAMILY
 
+#if REACTORMQ_SOCKET_WITH_IO_URING && REACTORMQ_PLATFORM_LINUX
+    inline constexpr bool kHasIoUring = true;
+#else
+    inline constexpr bool kHasIoUring = false;
+#endif // REACTORMQ_SOCKET_WITH_IO_URING && REACTORMQ_PLATFORM_LINUX
+
 #if REACTORMQ_WITH_TLS
     inline constexpr bool kHasOpenSsl = true;
 #else
@@ -0,0 +1,105 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/wakeup_route.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Raised when a call the reactor is waiting on completes on another thread, so an idle reactor ticks to
+     * pick the result up instead of sleeping until its next deadline. Shared with the callbacks, which may outlive the
+     * context.
+     */
+    struct AsyncSignal
+    {
+        std::atomic<bool> isRaised{ false };
+        std::shared_ptr<WakeupRoute> wakeup;
+
+        void raise()
+        {
+            isRaised.store(true, std::memory_order_release);
+            if (wakeup)
+            {
+                wakeup->signal();
+            }
+        }
+    };
+
+    /**
+     * @brief One value handed to the reactor thread by a callback that may run on any thread, or inline.
+     * Only the first value set is kept. The reactor holds the result and callbacks a weak pointer, so a value that
+     * arrives after the reactor stopped waiting is dropped.
+     * @tparam T Value type.
+     */
+    template<typename T>
+    class AsyncResult final
+    {
+    public:
+        explicit AsyncResult(std::shared_ptr<AsyncSignal> signal)
+            : m_signal(std::move(signal))
+        {
+        }
+
+        /**
+         * @brief Store the value and wake the reactor. Safe from any thread.
+         * @param value Value to hand over; ignored if one was already set.
+         */
+        void set(T value)
+        {
+            {
+                const std::lock_guard lock(m_mutex);
+                if (m_isSet)
+                {
+                    return;
+                }
+                m_value = std::move(value);
+                m_isSet = true;
+            }
+            if (m_signal)
+            {
+                m_signal->raise();
+            }
+        }
+
+        /**
+         * @brief Take the value if it has arrived. Reactor thread only.
+         * @return The value, once; empty before it arrives and after it was taken.
+         */
+        [[nodiscard]] std::optional<T> take()
+        {
+            const std::lock_guard lock(m_mutex);
+            return std::exchange(m_value, std::nullopt);
+        }
+
+        /**
+         * @brief Build a callback that sets the result for as long as it exists.
+         * @param result Result to set.
+         * @return Callable taking the value; copies share the result.
+         */
+        [[nodiscard]] static auto makeSetter(const std::shared_ptr<AsyncResult>& result)
+        {
+            return [weak = std::weak_ptr<AsyncResult>(result)](T value)
+            {
+                if (const auto locked = weak.lock())
+                {
+                    locked->set(std::move(value));
+                }
+            };
+        }
+
+    private:
+        std::shared_ptr<AsyncSignal> m_signal;
+        std::mutex m_mutex;
+        std::optional<T> m_value;
+        bool m_isSet = false;
+    };
+} // namespace reactormq::mqtt::client
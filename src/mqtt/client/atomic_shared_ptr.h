@@ -0,0 +1,57 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief A shared_ptr loaded and replaced atomically, for values the reactor thread publishes to other threads.
+     * Uses std::atomic<std::shared_ptr> where the standard library has it, and the std::atomic_* free functions
+     * otherwise.
+     */
+    template<typename T>
+    class AtomicSharedPtr final
+    {
+    public:
+        [[nodiscard]] std::shared_ptr<T> load() const
+        {
+#if defined(__cpp_lib_atomic_shared_ptr)
+            return m_value.load(std::memory_order_acquire);
+#else
+            return std::atomic_load_explicit(&m_value, std::memory_order_acquire);
+#endif
+        }
+
+        void store(std::shared_ptr<T> value)
+        {
+#if defined(__cpp_lib_atomic_shared_ptr)
+            m_value.store(std::move(value), std::memory_order_release);
+#else
+            std::atomic_store_explicit(&m_value, std::move(value), std::memory_order_release);
+#endif
+        }
+
+        /// @return The value replaced.
+        std::shared_ptr<T> exchange(std::shared_ptr<T> value)
+        {
+#if defined(__cpp_lib_atomic_shared_ptr)
+            return m_value.exchange(std::move(value), std::memory_order_acq_rel);
+#else
+            return std::atomic_exchange_explicit(&m_value, std::move(value), std::memory_order_acq_rel);
+#endif
+        }
+
+    private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<std::shared_ptr<T>> m_value;
+#else
+        std::shared_ptr<T> m_value;
+#endif
+    };
+} // namespace reactormq::mqtt::client
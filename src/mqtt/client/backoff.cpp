@@ -8,11 +8,14 @@
 
 namespace reactormq::mqtt::client
 {
-    BackoffCalculator::BackoffCalculator(const std::uint32_t initialDelayMs, const std::uint32_t maxDelayMs, const double multiplier)
+    BackoffCalculator::BackoffCalculator(
+        const std::uint32_t initialDelayMs, const std::uint32_t maxDelayMs, const double multiplier, const ReconnectJitter jitter)
         : m_initialDelayMs(initialDelayMs)
         , m_maxDelayMs(maxDelayMs)
         , m_multiplier(multiplier)
+        , m_jitter(jitter)
         , m_attemptCount(0)
+        , m_previousDelayMs(initialDelayMs)
         , m_rng(std::random_device{}())
         , m_jitterDistribution(0.9, 1.1)
     {
@@ -20,6 +23,12 @@ namespace reactormq::mqtt::client
 
     std::chrono::milliseconds BackoffCalculator::calculateNextDelay()
     {
+        if (m_jitter == ReconnectJitter::Decorrelated)
+        {
+            ++m_attemptCount;
+            return std::chrono::milliseconds(nextDecorrelatedDelay());
+        }
+
         double baseDelay = m_initialDelayMs;
 
         if (m_attemptCount > 0)
@@ -41,6 +50,16 @@ namespace reactormq::mqtt::client
     void BackoffCalculator::reset()
     {
         m_attemptCount = 0;
+        m_previousDelayMs = m_initialDelayMs;
+    }
+
+    std::uint32_t BackoffCalculator::nextDecorrelatedDelay()
+    {
+        const std::uint32_t lowerMs = std::max(std::min(m_initialDelayMs, m_maxDelayMs), 1u);
+        const std::uint64_t upperMs = std::max<std::uint64_t>(std::uint64_t{ m_previousDelayMs } * 3, lowerMs);
+        std::uniform_int_distribution<std::uint64_t> distribution(lowerMs, upperMs);
+        m_previousDelayMs = static_cast<std::uint32_t>(std::min<std::uint64_t>(distribution(m_rng), std::max(m_maxDelayMs, lowerMs)));
+        return m_previousDelayMs;
     }
 
     std::uint32_t BackoffCalculator::applyJitter(const std::uint32_t baseDelayMs)
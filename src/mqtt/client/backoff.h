@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "reactormq/mqtt/reconnect_jitter.h"
+
 #include <chrono>
 #include <random>
 
@@ -13,7 +15,9 @@ namespace reactormq::mqtt::client
      * @brief Calculates exponential backoff delays with jitter for reconnection attempts.
      *
      * Implements exponential backoff: delay = min(initialDelay * (multiplier ^ attempt), maxDelay)
-     * with ±10% random jitter to prevent thundering herd problem.
+     * with ±10% random jitter to prevent thundering herd problem. With decorrelated jitter, each delay is instead
+     * drawn from [initialDelay, previousDelay * 3] and capped at maxDelay, which keeps clients that failed together
+     * from retrying together.
      *
      */
     class BackoffCalculator
@@ -23,9 +27,14 @@ namespace reactormq::mqtt::client
          * @brief Constructor.
          * @param initialDelayMs Initial delay in milliseconds before first retry.
          * @param maxDelayMs Maximum delay in milliseconds between retries.
-         * @param multiplier Exponential backoff multiplier (e.g., 2.0 for doubling).
+         * @param multiplier Exponential backoff multiplier (e.g., 2.0 for doubling); unused with decorrelated jitter.
+         * @param jitter How each delay is randomised.
          */
-        BackoffCalculator(std::uint32_t initialDelayMs, std::uint32_t maxDelayMs, double multiplier);
+        BackoffCalculator(
+            std::uint32_t initialDelayMs,
+            std::uint32_t maxDelayMs,
+            double multiplier,
+            ReconnectJitter jitter = ReconnectJitter::Proportional);
 
         /**
          * @brief Calculate the next delay with exponential backoff and jitter.
@@ -39,7 +48,7 @@ namespace reactormq::mqtt::client
         std::chrono::milliseconds calculateNextDelay();
 
         /**
-         * @brief Reset the backoff state (attempt counter).
+         * @brief Reset the backoff state (attempt counter and previous delay).
          *
          * Called when connection succeeds to reset backoff for future reconnection attempts.
          */
@@ -62,6 +71,12 @@ namespace reactormq::mqtt::client
          */
         std::uint32_t applyJitter(std::uint32_t baseDelayMs);
 
+        /**
+         * @brief Draw a decorrelated delay from [initialDelay, previousDelay * 3], capped at the maximum delay.
+         * @return Delay in milliseconds.
+         */
+        std::uint32_t nextDecorrelatedDelay();
+
         /// @brief Initial delay in milliseconds.
         std::uint32_t m_initialDelayMs;
 
@@ -71,11 +86,18 @@ namespace reactormq::mqtt::client
         /// @brief Exponential backoff multiplier.
         double m_multiplier;
 
+        /// @brief How each delay is randomised.
+        ReconnectJitter m_jitter;
+
         /// @brief Current attempt count (incremented on each calculateNextDelay call).
         std::uint32_t m_attemptCount;
 
-        /// @brief Random number generator for jitter (seeded with std::random_device).
-        std::mt19937 m_rng;
+        /// @brief Delay returned by the last call; decorrelated jitter grows from it.
+        std::uint32_t m_previousDelayMs;
+
+        /// @brief Random number generator for jitter (seeded with std::random_device); a small engine, since jitter needs
+        /// no long period and every client holds one.
+        std::minstd_rand m_rng;
 
         /// @brief Uniform distribution for jitter factor [0.9, 1.1].
         std::uniform_real_distribution<> m_jitterDistribution;
@@ -0,0 +1,203 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "chunked_transfer.h"
+
+#include "mqtt/client/payload_codecs.h"
+#include "mqtt/client/topic_router.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <array>
+
+namespace reactormq::mqtt::client
+{
+    namespace
+    {
+        constexpr std::array<std::uint8_t, 4> kChunkMagic{ 'R', 'M', 'Q', 'C' };
+        constexpr std::uint8_t kChunkFormatVersion = 1;
+
+        template<typename T>
+        void writeBigEndian(std::uint8_t* out, const T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                out[i] = static_cast<std::uint8_t>(value >> (8 * (sizeof(T) - 1 - i)));
+            }
+        }
+
+        template<typename T>
+        T readBigEndian(const std::uint8_t* in)
+        {
+            T value = 0;
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                value = static_cast<T>(value << 8 | in[i]);
+            }
+            return value;
+        }
+    } // namespace
+
+    void ChunkHeader::encode(const std::span<std::uint8_t, kChunkHeaderSize> out) const
+    {
+        std::ranges::copy(kChunkMagic, out.begin());
+        out[4] = kChunkFormatVersion;
+        out[5] = 0;
+        out[6] = 0;
+        out[7] = 0;
+        writeBigEndian(out.data() + 8, transferId);
+        writeBigEndian(out.data() + 16, sequence);
+        writeBigEndian(out.data() + 20, chunkCount);
+        writeBigEndian(out.data() + 24, totalSize);
+    }
+
+    std::optional<ChunkHeader> ChunkHeader::decode(const std::span<const std::uint8_t> payload)
+    {
+        if (payload.size() < kChunkHeaderSize || !std::ranges::equal(payload.first(kChunkMagic.size()), kChunkMagic)
+            || payload[4] != kChunkFormatVersion)
+        {
+            return std::nullopt;
+        }
+
+        ChunkHeader header;
+        header.transferId = readBigEndian<std::uint64_t>(payload.data() + 8);
+        header.sequence = readBigEndian<std::uint32_t>(payload.data() + 16);
+        header.chunkCount = readBigEndian<std::uint32_t>(payload.data() + 20);
+        header.totalSize = readBigEndian<std::uint64_t>(payload.data() + 24);
+        if (header.sequence >= header.chunkCount)
+        {
+            return std::nullopt;
+        }
+        return header;
+    }
+
+    void ChunkAssemblers::add(const std::string_view filter, PayloadSinkPtr sink)
+    {
+        m_sinks.emplace_back(std::string(filter), std::move(sink));
+    }
+
+    size_t ChunkAssemblers::remove(const std::string_view filter)
+    {
+        std::vector<PayloadSinkPtr> removed;
+        const size_t count = std::erase_if(
+            m_sinks,
+            [filter, &removed](const std::pair<std::string, PayloadSinkPtr>& entry)
+            {
+                if (entry.first != filter)
+                {
+                    return false;
+                }
+                removed.push_back(entry.second);
+                return true;
+            });
+
+        std::erase_if(
+            m_assemblies,
+            [&removed](const auto& entry)
+            {
+                const Assembly& assembly = entry.second;
+                if (std::ranges::find(removed, assembly.sink) == removed.end())
+                {
+                    return false;
+                }
+                if (!assembly.isComplete())
+                {
+                    assembly.sink->onEnd(false);
+                }
+                return true;
+            });
+        return count;
+    }
+
+    PayloadSinkPtr ChunkAssemblers::find(const std::string_view topic) const
+    {
+        const auto it = std::ranges::find_if(
+            m_sinks,
+            [topic](const std::pair<std::string, PayloadSinkPtr>& entry)
+            {
+                return PayloadCodecs::matchesFilter(TopicRouter::stripSharePrefix(entry.first), topic);
+            });
+        return it != m_sinks.end() ? it->second : nullptr;
+    }
+
+    bool ChunkAssemblers::deliver(const MessageView& message)
+    {
+        const std::optional<ChunkHeader> header = ChunkHeader::decode(message.getPayload());
+        if (!header)
+        {
+            return false;
+        }
+        PayloadSinkPtr sink = find(message.getTopic());
+        if (!sink)
+        {
+            return false;
+        }
+
+        const std::string_view topic = message.getTopic();
+        auto it = m_assemblies.find(topic);
+        if (it != m_assemblies.end() && it->second.transferId == header->transferId)
+        {
+            Assembly& assembly = it->second;
+            if (header->sequence < assembly.nextSequence)
+            {
+                return true; // Sent again after a reconnect; already passed on.
+            }
+            if (header->sequence > assembly.nextSequence)
+            {
+                REACTORMQ_LOG_RATELIMITED(
+                    logging::LogLevel::Warn,
+                    10,
+                    "Chunked transfer on %.*s missed chunk %u of %u; ended incomplete",
+                    static_cast<int>(topic.size()),
+                    topic.data(),
+                    assembly.nextSequence,
+                    assembly.chunkCount);
+                assembly.sink->onEnd(false);
+                m_assemblies.erase(it);
+                return true;
+            }
+        }
+        else
+        {
+            if (it != m_assemblies.end())
+            {
+                if (!it->second.isComplete())
+                {
+                    it->second.sink->onEnd(false);
+                }
+                m_assemblies.erase(it);
+            }
+            if (header->sequence != 0)
+            {
+                REACTORMQ_LOG_RATELIMITED(
+                    logging::LogLevel::Warn,
+                    10,
+                    "Chunk %u of a chunked transfer on %.*s arrived without its start; dropped",
+                    header->sequence,
+                    static_cast<int>(topic.size()),
+                    topic.data());
+                return true;
+            }
+
+            it = m_assemblies.emplace(std::string(topic), Assembly{ sink, header->transferId, 0, header->chunkCount, header->totalSize, 0 })
+                     .first;
+            const MessageView start(topic, {}, message.shouldRetain(), message.getQualityOfService(), message.getRawProperties());
+            sink->onBegin(start, static_cast<size_t>(header->totalSize));
+        }
+
+        Assembly& assembly = it->second;
+        const std::span<const std::uint8_t> body = message.getPayload().subspan(kChunkHeaderSize);
+        if (!body.empty())
+        {
+            assembly.sink->onChunk(body);
+        }
+        assembly.received += body.size();
+        ++assembly.nextSequence;
+        if (assembly.isComplete())
+        {
+            assembly.sink->onEnd(assembly.received == assembly.totalSize);
+        }
+        return true;
+    }
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,140 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/completion.h"
+#include "reactormq/mqtt/chunked_transfer.h"
+#include "reactormq/mqtt/message_view.h"
+#include "reactormq/mqtt/payload_sink.h"
+#include "reactormq/mqtt/payload_source.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /// @brief The header at the start of each chunk of a chunked transfer; see kChunkHeaderSize for the layout.
+    struct ChunkHeader
+    {
+        std::uint64_t transferId = 0;
+        std::uint32_t sequence = 0;
+        std::uint32_t chunkCount = 0;
+        std::uint64_t totalSize = 0;
+
+        /// @brief Write the header into the first kChunkHeaderSize bytes of @p out.
+        void encode(std::span<std::uint8_t, kChunkHeaderSize> out) const;
+
+        /**
+         * @brief Read the header a payload starts with.
+         * @param payload Payload of a received message.
+         * @return The header, or nullopt when the payload is not a chunk: too short, another magic or version, or a
+         * sequence number outside the transfer.
+         */
+        [[nodiscard]] static std::optional<ChunkHeader> decode(std::span<const std::uint8_t> payload);
+    };
+
+    /**
+     * @brief Progress of a payload being published in chunks by IPublishableAsync::publishChunked().
+     * Shared by the command that pumps it and the completions of its chunks. Only touched on the reactor thread.
+     */
+    struct ChunkedTransfer
+    {
+        std::string topic;
+        PayloadSourcePtr source;
+        ChunkedTransferOptions options;
+        Completion<void> promise;
+
+        std::uint64_t transferId = 0;
+        /// Payload bytes per chunk; 0 until the first pump sizes the chunks against the broker's Maximum Packet Size.
+        std::uint32_t chunkSize = 0;
+        std::uint32_t chunkCount = 0;
+        std::uint32_t nextSequence = 0;
+        std::uint32_t acknowledged = 0;
+        std::uint32_t inFlight = 0;
+        /// A command to publish more chunks is queued, so acknowledgements in the same tick queue no other.
+        bool isPumpQueued = false;
+        bool isFinished = false;
+
+        /// @brief Finish the transfer with @p result, unless it already finished.
+        void finish(const Result<void>& result)
+        {
+            if (!isFinished)
+            {
+                isFinished = true;
+                source.reset();
+                promise.set_value(result);
+            }
+        }
+    };
+
+    /**
+     * @brief The sinks of the subscriptions made with ISubscribableAsync::subscribeChunked(), and the transfer each
+     * topic is part way through. Chunks of a transfer are passed to the sink as they arrive, so a receiver holds one
+     * chunk at a time. One transfer at a time per topic: a chunk of a new transfer ends the one in progress. Not
+     * thread-safe; it belongs to the reactor thread.
+     */
+    class ChunkAssemblers final
+    {
+    public:
+        /**
+         * @brief Reassemble the chunked transfers published to topics matching a filter into a sink.
+         * @param filter Topic filter, with '+' and '#' wildcards.
+         * @param sink The sink.
+         */
+        void add(std::string_view filter, PayloadSinkPtr sink);
+
+        /**
+         * @brief Drop the sinks of a filter, as when it is unsubscribed; transfers they were receiving end incomplete.
+         * @param filter Topic filter exactly as it was added.
+         * @return Number of sinks removed.
+         */
+        size_t remove(std::string_view filter);
+
+        /// @brief Whether no subscription reassembles chunked transfers.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_sinks.empty();
+        }
+
+        /**
+         * @brief Pass a received message on to the sink of its transfer if it is a chunk for one.
+         * A chunk already passed on, as when a QoS 1 chunk is sent again, is consumed without being passed on twice;
+         * a gap in the sequence ends the transfer incomplete.
+         * @param message The received message.
+         * @return True if the message was a chunk for a subscribed sink and needs no other delivery.
+         */
+        bool deliver(const MessageView& message);
+
+    private:
+        /// Transfer a topic is receiving, kept once complete so late duplicates of its chunks are recognised.
+        struct Assembly
+        {
+            PayloadSinkPtr sink;
+            std::uint64_t transferId = 0;
+            std::uint32_t nextSequence = 0;
+            std::uint32_t chunkCount = 0;
+            std::uint64_t totalSize = 0;
+            std::uint64_t received = 0;
+
+            [[nodiscard]] bool isComplete() const
+            {
+                return nextSequence == chunkCount;
+            }
+        };
+
+        [[nodiscard]] PayloadSinkPtr find(std::string_view topic) const;
+
+        std::vector<std::pair<std::string, PayloadSinkPtr>> m_sinks;
+        std::map<std::string, Assembly, std::less<>> m_assemblies;
+    };
+} // namespace reactormq::mqtt::client
@@ -4,6 +4,10 @@
 
 #include "reactormq/mqtt/client_factory.h"
 #include "client_impl.h"
+#include "consumer_group.h"
+#include "mapped_session_store.h"
+#include "reactor_group.h"
+#include "sharded_client.h"
 
 namespace reactormq::mqtt::client
 {
@@ -11,4 +15,44 @@ namespace reactormq::mqtt::client
     {
         return std::make_shared<ClientImpl>(settings);
     }
+
+    std::shared_ptr<IReactorGroup> createReactorGroup(
+        const size_t threadCount,
+        const ThreadPlacement& placement,
+        const BusyPollOptions& busyPoll,
+        const RebalanceOptions& rebalance)
+    {
+        return std::make_shared<ReactorGroup>(threadCount, placement, busyPoll, rebalance);
+    }
+
+    std::shared_ptr<IShardedClient> createShardedClient(
+        const ConnectionSettingsPtr& settings,
+        const size_t shardCount,
+        const std::shared_ptr<IReactorGroup>& group)
+    {
+        return std::make_shared<ShardedClient>(settings, shardCount, group);
+    }
+
+    std::shared_ptr<IConsumerGroup> createConsumerGroup(
+        const ConnectionSettingsPtr& settings,
+        const std::string_view shareName,
+        const TopicFilter& topicFilter,
+        const size_t consumerCount,
+        const std::shared_ptr<IReactorGroup>& group,
+        const size_t dispatchLanes)
+    {
+        return std::make_shared<ConsumerGroup>(settings, shareName, topicFilter, consumerCount, dispatchLanes, group);
+    }
+
+    SessionStorePtr createMappedSessionStore(const std::string& path, const size_t capacityBytes)
+    {
+#if REACTORMQ_PLATFORM_POSIX_FAMILY && !REACTORMQ_PLATFORM_WINDOWS_FAMILY
+        auto store = std::make_shared<MappedSessionStore>(path, capacityBytes);
+        return store->isOpen() ? store : nullptr;
+#else
+        (void)path;
+        (void)capacityBytes;
+        return nullptr;
+#endif
+    }
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -5,16 +5,90 @@
 #include "client_impl.h"
 
 #include "command.h"
+#include "mqtt/client/mqtt_version_mapping.h"
+#include "mqtt/packets/packet_batch.h"
+#include "serialize/utf8.h"
 
 #include <reactormq/mqtt/connection_settings.h>
 
 namespace reactormq::mqtt::client
 {
+    namespace
+    {
+        /// @brief Wrap a completion handler so it runs on the settings' CallbackExecutor, if one is set.
+        template<typename T>
+        CompletionHandler<T> throughExecutor(const ConnectionSettingsPtr& settings, CompletionHandler<T> handler)
+        {
+            if (!handler || !settings || !settings->getCallbackExecutor())
+            {
+                return handler;
+            }
+
+            return [executor = settings->getCallbackExecutor(), handler = std::move(handler)](const Result<T>& result)
+            { executor([handler, result] { handler(result); }); };
+        }
+
+        /**
+         * @brief Encode a publish on the calling thread, when the settings ask for it and the reactor would send it as
+         * encoded here: a payload small enough to be copied into the outbound batch, no payload codec and no Topic
+         * Alias. The reactor checks the rest when it sends it.
+         */
+        void encodeOnCallingThread(const ConnectionSettingsPtr& settings, PublishCommand& command)
+        {
+            if (!settings || !settings->shouldEncodePublishesOnCallingThread())
+            {
+                return;
+            }
+
+            const Message& message = command.message;
+            if (message.getPayloadView().size() >= packets::PacketBatch::kInlinePayloadBytes
+                || (kFixedProtocolVersion == packets::ProtocolVersion::V5 && !settings->getPayloadCodecs().empty()))
+            {
+                return;
+            }
+
+            // A topic the reactor would refuse is left for it to refuse, with the usual error.
+            if (settings->isStrictMode() && !serialize::isValidTopicName(message.getTopic()))
+            {
+                return;
+            }
+
+            // Each publishing thread keeps the header template of the topic it last published to, as the reactor keeps
+            // one per topic; a producer usually sends one topic after another.
+            thread_local packets::PublishTemplate lastTemplate;
+            const std::uint32_t messageExpiryInterval
+                = kFixedProtocolVersion == packets::ProtocolVersion::V5 ? message.getMessageExpiryInterval().value_or(0) : 0;
+            if (!lastTemplate.matches(
+                    kFixedProtocolVersion,
+                    message.getTopic(),
+                    message.getQualityOfService(),
+                    message.shouldRetain(),
+                    0,
+                    {},
+                    messageExpiryInterval))
+            {
+                lastTemplate = withMqttVersion(
+                    kFixedProtocolVersion,
+                    [&]<typename VersionTag>(VersionTag)
+                    {
+                        return packets::PublishTemplate::create<VersionTag::value>(
+                            message.getTopic(), message.getQualityOfService(), message.shouldRetain(), 0, {}, messageExpiryInterval);
+                    });
+            }
+            command.preEncoded = packets::PreEncodedPublish(lastTemplate, message.getPayloadView(), settings->getMemoryResource());
+        }
+    } // namespace
+
     ClientImpl::ClientImpl(const ConnectionSettingsPtr& settings)
         : m_reactor(std::make_shared<Reactor>(settings))
     {
     }
 
+    ClientImpl::ClientImpl(std::shared_ptr<Reactor> reactor)
+        : m_reactor(std::move(reactor))
+    {
+    }
+
     ClientImpl::~ClientImpl() = default;
 
     ConnectFuture ClientImpl::connectAsync(const bool cleanSession)
@@ -39,17 +113,130 @@ namespace reactormq::mqtt::client
         return future;
     }
 
+    void ClientImpl::connectAsync(const bool cleanSession, CompletionHandler<void> onComplete)
+    {
+        ConnectCommand cmd{ cleanSession, Completion<void>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::disconnectAsync(CompletionHandler<void> onComplete)
+    {
+        DisconnectCommand cmd{ Completion<void>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    DisconnectFuture ClientImpl::disconnectAsync(const DrainOptions& drain)
+    {
+        std::promise<Result<void>> promise;
+        auto future = promise.get_future();
+
+        DisconnectCommand cmd{ std::move(promise), drain };
+        m_reactor->enqueueCommand(std::move(cmd));
+
+        return future;
+    }
+
+    void ClientImpl::disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete)
+    {
+        DisconnectCommand cmd{ Completion<void>(throughExecutor(getSettings(), std::move(onComplete))), drain };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
     PublishFuture ClientImpl::publishAsync(Message&& message)
     {
         std::promise<Result<void>> promise;
         auto future = promise.get_future();
 
         PublishCommand cmd{ std::move(message), std::move(promise) };
+        encodeOnCallingThread(getSettings(), cmd);
+        m_reactor->enqueueCommand(std::move(cmd));
+
+        return future;
+    }
+
+    PublishFuture ClientImpl::publishBatchAsync(std::vector<Message>&& messages)
+    {
+        std::promise<Result<void>> promise;
+        auto future = promise.get_future();
+
+        PublishBatchCommand cmd{ std::move(messages), std::move(promise) };
         m_reactor->enqueueCommand(std::move(cmd));
 
         return future;
     }
 
+    void ClientImpl::publishBatchAsync(std::vector<Message>&& messages, PublishCallback onComplete)
+    {
+        PublishBatchCommand cmd{ std::move(messages), Completion<void>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::publish(Message&& message)
+    {
+        PublishCommand cmd{ std::move(message), PublishCompletion{} };
+        encodeOnCallingThread(getSettings(), cmd);
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::publish(Message&& message, PublishCallback onComplete)
+    {
+        PublishCommand cmd{ std::move(message), PublishCompletion(throughExecutor(getSettings(), std::move(onComplete))) };
+        encodeOnCallingThread(getSettings(), cmd);
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::publishStream(
+        std::string topic,
+        PayloadSourcePtr source,
+        const QualityOfService qualityOfService,
+        const bool shouldRetain,
+        PublishCallback onComplete)
+    {
+        PublishCompletion completion(throughExecutor(getSettings(), std::move(onComplete)));
+        if (!source)
+        {
+            completion.set_value(Result<void>::failure(ResultError::PayloadSourceFailed, "Null payload source"));
+            return;
+        }
+
+        PublishCommand cmd{ Message(std::move(topic), SharedPayload{}, shouldRetain, qualityOfService), std::move(completion) };
+        cmd.stream = std::move(source);
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::publishChunked(
+        std::string topic,
+        PayloadSourcePtr source,
+        const ChunkedTransferOptions& options,
+        PublishCallback onComplete)
+    {
+        Completion<void> completion(throughExecutor(getSettings(), std::move(onComplete)));
+        if (!source)
+        {
+            completion.set_value(Result<void>::failure(ResultError::PayloadSourceFailed, "Null payload source"));
+            return;
+        }
+
+        auto transfer = std::make_shared<ChunkedTransfer>();
+        transfer->topic = std::move(topic);
+        transfer->source = std::move(source);
+        transfer->options = options;
+        transfer->promise = std::move(completion);
+        transfer->isPumpQueued = true;
+        m_reactor->enqueueCommand(PublishChunkedCommand{ std::move(transfer) });
+    }
+
+    PublishReservation ClientImpl::allocatePublish(
+        std::string topic,
+        const size_t payloadSize,
+        const QualityOfService qualityOfService,
+        const bool shouldRetain)
+    {
+        const ConnectionSettingsPtr& settings = getSettings();
+        std::pmr::memory_resource* resource = settings ? settings->getMemoryResource() : std::pmr::new_delete_resource();
+        return PublishReservation(std::move(topic), payloadSize, qualityOfService, shouldRetain, resource);
+    }
+
     SubscribesFuture ClientImpl::subscribeAsync(const std::vector<TopicFilter>& topicFilters)
     {
         std::promise<Result<std::vector<SubscribeResult>>> promise;
@@ -72,11 +259,111 @@ namespace reactormq::mqtt::client
         return future;
     }
 
+    SubscribeFuture ClientImpl::subscribeAsync(TopicFilter&& topicFilter, MessageHandler handler)
+    {
+        std::promise<Result<SubscribeResult>> promise;
+        auto future = promise.get_future();
+
+        SubscribeCommand cmd{ std::move(topicFilter), std::move(promise), std::move(handler) };
+        m_reactor->enqueueCommand(std::move(cmd));
+
+        return future;
+    }
+
+    void ClientImpl::subscribeAsync(
+        const std::vector<TopicFilter>& topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete)
+    {
+        SubscribesCommand cmd{ topicFilters,
+                               Completion<std::vector<SubscribeResult>>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::subscribeAsync(TopicFilter&& topicFilter, MessageHandler handler, CompletionHandler<SubscribeResult> onComplete)
+    {
+        SubscribeCommand cmd{ std::move(topicFilter),
+                              Completion<SubscribeResult>(throughExecutor(getSettings(), std::move(onComplete))),
+                              std::move(handler) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::subscribeAsync(
+        TopicFilter&& topicFilter, MessageHandler handler, const HandlerDelivery delivery, CompletionHandler<SubscribeResult> onComplete)
+    {
+        SubscribeCommand cmd{ std::move(topicFilter),
+                              Completion<SubscribeResult>(throughExecutor(getSettings(), std::move(onComplete))),
+                              std::move(handler),
+                              nullptr,
+                              delivery == HandlerDelivery::LatestPerTopic };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::subscribeAsync(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete)
+    {
+        SubscribeCommand cmd{ std::move(topicFilter),
+                              Completion<SubscribeResult>(throughExecutor(getSettings(), std::move(onComplete))),
+                              nullptr,
+                              std::move(sink) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    void ClientImpl::subscribeChunked(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete)
+    {
+        SubscribeCommand cmd{ std::move(topicFilter),
+                              Completion<SubscribeResult>(throughExecutor(getSettings(), std::move(onComplete))),
+                              nullptr,
+                              std::move(sink) };
+        cmd.isChunked = true;
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
     SubscribeFuture ClientImpl::subscribeAsync(const std::string& topicFilter)
     {
         return subscribeAsync(TopicFilter{ topicFilter, QualityOfService::AtLeastOnce });
     }
 
+    SubscribesFuture ClientImpl::setSubscriptions(const std::span<const TopicFilter> topicFilters)
+    {
+        std::promise<Result<std::vector<SubscribeResult>>> promise;
+        auto future = promise.get_future();
+
+        SetSubscriptionsCommand cmd{ std::vector<TopicFilter>(topicFilters.begin(), topicFilters.end()), std::move(promise) };
+        m_reactor->enqueueCommand(std::move(cmd));
+
+        return future;
+    }
+
+    void ClientImpl::setSubscriptions(
+        const std::span<const TopicFilter> topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete)
+    {
+        SetSubscriptionsCommand cmd{ std::vector<TopicFilter>(topicFilters.begin(), topicFilters.end()),
+                                     Completion<std::vector<SubscribeResult>>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
+    RequestFuture ClientImpl::requestAsync(std::string topic, std::vector<std::uint8_t> payload, const std::chrono::milliseconds timeout)
+    {
+        std::promise<Result<Message>> promise;
+        auto future = promise.get_future();
+
+        RequestCommand cmd{ std::move(topic), std::move(payload), timeout, std::move(promise) };
+        m_reactor->enqueueCommand(std::move(cmd));
+
+        return future;
+    }
+
+    void ClientImpl::requestAsync(
+        std::string topic,
+        std::vector<std::uint8_t> payload,
+        const std::chrono::milliseconds timeout,
+        CompletionHandler<Message> onComplete)
+    {
+        RequestCommand cmd{ std::move(topic),
+                            std::move(payload),
+                            timeout,
+                            Completion<Message>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
     UnsubscribesFuture ClientImpl::unsubscribeAsync(const std::vector<std::string>& topics)
     {
         std::promise<Result<std::vector<UnsubscribeResult>>> promise;
@@ -88,6 +375,13 @@ namespace reactormq::mqtt::client
         return future;
     }
 
+    void ClientImpl::unsubscribeAsync(const std::vector<std::string>& topics, CompletionHandler<std::vector<UnsubscribeResult>> onComplete)
+    {
+        UnsubscribesCommand cmd{ topics,
+                                 Completion<std::vector<UnsubscribeResult>>(throughExecutor(getSettings(), std::move(onComplete))) };
+        m_reactor->enqueueCommand(std::move(cmd));
+    }
+
     OnConnect& ClientImpl::onConnect()
     {
         return m_reactor->getContext().getOnConnect();
@@ -118,6 +412,11 @@ namespace reactormq::mqtt::client
         return m_reactor->getContext().getOnMessage();
     }
 
+    OnMessageView& ClientImpl::onMessageView()
+    {
+        return m_reactor->getContext().getOnMessageView();
+    }
+
     bool ClientImpl::isConnected() const
     {
         return m_reactor->isConnected();
@@ -133,4 +432,44 @@ namespace reactormq::mqtt::client
     {
         m_reactor->tick();
     }
+
+    void ClientImpl::waitAndTick(const std::chrono::milliseconds maxWait)
+    {
+        m_reactor->waitAndTick(maxWait);
+    }
+
+    size_t ClientImpl::getCommandQueueDepth() const
+    {
+        return m_reactor->getCommandQueueDepth();
+    }
+
+    size_t ClientImpl::getInboundBacklogBytes() const
+    {
+        return m_reactor->getInboundBacklogBytes();
+    }
+
+    ClientMetrics ClientImpl::getMetrics() const
+    {
+        return m_reactor->getMetrics();
+    }
+
+    TickProfile ClientImpl::getTickProfile() const
+    {
+        return m_reactor->getTickProfile();
+    }
+
+    InboundTraffic ClientImpl::getInboundTraffic() const
+    {
+        return m_reactor->getInboundTraffic();
+    }
+
+    std::shared_ptr<const Message> ClientImpl::getLastValue(const std::string_view topic) const
+    {
+        return m_reactor->getLastValue(topic);
+    }
+
+    const ConnectionSettingsPtr& ClientImpl::getSettings() const
+    {
+        return m_reactor->getContext().getSettings();
+    }
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -28,22 +28,94 @@ namespace reactormq::mqtt::client
          */
         explicit ClientImpl(const ConnectionSettingsPtr& settings);
 
+        /**
+         * @brief Construct a client around an existing reactor (for example one driven by a ReactorGroup thread).
+         * @param reactor Reactor that executes this client's commands.
+         */
+        explicit ClientImpl(std::shared_ptr<Reactor> reactor);
+
         ~ClientImpl() override;
 
         ConnectFuture connectAsync(bool cleanSession) override;
 
         DisconnectFuture disconnectAsync() override;
 
+        void connectAsync(bool cleanSession, CompletionHandler<void> onComplete) override;
+
+        void disconnectAsync(CompletionHandler<void> onComplete) override;
+        DisconnectFuture disconnectAsync(const DrainOptions& drain) override;
+        void disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete) override;
+
         PublishFuture publishAsync(Message&& message) override;
 
+        PublishFuture publishBatchAsync(std::vector<Message>&& messages) override;
+
+        void publishBatchAsync(std::vector<Message>&& messages, PublishCallback onComplete) override;
+
+        void publish(Message&& message) override;
+
+        void publish(Message&& message, PublishCallback onComplete) override;
+
+        void publishStream(
+            std::string topic,
+            PayloadSourcePtr source,
+            QualityOfService qualityOfService,
+            bool shouldRetain,
+            PublishCallback onComplete) override;
+
+        void publishChunked(
+            std::string topic,
+            PayloadSourcePtr source,
+            const ChunkedTransferOptions& options,
+            PublishCallback onComplete) override;
+
+        [[nodiscard]] PublishReservation allocatePublish(
+            std::string topic,
+            size_t payloadSize,
+            QualityOfService qualityOfService,
+            bool shouldRetain) override;
+
         SubscribesFuture subscribeAsync(const std::vector<TopicFilter>& topicFilters) override;
 
         SubscribeFuture subscribeAsync(TopicFilter&& topicFilter) override;
 
+        SubscribeFuture subscribeAsync(TopicFilter&& topicFilter, MessageHandler handler) override;
+
         SubscribeFuture subscribeAsync(const std::string& topicFilter) override;
 
+        void subscribeAsync(
+            const std::vector<TopicFilter>& topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete) override;
+
+        void subscribeAsync(TopicFilter&& topicFilter, MessageHandler handler, CompletionHandler<SubscribeResult> onComplete) override;
+
+        void subscribeAsync(
+            TopicFilter&& topicFilter,
+            MessageHandler handler,
+            HandlerDelivery delivery,
+            CompletionHandler<SubscribeResult> onComplete) override;
+
+        void subscribeAsync(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete) override;
+
+        void subscribeChunked(TopicFilter&& topicFilter, PayloadSinkPtr sink, CompletionHandler<SubscribeResult> onComplete) override;
+
+        SubscribesFuture setSubscriptions(std::span<const TopicFilter> topicFilters) override;
+
+        void setSubscriptions(
+            std::span<const TopicFilter> topicFilters, CompletionHandler<std::vector<SubscribeResult>> onComplete) override;
+
+        RequestFuture requestAsync(std::string topic, std::vector<std::uint8_t> payload, std::chrono::milliseconds timeout) override;
+
+        void requestAsync(
+            std::string topic,
+            std::vector<std::uint8_t> payload,
+            std::chrono::milliseconds timeout,
+            CompletionHandler<Message> onComplete) override;
+
         UnsubscribesFuture unsubscribeAsync(const std::vector<std::string>& topics) override;
 
+        void unsubscribeAsync(
+            const std::vector<std::string>& topics, CompletionHandler<std::vector<UnsubscribeResult>> onComplete) override;
+
         OnConnect& onConnect() override;
 
         OnDisconnect& onDisconnect() override;
@@ -56,6 +128,8 @@ namespace reactormq::mqtt::client
 
         OnMessage& onMessage() override;
 
+        OnMessageView& onMessageView() override;
+
         [[nodiscard]] bool isConnected() const override;
 
         void closeSocket(std::int32_t code, const std::string& reason) override;
@@ -66,7 +140,34 @@ namespace reactormq::mqtt::client
          */
         void tick() override;
 
+        /**
+         * @brief Wait for socket I/O, a timer deadline, or a queued command, then tick the reactor.
+         * @param maxWait Upper bound on the wait.
+         */
+        void waitAndTick(std::chrono::milliseconds maxWait) override;
+
+        /// @brief Approximate number of commands waiting for the reactor.
+        [[nodiscard]] size_t getCommandQueueDepth() const override;
+
+        /// @brief Inbound bytes held back by the per-tick inbound budget.
+        [[nodiscard]] size_t getInboundBacklogBytes() const override;
+
+        /// @brief Snapshot of traffic, connection and reactor metrics.
+        [[nodiscard]] ClientMetrics getMetrics() const override;
+
+        /// @brief Rolling per-phase cost of recent reactor ticks.
+        [[nodiscard]] TickProfile getTickProfile() const override;
+
+        /// @brief Received messages, bytes and drops per subscription and busiest topic prefix.
+        [[nodiscard]] InboundTraffic getInboundTraffic() const override;
+
+        /// @brief Latest message kept for a topic.
+        [[nodiscard]] std::shared_ptr<const Message> getLastValue(std::string_view topic) const override;
+
     private:
+        /// @brief Settings of the client's reactor, for completion handlers that go through the callback executor.
+        [[nodiscard]] const ConnectionSettingsPtr& getSettings() const;
+
         std::shared_ptr<Reactor> m_reactor;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -0,0 +1,196 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/client_metrics.h"
+#include "socket/traffic_counters.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace reactormq::mqtt::client
+{
+    /// @brief Live side of a LatencyHistogram; written by the reactor thread only, read from any thread.
+    struct AtomicLatencyHistogram
+    {
+        std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> counts{};
+        std::atomic<std::uint64_t> count{ 0 };
+        std::atomic<std::uint64_t> sumUs{ 0 };
+        std::atomic<std::uint64_t> maxUs{ 0 };
+
+        void record(const std::chrono::steady_clock::duration duration)
+        {
+            const auto ticks = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+            const auto us = static_cast<std::uint64_t>(ticks < 0 ? 0 : ticks);
+            counts[LatencyHistogram::getBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+            sumUs.fetch_add(us, std::memory_order_relaxed);
+            // Single writer, so a plain max needs no compare-exchange loop.
+            if (us > maxUs.load(std::memory_order_relaxed))
+            {
+                maxUs.store(us, std::memory_order_relaxed);
+            }
+        }
+
+        void fill(LatencyHistogram& out) const
+        {
+            for (size_t i = 0; i < counts.size(); ++i)
+            {
+                out.counts[i] = counts[i].load(std::memory_order_relaxed);
+            }
+            out.count = count.load(std::memory_order_relaxed);
+            out.sumUs = sumUs.load(std::memory_order_relaxed);
+            out.maxUs = maxUs.load(std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Live side of a PublishLatency.
+    struct AtomicPublishLatency
+    {
+        AtomicLatencyHistogram queued;
+        AtomicLatencyHistogram acknowledged;
+        AtomicLatencyHistogram total;
+    };
+
+    /**
+     * @brief Live counters behind IClient::getMetrics(), owned by the context so they span reconnects.
+     * The reactor thread writes them with relaxed atomics and any thread may snapshot them; nothing here takes a lock.
+     */
+    struct ClientMetricCounters
+    {
+        /// Shared with each socket the context uses.
+        std::shared_ptr<socket::TrafficCounters> traffic = std::make_shared<socket::TrafficCounters>();
+
+        std::atomic<std::uint64_t> messagesPublished{ 0 };
+        std::atomic<std::uint64_t> messagesReceived{ 0 };
+        std::atomic<std::uint64_t> messagesExpired{ 0 };
+        std::atomic<std::uint64_t> messagesDeduplicated{ 0 };
+        std::atomic<std::uint64_t> messagesRateLimited{ 0 };
+        std::atomic<std::uint64_t> connectAttempts{ 0 };
+        std::atomic<std::uint64_t> connections{ 0 };
+        std::atomic<std::uint64_t> disconnects{ 0 };
+        std::atomic<std::uint64_t> reauthentications{ 0 };
+        std::atomic<std::uint64_t> parseFailures{ 0 };
+
+        /// Reactor-thread gauges, mirrored at the end of each tick.
+        std::atomic<size_t> inFlightCommands{ 0 };
+        std::atomic<size_t> outboundQueueBytes{ 0 };
+        std::atomic<size_t> offlinePublishes{ 0 };
+
+        std::array<std::atomic<std::uint64_t>, ClientMetrics::kTickDurationBuckets> tickDurationsUs{};
+        std::atomic<std::uint64_t> tickDurationSumUs{ 0 };
+
+        using PublishLatencies = std::array<AtomicPublishLatency, 3>;
+
+        /// Latency histograms by QoS (17 KiB); allocated by the first publish recorded, so an idle client has none.
+        std::unique_ptr<PublishLatencies> publishLatencyStorage;
+
+        /// publishLatencyStorage once allocated, for readers on other threads; null until then.
+        std::atomic<const PublishLatencies*> publishLatency{ nullptr };
+
+        static void increment(std::atomic<std::uint64_t>& counter)
+        {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Add one reactor tick to the duration histogram.
+        void recordTick(const std::chrono::steady_clock::duration duration)
+        {
+            const auto us = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+            // Bucket i holds durations below 2^i us, so it is the bit width of the value.
+            const size_t bucket = std::min<size_t>(static_cast<size_t>(std::bit_width(us)), tickDurationsUs.size() - 1);
+            tickDurationsUs[bucket].fetch_add(1, std::memory_order_relaxed);
+            tickDurationSumUs.fetch_add(us, std::memory_order_relaxed);
+        }
+
+        /// @brief Latency histograms, allocated on first use. Reactor thread only.
+        PublishLatencies& getPublishLatency()
+        {
+            if (!publishLatencyStorage)
+            {
+                publishLatencyStorage = std::make_unique<PublishLatencies>();
+                publishLatency.store(publishLatencyStorage.get(), std::memory_order_release);
+            }
+            return *publishLatencyStorage;
+        }
+
+        /**
+         * @brief Record a PUBLISH handed to the socket.
+         * @param qos QoS level of the publish, indexing publishLatency.
+         * @param enqueuedAt When the publish was requested.
+         * @param sentAt When it was handed to the socket.
+         */
+        void recordPublishSent(
+            const size_t qos, const std::chrono::steady_clock::time_point enqueuedAt, const std::chrono::steady_clock::time_point sentAt)
+        {
+            PublishLatencies& latencies = getPublishLatency();
+            AtomicPublishLatency& latency = latencies[std::min(qos, latencies.size() - 1)];
+            latency.queued.record(sentAt - enqueuedAt);
+            if (qos == 0)
+            {
+                latency.total.record(sentAt - enqueuedAt);
+            }
+        }
+
+        /**
+         * @brief Record the PUBACK or PUBCOMP that completed a QoS 1/2 publish.
+         * @param qos QoS level of the publish, indexing publishLatency.
+         * @param enqueuedAt When the publish was requested.
+         * @param sentAt When it was first handed to the socket.
+         * @param acknowledgedAt When the acknowledgement arrived.
+         */
+        void recordPublishAcknowledged(
+            const size_t qos,
+            const std::chrono::steady_clock::time_point enqueuedAt,
+            const std::chrono::steady_clock::time_point sentAt,
+            const std::chrono::steady_clock::time_point acknowledgedAt)
+        {
+            PublishLatencies& latencies = getPublishLatency();
+            AtomicPublishLatency& latency = latencies[std::min(qos, latencies.size() - 1)];
+            latency.acknowledged.record(acknowledgedAt - sentAt);
+            latency.total.record(acknowledgedAt - enqueuedAt);
+        }
+
+        /// @brief Copy the counters and mirrored gauges into a snapshot.
+        void fill(ClientMetrics& out) const
+        {
+            out.inFlightCommands = inFlightCommands.load(std::memory_order_relaxed);
+            out.outboundQueueBytes = outboundQueueBytes.load(std::memory_order_relaxed);
+            out.offlinePublishes = offlinePublishes.load(std::memory_order_relaxed);
+            out.bytesSent = traffic->bytesSent.load(std::memory_order_relaxed);
+            out.bytesReceived = traffic->bytesReceived.load(std::memory_order_relaxed);
+            out.packetsSent = traffic->packetsSent.load(std::memory_order_relaxed);
+            out.packetsReceived = traffic->packetsReceived.load(std::memory_order_relaxed);
+            out.messagesPublished = messagesPublished.load(std::memory_order_relaxed);
+            out.messagesReceived = messagesReceived.load(std::memory_order_relaxed);
+            out.messagesExpired = messagesExpired.load(std::memory_order_relaxed);
+            out.messagesDeduplicated = messagesDeduplicated.load(std::memory_order_relaxed);
+            out.messagesRateLimited = messagesRateLimited.load(std::memory_order_relaxed);
+            out.connectAttempts = connectAttempts.load(std::memory_order_relaxed);
+            out.connections = connections.load(std::memory_order_relaxed);
+            out.disconnects = disconnects.load(std::memory_order_relaxed);
+            out.reauthentications = reauthentications.load(std::memory_order_relaxed);
+            out.parseFailures = parseFailures.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < tickDurationsUs.size(); ++i)
+            {
+                out.tickDurationsUs[i] = tickDurationsUs[i].load(std::memory_order_relaxed);
+            }
+            out.tickDurationSumUs = tickDurationSumUs.load(std::memory_order_relaxed);
+            const PublishLatencies* latencies = publishLatency.load(std::memory_order_acquire);
+            for (size_t qos = 0; nullptr != latencies && qos < latencies->size(); ++qos)
+            {
+                (*latencies)[qos].queued.fill(out.publishLatency[qos].queued);
+                (*latencies)[qos].acknowledged.fill(out.publishLatency[qos].acknowledged);
+                (*latencies)[qos].total.fill(out.publishLatency[qos].total);
+            }
+        }
+    };
+} // namespace reactormq::mqtt::client
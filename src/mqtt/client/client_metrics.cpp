@@ -0,0 +1,137 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/client_metrics.h"
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    namespace
+    {
+        /// Label values escape backslash, double quote and newline.
+        std::string escapeLabelValue(const std::string_view value)
+        {
+            std::string escaped;
+            escaped.reserve(value.size());
+            for (const char c : value)
+            {
+                switch (c)
+                {
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                case '"':
+                    escaped += "\\\"";
+                    break;
+                case '\n':
+                    escaped += "\\n";
+                    break;
+                default:
+                    escaped += c;
+                    break;
+                }
+            }
+            return escaped;
+        }
+
+        void appendSample(
+            std::string& out,
+            const char* name,
+            const char* type,
+            const char* help,
+            const std::string& label,
+            const std::uint64_t value)
+        {
+            out += std::format("# HELP {} {}\n# TYPE {} {}\n{}{{client_id=\"{}\"}} {}\n", name, help, name, type, name, label, value);
+        }
+    } // namespace
+
+    std::string formatPrometheusMetrics(const ClientMetrics& metrics, const std::string_view clientId)
+    {
+        const std::string label = escapeLabelValue(clientId);
+        std::string out;
+        out.reserve(4096);
+
+        appendSample(out, "reactormq_command_queue_depth", "gauge", "API calls queued for the reactor.", label, metrics.commandQueueDepth);
+        appendSample(
+            out, "reactormq_in_flight_commands", "gauge", "Commands awaiting an acknowledgement or held.", label, metrics.inFlightCommands);
+        appendSample(
+            out, "reactormq_outbound_queue_bytes", "gauge", "Bytes held against the outbound queue limit.", label, metrics.outboundQueueBytes);
+        appendSample(
+            out, "reactormq_inbound_backlog_bytes", "gauge", "Received bytes held back by the inbound budget.", label, metrics.inboundBacklogBytes);
+        appendSample(
+            out, "reactormq_pending_deliveries", "gauge", "Messages whose handlers have not finished.", label, metrics.pendingDeliveries);
+        appendSample(out, "reactormq_offline_publishes", "gauge", "Publishes queued while disconnected.", label, metrics.offlinePublishes);
+
+        appendSample(out, "reactormq_sent_bytes_total", "counter", "Bytes handed to the transport.", label, metrics.bytesSent);
+        appendSample(out, "reactormq_received_bytes_total", "counter", "Bytes of complete packets received.", label, metrics.bytesReceived);
+        appendSample(out, "reactormq_sent_packets_total", "counter", "MQTT packets handed to the transport.", label, metrics.packetsSent);
+        appendSample(out, "reactormq_received_packets_total", "counter", "Complete MQTT packets received.", label, metrics.packetsReceived);
+        appendSample(out, "reactormq_published_messages_total", "counter", "PUBLISH packets sent.", label, metrics.messagesPublished);
+        appendSample(out, "reactormq_received_messages_total", "counter", "PUBLISH packets received.", label, metrics.messagesReceived);
+        appendSample(
+            out, "reactormq_expired_messages_total", "counter", "Publishes dropped unsent on expiry.", label, metrics.messagesExpired);
+        appendSample(
+            out, "reactormq_deduplicated_messages_total", "counter", "Publishes skipped as unchanged.", label, metrics.messagesDeduplicated);
+        appendSample(
+            out, "reactormq_rate_limited_messages_total", "counter", "Publishes dropped by a rate limit.", label, metrics.messagesRateLimited);
+        appendSample(out, "reactormq_connect_attempts_total", "counter", "Connection attempts started.", label, metrics.connectAttempts);
+        appendSample(out, "reactormq_connections_total", "counter", "Connections that became ready.", label, metrics.connections);
+        appendSample(out, "reactormq_disconnects_total", "counter", "Ready connections that ended.", label, metrics.disconnects);
+        appendSample(
+            out, "reactormq_reauthentications_total", "counter", "Re-authentications accepted.", label, metrics.reauthentications);
+        appendSample(out, "reactormq_parse_failures_total", "counter", "Received packets that failed to decode.", label, metrics.parseFailures);
+
+        // Histogram buckets are cumulative; bucket i holds ticks under 2^i us, which is le = 2^i - 1 in whole us.
+        constexpr const char* kTickName = "reactormq_tick_duration_microseconds";
+        out += std::format("# HELP {} Reactor tick duration.\n# TYPE {} histogram\n", kTickName, kTickName);
+        std::uint64_t cumulative = 0;
+        for (size_t i = 0; i + 1 < metrics.tickDurationsUs.size(); ++i)
+        {
+            cumulative += metrics.tickDurationsUs[i];
+            out += std::format("{}_bucket{{client_id=\"{}\",le=\"{}\"}} {}\n", kTickName, label, (std::uint64_t{ 1 } << i) - 1, cumulative);
+        }
+        cumulative += metrics.tickDurationsUs.back();
+        out += std::format("{}_bucket{{client_id=\"{}\",le=\"+Inf\"}} {}\n", kTickName, label, cumulative);
+        out += std::format("{}_sum{{client_id=\"{}\"}} {}\n", kTickName, label, metrics.tickDurationSumUs);
+        out += std::format("{}_count{{client_id=\"{}\"}} {}\n", kTickName, label, cumulative);
+
+        // Publish latency has far too many buckets for a Prometheus histogram, so it is exported as a summary.
+        constexpr const char* kLatencyName = "reactormq_publish_latency_microseconds";
+        constexpr std::array<std::pair<const char*, double>, 4> kQuantiles{ {
+            { "0.5", 50.0 },
+            { "0.9", 90.0 },
+            { "0.99", 99.0 },
+            { "0.999", 99.9 },
+        } };
+        out += std::format("# HELP {} Publish latency by QoS and stage.\n# TYPE {} summary\n", kLatencyName, kLatencyName);
+        for (size_t qos = 0; qos < metrics.publishLatency.size(); ++qos)
+        {
+            const PublishLatency& latency = metrics.publishLatency[qos];
+            const std::array<std::pair<const char*, const LatencyHistogram*>, 3> stages{ {
+                { "queued", &latency.queued },
+                { "acknowledged", &latency.acknowledged },
+                { "total", &latency.total },
+            } };
+            for (const auto& [stage, histogram] : stages)
+            {
+                const std::string labels = std::format("client_id=\"{}\",qos=\"{}\",stage=\"{}\"", label, qos, stage);
+                for (const auto& [quantile, percentile] : kQuantiles)
+                {
+                    out += std::format(
+                        "{}{{{},quantile=\"{}\"}} {}\n", kLatencyName, labels, quantile, histogram->getValueAtPercentile(percentile));
+                }
+                out += std::format("{}_sum{{{}}} {}\n", kLatencyName, labels, histogram->sumUs);
+                out += std::format("{}_count{{{}}} {}\n", kLatencyName, labels, histogram->count);
+            }
+        }
+        return out;
+    }
+} // namespace reactormq::mqtt
@@ -4,13 +4,26 @@
 
 #pragma once
 
+#include "mqtt/client/chunked_transfer.h"
+#include "mqtt/client/completion.h"
+#include "mqtt/client/publish_completion.h"
+#include "mqtt/packets/pre_encoded_publish.h"
+#include "reactormq/mqtt/drain_options.h"
 #include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/payload_source.h"
 #include "reactormq/mqtt/result.h"
 #include "reactormq/mqtt/subscribe_result.h"
+#include "reactormq/mqtt/subscribable_async.h"
 #include "reactormq/mqtt/topic_filter.h"
 #include "reactormq/mqtt/unsubscribe_result.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <future>
+#include <memory>
+#include <optional>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -22,7 +35,7 @@ namespace reactormq::mqtt::client
     struct ConnectCommand
     {
         bool cleanSession;
-        std::promise<Result<void>> promise;
+        Completion<void> promise;
     };
 
     /**
@@ -31,7 +44,94 @@ namespace reactormq::mqtt::client
     struct PublishCommand
     {
         Message message;
-        std::promise<Result<void>> promise;
+        PublishCompletion promise;
+
+        /// When the publish was requested; the start of its latency.
+        std::chrono::steady_clock::time_point enqueuedAt = std::chrono::steady_clock::now();
+
+        /// When its PUBLISH was first handed to the socket; unset for publishes restored from a session store.
+        std::chrono::steady_clock::time_point sentAt{};
+
+        /// Payload of a streamed publish, read as the socket drains; the message's own payload is then empty.
+        PayloadSourcePtr stream;
+
+        /// The whole packet, encoded on the publishing thread; empty when the reactor thread encodes it.
+        packets::PreEncodedPublish preEncoded;
+
+        /// @brief When the message's Message Expiry Interval runs out, counted from enqueuedAt; unset if it has none.
+        [[nodiscard]] std::optional<std::chrono::steady_clock::time_point> getExpiresAt() const
+        {
+            const auto interval = message.getMessageExpiryInterval();
+            return interval ? std::optional(enqueuedAt + std::chrono::seconds(*interval)) : std::nullopt;
+        }
+
+        /// @brief Whether the message expired before now.
+        [[nodiscard]] bool hasExpired(const std::chrono::steady_clock::time_point now) const
+        {
+            const auto expiresAt = getExpiresAt();
+            return expiresAt && *expiresAt <= now;
+        }
+
+        /**
+         * @brief Message Expiry Interval to send: the lifetime left, rounded up to whole seconds.
+         * @param now Current time.
+         * @return Seconds left, at least 1; 0 when the message does not expire.
+         */
+        [[nodiscard]] std::uint32_t getRemainingExpiryInterval(const std::chrono::steady_clock::time_point now) const
+        {
+            const auto expiresAt = getExpiresAt();
+            if (!expiresAt)
+            {
+                return 0;
+            }
+            const auto remaining = std::chrono::ceil<std::chrono::seconds>(*expiresAt - now).count();
+            return static_cast<std::uint32_t>(std::max<std::chrono::seconds::rep>(remaining, 1));
+        }
+    };
+
+    /**
+     * @brief Command to publish several messages, in order, behind one future.
+     * The reactor unpacks it into publish commands that share a PublishBatch.
+     */
+    struct PublishBatchCommand
+    {
+        std::vector<Message> messages;
+        Completion<void> promise;
+
+        /// When the batch was requested; each of its publishes measures latency from here.
+        std::chrono::steady_clock::time_point enqueuedAt = std::chrono::steady_clock::now();
+    };
+
+    /**
+     * @brief Command to publish more chunks of a chunked transfer.
+     * The reactor publishes chunks until the transfer's window is full, and queues this command again as they are
+     * acknowledged; see Reactor::pumpChunkedTransfer().
+     */
+    struct PublishChunkedCommand
+    {
+        std::shared_ptr<ChunkedTransfer> transfer;
+    };
+
+    /**
+     * @brief Shared outcome of a multi-filter subscribe too large for one SUBSCRIBE, sent as several.
+     * The filters stay here and each packet names its share; the promise is set once every packet has been
+     * acknowledged. Only touched on the reactor thread.
+     */
+    struct SubscribeBatch
+    {
+        std::vector<TopicFilter> topicFilters;
+        Completion<std::vector<SubscribeResult>> promise;
+        /// Whether the broker granted each filter, in filter order; sized up front.
+        std::vector<std::uint8_t> granted;
+        size_t remaining = 0;
+    };
+
+    /// @brief One SUBSCRIBE's share of a SubscribeBatch: the filters [offset, offset + count).
+    struct SubscribeBatchSlice
+    {
+        std::shared_ptr<SubscribeBatch> batch;
+        size_t offset = 0;
+        size_t count = 0;
     };
 
     /**
@@ -40,7 +140,10 @@ namespace reactormq::mqtt::client
     struct SubscribesCommand
     {
         std::vector<TopicFilter> topicFilters;
-        std::promise<Result<std::vector<SubscribeResult>>> promise;
+        Completion<std::vector<SubscribeResult>> promise;
+        /// Set on each packet of a subscribe split to fit the broker's maximum packet size, which then carries no
+        /// filters or promise of its own.
+        SubscribeBatchSlice slice = {};
     };
 
     /**
@@ -49,7 +152,15 @@ namespace reactormq::mqtt::client
     struct SubscribeCommand
     {
         TopicFilter topicFilter;
-        std::promise<Result<SubscribeResult>> promise;
+        Completion<SubscribeResult> promise;
+        /// Routes messages matching the filter to this handler once SUBSCRIBE is sent; empty for none.
+        MessageHandler handler = nullptr;
+        /// Takes the payloads of matching messages over the inbound streaming threshold; null for none.
+        PayloadSinkPtr sink = nullptr;
+        /// The handler gets only the newest message per topic; see HandlerDelivery::LatestPerTopic.
+        bool isConflated = false;
+        /// The sink reassembles chunked transfers instead of taking large messages; see subscribeChunked().
+        bool isChunked = false;
     };
 
     /**
@@ -58,7 +169,7 @@ namespace reactormq::mqtt::client
     struct UnsubscribesCommand
     {
         std::vector<std::string> topics;
-        std::promise<Result<std::vector<UnsubscribeResult>>> promise;
+        Completion<std::vector<UnsubscribeResult>> promise;
     };
 
     /**
@@ -67,7 +178,59 @@ namespace reactormq::mqtt::client
     struct UnsubscribeCommand
     {
         std::string topic;
-        std::promise<Result<UnsubscribeResult>> promise;
+        Completion<UnsubscribeResult> promise;
+    };
+
+    /**
+     * @brief Command to make the client's subscriptions exactly the given filters.
+     * The reactor compares them with the SubscriptionCache and sends only the difference, as one subscribes command
+     * and one unsubscribes command that share a SubscriptionSetUpdate.
+     */
+    struct SetSubscriptionsCommand
+    {
+        std::vector<TopicFilter> topicFilters;
+        Completion<std::vector<SubscribeResult>> promise;
+    };
+
+    /**
+     * @brief Shared outcome of a SetSubscriptionsCommand: the results of its SUBSCRIBE, and the first error of either
+     * packet. The promise is set once both have completed. Only touched on the reactor thread.
+     */
+    struct SubscriptionSetUpdate
+    {
+        Completion<std::vector<SubscribeResult>> promise;
+        std::vector<SubscribeResult> subscribed;
+        std::optional<ResultError> error;
+        size_t remaining = 0;
+        /// The SUBSCRIBE has been handed to the state and has not completed yet.
+        bool isSubscribing = false;
+
+        /// @brief Count one packet as complete, failed with @p packetError if set; the last one sets the promise.
+        void complete(const std::optional<ResultError> packetError)
+        {
+            if (!error)
+            {
+                error = packetError;
+            }
+            if (--remaining > 0)
+            {
+                return;
+            }
+            promise.set_value(
+                error ? Result<std::vector<SubscribeResult>>::failure(*error)
+                      : Result<std::vector<SubscribeResult>>::success(std::move(subscribed)));
+        }
+    };
+
+    /**
+     * @brief Command to publish an MQTT 5 request and wait for the response to it.
+     */
+    struct RequestCommand
+    {
+        std::string topic;
+        std::vector<std::uint8_t> payload;
+        std::chrono::milliseconds timeout;
+        Completion<Message> promise;
     };
 
     /**
@@ -75,7 +238,10 @@ namespace reactormq::mqtt::client
      */
     struct DisconnectCommand
     {
-        std::promise<Result<void>> promise;
+        Completion<void> promise;
+
+        /// @brief Work to let finish before DISCONNECT; empty to disconnect at once.
+        std::optional<DrainOptions> drain;
     };
 
     /**
@@ -93,10 +259,14 @@ namespace reactormq::mqtt::client
     using Command = std::variant<
         ConnectCommand,
         PublishCommand,
+        PublishBatchCommand,
+        PublishChunkedCommand,
         SubscribesCommand,
         SubscribeCommand,
         UnsubscribesCommand,
         UnsubscribeCommand,
+        SetSubscriptionsCommand,
+        RequestCommand,
         DisconnectCommand,
         CloseSocketCommand>;
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -0,0 +1,63 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/result.h"
+
+#include <future>
+#include <utility>
+#include <variant>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Where a command reports its outcome: a caller's promise, a completion handler, or nowhere.
+     *
+     * Shaped like std::promise so the state machine completes each kind the same way. A default-constructed
+     * completion reports to nobody and allocates nothing.
+     *
+     * @tparam T Result value type.
+     */
+    template<typename T>
+    class Completion final
+    {
+    public:
+        Completion() = default;
+
+        /// @brief Report to a caller's future.
+        Completion(std::promise<Result<T>> promise)
+            : m_target(std::move(promise))
+        {
+        }
+
+        /// @brief Report to a handler; an empty handler reports to nobody.
+        explicit Completion(CompletionHandler<T> handler)
+        {
+            if (handler)
+            {
+                m_target = std::move(handler);
+            }
+        }
+
+        /// @brief Report the outcome; later calls do nothing.
+        void set_value(const Result<T>& result)
+        {
+            // Detach first: a handler may resume a coroutine that goes on to reuse or destroy this command.
+            auto target = std::exchange(m_target, std::monostate{});
+            if (auto* promise = std::get_if<std::promise<Result<T>>>(&target))
+            {
+                promise->set_value(result);
+            }
+            else if (const auto* handler = std::get_if<CompletionHandler<T>>(&target))
+            {
+                (*handler)(result);
+            }
+        }
+
+    private:
+        std::variant<std::monostate, std::promise<Result<T>>, CompletionHandler<T>> m_target;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,110 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/atomic_shared_ptr.h"
+#include "mqtt/client/topic_router.h"
+#include "reactormq/mqtt/message.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The handlers of subscriptions made with HandlerDelivery::LatestPerTopic, with the message each is yet to
+     * be called with per topic.
+     *
+     * The reactor thread swaps a newer message into a topic's pending slot; only the swap that finds the slot empty
+     * queues a call, and that call takes whatever the slot holds when it runs. So however many messages arrive before
+     * the executor gets to it, the handler sees the newest once. Handlers are the ones TopicRouter matched, looked up
+     * by identity. Not thread-safe apart from the slots; the registry belongs to the reactor thread.
+     */
+    class ConflatedHandlers final
+    {
+    public:
+        /// @brief The message a handler is yet to be called with on one topic; empty once the call has taken it.
+        using Pending = AtomicSharedPtr<const Message>;
+
+        /**
+         * @brief Deliver only the newest message per topic to a handler.
+         * @param filter Topic filter the handler was routed for.
+         * @param handler The handler, as added to TopicRouter.
+         */
+        void add(const std::string_view filter, TopicRouter::Handler handler)
+        {
+            const MessageHandler* key = handler.get();
+            m_handlers.insert_or_assign(key, Entry{ std::string(filter), std::move(handler), {} });
+        }
+
+        /**
+         * @brief Drop the handlers of a filter, as when it is unsubscribed. Calls already queued still run.
+         * @param filter Topic filter exactly as it was added.
+         * @return Number of handlers removed.
+         */
+        size_t remove(const std::string_view filter)
+        {
+            return std::erase_if(
+                m_handlers,
+                [filter](const auto& entry)
+                {
+                    return entry.second.filter == filter;
+                });
+        }
+
+        /**
+         * @brief The pending slot of a handler for a topic, created on first use.
+         * @param handler A handler TopicRouter matched.
+         * @param topic Topic name of the message.
+         * @return The slot, or nullptr when the handler takes every message.
+         */
+        [[nodiscard]] std::shared_ptr<Pending> findPending(const MessageHandler* handler, const std::string_view topic)
+        {
+            const auto it = m_handlers.find(handler);
+            if (it == m_handlers.end())
+            {
+                return nullptr;
+            }
+
+            auto& pending = it->second.pending;
+            if (const auto slot = pending.find(topic); slot != pending.end())
+            {
+                return slot->second;
+            }
+            return pending.emplace(std::string(topic), std::make_shared<Pending>()).first->second;
+        }
+
+        /// @brief Whether no subscription conflates its messages.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_handlers.empty();
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        struct Entry
+        {
+            std::string filter;
+            TopicRouter::Handler handler;
+            std::unordered_map<std::string, std::shared_ptr<Pending>, StringHash, std::equal_to<>> pending;
+        };
+
+        std::unordered_map<const MessageHandler*, Entry> m_handlers;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,116 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/mqtt_version_mapping.h"
+#include "mqtt/packets/connect.h"
+#include "reactormq/mqtt/credentials.h"
+#include "serialize/bytes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The last CONNECT this client encoded, kept across reconnects.
+     *
+     * A reconnect whose client ID, credentials, auth data, clean start flag and limits match the previous attempt sends
+     * the same bytes again instead of re-encoding them; a provider that hands out new credentials, or a client ID the
+     * broker assigned, re-encodes once. The cached bytes hold the password, so they are overwritten before being
+     * replaced or destroyed. Not thread-safe; it belongs to the reactor thread.
+     */
+    class ConnectPacketCache final
+    {
+    public:
+        /// @brief What goes into a CONNECT; the cache is keyed on all of it.
+        struct Fields
+        {
+            packets::ProtocolVersion protocolVersion = packets::ProtocolVersion::V311;
+            std::string clientId;
+            std::uint16_t keepAliveSeconds = 0;
+            Credentials credentials;
+            bool cleanSession = true;
+            std::string authMethod;
+            std::vector<std::uint8_t> initialAuthData;
+            std::uint16_t topicAliasMaximum = 0;
+            std::uint16_t receiveMaximum = 0;
+
+            bool operator==(const Fields& other) const
+            {
+                return protocolVersion == other.protocolVersion && clientId == other.clientId && keepAliveSeconds == other.keepAliveSeconds
+                    && credentials.username == other.credentials.username && credentials.password == other.credentials.password
+                    && cleanSession == other.cleanSession && authMethod == other.authMethod && initialAuthData == other.initialAuthData
+                    && topicAliasMaximum == other.topicAliasMaximum && receiveMaximum == other.receiveMaximum;
+            }
+        };
+
+        ConnectPacketCache() = default;
+        ConnectPacketCache(const ConnectPacketCache&) = delete;
+        ConnectPacketCache& operator=(const ConnectPacketCache&) = delete;
+
+        ~ConnectPacketCache()
+        {
+            wipe();
+        }
+
+        /**
+         * @brief The encoded CONNECT for these fields, encoding it only if they differ from the cached packet's.
+         * @param fields What goes into the packet; taken only when it is encoded.
+         * @return Bytes valid until the next call.
+         */
+        [[nodiscard]] std::span<const std::byte> get(Fields&& fields)
+        {
+            if (!m_bytes.empty() && fields == m_fields)
+            {
+                return m_bytes;
+            }
+
+            wipe();
+            m_fields = std::move(fields);
+            serialize::ByteWriter writer(m_bytes);
+            withMqttVersion(
+                m_fields.protocolVersion,
+                [this, &writer]<typename VersionTag>(VersionTag)
+                {
+                    packets::encodeConnectToWriter<VersionTag::value>(
+                        writer,
+                        m_fields.clientId,
+                        m_fields.keepAliveSeconds,
+                        m_fields.credentials.username,
+                        m_fields.credentials.password,
+                        m_fields.cleanSession,
+                        m_fields.authMethod,
+                        m_fields.initialAuthData,
+                        m_fields.topicAliasMaximum,
+                        m_fields.receiveMaximum);
+                });
+            ++m_encodeCount;
+            return m_bytes;
+        }
+
+        /// @brief Number of times a CONNECT was encoded rather than reused.
+        [[nodiscard]] size_t getEncodeCount() const
+        {
+            return m_encodeCount;
+        }
+
+    private:
+        void wipe()
+        {
+            std::fill(m_bytes.begin(), m_bytes.end(), std::byte{ 0 });
+            std::fill(m_fields.credentials.password.begin(), m_fields.credentials.password.end(), '\0');
+            m_bytes.clear();
+        }
+
+        Fields m_fields;
+        std::vector<std::byte> m_bytes;
+        size_t m_encodeCount = 0;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,139 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/consumer_group.h"
+
+#include "mqtt/client/fan_in.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    ConsumerGroup::ConsumerGroup(
+        const ConnectionSettingsPtr& settings,
+        const std::string_view shareName,
+        const TopicFilter& topicFilter,
+        const size_t consumerCount,
+        const size_t dispatchLanes,
+        const std::shared_ptr<IReactorGroup>& group)
+        : m_consumers(settings, consumerCount, group)
+        , m_sharedFilter(
+              "$share/" + std::string(shareName) + "/" + topicFilter.getFilter(),
+              topicFilter.getQualityOfService(),
+              // The spec makes No Local a protocol error on a shared subscription.
+              false,
+              topicFilter.getIsRetainAsPublished(),
+              topicFilter.getRetainHandlingOptions())
+        , m_stage(std::make_shared<DispatchStage>(std::max<size_t>(dispatchLanes, 1)))
+        , m_isSubscribed(m_consumers.getShardCount(), false)
+    {
+    }
+
+    ConnectFuture ConsumerGroup::connectAsync(const bool cleanSession)
+    {
+        return makeFuture([this, cleanSession](CompletionHandler<void> onComplete) { connectAsync(cleanSession, std::move(onComplete)); });
+    }
+
+    void ConsumerGroup::connectAsync(const bool cleanSession, CompletionHandler<void> onComplete)
+    {
+        m_consumers.connectAsync(
+            cleanSession,
+            [weak = weak_from_this(), onComplete = std::move(onComplete)](const Result<void>& result)
+            {
+                const auto self = weak.lock();
+                if (!self || !result.hasSucceeded())
+                {
+                    if (onComplete)
+                    {
+                        onComplete(self ? result : Result<void>::failure(ResultError::Cancelled, "consumer group destroyed"));
+                    }
+                    return;
+                }
+
+                self->subscribePending(onComplete);
+            });
+    }
+
+    DisconnectFuture ConsumerGroup::disconnectAsync()
+    {
+        return m_consumers.disconnectAsync();
+    }
+
+    void ConsumerGroup::disconnectAsync(CompletionHandler<void> onComplete)
+    {
+        m_consumers.disconnectAsync(std::move(onComplete));
+    }
+
+    DisconnectFuture ConsumerGroup::disconnectAsync(const DrainOptions& drain)
+    {
+        return m_consumers.disconnectAsync(drain);
+    }
+
+    void ConsumerGroup::disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete)
+    {
+        m_consumers.disconnectAsync(drain, std::move(onComplete));
+    }
+
+    void ConsumerGroup::subscribePending(CompletionHandler<void> onComplete)
+    {
+        std::vector<size_t> pending;
+        {
+            std::scoped_lock lock(m_subscribedMutex);
+            for (size_t index = 0; index < m_isSubscribed.size(); ++index)
+            {
+                if (!m_isSubscribed[index])
+                {
+                    m_isSubscribed[index] = true;
+                    pending.push_back(index);
+                }
+            }
+        }
+
+        if (pending.empty())
+        {
+            if (onComplete)
+            {
+                onComplete(Result<void>::success());
+            }
+            return;
+        }
+
+        // Holding the stage, not the group, keeps a subscription alive in the connections that own it.
+        const MessageHandler handler = [stage = m_stage](const Message& message)
+        {
+            stage->dispatcher.dispatch(
+                std::hash<std::string_view>{}(message.getTopic()), [raw = stage.get(), message] { raw->onMessage.broadcast(message); });
+        };
+
+        const auto fanIn = std::make_shared<FanIn>(pending.size(), std::move(onComplete));
+        for (const size_t index : pending)
+        {
+            m_consumers.getShard(index)->subscribeAsync(
+                TopicFilter(m_sharedFilter),
+                handler,
+                [weak = weak_from_this(), index, fanIn](const Result<SubscribeResult>& result)
+                {
+                    const bool wasSuccessful = result.hasSucceeded() && result.getResult() && result.getResult()->wasSuccessful();
+                    if (const auto self = weak.lock(); self && !wasSuccessful)
+                    {
+                        REACTORMQ_LOG(
+                            logging::LogLevel::Warn,
+                            "ConsumerGroup::subscribePending() consumer %zu failed to subscribe to %s",
+                            index,
+                            self->m_sharedFilter.getFilter().c_str());
+
+                        // The next connectAsync() tries again.
+                        std::scoped_lock lock(self->m_subscribedMutex);
+                        self->m_isSubscribed[index] = false;
+                    }
+                    fanIn->complete(
+                        wasSuccessful ? Result<void>::success()
+                                      : Result<void>::failure(ResultError::PartialFailure, "a consumer failed to subscribe"));
+                });
+        }
+    }
+} // namespace reactormq::mqtt::client
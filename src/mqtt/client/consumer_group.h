@@ -0,0 +1,122 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/message_dispatcher.h"
+#include "mqtt/client/sharded_client.h"
+#include "reactormq/mqtt/connection_settings.h"
+#include "reactormq/mqtt/consumer_group.h"
+#include "reactormq/mqtt/reactor_group.h"
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief IConsumerGroup implementation: a ShardedClient whose connections all subscribe to one shared filter and
+     * hand their messages to a MessageDispatcher.
+     */
+    class ConsumerGroup final
+        : public IConsumerGroup
+        , public std::enable_shared_from_this<ConsumerGroup>
+    {
+    public:
+        /**
+         * @brief Create the connections; none of them connects until connectAsync().
+         * @param settings Connection settings shared by every connection; see ShardedClient for the client IDs.
+         * @param shareName Share name of the shared subscription, the {group} in $share/{group}/{filter}.
+         * @param topicFilter Filter to share, with the subscribe options every connection uses.
+         * @param consumerCount Number of connections; 0 is treated as 1.
+         * @param dispatchLanes Number of dispatch lanes; 0 is treated as 1.
+         * @param group Group whose threads drive the connections; null if the owner calls tick().
+         */
+        ConsumerGroup(
+            const ConnectionSettingsPtr& settings,
+            std::string_view shareName,
+            const TopicFilter& topicFilter,
+            size_t consumerCount,
+            size_t dispatchLanes,
+            const std::shared_ptr<IReactorGroup>& group);
+
+        ConnectFuture connectAsync(bool cleanSession) override;
+        void connectAsync(bool cleanSession, CompletionHandler<void> onComplete) override;
+        DisconnectFuture disconnectAsync() override;
+        void disconnectAsync(CompletionHandler<void> onComplete) override;
+        DisconnectFuture disconnectAsync(const DrainOptions& drain) override;
+        void disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete) override;
+
+        [[nodiscard]] size_t getConsumerCount() const override
+        {
+            return m_consumers.getShardCount();
+        }
+
+        [[nodiscard]] const std::shared_ptr<IClient>& getConsumer(const size_t index) const override
+        {
+            return m_consumers.getShard(index);
+        }
+
+        [[nodiscard]] const std::string& getSharedFilter() const override
+        {
+            return m_sharedFilter.getFilter();
+        }
+
+        OnMessage& onMessage() override
+        {
+            return m_stage->onMessage;
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return m_consumers.isConnected();
+        }
+
+        void tick() override
+        {
+            m_consumers.tick();
+        }
+
+        [[nodiscard]] ClientMetrics getMetrics() const override
+        {
+            return m_consumers.getMetrics();
+        }
+
+        [[nodiscard]] InboundTraffic getInboundTraffic() const override
+        {
+            return m_consumers.getInboundTraffic();
+        }
+
+    private:
+        /// @brief Shared with the connections' subscription handlers, which may outlive the group.
+        struct DispatchStage
+        {
+            explicit DispatchStage(const size_t laneCount)
+                : dispatcher(laneCount)
+            {
+            }
+
+            OnMessage onMessage;
+            MessageDispatcher dispatcher; ///< Declared last, so its lanes drain before onMessage goes away.
+        };
+
+        /**
+         * @brief Subscribe every connection that has not subscribed yet to the shared filter.
+         * @param onComplete Called once every subscribe has completed, failing if any did.
+         */
+        void subscribePending(CompletionHandler<void> onComplete);
+
+        ShardedClient m_consumers;
+        TopicFilter m_sharedFilter;
+        std::shared_ptr<DispatchStage> m_stage;
+
+        std::mutex m_subscribedMutex;
+        std::vector<bool> m_isSubscribed; ///< Per connection: subscribed, or a subscribe is in flight.
+    };
+} // namespace reactormq::mqtt::client
@@ -9,167 +9,759 @@
 #include "mqtt/packets/auth.h"
 #include "mqtt/packets/fixed_header.h"
 #include "mqtt/packets/interface/control_packet.h"
+#include "mqtt/packets/pre_encoded_packets.h"
+#include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_view.h"
 #include "mqtt_version_mapping.h"
 #include "serialize/bytes.h"
 #include "util/logging/logging.h"
+#include "util/trace/memory_tags.h"
 
+#include <algorithm>
+#include <array>
+#include <format>
+#include <functional>
+#include <random>
 #include <span>
+#include <string_view>
+#include <utility>
 
 namespace reactormq::mqtt::client
 {
+    namespace
+    {
+        /// @brief DUP flag of a PUBLISH fixed header (bit 3 of the first byte).
+        constexpr std::byte kPublishDupFlag{ 0x08 };
+
+        /// @brief Size at which a batch of PUBLISHes is written without waiting for the end of the tick.
+        constexpr size_t kMaxOutboundBatchBytes = 64 * 1024;
+
+        /// @brief Encoded size of a PUBACK, PUBREC, PUBREL or PUBCOMP with no properties.
+        constexpr size_t kIdOnlyAckBytes = 4;
+
+        /// @brief Highest packet identifier.
+        constexpr std::uint16_t kMaxPacketId = 65535;
+    } // namespace
+
     Context::Context(ConnectionSettingsPtr settings)
         : m_settings(std::move(settings))
+        , m_packetArena(m_settings ? m_settings->getPacketArenaSize() : 0, getMemoryResource())
+        , m_topicInterns(m_settings ? m_settings->getMaxInternedTopics() : 0)
+        , m_offlinePublishes(
+              m_settings ? m_settings->getMaxOfflinePublishes() : 0,
+              m_settings ? m_settings->getMaxOfflineQueueBytes() : 0,
+              m_settings ? m_settings->getOfflineQueuePolicy() : OfflineQueuePolicy::DropOldest)
+        , m_endpoints(m_settings)
+        , m_reconnectBackoff(
+              m_settings ? m_settings->getAutoReconnectInitialDelayMs() : 0,
+              m_settings ? m_settings->getAutoReconnectMaxDelayMs() : 0,
+              m_settings ? m_settings->getAutoReconnectMultiplier() : 1.0,
+              m_settings ? m_settings->getReconnectJitter() : ReconnectJitter::Proportional)
     {
+        if (m_settings)
+        {
+            m_sessionStore = m_settings->getSessionStore();
+            m_payloadCodecs = PayloadCodecs(m_settings->getPayloadCodecs());
+            if (const std::uint32_t lanes = m_settings->getMessageDispatchLanes(); lanes > 0)
+            {
+                m_messageDispatcher = std::make_unique<MessageDispatcher>(lanes);
+            }
+            if (m_settings->shouldProfileTicks())
+            {
+                m_tickProfiler = std::make_unique<TickProfiler>();
+            }
+            if (m_settings->getTrafficAccounting().isEnabled)
+            {
+                m_trafficAccounting = std::make_unique<TrafficAccounting>(m_settings->getTrafficAccounting());
+            }
+            if (const std::uint32_t lastValues = m_settings->getLastValueCacheSize(); lastValues > 0)
+            {
+                m_lastValues = std::make_unique<LastValueCache>(lastValues);
+            }
+            if (m_settings->getPublishDedup().isEnabled)
+            {
+                m_publishDeduplicator = std::make_unique<PublishDeduplicator>(m_settings->getPublishDedup());
+            }
+            if (!m_settings->getPublishRateLimits().empty())
+            {
+                m_publishRateLimiter
+                    = std::make_unique<PublishRateLimiter>(m_settings->getPublishRateLimits(), m_settings->getMaxPendingCommands());
+            }
+            if (m_settings->getFixedCapacity().isEnabled)
+            {
+                reserveFixedCapacity();
+            }
+        }
+
+        restoreSession();
     }
 
-    std::uint16_t Context::allocatePacketId()
+    void Context::reserveFixedCapacity()
     {
-        std::scoped_lock lock(packetIdMutex);
-        constexpr std::uint16_t kMaxPacketId = 65535;
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ);
+        // Every publish or subscription waiting on an ID came through the command queue, so the queue bound caps them.
+        const auto maxPacketId = static_cast<std::uint16_t>(
+            std::clamp<std::uint32_t>(m_settings->getMaxPendingCommands(), 1, kMaxPacketId));
+        m_packetIds.setMaxId(maxPacketId);
+        m_inFlight.reserve(maxPacketId, maxPacketId);
+
+        // The broker picks inbound IDs from the whole range; receive maximum bounds how many are live at once.
+        const std::uint16_t receiveMaximum = m_settings->getReceiveMaximum();
+        m_incomingPackets.reserve(receiveMaximum, kMaxPacketId);
+        m_deliveredQos2PacketIds.reserve();
+        m_subscriptionCache.reserve(m_settings->getFixedCapacity().maxSubscriptions);
+
+        m_packetArena.reserve();
+        m_outboundBatch.reserve(kMaxOutboundBatchBytes);
+        m_outboundSendBuffers.reserve(socket::kMaxSendBuffers);
+        m_ackBatch.reserve(static_cast<size_t>(receiveMaximum) * kIdOnlyAckBytes);
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Info,
+            "Fixed capacity: %u packet IDs, %u inbound, %u subscriptions reserved",
+            static_cast<unsigned>(maxPacketId),
+            static_cast<unsigned>(receiveMaximum),
+            static_cast<unsigned>(m_settings->getFixedCapacity().maxSubscriptions));
+    }
 
-        if (m_packetIdsInUse.size() >= kMaxPacketId)
+    void Context::restoreSession()
+    {
+        if (!m_sessionStore)
         {
-            return 0;
+            return;
         }
 
-        std::uint16_t attempts = 0;
-        while (attempts < kMaxPacketId)
+        // Restored publishes have no caller waiting on them; they are retransmitted with DUP set once ready.
+        for (StoredPublish& stored : m_sessionStore->loadOutboundPublishes())
         {
-            constexpr std::uint16_t kMinPacketId = 1;
-            if (!m_packetIdsInUse.contains(m_nextPacketId))
+            std::uint16_t packetId = stored.packetId;
+            if (packetId > m_packetIds.getMaxId())
             {
-                const std::uint16_t allocatedId = m_nextPacketId;
-                m_packetIdsInUse.insert(allocatedId);
-
-                ++m_nextPacketId;
-                if (m_nextPacketId == 0)
-                {
-                    m_nextPacketId = kMinPacketId;
-                }
-
-                return allocatedId;
+                // Saved before the ID range was narrowed; resent under a new ID, so the broker may deliver it twice.
+                packetId = m_packetIds.allocate();
+                REACTORMQ_LOG(
+                    logging::LogLevel::Warn,
+                    "Restored publish %u is outside the fixed-capacity ID range; resending it as %u",
+                    static_cast<unsigned>(stored.packetId),
+                    static_cast<unsigned>(packetId));
+            }
+            else if (!m_packetIds.reserve(packetId))
+            {
+                continue;
             }
 
-            ++m_nextPacketId;
-            if (m_nextPacketId == 0)
+            if (packetId != 0)
             {
-                m_nextPacketId = kMinPacketId;
+                m_inFlight.tryEmplace(packetId, InFlightPacket{ PublishCommand{ std::move(stored.message), {} }, {}, 0 });
+                ++m_pendingPublishCount;
             }
+        }
 
-            ++attempts;
+        for (StoredPublish& stored : m_sessionStore->loadInboundQos2())
+        {
+            m_incomingPackets.tryEmplace(stored.packetId, std::move(stored.message));
         }
+    }
 
-        return 0;
+    void Context::commitSessionStore()
+    {
+        if (m_sessionStore)
+        {
+            m_sessionStore->commit();
+        }
+    }
+
+    void Context::flushCallbacks()
+    {
+        if (m_batchedCallbacks.empty())
+        {
+            return;
+        }
+
+        const TickPhaseScope phaseScope(m_tickProfiler.get(), TickPhase::Dispatch);
+        m_settings->getCallbackExecutor()(
+            [batch = std::exchange(m_batchedCallbacks, {})]
+            {
+                REACTORMQ_TRACE_SCOPE("Context::flushCallbacks");
+                for (const auto& callback : batch)
+                {
+                    callback();
+                }
+            });
+    }
+
+    std::uint16_t Context::allocatePacketId()
+    {
+        return m_packetIds.allocate();
     }
 
     void Context::releasePacketId(const std::uint16_t packetId)
     {
-        std::scoped_lock lock(packetIdMutex);
-        m_packetIdsInUse.erase(packetId);
+        m_packetIds.release(packetId);
     }
 
     bool Context::isPacketIdInUse(const std::uint16_t packetId) const
     {
-        std::scoped_lock lock(packetIdMutex);
-        return m_packetIdsInUse.contains(packetId);
+        return m_packetIds.isInUse(packetId);
     }
 
-    void Context::storePendingPublish(const std::uint16_t packetId, PublishCommand command)
+    template<typename TCommand>
+    std::optional<TCommand> Context::takeInFlight(const std::uint16_t packetId)
     {
-        m_pendingPublishes.try_emplace(packetId, std::move(command));
+        InFlightPacket* inFlight = m_inFlight.find(packetId);
+        if (nullptr == inFlight || !std::holds_alternative<TCommand>(inFlight->command))
+        {
+            return std::nullopt;
+        }
+
+        TCommand command = std::move(std::get<TCommand>(inFlight->command));
+        m_inFlight.erase(packetId);
+        return command;
     }
 
-    std::optional<PublishCommand> Context::takePendingPublish(const std::uint16_t packetId)
+    void Context::storePendingPublish(
+        const std::uint16_t packetId,
+        PublishCommand command,
+        std::vector<std::byte> sentHeader,
+        SharedPayload encodedPayload,
+        const IPayloadCodec* payloadCodec)
     {
-        const auto it = m_pendingPublishes.find(packetId);
-        if (it == m_pendingPublishes.end())
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_InFlight);
+        if (!sentHeader.empty())
         {
-            return std::nullopt;
+            sentHeader.front() |= kPublishDupFlag;
+        }
+
+        // A streamed payload is only held by its source, so the store could not bring it back after a restart.
+        const bool canPersist = !command.stream;
+        InFlightPacket packet{ std::move(command), std::move(sentHeader), 0, std::move(encodedPayload), payloadCodec };
+        if (InFlightPacket* inFlight = m_inFlight.tryEmplace(packetId, std::move(packet)))
+        {
+            ++m_pendingPublishCount;
+            if (m_sessionStore && canPersist)
+            {
+                m_sessionStore->addOutboundPublish(packetId, std::get<PublishCommand>(inFlight->command).message);
+            }
         }
+    }
 
-        PublishCommand command = std::move(it->second);
-        m_pendingPublishes.erase(it);
+    std::optional<PublishCommand> Context::takePendingPublish(const std::uint16_t packetId)
+    {
+        auto command = takeInFlight<PublishCommand>(packetId);
+        if (command.has_value())
+        {
+            --m_pendingPublishCount;
+            if (m_sessionStore)
+            {
+                m_sessionStore->removeOutboundPublish(packetId);
+            }
+        }
         return command;
     }
 
-    void Context::storePendingSubscribe(const std::uint16_t packetId, SubscribeCommand command)
+    const PublishCommand* Context::findPendingPublish(const std::uint16_t packetId) const
     {
-        m_pendingSubscribes.try_emplace(packetId, std::move(command));
+        const InFlightPacket* inFlight = m_inFlight.find(packetId);
+        return nullptr != inFlight ? std::get_if<PublishCommand>(&inFlight->command) : nullptr;
     }
 
-    std::optional<SubscribeCommand> Context::takePendingSubscribe(const std::uint16_t packetId)
+    void Context::markPublishReleased(const std::uint16_t packetId)
     {
-        const auto it = m_pendingSubscribes.find(packetId);
-        if (it == m_pendingSubscribes.end())
+        InFlightPacket* inFlight = m_inFlight.find(packetId);
+        if (nullptr != inFlight && std::holds_alternative<PublishCommand>(inFlight->command))
+        {
+            inFlight->isReleased = true;
+        }
+    }
+
+    void Context::holdPublish(PublishCommand command)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_InFlight);
+        m_heldPublishes.push_back(std::move(command));
+    }
+
+    std::optional<PublishCommand> Context::takeHeldPublish()
+    {
+        if (m_heldPublishes.empty())
         {
             return std::nullopt;
         }
 
-        SubscribeCommand command = std::move(it->second);
-        m_pendingSubscribes.erase(it);
+        PublishCommand command = std::move(m_heldPublishes.front());
+        m_heldPublishes.pop_front();
         return command;
     }
 
+    void Context::storePendingSubscribe(const std::uint16_t packetId, SubscribeCommand command)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_InFlight);
+        m_inFlight.tryEmplace(packetId, InFlightPacket{ std::move(command), {}, 0 });
+    }
+
+    std::optional<SubscribeCommand> Context::takePendingSubscribe(const std::uint16_t packetId)
+    {
+        return takeInFlight<SubscribeCommand>(packetId);
+    }
+
     void Context::storePendingSubscribes(const std::uint16_t packetId, SubscribesCommand command)
     {
-        m_pendingSubscribesMulti.try_emplace(packetId, std::move(command));
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_InFlight);
+        m_inFlight.tryEmplace(packetId, InFlightPacket{ std::move(command), {}, 0 });
     }
 
     std::optional<SubscribesCommand> Context::takePendingSubscribes(const std::uint16_t packetId)
     {
-        const auto it = m_pendingSubscribesMulti.find(packetId);
-        if (it == m_pendingSubscribesMulti.end())
+        return takeInFlight<SubscribesCommand>(packetId);
+    }
+
+    void Context::storePendingUnsubscribes(const std::uint16_t packetId, UnsubscribesCommand command)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_InFlight);
+        m_inFlight.tryEmplace(packetId, InFlightPacket{ std::move(command), {}, 0 });
+    }
+
+    std::optional<UnsubscribesCommand> Context::takePendingUnsubscribes(const std::uint16_t packetId)
+    {
+        return takeInFlight<UnsubscribesCommand>(packetId);
+    }
+
+    bool Context::deliverMessage(
+        Message message,
+        const std::span<const std::uint32_t> subscriptionIdentifiers,
+        const std::uint16_t ackPacketId,
+        const packets::PacketType ackType)
+    {
+        REACTORMQ_TRACE_SCOPE("Context::deliverMessage");
+
+        // A chunk of a transfer a sink is reassembling goes to that sink only, and is acknowledged at once.
+        if (!m_chunkAssemblers.isEmpty() && m_chunkAssemblers.deliver(MessageView(message)))
         {
-            return std::nullopt;
+            return false;
         }
 
-        SubscribesCommand command = std::move(it->second);
-        m_pendingSubscribesMulti.erase(it);
-        return command;
+        // Waiting messages keep their place even once no filter has a priority any more.
+        if (m_inboundScheduler.isEnabled() || m_inboundScheduler.getWaitingCount() > 0)
+        {
+            const std::uint8_t priority = m_inboundScheduler.getPriority(message.getTopic());
+            if (!m_inboundScheduler.tryAdmit(priority))
+            {
+                m_inboundScheduler.defer(
+                    priority,
+                    InboundScheduler::Deferred{ std::move(message),
+                                                { subscriptionIdentifiers.begin(), subscriptionIdentifiers.end() },
+                                                ackPacketId,
+                                                ackType,
+                                                m_deliveryConnection });
+                if (m_socket && m_inboundScheduler.isFull())
+                {
+                    m_socket->setReceivePaused(true);
+                }
+                return ackPacketId != 0;
+            }
+        }
+        return deliverNow(std::move(message), subscriptionIdentifiers, ackPacketId, ackType);
     }
 
-    void Context::storePendingUnsubscribes(const std::uint16_t packetId, UnsubscribesCommand command)
+    bool Context::deliverNow(
+        Message message,
+        const std::span<const std::uint32_t> subscriptionIdentifiers,
+        const std::uint16_t ackPacketId,
+        const packets::PacketType ackType)
+    {
+        if (m_lastValues)
+        {
+            m_lastValues->store(message);
+        }
+
+        auto routed = subscriptionIdentifiers.empty() ? matchTopic(message.getTopic(), message.getSharedTopic())
+                                                      : m_topicRouter.matchIdentifiers(subscriptionIdentifiers);
+        if (m_trafficAccounting)
+        {
+            m_trafficAccounting->recordMessage(
+                message.getTopic(), message.getTopic().size() + message.getPayloadView().size(), routed.get());
+        }
+
+        // Hashing the topic keeps each topic on one lane, so its messages are handled in arrival order.
+        const size_t laneKey = m_messageDispatcher ? std::hash<std::string_view>{}(message.getTopic()) : 0;
+        if (routed && !m_conflatedHandlers.isEmpty())
+        {
+            routed = conflate(message, std::move(routed), laneKey);
+        }
+        if (m_onMessage.getSize() == 0 && !routed)
+        {
+            return false;
+        }
+
+        const bool isBounded = isDeliveryBounded();
+        const bool isManual = ackPacketId != 0 && m_settings && m_settings->shouldAcknowledgeManually();
+        const size_t bytes = isBounded ? message.getTopic().size() + message.getPayloadView().size() : 0;
+        const DeliveredAck ack{ ackPacketId, ackType, m_deliveryConnection };
+
+        // A manual acknowledgement is the application's to send; the handlers finishing only frees room.
+        auto deliver = [this,
+                        msg = isManual ? Message(std::move(message), makeAckToken(ack)) : std::move(message),
+                        routed = std::move(routed),
+                        isBounded,
+                        bytes,
+                        handledAck = isManual ? DeliveredAck{} : ack]() mutable
+        {
+            m_onMessage.broadcast(msg);
+            if (routed)
+            {
+                for (const auto& handler : *routed)
+                {
+                    (*handler)(msg);
+                }
+            }
+
+            if (isBounded)
+            {
+                finishDelivery(handledAck, bytes);
+            }
+        };
+
+        if (isBounded)
+        {
+            m_pendingDeliveries.fetch_add(1, std::memory_order_acq_rel);
+            m_pendingDeliveryBytes.fetch_add(bytes, std::memory_order_acq_rel);
+            if (m_socket && isDeliveryQueueFull())
+            {
+                m_socket->setReceivePaused(true);
+            }
+        }
+
+        if (m_messageDispatcher)
+        {
+            m_messageDispatcher->dispatch(laneKey, std::move(deliver));
+        }
+        else
+        {
+            invokeCallback(std::move(deliver));
+        }
+
+        return ackPacketId != 0 && (isBounded || isManual);
+    }
+
+    std::shared_ptr<const TopicRouter::HandlerList> Context::conflate(
+        const Message& message, std::shared_ptr<const TopicRouter::HandlerList> routed, const size_t laneKey)
+    {
+        TopicRouter::HandlerList remaining;
+        std::shared_ptr<const Message> latest;
+        for (const auto& handler : *routed)
+        {
+            auto pending = m_conflatedHandlers.findPending(handler.get(), message.getTopic());
+            if (!pending)
+            {
+                remaining.push_back(handler);
+                continue;
+            }
+
+            if (!latest)
+            {
+                latest = std::make_shared<const Message>(message);
+            }
+
+            // A call already queued for this handler and topic will deliver the newer message instead.
+            if (pending->exchange(latest))
+            {
+                if (m_trafficAccounting)
+                {
+                    m_trafficAccounting->recordDropped(handler.get());
+                }
+                continue;
+            }
+
+            auto deliver = [handler, pending = std::move(pending)]
+            {
+                if (const auto msg = pending->exchange(nullptr))
+                {
+                    (*handler)(*msg);
+                }
+            };
+            if (m_messageDispatcher)
+            {
+                m_messageDispatcher->dispatch(laneKey, std::move(deliver));
+            }
+            else
+            {
+                invokeCallback(std::move(deliver));
+            }
+        }
+
+        if (!latest)
+        {
+            return routed;
+        }
+        return remaining.empty() ? nullptr : std::make_shared<const TopicRouter::HandlerList>(std::move(remaining));
+    }
+
+    const std::string& Context::getResponseTopic()
     {
-        m_pendingUnsubscribes.try_emplace(packetId, std::move(command));
+        if (m_responseTopic.empty())
+        {
+            std::random_device random;
+            const std::uint64_t token = static_cast<std::uint64_t>(random()) << 32 | random();
+            m_responseTopic = std::format("reactormq/responses/{:016x}", token);
+        }
+        return m_responseTopic;
     }
 
-    std::optional<UnsubscribesCommand> Context::takePendingUnsubscribes(const std::uint16_t packetId)
+    void Context::completeRequest(const MessageView& view, const std::span<const std::uint8_t> correlationData)
     {
-        const auto it = m_pendingUnsubscribes.find(packetId);
-        if (it == m_pendingUnsubscribes.end())
+        const std::uint32_t correlationId = RequestTable::fromCorrelationData(correlationData);
+        if (auto completion = m_requests.take(correlationId))
         {
-            return std::nullopt;
+            m_timers.cancel(TimerKey{ TimerKind::RequestTimeout, correlationId });
+            completion->set_value(Result<Message>::success(Message{ view.toMessage(), getTickTimeUtc() }));
         }
+    }
 
-        UnsubscribesCommand command = std::move(it->second);
-        m_pendingUnsubscribes.erase(it);
-        return command;
+    void Context::expireRequest(const std::uint32_t correlationId)
+    {
+        if (auto completion = m_requests.take(correlationId))
+        {
+            completion->set_value(Result<Message>::failure(ResultError::TimedOut));
+        }
+    }
+
+    bool Context::isDeliveryBounded() const
+    {
+        if (!m_settings || (m_settings->getMaxPendingDeliveries() == 0 && m_settings->getMaxPendingDeliveryBytes() == 0))
+        {
+            return false;
+        }
+
+        // Handlers on the reactor thread hold it until they return, which pushes back on the broker already.
+        return m_messageDispatcher || m_settings->getCallbackExecutor();
+    }
+
+    bool Context::isDeliveryQueueFull() const
+    {
+        if (!m_settings)
+        {
+            return false;
+        }
+
+        const std::uint32_t maxDeliveries = m_settings->getMaxPendingDeliveries();
+        const std::uint32_t maxBytes = m_settings->getMaxPendingDeliveryBytes();
+        return (maxDeliveries != 0 && m_pendingDeliveries.load(std::memory_order_acquire) >= maxDeliveries)
+            || (maxBytes != 0 && m_pendingDeliveryBytes.load(std::memory_order_acquire) >= maxBytes) || m_inboundScheduler.isFull();
+    }
+
+    void Context::finishDelivery(const DeliveredAck& ack, const size_t bytes)
+    {
+        const bool wasFull = isDeliveryQueueFull();
+        m_pendingDeliveryBytes.fetch_sub(bytes, std::memory_order_acq_rel);
+        m_pendingDeliveries.fetch_sub(1, std::memory_order_acq_rel);
+
+        if (ack.packetId != 0)
+        {
+            m_deliveredAcks->push(ack);
+        }
+        // Without an acknowledgement to send, only the delivery that frees room in a full queue needs the reactor.
+        else if (wasFull && m_deliveredAcks->wakeup)
+        {
+            m_deliveredAcks->wakeup->signal();
+        }
+    }
+
+    AckToken Context::makeAckToken(const DeliveredAck& ack) const
+    {
+        return AckToken(
+            [acks = std::weak_ptr(m_deliveredAcks), ack]
+            {
+                if (const auto delivered = acks.lock())
+                {
+                    delivered->push(ack);
+                }
+            });
+    }
+
+    void Context::completeDeliveries()
+    {
+        while (const auto ack = m_deliveredAcks->queue.tryPop())
+        {
+            if (ack->connection != m_deliveryConnection)
+            {
+                continue;
+            }
+
+            if (ack->type == packets::PacketType::PubComp)
+            {
+                m_ackBatch.appendIdOnlyAck<packets::PacketType::PubComp>(ack->packetId);
+            }
+            else
+            {
+                m_ackBatch.appendIdOnlyAck<packets::PacketType::PubAck>(ack->packetId);
+            }
+            releaseIncomingPacketId(ack->packetId);
+        }
+
+        // Every acknowledgement of the tick goes to the control lane in one send.
+        if (m_socket && !m_ackBatch.isEmpty())
+        {
+            m_socket->sendControl(m_ackBatch.getContiguousBytes(), m_ackBatch.getPacketCount());
+        }
+        m_ackBatch.clear();
+
+        if (m_socket && (isDeliveryBounded() || m_socket->isReceivePaused()))
+        {
+            m_socket->setReceivePaused(isDeliveryQueueFull());
+        }
+    }
+
+    void Context::deliverWaitingMessages()
+    {
+        const size_t waiting = m_inboundScheduler.getWaitingCount();
+        while (auto deferred = m_inboundScheduler.takeNext())
+        {
+            // An acknowledgement owed on a connection that has since closed is not sent; the broker sends the message again.
+            const std::uint16_t ackPacketId = deferred->connection == m_deliveryConnection ? deferred->ackPacketId : 0;
+            if (!deliverNow(std::move(deferred->message), deferred->subscriptionIdentifiers, ackPacketId, deferred->ackType)
+                && ackPacketId != 0)
+            {
+                m_deliveredAcks->queue.push(DeliveredAck{ ackPacketId, deferred->ackType, deferred->connection });
+            }
+        }
+        m_inboundScheduler.beginTick();
+
+        if (waiting != 0)
+        {
+            completeDeliveries();
+        }
+    }
+
+    void Context::setDeliveryPriority(const std::string_view filter, const std::uint8_t priority)
+    {
+        m_inboundScheduler.setBudget(m_settings ? m_settings->getMaxInboundPacketsPerTick() : 0);
+        m_inboundScheduler.setPriority(filter, priority);
+        if (m_socket)
+        {
+            m_socket->setInboundPacketLimited(!m_inboundScheduler.isEnabled());
+        }
+    }
+
+    bool Context::hasCompletedDeliveries() const
+    {
+        return m_deliveredAcks->queue.getDepth() > 0 || (m_socket && m_socket->isReceivePaused() && !isDeliveryQueueFull())
+            || m_inboundScheduler.getWaitingCount() > 0;
+    }
+
+    void Context::abandonDeferredAcks()
+    {
+        // A QoS 2 entry holds its message until PUBREL, so an entry without one waits on a deferred PUBACK or PUBCOMP.
+        std::vector<std::uint16_t> packetIds;
+        for (const auto& [packetId, message] : m_incomingPackets)
+        {
+            if (!message.has_value())
+            {
+                packetIds.push_back(packetId);
+            }
+        }
+
+        for (const std::uint16_t packetId : packetIds)
+        {
+            releaseIncomingPacketId(packetId);
+        }
+        ++m_deliveryConnection;
+    }
+
+    void Context::abandonInboundStream()
+    {
+        if (m_inboundStream.sink)
+        {
+            m_inboundStream.sink->onEnd(false);
+        }
+        m_inboundStream = InboundStream{};
+    }
+
+    bool Context::hasMessageHandlers(
+        const std::string_view topic,
+        const std::span<const std::uint32_t> subscriptionIdentifiers,
+        const SharedTopic& interned)
+    {
+        if (m_onMessage.getSize() != 0)
+        {
+            return true;
+        }
+        return (subscriptionIdentifiers.empty() ? matchTopic(topic, interned) : m_topicRouter.matchIdentifiers(subscriptionIdentifiers))
+            != nullptr;
+    }
+
+    std::shared_ptr<const TopicRouter::HandlerList> Context::matchTopic(const std::string_view topic, const SharedTopic& interned)
+    {
+        return interned.isEmpty() ? m_topicRouter.match(topic) : m_topicRouter.match(interned);
+    }
+
+    void Context::failPendingSubscribes(const ResultError error)
+    {
+        std::vector<std::uint16_t> packetIds;
+        for (const auto& [packetId, inFlight] : m_inFlight)
+        {
+            if (std::holds_alternative<SubscribeCommand>(inFlight.command) || std::holds_alternative<SubscribesCommand>(inFlight.command))
+            {
+                packetIds.push_back(packetId);
+            }
+        }
+
+        for (const std::uint16_t packetId : packetIds)
+        {
+            if (auto subscribe = takePendingSubscribe(packetId))
+            {
+                subscribe->promise.set_value(Result<SubscribeResult>::failure(error));
+            }
+            else if (auto subscribes = takePendingSubscribes(packetId))
+            {
+                // Each packet of a split subscribe fails the batch; only the first one is reported.
+                auto& promise = subscribes->slice.batch ? subscribes->slice.batch->promise : subscribes->promise;
+                promise.set_value(Result<std::vector<SubscribeResult>>::failure(error));
+            }
+            releasePacketId(packetId);
+        }
     }
 
     void Context::storePendingIncomingQos2Message(const std::uint16_t packetId, Message message)
     {
-        m_pendingIncomingQos2Messages.try_emplace(packetId, std::move(message));
+        std::optional<Message>* slot = m_incomingPackets.find(packetId);
+        if (nullptr == slot)
+        {
+            slot = m_incomingPackets.tryEmplace(packetId);
+        }
+
+        if (nullptr != slot && !slot->has_value())
+        {
+            slot->emplace(std::move(message));
+            if (m_sessionStore)
+            {
+                m_sessionStore->addInboundQos2(packetId, slot->value());
+            }
+        }
     }
 
     std::optional<Message> Context::takePendingIncomingQos2Message(const std::uint16_t packetId)
     {
-        const auto it = m_pendingIncomingQos2Messages.find(packetId);
-        if (it == m_pendingIncomingQos2Messages.end())
+        std::optional<Message>* slot = m_incomingPackets.find(packetId);
+        if (nullptr == slot)
         {
             return std::nullopt;
         }
 
-        Message message = std::move(it->second);
-        m_pendingIncomingQos2Messages.erase(it);
+        // The packet ID stays tracked until releaseIncomingPacketId(), as before PUBCOMP is sent.
+        std::optional<Message> message = std::move(*slot);
+        slot->reset();
+        if (message.has_value() && m_sessionStore)
+        {
+            m_sessionStore->removeInboundQos2(packetId);
+        }
         return message;
     }
 
-    std::unique_ptr<packets::IControlPacket> Context::parsePacket(const std::span<const std::byte> data) const
+    bool Context::isParseableFrame(const std::span<const std::byte> data) const
     {
         if (data.size() < 2)
         {
             REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Failed to parse packet: insufficient data (size: %llu)", data.size());
-            return nullptr;
+            return false;
         }
 
         if (m_settings && m_settings->shouldEnforceMaxPacketSize())
@@ -182,103 +774,251 @@ namespace reactormq::mqtt::client
                     "Packet size (%llu bytes) exceeds maximum allowed (%u bytes)",
                     data.size(),
                     maxPacketSize);
-                return nullptr;
+                return false;
             }
         }
 
-        serialize::ByteReader reader(data);
-        packets::FixedHeader fixedHeader;
-        fixedHeader.decode(reader);
+        return true;
+    }
+
+    PacketPtr Context::parsePacket(const socket::InboundFrame& frame) const
+    {
+        REACTORMQ_TRACE_SCOPE("Context::parsePacket");
+        if (!isParseableFrame(std::as_bytes(frame.bytes)))
+        {
+            return nullptr;
+        }
+
+        // The framing already decoded the fixed header; the decoder reads the body only.
+        const packets::FixedHeader fixedHeader = packets::FixedHeader::create(frame.typeAndFlags, frame.remainingLength);
+        serialize::ByteReader reader(std::as_bytes(frame.getBody()));
 
         const packets::PacketType packetType = fixedHeader.getPacketType();
         const packets::ProtocolVersion protocolVersion = getProtocolVersion();
 
-        std::unique_ptr<packets::IControlPacket> result = withMqttVersion(
-            protocolVersion,
-            [&reader, &fixedHeader, &packetType]<typename VersionTag>(VersionTag) -> std::unique_ptr<packets::IControlPacket>
-            {
-                constexpr auto kV = VersionTag::value;
-                return parsePacketImpl<kV>(reader, fixedHeader, packetType);
-            });
-
-        if (result == nullptr)
+        const PacketDecoder decoder = getPacketDecoder(protocolVersion, packetType);
+        if (nullptr == decoder)
         {
-            // Preserve previous early-return behavior for unsupported AUTH on MQTT 3.1.1
             if (packetType == packets::PacketType::Auth && protocolVersion == packets::ProtocolVersion::V311)
             {
                 REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "AUTH packet not supported in MQTT 3.1.1");
-                return nullptr;
             }
-
-            // Preserve previous early-return behavior for unknown/invalid types (already logged in impl)
-            if (packetType == packets::PacketType::None || packetType == packets::PacketType::Max)
+            else
             {
-                return nullptr;
+                REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Unknown or invalid packet type: %d", packetType);
             }
-
-            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Failed to create packet of type: %d", packetType);
             return nullptr;
         }
 
-        if (!result->isValid())
+        // Malformed packets are logged by the decoder.
+        PacketPtr result = decoder(reader, fixedHeader, m_packetArena);
+        if (result == nullptr)
         {
-            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Malformed packet of type: %d", packetType);
             return nullptr;
         }
 
         REACTORMQ_LOG(
             reactormq::logging::LogLevel::Debug,
             "Received packet - Type: %d, PacketId: %u",
-            result->getPacketType(),
+            packetType,
             result->getPacketId());
 
         return result;
     }
 
-    std::unique_ptr<packets::IControlPacket> Context::parsePacket(const std::uint8_t* data, const std::uint32_t size) const
+    PacketPtr Context::parsePacket(const std::span<const std::byte> data) const
+    {
+        const std::span u8{ reinterpret_cast<const std::uint8_t*>(data.data()), data.size() };
+        return parsePacket(socket::InboundFrame::fromBytes(u8));
+    }
+
+    PacketPtr Context::parsePacket(const std::uint8_t* data, const std::uint32_t size) const
     {
         if (nullptr == data || 0 == size)
         {
             return nullptr;
         }
 
-        const std::span u8{ data, size };
-        const std::span<const std::byte> bytes = std::as_bytes(u8);
+        return parsePacket(socket::InboundFrame::fromBytes(std::span{ data, size }));
+    }
+
+    PacketPtr Context::parsePublishView(const socket::InboundFrame& frame) const
+    {
+        if (!isParseableFrame(std::as_bytes(frame.bytes)))
+        {
+            return nullptr;
+        }
 
-        return parsePacket(bytes);
+        const packets::FixedHeader fixedHeader = packets::FixedHeader::create(frame.typeAndFlags, frame.remainingLength);
+        if (fixedHeader.getPacketType() != packets::PacketType::Publish)
+        {
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Expected PUBLISH, got packet of type: %d", fixedHeader.getPacketType());
+            return nullptr;
+        }
+
+        serialize::ByteReader reader(std::as_bytes(frame.getBody()));
+        PacketPtr result = withMqttVersion(
+            getProtocolVersion(),
+            [this, &reader, &fixedHeader]<typename VersionTag>(VersionTag) -> PacketPtr
+            {
+                constexpr auto kV = VersionTag::value;
+                return m_packetArena.create<packets::PublishView<kV>>(reader, fixedHeader);
+            });
+
+        if (!result->isValid())
+        {
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Malformed packet of type: %d", packets::PacketType::Publish);
+            return nullptr;
+        }
+
+        return result;
+    }
+
+    PacketPtr Context::parsePublishView(const std::uint8_t* data, const std::uint32_t size) const
+    {
+        if (nullptr == data || 0 == size)
+        {
+            return nullptr;
+        }
+
+        return parsePublishView(socket::InboundFrame::fromBytes(std::span{ data, size }));
+    }
+
+    bool Context::shouldDecodePublishViews() const
+    {
+        return m_onMessageView.getSize() > 0;
     }
 
     void Context::recordActivity()
     {
-        m_lastActivityTime = std::chrono::steady_clock::now();
+        m_lastSendTime = m_now;
+        m_lastReceiveTime = m_lastSendTime;
+    }
+
+    void Context::recordTraffic(const std::chrono::steady_clock::time_point now)
+    {
+        const socket::TrafficCounters& traffic = *m_metrics.traffic;
+        if (const auto sent = traffic.packetsSent.load(std::memory_order_relaxed); sent != m_packetsSentSeen)
+        {
+            m_packetsSentSeen = sent;
+            m_lastSendTime = now;
+        }
+        if (const auto received = traffic.packetsReceived.load(std::memory_order_relaxed); received != m_packetsReceivedSeen)
+        {
+            m_packetsReceivedSeen = received;
+            m_lastReceiveTime = now;
+        }
     }
 
     std::chrono::milliseconds Context::getTimeSinceLastActivity() const
     {
-        const auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastActivityTime);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_now - getLastActivityTime());
     }
 
     void Context::recordPublishSent(const std::uint16_t packetId)
     {
-        m_publishSentTimes[packetId] = std::chrono::steady_clock::now();
+        if (InFlightPacket* inFlight = m_inFlight.find(packetId))
+        {
+            inFlight->retryCount = 0;
+            inFlight->sentAt = m_now;
+        }
+
+        m_timers.schedule(TimerKey{ TimerKind::PublishTimeout, packetId }, m_now + getPublishRetryInterval(0));
+    }
+
+    bool Context::retryPendingPublish(const std::uint16_t packetId)
+    {
+        InFlightPacket* inFlight = m_inFlight.find(packetId);
+        if (nullptr == inFlight || !std::holds_alternative<PublishCommand>(inFlight->command))
+        {
+            return false;
+        }
+
+        if (const std::uint8_t maxRetries = m_settings ? m_settings->getMaxPacketRetries() : 0; inFlight->retryCount >= maxRetries)
+        {
+            return false;
+        }
+
+        // A streamed publish is not resent on the same connection: its source may still be feeding the first send.
+        ++inFlight->retryCount;
+        if (getProtocolVersion() == packets::ProtocolVersion::V311 && !std::get<PublishCommand>(inFlight->command).stream)
+        {
+            sendRetransmit(*inFlight, packetId);
+            inFlight->sentAt = {};
+        }
+
+        m_timers.schedule(
+            TimerKey{ TimerKind::PublishTimeout, packetId }, m_now + getPublishRetryInterval(inFlight->retryCount));
+        return true;
+    }
+
+    std::chrono::milliseconds Context::getPublishRetryInterval(const std::uint8_t retryCount) const
+    {
+        // Same defaults as ConnectionSettings.
+        double intervalSeconds = m_settings ? m_settings->getPacketRetryIntervalSeconds() : 5.0;
+        const double multiplier = m_settings ? m_settings->getPacketRetryBackoffMultiplier() : 1.5;
+        const double maxSeconds = m_settings ? m_settings->getMaxPacketRetryIntervalSeconds() : 60.0;
+
+        if (m_settings && m_settings->shouldAdaptTimeouts() && m_rttEstimator.hasSample())
+        {
+            const auto maxTimeout = std::chrono::duration_cast<RttEstimator::Duration>(std::chrono::duration<double>(maxSeconds));
+            intervalSeconds = std::chrono::duration<double>(m_rttEstimator.getRetransmitTimeout(maxTimeout)).count();
+        }
+
+        for (std::uint8_t i = 0; i < retryCount && intervalSeconds < maxSeconds; ++i)
+        {
+            intervalSeconds *= multiplier;
+        }
+
+        return std::chrono::milliseconds(static_cast<std::int64_t>(std::min(intervalSeconds, maxSeconds) * 1000.0));
+    }
+
+    void Context::recordPingResponse()
+    {
+        if (m_pingPending)
+        {
+            m_rttEstimator.addSample(std::chrono::duration_cast<RttEstimator::Duration>(m_now - m_pingSentTime));
+        }
+    }
+
+    void Context::recordPublishResponse(const std::uint16_t packetId)
+    {
+        InFlightPacket* inFlight = m_inFlight.find(packetId);
+        if (nullptr == inFlight || inFlight->isReleased || inFlight->sentAt == std::chrono::steady_clock::time_point{})
+        {
+            return;
+        }
+
+        m_rttEstimator.addSample(std::chrono::duration_cast<RttEstimator::Duration>(m_now - inFlight->sentAt));
+        inFlight->sentAt = {};
+    }
+
+    std::chrono::milliseconds Context::getPingTimeout(const std::chrono::milliseconds keepalive) const
+    {
+        const std::chrono::milliseconds fixed = keepalive + keepalive / 2;
+        if (!m_settings || !m_settings->shouldAdaptTimeouts() || !m_rttEstimator.hasSample())
+        {
+            return fixed;
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_rttEstimator.getRetransmitTimeout(fixed));
     }
 
     std::chrono::milliseconds Context::getPublishElapsedTime(const std::uint16_t packetId) const
     {
-        const auto it = m_publishSentTimes.find(packetId);
-        if (it == m_publishSentTimes.end())
+        const auto fireTime = m_timers.getFireTime(TimerKey{ TimerKind::PublishTimeout, packetId });
+        if (!fireTime.has_value())
         {
             return std::chrono::milliseconds(0);
         }
 
-        const auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second);
+        const InFlightPacket* inFlight = m_inFlight.find(packetId);
+        const auto interval = getPublishRetryInterval(nullptr != inFlight ? inFlight->retryCount : 0);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(m_now - (fireTime.value() - interval));
     }
 
     void Context::clearPublishTimeout(const std::uint16_t packetId)
     {
-        m_publishSentTimes.erase(packetId);
+        m_timers.cancel(TimerKey{ TimerKind::PublishTimeout, packetId });
     }
 
     void Context::retransmitPendingPublishes()
@@ -288,12 +1028,106 @@ namespace reactormq::mqtt::client
             return;
         }
 
-        for (auto const& [packetId, publishCmd] : m_pendingPublishes)
+        flushOutboundBatch();
+
+        // Every PUBREL is referenced from the send buffers until the one vectored send, so none may be reallocated.
+        std::vector<std::array<std::byte, packets::kIdOnlyAckPacketSize>> pubRels;
+        pubRels.reserve(m_inFlight.size());
+        m_outboundSendBuffers.clear();
+        size_t packetCount = 0;
+        const auto sendGathered = [this, &packetCount]
         {
-            auto buffer = encodePendingPublish(publishCmd, packetId);
-            sendEncodedPublish(buffer);
+            if (packetCount != 0)
+            {
+                m_socket->sendVectored(m_outboundSendBuffers, packetCount);
+                m_outboundSendBuffers.clear();
+                packetCount = 0;
+            }
+        };
+
+        std::vector<std::uint16_t> completedPacketIds;
+        std::vector<std::uint16_t> failedPacketIds;
+        for (auto& [packetId, inFlight] : m_inFlight)
+        {
+            if (!std::holds_alternative<PublishCommand>(inFlight.command))
+            {
+                continue;
+            }
+
+            const PublishCommand& publish = std::get<PublishCommand>(inFlight.command);
+            if (inFlight.isReleased && !m_isSessionPresent)
+            {
+                completedPacketIds.push_back(packetId);
+                continue;
+            }
+
+            if (inFlight.isReleased)
+            {
+                pubRels.push_back(packets::encodeIdOnlyAck<packets::PacketType::PubRel>(packetId));
+                m_outboundSendBuffers.push_back(
+                    socket::SendBuffer{ reinterpret_cast<const std::uint8_t*>(pubRels.back().data()), pubRels.back().size() });
+                ++packetCount;
+            }
+            else if (publish.stream)
+            {
+                // A stream is read from its source as it is sent, so what was gathered before it goes out first.
+                sendGathered();
+                if (!sendRetransmit(inFlight, packetId))
+                {
+                    failedPacketIds.push_back(packetId);
+                    continue;
+                }
+            }
+            else
+            {
+                appendRetransmit(inFlight, packetId, m_outboundSendBuffers);
+                ++packetCount;
+            }
             recordPublishSent(packetId);
         }
+        sendGathered();
+
+        for (const std::uint16_t packetId : completedPacketIds)
+        {
+            if (auto publish = takePendingPublish(packetId))
+            {
+                clearPublishTimeout(packetId);
+                publish->promise.set_value(Result<void>::success());
+            }
+            releasePacketId(packetId);
+        }
+
+        for (const std::uint16_t packetId : failedPacketIds)
+        {
+            if (auto publish = takePendingPublish(packetId))
+            {
+                clearPublishTimeout(packetId);
+                publish->promise.set_value(Result<void>::failure(ResultError::PayloadSourceFailed, "Payload source cannot be rewound"));
+            }
+            releasePacketId(packetId);
+        }
+    }
+
+    void Context::releaseHeldIncomingQos2Messages()
+    {
+        std::vector<std::uint16_t> packetIds;
+        for (const auto& [packetId, message] : m_incomingPackets)
+        {
+            if (message.has_value())
+            {
+                packetIds.push_back(packetId);
+            }
+        }
+
+        for (const std::uint16_t packetId : packetIds)
+        {
+            if (auto message = takePendingIncomingQos2Message(packetId))
+            {
+                m_onMessageView.broadcast(MessageView(message.value()));
+                (void)deliverMessage(std::move(message.value()), {}, 0, packets::PacketType::PubComp);
+            }
+            releaseIncomingPacketId(packetId);
+        }
     }
 
     template<typename VersionTag, typename Message>
@@ -303,30 +1137,153 @@ namespace reactormq::mqtt::client
         PublishEncoder<kV>::encode(message, packetId, writer);
     }
 
-    void Context::sendEncodedPublish(std::vector<std::byte> const& buffer) const
+    void Context::flushOutboundBatch()
     {
-        if (!m_socket || buffer.empty())
+        if (m_outboundBatch.isEmpty())
         {
             return;
         }
 
-        const std::span bytes = buffer;
-        m_socket->send(bytes);
+        REACTORMQ_TRACE_SCOPE("Context::flushOutboundBatch");
+        if (m_socket)
+        {
+            m_outboundSendBuffers.clear();
+            m_outboundBatch.forEachSegment(
+                [this](const std::span<const std::byte> segment)
+                {
+                    m_outboundSendBuffers.push_back(
+                        socket::SendBuffer{ reinterpret_cast<const std::uint8_t*>(segment.data()), segment.size() });
+                });
+            m_socket->sendVectored(m_outboundSendBuffers, m_outboundBatch.getPacketCount());
+        }
+        m_outboundBatch.clear();
     }
 
-    std::vector<std::byte> Context::encodePendingPublish(PublishCommand const& publishCmd, const std::uint16_t packetId) const
+    void Context::sendPublish(const packets::PublishTemplate& publishTemplate, const std::uint16_t packetId, const SharedPayload& payload)
     {
-        std::vector<std::byte> buffer;
-        serialize::ByteWriter writer(buffer);
+        m_outboundBatch.appendPublish(publishTemplate, packetId, payload, false);
 
-        encodePublishForCurrentVersion(publishCmd.message, packetId, writer);
-        return buffer;
+        // A vectored write takes a bounded number of regions, and the batch buffer should stay around a tick's worth.
+        if (!m_isBatchingOutbound || m_outboundBatch.getSegmentCount() + 2 > socket::kMaxSendBuffers
+            || m_outboundBatch.getSize() >= kMaxOutboundBatchBytes)
+        {
+            flushOutboundBatch();
+        }
+    }
+
+    void Context::sendPreEncodedPublish(const std::span<const std::byte> packet)
+    {
+        m_outboundBatch.appendPublish(packet, SharedPayload{});
+        if (!m_isBatchingOutbound || m_outboundBatch.getSize() >= kMaxOutboundBatchBytes)
+        {
+            flushOutboundBatch();
+        }
+    }
+
+    bool Context::sendPublishStream(
+        const packets::PublishTemplate& publishTemplate,
+        const std::uint16_t packetId,
+        const PayloadSourcePtr& source)
+    {
+        if (!m_socket)
+        {
+            return false;
+        }
+
+        flushOutboundBatch();
+
+        const auto payloadSize = static_cast<std::uint32_t>(source->getSize());
+        std::vector<std::byte> header;
+        header.reserve(publishTemplate.getHeaderSize(payloadSize));
+        serialize::ByteWriter writer(header);
+        publishTemplate.encodeHeader(writer, packetId, payloadSize, false);
+        return m_socket->sendStream(header, source);
+    }
+
+    bool Context::sendRetransmit(InFlightPacket& inFlight, const std::uint16_t packetId)
+    {
+        if (!m_socket)
+        {
+            return true;
+        }
+
+        flushOutboundBatch();
+
+        if (inFlight.isReleased)
+        {
+            m_socket->sendControl(packets::encodeIdOnlyAck<packets::PacketType::PubRel>(packetId));
+            return true;
+        }
+
+        const PublishCommand& publish = std::get<PublishCommand>(inFlight.command);
+        if (publish.stream)
+        {
+            if (inFlight.retransmitHeader.empty())
+            {
+                inFlight.retransmitHeader = encodeRetransmitHeader(inFlight, packetId);
+            }
+            return publish.stream->rewind() && m_socket->sendStream(inFlight.retransmitHeader, publish.stream);
+        }
+
+        m_outboundSendBuffers.clear();
+        appendRetransmit(inFlight, packetId, m_outboundSendBuffers);
+        m_socket->sendVectored(m_outboundSendBuffers);
+        m_outboundSendBuffers.clear();
+        return true;
+    }
+
+    void Context::appendRetransmit(InFlightPacket& inFlight, const std::uint16_t packetId, std::vector<socket::SendBuffer>& buffers)
+    {
+        if (inFlight.retransmitHeader.empty())
+        {
+            inFlight.retransmitHeader = encodeRetransmitHeader(inFlight, packetId);
+        }
+
+        const PublishCommand& publish = std::get<PublishCommand>(inFlight.command);
+        const auto payload = nullptr != inFlight.payloadCodec ? inFlight.encodedPayload.getView() : publish.message.getPayloadView();
+        const std::vector<std::byte>& header = inFlight.retransmitHeader;
+        buffers.push_back(socket::SendBuffer{ reinterpret_cast<const std::uint8_t*>(header.data()), header.size() });
+        buffers.push_back(socket::SendBuffer{ payload.data(), payload.size() });
+    }
+
+    std::vector<std::byte> Context::encodeRetransmitHeader(const InFlightPacket& inFlight, const std::uint16_t packetId) const
+    {
+        const PublishCommand& publish = std::get<PublishCommand>(inFlight.command);
+        const Message& message = publish.message;
+        const bool isEncoded = nullptr != inFlight.payloadCodec;
+        size_t payloadSize = isEncoded ? inFlight.encodedPayload.getSize() : message.getPayloadView().size();
+        if (publish.stream)
+        {
+            payloadSize = publish.stream->getSize();
+        }
+        const std::string_view payloadCodec = isEncoded ? inFlight.payloadCodec->getName() : std::string_view{};
+        const std::uint32_t messageExpiryInterval = publish.getRemainingExpiryInterval(getNow());
+
+        std::vector<std::byte> header;
+        serialize::ByteWriter writer(header);
+        withMqttVersion(
+            getProtocolVersion(),
+            [&writer, &message, packetId, payloadSize, payloadCodec, messageExpiryInterval]<typename VersionTag>(VersionTag)
+            {
+                packets::encodePublishHeaderToWriter<VersionTag::value>(
+                    writer,
+                    message.getTopic(),
+                    static_cast<std::uint32_t>(payloadSize),
+                    message.getQualityOfService(),
+                    message.shouldRetain(),
+                    packetId,
+                    true,
+                    0,
+                    payloadCodec,
+                    messageExpiryInterval);
+            });
+        return header;
     }
 
     void Context::encodePublishForCurrentVersion(Message const& message, const std::uint16_t packetId, serialize::ByteWriter& writer) const
     {
         withMqttVersion(
-            m_protocolVersion,
+            getProtocolVersion(),
             [&message, &packetId, &writer, this]<typename VersionTag>(VersionTag)
             {
                 encodePublish<VersionTag>(message, packetId, writer);
@@ -335,28 +1292,22 @@ namespace reactormq::mqtt::client
 
     bool Context::trackIncomingPacketId(const std::uint16_t packetId)
     {
-        if (m_incomingPacketIds.contains(packetId))
-        {
-            return false; // Duplicate packet ID
-        }
-
-        m_incomingPacketIds.insert(packetId);
-        return true;
+        return nullptr != m_incomingPackets.tryEmplace(packetId); // nullptr: duplicate packet ID
     }
 
     void Context::releaseIncomingPacketId(const std::uint16_t packetId)
     {
-        m_incomingPacketIds.erase(packetId);
+        m_incomingPackets.erase(packetId);
     }
 
     bool Context::hasIncomingPacketId(const std::uint16_t packetId) const
     {
-        return m_incomingPacketIds.contains(packetId);
+        return m_incomingPackets.contains(packetId);
     }
 
     size_t Context::getPendingCommandCount() const
     {
-        return m_pendingPublishes.size() + m_pendingSubscribes.size() + m_pendingSubscribesMulti.size() + m_pendingUnsubscribes.size();
+        return m_inFlight.size() + m_heldPublishes.size();
     }
 
     bool Context::canAddPendingCommand() const
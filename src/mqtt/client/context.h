@@ -4,17 +4,62 @@
 
 #pragma once
 
+#include "mqtt/client/async_result.h"
+#include "mqtt/client/backoff.h"
+#include "mqtt/client/client_metric_counters.h"
+#include "mqtt/client/chunked_transfer.h"
+#include "mqtt/client/command.h"
+#include "mqtt/client/inbound_topic_aliases.h"
+#include "mqtt/client/conflated_handlers.h"
+#include "mqtt/client/connect_packet_cache.h"
+#include "mqtt/client/endpoint_selector.h"
+#include "mqtt/client/inbound_scheduler.h"
+#include "mqtt/client/last_value_cache.h"
+#include "mqtt/client/message_dispatcher.h"
+#include "mqtt/client/mpsc_queue.h"
+#include "mqtt/client/mqtt_version_mapping.h"
+#include "mqtt/client/offline_publish_queue.h"
+#include "mqtt/client/packet_arena.h"
+#include "mqtt/client/packet_id_bitmap.h"
+#include "mqtt/client/packet_id_pool.h"
+#include "mqtt/client/packet_id_slot_map.h"
+#include "mqtt/client/payload_codecs.h"
+#include "mqtt/client/payload_sinks.h"
+#include "mqtt/client/publish_deduplicator.h"
+#include "mqtt/client/publish_rate_limiter.h"
+#include "mqtt/client/publish_templates.h"
+#include "mqtt/client/request_table.h"
+#include "mqtt/client/rtt_estimator.h"
+#include "mqtt/client/standby_connection.h"
+#include "mqtt/client/subscription_cache.h"
+#include "mqtt/client/tick_profiler.h"
+#include "mqtt/client/timer.h"
+#include "mqtt/client/topic_alias_manager.h"
+#include "mqtt/client/topic_intern_table.h"
+#include "mqtt/client/topic_router.h"
+#include "mqtt/client/traffic_accounting.h"
+#include "mqtt/client/wakeup_route.h"
+#include "mqtt/packets/packet_batch.h"
+#include "mqtt/packets/packet_type.h"
 #include "reactormq/mqtt/connection_settings.h"
 #include "reactormq/mqtt/delegates.h"
 #include "reactormq/mqtt/message.h"
 #include "reactormq/mqtt/protocol_version.h"
+#include "reactormq/mqtt/session_store.h"
 #include "serialize/bytes.h"
 #include "socket/socket.h"
+#include "util/trace/trace.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
-#include <unordered_map>
-#include <unordered_set>
+#include <variant>
+#include <vector>
 
 namespace reactormq::mqtt::packets
 {
@@ -48,10 +93,6 @@ namespace reactormq::mqtt::packets
 
 namespace reactormq::mqtt::client
 {
-    struct PublishCommand;
-    struct SubscribeCommand;
-    struct SubscribesCommand;
-    struct UnsubscribesCommand;
     class Reactor;
 
     /**
@@ -60,6 +101,38 @@ namespace reactormq::mqtt::client
      */
     using OnSocketReplaced = MulticastDelegate<void()>;
 
+    /// @brief An acknowledgeable command awaiting its acknowledgement; they all share the outgoing packet ID space.
+    using InFlightCommand = std::variant<PublishCommand, SubscribeCommand, SubscribesCommand, UnsubscribesCommand>;
+
+    /// @brief Entry of the in-flight table: the command plus its retransmission state.
+    struct InFlightPacket
+    {
+        InFlightCommand command;
+
+        /**
+         * @brief Publishes only: PUBLISH header (fixed header through properties) with DUP set and the full topic.
+         * Kept from the original send when that carried no topic alias, otherwise encoded on the first retransmit.
+         * The payload is sent from the message's shared buffer, so a retransmit copies and encodes nothing.
+         */
+        std::vector<std::byte> retransmitHeader;
+
+        /// @brief Publishes only: retry timer expiries so far on the current connection.
+        std::uint8_t retryCount = 0;
+
+        /// @brief Publishes only: payload as a payload codec encoded it, which retransmits send instead of the message's.
+        SharedPayload encodedPayload;
+
+        /// @brief Publishes only: codec behind encodedPayload, or nullptr when the payload was sent plain.
+        const IPayloadCodec* payloadCodec = nullptr;
+
+        /// @brief QoS 2 publishes only: PUBREC arrived and PUBREL was sent, so a retransmit is the PUBREL.
+        bool isReleased = false;
+
+        /// @brief Publishes only: when the PUBLISH was sent on this connection, to time its PUBACK or PUBREC; unset once
+        /// it has been resent on the same connection, when the response could be to either send.
+        std::chrono::steady_clock::time_point sentAt{};
+    };
+
     /**
      * @brief Shared MQTT client state used by the reactor thread.
      * Holds the socket, connection settings, ID pools, queues, and user callbacks.
@@ -79,32 +152,79 @@ namespace reactormq::mqtt::client
             return m_socket;
         }
 
+        /// @brief Whether the socket has paused receiving, so packets left in a batch should stay buffered.
+        [[nodiscard]] bool isReceivePaused() const
+        {
+            return m_socket && m_socket->isReceivePaused();
+        }
+
         /**
          * @brief Replace the socket instance.
          * @param socket New socket to use.
          */
         void setSocket(socket::SocketPtr socket)
         {
+            flushOutboundBatch();
             m_socket = std::move(socket);
+            if (m_socket)
+            {
+                m_socket->setTrafficCounters(m_metrics.traffic);
+                m_socket->setInboundPacketLimited(!m_inboundScheduler.isEnabled());
+                if (m_settings)
+                {
+                    m_socket->setPacketTap(m_settings->getPacketTap());
+                }
+            }
             m_onSocketReplaced.broadcast();
         }
 
-        /// @brief Access the connection settings.
-        [[nodiscard]] ConnectionSettingsPtr getSettings() const
+        /// @brief Counters behind IClient::getMetrics(); their atomics may be read from any thread.
+        [[nodiscard]] ClientMetricCounters& getMetricCounters()
+        {
+            return m_metrics;
+        }
+
+        /// @brief Counters behind IClient::getMetrics(); their atomics may be read from any thread.
+        [[nodiscard]] const ClientMetricCounters& getMetricCounters() const
+        {
+            return m_metrics;
+        }
+
+        /// @brief Per-phase tick timings behind IClient::getTickProfile(); nullptr unless tick profiling is enabled.
+        [[nodiscard]] TickProfiler* getTickProfiler() const
+        {
+            return m_tickProfiler.get();
+        }
+
+        /// @brief Inbound counters behind IClient::getInboundTraffic(); nullptr unless traffic accounting is enabled.
+        [[nodiscard]] TrafficAccounting* getTrafficAccounting() const
+        {
+            return m_trafficAccounting.get();
+        }
+
+        /// @brief Access the connection settings; set once at construction, so the reference stays valid for the context's life.
+        [[nodiscard]] const ConnectionSettingsPtr& getSettings() const
         {
             return m_settings;
         }
 
-        /// @brief Get the negotiated protocol version.
+        /// @brief Get the negotiated protocol version; a constant in a single-version build, so checks on it fold away.
         [[nodiscard]] packets::ProtocolVersion getProtocolVersion() const
         {
-            return m_protocolVersion;
+            if constexpr (kIsProtocolVersionFixed)
+            {
+                return kFixedProtocolVersion;
+            }
+            else
+            {
+                return m_protocolVersion;
+            }
         }
 
-        /// @brief Update the negotiated protocol version.
+        /// @brief Update the negotiated protocol version; a single-version build keeps the one it was built for.
         void setProtocolVersion(const packets::ProtocolVersion version)
         {
-            m_protocolVersion = version;
+            m_protocolVersion = kIsProtocolVersionFixed ? kFixedProtocolVersion : version;
         }
 
         /**
@@ -127,6 +247,7 @@ namespace reactormq::mqtt::client
 
         /**
          * @brief Check whether adding bytes would exceed the outbound limit.
+         * Bytes still queued inside the socket count against the limit, so a slow peer applies backpressure.
          * @param bytes Number of bytes to potentially add.
          * @return True if within limit; false if it would exceed.
          */
@@ -137,7 +258,8 @@ namespace reactormq::mqtt::client
                 return true;
             }
             const size_t maxBytes = m_settings->getMaxOutboundQueueBytes();
-            return m_outboundQueueSize + bytes <= maxBytes;
+            const size_t socketPendingBytes = m_socket ? m_socket->getPendingSendBytes() : 0;
+            return m_outboundQueueSize + socketPendingBytes + bytes <= maxBytes;
         }
 
         /// @brief Increase the outbound queue size by the given bytes.
@@ -188,6 +310,12 @@ namespace reactormq::mqtt::client
             return m_onMessage;
         }
 
+        /// @brief Access the onMessageView delegate.
+        OnMessageView& getOnMessageView()
+        {
+            return m_onMessageView;
+        }
+
         /// @brief Access the onSocketReplaced delegate (internal use by reactor).
         OnSocketReplaced& getOnSocketReplaced()
         {
@@ -196,17 +324,26 @@ namespace reactormq::mqtt::client
 
         /**
          * @brief Invoke a callback immediately or via the settings-provided executor.
-         * If a CallbackExecutor is set, the call is marshalled to it; otherwise it runs on the reactor thread.
+         * If a CallbackExecutor is set, the call is marshalled to it, or held for flushCallbacks() when callbacks are
+         * batched; otherwise it runs on the reactor thread.
          * @tparam Callback Callable type (typically a lambda).
          * @param callback The callback to invoke.
          */
         template<typename Callback>
-        void invokeCallback(Callback&& callback) const
+        void invokeCallback(Callback&& callback)
         {
+            REACTORMQ_TRACE_SCOPE("Context::invokeCallback");
+            const TickPhaseScope phaseScope(m_tickProfiler.get(), TickPhase::Dispatch);
             if (m_settings)
             {
                 if (const auto& executor = m_settings->getCallbackExecutor())
                 {
+                    if (m_settings->shouldBatchCallbacks())
+                    {
+                        m_batchedCallbacks.emplace_back(std::forward<Callback>(callback));
+                        return;
+                    }
+
                     executor(std::forward<Callback>(callback));
                     return;
                 }
@@ -215,14 +352,30 @@ namespace reactormq::mqtt::client
             std::forward<Callback>(callback)();
         }
 
+        /**
+         * @brief Hand the callbacks batched since the last flush to the CallbackExecutor as one task.
+         * Called by the reactor at the end of every tick; does nothing when no callback is held.
+         */
+        void flushCallbacks();
+
+        /**
+         * @brief Parse a complete MQTT control packet the socket framed, without decoding its fixed header again.
+         * Returns a concrete packet instance or nullptr on parse failure. The packet lives in the tick-scoped packet
+         * arena when it is enabled and must be released before the reactor's tick ends.
+         * @param frame The packet and its decoded fixed header.
+         * @return Parsed packet, or nullptr on error.
+         */
+        [[nodiscard]] PacketPtr parsePacket(const socket::InboundFrame& frame) const;
+
         /**
          * @brief Parse a complete MQTT control packet from raw bytes.
-         * Returns a concrete packet instance or nullptr on parse failure.
+         * Returns a concrete packet instance or nullptr on parse failure. The packet lives in the tick-scoped packet
+         * arena when it is enabled and must be released before the reactor's tick ends.
          * @param data Pointer to the raw packet data.
          * @param size Buffer size in bytes.
          * @return Parsed packet, or nullptr on error.
          */
-        [[nodiscard]] std::unique_ptr<packets::IControlPacket> parsePacket(const std::uint8_t* data, std::uint32_t size) const;
+        [[nodiscard]] PacketPtr parsePacket(const std::uint8_t* data, std::uint32_t size) const;
 
         /**
          * @brief Parse a complete MQTT control packet from raw bytes.
@@ -230,18 +383,497 @@ namespace reactormq::mqtt::client
          * @param data The packet being parsed
          * @return Parsed packet, or nullptr on error.
          */
-        [[nodiscard]] std::unique_ptr<packets::IControlPacket> parsePacket(std::span<const std::byte> data) const;
+        [[nodiscard]] PacketPtr parsePacket(std::span<const std::byte> data) const;
+
+        /**
+         * @brief Common size checks before a frame is decoded, for decoders that bypass parsePacket().
+         * @param data The whole packet.
+         * @return False, after logging why, if the packet is too short or over the enforced maximum packet size.
+         */
+        [[nodiscard]] bool isParseableFrame(std::span<const std::byte> data) const;
 
-        /// @brief Store a pending publish command by packet ID.
-        void storePendingPublish(std::uint16_t packetId, PublishCommand command);
+        /**
+         * @brief Parse a framed PUBLISH packet as a packets::IPublishView over its bytes.
+         * Nothing is copied: the packet must be released before the buffer holding the frame is reused.
+         * @param frame The packet and its decoded fixed header.
+         * @return Parsed packet, or nullptr if the frame is not a well-formed PUBLISH.
+         */
+        [[nodiscard]] PacketPtr parsePublishView(const socket::InboundFrame& frame) const;
+
+        /**
+         * @brief Parse a complete PUBLISH packet as a packets::IPublishView over the raw bytes.
+         * Nothing is copied: the packet must be released before the buffer holding data is reused.
+         * @param data Pointer to the raw packet data.
+         * @param size Buffer size in bytes.
+         * @return Parsed packet, or nullptr if the bytes are not a well-formed PUBLISH.
+         */
+        [[nodiscard]] PacketPtr parsePublishView(const std::uint8_t* data, std::uint32_t size) const;
+
+        /// @brief Whether inbound PUBLISH packets should be decoded as views, i.e. an OnMessageView handler is bound.
+        [[nodiscard]] bool shouldDecodePublishViews() const;
+
+        /// @brief Reclaim every packet decoded since the last reset; called by Reactor::tick() once all are released.
+        void resetPacketArena() const
+        {
+            m_packetArena.reset();
+        }
+
+        /// @brief Tick-scoped arena that backs decoded inbound packets (read-only).
+        [[nodiscard]] const PacketArena& getPacketArena() const
+        {
+            return m_packetArena;
+        }
+
+        /**
+         * @brief Steady time sampled once at the start of the current reactor tick. Deadlines, timeouts and latency
+         * stamps taken during the tick use it instead of reading the clock for every packet.
+         */
+        [[nodiscard]] std::chrono::steady_clock::time_point getNow() const
+        {
+            return m_now;
+        }
+
+        /**
+         * @brief Set the time getNow() returns until the next call; the reactor calls it first thing in every tick.
+         * @param now Clock read that starts the tick.
+         */
+        void setNow(const std::chrono::steady_clock::time_point now)
+        {
+            m_now = now;
+        }
+
+        /// @brief Wall-clock time of the current tick, read on first use; stamps the messages received in it.
+        [[nodiscard]] Message::Clock::time_point getTickTimeUtc() const
+        {
+            if (!m_tickTimeUtc.has_value())
+            {
+                m_tickTimeUtc = Message::Clock::now();
+            }
+            return m_tickTimeUtc.value();
+        }
+
+        /// @brief Forget the tick time, so the next tick that receives a message reads the clock again.
+        void resetTickTime() const
+        {
+            m_tickTimeUtc.reset();
+        }
+
+        /// @brief Memory resource the client draws inbound payloads and its packet arena from.
+        [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const
+        {
+            return m_settings ? m_settings->getMemoryResource() : std::pmr::new_delete_resource();
+        }
+
+        /// @brief Outbound MQTT 5 topic aliases for the current connection.
+        [[nodiscard]] TopicAliasManager& getTopicAliases()
+        {
+            return m_topicAliases;
+        }
+
+        /// @brief MQTT 5 payload codecs from the settings.
+        [[nodiscard]] const PayloadCodecs& getPayloadCodecs() const
+        {
+            return m_payloadCodecs;
+        }
+
+        /// @brief Per-subscription message handlers, by topic filter.
+        [[nodiscard]] TopicRouter& getTopicRouter()
+        {
+            return m_topicRouter;
+        }
+
+        /// @brief Per-subscription sinks for messages over the inbound streaming threshold, by topic filter.
+        [[nodiscard]] PayloadSinks& getPayloadSinks()
+        {
+            return m_payloadSinks;
+        }
+
+        /// @brief Per-subscription sinks that reassemble chunked transfers, by topic filter.
+        [[nodiscard]] ChunkAssemblers& getChunkAssemblers()
+        {
+            return m_chunkAssemblers;
+        }
+
+        /**
+         * @brief Set the delivery priority of a subscribed filter, and have the socket read every packet while any
+         * filter has one, so the InboundScheduler spends the per-tick budget on deliveries.
+         * @param filter Topic filter.
+         * @param priority TopicFilter::getDeliveryPriority(); 0 drops the filter's priority.
+         */
+        void setDeliveryPriority(std::string_view filter, std::uint8_t priority);
+
+        /// @brief Per-subscription handlers that take only the newest message per topic.
+        [[nodiscard]] ConflatedHandlers& getConflatedHandlers()
+        {
+            return m_conflatedHandlers;
+        }
+
+        /// @brief Latest message per topic, or nullptr when the cache is off. The cache itself is safe to read from any thread.
+        [[nodiscard]] const LastValueCache* getLastValues() const
+        {
+            return m_lastValues.get();
+        }
+
+        /// @brief Subscriptions the broker has granted, resubscribed to when a reconnect finds no session.
+        [[nodiscard]] SubscriptionCache& getSubscriptionCache()
+        {
+            return m_subscriptionCache;
+        }
+
+        /// @brief Requests waiting for their response.
+        [[nodiscard]] RequestTable& getRequests()
+        {
+            return m_requests;
+        }
+
+        /// @brief Topic this client's responses come back on; chosen the first time it is asked for, then kept.
+        [[nodiscard]] const std::string& getResponseTopic();
+
+        /// @brief Whether the response topic has been subscribed to on this session.
+        [[nodiscard]] bool isResponseTopicSubscribed() const
+        {
+            return m_isResponseTopicSubscribed;
+        }
+
+        /// @brief Record whether the response topic is subscribed to, as when its SUBSCRIBE goes out or a session is lost.
+        void setResponseTopicSubscribed(const bool isSubscribed)
+        {
+            m_isResponseTopicSubscribed = isSubscribed;
+        }
+
+        /// @brief Whether messages on a topic are responses to this client's requests rather than for ordinary delivery.
+        [[nodiscard]] bool isResponseTopic(const std::string_view topic) const
+        {
+            return !m_responseTopic.empty() && topic == m_responseTopic;
+        }
+
+        /**
+         * @brief Complete the request a message on the response topic answers. A response no request is waiting for,
+         * because it timed out or was never ours, is dropped.
+         * @param view The message.
+         * @param correlationData Correlation Data it carries; empty if none.
+         */
+        void completeRequest(const MessageView& view, std::span<const std::uint8_t> correlationData);
+
+        /**
+         * @brief Fail a request whose response did not come in time.
+         * @param correlationId The request's correlation ID.
+         */
+        void expireRequest(std::uint32_t correlationId);
+
+        /// @brief The PUBLISH the socket is passing on in fragments, if any.
+        [[nodiscard]] InboundStream& getInboundStream()
+        {
+            return m_inboundStream;
+        }
+
+        /// @brief Drop a PUBLISH cut off in the middle of its fragments, as the connection closes; its sink is told.
+        void abandonInboundStream();
+
+        /**
+         * @brief Hand an incoming message to the OnMessage handlers and to the handlers routed for it, via the
+         * callback executor if one is set. Does nothing when no handler would see it, beyond keeping the message in the
+         * last-value cache when that is on.
+         * When the pending-delivery bounds are set and the handlers run off the reactor thread, the message counts
+         * against them until its handlers finish, and reaching a bound pauses reading from the socket. With manual
+         * acknowledgement the message carries an AckToken and the acknowledgement waits for it. While subscriptions
+         * have delivery priorities, a message over the tick's budget, or behind waiting messages of its priority or
+         * higher, waits in the InboundScheduler, and so does its acknowledgement.
+         * @param message The received message.
+         * @param subscriptionIdentifiers Subscription Identifiers the PUBLISH carried; when there are any, handlers
+         * are found by identifier instead of by topic.
+         * @param ackPacketId Packet ID to acknowledge once the message is handled, or 0 when it needs no
+         * acknowledgement.
+         * @param ackType Acknowledgement owed for ackPacketId: PUBACK for QoS 1, PUBCOMP for QoS 2.
+         * @return True if the acknowledgement waits for the handlers or the application: completeDeliveries() sends
+         * it and releases the packet ID. False if the caller should acknowledge now.
+         */
+        bool deliverMessage(
+            Message message,
+            std::span<const std::uint32_t> subscriptionIdentifiers = {},
+            std::uint16_t ackPacketId = 0,
+            packets::PacketType ackType = packets::PacketType::PubAck);
+
+        /// @brief Whether deliverMessage() would reach any handler for a topic, given as interned when it is.
+        [[nodiscard]] bool hasMessageHandlers(
+            std::string_view topic,
+            std::span<const std::uint32_t> subscriptionIdentifiers = {},
+            const SharedTopic& interned = {});
+
+        /**
+         * @brief The shared string for an inbound topic, when the settings turn topic interning on.
+         * @param topic Topic name of an inbound PUBLISH.
+         * @return The interned topic; empty when interning is off, in which case the message owns its topic.
+         */
+        [[nodiscard]] SharedTopic internTopic(const std::string_view topic)
+        {
+            return m_topicInterns.intern(topic);
+        }
+
+        /**
+         * @brief Send the acknowledgements of messages that are handled or acknowledged by the application, then
+         * pause or resume reading from the socket to match the pending-delivery bounds. Called by the reactor every
+         * tick, so everything acknowledged since the last tick goes out in one write.
+         */
+        void completeDeliveries();
+
+        /**
+         * @brief Deliver the messages the InboundScheduler held back, highest priority first, with what is left of
+         * the tick's budget, then start the next tick's budget and send their acknowledgements. Called by the reactor
+         * every tick once the socket has been read.
+         */
+        void deliverWaitingMessages();
+
+        /// @brief Whether completeDeliveries() has an acknowledgement to send or a paused receive to resume, or a message
+        /// is waiting for deliverWaitingMessages().
+        [[nodiscard]] bool hasCompletedDeliveries() const;
+
+        /**
+         * @brief Forget the packet IDs whose PUBACK or PUBCOMP is still deferred, as the connection closes.
+         * The broker resends those publishes (or PUBRELs) on the next connection; forgetting them lets that copy
+         * through instead of it being dropped as a duplicate, and the acknowledgements of the old connection are
+         * never sent.
+         */
+        void abandonDeferredAcks();
+
+        /// @brief Messages handed off the reactor thread under the pending-delivery bounds whose handlers have not finished.
+        [[nodiscard]] size_t getPendingDeliveryCount() const
+        {
+            return m_pendingDeliveries.load(std::memory_order_acquire);
+        }
+
+        /// @brief Wakeup signalled when a message is handled or acknowledged, so the reactor sends its acknowledgement
+        /// without waiting for I/O. Set once, before any message is delivered.
+        void setDeliveryWakeup(std::shared_ptr<WakeupRoute> wakeup)
+        {
+            m_asyncSignal->wakeup = wakeup;
+            m_deliveredAcks->wakeup = std::move(wakeup);
+        }
+
+        /// @brief Signal raised by AsyncResults, such as credentials a provider delivers from its own thread.
+        [[nodiscard]] const std::shared_ptr<AsyncSignal>& getAsyncSignal() const
+        {
+            return m_asyncSignal;
+        }
+
+        /// @brief Whether an AsyncResult was set since the last clearAsyncResults(). Safe from any thread.
+        [[nodiscard]] bool hasAsyncResults() const
+        {
+            return m_asyncSignal->isRaised.load(std::memory_order_acquire);
+        }
+
+        /// @brief Lower the async signal; the reactor does this before the state takes whatever results arrived.
+        void clearAsyncResults()
+        {
+            m_asyncSignal->isRaised.store(false, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gather the PUBLISHes sent from now until endOutboundBatch() into one buffer, written in one send.
+         * The reactor opens a batch around each tick's commands.
+         */
+        void beginOutboundBatch()
+        {
+            m_isBatchingOutbound = true;
+        }
+
+        /// @brief Write the gathered PUBLISHes and send the ones that follow straight away again.
+        void endOutboundBatch()
+        {
+            flushOutboundBatch();
+            m_isBatchingOutbound = false;
+        }
+
+        /**
+         * @brief Write the PUBLISHes gathered so far in one vectored send, staying in the batch.
+         * Called before anything else is sent on the data lane, so packets leave in the order they were made.
+         */
+        void flushOutboundBatch();
+
+        /**
+         * @brief Send a PUBLISH encoded from its template; gathered into the current batch if one is open.
+         * @param publishTemplate Template the header is encoded from.
+         * @param packetId Packet identifier; ignored for QoS 0.
+         * @param payload Payload bytes; kept alive by the batch until it is written.
+         */
+        void sendPublish(const packets::PublishTemplate& publishTemplate, std::uint16_t packetId, const SharedPayload& payload);
+
+        /**
+         * @brief Send a PUBLISH encoded on the thread that published it; gathered into the current batch if one is open.
+         * @param packet The whole packet, packet identifier included; copied into the batch.
+         */
+        void sendPreEncodedPublish(std::span<const std::byte> packet);
+
+        /**
+         * @brief Send a PUBLISH whose payload the socket reads from a source as it drains, behind the current batch.
+         * @param publishTemplate Template the header is encoded from.
+         * @param packetId Packet identifier; ignored for QoS 0.
+         * @param source Payload source; its size goes into the header.
+         * @return False if there is no socket or the source fell short.
+         */
+        bool sendPublishStream(const packets::PublishTemplate& publishTemplate, std::uint16_t packetId, const PayloadSourcePtr& source);
+
+        /// @brief PUBLISH header templates, so repeated publishes to a topic only patch the per-message fields.
+        [[nodiscard]] PublishTemplates& getPublishTemplates()
+        {
+            return m_publishTemplates;
+        }
+
+        /// @brief The last CONNECT encoded, so a reconnect with unchanged credentials sends the same bytes.
+        [[nodiscard]] ConnectPacketCache& getConnectPacketCache()
+        {
+            return m_connectPacket;
+        }
+
+        /// @brief Last payload hash sent per topic, or nullptr unless ConnectionSettings::getPublishDedup() is enabled.
+        [[nodiscard]] PublishDeduplicator* getPublishDeduplicator()
+        {
+            return m_publishDeduplicator.get();
+        }
+
+        /// @brief Outbound rate limits and the publishes they hold, or nullptr unless ConnectionSettings::getPublishRateLimits() has any.
+        [[nodiscard]] PublishRateLimiter* getPublishRateLimiter()
+        {
+            return m_publishRateLimiter.get();
+        }
+
+        /// @brief Topic aliases the broker has set for inbound PUBLISH packets on the current connection.
+        [[nodiscard]] InboundTopicAliases& getInboundTopicAliases()
+        {
+            return m_inboundTopicAliases;
+        }
+
+        /// @brief Publishes made while not connected, sent when the client next becomes ready.
+        [[nodiscard]] OfflinePublishQueue& getOfflinePublishes()
+        {
+            return m_offlinePublishes;
+        }
+
+        /// @brief Broker node each connection attempt goes to, with the health of every configured node.
+        [[nodiscard]] EndpointSelector& getEndpoints()
+        {
+            return m_endpoints;
+        }
+
+        /// @brief Transport kept open to a failover node when the settings enable a warm standby.
+        [[nodiscard]] StandbyConnection& getStandby()
+        {
+            return m_standby;
+        }
+
+        /// @brief Delays between automatic reconnect attempts; kept across attempts and reset once the broker accepts.
+        [[nodiscard]] BackoffCalculator& getReconnectBackoff()
+        {
+            return m_reconnectBackoff;
+        }
+
+        /**
+         * @brief Store a pending publish command by packet ID.
+         * @param packetId Packet ID the publish was sent with.
+         * @param command The publish command.
+         * @param sentHeader PUBLISH header exactly as sent, if it carried the full topic and no topic alias; it is
+         * kept, with DUP set, for retransmits. Empty to have it encoded on the first retransmit instead.
+         * @param encodedPayload Payload as sent, when payloadCodec encoded it.
+         * @param payloadCodec Codec the payload was sent encoded with, or nullptr.
+         */
+        void storePendingPublish(
+            std::uint16_t packetId,
+            PublishCommand command,
+            std::vector<std::byte> sentHeader = {},
+            SharedPayload encodedPayload = {},
+            const IPayloadCodec* payloadCodec = nullptr);
 
         /// @brief Take and remove a pending publish command by packet ID.
         std::optional<PublishCommand> takePendingPublish(std::uint16_t packetId);
 
-        /// @brief Read-only view of pending publish commands (used for timeouts).
-        [[nodiscard]] const std::unordered_map<std::uint16_t, PublishCommand>& getPendingPublishes() const
+        /// @brief Pending publish command for a packet ID, or nullptr.
+        [[nodiscard]] const PublishCommand* findPendingPublish(std::uint16_t packetId) const;
+
+        /**
+         * @brief Record that a QoS 2 publish got its PUBREC and its PUBREL was sent.
+         * @param packetId Packet ID of the publish; an unknown one is ignored.
+         */
+        void markPublishReleased(std::uint16_t packetId);
+
+        /// @brief Number of QoS 1/2 publishes sent and not yet acknowledged.
+        [[nodiscard]] size_t getPendingPublishCount() const
+        {
+            return m_pendingPublishCount;
+        }
+
+        /**
+         * @brief Set the broker's Receive Maximum, i.e. how many QoS 1/2 publishes may be unacknowledged at once.
+         * @param receiveMaximum Receive Maximum from CONNACK (65535 when absent, and for MQTT 3.1.1).
+         */
+        void setReceiveMaximum(const std::uint16_t receiveMaximum)
         {
-            return m_pendingPublishes;
+            m_receiveMaximum = receiveMaximum;
+        }
+
+        /// @brief Broker's Receive Maximum for the current connection.
+        [[nodiscard]] std::uint16_t getReceiveMaximum() const
+        {
+            return m_receiveMaximum;
+        }
+
+        /**
+         * @brief Set the largest packet the broker accepts, which bounds how many filters one SUBSCRIBE carries.
+         * @param maximumPacketSize Maximum Packet Size from CONNACK (the protocol limit when absent, and for MQTT 3.1.1).
+         */
+        void setBrokerMaximumPacketSize(const std::uint32_t maximumPacketSize)
+        {
+            m_brokerMaximumPacketSize = maximumPacketSize;
+        }
+
+        /// @brief Broker's Maximum Packet Size for the current connection.
+        [[nodiscard]] std::uint32_t getBrokerMaximumPacketSize() const
+        {
+            return m_brokerMaximumPacketSize;
+        }
+
+        /// @brief Set whether the broker accepts Subscription Identifiers, from CONNACK (false for MQTT 3.1.1).
+        void setSubscriptionIdentifiersAvailable(const bool available)
+        {
+            m_subscriptionIdentifiersAvailable = available;
+        }
+
+        /// @brief Whether SUBSCRIBE may carry a Subscription Identifier on the current connection.
+        [[nodiscard]] bool areSubscriptionIdentifiersAvailable() const
+        {
+            return m_subscriptionIdentifiersAvailable;
+        }
+
+        /// @brief Set whether the broker resumed a session for this connection, from CONNACK's Session Present flag.
+        void setSessionPresent(const bool isSessionPresent)
+        {
+            m_isSessionPresent = isSessionPresent;
+        }
+
+        /// @brief Whether the broker kept the session, and with it the subscriptions, across the reconnect.
+        [[nodiscard]] bool isSessionPresent() const
+        {
+            return m_isSessionPresent;
+        }
+
+        /**
+         * @brief Remaining send quota: QoS 1/2 publishes that may be sent before another one is acknowledged.
+         * Every unacknowledged publish uses one unit; PUBACK, PUBCOMP or a timeout gives it back.
+         */
+        [[nodiscard]] size_t getSendQuota() const
+        {
+            return m_pendingPublishCount < m_receiveMaximum ? m_receiveMaximum - m_pendingPublishCount : 0;
+        }
+
+        /// @brief Queue a QoS 1/2 publish until the send quota allows it to be sent.
+        void holdPublish(PublishCommand command);
+
+        /// @brief Take the oldest held publish, if any.
+        std::optional<PublishCommand> takeHeldPublish();
+
+        /// @brief Number of publishes waiting for send quota.
+        [[nodiscard]] size_t getHeldPublishCount() const
+        {
+            return m_heldPublishes.size();
         }
 
         /// @brief Store a pending subscribe command by packet ID.
@@ -262,18 +894,80 @@ namespace reactormq::mqtt::client
         /// @brief Take and remove a pending 'unsubscribes' command by packet ID.
         std::optional<UnsubscribesCommand> takePendingUnsubscribes(std::uint16_t packetId);
 
+        /**
+         * @brief Fail every subscribe awaiting its SUBACK and release its packet ID, as when the connection they
+         * were sent on is refused.
+         * @param error Error the promises fail with.
+         */
+        void failPendingSubscribes(ResultError error);
+
         /// @brief Store an incoming QoS 2 message awaiting PUBREL (after PUBREC).
         void storePendingIncomingQos2Message(std::uint16_t packetId, Message message);
 
         /// @brief Take and remove a pending QoS 2 message by packet ID (on PUBREL).
         std::optional<Message> takePendingIncomingQos2Message(std::uint16_t packetId);
 
-        /// @brief Record activity for keepalive tracking.
+        /**
+         * @brief Record a QoS 2 message delivered on PUBLISH, so a resent PUBLISH is not delivered again before PUBREL.
+         * @param packetId Broker's packet ID.
+         * @return False if the ID is already recorded, i.e. the PUBLISH is a duplicate.
+         */
+        bool trackDeliveredQos2PacketId(std::uint16_t packetId)
+        {
+            return m_deliveredQos2PacketIds.insert(packetId);
+        }
+
+        /**
+         * @brief Forget a QoS 2 message delivered on PUBLISH (on PUBREL).
+         * @param packetId Broker's packet ID.
+         * @return True if it was recorded.
+         */
+        bool releaseDeliveredQos2PacketId(std::uint16_t packetId)
+        {
+            return m_deliveredQos2PacketIds.erase(packetId);
+        }
+
+        /// @brief Forget every QoS 2 message delivered on PUBLISH, as when the broker starts a new session.
+        void clearDeliveredQos2PacketIds()
+        {
+            m_deliveredQos2PacketIds.clear();
+        }
+
+        /// @brief Make the session state recorded since the last call durable; called once per reactor tick.
+        void commitSessionStore();
+
+        /// @brief Mark both directions active now, as when a connection is established.
         void recordActivity();
 
-        /// @brief Time since last activity.
+        /**
+         * @brief Stamp the last send and receive times for each direction the socket carried a packet in since the
+         * previous call. Called once at the end of every reactor tick with the clock read that closes it, so sending a
+         * packet costs no clock read of its own.
+         * @param now End of the current tick.
+         */
+        void recordTraffic(std::chrono::steady_clock::time_point now);
+
+        /// @brief Time since last activity in either direction.
         [[nodiscard]] std::chrono::milliseconds getTimeSinceLastActivity() const;
 
+        /// @brief Time of the last recorded activity in either direction.
+        [[nodiscard]] std::chrono::steady_clock::time_point getLastActivityTime() const
+        {
+            return std::max(m_lastSendTime, m_lastReceiveTime);
+        }
+
+        /// @brief End of the last tick that sent a packet; the keepalive only pings once this is a full interval old.
+        [[nodiscard]] std::chrono::steady_clock::time_point getLastSendTime() const
+        {
+            return m_lastSendTime;
+        }
+
+        /// @brief End of the last tick that received a packet; anything from the broker shows the link is alive.
+        [[nodiscard]] std::chrono::steady_clock::time_point getLastReceiveTime() const
+        {
+            return m_lastReceiveTime;
+        }
+
         /// @brief Whether a PINGREQ is currently pending.
         [[nodiscard]] bool isPingPending() const
         {
@@ -286,29 +980,119 @@ namespace reactormq::mqtt::client
             m_pingPending = pending;
         }
 
-        /// @brief Record when a QoS 1/2 publish was sent (for timeout tracking).
+        /**
+         * @brief Mark a PINGREQ as pending from the given time.
+         * @param sentAt When the PINGREQ was queued; its PINGRESP timeout counts from here.
+         */
+        void recordPingSent(const std::chrono::steady_clock::time_point sentAt)
+        {
+            m_pingPending = true;
+            m_pingSentTime = sentAt;
+        }
+
+        /// @brief When the pending PINGREQ was queued.
+        [[nodiscard]] std::chrono::steady_clock::time_point getPingSentTime() const
+        {
+            return m_pingSentTime;
+        }
+
+        /// @brief Time the pending PINGREQ's round trip, now that its PINGRESP has arrived.
+        void recordPingResponse();
+
+        /**
+         * @brief Time a publish's round trip, now that the PUBACK or PUBREC answering its PUBLISH has arrived.
+         * Publishes resent on the same connection are not timed.
+         * @param packetId Packet ID of the publish.
+         */
+        void recordPublishResponse(std::uint16_t packetId);
+
+        /// @brief Smoothed round-trip time to the broker, from PINGREQ and QoS 1/2 PUBLISH exchanges.
+        [[nodiscard]] const RttEstimator& getRttEstimator() const
+        {
+            return m_rttEstimator;
+        }
+
+        /**
+         * @brief How long a PINGREQ waits for its PINGRESP before the connection is taken as dead: one and a half
+         * keepalive intervals, or with adaptive timeouts the retransmit timeout of the measured round-trip time when
+         * that is shorter.
+         * @param keepalive Keepalive interval.
+         */
+        [[nodiscard]] std::chrono::milliseconds getPingTimeout(std::chrono::milliseconds keepalive) const;
+
+        /// @brief Record when a QoS 1/2 publish was sent and schedule its first PublishTimeout (retry) timer.
         void recordPublishSent(std::uint16_t packetId);
 
+        /**
+         * @brief Service an expired PublishTimeout timer: retransmit the publish and schedule the next retry, with
+         * the interval growing by the packet retry backoff multiplier up to the maximum retry interval.
+         * MQTT 5 forbids resending while connected, so there the timer only waits out the same schedule.
+         * @param packetId Packet ID of the publish.
+         * @return False when the publish is unknown or has used up its retries; the caller then fails it.
+         */
+        bool retryPendingPublish(std::uint16_t packetId);
+
+        /**
+         * @brief Wait before a publish retry is due: the packet retry interval times the backoff multiplier per
+         * earlier retry, capped at the maximum packet retry interval. With adaptive timeouts the retransmit timeout of
+         * the measured round-trip time replaces the packet retry interval once there is one.
+         * @param retryCount Retries already made.
+         */
+        [[nodiscard]] std::chrono::milliseconds getPublishRetryInterval(std::uint8_t retryCount) const;
+
         /// @brief Elapsed time since a publish was sent, or 0 if unknown.
         [[nodiscard]] std::chrono::milliseconds getPublishElapsedTime(std::uint16_t packetId) const;
 
         /// @brief Clear timeout tracking for a publish.
         void clearPublishTimeout(std::uint16_t packetId);
 
+        /// @brief Reactor-owned deadlines (keepalive, timeouts, retry backoff); fired by Reactor::tick().
+        [[nodiscard]] TimerQueue& getTimers()
+        {
+            return m_timers;
+        }
+
+        /// @brief Reactor-owned deadlines (read-only).
+        [[nodiscard]] const TimerQueue& getTimers() const
+        {
+            return m_timers;
+        }
+
         void encodePublishForCurrentVersion(Message const& message, std::uint16_t packetId, serialize::ByteWriter& writer) const;
 
-        /// @brief Retransmit pending QoS 1/2 publishes with DUP set (on reconnect).
+        /**
+         * @brief Resume outbound QoS 1/2 exchanges on a new connection, according to CONNACK's Session Present flag.
+         *
+         * With the session present each exchange picks up where it stopped, with its original packet ID: a PUBLISH
+         * with DUP set from its cached header, or the PUBREL of a QoS 2 publish the broker already answered with PUBREC.
+         * Without it, those PUBREC'd publishes succeed, since the broker has taken them and kept nothing to complete,
+         * and every other publish is sent again. All of it goes out in one vectored send; streamed publishes whose
+         * source cannot be rewound fail instead.
+         */
         void retransmitPendingPublishes();
 
-        std::vector<std::byte> encodePendingPublish(PublishCommand const& publishCmd, std::uint16_t packetId) const;
+        /**
+         * @brief Deliver the inbound QoS 2 messages held for a PUBREL, and forget their packet IDs, when the broker kept
+         * no session and so will never send that PUBREL. Nothing is acknowledged.
+         */
+        void releaseHeldIncomingQos2Messages();
+
+        /// @brief Encode the PUBLISH header a retransmit is sent with: DUP set, full topic, no topic alias.
+        [[nodiscard]] std::vector<std::byte> encodeRetransmitHeader(const InFlightPacket& inFlight, std::uint16_t packetId) const;
+
+        /**
+         * @brief Send a pending publish with DUP set, encoding its header only if it was not kept from the first send.
+         * @return False if the publish is streamed and its source could not be rewound and read again.
+         */
+        bool sendRetransmit(InFlightPacket& inFlight, std::uint16_t packetId);
+
+        /// @brief Append the header and payload buffers of a pending, not streamed, publish's retransmit to buffers.
+        void appendRetransmit(InFlightPacket& inFlight, std::uint16_t packetId, std::vector<socket::SendBuffer>& buffers);
 
         /// @brief encode packet to publish to the socket
         template<typename VersionTag, typename Message>
         void encodePublish(Message const& message, std::uint16_t packetId, serialize::ByteWriter& writer) const;
 
-        /// @brief send packet to the socket
-        void sendEncodedPublish(std::vector<std::byte> const& buffer) const;
-
         /// @brief Track an incoming QoS 1/2 packet ID; returns false if duplicate.
         bool trackIncomingPacketId(std::uint16_t packetId);
 
@@ -364,21 +1148,41 @@ namespace reactormq::mqtt::client
         }
 
     private:
+        /// @brief Take and remove an in-flight command of the given kind; nullopt if the ID holds another kind.
+        template<typename TCommand>
+        std::optional<TCommand> takeInFlight(std::uint16_t packetId);
+
+        /// @brief Reserve the in-flight tables, packet IDs, subscription table and outbound batches for FixedCapacityOptions.
+        void reserveFixedCapacity();
+
+        /// @brief Load the session store's outbound publishes and inbound QoS 2 messages into the in-flight state.
+        void restoreSession();
+
         socket::SocketPtr m_socket;
 
-        ConnectionSettingsPtr m_settings;
+        const ConnectionSettingsPtr m_settings;
+
+        /// @brief Persistent copy of the QoS 1/2 state, from the settings; nullptr keeps it in memory only.
+        SessionStorePtr m_sessionStore;
 
-        packets::ProtocolVersion m_protocolVersion = packets::ProtocolVersion::V5;
+        packets::ProtocolVersion m_protocolVersion = kFixedProtocolVersion;
 
         std::string m_assignedClientId;
 
-        std::uint16_t m_nextPacketId = 1;
+        /// @brief Outgoing packet IDs in use; only touched on the reactor thread, so it needs no lock.
+        PacketIdPool m_packetIds;
 
-        mutable std::mutex packetIdMutex;
+        size_t m_outboundQueueSize = 0;
+        ClientMetricCounters m_metrics;
 
-        std::unordered_set<std::uint16_t> m_packetIdsInUse;
+        /// @brief Set when the settings enable tick profiling.
+        std::unique_ptr<TickProfiler> m_tickProfiler;
 
-        size_t m_outboundQueueSize = 0;
+        /// @brief Set when the settings enable traffic accounting.
+        std::unique_ptr<TrafficAccounting> m_trafficAccounting;
+
+        /// @brief Callbacks held for the next flushCallbacks(), in the order they were produced.
+        std::vector<std::function<void()>> m_batchedCallbacks;
 
         OnConnect m_onConnect;
         OnDisconnect m_onDisconnect;
@@ -386,27 +1190,214 @@ namespace reactormq::mqtt::client
         OnSubscribe m_onSubscribe;
         OnUnsubscribe m_onUnsubscribe;
         OnMessage m_onMessage;
+        OnMessageView m_onMessageView;
         OnSocketReplaced m_onSocketReplaced;
 
-        std::unordered_map<std::uint16_t, PublishCommand> m_pendingPublishes; ///< Map for tracking pending publishes
-        std::unordered_map<std::uint16_t, SubscribeCommand> m_pendingSubscribes;
-        ///< Map for tracking pending subscribes
-        std::unordered_map<std::uint16_t, SubscribesCommand> m_pendingSubscribesMulti;
-        ///< Map for tracking pending multi-topic subscribes
-        std::unordered_map<std::uint16_t, UnsubscribesCommand> m_pendingUnsubscribes;
-        ///< Map for tracking pending unsubscribes
+        /// @brief Publishes, subscribes and unsubscribes awaiting their acknowledgement, by packet ID.
+        PacketIdSlotMap<InFlightPacket> m_inFlight;
 
-        /// @brief Map for tracking incoming QoS 2 messages that have been PUBREC'd and are awaiting PUBREL.
-        std::unordered_map<std::uint16_t, Message> m_pendingIncomingQos2Messages;
+        /// @brief Number of PublishCommand entries in m_inFlight.
+        size_t m_pendingPublishCount = 0;
 
-        std::chrono::steady_clock::time_point m_lastActivityTime = std::chrono::steady_clock::now();
+        /// @brief QoS 1/2 publishes waiting for send quota, oldest first; packet IDs are allocated when they are sent.
+        std::deque<PublishCommand> m_heldPublishes;
+
+        /// @brief Broker's Receive Maximum: cap on unacknowledged QoS 1/2 publishes.
+        std::uint16_t m_receiveMaximum = 65535;
+
+        /// @brief Broker's Maximum Packet Size; the protocol limit (Remaining Length cap plus the fixed header) until known.
+        std::uint32_t m_brokerMaximumPacketSize = 268435460;
+
+        /// @brief Whether the broker accepts Subscription Identifiers on the current connection.
+        bool m_subscriptionIdentifiersAvailable = false;
+
+        /// @brief Session Present flag of the current connection's CONNACK.
+        bool m_isSessionPresent = false;
+
+        /// @brief Start of the current tick; the construction time until the first one.
+        std::chrono::steady_clock::time_point m_now = std::chrono::steady_clock::now();
+
+        std::chrono::steady_clock::time_point m_lastSendTime = m_now;
+        std::chrono::steady_clock::time_point m_lastReceiveTime = m_lastSendTime;
+        std::chrono::steady_clock::time_point m_pingSentTime{};
+
+        /// @brief Socket packet totals seen by the last recordTraffic().
+        std::uint64_t m_packetsSentSeen = 0;
+        std::uint64_t m_packetsReceivedSeen = 0;
 
         bool m_pingPending = false;
 
-        /// @brief Map tracking sent times for QoS 1/2 publish operations (for timeout detection).
-        std::unordered_map<std::uint16_t, std::chrono::steady_clock::time_point> m_publishSentTimes;
+        /// @brief Round-trip time to the broker; kept across reconnects, as the route to it usually stays the same.
+        RttEstimator m_rttEstimator;
+
+        /// @brief Deadlines for the current state and for in-flight QoS 1/2 publishes.
+        TimerQueue m_timers;
+
+        /**
+         * @brief Incoming packet IDs currently being tracked (for duplicate detection), by the broker's packet ID.
+         * QoS 2 entries hold the message between PUBREC and PUBREL.
+         */
+        PacketIdSlotMap<std::optional<Message>> m_incomingPackets;
+
+        /// @brief QoS 2 messages delivered on PUBLISH and awaiting PUBREL, when ConnectionSettings asks for that flow.
+        PacketIdBitmap m_deliveredQos2PacketIds;
+
+        /// @brief Backs packets returned by parsePacket(); mutable because parsing does not change client state.
+        mutable PacketArena m_packetArena;
+
+        /// @brief Time of the current tick once read; mutable because reading it does not change client state.
+        mutable std::optional<Message::Clock::time_point> m_tickTimeUtc;
+
+        /// @brief Topic aliases assigned to outgoing PUBLISH topics; reset on every CONNACK.
+        TopicAliasManager m_topicAliases;
+
+        /// @brief Inbound topic aliases; sized to the advertised Topic Alias Maximum whenever CONNECT is sent.
+        InboundTopicAliases m_inboundTopicAliases;
+
+        /// @brief Pre-encoded PUBLISH headers of the topics published to.
+        PublishTemplates m_publishTemplates;
+
+        /// @brief CONNECT of the last connection attempt, reused while what goes into it is unchanged.
+        ConnectPacketCache m_connectPacket;
+
+        /// @brief Last payload hash sent per topic; null unless ConnectionSettings::getPublishDedup() is enabled.
+        std::unique_ptr<PublishDeduplicator> m_publishDeduplicator;
+
+        /// @brief Outbound rate limits; null unless ConnectionSettings::getPublishRateLimits() has any.
+        std::unique_ptr<PublishRateLimiter> m_publishRateLimiter;
+
+        /// @brief PUBLISHes waiting for the current batch to be written; its capacity is reused from tick to tick.
+        packets::PacketBatch m_outboundBatch;
+
+        /// @brief Regions of m_outboundBatch handed to the socket; kept to reuse its capacity.
+        std::vector<socket::SendBuffer> m_outboundSendBuffers;
+
+        /// @brief Set between beginOutboundBatch() and endOutboundBatch().
+        bool m_isBatchingOutbound = false;
+
+        /// @brief Acknowledgements gathered by completeDeliveries(); kept to reuse its capacity.
+        packets::PacketBatch m_ackBatch;
+
+        /// @brief Handlers of subscriptions made with subscribeAsync(filter, handler).
+        TopicRouter m_topicRouter;
+
+        /// @brief Sinks of subscriptions made with subscribeAsync(filter, sink, onComplete).
+        PayloadSinks m_payloadSinks;
+
+        /// @brief Sinks of subscriptions made with subscribeChunked().
+        ChunkAssemblers m_chunkAssemblers;
+
+        /// @brief Delivery priorities of the subscriptions that have one, and the messages waiting for budget.
+        InboundScheduler m_inboundScheduler;
+
+        /// @brief Handlers of subscriptions made with HandlerDelivery::LatestPerTopic; also routed by m_topicRouter.
+        ConflatedHandlers m_conflatedHandlers;
+
+        /// @brief Latest message per topic; null unless ConnectionSettings::getLastValueCacheSize() is set.
+        std::unique_ptr<LastValueCache> m_lastValues;
+
+        /// @brief Granted subscriptions, kept across connections.
+        SubscriptionCache m_subscriptionCache;
+
+        /// @brief Requests waiting for their response, by correlation ID.
+        RequestTable m_requests;
+
+        /// @brief Topic responses come back on; empty until the first request.
+        std::string m_responseTopic;
+
+        /// @brief Set once the response topic's SUBSCRIBE has gone out, and cleared when a reconnect finds no session.
+        bool m_isResponseTopicSubscribed = false;
+
+        /// @brief Progress through the PUBLISH arriving in fragments.
+        InboundStream m_inboundStream;
+
+        /// @brief Inbound topics shared by the messages delivered on them; sized by getMaxInternedTopics().
+        TopicInternTable m_topicInterns;
+
+        /// @brief Payload codecs configured in the settings.
+        PayloadCodecs m_payloadCodecs;
+
+        /// @brief Publishes made while not connected; bounded by the offline queue settings.
+        OfflinePublishQueue m_offlinePublishes;
+
+        /// @brief The host and its failover endpoints.
+        EndpointSelector m_endpoints;
+
+        /// @brief Warm standby to a failover node; closed unless the settings enable it.
+        StandbyConnection m_standby;
+
+        /// @brief Reconnect delays from the settings' initial and maximum delay, multiplier and jitter.
+        BackoffCalculator m_reconnectBackoff;
+
+        /// @brief Raised when a provider call completes off the reactor thread.
+        std::shared_ptr<AsyncSignal> m_asyncSignal = std::make_shared<AsyncSignal>();
+
+        /// @brief An acknowledgement ready to send, with the connection its message arrived on.
+        struct DeliveredAck
+        {
+            std::uint16_t packetId = 0;
+            packets::PacketType type = packets::PacketType::PubAck;
+            std::uint32_t connection = 0;
+        };
+
+        /// @brief Acknowledgements ready to send and the wakeup that reports them; shared with AckTokens, which may
+        /// outlive the context.
+        struct DeliveredAcks
+        {
+            MpscQueue<DeliveredAck> queue;
+            std::shared_ptr<WakeupRoute> wakeup;
+
+            void push(const DeliveredAck& ack)
+            {
+                queue.push(ack);
+                if (wakeup)
+                {
+                    wakeup->signal();
+                }
+            }
+        };
+
+        /// @brief Routed handlers for a topic, looked up by identity when it is interned.
+        [[nodiscard]] std::shared_ptr<const TopicRouter::HandlerList> matchTopic(std::string_view topic, const SharedTopic& interned);
+
+        /// @brief Queue the conflated handlers among the routed ones, or refresh the message their queued calls deliver.
+        /// @return The handlers left to call with every message; nullptr when none are left.
+        [[nodiscard]] std::shared_ptr<const TopicRouter::HandlerList> conflate(
+            const Message& message, std::shared_ptr<const TopicRouter::HandlerList> routed, size_t laneKey);
+
+        /// @brief Hand a message to its handlers now; deliverMessage() without the InboundScheduler.
+        bool deliverNow(
+            Message message,
+            std::span<const std::uint32_t> subscriptionIdentifiers,
+            std::uint16_t ackPacketId,
+            packets::PacketType ackType);
+
+        /// @brief Whether a delivery counts against the pending-delivery bounds: they are set and handlers run off the reactor thread.
+        [[nodiscard]] bool isDeliveryBounded() const;
+
+        /// @brief Whether the pending deliveries have reached either bound.
+        [[nodiscard]] bool isDeliveryQueueFull() const;
+
+        /// @brief Account for a finished delivery and wake the reactor if it has work to do; called on the handler's thread.
+        void finishDelivery(const DeliveredAck& ack, size_t bytes);
+
+        /// @brief Token that queues ack when the application acknowledges the message.
+        [[nodiscard]] AckToken makeAckToken(const DeliveredAck& ack) const;
+
+        /// @brief Count of deliveries made under the bounds that have not finished; written from handler threads.
+        std::atomic<size_t> m_pendingDeliveries{ 0 };
+
+        /// @brief Topic and payload bytes of those deliveries.
+        std::atomic<size_t> m_pendingDeliveryBytes{ 0 };
+
+        /// @brief Pushed by handler threads and AckTokens, drained by completeDeliveries().
+        std::shared_ptr<DeliveredAcks> m_deliveredAcks = std::make_shared<DeliveredAcks>();
+
+        /// @brief Bumped by abandonDeferredAcks(), so acknowledgements made after their connection closed are dropped.
+        std::uint32_t m_deliveryConnection = 0;
 
-        /// @brief Set of incoming packet IDs currently being tracked (for duplicate detection).
-        std::unordered_set<std::uint16_t> m_incomingPacketIds;
+        /// @brief Lanes running message handlers when enabled in the settings; declared last so its destructor runs the
+        /// handlers still queued while everything they touch is alive.
+        std::unique_ptr<MessageDispatcher> m_messageDispatcher;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -0,0 +1,263 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/broker_endpoint.h"
+#include "reactormq/mqtt/connection_settings.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Picks the broker node each connection attempt goes to, from the host and its failover endpoints.
+     *
+     * A node that fails to connect, or drops a connection that was not closed on purpose, is not picked again until
+     * a cooldown that doubles with each consecutive failure (the reconnect delays from the settings) has passed,
+     * as long as another node is available. Among available nodes, fewer recent failures win, then a heavier weight,
+     * then a lower connect latency when both have one, then the order they were configured in. A client without
+     * failover endpoints always gets its own settings back, and failures are not tracked.
+     */
+    class EndpointSelector final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief What the selector knows about one node.
+        struct Health
+        {
+            std::uint32_t consecutiveFailures = 0; ///< Failures since the last successful connect.
+            Clock::time_point retryAfter{}; ///< Not picked before this while another node is available.
+            std::uint32_t connectLatencyMs = 0; ///< Smoothed time from starting an attempt to CONNACK; 0 until known.
+        };
+
+        /**
+         * @brief Build the node list from the settings.
+         * @param settings Connection settings; may be null, in which case beginAttempt() returns null.
+         */
+        explicit EndpointSelector(const ConnectionSettingsPtr& settings)
+        {
+            if (!settings)
+            {
+                return;
+            }
+
+            m_initialCooldownMs = std::max<std::uint32_t>(settings->getAutoReconnectInitialDelayMs(), 1);
+            m_maxCooldownMs = std::max(settings->getAutoReconnectMaxDelayMs(), m_initialCooldownMs);
+
+            m_endpoints.push_back(Endpoint{ settings, 1 });
+            for (const BrokerEndpoint& endpoint : settings->getFailoverEndpoints())
+            {
+                m_endpoints.push_back(Endpoint{ settings->withEndpoint(endpoint), endpoint.weight });
+            }
+            m_health.resize(m_endpoints.size());
+        }
+
+        /// @brief Number of nodes, the host included.
+        [[nodiscard]] size_t getEndpointCount() const
+        {
+            return m_endpoints.size();
+        }
+
+        /// @brief Node of the attempt or connection in progress, if any.
+        [[nodiscard]] std::optional<size_t> getCurrentIndex() const
+        {
+            return m_current;
+        }
+
+        [[nodiscard]] const Health& getHealth(const size_t index) const
+        {
+            return m_health[index];
+        }
+
+        /// @brief Cooldown after a node's first failure: the initial reconnect delay.
+        [[nodiscard]] std::chrono::milliseconds getInitialCooldown() const
+        {
+            return std::chrono::milliseconds(m_initialCooldownMs);
+        }
+
+        /**
+         * @brief Pick the node for a new connection attempt.
+         * @param now Current time.
+         * @return Settings to create the socket with: the client's own for the host, a copy for any other node.
+         */
+        [[nodiscard]] ConnectionSettingsPtr beginAttempt(const Clock::time_point now)
+        {
+            if (m_endpoints.empty())
+            {
+                return nullptr;
+            }
+
+            m_current = m_endpoints.size() == 1 ? 0 : pick(now);
+            m_attemptStart = now;
+            return m_endpoints[*m_current].settings;
+        }
+
+        /**
+         * @brief Start an attempt on a given node, as when a standby connection to it is promoted.
+         * @param index Node to connect to.
+         * @param startedAt When the attempt counts as started, for the connect latency.
+         */
+        void beginAttempt(const size_t index, const Clock::time_point startedAt)
+        {
+            m_current = index;
+            m_attemptStart = startedAt;
+        }
+
+        /// @brief Settings to create a socket to a node with.
+        [[nodiscard]] const ConnectionSettingsPtr& getSettings(const size_t index) const
+        {
+            return m_endpoints[index].settings;
+        }
+
+        /**
+         * @brief Pick the node a standby connection should go to: the best available one that is not in use.
+         * @param now Current time.
+         * @return Node index; empty without failover endpoints or when every other node is cooling down.
+         */
+        [[nodiscard]] std::optional<size_t> pickStandby(const Clock::time_point now) const
+        {
+            if (m_endpoints.size() < 2)
+            {
+                return std::nullopt;
+            }
+            return findAvailable(now, m_current);
+        }
+
+        /**
+         * @brief The broker accepted the connection; clears the node's failures and updates its latency.
+         * @param now Current time.
+         */
+        void recordConnected(const Clock::time_point now)
+        {
+            if (!m_current)
+            {
+                return;
+            }
+
+            Health& health = m_health[*m_current];
+            const auto latencyMs
+                = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_attemptStart).count());
+            // Weight the newest sample by a quarter so one slow handshake does not reorder the nodes.
+            health.connectLatencyMs = health.connectLatencyMs == 0 ? std::max<std::uint32_t>(latencyMs, 1)
+                                                                   : (health.connectLatencyMs * 3 + latencyMs) / 4;
+            health.consecutiveFailures = 0;
+            health.retryAfter = Clock::time_point{};
+        }
+
+        /**
+         * @brief The attempt or connection in progress failed; its node cools down.
+         * @param now Current time.
+         * @return True if another node can be tried straight away.
+         */
+        bool recordFailure(const Clock::time_point now)
+        {
+            if (!m_current || m_endpoints.size() == 1)
+            {
+                m_current.reset();
+                return false;
+            }
+
+            coolDown(*m_current, now);
+            m_current.reset();
+
+            return std::any_of(m_health.begin(), m_health.end(), [now](const Health& other) { return other.retryAfter <= now; });
+        }
+
+        /**
+         * @brief A standby connection to a node that is not in use failed to connect; the node cools down.
+         * @param index Node the standby went to.
+         * @param now Current time.
+         */
+        void recordStandbyFailure(const size_t index, const Clock::time_point now)
+        {
+            if (index < m_health.size())
+            {
+                coolDown(index, now);
+            }
+        }
+
+        /// @brief The connection was closed on purpose; the node keeps its health.
+        void endConnection()
+        {
+            m_current.reset();
+        }
+
+    private:
+        struct Endpoint
+        {
+            ConnectionSettingsPtr settings;
+            std::uint32_t weight = 1;
+        };
+
+        [[nodiscard]] bool isPreferred(const size_t candidate, const size_t best) const
+        {
+            const Health& a = m_health[candidate];
+            const Health& b = m_health[best];
+            if (a.consecutiveFailures != b.consecutiveFailures)
+            {
+                return a.consecutiveFailures < b.consecutiveFailures;
+            }
+            if (m_endpoints[candidate].weight != m_endpoints[best].weight)
+            {
+                return m_endpoints[candidate].weight > m_endpoints[best].weight;
+            }
+            return a.connectLatencyMs != 0 && b.connectLatencyMs != 0 && a.connectLatencyMs < b.connectLatencyMs;
+        }
+
+        void coolDown(const size_t index, const Clock::time_point now)
+        {
+            Health& health = m_health[index];
+            ++health.consecutiveFailures;
+            const std::uint32_t shift = std::min<std::uint32_t>(health.consecutiveFailures - 1, 16);
+            const std::uint64_t cooldownMs = std::min<std::uint64_t>(std::uint64_t{ m_initialCooldownMs } << shift, m_maxCooldownMs);
+            health.retryAfter = now + std::chrono::milliseconds(cooldownMs);
+        }
+
+        [[nodiscard]] std::optional<size_t> findAvailable(const Clock::time_point now, const std::optional<size_t> excluded) const
+        {
+            std::optional<size_t> best;
+            for (size_t index = 0; index < m_endpoints.size(); ++index)
+            {
+                if (index != excluded && m_health[index].retryAfter <= now && (!best || isPreferred(index, *best)))
+                {
+                    best = index;
+                }
+            }
+            return best;
+        }
+
+        [[nodiscard]] size_t pick(const Clock::time_point now) const
+        {
+            if (const auto best = findAvailable(now, std::nullopt))
+            {
+                return *best;
+            }
+
+            // Every node is cooling down: take the one that is ready soonest.
+            size_t soonest = 0;
+            for (size_t index = 1; index < m_endpoints.size(); ++index)
+            {
+                if (m_health[index].retryAfter < m_health[soonest].retryAfter)
+                {
+                    soonest = index;
+                }
+            }
+            return soonest;
+        }
+
+        std::vector<Endpoint> m_endpoints;
+        std::vector<Health> m_health;
+        std::optional<size_t> m_current;
+        Clock::time_point m_attemptStart{};
+        std::uint32_t m_initialCooldownMs = 1;
+        std::uint32_t m_maxCooldownMs = 1;
+    };
+} // namespace reactormq::mqtt::client
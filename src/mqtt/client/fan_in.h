@@ -0,0 +1,65 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/completion_handler.h"
+#include "reactormq/mqtt/result.h"
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /// @brief Reports an operation split across connections once every part has completed, failing if any did.
+    class FanIn final
+    {
+    public:
+        FanIn(const size_t parts, CompletionHandler<void> onComplete)
+            : m_onComplete(std::move(onComplete))
+            , m_remaining(parts)
+        {
+        }
+
+        void complete(const Result<void>& result)
+        {
+            if (!result.hasSucceeded())
+            {
+                m_failed.store(true, std::memory_order_relaxed);
+            }
+
+            if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1 || !m_onComplete)
+            {
+                return;
+            }
+
+            m_onComplete(
+                m_failed.load(std::memory_order_relaxed) ? Result<void>::failure(ResultError::PartialFailure, "a shard failed")
+                                                         : Result<void>::success());
+        }
+
+    private:
+        CompletionHandler<void> m_onComplete;
+        std::atomic<size_t> m_remaining;
+        std::atomic<bool> m_failed{ false };
+    };
+
+    [[nodiscard]] inline CompletionHandler<void> joinFanIn(const std::shared_ptr<FanIn>& fanIn)
+    {
+        return [fanIn](const Result<void>& result) { fanIn->complete(result); };
+    }
+
+    /// @brief Run a callback-style operation and return a future of its result.
+    template<typename Start>
+    [[nodiscard]] std::future<Result<void>> makeFuture(Start start)
+    {
+        auto promise = std::make_shared<std::promise<Result<void>>>();
+        auto future = promise->get_future();
+        start([promise](const Result<void>& result) { promise->set_value(result); });
+        return future;
+    }
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,188 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/payload_codecs.h"
+#include "mqtt/client/topic_router.h"
+#include "mqtt/packets/packet_type.h"
+#include "reactormq/mqtt/message.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Orders inbound deliveries by the delivery priority of the subscriptions they match, within the per-tick
+     * inbound packet budget.
+     *
+     * While any filter has a priority, the socket reads every complete packet and the budget counts deliveries
+     * instead. A message is delivered at once while the tick has budget left and no message of the same or a higher
+     * priority is waiting; otherwise it waits here, and the reactor delivers the waiting messages highest priority
+     * first, oldest first within a priority, as budget frees up. A topic's messages all have one priority, so they
+     * stay in order. Not thread-safe; it belongs to the reactor thread.
+     */
+    class InboundScheduler final
+    {
+    public:
+        /// Reading pauses once this many ticks' budget of messages is waiting.
+        static constexpr size_t kMaxWaitingTicks = 64;
+
+        /// @brief A message waiting for budget, with the acknowledgement it owes once delivered.
+        struct Deferred
+        {
+            Message message;
+            std::vector<std::uint32_t> subscriptionIdentifiers;
+            std::uint16_t ackPacketId = 0;
+            packets::PacketType ackType = packets::PacketType::PubAck;
+            /// Connection the message arrived on; its acknowledgement is dropped once that connection has closed.
+            std::uint32_t connection = 0;
+        };
+
+        /**
+         * @brief Set the delivery priority of a subscribed filter.
+         * @param filter Topic filter, with '+' and '#' wildcards.
+         * @param priority Priority; 0 removes the filter, as when it is unsubscribed.
+         */
+        void setPriority(const std::string_view filter, const std::uint8_t priority)
+        {
+            const auto it = std::ranges::find(m_priorities, filter, &Entry::first);
+            if (priority == 0)
+            {
+                if (it != m_priorities.end())
+                {
+                    m_priorities.erase(it);
+                }
+            }
+            else if (it != m_priorities.end())
+            {
+                it->second = priority;
+            }
+            else
+            {
+                m_priorities.emplace_back(std::string(filter), priority);
+            }
+        }
+
+        /// @brief Whether any subscription has a priority, so deliveries are scheduled.
+        [[nodiscard]] bool isEnabled() const
+        {
+            return !m_priorities.empty();
+        }
+
+        /**
+         * @brief Priority of a topic.
+         * @param topic Topic name of a received message.
+         * @return The highest priority of the filters matching it; 0 when none does.
+         */
+        [[nodiscard]] std::uint8_t getPriority(const std::string_view topic) const
+        {
+            std::uint8_t priority = 0;
+            for (const auto& [filter, filterPriority] : m_priorities)
+            {
+                if (filterPriority > priority && PayloadCodecs::matchesFilter(TopicRouter::stripSharePrefix(filter), topic))
+                {
+                    priority = filterPriority;
+                }
+            }
+            return priority;
+        }
+
+        /**
+         * @brief Set the budget, ConnectionSettings::getMaxInboundPacketsPerTick().
+         * @param budget Deliveries allowed per tick; 0 for no limit.
+         */
+        void setBudget(const std::uint32_t budget)
+        {
+            m_budget = budget;
+        }
+
+        /// @brief Start a new tick's budget.
+        void beginTick()
+        {
+            m_delivered = 0;
+        }
+
+        /**
+         * @brief Count a delivery against the tick's budget if it may go now.
+         * @param priority Priority of the message.
+         * @return True if the message should be delivered now; false if it should wait behind the others.
+         */
+        bool tryAdmit(const std::uint8_t priority)
+        {
+            if (hasBudget() && (m_waiting.empty() || m_waiting.begin()->first < priority))
+            {
+                ++m_delivered;
+                return true;
+            }
+            return false;
+        }
+
+        /// @brief Queue a message to deliver once budget frees up.
+        void defer(const std::uint8_t priority, Deferred deferred)
+        {
+            m_waiting[priority].push_back(std::move(deferred));
+            ++m_waitingCount;
+        }
+
+        /**
+         * @brief Take the next waiting message and count it against the tick's budget.
+         * @return The highest-priority waiting message, or nullopt when none is waiting or the budget is used up.
+         */
+        [[nodiscard]] std::optional<Deferred> takeNext()
+        {
+            if (m_waiting.empty() || !hasBudget())
+            {
+                return std::nullopt;
+            }
+
+            const auto it = m_waiting.begin();
+            Deferred next = std::move(it->second.front());
+            it->second.pop_front();
+            if (it->second.empty())
+            {
+                m_waiting.erase(it);
+            }
+            --m_waitingCount;
+            ++m_delivered;
+            return next;
+        }
+
+        /// @brief Number of messages waiting.
+        [[nodiscard]] size_t getWaitingCount() const
+        {
+            return m_waitingCount;
+        }
+
+        /// @brief Whether enough messages are waiting that reading should pause.
+        [[nodiscard]] bool isFull() const
+        {
+            return m_budget != 0 && m_waitingCount >= static_cast<size_t>(m_budget) * kMaxWaitingTicks;
+        }
+
+    private:
+        using Entry = std::pair<std::string, std::uint8_t>;
+
+        [[nodiscard]] bool hasBudget() const
+        {
+            return m_budget == 0 || m_delivered < m_budget;
+        }
+
+        std::vector<Entry> m_priorities;
+        std::map<std::uint8_t, std::deque<Deferred>, std::greater<>> m_waiting;
+        size_t m_waitingCount = 0;
+        std::uint32_t m_budget = 0;
+        std::uint32_t m_delivered = 0;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,71 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Topic aliases the broker has set for PUBLISH packets it sends to this client (MQTT 5).
+     *
+     * One slot per alias up to the Topic Alias Maximum advertised in CONNECT, sized once per connection. Each slot
+     * keeps its topic string, so an alias-only PUBLISH resolves with an index instead of a decode and an allocation,
+     * and re-setting an alias reuses the slot's storage. Not thread-safe; it belongs to the reactor thread.
+     */
+    class InboundTopicAliases final
+    {
+    public:
+        /**
+         * @brief Drop every alias and size the table for a new connection.
+         * @param maximum Topic Alias Maximum advertised in CONNECT; 0 means the broker may not use aliases.
+         */
+        void reset(const std::uint16_t maximum)
+        {
+            m_topics.assign(maximum, std::string{});
+        }
+
+        /// @brief Number of aliases the broker may use on this connection.
+        [[nodiscard]] std::uint16_t getMaximum() const
+        {
+            return static_cast<std::uint16_t>(m_topics.size());
+        }
+
+        /**
+         * @brief Resolve the topic of an inbound PUBLISH carrying a Topic Alias.
+         * A non-empty topic (re)binds the alias; an empty one is looked up.
+         * @param alias Topic Alias property of the packet (non-zero).
+         * @param topic Topic name of the packet, possibly empty.
+         * @return The topic, viewing the table's copy; std::nullopt if the alias is out of range or was never set,
+         * which is a protocol error.
+         */
+        [[nodiscard]] std::optional<std::string_view> resolve(const std::uint16_t alias, const std::string_view topic)
+        {
+            if (alias == 0 || alias > m_topics.size())
+            {
+                return std::nullopt;
+            }
+
+            std::string& slot = m_topics[alias - 1];
+            if (!topic.empty())
+            {
+                slot.assign(topic);
+            }
+            else if (slot.empty())
+            {
+                return std::nullopt;
+            }
+
+            return std::string_view{ slot };
+        }
+
+    private:
+        std::vector<std::string> m_topics;
+    };
+} // namespace reactormq::mqtt::client
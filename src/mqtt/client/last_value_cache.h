@@ -0,0 +1,109 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/atomic_shared_ptr.h"
+#include "reactormq/mqtt/message.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The latest message received on each topic, behind IClient::getLastValue().
+     *
+     * The reactor thread stores every delivered message; any thread reads without a mutex. Each topic has a fixed slot
+     * holding an immutable message that a store replaces whole, so a reader keeps the one it loaded for as long as it
+     * likes while newer ones arrive. The topic-to-slot index is republished as a new snapshot only when a topic is
+     * first seen. Once the cache holds its maximum, messages on new topics are not kept; the slots never move, so a
+     * reader racing a store cannot see a half-built value.
+     */
+    class LastValueCache final
+    {
+    public:
+        /**
+         * @brief Create a cache.
+         * @param maxTopics Most distinct topics kept.
+         */
+        explicit LastValueCache(const size_t maxTopics)
+            : m_maxTopics(maxTopics)
+            , m_slots(std::make_unique<AtomicSharedPtr<const Message>[]>(maxTopics))
+            , m_index(std::make_shared<const Index>())
+        {
+            m_published.store(m_index);
+        }
+
+        /**
+         * @brief Keep a message as its topic's latest value. Reactor thread only.
+         * @param message A delivered message.
+         */
+        void store(const Message& message)
+        {
+            const std::string_view topic = message.getTopic();
+            size_t slot = 0;
+            if (const auto it = m_index->find(topic); it != m_index->end())
+            {
+                slot = it->second;
+            }
+            else
+            {
+                if (m_index->size() >= m_maxTopics)
+                {
+                    return;
+                }
+
+                slot = m_index->size();
+                auto next = std::make_shared<Index>(*m_index);
+                next->emplace(std::string(topic), slot);
+                m_index = std::move(next);
+                m_published.store(m_index);
+            }
+
+            m_slots[slot].store(std::make_shared<const Message>(message));
+        }
+
+        /**
+         * @brief The latest message on a topic. Safe to call from any thread.
+         * @param topic Exact topic name; wildcards are not matched.
+         * @return The message, or nullptr if none was kept for the topic.
+         */
+        [[nodiscard]] std::shared_ptr<const Message> find(const std::string_view topic) const
+        {
+            const std::shared_ptr<const Index> index = m_published.load();
+            const auto it = index->find(topic);
+            return it != index->end() ? m_slots[it->second].load() : nullptr;
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        using Index = std::unordered_map<std::string, size_t, StringHash, std::equal_to<>>;
+
+        const size_t m_maxTopics;
+
+        /// One per topic, in the order the topics were first seen.
+        std::unique_ptr<AtomicSharedPtr<const Message>[]> m_slots;
+
+        /// The current index; reactor thread only.
+        std::shared_ptr<const Index> m_index;
+
+        /// The index readers load.
+        AtomicSharedPtr<const Index> m_published;
+    };
+} // namespace reactormq::mqtt::client
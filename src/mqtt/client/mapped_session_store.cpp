@@ -0,0 +1,455 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_PLATFORM_POSIX_FAMILY && !REACTORMQ_PLATFORM_WINDOWS_FAMILY
+
+#include "mapped_session_store.h"
+
+#include "util/logging/logging.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace reactormq::mqtt::client
+{
+    namespace
+    {
+        constexpr std::array<char, 8> kMagic{ 'R', 'M', 'Q', 'S', 'E', 'S', 'S', '1' };
+
+        /// @brief Magic and reserved bytes at the start of the file.
+        constexpr size_t kFileHeaderSize = 16;
+
+        /// @brief Body length and checksum in front of every record body.
+        constexpr size_t kRecordHeaderSize = 8;
+
+        /// @brief Type and packet ID, which every record body starts with.
+        constexpr size_t kRemoveBodySize = 3;
+
+        /// @brief Type, packet ID, flags and topic length, in front of an add record's topic and payload.
+        constexpr size_t kAddBodyPrefixSize = 6;
+
+        constexpr size_t kMinCapacity = 4096;
+
+        std::uint32_t checksum(const std::span<const std::byte> bytes)
+        {
+            // FNV-1a; it only has to catch a torn or stale tail, not an adversary.
+            std::uint32_t hash = 2166136261u;
+            for (const std::byte b : bytes)
+            {
+                hash = (hash ^ static_cast<std::uint32_t>(b)) * 16777619u;
+            }
+            return hash;
+        }
+
+        void putUint16(std::byte* out, const std::uint16_t value)
+        {
+            out[0] = static_cast<std::byte>(value & 0xFF);
+            out[1] = static_cast<std::byte>(value >> 8);
+        }
+
+        void putUint32(std::byte* out, const std::uint32_t value)
+        {
+            for (size_t i = 0; i < 4; ++i)
+            {
+                out[i] = static_cast<std::byte>(value >> (8 * i) & 0xFF);
+            }
+        }
+
+        std::uint16_t getUint16(const std::byte* in)
+        {
+            return static_cast<std::uint16_t>(static_cast<std::uint16_t>(in[0]) | static_cast<std::uint16_t>(in[1]) << 8);
+        }
+
+        std::uint32_t getUint32(const std::byte* in)
+        {
+            std::uint32_t value = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        size_t roundToPage(const size_t bytes)
+        {
+            const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return (std::max(bytes, kMinCapacity) + page - 1) / page * page;
+        }
+
+        /// @brief Write the file header and a record stream into a file descriptor.
+        bool writeAll(const int fd, const std::span<const std::byte> bytes)
+        {
+            size_t written = 0;
+            while (written < bytes.size())
+            {
+                const ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+                if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (n <= 0)
+                {
+                    return false;
+                }
+                written += static_cast<size_t>(n);
+            }
+            return true;
+        }
+    } // namespace
+
+    MappedSessionStore::MappedSessionStore(std::string path, const size_t capacityBytes)
+        : m_path(std::move(path))
+        , m_capacity(roundToPage(capacityBytes))
+    {
+        if (!open())
+        {
+            unmap();
+        }
+    }
+
+    MappedSessionStore::~MappedSessionStore()
+    {
+        commit();
+        unmap();
+    }
+
+    bool MappedSessionStore::open()
+    {
+        m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (m_fd < 0)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "Session store: cannot open %s (errno %d)", m_path.c_str(), errno);
+            return false;
+        }
+
+        struct stat info{};
+        if (fstat(m_fd, &info) != 0)
+        {
+            return false;
+        }
+
+        const auto fileSize = static_cast<size_t>(info.st_size);
+        if (!map(std::max(m_capacity, fileSize)))
+        {
+            return false;
+        }
+
+        if (fileSize >= kFileHeaderSize && std::memcmp(m_base, kMagic.data(), kMagic.size()) == 0)
+        {
+            m_writeOffset = replay();
+            REACTORMQ_LOG(
+                logging::LogLevel::Info,
+                "Session store: recovered %zu outbound and %zu inbound messages from %s",
+                m_outbound.size(),
+                m_inbound.size(),
+                m_path.c_str());
+        }
+        else
+        {
+            std::memset(m_base, 0, m_capacity);
+            std::memcpy(m_base, kMagic.data(), kMagic.size());
+            m_writeOffset = kFileHeaderSize;
+            if (msync(m_base, kFileHeaderSize, MS_SYNC) != 0)
+            {
+                return false;
+            }
+        }
+
+        m_syncedOffset = m_writeOffset;
+        return true;
+    }
+
+    bool MappedSessionStore::map(const size_t capacityBytes)
+    {
+        if (ftruncate(m_fd, static_cast<off_t>(capacityBytes)) != 0)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "Session store: cannot size %s to %zu bytes (errno %d)", m_path.c_str(), capacityBytes, errno);
+            return false;
+        }
+
+        void* base = mmap(nullptr, capacityBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (base == MAP_FAILED)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "Session store: cannot map %s (errno %d)", m_path.c_str(), errno);
+            return false;
+        }
+
+        m_base = static_cast<std::byte*>(base);
+        m_capacity = capacityBytes;
+        return true;
+    }
+
+    void MappedSessionStore::unmap()
+    {
+        if (nullptr != m_base)
+        {
+            munmap(m_base, m_capacity);
+            m_base = nullptr;
+        }
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    size_t MappedSessionStore::replay()
+    {
+        size_t offset = kFileHeaderSize;
+        while (offset + kRecordHeaderSize <= m_capacity)
+        {
+            const std::byte* record = m_base + offset;
+            const std::uint32_t bodySize = getUint32(record);
+            if (bodySize < kRemoveBodySize || bodySize > m_capacity - offset - kRecordHeaderSize)
+            {
+                break;
+            }
+
+            const std::span body(record + kRecordHeaderSize, bodySize);
+            if (checksum(body) != getUint32(record + 4))
+            {
+                break;
+            }
+
+            const auto type = static_cast<RecordType>(body[0]);
+            const std::uint16_t packetId = getUint16(body.data() + 1);
+            LiveMap& live = type == RecordType::AddOutbound || type == RecordType::RemoveOutbound ? m_outbound : m_inbound;
+            if (type == RecordType::AddOutbound || type == RecordType::AddInbound)
+            {
+                if (bodySize < kAddBodyPrefixSize)
+                {
+                    break;
+                }
+
+                const auto flags = static_cast<std::uint8_t>(body[3]);
+                const std::uint16_t topicSize = getUint16(body.data() + 4);
+                if (kAddBodyPrefixSize + topicSize > bodySize)
+                {
+                    break;
+                }
+
+                std::string topic(reinterpret_cast<const char*>(body.data() + kAddBodyPrefixSize), topicSize);
+                const auto payload = body.subspan(kAddBodyPrefixSize + topicSize);
+                live.erase(packetId);
+                live.tryEmplace(
+                    packetId,
+                    LiveEntry{ ++m_sequence,
+                               Message(
+                                   std::move(topic),
+                                   std::span(reinterpret_cast<const std::uint8_t*>(payload.data()), payload.size()),
+                                   (flags & 0x04) != 0,
+                                   static_cast<QualityOfService>(flags & 0x03)) });
+            }
+            else
+            {
+                live.erase(packetId);
+            }
+
+            offset += kRecordHeaderSize + bodySize;
+        }
+
+        // Clear a torn record so a shorter record appended over it cannot leave a readable remnant behind.
+        if (offset + kRecordHeaderSize <= m_capacity && getUint32(m_base + offset) != 0)
+        {
+            std::memset(m_base + offset, 0, m_capacity - offset);
+        }
+
+        return offset;
+    }
+
+    void MappedSessionStore::addOutboundPublish(const std::uint16_t packetId, const Message& message)
+    {
+        add(RecordType::AddOutbound, m_outbound, packetId, message);
+    }
+
+    void MappedSessionStore::removeOutboundPublish(const std::uint16_t packetId)
+    {
+        remove(RecordType::RemoveOutbound, m_outbound, packetId);
+    }
+
+    void MappedSessionStore::addInboundQos2(const std::uint16_t packetId, const Message& message)
+    {
+        add(RecordType::AddInbound, m_inbound, packetId, message);
+    }
+
+    void MappedSessionStore::removeInboundQos2(const std::uint16_t packetId)
+    {
+        remove(RecordType::RemoveInbound, m_inbound, packetId);
+    }
+
+    void MappedSessionStore::add(const RecordType type, LiveMap& live, const std::uint16_t packetId, const Message& message)
+    {
+        if (!isOpen())
+        {
+            return;
+        }
+
+        live.erase(packetId);
+        live.tryEmplace(packetId, LiveEntry{ ++m_sequence, message });
+        encodeAdd(m_scratch, type, packetId, message);
+        append(m_scratch);
+    }
+
+    void MappedSessionStore::remove(const RecordType type, LiveMap& live, const std::uint16_t packetId)
+    {
+        if (!isOpen() || !live.contains(packetId))
+        {
+            return;
+        }
+
+        live.erase(packetId);
+        std::array<std::byte, kRemoveBodySize> body{};
+        body[0] = static_cast<std::byte>(type);
+        putUint16(body.data() + 1, packetId);
+        append(body);
+    }
+
+    void MappedSessionStore::encodeAdd(std::vector<std::byte>& body, const RecordType type, const std::uint16_t packetId, const Message& message)
+    {
+        const std::string& topic = message.getTopic();
+        const auto payload = message.getPayloadView();
+        const auto topicSize = static_cast<std::uint16_t>(std::min<size_t>(topic.size(), 0xFFFF));
+
+        body.resize(kAddBodyPrefixSize + topicSize + payload.size());
+        body[0] = static_cast<std::byte>(type);
+        putUint16(body.data() + 1, packetId);
+        body[3] = static_cast<std::byte>(static_cast<std::uint8_t>(message.getQualityOfService()) | (message.shouldRetain() ? 0x04 : 0x00));
+        putUint16(body.data() + 4, topicSize);
+        std::memcpy(body.data() + kAddBodyPrefixSize, topic.data(), topicSize);
+        if (!payload.empty())
+        {
+            std::memcpy(body.data() + kAddBodyPrefixSize + topicSize, payload.data(), payload.size());
+        }
+    }
+
+    void MappedSessionStore::append(const std::span<const std::byte> body)
+    {
+        const size_t recordSize = kRecordHeaderSize + body.size();
+        if (m_writeOffset + recordSize > m_capacity && !compact(recordSize))
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "Session store: cannot make room in %s; closing it", m_path.c_str());
+            unmap();
+            return;
+        }
+
+        std::byte* record = m_base + m_writeOffset;
+        putUint32(record, static_cast<std::uint32_t>(body.size()));
+        putUint32(record + 4, checksum(body));
+        std::memcpy(record + kRecordHeaderSize, body.data(), body.size());
+        m_writeOffset += recordSize;
+    }
+
+    bool MappedSessionStore::compact(const size_t spareBytes)
+    {
+        std::vector<std::byte> log(kMagic.size());
+        std::memcpy(log.data(), kMagic.data(), kMagic.size());
+        log.resize(kFileHeaderSize);
+
+        const auto appendLive = [this, &log](const RecordType type, const LiveMap& live)
+        {
+            for (const StoredPublish& stored : load(live))
+            {
+                encodeAdd(m_scratch, type, stored.packetId, stored.message);
+                const size_t offset = log.size();
+                log.resize(offset + kRecordHeaderSize + m_scratch.size());
+                putUint32(log.data() + offset, static_cast<std::uint32_t>(m_scratch.size()));
+                putUint32(log.data() + offset + 4, checksum(m_scratch));
+                std::memcpy(log.data() + offset + kRecordHeaderSize, m_scratch.data(), m_scratch.size());
+            }
+        };
+        appendLive(RecordType::AddOutbound, m_outbound);
+        appendLive(RecordType::AddInbound, m_inbound);
+
+        // Leave the log at most half full after compacting, so a steady live set does not compact on every append.
+        const size_t capacity = roundToPage(std::max(m_capacity, 2 * (log.size() + spareBytes)));
+        const std::string tmpPath = m_path + ".tmp";
+        const int fd = ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        if (!writeAll(fd, log) || ftruncate(fd, static_cast<off_t>(capacity)) != 0 || fsync(fd) != 0
+            || std::rename(tmpPath.c_str(), m_path.c_str()) != 0)
+        {
+            ::close(fd);
+            ::unlink(tmpPath.c_str());
+            return false;
+        }
+
+        unmap();
+        m_fd = fd;
+        if (!map(capacity))
+        {
+            return false;
+        }
+
+        m_writeOffset = log.size();
+        m_syncedOffset = m_writeOffset;
+        return true;
+    }
+
+    void MappedSessionStore::commit()
+    {
+        if (!isOpen() || m_writeOffset == m_syncedOffset)
+        {
+            return;
+        }
+
+        const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t begin = m_syncedOffset / page * page;
+        if (msync(m_base + begin, m_writeOffset - begin, MS_SYNC) != 0)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "Session store: msync of %s failed (errno %d)", m_path.c_str(), errno);
+            return;
+        }
+
+        m_syncedOffset = m_writeOffset;
+    }
+
+    std::vector<StoredPublish> MappedSessionStore::loadOutboundPublishes() const
+    {
+        return load(m_outbound);
+    }
+
+    std::vector<StoredPublish> MappedSessionStore::loadInboundQos2() const
+    {
+        return load(m_inbound);
+    }
+
+    std::vector<StoredPublish> MappedSessionStore::load(const LiveMap& live)
+    {
+        std::vector<const LiveMap::Entry*> entries;
+        entries.reserve(live.size());
+        for (const auto& entry : live)
+        {
+            entries.push_back(&entry);
+        }
+
+        std::ranges::sort(
+            entries,
+            [](const LiveMap::Entry* lhs, const LiveMap::Entry* rhs)
+            {
+                return lhs->value.sequence < rhs->value.sequence;
+            });
+
+        std::vector<StoredPublish> stored;
+        stored.reserve(entries.size());
+        for (const LiveMap::Entry* entry : entries)
+        {
+            stored.push_back(StoredPublish{ entry->packetId, entry->value.message });
+        }
+        return stored;
+    }
+} // namespace reactormq::mqtt::client
+
+#endif // REACTORMQ_PLATFORM_POSIX_FAMILY && !REACTORMQ_PLATFORM_WINDOWS_FAMILY
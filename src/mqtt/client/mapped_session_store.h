@@ -0,0 +1,113 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/packet_id_slot_map.h"
+#include "reactormq/mqtt/session_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Session store backed by a memory-mapped, append-only log file.
+     *
+     * Every add and remove appends a checksummed record to the mapping, which is only a memory copy; commit() then
+     * msyncs the bytes appended since the last commit in one call, so a tick's worth of messages shares one sync.
+     * The live state is mirrored in memory. When the log is full it is compacted into a fresh file holding only the
+     * live records, which replaces the old one by rename. Recovery replays records up to the first one that is torn
+     * or fails its checksum. POSIX only. Not thread-safe; it belongs to the reactor thread.
+     */
+    class MappedSessionStore final : public ISessionStore
+    {
+    public:
+        /**
+         * @brief Open (or create) the log at a path and replay what it holds.
+         * @param path Log file path.
+         * @param capacityBytes Initial size of the mapping; it grows when the live state does not fit.
+         */
+        MappedSessionStore(std::string path, size_t capacityBytes);
+
+        ~MappedSessionStore() override;
+
+        MappedSessionStore(const MappedSessionStore&) = delete;
+        MappedSessionStore& operator=(const MappedSessionStore&) = delete;
+
+        /// @brief Whether the log is open and mapped; a store that failed to open records nothing.
+        [[nodiscard]] bool isOpen() const
+        {
+            return nullptr != m_base;
+        }
+
+        void addOutboundPublish(std::uint16_t packetId, const Message& message) override;
+
+        void removeOutboundPublish(std::uint16_t packetId) override;
+
+        void addInboundQos2(std::uint16_t packetId, const Message& message) override;
+
+        void removeInboundQos2(std::uint16_t packetId) override;
+
+        void commit() override;
+
+        [[nodiscard]] std::vector<StoredPublish> loadOutboundPublishes() const override;
+
+        [[nodiscard]] std::vector<StoredPublish> loadInboundQos2() const override;
+
+    private:
+        enum class RecordType : std::uint8_t
+        {
+            AddOutbound = 1,
+            RemoveOutbound = 2,
+            AddInbound = 3,
+            RemoveInbound = 4
+        };
+
+        struct LiveEntry
+        {
+            std::uint64_t sequence = 0;
+            Message message;
+        };
+
+        using LiveMap = PacketIdSlotMap<LiveEntry>;
+
+        [[nodiscard]] bool open();
+
+        [[nodiscard]] bool map(size_t capacityBytes);
+
+        void unmap();
+
+        /// @brief Replay the records of the mapping into the live maps; returns the offset after the last good one.
+        size_t replay();
+
+        void add(RecordType type, LiveMap& live, std::uint16_t packetId, const Message& message);
+
+        void remove(RecordType type, LiveMap& live, std::uint16_t packetId);
+
+        /// @brief Append an encoded record body, compacting or growing the log first if it does not fit.
+        void append(std::span<const std::byte> body);
+
+        /// @brief Rewrite the log with only the live records, sized to hold at least spareBytes more.
+        [[nodiscard]] bool compact(size_t spareBytes);
+
+        static void encodeAdd(std::vector<std::byte>& body, RecordType type, std::uint16_t packetId, const Message& message);
+
+        static std::vector<StoredPublish> load(const LiveMap& live);
+
+        std::string m_path;
+        int m_fd = -1;
+        std::byte* m_base = nullptr;
+        size_t m_capacity = 0;
+        size_t m_writeOffset = 0;
+        size_t m_syncedOffset = 0;
+        std::uint64_t m_sequence = 0;
+        LiveMap m_outbound;
+        LiveMap m_inbound;
+        std::vector<std::byte> m_scratch;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,78 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/message_dispatcher.h"
+
+#include "util/logging/logging.h"
+#include "util/trace/trace.h"
+
+#include <algorithm>
+
+namespace reactormq::mqtt::client
+{
+    MessageDispatcher::MessageDispatcher(const size_t laneCount)
+    {
+        const size_t count = std::max<size_t>(1, laneCount);
+        REACTORMQ_LOG(logging::LogLevel::Info, "MessageDispatcher::MessageDispatcher() starting %zu lane(s)", count);
+
+        m_lanes.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto lane = std::make_unique<Lane>();
+            lane->thread = std::thread([&lane = *lane] { run(lane); });
+            m_lanes.push_back(std::move(lane));
+        }
+    }
+
+    MessageDispatcher::~MessageDispatcher()
+    {
+        for (const auto& lane : m_lanes)
+        {
+            {
+                std::scoped_lock lock(lane->mutex);
+                lane->isStopping = true;
+            }
+            lane->ready.notify_one();
+        }
+
+        for (const auto& lane : m_lanes)
+        {
+            if (lane->thread.joinable())
+            {
+                lane->thread.join();
+            }
+        }
+    }
+
+    void MessageDispatcher::dispatch(const size_t key, std::function<void()> task)
+    {
+        Lane& lane = *m_lanes[key % m_lanes.size()];
+        lane.tasks.push(std::move(task));
+
+        // Taking the mutex orders the push before the lane's emptiness check, so the wakeup cannot be lost.
+        {
+            std::scoped_lock lock(lane.mutex);
+        }
+        lane.ready.notify_one();
+    }
+
+    void MessageDispatcher::run(Lane& lane)
+    {
+        while (true)
+        {
+            while (auto task = lane.tasks.tryPop())
+            {
+                REACTORMQ_TRACE_SCOPE("MessageDispatcher::task");
+                (*task)();
+            }
+
+            std::unique_lock lock(lane.mutex);
+            lane.ready.wait(lock, [&lane] { return lane.isStopping || lane.tasks.getDepth() > 0; });
+            if (lane.isStopping && lane.tasks.getDepth() == 0)
+            {
+                return;
+            }
+        }
+    }
+} // namespace reactormq::mqtt::client
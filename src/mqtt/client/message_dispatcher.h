@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/mpsc_queue.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Runs message callbacks on a fixed set of worker lanes, keeping tasks with the same key in order.
+     *
+     * Each lane is one thread draining its own queue, and a key always maps to the same lane, so tasks for one topic
+     * run in the order they were dispatched while different topics are handled in parallel. dispatch() may be called
+     * from several reactor threads at once, as by a consumer group; tasks with one key then run in the order their
+     * calls queued them. Destruction runs every task already dispatched, then joins the lanes, so it must not happen
+     * on a lane.
+     */
+    class MessageDispatcher final
+    {
+    public:
+        /// @param laneCount Number of worker lanes; must be at least 1.
+        explicit MessageDispatcher(size_t laneCount);
+
+        ~MessageDispatcher();
+
+        MessageDispatcher(const MessageDispatcher&) = delete;
+
+        MessageDispatcher& operator=(const MessageDispatcher&) = delete;
+
+        /**
+         * @brief Queue a task on the lane that owns the key.
+         * @param key Ordering key, for example a topic hash; tasks with equal keys run in dispatch order.
+         * @param task Task to run on the lane's thread.
+         */
+        void dispatch(size_t key, std::function<void()> task);
+
+        /// @brief Number of worker lanes.
+        [[nodiscard]] size_t getLaneCount() const
+        {
+            return m_lanes.size();
+        }
+
+    private:
+        struct Lane
+        {
+            MpscQueue<std::function<void()>> tasks;
+            std::mutex mutex;
+            std::condition_variable ready;
+            bool isStopping = false;
+            std::thread thread;
+        };
+
+        static void run(Lane& lane);
+
+        std::vector<std::unique_ptr<Lane>> m_lanes;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,227 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Unbounded lock-free multi-producer single-consumer queue (Vyukov intrusive MPSC with a stub node).
+     *
+     * push() may be called from any thread and costs one atomic exchange. tryPop() must only be called from the
+     * single consumer thread. Popped nodes go back to a bounded freelist for the next push, so in steady state the
+     * queue allocates nothing however many values pass through it; taking or returning a node holds the freelist's
+     * mutex for a few instructions only. A producer preempted between its exchange and link makes the items
+     * behind it briefly invisible to the consumer; tryPop() then reports empty and the items appear once the
+     * producer resumes, so callers must pair pushes with a wakeup rather than spin on the queue.
+     *
+     * @tparam T Element type; only needs to be move-constructible.
+     */
+    template<typename T>
+    class MpscQueue final
+    {
+    public:
+        /// @param maxRecycledNodes Most popped nodes kept for reuse; nodes beyond this are freed.
+        explicit MpscQueue(const size_t maxRecycledNodes = kDefaultMaxRecycledNodes)
+            : m_head(&m_stub)
+            , m_tail(&m_stub)
+            , m_maxRecycledNodes(maxRecycledNodes)
+        {
+        }
+
+        ~MpscQueue()
+        {
+            while (tryPop().has_value())
+            {
+                // drain remaining nodes
+            }
+
+            while (nullptr != m_recycled)
+            {
+                delete std::exchange(m_recycled, m_recycled->nextRecycled);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /**
+         * @brief Put nodes in the freelist up front, so up to count values can be queued without allocating.
+         * Raises the freelist bound to count if it is lower.
+         * @param count Nodes to keep ready.
+         */
+        void preallocate(const size_t count)
+        {
+            const std::scoped_lock lock(m_recycledMutex);
+            m_maxRecycledNodes = std::max(m_maxRecycledNodes, count);
+            for (; m_recycledCount < count; ++m_recycledCount)
+            {
+                Node* node = new Node();
+                node->nextRecycled = m_recycled;
+                m_recycled = node;
+            }
+        }
+
+        /**
+         * @brief Enqueue a value. Thread-safe for any number of producers.
+         * @param value Value to enqueue.
+         */
+        void push(T value)
+        {
+            // Count before linking so the depth never underflows when the consumer pops the node straight away.
+            m_depth.fetch_add(1, std::memory_order_relaxed);
+            pushNode(acquireNode(std::move(value)));
+        }
+
+        /**
+         * @brief Dequeue the oldest value. Consumer thread only.
+         * @return The value, or std::nullopt if the queue is empty or a producer has not finished linking.
+         */
+        std::optional<T> tryPop()
+        {
+            Node* node = popNode();
+            if (nullptr == node)
+            {
+                return std::nullopt;
+            }
+
+            std::optional<T> value{ std::move(*node->value) };
+            recycleNode(node);
+            m_depth.fetch_sub(1, std::memory_order_relaxed);
+            return value;
+        }
+
+        /**
+         * @brief Approximate number of queued values, for monitoring and emptiness checks.
+         * Exact when observed from the consumer thread with no concurrent producers.
+         */
+        [[nodiscard]] size_t getDepth() const
+        {
+            return m_depth.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Number of popped nodes waiting to be reused by a push.
+        [[nodiscard]] size_t getRecycledNodeCount() const
+        {
+            const std::scoped_lock lock(m_recycledMutex);
+            return m_recycledCount;
+        }
+
+    private:
+        struct NodeBase
+        {
+            std::atomic<NodeBase*> next{ nullptr };
+        };
+
+        struct Node final : NodeBase
+        {
+            /// Empty while the node sits in the freelist.
+            std::optional<T> value;
+            Node* nextRecycled = nullptr;
+        };
+
+        static constexpr size_t kDefaultMaxRecycledNodes = 1024;
+
+        Node* acquireNode(T&& value)
+        {
+            Node* node = nullptr;
+            {
+                const std::scoped_lock lock(m_recycledMutex);
+                if (nullptr != m_recycled)
+                {
+                    node = std::exchange(m_recycled, m_recycled->nextRecycled);
+                    --m_recycledCount;
+                }
+            }
+
+            if (nullptr == node)
+            {
+                node = new Node();
+            }
+            node->value.emplace(std::move(value));
+            return node;
+        }
+
+        void recycleNode(Node* node)
+        {
+            node->value.reset();
+            {
+                const std::scoped_lock lock(m_recycledMutex);
+                if (m_recycledCount < m_maxRecycledNodes)
+                {
+                    node->nextRecycled = m_recycled;
+                    m_recycled = node;
+                    ++m_recycledCount;
+                    return;
+                }
+            }
+            delete node;
+        }
+
+        void pushNode(NodeBase* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            NodeBase* previous = m_head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        Node* popNode()
+        {
+            NodeBase* tail = m_tail;
+            NodeBase* next = tail->next.load(std::memory_order_acquire);
+
+            if (tail == &m_stub)
+            {
+                if (nullptr == next)
+                {
+                    return nullptr;
+                }
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (nullptr != next)
+            {
+                m_tail = next;
+                return static_cast<Node*>(tail);
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire))
+            {
+                return nullptr; // a producer is between its exchange and link
+            }
+
+            // tail is the last real node; re-insert the stub behind it so tail can be detached.
+            pushNode(&m_stub);
+
+            next = tail->next.load(std::memory_order_acquire);
+            if (nullptr != next)
+            {
+                m_tail = next;
+                return static_cast<Node*>(tail);
+            }
+
+            return nullptr;
+        }
+
+        alignas(64) std::atomic<NodeBase*> m_head; ///< Producers exchange here.
+        std::atomic<size_t> m_depth{ 0 };
+        alignas(64) NodeBase* m_tail; ///< Consumer-owned.
+        NodeBase m_stub;
+
+        mutable std::mutex m_recycledMutex;
+        Node* m_recycled = nullptr;
+        size_t m_recycledCount = 0;
+        size_t m_maxRecycledNodes;
+    };
+} // namespace reactormq::mqtt::client
@@ -10,133 +10,128 @@
 
 #include <reactormq/mqtt/message.h>
 
+#include <array>
+#include <type_traits>
+
 namespace reactormq::mqtt::client
 {
-    template<packets::ProtocolVersion V>
-    std::unique_ptr<packets::IControlPacket> parsePacketImpl(
-        serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, const packets::PacketType packetType)
+    namespace
     {
-        using Mapping = MqttVersionMapping<V>;
-
-        switch (packetType)
+        // Each entry knows its concrete (final) packet type, so the validity check below is resolved statically.
+        template<typename TPacket>
+        PacketPtr decodePacket(serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, PacketArena& arena)
         {
-            using enum packets::PacketType;
-        case Connect:
-            {
-                return std::make_unique<typename Mapping::Connect>(reader, fixedHeader);
-            }
-        case ConnAck:
-            {
-                return std::make_unique<typename Mapping::ConnAck>(reader, fixedHeader);
-            }
-        case Publish:
-            {
-                return std::make_unique<typename Mapping::Publish>(reader, fixedHeader);
-            }
-        case PubAck:
-            {
-                return std::make_unique<typename Mapping::PubAck>(reader, fixedHeader);
-            }
-        case PubRec:
-            {
-                return std::make_unique<typename Mapping::PubRec>(reader, fixedHeader);
-            }
-        case PubRel:
-            {
-                return std::make_unique<typename Mapping::PubRel>(reader, fixedHeader);
-            }
-        case PubComp:
-            {
-                return std::make_unique<typename Mapping::PubComp>(reader, fixedHeader);
-            }
-        case Subscribe:
-            {
-                return std::make_unique<typename Mapping::Subscribe>(reader, fixedHeader);
-            }
-        case SubAck:
-            {
-                return std::make_unique<typename Mapping::SubAck>(reader, fixedHeader);
-            }
-        case Unsubscribe:
-            {
-                return std::make_unique<typename Mapping::Unsubscribe>(reader, fixedHeader);
-            }
-        case UnsubAck:
-            {
-                return std::make_unique<typename Mapping::UnsubAck>(reader, fixedHeader);
-            }
-        case PingReq:
-            {
-                return std::make_unique<packets::PingReq>(fixedHeader);
-            }
-        case PingResp:
-            {
-                return std::make_unique<packets::PingResp>(fixedHeader);
-            }
-        case Disconnect:
+            PacketPtr packet = [&]
             {
-                return std::make_unique<typename Mapping::Disconnect>(reader, fixedHeader);
-            }
-        case Auth:
-            {
-                if constexpr (Mapping::supportsAuth())
+                if constexpr (std::is_constructible_v<TPacket, serialize::ByteReader&, const packets::FixedHeader&>)
                 {
-                    return std::make_unique<packets::Auth>(reader, fixedHeader);
+                    return arena.create<TPacket>(reader, fixedHeader);
                 }
                 else
                 {
-                    return nullptr;
+                    return arena.create<TPacket>(fixedHeader);
                 }
-            }
-        case None:
-        case Max:
-        default:
+            }();
+
+            if (const auto* concrete = static_cast<const TPacket*>(packet.get()); !concrete->isValid())
             {
-                REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Unknown or invalid packet type: %d", packetType);
+                REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Malformed packet of type: %d", concrete->getPacketType());
                 return nullptr;
             }
+
+            return packet;
+        }
+
+        using DecoderRow = std::array<PacketDecoder, static_cast<size_t>(packets::PacketType::Max)>;
+
+        constexpr size_t toIndex(const packets::PacketType packetType)
+        {
+            return static_cast<size_t>(packetType);
+        }
+
+        template<packets::ProtocolVersion V>
+        consteval DecoderRow makeDecoderRow()
+        {
+            using Mapping = MqttVersionMapping<V>;
+            using enum packets::PacketType;
+
+            DecoderRow row{};
+            row[toIndex(Connect)] = &decodePacket<typename Mapping::Connect>;
+            row[toIndex(ConnAck)] = &decodePacket<typename Mapping::ConnAck>;
+            row[toIndex(Publish)] = &decodePacket<typename Mapping::Publish>;
+            row[toIndex(PubAck)] = &decodePacket<typename Mapping::PubAck>;
+            row[toIndex(PubRec)] = &decodePacket<typename Mapping::PubRec>;
+            row[toIndex(PubRel)] = &decodePacket<typename Mapping::PubRel>;
+            row[toIndex(PubComp)] = &decodePacket<typename Mapping::PubComp>;
+            row[toIndex(Subscribe)] = &decodePacket<typename Mapping::Subscribe>;
+            row[toIndex(SubAck)] = &decodePacket<typename Mapping::SubAck>;
+            row[toIndex(Unsubscribe)] = &decodePacket<typename Mapping::Unsubscribe>;
+            row[toIndex(UnsubAck)] = &decodePacket<typename Mapping::UnsubAck>;
+            row[toIndex(PingReq)] = &decodePacket<packets::PingReq>;
+            row[toIndex(PingResp)] = &decodePacket<packets::PingResp>;
+            row[toIndex(Disconnect)] = &decodePacket<typename Mapping::Disconnect>;
+            if constexpr (Mapping::supportsAuth())
+            {
+                row[toIndex(Auth)] = &decodePacket<packets::Auth>;
+            }
+            return row;
         }
+
+        /// @brief Decoders of one protocol version indexed by packet type; None and unsupported types stay nullptr.
+        /// Only rows reached through withMqttVersion() are instantiated, so a single-version build omits the other's.
+        template<packets::ProtocolVersion V>
+        constexpr DecoderRow kPacketDecoders = makeDecoderRow<V>();
+    } // namespace
+
+    PacketDecoder getPacketDecoder(const packets::ProtocolVersion version, const packets::PacketType packetType)
+    {
+        if (toIndex(packetType) >= std::tuple_size_v<DecoderRow>)
+        {
+            return nullptr;
+        }
+
+        return withMqttVersion(
+            version,
+            [packetType](auto versionTag)
+            {
+                return kPacketDecoders<decltype(versionTag)::value>[toIndex(packetType)];
+            });
     }
 
+    namespace
+    {
+        /// @brief Upper bound on PUBLISH header bytes besides the topic: fixed header, lengths, packet ID, empty properties.
+        constexpr size_t kPublishHeaderOverhead = 16;
+
+        // Retransmits write the header and then the payload straight from the message, so the shared payload
+        // buffer is never copied into a temporary Publish packet.
+        template<packets::ProtocolVersion V>
+        void encodeRetransmit(Message const& message, const std::uint16_t packetId, serialize::ByteWriter& writer)
+        {
+            const std::span<const std::uint8_t> payload = message.getPayloadView();
+            writer.reserve(kPublishHeaderOverhead + message.getTopic().size() + payload.size());
+            packets::encodePublishHeaderToWriter<V>(
+                writer,
+                message.getTopic(),
+                static_cast<std::uint32_t>(payload.size()),
+                message.getQualityOfService(),
+                message.shouldRetain(),
+                packetId,
+                true // dup
+            );
+            writer.writeBytes(reinterpret_cast<const std::byte*>(payload.data()), payload.size());
+        }
+    } // namespace
+
     void PublishEncoder<packets::ProtocolVersion::V311>::encode(
         Message const& message, const std::uint16_t packetId, serialize::ByteWriter& writer)
     {
-        using Mapping = MqttVersionMapping<packets::ProtocolVersion::V311>;
-
-        const Mapping::Publish publishPacket(
-            message.getTopic(),
-            message.getPayload(),
-            message.getQualityOfService(),
-            message.shouldRetain(),
-            packetId,
-            true // dup
-        );
-
-        publishPacket.encode(writer);
+        encodeRetransmit<packets::ProtocolVersion::V311>(message, packetId, writer);
     }
 
     void PublishEncoder<packets::ProtocolVersion::V5>::encode(
         Message const& message, const std::uint16_t packetId, serialize::ByteWriter& writer)
     {
-        using Mapping = MqttVersionMapping<packets::ProtocolVersion::V5>;
-
-        const Mapping::Publish publishPacket(
-            message.getTopic(),
-            message.getPayload(),
-            message.getQualityOfService(),
-            message.shouldRetain(),
-            packetId,
-            {},
-            // properties
-            true // dup
-        );
-
-        publishPacket.encode(writer);
+        encodeRetransmit<packets::ProtocolVersion::V5>(message, packetId, writer);
     }
-
-    template std::unique_ptr<packets::IControlPacket> parsePacketImpl<packets::ProtocolVersion::V311>(
-        serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, packets::PacketType packetType);
-
-    template std::unique_ptr<packets::IControlPacket> parsePacketImpl<packets::ProtocolVersion::V5>(
-        serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, packets::PacketType packetType);
 } // namespace reactormq::mqtt::client
\ No newline at end of file
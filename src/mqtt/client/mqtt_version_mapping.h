@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "mqtt/client/packet_arena.h"
 #include "mqtt/packets/conn_ack.h"
 #include "mqtt/packets/connect.h"
 #include "mqtt/packets/disconnect.h"
@@ -18,6 +19,16 @@
 #include "mqtt/packets/unsubscribe.h"
 #include "reactormq/mqtt/protocol_version.h"
 
+// Protocol level the client is built for (4 for MQTT 3.1.1, 5 for MQTT 5); the build sets it from REACTORMQ_MQTT_VERSION.
+// 0 keeps both versions and dispatches on the connection's version at run time.
+#ifndef REACTORMQ_MQTT_VERSION
+#define REACTORMQ_MQTT_VERSION 0
+#endif
+
+static_assert(
+    REACTORMQ_MQTT_VERSION == 0 || REACTORMQ_MQTT_VERSION == 4 || REACTORMQ_MQTT_VERSION == 5,
+    "REACTORMQ_MQTT_VERSION must be 0 (both), 4 (MQTT 3.1.1) or 5 (MQTT 5)");
+
 namespace reactormq::mqtt
 {
     struct Message;
@@ -26,21 +37,21 @@ namespace reactormq::mqtt
 namespace reactormq::mqtt::client
 {
     /**
-     * @brief Parse an MQTT control packet for a specific protocol version.
-     *
-     * This function is instantiated per MQTT protocol version and is responsible
-     * for constructing the appropriate concrete control packet type from the
-     * provided fixed header and reader.
-     *
-     * @tparam V MQTT protocol version (e.g. packets::ProtocolVersion::V311 or V5).
-     * @param reader      Byte reader positioned at the start of the packet body.
+     * @brief Decodes the body of one concrete control packet type.
+     * @param reader      Byte reader positioned after the fixed header.
      * @param fixedHeader Fixed header already parsed for this packet.
-     * @param packetType  MQTT packet type encoded in the fixed header.
-     * @return A unique_ptr to the parsed control packet, or nullptr on failure.
+     * @param arena       Arena the packet object is placed in (heap when the arena is disabled).
+     * @return The decoded packet, or nullptr if it is malformed.
      */
-    template<packets::ProtocolVersion V>
-    std::unique_ptr<packets::IControlPacket> parsePacketImpl(
-        serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, packets::PacketType packetType);
+    using PacketDecoder = PacketPtr (*)(serialize::ByteReader& reader, const packets::FixedHeader& fixedHeader, PacketArena& arena);
+
+    /**
+     * @brief Look up the decoder for a packet type in a compile-time table indexed by protocol version and packet type.
+     * @param version    MQTT protocol version of the connection.
+     * @param packetType MQTT packet type encoded in the fixed header.
+     * @return The decoder, or nullptr if the type is invalid or not defined for @p version (AUTH on 3.1.1).
+     */
+    [[nodiscard]] PacketDecoder getPacketDecoder(packets::ProtocolVersion version, packets::PacketType packetType);
 
     /**
      * @brief Compile-time mapping between an MQTT protocol version and its packet types.
@@ -124,6 +135,13 @@ namespace reactormq::mqtt::client
         }
     };
 
+    /// @brief Whether the build speaks a single protocol version, fixed by REACTORMQ_MQTT_VERSION.
+    inline constexpr bool kIsProtocolVersionFixed = REACTORMQ_MQTT_VERSION != 0;
+
+    /// @brief The version a single-version build speaks; MQTT 5 when both are built in.
+    inline constexpr packets::ProtocolVersion kFixedProtocolVersion
+        = kIsProtocolVersionFixed ? static_cast<packets::ProtocolVersion>(REACTORMQ_MQTT_VERSION) : packets::ProtocolVersion::V5;
+
     /**
      * @brief Invoke a callable with a compile-time MQTT version tag based on a runtime version value.
      *
@@ -131,6 +149,9 @@ namespace reactormq::mqtt::client
      * integral constant and passes it to the provided callable. It is typically used
      * to select version-specific code paths while keeping the main logic shared.
      *
+     * In a single-version build the runtime value is ignored and only the built-in version's
+     * instantiation of @p f exists, so the call inlines and the other version's encoders are never emitted.
+     *
      * Example:
      * @code
      * withMqttVersion(protocolVersion, [](auto versionTag)
@@ -149,21 +170,28 @@ namespace reactormq::mqtt::client
      * @return Whatever @p f returns.
      */
     template<typename F>
-    decltype(auto) withMqttVersion(const packets::ProtocolVersion version, F&& f)
+    decltype(auto) withMqttVersion([[maybe_unused]] const packets::ProtocolVersion version, F&& f)
     {
-        switch (version)
+        if constexpr (kIsProtocolVersionFixed)
         {
-        case packets::ProtocolVersion::V311:
-            {
-                return std::forward<F>(f)(std::integral_constant<packets::ProtocolVersion, packets::ProtocolVersion::V311>{});
-            }
-        case packets::ProtocolVersion::V5:
+            return std::forward<F>(f)(std::integral_constant<packets::ProtocolVersion, kFixedProtocolVersion>{});
+        }
+        else
+        {
+            switch (version)
             {
-                return std::forward<F>(f)(std::integral_constant<packets::ProtocolVersion, packets::ProtocolVersion::V5>{});
+            case packets::ProtocolVersion::V311:
+                {
+                    return std::forward<F>(f)(std::integral_constant<packets::ProtocolVersion, packets::ProtocolVersion::V311>{});
+                }
+            case packets::ProtocolVersion::V5:
+                {
+                    return std::forward<F>(f)(std::integral_constant<packets::ProtocolVersion, packets::ProtocolVersion::V5>{});
+                }
             }
-        }
 
-        std::terminate();
+            std::terminate();
+        }
     }
 
     template<auto Version>
@@ -0,0 +1,163 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/command.h"
+#include "reactormq/mqtt/offline_queue_policy.h"
+#include "reactormq/mqtt/result.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Publishes made while the client is not connected, sent oldest first once it is ready again.
+     *
+     * Bounded by a publish count and by the topic and payload bytes it holds; when a new publish does not fit, the
+     * policy decides which publish fails, after any publish whose message has expired is dropped to make room. A
+     * publish that is dropped or rejected has its promise failed at once, so no caller waits on a message that will
+     * never be sent. Not thread-safe; it belongs to the reactor thread.
+     */
+    class OfflinePublishQueue final
+    {
+    public:
+        /**
+         * @param maxPublishes Most queued publishes; 0 disables the queue, so every push fails.
+         * @param maxBytes Most topic and payload bytes queued.
+         * @param policy What fails when a new publish does not fit.
+         */
+        OfflinePublishQueue(const std::uint32_t maxPublishes, const std::uint32_t maxBytes, const OfflineQueuePolicy policy)
+            : m_maxPublishes(maxPublishes)
+            , m_maxBytes(maxBytes)
+            , m_policy(policy)
+        {
+        }
+
+        /**
+         * @brief Queue a publish, dropping an older one or failing this one if the queue is full.
+         * Expired publishes go first, so a full queue only applies its policy to messages still worth sending.
+         * @param command Publish to queue.
+         */
+        void push(PublishCommand command)
+        {
+            if (0 == m_maxPublishes)
+            {
+                command.promise.set_value(Result<void>::failure(ResultError::NotConnected));
+                return;
+            }
+
+            const size_t bytes = sizeOf(command);
+            if (bytes > m_maxBytes)
+            {
+                command.promise.set_value(Result<void>::failure(ResultError::OfflineQueueFull));
+                return;
+            }
+
+            if (!fits(bytes))
+            {
+                (void)dropExpired(command.enqueuedAt);
+            }
+
+            if (m_policy == OfflineQueuePolicy::Reject && !fits(bytes))
+            {
+                command.promise.set_value(Result<void>::failure(ResultError::OfflineQueueFull));
+                return;
+            }
+
+            while (!fits(bytes))
+            {
+                if (m_policy == OfflineQueuePolicy::DropOldest)
+                {
+                    drop(m_publishes.front());
+                    m_publishes.pop_front();
+                }
+                else
+                {
+                    drop(m_publishes.back());
+                    m_publishes.pop_back();
+                }
+            }
+
+            m_bytes += bytes;
+            m_publishes.push_back(std::move(command));
+        }
+
+        /**
+         * @brief Drop every queued publish whose message expired, completing it with Result::expired().
+         * @param now Current time.
+         * @return Number of publishes dropped.
+         */
+        size_t dropExpired(const std::chrono::steady_clock::time_point now)
+        {
+            const size_t before = m_publishes.size();
+            std::erase_if(
+                m_publishes,
+                [this, now](PublishCommand& command)
+                {
+                    if (!command.hasExpired(now))
+                    {
+                        return false;
+                    }
+                    m_bytes -= sizeOf(command);
+                    command.promise.set_value(Result<void>::expired());
+                    return true;
+                });
+            return before - m_publishes.size();
+        }
+
+        /// @brief Take the oldest queued publish, if any.
+        std::optional<PublishCommand> pop()
+        {
+            if (m_publishes.empty())
+            {
+                return std::nullopt;
+            }
+
+            PublishCommand command = std::move(m_publishes.front());
+            m_publishes.pop_front();
+            m_bytes -= sizeOf(command);
+            return command;
+        }
+
+        /// @brief Number of queued publishes.
+        [[nodiscard]] size_t size() const
+        {
+            return m_publishes.size();
+        }
+
+        /// @brief Topic and payload bytes currently queued.
+        [[nodiscard]] size_t getBytes() const
+        {
+            return m_bytes;
+        }
+
+    private:
+        [[nodiscard]] static size_t sizeOf(const PublishCommand& command)
+        {
+            return command.message.getTopic().size() + command.message.getPayloadView().size();
+        }
+
+        [[nodiscard]] bool fits(const size_t bytes) const
+        {
+            return m_publishes.size() < m_maxPublishes && m_bytes + bytes <= m_maxBytes;
+        }
+
+        void drop(PublishCommand& command)
+        {
+            m_bytes -= sizeOf(command);
+            command.promise.set_value(Result<void>::failure(ResultError::DroppedFromOfflineQueue));
+        }
+
+        std::deque<PublishCommand> m_publishes;
+        size_t m_bytes = 0;
+        std::uint32_t m_maxPublishes;
+        std::uint32_t m_maxBytes;
+        OfflineQueuePolicy m_policy;
+    };
+} // namespace reactormq::mqtt::client
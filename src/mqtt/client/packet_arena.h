@@ -0,0 +1,166 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/interface/control_packet.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Deleter for decoded packets that may live in a PacketArena.
+     * Arena-backed packets are only destroyed; their storage is reclaimed when the arena is reset.
+     */
+    struct PacketDeleter
+    {
+        bool isArenaOwned = false;
+
+        void operator()(packets::IControlPacket* packet) const
+        {
+            if (nullptr == packet)
+            {
+                return;
+            }
+
+            if (isArenaOwned)
+            {
+                packet->~IControlPacket();
+            }
+            else
+            {
+                delete packet;
+            }
+        }
+    };
+
+    /// @brief Owning pointer to a decoded packet, heap- or arena-backed.
+    using PacketPtr = std::unique_ptr<packets::IControlPacket, PacketDeleter>;
+
+    /**
+     * @brief Tick-scoped monotonic arena for decoded inbound packets.
+     *
+     * Backed by one fixed block, allocated with the first packet so an idle client does not hold it, or up front by
+     * reserve(); allocation is a pointer bump and nothing is freed until reset().
+     * A packet that does not fit in what is left of the block gets its own allocation, released on the next reset.
+     * The block and the overflow allocations come from the client's memory resource.
+     * Every packet allocated from the arena must be destroyed before reset() is called. Not thread-safe; it belongs
+     * to the reactor thread.
+     */
+    class PacketArena final
+    {
+    public:
+        /**
+         * @param capacity Size of the fixed block in bytes; 0 disables the arena.
+         * @param resource Memory resource the block and overflow allocations come from; must outlive the arena.
+         */
+        explicit PacketArena(const size_t capacity, std::pmr::memory_resource* resource = std::pmr::new_delete_resource())
+            : m_resource(resource)
+            , m_capacity(capacity)
+            , m_overflow(resource)
+        {
+        }
+
+        ~PacketArena()
+        {
+            reset();
+            if (nullptr != m_storage)
+            {
+                m_resource->deallocate(m_storage, m_capacity, kAlignment);
+            }
+        }
+
+        PacketArena(const PacketArena&) = delete;
+        PacketArena& operator=(const PacketArena&) = delete;
+
+        /// @brief Whether packets are placed in the arena at all.
+        [[nodiscard]] bool isEnabled() const
+        {
+            return m_capacity > 0;
+        }
+
+        /**
+         * @brief Construct a packet, in the arena when enabled and on the heap otherwise.
+         * @tparam T Concrete packet type.
+         * @param args Constructor arguments.
+         * @return Owning pointer to the new packet.
+         */
+        template<typename T, typename... Args>
+        PacketPtr create(Args&&... args)
+        {
+            if (!isEnabled())
+            {
+                return PacketPtr(new T(std::forward<Args>(args)...), PacketDeleter{ false });
+            }
+
+            void* storage = allocate(sizeof(T), alignof(T));
+            return PacketPtr(::new (storage) T(std::forward<Args>(args)...), PacketDeleter{ true });
+        }
+
+        /// @brief Allocate the fixed block now rather than with the first packet.
+        void reserve()
+        {
+            if (nullptr == m_storage && isEnabled())
+            {
+                m_storage = static_cast<std::byte*>(m_resource->allocate(m_capacity, kAlignment));
+            }
+        }
+
+        /// @brief Reclaim everything allocated since the last reset and rewind to the start of the fixed block.
+        void reset()
+        {
+            m_used = 0;
+            for (const auto& [block, size] : m_overflow)
+            {
+                m_resource->deallocate(block, size, kAlignment);
+            }
+            m_overflow.clear();
+        }
+
+        /// @brief Bytes of the fixed block handed out since the last reset.
+        [[nodiscard]] size_t getBytesUsed() const
+        {
+            return m_used;
+        }
+
+        /// @brief Number of allocations since the last reset that did not fit in the fixed block.
+        [[nodiscard]] size_t getOverflowCount() const
+        {
+            return m_overflow.size();
+        }
+
+    private:
+        /// Alignment of the block and of overflow allocations; covers every fundamental type, so every packet class.
+        static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+        void* allocate(const size_t size, const size_t alignment)
+        {
+            reserve();
+            const auto base = reinterpret_cast<std::uintptr_t>(m_storage);
+            const std::uintptr_t aligned = (base + m_used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            if (const size_t offset = aligned - base; offset + size <= m_capacity)
+            {
+                m_used = offset + size;
+                return m_storage + offset;
+            }
+
+            void* block = m_resource->allocate(size, kAlignment);
+            m_overflow.emplace_back(block, size);
+            return block;
+        }
+
+        std::pmr::memory_resource* m_resource;
+        std::byte* m_storage = nullptr;
+        size_t m_capacity;
+        size_t m_used = 0;
+        std::pmr::vector<std::pair<void*, size_t>> m_overflow;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,355 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/traffic_recording.h"
+#include "reactormq/mqtt/packet_tap.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    namespace
+    {
+        /// @brief One packet as the writer thread gets it; bytes points into the ring's arena.
+        struct CapturedPacket
+        {
+            std::int64_t timestampUs = 0;
+            PacketDirection direction = PacketDirection::Received;
+            std::uint32_t originalSize = 0;
+            std::span<const std::uint8_t> bytes;
+        };
+
+        /**
+         * @brief Bounded lock-free multi-producer single-consumer ring of captured packets (Vyukov bounded queue).
+         * The same protocol as logging::AsyncLogQueue; each slot's bytes live at a fixed offset in one arena, so
+         * pushing copies at most the snap length and never allocates. A full ring rejects the packet.
+         */
+        class PacketCaptureRing final
+        {
+        public:
+            PacketCaptureRing(const size_t capacity, const std::uint32_t snapLength)
+                : m_mask(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity) - 1)
+                , m_snapLength(snapLength)
+                , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+                , m_arena(std::make_unique<std::uint8_t[]>((m_mask + 1) * snapLength))
+            {
+                for (size_t i = 0; i <= m_mask; ++i)
+                {
+                    m_slots[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            /// @return False if the ring is full and the packet was dropped. Thread-safe for any number of producers.
+            bool tryPush(
+                const PacketDirection direction, const std::span<const std::span<const std::uint8_t>> parts, const size_t originalSize)
+            {
+                size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+                Slot* slot = nullptr;
+                for (;;)
+                {
+                    slot = &m_slots[position & m_mask];
+                    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                    const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                    if (distance == 0)
+                    {
+                        if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (distance < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = m_enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                std::uint8_t* bytes = &m_arena[(position & m_mask) * m_snapLength];
+                size_t captured = 0;
+                for (const std::span<const std::uint8_t> part : parts)
+                {
+                    const size_t count = std::min<size_t>(part.size(), m_snapLength - captured);
+                    std::memcpy(bytes + captured, part.data(), count);
+                    captured += count;
+                }
+
+                const auto now = std::chrono::system_clock::now().time_since_epoch();
+                slot->timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+                slot->direction = direction;
+                slot->originalSize = static_cast<std::uint32_t>(std::min<size_t>(originalSize, UINT32_MAX));
+                slot->capturedSize = static_cast<std::uint32_t>(captured);
+                slot->sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Hand queued packets, oldest first, to a consumer. Consumer thread only.
+             * @param consume Called as `consume(const CapturedPacket&)`; the bytes are valid for that call only.
+             * @param maxPackets Most packets consumed by this call.
+             * @return Number of packets consumed.
+             */
+            template<typename Consume>
+            size_t drain(Consume&& consume, const size_t maxPackets)
+            {
+                size_t consumed = 0;
+                while (consumed < maxPackets)
+                {
+                    Slot& slot = m_slots[m_dequeuePosition & m_mask];
+                    if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+                    {
+                        break; // empty, or a producer is still copying its packet in
+                    }
+
+                    consume(CapturedPacket{
+                        slot.timestampUs,
+                        slot.direction,
+                        slot.originalSize,
+                        { &m_arena[(m_dequeuePosition & m_mask) * m_snapLength], slot.capturedSize } });
+                    slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+                    ++m_dequeuePosition;
+                    ++consumed;
+                }
+
+                return consumed;
+            }
+
+        private:
+            struct Slot
+            {
+                std::atomic<size_t> sequence{ 0 };
+                std::int64_t timestampUs = 0;
+                PacketDirection direction = PacketDirection::Received;
+                std::uint32_t originalSize = 0;
+                std::uint32_t capturedSize = 0;
+            };
+
+            const size_t m_mask;
+            const std::uint32_t m_snapLength;
+            std::unique_ptr<Slot[]> m_slots;
+            std::unique_ptr<std::uint8_t[]> m_arena;
+            alignas(64) std::atomic<size_t> m_enqueuePosition{ 0 };
+            alignas(64) size_t m_dequeuePosition = 0; ///< Consumer-owned.
+        };
+
+        /// @brief Appends blocks of a pcapng file (in host byte order, which its byte-order magic records).
+        class PcapngEncoder final
+        {
+        public:
+            /// @brief Section header and the one interface every packet is recorded on.
+            static void appendHeader(std::vector<char>& out, const std::uint32_t snapLength)
+            {
+                constexpr std::uint32_t kSectionHeaderBlock = 0x0A0D0D0A;
+                constexpr std::uint32_t kByteOrderMagic = 0x1A2B3C4D;
+                constexpr std::uint32_t kSectionHeaderSize = 28;
+                append<std::uint32_t>(out, kSectionHeaderBlock);
+                append<std::uint32_t>(out, kSectionHeaderSize);
+                append<std::uint32_t>(out, kByteOrderMagic);
+                append<std::uint16_t>(out, 1); // major version
+                append<std::uint16_t>(out, 0); // minor version
+                append<std::int64_t>(out, -1); // section length not known
+                append<std::uint32_t>(out, kSectionHeaderSize);
+
+                // Timestamps are in microseconds, the default resolution, so the interface needs no options.
+                constexpr std::uint32_t kInterfaceDescriptionBlock = 1;
+                constexpr std::uint32_t kInterfaceDescriptionSize = 20;
+                constexpr std::uint16_t kLinkTypeUser0 = 147;
+                append<std::uint32_t>(out, kInterfaceDescriptionBlock);
+                append<std::uint32_t>(out, kInterfaceDescriptionSize);
+                append<std::uint16_t>(out, kLinkTypeUser0);
+                append<std::uint16_t>(out, 0); // reserved
+                append<std::uint32_t>(out, snapLength);
+                append<std::uint32_t>(out, kInterfaceDescriptionSize);
+            }
+
+            /// @brief An Enhanced Packet Block whose epb_flags option records the direction.
+            static void appendPacket(std::vector<char>& out, const CapturedPacket& packet)
+            {
+                constexpr std::uint32_t kEnhancedPacketBlock = 6;
+                constexpr std::uint16_t kFlagsOption = 2;
+                constexpr std::uint32_t kInbound = 1;
+                constexpr std::uint32_t kOutbound = 2;
+                const auto capturedSize = static_cast<std::uint32_t>(packet.bytes.size());
+                const std::uint32_t paddedSize = (capturedSize + 3U) & ~3U;
+                const std::uint32_t blockSize = 32U + paddedSize + 12U;
+                const auto timestamp = static_cast<std::uint64_t>(packet.timestampUs);
+
+                append<std::uint32_t>(out, kEnhancedPacketBlock);
+                append<std::uint32_t>(out, blockSize);
+                append<std::uint32_t>(out, 0); // interface
+                append<std::uint32_t>(out, static_cast<std::uint32_t>(timestamp >> 32));
+                append<std::uint32_t>(out, static_cast<std::uint32_t>(timestamp));
+                append<std::uint32_t>(out, capturedSize);
+                append<std::uint32_t>(out, packet.originalSize);
+                out.insert(out.end(), packet.bytes.begin(), packet.bytes.end());
+                out.insert(out.end(), paddedSize - capturedSize, '\0');
+                append<std::uint16_t>(out, kFlagsOption);
+                append<std::uint16_t>(out, 4);
+                append<std::uint32_t>(out, packet.direction == PacketDirection::Received ? kInbound : kOutbound);
+                append<std::uint32_t>(out, 0); // end of options
+                append<std::uint32_t>(out, blockSize);
+            }
+
+        private:
+            template<typename T>
+            static void append(std::vector<char>& out, const T value)
+            {
+                const auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+                out.insert(out.end(), bytes.begin(), bytes.end());
+            }
+        };
+
+        /// @brief Appends one JSON line per packet.
+        void appendJsonLine(std::vector<char>& out, const CapturedPacket& packet)
+        {
+            constexpr char kHexDigits[] = "0123456789abcdef";
+            const std::string prefix = "{\"ts_us\":" + std::to_string(packet.timestampUs) + ",\"dir\":\""
+                + (packet.direction == PacketDirection::Received ? "in" : "out") + "\",\"len\":" + std::to_string(packet.originalSize)
+                + ",\"hex\":\"";
+            out.insert(out.end(), prefix.begin(), prefix.end());
+            for (const std::uint8_t byte : packet.bytes)
+            {
+                out.push_back(kHexDigits[byte >> 4]);
+                out.push_back(kHexDigits[byte & 0x0F]);
+            }
+            out.push_back('"');
+            out.push_back('}');
+            out.push_back('\n');
+        }
+
+        class PacketCapture final : public IPacketCapture
+        {
+        public:
+            PacketCapture(const PacketCaptureOptions& options, std::ofstream file)
+                : m_format(options.format)
+                , m_snapLength(options.snapLength)
+                , m_ring(options.ringSlots, options.snapLength)
+                , m_file(std::move(file))
+                , m_writer([this](const std::stop_token& stopToken) { run(stopToken); })
+            {
+            }
+
+            void onPacket(
+                const PacketDirection direction,
+                const std::span<const std::span<const std::uint8_t>> parts,
+                const size_t originalSize) override
+            {
+                if (!m_ring.tryPush(direction, parts, originalSize))
+                {
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            [[nodiscard]] std::uint64_t getWrittenCount() const override
+            {
+                return m_writtenCount.load(std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] std::uint64_t getDroppedCount() const override
+            {
+                return m_droppedCount.load(std::memory_order_relaxed);
+            }
+
+        private:
+            /// Packets formatted per write to the file.
+            static constexpr size_t kBatchSize = 256;
+
+            /// How long the writer sleeps when the ring is empty; producers never wake it, so tapping makes no system call.
+            static constexpr std::chrono::milliseconds kIdlePollInterval{ 5 };
+
+            void run(const std::stop_token& stopToken)
+            {
+                if (m_format == PacketCaptureFormat::Pcapng)
+                {
+                    PcapngEncoder::appendHeader(m_buffer, m_snapLength);
+                }
+                else if (m_format == PacketCaptureFormat::Recording)
+                {
+                    client::TrafficRecordingEncoder::appendHeader(m_buffer);
+                }
+
+                while (!stopToken.stop_requested())
+                {
+                    if (writeBatch() == 0)
+                    {
+                        m_file.flush();
+                        std::this_thread::sleep_for(kIdlePollInterval);
+                    }
+                }
+
+                while (writeBatch() > 0)
+                {
+                    // write what was queued before the stop
+                }
+                m_file.flush();
+            }
+
+            size_t writeBatch()
+            {
+                const size_t count = m_ring.drain(
+                    [this](const CapturedPacket& packet)
+                    {
+                        switch (m_format)
+                        {
+                        case PacketCaptureFormat::Pcapng:
+                            PcapngEncoder::appendPacket(m_buffer, packet);
+                            break;
+                        case PacketCaptureFormat::JsonLines:
+                            appendJsonLine(m_buffer, packet);
+                            break;
+                        case PacketCaptureFormat::Recording:
+                            m_recording.appendPacket(m_buffer, packet.timestampUs, packet.direction, packet.originalSize, packet.bytes);
+                            break;
+                        }
+                    },
+                    kBatchSize);
+
+                if (!m_buffer.empty())
+                {
+                    m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+                    m_buffer.clear();
+                }
+                m_writtenCount.fetch_add(count, std::memory_order_relaxed);
+                return count;
+            }
+
+            const PacketCaptureFormat m_format;
+            const std::uint32_t m_snapLength;
+            PacketCaptureRing m_ring;
+            std::ofstream m_file; ///< Writer-owned.
+            std::vector<char> m_buffer; ///< Writer-owned; reused so formatting keeps its capacity.
+            client::TrafficRecordingEncoder m_recording; ///< Writer-owned; timestamps are deltas from its last packet.
+            std::atomic<std::uint64_t> m_writtenCount{ 0 };
+            std::atomic<std::uint64_t> m_droppedCount{ 0 };
+            std::jthread m_writer; ///< Declared last, so it is stopped and joined before anything it uses is destroyed.
+        };
+    } // namespace
+
+    PacketCapturePtr createPacketCapture(const PacketCaptureOptions& options)
+    {
+        std::ofstream file(options.path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "createPacketCapture() could not open %s", options.path.c_str());
+            return nullptr;
+        }
+        return std::make_shared<PacketCapture>(options, std::move(file));
+    }
+} // namespace reactormq::mqtt
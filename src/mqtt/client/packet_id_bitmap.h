@@ -0,0 +1,101 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Set of packet IDs (1-65535) as one bit each.
+     *
+     * The 8 KiB of words are allocated on the first insert, so a client that never uses the set pays nothing; after
+     * that, insert, erase and lookup are one indexed bit operation. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PacketIdBitmap final
+    {
+    public:
+        /**
+         * @brief Add an ID.
+         * @param packetId Packet ID; 0 is not a valid packet identifier and is rejected.
+         * @return True if it was added; false if it was 0 or already present.
+         */
+        bool insert(const std::uint16_t packetId)
+        {
+            if (packetId == 0 || contains(packetId))
+            {
+                return false;
+            }
+
+            if (m_words.empty())
+            {
+                m_words.resize(kWordCount, 0);
+            }
+            m_words[packetId / kBitsPerWord] |= getMask(packetId);
+            ++m_size;
+            return true;
+        }
+
+        /**
+         * @brief Remove an ID.
+         * @param packetId Packet ID.
+         * @return True if it was present.
+         */
+        bool erase(const std::uint16_t packetId)
+        {
+            if (!contains(packetId))
+            {
+                return false;
+            }
+
+            m_words[packetId / kBitsPerWord] &= ~getMask(packetId);
+            --m_size;
+            return true;
+        }
+
+        /// @brief Whether an ID is present.
+        [[nodiscard]] bool contains(const std::uint16_t packetId) const
+        {
+            return !m_words.empty() && (m_words[packetId / kBitsPerWord] & getMask(packetId)) != 0;
+        }
+
+        /// @brief Number of IDs present.
+        [[nodiscard]] size_t size() const
+        {
+            return m_size;
+        }
+
+        /// @brief Allocate the words now rather than on the first insert.
+        void reserve()
+        {
+            if (m_words.empty())
+            {
+                m_words.resize(kWordCount, 0);
+            }
+        }
+
+        /// @brief Remove every ID, keeping the words.
+        void clear()
+        {
+            std::fill(m_words.begin(), m_words.end(), 0);
+            m_size = 0;
+        }
+
+    private:
+        static constexpr size_t kBitsPerWord = 64;
+        static constexpr size_t kWordCount = 65536 / kBitsPerWord;
+
+        [[nodiscard]] static std::uint64_t getMask(const std::uint16_t packetId)
+        {
+            return std::uint64_t{ 1 } << (packetId % kBitsPerWord);
+        }
+
+        std::vector<std::uint64_t> m_words;
+        size_t m_size = 0;
+    };
+} // namespace reactormq::mqtt::client
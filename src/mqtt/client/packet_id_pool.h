@@ -0,0 +1,149 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Pool of outgoing packet IDs (1-65535) backed by an 8 KiB bitmap, allocated on the first allocation so an
+     * idle client does not carry it.
+     *
+     * Allocation scans forward from a cursor one 64-bit word at a time, so IDs are handed out round-robin (a released
+     * ID is not reused straight away) and a nearly full pool costs at most 1024 word reads instead of a probe per ID.
+     * Release and lookup are a single bit operation. setMaxId() narrows the range, so a table keyed by ID can be sized
+     * for it up front. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PacketIdPool final
+    {
+    public:
+        /**
+         * @brief Hand out IDs from 1 to maxId only.
+         * @param maxId Highest ID; 0 is treated as 1. Call it while no ID is in use.
+         */
+        void setMaxId(const std::uint16_t maxId)
+        {
+            m_maxId = maxId == 0 ? 1 : maxId;
+            m_wordCount = m_maxId / kBitsPerWord + 1;
+            m_words.reset();
+            m_inUse = 0;
+            m_cursor = 1;
+            (void)getWords();
+        }
+
+        /// @brief Highest ID the pool hands out.
+        [[nodiscard]] std::uint16_t getMaxId() const
+        {
+            return m_maxId;
+        }
+
+        /**
+         * @brief Allocate the next free ID at or after the cursor, wrapping around.
+         * @return ID, or 0 if the pool is exhausted.
+         */
+        [[nodiscard]] std::uint16_t allocate()
+        {
+            if (m_inUse == m_maxId)
+            {
+                return 0;
+            }
+
+            Words& words = getWords();
+            size_t word = m_cursor / kBitsPerWord;
+            // Ignore free bits below the cursor in its own word; they are reached again after wrapping.
+            std::uint64_t free = ~words[word] & (~std::uint64_t{ 0 } << (m_cursor % kBitsPerWord));
+            for (size_t scanned = 0; free == 0 && scanned < m_wordCount; ++scanned)
+            {
+                word = (word + 1) % m_wordCount;
+                free = ~words[word];
+            }
+
+            const auto id = static_cast<std::uint16_t>(word * kBitsPerWord + static_cast<size_t>(std::countr_zero(free)));
+            words[word] |= std::uint64_t{ 1 } << (id % kBitsPerWord);
+            ++m_inUse;
+            m_cursor = static_cast<std::uint16_t>(id + 1);
+            if (m_cursor == 0 || m_cursor > m_maxId)
+            {
+                m_cursor = 1;
+            }
+
+            return id;
+        }
+
+        /**
+         * @brief Mark a specific ID as allocated, as when resuming a persisted session.
+         * @return False if the ID is 0, above the max ID or already in use.
+         */
+        bool reserve(const std::uint16_t id)
+        {
+            if (id == 0 || id > m_maxId || isInUse(id))
+            {
+                return false;
+            }
+
+            getWords()[id / kBitsPerWord] |= std::uint64_t{ 1 } << (id % kBitsPerWord);
+            ++m_inUse;
+            return true;
+        }
+
+        /// @brief Return an ID to the pool; releasing a free ID or 0 does nothing.
+        void release(const std::uint16_t id)
+        {
+            if (id == 0 || id > m_maxId || !isInUse(id))
+            {
+                return;
+            }
+
+            (*m_words)[id / kBitsPerWord] &= ~(std::uint64_t{ 1 } << (id % kBitsPerWord));
+            --m_inUse;
+        }
+
+        /// @brief Whether an ID is currently allocated.
+        [[nodiscard]] bool isInUse(const std::uint16_t id) const
+        {
+            return id != 0 && id <= m_maxId && m_words && ((*m_words)[id / kBitsPerWord] >> (id % kBitsPerWord) & 1) != 0;
+        }
+
+        /// @brief Number of IDs currently allocated.
+        [[nodiscard]] size_t size() const
+        {
+            return m_inUse;
+        }
+
+    private:
+        static constexpr size_t kBitsPerWord = 64;
+        static constexpr size_t kWordCount = 65536 / kBitsPerWord;
+        static constexpr std::uint16_t kMaxPacketId = 65535;
+
+        using Words = std::array<std::uint64_t, kWordCount>;
+
+        Words& getWords()
+        {
+            if (!m_words)
+            {
+                m_words = std::make_unique<Words>();
+                // ID 0 is not a valid packet identifier; keep its bit set so it is never handed out.
+                (*m_words)[0] = 1;
+                // Bits above the max ID in its word stay set so the scan never returns them.
+                if (const size_t lastBit = m_maxId % kBitsPerWord; lastBit + 1 < kBitsPerWord)
+                {
+                    (*m_words)[m_wordCount - 1] |= ~std::uint64_t{ 0 } << (lastBit + 1);
+                }
+            }
+            return *m_words;
+        }
+
+        std::unique_ptr<Words> m_words;
+        std::uint16_t m_maxId = kMaxPacketId;
+        size_t m_wordCount = kWordCount;
+        size_t m_inUse = 0;
+        std::uint16_t m_cursor = 1;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,201 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Map from packet ID (1-65535) to a value, stored densely.
+     *
+     * Values live contiguously in one vector, so iterating in-flight packets walks a flat array. A two-level index
+     * (256 pages of 256 slots, each page allocated the first time one of its IDs is used) maps an ID to its position,
+     * so a lookup is two indexed loads with no hashing. The page table itself is allocated on the first insert, so an
+     * empty map is a few words. Erasing moves the last value into the hole, which means
+     * iteration order is unspecified. Not thread-safe; it belongs to the reactor thread.
+     *
+     * @tparam T Value type; must be move-constructible (commands and messages are not move-assignable).
+     */
+    template<typename T>
+    class PacketIdSlotMap final
+    {
+    public:
+        struct Entry
+        {
+            std::uint16_t packetId = 0;
+            T value;
+        };
+
+        /**
+         * @brief Insert a value if the ID is not present yet.
+         * @param packetId Packet ID; 0 is not a valid packet identifier and is rejected.
+         * @param args Constructor arguments for the value.
+         * @return Pointer to the new value, or nullptr if the ID was 0 or already present.
+         */
+        template<typename... Args>
+        T* tryEmplace(const std::uint16_t packetId, Args&&... args)
+        {
+            if (packetId == 0 || contains(packetId))
+            {
+                return nullptr;
+            }
+
+            m_entries.push_back(Entry{ packetId, T(std::forward<Args>(args)...) });
+            slotFor(packetId) = static_cast<std::uint16_t>(m_entries.size());
+            return &m_entries.back().value;
+        }
+
+        /// @brief Value stored for an ID, or nullptr.
+        [[nodiscard]] T* find(const std::uint16_t packetId)
+        {
+            const std::uint16_t slot = slotOf(packetId);
+            return slot != 0 ? &m_entries[slot - 1].value : nullptr;
+        }
+
+        /// @brief Value stored for an ID, or nullptr.
+        [[nodiscard]] const T* find(const std::uint16_t packetId) const
+        {
+            const std::uint16_t slot = slotOf(packetId);
+            return slot != 0 ? &m_entries[slot - 1].value : nullptr;
+        }
+
+        /// @brief Whether a value is stored for an ID.
+        [[nodiscard]] bool contains(const std::uint16_t packetId) const
+        {
+            return slotOf(packetId) != 0;
+        }
+
+        /// @brief Remove and return the value stored for an ID, if any.
+        std::optional<T> take(const std::uint16_t packetId)
+        {
+            T* value = find(packetId);
+            if (nullptr == value)
+            {
+                return std::nullopt;
+            }
+
+            std::optional<T> taken(std::move(*value));
+            erase(packetId);
+            return taken;
+        }
+
+        /// @brief Remove the value stored for an ID; erasing an absent ID does nothing.
+        void erase(const std::uint16_t packetId)
+        {
+            const std::uint16_t slot = slotOf(packetId);
+            if (slot == 0)
+            {
+                return;
+            }
+
+            if (slot != m_entries.size())
+            {
+                Entry& hole = m_entries[slot - 1];
+                std::destroy_at(&hole);
+                std::construct_at(&hole, std::move(m_entries.back()));
+                slotFor(m_entries[slot - 1].packetId) = slot;
+            }
+
+            m_entries.pop_back();
+            slotFor(packetId) = 0;
+        }
+
+        /**
+         * @brief Make room up front, so inserting never allocates.
+         * @param count Values to hold without growing.
+         * @param maxId Highest ID to allocate index pages for.
+         */
+        void reserve(const size_t count, const std::uint16_t maxId)
+        {
+            m_entries.reserve(count);
+            PageTable& pages = getPages();
+            for (size_t page = 0; page <= maxId / kPageSize; ++page)
+            {
+                if (!pages[page])
+                {
+                    pages[page] = std::make_unique<Page>();
+                }
+            }
+        }
+
+        /// @brief Number of stored values.
+        [[nodiscard]] size_t size() const
+        {
+            return m_entries.size();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return m_entries.empty();
+        }
+
+        [[nodiscard]] auto begin()
+        {
+            return m_entries.begin();
+        }
+
+        [[nodiscard]] auto end()
+        {
+            return m_entries.end();
+        }
+
+        [[nodiscard]] auto begin() const
+        {
+            return m_entries.cbegin();
+        }
+
+        [[nodiscard]] auto end() const
+        {
+            return m_entries.cend();
+        }
+
+    private:
+        static constexpr size_t kPageSize = 256;
+
+        /// Position in m_entries plus one for each ID of the page; 0 means absent.
+        using Page = std::array<std::uint16_t, kPageSize>;
+
+        using PageTable = std::array<std::unique_ptr<Page>, 65536 / kPageSize>;
+
+        [[nodiscard]] std::uint16_t slotOf(const std::uint16_t packetId) const
+        {
+            if (!m_pages)
+            {
+                return 0;
+            }
+            const auto& page = (*m_pages)[packetId / kPageSize];
+            return page ? (*page)[packetId % kPageSize] : 0;
+        }
+
+        PageTable& getPages()
+        {
+            if (!m_pages)
+            {
+                m_pages = std::make_unique<PageTable>();
+            }
+            return *m_pages;
+        }
+
+        std::uint16_t& slotFor(const std::uint16_t packetId)
+        {
+            auto& page = getPages()[packetId / kPageSize];
+            if (!page)
+            {
+                page = std::make_unique<Page>();
+            }
+            return (*page)[packetId % kPageSize];
+        }
+
+        std::vector<Entry> m_entries;
+        std::unique_ptr<PageTable> m_pages;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,146 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "payload_codecs.h"
+
+#include <algorithm>
+
+#if REACTORMQ_WITH_ZLIB
+#include <zlib.h>
+#endif // REACTORMQ_WITH_ZLIB
+
+namespace reactormq::mqtt
+{
+#if REACTORMQ_WITH_ZLIB
+    namespace
+    {
+        /// zlib streams, one per call, so clients on several reactor threads can share the codec.
+        class DeflatePayloadCodec final : public IPayloadCodec
+        {
+        public:
+            explicit DeflatePayloadCodec(const int level)
+                : m_level(std::clamp(level, 1, 9))
+            {
+            }
+
+            [[nodiscard]] std::string_view getName() const override
+            {
+                return "deflate";
+            }
+
+            bool encode(const std::span<const std::uint8_t> payload, std::vector<std::uint8_t>& out) const override
+            {
+                uLongf size = compressBound(static_cast<uLong>(payload.size()));
+                out.resize(size);
+                if (compress2(out.data(), &size, payload.data(), static_cast<uLong>(payload.size()), m_level) != Z_OK)
+                {
+                    out.clear();
+                    return false;
+                }
+                out.resize(size);
+                return true;
+            }
+
+            bool decode(const std::span<const std::uint8_t> payload, const size_t maxSize, std::vector<std::uint8_t>& out) const override
+            {
+                z_stream stream{};
+                if (inflateInit(&stream) != Z_OK)
+                {
+                    return false;
+                }
+
+                stream.next_in = const_cast<Bytef*>(payload.data());
+                stream.avail_in = static_cast<uInt>(payload.size());
+                out.clear();
+                int result = Z_OK;
+                while (result == Z_OK)
+                {
+                    const size_t used = out.size() - (out.empty() ? 0 : stream.avail_out);
+                    if (used >= maxSize)
+                    {
+                        break;
+                    }
+                    out.resize(std::min(maxSize, std::max<size_t>(used * 2, payload.size() * 4 + 64)));
+                    stream.next_out = out.data() + used;
+                    stream.avail_out = static_cast<uInt>(out.size() - used);
+                    result = inflate(&stream, Z_NO_FLUSH);
+                }
+                out.resize(out.size() - stream.avail_out);
+                inflateEnd(&stream);
+                return result == Z_STREAM_END;
+            }
+
+        private:
+            int m_level;
+        };
+    } // namespace
+#endif // REACTORMQ_WITH_ZLIB
+
+    PayloadCodecPtr createDeflatePayloadCodec([[maybe_unused]] const int level)
+    {
+#if REACTORMQ_WITH_ZLIB
+        return std::make_shared<DeflatePayloadCodec>(level);
+#else
+        return nullptr;
+#endif // REACTORMQ_WITH_ZLIB
+    }
+} // namespace reactormq::mqtt
+
+namespace reactormq::mqtt::client
+{
+    const IPayloadCodec* PayloadCodecs::findForTopic(const std::string_view topic) const
+    {
+        const auto it = std::ranges::find_if(
+            m_bindings,
+            [topic](const PayloadCodecBinding& binding)
+            {
+                return matchesFilter(binding.topicFilter, topic);
+            });
+        return it != m_bindings.end() ? it->codec.get() : nullptr;
+    }
+
+    const IPayloadCodec* PayloadCodecs::findByName(const std::string_view name) const
+    {
+        const auto it = std::ranges::find_if(
+            m_bindings,
+            [name](const PayloadCodecBinding& binding)
+            {
+                return binding.codec->getName() == name;
+            });
+        return it != m_bindings.end() ? it->codec.get() : nullptr;
+    }
+
+    bool PayloadCodecs::matchesFilter(std::string_view filter, std::string_view topic)
+    {
+        // Wildcards at the first level do not match topics starting with '$' (MQTT 4.7.2).
+        if (!topic.empty() && topic.front() == '$' && !filter.empty() && (filter.front() == '+' || filter.front() == '#'))
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            const size_t filterEnd = filter.find('/');
+            const std::string_view filterLevel = filter.substr(0, filterEnd);
+            if (filterLevel == "#")
+            {
+                return true;
+            }
+
+            const size_t topicEnd = topic.find('/');
+            if (filterLevel != "+" && filterLevel != topic.substr(0, topicEnd))
+            {
+                return false;
+            }
+
+            if (filterEnd == std::string_view::npos || topicEnd == std::string_view::npos)
+            {
+                // "a/#" also matches "a" itself.
+                return filterEnd == topicEnd || (topicEnd == std::string_view::npos && filter.substr(filterEnd + 1) == "#");
+            }
+            filter.remove_prefix(filterEnd + 1);
+            topic.remove_prefix(topicEnd + 1);
+        }
+    }
+} // namespace reactormq::mqtt::client
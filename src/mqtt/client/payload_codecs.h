@@ -0,0 +1,63 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/payload_codec.h"
+
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The payload codecs configured for a client: which one encodes a topic, and which one a name refers to.
+     * Immutable once built, like the settings it comes from.
+     */
+    class PayloadCodecs final
+    {
+    public:
+        PayloadCodecs() = default;
+
+        /**
+         * @brief Take the bindings from ConnectionSettings::getPayloadCodecs().
+         * @param bindings Codecs and their topic filters, in the order the filters are tried.
+         */
+        explicit PayloadCodecs(std::vector<PayloadCodecBinding> bindings)
+            : m_bindings(std::move(bindings))
+        {
+        }
+
+        /// @brief Whether no codec is configured, so payloads go out and come in as they are.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_bindings.empty();
+        }
+
+        /**
+         * @brief Codec for an outbound message.
+         * @param topic Topic the message is published to.
+         * @return The codec of the first binding whose filter matches, or nullptr.
+         */
+        [[nodiscard]] const IPayloadCodec* findForTopic(std::string_view topic) const;
+
+        /**
+         * @brief Codec a received PUBLISH names in its "payload-codec" User Property.
+         * @param name Value of the property.
+         * @return The codec with that name, or nullptr.
+         */
+        [[nodiscard]] const IPayloadCodec* findByName(std::string_view name) const;
+
+        /**
+         * @brief Whether a topic name matches a topic filter, with the MQTT rules for '+', '#' and '$' topics.
+         * @param filter Topic filter.
+         * @param topic Topic name.
+         * @return True on a match.
+         */
+        [[nodiscard]] static bool matchesFilter(std::string_view filter, std::string_view topic);
+
+    private:
+        std::vector<PayloadCodecBinding> m_bindings;
+    };
+} // namespace reactormq::mqtt::client
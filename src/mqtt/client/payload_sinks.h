@@ -0,0 +1,104 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/payload_codecs.h"
+#include "mqtt/client/topic_router.h"
+#include "reactormq/mqtt/payload_sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The payload sinks of the subscriptions that stream their large messages, by topic filter.
+     * Only PUBLISHes over the inbound streaming threshold are looked up, which are few and large, so the filters are
+     * tried in turn rather than kept in a trie like TopicRouter's. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PayloadSinks final
+    {
+    public:
+        /**
+         * @brief Stream the large messages matching a filter to a sink.
+         * @param filter Topic filter, with '+' and '#' wildcards.
+         * @param sink The sink.
+         */
+        void add(const std::string_view filter, PayloadSinkPtr sink)
+        {
+            m_sinks.emplace_back(std::string(filter), std::move(sink));
+        }
+
+        /**
+         * @brief Drop the sinks of a filter, as when it is unsubscribed.
+         * @param filter Topic filter exactly as it was added.
+         * @return Number of sinks removed.
+         */
+        size_t remove(const std::string_view filter)
+        {
+            return std::erase_if(
+                m_sinks,
+                [filter](const Entry& entry)
+                {
+                    return entry.first == filter;
+                });
+        }
+
+        /**
+         * @brief Sink for a topic.
+         * @param topic Topic name of a streamed PUBLISH.
+         * @return The sink of the first filter that matches, or nullptr.
+         */
+        [[nodiscard]] PayloadSinkPtr find(const std::string_view topic) const
+        {
+            const auto it = std::ranges::find_if(
+                m_sinks,
+                [topic](const Entry& entry)
+                {
+                    return PayloadCodecs::matchesFilter(TopicRouter::stripSharePrefix(entry.first), topic);
+                });
+            return it != m_sinks.end() ? it->second : nullptr;
+        }
+
+        /// @brief Whether no subscription streams its messages.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_sinks.empty();
+        }
+
+    private:
+        using Entry = std::pair<std::string, PayloadSinkPtr>;
+
+        std::vector<Entry> m_sinks;
+    };
+
+    /// @brief Progress through a PUBLISH the socket passes on in fragments; see socket::InboundFrame.
+    struct InboundStream
+    {
+        /// @brief Bytes gathered so far: the packet up to its payload until the header is parsed, or the whole packet
+        /// when it goes through ordinary delivery.
+        std::vector<std::uint8_t> gathered;
+
+        /// @brief Sink the payload goes to; null until the header is parsed, and when no subscription's sink matches.
+        PayloadSinkPtr sink;
+
+        /// @brief Offset of the payload in the packet, once the header has been parsed; 0 before.
+        size_t payloadOffset = 0;
+
+        /// @brief Packet identifier, for QoS 1/2.
+        std::uint16_t packetId = 0;
+
+        /// @brief The rest of the packet is skipped: a duplicate, malformed, or too large for ordinary delivery.
+        bool isSkipped = false;
+
+        /// @brief A skipped packet is still acknowledged once its last byte is in.
+        bool shouldAcknowledge = false;
+    };
+} // namespace reactormq::mqtt::client
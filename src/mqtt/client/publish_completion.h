@@ -0,0 +1,77 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/completion.h"
+#include "reactormq/mqtt/result.h"
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Shared outcome of a publishBatchAsync() call.
+     * The promise is set once every publish of the batch has completed: success if all of them succeeded.
+     * Only touched on the reactor thread.
+     */
+    struct PublishBatch
+    {
+        Completion<void> promise;
+        size_t remaining = 0;
+        bool failed = false;
+    };
+
+    /**
+     * @brief Where a publish reports its outcome: anything a Completion can report to, or its share of a batch.
+     * A default-constructed completion reports to nobody, as for fire-and-forget publishes and those restored from
+     * a session store; it costs no allocation.
+     */
+    class PublishCompletion final
+    {
+    public:
+        PublishCompletion() = default;
+
+        /// @brief Report to a caller's own future.
+        PublishCompletion(std::promise<Result<void>> promise)
+            : m_single(std::move(promise))
+        {
+        }
+
+        /// @brief Report to a handler, run on the reactor thread; an empty handler reports to nobody.
+        explicit PublishCompletion(CompletionHandler<void> handler)
+            : m_single(std::move(handler))
+        {
+        }
+
+        /// @brief Report to a batch; the batch completes when its last publish does.
+        explicit PublishCompletion(std::shared_ptr<PublishBatch> batch)
+            : m_batch(std::move(batch))
+        {
+        }
+
+        void set_value(const Result<void>& result)
+        {
+            if (!m_batch)
+            {
+                m_single.set_value(result);
+                return;
+            }
+
+            const auto batch = std::move(m_batch);
+            batch->failed = batch->failed || !result.hasSucceeded();
+            if (--batch->remaining == 0)
+            {
+                batch->promise.set_value(batch->failed ? Result<void>::failure(ResultError::PartialFailure) : Result<void>::success());
+            }
+        }
+
+    private:
+        Completion<void> m_single;
+        std::shared_ptr<PublishBatch> m_batch;
+    };
+} // namespace reactormq::mqtt::client
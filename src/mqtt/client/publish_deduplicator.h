@@ -0,0 +1,135 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/payload_hash.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/publish_dedup_options.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Hash of the last payload sent on each topic, for suppressing publishes that would repeat it.
+     *
+     * check() hashes a publish's payload and compares it with the topic's entry; record() stores it once the publish
+     * went out, so a publish that failed to send is not remembered. Once the map holds PublishDedupOptions::maxTopics
+     * topics it starts over, like the PUBLISH header templates. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PublishDeduplicator final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit PublishDeduplicator(const PublishDedupOptions& options)
+            : m_options(options)
+        {
+        }
+
+        /**
+         * @brief Whether a publish repeats the last one sent on its topic.
+         * @param message Message to publish.
+         * @param now Current time.
+         * @return The payload hash to pass to record() once the publish is sent; empty if the publish is a repeat and
+         * should be suppressed. A message that is not compared, such as one without the retain flag when only
+         * retained publishes are, is not hashed and gets 0.
+         */
+        [[nodiscard]] std::optional<std::uint64_t> check(const Message& message, const Clock::time_point now) const
+        {
+            if (!isCompared(message))
+            {
+                return 0;
+            }
+
+            const std::uint64_t hash = hashPayload(message.getPayloadView());
+            const auto it = m_entries.find(message.getTopic());
+            if (it == m_entries.end())
+            {
+                return hash;
+            }
+
+            const Entry& entry = it->second;
+            const auto refreshInterval = std::chrono::milliseconds(m_options.refreshIntervalMs);
+            const bool isStale = m_options.refreshIntervalMs != 0 && now - entry.sentAt >= refreshInterval;
+            if (isStale || entry.hash != hash || entry.qos != message.getQualityOfService() || entry.shouldRetain != message.shouldRetain())
+            {
+                return hash;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Remember a publish that was sent.
+         * @param message Message that was sent.
+         * @param hash Payload hash returned by check().
+         * @param now Current time.
+         */
+        void record(const Message& message, const std::uint64_t hash, const Clock::time_point now)
+        {
+            if (!isCompared(message))
+            {
+                return;
+            }
+
+            auto it = m_entries.find(message.getTopic());
+            if (it == m_entries.end())
+            {
+                if (m_entries.size() >= m_options.maxTopics)
+                {
+                    m_entries.clear();
+                }
+                it = m_entries.emplace(message.getTopic(), Entry{}).first;
+            }
+            it->second = Entry{ hash, now, message.getQualityOfService(), message.shouldRetain() };
+        }
+
+        /// @brief Forget every topic, so the next publish on each is sent.
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+        /// @brief Number of topics with a remembered payload.
+        [[nodiscard]] size_t size() const
+        {
+            return m_entries.size();
+        }
+
+    private:
+        [[nodiscard]] bool isCompared(const Message& message) const
+        {
+            return !m_options.isRetainedOnly || message.shouldRetain();
+        }
+
+        struct Entry
+        {
+            std::uint64_t hash = 0;
+            Clock::time_point sentAt{};
+            QualityOfService qos = QualityOfService::AtMostOnce;
+            bool shouldRetain = false;
+        };
+
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        PublishDedupOptions m_options;
+        std::unordered_map<std::string, Entry, StringHash, std::equal_to<>> m_entries;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,317 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/command.h"
+#include "reactormq/mqtt/publish_rate_limit.h"
+#include "reactormq/mqtt/result.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Token buckets of the configured PublishRateLimit entries, with the publishes they hold back.
+     *
+     * admit() costs one lookup of the topic's limit, a refill and a hash map probe, so a publish costs the same no
+     * matter how many are held. A held publish waits in its limit's queue, once per topic: a newer publish on the topic
+     * takes its place in the queue and the older one fails. The reactor asks getNextRelease() for one timer deadline
+     * covering every queue and calls takeReleasable() when it fires. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PublishRateLimiter final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// @brief What admit() did with a publish.
+        enum class Verdict : std::uint8_t
+        {
+            Send, ///< Within its limits: send it now. The tokens are taken.
+            Held, ///< Over its limit: queued until the bucket refills.
+            Replaced, ///< Over its limit: replaced the publish already held on its topic, which failed.
+            Rejected ///< Over its limit: failed.
+        };
+
+        /**
+         * @param limits Configured limits; entries with neither rate set are ignored.
+         * @param maxHeld Most publishes held at once; a publish that would be held beyond this fails instead.
+         */
+        PublishRateLimiter(const std::vector<PublishRateLimit>& limits, const size_t maxHeld)
+            : m_maxHeld(maxHeld)
+        {
+            for (const PublishRateLimit& limit : limits)
+            {
+                if (limit.messagesPerSecond == 0 && limit.bytesPerSecond == 0)
+                {
+                    continue;
+                }
+                if (limit.topicPrefix.empty() && m_clientLimit)
+                {
+                    continue;
+                }
+
+                if (limit.topicPrefix.empty())
+                {
+                    m_clientLimit = m_limits.size();
+                }
+                m_limits.push_back(Limit{ limit.topicPrefix,
+                                          Bucket(limit.messagesPerSecond, limit.burstMs),
+                                          Bucket(limit.bytesPerSecond, limit.burstMs),
+                                          limit.action,
+                                          {} });
+            }
+        }
+
+        /// @brief Number of publishes held back.
+        [[nodiscard]] size_t getHeldCount() const
+        {
+            return m_held.size();
+        }
+
+        /**
+         * @brief Decide whether a publish goes out now.
+         * @param command Publish; moved from when it is held, and its promise completed when it is rejected.
+         * @param now Current time.
+         * @return What happened to the publish.
+         */
+        [[nodiscard]] Verdict admit(PublishCommand& command, const Clock::time_point now)
+        {
+            const std::optional<size_t> index = findLimit(command.message.getTopic());
+            if (!index)
+            {
+                return Verdict::Send;
+            }
+
+            if (const auto held = m_held.find(command.message.getTopic()); held != m_held.end())
+            {
+                held->second.promise.set_value(Result<void>::failure(ResultError::Superseded));
+                held->second = std::move(command);
+                return Verdict::Replaced;
+            }
+
+            // A limit with publishes waiting keeps new topics behind them, so the oldest topic goes first.
+            Limit& limit = m_limits[*index];
+            if (limit.queue.empty() && tryTake(*index, sizeOf(command), now))
+            {
+                return Verdict::Send;
+            }
+
+            if (limit.action == RateLimitAction::Reject || m_held.size() >= m_maxHeld)
+            {
+                command.promise.set_value(Result<void>::failure(ResultError::RateLimited));
+                return Verdict::Rejected;
+            }
+
+            limit.queue.push_back(command.message.getTopic());
+            std::string topic = command.message.getTopic();
+            m_held.emplace(std::move(topic), std::move(command));
+            return Verdict::Held;
+        }
+
+        /**
+         * @brief Take the next held publish its limits now allow, taking its tokens.
+         * @param now Current time.
+         * @return The publish, or empty when every queue is still over its limit.
+         */
+        [[nodiscard]] std::optional<PublishCommand> takeReleasable(const Clock::time_point now)
+        {
+            for (size_t index = 0; index < m_limits.size(); ++index)
+            {
+                Limit& limit = m_limits[index];
+                if (limit.queue.empty())
+                {
+                    continue;
+                }
+
+                const auto held = m_held.find(limit.queue.front());
+                if (!tryTake(index, sizeOf(held->second), now))
+                {
+                    continue;
+                }
+
+                PublishCommand command = std::move(held->second);
+                m_held.erase(held);
+                limit.queue.pop_front();
+                return command;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief When the first held publish can go out.
+         * @param now Current time.
+         * @return Deadline; empty when nothing is held.
+         */
+        [[nodiscard]] std::optional<Clock::time_point> getNextRelease(const Clock::time_point now) const
+        {
+            std::optional<Clock::duration> soonest;
+            for (size_t index = 0; index < m_limits.size(); ++index)
+            {
+                const Limit& limit = m_limits[index];
+                if (limit.queue.empty())
+                {
+                    continue;
+                }
+
+                const double cost = static_cast<double>(sizeOf(m_held.find(limit.queue.front())->second));
+                Clock::duration wait = std::max(limit.messages.getWait(1, now), limit.bytes.getWait(cost, now));
+                if (m_clientLimit && *m_clientLimit != index)
+                {
+                    const Limit& client = m_limits[*m_clientLimit];
+                    wait = std::max({ wait, client.messages.getWait(1, now), client.bytes.getWait(cost, now) });
+                }
+                soonest = soonest ? std::min(*soonest, wait) : wait;
+            }
+
+            if (!soonest)
+            {
+                return std::nullopt;
+            }
+            // Round up so the timer does not fire a hair before the tokens are there.
+            return now + std::max(std::chrono::ceil<std::chrono::milliseconds>(*soonest), std::chrono::milliseconds(1));
+        }
+
+    private:
+        /// @brief Tokens refilled continuously at a fixed rate, up to the burst allowance.
+        class Bucket
+        {
+        public:
+            Bucket(const std::uint32_t perSecond, const std::uint32_t burstMs)
+                : m_perSecond(static_cast<double>(perSecond))
+                , m_capacity(std::max(m_perSecond * static_cast<double>(burstMs) / 1000.0, 1.0))
+                , m_tokens(m_capacity)
+            {
+            }
+
+            [[nodiscard]] bool isLimited() const
+            {
+                return m_perSecond > 0;
+            }
+
+            /// @brief Whether cost can be taken. A cost above the burst allowance goes once the bucket is full.
+            [[nodiscard]] bool canTake(const double cost, const Clock::time_point now) const
+            {
+                return !isLimited() || getTokens(now) >= std::min(cost, m_capacity);
+            }
+
+            /// @brief Take cost; the bucket may go into debt for a publish larger than the burst allowance.
+            void take(const double cost, const Clock::time_point now)
+            {
+                if (isLimited())
+                {
+                    m_tokens = getTokens(now) - cost;
+                    m_refilledAt = now;
+                }
+            }
+
+            /// @brief Time until canTake() would allow cost.
+            [[nodiscard]] Clock::duration getWait(const double cost, const Clock::time_point now) const
+            {
+                const double missing = std::min(cost, m_capacity) - getTokens(now);
+                if (!isLimited() || missing <= 0)
+                {
+                    return Clock::duration::zero();
+                }
+                return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(missing / m_perSecond));
+            }
+
+        private:
+            [[nodiscard]] double getTokens(const Clock::time_point now) const
+            {
+                if (m_refilledAt == Clock::time_point{} || now <= m_refilledAt)
+                {
+                    return m_tokens;
+                }
+                const double elapsed = std::chrono::duration<double>(now - m_refilledAt).count();
+                return std::min(m_tokens + elapsed * m_perSecond, m_capacity);
+            }
+
+            double m_perSecond;
+            double m_capacity;
+            double m_tokens;
+            Clock::time_point m_refilledAt{};
+        };
+
+        struct Limit
+        {
+            std::string topicPrefix;
+            Bucket messages;
+            Bucket bytes;
+            RateLimitAction action;
+            std::deque<std::string> queue; ///< Topics with a held publish, oldest first.
+        };
+
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        [[nodiscard]] static size_t sizeOf(const PublishCommand& command)
+        {
+            const size_t payloadSize = command.stream ? command.stream->getSize() : command.message.getPayloadView().size();
+            return command.message.getTopic().size() + payloadSize;
+        }
+
+        /// @brief The limit with the longest prefix of the topic, else the client-wide limit.
+        [[nodiscard]] std::optional<size_t> findLimit(const std::string_view topic) const
+        {
+            std::optional<size_t> best;
+            for (size_t index = 0; index < m_limits.size(); ++index)
+            {
+                const std::string& prefix = m_limits[index].topicPrefix;
+                if (!prefix.empty() && topic.starts_with(prefix) && (!best || prefix.size() > m_limits[*best].topicPrefix.size()))
+                {
+                    best = index;
+                }
+            }
+            return best ? best : m_clientLimit;
+        }
+
+        /// @brief Take the tokens of a publish from its limit and the client-wide one, if both allow it.
+        [[nodiscard]] bool tryTake(const size_t index, const size_t size, const Clock::time_point now)
+        {
+            const double cost = static_cast<double>(size);
+            Limit& limit = m_limits[index];
+            Limit* client = m_clientLimit && *m_clientLimit != index ? &m_limits[*m_clientLimit] : nullptr;
+            if (!limit.messages.canTake(1, now) || !limit.bytes.canTake(cost, now))
+            {
+                return false;
+            }
+            if (nullptr != client && (!client->messages.canTake(1, now) || !client->bytes.canTake(cost, now)))
+            {
+                return false;
+            }
+
+            limit.messages.take(1, now);
+            limit.bytes.take(cost, now);
+            if (nullptr != client)
+            {
+                client->messages.take(1, now);
+                client->bytes.take(cost, now);
+            }
+            return true;
+        }
+
+        std::vector<Limit> m_limits;
+        std::optional<size_t> m_clientLimit;
+        std::unordered_map<std::string, PublishCommand, StringHash, std::equal_to<>> m_held;
+        size_t m_maxHeld;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,97 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/mqtt_version_mapping.h"
+#include "mqtt/packets/publish_template.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief PUBLISH header templates for the topics this client publishes to, one per topic.
+     *
+     * A topic published with the same QoS, retain flag, topic alias, payload codec and expiry interval as last time
+     * reuses its template; anything else re-encodes it in place. Once the cache holds its maximum it starts over, so publishing
+     * to ever-new topics cannot grow it without bound. Not thread-safe; it belongs to the reactor thread.
+     */
+    class PublishTemplates final
+    {
+    public:
+        /**
+         * @brief The template for a publish, encoding it if the cached one does not fit.
+         * @param version Protocol version of the connection.
+         * @param messageTopic Topic of the message, which keys the cache.
+         * @param sentTopic Topic as sent: messageTopic, or empty when a known Topic Alias stands in for it.
+         * @param qos Quality of Service.
+         * @param shouldRetain Retain flag.
+         * @param topicAlias MQTT 5 Topic Alias property to send, or 0 for none.
+         * @param payloadCodec MQTT 5 payload codec name, or empty.
+         * @param messageExpiryInterval MQTT 5 Message Expiry Interval in seconds, or 0 for none.
+         * @return Reference valid until the next call.
+         */
+        [[nodiscard]] const packets::PublishTemplate& get(
+            const packets::ProtocolVersion version,
+            const std::string_view messageTopic,
+            const std::string& sentTopic,
+            const QualityOfService qos,
+            const bool shouldRetain,
+            const std::uint16_t topicAlias,
+            const std::string_view payloadCodec,
+            const std::uint32_t messageExpiryInterval = 0)
+        {
+            auto it = m_templates.find(messageTopic);
+            if (it == m_templates.end())
+            {
+                if (m_templates.size() >= kMaxTemplates)
+                {
+                    m_templates.clear();
+                }
+                it = m_templates.emplace(std::string(messageTopic), packets::PublishTemplate{}).first;
+            }
+
+            packets::PublishTemplate& cached = it->second;
+            if (!cached.matches(version, sentTopic, qos, shouldRetain, topicAlias, payloadCodec, messageExpiryInterval))
+            {
+                cached = withMqttVersion(
+                    version,
+                    [&]<typename VersionTag>(VersionTag)
+                    {
+                        return packets::PublishTemplate::create<VersionTag::value>(
+                            sentTopic, qos, shouldRetain, topicAlias, payloadCodec, messageExpiryInterval);
+                    });
+            }
+            return cached;
+        }
+
+        /// @brief Number of cached templates.
+        [[nodiscard]] size_t size() const
+        {
+            return m_templates.size();
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        /// @brief Most topics with a cached template; the cache starts over once it is full.
+        static constexpr size_t kMaxTemplates = 256;
+
+        std::unordered_map<std::string, packets::PublishTemplate, StringHash, std::equal_to<>> m_templates;
+    };
+} // namespace reactormq::mqtt::client
@@ -4,22 +4,35 @@
 
 #include "mqtt/client/reactor.h"
 
-#include "mqtt/client/state/disconnected_state.h"
 #include "socket/socket.h"
 #include "util/logging/logging.h"
+#include "util/trace/memory_tags.h"
+#include "util/trace/trace.h"
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
 
 namespace reactormq::mqtt::client
 {
-    Reactor::Reactor(const ConnectionSettingsPtr& settings)
+    Reactor::Reactor(const ConnectionSettingsPtr& settings, std::shared_ptr<socket::WakeupHandle> wakeup)
         : m_context(settings)
-        , m_currentState(std::make_unique<DisconnectedState>())
+        , m_wakeup(std::make_shared<WakeupRoute>(wakeup ? std::move(wakeup) : std::make_shared<socket::WakeupHandle>()))
+        , m_spinBackoff(settings ? settings->getBusyPoll() : BusyPollOptions{})
     {
         REACTORMQ_LOG(
             logging::LogLevel::Info,
             "Reactor::Reactor() created (initialState=%s)",
-            m_currentState ? m_currentState->getStateName() : "None");
+            getCurrentStateName());
+
+        m_context.setDeliveryWakeup(m_wakeup);
+        if (settings && settings->getFixedCapacity().isEnabled)
+        {
+            m_commandQueue.preallocate(settings->getMaxPendingCommands());
+        }
 
         m_socketReplacedHandle = m_context.getOnSocketReplaced().add(
             [this]
@@ -28,10 +41,7 @@ namespace reactormq::mqtt::client
                 setupSocketCallbacks();
             });
 
-        if (m_currentState)
-        {
-            m_currentState->onEnter(m_context);
-        }
+        (void)visitState([this](auto& state) { return state.onEnter(m_context); });
     }
 
     Reactor::~Reactor()
@@ -39,133 +49,518 @@ namespace reactormq::mqtt::client
         REACTORMQ_LOG(
             logging::LogLevel::Info,
             "Reactor::~Reactor() (currentState=%s)",
-            nullptr != m_currentState ? m_currentState->getStateName() : "None");
+            getCurrentStateName());
 
         m_socketReplacedHandle.disconnect();
 
-        if (m_currentState)
-        {
-            m_currentState->onExit(m_context);
-        }
+        visitState([this](auto& state) { state.onExit(m_context); });
+        m_context.flushCallbacks();
     }
 
     void Reactor::enqueueCommand(Command command)
     {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ);
+        m_commandQueue.push(std::move(command));
+        REACTORMQ_LOG(logging::LogLevel::Debug, "Reactor::enqueueCommand() queued command (queueSize=%zu)", m_commandQueue.getDepth());
+
+        m_wakeup->signal();
+    }
+
+    void Reactor::setWakeup(std::shared_ptr<socket::WakeupHandle> wakeup)
+    {
+        m_wakeup->retarget(std::move(wakeup));
+    }
+
+    void Reactor::tick()
+    {
+        REACTORMQ_TRACE_SCOPE("Reactor::tick");
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ);
+        const auto tickStart = std::chrono::steady_clock::now();
+        m_context.setNow(tickStart);
+        REACTORMQ_LOG(logging::LogLevel::Trace, "Reactor::tick() (state=%s) (", getCurrentStateName());
+
+        // Everything the state machine emits this tick goes out in one write at the end (or earlier, once the
+        // coalescing caps are hit). A socket replaced mid-tick is flushed through the pointer captured here.
+        const auto coalescingSocket = m_context.getSocket();
+        if (coalescingSocket)
+        {
+            coalescingSocket->beginCoalescing();
+        }
+
+        TickProfiler* profiler = m_context.getTickProfiler();
         {
-            std::scoped_lock lock(m_commandQueueMutex);
-            m_commandQueue.push_back(std::move(command));
+            const TickPhaseScope phaseScope(profiler, TickPhase::Commands);
+            processCommandQueue();
+
+            // Acknowledge the messages handled since the last tick and resume reading before the socket is serviced.
+            m_context.completeDeliveries();
+        }
+
+        {
+            const TickPhaseScope phaseScope(profiler, TickPhase::StateTick);
+
+            // Lowered before the state looks, so a result set from here on wakes the next wait.
+            m_context.clearAsyncResults();
+            transitionToState(visitState([this](auto& state) { return state.onTick(m_context); }));
 
-            REACTORMQ_LOG(logging::LogLevel::Debug, "Reactor::enqueueCommand() queued command (queueSize=%zu)", m_commandQueue.size());
+            fireExpiredTimers();
+        }
+
+        if (const auto sock = m_context.getSocket())
+        {
+            {
+                const TickPhaseScope phaseScope(profiler, TickPhase::SocketRead);
+                sock->tick();
+            }
+            m_inboundBacklogBytes.store(sock->getInboundBacklogBytes(), std::memory_order_relaxed);
+        }
+        else
+        {
+            m_inboundBacklogBytes.store(0, std::memory_order_relaxed);
+        }
+
+        // Messages held back by delivery priority take what budget the tick's reads left.
+        m_context.deliverWaitingMessages();
+
+        // Persist this tick's session changes before its acknowledgements leave, so one sync covers them all.
+        m_context.commitSessionStore();
+
+        if (coalescingSocket)
+        {
+            coalescingSocket->flushCoalesced();
+        }
+
+        // Every packet decoded this tick has been handled and released by now.
+        m_context.resetPacketArena();
+        m_context.resetTickTime();
+
+        m_context.flushCallbacks();
+
+        ClientMetricCounters& metrics = m_context.getMetricCounters();
+        const auto sock = m_context.getSocket();
+        metrics.inFlightCommands.store(m_context.getPendingCommandCount(), std::memory_order_relaxed);
+        metrics.outboundQueueBytes.store(
+            m_context.getOutboundQueueSize() + (sock ? sock->getPendingSendBytes() : 0), std::memory_order_relaxed);
+        metrics.offlinePublishes.store(m_context.getOfflinePublishes().size(), std::memory_order_relaxed);
+        const auto tickEnd = std::chrono::steady_clock::now();
+        m_context.recordTraffic(tickEnd);
+        const auto tickDuration = tickEnd - tickStart;
+        metrics.recordTick(tickDuration);
+        if (profiler)
+        {
+            profiler->endTick(tickDuration);
         }
     }
 
-    void Reactor::tick()
+    TickProfile Reactor::getTickProfile() const
+    {
+        const TickProfiler* profiler = m_context.getTickProfiler();
+        return profiler ? profiler->getProfile() : TickProfile{};
+    }
+
+    InboundTraffic Reactor::getInboundTraffic() const
+    {
+        const TrafficAccounting* accounting = m_context.getTrafficAccounting();
+        return accounting ? accounting->getReport() : InboundTraffic{};
+    }
+
+    std::shared_ptr<const Message> Reactor::getLastValue(const std::string_view topic) const
+    {
+        const LastValueCache* lastValues = m_context.getLastValues();
+        return lastValues ? lastValues->find(topic) : nullptr;
+    }
+
+    ClientMetrics Reactor::getMetrics() const
+    {
+        ClientMetrics metrics;
+        m_context.getMetricCounters().fill(metrics);
+        metrics.commandQueueDepth = getCommandQueueDepth();
+        metrics.inboundBacklogBytes = getInboundBacklogBytes();
+        metrics.pendingDeliveries = m_context.getPendingDeliveryCount();
+        return metrics;
+    }
+
+    void Reactor::waitAndTick(const std::chrono::milliseconds maxWait)
     {
-        REACTORMQ_LOG(logging::LogLevel::Trace, "Reactor::tick() (state=%s) (", m_currentState ? m_currentState->getStateName() : "None");
+        waitForWork(maxWait);
+        tick();
+    }
 
-        processCommandQueue();
+    void Reactor::waitForWork(const std::chrono::milliseconds maxWait)
+    {
+        // Reset before checking the queue: a command enqueued after this point re-latches the wakeup, and one
+        // enqueued before it is seen by the check below.
+        const auto wakeup = m_wakeup->get();
+        wakeup->reset();
 
-        if (m_currentState)
+        if (m_commandQueue.getDepth() > 0 || m_context.hasCompletedDeliveries() || m_context.hasAsyncResults())
         {
-            auto [newState] = m_currentState->onTick(m_context);
-            if (newState.has_value())
+            m_spinBackoff.reset();
+            return;
+        }
+
+        // Busy polling: the tick's non-blocking read is the poll, so only back off while ticks come up empty.
+        if (m_spinBackoff.isEnabled())
+        {
+            if (const auto received = m_context.getLastReceiveTime(); received != m_lastPolledReceiveTime)
+            {
+                m_lastPolledReceiveTime = received;
+                m_spinBackoff.reset();
+            }
+            else
             {
-                transitionToState(std::move(newState.value()));
+                m_spinBackoff.idle();
             }
+            return;
         }
 
+        std::chrono::milliseconds timeout = maxWait;
+        if (const auto deadline = getNextDeadline())
+        {
+            const auto untilDeadline = std::chrono::ceil<std::chrono::milliseconds>(deadline.value() - std::chrono::steady_clock::now());
+            timeout = std::clamp(untilDeadline, std::chrono::milliseconds::zero(), maxWait);
+        }
+
+        if (timeout <= std::chrono::milliseconds::zero())
+        {
+            return;
+        }
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Trace,
+            "Reactor::waitForWork() waiting up to %ums (state=%s)",
+            static_cast<std::uint32_t>(std::min<std::chrono::milliseconds::rep>(timeout.count(), UINT32_MAX)),
+            getCurrentStateName());
+
         if (const auto sock = m_context.getSocket())
         {
-            sock->tick();
+            sock->waitForActivity(*wakeup, timeout);
+        }
+        else
+        {
+            wakeup->waitFor(timeout);
         }
     }
 
-    const char* Reactor::getCurrentStateName() const
+    std::optional<std::chrono::steady_clock::time_point> Reactor::getNextDeadline() const
     {
-        const char* name = m_currentState ? m_currentState->getStateName() : "None";
-        REACTORMQ_LOG(logging::LogLevel::Trace, "Reactor::getCurrentStateName() -> %s", name);
-        return name;
+        return m_context.getTimers().getNextDeadline();
     }
 
-    bool Reactor::isConnected() const
+    void Reactor::fireExpiredTimers()
     {
-        if (!m_currentState)
+        const auto now = m_context.getNow();
+        auto& timers = m_context.getTimers();
+        while (const auto timer = timers.popExpired(now))
         {
-            REACTORMQ_LOG(logging::LogLevel::Trace, "Reactor::isConnected() -> false (no current state)");
-            return false;
+            // A request waits for its response through reconnects, so its timeout belongs to no one state.
+            if (timer->kind == TimerKind::RequestTimeout)
+            {
+                m_context.expireRequest(timer->id);
+                continue;
+            }
+
+            // A transition can cancel or schedule timers; popExpired() only ever returns live ones.
+            transitionToState(visitState([this, &timer](auto& state) { return state.onTimer(m_context, *timer); }));
+        }
+    }
+
+    socket::PollRegistration Reactor::getPollRegistration() const
+    {
+        const auto sock = m_context.getSocket();
+        return sock ? sock->getPollRegistration() : socket::PollRegistration{};
+    }
+
+    void Reactor::transitionToState(StateTransition transition)
+    {
+        // A state whose onEnter moves straight on is followed here, so chains of transitions do not recurse.
+        while (transition.newState.has_value())
+        {
+            // Publishes gathered so far leave before whatever the next state sends, such as a DISCONNECT.
+            m_context.flushOutboundBatch();
+
+            const char* fromName = getCurrentStateName();
+            visitState([this](auto& state) { state.onExit(m_context); });
+            emplaceState(*transition.newState);
+
+            const char* toName = getCurrentStateName();
+            REACTORMQ_TRACE_SCOPE_TEXT("Reactor::transitionToState", toName);
+            REACTORMQ_LOG(logging::LogLevel::Info, "Reactor::transitionToState() %s -> %s", fromName, toName);
+
+            transition = visitState([this](auto& state) { return state.onEnter(m_context); });
+            if (transition.newState.has_value())
+            {
+                REACTORMQ_LOG(logging::LogLevel::Debug, "Reactor::transitionToState() chaining transition from state=%s", toName);
+            }
+        }
+    }
+
+    void Reactor::emplaceState(StateTransition::Target& target)
+    {
+        switch (target.id)
+        {
+        case StateId::Disconnected:
+            m_currentState.emplace<DisconnectedState>(target.wasGracefulDisconnect);
+            break;
+        case StateId::Connecting:
+            m_currentState.emplace<ConnectingState>(target.cleanSession, std::move(target.promise));
+            break;
+        case StateId::Ready:
+            m_currentState.emplace<ReadyState>();
+            break;
+        case StateId::Closing:
+            m_currentState.emplace<ClosingState>(std::move(target.promise));
+            break;
+        }
+        m_stateId.store(target.id, std::memory_order_relaxed);
+    }
+
+    void Reactor::processCommandQueue()
+    {
+        size_t batchSize = m_commandQueue.getDepth();
+        if (batchSize == 0)
+        {
+            return;
+        }
+        REACTORMQ_TRACE_SCOPE("Reactor::processCommandQueue");
+
+        // Over budget, the rest stays queued; a non-empty queue keeps the next wait from blocking.
+        const auto& settings = m_context.getSettings();
+        const std::uint32_t maxCommands = settings ? settings->getMaxCommandsPerTick() : 0;
+        const std::chrono::microseconds maxTime{ settings ? settings->getMaxCommandProcessingTimeUs() : 0 };
+        const auto start = m_context.getNow();
+        if (maxCommands != 0)
+        {
+            batchSize = std::min<size_t>(batchSize, maxCommands);
         }
 
-        const bool connected = (m_currentState->getStateId() == StateId::Ready);
         REACTORMQ_LOG(
-            logging::LogLevel::Trace,
-            "Reactor::isConnected() -> %s (state=%s)",
-            connected ? "true" : "false",
-            m_currentState->getStateName());
-        return connected;
+            logging::LogLevel::Debug,
+            "Reactor::processCommandQueue() processing %zu command(s) (state=%s)",
+            batchSize,
+            getCurrentStateName());
+
+        // The publishes of this batch of commands are encoded into one buffer and written together.
+        m_context.beginOutboundBatch();
+        for (size_t processed = 0; processed < batchSize; ++processed)
+        {
+            if (maxTime.count() > 0 && processed > 0 && std::chrono::steady_clock::now() - start >= maxTime)
+            {
+                break;
+            }
+
+            std::optional<Command> cmd = m_commandQueue.tryPop();
+            if (!cmd.has_value())
+            {
+                break; // a producer is mid-push; its wakeup brings us back
+            }
+
+            dispatchCommand(cmd.value());
+        }
+        m_context.endOutboundBatch();
     }
 
-    void Reactor::transitionToState(StatePtr toState)
+    void Reactor::dispatchCommand(Command& command)
     {
-        if (!toState)
+        if (auto* batchCmd = std::get_if<PublishBatchCommand>(&command))
+        {
+            if (batchCmd->messages.empty())
+            {
+                batchCmd->promise.set_value(Result<void>::success());
+                return;
+            }
+
+            // Each publish completes its share of the batch; the last one to finish sets the caller's future.
+            auto batch = std::make_shared<PublishBatch>();
+            batch->promise = std::move(batchCmd->promise);
+            batch->remaining = batchCmd->messages.size();
+
+            for (auto& message : batchCmd->messages)
+            {
+                Command publish = PublishCommand{ std::move(message), PublishCompletion(batch), batchCmd->enqueuedAt };
+                dispatchCommand(publish);
+            }
+            return;
+        }
+
+        if (auto* chunkedCmd = std::get_if<PublishChunkedCommand>(&command))
         {
-            REACTORMQ_LOG(logging::LogLevel::Warn, "Reactor::transitionToState() called with null target state");
+            pumpChunkedTransfer(chunkedCmd->transfer);
             return;
         }
 
-        const char* fromName = m_currentState ? m_currentState->getStateName() : "None";
-        const char* toName = toState->getStateName();
+        if (auto* setCmd = std::get_if<SetSubscriptionsCommand>(&command))
+        {
+            dispatchSetSubscriptions(*setCmd);
+            return;
+        }
 
-        REACTORMQ_LOG(logging::LogLevel::Info, "Reactor::transitionToState() %s -> %s", fromName, toName);
+        transitionToState(visitState([this, &command](auto& state) { return state.handleCommand(m_context, command); }));
+    }
 
-        if (m_currentState)
+    void Reactor::dispatchSetSubscriptions(SetSubscriptionsCommand& command)
+    {
+        if (m_stateId.load(std::memory_order_relaxed) != StateId::Ready)
         {
-            m_currentState->onExit(m_context);
+            command.promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::NotConnected));
+            return;
         }
 
-        m_currentState = std::move(toState);
+        SubscriptionCache& subscriptions = m_context.getSubscriptionCache();
+        std::vector<TopicFilter> toSubscribe;
+        std::vector<std::string> toUnsubscribe;
+        subscriptions.diff(command.topicFilters, toSubscribe, toUnsubscribe);
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "Reactor::dispatchSetSubscriptions() %zu filter(s): subscribing %zu, unsubscribing %zu",
+            command.topicFilters.size(),
+            toSubscribe.size(),
+            toUnsubscribe.size());
 
-        auto [newState] = m_currentState->onEnter(m_context);
+        if (toSubscribe.empty() && toUnsubscribe.empty())
+        {
+            command.promise.set_value(Result<std::vector<SubscribeResult>>::success({}));
+            return;
+        }
+
+        auto update = std::make_shared<SubscriptionSetUpdate>();
+        update->promise = std::move(command.promise);
+        update->remaining = (toSubscribe.empty() ? 0 : 1) + (toUnsubscribe.empty() ? 0 : 1);
 
-        if (newState.has_value())
+        // Subscribe before unsubscribing, so a filter swapped for a wider or narrower one loses no messages between.
+        if (!toSubscribe.empty())
         {
-            REACTORMQ_LOG(
-                logging::LogLevel::Debug,
-                "Reactor::transitionToState() chaining transition from state=%s",
-                m_currentState ? m_currentState->getStateName() : "None");
-            transitionToState(std::move(newState.value()));
+            update->isSubscribing = true;
+            Command subscribe = SubscribesCommand{ toSubscribe,
+                                                   Completion<std::vector<SubscribeResult>>(
+                                                       [update](const Result<std::vector<SubscribeResult>>& result)
+                                                       {
+                                                           update->isSubscribing = false;
+                                                           if (!result.hasSucceeded())
+                                                           {
+                                                               update->complete(result.getError());
+                                                               return;
+                                                           }
+                                                           update->subscribed = std::move(*result.getResult());
+                                                           update->complete(std::nullopt);
+                                                       }) };
+            dispatchCommand(subscribe);
+
+            // Sent: counted as subscribed from now on, so another update before the SUBACK does not send them again.
+            // A refusal in the SUBACK forgets them.
+            if (update->isSubscribing)
+            {
+                for (const TopicFilter& topicFilter : toSubscribe)
+                {
+                    subscriptions.remember(topicFilter);
+                }
+            }
+        }
+
+        if (!toUnsubscribe.empty())
+        {
+            Command unsubscribe = UnsubscribesCommand{ std::move(toUnsubscribe),
+                                                       Completion<std::vector<UnsubscribeResult>>(
+                                                           [update](const Result<std::vector<UnsubscribeResult>>& result)
+                                                           {
+                                                               update->complete(
+                                                                   result.hasSucceeded() ? std::nullopt
+                                                                                         : std::optional(result.getError()));
+                                                           }) };
+            dispatchCommand(unsubscribe);
         }
     }
 
-    void Reactor::processCommandQueue()
+    void Reactor::pumpChunkedTransfer(const std::shared_ptr<ChunkedTransfer>& transfer)
     {
-        std::deque<Command> commands;
+        transfer->isPumpQueued = false;
+        if (transfer->isFinished)
         {
-            std::scoped_lock lock(m_commandQueueMutex);
-            commands.swap(m_commandQueue);
+            return;
         }
 
-        if (!commands.empty())
+        const std::uint64_t totalSize = transfer->source->getSize();
+        if (transfer->chunkSize == 0)
         {
+            // Fixed header, topic, packet ID and a property block, with room for the properties a publish may gain.
+            constexpr size_t kPublishOverhead = 64;
+            const size_t overhead = kChunkHeaderSize + kPublishOverhead + transfer->topic.size();
+            const std::uint32_t maxPacketSize = m_context.getBrokerMaximumPacketSize();
+            if (maxPacketSize <= overhead)
+            {
+                transfer->finish(Result<void>::failure(ResultError::PacketTooLarge, "Maximum Packet Size leaves no room for a chunk"));
+                return;
+            }
+
+            const auto chunkSize = std::min<std::uint32_t>(
+                std::max<std::uint32_t>(transfer->options.chunkSize, 1), maxPacketSize - static_cast<std::uint32_t>(overhead));
+            const std::uint64_t chunkCount = std::max<std::uint64_t>((totalSize + chunkSize - 1) / chunkSize, 1);
+            if (chunkCount > std::numeric_limits<std::uint32_t>::max())
+            {
+                transfer->finish(Result<void>::failure(ResultError::PacketTooLarge, "Payload needs too many chunks"));
+                return;
+            }
+
+            std::random_device random;
+            transfer->transferId = static_cast<std::uint64_t>(random()) << 32 | random();
+            transfer->chunkSize = chunkSize;
+            transfer->chunkCount = static_cast<std::uint32_t>(chunkCount);
             REACTORMQ_LOG(
                 logging::LogLevel::Debug,
-                "Reactor::processCommandQueue() processing %zu command(s) (state=%s)",
-                commands.size(),
-                m_currentState ? m_currentState->getStateName() : "None");
+                "Reactor::pumpChunkedTransfer() %llu byte(s) to %s in %u chunk(s) of %u",
+                static_cast<unsigned long long>(totalSize),
+                transfer->topic.c_str(),
+                transfer->chunkCount,
+                transfer->chunkSize);
         }
 
-        for (auto& cmd : commands)
+        // Capped per call as well, since QoS 0 chunks complete as they are sent and never fill the window.
+        const std::uint32_t window = std::max<std::uint32_t>(transfer->options.window, 1);
+        for (std::uint32_t published = 0;
+             published < window && transfer->inFlight < window && transfer->nextSequence < transfer->chunkCount && !transfer->isFinished;
+             ++published)
         {
-            if (!m_currentState)
+            const std::uint64_t offset = static_cast<std::uint64_t>(transfer->nextSequence) * transfer->chunkSize;
+            const auto bodySize = static_cast<size_t>(std::min<std::uint64_t>(transfer->chunkSize, totalSize - offset));
+            std::vector<std::uint8_t> payload(kChunkHeaderSize + bodySize);
+            const std::span<std::uint8_t> body = std::span(payload).subspan(kChunkHeaderSize);
+            if (!body.empty() && transfer->source->read(body) != body.size())
             {
-                REACTORMQ_LOG(logging::LogLevel::Warn, "Reactor::processCommandQueue() command skipped (no current state)");
-                break;
+                transfer->finish(Result<void>::failure(ResultError::PayloadSourceFailed, "Payload source ended early"));
+                return;
             }
+            ChunkHeader{ transfer->transferId, transfer->nextSequence, transfer->chunkCount, totalSize }.encode(
+                std::span(payload).first<kChunkHeaderSize>());
+            ++transfer->nextSequence;
+            ++transfer->inFlight;
 
-            auto [newState] = m_currentState->handleCommand(m_context, cmd);
-            if (newState.has_value())
-            {
-                transitionToState(std::move(newState.value()));
-            }
+            PublishCompletion completion(CompletionHandler<void>(
+                [transfer, weakSelf = weak_from_this()](const Result<void>& result)
+                {
+                    --transfer->inFlight;
+                    if (!result.hasSucceeded())
+                    {
+                        transfer->finish(result);
+                        return;
+                    }
+                    if (++transfer->acknowledged == transfer->chunkCount)
+                    {
+                        transfer->finish(Result<void>::success());
+                        return;
+                    }
+                    if (transfer->isFinished || transfer->isPumpQueued || transfer->nextSequence == transfer->chunkCount)
+                    {
+                        return;
+                    }
+                    if (const auto self = weakSelf.lock())
+                    {
+                        transfer->isPumpQueued = true;
+                        self->enqueueCommand(PublishChunkedCommand{ transfer });
+                    }
+                }));
+            Message chunk{ transfer->topic, SharedPayload{ std::move(payload) }, false, transfer->options.qualityOfService };
+            Command publish = PublishCommand{ std::move(chunk), std::move(completion) };
+            dispatchCommand(publish);
         }
     }
 
@@ -187,20 +582,11 @@ namespace reactormq::mqtt::client
                     logging::LogLevel::Info,
                     "Reactor socket onConnect callback (success=%s, state=%s)",
                     wasSuccessful ? "true" : "false",
-                    m_currentState ? m_currentState->getStateName() : "None");
+                    getCurrentStateName());
 
-                if (nullptr == m_currentState)
-                {
-                    return;
-                }
-
-                auto [newState]
-                    = wasSuccessful ? m_currentState->onSocketConnected(m_context) : m_currentState->onSocketDisconnected(m_context);
-
-                if (newState.has_value())
-                {
-                    transitionToState(std::move(newState.value()));
-                }
+                transitionToState(visitState(
+                    [this, wasSuccessful](auto& state)
+                    { return wasSuccessful ? state.onSocketConnected(m_context) : state.onSocketDisconnected(m_context); }));
             });
 
         sock->getOnDisconnectCallback().add(this,
@@ -209,18 +595,9 @@ namespace reactormq::mqtt::client
                 REACTORMQ_LOG(
                     logging::LogLevel::Info,
                     "Reactor socket onDisconnect callback (state=%s)",
-                    m_currentState ? m_currentState->getStateName() : "None");
-
-                if (!m_currentState)
-                {
-                    return;
-                }
+                    getCurrentStateName());
 
-                auto [newState] = m_currentState->onSocketDisconnected(m_context);
-                if (newState.has_value())
-                {
-                    transitionToState(std::move(newState.value()));
-                }
+                transitionToState(visitState([this](auto& state) { return state.onSocketDisconnected(m_context); }));
 
                 m_context.invokeCallback(
                     [&ctx = m_context]
@@ -230,24 +607,30 @@ namespace reactormq::mqtt::client
                     });
             });
 
-        sock->getOnDataReceivedCallback().add(this,
-            [this](const uint8_t* data, const uint32_t size)
+        sock->getOnDataReceivedBatchCallback().add(this,
+            [this](const std::span<const socket::InboundFrame> frames, size_t& handled)
             {
                 REACTORMQ_LOG(
                     logging::LogLevel::Trace,
-                    "Reactor socket onDataReceived callback (size=%u, state=%s)",
-                    size,
-                    m_currentState ? m_currentState->getStateName() : "None");
-
-                if (!m_currentState)
+                    "Reactor socket onDataReceivedBatch callback (frames=%zu, state=%s)",
+                    frames.size(),
+                    getCurrentStateName());
+
+                const TickPhaseScope phaseScope(m_context.getTickProfiler(), TickPhase::Parse);
+                // A packet that changes state leaves the rest of the batch to the state it changed to; one that pauses
+                // receiving leaves it in the socket.
+                handled = 0;
+                while (handled < frames.size())
                 {
-                    return;
-                }
-
-                auto [newState] = m_currentState->onDataReceived(m_context, data, size);
-                if (newState.has_value())
-                {
-                    transitionToState(std::move(newState.value()));
+                    const std::span<const socket::InboundFrame> remaining = frames.subspan(handled);
+                    size_t handledByState = 0;
+                    transitionToState(
+                        visitState([&](auto& state) { return state.onDataReceivedBatch(m_context, remaining, handledByState); }));
+                    handled += handledByState;
+                    if (m_context.isReceivePaused())
+                    {
+                        break;
+                    }
                 }
             });
 
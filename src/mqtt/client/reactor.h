@@ -6,19 +6,33 @@
 
 #include "mqtt/client/command.h"
 #include "mqtt/client/context.h"
+#include "mqtt/client/mpsc_queue.h"
+#include "mqtt/client/spin_backoff.h"
+#include "mqtt/client/state/closing_state.h"
+#include "mqtt/client/state/connecting_state.h"
+#include "mqtt/client/state/disconnected_state.h"
+#include "mqtt/client/state/ready_state.h"
 #include "mqtt/client/state/state.h"
+#include "mqtt/client/wakeup_route.h"
+#include "reactormq/mqtt/client_metrics.h"
 #include "reactormq/mqtt/connection_settings.h"
+#include "socket/platform/poller.h"
+#include "socket/platform/wakeup_handle.h"
 
-#include <deque>
+#include <atomic>
+#include <chrono>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <utility>
+#include <variant>
 
 namespace reactormq::mqtt::client
 {
     /**
      * @brief Reactor that drives the event loop, state machine, and command queue.
      * Owns the current State, Context, and command queue.
-     * Dispatches events and commands to the active state.
+     * Dispatches events and commands to the active state. The state is held by value, so transitions reuse its storage
+     * instead of allocating, and each event is dispatched to the state's concrete type.
      */
     class Reactor : public std::enable_shared_from_this<Reactor>
     {
@@ -26,17 +40,29 @@ namespace reactormq::mqtt::client
         /**
          * @brief Constructor.
          * @param settings Connection settings for the MQTT client.
+         * @param wakeup Wakeup signalled when a command is enqueued; shared when several reactors are driven by one
+         * thread (see ReactorGroup). A private handle is created if null.
          */
-        explicit Reactor(const ConnectionSettingsPtr& settings);
+        explicit Reactor(const ConnectionSettingsPtr& settings, std::shared_ptr<socket::WakeupHandle> wakeup = nullptr);
 
         ~Reactor();
 
         /**
          * @brief Enqueue a command for execution on the reactor thread.
+         * Wakes a reactor blocked in waitAndTick() so the command runs immediately.
          * @param command The command to enqueue.
          */
         void enqueueCommand(Command command);
 
+        /**
+         * @brief Move the reactor's wakeup to another handle, as when a ReactorGroup moves it to another thread.
+         * Commands, deliveries and async results signal the new handle from then on; it is signalled once so nothing
+         * raised against the old one is missed. Safe from any thread, but the reactor must not be waiting on the old
+         * handle in waitAndTick().
+         * @param wakeup New wakeup; must not be null.
+         */
+        void setWakeup(std::shared_ptr<socket::WakeupHandle> wakeup);
+
         /**
          * @brief Tick the reactor (one iteration of the event loop).
          * Processes command queue, ticks current state, and ticks socket.
@@ -44,16 +70,117 @@ namespace reactormq::mqtt::client
         void tick();
 
         /**
-         * @brief Get the name of the current state.
+         * @brief Block until there is work, then tick once (blocking run mode).
+         * Waits for socket readiness, the current state's next timer deadline, or a command enqueued from another
+         * thread, whichever comes first, capped at maxWait. An idle client therefore sleeps instead of spinning,
+         * unless the settings turn on busy polling: then it never sleeps, and only backs off between ticks that find
+         * nothing, so it returns within a few pauses once data or a command arrives.
+         * @param maxWait Upper bound on the time spent waiting before the tick.
+         */
+        void waitAndTick(std::chrono::milliseconds maxWait);
+
+        /**
+         * @brief Earliest deadline in the reactor's timer queue (keepalive, timeouts, retry backoff, in-flight publishes).
+         * @return Next deadline, or std::nullopt if no timer is pending.
+         */
+        [[nodiscard]] std::optional<std::chrono::steady_clock::time_point> getNextDeadline() const;
+
+        /**
+         * @brief Handle and readiness the current socket is waiting for, for callers that poll many reactors at once.
+         * @return Poll registration; an invalid handle when there is no socket or it cannot be polled.
+         */
+        [[nodiscard]] socket::PollRegistration getPollRegistration() const;
+
+        /**
+         * @brief Whether a message handler has finished since the last tick, leaving a PUBACK to send or a paused
+         * receive to resume, or a message is waiting for delivery budget. Reactor thread only; callers that poll many
+         * reactors tick the ones that report true.
+         */
+        [[nodiscard]] bool hasCompletedDeliveries() const
+        {
+            return m_context.hasCompletedDeliveries();
+        }
+
+        /**
+         * @brief Whether a call the state machine waits on, such as an asynchronous credentials provider, has completed
+         * since the last tick. Safe from any thread; callers that poll many reactors tick the ones that report true.
+         */
+        [[nodiscard]] bool hasAsyncResults() const
+        {
+            return m_context.hasAsyncResults();
+        }
+
+        /**
+         * @brief Number of commands enqueued but not yet processed (for monitoring).
+         * @return Approximate queue depth; safe to call from any thread.
+         */
+        [[nodiscard]] size_t getCommandQueueDepth() const
+        {
+            return m_commandQueue.getDepth();
+        }
+
+        /**
+         * @brief Inbound bytes held back by the per-tick inbound budget as of the last tick (for monitoring).
+         * @return Backlog size in bytes; safe to call from any thread.
+         */
+        [[nodiscard]] size_t getInboundBacklogBytes() const
+        {
+            return m_inboundBacklogBytes.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Snapshot of the client's counters and gauges (for monitoring).
+         * @return Metrics; safe to call from any thread.
+         */
+        [[nodiscard]] ClientMetrics getMetrics() const;
+
+        /**
+         * @brief Rolling per-phase timings of recent ticks (for frame budgets).
+         * @return Profile; empty unless tick profiling is enabled. Safe to call from any thread.
+         */
+        [[nodiscard]] TickProfile getTickProfile() const;
+
+        /**
+         * @brief Per-subscription and per-topic-prefix inbound counts (for capacity planning).
+         * @return Counts; empty unless traffic accounting is enabled. Safe to call from any thread.
+         */
+        [[nodiscard]] InboundTraffic getInboundTraffic() const;
+
+        /**
+         * @brief Latest message kept for a topic (for polling current values).
+         * @param topic Exact topic name.
+         * @return The message, or nullptr; always nullptr unless the last-value cache is enabled. Safe to call from any
+         * thread.
+         */
+        [[nodiscard]] std::shared_ptr<const Message> getLastValue(std::string_view topic) const;
+
+        /**
+         * @brief Get the current state. Safe to call from any thread; a single relaxed atomic load.
+         * @return The state the reactor thread last entered.
+         */
+        [[nodiscard]] StateId getStateId() const
+        {
+            return m_stateId.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the name of the current state. Safe to call from any thread.
          * @return State name string.
          */
-        [[nodiscard]] const char* getCurrentStateName() const;
+        [[nodiscard]] const char* getCurrentStateName() const
+        {
+            return stateIdToString(getStateId());
+        }
 
         /**
-         * @brief Check if the reactor is in the connected state.
+         * @brief Check if the reactor is in the connected state. Safe to call from any thread, and cheap enough to poll
+         * every frame.
          * @return True if connected, false otherwise.
          */
-        [[nodiscard]] bool isConnected() const;
+        [[nodiscard]] bool isConnected() const
+        {
+            return getStateId() == StateId::Ready;
+        }
 
         /**
          * @brief Get the shared context.
@@ -65,26 +192,90 @@ namespace reactormq::mqtt::client
         }
 
     private:
+        /// @brief Every state the reactor can be in.
+        using StateVariant = std::variant<DisconnectedState, ConnectingState, ReadyState, ClosingState>;
+
+        /**
+         * @brief Call a handler with the current state as its concrete type.
+         * @param handler Callable taking any of the states by reference.
+         * @return Whatever the handler returns.
+         */
+        template<typename Handler>
+        decltype(auto) visitState(Handler&& handler)
+        {
+            return std::visit(std::forward<Handler>(handler), m_currentState);
+        }
+
         /**
-         * @brief Transition to a new state.
-         * @param toState The new state to transition to.
+         * @brief Transition to the new state the transition names, if any, then to any state its onEnter moves on to.
+         * @param transition Result of a state operation.
          */
-        void transitionToState(StatePtr toState);
+        void transitionToState(StateTransition transition);
 
         /**
-         * @brief Process all commands in the command queue.
+         * @brief Replace the current state with a newly constructed one, in place.
+         * @param target The state to construct and its arguments.
+         */
+        void emplaceState(StateTransition::Target& target);
+
+        /**
+         * @brief Process the commands queued when the call starts, up to the settings' per-tick count and time budget.
+         * Commands enqueued while the batch runs (for example from callbacks), or left over the budget, wait for the
+         * next tick.
          */
         void processCommandQueue();
 
+        /**
+         * @brief Hand one command to the current state, unpacking a publish batch into its publishes, a chunked
+         * transfer into the publishes of its next chunks, and a subscription set into the subscribe and unsubscribe
+         * that reach it.
+         * @param command The command to dispatch.
+         */
+        void dispatchCommand(Command& command);
+
+        /**
+         * @brief Subscribe to the filters of @p command the SubscriptionCache lacks and unsubscribe from those it has
+         * beyond them. Fails with NotConnected outside the Ready state, as a subscribe would.
+         * @param command The command to dispatch.
+         */
+        void dispatchSetSubscriptions(SetSubscriptionsCommand& command);
+
+        /**
+         * @brief Publish the next chunks of a chunked transfer, until its window is full or every chunk is out. The
+         * first call sizes the chunks to fit the broker's Maximum Packet Size. Each chunk's completion queues another
+         * PublishChunkedCommand rather than publishing from inside the acknowledgement.
+         * @param transfer The transfer.
+         */
+        void pumpChunkedTransfer(const std::shared_ptr<ChunkedTransfer>& transfer);
+
+        /**
+         * @brief Block until socket I/O, a state deadline, or a command wakeup, capped at maxWait.
+         * @param maxWait Upper bound on the wait.
+         */
+        void waitForWork(std::chrono::milliseconds maxWait);
+
+        /// @brief Pop every timer that expired before this call and dispatch it to the current state.
+        void fireExpiredTimers();
+
         /**
          * @brief Set up socket callbacks for the current socket.
          */
         void setupSocketCallbacks();
 
         Context m_context;
-        StatePtr m_currentState;
-        std::deque<Command> m_commandQueue;
-        std::mutex m_commandQueueMutex;
+        StateVariant m_currentState;
+
+        /// @brief Mirrors the alternative m_currentState holds, for readers on other threads.
+        std::atomic<StateId> m_stateId{ StateId::Disconnected };
+        MpscQueue<Command> m_commandQueue;
+        std::atomic<size_t> m_inboundBacklogBytes{ 0 };
+        std::shared_ptr<WakeupRoute> m_wakeup; ///< Shared with the context's delivery and async signals.
         DelegateHandle m_socketReplacedHandle;
+
+        /// @brief Backoff of waitForWork() in busy-poll mode; disabled unless the settings turn it on.
+        SpinBackoff m_spinBackoff;
+
+        /// @brief Last receive time seen by waitForWork(); a newer one means the last tick read something.
+        std::chrono::steady_clock::time_point m_lastPolledReceiveTime{};
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -0,0 +1,438 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/reactor_group.h"
+
+#include "mqtt/client/client_impl.h"
+#include "util/logging/logging.h"
+#include "util/system/thread_placement.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace reactormq::mqtt::client
+{
+    ReactorShard::ReactorShard(mqtt::ThreadPlacement placement, const BusyPollOptions& busyPoll, const RebalanceOptions& rebalance)
+        : m_placement(std::move(placement))
+        , m_rebalance(rebalance)
+        , m_spinBackoff(busyPoll)
+        , m_wakeup(std::make_shared<socket::WakeupHandle>())
+        , m_poller(socket::createPoller())
+    {
+    }
+
+    ReactorShard::~ReactorShard()
+    {
+        stop();
+    }
+
+    void ReactorShard::start()
+    {
+        if (bool expected = false; !m_isRunning.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        m_thread = std::thread([this] { run(); });
+    }
+
+    void ReactorShard::stop()
+    {
+        m_isRunning.store(false, std::memory_order_release);
+        m_wakeup->signal();
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    std::shared_ptr<Reactor> ReactorShard::createReactor(const ConnectionSettingsPtr& settings)
+    {
+        auto reactor = std::make_shared<Reactor>(settings, m_wakeup);
+        {
+            std::scoped_lock lock(m_reactorsMutex);
+            m_reactors.push_back(ScheduledReactor{ reactor, m_nextToken++ });
+        }
+        m_wakeup->signal();
+        return reactor;
+    }
+
+    void ReactorShard::adopt(const std::shared_ptr<Reactor>& reactor)
+    {
+        {
+            std::scoped_lock lock(m_reactorsMutex);
+            m_reactors.push_back(ScheduledReactor{ reactor, m_nextToken++ });
+        }
+        // Signals this shard's wakeup, so the reactor gets its first tick here straight away.
+        reactor->setWakeup(m_wakeup);
+    }
+
+    void ReactorShard::setPeers(std::vector<ReactorShard*> peers)
+    {
+        m_peers = std::move(peers);
+    }
+
+    size_t ReactorShard::getReactorCount() const
+    {
+        std::scoped_lock lock(m_reactorsMutex);
+        return static_cast<size_t>(std::ranges::count_if(m_reactors, [](const auto& scheduled) { return !scheduled.reactor.expired(); }));
+    }
+
+    void ReactorShard::run()
+    {
+        if (!m_placement.isDefault() && !system::applyThreadPlacement(m_placement))
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Warn,
+                "ReactorShard::run() could not apply all of the thread placement (name=%s, cores=%zu, priority=%s)",
+                m_placement.name.c_str(),
+                m_placement.cores.size(),
+                threadPriorityToString(m_placement.priority));
+        }
+
+        REACTORMQ_LOG(logging::LogLevel::Debug, "ReactorShard::run() event loop started (poller=%s)", getPollerBackendName());
+
+        bool isWakeupPolled = false;
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+        if (const int wakeupDescriptor = m_wakeup->getReadDescriptor(); m_poller && wakeupDescriptor != -1)
+        {
+            isWakeupPolled = m_poller->setInterest(wakeupDescriptor, socket::PollEvents::Readable, kWakeupToken);
+        }
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
+        std::vector<PinnedReactor> reactors;
+        std::unordered_map<std::uint64_t, SocketHandle> registeredHandles;
+        std::unordered_set<std::uint64_t> dueTokens;
+        std::unordered_set<std::uint64_t> liveTokens;
+        std::vector<socket::PollEvent> events(kMaxEventsPerWait);
+
+        const bool isRebalancing = m_rebalance.isEnabled && !m_peers.empty();
+        const std::chrono::nanoseconds loadWindow = std::chrono::milliseconds(std::max<std::uint32_t>(m_rebalance.windowMs, 1));
+        std::unordered_map<std::uint64_t, std::chrono::nanoseconds> tickCosts;
+        auto loadWindowStart = std::chrono::steady_clock::now();
+
+        while (m_isRunning.load(std::memory_order_acquire))
+        {
+            // Reset before ticking: anything enqueued from here on re-latches the wakeup and skips the wait below.
+            m_wakeup->reset();
+
+            collectReactors(reactors);
+
+            std::chrono::milliseconds timeout = isWakeupPolled ? kMaxIdleWait : kSocketPollInterval;
+            std::unordered_set<std::uint64_t> nextDueTokens;
+            liveTokens.clear();
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto& [reactor, token] : reactors)
+            {
+                liveTokens.insert(token);
+
+                const auto registered = registeredHandles.find(token);
+                const bool isPolled = registered != registeredHandles.end();
+                const auto deadline = reactor->getNextDeadline();
+                if (!isPolled || dueTokens.contains(token) || reactor->getCommandQueueDepth() > 0 || reactor->hasCompletedDeliveries()
+                    || reactor->hasAsyncResults() || (deadline && deadline.value() <= now))
+                {
+                    if (isRebalancing)
+                    {
+                        const auto tickStart = std::chrono::steady_clock::now();
+                        reactor->tick();
+                        tickCosts[token] += std::chrono::steady_clock::now() - tickStart;
+                    }
+                    else
+                    {
+                        reactor->tick();
+                    }
+                }
+
+                const socket::PollRegistration registration = m_poller ? reactor->getPollRegistration() : socket::PollRegistration{};
+                if (isPolled && registered->second != registration.handle)
+                {
+                    m_poller->remove(registered->second, token);
+                    registeredHandles.erase(registered);
+                }
+
+                bool isNowPolled = false;
+                if (registration.handle != kInvalidSocketHandle)
+                {
+                    isNowPolled = m_poller->setInterest(registration.handle, registration.interest, token);
+                    if (isNowPolled)
+                    {
+                        registeredHandles[token] = registration.handle;
+                    }
+                    else
+                    {
+                        registeredHandles.erase(token);
+                    }
+                }
+
+                if (reactor->getCommandQueueDepth() > 0 || reactor->hasCompletedDeliveries() || reactor->hasAsyncResults()
+                    || registration.hasBufferedInput)
+                {
+                    nextDueTokens.insert(token);
+                    timeout = std::chrono::milliseconds::zero();
+                }
+                else if (!isNowPolled)
+                {
+                    timeout = std::min(timeout, kSocketPollInterval);
+                }
+
+                if (const auto nextDeadline = reactor->getNextDeadline())
+                {
+                    const auto untilDeadline = std::chrono::ceil<std::chrono::milliseconds>(nextDeadline.value() - now);
+                    timeout = std::clamp(untilDeadline, std::chrono::milliseconds::zero(), timeout);
+                }
+            }
+
+            // Forget reactors that were released; the remove is a no-op if their handle was already reused.
+            std::erase_if(
+                registeredHandles,
+                [this, &liveTokens](const auto& entry)
+                {
+                    if (liveTokens.contains(entry.first))
+                    {
+                        return false;
+                    }
+                    m_poller->remove(entry.second, entry.first);
+                    return true;
+                });
+
+            // A safe point: no reactor of this shard is mid-tick, so one can be handed to a peer.
+            if (isRebalancing)
+            {
+                if (const auto windowEnd = std::chrono::steady_clock::now(); windowEnd - loadWindowStart >= loadWindow)
+                {
+                    if (const auto movedToken = closeLoadWindow(reactors, tickCosts, windowEnd - loadWindowStart, registeredHandles))
+                    {
+                        nextDueTokens.erase(*movedToken);
+                    }
+                    tickCosts.clear();
+                    loadWindowStart = windowEnd;
+                }
+            }
+
+            // Drop strong references before sleeping so released clients are destroyed promptly.
+            reactors.clear();
+
+            dueTokens = std::move(nextDueTokens);
+            const bool isBusyPolling = m_spinBackoff.isEnabled();
+            bool hasWork = timeout <= std::chrono::milliseconds::zero() || m_wakeup->isSignalled();
+            if (m_poller)
+            {
+                const size_t eventCount = m_poller->wait(events, hasWork || isBusyPolling ? std::chrono::milliseconds::zero() : timeout);
+                for (size_t i = 0; i < eventCount; ++i)
+                {
+                    if (events[i].token != kWakeupToken)
+                    {
+                        dueTokens.insert(events[i].token);
+                    }
+                }
+                hasWork = hasWork || eventCount > 0;
+            }
+            else if (!isBusyPolling && timeout > std::chrono::milliseconds::zero())
+            {
+                m_wakeup->waitFor(timeout);
+            }
+
+            // Busy polling never sleeps in the kernel; it backs off only while polls come up empty.
+            if (isBusyPolling)
+            {
+                if (hasWork)
+                {
+                    m_spinBackoff.reset();
+                }
+                else
+                {
+                    m_spinBackoff.idle();
+                }
+            }
+        }
+
+        REACTORMQ_LOG(logging::LogLevel::Debug, "ReactorShard::run() event loop stopped");
+    }
+
+    void ReactorShard::collectReactors(std::vector<PinnedReactor>& outReactors)
+    {
+        outReactors.clear();
+
+        std::scoped_lock lock(m_reactorsMutex);
+        std::erase_if(m_reactors, [](const auto& scheduled) { return scheduled.reactor.expired(); });
+        outReactors.reserve(m_reactors.size());
+        for (const auto& [weakReactor, token] : m_reactors)
+        {
+            if (auto reactor = weakReactor.lock())
+            {
+                outReactors.push_back(PinnedReactor{ std::move(reactor), token });
+            }
+        }
+    }
+
+    std::optional<std::uint64_t> ReactorShard::closeLoadWindow(
+        const std::vector<PinnedReactor>& reactors,
+        const std::unordered_map<std::uint64_t, std::chrono::nanoseconds>& tickCosts,
+        const std::chrono::nanoseconds windowLength,
+        std::unordered_map<std::uint64_t, SocketHandle>& registeredHandles)
+    {
+        std::chrono::nanoseconds busy{};
+        for (const auto& [token, cost] : tickCosts)
+        {
+            busy += cost;
+        }
+        const auto load = static_cast<std::uint32_t>(std::min<std::int64_t>(busy * 100 / windowLength, 100));
+        m_loadPercent.store(load, std::memory_order_relaxed);
+
+        ReactorShard* target = nullptr;
+        std::uint32_t targetLoad = load;
+        for (ReactorShard* peer : m_peers)
+        {
+            if (const std::uint32_t peerLoad = peer->getLoadPercent();
+                peerLoad < targetLoad && peer->m_isRunning.load(std::memory_order_acquire))
+            {
+                target = peer;
+                targetLoad = peerLoad;
+            }
+        }
+
+        // Moving the only reactor just moves the hot spot.
+        if (target == nullptr || load - targetLoad < m_rebalance.minImbalancePercent || reactors.size() < 2)
+        {
+            m_imbalancedWindows = 0;
+            return std::nullopt;
+        }
+        if (++m_imbalancedWindows < m_rebalance.imbalancedWindows)
+        {
+            return std::nullopt;
+        }
+        m_imbalancedWindows = 0;
+
+        // Moving a reactor that costs c turns a gap g into |g - 2c|: only reactors cheaper than the gap narrow it,
+        // and the one closest to half of it narrows it most.
+        const std::chrono::nanoseconds gap = windowLength * (load - targetLoad) / 100;
+        const PinnedReactor* chosen = nullptr;
+        std::chrono::nanoseconds chosenCost{};
+        std::chrono::nanoseconds chosenRemainder = gap;
+        for (const PinnedReactor& pinned : reactors)
+        {
+            const auto cost = tickCosts.find(pinned.token);
+            if (cost == tickCosts.end() || cost->second <= std::chrono::nanoseconds::zero() || cost->second >= gap)
+            {
+                continue;
+            }
+            if (const auto remainder = std::chrono::abs(gap - 2 * cost->second); remainder < chosenRemainder)
+            {
+                chosen = &pinned;
+                chosenCost = cost->second;
+                chosenRemainder = remainder;
+            }
+        }
+        if (chosen == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        const std::uint64_t token = chosen->token;
+        {
+            std::scoped_lock lock(m_reactorsMutex);
+            std::erase_if(m_reactors, [token](const auto& scheduled) { return scheduled.token == token; });
+        }
+        if (const auto registered = registeredHandles.find(token); registered != registeredHandles.end())
+        {
+            m_poller->remove(registered->second, token);
+            registeredHandles.erase(registered);
+        }
+
+        // Count the reactor against the target until it publishes its own next window, so other shards closing a
+        // window meanwhile do not all pick it.
+        const auto movedLoad = static_cast<std::uint32_t>(chosenCost * 100 / windowLength);
+        target->m_loadPercent.fetch_add(movedLoad, std::memory_order_relaxed);
+        m_loadPercent.fetch_sub(std::min(movedLoad, load), std::memory_order_relaxed);
+        target->adopt(chosen->reactor);
+        m_migrationCount.fetch_add(1, std::memory_order_relaxed);
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "ReactorShard::closeLoadWindow() handed a reactor to a peer (load=%u%%, peerLoad=%u%%, reactorLoad=%u%%)",
+            load,
+            targetLoad,
+            movedLoad);
+        return token;
+    }
+
+    ReactorGroup::ReactorGroup(
+        const size_t threadCount,
+        const ThreadPlacement& placement,
+        const BusyPollOptions& busyPoll,
+        const RebalanceOptions& rebalance)
+    {
+        const size_t shardCount = threadCount != 0 ? threadCount : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        REACTORMQ_LOG(logging::LogLevel::Info, "ReactorGroup::ReactorGroup() starting %zu thread(s)", shardCount);
+
+        m_shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; ++i)
+        {
+            m_shards.push_back(std::make_unique<ReactorShard>(system::getPoolThreadPlacement(placement, i), busyPoll, rebalance));
+        }
+
+        for (const auto& shard : m_shards)
+        {
+            std::vector<ReactorShard*> peers;
+            for (const auto& peer : m_shards)
+            {
+                if (peer != shard)
+                {
+                    peers.push_back(peer.get());
+                }
+            }
+            shard->setPeers(std::move(peers));
+        }
+
+        for (const auto& shard : m_shards)
+        {
+            shard->start();
+        }
+    }
+
+    ReactorGroup::~ReactorGroup()
+    {
+        ReactorGroup::stop();
+    }
+
+    std::shared_ptr<IClient> ReactorGroup::createClient(const ConnectionSettingsPtr& settings)
+    {
+        std::scoped_lock lock(m_assignMutex);
+
+        const auto shardIt = std::ranges::min_element(m_shards, {}, [](const auto& shard) { return shard->getReactorCount(); });
+        return std::make_shared<ClientImpl>((*shardIt)->createReactor(settings));
+    }
+
+    size_t ReactorGroup::getClientCount() const
+    {
+        size_t count = 0;
+        for (const auto& shard : m_shards)
+        {
+            count += shard->getReactorCount();
+        }
+        return count;
+    }
+
+    std::uint64_t ReactorGroup::getMigrationCount() const
+    {
+        std::uint64_t count = 0;
+        for (const auto& shard : m_shards)
+        {
+            count += shard->getMigrationCount();
+        }
+        return count;
+    }
+
+    void ReactorGroup::stop()
+    {
+        for (const auto& shard : m_shards)
+        {
+            shard->stop();
+        }
+    }
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,210 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/reactor.h"
+#include "mqtt/client/spin_backoff.h"
+#include "reactormq/mqtt/reactor_group.h"
+#include "reactormq/mqtt/rebalance_options.h"
+#include "reactormq/mqtt/thread_placement.h"
+#include "socket/platform/poller.h"
+#include "socket/platform/wakeup_handle.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief One event-loop thread driving a set of reactors.
+     * All reactors on the shard share one wakeup handle, so a command enqueued on any of them wakes the thread.
+     * Where the platform has a readiness poller, every reactor's socket and the wakeup are registered with it, and
+     * a loop iteration only ticks reactors whose socket is ready, that have queued commands, or whose timer is due.
+     * With rebalancing on and peers set, the shard times its ticks and hands reactors to a less busy peer as described
+     * by RebalanceOptions.
+     */
+    class ReactorShard final
+    {
+    public:
+        /**
+         * @brief Create the shard; its thread starts with start().
+         * @param placement Name, cores and priority the event-loop thread applies to itself as it starts.
+         * @param busyPoll Spin on non-blocking polls instead of sleeping in the poller when enabled.
+         * @param rebalance When to hand reactors to a peer; only acted on once peers are set.
+         */
+        explicit ReactorShard(
+            mqtt::ThreadPlacement placement = {},
+            const BusyPollOptions& busyPoll = {},
+            const RebalanceOptions& rebalance = {});
+
+        ~ReactorShard();
+
+        ReactorShard(const ReactorShard&) = delete;
+
+        ReactorShard& operator=(const ReactorShard&) = delete;
+
+        /// @brief Start the event-loop thread. No-op if already running.
+        void start();
+
+        /// @brief Stop and join the event-loop thread.
+        void stop();
+
+        /**
+         * @brief Create a reactor bound to this shard's wakeup and schedule it on the thread.
+         * The shard only keeps a weak reference; the reactor is dropped once its owner releases it.
+         * @param settings Connection settings for the reactor.
+         * @return The new reactor.
+         */
+        std::shared_ptr<Reactor> createReactor(const ConnectionSettingsPtr& settings);
+
+        /**
+         * @brief Schedule a reactor another shard has let go of, retargeting its wakeup to this shard's.
+         * The reactor must no longer be ticked or registered with a poller by its previous shard.
+         * @param reactor Reactor to drive from now on.
+         */
+        void adopt(const std::shared_ptr<Reactor>& reactor);
+
+        /**
+         * @brief Set the shards reactors may be handed to. Call before start(); the peers must outlive the thread.
+         * @param peers Other shards of the group.
+         */
+        void setPeers(std::vector<ReactorShard*> peers);
+
+        /// @brief Number of live reactors on this shard.
+        [[nodiscard]] size_t getReactorCount() const;
+
+        /// @brief Share of the last measurement window spent ticking reactors, in percent; 0 without rebalancing.
+        [[nodiscard]] std::uint32_t getLoadPercent() const
+        {
+            return m_loadPercent.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Number of reactors this shard has handed to a peer.
+        [[nodiscard]] std::uint64_t getMigrationCount() const
+        {
+            return m_migrationCount.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Name of the readiness poller backend, or "none" when sockets are re-polled on an interval.
+        [[nodiscard]] const char* getPollerBackendName() const
+        {
+            return m_poller ? m_poller->getBackendName() : "none";
+        }
+
+    private:
+        struct ScheduledReactor
+        {
+            std::weak_ptr<Reactor> reactor;
+            std::uint64_t token = 0; ///< Poller token; unique per reactor for the shard's lifetime.
+        };
+
+        struct PinnedReactor
+        {
+            std::shared_ptr<Reactor> reactor;
+            std::uint64_t token = 0;
+        };
+
+        void run();
+
+        /**
+         * @brief Pin the live reactors into outReactors and forget expired ones.
+         * @param outReactors Cleared and filled with strong references.
+         */
+        void collectReactors(std::vector<PinnedReactor>& outReactors);
+
+        /**
+         * @brief Close a measurement window: publish the load and, once the imbalance has persisted, hand one reactor
+         * to the least busy peer. Event-loop thread only, between ticks.
+         * @param reactors Reactors ticked this iteration.
+         * @param tickCosts Time spent ticking each reactor over the window, by token.
+         * @param windowLength Length of the window.
+         * @param registeredHandles Poller registrations; the handed-over reactor's is removed.
+         * @return Token of the reactor handed over, if any.
+         */
+        std::optional<std::uint64_t> closeLoadWindow(
+            const std::vector<PinnedReactor>& reactors,
+            const std::unordered_map<std::uint64_t, std::chrono::nanoseconds>& tickCosts,
+            std::chrono::nanoseconds windowLength,
+            std::unordered_map<std::uint64_t, SocketHandle>& registeredHandles);
+
+        /**
+         * @brief Longest sleep before re-polling a socket the poller cannot watch (no poller backend, a socket
+         * without a pollable handle, or a wakeup that is not selectable).
+         */
+        static constexpr std::chrono::milliseconds kSocketPollInterval{ 1 };
+
+        /// @brief Longest poller wait when every reactor is idle, as a backstop for states without deadlines.
+        static constexpr std::chrono::milliseconds kMaxIdleWait{ 100 };
+
+        /// @brief Largest number of readiness events drained per wait.
+        static constexpr size_t kMaxEventsPerWait = 256;
+
+        /// @brief Poller token of the shared wakeup handle; reactor tokens start after it.
+        static constexpr std::uint64_t kWakeupToken = 0;
+
+        mqtt::ThreadPlacement m_placement;
+        RebalanceOptions m_rebalance;
+        SpinBackoff m_spinBackoff; ///< Only touched by the event-loop thread after construction.
+        std::shared_ptr<socket::WakeupHandle> m_wakeup;
+        std::unique_ptr<socket::Poller> m_poller; ///< Only touched by the event-loop thread after construction.
+        std::atomic<bool> m_isRunning{ false };
+        std::thread m_thread;
+
+        std::vector<ReactorShard*> m_peers;
+        std::uint32_t m_imbalancedWindows = 0; ///< Only touched by the event-loop thread.
+        std::atomic<std::uint32_t> m_loadPercent{ 0 };
+        std::atomic<std::uint64_t> m_migrationCount{ 0 };
+
+        mutable std::mutex m_reactorsMutex;
+        std::vector<ScheduledReactor> m_reactors;
+        std::uint64_t m_nextToken = kWakeupToken + 1;
+    };
+
+    /**
+     * @brief IReactorGroup implementation: a fixed set of ReactorShard threads.
+     */
+    class ReactorGroup final : public IReactorGroup
+    {
+    public:
+        /**
+         * @brief Create and start the shard threads.
+         * @param threadCount Number of threads; 0 uses std::thread::hardware_concurrency().
+         * @param placement Placement of the threads; each gets its index appended to the name and one of the cores.
+         * @param busyPoll Run mode of every thread; spinning keeps each one busy on its core.
+         * @param rebalance When the threads move clients between them.
+         */
+        explicit ReactorGroup(
+            size_t threadCount,
+            const ThreadPlacement& placement = {},
+            const BusyPollOptions& busyPoll = {},
+            const RebalanceOptions& rebalance = {});
+
+        ~ReactorGroup() override;
+
+        std::shared_ptr<IClient> createClient(const ConnectionSettingsPtr& settings) override;
+
+        [[nodiscard]] size_t getThreadCount() const override
+        {
+            return m_shards.size();
+        }
+
+        [[nodiscard]] size_t getClientCount() const override;
+
+        [[nodiscard]] std::uint64_t getMigrationCount() const override;
+
+        void stop() override;
+
+    private:
+        std::vector<std::unique_ptr<ReactorShard>> m_shards;
+        std::mutex m_assignMutex;
+    };
+} // namespace reactormq::mqtt::client
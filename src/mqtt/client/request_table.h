@@ -0,0 +1,134 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/completion.h"
+#include "reactormq/mqtt/message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Requests waiting for their response, keyed by the Correlation Data sent with them.
+     *
+     * Requests live in a flat array of slots reused through a free list, like packet IDs, so adding and completing one
+     * is an index and never a hash. A correlation ID is the slot index plus one in its low 16 bits and the slot's
+     * generation in its high 16 bits, which is bumped on every take: a late response for a request that already timed
+     * out names an old generation and is ignored rather than completing whichever request reused the slot. Not
+     * thread-safe; it belongs to the reactor thread.
+     */
+    class RequestTable final
+    {
+    public:
+        /// @brief Most requests pending at once.
+        static constexpr size_t kMaxRequests = 65535;
+
+        /// @brief Size of the Correlation Data a correlation ID is sent as.
+        static constexpr size_t kCorrelationDataSize = 4;
+
+        /**
+         * @brief Keep a request until its response arrives or it times out.
+         * @param completion Where the response is reported.
+         * @return Its correlation ID, or 0 if kMaxRequests are already pending.
+         */
+        [[nodiscard]] std::uint32_t add(Completion<Message> completion)
+        {
+            std::uint16_t index = 0;
+            if (!m_free.empty())
+            {
+                index = m_free.back();
+                m_free.pop_back();
+            }
+            else if (m_slots.size() < kMaxRequests)
+            {
+                index = static_cast<std::uint16_t>(m_slots.size());
+                m_slots.emplace_back();
+            }
+            else
+            {
+                return 0;
+            }
+
+            Slot& slot = m_slots[index];
+            slot.completion = std::move(completion);
+            slot.isPending = true;
+            ++m_pending;
+            return static_cast<std::uint32_t>(slot.generation) << 16 | static_cast<std::uint32_t>(index + 1);
+        }
+
+        /**
+         * @brief Remove a pending request.
+         * @param correlationId ID returned by add().
+         * @return Its completion, or nullopt if no request with the ID is pending.
+         */
+        std::optional<Completion<Message>> take(const std::uint32_t correlationId)
+        {
+            const std::uint32_t position = correlationId & 0xFFFF;
+            if (position == 0 || position > m_slots.size())
+            {
+                return std::nullopt;
+            }
+
+            const auto index = static_cast<std::uint16_t>(position - 1);
+            Slot& slot = m_slots[index];
+            if (!slot.isPending || slot.generation != static_cast<std::uint16_t>(correlationId >> 16))
+            {
+                return std::nullopt;
+            }
+
+            Completion<Message> completion = std::move(slot.completion);
+            slot.completion = {};
+            slot.isPending = false;
+            ++slot.generation;
+            m_free.push_back(index);
+            --m_pending;
+            return completion;
+        }
+
+        /// @brief Number of requests waiting for a response.
+        [[nodiscard]] size_t size() const
+        {
+            return m_pending;
+        }
+
+        /// @brief Correlation Data for a correlation ID, big-endian.
+        [[nodiscard]] static std::vector<std::uint8_t> toCorrelationData(const std::uint32_t correlationId)
+        {
+            return { static_cast<std::uint8_t>(correlationId >> 24),
+                     static_cast<std::uint8_t>(correlationId >> 16),
+                     static_cast<std::uint8_t>(correlationId >> 8),
+                     static_cast<std::uint8_t>(correlationId) };
+        }
+
+        /// @brief Correlation ID in Correlation Data, or 0 if the data is not one this table sent.
+        [[nodiscard]] static std::uint32_t fromCorrelationData(const std::span<const std::uint8_t> data)
+        {
+            if (data.size() != kCorrelationDataSize)
+            {
+                return 0;
+            }
+            return static_cast<std::uint32_t>(data[0]) << 24 | static_cast<std::uint32_t>(data[1]) << 16
+                | static_cast<std::uint32_t>(data[2]) << 8 | static_cast<std::uint32_t>(data[3]);
+        }
+
+    private:
+        struct Slot
+        {
+            Completion<Message> completion;
+            std::uint16_t generation = 0;
+            bool isPending = false;
+        };
+
+        std::vector<Slot> m_slots;
+        std::vector<std::uint16_t> m_free;
+        size_t m_pending = 0;
+    };
+} // namespace reactormq::mqtt::client
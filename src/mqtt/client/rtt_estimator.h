@@ -0,0 +1,82 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Smoothed round-trip time to the broker and its variance, as TCP keeps them (RFC 6298).
+     *
+     * Each sample moves the smoothed time an eighth of the way and the variance a quarter of the way towards it; the
+     * first sample sets the smoothed time and half of it as the variance. Samples must come from exchanges sent only
+     * once (Karn's algorithm), since the response to a resent packet cannot be matched to one send. Not thread-safe;
+     * it belongs to the reactor thread.
+     */
+    class RttEstimator final
+    {
+    public:
+        using Duration = std::chrono::microseconds;
+
+        /// Shortest retransmit timeout, as RFC 6298 recommends, so a fast link is not retried on ordinary jitter.
+        static constexpr Duration kMinRetransmitTimeout = std::chrono::seconds(1);
+
+        /**
+         * @brief Add a round trip measured from a request to its response.
+         * @param sample Time from the request being sent to its response arriving; negative samples count as 0.
+         */
+        void addSample(const Duration sample)
+        {
+            const Duration rtt = std::max(sample, Duration::zero());
+            if (!m_hasSample)
+            {
+                m_smoothed = rtt;
+                m_variance = rtt / 2;
+                m_hasSample = true;
+                return;
+            }
+
+            const Duration error = rtt > m_smoothed ? rtt - m_smoothed : m_smoothed - rtt;
+            m_variance = (m_variance * 3 + error) / 4;
+            m_smoothed = (m_smoothed * 7 + rtt) / 8;
+        }
+
+        /// @brief Whether any round trip has been measured.
+        [[nodiscard]] bool hasSample() const
+        {
+            return m_hasSample;
+        }
+
+        /// @brief Smoothed round-trip time; zero before the first sample.
+        [[nodiscard]] Duration getSmoothedRtt() const
+        {
+            return m_smoothed;
+        }
+
+        /// @brief Mean deviation of the round-trip time; zero before the first sample.
+        [[nodiscard]] Duration getRttVariance() const
+        {
+            return m_variance;
+        }
+
+        /**
+         * @brief Time to wait for a response before treating the request as lost.
+         * @param maxTimeout Upper bound of the result.
+         * @return The smoothed round-trip time plus four times its variance, within [kMinRetransmitTimeout,
+         * maxTimeout]; maxTimeout wins when it is the smaller.
+         */
+        [[nodiscard]] Duration getRetransmitTimeout(const Duration maxTimeout) const
+        {
+            return std::min(std::max(m_smoothed + m_variance * 4, kMinRetransmitTimeout), maxTimeout);
+        }
+
+    private:
+        Duration m_smoothed{ 0 };
+        Duration m_variance{ 0 };
+        bool m_hasSample = false;
+    };
+} // namespace reactormq::mqtt::client
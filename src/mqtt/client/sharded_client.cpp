@@ -0,0 +1,200 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/sharded_client.h"
+
+#include "mqtt/client/fan_in.h"
+#include "reactormq/mqtt/client_factory.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    ShardedClient::ShardedClient(
+        const ConnectionSettingsPtr& settings,
+        const size_t shardCount,
+        const std::shared_ptr<IReactorGroup>& group)
+    {
+        const size_t count = std::max<size_t>(shardCount, 1);
+        m_shards.reserve(count);
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            ConnectionSettingsPtr shardSettings = settings;
+            if (index > 0)
+            {
+                const std::string& clientId = settings->getClientId();
+                shardSettings = settings->withClientId(clientId.empty() ? std::string() : clientId + "-" + std::to_string(index));
+            }
+
+            m_shards.push_back(group ? group->createClient(shardSettings) : createClient(shardSettings));
+        }
+    }
+
+    ConnectFuture ShardedClient::connectAsync(const bool cleanSession)
+    {
+        return makeFuture([this, cleanSession](CompletionHandler<void> onComplete) { connectAsync(cleanSession, std::move(onComplete)); });
+    }
+
+    void ShardedClient::connectAsync(const bool cleanSession, CompletionHandler<void> onComplete)
+    {
+        const auto fanIn = std::make_shared<FanIn>(m_shards.size(), std::move(onComplete));
+        for (const auto& shard : m_shards)
+        {
+            shard->connectAsync(cleanSession, joinFanIn(fanIn));
+        }
+    }
+
+    DisconnectFuture ShardedClient::disconnectAsync()
+    {
+        return makeFuture([this](CompletionHandler<void> onComplete) { disconnectAsync(std::move(onComplete)); });
+    }
+
+    void ShardedClient::disconnectAsync(CompletionHandler<void> onComplete)
+    {
+        const auto fanIn = std::make_shared<FanIn>(m_shards.size(), std::move(onComplete));
+        for (const auto& shard : m_shards)
+        {
+            shard->disconnectAsync(joinFanIn(fanIn));
+        }
+    }
+
+    DisconnectFuture ShardedClient::disconnectAsync(const DrainOptions& drain)
+    {
+        return makeFuture([this, drain](CompletionHandler<void> onComplete) { disconnectAsync(drain, std::move(onComplete)); });
+    }
+
+    void ShardedClient::disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete)
+    {
+        const auto fanIn = std::make_shared<FanIn>(m_shards.size(), std::move(onComplete));
+        for (const auto& shard : m_shards)
+        {
+            shard->disconnectAsync(drain, joinFanIn(fanIn));
+        }
+    }
+
+    PublishFuture ShardedClient::publishAsync(Message&& message)
+    {
+        return getShardForTopic(message.getTopic()).publishAsync(std::move(message));
+    }
+
+    PublishFuture ShardedClient::publishBatchAsync(std::vector<Message>&& messages)
+    {
+        return makeFuture([this, &messages](PublishCallback onComplete) { publishBatchAsync(std::move(messages), std::move(onComplete)); });
+    }
+
+    void ShardedClient::publishBatchAsync(std::vector<Message>&& messages, PublishCallback onComplete)
+    {
+        if (m_shards.size() == 1)
+        {
+            m_shards.front()->publishBatchAsync(std::move(messages), std::move(onComplete));
+            return;
+        }
+
+        // Each connection gets one batch with its messages in their original order.
+        std::vector<std::vector<Message>> batches(m_shards.size());
+        for (Message& message : messages)
+        {
+            batches[getShardIndex(message.getTopic())].push_back(std::move(message));
+        }
+
+        const auto parts = static_cast<size_t>(
+            std::count_if(batches.begin(), batches.end(), [](const std::vector<Message>& batch) { return !batch.empty(); }));
+        if (parts == 0)
+        {
+            m_shards.front()->publishBatchAsync(std::vector<Message>(), std::move(onComplete));
+            return;
+        }
+
+        const auto fanIn = std::make_shared<FanIn>(parts, std::move(onComplete));
+        for (size_t index = 0; index < batches.size(); ++index)
+        {
+            if (!batches[index].empty())
+            {
+                m_shards[index]->publishBatchAsync(std::move(batches[index]), joinFanIn(fanIn));
+            }
+        }
+    }
+
+    void ShardedClient::publish(Message&& message)
+    {
+        getShardForTopic(message.getTopic()).publish(std::move(message));
+    }
+
+    void ShardedClient::publish(Message&& message, PublishCallback onComplete)
+    {
+        getShardForTopic(message.getTopic()).publish(std::move(message), std::move(onComplete));
+    }
+
+    void ShardedClient::publishStream(
+        std::string topic,
+        PayloadSourcePtr source,
+        const QualityOfService qualityOfService,
+        const bool shouldRetain,
+        PublishCallback onComplete)
+    {
+        IClient& shard = getShardForTopic(topic);
+        shard.publishStream(std::move(topic), std::move(source), qualityOfService, shouldRetain, std::move(onComplete));
+    }
+
+    void ShardedClient::publishChunked(
+        std::string topic,
+        PayloadSourcePtr source,
+        const ChunkedTransferOptions& options,
+        PublishCallback onComplete)
+    {
+        IClient& shard = getShardForTopic(topic);
+        shard.publishChunked(std::move(topic), std::move(source), options, std::move(onComplete));
+    }
+
+    PublishReservation ShardedClient::allocatePublish(
+        std::string topic,
+        const size_t payloadSize,
+        const QualityOfService qualityOfService,
+        const bool shouldRetain)
+    {
+        IClient& shard = getShardForTopic(topic);
+        return shard.allocatePublish(std::move(topic), payloadSize, qualityOfService, shouldRetain);
+    }
+
+    size_t ShardedClient::getShardIndex(const std::string_view topic) const
+    {
+        return std::hash<std::string_view>{}(topic) % m_shards.size();
+    }
+
+    bool ShardedClient::isConnected() const
+    {
+        return std::all_of(m_shards.begin(), m_shards.end(), [](const auto& shard) { return shard->isConnected(); });
+    }
+
+    void ShardedClient::tick()
+    {
+        for (const auto& shard : m_shards)
+        {
+            shard->tick();
+        }
+    }
+
+    ClientMetrics ShardedClient::getMetrics() const
+    {
+        ClientMetrics total;
+        for (const auto& shard : m_shards)
+        {
+            total.merge(shard->getMetrics());
+        }
+        return total;
+    }
+
+    InboundTraffic ShardedClient::getInboundTraffic() const
+    {
+        InboundTraffic total;
+        for (const auto& shard : m_shards)
+        {
+            total.merge(shard->getInboundTraffic());
+        }
+        return total;
+    }
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,93 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/connection_settings.h"
+#include "reactormq/mqtt/reactor_group.h"
+#include "reactormq/mqtt/sharded_client.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief IShardedClient implementation over a fixed set of clients.
+     * The first connection uses the settings as given; the others use withClientId() copies named "<clientId>-<n>",
+     * or generated IDs when the settings have none, so every connection is a separate broker session.
+     */
+    class ShardedClient final : public IShardedClient
+    {
+    public:
+        /**
+         * @brief Create the connections; none of them connects until connectAsync().
+         * @param settings Connection settings shared by every connection.
+         * @param shardCount Number of connections; 0 is treated as 1.
+         * @param group Group whose threads drive the connections; null if the owner calls tick().
+         */
+        ShardedClient(const ConnectionSettingsPtr& settings, size_t shardCount, const std::shared_ptr<IReactorGroup>& group);
+
+        ConnectFuture connectAsync(bool cleanSession) override;
+        void connectAsync(bool cleanSession, CompletionHandler<void> onComplete) override;
+        DisconnectFuture disconnectAsync() override;
+        void disconnectAsync(CompletionHandler<void> onComplete) override;
+        DisconnectFuture disconnectAsync(const DrainOptions& drain) override;
+        void disconnectAsync(const DrainOptions& drain, CompletionHandler<void> onComplete) override;
+
+        PublishFuture publishAsync(Message&& message) override;
+        PublishFuture publishBatchAsync(std::vector<Message>&& messages) override;
+        void publishBatchAsync(std::vector<Message>&& messages, PublishCallback onComplete) override;
+        void publish(Message&& message) override;
+        void publish(Message&& message, PublishCallback onComplete) override;
+        void publishStream(
+            std::string topic,
+            PayloadSourcePtr source,
+            QualityOfService qualityOfService,
+            bool shouldRetain,
+            PublishCallback onComplete) override;
+        void publishChunked(
+            std::string topic,
+            PayloadSourcePtr source,
+            const ChunkedTransferOptions& options,
+            PublishCallback onComplete) override;
+        [[nodiscard]] PublishReservation allocatePublish(
+            std::string topic,
+            size_t payloadSize,
+            QualityOfService qualityOfService,
+            bool shouldRetain) override;
+
+        [[nodiscard]] size_t getShardCount() const override
+        {
+            return m_shards.size();
+        }
+
+        [[nodiscard]] size_t getShardIndex(std::string_view topic) const override;
+
+        [[nodiscard]] const std::shared_ptr<IClient>& getShard(size_t index) const override
+        {
+            return m_shards[index];
+        }
+
+        [[nodiscard]] bool isConnected() const override;
+
+        void tick() override;
+
+        [[nodiscard]] ClientMetrics getMetrics() const override;
+
+        [[nodiscard]] InboundTraffic getInboundTraffic() const override;
+
+    private:
+        /// @brief Client a topic's publishes go through.
+        [[nodiscard]] IClient& getShardForTopic(std::string_view topic) const
+        {
+            return *m_shards[getShardIndex(topic)];
+        }
+
+        std::vector<std::shared_ptr<IClient>> m_shards;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,91 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/busy_poll_options.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace reactormq::mqtt::client
+{
+    /// @brief Tell the CPU the thread is spinning: frees the core for a sibling hyperthread and saves power.
+    inline void cpuRelax()
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+        __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    /**
+     * @brief Backoff between the empty polls of a busy-polling loop: 1, 2, 4, ... pause instructions up to the
+     * configured cap, then also a yield per poll once the loop has been idle long enough. Any work resets it.
+     */
+    class SpinBackoff final
+    {
+    public:
+        explicit SpinBackoff(const BusyPollOptions& options = {})
+            : m_options(options)
+        {
+        }
+
+        /// @brief Whether the loop should spin rather than sleep.
+        [[nodiscard]] bool isEnabled() const
+        {
+            return m_options.isEnabled;
+        }
+
+        /// @brief Empty polls since the last reset.
+        [[nodiscard]] std::uint32_t getIdlePolls() const
+        {
+            return m_idlePolls;
+        }
+
+        /// @brief The last poll found work; the next idle one starts from a single pause.
+        void reset()
+        {
+            m_idlePolls = 0;
+        }
+
+        /// @brief Wait out one empty poll.
+        void idle()
+        {
+            const std::uint32_t cap = m_options.maxPauseIterations;
+            const std::uint32_t pauses = m_idlePolls >= 31 ? cap : std::min(std::uint32_t{ 1 } << m_idlePolls, cap);
+            for (std::uint32_t i = 0; i < pauses; ++i)
+            {
+                cpuRelax();
+            }
+
+            if (m_options.yieldAfterIdlePolls != 0 && m_idlePolls >= m_options.yieldAfterIdlePolls)
+            {
+                std::this_thread::yield();
+            }
+
+            if (m_idlePolls != std::numeric_limits<std::uint32_t>::max())
+            {
+                ++m_idlePolls;
+            }
+        }
+
+    private:
+        BusyPollOptions m_options;
+        std::uint32_t m_idlePolls = 0;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,174 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/endpoint_selector.h"
+#include "reactormq/mqtt/delegates.h"
+#include "socket/socket.h"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief A transport to a failover node, kept resolved, connected and past its TLS handshake while the client is
+     * connected elsewhere, so a lost connection can move to it without a cold connect.
+     *
+     * No MQTT packet is sent on it: the client's CONNECT goes out once it is promoted. A standby that fails to connect
+     * cools its node down like a failed attempt; one that is closed after connecting (brokers may drop a connection that
+     * stays silent before CONNECT) is reopened after the initial reconnect delay without counting against the node.
+     * Reactor thread only.
+     */
+    class StandbyConnection final
+    {
+    public:
+        using Clock = EndpointSelector::Clock;
+
+        StandbyConnection() = default;
+
+        StandbyConnection(const StandbyConnection&) = delete;
+
+        StandbyConnection& operator=(const StandbyConnection&) = delete;
+
+        ~StandbyConnection()
+        {
+            close();
+        }
+
+        /**
+         * @brief Open a standby to the best node not in use if there is none, and service the one there is.
+         * A standby to the node the client has since connected to is closed and replaced.
+         * @param endpoints The client's nodes.
+         * @param now Current time.
+         */
+        void maintain(EndpointSelector& endpoints, const Clock::time_point now)
+        {
+            if (m_socket && (m_hasFailed || m_index == endpoints.getCurrentIndex()))
+            {
+                if (m_hasFailed && !m_connectedAt)
+                {
+                    endpoints.recordStandbyFailure(*m_index, now);
+                }
+                else if (m_hasFailed)
+                {
+                    m_reopenAfter = now + endpoints.getInitialCooldown();
+                }
+                close();
+            }
+
+            if (!m_socket && now >= m_reopenAfter)
+            {
+                open(endpoints, now);
+            }
+
+            if (m_socket)
+            {
+                m_socket->tick();
+            }
+        }
+
+        /**
+         * @brief Hand over the standby if it is connected, making its node the one in use.
+         * @param endpoints The client's nodes.
+         * @param now Current time.
+         * @return The connected socket, with no callbacks of its own left; null if there is no usable standby.
+         */
+        [[nodiscard]] socket::SocketPtr promote(EndpointSelector& endpoints, const Clock::time_point now)
+        {
+            if (!m_socket)
+            {
+                return nullptr;
+            }
+
+            // Reads a close that arrived since the last tick, so a dead standby is not promoted.
+            m_socket->tick();
+            if (m_hasFailed || !m_connectedAt || !m_socket->isConnected())
+            {
+                close();
+                return nullptr;
+            }
+
+            // The connect latency covers the standby's own handshake, not the time it sat idle.
+            endpoints.beginAttempt(*m_index, now - (*m_connectedAt - m_openedAt));
+            m_onConnect.disconnect();
+            m_onDisconnect.disconnect();
+            m_index.reset();
+            m_connectedAt.reset();
+            return std::exchange(m_socket, nullptr);
+        }
+
+        /// @brief Close the standby, if any.
+        void close()
+        {
+            m_onConnect.disconnect();
+            m_onDisconnect.disconnect();
+            if (m_socket)
+            {
+                m_socket->close();
+                m_socket.reset();
+            }
+            m_index.reset();
+            m_connectedAt.reset();
+            m_hasFailed = false;
+        }
+
+        /// @brief Node the standby goes to, if one is open.
+        [[nodiscard]] std::optional<size_t> getIndex() const
+        {
+            return m_index;
+        }
+
+        /// @brief Whether the standby is connected and can be promoted.
+        [[nodiscard]] bool isReady() const
+        {
+            return m_socket && m_connectedAt && !m_hasFailed;
+        }
+
+    private:
+        void open(const EndpointSelector& endpoints, const Clock::time_point now)
+        {
+            const auto index = endpoints.pickStandby(now);
+            if (!index)
+            {
+                return;
+            }
+
+            m_socket = socket::CreateSocket(endpoints.getSettings(*index));
+            if (!m_socket)
+            {
+                return;
+            }
+
+            m_index = index;
+            m_openedAt = now;
+            m_onConnect = m_socket->getOnConnectCallback().add(
+                [this](const bool wasSuccessful)
+                {
+                    if (wasSuccessful)
+                    {
+                        m_connectedAt = Clock::now();
+                    }
+                    else
+                    {
+                        m_hasFailed = true;
+                    }
+                });
+            m_onDisconnect = m_socket->getOnDisconnectCallback().add([this] { m_hasFailed = true; });
+            m_socket->connect();
+        }
+
+        socket::SocketPtr m_socket;
+        DelegateHandle m_onConnect;
+        DelegateHandle m_onDisconnect;
+        std::optional<size_t> m_index;
+        Clock::time_point m_openedAt{};
+        std::optional<Clock::time_point> m_connectedAt;
+        Clock::time_point m_reopenAfter{};
+        bool m_hasFailed = false;
+    };
+} // namespace reactormq::mqtt::client
@@ -5,14 +5,56 @@
 #include "mqtt/client/state/acknowledgement/subscription_acknowledgement.h"
 
 #include "mqtt/client/command.h"
+#include "mqtt/client/subscription_cache.h"
 #include "mqtt/packets/sub_ack.h"
 
 namespace reactormq::mqtt::client::acknowledgement::subscription
 {
     namespace
     {
+        /// @brief Keep a granted filter for resubscribing after a reconnect; drop a refused one.
+        void recordGrant(SubscriptionCache& subscriptions, const TopicFilter& topicFilter, const bool isGranted)
+        {
+            if (isGranted)
+            {
+                subscriptions.remember(topicFilter);
+            }
+            else
+            {
+                subscriptions.forget(topicFilter.getFilter());
+            }
+        }
+
+        /// @brief Record one SUBACK of a split subscribe; the last one completes the batch.
+        template<typename Codes, typename IsSuccessFn>
+        void resolveBatchSlice(
+            SubscriptionCache& subscriptions, const SubscribeBatchSlice& slice, const Codes& codes, IsSuccessFn&& isSuccess)
+        {
+            SubscribeBatch& batch = *slice.batch;
+            for (size_t i = 0; i < codes.size() && i < slice.count; ++i)
+            {
+                const bool isGranted = isSuccess(codes[i]);
+                batch.granted[slice.offset + i] = isGranted ? 1 : 0;
+                recordGrant(subscriptions, batch.topicFilters[slice.offset + i], isGranted);
+            }
+
+            if (--batch.remaining > 0)
+            {
+                return;
+            }
+
+            std::vector<SubscribeResult> results;
+            results.reserve(batch.topicFilters.size());
+            for (size_t i = 0; i < batch.topicFilters.size(); ++i)
+            {
+                results.emplace_back(std::move(batch.topicFilters[i]), batch.granted[i] != 0);
+            }
+            batch.promise.set_value(Result<std::vector<SubscribeResult>>::success(std::move(results)));
+        }
+
         template<typename Codes, typename IsSuccessFn>
         void resolveSubscriptionPromises(
+            SubscriptionCache& subscriptions,
             std::optional<SubscribeCommand>& singleSubscription,
             std::optional<SubscribesCommand>& multiSubscription,
             const Codes& codes,
@@ -22,21 +64,29 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
             {
                 if (codes.empty())
                 {
-                    singleSubscription->promise.set_value(Result<SubscribeResult>::failure("Empty SUBACK"));
+                    singleSubscription->promise.set_value(Result<SubscribeResult>::failure(ResultError::MalformedPacket, "Empty SUBACK"));
                 }
                 else
                 {
+                    recordGrant(subscriptions, singleSubscription->topicFilter, isSuccess(codes[0]));
                     SubscribeResult r{ singleSubscription->topicFilter, isSuccess(codes[0]) };
                     singleSubscription->promise.set_value(Result<SubscribeResult>::success(std::move(r)));
                 }
                 return;
             }
 
+            if (const SubscribeBatchSlice& slice = multiSubscription->slice; slice.batch)
+            {
+                resolveBatchSlice(subscriptions, slice, codes, isSuccess);
+                return;
+            }
+
             std::vector<SubscribeResult> results;
             results.reserve(multiSubscription->topicFilters.size());
 
             for (size_t i = 0; i < codes.size() && i < multiSubscription->topicFilters.size(); ++i)
             {
+                recordGrant(subscriptions, multiSubscription->topicFilters[i], isSuccess(codes[i]));
                 results.emplace_back(multiSubscription->topicFilters[i], isSuccess(codes[i]));
             }
 
@@ -45,6 +95,7 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
 
         void resolveSubscriptionV5(
             const packets::IControlPacket& packet,
+            SubscriptionCache& subscriptions,
             std::optional<SubscribeCommand>& singleSubscription,
             std::optional<SubscribesCommand>& multiSubscription)
         {
@@ -52,6 +103,7 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
             const auto& reasonCodes = subAck->getReasonCodes();
 
             resolveSubscriptionPromises(
+                subscriptions,
                 singleSubscription,
                 multiSubscription,
                 reasonCodes,
@@ -64,6 +116,7 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
 
         void resolveSubscriptionV311(
             const packets::IControlPacket& packet,
+            SubscriptionCache& subscriptions,
             std::optional<SubscribeCommand>& singleSubscription,
             std::optional<SubscribesCommand>& multiSubscription)
         {
@@ -71,6 +124,7 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
             const auto& returnCodes = subAck->getReasonCodes();
 
             resolveSubscriptionPromises(
+                subscriptions,
                 singleSubscription,
                 multiSubscription,
                 returnCodes,
@@ -83,17 +137,18 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
 
     void resolve(
         const packets::IControlPacket& packet,
+        SubscriptionCache& subscriptions,
         std::optional<SubscribeCommand>& singleSubscription,
         std::optional<SubscribesCommand>& multiSubscription,
         const packets::ProtocolVersion protocolVersion)
     {
         if (protocolVersion == packets::ProtocolVersion::V5)
         {
-            resolveSubscriptionV5(packet, singleSubscription, multiSubscription);
+            resolveSubscriptionV5(packet, subscriptions, singleSubscription, multiSubscription);
         }
         else
         {
-            resolveSubscriptionV311(packet, singleSubscription, multiSubscription);
+            resolveSubscriptionV311(packet, subscriptions, singleSubscription, multiSubscription);
         }
     }
 } // namespace reactormq::mqtt::client::acknowledgement::subscription
\ No newline at end of file
@@ -20,6 +20,7 @@ namespace reactormq::mqtt::packets
 
 namespace reactormq::mqtt::client
 {
+    class SubscriptionCache;
     struct SubscribeCommand;
     struct SubscribesCommand;
 } // namespace reactormq::mqtt::client
@@ -29,12 +30,14 @@ namespace reactormq::mqtt::client::acknowledgement::subscription
     /**
      * @brief Processes a SUBACK packet and resolves subscription promise.
      * @param packet Received SUBACK packet.
+     * @param subscriptions Granted subscriptions; each filter is kept or dropped by its return code.
      * @param singleSubscription Optional single subscription command.
      * @param multiSubscription Optional multiple subscriptions command.
      * @param protocolVersion MQTT protocol version.
      */
     void resolve(
         const packets::IControlPacket& packet,
+        SubscriptionCache& subscriptions,
         std::optional<SubscribeCommand>& singleSubscription,
         std::optional<SubscribesCommand>& multiSubscription,
         packets::ProtocolVersion protocolVersion);
@@ -3,41 +3,28 @@
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
 #include "closing_state.h"
-#include "disconnected_state.h"
 
 #include "mqtt/client/context.h"
-#include "mqtt/packets/disconnect.h"
-#include "serialize/bytes.h"
+#include "mqtt/packets/pre_encoded_packets.h"
 #include "socket/socket.h"
 
 #include <chrono>
-#include <mqtt/client/mqtt_version_mapping.h>
 
 namespace reactormq::mqtt::client
 {
-    ClosingState::ClosingState(std::promise<Result<void>> promise)
+    ClosingState::ClosingState(Completion<void> promise)
         : m_promise(std::move(promise))
-        , m_entryTime(std::chrono::steady_clock::now())
     {
     }
 
     StateTransition ClosingState::onEnter(Context& context)
     {
+        context.getTimers().schedule(TimerKey{ TimerKind::CloseTimeout }, context.getNow() + kCloseTimeout);
+
         const auto sock = context.getSocket();
         if (sock)
         {
-            std::vector<std::byte> buffer;
-            serialize::ByteWriter writer(buffer);
-
-            withMqttVersion(
-                context.getProtocolVersion(),
-                [&writer]<typename VersionTag>(VersionTag)
-                {
-                    constexpr auto kV = VersionTag::value;
-                    packets::encodeDisconnectToWriter<kV>(writer);
-                });
-
-            sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+            sock->sendControl(packets::kHeaderOnlyPacket<packets::PacketType::Disconnect>);
         }
 
         if (sock)
@@ -50,6 +37,8 @@ namespace reactormq::mqtt::client
 
     void ClosingState::onExit(Context& context)
     {
+        context.getTimers().cancel(TimerKey{ TimerKind::CloseTimeout });
+
         if (m_promise.has_value())
         {
             m_promise.value().set_value(Result<void>::success());
@@ -71,41 +60,54 @@ namespace reactormq::mqtt::client
             {
                 sock->disconnect();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(true));
+            return StateTransition::toDisconnected(true);
         }
 
+        if (std::holds_alternative<DisconnectCommand>(command))
+        {
+            auto& [promise, drain] = std::get<DisconnectCommand>(command);
+            promise.set_value(Result<void>::success());
+        }
+        else
+        {
+            rejectCommand(command);
+        }
+
+        return StateTransition::noTransition();
+    }
+
+    void ClosingState::rejectCommand(Command& command)
+    {
         if (std::holds_alternative<ConnectCommand>(command))
         {
             auto& [cleanSession, promise] = std::get<ConnectCommand>(command);
-            promise.set_value(Result<void>::failure("Cannot connect while closing"));
+            promise.set_value(Result<void>::failure(ResultError::Closing));
         }
         else if (std::holds_alternative<PublishCommand>(command))
         {
-            auto& [message, promise] = std::get<PublishCommand>(command);
-            promise.set_value(Result<void>::failure("Cannot publish while closing"));
+            auto& [message, promise, enqueuedAt, sentAt, stream, preEncoded] = std::get<PublishCommand>(command);
+            promise.set_value(Result<void>::failure(ResultError::Closing));
         }
         else if (std::holds_alternative<SubscribeCommand>(command))
         {
-            auto& [topicFilter, promise] = std::get<SubscribeCommand>(command);
-            promise.set_value(Result<SubscribeResult>::failure("Cannot subscribe while closing"));
+            auto& [topicFilter, promise, handler, sink, isConflated, isChunked] = std::get<SubscribeCommand>(command);
+            promise.set_value(Result<SubscribeResult>::failure(ResultError::Closing));
         }
         else if (std::holds_alternative<SubscribesCommand>(command))
         {
-            auto& [topicFilters, promise] = std::get<SubscribesCommand>(command);
-            promise.set_value(Result<std::vector<SubscribeResult>>::failure("Cannot subscribe while closing"));
+            auto& [topicFilters, promise, slice] = std::get<SubscribesCommand>(command);
+            promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::Closing));
         }
         else if (std::holds_alternative<UnsubscribesCommand>(command))
         {
             auto& [topics, promise] = std::get<UnsubscribesCommand>(command);
-            promise.set_value(Result<std::vector<UnsubscribeResult>>::failure("Cannot unsubscribe while closing"));
+            promise.set_value(Result<std::vector<UnsubscribeResult>>::failure(ResultError::Closing));
         }
-        else if (std::holds_alternative<DisconnectCommand>(command))
+        else if (std::holds_alternative<RequestCommand>(command))
         {
-            auto& [promise] = std::get<DisconnectCommand>(command);
-            promise.set_value(Result<void>::success());
+            auto& [topic, payload, timeout, promise] = std::get<RequestCommand>(command);
+            promise.set_value(Result<Message>::failure(ResultError::Closing));
         }
-
-        return StateTransition::noTransition();
     }
 
     StateTransition ClosingState::onSocketConnected(Context& /*context*/)
@@ -115,27 +117,30 @@ namespace reactormq::mqtt::client
 
     StateTransition ClosingState::onSocketDisconnected(Context& /*context*/)
     {
-        return StateTransition::transitionTo(std::make_unique<DisconnectedState>(true));
+        return StateTransition::toDisconnected(true);
     }
 
-    StateTransition ClosingState::onDataReceived(Context& /*context*/, const uint8_t* /*data*/, const uint32_t /*size*/)
+    StateTransition ClosingState::onDataReceived(Context& /*context*/, const socket::InboundFrame& /*frame*/)
     {
         return StateTransition::noTransition();
     }
 
-    StateTransition ClosingState::onTick(Context& context)
+    StateTransition ClosingState::onTick(Context& /*context*/)
     {
-        constexpr std::chrono::milliseconds kCloseTimeout{ 5000 };
+        return StateTransition::noTransition();
+    }
 
-        if (const auto elapsed = std::chrono::steady_clock::now() - m_entryTime; elapsed >= kCloseTimeout)
+    StateTransition ClosingState::onTimer(Context& context, const TimerKey& timer)
+    {
+        if (timer.kind != TimerKind::CloseTimeout)
         {
-            if (const auto sock = context.getSocket())
-            {
-                sock->disconnect();
-            }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(true));
+            return StateTransition::noTransition();
         }
 
-        return StateTransition::noTransition();
+        if (const auto sock = context.getSocket())
+        {
+            sock->disconnect();
+        }
+        return StateTransition::toDisconnected(true);
     }
 } // namespace reactormq::mqtt::client
\ No newline at end of file
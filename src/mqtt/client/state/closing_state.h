@@ -4,10 +4,10 @@
 
 #pragma once
 
+#include "mqtt/client/completion.h"
 #include "reactormq/mqtt/result.h"
 #include "state.h"
 
-#include <future>
 #include <optional>
 
 namespace reactormq::mqtt::client
@@ -24,7 +24,7 @@ namespace reactormq::mqtt::client
          * @brief Construct a ClosingState.
          * @param promise Promise fulfilled when the disconnect completes.
          */
-        explicit ClosingState(std::promise<Result<void>> promise);
+        explicit ClosingState(Completion<void> promise);
 
         ~ClosingState() override = default;
 
@@ -38,10 +38,14 @@ namespace reactormq::mqtt::client
 
         StateTransition onSocketDisconnected(Context& context) override;
 
-        StateTransition onDataReceived(Context& context, const uint8_t* data, uint32_t size) override;
+        using IState::onDataReceived;
+
+        StateTransition onDataReceived(Context& context, const socket::InboundFrame& frame) override;
 
         StateTransition onTick(Context& context) override;
 
+        StateTransition onTimer(Context& context, const TimerKey& timer) override;
+
         [[nodiscard]] const char* getStateName() const override
         {
             return "Closing";
@@ -52,8 +56,16 @@ namespace reactormq::mqtt::client
             return StateId::Closing;
         }
 
+        /**
+         * @brief Fail a command that cannot run once a disconnect has begun; also used by ReadyState while it drains.
+         * Disconnect and CloseSocket commands are left alone.
+         * @param command The command to fail.
+         */
+        static void rejectCommand(Command& command);
+
     private:
-        std::optional<std::promise<Result<void>>> m_promise;
-        std::chrono::steady_clock::time_point m_entryTime;
+        static constexpr std::chrono::milliseconds kCloseTimeout{ 5000 };
+
+        std::optional<Completion<void>> m_promise;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
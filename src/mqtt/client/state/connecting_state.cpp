@@ -3,22 +3,24 @@
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
 #include "connecting_state.h"
-#include "disconnected_state.h"
 #include "mqtt/packets/auth.h"
 #include "mqtt/packets/conn_ack.h"
 #include "mqtt/packets/connect.h"
 #include "mqtt/packets/fixed_header.h"
 #include "processing/authentication_handler.h"
+#include "reactormq/mqtt/credentials.h"
 #include "ready_state.h"
 #include "serialize/bytes.h"
 #include "socket/socket.h"
 
+#include <algorithm>
 #include <cstring>
+#include <span>
 #include <mqtt/client/mqtt_version_mapping.h>
 
 namespace reactormq::mqtt::client
 {
-    ConnectingState::ConnectingState(const bool cleanSession, std::promise<Result<void>> promise)
+    ConnectingState::ConnectingState(const bool cleanSession, Completion<void> promise)
         : m_cleanSession(cleanSession)
         , m_promise(std::move(promise))
     {
@@ -26,9 +28,20 @@ namespace reactormq::mqtt::client
 
     StateTransition ConnectingState::onEnter(Context& context)
     {
+        ClientMetricCounters::increment(context.getMetricCounters().connectAttempts);
         if (!context.getSocket())
         {
-            context.setSocket(socket::CreateSocket(context.getSettings()));
+            const auto now = context.getNow();
+
+            // A warm standby is already through DNS, TCP and TLS; only CONNECT is left to send.
+            if (auto standby = context.getStandby().promote(context.getEndpoints(), now))
+            {
+                REACTORMQ_LOG(logging::LogLevel::Info, "ConnectingState::onEnter() promoting the warm standby connection");
+                context.setSocket(std::move(standby));
+                return onSocketConnected(context);
+            }
+
+            context.setSocket(socket::CreateSocket(context.getEndpoints().beginAttempt(now)));
         }
 
         if (const auto sock = context.getSocket())
@@ -39,31 +52,90 @@ namespace reactormq::mqtt::client
         return StateTransition::noTransition();
     }
 
-    void ConnectingState::onExit(Context& /*context*/)
+    void ConnectingState::onExit(Context& context)
     {
+        context.getTimers().cancel(TimerKey{ TimerKind::ConnectTimeout });
+
+        // Subscribes sent ahead of a CONNACK that never accepted the connection will never see a SUBACK.
+        if (!m_connectAccepted && shouldPipelineSubscribes(context))
+        {
+            for (Command& command : m_pipelinedSubscribes)
+            {
+                if (auto* subscribe = std::get_if<SubscribeCommand>(&command))
+                {
+                    subscribe->promise.set_value(Result<SubscribeResult>::failure(ResultError::NotConnected));
+                }
+                else if (auto* subscribes = std::get_if<SubscribesCommand>(&command))
+                {
+                    subscribes->promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::NotConnected));
+                }
+            }
+            m_pipelinedSubscribes.clear();
+            context.failPendingSubscribes(ResultError::NotConnected);
+        }
+
         if (m_promise.has_value())
         {
-            m_promise.value().set_value(Result<void>::failure("Connection interrupted"));
+            m_promise.value().set_value(Result<void>::failure(ResultError::ConnectionLost));
             m_promise.reset();
         }
     }
 
-    StateTransition ConnectingState::handleCommand(Context& /*context*/, Command& /*command*/)
+    StateTransition ConnectingState::handleCommand(Context& context, Command& command)
     {
+        if (std::holds_alternative<PublishCommand>(command))
+        {
+            context.getOfflinePublishes().push(std::move(std::get<PublishCommand>(command)));
+        }
+        else if (std::holds_alternative<RequestCommand>(command))
+        {
+            auto& [topic, payload, timeout, promise] = std::get<RequestCommand>(command);
+            promise.set_value(Result<Message>::failure(ResultError::NotConnected));
+        }
+        else if ((std::holds_alternative<SubscribeCommand>(command) || std::holds_alternative<SubscribesCommand>(command))
+                 && shouldPipelineSubscribes(context))
+        {
+            if (const auto sock = context.getSocket(); sock && m_connectSent)
+            {
+                sendPipelinedSubscribe(context, *sock, command);
+            }
+            else
+            {
+                m_pipelinedSubscribes.push_back(std::move(command));
+            }
+        }
         return StateTransition::noTransition();
     }
 
+    bool ConnectingState::shouldPipelineSubscribes(const Context& context)
+    {
+        const auto& settings = context.getSettings();
+        return settings && settings->shouldPipelineSubscribesOnConnect();
+    }
+
+    void ConnectingState::sendPipelinedSubscribe(Context& context, socket::Socket& sock, Command& command)
+    {
+        if (auto* subscribe = std::get_if<SubscribeCommand>(&command))
+        {
+            (void)ReadyState::handleSubscribeCommand(context, sock, *subscribe);
+        }
+        else if (auto* subscribes = std::get_if<SubscribesCommand>(&command))
+        {
+            (void)ReadyState::handleSubscribesCommand(context, sock, *subscribes);
+        }
+    }
+
     StateTransition ConnectingState::onSocketConnected(Context& context)
     {
-        const auto settings = context.getSettings();
+        const auto& settings = context.getSettings();
         if (!settings)
         {
             if (m_promise.has_value())
             {
-                m_promise.value().set_value(Result<void>::failure("No connection settings"));
+                m_promise.value().set_value(Result<void>::failure(ResultError::NotConfigured, "No connection settings"));
                 m_promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         const auto sock = context.getSocket();
@@ -71,96 +143,135 @@ namespace reactormq::mqtt::client
         {
             if (m_promise.has_value())
             {
-                m_promise.value().set_value(Result<void>::failure("No socket available"));
+                m_promise.value().set_value(Result<void>::failure(ResultError::NotConfigured, "No socket available"));
                 m_promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
-        const auto protocolVersion = context.getProtocolVersion();
-        std::vector<std::byte> buffer;
-        serialize::ByteWriter writer(buffer);
+        // Bounds the wait for the provider's credentials as well as for CONNACK.
+        context.getTimers().schedule(
+            TimerKey{ TimerKind::ConnectTimeout },
+            context.getNow() + std::chrono::seconds(settings->getMqttConnectionTimeoutSeconds()));
+
+        const auto credProvider = settings->getCredentialsProvider();
+        if (!credProvider)
+        {
+            sendConnect(context, Credentials{});
+            return StateTransition::noTransition();
+        }
+
+        // A provider that fetches its credentials completes later, from its own thread; onTick() sends CONNECT then.
+        m_pendingCredentials = std::make_shared<AsyncResult<Credentials>>(context.getAsyncSignal());
+        credProvider->getCredentialsAsync(AsyncResult<Credentials>::makeSetter(m_pendingCredentials));
+        sendConnectIfCredentialsArrived(context);
+        return StateTransition::noTransition();
+    }
+
+    void ConnectingState::sendConnectIfCredentialsArrived(Context& context)
+    {
+        if (!m_pendingCredentials)
+        {
+            return;
+        }
 
-        std::string username;
-        std::string password;
+        if (auto credentials = m_pendingCredentials->take())
+        {
+            m_pendingCredentials.reset();
+            sendConnect(context, std::move(*credentials));
+        }
+    }
+
+    void ConnectingState::sendConnect(Context& context, Credentials credentials)
+    {
+        const auto& settings = context.getSettings();
+        const auto sock = context.getSocket();
+        if (!settings || !sock)
+        {
+            return;
+        }
+
+        const auto protocolVersion = context.getProtocolVersion();
         std::string authMethod;
         std::vector<std::uint8_t> initialAuthData;
 
-        if (const auto credProvider = settings->getCredentialsProvider())
+        if (const auto credProvider = settings->getCredentialsProvider(); credProvider && protocolVersion == packets::ProtocolVersion::V5)
         {
-            const auto creds = credProvider->getCredentials();
-            username = creds.username;
-            password = creds.password;
-
-            if (protocolVersion == packets::ProtocolVersion::V5)
-            {
-                authMethod = credProvider->getAuthMethod();
-                initialAuthData = credProvider->getInitialAuthData();
-            }
+            authMethod = credProvider->getAuthMethod();
+            initialAuthData = credProvider->getInitialAuthData();
         }
 
-        withMqttVersion(
-            protocolVersion,
-            [&context, &settings, &writer, &username, &password, &cleanSession = m_cleanSession, &authMethod, &initialAuthData]<
-                typename VersionTag>(VersionTag)
-            {
-                constexpr auto kV = VersionTag::value;
-                packets::encodeConnectToWriter<kV>(
-                    writer,
-                    context.getEffectiveClientId(),
-                    settings->getKeepAliveIntervalSeconds(),
-                    username,
-                    password,
-                    cleanSession,
-                    authMethod,
-                    initialAuthData);
-            });
-
-        sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
-
-        m_handshakeDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(settings->getMqttConnectionTimeoutSeconds());
+        // Aliases never outlive a connection, so the inbound table starts empty for every CONNECT.
+        const std::uint16_t inboundTopicAliases
+            = protocolVersion == packets::ProtocolVersion::V5 ? settings->getMaxInboundTopicAliases() : std::uint16_t{ 0 };
+        context.getInboundTopicAliases().reset(inboundTopicAliases);
 
-        return StateTransition::noTransition();
+        // Unchanged since the last attempt (the usual reconnect), these are the bytes sent then.
+        const std::span<const std::byte> connect = context.getConnectPacketCache().get(ConnectPacketCache::Fields{
+            protocolVersion,
+            context.getEffectiveClientId(),
+            settings->getKeepAliveIntervalSeconds(),
+            std::move(credentials),
+            m_cleanSession,
+            std::move(authMethod),
+            std::move(initialAuthData),
+            inboundTopicAliases,
+            settings->getReceiveMaximum() });
+
+        sock->send(connect.data(), static_cast<std::uint32_t>(connect.size()));
+        m_connectSent = true;
+
+        // Written behind CONNECT in the same flush, so the SUBACKs follow CONNACK one round trip later.
+        for (Command& command : m_pipelinedSubscribes)
+        {
+            sendPipelinedSubscribe(context, *sock, command);
+        }
+        m_pipelinedSubscribes.clear();
     }
 
     StateTransition ConnectingState::onSocketDisconnected(Context& /*context*/)
     {
         if (m_promise.has_value())
         {
-            m_promise.value().set_value(Result<void>::failure("Connection failed"));
+            m_promise.value().set_value(Result<void>::failure(ResultError::ConnectionFailed));
             m_promise.reset();
         }
 
-        return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+        return StateTransition::toDisconnected(false);
     }
 
-    StateTransition ConnectingState::onDataReceived(Context& context, const uint8_t* data, const uint32_t size)
+    StateTransition ConnectingState::onDataReceived(Context& context, const socket::InboundFrame& frame)
     {
-        const auto packet = context.parsePacket(data, size);
+        const auto packet = context.parsePacket(frame);
         if (packet == nullptr)
         {
+            ClientMetricCounters::increment(context.getMetricCounters().parseFailures);
             if (m_promise.has_value())
             {
-                m_promise.value().set_value(Result<void>::failure("Failed to parse CONNACK packet"));
+                m_promise.value().set_value(Result<void>::failure(ResultError::MalformedPacket, "Failed to parse CONNACK packet"));
                 m_promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         if (!packet->isValid())
         {
             if (m_promise.has_value())
             {
-                m_promise.value().set_value(Result<void>::failure("Invalid CONNACK packet"));
+                m_promise.value().set_value(Result<void>::failure(ResultError::MalformedPacket, "Invalid CONNACK packet"));
                 m_promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         switch (const auto packetType = packet->getPacketType())
         {
         case packets::PacketType::Auth:
-            return processing::authentication::handle(context, *packet, m_promise);
+            {
+                auto transition = processing::authentication::handle(context, *packet, m_promise, m_pendingAuthResponse);
+                sendAuthResponseIfArrived(context);
+                return transition;
+            }
 
         case packets::PacketType::ConnAck:
             return handleConnAck(context, *packet);
@@ -172,14 +283,15 @@ namespace reactormq::mqtt::client
                     "Unexpected packet type %d in Connecting state (expected AUTH or CONNACK)",
                     packetType);
 
-                if (const auto settings = context.getSettings(); settings && settings->isStrictMode())
+                if (const auto& settings = context.getSettings(); settings && settings->isStrictMode())
                 {
                     if (m_promise.has_value())
                     {
-                        m_promise.value().set_value(Result<void>::failure("Unexpected packet (strict mode)"));
+                        m_promise.value().set_value(
+                            Result<void>::failure(ResultError::ProtocolViolation, "Unexpected packet (strict mode)"));
                         m_promise.reset();
                     }
-                    return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+                    return StateTransition::toDisconnected(false);
                 }
 
                 return StateTransition::noTransition();
@@ -205,6 +317,69 @@ namespace reactormq::mqtt::client
         }
     }
 
+    void ConnectingState::resetTopicAliases(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck)
+    {
+        // Absent Topic Alias Maximum means the broker accepts no aliases.
+        std::uint16_t brokerMaximum = 0;
+        for (const auto& prop : connAck.getProperties().getProperties())
+        {
+            if (prop.getIdentifier() == packets::properties::PropertyIdentifier::TopicAliasMaximum)
+            {
+                prop.tryGetValue(brokerMaximum);
+            }
+        }
+
+        const auto& settings = context.getSettings();
+        const std::uint16_t clientMaximum = settings ? settings->getMaxOutboundTopicAliases() : 0;
+        context.getTopicAliases().reset(std::min(brokerMaximum, clientMaximum));
+    }
+
+    void ConnectingState::applyReceiveMaximum(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck)
+    {
+        std::uint16_t receiveMaximum = kDefaultReceiveMaximum;
+        for (const auto& prop : connAck.getProperties().getProperties())
+        {
+            if (prop.getIdentifier() == packets::properties::PropertyIdentifier::ReceiveMaximum)
+            {
+                prop.tryGetValue(receiveMaximum);
+            }
+        }
+
+        // 0 is a protocol error; rather than stall every QoS 1/2 publish, fall back to the default.
+        context.setReceiveMaximum(receiveMaximum != 0 ? receiveMaximum : kDefaultReceiveMaximum);
+    }
+
+    void ConnectingState::applyMaximumPacketSize(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck)
+    {
+        std::uint32_t maximumPacketSize = kDefaultMaximumPacketSize;
+        for (const auto& prop : connAck.getProperties().getProperties())
+        {
+            if (prop.getIdentifier() == packets::properties::PropertyIdentifier::MaximumPacketSize)
+            {
+                prop.tryGetValue(maximumPacketSize);
+            }
+        }
+
+        // 0 is a protocol error; treat it as absent.
+        context.setBrokerMaximumPacketSize(maximumPacketSize != 0 ? maximumPacketSize : kDefaultMaximumPacketSize);
+    }
+
+    void ConnectingState::applySubscriptionIdentifierAvailable(
+        Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck)
+    {
+        // Absent means the broker accepts them.
+        std::uint8_t available = 1;
+        for (const auto& prop : connAck.getProperties().getProperties())
+        {
+            if (prop.getIdentifier() == packets::properties::PropertyIdentifier::SubscriptionIdentifierAvailable)
+            {
+                prop.tryGetValue(available);
+            }
+        }
+
+        context.setSubscriptionIdentifiersAvailable(available != 0);
+    }
+
     StateTransition ConnectingState::handleConnAck(Context& context, const packets::IControlPacket& packet)
     {
         bool success = false;
@@ -216,15 +391,26 @@ namespace reactormq::mqtt::client
 
             if (success)
             {
+                context.setSessionPresent(connAck->getSessionPresent());
                 assignClientId(context, *connAck);
+                resetTopicAliases(context, *connAck);
+                applyReceiveMaximum(context, *connAck);
+                applyMaximumPacketSize(context, *connAck);
+                applySubscriptionIdentifierAvailable(context, *connAck);
             }
         }
         else
         {
+            context.getTopicAliases().reset(0);
+            context.setReceiveMaximum(kDefaultReceiveMaximum);
+            context.setBrokerMaximumPacketSize(kDefaultMaximumPacketSize);
+            context.setSubscriptionIdentifiersAvailable(false);
+
             auto const* connAck = static_cast<const packets::ConnAck<packets::ProtocolVersion::V311>*>(&packet);
             if (nullptr != connAck)
             {
                 success = connAck->getReasonCode() == packets::ConnectReturnCode::Accepted;
+                context.setSessionPresent(success && connAck->getSessionPresent());
             }
         }
 
@@ -236,31 +422,56 @@ namespace reactormq::mqtt::client
             }
             else
             {
-                m_promise.value().set_value(Result<void>::failure("Connection refused by broker"));
+                m_promise.value().set_value(Result<void>::failure(ResultError::ConnectionRefused));
             }
             m_promise.reset();
         }
 
         if (success)
         {
-            return StateTransition::transitionTo(std::make_unique<ReadyState>());
+            m_connectAccepted = true;
+            context.getEndpoints().recordConnected(context.getNow());
+            context.getReconnectBackoff().reset();
+            return StateTransition::toReady();
         }
-        return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+        return StateTransition::toDisconnected(false);
     }
 
-    StateTransition ConnectingState::onTick(Context& /*context*/)
+    StateTransition ConnectingState::onTick(Context& context)
     {
-        if (m_handshakeDeadline.has_value() && std::chrono::steady_clock::now() > m_handshakeDeadline.value())
+        sendConnectIfCredentialsArrived(context);
+        sendAuthResponseIfArrived(context);
+        return StateTransition::noTransition();
+    }
+
+    void ConnectingState::sendAuthResponseIfArrived(const Context& context)
+    {
+        if (!m_pendingAuthResponse)
         {
-            REACTORMQ_LOG(logging::LogLevel::Error, "ConnectingState::onTick() handshake timeout");
-            if (m_promise.has_value())
-            {
-                m_promise.value().set_value(Result<void>::failure("Handshake timeout"));
-                m_promise.reset();
-            }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return;
         }
-        return StateTransition::noTransition();
+
+        if (const auto response = m_pendingAuthResponse->take())
+        {
+            m_pendingAuthResponse.reset();
+            processing::authentication::sendResponse(context, *response);
+        }
+    }
+
+    StateTransition ConnectingState::onTimer(Context& /*context*/, const TimerKey& timer)
+    {
+        if (timer.kind != TimerKind::ConnectTimeout)
+        {
+            return StateTransition::noTransition();
+        }
+
+        REACTORMQ_LOG(logging::LogLevel::Error, "ConnectingState::onTimer() handshake timeout");
+        if (m_promise.has_value())
+        {
+            m_promise.value().set_value(Result<void>::failure(ResultError::TimedOut, "Handshake timeout"));
+            m_promise.reset();
+        }
+        return StateTransition::toDisconnected(false);
     }
 
     const char* ConnectingState::getStateName() const
@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include "mqtt/client/async_result.h"
+#include "mqtt/client/completion.h"
+#include "reactormq/mqtt/credentials.h"
 #include "state.h"
 
 #include <chrono>
-#include <future>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace reactormq::mqtt::packets
 {
@@ -32,7 +38,7 @@ namespace reactormq::mqtt::client
          * @param cleanSession Whether to start a clean session vs. resume.
          * @param promise Promise completed when the connect attempt finishes.
          */
-        explicit ConnectingState(bool cleanSession, std::promise<Result<void>> promise);
+        explicit ConnectingState(bool cleanSession, Completion<void> promise);
 
         ~ConnectingState() override = default;
 
@@ -46,10 +52,14 @@ namespace reactormq::mqtt::client
 
         StateTransition onSocketDisconnected(Context& context) override;
 
-        StateTransition onDataReceived(Context& context, const uint8_t* data, uint32_t size) override;
+        using IState::onDataReceived;
+
+        StateTransition onDataReceived(Context& context, const socket::InboundFrame& frame) override;
 
         StateTransition onTick(Context& context) override;
 
+        StateTransition onTimer(Context& context, const TimerKey& timer) override;
+
         [[nodiscard]] const char* getStateName() const override;
 
         [[nodiscard]] StateId getStateId() const override
@@ -59,10 +69,51 @@ namespace reactormq::mqtt::client
 
     private:
         StateTransition handleConnAck(Context& context, const packets::IControlPacket& packet);
+
+        /// @brief Send CONNECT, encoded unless the last attempt's still fits, followed by any pipelined subscribes.
+        void sendConnect(Context& context, Credentials credentials);
+
+        /// @brief Send CONNECT once the credentials provider has delivered.
+        void sendConnectIfCredentialsArrived(Context& context);
+
+        /// @brief Send the AUTH response once the credentials provider has delivered it.
+        void sendAuthResponseIfArrived(const Context& context);
+
+        /// @brief Whether SUBSCRIBE may be sent ahead of CONNACK.
+        [[nodiscard]] static bool shouldPipelineSubscribes(const Context& context);
+
+        /// @brief Send a subscribe command behind CONNECT, without waiting for CONNACK.
+        static void sendPipelinedSubscribe(Context& context, socket::Socket& sock, Command& command);
         static void assignClientId(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck);
+        static void resetTopicAliases(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck);
+        static void applyReceiveMaximum(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck);
+        static void applyMaximumPacketSize(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck);
+
+        static void applySubscriptionIdentifierAvailable(Context& context, const packets::ConnAck<packets::ProtocolVersion::V5>& connAck);
+
+        /// @brief Receive Maximum when CONNACK does not carry one (and for MQTT 3.1.1): effectively unlimited.
+        static constexpr std::uint16_t kDefaultReceiveMaximum = 65535;
+
+        /// @brief Maximum Packet Size when CONNACK does not carry one (and for MQTT 3.1.1): the protocol limit.
+        static constexpr std::uint32_t kDefaultMaximumPacketSize = 268435460;
 
         bool m_cleanSession;
-        std::optional<std::promise<Result<void>>> m_promise;
-        std::optional<std::chrono::steady_clock::time_point> m_handshakeDeadline;
+
+        /// @brief Whether CONNECT has been sent; pipelined subscribes before that wait in m_pipelinedSubscribes.
+        bool m_connectSent = false;
+
+        /// @brief Whether CONNACK accepted the connection; if not, pipelined subscribes fail on exit.
+        bool m_connectAccepted = false;
+
+        /// @brief Subscribes made before the socket connected, sent right after CONNECT.
+        std::deque<Command> m_pipelinedSubscribes;
+
+        /// @brief Credentials CONNECT waits for, while the provider fetches them.
+        std::shared_ptr<AsyncResult<Credentials>> m_pendingCredentials;
+
+        /// @brief Response to the broker's AUTH challenge, while the provider computes it.
+        std::shared_ptr<AsyncResult<std::vector<std::uint8_t>>> m_pendingAuthResponse;
+
+        std::optional<Completion<void>> m_promise;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
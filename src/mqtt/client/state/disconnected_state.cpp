@@ -3,9 +3,9 @@
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
 #include "disconnected_state.h"
-#include "connecting_state.h"
 #include "reactormq/mqtt/result.h"
 
+#include <chrono>
 #include <variant>
 
 namespace reactormq::mqtt::client
@@ -22,65 +22,87 @@ namespace reactormq::mqtt::client
             context.setSocket(nullptr);
         }
 
-        if (const auto settings = context.getSettings(); settings && settings->isAutoReconnectEnabled() && !m_wasGracefulDisconnect)
+        const auto now = context.getNow();
+        bool canFailOver = false;
+        if (m_wasGracefulDisconnect)
         {
-            m_backoffCalculator.emplace(
-                settings->getAutoReconnectInitialDelayMs(),
-                settings->getAutoReconnectMaxDelayMs(),
-                settings->getAutoReconnectMultiplier());
+            context.getEndpoints().endConnection();
+        }
+        else
+        {
+            canFailOver = context.getEndpoints().recordFailure(now);
+        }
 
-            const auto delayMs = m_backoffCalculator->calculateNextDelay();
-            m_nextRetryTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+        const auto& settings = context.getSettings();
+        if (!settings || !settings->isAutoReconnectEnabled() || m_wasGracefulDisconnect)
+        {
+            context.getStandby().close();
+        }
+        else
+        {
+            // Another node that has not failed recently is tried at once; the backoff is for when they all have.
+            if (canFailOver)
+            {
+                context.getTimers().schedule(TimerKey{ TimerKind::RetryBackoff }, now);
+                return StateTransition::noTransition();
+            }
+
+            const auto delayMs = context.getReconnectBackoff().calculateNextDelay();
+            context.getTimers().schedule(TimerKey{ TimerKind::RetryBackoff }, now + std::chrono::milliseconds(delayMs));
         }
 
         return StateTransition::noTransition();
     }
 
-    void DisconnectedState::onExit(Context& /*context*/)
+    void DisconnectedState::onExit(Context& context)
     {
-        // Nothing to do
+        context.getTimers().cancel(TimerKey{ TimerKind::RetryBackoff });
     }
 
-    StateTransition DisconnectedState::handleCommand(Context& /*context*/, Command& command)
+    StateTransition DisconnectedState::handleCommand(Context& context, Command& command)
     {
         if (std::holds_alternative<ConnectCommand>(command))
         {
             auto& [cleanSession, promise] = std::get<ConnectCommand>(command);
 
-            m_nextRetryTime.reset();
-            m_backoffCalculator.reset();
+            context.getTimers().cancel(TimerKey{ TimerKind::RetryBackoff });
+            context.getReconnectBackoff().reset();
 
-            return StateTransition::transitionTo(std::make_unique<ConnectingState>(cleanSession, std::move(promise)));
+            return StateTransition::toConnecting(cleanSession, std::move(promise));
         }
 
         if (std::holds_alternative<PublishCommand>(command))
         {
-            auto& [message, promise] = std::get<PublishCommand>(command);
-            promise.set_value(Result<void>::failure("Not connected"));
+            context.getOfflinePublishes().push(std::move(std::get<PublishCommand>(command)));
         }
         else if (std::holds_alternative<SubscribesCommand>(command))
         {
-            auto& [topicFilters, promise] = std::get<SubscribesCommand>(command);
-            promise.set_value(Result<std::vector<SubscribeResult>>::failure("Not connected"));
+            auto& [topicFilters, promise, slice] = std::get<SubscribesCommand>(command);
+            promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::NotConnected));
         }
         else if (std::holds_alternative<SubscribeCommand>(command))
         {
-            auto& [topicFilter, promise] = std::get<SubscribeCommand>(command);
-            promise.set_value(Result<SubscribeResult>::failure("Not connected"));
+            auto& [topicFilter, promise, handler, sink, isConflated, isChunked] = std::get<SubscribeCommand>(command);
+            promise.set_value(Result<SubscribeResult>::failure(ResultError::NotConnected));
         }
         else if (std::holds_alternative<UnsubscribesCommand>(command))
         {
             auto& [topics, promise] = std::get<UnsubscribesCommand>(command);
-            promise.set_value(Result<std::vector<UnsubscribeResult>>::failure("Not connected"));
+            promise.set_value(Result<std::vector<UnsubscribeResult>>::failure(ResultError::NotConnected));
         }
         else if (std::holds_alternative<UnsubscribeCommand>(command))
         {
             auto& [topic, promise] = std::get<UnsubscribeCommand>(command);
-            promise.set_value(Result<UnsubscribeResult>::failure("Not connected"));
+            promise.set_value(Result<UnsubscribeResult>::failure(ResultError::NotConnected));
+        }
+        else if (std::holds_alternative<RequestCommand>(command))
+        {
+            auto& [topic, payload, timeout, promise] = std::get<RequestCommand>(command);
+            promise.set_value(Result<Message>::failure(ResultError::NotConnected));
         }
         else if (std::holds_alternative<DisconnectCommand>(command))
         {
-            auto& [promise] = std::get<DisconnectCommand>(command);
+            auto& [promise, drain] = std::get<DisconnectCommand>(command);
             promise.set_value(Result<void>::success());
         }
 
@@ -97,28 +119,39 @@ namespace reactormq::mqtt::client
         return StateTransition::noTransition();
     }
 
-    StateTransition DisconnectedState::onDataReceived(Context& /*context*/, const uint8_t* /*data*/, uint32_t /*size*/)
+    StateTransition DisconnectedState::onDataReceived(Context& /*context*/, const socket::InboundFrame& /*frame*/)
     {
         return StateTransition::noTransition();
     }
 
-    StateTransition DisconnectedState::onTick(Context& context)
+    StateTransition DisconnectedState::onTick(Context& /*context*/)
     {
-        if (m_nextRetryTime.has_value())
+        return StateTransition::noTransition();
+    }
+
+    StateTransition DisconnectedState::onTimer(Context& context, const TimerKey& timer)
+    {
+        if (timer.kind != TimerKind::RetryBackoff)
         {
-            const auto now = std::chrono::steady_clock::now();
-            if (now >= m_nextRetryTime.value())
-            {
-                std::promise<Result<void>> promise;
-                auto future = promise.get_future();
+            return StateTransition::noTransition();
+        }
 
-                const auto settings = context.getSettings();
-                const bool cleanSession = settings ? settings->getSessionExpiryInterval() == 0 : true;
+        const auto& settings = context.getSettings();
 
-                return StateTransition::transitionTo(std::make_unique<ConnectingState>(cleanSession, std::move(promise)));
+        // The attempt takes the next slot of the shared throttle and comes back when its slot is due.
+        if (const ReconnectThrottlePtr& throttle = settings ? settings->getReconnectThrottle() : nullptr; throttle && !m_isAdmitted)
+        {
+            m_isAdmitted = true;
+            const auto now = context.getNow();
+            if (const auto admittedAt = throttle->reserve(now); admittedAt > now)
+            {
+                context.getTimers().schedule(TimerKey{ TimerKind::RetryBackoff }, admittedAt);
+                return StateTransition::noTransition();
             }
         }
 
-        return StateTransition::noTransition();
+        const bool cleanSession = settings ? settings->getSessionExpiryInterval() == 0 : true;
+
+        return StateTransition::toConnecting(cleanSession, Completion<void>{});
     }
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -4,18 +4,15 @@
 
 #pragma once
 
-#include "mqtt/client/backoff.h"
 #include "state.h"
 
-#include <chrono>
-#include <optional>
-
 namespace reactormq::mqtt::client
 {
     /**
      * @brief State representing a disconnected client.
      * Accepts connectAsync to initiate a connection.
-     * Can auto-reconnect with exponential backoff after an unexpected drop.
+     * Can auto-reconnect with exponential backoff after an unexpected drop, waiting for the settings' reconnect
+     * throttle, if any, before each attempt.
      */
     class DisconnectedState final : public IState
     {
@@ -38,10 +35,14 @@ namespace reactormq::mqtt::client
 
         StateTransition onSocketDisconnected(Context& context) override;
 
-        StateTransition onDataReceived(Context& context, const uint8_t* data, uint32_t size) override;
+        using IState::onDataReceived;
+
+        StateTransition onDataReceived(Context& context, const socket::InboundFrame& frame) override;
 
         StateTransition onTick(Context& context) override;
 
+        StateTransition onTimer(Context& context, const TimerKey& timer) override;
+
         [[nodiscard]] const char* getStateName() const override
         {
             return "Disconnected";
@@ -54,7 +55,8 @@ namespace reactormq::mqtt::client
 
     private:
         bool m_wasGracefulDisconnect = false;
-        std::optional<std::chrono::steady_clock::time_point> m_nextRetryTime;
-        std::optional<BackoffCalculator> m_backoffCalculator;
+
+        /// @brief Whether this state's reconnect attempt already holds a slot from the reconnect throttle.
+        bool m_isAdmitted = false;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -5,7 +5,6 @@
 #include "authentication_handler.h"
 
 #include "mqtt/client/context.h"
-#include "mqtt/client/state/disconnected_state.h"
 #include "mqtt/packets/auth.h"
 #include "mqtt/packets/properties/property.h"
 #include "serialize/bytes.h"
@@ -15,17 +14,20 @@
 namespace reactormq::mqtt::client::processing::authentication
 {
     StateTransition handle(
-        const Context& context, const packets::IControlPacket& packet, std::optional<std::promise<Result<void>>>& promise)
+        const Context& context,
+        const packets::IControlPacket& packet,
+        std::optional<Completion<void>>& promise,
+        PendingResponse& pendingResponse)
     {
         if (const auto protocolVersion = context.getProtocolVersion(); protocolVersion != packets::ProtocolVersion::V5)
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "AUTH packet received but protocol is not MQTT 5");
             if (promise.has_value())
             {
-                promise.value().set_value(Result<void>::failure("AUTH not supported in MQTT 3.1.1"));
+                promise.value().set_value(Result<void>::failure(ResultError::UnsupportedByProtocol));
                 promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         auto const* authPacket = static_cast<const packets::Auth*>(&packet);
@@ -34,10 +36,10 @@ namespace reactormq::mqtt::client::processing::authentication
             REACTORMQ_LOG(logging::LogLevel::Error, "Failed to cast to AUTH packet");
             if (promise.has_value())
             {
-                promise.value().set_value(Result<void>::failure("Invalid AUTH packet"));
+                promise.value().set_value(Result<void>::failure(ResultError::MalformedPacket, "Invalid AUTH packet"));
                 promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         if (const auto reasonCode = authPacket->getReasonCode(); reasonCode != ReasonCode::ContinueAuthentication)
@@ -45,10 +47,10 @@ namespace reactormq::mqtt::client::processing::authentication
             REACTORMQ_LOG(logging::LogLevel::Error, "AUTH packet with unexpected reason code: %d", reasonCode);
             if (promise.has_value())
             {
-                promise.value().set_value(Result<void>::failure("Authentication failed"));
+                promise.value().set_value(Result<void>::failure(ResultError::AuthenticationFailed));
                 promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
         std::vector<std::uint8_t> serverAuthData;
@@ -62,41 +64,97 @@ namespace reactormq::mqtt::client::processing::authentication
             }
         }
 
-        const auto settings = context.getSettings();
+        const auto& settings = context.getSettings();
         if (!settings || !settings->getCredentialsProvider())
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "No credentials provider available for AUTH challenge");
             if (promise.has_value())
             {
-                promise.value().set_value(Result<void>::failure("No credentials provider"));
+                promise.value().set_value(Result<void>::failure(ResultError::NotConfigured, "No credentials provider"));
                 promise.reset();
             }
-            return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+            return StateTransition::toDisconnected(false);
         }
 
-        const auto credProvider = settings->getCredentialsProvider();
-        const std::vector<std::uint8_t> clientAuthData = credProvider->onAuthChallenge(serverAuthData);
+        // A provider that computes its response off the reactor thread completes later; the state sends it then.
+        pendingResponse = std::make_shared<AsyncResult<std::vector<std::uint8_t>>>(context.getAsyncSignal());
+        settings->getCredentialsProvider()->onAuthChallengeAsync(
+            serverAuthData, AsyncResult<std::vector<std::uint8_t>>::makeSetter(pendingResponse));
 
-        std::vector<packets::properties::Property> responsePropList;
-        if (!clientAuthData.empty())
+        return StateTransition::noTransition();
+    }
+
+    namespace
+    {
+        /// Every AUTH packet carries the method the connection authenticated with, and the data when there is any.
+        void sendAuth(const Context& context, const ReasonCode reasonCode, const std::vector<std::uint8_t>& clientAuthData)
         {
-            responsePropList.emplace_back(
-                packets::properties::Property::
-                    create<packets::properties::PropertyIdentifier::AuthenticationData, std::vector<std::uint8_t>>(clientAuthData));
+            std::vector<packets::properties::Property> responsePropList;
+            if (const auto& settings = context.getSettings(); settings && settings->getCredentialsProvider())
+            {
+                if (std::string authMethod = settings->getCredentialsProvider()->getAuthMethod(); !authMethod.empty())
+                {
+                    responsePropList.emplace_back(
+                        packets::properties::Property::create<packets::properties::PropertyIdentifier::AuthenticationMethod, std::string>(
+                            std::move(authMethod)));
+                }
+            }
+            if (!clientAuthData.empty())
+            {
+                responsePropList.emplace_back(
+                    packets::properties::Property::
+                        create<packets::properties::PropertyIdentifier::AuthenticationData, std::vector<std::uint8_t>>(clientAuthData));
+            }
+            const packets::properties::Properties responseProps(responsePropList);
+
+            const packets::Auth authPacket(reasonCode, responseProps);
+
+            std::vector<std::byte> buffer;
+            serialize::ByteWriter writer(buffer);
+            authPacket.encode(writer);
+
+            if (const auto sock = context.getSocket())
+            {
+                sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+            }
         }
-        const packets::properties::Properties responseProps(responsePropList);
+    } // namespace
 
-        const packets::Auth authResponse(ReasonCode::ContinueAuthentication, responseProps);
+    void sendResponse(const Context& context, const std::vector<std::uint8_t>& clientAuthData)
+    {
+        sendAuth(context, ReasonCode::ContinueAuthentication, clientAuthData);
+    }
+
+    bool isReauthenticationEnabled(const Context& context)
+    {
+        const auto& settings = context.getSettings();
+        return settings && settings->getReauthenticateIntervalMs() != 0 && settings->getCredentialsProvider()
+               && context.getProtocolVersion() == packets::ProtocolVersion::V5
+               && !settings->getCredentialsProvider()->getAuthMethod().empty();
+    }
+
+    void requestReauthentication(const Context& context, PendingResponse& pendingResponse)
+    {
+        pendingResponse = std::make_shared<AsyncResult<std::vector<std::uint8_t>>>(context.getAsyncSignal());
+        context.getSettings()->getCredentialsProvider()->getReauthenticationDataAsync(
+            AsyncResult<std::vector<std::uint8_t>>::makeSetter(pendingResponse));
+    }
 
-        std::vector<std::byte> responseBuffer;
-        serialize::ByteWriter responseWriter(responseBuffer);
-        authResponse.encode(responseWriter);
+    void sendReauthentication(const Context& context, const std::vector<std::uint8_t>& clientAuthData)
+    {
+        sendAuth(context, ReasonCode::ReAuthenticate, clientAuthData);
+    }
 
-        if (const auto sock = context.getSocket())
+    StateTransition handleReauthentication(
+        const Context& context, const packets::IControlPacket& packet, PendingResponse& pendingResponse, bool& isComplete)
+    {
+        if (const auto* authPacket = static_cast<const packets::Auth*>(&packet); authPacket->getReasonCode() == ReasonCode::Success)
         {
-            sock->send(responseBuffer.data(), static_cast<std::uint32_t>(responseBuffer.size()));
+            isComplete = true;
+            return StateTransition::noTransition();
         }
 
-        return StateTransition::noTransition();
+        std::optional<Completion<void>> noPromise;
+        return handle(context, packet, noPromise, pendingResponse);
     }
 } // namespace reactormq::mqtt::client::processing::authentication
\ No newline at end of file
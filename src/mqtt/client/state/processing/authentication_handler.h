@@ -4,10 +4,14 @@
 
 #pragma once
 
+#include "mqtt/client/async_result.h"
+#include "mqtt/client/completion.h"
 #include "mqtt/client/state/state.h"
 
-#include <future>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace reactormq::mqtt::packets
 {
@@ -21,13 +25,59 @@ namespace reactormq::mqtt::client
 
 namespace reactormq::mqtt::client::processing::authentication
 {
+    /// @brief The client's response to an AUTH challenge, delivered by the credentials provider.
+    using PendingResponse = std::shared_ptr<AsyncResult<std::vector<std::uint8_t>>>;
+
     /**
-     * @brief Process an AUTH packet.
+     * @brief Process an AUTH packet and ask the credentials provider for the response, without waiting for it.
      * @param context The client context.
      * @param packet The AUTH packet.
      * @param promise The connection promise to fail if auth fails.
+     * @param pendingResponse Set to the result the provider completes; send it with sendResponse() once it arrives.
      * @return StateTransition (usually noTransition or to DisconnectedState).
      */
     [[nodiscard]] StateTransition handle(
-        const Context& context, const packets::IControlPacket& packet, std::optional<std::promise<Result<void>>>& promise);
+        const Context& context,
+        const packets::IControlPacket& packet,
+        std::optional<Completion<void>>& promise,
+        PendingResponse& pendingResponse);
+
+    /**
+     * @brief Send the AUTH packet continuing the exchange.
+     * @param context The client context.
+     * @param clientAuthData Response from the credentials provider; may be empty.
+     */
+    void sendResponse(const Context& context, const std::vector<std::uint8_t>& clientAuthData);
+
+    /**
+     * @brief Whether the client re-authenticates while connected: MQTT 5, an authentication method and an interval.
+     * @param context The client context.
+     * @return True if ReadyState should schedule re-authentication.
+     */
+    [[nodiscard]] bool isReauthenticationEnabled(const Context& context);
+
+    /**
+     * @brief Ask the credentials provider for the data of a re-authentication, without waiting for it.
+     * @param context The client context.
+     * @param pendingResponse Set to the result the provider completes; send it with sendReauthentication() once it arrives.
+     */
+    void requestReauthentication(const Context& context, PendingResponse& pendingResponse);
+
+    /**
+     * @brief Send the AUTH packet with reason code 0x19 (Re-authenticate) that starts a re-authentication.
+     * @param context The client context.
+     * @param clientAuthData Authentication data from the credentials provider; may be empty.
+     */
+    void sendReauthentication(const Context& context, const std::vector<std::uint8_t>& clientAuthData);
+
+    /**
+     * @brief Process an AUTH packet received while connected, during a re-authentication the client started.
+     * @param context The client context.
+     * @param packet The AUTH packet.
+     * @param pendingResponse Set as by handle() when the broker sends a further challenge.
+     * @param isComplete Set to true when the broker accepted the re-authentication.
+     * @return StateTransition (noTransition, or to DisconnectedState for an AUTH that fails the exchange).
+     */
+    [[nodiscard]] StateTransition handleReauthentication(
+        const Context& context, const packets::IControlPacket& packet, PendingResponse& pendingResponse, bool& isComplete);
 } // namespace reactormq::mqtt::client::processing::authentication
\ No newline at end of file
@@ -6,120 +6,696 @@
 
 #include "mqtt/client/context.h"
 #include "mqtt/client/mqtt_version_mapping.h"
-#include "mqtt/packets/pub_ack.h"
-#include "mqtt/packets/pub_rec.h"
+#include "mqtt/packets/pre_encoded_packets.h"
+#include "mqtt/packets/properties/property_view.h"
 #include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_view.h"
 #include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/message_view.h"
+#include "reactormq/mqtt/shared_payload.h"
+#include "reactormq/mqtt/shared_topic.h"
 #include "serialize/bytes.h"
+#include "serialize/mqtt_codec.h"
 #include "socket/socket.h"
 #include "util/logging/logging.h"
+#include "util/trace/memory_tags.h"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace reactormq::mqtt::client::incoming::publish
 {
     namespace
     {
-        StateTransition handleQos0(Context& context, const packets::IPublishPacket& publish)
+        template<packets::PacketType TAckType>
+        void sendAck(const Context& context, const std::uint16_t packetId)
         {
-            Message message(publish.getTopicName(), publish.getPayload(), publish.getShouldRetain(), QualityOfService::AtMostOnce);
+            if (const auto sock = context.getSocket())
+            {
+                const auto ack = packets::encodeIdOnlyAck<TAckType>(packetId);
+                sock->sendControl(ack);
+            }
+        }
 
-            context.invokeCallback(
-                [&ctx = context, msg = std::move(message)]() mutable
+        /// @brief The payload of a view, sharing the socket's inbound storage when it can and copied when it cannot.
+        SharedPayload toPayload(const Context& context, const std::span<const std::uint8_t> payload)
+        {
+            if (const auto sock = context.getSocket())
+            {
+                if (auto owner = sock->shareInbound(payload))
                 {
-                    ctx.getOnMessage().broadcast(msg);
-                });
+                    return SharedPayload::share(std::move(owner), payload.size(), context.getMemoryResource());
+                }
+            }
+            return SharedPayload::copyOf(payload, context.getMemoryResource());
+        }
 
+        /// @brief Owning message for a view, sharing the interned topic instead of copying it when interning is on.
+        Message toMessage(const Context& context, const MessageView& view, SharedTopic interned)
+        {
+            SharedPayload payload = toPayload(context, view.getPayload());
+            const bool shouldRetain = view.shouldRetain();
+            const QualityOfService qos = view.getQualityOfService();
+            if (interned.isEmpty())
+            {
+                return Message{
+                    Message{ std::string{ view.getTopic() }, std::move(payload), shouldRetain, qos }, context.getTickTimeUtc() };
+            }
+            return Message{ Message{ std::move(interned), std::move(payload), shouldRetain, qos }, context.getTickTimeUtc() };
+        }
+
+        /// @return True if the PUBACK for ackPacketId waits for the handlers, as Context::deliverMessage() reports.
+        bool deliverView(
+            Context& context,
+            const MessageView& view,
+            const packets::SubscriptionIdentifiers& subscriptionIdentifiers,
+            const std::uint16_t ackPacketId = 0)
+        {
+            if (!context.getChunkAssemblers().isEmpty() && context.getChunkAssemblers().deliver(view))
+            {
+                return false;
+            }
+            context.getOnMessageView().broadcast(view);
+
+            // Only build an owning copy when some handler will see it, or the last-value cache keeps it.
+            SharedTopic interned = context.internTopic(view.getTopic());
+            if (context.getLastValues() != nullptr || context.hasMessageHandlers(view.getTopic(), subscriptionIdentifiers.get(), interned))
+            {
+                return context.deliverMessage(
+                    toMessage(context, view, std::move(interned)), subscriptionIdentifiers.get(), ackPacketId);
+            }
+            return false;
+        }
+
+        /// @brief Message for an owning PUBLISH, around the interned topic when interning is on.
+        Message makeMessage(
+            Context& context,
+            std::string topic,
+            std::vector<std::uint8_t> payload,
+            const bool shouldRetain,
+            const QualityOfService qos)
+        {
+            if (SharedTopic interned = context.internTopic(topic); !interned.isEmpty())
+            {
+                return Message{ Message{ std::move(interned), SharedPayload{ std::move(payload) }, shouldRetain, qos },
+                                context.getTickTimeUtc() };
+            }
+            return Message{ Message{ std::move(topic), std::move(payload), shouldRetain, qos }, context.getTickTimeUtc() };
+        }
+
+        enum class PayloadDecoding : std::uint8_t
+        {
+            Plain,
+            Decoded,
+            Failed
+        };
+
+        /// @brief Undo the payload codec a PUBLISH names, if any; a codec this client does not know leaves the payload as it is.
+        PayloadDecoding decodePayload(
+            const Context& context,
+            const std::string_view codecName,
+            const std::span<const std::uint8_t> payload,
+            std::vector<std::uint8_t>& out)
+        {
+            if (codecName.empty() || context.getPayloadCodecs().isEmpty())
+            {
+                return PayloadDecoding::Plain;
+            }
+
+            const IPayloadCodec* codec = context.getPayloadCodecs().findByName(codecName);
+            if (nullptr == codec)
+            {
+                REACTORMQ_LOG_RATELIMITED(
+                    logging::LogLevel::Warn,
+                    10,
+                    "PUBLISH with unknown payload codec delivered as received: %.*s",
+                    static_cast<int>(codecName.size()),
+                    codecName.data());
+                return PayloadDecoding::Plain;
+            }
+
+            const auto& settings = context.getSettings();
+            const size_t maxSize = settings ? settings->getMaxBufferSize() : payload.size();
+            if (!codec->decode(payload, maxSize, out))
+            {
+                REACTORMQ_LOG(
+                    logging::LogLevel::Error,
+                    "PUBLISH payload failed to decode with codec %.*s; message dropped",
+                    static_cast<int>(codecName.size()),
+                    codecName.data());
+                return PayloadDecoding::Failed;
+            }
+            return PayloadDecoding::Decoded;
+        }
+
+        /// @brief Acknowledge a PUBLISH whose payload cannot be decoded, so the broker does not resend it forever.
+        StateTransition dropUndecodable(const Context& context, const QualityOfService qos, const std::uint16_t packetId)
+        {
+            // Nothing is stored for a QoS 2 message, so its packet ID stays untracked and the PUBREL gets its PUBCOMP.
+            if (qos == QualityOfService::AtLeastOnce)
+            {
+                sendAck<packets::PacketType::PubAck>(context, packetId);
+            }
+            else if (qos == QualityOfService::ExactlyOnce)
+            {
+                sendAck<packets::PacketType::PubRec>(context, packetId);
+            }
             return StateTransition::noTransition();
         }
 
-        StateTransition handleQos1(Context& context, const packets::IPublishPacket& publish)
+        StateTransition rejectTopicAlias(const Context& context, const std::uint16_t alias)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "PUBLISH with invalid or unknown topic alias %u dropped", alias);
+            if (const auto& settings = context.getSettings(); settings && settings->isStrictMode())
+            {
+                return StateTransition::toDisconnected(false);
+            }
+            return StateTransition::noTransition();
+        }
+
+        /// @brief Topic to deliver: moved out of the packet, or copied from the alias table for an alias-only PUBLISH.
+        template<typename TPublish>
+        std::optional<std::string> takeTopic(Context& context, TPublish& publish)
+        {
+            const std::uint16_t alias = publish.getTopicAlias();
+            if (alias == 0)
+            {
+                return publish.takeTopicName();
+            }
+
+            const auto resolved = context.getInboundTopicAliases().resolve(alias, publish.getTopicName());
+            if (!resolved.has_value())
+            {
+                return std::nullopt;
+            }
+
+            return publish.getTopicName().empty() ? std::string{ resolved.value() } : publish.takeTopicName();
+        }
+
+        template<typename TPublish>
+        StateTransition handleQos0(Context& context, TPublish& publish, std::string topic, std::vector<std::uint8_t> payload)
+        {
+            Message message
+                = makeMessage(context, std::move(topic), std::move(payload), publish.getShouldRetain(), QualityOfService::AtMostOnce);
+
+            context.deliverMessage(std::move(message), publish.getSubscriptionIdentifiers().get());
+
+            return StateTransition::noTransition();
+        }
+
+        template<typename TPublish>
+        StateTransition handleQos1(Context& context, TPublish& publish, std::string topic, std::vector<std::uint8_t> payload)
         {
             const std::uint16_t packetId = publish.getPacketId();
             if (!context.trackIncomingPacketId(packetId))
             {
-                REACTORMQ_LOG(logging::LogLevel::Warn, "Duplicate QoS 1 PUBLISH packet ID: %u", packetId);
+                REACTORMQ_LOG_RATELIMITED(logging::LogLevel::Warn, 10, "Duplicate QoS 1 PUBLISH packet ID: %u", packetId);
                 return StateTransition::noTransition();
             }
 
-            Message message(publish.getTopicName(), publish.getPayload(), publish.getShouldRetain(), QualityOfService::AtLeastOnce);
-
-            context.invokeCallback(
-                [&ctx = context, msg = std::move(message)]() mutable
-                {
-                    ctx.getOnMessage().broadcast(msg);
-                });
-
-            std::vector<std::byte> buffer;
-            serialize::ByteWriter writer(buffer);
-            withMqttVersion(
-                context.getProtocolVersion(),
-                [&writer, &packetId]<typename VersionTag>(VersionTag)
-                {
-                    constexpr auto kV = VersionTag::value;
-                    packets::encodePubAckToWriter<kV>(writer, packetId);
-                });
+            Message message
+                = makeMessage(context, std::move(topic), std::move(payload), publish.getShouldRetain(), QualityOfService::AtLeastOnce);
 
-            if (const auto sock = context.getSocket())
+            if (context.deliverMessage(std::move(message), publish.getSubscriptionIdentifiers().get(), packetId))
             {
-                sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+                return StateTransition::noTransition();
             }
 
+            sendAck<packets::PacketType::PubAck>(context, packetId);
+
             context.releaseIncomingPacketId(packetId);
 
             return StateTransition::noTransition();
         }
 
-        StateTransition handleQos2(Context& context, const packets::IPublishPacket& publish)
+        /// @brief Whether a QoS 2 message is delivered on PUBLISH, only its packet ID kept until PUBREL.
+        bool shouldDeliverQos2OnPublish(const Context& context)
+        {
+            const auto& settings = context.getSettings();
+            return settings && settings->shouldDeliverQos2OnPublish();
+        }
+
+        template<typename TPublish>
+        StateTransition handleQos2(Context& context, TPublish& publish, std::string topic, std::vector<std::uint8_t> payload)
         {
             const std::uint16_t packetId = publish.getPacketId();
+            if (shouldDeliverQos2OnPublish(context))
+            {
+                // A resent PUBLISH is only acknowledged again: the broker resends when the first PUBREC did not arrive.
+                if (context.trackDeliveredQos2PacketId(packetId))
+                {
+                    Message message = makeMessage(
+                        context, std::move(topic), std::move(payload), publish.getShouldRetain(), QualityOfService::ExactlyOnce);
+                    context.deliverMessage(std::move(message), publish.getSubscriptionIdentifiers().get());
+                }
+                sendAck<packets::PacketType::PubRec>(context, packetId);
+                return StateTransition::noTransition();
+            }
+
             if (!context.trackIncomingPacketId(packetId))
             {
-                REACTORMQ_LOG(logging::LogLevel::Warn, "Duplicate QoS 2 PUBLISH packet ID: %u", packetId);
+                REACTORMQ_LOG_RATELIMITED(logging::LogLevel::Warn, 10, "Duplicate QoS 2 PUBLISH packet ID: %u", packetId);
                 return StateTransition::noTransition();
             }
 
-            Message message(publish.getTopicName(), publish.getPayload(), publish.getShouldRetain(), QualityOfService::ExactlyOnce);
+            Message message
+                = makeMessage(context, std::move(topic), std::move(payload), publish.getShouldRetain(), QualityOfService::ExactlyOnce);
 
             context.storePendingIncomingQos2Message(packetId, std::move(message));
 
-            std::vector<std::byte> buffer;
-            serialize::ByteWriter writer(buffer);
-            withMqttVersion(
-                context.getProtocolVersion(),
-                [&writer, &packetId]<typename VersionTag>(VersionTag)
+            sendAck<packets::PacketType::PubRec>(context, packetId);
+
+            return StateTransition::noTransition();
+        }
+
+        /**
+         * @brief Offset of the payload in a streamed PUBLISH, from the packet bytes gathered so far.
+         * @return The offset; 0 while too few bytes are in to tell; std::nullopt if the header is malformed.
+         */
+        std::optional<size_t> findPayloadOffset(
+            const std::span<const std::uint8_t> gathered,
+            const socket::InboundFrame& fragment,
+            const QualityOfService qos,
+            const bool hasProperties)
+        {
+            size_t offset = fragment.headerSize;
+            if (gathered.size() < offset + 2)
+            {
+                return 0;
+            }
+            offset += 2 + (static_cast<size_t>(gathered[offset]) << 8 | gathered[offset + 1]);
+            offset += qos != QualityOfService::AtMostOnce ? 2 : 0;
+
+            if (hasProperties)
+            {
+                if (gathered.size() <= offset)
                 {
-                    constexpr auto kV = VersionTag::value;
-                    packets::encodePubRecToWriter<kV>(writer, packetId);
-                });
+                    return offset <= fragment.getPacketSize() ? std::optional<size_t>{ 0 } : std::nullopt;
+                }
 
-            if (const auto sock = context.getSocket())
+                std::uint32_t propertiesLength = 0;
+                size_t lengthSize = 0;
+                switch (serialize::scanVariableByteInteger(gathered.subspan(offset), propertiesLength, lengthSize))
+                {
+                case serialize::VariableByteIntegerStatus::Incomplete:
+                    return 0;
+                case serialize::VariableByteIntegerStatus::Malformed:
+                    return std::nullopt;
+                case serialize::VariableByteIntegerStatus::Complete:
+                    offset += lengthSize + propertiesLength;
+                    break;
+                }
+            }
+
+            if (offset > fragment.getPacketSize())
             {
-                sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+                return std::nullopt;
             }
+            return gathered.size() >= offset ? offset : 0;
+        }
 
+        /**
+         * @brief Parse the header of a streamed PUBLISH once it is in, and choose where the payload goes.
+         * The header is parsed as a PUBLISH with an empty payload, so topic aliases and properties work as for any other.
+         */
+        StateTransition beginStream(Context& context, const socket::InboundFrame& fragment)
+        {
+            InboundStream& stream = context.getInboundStream();
+            const size_t variableHeaderSize = stream.payloadOffset - fragment.headerSize;
+
+            std::vector<std::byte> header;
+            header.reserve(1 + serialize::mqtt::kMaxVariableByteSize + variableHeaderSize);
+            serialize::ByteWriter writer(header);
+            writer.writeUint8(fragment.typeAndFlags);
+            serialize::encodeVariableByteInteger(static_cast<std::uint32_t>(variableHeaderSize), writer);
+            writer.writeBytes(reinterpret_cast<const std::byte*>(stream.gathered.data() + fragment.headerSize), variableHeaderSize);
+
+            const auto packet
+                = context.parsePublishView(reinterpret_cast<const std::uint8_t*>(header.data()), static_cast<std::uint32_t>(header.size()));
+            if (packet == nullptr || !packet->isValid())
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "Streamed PUBLISH with a malformed header dropped");
+                stream.isSkipped = true;
+                return StateTransition::noTransition();
+            }
+
+            const auto& publish = static_cast<const packets::IPublishView&>(*packet);
+            const QualityOfService qos = publish.getQualityOfService();
+            stream.packetId = publish.getPacketId();
+            std::string_view topic = publish.getTopicName();
+            if (const std::uint16_t alias = publish.getTopicAlias(); alias != 0)
+            {
+                const auto resolved = context.getInboundTopicAliases().resolve(alias, topic);
+                if (!resolved.has_value())
+                {
+                    stream.isSkipped = true;
+                    return rejectTopicAlias(context, alias);
+                }
+                topic = resolved.value();
+            }
+
+            if (qos != QualityOfService::AtMostOnce && !context.trackIncomingPacketId(stream.packetId))
+            {
+                REACTORMQ_LOG_RATELIMITED(logging::LogLevel::Warn, 10, "Duplicate streamed PUBLISH packet ID: %u", stream.packetId);
+                stream.isSkipped = true;
+                return StateTransition::noTransition();
+            }
+
+            stream.sink = context.getPayloadSinks().find(topic);
+            if (stream.sink)
+            {
+                ClientMetricCounters::increment(context.getMetricCounters().messagesReceived);
+                const std::span<const std::byte> rawProperties = publish.getRawProperties();
+                const MessageView view(
+                    topic,
+                    {},
+                    publish.getShouldRetain(),
+                    qos,
+                    { reinterpret_cast<const std::uint8_t*>(rawProperties.data()), rawProperties.size() });
+                stream.sink->onBegin(view, fragment.getPacketSize() - stream.payloadOffset);
+                return StateTransition::noTransition();
+            }
+
+            // Ordinary delivery tracks the packet ID itself once the packet is whole.
+            if (qos != QualityOfService::AtMostOnce)
+            {
+                context.releaseIncomingPacketId(stream.packetId);
+            }
+
+            const auto& settings = context.getSettings();
+            if (settings && fragment.getPacketSize() > settings->getMaxBufferSize())
+            {
+                REACTORMQ_LOG_RATELIMITED(
+                    logging::LogLevel::Warn,
+                    10,
+                    "Streamed PUBLISH of %zu bytes on %.*s matches no payload sink and exceeds the buffer; dropped",
+                    fragment.getPacketSize(),
+                    static_cast<int>(topic.size()),
+                    topic.data());
+                stream.isSkipped = true;
+                stream.shouldAcknowledge = qos != QualityOfService::AtMostOnce;
+            }
             return StateTransition::noTransition();
         }
+
+        /// @brief Acknowledge a streamed PUBLISH whose last byte is in.
+        void finishStream(Context& context, const QualityOfService qos)
+        {
+            const InboundStream& stream = context.getInboundStream();
+            if (stream.sink)
+            {
+                stream.sink->onEnd(true);
+            }
+            else if (!stream.shouldAcknowledge)
+            {
+                return;
+            }
+
+            // With the payload already handed over, QoS 2 has nothing left to deliver on PUBREL, which is then answered
+            // as for an unknown packet ID.
+            if (qos == QualityOfService::AtLeastOnce)
+            {
+                sendAck<packets::PacketType::PubAck>(context, stream.packetId);
+            }
+            else if (qos == QualityOfService::ExactlyOnce)
+            {
+                sendAck<packets::PacketType::PubRec>(context, stream.packetId);
+            }
+            if (stream.sink && qos != QualityOfService::AtMostOnce)
+            {
+                context.releaseIncomingPacketId(stream.packetId);
+            }
+        }
+
+        /// @brief Deliver a decoded PUBLISH; TPublish is its concrete type on the fast path, so its getters bind statically.
+        template<typename TPublish>
+        StateTransition broadcastPacket(Context& context, TPublish& publish)
+        {
+            auto topic = takeTopic(context, publish);
+            if (!topic.has_value())
+            {
+                return rejectTopicAlias(context, publish.getTopicAlias());
+            }
+
+            std::vector<std::uint8_t> payload = publish.takePayload();
+            std::vector<std::uint8_t> decoded;
+            switch (decodePayload(context, publish.getPayloadCodec(), payload, decoded))
+            {
+            case PayloadDecoding::Decoded:
+                payload = std::move(decoded);
+                break;
+            case PayloadDecoding::Failed:
+                return dropUndecodable(context, publish.getQualityOfService(), publish.getPacketId());
+            case PayloadDecoding::Plain:
+                break;
+            }
+
+            // Responses are subscribed to at QoS 0, so only a QoS 0 message can be one.
+            if (publish.getQualityOfService() == QualityOfService::AtMostOnce && context.isResponseTopic(topic.value()))
+            {
+                const MessageView response(topic.value(), payload, publish.getShouldRetain(), QualityOfService::AtMostOnce);
+                context.completeRequest(response, publish.getCorrelationData());
+                return StateTransition::noTransition();
+            }
+
+            switch (publish.getQualityOfService())
+            {
+                using enum QualityOfService;
+            case AtMostOnce:
+                return handleQos0(context, publish, std::move(topic.value()), std::move(payload));
+            case AtLeastOnce:
+                return handleQos1(context, publish, std::move(topic.value()), std::move(payload));
+            case ExactlyOnce:
+                return handleQos2(context, publish, std::move(topic.value()), std::move(payload));
+            default:
+                REACTORMQ_LOG(logging::LogLevel::Warn, "Invalid QoS level in PUBLISH packet");
+                return StateTransition::noTransition();
+            }
+        }
+
+        /// @brief Deliver a PUBLISH decoded as a view; TPublish is its concrete type on the fast path.
+        template<typename TPublish>
+        StateTransition broadcastPacketView(Context& context, const TPublish& publish)
+        {
+            std::string_view topic = publish.getTopicName();
+            if (const std::uint16_t alias = publish.getTopicAlias(); alias != 0)
+            {
+                const auto resolved = context.getInboundTopicAliases().resolve(alias, topic);
+                if (!resolved.has_value())
+                {
+                    return rejectTopicAlias(context, alias);
+                }
+                topic = resolved.value();
+            }
+
+            const QualityOfService qos = publish.getQualityOfService();
+            std::span<const std::uint8_t> payload = publish.getPayload();
+            std::vector<std::uint8_t> decoded;
+            switch (decodePayload(context, publish.getPayloadCodec(), payload, decoded))
+            {
+            case PayloadDecoding::Decoded:
+                payload = decoded;
+                break;
+            case PayloadDecoding::Failed:
+                return dropUndecodable(context, qos, publish.getPacketId());
+            case PayloadDecoding::Plain:
+                break;
+            }
+            const std::span<const std::byte> rawProperties = publish.getRawProperties();
+            const MessageView view(
+                topic,
+                payload,
+                publish.getShouldRetain(),
+                qos,
+                { reinterpret_cast<const std::uint8_t*>(rawProperties.data()), rawProperties.size() });
+
+            switch (qos)
+            {
+                using enum QualityOfService;
+            case AtMostOnce:
+                if (context.isResponseTopic(topic))
+                {
+                    const auto correlationData = packets::properties::PropertiesView(rawProperties).find(
+                        packets::properties::PropertyIdentifier::CorrelationData);
+                    context.completeRequest(
+                        view, correlationData.has_value() ? correlationData->getBinary() : std::span<const std::uint8_t>{});
+                    return StateTransition::noTransition();
+                }
+                deliverView(context, view, publish.getSubscriptionIdentifiers());
+                return StateTransition::noTransition();
+            case AtLeastOnce:
+                {
+                    const std::uint16_t packetId = publish.getPacketId();
+                    if (!context.trackIncomingPacketId(packetId))
+                    {
+                        REACTORMQ_LOG_RATELIMITED(logging::LogLevel::Warn, 10, "Duplicate QoS 1 PUBLISH packet ID: %u", packetId);
+                        return StateTransition::noTransition();
+                    }
+
+                    if (deliverView(context, view, publish.getSubscriptionIdentifiers(), packetId))
+                    {
+                        return StateTransition::noTransition();
+                    }
+
+                    sendAck<packets::PacketType::PubAck>(context, packetId);
+                    context.releaseIncomingPacketId(packetId);
+                    return StateTransition::noTransition();
+                }
+            case ExactlyOnce:
+                {
+                    const std::uint16_t packetId = publish.getPacketId();
+                    if (shouldDeliverQos2OnPublish(context))
+                    {
+                        if (context.trackDeliveredQos2PacketId(packetId))
+                        {
+                            deliverView(context, view, publish.getSubscriptionIdentifiers());
+                        }
+                        sendAck<packets::PacketType::PubRec>(context, packetId);
+                        return StateTransition::noTransition();
+                    }
+
+                    if (!context.trackIncomingPacketId(packetId))
+                    {
+                        REACTORMQ_LOG_RATELIMITED(logging::LogLevel::Warn, 10, "Duplicate QoS 2 PUBLISH packet ID: %u", packetId);
+                        return StateTransition::noTransition();
+                    }
+
+                    // Delivery waits for PUBREL, long after the receive buffer is reused, so this one has to own its data;
+                    // the property block is not kept, so the view delivered then carries none.
+                    context.storePendingIncomingQos2Message(
+                        packetId, toMessage(context, view, context.internTopic(view.getTopic())));
+                    sendAck<packets::PacketType::PubRec>(context, packetId);
+                    return StateTransition::noTransition();
+                }
+            default:
+                REACTORMQ_LOG(logging::LogLevel::Warn, "Invalid QoS level in PUBLISH packet");
+                return StateTransition::noTransition();
+            }
+        }
     } // namespace
 
-    [[nodiscard]] StateTransition broadcast(Context& context, const packets::IControlPacket& packet)
+    [[nodiscard]] StateTransition broadcast(Context& context, packets::IControlPacket& packet)
     {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Payload);
         if (packet.getPacketType() != packets::PacketType::Publish)
         {
             REACTORMQ_LOG(logging::LogLevel::Warn, "Unexpected packet type: Publish {}", packetTypeToString(packet.getPacketType()));
             return StateTransition::noTransition();
         }
 
-        switch (const auto publish = static_cast<const packets::IPublishPacket*>(&packet); publish->getQualityOfService())
+        return broadcastPacket(context, static_cast<packets::IPublishPacket&>(packet));
+    }
+
+    [[nodiscard]] StateTransition broadcastView(Context& context, const packets::IPublishView& publish)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Payload);
+        return broadcastPacketView(context, publish);
+    }
+
+    std::optional<StateTransition> receive(Context& context, const socket::InboundFrame& frame)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Payload);
+        if (!context.isParseableFrame(std::as_bytes(frame.bytes)))
         {
-            using enum QualityOfService;
-        case AtMostOnce:
-            return handleQos0(context, *publish);
-        case AtLeastOnce:
-            return handleQos1(context, *publish);
-        case ExactlyOnce:
-            return handleQos2(context, *publish);
-        default:
-            REACTORMQ_LOG(logging::LogLevel::Warn, "Invalid QoS level in PUBLISH packet");
-            return StateTransition::noTransition();
+            return std::nullopt;
+        }
+
+        const packets::FixedHeader fixedHeader = packets::FixedHeader::create(frame.typeAndFlags, frame.remainingLength);
+        serialize::ByteReader reader(std::as_bytes(frame.getBody()));
+        const bool isView = context.shouldDecodePublishViews();
+        return withMqttVersion(
+            context.getProtocolVersion(),
+            [&context, &reader, &fixedHeader, isView]<typename VersionTag>(VersionTag) -> std::optional<StateTransition>
+            {
+                constexpr auto kV = VersionTag::value;
+                if (isView)
+                {
+                    const packets::PublishView<kV> publish(reader, fixedHeader);
+                    if (!publish.isValid())
+                    {
+                        REACTORMQ_LOG(logging::LogLevel::Error, "Malformed packet of type: %d", packets::PacketType::Publish);
+                        return std::nullopt;
+                    }
+                    return broadcastPacketView(context, publish);
+                }
+
+                packets::Publish<kV> publish(reader, fixedHeader);
+                if (!publish.isValid())
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Error, "Malformed packet of type: %d", packets::PacketType::Publish);
+                    return std::nullopt;
+                }
+                return broadcastPacket(context, publish);
+            });
+    }
+
+    StateTransition receiveFragment(Context& context, const socket::InboundFrame& fragment, std::span<const std::uint8_t>& outPacket)
+    {
+        if (fragment.fragmentOffset == 0)
+        {
+            context.abandonInboundStream();
+        }
+
+        InboundStream& stream = context.getInboundStream();
+        const auto qos = static_cast<QualityOfService>((fragment.typeAndFlags >> 1) & 0x03);
+        StateTransition transition = StateTransition::noTransition();
+        std::span<const std::uint8_t> chunk = fragment.bytes;
+
+        // Gather the header, and the whole packet when it goes through ordinary delivery.
+        if (!stream.sink && !stream.isSkipped)
+        {
+            stream.gathered.insert(stream.gathered.end(), chunk.begin(), chunk.end());
+            chunk = {};
+            if (stream.payloadOffset == 0)
+            {
+                const bool hasProperties = context.getProtocolVersion() == packets::ProtocolVersion::V5;
+                const std::optional<size_t> payloadOffset = findPayloadOffset(stream.gathered, fragment, qos, hasProperties);
+                const auto& settings = context.getSettings();
+                if (!payloadOffset.has_value() || (payloadOffset == 0 && settings && stream.gathered.size() > settings->getMaxBufferSize()))
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Error, "Streamed PUBLISH with a malformed or oversized header dropped");
+                    stream.isSkipped = true;
+                }
+                else if (payloadOffset.value() != 0)
+                {
+                    stream.payloadOffset = payloadOffset.value();
+                    transition = beginStream(context, fragment);
+                    if (stream.sink)
+                    {
+                        chunk = std::span{ stream.gathered }.subspan(stream.payloadOffset);
+                    }
+                }
+            }
+        }
+
+        if (stream.sink)
+        {
+            if (!chunk.empty())
+            {
+                stream.sink->onChunk(chunk);
+            }
+            stream.gathered.clear();
         }
+        else if (stream.isSkipped)
+        {
+            stream.gathered = {};
+        }
+
+        if (!fragment.isLastFragment())
+        {
+            return transition;
+        }
+
+        if (!stream.sink && !stream.isSkipped)
+        {
+            outPacket = stream.gathered;
+            return transition;
+        }
+
+        finishStream(context, qos);
+        stream = InboundStream{};
+        return transition;
     }
-} // namespace reactormq::mqtt::client::incoming::publish
\ No newline at end of file
+} // namespace reactormq::mqtt::client::incoming::publish
@@ -6,9 +6,14 @@
 
 #include "mqtt/client/state/state.h"
 
+#include <cstdint>
+#include <optional>
+#include <span>
+
 namespace reactormq::mqtt::packets
 {
     class IPublishPacket;
+    class IPublishView;
 }
 
 namespace reactormq::mqtt::client
@@ -16,13 +21,52 @@ namespace reactormq::mqtt::client
     class Context;
 }
 
+namespace reactormq::socket
+{
+    struct InboundFrame;
+}
+
 namespace reactormq::mqtt::client::incoming::publish
 {
     /**
      * @brief Handle an incoming PUBLISH packet and broadcasts to subscribers.
+     * The topic and payload are moved out of the packet into the delivered Message.
      * @param context The client context.
      * @param packet The generic control packet (must be PUBLISH).
      * @return StateTransition (usually noTransition).
      */
-    StateTransition broadcast(Context& context, const packets::IControlPacket& packet);
+    StateTransition broadcast(Context& context, packets::IControlPacket& packet);
+
+    /**
+     * @brief Handle an incoming PUBLISH decoded as a view and deliver it without copying.
+     * OnMessageView handlers run synchronously on the view; an owning Message is only built when OnMessage handlers
+     * are bound, or for QoS 2, where delivery waits for PUBREL.
+     * @param context The client context.
+     * @param publish The PUBLISH packet viewing the receive buffer.
+     * @return StateTransition (usually noTransition).
+     */
+    StateTransition broadcastView(Context& context, const packets::IPublishView& publish);
+
+    /**
+     * @brief Decode a whole PUBLISH frame and deliver it, as a view when OnMessageView handlers are bound.
+     * The packet is decoded on the stack as its concrete type for the negotiated protocol version, so neither the packet
+     * arena nor the packet interfaces are involved.
+     * @param context The client context.
+     * @param frame The PUBLISH and its decoded fixed header.
+     * @return StateTransition (usually noTransition); empty if the frame is not a well-formed PUBLISH.
+     */
+    std::optional<StateTransition> receive(Context& context, const socket::InboundFrame& frame);
+
+    /**
+     * @brief Handle the next fragment of a PUBLISH over the inbound streaming threshold.
+     * Once the header is in, the payload goes chunk by chunk to the sink of the subscription the topic matches, and the
+     * message is acknowledged after its last byte; QoS 2 messages are handed over on arrival, not on PUBREL. Without a
+     * sink, a packet that fits the max buffer size is gathered whole, and one that does not is acknowledged and dropped.
+     * @param context The client context.
+     * @param fragment The fragment.
+     * @param outPacket Set to the whole packet once a gathered one is complete, for the caller to handle like any other
+     * and then reset the context's inbound stream; left empty otherwise.
+     * @return StateTransition (usually noTransition).
+     */
+    StateTransition receiveFragment(Context& context, const socket::InboundFrame& fragment, std::span<const std::uint8_t>& outPacket);
 } // namespace reactormq::mqtt::client::incoming::publish
\ No newline at end of file
@@ -4,27 +4,48 @@
 
 #include "ready_state.h"
 #include "acknowledgement/subscription_acknowledgement.h"
+#include "closing_state.h"
 #include "acknowledgement/unsubscription_acknowledgement.h"
+#include "processing/authentication_handler.h"
 #include "processing/incoming_publish.h"
 
-#include "closing_state.h"
-#include "disconnected_state.h"
 #include "mqtt/client/command.h"
 #include "mqtt/packets/fixed_header.h"
-#include "mqtt/packets/ping_req.h"
-#include "mqtt/packets/pub_comp.h"
+#include "mqtt/packets/pre_encoded_packets.h"
 #include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_template.h"
+#include "mqtt/packets/publish_view.h"
 #include "mqtt/packets/subscribe.h"
+#include "reactormq/mqtt/message_view.h"
 #include "serialize/bytes.h"
+#include "serialize/utf8.h"
 #include "socket/socket.h"
 
 #include <mqtt/client/mqtt_version_mapping.h>
-#include <ranges>
+#include <algorithm>
+#include <array>
 
 namespace reactormq::mqtt::client
 {
+    namespace
+    {
+        /// Largest Remaining Length a four-byte Variable Byte Integer can carry.
+        constexpr size_t kMaxRemainingLength = 268435455;
+
+        /// First byte of every PUBACK: the packet type and its reserved flags, which must be zero.
+        constexpr std::uint8_t kPubAckTypeAndFlags = static_cast<std::uint8_t>(packets::PacketType::PubAck) << 4;
+
+        /// Strict mode checks topics before they go out, so a malformed one fails its own command, not the connection.
+        bool shouldValidateTopics(const Context& context)
+        {
+            const auto& settings = context.getSettings();
+            return settings && settings->isStrictMode();
+        }
+    } // namespace
+
     StateTransition ReadyState::onEnter(Context& context)
     {
+        ClientMetricCounters::increment(context.getMetricCounters().connections);
         context.invokeCallback(
             [&ctx = context]
             {
@@ -32,14 +53,68 @@ namespace reactormq::mqtt::client
             });
         context.recordActivity();
 
+        if (const auto& settings = context.getSettings(); settings && settings->getKeepAliveIntervalSeconds() != 0)
+        {
+            const auto keepaliveMs = std::chrono::milliseconds(settings->getKeepAliveIntervalSeconds() * 1000);
+            context.getTimers().schedule(TimerKey{ TimerKind::Keepalive }, context.getLastSendTime() + keepaliveMs);
+        }
+
+        // CONNECT just authenticated, so the first re-authentication is one full interval away.
+        if (processing::authentication::isReauthenticationEnabled(context))
+        {
+            const auto intervalMs = std::chrono::milliseconds(context.getSettings()->getReauthenticateIntervalMs());
+            context.getTimers().schedule(TimerKey{ TimerKind::Reauthenticate }, context.getNow() + intervalMs);
+        }
+
+        // A broker that lost its state while disconnected gets every topic again, changed or not.
+        if (PublishDeduplicator* const deduplicator = context.getPublishDeduplicator())
+        {
+            deduplicator->clear();
+        }
+
         context.retransmitPendingPublishes();
+        sendHeldPublishes(context);
+        releaseRateLimitedPublishes(context);
+
+        if (!context.isSessionPresent())
+        {
+            context.setResponseTopicSubscribed(false);
+            context.clearDeliveredQos2PacketIds();
+            context.releaseHeldIncomingQos2Messages();
+        }
+
+        if (const auto sock = context.getSocket())
+        {
+            resubscribe(context, *sock);
+
+            // Publishes made while offline go through the normal path, so Receive Maximum holds them where needed.
+            auto& offline = context.getOfflinePublishes();
+            while (auto publish = offline.pop())
+            {
+                (void)handlePublishCommand(context, *sock, publish.value());
+            }
+        }
 
         return StateTransition::noTransition();
     }
 
     void ReadyState::onExit(Context& context)
     {
+        ClientMetricCounters::increment(context.getMetricCounters().disconnects);
+        context.getTimers().cancel(TimerKey{ TimerKind::Keepalive });
+        context.getTimers().cancel(TimerKey{ TimerKind::RateLimit });
+        context.getTimers().cancel(TimerKey{ TimerKind::Reauthenticate });
+        context.getTimers().cancel(TimerKey{ TimerKind::DrainTimeout });
         context.setPingPending(false);
+        context.abandonDeferredAcks();
+        context.abandonInboundStream();
+
+        // The connection went down under the drain; the caller asked to disconnect, and it is disconnected.
+        if (m_drainPromise.has_value())
+        {
+            m_drainPromise->set_value(Result<void>::success());
+            m_drainPromise.reset();
+        }
     }
 
     StateTransition ReadyState::handleCommand(Context& context, Command& command)
@@ -50,6 +125,21 @@ namespace reactormq::mqtt::client
             return StateTransition::noTransition();
         }
 
+        if (m_drainPromise.has_value())
+        {
+            // A second disconnect cuts the drain short; it and the first complete together once Closing is done.
+            if (auto* disconnectCmd = std::get_if<DisconnectCommand>(&command))
+            {
+                auto& [promise, drain] = *disconnectCmd;
+                m_drainPromise->set_value(Result<void>::success());
+                m_drainPromise.reset();
+                return StateTransition::toClosing(std::move(promise));
+            }
+
+            ClosingState::rejectCommand(command);
+            return StateTransition::noTransition();
+        }
+
         if (auto* publishCmd = std::get_if<PublishCommand>(&command))
         {
             return handlePublishCommand(context, *sock, *publishCmd);
@@ -70,10 +160,19 @@ namespace reactormq::mqtt::client
             return handleUnsubscribesCommand(context, *sock, *unsubscribesCmd);
         }
 
+        if (auto* requestCmd = std::get_if<RequestCommand>(&command))
+        {
+            return handleRequestCommand(context, *sock, *requestCmd);
+        }
+
         if (auto* disconnectCmd = std::get_if<DisconnectCommand>(&command))
         {
-            auto& [promise] = *disconnectCmd;
-            return StateTransition::transitionTo(std::make_unique<ClosingState>(std::move(promise)));
+            auto& [promise, drain] = *disconnectCmd;
+            if (drain.has_value())
+            {
+                return startDrain(context, std::move(promise), *drain);
+            }
+            return StateTransition::toClosing(std::move(promise));
         }
 
         return StateTransition::noTransition();
@@ -86,28 +185,87 @@ namespace reactormq::mqtt::client
 
     StateTransition ReadyState::onSocketDisconnected(Context& /*context*/)
     {
-        return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+        // Losing the link while draining still ends a disconnect the caller asked for, so it must not reconnect.
+        return StateTransition::toDisconnected(m_drainPromise.has_value());
     }
 
-    StateTransition ReadyState::onDataReceived(Context& context, const uint8_t* data, const uint32_t size)
+    StateTransition ReadyState::onDataReceived(Context& context, const socket::InboundFrame& frame)
     {
-        const auto packet = context.parsePacket(data, size);
-        if (packet == nullptr)
+        StateTransition transition = receivePacket(context, frame);
+        if (transition.newState.has_value() || !m_drainPromise.has_value())
         {
-            if (const auto settings = context.getSettings(); settings && settings->isStrictMode())
+            return transition;
+        }
+
+        // The last acknowledgement ends the drain here rather than on the next tick, which may be a wait away.
+        return finishDrainIfDone(context);
+    }
+
+    StateTransition ReadyState::onDataReceivedBatch(
+        Context& context,
+        const std::span<const socket::InboundFrame> frames,
+        size_t& handled)
+    {
+        handled = 0;
+        while (handled < frames.size())
+        {
+            StateTransition transition = receivePacket(context, frames[handled++]);
+            if (transition.newState.has_value())
             {
-                return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+                return transition;
             }
-            return StateTransition::noTransition();
+            if (context.isReceivePaused())
+            {
+                break;
+            }
+        }
+
+        return m_drainPromise.has_value() ? finishDrainIfDone(context) : StateTransition::noTransition();
+    }
+
+    StateTransition ReadyState::receivePacket(Context& context, const socket::InboundFrame& frame)
+    {
+        if (frame.isFragment)
+        {
+            // A PUBLISH that no sink takes is handed back whole once its last fragment is in.
+            std::span<const std::uint8_t> gathered;
+            StateTransition transition = incoming::publish::receiveFragment(context, frame, gathered);
+            if (gathered.empty())
+            {
+                return transition;
+            }
+
+            StateTransition result = receivePacket(context, socket::InboundFrame::fromBytes(gathered));
+            context.getInboundStream() = InboundStream{};
+            return result;
         }
 
-        if (!packet->isValid())
+        // PUBLISH and PUBACK are nearly all the traffic of a busy connection, so they are decoded straight from the frame.
+        switch (static_cast<packets::PacketType>(frame.typeAndFlags >> 4))
         {
-            if (const auto settings = context.getSettings(); settings && settings->isStrictMode())
+        case packets::PacketType::Publish:
+            if (auto transition = incoming::publish::receive(context, frame))
             {
-                return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+                ClientMetricCounters::increment(context.getMetricCounters().messagesReceived);
+                return std::move(*transition);
             }
-            return StateTransition::noTransition();
+            return rejectMalformedPacket(context);
+
+        case packets::PacketType::PubAck:
+            if (const auto packetId = peekPubAckPacketId(context, frame))
+            {
+                return handlePubAck(context, *packetId);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        const auto packet = context.parsePacket(frame);
+        if (packet == nullptr || !packet->isValid())
+        {
+            return rejectMalformedPacket(context);
         }
 
         const auto packetType = packet->getPacketType();
@@ -118,7 +276,7 @@ namespace reactormq::mqtt::client
         {
             using enum packets::PacketType;
         case PubAck:
-            return handlePubAck(context, *controlPacket);
+            return handlePubAck(context, controlPacket->getPacketId());
 
         case SubAck:
             return handleSubAck(context, *controlPacket, protocolVersion);
@@ -126,14 +284,11 @@ namespace reactormq::mqtt::client
         case UnsubAck:
             return handleUnsubAck(context, *controlPacket, protocolVersion);
 
-        case Publish:
-            return incoming::publish::broadcast(context, *controlPacket);
-
         case PubRec:
-            return handlePubRec(context, *controlPacket, protocolVersion);
+            return handlePubRec(context, *controlPacket);
 
         case PubRel:
-            return handlePubRel(context, *controlPacket, protocolVersion);
+            return handlePubRel(context, *controlPacket);
 
         case PubComp:
             return handlePubComp(context, *controlPacket);
@@ -141,14 +296,17 @@ namespace reactormq::mqtt::client
         case PingResp:
             return handlePingResp(context);
 
+        case Auth:
+            return handleAuth(context, *controlPacket);
+
         default:
             REACTORMQ_LOG(logging::LogLevel::Warn, "Unexpected packet type %d in Ready state", packetType);
 
             {
-                const auto settings = context.getSettings();
+                const auto& settings = context.getSettings();
                 if (settings && settings->isStrictMode())
                 {
-                    return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+                    return StateTransition::toDisconnected(false);
                 }
             }
             return StateTransition::noTransition();
@@ -157,122 +315,420 @@ namespace reactormq::mqtt::client
 
     StateTransition ReadyState::onTick(Context& context)
     {
-        const auto settings = context.getSettings();
-        if (!settings)
+        // The standby only ever replaces a connection auto-reconnect would have replaced anyway.
+        if (const auto& settings = context.getSettings();
+            settings && settings->isWarmStandbyEnabled() && settings->isAutoReconnectEnabled())
+        {
+            context.getStandby().maintain(context.getEndpoints(), context.getNow());
+        }
+
+        sendReauthenticationIfArrived(context);
+        return m_drainPromise.has_value() ? finishDrainIfDone(context) : StateTransition::noTransition();
+    }
+
+    StateTransition ReadyState::onTimer(Context& context, const TimerKey& timer)
+    {
+        if (timer.kind == TimerKind::Keepalive)
+        {
+            return handleKeepaliveTimer(context);
+        }
+
+        if (timer.kind == TimerKind::PublishTimeout)
+        {
+            handlePublishTimeout(context, static_cast<std::uint16_t>(timer.id));
+        }
+
+        if (timer.kind == TimerKind::RateLimit)
+        {
+            releaseRateLimitedPublishes(context);
+        }
+
+        if (timer.kind == TimerKind::Reauthenticate)
+        {
+            handleReauthenticateTimer(context);
+        }
+
+        if (timer.kind == TimerKind::DrainTimeout && m_drainPromise.has_value())
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Warn,
+                "Draining disconnect timed out with %zu publishes unacknowledged",
+                context.getPendingPublishCount() + context.getHeldPublishCount());
+            Completion<void> promise = std::move(*m_drainPromise);
+            m_drainPromise.reset();
+            return StateTransition::toClosing(std::move(promise));
+        }
+
+        return StateTransition::noTransition();
+    }
+
+    StateTransition ReadyState::startDrain(Context& context, Completion<void> promise, const DrainOptions& drain)
+    {
+        m_drainPromise.emplace(std::move(promise));
+        m_shouldDrainAcknowledgements = drain.shouldWaitForAcknowledgements;
+        context.getTimers().schedule(
+            TimerKey{ TimerKind::DrainTimeout }, context.getNow() + std::chrono::milliseconds(drain.timeoutMs));
+        return finishDrainIfDone(context);
+    }
+
+    StateTransition ReadyState::finishDrainIfDone(Context& context)
+    {
+        if (m_shouldDrainAcknowledgements)
+        {
+            // Held publishes still count: they go out as acknowledgements free the quota or the rate limits refill.
+            const PublishRateLimiter* const limiter = context.getPublishRateLimiter();
+            if (context.getPendingPublishCount() != 0 || context.getHeldPublishCount() != 0
+                || (limiter != nullptr && limiter->getHeldCount() != 0))
+            {
+                return StateTransition::noTransition();
+            }
+        }
+
+        context.flushOutboundBatch();
+        if (const auto sock = context.getSocket(); sock && sock->getPendingSendBytes() != 0)
         {
             return StateTransition::noTransition();
         }
 
-        const std::uint16_t keepaliveSeconds = settings->getKeepAliveIntervalSeconds();
+        Completion<void> promise = std::move(*m_drainPromise);
+        m_drainPromise.reset();
+        return StateTransition::toClosing(std::move(promise));
+    }
+
+    StateTransition ReadyState::handleKeepaliveTimer(Context& context)
+    {
+        const auto& settings = context.getSettings();
+        const std::uint16_t keepaliveSeconds = settings ? settings->getKeepAliveIntervalSeconds() : 0;
         if (keepaliveSeconds == 0)
         {
             return StateTransition::noTransition();
         }
 
-        const auto timeSinceActivity = context.getTimeSinceLastActivity();
         const auto keepaliveMs = std::chrono::milliseconds(keepaliveSeconds * 1000);
+        const auto pingTimeout = context.getPingTimeout(keepaliveMs);
+        const auto now = context.getNow();
+        auto& timers = context.getTimers();
+
+        // Anything from the broker after the PINGREQ shows the link is alive, even if the PINGRESP is queued behind it.
+        if (context.isPingPending() && context.getLastReceiveTime() > context.getPingSentTime())
+        {
+            context.setPingPending(false);
+        }
 
         if (context.isPingPending())
         {
-            const auto pingTimeout = keepaliveMs + keepaliveMs / 2;
-            if (timeSinceActivity >= pingTimeout)
+            if (const auto due = context.getPingSentTime() + pingTimeout; now < due)
             {
-                return StateTransition::transitionTo(std::make_unique<DisconnectedState>(false));
+                timers.schedule(TimerKey{ TimerKind::Keepalive }, due);
+                return StateTransition::noTransition();
             }
+            return StateTransition::toDisconnected(false);
         }
-        else if (timeSinceActivity >= keepaliveMs)
+
+        // Only the outbound side counts: the broker expects a packet from the client within each interval, and a
+        // busy link that keeps sending never needs a PINGREQ.
+        if (const auto due = context.getLastSendTime() + keepaliveMs; now < due)
         {
-            if (const auto sock = context.getSocket())
-            {
-                std::vector<std::byte> buffer;
-                serialize::ByteWriter writer(buffer);
-                const packets::PingReq pingReq;
-                pingReq.encode(writer);
+            timers.schedule(TimerKey{ TimerKind::Keepalive }, due);
+            return StateTransition::noTransition();
+        }
 
-                sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+        if (const auto sock = context.getSocket())
+        {
+            sock->sendControl(packets::kHeaderOnlyPacket<packets::PacketType::PingReq>);
+            context.recordPingSent(now);
+        }
 
-                context.setPingPending(true);
-                context.recordActivity();
+        // Fire again after one keepalive: any packet sent in the meantime pushes the next ping back from there.
+        timers.schedule(TimerKey{ TimerKind::Keepalive }, now + keepaliveMs);
+        return StateTransition::noTransition();
+    }
+
+    void ReadyState::handlePublishTimeout(Context& context, const std::uint16_t packetId)
+    {
+        if (context.retryPendingPublish(packetId))
+        {
+            return;
+        }
+
+        auto cmd = context.takePendingPublish(packetId);
+        if (cmd.has_value())
+        {
+            context.releasePacketId(packetId);
+            context.clearPublishTimeout(packetId);
+            cmd->promise.set_value(Result<void>::failure(ResultError::TimedOut));
+            sendHeldPublishes(context);
+        }
+    }
+
+    StateTransition ReadyState::handlePublishCommand(Context& context, socket::Socket& /*sock*/, PublishCommand& publishCmd)
+    {
+        if (PublishRateLimiter* const limiter = context.getPublishRateLimiter())
+        {
+            switch (limiter->admit(publishCmd, context.getNow()))
+            {
+            case PublishRateLimiter::Verdict::Send:
+                break;
+            case PublishRateLimiter::Verdict::Held:
+                scheduleRateLimitRelease(context);
+                return StateTransition::noTransition();
+            case PublishRateLimiter::Verdict::Replaced:
+            case PublishRateLimiter::Verdict::Rejected:
+                ClientMetricCounters::increment(context.getMetricCounters().messagesRateLimited);
+                return StateTransition::noTransition();
             }
         }
 
-        constexpr std::chrono::milliseconds kPublishTimeout{ 30000 };
-        std::vector<std::uint16_t> timedOutPacketIds;
+        return queuePublish(context, publishCmd);
+    }
 
-        for (const auto& packetId : context.getPendingPublishes() | std::views::keys)
+    StateTransition ReadyState::queuePublish(Context& context, PublishCommand& publishCmd)
+    {
+        if (publishCmd.message.getQualityOfService() != QualityOfService::AtMostOnce)
         {
-            if (context.getPublishElapsedTime(packetId) >= kPublishTimeout)
+            if (!context.canAddPendingCommand())
             {
-                timedOutPacketIds.push_back(packetId);
+                publishCmd.promise.set_value(Result<void>::failure(ResultError::PendingCommandsLimit));
+                return StateTransition::noTransition();
             }
+
+            // Over the broker's Receive Maximum, or behind publishes that are: wait for an acknowledgement.
+            if (context.getSendQuota() == 0 || context.getHeldPublishCount() > 0)
+            {
+                context.holdPublish(std::move(publishCmd));
+                return StateTransition::noTransition();
+            }
+        }
+
+        return sendPublish(context, publishCmd);
+    }
+
+    void ReadyState::resubscribe(Context& context, socket::Socket& sock)
+    {
+        const auto& settings = context.getSettings();
+        const SubscriptionCache& subscriptions = context.getSubscriptionCache();
+        if (context.isSessionPresent() || subscriptions.isEmpty() || !settings || !settings->shouldResubscribeOnReconnect())
+        {
+            return;
+        }
+
+        REACTORMQ_LOG(logging::LogLevel::Info, "ReadyState::resubscribe() %zu subscription(s)", subscriptions.getFilters().size());
+
+        // Nobody waits on the result; a refused filter drops out of the cache when its SUBACK comes in.
+        const std::span<const TopicFilter> filters = subscriptions.getFilters();
+        SubscribesCommand resubscribeCmd{ std::vector<TopicFilter>(filters.begin(), filters.end()), {} };
+        (void)handleSubscribesCommand(context, sock, resubscribeCmd);
+    }
+
+    void ReadyState::sendHeldPublishes(Context& context)
+    {
+        const auto sock = context.getSocket();
+        if (!sock)
+        {
+            return;
         }
 
-        for (const auto packetId : timedOutPacketIds)
+        while (context.getSendQuota() > 0)
         {
-            auto cmd = context.takePendingPublish(packetId);
-            if (cmd.has_value())
+            auto held = context.takeHeldPublish();
+            if (!held.has_value())
             {
-                context.releasePacketId(packetId);
-                context.clearPublishTimeout(packetId);
-                cmd->promise.set_value(Result<void>::failure("Publish timeout"));
+                return;
             }
+            (void)sendPublish(context, held.value());
         }
+    }
 
-        return StateTransition::noTransition();
+    void ReadyState::releaseRateLimitedPublishes(Context& context)
+    {
+        PublishRateLimiter* const limiter = context.getPublishRateLimiter();
+        if (nullptr == limiter)
+        {
+            return;
+        }
+
+        while (auto publish = limiter->takeReleasable(context.getNow()))
+        {
+            (void)queuePublish(context, publish.value());
+        }
+        scheduleRateLimitRelease(context);
+    }
+
+    void ReadyState::scheduleRateLimitRelease(Context& context)
+    {
+        const PublishRateLimiter* const limiter = context.getPublishRateLimiter();
+        const auto due = nullptr != limiter ? limiter->getNextRelease(context.getNow()) : std::nullopt;
+        if (!due)
+        {
+            return;
+        }
+
+        // Publishes held back to back share one deadline, so the timer is only moved when it would fire too late.
+        auto& timers = context.getTimers();
+        if (const auto scheduled = timers.getFireTime(TimerKey{ TimerKind::RateLimit }); !scheduled || *scheduled > *due)
+        {
+            timers.schedule(TimerKey{ TimerKind::RateLimit }, *due);
+        }
     }
 
-    StateTransition ReadyState::handlePublishCommand(Context& context, socket::Socket& sock, PublishCommand& publishCmd)
+    StateTransition ReadyState::sendPublish(Context& context, PublishCommand& publishCmd)
     {
+        // A message that outlived its expiry while held or queued offline is dropped before anything is encoded.
+        if (publishCmd.hasExpired(context.getNow()))
+        {
+            ClientMetricCounters::increment(context.getMetricCounters().messagesExpired);
+            publishCmd.promise.set_value(Result<void>::expired());
+            return StateTransition::noTransition();
+        }
+
         const auto& message = publishCmd.message;
         const auto qos = message.getQualityOfService();
+        // A publish encoded on its publishing thread had its topic checked there.
+        packets::PreEncodedPublish& preEncoded = publishCmd.preEncoded;
+        if (preEncoded.isEmpty() && shouldValidateTopics(context) && !serialize::isValidTopicName(message.getTopic()))
+        {
+            publishCmd.promise.set_value(Result<void>::failure(ResultError::InvalidTopicName));
+            return StateTransition::noTransition();
+        }
 
-        std::uint16_t packetId = 0;
-        if (qos == QualityOfService::AtLeastOnce || qos == QualityOfService::ExactlyOnce)
+        // The broker already has this payload on this topic, so the publish completes without sending it again.
+        PublishDeduplicator* const deduplicator = publishCmd.stream ? nullptr : context.getPublishDeduplicator();
+        std::optional<std::uint64_t> payloadHash;
+        if (nullptr != deduplicator)
         {
-            if (!context.canAddPendingCommand())
+            payloadHash = deduplicator->check(message, context.getNow());
+            if (!payloadHash.has_value())
             {
-                publishCmd.promise.set_value(Result<void>::failure("Max pending commands limit exceeded"));
+                ClientMetricCounters::increment(context.getMetricCounters().messagesDeduplicated);
+                publishCmd.promise.set_value(Result<void>::success());
                 return StateTransition::noTransition();
             }
+        }
 
+        std::uint16_t packetId = 0;
+        if (qos == QualityOfService::AtLeastOnce || qos == QualityOfService::ExactlyOnce)
+        {
             packetId = context.allocatePacketId();
             if (packetId == 0)
             {
-                publishCmd.promise.set_value(Result<void>::failure("Packet ID pool exhausted"));
+                publishCmd.promise.set_value(Result<void>::failure(ResultError::PacketIdsExhausted));
                 return StateTransition::noTransition();
             }
         }
 
-        std::vector<std::byte> buffer;
-        serialize::ByteWriter writer(buffer);
+        // Once the broker knows a topic's alias, the topic itself is left out of the packet.
+        static const std::string kAliasedTopic;
+        const TopicAliasChoice topicAlias = context.getTopicAliases().choose(message.getTopic());
+        const std::string& topic = topicAlias.alias != 0 && !topicAlias.isNew ? kAliasedTopic : message.getTopic();
 
-        withMqttVersion(
-            context.getProtocolVersion(),
-            [&writer, &message, packetId]<typename VersionTag>(VersionTag)
+        // A payload codec only pays off when it shrinks the payload; otherwise the message goes out as it is.
+        SharedPayload encodedPayload;
+        const IPayloadCodec* payloadCodec = nullptr;
+        if (context.getProtocolVersion() == packets::ProtocolVersion::V5 && !context.getPayloadCodecs().isEmpty() && !publishCmd.stream)
+        {
+            if (const IPayloadCodec* codec = context.getPayloadCodecs().findForTopic(message.getTopic()))
             {
-                constexpr auto kV = VersionTag::value;
-                packets::encodePublishToWriter<kV>(
-                    writer,
-                    message.getTopic(),
-                    message.getPayload(),
-                    message.getQualityOfService(),
-                    message.shouldRetain(),
-                    packetId,
-                    false);
-            });
+                if (std::vector<std::uint8_t> encoded; codec->encode(message.getPayloadView(), encoded)
+                                                       && encoded.size() < message.getPayloadView().size())
+                {
+                    encodedPayload = SharedPayload{ std::move(encoded) };
+                    payloadCodec = codec;
+                }
+            }
+        }
+        const std::string_view payloadCodecName = nullptr != payloadCodec ? payloadCodec->getName() : std::string_view{};
+
+        // The topic and properties come pre-encoded from the topic's template; only the per-message fields are written,
+        // into the tick's outbound batch, and large payloads are sent straight from the message's shared buffer.
+        const SharedPayload& payload = nullptr != payloadCodec ? encodedPayload : message.getSharedPayload();
+        // The expiry left is part of the template key; a message sent as soon as it is published sends its full interval.
+        const std::uint32_t messageExpiryInterval
+            = context.getProtocolVersion() == packets::ProtocolVersion::V5 ? publishCmd.getRemainingExpiryInterval(context.getNow()) : 0;
+
+        // The packet encoded on the publishing thread is sent as it is when the connection would write the same bytes;
+        // it has no Topic Alias and no payload codec, and its expiry interval is the one the message was published with.
+        if (!preEncoded.isEmpty() && (topicAlias.alias != 0 || nullptr != payloadCodec
+                                      || !preEncoded.matches(context.getProtocolVersion(), messageExpiryInterval)))
+        {
+            preEncoded.reset();
+        }
 
-        const size_t packetSize = buffer.size();
+        const packets::PublishTemplate* publishTemplate = nullptr;
+        if (preEncoded.isEmpty())
+        {
+            publishTemplate = &context.getPublishTemplates().get(
+                context.getProtocolVersion(),
+                message.getTopic(),
+                topic,
+                qos,
+                message.shouldRetain(),
+                topicAlias.alias,
+                payloadCodecName,
+                messageExpiryInterval);
+        }
+
+        // A streamed payload is read as the socket drains, so only its header counts against the outbound queue.
+        const size_t payloadSize = publishCmd.stream ? publishCmd.stream->getSize() : payload.getSize();
+        if (nullptr != publishTemplate && payloadSize > kMaxRemainingLength - publishTemplate->getRemainingLength(0))
+        {
+            if (qos != QualityOfService::AtMostOnce)
+            {
+                context.releasePacketId(packetId);
+            }
+            publishCmd.promise.set_value(Result<void>::failure(ResultError::PacketTooLarge));
+            return StateTransition::noTransition();
+        }
+
+        size_t packetSize = preEncoded.getSize();
+        if (nullptr != publishTemplate)
+        {
+            const size_t headerSize = publishTemplate->getHeaderSize(static_cast<std::uint32_t>(payloadSize));
+            packetSize = publishCmd.stream ? headerSize : headerSize + payloadSize;
+        }
         if (!context.canAddToOutboundQueue(packetSize))
         {
             if (qos != QualityOfService::AtMostOnce)
             {
                 context.releasePacketId(packetId);
             }
-            publishCmd.promise.set_value(Result<void>::failure("Outbound queue full"));
+            publishCmd.promise.set_value(Result<void>::failure(ResultError::OutboundQueueFull));
             return StateTransition::noTransition();
         }
 
-        sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+        if (nullptr == publishTemplate)
+        {
+            context.sendPreEncodedPublish(preEncoded.patchPacketId(packetId));
+            preEncoded.reset();
+        }
+        else if (!publishCmd.stream)
+        {
+            context.sendPublish(*publishTemplate, packetId, payload);
+        }
+        else if (!context.sendPublishStream(*publishTemplate, packetId, publishCmd.stream))
+        {
+            if (qos != QualityOfService::AtMostOnce)
+            {
+                context.releasePacketId(packetId);
+            }
+            publishCmd.promise.set_value(Result<void>::failure(ResultError::PayloadSourceFailed, "Payload source fell short"));
+            return StateTransition::noTransition();
+        }
+        ClientMetricCounters& metrics = context.getMetricCounters();
+        ClientMetricCounters::increment(metrics.messagesPublished);
+        if (payloadHash.has_value())
+        {
+            deduplicator->record(message, *payloadHash, context.getNow());
+        }
+        if (publishCmd.sentAt == std::chrono::steady_clock::time_point{})
+        {
+            publishCmd.sentAt = context.getNow();
+            metrics.recordPublishSent(static_cast<size_t>(qos), publishCmd.enqueuedAt, publishCmd.sentAt);
+        }
+
+        if (topicAlias.isNew)
+        {
+            context.getTopicAliases().commit(message.getTopic(), topicAlias.alias);
+        }
 
         context.addOutboundQueueSize(packetSize);
 
@@ -283,7 +739,8 @@ namespace reactormq::mqtt::client
         }
         else
         {
-            context.storePendingPublish(packetId, std::move(publishCmd));
+            // The header went into the batch, so a retransmit encodes its own.
+            context.storePendingPublish(packetId, std::move(publishCmd), {}, std::move(encodedPayload), payloadCodec);
 
             context.recordPublishSent(packetId);
 
@@ -297,29 +754,75 @@ namespace reactormq::mqtt::client
     {
         if (!context.canAddPendingCommand())
         {
-            subscribeCmd.promise.set_value(Result<SubscribeResult>::failure("Max pending commands limit exceeded"));
+            subscribeCmd.promise.set_value(Result<SubscribeResult>::failure(ResultError::PendingCommandsLimit));
+            return StateTransition::noTransition();
+        }
+
+        if (shouldValidateTopics(context) && !serialize::isValidTopicFilter(subscribeCmd.topicFilter.getFilter()))
+        {
+            subscribeCmd.promise.set_value(Result<SubscribeResult>::failure(ResultError::InvalidTopicFilter));
             return StateTransition::noTransition();
         }
 
         const std::uint16_t packetId = context.allocatePacketId();
         if (packetId == 0)
         {
-            subscribeCmd.promise.set_value(Result<SubscribeResult>::failure("Packet ID pool exhausted"));
+            subscribeCmd.promise.set_value(Result<SubscribeResult>::failure(ResultError::PacketIdsExhausted));
             return StateTransition::noTransition();
         }
 
+        // A handler gets a Subscription Identifier where the broker allows one, so its messages skip topic matching.
+        std::uint32_t subscriptionIdentifier = 0;
+        if (subscribeCmd.handler)
+        {
+            auto handler = std::make_shared<const MessageHandler>(std::move(subscribeCmd.handler));
+            if (subscribeCmd.isConflated)
+            {
+                context.getConflatedHandlers().add(subscribeCmd.topicFilter.getFilter(), handler);
+            }
+            if (TrafficAccounting* accounting = context.getTrafficAccounting())
+            {
+                accounting->addSubscription(subscribeCmd.topicFilter.getFilter(), handler.get());
+            }
+            subscriptionIdentifier = context.getTopicRouter().add(
+                subscribeCmd.topicFilter.getFilter(), std::move(handler), context.areSubscriptionIdentifiersAvailable());
+        }
+        if (subscribeCmd.sink && subscribeCmd.isChunked)
+        {
+            context.getChunkAssemblers().add(subscribeCmd.topicFilter.getFilter(), std::move(subscribeCmd.sink));
+        }
+        else if (subscribeCmd.sink)
+        {
+            context.getPayloadSinks().add(subscribeCmd.topicFilter.getFilter(), std::move(subscribeCmd.sink));
+        }
+        context.setDeliveryPriority(subscribeCmd.topicFilter.getFilter(), subscribeCmd.topicFilter.getDeliveryPriority());
+
         std::vector<std::byte> buffer;
         serialize::ByteWriter writer(buffer);
 
-        const std::vector filters = { subscribeCmd.topicFilter };
+        const std::span<const TopicFilter> filters{ &subscribeCmd.topicFilter, 1 };
         withMqttVersion(
             context.getProtocolVersion(),
-            [&writer, &filters, &packetId]<typename VersionTag>(VersionTag)
+            [&writer, filters, &packetId, subscriptionIdentifier]<typename VersionTag>(VersionTag)
             {
                 constexpr auto kV = VersionTag::value;
-                packets::encodeSubscribeToWriter<kV>(writer, filters, packetId);
+                if constexpr (packets::detail::SubscribeTraits<kV>::HasProperties)
+                {
+                    using namespace packets::properties;
+                    Properties properties;
+                    if (subscriptionIdentifier != 0)
+                    {
+                        properties = Properties{ { Property::create<PropertyIdentifier::SubscriptionIdentifier>(subscriptionIdentifier) } };
+                    }
+                    packets::encodeSubscribeToWriter<kV>(writer, filters, packetId, std::move(properties));
+                }
+                else
+                {
+                    packets::encodeSubscribeToWriter<kV>(writer, filters, packetId);
+                }
             });
 
+        context.flushOutboundBatch();
         sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
 
         context.storePendingSubscribe(packetId, std::move(subscribeCmd));
@@ -331,32 +834,195 @@ namespace reactormq::mqtt::client
     {
         if (!context.canAddPendingCommand())
         {
-            subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure("Max pending commands limit exceeded"));
+            subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::PendingCommandsLimit));
             return StateTransition::noTransition();
         }
 
-        const std::uint16_t packetId = context.allocatePacketId();
-        if (packetId == 0)
+        if (shouldValidateTopics(context) && !std::ranges::all_of(subscribesCmd.topicFilters, serialize::isValidTopicFilter, &TopicFilter::getFilter))
         {
-            subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure("Packet ID pool exhausted"));
+            subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::InvalidTopicFilter));
             return StateTransition::noTransition();
         }
 
+        // Cut the filters into as few SUBSCRIBE packets as the broker's maximum packet size allows.
+        const std::vector<size_t> packetEnds = splitSubscribe(context, subscribesCmd.topicFilters);
+        if (packetEnds.empty())
+        {
+            subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::PacketTooLarge));
+            return StateTransition::noTransition();
+        }
+
+        std::vector<std::uint16_t> packetIds;
+        packetIds.reserve(packetEnds.size());
+        for (size_t i = 0; i < packetEnds.size(); ++i)
+        {
+            const std::uint16_t packetId = context.allocatePacketId();
+            if (packetId == 0)
+            {
+                for (const std::uint16_t allocated : packetIds)
+                {
+                    context.releasePacketId(allocated);
+                }
+                subscribesCmd.promise.set_value(Result<std::vector<SubscribeResult>>::failure(ResultError::PacketIdsExhausted));
+                return StateTransition::noTransition();
+            }
+            packetIds.push_back(packetId);
+        }
+
+        for (const TopicFilter& topicFilter : subscribesCmd.topicFilters)
+        {
+            context.setDeliveryPriority(topicFilter.getFilter(), topicFilter.getDeliveryPriority());
+        }
+
+        // Every packet goes out in one write.
         std::vector<std::byte> buffer;
         serialize::ByteWriter writer(buffer);
+        const std::span<const TopicFilter> filters = subscribesCmd.topicFilters;
+        size_t begin = 0;
+        for (size_t i = 0; i < packetEnds.size(); ++i)
+        {
+            const std::span<const TopicFilter> packetFilters = filters.subspan(begin, packetEnds[i] - begin);
+            withMqttVersion(
+                context.getProtocolVersion(),
+                [&writer, packetFilters, packetId = packetIds[i]]<typename VersionTag>(VersionTag)
+                {
+                    constexpr auto kV = VersionTag::value;
+                    packets::encodeSubscribeToWriter<kV>(writer, packetFilters, packetId);
+                });
+            begin = packetEnds[i];
+        }
 
-        withMqttVersion(
-            context.getProtocolVersion(),
-            [&writer, &filters = subscribesCmd.topicFilters, &packetId]<typename VersionTag>(VersionTag)
+        context.flushOutboundBatch();
+        sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+
+        if (packetIds.size() == 1)
+        {
+            context.storePendingSubscribes(packetIds.front(), std::move(subscribesCmd));
+            return StateTransition::noTransition();
+        }
+
+        const auto batch = std::make_shared<SubscribeBatch>();
+        batch->granted.resize(subscribesCmd.topicFilters.size());
+        batch->topicFilters = std::move(subscribesCmd.topicFilters);
+        batch->promise = std::move(subscribesCmd.promise);
+        batch->remaining = packetIds.size();
+        begin = 0;
+        for (size_t i = 0; i < packetIds.size(); ++i)
+        {
+            const SubscribeBatchSlice slice{ batch, begin, packetEnds[i] - begin };
+            context.storePendingSubscribes(packetIds[i], SubscribesCommand{ {}, {}, slice });
+            begin = packetEnds[i];
+        }
+
+        return StateTransition::noTransition();
+    }
+
+    std::vector<size_t> ReadyState::splitSubscribe(const Context& context, const std::span<const TopicFilter> topicFilters)
+    {
+        const std::uint32_t maxPacketSize = context.getBrokerMaximumPacketSize();
+
+        // Packet ID, plus an empty property block for MQTT 5.
+        const std::uint32_t baseLength = context.getProtocolVersion() == packets::ProtocolVersion::V5 ? 3 : 2;
+        const auto fits = [maxPacketSize](const std::uint32_t remainingLength)
+        {
+            return remainingLength <= kMaxRemainingLength
+                && 1U + serialize::variableByteIntegerSize(remainingLength) + remainingLength <= maxPacketSize;
+        };
+
+        std::vector<size_t> packetEnds;
+        std::uint32_t remainingLength = baseLength;
+        for (size_t i = 0; i < topicFilters.size(); ++i)
+        {
+            const std::uint32_t entryLength = packets::Subscribe<packets::ProtocolVersion::V311>::getEntryLength(topicFilters[i]);
+            if (!fits(baseLength + entryLength))
             {
-                constexpr auto kV = VersionTag::value;
-                packets::encodeSubscribeToWriter<kV>(writer, filters, packetId);
-            });
+                return {};
+            }
+            if (remainingLength > baseLength && !fits(remainingLength + entryLength))
+            {
+                packetEnds.push_back(i);
+                remainingLength = baseLength;
+            }
+            remainingLength += entryLength;
+        }
+        packetEnds.push_back(topicFilters.size());
+        return packetEnds;
+    }
 
-        sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+    StateTransition ReadyState::handleRequestCommand(Context& context, socket::Socket& sock, RequestCommand& requestCmd)
+    {
+        if (context.getProtocolVersion() != packets::ProtocolVersion::V5)
+        {
+            requestCmd.promise.set_value(Result<Message>::failure(ResultError::UnsupportedByProtocol));
+            return StateTransition::noTransition();
+        }
+
+        if (shouldValidateTopics(context) && !serialize::isValidTopicName(requestCmd.topic))
+        {
+            requestCmd.promise.set_value(Result<Message>::failure(ResultError::InvalidTopicName));
+            return StateTransition::noTransition();
+        }
+
+        if (context.getRequests().size() >= RequestTable::kMaxRequests)
+        {
+            requestCmd.promise.set_value(Result<Message>::failure(ResultError::PendingRequestsLimit));
+            return StateTransition::noTransition();
+        }
+
+        // One subscription serves every request; it goes out ahead of the first, so the broker has it before a
+        // responder can answer. A refused SUBSCRIBE lets the next request try again.
+        const std::string& responseTopic = context.getResponseTopic();
+        if (!context.isResponseTopicSubscribed())
+        {
+            context.setResponseTopicSubscribed(true);
+            SubscribeCommand subscribe{ TopicFilter{ responseTopic, QualityOfService::AtMostOnce },
+                                        Completion<SubscribeResult>(CompletionHandler<SubscribeResult>(
+                                            [&context](const Result<SubscribeResult>& result)
+                                            {
+                                                if (!result.isSuccess() || !result.getResult()->wasSuccessful())
+                                                {
+                                                    context.setResponseTopicSubscribed(false);
+                                                }
+                                            })) };
+            (void)handleSubscribeCommand(context, sock, subscribe);
+        }
 
-        context.storePendingSubscribes(packetId, std::move(subscribesCmd));
+        const std::uint32_t correlationId = context.getRequests().add(std::move(requestCmd.promise));
+
+        packets::properties::PropertyList properties;
+        properties.add(packets::properties::Property::create<packets::properties::PropertyIdentifier::ResponseTopic>(responseTopic));
+        properties.add(packets::properties::Property::create<packets::properties::PropertyIdentifier::CorrelationData>(
+            RequestTable::toCorrelationData(correlationId)));
+        const packets::Publish5 header(
+            requestCmd.topic, {}, QualityOfService::AtMostOnce, false, 0, packets::properties::Properties{ std::move(properties) }, false);
+
+        const size_t payloadSize = requestCmd.payload.size();
+        ResultError failure = ResultError::None;
+        if (payloadSize > kMaxRemainingLength - header.getLength())
+        {
+            failure = ResultError::PacketTooLarge;
+        }
+        else if (!context.canAddToOutboundQueue(header.getLength() + payloadSize))
+        {
+            failure = ResultError::OutboundQueueFull;
+        }
+        if (ResultError::None != failure)
+        {
+            context.getRequests().take(correlationId)->set_value(Result<Message>::failure(failure));
+            return StateTransition::noTransition();
+        }
 
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        header.encodeHeader(writer, static_cast<std::uint32_t>(payloadSize));
+        writer.writeBytes(reinterpret_cast<const std::byte*>(requestCmd.payload.data()), payloadSize);
+
+        context.flushOutboundBatch();
+        sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+        ClientMetricCounters::increment(context.getMetricCounters().messagesPublished);
+
+        const auto deadline = context.getNow() + requestCmd.timeout;
+        context.getTimers().schedule(TimerKey{ TimerKind::RequestTimeout, correlationId }, deadline);
         return StateTransition::noTransition();
     }
 
@@ -364,14 +1030,20 @@ namespace reactormq::mqtt::client
     {
         if (!context.canAddPendingCommand())
         {
-            unsubscribesCmd.promise.set_value(Result<std::vector<UnsubscribeResult>>::failure("Max pending commands limit exceeded"));
+            unsubscribesCmd.promise.set_value(Result<std::vector<UnsubscribeResult>>::failure(ResultError::PendingCommandsLimit));
+            return StateTransition::noTransition();
+        }
+
+        if (shouldValidateTopics(context) && !std::ranges::all_of(unsubscribesCmd.topics, serialize::isValidTopicFilter))
+        {
+            unsubscribesCmd.promise.set_value(Result<std::vector<UnsubscribeResult>>::failure(ResultError::InvalidTopicFilter));
             return StateTransition::noTransition();
         }
 
         const std::uint16_t packetId = context.allocatePacketId();
         if (packetId == 0)
         {
-            unsubscribesCmd.promise.set_value(Result<std::vector<UnsubscribeResult>>::failure("Packet ID pool exhausted"));
+            unsubscribesCmd.promise.set_value(Result<std::vector<UnsubscribeResult>>::failure(ResultError::PacketIdsExhausted));
             return StateTransition::noTransition();
         }
 
@@ -386,22 +1058,61 @@ namespace reactormq::mqtt::client
                 packets::encodeUnsubscribeToWriter<kV>(writer, topics, packetId);
             });
 
+        context.flushOutboundBatch();
         sock.send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
 
+        for (const std::string& topic : unsubscribesCmd.topics)
+        {
+            context.getTopicRouter().remove(topic);
+            context.getPayloadSinks().remove(topic);
+            context.getChunkAssemblers().remove(topic);
+            context.getConflatedHandlers().remove(topic);
+            if (TrafficAccounting* accounting = context.getTrafficAccounting())
+            {
+                accounting->removeSubscription(topic);
+            }
+            context.setDeliveryPriority(topic, 0);
+            context.getSubscriptionCache().forget(topic);
+        }
+
         context.storePendingUnsubscribes(packetId, std::move(unsubscribesCmd));
 
         return StateTransition::noTransition();
     }
 
-    StateTransition ReadyState::handlePubAck(Context& context, const packets::IControlPacket& packet)
+    StateTransition ReadyState::rejectMalformedPacket(Context& context)
+    {
+        ClientMetricCounters::increment(context.getMetricCounters().parseFailures);
+        if (const auto& settings = context.getSettings(); settings && settings->isStrictMode())
+        {
+            return StateTransition::toDisconnected(false);
+        }
+        return StateTransition::noTransition();
+    }
+
+    std::optional<std::uint16_t> ReadyState::peekPubAckPacketId(const Context& context, const socket::InboundFrame& frame)
+    {
+        // Only the packet ID is acted on. A PUBACK with MQTT 5 properties, or a malformed one, takes the generic path.
+        const auto body = frame.getBody();
+        const bool hasReasonCodeOnly = body.size() == 3 && context.getProtocolVersion() == packets::ProtocolVersion::V5;
+        if (frame.typeAndFlags != kPubAckTypeAndFlags || (body.size() != 2 && !hasReasonCodeOnly))
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::uint16_t>(body[0] << 8 | body[1]);
+    }
+
+    StateTransition ReadyState::handlePubAck(Context& context, const std::uint16_t packetId)
     {
-        const std::uint16_t packetId = packet.getPacketId();
         context.clearPublishTimeout(packetId);
+        context.recordPublishResponse(packetId);
 
         if (auto pendingPublish = context.takePendingPublish(packetId); pendingPublish.has_value())
         {
             context.releasePacketId(packetId);
+            recordPublishAcknowledged(context, *pendingPublish);
             pendingPublish->promise.set_value(Result<void>::success());
+            sendHeldPublishes(context);
         }
 
         return StateTransition::noTransition();
@@ -417,7 +1128,8 @@ namespace reactormq::mqtt::client
             pendingSingleSubscribe.has_value() || pendingMultiSubscribe.has_value())
         {
             context.releasePacketId(packetId);
-            acknowledgement::subscription::resolve(packet, pendingSingleSubscribe, pendingMultiSubscribe, protocolVersion);
+            acknowledgement::subscription::resolve(
+                packet, context.getSubscriptionCache(), pendingSingleSubscribe, pendingMultiSubscribe, protocolVersion);
         }
 
         return StateTransition::noTransition();
@@ -437,62 +1149,52 @@ namespace reactormq::mqtt::client
         return StateTransition::noTransition();
     }
 
-    StateTransition ReadyState::handlePubRec(
-        const Context& context, const packets::IControlPacket& packet, const packets::ProtocolVersion protocolVersion)
+    StateTransition ReadyState::handlePubRec(Context& context, const packets::IControlPacket& packet)
     {
-        const std::uint16_t packetId = packet.getPacketId();
-
-        std::vector<std::byte> buffer;
-        serialize::ByteWriter writer(buffer);
-
-        withMqttVersion(
-            protocolVersion,
-            [&writer, &packetId]<typename VersionTag>(VersionTag)
-            {
-                constexpr auto kV = VersionTag::value;
-                packets::encodePubRelToWriter<kV>(writer, packetId);
-            });
-
+        context.recordPublishResponse(packet.getPacketId());
         if (const auto sock = context.getSocket())
         {
-            sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+            const auto pubRel = packets::encodeIdOnlyAck<packets::PacketType::PubRel>(packet.getPacketId());
+            sock->sendControl(pubRel);
         }
+        context.markPublishReleased(packet.getPacketId());
 
         return StateTransition::noTransition();
     }
 
-    StateTransition ReadyState::handlePubRel(
-        Context& context, const packets::IControlPacket& packet, const packets::ProtocolVersion protocolVersion)
+    StateTransition ReadyState::handlePubRel(Context& context, const packets::IControlPacket& packet)
     {
         const std::uint16_t packetId = packet.getPacketId();
 
-        if (auto message = context.takePendingIncomingQos2Message(packetId); message.has_value())
-        {
-            std::vector<std::byte> buffer;
-            serialize::ByteWriter writer(buffer);
+        // A message delivered on PUBLISH only has its packet ID to forget; the PUBCOMP below goes out as for one unknown.
+        context.releaseDeliveredQos2PacketId(packetId);
 
-            withMqttVersion(
-                protocolVersion,
-                [&writer, &packetId]<typename VersionTag>(VersionTag)
-                {
-                    constexpr auto kV = VersionTag::value;
-                    packets::encodePubCompToWriter<kV>(writer, packetId);
-                });
+        auto message = context.takePendingIncomingQos2Message(packetId);
+        if (message.has_value())
+        {
+            context.getOnMessageView().broadcast(MessageView(message.value()));
 
-            if (const auto sock = context.getSocket())
+            if (context.deliverMessage(std::move(message.value()), {}, packetId, packets::PacketType::PubComp))
             {
-                sock->send(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+                return StateTransition::noTransition();
             }
+        }
+        else if (context.hasIncomingPacketId(packetId))
+        {
+            // A resent PUBREL for a message whose PUBCOMP is still deferred; that PUBCOMP answers both.
+            return StateTransition::noTransition();
+        }
 
-            context.invokeCallback(
-                [&ctx = context, msg = std::move(message.value())]() mutable
-                {
-                    ctx.getOnMessage().broadcast(msg);
-                });
-
-            context.releaseIncomingPacketId(packetId);
+        // An unknown packet ID is a PUBREL resent after the PUBCOMP was lost or abandoned with its connection; it is
+        // answered all the same, or the broker would hold the exchange open forever.
+        if (const auto sock = context.getSocket())
+        {
+            const auto pubComp = packets::encodeIdOnlyAck<packets::PacketType::PubComp>(packetId);
+            sock->sendControl(pubComp);
         }
 
+        context.releaseIncomingPacketId(packetId);
+
         return StateTransition::noTransition();
     }
 
@@ -505,17 +1207,95 @@ namespace reactormq::mqtt::client
         if (auto pendingPublish = context.takePendingPublish(packetId); pendingPublish.has_value())
         {
             context.releasePacketId(packetId);
+            recordPublishAcknowledged(context, *pendingPublish);
             pendingPublish->promise.set_value(Result<void>::success());
+            sendHeldPublishes(context);
         }
 
         return StateTransition::noTransition();
     }
 
+    void ReadyState::recordPublishAcknowledged(Context& context, const PublishCommand& publish)
+    {
+        // A publish restored from a session store was sent by an earlier process; its timings are meaningless here.
+        if (publish.sentAt == std::chrono::steady_clock::time_point{})
+        {
+            return;
+        }
+
+        const auto qos = static_cast<size_t>(publish.message.getQualityOfService());
+        context.getMetricCounters().recordPublishAcknowledged(qos, publish.enqueuedAt, publish.sentAt, context.getNow());
+    }
+
     StateTransition ReadyState::handlePingResp(Context& context)
     {
+        context.recordPingResponse();
         context.setPingPending(false);
-        context.recordActivity();
 
         return StateTransition::noTransition();
     }
+
+    StateTransition ReadyState::handleAuth(Context& context, const packets::IControlPacket& packet)
+    {
+        if (!m_isReauthenticating)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "AUTH received in Ready state without a re-authentication in progress");
+            return StateTransition::toDisconnected(false);
+        }
+
+        bool isComplete = false;
+        StateTransition transition
+            = processing::authentication::handleReauthentication(context, packet, m_pendingAuthResponse, isComplete);
+        if (isComplete)
+        {
+            m_isReauthenticating = false;
+            ClientMetricCounters::increment(context.getMetricCounters().reauthentications);
+            return transition;
+        }
+
+        sendReauthenticationIfArrived(context);
+        return transition;
+    }
+
+    void ReadyState::handleReauthenticateTimer(Context& context)
+    {
+        if (!processing::authentication::isReauthenticationEnabled(context))
+        {
+            return;
+        }
+
+        const auto intervalMs = std::chrono::milliseconds(context.getSettings()->getReauthenticateIntervalMs());
+        context.getTimers().schedule(TimerKey{ TimerKind::Reauthenticate }, context.getNow() + intervalMs);
+
+        // Only one exchange at a time: one still waiting on the provider or the broker is left to finish.
+        if (m_isReauthenticating || m_pendingReauthentication)
+        {
+            return;
+        }
+
+        processing::authentication::requestReauthentication(context, m_pendingReauthentication);
+        sendReauthenticationIfArrived(context);
+    }
+
+    void ReadyState::sendReauthenticationIfArrived(const Context& context)
+    {
+        if (m_pendingReauthentication)
+        {
+            if (const auto data = m_pendingReauthentication->take())
+            {
+                m_pendingReauthentication.reset();
+                m_isReauthenticating = true;
+                processing::authentication::sendReauthentication(context, *data);
+            }
+        }
+
+        if (m_pendingAuthResponse)
+        {
+            if (const auto response = m_pendingAuthResponse->take())
+            {
+                m_pendingAuthResponse.reset();
+                processing::authentication::sendResponse(context, *response);
+            }
+        }
+    }
 } // namespace reactormq::mqtt::client
\ No newline at end of file
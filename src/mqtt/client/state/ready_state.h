@@ -4,8 +4,24 @@
 
 #pragma once
 
+#include "mqtt/client/async_result.h"
+#include "mqtt/client/completion.h"
+#include "reactormq/mqtt/drain_options.h"
 #include "state.h"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace reactormq::mqtt
+{
+    class TopicFilter;
+}
+
 namespace reactormq::mqtt::packets
 {
     class IControlPacket;
@@ -40,10 +56,20 @@ namespace reactormq::mqtt::client
 
         StateTransition onSocketDisconnected(Context& context) override;
 
-        StateTransition onDataReceived(Context& context, const uint8_t* data, uint32_t size) override;
+        using IState::onDataReceived;
+
+        StateTransition onDataReceived(Context& context, const socket::InboundFrame& frame) override;
+
+        /**
+         * @brief Handle the packets of one read in a single loop, checking for the end of a drain once at the end
+         * instead of after every packet.
+         */
+        StateTransition onDataReceivedBatch(Context& context, std::span<const socket::InboundFrame> frames, size_t& handled) override;
 
         StateTransition onTick(Context& context) override;
 
+        StateTransition onTimer(Context& context, const TimerKey& timer) override;
+
         [[nodiscard]] const char* getStateName() const override
         {
             return "Ready";
@@ -54,9 +80,52 @@ namespace reactormq::mqtt::client
             return StateId::Ready;
         }
 
+        /**
+         * @brief Handle a subscribe command by encoding and sending a SUBSCRIBE packet.
+         * Also used by ConnectingState to pipeline SUBSCRIBE behind CONNECT.
+         * @param context Shared context.
+         * @param sock Socket for sending data.
+         * @param subscribeCmd The subscribe command containing the topic filter and promise.
+         * @return Optional state transition.
+         */
+        static StateTransition handleSubscribeCommand(Context& context, socket::Socket& sock, SubscribeCommand& subscribeCmd);
+
+        /**
+         * @brief Handle a multi-subscribe command by encoding and sending a SUBSCRIBE packet with multiple filters.
+         * @param context Shared context.
+         * @param sock Socket for sending data.
+         * @param subscribesCmd The subscribes command containing multiple topic filters and promise.
+         * @return Optional state transition.
+         */
+        static StateTransition handleSubscribesCommand(Context& context, socket::Socket& sock, SubscribesCommand& subscribesCmd);
+
     private:
         /**
-         * @brief Handle a publish command by encoding and sending a PUBLISH packet.
+         * @brief Dispatch one received packet to its handler.
+         * @param context Shared context.
+         * @param frame The received frame.
+         * @return Optional state transition.
+         */
+        StateTransition receivePacket(Context& context, const socket::InboundFrame& frame);
+
+        /**
+         * @brief Service the Keepalive timer: send PINGREQ when idle, disconnect if PINGRESP is overdue, otherwise
+         * re-arm. The timer is not moved on every packet; it re-reads the last activity time when it fires.
+         * @param context Shared context.
+         * @return Optional state transition.
+         */
+        static StateTransition handleKeepaliveTimer(Context& context);
+
+        /**
+         * @brief Retry a QoS 1/2 publish whose acknowledgement did not arrive in time, or fail it once its retries
+         * are used up.
+         * @param context Shared context.
+         * @param packetId Packet ID of the publish.
+         */
+        static void handlePublishTimeout(Context& context, std::uint16_t packetId);
+
+        /**
+         * @brief Handle a publish command: hold or reject it if an outbound rate limit is used up, otherwise queue it.
          * @param context Shared context.
          * @param sock Socket for sending data.
          * @param publishCmd The publish command containing the message and promise.
@@ -65,22 +134,64 @@ namespace reactormq::mqtt::client
         static StateTransition handlePublishCommand(Context& context, socket::Socket& sock, PublishCommand& publishCmd);
 
         /**
-         * @brief Handle a subscribe command by encoding and sending a SUBSCRIBE packet.
+         * @brief Send a publish, or hold a QoS 1/2 publish while the broker's Receive Maximum is reached.
          * @param context Shared context.
-         * @param sock Socket for sending data.
-         * @param subscribeCmd The subscribe command containing the topic filter and promise.
+         * @param publishCmd The publish command containing the message and promise.
          * @return Optional state transition.
          */
-        static StateTransition handleSubscribeCommand(Context& context, socket::Socket& sock, SubscribeCommand& subscribeCmd);
+        static StateTransition queuePublish(Context& context, PublishCommand& publishCmd);
 
         /**
-         * @brief Handle a multi-subscribe command by encoding and sending a SUBSCRIBE packet with multiple filters.
+         * @brief Queue the publishes held by the outbound rate limits that their buckets now allow, and set the
+         * RateLimit timer for the next.
+         * @param context Shared context.
+         */
+        static void releaseRateLimitedPublishes(Context& context);
+
+        /**
+         * @brief Set the RateLimit timer for when the first publish held by an outbound rate limit may go out.
+         * @param context Shared context.
+         */
+        static void scheduleRateLimitRelease(Context& context);
+
+        /**
+         * @brief Encode and send a PUBLISH packet, through the context's outbound batch.
+         * @param context Shared context.
+         * @param publishCmd The publish command containing the message and promise.
+         * @return Optional state transition.
+         */
+        static StateTransition sendPublish(Context& context, PublishCommand& publishCmd);
+
+        /**
+         * @brief Send held publishes, oldest first, while the send quota allows.
+         * @param context Shared context.
+         */
+        static void sendHeldPublishes(Context& context);
+
+        /**
+         * @brief Subscribe again to every granted subscription, when the broker kept no session across a reconnect.
          * @param context Shared context.
          * @param sock Socket for sending data.
-         * @param subscribesCmd The subscribes command containing multiple topic filters and promise.
+         */
+        static void resubscribe(Context& context, socket::Socket& sock);
+
+        /**
+         * @brief Cut topic filters into as few SUBSCRIBE packets as the broker's Maximum Packet Size allows.
+         * @param context Shared context.
+         * @param topicFilters The filters, in order.
+         * @return End index of each packet's filters; empty if one filter alone is too large for a packet.
+         */
+        [[nodiscard]] static std::vector<size_t> splitSubscribe(const Context& context, std::span<const TopicFilter> topicFilters);
+
+        /**
+         * @brief Handle a request command: subscribe to the response topic if needed, send the request as a QoS 0 PUBLISH
+         * with a Response Topic and Correlation Data, and start its timeout.
+         * @param context Shared context.
+         * @param sock Socket for sending data.
+         * @param requestCmd The request command.
          * @return Optional state transition.
          */
-        static StateTransition handleSubscribesCommand(Context& context, socket::Socket& sock, SubscribesCommand& subscribesCmd);
+        static StateTransition handleRequestCommand(Context& context, socket::Socket& sock, RequestCommand& requestCmd);
 
         /**
          * @brief Handle an unsubscribe command by encoding and sending an UNSUBSCRIBE packet.
@@ -91,13 +202,28 @@ namespace reactormq::mqtt::client
          */
         static StateTransition handleUnsubscribesCommand(Context& context, socket::Socket& sock, UnsubscribesCommand& unsubscribesCmd);
 
+        /**
+         * @brief Count a packet that failed to decode, and disconnect for it in strict mode.
+         * @param context Shared context.
+         * @return Optional state transition.
+         */
+        static StateTransition rejectMalformedPacket(Context& context);
+
+        /**
+         * @brief Read the packet ID of a PUBACK straight from its frame.
+         * @param context Shared context.
+         * @param frame The received PUBACK.
+         * @return The packet ID; empty for a PUBACK with properties or a malformed one, which need a full decode.
+         */
+        [[nodiscard]] static std::optional<std::uint16_t> peekPubAckPacketId(const Context& context, const socket::InboundFrame& frame);
+
         /**
          * @brief Handle received PUBACK packet.
          * @param context Shared context.
-         * @param packet The received packet.
+         * @param packetId Packet ID the PUBACK acknowledges.
          * @return Optional state transition.
          */
-        static StateTransition handlePubAck(Context& context, const packets::IControlPacket& packet);
+        static StateTransition handlePubAck(Context& context, std::uint16_t packetId);
 
         /**
          * @brief Handle received SUBACK packet.
@@ -123,21 +249,17 @@ namespace reactormq::mqtt::client
          * @brief Handle received PUBREC packet.
          * @param context Shared context.
          * @param packet The received packet.
-         * @param protocolVersion MQTT protocol version.
          * @return Optional state transition.
          */
-        static StateTransition handlePubRec(
-            const Context& context, const packets::IControlPacket& packet, packets::ProtocolVersion protocolVersion);
+        static StateTransition handlePubRec(Context& context, const packets::IControlPacket& packet);
 
         /**
          * @brief Handle received PUBREL packet.
          * @param context Shared context.
          * @param packet The received packet.
-         * @param protocolVersion MQTT protocol version.
          * @return Optional state transition.
          */
-        static StateTransition handlePubRel(
-            Context& context, const packets::IControlPacket& packet, packets::ProtocolVersion protocolVersion);
+        static StateTransition handlePubRel(Context& context, const packets::IControlPacket& packet);
 
         /**
          * @brief Handle received PUBCOMP packet.
@@ -147,11 +269,70 @@ namespace reactormq::mqtt::client
          */
         static StateTransition handlePubComp(Context& context, const packets::IControlPacket& packet);
 
+        /**
+         * @brief Record the latency of a QoS 1/2 publish whose PUBACK or PUBCOMP arrived.
+         * @param context Shared context.
+         * @param publish The acknowledged publish.
+         */
+        static void recordPublishAcknowledged(Context& context, const PublishCommand& publish);
+
         /**
          * @brief Handle received PINGRESP packet.
          * @param context Shared context.
          * @return Optional state transition.
          */
         static StateTransition handlePingResp(Context& context);
+
+        /**
+         * @brief Handle received AUTH packet: a challenge or the result of the re-authentication in progress.
+         * @param context Shared context.
+         * @param packet The received packet.
+         * @return Optional state transition.
+         */
+        StateTransition handleAuth(Context& context, const packets::IControlPacket& packet);
+
+        /**
+         * @brief Service the Reauthenticate timer: ask the credentials provider for fresh data and re-arm the timer.
+         * @param context Shared context.
+         */
+        void handleReauthenticateTimer(Context& context);
+
+        /**
+         * @brief Send the re-authentication AUTH, or the answer to the broker's challenge, once the provider delivers it.
+         * @param context Shared context.
+         */
+        void sendReauthenticationIfArrived(const Context& context);
+
+        /**
+         * @brief Begin a draining disconnect: stop taking new work and set the DrainTimeout timer.
+         * @param context Shared context.
+         * @param promise Promise fulfilled when the disconnect completes.
+         * @param drain What to wait for, and for how long.
+         * @return Transition to Closing if nothing is left to wait for.
+         */
+        StateTransition startDrain(Context& context, Completion<void> promise, const DrainOptions& drain);
+
+        /**
+         * @brief Move to Closing once the socket has written everything and, if asked, every QoS 1/2 publish is
+         * acknowledged.
+         * @param context Shared context.
+         * @return Transition to Closing, or no transition while there is still something to wait for.
+         */
+        StateTransition finishDrainIfDone(Context& context);
+
+        /// @brief Data for the next AUTH with reason code 0x19, while the provider fetches it.
+        std::shared_ptr<AsyncResult<std::vector<std::uint8_t>>> m_pendingReauthentication;
+
+        /// @brief Response to the broker's AUTH challenge during a re-authentication, while the provider computes it.
+        std::shared_ptr<AsyncResult<std::vector<std::uint8_t>>> m_pendingAuthResponse;
+
+        /// @brief Whether a re-authentication has been started and the broker has not yet accepted it.
+        bool m_isReauthenticating = false;
+
+        /// @brief Promise of the draining disconnect in progress; empty unless one is.
+        std::optional<Completion<void>> m_drainPromise;
+
+        /// @brief Whether the draining disconnect waits for PUBACK and PUBCOMP, not only for the socket to flush.
+        bool m_shouldDrainAcknowledgements = false;
     };
 } // namespace reactormq::mqtt::client
\ No newline at end of file
@@ -4,31 +4,23 @@
 
 #pragma once
 
-#include <memory>
-
 #include "mqtt/client/command.h"
 #include "mqtt/client/context.h"
 #include "mqtt/client/state/state_transition.h"
+#include "mqtt/client/timer.h"
+
+#include <cstddef>
+#include <span>
 
 namespace reactormq::mqtt::client
 {
-    class IState;
-
-    using StatePtr = std::unique_ptr<IState>;
-
-    enum class StateId
-    {
-        Disconnected,
-        Connecting,
-        Ready,
-        Closing
-    };
-
     /**
      * @brief Interface for connection lifecycle states.
      *
      * Each state handles commands, socket events, and timers appropriate for that phase.
-     * States are owned by the Reactor and accessed only on the reactor thread.
+     * States are owned by the Reactor and accessed only on the reactor thread. The reactor holds its states by value
+     * in a variant and calls them through their final types, so this interface is the contract they share rather
+     * than how they are dispatched.
      */
     class IState
     {
@@ -71,13 +63,48 @@ namespace reactormq::mqtt::client
         virtual StateTransition onSocketDisconnected(Context& context) = 0;
 
         /**
-         * @brief Called when data is received from the socket.
+         * @brief Called for each complete packet the socket receives.
+         * @param context Shared context.
+         * @param frame The packet, with its fixed header already decoded by the framing.
+         * @return Optional state transition.
+         */
+        virtual StateTransition onDataReceived(Context& context, const socket::InboundFrame& frame) = 0;
+
+        /**
+         * @brief Frame raw bytes holding one packet and hand them to onDataReceived(Context&, const socket::InboundFrame&).
+         * @param context Shared context.
+         * @param data Pointer to the packet.
+         * @param size Size of the packet in bytes.
+         * @return Optional state transition.
+         */
+        StateTransition onDataReceived(Context& context, const uint8_t* data, const uint32_t size)
+        {
+            return onDataReceived(context, socket::InboundFrame::fromBytes({ data, size }));
+        }
+
+        /**
+         * @brief Called with a batch of packets the socket received, in order.
+         * Stops after the first packet that asks for a transition, for which the reactor hands the rest to the new
+         * state, or that pauses receiving, which leaves the rest buffered in the socket. Handles one packet at a time
+         * unless a state overrides it.
          * @param context Shared context.
-         * @param data Pointer to received data.
-         * @param size Size of received data in bytes.
+         * @param frames The packets; never empty.
+         * @param handled Set to the number of packets handled, at least one.
          * @return Optional state transition.
          */
-        virtual StateTransition onDataReceived(Context& context, const uint8_t* data, uint32_t size) = 0;
+        virtual StateTransition onDataReceivedBatch(Context& context, const std::span<const socket::InboundFrame> frames, size_t& handled)
+        {
+            handled = 0;
+            while (handled < frames.size())
+            {
+                StateTransition transition = onDataReceived(context, frames[handled++]);
+                if (transition.newState.has_value() || context.isReceivePaused())
+                {
+                    return transition;
+                }
+            }
+            return StateTransition::noTransition();
+        }
 
         /**
          * @brief Called periodically to allow the state to perform time-based operations.
@@ -86,6 +113,19 @@ namespace reactormq::mqtt::client
          */
         virtual StateTransition onTick(Context& context) = 0;
 
+        /**
+         * @brief Called by the reactor for each expired timer in Context::getTimers().
+         * States schedule their own timers (usually in onEnter) and cancel them in onExit; timers of kinds a state
+         * does not handle are ignored.
+         * @param context Shared context.
+         * @param timer The expired timer.
+         * @return Optional state transition.
+         */
+        virtual StateTransition onTimer(Context& /*context*/, const TimerKey& /*timer*/)
+        {
+            return StateTransition::noTransition();
+        }
+
         /**
          * @brief Get a human-readable name for this state (for debugging/logging).
          * @return State name.
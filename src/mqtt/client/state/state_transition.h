@@ -5,29 +5,101 @@
 #pragma once
 
 #include "mqtt/client/command.h"
+#include "mqtt/client/completion.h"
 
-#include <memory>
 #include <optional>
+#include <utility>
 
 namespace reactormq::mqtt::client
 {
-    class IState;
-    using StatePtr = std::unique_ptr<IState>;
+    enum class StateId
+    {
+        Disconnected,
+        Connecting,
+        Ready,
+        Closing
+    };
+
+    /**
+     * @brief Name of a state, as its getStateName() returns it.
+     * @param id The state.
+     * @return A constant C-string naming the state.
+     */
+    inline const char* stateIdToString(const StateId id)
+    {
+        switch (id)
+        {
+            using enum StateId;
+        case Disconnected:
+            return "Disconnected";
+        case Connecting:
+            return "Connecting";
+        case Ready:
+            return "Ready";
+        case Closing:
+            return "Closing";
+        default:
+            return "Unknown";
+        }
+    }
+
     /**
      * @brief Result of a state operation, optionally indicating a new state to transition to.
+     *
+     * The new state is described rather than built: the reactor constructs it in place of the current one, so a
+     * transition never allocates.
      */
     struct StateTransition
     {
-        std::optional<StatePtr> newState; ///< New state. If present, the reactor will transition to it.
+        /// @brief The state to enter and the arguments it is constructed with.
+        struct Target
+        {
+            StateId id = StateId::Disconnected;
+            bool wasGracefulDisconnect = false; ///< Disconnected only.
+            bool cleanSession = false; ///< Connecting only.
+            Completion<void> promise; ///< Connecting and Closing only.
+        };
+
+        std::optional<Target> newState; ///< New state. If present, the reactor will transition to it.
+
+        /**
+         * @brief Create a transition to DisconnectedState.
+         * @param wasGracefulDisconnect True if the connection was closed on purpose, which suppresses auto-reconnect.
+         * @return Transition with the new state set.
+         */
+        static StateTransition toDisconnected(const bool wasGracefulDisconnect = false)
+        {
+            return StateTransition{ Target{ StateId::Disconnected, wasGracefulDisconnect, false, {} } };
+        }
+
+        /**
+         * @brief Create a transition to ConnectingState.
+         * @param cleanSession Whether to request a clean session.
+         * @param promise Completed when the connect succeeds or fails.
+         * @return Transition with the new state set.
+         */
+        static StateTransition toConnecting(const bool cleanSession, Completion<void> promise)
+        {
+            return StateTransition{ Target{ StateId::Connecting, false, cleanSession, std::move(promise) } };
+        }
+
+        /**
+         * @brief Create a transition to ReadyState.
+         * @return Transition with the new state set.
+         */
+        static StateTransition toReady()
+        {
+            return StateTransition{ Target{ StateId::Ready, false, false, {} } };
+        }
 
         /**
-         * @brief Create a transition to a new state.
-         * @param state The new state to transition to.
+         * @brief Create a transition to ClosingState.
+         * @param promise Completed once the connection is closed.
          * @return Transition with the new state set.
          */
-        static StateTransition transitionTo(StatePtr state)
+        static StateTransition toClosing(Completion<void> promise)
         {
-            return StateTransition{ std::move(state) };
+            return StateTransition{ Target{ StateId::Closing, false, false, std::move(promise) } };
         }
 
         /**
@@ -39,4 +111,4 @@ namespace reactormq::mqtt::client
             return StateTransition{ std::nullopt };
         }
     };
-} // namespace reactormq::mqtt::client
\ No newline at end of file
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,145 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The subscriptions the broker has granted, with their QoS and options, for resubscribing after a reconnect
+     * that finds no session.
+     *
+     * Filters sit contiguously in one vector, so a resubscribe encodes them straight from getFilters(); an index by
+     * filter string keeps remember() and forget() constant time, and forget() moves the last filter into the hole.
+     * Not thread-safe; it belongs to the reactor thread.
+     */
+    class SubscriptionCache final
+    {
+    public:
+        /**
+         * @brief Keep a granted subscription, replacing the options of one with the same filter.
+         * @param topicFilter The filter as it was subscribed.
+         */
+        void remember(const TopicFilter& topicFilter)
+        {
+            if (const auto it = m_indices.find(topicFilter.getFilter()); it != m_indices.end())
+            {
+                m_filters[it->second] = topicFilter;
+                return;
+            }
+
+            m_indices.emplace(topicFilter.getFilter(), m_filters.size());
+            m_filters.push_back(topicFilter);
+        }
+
+        /**
+         * @brief Drop a subscription, as when it is unsubscribed or refused.
+         * @param filter Topic filter exactly as it was subscribed.
+         */
+        void forget(const std::string_view filter)
+        {
+            const auto it = m_indices.find(filter);
+            if (it == m_indices.end())
+            {
+                return;
+            }
+
+            const size_t index = it->second;
+            m_indices.erase(it);
+            if (index + 1 != m_filters.size())
+            {
+                m_filters[index] = std::move(m_filters.back());
+                m_indices[m_filters[index].getFilter()] = index;
+            }
+            m_filters.pop_back();
+        }
+
+        /**
+         * @brief Make room for count subscriptions, so remembering that many never grows the table.
+         * @param count Subscriptions to hold.
+         */
+        void reserve(const size_t count)
+        {
+            m_filters.reserve(count);
+            m_indices.reserve(count);
+        }
+
+        /**
+         * @brief Work out the smallest change that turns the subscriptions into @p desired.
+         * @param desired Every filter that should be subscribed; a filter listed twice keeps its last options.
+         * @param toSubscribe Receives the filters that are not subscribed, or are with other options, in @p desired order.
+         * @param toUnsubscribe Receives the subscribed filters that @p desired leaves out.
+         */
+        void diff(
+            const std::span<const TopicFilter> desired,
+            std::vector<TopicFilter>& toSubscribe,
+            std::vector<std::string>& toUnsubscribe) const
+        {
+            std::unordered_map<std::string_view, const TopicFilter*> wanted;
+            wanted.reserve(desired.size());
+            for (const TopicFilter& topicFilter : desired)
+            {
+                wanted.insert_or_assign(topicFilter.getFilter(), &topicFilter);
+            }
+
+            for (const TopicFilter& topicFilter : desired)
+            {
+                if (wanted[topicFilter.getFilter()] != &topicFilter)
+                {
+                    continue;
+                }
+                const auto it = m_indices.find(topicFilter.getFilter());
+                if (it == m_indices.end() || m_filters[it->second] != topicFilter)
+                {
+                    toSubscribe.push_back(topicFilter);
+                }
+            }
+
+            for (const TopicFilter& topicFilter : m_filters)
+            {
+                if (!wanted.contains(topicFilter.getFilter()))
+                {
+                    toUnsubscribe.push_back(topicFilter.getFilter());
+                }
+            }
+        }
+
+        /// @brief The granted subscriptions, in no particular order.
+        [[nodiscard]] std::span<const TopicFilter> getFilters() const
+        {
+            return m_filters;
+        }
+
+        /// @brief Whether no subscription is active.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_filters.empty();
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        std::vector<TopicFilter> m_filters;
+        std::unordered_map<std::string, size_t, StringHash, std::equal_to<>> m_indices;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,79 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/tick_profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace reactormq::mqtt::client
+{
+    namespace
+    {
+        std::uint32_t saturate(const std::uint64_t ns)
+        {
+            return static_cast<std::uint32_t>(std::min<std::uint64_t>(ns, std::numeric_limits<std::uint32_t>::max()));
+        }
+    } // namespace
+
+    void TickProfiler::endTick(const std::chrono::steady_clock::duration total)
+    {
+        const auto totalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(total).count();
+        m_currentNs[static_cast<size_t>(TickPhase::Total)] = static_cast<std::uint64_t>(totalNs < 0 ? 0 : totalNs);
+
+        const std::uint64_t tick = m_ticksRecorded.load(std::memory_order_relaxed);
+        Sample& sample = m_window[tick % TickProfile::kWindowTicks];
+        for (size_t phase = 0; phase < TickProfile::kPhaseCount; ++phase)
+        {
+            sample[phase].store(saturate(m_currentNs[phase]), std::memory_order_relaxed);
+        }
+        m_ticksRecorded.store(tick + 1, std::memory_order_release);
+
+        m_currentNs = {};
+        m_nestedNs = 0;
+    }
+
+    TickProfile TickProfiler::getProfile() const
+    {
+        TickProfile profile;
+        profile.ticksRecorded = m_ticksRecorded.load(std::memory_order_acquire);
+        profile.windowTicks = static_cast<size_t>(std::min<std::uint64_t>(profile.ticksRecorded, TickProfile::kWindowTicks));
+        if (profile.windowTicks == 0)
+        {
+            return profile;
+        }
+
+        std::array<std::uint32_t, TickProfile::kWindowTicks> values{};
+        size_t slowest = 0;
+        for (size_t phase = 0; phase < TickProfile::kPhaseCount; ++phase)
+        {
+            std::uint64_t sum = 0;
+            for (size_t i = 0; i < profile.windowTicks; ++i)
+            {
+                values[i] = m_window[i][phase].load(std::memory_order_relaxed);
+                sum += values[i];
+                if (phase == static_cast<size_t>(TickPhase::Total) && values[i] > values[slowest])
+                {
+                    slowest = i;
+                }
+            }
+
+            TickPhaseStats& stats = profile.phases[phase];
+            stats.meanNs = sum / profile.windowTicks;
+            const auto end = values.begin() + static_cast<std::ptrdiff_t>(profile.windowTicks);
+            stats.maxNs = *std::max_element(values.begin(), end);
+            // Nearest rank: the smallest sample at or above 99% of the window.
+            const size_t rank = (profile.windowTicks * 99 + 99) / 100 - 1;
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), end);
+            stats.p99Ns = values[rank];
+        }
+
+        for (size_t phase = 0; phase < TickProfile::kPhaseCount; ++phase)
+        {
+            profile.slowestTickNs[phase] = m_window[slowest][phase].load(std::memory_order_relaxed);
+        }
+        return profile;
+    }
+} // namespace reactormq::mqtt::client
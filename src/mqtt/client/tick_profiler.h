@@ -0,0 +1,86 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/client_metrics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Rolling per-phase timings of the last TickProfile::kWindowTicks reactor ticks, behind
+     * IClient::getTickProfile().
+     *
+     * The reactor thread opens a TickPhaseScope around each phase and calls endTick() once per tick; any thread may
+     * call getProfile(). Scopes nest, and each phase is charged only the time not spent in a scope nested inside
+     * it, so a handler run while parsing counts as dispatch. Samples are stored in nanoseconds and saturate at about
+     * 4.3 seconds.
+     */
+    class TickProfiler final
+    {
+    public:
+        /// @brief Record the tick whose phases were timed since the previous call.
+        void endTick(std::chrono::steady_clock::duration total);
+
+        /// @brief Statistics over the recorded window; safe to call from any thread.
+        [[nodiscard]] TickProfile getProfile() const;
+
+    private:
+        friend class TickPhaseScope;
+
+        using Sample = std::array<std::atomic<std::uint32_t>, TickProfile::kPhaseCount>;
+
+        /// Per-tick totals, reactor thread only.
+        std::array<std::uint64_t, TickProfile::kPhaseCount> m_currentNs{};
+        /// Time spent in scopes nested inside the innermost open one.
+        std::uint64_t m_nestedNs = 0;
+
+        std::array<Sample, TickProfile::kWindowTicks> m_window{};
+        std::atomic<std::uint64_t> m_ticksRecorded{ 0 };
+    };
+
+    /// @brief Charges the time until its destruction to one phase of the current tick; does nothing without a profiler.
+    class TickPhaseScope final
+    {
+    public:
+        TickPhaseScope(TickProfiler* profiler, const TickPhase phase)
+            : m_profiler(profiler)
+            , m_phase(phase)
+        {
+            if (m_profiler)
+            {
+                m_outerNestedNs = m_profiler->m_nestedNs;
+                m_profiler->m_nestedNs = 0;
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~TickPhaseScope()
+        {
+            if (m_profiler)
+            {
+                const auto elapsed = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+                const std::uint64_t nested = m_profiler->m_nestedNs < elapsed ? m_profiler->m_nestedNs : elapsed;
+                m_profiler->m_currentNs[static_cast<size_t>(m_phase)] += elapsed - nested;
+                m_profiler->m_nestedNs = m_outerNestedNs + elapsed;
+            }
+        }
+
+        TickPhaseScope(const TickPhaseScope&) = delete;
+        TickPhaseScope& operator=(const TickPhaseScope&) = delete;
+
+    private:
+        TickProfiler* m_profiler;
+        TickPhase m_phase;
+        std::uint64_t m_outerNestedNs = 0;
+        std::chrono::steady_clock::time_point m_start;
+    };
+} // namespace reactormq::mqtt::client
@@ -4,12 +4,20 @@
 
 #pragma once
 
+#include "reactormq/mqtt/inline_function.h"
+
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace reactormq::mqtt::client
 {
-    using TimerCallback = std::function<void()>;
+    using TimerCallback = InlineFunction<void()>;
     using TimePoint = std::chrono::steady_clock::time_point;
     using Duration = std::chrono::milliseconds;
 
@@ -18,8 +26,7 @@ namespace reactormq::mqtt::client
      *
      * Timers are checked and fired during the reactor's tick() cycle.
      * Supports one-shot and periodic timers.
-     * n.b we can potentially delete this, we stuck with global timer / timestamp approach as this started getting messy,
-     * and harder to reason about.
+     * n.b. superseded by TimerQueue, which the reactor uses for all of its deadlines.
      */
     struct Timer
     {
@@ -60,4 +67,223 @@ namespace reactormq::mqtt::client
             }
         }
     };
-} // namespace reactormq::mqtt::client
\ No newline at end of file
+
+    /**
+     * @brief What a reactor timer guards. Each kind is owned by the state that schedules it.
+     */
+    enum class TimerKind : std::uint8_t
+    {
+        Keepalive, ///< Ready: send PINGREQ when idle, disconnect if PINGRESP is overdue.
+        ConnectTimeout, ///< Connecting: CONNACK did not arrive in time.
+        RetryBackoff, ///< Disconnected: next automatic reconnect attempt.
+        CloseTimeout, ///< Closing: force the socket down if the peer does not close.
+        PublishTimeout, ///< Any state: QoS 1/2 publish not acknowledged in time; id is the packet ID.
+        RequestTimeout, ///< Any state, fired by the reactor: no response to a request in time; id is its correlation ID.
+        RateLimit, ///< Ready: a publish held by an outbound rate limit may go out.
+        Reauthenticate, ///< Ready: time to send the next MQTT 5 re-authentication.
+        DrainTimeout, ///< Ready: a draining disconnect ran out of time; DISCONNECT goes out with whatever is left.
+    };
+
+    /**
+     * @brief Identity of a scheduled timer; scheduling the same key again replaces the previous deadline.
+     */
+    struct TimerKey
+    {
+        TimerKind kind = TimerKind::Keepalive;
+        std::uint32_t id = 0; ///< Distinguishes timers of the same kind (packet ID for PublishTimeout).
+
+        [[nodiscard]] bool operator==(const TimerKey&) const = default;
+    };
+
+    /**
+     * @brief Min-heap of reactor deadlines with O(log n) schedule and O(1) cancel.
+     *
+     * Cancelled or rescheduled entries stay in the heap and are skipped when they reach the top, so an expiry
+     * check costs O(expired · log n) no matter how many timers are pending. The heap is rebuilt when stale entries
+     * outnumber live ones. Not thread-safe; it belongs to the reactor thread.
+     *
+     * PublishTimeout deadlines are the bulk of the timers and share one retry interval, so they are scheduled in send
+     * order. They go to a FIFO instead of the heap while they arrive in deadline order, which makes scheduling and
+     * expiring them O(1); one that would be out of order, such as a short retry behind a long one, goes to the heap.
+     */
+    class TimerQueue final
+    {
+    public:
+        /**
+         * @brief Schedule (or reschedule) a timer.
+         * @param key Timer identity.
+         * @param fireTime When the timer expires.
+         */
+        void schedule(const TimerKey key, const TimePoint fireTime)
+        {
+            const std::uint64_t encoded = encode(key);
+            const std::uint32_t generation = m_nextGeneration++;
+            m_live[encoded] = LiveTimer{ fireTime, generation };
+            if (key.kind == TimerKind::PublishTimeout && (m_fifo.empty() || m_fifo.back().fireTime <= fireTime))
+            {
+                m_fifo.push_back(HeapEntry{ fireTime, encoded, generation });
+            }
+            else
+            {
+                m_heap.push_back(HeapEntry{ fireTime, encoded, generation });
+                std::ranges::push_heap(m_heap, std::greater{});
+            }
+            compactIfNeeded();
+        }
+
+        /// @brief Cancel a timer; no-op if it is not scheduled.
+        void cancel(const TimerKey key)
+        {
+            if (m_live.erase(encode(key)) != 0)
+            {
+                discardStaleTop();
+                compactIfNeeded();
+            }
+        }
+
+        /// @brief Whether the timer is currently scheduled.
+        [[nodiscard]] bool isScheduled(const TimerKey key) const
+        {
+            return m_live.contains(encode(key));
+        }
+
+        /// @brief Deadline of a scheduled timer, or std::nullopt.
+        [[nodiscard]] std::optional<TimePoint> getFireTime(const TimerKey key) const
+        {
+            const auto it = m_live.find(encode(key));
+            return it != m_live.end() ? std::optional{ it->second.fireTime } : std::nullopt;
+        }
+
+        /// @brief Earliest live deadline, or std::nullopt if nothing is scheduled.
+        [[nodiscard]] std::optional<TimePoint> getNextDeadline() const
+        {
+            const HeapEntry* const next = getNext();
+            return nullptr != next ? std::optional{ next->fireTime } : std::nullopt;
+        }
+
+        /**
+         * @brief Remove and return the earliest timer that has expired.
+         * @param now Current time.
+         * @return Expired key, or std::nullopt if no timer is due.
+         */
+        std::optional<TimerKey> popExpired(const TimePoint now)
+        {
+            const HeapEntry* const next = getNext();
+            if (nullptr == next || next->fireTime > now)
+            {
+                return std::nullopt;
+            }
+
+            const std::uint64_t encoded = next->key;
+            if (!m_fifo.empty() && next == &m_fifo.front())
+            {
+                m_fifo.pop_front();
+            }
+            else
+            {
+                std::ranges::pop_heap(m_heap, std::greater{});
+                m_heap.pop_back();
+            }
+            m_live.erase(encoded);
+            discardStaleTop();
+            return decode(encoded);
+        }
+
+        /// @brief Number of live (scheduled, not cancelled) timers.
+        [[nodiscard]] size_t size() const
+        {
+            return m_live.size();
+        }
+
+        /// @brief Drop all timers.
+        void clear()
+        {
+            m_live.clear();
+            m_heap.clear();
+            m_fifo.clear();
+        }
+
+    private:
+        struct LiveTimer
+        {
+            TimePoint fireTime;
+            std::uint32_t generation = 0;
+        };
+
+        struct HeapEntry
+        {
+            TimePoint fireTime;
+            std::uint64_t key = 0;
+            std::uint32_t generation = 0;
+
+            [[nodiscard]] bool operator>(const HeapEntry& other) const
+            {
+                return fireTime > other.fireTime;
+            }
+        };
+
+        static std::uint64_t encode(const TimerKey key)
+        {
+            return (static_cast<std::uint64_t>(key.kind) << 32) | key.id;
+        }
+
+        static TimerKey decode(const std::uint64_t encoded)
+        {
+            return TimerKey{ static_cast<TimerKind>(encoded >> 32), static_cast<std::uint32_t>(encoded) };
+        }
+
+        [[nodiscard]] bool isLive(const HeapEntry& entry) const
+        {
+            const auto it = m_live.find(entry.key);
+            return it != m_live.end() && it->second.generation == entry.generation;
+        }
+
+        /// @brief Earlier of the heap top and the FIFO head, or nullptr.
+        [[nodiscard]] const HeapEntry* getNext() const
+        {
+            if (m_fifo.empty())
+            {
+                return m_heap.empty() ? nullptr : &m_heap.front();
+            }
+            if (m_heap.empty() || m_fifo.front().fireTime <= m_heap.front().fireTime)
+            {
+                return &m_fifo.front();
+            }
+            return &m_heap.front();
+        }
+
+        /// @brief Keep the heap top and the FIFO head live so getNextDeadline() is exact.
+        void discardStaleTop()
+        {
+            while (!m_heap.empty() && !isLive(m_heap.front()))
+            {
+                std::ranges::pop_heap(m_heap, std::greater{});
+                m_heap.pop_back();
+            }
+            while (!m_fifo.empty() && !isLive(m_fifo.front()))
+            {
+                m_fifo.pop_front();
+            }
+        }
+
+        void compactIfNeeded()
+        {
+            discardStaleTop();
+            if (m_heap.size() + m_fifo.size() <= 2 * m_live.size() + kCompactionSlack)
+            {
+                return;
+            }
+
+            std::erase_if(m_heap, [this](const HeapEntry& entry) { return !isLive(entry); });
+            std::ranges::make_heap(m_heap, std::greater{});
+            std::erase_if(m_fifo, [this](const HeapEntry& entry) { return !isLive(entry); });
+        }
+
+        static constexpr size_t kCompactionSlack = 64;
+
+        std::vector<HeapEntry> m_heap;
+        std::deque<HeapEntry> m_fifo; ///< PublishTimeout entries in deadline order.
+        std::unordered_map<std::uint64_t, LiveTimer> m_live;
+        std::uint32_t m_nextGeneration = 0;
+    };
+} // namespace reactormq::mqtt::client
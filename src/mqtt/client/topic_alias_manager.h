@@ -0,0 +1,115 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Alias picked for an outgoing PUBLISH topic.
+     * alias is 0 when the topic is sent without one. When isNew is set the topic must be sent alongside the alias
+     * so the broker learns the mapping; otherwise the topic may be omitted.
+     */
+    struct TopicAliasChoice
+    {
+        std::uint16_t alias = 0;
+        bool isNew = false;
+    };
+
+    /**
+     * @brief Least-recently-used mapping of outgoing MQTT 5 topics to topic aliases.
+     *
+     * Aliases are scoped to one network connection, so the mapping is reset with the broker's Topic Alias Maximum
+     * on every CONNACK. Aliases 1..maximum are handed out in order; once all are taken, the least recently published
+     * topic gives its alias up. Not thread-safe; it belongs to the reactor thread.
+     */
+    class TopicAliasManager final
+    {
+    public:
+        /**
+         * @brief Drop every mapping and set how many aliases may be in use.
+         * @param maximum Number of aliases the broker accepts (capped by client settings); 0 disables aliasing.
+         */
+        void reset(const std::uint16_t maximum)
+        {
+            m_index.clear();
+            m_entries.clear();
+            m_maximum = maximum;
+        }
+
+        /// @brief Number of aliases that may be in use on this connection.
+        [[nodiscard]] std::uint16_t getMaximum() const
+        {
+            return m_maximum;
+        }
+
+        /// @brief Number of topics that currently have an alias.
+        [[nodiscard]] size_t size() const
+        {
+            return m_entries.size();
+        }
+
+        /**
+         * @brief Pick the alias to publish a topic with. A known topic becomes the most recently used one; an
+         * unknown topic does not change the mapping until commit() is called after the packet is sent.
+         * @param topic Topic name of the outgoing PUBLISH.
+         * @return The alias choice; alias 0 when aliasing is disabled.
+         */
+        [[nodiscard]] TopicAliasChoice choose(const std::string& topic)
+        {
+            if (0 == m_maximum || topic.empty())
+            {
+                return {};
+            }
+
+            if (const auto it = m_index.find(topic); it != m_index.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return { it->second->alias, false };
+            }
+
+            if (m_entries.size() < m_maximum)
+            {
+                return { static_cast<std::uint16_t>(m_entries.size() + 1), true };
+            }
+
+            return { m_entries.back().alias, true };
+        }
+
+        /**
+         * @brief Record that a topic was sent with a new alias chosen by choose(), evicting its previous holder.
+         * @param topic Topic name that was sent.
+         * @param alias Alias that was sent with it.
+         */
+        void commit(const std::string& topic, const std::uint16_t alias)
+        {
+            if (m_entries.size() >= m_maximum && !m_entries.empty())
+            {
+                m_index.erase(m_entries.back().topic);
+                m_entries.pop_back();
+            }
+
+            m_entries.push_front(Entry{ topic, alias });
+            m_index.emplace(m_entries.front().topic, m_entries.begin());
+        }
+
+    private:
+        struct Entry
+        {
+            std::string topic;
+            std::uint16_t alias = 0;
+        };
+
+        /// Most recently used first; list nodes are stable, so the index can key on views of their topics.
+        std::list<Entry> m_entries;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> m_index;
+        std::uint16_t m_maximum = 0;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,79 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/shared_topic.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Maps inbound topic names to one SharedTopic each, so messages on a repeated topic share its string.
+     *
+     * Lookups hash the decoded topic bytes in place; only the first message on a topic allocates. Keys view the
+     * interned strings themselves, which never move. Once the table holds its maximum it starts over, so a stream of
+     * ever-new topics cannot grow it without bound; handles already given out stay valid. Not thread-safe; it
+     * belongs to the reactor thread.
+     */
+    class TopicInternTable final
+    {
+    public:
+        /**
+         * @brief Create a table.
+         * @param maxTopics Most distinct topics held; 0 disables interning.
+         */
+        explicit TopicInternTable(const size_t maxTopics = 0)
+            : m_maxTopics(maxTopics)
+        {
+        }
+
+        /// @brief Whether intern() hands out topics at all.
+        [[nodiscard]] bool isEnabled() const
+        {
+            return m_maxTopics != 0;
+        }
+
+        /**
+         * @brief The shared string for a topic, interning it on first sight.
+         * @param topic Topic name of an inbound PUBLISH.
+         * @return The interned topic; empty when interning is disabled.
+         */
+        [[nodiscard]] SharedTopic intern(const std::string_view topic)
+        {
+            if (!isEnabled())
+            {
+                return {};
+            }
+
+            if (const auto it = m_topics.find(topic); it != m_topics.end())
+            {
+                return it->second;
+            }
+
+            if (m_topics.size() >= m_maxTopics)
+            {
+                m_topics.clear();
+            }
+
+            SharedTopic interned{ std::string(topic) };
+            m_topics.emplace(std::string_view{ interned.get() }, interned);
+            return interned;
+        }
+
+        /// @brief Number of topics currently interned.
+        [[nodiscard]] size_t size() const
+        {
+            return m_topics.size();
+        }
+
+    private:
+        size_t m_maxTopics;
+        std::unordered_map<std::string_view, SharedTopic> m_topics;
+    };
+} // namespace reactormq::mqtt::client
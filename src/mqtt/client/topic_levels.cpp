@@ -0,0 +1,74 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/topic_levels.h"
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REACTORMQ_TOPIC_LEVELS_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define REACTORMQ_TOPIC_LEVELS_NEON 1
+#endif
+
+namespace reactormq::mqtt::client
+{
+    std::uint64_t hashTopicLevel(const std::string_view level)
+    {
+        return std::hash<std::string_view>{}(level);
+    }
+
+    void splitTopicLevels(const std::string_view topic, std::vector<TopicLevel>& outLevels)
+    {
+        outLevels.clear();
+        const char* data = topic.data();
+        const size_t size = topic.size();
+        size_t start = 0;
+        const auto endLevelAt = [&](const size_t separator)
+        {
+            const std::string_view level = topic.substr(start, separator - start);
+            outLevels.push_back({ level, hashTopicLevel(level) });
+            start = separator + 1;
+        };
+
+        size_t i = 0;
+#if REACTORMQ_TOPIC_LEVELS_SSE2
+        const __m128i slash = _mm_set1_epi8('/');
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            for (auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, slash))); mask != 0; mask &= mask - 1)
+            {
+                endLevelAt(i + static_cast<size_t>(std::countr_zero(mask)));
+            }
+        }
+#elif REACTORMQ_TOPIC_LEVELS_NEON
+        const uint8x16_t slash = vdupq_n_u8('/');
+        for (; i + 16 <= size; i += 16)
+        {
+            // Narrowing each 16-bit lane by four bits leaves one nibble per byte, set where the byte is a '/'.
+            const uint8x16_t equal = vceqq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(data + i)), slash);
+            std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+            while (mask != 0)
+            {
+                const int bit = std::countr_zero(mask);
+                endLevelAt(i + static_cast<size_t>(bit / 4));
+                mask &= ~(std::uint64_t{ 0xF } << (bit & ~3));
+            }
+        }
+#endif // REACTORMQ_TOPIC_LEVELS_SSE2
+        for (; i < size; ++i)
+        {
+            if (data[i] == '/')
+            {
+                endLevelAt(i);
+            }
+        }
+        endLevelAt(size);
+    }
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,31 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /// @brief One '/'-separated level of a topic name or filter, with its hash.
+    struct TopicLevel
+    {
+        std::string_view text;
+        std::uint64_t hash = 0;
+    };
+
+    /**
+     * @brief Split a topic into its levels and hash each one.
+     * Separators are found 16 bytes at a time on SSE2 and NEON targets. An empty topic has one empty level, and a
+     * leading, trailing or doubled '/' gives an empty level too, as MQTT counts them.
+     * @param topic Topic name or filter; the levels view into it.
+     * @param outLevels Cleared, then filled with the levels in order.
+     */
+    void splitTopicLevels(std::string_view topic, std::vector<TopicLevel>& outLevels);
+
+    /// @brief Hash of one level, the same as splitTopicLevels() gives it.
+    [[nodiscard]] std::uint64_t hashTopicLevel(std::string_view level);
+} // namespace reactormq::mqtt::client
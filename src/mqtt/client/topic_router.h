@@ -0,0 +1,531 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/topic_levels.h"
+#include "reactormq/mqtt/shared_topic.h"
+#include "reactormq/mqtt/subscribable_async.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Routes incoming topics to the handlers of the subscriptions whose filters match them.
+     *
+     * Filters are stored in a trie with one node per topic level, so a lookup walks the topic's levels (plus the
+     * '+' branches it meets) instead of testing every filter. The trie is flat: nodes live in one array and are
+     * named by index, and every named child edge of every node sits in one open-addressed table keyed by the parent's
+     * index and the level's hash, so a step down is a probe into contiguous memory rather than a per-node map lookup.
+     * A topic's levels are split and hashed once per lookup. Subscribing and unsubscribing change only the nodes of
+     * their filter, and an unsubscribe frees the nodes it leaves empty for reuse.
+     *
+     * Results are cached per topic until the set of routes changes, so a steady stream on a few topics costs one hash
+     * lookup each, and an interned topic repeated from the previous message costs a pointer comparison. Shared
+     * subscription filters ($share/group/filter) route on the filter part.
+     *
+     * For MQTT 5 a filter can also be given a Subscription Identifier, which the broker echoes on every PUBLISH the
+     * subscription matches; matchIdentifiers() then finds the handlers with one array index per identifier and no
+     * topic matching at all. The trie still holds those handlers for PUBLISHes that carry no identifiers. Not
+     * thread-safe; it belongs to the reactor thread.
+     */
+    class TopicRouter final
+    {
+    public:
+        using Handler = std::shared_ptr<const MessageHandler>;
+        using HandlerList = std::vector<Handler>;
+
+        /**
+         * @brief Route topics matching a filter to a handler. A filter may have several handlers.
+         * @param filter Topic filter, with '+' and '#' wildcards.
+         * @param handler Handler called for each matching message.
+         * @param withIdentifier Also route by a Subscription Identifier for the filter, assigned on its first handler.
+         * @return The filter's Subscription Identifier, or 0 without one.
+         */
+        std::uint32_t add(const std::string_view filter, MessageHandler handler, const bool withIdentifier = false)
+        {
+            return add(filter, std::make_shared<const MessageHandler>(std::move(handler)), withIdentifier);
+        }
+
+        /**
+         * @brief Route topics matching a filter to a handler the caller keeps a reference to.
+         * @param filter Topic filter, with '+' and '#' wildcards.
+         * @param shared Handler called for each matching message; match() returns this same pointer.
+         * @param withIdentifier Also route by a Subscription Identifier for the filter, assigned on its first handler.
+         * @return The filter's Subscription Identifier, or 0 without one.
+         */
+        std::uint32_t add(const std::string_view filter, Handler shared, const bool withIdentifier = false)
+        {
+            NodeIndex node = kRoot;
+            bool multiLevel = false;
+            splitTopicLevels(stripSharePrefix(filter), m_levels);
+            for (const TopicLevel& level : m_levels)
+            {
+                if (level.text == "#")
+                {
+                    multiLevel = true;
+                    break;
+                }
+
+                node = level.text == "+" ? findOrAddSingleLevel(node) : findOrAddChild(node, level);
+            }
+
+            (multiLevel ? m_nodes[node].multiLevelHandlers : m_nodes[node].handlers).push_back(shared);
+            ++m_size;
+            clearCache();
+
+            return withIdentifier ? addIdentified(filter, std::move(shared)) : 0;
+        }
+
+        /**
+         * @brief Drop every handler routed for a filter, as when it is unsubscribed.
+         * @param filter Topic filter exactly as it was added.
+         * @return Number of handlers removed.
+         */
+        size_t remove(const std::string_view filter)
+        {
+            NodeIndex node = kRoot;
+            bool multiLevel = false;
+            splitTopicLevels(stripSharePrefix(filter), m_levels);
+            for (const TopicLevel& level : m_levels)
+            {
+                if (level.text == "#")
+                {
+                    multiLevel = true;
+                    break;
+                }
+
+                node = level.text == "+" ? m_nodes[node].singleLevel : findChild(node, level);
+                if (kNoNode == node)
+                {
+                    return 0;
+                }
+            }
+
+            HandlerList& handlers = multiLevel ? m_nodes[node].multiLevelHandlers : m_nodes[node].handlers;
+            const size_t removed = handlers.size();
+            handlers.clear();
+            m_size -= removed;
+            prune(node);
+            clearCache();
+            removeIdentified(filter);
+            return removed;
+        }
+
+        /**
+         * @brief Handlers of the subscriptions a PUBLISH names by Subscription Identifier.
+         * @param identifiers Subscription Identifiers carried by the PUBLISH.
+         * @return Shared list of their handlers, or nullptr when none is known.
+         */
+        [[nodiscard]] std::shared_ptr<const HandlerList> matchIdentifiers(const std::span<const std::uint32_t> identifiers) const
+        {
+            if (identifiers.size() == 1)
+            {
+                return findIdentified(identifiers.front());
+            }
+
+            HandlerList matched;
+            for (const std::uint32_t identifier : identifiers)
+            {
+                if (const auto handlers = findIdentified(identifier))
+                {
+                    matched.insert(matched.end(), handlers->begin(), handlers->end());
+                }
+            }
+            return matched.empty() ? nullptr : std::make_shared<const HandlerList>(std::move(matched));
+        }
+
+        /**
+         * @brief Handlers of every filter that matches a topic.
+         * @param topic Topic name of an incoming message.
+         * @return Shared list of the matching handlers, or nullptr when none match.
+         */
+        [[nodiscard]] std::shared_ptr<const HandlerList> match(const std::string_view topic)
+        {
+            if (0 == m_size)
+            {
+                return nullptr;
+            }
+
+            if (const auto it = m_cache.find(topic); it != m_cache.end())
+            {
+                return it->second;
+            }
+
+            splitTopicLevels(topic, m_levels);
+
+            HandlerList matched;
+            // Wildcards at the first level do not match topics starting with '$' (MQTT 4.7.2).
+            collect(kRoot, 0, !topic.empty() && topic.front() == '$', matched);
+
+            auto result = matched.empty() ? nullptr : std::make_shared<const HandlerList>(std::move(matched));
+            if (m_cache.size() >= kMaxCachedTopics)
+            {
+                m_cache.clear();
+            }
+            m_cache.emplace(std::string(topic), result);
+            return result;
+        }
+
+        /**
+         * @brief Handlers of every filter that matches an interned topic.
+         * The same string as the previous call's is answered without hashing it.
+         * @param topic Interned topic name of an incoming message.
+         * @return Shared list of the matching handlers, or nullptr when none match.
+         */
+        [[nodiscard]] std::shared_ptr<const HandlerList> match(const SharedTopic& topic)
+        {
+            if (topic.isEmpty() || 0 == m_size)
+            {
+                return match(topic.get());
+            }
+
+            if (!topic.isSameAs(m_lastTopic))
+            {
+                m_lastMatch = match(topic.get());
+                m_lastTopic = topic;
+            }
+            return m_lastMatch;
+        }
+
+        /**
+         * @brief The filter part of a shared subscription filter ($share/group/filter).
+         * @param filter Topic filter.
+         * @return The filter without its share prefix; the filter itself when it is not shared.
+         */
+        [[nodiscard]] static std::string_view stripSharePrefix(const std::string_view filter)
+        {
+            constexpr std::string_view kSharePrefix = "$share/";
+            if (!filter.starts_with(kSharePrefix))
+            {
+                return filter;
+            }
+
+            const size_t filterStart = filter.find('/', kSharePrefix.size());
+            return filterStart == std::string_view::npos ? std::string_view{} : filter.substr(filterStart + 1);
+        }
+
+        /// @brief Number of routed handlers.
+        [[nodiscard]] size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        template<typename T>
+        using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+        /// Index of a node in m_nodes.
+        using NodeIndex = std::uint32_t;
+
+        static constexpr NodeIndex kNoNode = UINT32_MAX;
+        static constexpr NodeIndex kRoot = 0;
+
+        struct Node
+        {
+            NodeIndex parent = kNoNode;
+            NodeIndex singleLevel = kNoNode;
+            /// Named children, which have edges in m_edges; the node can be freed once it has none and no handlers.
+            std::uint32_t childCount = 0;
+            std::uint64_t levelHash = 0;
+            /// The level this node is reached by; "+" for a parent's singleLevel child, empty for the root.
+            std::string level;
+            /// Handlers of filters ending at this node.
+            HandlerList handlers;
+            /// Handlers of filters ending in '#' right after this node; they match its topic and everything below.
+            HandlerList multiLevelHandlers;
+        };
+
+        /// A named child edge; a slot whose child is kNoNode is empty.
+        struct Edge
+        {
+            std::uint64_t levelHash = 0;
+            NodeIndex parent = kNoNode;
+            NodeIndex child = kNoNode;
+        };
+
+        /// @brief Edge table size before the first edge; it doubles whenever it would be more than half full.
+        static constexpr size_t kMinEdgeSlots = 16;
+
+        /// @brief Most topics whose match results are cached; the cache starts over once it is full.
+        static constexpr size_t kMaxCachedTopics = 1024;
+
+        /// @brief Largest Subscription Identifier MQTT 5 allows (a four-byte Variable Byte Integer).
+        static constexpr std::uint32_t kMaxIdentifier = 268435455;
+
+        void clearCache()
+        {
+            m_cache.clear();
+            m_lastTopic = {};
+            m_lastMatch.reset();
+        }
+
+        std::uint32_t addIdentified(const std::string_view filter, Handler handler)
+        {
+            std::uint32_t identifier = 0;
+            if (const auto it = m_identifiers.find(filter); it != m_identifiers.end())
+            {
+                identifier = it->second;
+            }
+            else if (!m_freeIdentifiers.empty())
+            {
+                identifier = m_freeIdentifiers.back();
+                m_freeIdentifiers.pop_back();
+            }
+            else if (m_byIdentifier.size() <= kMaxIdentifier)
+            {
+                identifier = static_cast<std::uint32_t>(std::max<size_t>(m_byIdentifier.size(), 1));
+                m_byIdentifier.resize(identifier + 1);
+            }
+            else
+            {
+                return 0;
+            }
+
+            // Lists are shared with in-flight callbacks, so a new handler gets a new list rather than changing one.
+            auto handlers = m_byIdentifier[identifier] ? std::make_shared<HandlerList>(*m_byIdentifier[identifier]) : std::make_shared<HandlerList>();
+            handlers->push_back(std::move(handler));
+            m_byIdentifier[identifier] = std::move(handlers);
+            m_identifiers.emplace(std::string(filter), identifier);
+            return identifier;
+        }
+
+        void removeIdentified(const std::string_view filter)
+        {
+            const auto it = m_identifiers.find(filter);
+            if (it == m_identifiers.end())
+            {
+                return;
+            }
+
+            m_byIdentifier[it->second].reset();
+            m_freeIdentifiers.push_back(it->second);
+            m_identifiers.erase(it);
+        }
+
+        [[nodiscard]] std::shared_ptr<const HandlerList> findIdentified(const std::uint32_t identifier) const
+        {
+            return identifier < m_byIdentifier.size() ? m_byIdentifier[identifier] : nullptr;
+        }
+
+        [[nodiscard]] static size_t edgeSlot(const std::uint64_t levelHash, const NodeIndex parent, const size_t slotMask)
+        {
+            return static_cast<size_t>((levelHash ^ (parent * 0x9E3779B97F4A7C15ULL)) * 0xFF51AFD7ED558CCDULL >> 17) & slotMask;
+        }
+
+        [[nodiscard]] NodeIndex findChild(const NodeIndex parent, const TopicLevel& level) const
+        {
+            if (m_edges.empty())
+            {
+                return kNoNode;
+            }
+
+            const size_t slotMask = m_edges.size() - 1;
+            for (size_t slot = edgeSlot(level.hash, parent, slotMask);; slot = (slot + 1) & slotMask)
+            {
+                const Edge& edge = m_edges[slot];
+                if (kNoNode == edge.child)
+                {
+                    return kNoNode;
+                }
+                if (edge.levelHash == level.hash && edge.parent == parent && m_nodes[edge.child].level == level.text)
+                {
+                    return edge.child;
+                }
+            }
+        }
+
+        NodeIndex findOrAddChild(const NodeIndex parent, const TopicLevel& level)
+        {
+            if (const NodeIndex child = findChild(parent, level); kNoNode != child)
+            {
+                return child;
+            }
+
+            const NodeIndex child = allocateNode(parent, level.text, level.hash);
+            if ((m_edgeCount + 1) * 2 > m_edges.size())
+            {
+                resizeEdges(std::max(kMinEdgeSlots, m_edges.size() * 2));
+            }
+            insertEdge({ level.hash, parent, child });
+            ++m_edgeCount;
+            ++m_nodes[parent].childCount;
+            return child;
+        }
+
+        NodeIndex findOrAddSingleLevel(const NodeIndex parent)
+        {
+            if (kNoNode == m_nodes[parent].singleLevel)
+            {
+                const NodeIndex child = allocateNode(parent, "+", 0);
+                m_nodes[parent].singleLevel = child;
+            }
+            return m_nodes[parent].singleLevel;
+        }
+
+        NodeIndex allocateNode(const NodeIndex parent, const std::string_view level, const std::uint64_t levelHash)
+        {
+            NodeIndex index;
+            if (!m_freeNodes.empty())
+            {
+                index = m_freeNodes.back();
+                m_freeNodes.pop_back();
+            }
+            else
+            {
+                index = static_cast<NodeIndex>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+
+            Node& node = m_nodes[index];
+            node.parent = parent;
+            node.levelHash = levelHash;
+            node.level.assign(level);
+            return index;
+        }
+
+        void insertEdge(const Edge& edge)
+        {
+            const size_t slotMask = m_edges.size() - 1;
+            size_t slot = edgeSlot(edge.levelHash, edge.parent, slotMask);
+            while (kNoNode != m_edges[slot].child)
+            {
+                slot = (slot + 1) & slotMask;
+            }
+            m_edges[slot] = edge;
+        }
+
+        void resizeEdges(const size_t slotCount)
+        {
+            std::vector<Edge> previous(slotCount);
+            previous.swap(m_edges);
+            for (const Edge& edge : previous)
+            {
+                if (kNoNode != edge.child)
+                {
+                    insertEdge(edge);
+                }
+            }
+        }
+
+        /// @brief Remove a node's edge from its parent, shifting later entries of its probe run back into the gap.
+        void eraseEdge(const NodeIndex child)
+        {
+            const Node& node = m_nodes[child];
+            const size_t slotMask = m_edges.size() - 1;
+            size_t gap = edgeSlot(node.levelHash, node.parent, slotMask);
+            while (m_edges[gap].child != child)
+            {
+                gap = (gap + 1) & slotMask;
+            }
+
+            for (size_t slot = (gap + 1) & slotMask; kNoNode != m_edges[slot].child; slot = (slot + 1) & slotMask)
+            {
+                // An entry can fill the gap only if its home slot is not between the gap and where it sits now.
+                const size_t home = edgeSlot(m_edges[slot].levelHash, m_edges[slot].parent, slotMask);
+                if (((slot - home) & slotMask) >= ((slot - gap) & slotMask))
+                {
+                    m_edges[gap] = m_edges[slot];
+                    gap = slot;
+                }
+            }
+            m_edges[gap] = {};
+            --m_edgeCount;
+        }
+
+        /// @brief Free a node and each ancestor left without handlers or children, as an unsubscribe leaves them.
+        void prune(NodeIndex index)
+        {
+            while (kRoot != index)
+            {
+                Node& node = m_nodes[index];
+                if (!node.handlers.empty() || !node.multiLevelHandlers.empty() || 0 != node.childCount || kNoNode != node.singleLevel)
+                {
+                    return;
+                }
+
+                const NodeIndex parent = node.parent;
+                if (m_nodes[parent].singleLevel == index)
+                {
+                    m_nodes[parent].singleLevel = kNoNode;
+                }
+                else
+                {
+                    eraseEdge(index);
+                    --m_nodes[parent].childCount;
+                }
+
+                node = Node{};
+                m_freeNodes.push_back(index);
+                index = parent;
+            }
+        }
+
+        void collect(const NodeIndex index, const size_t depth, const bool skipWildcards, HandlerList& matched) const
+        {
+            const Node& node = m_nodes[index];
+            if (!skipWildcards)
+            {
+                matched.insert(matched.end(), node.multiLevelHandlers.begin(), node.multiLevelHandlers.end());
+            }
+
+            if (depth == m_levels.size())
+            {
+                matched.insert(matched.end(), node.handlers.begin(), node.handlers.end());
+                return;
+            }
+
+            if (0 != node.childCount)
+            {
+                if (const NodeIndex child = findChild(index, m_levels[depth]); kNoNode != child)
+                {
+                    collect(child, depth + 1, false, matched);
+                }
+            }
+
+            if (!skipWildcards && kNoNode != node.singleLevel)
+            {
+                collect(node.singleLevel, depth + 1, false, matched);
+            }
+        }
+
+        /// Nodes by index; m_nodes[kRoot] is the root and is never freed.
+        std::vector<Node> m_nodes = std::vector<Node>(1);
+        std::vector<NodeIndex> m_freeNodes;
+        /// Named child edges of every node, open-addressed with linear probing; the size is a power of two.
+        std::vector<Edge> m_edges;
+        size_t m_edgeCount = 0;
+        size_t m_size = 0;
+        StringMap<std::shared_ptr<const HandlerList>> m_cache;
+        /// Interned topic of the last match(SharedTopic) call and its result; held so the string cannot be reused.
+        SharedTopic m_lastTopic;
+        std::shared_ptr<const HandlerList> m_lastMatch;
+        /// Handlers by Subscription Identifier; index 0 is never assigned.
+        std::vector<std::shared_ptr<const HandlerList>> m_byIdentifier;
+        StringMap<std::uint32_t> m_identifiers;
+        std::vector<std::uint32_t> m_freeIdentifiers;
+        /// Levels of the topic or filter being looked up; reused so a lookup does not allocate.
+        std::vector<TopicLevel> m_levels;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,246 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/atomic_shared_ptr.h"
+#include "mqtt/client/topic_router.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/traffic_accounting_options.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief Counts received messages per subscription and per busy topic prefix, behind IClient::getInboundTraffic().
+     *
+     * A subscription's counters are found from the handler the router matched, with one hash lookup per handler, and
+     * are relaxed atomics, so getReport() reads them from any thread while the reactor counts; the list of
+     * subscriptions is republished as a new snapshot only when one is added or removed. The busiest prefixes are kept
+     * with the space-saving algorithm in a fixed number of slots: a prefix not in a slot takes over the quietest one
+     * and inherits its count. The slots sit behind a mutex that a report holds only while copying them.
+     * Recording is for the reactor thread only.
+     */
+    class TrafficAccounting final
+    {
+    public:
+        /**
+         * @brief Create the accounting.
+         * @param options Prefix slots and levels; isEnabled is the caller's to check.
+         */
+        explicit TrafficAccounting(const TrafficAccountingOptions& options)
+            : m_prefixLevels(options.prefixLevels)
+            , m_prefixCapacity(options.topPrefixCount)
+        {
+            m_published.store(std::make_shared<const Snapshot>());
+            m_prefixes.reserve(m_prefixCapacity);
+            m_prefixIndex.reserve(m_prefixCapacity);
+        }
+
+        /**
+         * @brief Start counting the messages routed to a subscription's handler.
+         * @param filter Topic filter as subscribed.
+         * @param handler The handler the router returns for it.
+         */
+        void addSubscription(const std::string_view filter, const MessageHandler* handler)
+        {
+            auto counters = std::make_shared<Counters>();
+            m_byHandler[handler] = counters;
+            m_subscriptions.push_back(Subscription{ std::string(filter), handler, std::move(counters) });
+            publish();
+        }
+
+        /**
+         * @brief Stop counting a filter's subscriptions, as when it is unsubscribed.
+         * @param filter Topic filter exactly as it was added.
+         */
+        void removeSubscription(const std::string_view filter)
+        {
+            const size_t removed = std::erase_if(
+                m_subscriptions,
+                [this, filter](const Subscription& subscription)
+                {
+                    if (subscription.filter != filter)
+                    {
+                        return false;
+                    }
+                    m_byHandler.erase(subscription.handler);
+                    return true;
+                });
+            if (removed != 0)
+            {
+                publish();
+            }
+        }
+
+        /**
+         * @brief Count a received message: towards its topic's prefix, and towards each subscription it was routed to.
+         * @param topic Topic of the message.
+         * @param bytes Topic and payload bytes.
+         * @param routed Handlers the message was routed to; null when none matched.
+         */
+        void recordMessage(const std::string_view topic, const size_t bytes, const TopicRouter::HandlerList* routed)
+        {
+            if (routed)
+            {
+                for (const auto& handler : *routed)
+                {
+                    if (const auto it = m_byHandler.find(handler.get()); it != m_byHandler.end())
+                    {
+                        it->second->messages.fetch_add(1, std::memory_order_relaxed);
+                        it->second->bytes.fetch_add(bytes, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            if (m_prefixCapacity != 0)
+            {
+                recordPrefix(getPrefix(topic), bytes);
+            }
+        }
+
+        /**
+         * @brief Count a message routed to a handler that it will now never get.
+         * @param handler The handler.
+         */
+        void recordDropped(const MessageHandler* handler)
+        {
+            if (const auto it = m_byHandler.find(handler); it != m_byHandler.end())
+            {
+                it->second->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Current counts; safe to call from any thread.
+        [[nodiscard]] InboundTraffic getReport() const
+        {
+            InboundTraffic report;
+            const std::shared_ptr<const Snapshot> snapshot = m_published.load();
+            report.subscriptions.reserve(snapshot->size());
+            for (const auto& [filter, counters] : *snapshot)
+            {
+                report.subscriptions.push_back(SubscriptionTraffic{ filter,
+                                                                    counters->messages.load(std::memory_order_relaxed),
+                                                                    counters->bytes.load(std::memory_order_relaxed),
+                                                                    counters->dropped.load(std::memory_order_relaxed) });
+            }
+
+            {
+                const std::scoped_lock lock(m_prefixMutex);
+                report.topPrefixes = m_prefixes;
+            }
+            std::ranges::stable_sort(report.topPrefixes, std::ranges::greater{}, &TopicPrefixTraffic::messages);
+            return report;
+        }
+
+    private:
+        struct Counters
+        {
+            std::atomic<std::uint64_t> messages{ 0 };
+            std::atomic<std::uint64_t> bytes{ 0 };
+            std::atomic<std::uint64_t> dropped{ 0 };
+        };
+
+        struct Subscription
+        {
+            std::string filter;
+            const MessageHandler* handler = nullptr;
+            std::shared_ptr<Counters> counters;
+        };
+
+        using Snapshot = std::vector<std::pair<std::string, std::shared_ptr<const Counters>>>;
+
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(const std::string_view value) const
+            {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        void publish()
+        {
+            auto snapshot = std::make_shared<Snapshot>();
+            snapshot->reserve(m_subscriptions.size());
+            for (const Subscription& subscription : m_subscriptions)
+            {
+                snapshot->emplace_back(subscription.filter, subscription.counters);
+            }
+            m_published.store(std::move(snapshot));
+        }
+
+        [[nodiscard]] std::string_view getPrefix(const std::string_view topic) const
+        {
+            if (m_prefixLevels == 0)
+            {
+                return topic;
+            }
+
+            size_t end = 0;
+            for (std::uint32_t level = 0; level < m_prefixLevels; ++level)
+            {
+                end = topic.find('/', level == 0 ? 0 : end + 1);
+                if (end == std::string_view::npos)
+                {
+                    return topic;
+                }
+            }
+            return topic.substr(0, end);
+        }
+
+        void recordPrefix(const std::string_view prefix, const size_t bytes)
+        {
+            const std::scoped_lock lock(m_prefixMutex);
+            if (const auto it = m_prefixIndex.find(prefix); it != m_prefixIndex.end())
+            {
+                TopicPrefixTraffic& slot = m_prefixes[it->second];
+                ++slot.messages;
+                slot.bytes += bytes;
+                return;
+            }
+
+            if (m_prefixes.size() < m_prefixCapacity)
+            {
+                m_prefixIndex.emplace(std::string(prefix), m_prefixes.size());
+                m_prefixes.push_back(TopicPrefixTraffic{ std::string(prefix), 1, bytes, 0 });
+                return;
+            }
+
+            // The quietest prefix gives up its slot; the newcomer may have been counted in it, so it inherits the count.
+            const auto quietest = std::ranges::min_element(m_prefixes, {}, &TopicPrefixTraffic::messages);
+            auto node = m_prefixIndex.extract(quietest->prefix);
+            node.key().assign(prefix);
+            m_prefixIndex.insert(std::move(node));
+            quietest->prefix.assign(prefix);
+            quietest->overcount = quietest->messages;
+            ++quietest->messages;
+            quietest->bytes = bytes;
+        }
+
+        std::uint32_t m_prefixLevels;
+        size_t m_prefixCapacity;
+
+        std::vector<Subscription> m_subscriptions;
+        std::unordered_map<const MessageHandler*, std::shared_ptr<Counters>> m_byHandler;
+        AtomicSharedPtr<const Snapshot> m_published;
+
+        mutable std::mutex m_prefixMutex;
+        std::vector<TopicPrefixTraffic> m_prefixes;
+        std::unordered_map<std::string, size_t, StringHash, std::equal_to<>> m_prefixIndex;
+    };
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,144 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/traffic_recording.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace reactormq::mqtt::client
+{
+    namespace
+    {
+        void appendVarint(std::vector<char>& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        bool readVarint(const std::span<const std::uint8_t> data, size_t& offset, std::uint64_t& outValue)
+        {
+            outValue = 0;
+            for (unsigned shift = 0; shift < 64 && offset < data.size(); shift += 7)
+            {
+                const std::uint8_t byte = data[offset++];
+                outValue |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readFile(const std::filesystem::path& path, std::vector<std::uint8_t>& outBytes)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+            {
+                return false;
+            }
+            outBytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            return !in.bad();
+        }
+    } // namespace
+
+    void TrafficRecordingEncoder::appendHeader(std::vector<char>& out)
+    {
+        out.insert(out.end(), kMagic, kMagic + kMagicSize);
+    }
+
+    void TrafficRecordingEncoder::appendPacket(
+        std::vector<char>& out,
+        const std::int64_t timestampUs,
+        const PacketDirection direction,
+        const std::uint32_t originalSize,
+        const std::span<const std::uint8_t> bytes)
+    {
+        const std::int64_t timestamp = std::max(timestampUs, m_previousTimestampUs);
+        out.push_back(direction == PacketDirection::Received ? 0 : 1);
+        appendVarint(out, static_cast<std::uint64_t>(timestamp - m_previousTimestampUs));
+        appendVarint(out, originalSize);
+        appendVarint(out, bytes.size());
+        out.insert(out.end(), bytes.begin(), bytes.end());
+        m_previousTimestampUs = timestamp;
+    }
+
+    bool decodeTrafficRecording(const std::span<const std::uint8_t> data, std::vector<RecordedPacket>& outPackets)
+    {
+        outPackets.clear();
+        constexpr size_t kMagicSize = TrafficRecordingEncoder::kMagicSize;
+        if (data.size() < kMagicSize || std::memcmp(data.data(), TrafficRecordingEncoder::kMagic, kMagicSize) != 0)
+        {
+            return false;
+        }
+
+        size_t offset = kMagicSize;
+        std::int64_t timestampUs = 0;
+        while (offset < data.size())
+        {
+            const std::uint8_t direction = data[offset++];
+            std::uint64_t deltaUs = 0;
+            std::uint64_t originalSize = 0;
+            std::uint64_t recordedSize = 0;
+            if (direction > 1 || !readVarint(data, offset, deltaUs) || !readVarint(data, offset, originalSize)
+                || !readVarint(data, offset, recordedSize) || recordedSize > originalSize || originalSize > UINT32_MAX
+                || recordedSize > data.size() - offset)
+            {
+                return false;
+            }
+
+            timestampUs += static_cast<std::int64_t>(deltaUs);
+            RecordedPacket& packet = outPackets.emplace_back();
+            packet.timestampUs = timestampUs;
+            packet.direction = direction == 0 ? PacketDirection::Received : PacketDirection::Sent;
+            packet.originalSize = static_cast<std::uint32_t>(originalSize);
+            const auto recorded = data.subspan(offset, static_cast<size_t>(recordedSize));
+            packet.bytes.assign(recorded.begin(), recorded.end());
+            offset += recordedSize;
+        }
+        return true;
+    }
+
+    bool loadTrafficRecording(const std::string& path, std::vector<RecordedPacket>& outPackets)
+    {
+        outPackets.clear();
+        std::error_code error;
+        if (!std::filesystem::is_directory(path, error))
+        {
+            std::vector<std::uint8_t> data;
+            return readFile(path, data) && decodeTrafficRecording(data, outPackets);
+        }
+
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(path, error))
+        {
+            if (entry.is_regular_file())
+            {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const std::filesystem::path& file : files)
+        {
+            RecordedPacket packet;
+            if (!readFile(file, packet.bytes))
+            {
+                return false;
+            }
+            packet.originalSize = static_cast<std::uint32_t>(packet.bytes.size());
+            outPackets.push_back(std::move(packet));
+        }
+        return !error;
+    }
+} // namespace reactormq::mqtt::client
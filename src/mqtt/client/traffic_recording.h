@@ -0,0 +1,87 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/packet_tap.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace reactormq::mqtt::client
+{
+    /// @brief One packet of a traffic recording.
+    struct RecordedPacket
+    {
+        /// Microseconds since the Unix epoch when the packet was tapped.
+        std::int64_t timestampUs = 0;
+        PacketDirection direction = PacketDirection::Received;
+        /// Size of the packet; more than bytes holds when the capture cut it at its snap length.
+        std::uint32_t originalSize = 0;
+        std::vector<std::uint8_t> bytes;
+
+        /// @brief Whether every byte of the packet was recorded, so it can be replayed.
+        [[nodiscard]] bool isComplete() const
+        {
+            return bytes.size() == originalSize;
+        }
+    };
+
+    /**
+     * @brief Writes the compact traffic recording format (PacketCaptureFormat::Recording).
+     *
+     * The file is the magic "RMQTRAF1" followed by one record per packet: a direction byte (0 received, 1 sent), then
+     * LEB128 varints for the microseconds since the previous record (since the epoch for the first), the original size
+     * and the recorded size, then the recorded bytes. A steady stream of small packets costs a few bytes of framing
+     * each.
+     */
+    class TrafficRecordingEncoder final
+    {
+    public:
+        static constexpr char kMagic[] = "RMQTRAF1";
+        static constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+
+        /// @brief Append the magic that starts a recording.
+        static void appendHeader(std::vector<char>& out);
+
+        /**
+         * @brief Append one packet.
+         * @param out Buffer to append to.
+         * @param timestampUs Microseconds since the Unix epoch; earlier than the previous packet's counts as equal.
+         * @param direction Whether the packet was received or sent.
+         * @param originalSize Size of the packet.
+         * @param bytes Recorded bytes; at most originalSize of them.
+         */
+        void appendPacket(
+            std::vector<char>& out,
+            std::int64_t timestampUs,
+            PacketDirection direction,
+            std::uint32_t originalSize,
+            std::span<const std::uint8_t> bytes);
+
+    private:
+        std::int64_t m_previousTimestampUs = 0;
+    };
+
+    /**
+     * @brief Decode a traffic recording.
+     * @param data Whole file, magic included.
+     * @param outPackets Cleared, then filled with the packets in order.
+     * @return False if the magic is missing or a record is malformed or cut short; outPackets then holds the records
+     * before it.
+     */
+    [[nodiscard]] bool decodeTrafficRecording(std::span<const std::uint8_t> data, std::vector<RecordedPacket>& outPackets);
+
+    /**
+     * @brief Load traffic to replay from a recording file, or from a directory laid out like a fuzz corpus.
+     * Each regular file of a directory is one chunk of received bytes, in file name order, with no timing; so
+     * tests/fuzz/corpus/fuzz_mqtt_codec can be replayed as it is.
+     * @param path Recording file or corpus directory.
+     * @param outPackets Cleared, then filled with the packets in order.
+     * @return False if the path cannot be read or the recording is malformed.
+     */
+    [[nodiscard]] bool loadTrafficRecording(const std::string& path, std::vector<RecordedPacket>& outPackets);
+} // namespace reactormq::mqtt::client
@@ -0,0 +1,56 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/client/atomic_shared_ptr.h"
+#include "socket/platform/wakeup_handle.h"
+
+#include <memory>
+#include <utility>
+
+namespace reactormq::mqtt::client
+{
+    /**
+     * @brief The wakeup a reactor's producers signal: command senders, message handlers acknowledging deliveries, and
+     * async callbacks. Every producer holds the route rather than the handle, so a ReactorGroup that moves the reactor
+     * to another thread retargets all of them at once, while they keep signalling from their own threads.
+     */
+    class WakeupRoute final
+    {
+    public:
+        explicit WakeupRoute(std::shared_ptr<socket::WakeupHandle> wakeup)
+        {
+            m_wakeup.store(std::move(wakeup));
+        }
+
+        /// @brief Signal the current wakeup. Safe from any thread.
+        void signal() const
+        {
+            if (const auto wakeup = m_wakeup.load())
+            {
+                wakeup->signal();
+            }
+        }
+
+        /// @brief The current wakeup. Safe from any thread.
+        [[nodiscard]] std::shared_ptr<socket::WakeupHandle> get() const
+        {
+            return m_wakeup.load();
+        }
+
+        /**
+         * @brief Point the route at another wakeup and signal it, so work raised against the old one is not missed.
+         * @param wakeup New wakeup; must not be null.
+         */
+        void retarget(std::shared_ptr<socket::WakeupHandle> wakeup)
+        {
+            m_wakeup.store(wakeup);
+            wakeup->signal();
+        }
+
+    private:
+        AtomicSharedPtr<socket::WakeupHandle> m_wakeup;
+    };
+} // namespace reactormq::mqtt::client
@@ -10,6 +10,11 @@
 
 std::shared_ptr<reactormq::mqtt::ConnectionSettings> reactormq::mqtt::ConnectionSettingsBuilder::build() const
 {
+    FixedCapacityOptions fixedCapacity = m_fixedCapacity;
+#if REACTORMQ_FIXED_CAPACITY
+    fixedCapacity.isEnabled = true;
+#endif // REACTORMQ_FIXED_CAPACITY
+
     return std::make_shared<ConnectionSettings>(
         m_host,
         m_port,
@@ -40,7 +45,115 @@ std::shared_ptr<reactormq::mqtt::ConnectionSettings> reactormq::mqtt::Connection
         m_maxInboundPacketsPerTick,
         m_maxPendingCommands,
         m_callbackExecutor,
-        m_sslVerifyCallback);
+        m_sslVerifyCallback,
+        m_outboundCoalesceMaxBytes,
+        m_outboundCoalesceMaxDelayMs,
+        m_packetArenaSize,
+        m_maxOutboundTopicAliases,
+        m_maxInboundTopicAliases,
+        m_maxOfflinePublishes,
+        m_maxOfflineQueueBytes,
+        m_offlineQueuePolicy,
+        m_sessionStore,
+        m_pipelineSubscribesOnConnect,
+        m_maxInboundProcessingTimeUs,
+        m_maxCommandsPerTick,
+        m_maxCommandProcessingTimeUs,
+        m_batchCallbacks,
+        m_messageDispatchLanes,
+        m_maxPendingDeliveries,
+        m_maxPendingDeliveryBytes,
+        m_manualAcknowledgement,
+        m_receiveMaximum,
+        m_tickProfiling,
+        m_kernelTlsOffload,
+        m_dnsCacheTtlSeconds,
+        m_socketOptions,
+        m_webSocketDeflate,
+        m_payloadCodecs,
+        m_maxInternedTopics,
+        m_memoryResource,
+        m_inboundStreamingThreshold,
+        m_resubscribeOnReconnect,
+        m_lastValueCacheSize,
+        m_failoverEndpoints,
+        m_warmStandby,
+        m_reconnectJitter,
+        m_reconnectThrottle,
+        m_busyPoll,
+        m_publishDedup,
+        m_publishRateLimits,
+        m_bufferMemory,
+        m_deliverQos2OnPublish,
+        m_reauthenticateIntervalMs,
+        fixedCapacity,
+        m_packetTap,
+        m_tlsTuning,
+        m_encodePublishesOnCallingThread,
+        m_adaptiveTimeouts,
+        m_trafficAccounting);
+}
+
+reactormq::mqtt::ConnectionSettingsBuilder& reactormq::mqtt::ConnectionSettingsBuilder::applyProfile(const PerformanceProfile profile)
+{
+    // Start every profile from the defaults of the knobs profiles cover, so no knob of an earlier profile survives.
+    const ConnectionSettingsBuilder defaults;
+    m_outboundCoalesceMaxBytes = defaults.m_outboundCoalesceMaxBytes;
+    m_outboundCoalesceMaxDelayMs = defaults.m_outboundCoalesceMaxDelayMs;
+    m_maxInboundPacketsPerTick = defaults.m_maxInboundPacketsPerTick;
+    m_maxInboundProcessingTimeUs = defaults.m_maxInboundProcessingTimeUs;
+    m_maxCommandsPerTick = defaults.m_maxCommandsPerTick;
+    m_maxCommandProcessingTimeUs = defaults.m_maxCommandProcessingTimeUs;
+    m_socketOptions = defaults.m_socketOptions;
+    m_busyPoll = defaults.m_busyPoll;
+    m_maxPacketSize = defaults.m_maxPacketSize;
+    m_maxBufferSize = defaults.m_maxBufferSize;
+    m_maxOutboundQueueBytes = defaults.m_maxOutboundQueueBytes;
+    m_packetArenaSize = defaults.m_packetArenaSize;
+    m_tlsTuning = defaults.m_tlsTuning;
+    m_batchCallbacks = defaults.m_batchCallbacks;
+    m_messageDispatchLanes = defaults.m_messageDispatchLanes;
+    m_encodePublishesOnCallingThread = defaults.m_encodePublishesOnCallingThread;
+
+    switch (profile)
+    {
+        using enum PerformanceProfile;
+    case LowLatency:
+        m_outboundCoalesceMaxBytes = 0;
+        m_socketOptions = SocketOptions::lowLatency();
+        m_tlsTuning = TlsTuningOptions::lowLatency();
+        break;
+    case HighThroughput:
+        m_outboundCoalesceMaxBytes = 256 * 1024;
+        m_outboundCoalesceMaxDelayMs = 2;
+        m_maxInboundPacketsPerTick = 1000;
+        m_socketOptions = SocketOptions::highThroughput();
+        m_packetArenaSize = 256 * 1024;
+        m_tlsTuning = TlsTuningOptions::highThroughput();
+        m_encodePublishesOnCallingThread = true;
+        break;
+    case Embedded:
+        m_outboundCoalesceMaxBytes = 4 * 1024;
+        m_maxInboundPacketsPerTick = 16;
+        m_maxCommandsPerTick = 16;
+        m_maxPacketSize = 256 * 1024;
+        m_maxBufferSize = 512 * 1024;
+        m_maxOutboundQueueBytes = 256 * 1024;
+        m_packetArenaSize = 4 * 1024;
+        m_tlsTuning.maxFragmentLength = 2048;
+        break;
+    case GameThread:
+        m_maxInboundPacketsPerTick = 64;
+        m_maxInboundProcessingTimeUs = 1000;
+        m_maxCommandsPerTick = 64;
+        m_maxCommandProcessingTimeUs = 500;
+        m_batchCallbacks = true;
+        break;
+    case Default:
+    default:
+        break;
+    }
+    return *this;
 }
 
 std::string reactormq::mqtt::ConnectionSettingsBuilder::generateClientId(const bool withRandomPrefix)
@@ -0,0 +1,52 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/message_view.h"
+#include "mqtt/packets/properties/property_view.h"
+
+namespace reactormq::mqtt
+{
+    namespace
+    {
+        packets::properties::PropertiesView viewProperties(const std::span<const std::uint8_t> rawProperties)
+        {
+            return packets::properties::PropertiesView(std::as_bytes(rawProperties));
+        }
+    } // namespace
+
+    bool MessageView::forEachProperty(const InlineFunction<void(const MessageProperty&)>& visitor) const
+    {
+        return viewProperties(m_rawProperties)
+            .forEach(
+                [&visitor](const packets::properties::PropertyView& property)
+                {
+                    using enum packets::properties::PropertyIdentifier;
+                    const packets::properties::PropertyIdentifier identifier = property.getIdentifier();
+
+                    MessageProperty out;
+                    out.identifier = static_cast<std::uint8_t>(identifier);
+                    out.integer = property.getInteger();
+                    if (identifier == CorrelationData || identifier == AuthenticationData)
+                    {
+                        out.binary = property.getBinary();
+                    }
+                    else
+                    {
+                        out.string = property.getString();
+                        out.value = property.getUserPropertyValue();
+                    }
+                    visitor(out);
+                });
+    }
+
+    std::optional<std::string_view> MessageView::findUserProperty(const std::string_view name) const
+    {
+        return viewProperties(m_rawProperties).findUserProperty(name);
+    }
+
+    std::optional<std::uint32_t> MessageView::getMessageExpiryInterval() const
+    {
+        return viewProperties(m_rawProperties).getMessageExpiryInterval();
+    }
+} // namespace reactormq::mqtt
@@ -289,8 +289,8 @@ namespace reactormq::mqtt::packets
             return false;
         }
 
-        std::string protocolName;
-        if (!serialize::decodeString(reader, protocolName))
+        std::string_view protocolName;
+        if (!serialize::decodeStringView(reader, protocolName))
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "[Connect] Failed to decode protocol name");
             return false;
@@ -298,7 +298,11 @@ namespace reactormq::mqtt::packets
 
         if (protocolName != "MQTT")
         {
-            REACTORMQ_LOG(logging::LogLevel::Error, "[Connect] Invalid protocol name: %s", protocolName.c_str());
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "[Connect] Invalid protocol name: %.*s",
+                static_cast<int>(protocolName.size()),
+                protocolName.data());
             return false;
         }
 
@@ -352,7 +356,7 @@ namespace reactormq::mqtt::packets
                 return false;
             }
 
-            if (!serialize::decodeString(reader, m_willMessage))
+            if (!serialize::decodeBinaryData(reader, m_willMessage))
             {
                 REACTORMQ_LOG(logging::LogLevel::Error, "[Connect] Failed to decode will message");
                 return false;
@@ -391,7 +395,7 @@ namespace reactormq::mqtt::packets
             return false;
         }
 
-        if ((flags & kPasswordBit) != std::byte{} && !serialize::decodeString(reader, m_password))
+        if ((flags & kPasswordBit) != std::byte{} && !serialize::decodeBinaryData(reader, m_password))
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "[Connect] Failed to decode password");
             return false;
@@ -409,15 +413,26 @@ namespace reactormq::mqtt::packets
         const std::string& password,
         bool cleanSession,
         const std::string& authMethod,
-        const std::vector<std::uint8_t>& initialAuthData)
+        const std::vector<std::uint8_t>& initialAuthData,
+        const std::uint16_t topicAliasMaximum,
+        const std::uint16_t receiveMaximum)
     {
         if constexpr (V == ProtocolVersion::V5)
         {
-            properties::Properties connectProperties;
+            std::vector<properties::Property> propList;
+
+            if (receiveMaximum != 0)
+            {
+                propList.emplace_back(properties::Property::create<properties::PropertyIdentifier::ReceiveMaximum>(receiveMaximum));
+            }
+
+            if (topicAliasMaximum != 0)
+            {
+                propList.emplace_back(properties::Property::create<properties::PropertyIdentifier::TopicAliasMaximum>(topicAliasMaximum));
+            }
 
             if (!authMethod.empty())
             {
-                std::vector<properties::Property> propList;
                 propList.emplace_back(
                     properties::Property::create<properties::PropertyIdentifier::AuthenticationMethod, std::string>(authMethod));
 
@@ -427,10 +442,9 @@ namespace reactormq::mqtt::packets
                         properties::Property::create<properties::PropertyIdentifier::AuthenticationData, std::vector<std::uint8_t>>(
                             initialAuthData));
                 }
-
-                connectProperties = properties::Properties(propList);
             }
 
+            properties::Properties connectProperties(std::move(propList));
             properties::Properties willProps{};
             Connect<V> connectPacket(
                 clientId,
@@ -465,7 +479,9 @@ namespace reactormq::mqtt::packets
         const std::string&,
         bool,
         const std::string&,
-        const std::vector<std::uint8_t>&);
+        const std::vector<std::uint8_t>&,
+        std::uint16_t,
+        std::uint16_t);
 
     template void encodeConnectToWriter<ProtocolVersion::V5>(
         ByteWriter&,
@@ -475,5 +491,7 @@ namespace reactormq::mqtt::packets
         const std::string&,
         bool,
         const std::string&,
-        const std::vector<std::uint8_t>&);
+        const std::vector<std::uint8_t>&,
+        std::uint16_t,
+        std::uint16_t);
 } // namespace reactormq::mqtt::packets
\ No newline at end of file
@@ -323,6 +323,8 @@ namespace reactormq::mqtt::packets
      * @param cleanSession Clean session flag.
      * @param authMethod Authentication method (MQTT 5 only).
      * @param initialAuthData Initial authentication data (MQTT 5 only).
+     * @param topicAliasMaximum Topic Alias Maximum to advertise, 0 to leave it out (MQTT 5 only).
+     * @param receiveMaximum Receive Maximum to advertise, 0 to leave it out (MQTT 5 only).
      */
     template<ProtocolVersion V>
     void encodeConnectToWriter(
@@ -333,7 +335,9 @@ namespace reactormq::mqtt::packets
         const std::string& password,
         bool cleanSession,
         const std::string& authMethod,
-        const std::vector<std::uint8_t>& initialAuthData);
+        const std::vector<std::uint8_t>& initialAuthData,
+        std::uint16_t topicAliasMaximum = 0,
+        std::uint16_t receiveMaximum = 0);
 
     /**
      * @brief Alias for MQTT 3.1.1 CONNECT packet.
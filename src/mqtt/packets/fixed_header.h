@@ -17,6 +17,9 @@
 
 namespace reactormq::mqtt::packets
 {
+    /// @brief Stack buffer size that fits any PINGREQ or acknowledgement the client sends (no reason string or user properties).
+    inline constexpr size_t kSmallPacketBufferSize = 16;
+
     /**
      * @brief Fixed header for an MQTT control packet.
      * Encodes/decodes the first byte and Remaining Length per MQTT 3.1.1 and 5.0.
@@ -70,6 +73,21 @@ namespace reactormq::mqtt::packets
             return header;
         }
 
+        /**
+         * @brief Build a fixed header from fields the framing already decoded, e.g. a socket::InboundFrame.
+         * @param flags First byte of the packet: type and flags.
+         * @param remainingLength Remaining Length from the header.
+         * @return The fixed header, or an empty one (packet type None) if the type is reserved.
+         */
+        static FixedHeader create(const uint8_t flags, const uint32_t remainingLength)
+        {
+            if (!isValidTypeByte(flags))
+            {
+                return {};
+            }
+            return { flags, remainingLength };
+        }
+
         /**
          * @brief Build a fixed header from a packet using default flags.
          * @param packet Packet to inspect.
@@ -136,11 +154,24 @@ namespace reactormq::mqtt::packets
         }
 
         /**
-         * @brief Encode the fixed header to a writer.
+         * @brief Encode the fixed header to a writer, first reserving room for the whole packet.
          * @param writer Writer for serialization.
          */
         void encode(const serialize::ByteWriter& writer) const
         {
+            encode(writer, 0);
+        }
+
+        /**
+         * @brief Encode the fixed header to a writer, reserving room for the packet minus bytes sent separately.
+         * @param writer Writer for serialization.
+         * @param externalBytes Trailing body bytes that will not go through this writer, e.g. a PUBLISH payload
+         * handed to a vectored send.
+         */
+        void encode(const serialize::ByteWriter& writer, const uint32_t externalBytes) const
+        {
+            const uint32_t bodyBytes = m_remainingLength > externalBytes ? m_remainingLength - externalBytes : 0;
+            writer.reserve(sizeof(m_flags) + serialize::variableByteIntegerSize(m_remainingLength) + bodyBytes);
             writer.writeUint8(m_flags);
             serialize::encodeVariableByteInteger(m_remainingLength, writer);
         }
@@ -160,21 +191,8 @@ namespace reactormq::mqtt::packets
                 return;
             }
 
-            const auto temp = static_cast<std::byte>(tempFlags);
-            const auto rawPacketType = std::to_integer<uint8_t>((temp & kTypeMask) >> kTypeShift);
-
-            if (constexpr auto maxAllowedType = static_cast<uint8_t>(PacketType::Auth); rawPacketType > maxAllowedType)
+            if (!isValidTypeByte(tempFlags))
             {
-                const std::bitset<8> bits(tempFlags);
-                REACTORMQ_LOG(logging::LogLevel::Error, "FixedHeader Invalid packet type. Flags: 0b%s", bits.to_string().c_str());
-                m_flags = 0;
-                m_remainingLength = 0;
-                return;
-            }
-
-            if (const auto packetType = static_cast<PacketType>(rawPacketType); packetType == PacketType::None)
-            {
-                REACTORMQ_LOG(logging::LogLevel::Error, "Invalid packet type: None");
                 m_flags = 0;
                 m_remainingLength = 0;
                 return;
@@ -206,6 +224,27 @@ namespace reactormq::mqtt::packets
         {
         }
 
+        /// @brief Whether the type nibble of a first byte names a packet type, logging why not.
+        static bool isValidTypeByte(const uint8_t flags)
+        {
+            const auto temp = static_cast<std::byte>(flags);
+            const auto rawPacketType = std::to_integer<uint8_t>((temp & kTypeMask) >> kTypeShift);
+
+            if (constexpr auto maxAllowedType = static_cast<uint8_t>(PacketType::Auth); rawPacketType > maxAllowedType)
+            {
+                const std::bitset<8> bits(flags);
+                REACTORMQ_LOG(logging::LogLevel::Error, "FixedHeader Invalid packet type. Flags: 0b%s", bits.to_string().c_str());
+                return false;
+            }
+
+            if (static_cast<PacketType>(rawPacketType) == PacketType::None)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "Invalid packet type: None");
+                return false;
+            }
+            return true;
+        }
+
         static constexpr std::byte kTypeMask{ std::byte{ 0xF0 } };
         static constexpr int kTypeShift{ 4 };
         static constexpr std::byte kRetainBit{ std::byte{ 0x1 } << 0 };
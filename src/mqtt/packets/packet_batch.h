@@ -0,0 +1,215 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/packet_type.h"
+#include "mqtt/packets/pre_encoded_packets.h"
+#include "mqtt/packets/publish_template.h"
+#include "reactormq/mqtt/shared_payload.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief Encodes many packets back to back into one growable buffer, so they leave in a single write.
+     *
+     * Headers, acknowledgements and small payloads are appended to one contiguous buffer. Payloads of at least
+     * kInlinePayloadBytes are not copied: the batch keeps a reference to their shared buffer and splits the output
+     * around them, so forEachSegment() yields a few regions for a vectored send. Each packet's size is known up front
+     * from its template, so the buffer is reserved once per packet and never reallocates mid-encode; clear() keeps
+     * the capacity, so a steady stream stops allocating once the buffer has grown to a tick's worth of output. A
+     * referenced payload with headroom (see PublishReservation) gets its header encoded in front of it, so the two
+     * are one region.
+     */
+    class PacketBatch final
+    {
+    public:
+        /// @brief Payloads of at least this many bytes are referenced instead of copied into the batch.
+        static constexpr size_t kInlinePayloadBytes = 512;
+
+        /**
+         * @brief Bytes a PUBLISH adds to the contiguous buffer.
+         * @param publishTemplate Template the header is encoded from.
+         * @param payloadSize Payload size in bytes.
+         * @return Header size, plus the payload size when it is copied in.
+         */
+        [[nodiscard]] static size_t measurePublish(const PublishTemplate& publishTemplate, const size_t payloadSize)
+        {
+            const size_t headerSize = publishTemplate.getHeaderSize(static_cast<std::uint32_t>(payloadSize));
+            return payloadSize < kInlinePayloadBytes ? headerSize + payloadSize : headerSize;
+        }
+
+        /**
+         * @brief Make room for bytes measured ahead of appending them, e.g. with measurePublish().
+         * @param bytes Number of bytes about to be appended.
+         */
+        void reserve(const size_t bytes)
+        {
+            serialize::ByteWriter(m_bytes).reserve(bytes);
+        }
+
+        /**
+         * @brief Append a PUBLISH encoded from its template.
+         * @param publishTemplate Template the header is encoded from.
+         * @param packetId Packet identifier; ignored for QoS 0.
+         * @param payload Payload bytes; referenced until clear() when large, copied otherwise.
+         * @param isDuplicate Duplicate flag.
+         */
+        void appendPublish(
+            const PublishTemplate& publishTemplate,
+            const std::uint16_t packetId,
+            const SharedPayload& payload,
+            const bool isDuplicate)
+        {
+            const auto payloadSize = static_cast<std::uint32_t>(payload.getSize());
+            if (payloadSize >= kInlinePayloadBytes)
+            {
+                const size_t headerSize = publishTemplate.getHeaderSize(payloadSize);
+                if (std::uint8_t* const header = payload.claimHeadroom(headerSize))
+                {
+                    publishTemplate.encodeHeader(
+                        serialize::ByteWriter(std::as_writable_bytes(std::span{ header, headerSize })), packetId, payloadSize, isDuplicate);
+                    m_referenced.push_back(ReferencedPayload{ m_bytes.size(), payload, headerSize });
+                    m_referencedBytes += headerSize + payloadSize;
+                    ++m_packetCount;
+                    return;
+                }
+            }
+
+            reserve(measurePublish(publishTemplate, payloadSize));
+            publishTemplate.encodeHeader(serialize::ByteWriter(m_bytes), packetId, payloadSize, isDuplicate);
+            appendPayload(payload);
+            ++m_packetCount;
+        }
+
+        /**
+         * @brief Append a PUBLISH whose header is already encoded, as for a retransmit.
+         * @param header PUBLISH header, fixed header through properties.
+         * @param payload Payload bytes; referenced until clear() when large, copied otherwise.
+         */
+        void appendPublish(const std::span<const std::byte> header, const SharedPayload& payload)
+        {
+            reserve(header.size() + (payload.getSize() < kInlinePayloadBytes ? payload.getSize() : 0));
+            m_bytes.insert(m_bytes.end(), header.begin(), header.end());
+            appendPayload(payload);
+            ++m_packetCount;
+        }
+
+        /**
+         * @brief Append an acknowledgement carrying only a packet identifier.
+         * @tparam TPacketType PUBACK, PUBREC, PUBREL or PUBCOMP.
+         * @param packetId Packet identifier being acknowledged.
+         */
+        template<PacketType TPacketType>
+            requires(detail::isIdOnlyAck(TPacketType))
+        void appendIdOnlyAck(const std::uint16_t packetId)
+        {
+            const auto ack = encodeIdOnlyAck<TPacketType>(packetId);
+            m_bytes.insert(m_bytes.end(), ack.begin(), ack.end());
+            ++m_packetCount;
+        }
+
+        /**
+         * @brief Call a visitor with each region of the batch, in order.
+         * @param visit Called as visit(std::span<const std::byte>) for every non-empty region.
+         */
+        template<typename Visitor>
+        void forEachSegment(Visitor&& visit) const
+        {
+            size_t offset = 0;
+            for (const ReferencedPayload& referenced : m_referenced)
+            {
+                if (referenced.offset > offset)
+                {
+                    visit(std::span<const std::byte>{ m_bytes.data() + offset, referenced.offset - offset });
+                }
+                const std::span<const std::uint8_t> view = referenced.payload.getView();
+                visit(std::as_bytes(std::span{ view.data() - referenced.headerSize, view.size() + referenced.headerSize }));
+                offset = referenced.offset;
+            }
+            if (m_bytes.size() > offset)
+            {
+                visit(std::span<const std::byte>{ m_bytes.data() + offset, m_bytes.size() - offset });
+            }
+        }
+
+        /// @brief The contiguous buffer, which is the whole batch when it references no payload (e.g. only acknowledgements).
+        [[nodiscard]] std::span<const std::byte> getContiguousBytes() const
+        {
+            return m_bytes;
+        }
+
+        /// @brief Upper bound on the regions forEachSegment() yields.
+        [[nodiscard]] size_t getSegmentCount() const
+        {
+            return 2 * m_referenced.size() + 1;
+        }
+
+        /// @brief Number of packets appended since the last clear().
+        [[nodiscard]] size_t getPacketCount() const
+        {
+            return m_packetCount;
+        }
+
+        /// @brief Total bytes of the packets appended, referenced payloads included.
+        [[nodiscard]] size_t getSize() const
+        {
+            return m_bytes.size() + m_referencedBytes;
+        }
+
+        /// @brief Whether nothing has been appended since the last clear().
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_packetCount == 0;
+        }
+
+        /// @brief Drop the packets and payload references, keeping the buffer's capacity.
+        void clear()
+        {
+            for (const ReferencedPayload& referenced : m_referenced)
+            {
+                if (referenced.headerSize != 0)
+                {
+                    referenced.payload.releaseHeadroom();
+                }
+            }
+            m_bytes.clear();
+            m_referenced.clear();
+            m_referencedBytes = 0;
+            m_packetCount = 0;
+        }
+
+    private:
+        /// A payload sent from its own buffer, between the contiguous bytes before offset and those after it.
+        struct ReferencedPayload
+        {
+            size_t offset = 0;
+            SharedPayload payload;
+            size_t headerSize = 0; ///< Bytes of header encoded into the payload's headroom, sent with it.
+        };
+
+        void appendPayload(const SharedPayload& payload)
+        {
+            if (payload.getSize() < kInlinePayloadBytes)
+            {
+                const auto bytes = std::as_bytes(payload.getView());
+                m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+                return;
+            }
+            m_referenced.push_back(ReferencedPayload{ m_bytes.size(), payload });
+            m_referencedBytes += payload.getSize();
+        }
+
+        std::vector<std::byte> m_bytes;
+        std::vector<ReferencedPayload> m_referenced;
+        size_t m_referencedBytes = 0;
+        size_t m_packetCount = 0;
+    };
+} // namespace reactormq::mqtt::packets
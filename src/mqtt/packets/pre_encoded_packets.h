@@ -0,0 +1,72 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/packet_type.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief Pre-encoded wire bytes for the control packets whose encoding is (almost) fixed.
+     *
+     * Covers PINGREQ, PINGRESP and a clean DISCONNECT, plus PUBACK/PUBREC/PUBREL/PUBCOMP with reason Success and no
+     * properties. These encode identically in MQTT 3.1.1 and 5: MQTT 5 omits the reason code and property length
+     * when they are Success and empty, which is also what the packet classes emit. Anything carrying a non-Success
+     * reason code or properties must go through the packet classes.
+     */
+    namespace detail
+    {
+        constexpr std::byte firstByte(const PacketType type)
+        {
+            // PUBREL (like SUBSCRIBE/UNSUBSCRIBE) has mandatory flag bits 0b0010.
+            const auto flags = type == PacketType::PubRel ? std::byte{ 0x02 } : std::byte{ 0x00 };
+            return static_cast<std::byte>(static_cast<std::uint8_t>(type) << 4) | flags;
+        }
+
+        constexpr bool isIdOnlyAck(const PacketType type)
+        {
+            return type == PacketType::PubAck || type == PacketType::PubRec || type == PacketType::PubRel || type == PacketType::PubComp;
+        }
+
+        constexpr bool isHeaderOnly(const PacketType type)
+        {
+            return type == PacketType::PingReq || type == PacketType::PingResp || type == PacketType::Disconnect;
+        }
+    } // namespace detail
+
+    /// @brief Wire size of a packet that is only a fixed header with Remaining Length 0.
+    inline constexpr size_t kHeaderOnlyPacketSize = 2;
+
+    /// @brief Wire size of an acknowledgement carrying only a packet identifier.
+    inline constexpr size_t kIdOnlyAckPacketSize = 4;
+
+    /**
+     * @brief Complete encoding of a packet with no variable header or payload.
+     * @tparam TPacketType PINGREQ, PINGRESP or DISCONNECT (normal disconnection).
+     */
+    template<PacketType TPacketType>
+        requires(detail::isHeaderOnly(TPacketType))
+    inline constexpr std::array<std::byte, kHeaderOnlyPacketSize> kHeaderOnlyPacket{ detail::firstByte(TPacketType), std::byte{ 0x00 } };
+
+    /**
+     * @brief Encode an acknowledgement by patching the packet identifier into its fixed template.
+     * @tparam TPacketType PUBACK, PUBREC, PUBREL or PUBCOMP.
+     * @param packetId Packet identifier being acknowledged.
+     * @return The complete packet.
+     */
+    template<PacketType TPacketType>
+        requires(detail::isIdOnlyAck(TPacketType))
+    constexpr std::array<std::byte, kIdOnlyAckPacketSize> encodeIdOnlyAck(const std::uint16_t packetId)
+    {
+        return { detail::firstByte(TPacketType),
+                 std::byte{ 0x02 },
+                 static_cast<std::byte>(packetId >> 8),
+                 static_cast<std::byte>(packetId & 0xFFu) };
+    }
+} // namespace reactormq::mqtt::packets
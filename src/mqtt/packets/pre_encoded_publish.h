@@ -0,0 +1,122 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/publish_template.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief A whole PUBLISH, header and payload, encoded by the thread that published it.
+     *
+     * The packet identifier is left as zero and the DUP flag clear; the reactor thread patches in the identifier it
+     * allocates and appends the bytes, so a reactor serving many publishing threads copies packets instead of encoding
+     * them. The bytes come from the client's memory resource, so a pooling resource recycles them. Retransmits encode
+     * their own header with DUP set, as for any other publish.
+     */
+    class PreEncodedPublish final
+    {
+    public:
+        PreEncodedPublish() = default;
+
+        /**
+         * @brief Encode a publish from its header template.
+         * @param publishTemplate Template of the header, without a Topic Alias or payload codec.
+         * @param payload Payload bytes, copied after the header.
+         * @param resource Memory resource the bytes come from.
+         */
+        PreEncodedPublish(
+            const PublishTemplate& publishTemplate,
+            const std::span<const std::uint8_t> payload,
+            std::pmr::memory_resource* resource)
+            : m_version(publishTemplate.getVersion())
+            , m_messageExpiryInterval(publishTemplate.getMessageExpiryInterval())
+        {
+            const auto payloadSize = static_cast<std::uint32_t>(payload.size());
+            const size_t headerSize = publishTemplate.getHeaderSize(payloadSize);
+            m_size = headerSize + payload.size();
+            m_bytes = Bytes(static_cast<std::byte*>(resource->allocate(m_size, alignof(std::byte))), Deallocate{ resource, m_size });
+            publishTemplate.encodeHeader(serialize::ByteWriter(std::span{ m_bytes.get(), headerSize }), 0, payloadSize, false);
+            if (!payload.empty())
+            {
+                std::memcpy(m_bytes.get() + headerSize, payload.data(), payload.size());
+            }
+            m_packetIdOffset = publishTemplate.getPacketIdOffset(payloadSize);
+        }
+
+        /// @brief Whether there is no packet, because none was encoded or it was dropped with reset().
+        [[nodiscard]] bool isEmpty() const
+        {
+            return !m_bytes;
+        }
+
+        /**
+         * @brief Whether the connection would send these bytes: same protocol version and Message Expiry Interval.
+         * @param version Protocol version of the connection.
+         * @param messageExpiryInterval Interval the connection would send, which shrinks while the publish waits.
+         */
+        [[nodiscard]] bool matches(const ProtocolVersion version, const std::uint32_t messageExpiryInterval) const
+        {
+            return m_version == version && m_messageExpiryInterval == messageExpiryInterval;
+        }
+
+        /// @brief Wire size of the packet.
+        [[nodiscard]] size_t getSize() const
+        {
+            return m_size;
+        }
+
+        /**
+         * @brief Write the packet identifier into the packet.
+         * @param packetId Packet identifier; ignored for QoS 0.
+         * @return The packet, valid until the next call or reset().
+         */
+        [[nodiscard]] std::span<const std::byte> patchPacketId(const std::uint16_t packetId)
+        {
+            if (m_packetIdOffset != 0)
+            {
+                m_bytes[m_packetIdOffset] = static_cast<std::byte>(packetId >> 8);
+                m_bytes[m_packetIdOffset + 1] = static_cast<std::byte>(packetId & 0xFF);
+            }
+            return std::span<const std::byte>{ m_bytes.get(), m_size };
+        }
+
+        /// @brief Drop the packet, giving its bytes back to the memory resource.
+        void reset()
+        {
+            m_bytes.reset();
+            m_size = 0;
+        }
+
+    private:
+        /// Hands the bytes back to the resource they came from, which moves with them.
+        struct Deallocate
+        {
+            std::pmr::memory_resource* resource;
+            size_t size;
+
+            void operator()(std::byte* bytes) const
+            {
+                resource->deallocate(bytes, size, alignof(std::byte));
+            }
+        };
+
+        using Bytes = std::unique_ptr<std::byte[], Deallocate>;
+
+        Bytes m_bytes;
+        size_t m_size = 0;
+        size_t m_packetIdOffset = 0;
+        ProtocolVersion m_version = ProtocolVersion::V311;
+        std::uint32_t m_messageExpiryInterval = 0;
+    };
+} // namespace reactormq::mqtt::packets
@@ -5,11 +5,13 @@
 #pragma once
 
 #include "mqtt/packets/properties/property.h"
+#include "mqtt/packets/properties/property_list.h"
 #include "serialize/bytes.h"
 #include "serialize/mqtt_codec.h"
 #include "util/logging/logging.h"
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace reactormq::mqtt::packets::properties
@@ -28,6 +30,18 @@ namespace reactormq::mqtt::packets::properties
          * @param properties Vector of Property objects.
          */
         explicit Properties(std::vector<Property> properties)
+        {
+            for (Property& property : properties)
+            {
+                m_properties.add(std::move(property));
+            }
+        }
+
+        /**
+         * @brief Constructor from an inline property list, which avoids the vector allocation for a few properties.
+         * @param properties Property objects.
+         */
+        explicit Properties(PropertyList properties)
             : m_properties(std::move(properties))
         {
         }
@@ -48,20 +62,7 @@ namespace reactormq::mqtt::packets::properties
          */
         bool operator==(const Properties& other) const
         {
-            if (m_properties.size() != other.m_properties.size())
-            {
-                return false;
-            }
-
-            for (size_t i = 0; i < m_properties.size(); ++i)
-            {
-                if (m_properties[i] != other.m_properties[i])
-                {
-                    return false;
-                }
-            }
-
-            return true;
+            return m_properties == other.m_properties;
         }
 
         /**
@@ -110,7 +111,7 @@ namespace reactormq::mqtt::packets::properties
                     REACTORMQ_LOG(logging::LogLevel::Error, "Property length %u exceeds remaining length %u", propLength, remainingLength);
                     return;
                 }
-                m_properties.emplace_back(std::move(prop));
+                m_properties.add(std::move(prop));
                 remainingLength -= propLength;
             }
         }
@@ -145,16 +146,34 @@ namespace reactormq::mqtt::packets::properties
         }
 
         /**
-         * @brief Get the vector of properties.
-         * @return Vector of Property objects.
+         * @brief Get the properties.
+         * @return View of the Property objects, valid while this container is unchanged.
+         */
+        [[nodiscard]] std::span<const Property> getProperties() const
+        {
+            return m_properties.getSpan();
+        }
+
+        /**
+         * @brief Typed lookup of a property that appears at most once, e.g. TopicAlias or MessageExpiryInterval.
+         * @tparam TIdentifier Property to look for.
+         * @return Pointer to the value of the first such property, or nullptr if there is none.
          */
-        [[nodiscard]] std::vector<Property> getProperties() const
+        template<PropertyIdentifier TIdentifier>
+        [[nodiscard]] const property_value_type_t<TIdentifier>* find() const
         {
-            return m_properties;
+            for (const Property& property : m_properties)
+            {
+                if (property.getIdentifier() == TIdentifier)
+                {
+                    return property.getValueIf<property_value_type_t<TIdentifier>>();
+                }
+            }
+            return nullptr;
         }
 
     private:
-        std::vector<Property> m_properties;
+        PropertyList m_properties;
     };
 
     /**
@@ -189,6 +189,17 @@ namespace reactormq::mqtt::packets::properties
          */
         [[nodiscard]] uint32_t getLength() const;
 
+        /**
+         * @brief The value, without copying it.
+         * @tparam TValue One of the value types of property_value_type.
+         * @return Pointer to the value, or nullptr if the property holds another type.
+         */
+        template<typename TValue>
+        [[nodiscard]] const TValue* getValueIf() const
+        {
+            return std::get_if<TValue>(&m_data);
+        }
+
         /**
          * @brief Try to get the property value as uint8_t.
          */
@@ -0,0 +1,184 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/properties/property.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace reactormq::mqtt::packets::properties
+{
+    /**
+     * @brief Sequence of properties that keeps the first few inline.
+     * Most packets carry between zero and four properties, so decoding them needs no allocation for the container;
+     * a fifth property moves the whole list to the heap.
+     */
+    class PropertyList
+    {
+    public:
+        /// @brief Properties held without allocating.
+        static constexpr size_t kInlineCapacity = 4;
+
+        // User-provided so the inline storage is left uninitialised while const instances can still be declared.
+        PropertyList() noexcept
+        {
+        }
+
+        PropertyList(const PropertyList& other)
+        {
+            append(other.getSpan());
+        }
+
+        PropertyList(PropertyList&& other) noexcept
+        {
+            takeFrom(other);
+        }
+
+        PropertyList& operator=(const PropertyList& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                append(other.getSpan());
+            }
+            return *this;
+        }
+
+        PropertyList& operator=(PropertyList&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                takeFrom(other);
+            }
+            return *this;
+        }
+
+        ~PropertyList()
+        {
+            clear();
+        }
+
+        bool operator==(const PropertyList& other) const
+        {
+            return std::ranges::equal(getSpan(), other.getSpan());
+        }
+
+        /**
+         * @brief Append a property.
+         * @param property Property to append.
+         */
+        void add(Property property)
+        {
+            if (m_spilled.empty())
+            {
+                if (m_inlineSize < kInlineCapacity)
+                {
+                    std::construct_at(getInlineData() + m_inlineSize, std::move(property));
+                    ++m_inlineSize;
+                    return;
+                }
+
+                m_spilled.reserve(kInlineCapacity * 2);
+                for (Property& inlineProperty : std::span{ getInlineData(), m_inlineSize })
+                {
+                    m_spilled.push_back(std::move(inlineProperty));
+                }
+                destroyInline();
+            }
+            m_spilled.push_back(std::move(property));
+        }
+
+        /**
+         * @brief Append copies of several properties.
+         * @param properties Properties to append.
+         */
+        void append(const std::span<const Property> properties)
+        {
+            for (const Property& property : properties)
+            {
+                add(property);
+            }
+        }
+
+        /// @brief Remove every property; heap storage, if any, is kept for reuse.
+        void clear()
+        {
+            destroyInline();
+            m_spilled.clear();
+        }
+
+        /// @brief Number of properties.
+        [[nodiscard]] size_t size() const
+        {
+            return m_spilled.empty() ? m_inlineSize : m_spilled.size();
+        }
+
+        /// @brief Whether the list holds no property.
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// @brief The properties, contiguous whether they live inline or on the heap.
+        [[nodiscard]] std::span<const Property> getSpan() const
+        {
+            return { m_spilled.empty() ? getInlineData() : m_spilled.data(), size() };
+        }
+
+        [[nodiscard]] const Property* begin() const
+        {
+            return getSpan().data();
+        }
+
+        [[nodiscard]] const Property* end() const
+        {
+            return getSpan().data() + size();
+        }
+
+    private:
+        [[nodiscard]] Property* getInlineData()
+        {
+            return reinterpret_cast<Property*>(m_inline);
+        }
+
+        [[nodiscard]] const Property* getInlineData() const
+        {
+            return reinterpret_cast<const Property*>(m_inline);
+        }
+
+        void destroyInline()
+        {
+            std::destroy_n(getInlineData(), m_inlineSize);
+            m_inlineSize = 0;
+        }
+
+        void takeFrom(PropertyList& other)
+        {
+            if (!other.m_spilled.empty())
+            {
+                m_spilled = std::move(other.m_spilled);
+                other.m_spilled.clear();
+                return;
+            }
+
+            for (Property& property : std::span{ other.getInlineData(), other.m_inlineSize })
+            {
+                std::construct_at(getInlineData() + m_inlineSize, std::move(property));
+                ++m_inlineSize;
+            }
+            other.destroyInline();
+        }
+
+        alignas(Property) std::byte m_inline[kInlineCapacity * sizeof(Property)];
+        std::vector<Property> m_spilled;
+        std::uint8_t m_inlineSize = 0;
+    };
+} // namespace reactormq::mqtt::packets::properties
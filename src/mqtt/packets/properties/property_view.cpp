@@ -0,0 +1,152 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "property_view.h"
+
+#include "util/logging/logging.h"
+
+namespace reactormq::mqtt::packets::properties
+{
+    using namespace reactormq::serialize;
+
+    namespace
+    {
+        bool tryReadStringView(ByteReader& reader, std::span<const std::byte>& out)
+        {
+            std::string_view text;
+            if (!decodeStringView(reader, text))
+            {
+                return false;
+            }
+            out = std::as_bytes(std::span{ text });
+            return true;
+        }
+    } // namespace
+
+    bool PropertyView::tryDecode(ByteReader& reader, PropertyView& out)
+    {
+        std::uint8_t code = 0;
+        if (!reader.tryReadUint8(code) || !isValidPropertyIdentifier(code))
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "Invalid property identifier: %u", code);
+            return false;
+        }
+
+        out = PropertyView{};
+        out.m_identifier = static_cast<PropertyIdentifier>(code);
+
+        switch (out.m_identifier)
+        {
+            using enum PropertyIdentifier;
+        case PayloadFormatIndicator:
+        case RequestProblemInformation:
+        case RequestResponseInformation:
+        case MaximumQoS:
+        case RetainAvailable:
+        case WildcardSubscriptionAvailable:
+        case SubscriptionIdentifierAvailable:
+        case SharedSubscriptionAvailable:
+            {
+                std::uint8_t value = 0;
+                if (!reader.tryReadUint8(value))
+                {
+                    return false;
+                }
+                out.m_integer = value;
+                return true;
+            }
+
+        case ServerKeepAlive:
+        case ReceiveMaximum:
+        case TopicAliasMaximum:
+        case TopicAlias:
+            {
+                std::uint16_t value = 0;
+                if (!reader.tryReadUint16(value))
+                {
+                    return false;
+                }
+                out.m_integer = value;
+                return true;
+            }
+
+        case MessageExpiryInterval:
+        case SessionExpiryInterval:
+        case WillDelayInterval:
+        case MaximumPacketSize:
+            return reader.tryReadUint32(out.m_integer);
+
+        case SubscriptionIdentifier:
+            {
+                const size_t before = reader.getRemaining();
+                out.m_integer = decodeVariableByteInteger(reader);
+                return reader.getRemaining() != before;
+            }
+
+        case CorrelationData:
+        case AuthenticationData:
+            {
+                std::uint16_t length = 0;
+                return reader.tryReadUint16(length) && reader.tryReadView(length, out.m_first);
+            }
+
+        case ContentType:
+        case ResponseTopic:
+        case AssignedClientIdentifier:
+        case ResponseInformation:
+        case AuthenticationMethod:
+        case ServerReference:
+        case ReasonString:
+            return tryReadStringView(reader, out.m_first);
+
+        case UserProperty:
+            return tryReadStringView(reader, out.m_first) && tryReadStringView(reader, out.m_second);
+
+        case Max:
+        case Unknown:
+            break;
+        }
+        return false;
+    }
+
+    std::optional<PropertyView> PropertiesView::find(const PropertyIdentifier identifier) const
+    {
+        std::optional<PropertyView> found;
+        (void)forEach(
+            [identifier, &found](const PropertyView& property)
+            {
+                if (!found.has_value() && property.getIdentifier() == identifier)
+                {
+                    found = property;
+                }
+            });
+        return found;
+    }
+
+    std::uint16_t PropertiesView::getTopicAlias() const
+    {
+        const std::optional<PropertyView> property = find(PropertyIdentifier::TopicAlias);
+        return property.has_value() ? static_cast<std::uint16_t>(property->getInteger()) : 0;
+    }
+
+    std::optional<std::uint32_t> PropertiesView::getMessageExpiryInterval() const
+    {
+        const std::optional<PropertyView> property = find(PropertyIdentifier::MessageExpiryInterval);
+        return property.has_value() ? std::optional{ property->getInteger() } : std::nullopt;
+    }
+
+    std::optional<std::string_view> PropertiesView::findUserProperty(const std::string_view name) const
+    {
+        std::optional<std::string_view> found;
+        (void)forEach(
+            [name, &found](const PropertyView& property)
+            {
+                if (!found.has_value() && property.getIdentifier() == PropertyIdentifier::UserProperty && property.getString() == name)
+                {
+                    found = property.getUserPropertyValue();
+                }
+            });
+        return found;
+    }
+} // namespace reactormq::mqtt::packets::properties
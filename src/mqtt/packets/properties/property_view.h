@@ -0,0 +1,159 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/properties/property_identifier.h"
+#include "serialize/bytes.h"
+#include "serialize/mqtt_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace reactormq::mqtt::packets::properties
+{
+    /**
+     * @brief One property read in place: integers by value, strings and binary data as views into the packet bytes.
+     * Only valid while the buffer it was decoded from is.
+     */
+    class PropertyView
+    {
+    public:
+        PropertyView() = default;
+
+        /**
+         * @brief Decode one property, identifier included.
+         * @param reader Reader positioned at the identifier byte.
+         * @param out Decoded property (replaced on success).
+         * @return False if the identifier is unknown or the value is truncated or malformed.
+         */
+        static bool tryDecode(serialize::ByteReader& reader, PropertyView& out);
+
+        [[nodiscard]] PropertyIdentifier getIdentifier() const
+        {
+            return m_identifier;
+        }
+
+        /// @brief Value of a Byte, Two Byte Integer, Four Byte Integer or Variable Byte Integer property; 0 otherwise.
+        [[nodiscard]] std::uint32_t getInteger() const
+        {
+            return m_integer;
+        }
+
+        /// @brief Value of a UTF-8 string property, or the name of a User Property.
+        [[nodiscard]] std::string_view getString() const
+        {
+            return { reinterpret_cast<const char*>(m_first.data()), m_first.size() };
+        }
+
+        /// @brief Value of a User Property.
+        [[nodiscard]] std::string_view getUserPropertyValue() const
+        {
+            return { reinterpret_cast<const char*>(m_second.data()), m_second.size() };
+        }
+
+        /// @brief Value of a Binary Data property.
+        [[nodiscard]] std::span<const std::uint8_t> getBinary() const
+        {
+            return { reinterpret_cast<const std::uint8_t*>(m_first.data()), m_first.size() };
+        }
+
+    private:
+        std::span<const std::byte> m_first;
+        std::span<const std::byte> m_second;
+        std::uint32_t m_integer = 0;
+        PropertyIdentifier m_identifier = PropertyIdentifier::Unknown;
+    };
+
+    /**
+     * @brief Read-only, allocation-free access to a property block as it sits in a received packet.
+     * The counterpart of Properties for the receive path: nothing is copied, so it is only valid while the packet
+     * bytes are.
+     */
+    class PropertiesView
+    {
+    public:
+        PropertiesView() = default;
+
+        /**
+         * @brief View a raw property block.
+         * @param rawProperties The block as on the wire, Property Length prefix included; empty for no properties.
+         */
+        explicit PropertiesView(const std::span<const std::byte> rawProperties)
+            : m_raw(rawProperties)
+        {
+        }
+
+        /**
+         * @brief Call a visitor with each property, in wire order.
+         * @param visitor Callable taking a const PropertyView&.
+         * @return False if the block is malformed; properties before the fault have been visited.
+         */
+        template<typename TVisitor>
+        bool forEach(TVisitor&& visitor) const
+        {
+            if (m_raw.empty())
+            {
+                return true;
+            }
+
+            serialize::ByteReader reader(m_raw);
+            std::uint32_t remaining = serialize::decodeVariableByteInteger(reader);
+            if (reader.getRemaining() == m_raw.size() || remaining > reader.getRemaining())
+            {
+                return false;
+            }
+
+            while (remaining > 0)
+            {
+                const size_t before = reader.getRemaining();
+                PropertyView property;
+                if (!PropertyView::tryDecode(reader, property))
+                {
+                    return false;
+                }
+                const size_t consumed = before - reader.getRemaining();
+                if (consumed > remaining)
+                {
+                    return false;
+                }
+                remaining -= static_cast<std::uint32_t>(consumed);
+                visitor(property);
+            }
+            return true;
+        }
+
+        /**
+         * @brief First property with an identifier.
+         * @param identifier Property to look for.
+         * @return The property, or nullopt if absent or the block is malformed before it.
+         */
+        [[nodiscard]] std::optional<PropertyView> find(PropertyIdentifier identifier) const;
+
+        /// @brief Topic Alias, or 0 when absent.
+        [[nodiscard]] std::uint16_t getTopicAlias() const;
+
+        /// @brief Message Expiry Interval in seconds, or nullopt when absent.
+        [[nodiscard]] std::optional<std::uint32_t> getMessageExpiryInterval() const;
+
+        /**
+         * @brief Value of the first User Property with a name.
+         * @param name User Property name.
+         * @return The value, or nullopt when absent.
+         */
+        [[nodiscard]] std::optional<std::string_view> findUserProperty(std::string_view name) const;
+
+        /// @brief The raw block, Property Length prefix included.
+        [[nodiscard]] std::span<const std::byte> getRaw() const
+        {
+            return m_raw;
+        }
+
+    private:
+        std::span<const std::byte> m_raw;
+    };
+} // namespace reactormq::mqtt::packets::properties
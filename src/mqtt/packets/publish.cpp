@@ -4,6 +4,10 @@
 
 #include "publish.h"
 
+#include "reactormq/mqtt/payload_codec.h"
+
+#include <utility>
+
 namespace reactormq::mqtt::packets
 {
     using serialize::ByteReader;
@@ -95,6 +99,88 @@ namespace reactormq::mqtt::packets
         return m_payload;
     }
 
+    template<ProtocolVersion TProtocolVersion>
+    std::string Publish<TProtocolVersion>::takeTopicName()
+    {
+        return std::exchange(m_topicName, {});
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::vector<uint8_t> Publish<TProtocolVersion>::takePayload()
+    {
+        return std::exchange(m_payload, {});
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::uint16_t Publish<TProtocolVersion>::getTopicAlias() const
+    {
+        if constexpr (Traits::HasProperties)
+        {
+            if (const std::uint16_t* alias = m_properties.template find<properties::PropertyIdentifier::TopicAlias>())
+            {
+                return *alias;
+            }
+        }
+
+        return 0;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    SubscriptionIdentifiers Publish<TProtocolVersion>::getSubscriptionIdentifiers() const
+    {
+        SubscriptionIdentifiers identifiers;
+        if constexpr (Traits::HasProperties)
+        {
+            for (const auto& property : m_properties.getProperties())
+            {
+                if (const std::uint32_t* identifier = property.template getValueIf<std::uint32_t>();
+                    property.getIdentifier() == properties::PropertyIdentifier::SubscriptionIdentifier && identifier != nullptr)
+                {
+                    identifiers.add(*identifier);
+                }
+            }
+        }
+
+        return identifiers;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::string Publish<TProtocolVersion>::getPayloadCodec() const
+    {
+        if constexpr (Traits::HasProperties)
+        {
+            for (const auto& property : m_properties.getProperties())
+            {
+                if (const auto* userProperty = property.template getValueIf<std::pair<std::string, std::string>>();
+                    property.getIdentifier() == properties::PropertyIdentifier::UserProperty && userProperty != nullptr
+                    && userProperty->first == kPayloadCodecPropertyKey)
+                {
+                    return userProperty->second;
+                }
+            }
+        }
+
+        return {};
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::span<const std::uint8_t> Publish<TProtocolVersion>::getCorrelationData() const
+    {
+        if constexpr (Traits::HasProperties)
+        {
+            for (const auto& property : m_properties.getProperties())
+            {
+                if (const auto* data = property.template getValueIf<std::vector<uint8_t>>();
+                    property.getIdentifier() == properties::PropertyIdentifier::CorrelationData && data != nullptr)
+                {
+                    return *data;
+                }
+            }
+        }
+
+        return {};
+    }
+
     template<ProtocolVersion TProtocolVersion>
     const typename detail::PublishTraits<TProtocolVersion>::PropertiesType& Publish<TProtocolVersion>::getProperties() const
         requires(detail::PublishTraits<TProtocolVersion>::HasProperties)
@@ -152,9 +238,14 @@ namespace reactormq::mqtt::packets
     template<ProtocolVersion TProtocolVersion>
     void Publish<TProtocolVersion>::readPayload(ByteReader reader, const std::vector<uint8_t>::size_type payloadSize)
     {
-        m_payload.resize(payloadSize);
-        const auto dst = std::as_writable_bytes(std::span{ m_payload });
-        reader.readBytes(dst);
+        // Assign straight from the receive buffer; resize() would zero-fill the whole payload before the copy.
+        std::span<const std::byte> src;
+        if (!reader.tryReadView(payloadSize, src))
+        {
+            return;
+        }
+        const auto* first = reinterpret_cast<const uint8_t*>(src.data());
+        m_payload.assign(first, first + src.size());
     }
 
     template<ProtocolVersion TProtocolVersion>
@@ -183,6 +274,22 @@ namespace reactormq::mqtt::packets
         }
 
         this->getFixedHeader().encode(writer);
+        encodeVariableHeader(writer);
+        writer.writeBytes(reinterpret_cast<const std::byte*>(m_payload.data()), m_payload.size());
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    void Publish<TProtocolVersion>::encodeHeader(ByteWriter& writer, const uint32_t payloadSize) const
+    {
+        const QualityOfService qos = getQualityOfService();
+        const uint32_t remainingLength = getLength(static_cast<uint32_t>(m_topicName.length()), payloadSize, getPropertiesLength(), qos);
+        FixedHeader::create(this, remainingLength, getShouldRetain(), qos, getIsDuplicate()).encode(writer, payloadSize);
+        encodeVariableHeader(writer);
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    void Publish<TProtocolVersion>::encodeVariableHeader(ByteWriter& writer) const
+    {
         serialize::encodeString(m_topicName, writer);
 
         if (static_cast<uint8_t>(getQualityOfService()) > static_cast<uint8_t>(QualityOfService::AtMostOnce))
@@ -194,8 +301,6 @@ namespace reactormq::mqtt::packets
         {
             m_properties.encode(writer);
         }
-
-        writer.writeBytes(reinterpret_cast<const std::byte*>(m_payload.data()), m_payload.size());
     }
 
     template<ProtocolVersion TProtocolVersion>
@@ -222,14 +327,21 @@ namespace reactormq::mqtt::packets
         auto payloadSize = static_cast<int32_t>(this->getFixedHeader().getRemainingLength());
         payloadSize -= 2;
 
-        std::string topicName;
-        if (!serialize::decodeString(reader, topicName))
+        std::string_view topicName;
+        if (!serialize::decodeStringView(reader, topicName))
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "[Publish] Failed to decode topic name");
             return false;
         }
 
-        setTopicName(std::move(topicName));
+        // An empty topic is left to the alias lookup; wildcards only belong in subscriptions (MQTT 5 section 3.3.2.1).
+        if (topicName.find_first_of("+#") != std::string_view::npos)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "[Publish] Topic name contains a wildcard");
+            return false;
+        }
+
+        setTopicName(std::string{ topicName });
         payloadSize -= static_cast<int32_t>(m_topicName.length());
 
         if (static_cast<uint8_t>(getQualityOfService()) > static_cast<uint8_t>(QualityOfService::AtMostOnce))
@@ -299,6 +411,48 @@ namespace reactormq::mqtt::packets
         }
     }
 
+    template<ProtocolVersion V>
+    void encodePublishHeaderToWriter(
+        ByteWriter& writer,
+        const std::string& topic,
+        const uint32_t payloadSize,
+        QualityOfService qos,
+        bool shouldRetain,
+        std::uint16_t packetId,
+        bool isDuplicate,
+        const std::uint16_t topicAlias,
+        const std::string_view payloadCodec,
+        const std::uint32_t messageExpiryInterval)
+    {
+        using Traits = detail::PublishTraits<V>;
+        using PublishT = Publish<V>;
+
+        if constexpr (Traits::HasProperties)
+        {
+            properties::PropertyList props;
+            if (messageExpiryInterval != 0)
+            {
+                props.add(properties::Property::create<properties::PropertyIdentifier::MessageExpiryInterval>(messageExpiryInterval));
+            }
+            if (topicAlias != 0)
+            {
+                props.add(properties::Property::create<properties::PropertyIdentifier::TopicAlias>(topicAlias));
+            }
+            if (!payloadCodec.empty())
+            {
+                props.add(properties::Property::create<properties::PropertyIdentifier::UserProperty>(
+                    std::pair<std::string, std::string>{ kPayloadCodecPropertyKey, payloadCodec }));
+            }
+            PublishT publishPacket(topic, {}, qos, shouldRetain, packetId, properties::Properties{ std::move(props) }, isDuplicate);
+            publishPacket.encodeHeader(writer, payloadSize);
+        }
+        else
+        {
+            PublishT publishPacket(topic, {}, qos, shouldRetain, packetId, isDuplicate);
+            publishPacket.encodeHeader(writer, payloadSize);
+        }
+    }
+
     template class Publish<ProtocolVersion::V311>;
     template class Publish<ProtocolVersion::V5>;
 
@@ -307,4 +461,28 @@ namespace reactormq::mqtt::packets
 
     template void encodePublishToWriter<ProtocolVersion::V5>(
         ByteWriter&, const std::string&, const std::vector<uint8_t>&, QualityOfService, bool, std::uint16_t, bool);
-} // namespace reactormq::mqtt::packets
\ No newline at end of file
+
+    template void encodePublishHeaderToWriter<ProtocolVersion::V311>(
+        ByteWriter&,
+        const std::string&,
+        uint32_t,
+        QualityOfService,
+        bool,
+        std::uint16_t,
+        bool,
+        std::uint16_t,
+        std::string_view,
+        std::uint32_t);
+
+    template void encodePublishHeaderToWriter<ProtocolVersion::V5>(
+        ByteWriter&,
+        const std::string&,
+        uint32_t,
+        QualityOfService,
+        bool,
+        std::uint16_t,
+        bool,
+        std::uint16_t,
+        std::string_view,
+        std::uint32_t);
+} // namespace reactormq::mqtt::packets
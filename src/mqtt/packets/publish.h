@@ -7,13 +7,16 @@
 #include "mqtt/packets/fixed_header.h"
 #include "mqtt/packets/interface/control_packet_base.h"
 #include "mqtt/packets/properties/properties.h"
+#include "mqtt/packets/subscription_identifiers.h"
 #include "reactormq/mqtt/protocol_version.h"
 #include "reactormq/mqtt/quality_of_service.h"
 #include "serialize/bytes.h"
 #include "util/logging/logging.h"
 
 #include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace reactormq::mqtt::packets
@@ -83,6 +86,42 @@ namespace reactormq::mqtt::packets
          * @return The payload.
          */
         [[nodiscard]] virtual const std::vector<uint8_t>& getPayload() const = 0;
+
+        /**
+         * @brief Move the topic name out of the packet, leaving it empty.
+         * @return The topic name.
+         */
+        [[nodiscard]] virtual std::string takeTopicName() = 0;
+
+        /**
+         * @brief Move the payload out of the packet, leaving it empty.
+         * @return The payload.
+         */
+        [[nodiscard]] virtual std::vector<uint8_t> takePayload() = 0;
+
+        /**
+         * @brief Get the MQTT 5 Topic Alias property.
+         * @return The topic alias, or 0 when the packet carries none (always 0 for MQTT 3.1.1).
+         */
+        [[nodiscard]] virtual std::uint16_t getTopicAlias() const = 0;
+
+        /**
+         * @brief Get the MQTT 5 Subscription Identifier properties.
+         * @return The identifiers; none for MQTT 3.1.1.
+         */
+        [[nodiscard]] virtual SubscriptionIdentifiers getSubscriptionIdentifiers() const = 0;
+
+        /**
+         * @brief Get the value of the "payload-codec" User Property naming the codec the payload is encoded with.
+         * @return The codec name, or empty for a plain payload (always empty for MQTT 3.1.1).
+         */
+        [[nodiscard]] virtual std::string getPayloadCodec() const = 0;
+
+        /**
+         * @brief Get the MQTT 5 Correlation Data property.
+         * @return The data, or empty when the packet carries none (always empty for MQTT 3.1.1).
+         */
+        [[nodiscard]] virtual std::span<const std::uint8_t> getCorrelationData() const = 0;
     };
 
     /**
@@ -180,6 +219,26 @@ namespace reactormq::mqtt::packets
          */
         [[nodiscard]] const std::vector<uint8_t>& getPayload() const override;
 
+        /**
+         * @brief Move the topic name out of the packet, leaving it empty.
+         * @return The topic name.
+         */
+        [[nodiscard]] std::string takeTopicName() override;
+
+        /**
+         * @brief Move the payload out of the packet, leaving it empty.
+         * @return The payload.
+         */
+        [[nodiscard]] std::vector<uint8_t> takePayload() override;
+
+        [[nodiscard]] std::uint16_t getTopicAlias() const override;
+
+        [[nodiscard]] SubscriptionIdentifiers getSubscriptionIdentifiers() const override;
+
+        [[nodiscard]] std::string getPayloadCodec() const override;
+
+        [[nodiscard]] std::span<const std::uint8_t> getCorrelationData() const override;
+
         /**
          * @brief Get the properties for MQTT 5 PUBLISH packets.
          * @return The properties.
@@ -199,6 +258,14 @@ namespace reactormq::mqtt::packets
          */
         void encode(serialize::ByteWriter& writer) const override;
 
+        /**
+         * @brief Encode everything that precedes the payload: fixed header, topic, packet identifier and properties.
+         * The Remaining Length is sized for payloadSize bytes that the caller writes after the header itself.
+         * @param writer ByteWriter to write to.
+         * @param payloadSize Number of payload bytes that will follow the header.
+         */
+        void encodeHeader(serialize::ByteWriter& writer, uint32_t payloadSize) const;
+
         /**
          * @brief Decode the packet from a ByteReader.
          * @param reader ByteReader to read from.
@@ -223,6 +290,8 @@ namespace reactormq::mqtt::packets
         }
 
     private:
+        void encodeVariableHeader(serialize::ByteWriter& writer) const;
+
         void setPayload(std::vector<uint8_t>&& payload);
 
         void setPacketId(uint16_t packetId);
@@ -265,6 +334,36 @@ namespace reactormq::mqtt::packets
         std::uint16_t packetId,
         bool isDuplicate);
 
+    /**
+     * @brief Encode the header of a PUBLISH packet (everything except the payload) to the writer.
+     * Lets callers send the payload straight from its own storage instead of copying it into the packet buffer.
+     * @tparam V Protocol version.
+     * @param writer Writer to encode to.
+     * @param topic Topic name.
+     * @param payloadSize Size of the payload that will follow the header.
+     * @param qos Quality of Service.
+     * @param shouldRetain Retain flag.
+     * @param packetId Packet identifier.
+     * @param isDuplicate Duplicate flag.
+     * @param topicAlias MQTT 5 Topic Alias property to send, or 0 for none; @p topic may be empty when it is set.
+     * Ignored for MQTT 3.1.1.
+     * @param payloadCodec MQTT 5 name of the codec the payload was encoded with, sent as the "payload-codec" User
+     * Property; empty for a plain payload. Ignored for MQTT 3.1.1.
+     * @param messageExpiryInterval MQTT 5 Message Expiry Interval in seconds, or 0 for none. Ignored for MQTT 3.1.1.
+     */
+    template<ProtocolVersion V>
+    void encodePublishHeaderToWriter(
+        serialize::ByteWriter& writer,
+        const std::string& topic,
+        uint32_t payloadSize,
+        QualityOfService qos,
+        bool shouldRetain,
+        std::uint16_t packetId,
+        bool isDuplicate,
+        std::uint16_t topicAlias = 0,
+        std::string_view payloadCodec = {},
+        std::uint32_t messageExpiryInterval = 0);
+
     /**
      * @brief Alias for MQTT 3.1.1 PUBLISH packet.
      */
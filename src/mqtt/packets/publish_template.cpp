@@ -0,0 +1,119 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "publish_template.h"
+
+#include "mqtt/packets/publish.h"
+#include "serialize/mqtt_codec.h"
+
+#include <span>
+
+namespace reactormq::mqtt::packets
+{
+    using serialize::ByteWriter;
+
+    namespace
+    {
+        constexpr std::byte kDupBit{ 0x08 };
+
+        constexpr bool hasPacketId(const QualityOfService qos)
+        {
+            return qos != QualityOfService::AtMostOnce;
+        }
+    } // namespace
+
+    template<ProtocolVersion V>
+    PublishTemplate PublishTemplate::create(
+        const std::string& topic,
+        const QualityOfService qos,
+        const bool shouldRetain,
+        const std::uint16_t topicAlias,
+        const std::string_view payloadCodec,
+        const std::uint32_t messageExpiryInterval)
+    {
+        // Encode a whole header once and keep what lies around the Remaining Length and the packet identifier.
+        std::vector<std::byte> header;
+        ByteWriter writer(header);
+        encodePublishHeaderToWriter<V>(writer, topic, 0, qos, shouldRetain, 0, false, topicAlias, payloadCodec, messageExpiryInterval);
+
+        PublishTemplate result;
+        if (header.empty())
+        {
+            return result;
+        }
+
+        std::uint32_t remainingLength = 0;
+        size_t remainingLengthSize = 0;
+        const std::span<const std::uint8_t> afterFirstByte{ reinterpret_cast<const std::uint8_t*>(header.data()) + 1, header.size() - 1 };
+        if (serialize::scanVariableByteInteger(afterFirstByte, remainingLength, remainingLengthSize)
+            != serialize::VariableByteIntegerStatus::Complete)
+        {
+            return result;
+        }
+
+        const size_t variableHeaderStart = 1 + remainingLengthSize;
+        const size_t topicEnd = variableHeaderStart + 2 + topic.size();
+        const size_t propertiesStart = topicEnd + (hasPacketId(qos) ? 2 : 0);
+        if (propertiesStart > header.size())
+        {
+            return result;
+        }
+
+        result.m_firstByte = header.front();
+        result.m_invariant.reserve(header.size() - variableHeaderStart);
+        result.m_invariant.insert(result.m_invariant.end(), header.begin() + variableHeaderStart, header.begin() + topicEnd);
+        result.m_invariant.insert(result.m_invariant.end(), header.begin() + propertiesStart, header.end());
+        result.m_topicSize = topicEnd - variableHeaderStart;
+        result.m_payloadCodec = payloadCodec;
+        result.m_version = V;
+        result.m_qualityOfService = qos;
+        result.m_topicAlias = topicAlias;
+        result.m_messageExpiryInterval = messageExpiryInterval;
+        result.m_shouldRetain = shouldRetain;
+        result.m_isValid = true;
+        return result;
+    }
+
+    std::uint32_t PublishTemplate::getRemainingLength(const std::uint32_t payloadSize) const
+    {
+        return static_cast<std::uint32_t>(m_invariant.size()) + (hasPacketId(m_qualityOfService) ? 2u : 0u) + payloadSize;
+    }
+
+    size_t PublishTemplate::getHeaderSize(const std::uint32_t payloadSize) const
+    {
+        const std::uint32_t remainingLength = getRemainingLength(payloadSize);
+        return 1 + serialize::variableByteIntegerSize(remainingLength) + remainingLength - payloadSize;
+    }
+
+    size_t PublishTemplate::getPacketIdOffset(const std::uint32_t payloadSize) const
+    {
+        if (!hasPacketId(m_qualityOfService))
+        {
+            return 0;
+        }
+        return 1 + serialize::variableByteIntegerSize(getRemainingLength(payloadSize)) + m_topicSize;
+    }
+
+    void PublishTemplate::encodeHeader(
+        const ByteWriter& writer,
+        const std::uint16_t packetId,
+        const std::uint32_t payloadSize,
+        const bool isDuplicate) const
+    {
+        writer.writeUint8(std::to_integer<std::uint8_t>(isDuplicate ? m_firstByte | kDupBit : m_firstByte));
+        serialize::encodeVariableByteInteger(getRemainingLength(payloadSize), writer);
+        writer.writeBytes(m_invariant.data(), m_topicSize);
+        if (hasPacketId(m_qualityOfService))
+        {
+            writer.writeUint16(packetId);
+        }
+        writer.writeBytes(m_invariant.data() + m_topicSize, m_invariant.size() - m_topicSize);
+    }
+
+    template PublishTemplate PublishTemplate::create<ProtocolVersion::V311>(
+        const std::string&, QualityOfService, bool, std::uint16_t, std::string_view, std::uint32_t);
+
+    template PublishTemplate PublishTemplate::create<ProtocolVersion::V5>(
+        const std::string&, QualityOfService, bool, std::uint16_t, std::string_view, std::uint32_t);
+} // namespace reactormq::mqtt::packets
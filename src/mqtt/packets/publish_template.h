@@ -0,0 +1,129 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/protocol_version.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief PUBLISH header with everything that does not change between messages encoded once.
+     *
+     * The topic, its length prefix and the property block are kept as wire bytes, so a stream publishing to one topic
+     * with one QoS and retain flag only writes the first byte, the Remaining Length and the packet identifier per
+     * message; the payload follows from its own storage. The bytes come from encodePublishHeaderToWriter(), so a
+     * templated header is identical to one encoded from scratch.
+     */
+    class PublishTemplate final
+    {
+    public:
+        PublishTemplate() = default;
+
+        /**
+         * @brief Encode the invariant parts of a PUBLISH header.
+         * @tparam V Protocol version.
+         * @param topic Topic name as sent; empty when a known Topic Alias stands in for it.
+         * @param qos Quality of Service.
+         * @param shouldRetain Retain flag.
+         * @param topicAlias MQTT 5 Topic Alias property to send, or 0 for none. Ignored for MQTT 3.1.1.
+         * @param payloadCodec MQTT 5 payload codec name, or empty. Ignored for MQTT 3.1.1.
+         * @param messageExpiryInterval MQTT 5 Message Expiry Interval in seconds, or 0 for none. Ignored for MQTT 3.1.1.
+         * @return The template.
+         */
+        template<ProtocolVersion V>
+        [[nodiscard]] static PublishTemplate create(
+            const std::string& topic,
+            QualityOfService qos,
+            bool shouldRetain,
+            std::uint16_t topicAlias = 0,
+            std::string_view payloadCodec = {},
+            std::uint32_t messageExpiryInterval = 0);
+
+        /// @brief Whether this template encodes headers for these settings; arguments as for create().
+        [[nodiscard]] bool matches(
+            const ProtocolVersion version,
+            const std::string_view topic,
+            const QualityOfService qos,
+            const bool shouldRetain,
+            const std::uint16_t topicAlias,
+            const std::string_view payloadCodec,
+            const std::uint32_t messageExpiryInterval = 0) const
+        {
+            return m_isValid && m_version == version && m_qualityOfService == qos && m_shouldRetain == shouldRetain
+                && m_topicAlias == topicAlias && m_messageExpiryInterval == messageExpiryInterval && m_payloadCodec == payloadCodec
+                && getTopic() == topic;
+        }
+
+        /**
+         * @brief Wire size of a header encoded from this template.
+         * @param payloadSize Size of the payload that will follow the header.
+         * @return Header size in bytes.
+         */
+        [[nodiscard]] size_t getHeaderSize(std::uint32_t payloadSize) const;
+
+        /**
+         * @brief Remaining Length of a packet encoded from this template.
+         * @param payloadSize Size of the payload that will follow the header.
+         * @return Remaining Length in bytes.
+         */
+        [[nodiscard]] std::uint32_t getRemainingLength(std::uint32_t payloadSize) const;
+
+        /**
+         * @brief Encode a header, patching in the per-message fields.
+         * @param writer Writer to encode to.
+         * @param packetId Packet identifier; ignored for QoS 0.
+         * @param payloadSize Size of the payload that will follow the header.
+         * @param isDuplicate Duplicate flag.
+         */
+        void encodeHeader(const serialize::ByteWriter& writer, std::uint16_t packetId, std::uint32_t payloadSize, bool isDuplicate) const;
+
+        /**
+         * @brief Offset of the packet identifier in a header encoded from this template.
+         * @param payloadSize Size of the payload that will follow the header.
+         * @return Offset in bytes, or 0 for QoS 0, which has no packet identifier.
+         */
+        [[nodiscard]] size_t getPacketIdOffset(std::uint32_t payloadSize) const;
+
+        /// @brief Protocol version the template encodes for.
+        [[nodiscard]] ProtocolVersion getVersion() const
+        {
+            return m_version;
+        }
+
+        /// @brief MQTT 5 Message Expiry Interval the template encodes, or 0 for none.
+        [[nodiscard]] std::uint32_t getMessageExpiryInterval() const
+        {
+            return m_messageExpiryInterval;
+        }
+
+    private:
+        /// @brief The topic as encoded, without its length prefix.
+        [[nodiscard]] std::string_view getTopic() const
+        {
+            return m_topicSize < 2 ? std::string_view{}
+                                   : std::string_view{ reinterpret_cast<const char*>(m_invariant.data()) + 2, m_topicSize - 2 };
+        }
+
+        /// Topic (with its length prefix) followed by the property block; the packet identifier goes between them.
+        std::vector<std::byte> m_invariant;
+        size_t m_topicSize = 0;
+        std::string m_payloadCodec;
+        std::byte m_firstByte{};
+        ProtocolVersion m_version = ProtocolVersion::V311;
+        QualityOfService m_qualityOfService = QualityOfService::AtMostOnce;
+        std::uint32_t m_messageExpiryInterval = 0;
+        std::uint16_t m_topicAlias = 0;
+        bool m_shouldRetain = false;
+        bool m_isValid = false;
+    };
+} // namespace reactormq::mqtt::packets
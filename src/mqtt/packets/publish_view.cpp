@@ -0,0 +1,196 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "publish_view.h"
+
+#include "mqtt/packets/properties/property_view.h"
+#include "reactormq/mqtt/payload_codec.h"
+#include "serialize/mqtt_codec.h"
+#include "util/logging/logging.h"
+
+namespace reactormq::mqtt::packets
+{
+    using serialize::ByteReader;
+    using serialize::ByteWriter;
+
+    template<ProtocolVersion TProtocolVersion>
+    PublishView<TProtocolVersion>::PublishView(ByteReader& reader, const FixedHeader& fixedHeader)
+        : IPublishView(fixedHeader)
+    {
+        this->setIsValid(decode(reader));
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    bool PublishView<TProtocolVersion>::getIsDuplicate() const
+    {
+        const auto flags = static_cast<std::byte>(this->getFixedHeader().getFlags());
+        return getQualityOfService() != QualityOfService::AtMostOnce && (flags & kDupBit) == kDupBit;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    bool PublishView<TProtocolVersion>::getShouldRetain() const
+    {
+        const auto flags = static_cast<std::byte>(this->getFixedHeader().getFlags());
+        return (flags & kRetainBit) == kRetainBit;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    QualityOfService PublishView<TProtocolVersion>::getQualityOfService() const
+    {
+        const auto flags = static_cast<std::byte>(this->getFixedHeader().getFlags());
+        const auto qosBits = (flags >> kQosShift) & kQosMask;
+        return static_cast<QualityOfService>(std::to_integer<uint8_t>(qosBits));
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::string_view PublishView<TProtocolVersion>::getTopicName() const
+    {
+        return m_topicName;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::span<const std::uint8_t> PublishView<TProtocolVersion>::getPayload() const
+    {
+        return { reinterpret_cast<const std::uint8_t*>(m_payload.data()), m_payload.size() };
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    uint16_t PublishView<TProtocolVersion>::getPacketId() const
+    {
+        return m_packetIdentifier;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::uint16_t PublishView<TProtocolVersion>::getTopicAlias() const
+    {
+        return properties::PropertiesView(m_rawProperties).getTopicAlias();
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    SubscriptionIdentifiers PublishView<TProtocolVersion>::getSubscriptionIdentifiers() const
+    {
+        SubscriptionIdentifiers identifiers;
+        (void)properties::PropertiesView(m_rawProperties)
+            .forEach(
+                [&identifiers](const properties::PropertyView& property)
+                {
+                    if (property.getIdentifier() == properties::PropertyIdentifier::SubscriptionIdentifier)
+                    {
+                        identifiers.add(property.getInteger());
+                    }
+                });
+        return identifiers;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::string_view PublishView<TProtocolVersion>::getPayloadCodec() const
+    {
+        return properties::PropertiesView(m_rawProperties).findUserProperty(kPayloadCodecPropertyKey).value_or(std::string_view{});
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    std::span<const std::byte> PublishView<TProtocolVersion>::getRawProperties() const
+    {
+        return m_rawProperties;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    uint32_t PublishView<TProtocolVersion>::getLength() const
+    {
+        uint32_t length = kStringLengthFieldSize + static_cast<uint32_t>(m_topicName.size()) + static_cast<uint32_t>(m_rawProperties.size())
+            + static_cast<uint32_t>(m_payload.size());
+
+        if (getQualityOfService() != QualityOfService::AtMostOnce)
+        {
+            length += sizeof(uint16_t);
+        }
+
+        return length;
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    void PublishView<TProtocolVersion>::encode(ByteWriter& writer) const
+    {
+        this->getFixedHeader().encode(writer);
+        serialize::encodeString(m_topicName, writer);
+
+        if (getQualityOfService() != QualityOfService::AtMostOnce)
+        {
+            writer.writeUint16(m_packetIdentifier);
+        }
+
+        writer.writeBytes(m_rawProperties.data(), m_rawProperties.size());
+        writer.writeBytes(m_payload.data(), m_payload.size());
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    bool PublishView<TProtocolVersion>::decode(ByteReader& reader)
+    {
+        if (this->getFixedHeader().getPacketType() != PacketType::Publish)
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "[PublishView] Invalid packet type: expected Publish, got %s",
+                packetTypeToString(this->getFixedHeader().getPacketType()));
+            return false;
+        }
+
+        const size_t remainingLength = this->getFixedHeader().getRemainingLength();
+        if (remainingLength > reader.getRemaining())
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "[PublishView] Not enough data for packet (need %zu, have %zu)",
+                remainingLength,
+                reader.getRemaining());
+            return false;
+        }
+
+        const size_t bodyStart = reader.getRemaining();
+
+        if (!serialize::decodeStringView(reader, m_topicName))
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "[PublishView] Failed to decode topic name");
+            return false;
+        }
+
+        // An empty topic is left to the alias lookup; wildcards only belong in subscriptions (MQTT 5 section 3.3.2.1).
+        if (m_topicName.find_first_of("+#") != std::string_view::npos)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "[PublishView] Topic name contains a wildcard");
+            return false;
+        }
+
+        if (getQualityOfService() != QualityOfService::AtMostOnce && !reader.tryReadUint16(m_packetIdentifier))
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "[PublishView] Failed to read packet identifier");
+            return false;
+        }
+
+        if constexpr (TProtocolVersion == ProtocolVersion::V5)
+        {
+            const size_t propertiesStart = reader.getRemaining();
+            ByteReader lengthReader = reader;
+            const uint32_t propertiesLength = serialize::decodeVariableByteInteger(lengthReader);
+            const size_t lengthFieldSize = propertiesStart - lengthReader.getRemaining();
+            if (lengthFieldSize == 0 || !reader.tryReadView(lengthFieldSize + propertiesLength, m_rawProperties))
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "[PublishView] Failed to read properties");
+                return false;
+            }
+        }
+
+        const size_t headerSize = bodyStart - reader.getRemaining();
+        if (headerSize > remainingLength)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "[PublishView] Invalid payload size: header exceeds remaining length");
+            return false;
+        }
+
+        return reader.tryReadView(remainingLength - headerSize, m_payload);
+    }
+
+    template class PublishView<ProtocolVersion::V311>;
+    template class PublishView<ProtocolVersion::V5>;
+} // namespace reactormq::mqtt::packets
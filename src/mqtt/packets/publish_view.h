@@ -0,0 +1,165 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "mqtt/packets/fixed_header.h"
+#include "mqtt/packets/interface/control_packet_base.h"
+#include "mqtt/packets/subscription_identifiers.h"
+#include "reactormq/mqtt/protocol_version.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief Interface for non-owning MQTT PUBLISH packets.
+     */
+    class IPublishView : public TControlPacket<PacketType::Publish>
+    {
+    public:
+        IPublishView() = default;
+
+        using TControlPacket::TControlPacket;
+
+        /**
+         * @brief Get the is duplicate flag.
+         * @return The is duplicate flag.
+         */
+        [[nodiscard]] virtual bool getIsDuplicate() const = 0;
+
+        /**
+         * @brief Get the should retain flag.
+         * @return The should retain flag.
+         */
+        [[nodiscard]] virtual bool getShouldRetain() const = 0;
+
+        /**
+         * @brief Get the quality of service.
+         * @return The quality of service.
+         */
+        [[nodiscard]] virtual QualityOfService getQualityOfService() const = 0;
+
+        /**
+         * @brief Get the topic name.
+         * @return View into the decoded buffer.
+         */
+        [[nodiscard]] virtual std::string_view getTopicName() const = 0;
+
+        /**
+         * @brief Get the payload.
+         * @return View into the decoded buffer.
+         */
+        [[nodiscard]] virtual std::span<const std::uint8_t> getPayload() const = 0;
+
+        /**
+         * @brief Get the MQTT 5 Topic Alias property.
+         * @return The topic alias, or 0 when the packet carries none (always 0 for MQTT 3.1.1).
+         */
+        [[nodiscard]] virtual std::uint16_t getTopicAlias() const = 0;
+
+        /**
+         * @brief Get the MQTT 5 Subscription Identifier properties.
+         * @return The identifiers; none for MQTT 3.1.1.
+         */
+        [[nodiscard]] virtual SubscriptionIdentifiers getSubscriptionIdentifiers() const = 0;
+
+        /**
+         * @brief Get the value of the "payload-codec" User Property naming the codec the payload is encoded with.
+         * @return The codec name, or empty for a plain payload (always empty for MQTT 3.1.1).
+         */
+        [[nodiscard]] virtual std::string_view getPayloadCodec() const = 0;
+
+        /**
+         * @brief Raw MQTT 5 property block including its length prefix; empty for MQTT 3.1.1.
+         * @return View into the decoded buffer.
+         */
+        [[nodiscard]] virtual std::span<const std::byte> getRawProperties() const = 0;
+    };
+
+    /**
+     * @brief MQTT PUBLISH packet whose topic and payload are views into the buffer it was decoded from.
+     *
+     * Decode-only counterpart of Publish<V> for the inbound path: nothing is copied, so the packet must not outlive
+     * the receive buffer. MQTT 5 properties are kept as their raw encoded bytes; each getter that needs one walks the
+     * block in place, so a message nobody asks about is never parsed.
+     */
+    template<ProtocolVersion TProtocolVersion>
+    class PublishView final : public IPublishView
+    {
+    public:
+        /**
+         * @brief Constructor for deserialization.
+         * @param reader Reader for deserialization; its buffer must outlive the packet.
+         * @param fixedHeader The fixed header.
+         */
+        explicit PublishView(serialize::ByteReader& reader, const FixedHeader& fixedHeader);
+
+        [[nodiscard]] bool getIsDuplicate() const override;
+
+        [[nodiscard]] bool getShouldRetain() const override;
+
+        [[nodiscard]] QualityOfService getQualityOfService() const override;
+
+        [[nodiscard]] std::string_view getTopicName() const override;
+
+        [[nodiscard]] std::span<const std::uint8_t> getPayload() const override;
+
+        [[nodiscard]] uint16_t getPacketId() const override;
+
+        [[nodiscard]] std::uint16_t getTopicAlias() const override;
+
+        [[nodiscard]] SubscriptionIdentifiers getSubscriptionIdentifiers() const override;
+
+        [[nodiscard]] std::string_view getPayloadCodec() const override;
+
+        [[nodiscard]] std::span<const std::byte> getRawProperties() const override;
+
+        /**
+         * @brief Get the length of the packet payload (remaining length).
+         * @return The length in bytes.
+         */
+        [[nodiscard]] uint32_t getLength() const override;
+
+        /**
+         * @brief Encode the packet to a ByteWriter, byte for byte as it was received.
+         * @param writer ByteWriter to write to.
+         */
+        void encode(serialize::ByteWriter& writer) const override;
+
+        /**
+         * @brief Decode the packet from a ByteReader without copying topic or payload.
+         * @param reader ByteReader to read from.
+         * @return true on success, false on failure.
+         */
+        bool decode(serialize::ByteReader& reader) override;
+
+    private:
+        std::string_view m_topicName;
+        uint16_t m_packetIdentifier{};
+        std::span<const std::byte> m_rawProperties;
+        std::span<const std::byte> m_payload;
+
+        static constexpr std::byte kRetainBit{ std::byte{ 0x1 } << 0 };
+        static constexpr std::byte kDupBit{ std::byte{ 0x1 } << 3 };
+        static constexpr std::byte kQosMask{ std::byte{ 0x3 } };
+        static constexpr int kQosShift{ 1 };
+    };
+
+    /**
+     * @brief Alias for MQTT 3.1.1 PUBLISH view.
+     */
+    using PublishView3 = PublishView<ProtocolVersion::V311>;
+
+    /**
+     * @brief Alias for MQTT 5 PUBLISH view.
+     */
+    using PublishView5 = PublishView<ProtocolVersion::V5>;
+} // namespace reactormq::mqtt::packets
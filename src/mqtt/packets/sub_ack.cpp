@@ -129,16 +129,17 @@ namespace reactormq::mqtt::packets
             remainingLength -= (varIntSize + propsLen);
         }
 
-        while (remainingLength > 0)
+        std::span<const std::byte> codes;
+        if (!reader.tryReadView(remainingLength, codes))
         {
-            uint8_t codeByte = 0;
-            if (!reader.tryReadUint8(codeByte))
-            {
-                REACTORMQ_LOG(logging::LogLevel::Error, "Failed to read return code");
-                return false;
-            }
-            m_reasonCodes.push_back(static_cast<ReasonCodeType>(codeByte));
-            --remainingLength;
+            REACTORMQ_LOG(logging::LogLevel::Error, "Failed to read return code");
+            return false;
+        }
+
+        m_reasonCodes.reserve(codes.size());
+        for (const std::byte code : codes)
+        {
+            m_reasonCodes.push_back(static_cast<ReasonCodeType>(code));
         }
 
         return true;
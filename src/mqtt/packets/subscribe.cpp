@@ -55,24 +55,35 @@ namespace reactormq::mqtt::packets
     template<ProtocolVersion TProtocolVersion>
     uint32_t Subscribe<TProtocolVersion>::getLength() const
     {
-        uint32_t length = 2; // Packet ID
-
-        if constexpr (Traits::HasProperties)
+        uint32_t length = getBaseLength(m_properties);
+        for (const auto& topicFilter : m_topicFilters)
         {
-            length += m_properties.getLength(true);
+            length += getEntryLength(topicFilter);
         }
+        return length;
+    }
 
-        for (const auto& topicFilter : m_topicFilters)
+    template<ProtocolVersion TProtocolVersion>
+    uint32_t Subscribe<TProtocolVersion>::getBaseLength(const PropertiesStorage& properties)
+    {
+        uint32_t length = 2; // Packet ID
+
+        if constexpr (Traits::HasProperties)
         {
-            length += kStringLengthFieldSize;
-            length += static_cast<uint32_t>(topicFilter.getFilter().length());
-            length += 1; // QoS or Options byte (always 1 byte)
+            length += properties.getLength(true);
         }
         return length;
     }
 
     template<ProtocolVersion TProtocolVersion>
     void Subscribe<TProtocolVersion>::encode(ByteWriter& writer) const
+    {
+        encodeTo(writer, m_topicFilters, m_packetIdentifier, m_properties);
+    }
+
+    template<ProtocolVersion TProtocolVersion>
+    void Subscribe<TProtocolVersion>::encodeTo(
+        ByteWriter& writer, const std::span<const TopicFilter> topicFilters, const uint16_t packetId, const PropertiesStorage& properties)
     {
         if constexpr (TProtocolVersion == ProtocolVersion::V5)
         {
@@ -83,15 +94,20 @@ namespace reactormq::mqtt::packets
             REACTORMQ_LOG(logging::LogLevel::Trace, "[Encode][Subscribe] MQTT 3.1.1");
         }
 
-        this->getFixedHeader().encode(writer);
-        writer.writeUint16(m_packetIdentifier);
+        uint32_t remainingLength = getBaseLength(properties);
+        for (const auto& topicFilter : topicFilters)
+        {
+            remainingLength += getEntryLength(topicFilter);
+        }
+        FixedHeader::create(kTypeAndFlags, remainingLength).encode(writer);
+        writer.writeUint16(packetId);
 
         if constexpr (Traits::HasProperties)
         {
-            m_properties.encode(writer);
+            properties.encode(writer);
         }
 
-        for (const auto& topicFilter : m_topicFilters)
+        for (const auto& topicFilter : topicFilters)
         {
             serialize::encodeString(topicFilter.getFilter(), writer);
 
@@ -144,8 +160,9 @@ namespace reactormq::mqtt::packets
 
         while (reader.getRemaining() > 0)
         {
-            std::string topicFilterStr;
-            if (!serialize::decodeString(reader, topicFilterStr))
+            // Viewed in place; TopicFilter copies it only once the options byte has been validated.
+            std::string_view topicFilterStr;
+            if (!serialize::decodeStringView(reader, topicFilterStr))
             {
                 REACTORMQ_LOG(logging::LogLevel::Error, "Failed to read topic filter");
                 return false;
@@ -173,12 +190,12 @@ namespace reactormq::mqtt::packets
                     return false;
                 }
 
-                m_topicFilters.emplace_back(std::move(topicFilterStr), qos, noLocal, retainAsPublished, retainHandling);
+                m_topicFilters.emplace_back(topicFilterStr, qos, noLocal, retainAsPublished, retainHandling);
             }
             else
             {
                 auto qos = static_cast<QualityOfService>(optionsByte);
-                m_topicFilters.emplace_back(std::move(topicFilterStr), qos);
+                m_topicFilters.emplace_back(topicFilterStr, qos);
             }
         }
 
@@ -220,27 +237,17 @@ namespace reactormq::mqtt::packets
     template<ProtocolVersion V>
     void encodeSubscribeToWriter(
         ByteWriter& writer,
-        const std::vector<TopicFilter>& topicFilters,
-        uint16_t packetId,
+        const std::span<const TopicFilter> topicFilters,
+        const uint16_t packetId,
         typename detail::SubscribeTraits<V>::PropertiesType&& properties)
     {
-        using Traits = detail::SubscribeTraits<V>;
-        if constexpr (Traits::HasProperties)
-        {
-            Subscribe<V> packet(topicFilters, packetId, std::move(properties));
-            packet.encode(writer);
-        }
-        else
-        {
-            Subscribe<V> packet(topicFilters, packetId);
-            packet.encode(writer);
-        }
+        Subscribe<V>::encodeTo(writer, topicFilters, packetId, properties);
     }
 
     template void encodeSubscribeToWriter<ProtocolVersion::V311>(
-        ByteWriter&, const std::vector<TopicFilter>&, uint16_t, typename detail::SubscribeTraits<ProtocolVersion::V311>::PropertiesType&&);
+        ByteWriter&, std::span<const TopicFilter>, uint16_t, typename detail::SubscribeTraits<ProtocolVersion::V311>::PropertiesType&&);
     template void encodeSubscribeToWriter<ProtocolVersion::V5>(
-        ByteWriter&, const std::vector<TopicFilter>&, uint16_t, typename detail::SubscribeTraits<ProtocolVersion::V5>::PropertiesType&&);
+        ByteWriter&, std::span<const TopicFilter>, uint16_t, typename detail::SubscribeTraits<ProtocolVersion::V5>::PropertiesType&&);
 } // namespace reactormq::mqtt::packets
 
 #if defined(__clang__)
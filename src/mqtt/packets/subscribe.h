@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace reactormq::mqtt::packets
@@ -120,6 +121,36 @@ namespace reactormq::mqtt::packets
         [[nodiscard]] const PropertiesStorage& getProperties() const
             requires(detail::SubscribeTraits<TProtocolVersion>::HasProperties);
 
+        /**
+         * @brief Bytes one topic filter takes in the packet: length prefix, filter, and options byte.
+         * @param topicFilter The topic filter.
+         * @return Size in bytes.
+         */
+        [[nodiscard]] static uint32_t getEntryLength(const TopicFilter& topicFilter)
+        {
+            return kStringLengthFieldSize + static_cast<uint32_t>(topicFilter.getFilter().length()) + 1;
+        }
+
+        /**
+         * @brief Remaining Length of a SUBSCRIBE without any topic filter: packet ID and properties.
+         * @param properties The properties.
+         * @return Size in bytes.
+         */
+        [[nodiscard]] static uint32_t getBaseLength(const PropertiesStorage& properties);
+
+        /**
+         * @brief Encode a SUBSCRIBE straight from the caller's filters, without copying them into a packet.
+         * @param writer Destination writer.
+         * @param topicFilters The topic filters.
+         * @param packetId The packet identifier.
+         * @param properties The properties; empty for MQTT 3.1.1.
+         */
+        static void encodeTo(
+            serialize::ByteWriter& writer,
+            std::span<const TopicFilter> topicFilters,
+            uint16_t packetId,
+            const PropertiesStorage& properties);
+
     private:
         uint16_t m_packetIdentifier{ 0 };
         std::vector<TopicFilter> m_topicFilters;
@@ -127,6 +158,9 @@ namespace reactormq::mqtt::packets
 
         [[nodiscard]] uint32_t getPropertiesLength() const;
 
+        /// First byte of every SUBSCRIBE: the packet type and the reserved flags 0b0010.
+        static constexpr uint8_t kTypeAndFlags{ 0x82 };
+
         // V5 specific constants for decoding options
         static constexpr std::byte kQosMask{ std::byte{ 0x3 } };
         static constexpr std::byte kNoLocalBit{ std::byte{ 0x1 } << 2 };
@@ -142,15 +176,15 @@ namespace reactormq::mqtt::packets
     template<ProtocolVersion V>
     void encodeSubscribeToWriter(
         serialize::ByteWriter& writer,
-        const std::vector<TopicFilter>& topicFilters,
+        std::span<const TopicFilter> topicFilters,
         uint16_t packetId,
         typename detail::SubscribeTraits<V>::PropertiesType&& properties = {});
 
     extern template void encodeSubscribeToWriter<ProtocolVersion::V311>(
         serialize::ByteWriter&,
-        const std::vector<TopicFilter>&,
+        std::span<const TopicFilter>,
         uint16_t,
         detail::SubscribeTraits<ProtocolVersion::V311>::PropertiesType&&);
     extern template void encodeSubscribeToWriter<ProtocolVersion::V5>(
-        serialize::ByteWriter&, const std::vector<TopicFilter>&, uint16_t, detail::SubscribeTraits<ProtocolVersion::V5>::PropertiesType&&);
+        serialize::ByteWriter&, std::span<const TopicFilter>, uint16_t, detail::SubscribeTraits<ProtocolVersion::V5>::PropertiesType&&);
 } // namespace reactormq::mqtt::packets
\ No newline at end of file
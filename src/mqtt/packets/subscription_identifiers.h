@@ -0,0 +1,45 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace reactormq::mqtt::packets
+{
+    /**
+     * @brief Subscription Identifiers an MQTT 5 PUBLISH carries, one per matching subscription that had one.
+     * Held inline so reading them on the delivery path allocates nothing.
+     */
+    struct SubscriptionIdentifiers
+    {
+        static constexpr size_t kCapacity = 8;
+
+        std::array<std::uint32_t, kCapacity> values{};
+        std::uint8_t count = 0;
+        /// More identifiers than kCapacity were carried; the packet reports none so callers match on the topic.
+        bool overflowed = false;
+
+        void add(const std::uint32_t value)
+        {
+            if (count < kCapacity)
+            {
+                values[count++] = value;
+            }
+            else
+            {
+                overflowed = true;
+            }
+        }
+
+        /// @brief The identifiers; empty for none, for MQTT 3.1.1, or when they overflowed.
+        [[nodiscard]] std::span<const std::uint32_t> get() const
+        {
+            return overflowed ? std::span<const std::uint32_t>{} : std::span<const std::uint32_t>{ values.data(), count };
+        }
+    };
+} // namespace reactormq::mqtt::packets
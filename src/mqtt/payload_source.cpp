@@ -0,0 +1,141 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/payload_source.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    namespace
+    {
+        class CallbackPayloadSource final : public IPayloadSource
+        {
+        public:
+            CallbackPayloadSource(const size_t size, PayloadReader reader, std::function<bool()> rewind)
+                : m_size(size)
+                , m_reader(std::move(reader))
+                , m_rewind(std::move(rewind))
+            {
+            }
+
+            [[nodiscard]] size_t getSize() const override
+            {
+                return m_size;
+            }
+
+            size_t read(const std::span<std::uint8_t> out) override
+            {
+                return m_reader ? std::min(m_reader(out), out.size()) : 0;
+            }
+
+            bool rewind() override
+            {
+                return m_rewind && m_rewind();
+            }
+
+        private:
+            size_t m_size;
+            PayloadReader m_reader;
+            std::function<bool()> m_rewind;
+        };
+
+        class MemoryPayloadSource final : public IPayloadSource
+        {
+        public:
+            explicit MemoryPayloadSource(SharedPayload payload)
+                : m_payload(std::move(payload))
+            {
+            }
+
+            [[nodiscard]] size_t getSize() const override
+            {
+                return m_payload.getSize();
+            }
+
+            size_t read(const std::span<std::uint8_t> out) override
+            {
+                const size_t count = std::min(out.size(), m_payload.getSize() - m_offset);
+                if (count > 0)
+                {
+                    std::memcpy(out.data(), m_payload.getData() + m_offset, count);
+                    m_offset += count;
+                }
+                return count;
+            }
+
+            bool rewind() override
+            {
+                m_offset = 0;
+                return true;
+            }
+
+        private:
+            SharedPayload m_payload;
+            size_t m_offset = 0;
+        };
+
+        class FilePayloadSource final : public IPayloadSource
+        {
+        public:
+            FilePayloadSource(std::ifstream file, const size_t size)
+                : m_file(std::move(file))
+                , m_size(size)
+            {
+            }
+
+            [[nodiscard]] size_t getSize() const override
+            {
+                return m_size;
+            }
+
+            size_t read(const std::span<std::uint8_t> out) override
+            {
+                m_file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+                return static_cast<size_t>(m_file.gcount());
+            }
+
+            bool rewind() override
+            {
+                m_file.clear();
+                m_file.seekg(0);
+                return m_file.good();
+            }
+
+        private:
+            std::ifstream m_file;
+            size_t m_size;
+        };
+    } // namespace
+
+    PayloadSourcePtr createPayloadSource(const size_t size, PayloadReader reader, std::function<bool()> rewind)
+    {
+        return std::make_shared<CallbackPayloadSource>(size, std::move(reader), std::move(rewind));
+    }
+
+    PayloadSourcePtr createPayloadSource(SharedPayload payload)
+    {
+        return std::make_shared<MemoryPayloadSource>(std::move(payload));
+    }
+
+    PayloadSourcePtr createFilePayloadSource(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return nullptr;
+        }
+
+        const std::streamoff size = file.tellg();
+        file.seekg(0);
+        if (size < 0 || !file.good())
+        {
+            return nullptr;
+        }
+        return std::make_shared<FilePayloadSource>(std::move(file), static_cast<size_t>(size));
+    }
+} // namespace reactormq::mqtt
@@ -0,0 +1,57 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/publish_reservation.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace reactormq::mqtt
+{
+    namespace
+    {
+        /// First byte, Remaining Length, topic length prefix, packet identifier, and an MQTT 5 property block holding
+        /// a Topic Alias and a Message Expiry Interval.
+        constexpr size_t kHeaderOverhead = 1 + 4 + 2 + 2 + 4 + 3 + 5;
+    } // namespace
+
+    PublishReservation::PublishReservation(
+        std::string topic,
+        const size_t payloadCapacity,
+        const QualityOfService qualityOfService,
+        const bool shouldRetain,
+        std::pmr::memory_resource* resource)
+        : m_topic(std::move(topic))
+        , m_resource(nullptr != resource ? resource : std::pmr::new_delete_resource())
+        , m_headroom(getHeadroom(m_topic.size()))
+        , m_capacity(payloadCapacity)
+        , m_qualityOfService(qualityOfService)
+        , m_shouldRetain(shouldRetain)
+    {
+        const size_t size = m_headroom + m_capacity;
+        auto* block = static_cast<std::uint8_t*>(m_resource->allocate(size, kPayloadAlignment));
+        m_block = std::shared_ptr<std::uint8_t>(
+            block,
+            [resource = m_resource, size](std::uint8_t* adopted) { resource->deallocate(adopted, size, kPayloadAlignment); },
+            std::pmr::polymorphic_allocator<std::byte>{ m_resource });
+    }
+
+    Message PublishReservation::commit(const size_t payloadSize)
+    {
+        if (!m_block)
+        {
+            return Message(std::move(m_topic), SharedPayload{}, m_shouldRetain, m_qualityOfService);
+        }
+
+        const size_t size = std::min(payloadSize, m_capacity);
+        SharedPayload payload = SharedPayload::shareWithHeadroom(std::move(m_block), m_headroom, size, m_resource);
+        m_capacity = 0;
+        return Message(std::move(m_topic), std::move(payload), m_shouldRetain, m_qualityOfService);
+    }
+
+    size_t PublishReservation::getHeadroom(const size_t topicSize) noexcept
+    {
+        return (kHeaderOverhead + topicSize + kPayloadAlignment - 1) / kPayloadAlignment * kPayloadAlignment;
+    }
+} // namespace reactormq::mqtt
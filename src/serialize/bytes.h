@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <span>
+#include <string_view>
 #include <vector>
 
 #include "endian.h"
@@ -15,9 +18,11 @@
 namespace reactormq::serialize
 {
     /**
-     * @brief Appends primitive values and byte ranges to a growable buffer.
-     * Writes big-endian integers and raw bytes into an external std::vector<std::byte>.
-     * The writer does not fail; callers must size-check at a higher level when needed.
+     * @brief Appends primitive values and byte ranges to a growable or fixed buffer.
+     * Writes big-endian integers and raw bytes into an external std::vector<std::byte>, or into a caller-provided
+     * span (e.g. a stack array) for small packets that should not allocate.
+     * A vector-backed writer does not fail; a span-backed writer drops writes that do not fit and reports
+     * hasOverflowed(), so callers check once after encoding.
      */
     class ByteWriter
     {
@@ -27,7 +32,16 @@ namespace reactormq::serialize
          * @param buffer Destination byte buffer (not owned).
          */
         explicit ByteWriter(std::vector<std::byte>& buffer)
-            : m_buffer(buffer)
+            : m_buffer(&buffer)
+        {
+        }
+
+        /**
+         * @brief Construct a writer over fixed storage, starting at its first byte.
+         * @param storage Destination bytes (not owned); nothing is written past its end.
+         */
+        explicit ByteWriter(const std::span<std::byte> storage)
+            : m_storage(storage)
         {
         }
 
@@ -74,7 +88,15 @@ namespace reactormq::serialize
             {
                 return;
             }
-            m_buffer.insert(m_buffer.end(), data, data + size);
+            if (m_buffer != nullptr)
+            {
+                m_buffer->insert(m_buffer->end(), data, data + size);
+                return;
+            }
+            if (std::byte* dst = claim(size))
+            {
+                std::memcpy(dst, data, size);
+            }
         }
 
         /**
@@ -82,7 +104,33 @@ namespace reactormq::serialize
          */
         [[nodiscard]] size_t getSize() const
         {
-            return m_buffer.size();
+            return m_buffer != nullptr ? m_buffer->size() : m_written;
+        }
+
+        /**
+         * @brief Whether a span-backed writer ran out of room; always false for a vector-backed writer.
+         * Once set, the contents are incomplete and must not be sent.
+         */
+        [[nodiscard]] bool hasOverflowed() const
+        {
+            return m_hasOverflowed;
+        }
+
+        /**
+         * @brief Make room for at least additional more bytes so the writes that follow do not reallocate.
+         * Grows at least geometrically, so reserving per packet on a buffer that holds many stays linear.
+         * @param additional Number of bytes about to be written.
+         */
+        void reserve(const size_t additional) const
+        {
+            if (m_buffer == nullptr)
+            {
+                return;
+            }
+            if (const size_t needed = m_buffer->size() + additional; needed > m_buffer->capacity())
+            {
+                m_buffer->reserve(std::max(needed, 2 * m_buffer->capacity()));
+            }
         }
 
     private:
@@ -92,16 +140,72 @@ namespace reactormq::serialize
             static_assert(std::is_unsigned_v<T>, "ByteWriter only supports unsigned integer types");
             static_assert(sizeof(T) <= sizeof(uint64_t), "Unsupported integer size");
 
-            const auto value = static_cast<uint64_t>(v);
-            for (size_t i = 0; i < sizeof(T); ++i)
+            if constexpr (sizeof(T) == 1)
+            {
+                if (std::byte* dst = claim(1))
+                {
+                    *dst = static_cast<std::byte>(v);
+                }
+            }
+            else
             {
-                const size_t shift = (sizeof(T) - 1 - i) * 8;
-                const auto byteValue = static_cast<std::byte>(value >> shift & 0xFFu);
-                m_buffer.push_back(byteValue);
+                T bigEndian = v;
+                if constexpr (sizeof(T) == sizeof(uint16_t))
+                {
+                    bigEndian = hostToBigEndian16(v);
+                }
+                else if constexpr (sizeof(T) == sizeof(uint32_t))
+                {
+                    bigEndian = hostToBigEndian32(v);
+                }
+                else
+                {
+                    bigEndian = hostToBigEndian64(v);
+                }
+
+                // One grow and one store instead of a push_back per byte.
+                if (std::byte* dst = claim(sizeof(T)))
+                {
+                    std::memcpy(dst, &bigEndian, sizeof(T));
+                }
             }
         }
 
-        std::vector<std::byte>& m_buffer;
+        /// @brief Extend the destination by size bytes; returns where to write them, or nullptr on overflow.
+        std::byte* claim(const size_t size) const
+        {
+            if (m_buffer != nullptr)
+            {
+                const size_t offset = m_buffer->size();
+                m_buffer->resize(offset + size);
+                return m_buffer->data() + offset;
+            }
+
+            if (m_hasOverflowed || size > m_storage.size() - m_written)
+            {
+                if (!m_hasOverflowed)
+                {
+                    REACTORMQ_LOG(
+                        reactormq::logging::LogLevel::Error,
+                        "ByteWriter: overflow writing %zu bytes at %zu/%zu",
+                        size,
+                        m_written,
+                        m_storage.size());
+                }
+                m_hasOverflowed = true;
+                return nullptr;
+            }
+
+            std::byte* dst = m_storage.data() + m_written;
+            m_written += size;
+            return dst;
+        }
+
+        std::vector<std::byte>* m_buffer = nullptr;
+        std::span<std::byte> m_storage;
+        // Writes are const because the destination is external; the span cursor follows that convention.
+        mutable size_t m_written = 0;
+        mutable bool m_hasOverflowed = false;
     };
 
     /**
@@ -275,6 +379,48 @@ namespace reactormq::serialize
             return true;
         }
 
+        /**
+         * @brief Try to consume a raw byte range without copying it.
+         * @param size Number of bytes to consume.
+         * @param out Receives a view into the underlying buffer; only valid while that buffer is.
+         * @return True on success; false if not enough data.
+         */
+        bool tryReadView(const size_t size, std::span<const std::byte>& out)
+        {
+            if (!available(size))
+            {
+                logBounds("view");
+                return false;
+            }
+            out = std::span{ m_data + m_pos, size };
+            m_pos += size;
+            return true;
+        }
+
+        /**
+         * @brief Try to consume a byte range as text without copying it.
+         * The bytes are not checked; see decodeStringView for a validated MQTT string.
+         * @param size Number of bytes to consume.
+         * @param out Receives a view into the underlying buffer; only valid while that buffer is.
+         * @return True on success; false if not enough data.
+         */
+        bool tryReadStringView(const size_t size, std::string_view& out)
+        {
+            std::span<const std::byte> bytes;
+            if (!tryReadView(size, bytes))
+            {
+                return false;
+            }
+            out = std::string_view{ reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+            return true;
+        }
+
+        /// @brief View the unread bytes without consuming them; only valid while the underlying buffer is.
+        [[nodiscard]] std::span<const std::byte> peekRemaining() const
+        {
+            return std::span{ m_data + m_pos, getRemaining() };
+        }
+
     private:
         /// @brief Check whether n bytes can be read without overrunning the buffer.
         [[nodiscard]] bool available(const size_t n) const
@@ -5,11 +5,15 @@
 #pragma once
 
 #include "bytes.h"
+#include "utf8.h"
 #include "util/logging/logging.h"
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace reactormq::serialize
@@ -23,8 +27,17 @@ namespace reactormq::serialize
             static_cast<std::byte>(kVariableByteBase - 1u) // 0b0111'1111
         };
         static constexpr std::uint32_t kMaxVariableByteShift = 4u * kVariableByteBits;
+        static constexpr size_t kMaxVariableByteSize = 4u;
     } // namespace mqtt
 
+    /// @brief Outcome of scanVariableByteInteger().
+    enum class VariableByteIntegerStatus : std::uint8_t
+    {
+        Complete,   ///< The value and its size are set.
+        Incomplete, ///< Every byte present so far has the continuation bit; more are needed.
+        Malformed   ///< Four bytes with the continuation bit; no valid encoding is that long.
+    };
+
     /**
      * @brief Size in bytes needed to encode a variable byte integer (MQTT VBI).
      * @param value Non-negative value to be encoded.
@@ -73,44 +86,73 @@ namespace reactormq::serialize
     }
 
     /**
-     * @brief Decode a variable byte integer (MQTT VBI) from a reader.
-     * @param reader Source reader.
-     * @return Decoded value, or 0 on error (bounds or malformed input).
+     * @brief Decode a variable byte integer (MQTT VBI) at the start of a byte range, without a loop over its bytes.
+     * Up to four bytes are gathered into one word; the first byte without the continuation bit is found with a mask
+     * and countr_zero, and the 7-bit groups are packed with shifts. Shared by packet framing and parsing.
+     * @param data Bytes starting at the first byte of the integer; may be shorter than the encoding.
+     * @param outValue Receives the value on Complete.
+     * @param outSize Receives the number of bytes the encoding takes (1-4) on Complete.
+     * @return Complete, Incomplete if data ends inside the encoding, or Malformed.
      */
-    inline std::uint32_t decodeVariableByteInteger(ByteReader& reader)
+    inline VariableByteIntegerStatus scanVariableByteInteger(
+        const std::span<const std::uint8_t> data, std::uint32_t& outValue, size_t& outSize)
     {
-        std::uint32_t value = 0;
-        std::uint32_t shift = 0;
-        std::byte byte{ 0 };
-
-        do
+        // Little-endian gather; compilers turn the full case into a single load.
+        std::uint32_t word = 0;
+        std::uint32_t present = 0xFFFF'FFFFu;
+        if (data.size() >= mqtt::kMaxVariableByteSize)
         {
-            if (reader.isEof())
+            word = static_cast<std::uint32_t>(data[0]) | static_cast<std::uint32_t>(data[1]) << 8
+                | static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24;
+        }
+        else
+        {
+            for (size_t i = 0; i < data.size(); ++i)
             {
-                REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize");
-                return 0;
+                word |= static_cast<std::uint32_t>(data[i]) << (8 * i);
             }
+            present = (1u << (8 * data.size())) - 1u;
+        }
 
-            byte = static_cast<std::byte>(reader.readUint8());
-
-            const auto chunk = std::to_integer<std::uint32_t>(byte & mqtt::kValueMask);
+        // A set bit marks a byte whose continuation bit is clear: the last byte of the encoding.
+        const std::uint32_t terminators = ~word & 0x8080'8080u & present;
+        if (terminators == 0)
+        {
+            return data.size() >= mqtt::kMaxVariableByteSize ? VariableByteIntegerStatus::Malformed : VariableByteIntegerStatus::Incomplete;
+        }
 
-            value |= (chunk << shift);
-            shift += mqtt::kVariableByteBits;
+        // Keep the bytes up to and including the terminator, then close the gaps left by the continuation bits.
+        const std::uint32_t kept = word & (terminators ^ (terminators - 1u));
+        outValue = (kept & 0x7Fu) | (kept >> 1 & 0x3F80u) | (kept >> 2 & 0x1F'C000u) | (kept >> 3 & 0xFE0'0000u);
+        outSize = static_cast<size_t>(std::countr_zero(terminators)) / 8u + 1u;
+        return VariableByteIntegerStatus::Complete;
+    }
 
-            if (shift > mqtt::kMaxVariableByteShift)
-            {
-                REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize");
-                return 0;
-            }
-        } while ((byte & mqtt::kContinuationFlag) != std::byte{ 0 });
+    /**
+     * @brief Decode a variable byte integer (MQTT VBI) from a reader.
+     * @param reader Source reader.
+     * @return Decoded value, or 0 on error (bounds or malformed input).
+     */
+    inline std::uint32_t decodeVariableByteInteger(ByteReader& reader)
+    {
+        const std::span<const std::byte> remaining = reader.peekRemaining();
+        std::uint32_t value = 0;
+        size_t size = 0;
+        if (scanVariableByteInteger({ reinterpret_cast<const std::uint8_t*>(remaining.data()), remaining.size() }, value, size)
+            != VariableByteIntegerStatus::Complete)
+        {
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize DecodeVariableByteInteger: Truncated or malformed");
+            return 0;
+        }
 
+        std::span<const std::byte> consumed;
+        (void)reader.tryReadView(size, consumed);
         return value;
     }
 
     /**
      * @brief Encode a length-prefixed UTF-8 string.
-     * @param str String to encode (assumed UTF-8, not validated).
+     * @param str String to encode; callers check it with isValidMqttString() where they validate outbound strings.
      * @param writer Destination writer.
      * @return True on success; false if length exceeds 65535 bytes.
      */
@@ -132,33 +174,91 @@ namespace reactormq::serialize
     }
 
     /**
-     * @brief Decode a length-prefixed UTF-8 string.
+     * @brief Decode length-prefixed Binary Data as a view into the reader's buffer, without checking its contents.
      * @param reader Source reader.
-     * @param outStr Output string (replaced on success).
-     * @return True on success; false if not enough data or length invalid.
+     * @param outData Output view (replaced on success); only valid while the reader's buffer is.
+     * @return True on success; false if not enough data.
      */
-    inline bool decodeString(ByteReader& reader, std::string& outStr)
+    inline bool decodeBinaryDataView(ByteReader& reader, std::span<const std::byte>& outData)
+    {
+        uint16_t length = 0;
+        if (!reader.tryReadUint16(length))
+        {
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize DecodeBinaryData: Failed to read data length");
+            return false;
+        }
+
+        return reader.tryReadView(length, outData);
+    }
+
+    /**
+     * @brief Decode a length-prefixed UTF-8 string as a view into the reader's buffer.
+     * @param reader Source reader.
+     * @param outStr Output view (replaced on success); only valid while the reader's buffer is.
+     * @return True on success; false if not enough data or not a valid MQTT string.
+     */
+    inline bool decodeStringView(ByteReader& reader, std::string_view& outStr)
     {
         uint16_t length = 0;
         if (!reader.tryReadUint16(length))
         {
-            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize DecodeString: Failed to read string length");
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize DecodeStringView: Failed to read string length");
             return false;
         }
 
-        if (length == 0)
+        std::string_view text;
+        if (!reader.tryReadStringView(length, text))
+        {
+            return false;
+        }
+
+        if (!isValidMqttString(text))
+        {
+            REACTORMQ_LOG(reactormq::logging::LogLevel::Error, "Serialize DecodeStringView: Malformed UTF-8 or U+0000 in string");
+            return false;
+        }
+
+        outStr = text;
+        return true;
+    }
+
+    /**
+     * @brief Decode length-prefixed Binary Data into a string, without checking its contents.
+     * @param reader Source reader.
+     * @param outStr Output string (replaced on success).
+     * @return True on success; false if not enough data or length invalid.
+     */
+    inline bool decodeBinaryData(ByteReader& reader, std::string& outStr)
+    {
+        std::span<const std::byte> data;
+        if (!decodeBinaryDataView(reader, data))
         {
             outStr.clear();
-            return true;
+            return false;
         }
 
-        outStr.resize(length);
-        if (const auto span = std::span(reinterpret_cast<std::byte*>(outStr.data()), length); !reader.tryReadBytes(span))
+        // One copy out of the receive buffer; resize() would zero-fill the string first.
+        outStr.assign(reinterpret_cast<const char*>(data.data()), data.size());
+        return true;
+    }
+
+    /**
+     * @brief Decode a length-prefixed UTF-8 string.
+     * Validated in place, so a malformed string is rejected before anything is copied.
+     * @param reader Source reader.
+     * @param outStr Output string (replaced on success, cleared on failure).
+     * @return True on success; false if not enough data, length invalid, or not a valid MQTT string.
+     */
+    inline bool decodeString(ByteReader& reader, std::string& outStr)
+    {
+        std::string_view text;
+        if (!decodeStringView(reader, text))
         {
             outStr.clear();
             return false;
         }
 
+        outStr.assign(text);
         return true;
     }
 
@@ -192,11 +292,10 @@ namespace reactormq::serialize
             return false;
         }
 
-        outData.resize(size);
-
-        const std::span dst{ reinterpret_cast<std::byte*>(outData.data()), outData.size() };
-
-        reader.readBytes(dst);
+        std::span<const std::byte> data;
+        (void)reader.tryReadView(size, data);
+        const auto* first = reinterpret_cast<const uint8_t*>(data.data());
+        outData.assign(first, first + data.size());
         return true;
     }
 } // namespace reactormq::serialize
\ No newline at end of file
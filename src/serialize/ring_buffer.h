@@ -0,0 +1,308 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/buffer_memory_options.h"
+#include "util/system/buffer_pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace reactormq::serialize
+{
+    /// @brief Frees ring storage to wherever it came from.
+    struct RingStorageDeleter
+    {
+        system::BufferPool* pool = nullptr;
+        size_t size = 0;
+
+        void operator()(uint8_t* storage) const
+        {
+            if (nullptr != pool)
+            {
+                pool->release(storage, size);
+                return;
+            }
+            delete[] storage;
+        }
+    };
+
+    /**
+     * @brief Growable power-of-two byte ring used for inbound stream data.
+     * Writers fill the contiguous free region returned by getWritableSpan() and commit it; readers peek and consume
+     * from the front. Consuming never moves bytes, so long-lived partial packets cost nothing per read. Storage
+     * only grows (by doubling) when the free space is smaller than what reserve() asks for.
+     *
+     * share() lets readable bytes outlive the ring's hold on them, e.g. a received payload kept by a Message. The
+     * storage is reference-counted, and the next write into storage that is still shared moves the unread bytes to
+     * other storage first, so shared bytes are never overwritten. The ring keeps the storage it left as a spare and
+     * writes into it again once the last share is gone, so a steady stream of shared payloads allocates nothing.
+     */
+    class RingBuffer final
+    {
+    public:
+        RingBuffer() = default;
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+        RingBuffer(RingBuffer&&) noexcept = default;
+        RingBuffer& operator=(RingBuffer&&) noexcept = default;
+
+        /**
+         * @brief Ring whose storage comes from the buffer pool of the thread that grows it, not the heap.
+         * @param memory Buffer memory options; the heap is used unless isPooled() is true.
+         */
+        explicit RingBuffer(const reactormq::mqtt::BufferMemoryOptions& memory)
+            : m_memory(memory)
+        {
+        }
+
+        /// @brief Number of readable bytes.
+        [[nodiscard]] size_t getSize() const
+        {
+            return m_size;
+        }
+
+        /// @brief Allocated capacity in bytes (always zero or a power of two).
+        [[nodiscard]] size_t getCapacity() const
+        {
+            return m_capacity;
+        }
+
+        /// @brief Number of bytes that can be written without growing.
+        [[nodiscard]] size_t getFreeSpace() const
+        {
+            return m_capacity - m_size;
+        }
+
+        /// @brief True if there are no readable bytes.
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_size == 0;
+        }
+
+        /**
+         * @brief Ensure at least minFreeBytes can be written, growing to the next power of two if needed.
+         * Growing linearises the readable bytes at the start of the new storage.
+         * @param minFreeBytes Required free space in bytes.
+         */
+        void reserve(const size_t minFreeBytes)
+        {
+            const size_t required = m_size + minFreeBytes;
+            if (required <= m_capacity)
+            {
+                return;
+            }
+
+            const size_t newCapacity = std::bit_ceil(std::max(required, kMinCapacity));
+            Storage storage = allocate(newCapacity);
+            copyOut(storage.get(), m_size);
+
+            m_storage = std::move(storage);
+            m_spare = nullptr;
+            m_capacity = newCapacity;
+            m_readIndex = 0;
+        }
+
+        /**
+         * @brief Contiguous free region starting at the write position.
+         * May be shorter than getFreeSpace() when the free space wraps around the end of the storage.
+         * @return Writable span; empty if the ring is full or unallocated.
+         */
+        [[nodiscard]] std::span<uint8_t> getWritableSpan()
+        {
+            if (m_storage.use_count() > 1)
+            {
+                detach();
+            }
+            if (m_size == m_capacity)
+            {
+                return {};
+            }
+
+            const size_t writeIndex = (m_readIndex + m_size) & (m_capacity - 1);
+            const size_t contiguous = writeIndex >= m_readIndex ? m_capacity - writeIndex : m_readIndex - writeIndex;
+            return { m_storage.get() + writeIndex, contiguous };
+        }
+
+        /**
+         * @brief Mark bytes written into the span from getWritableSpan() as readable.
+         * @param bytes Number of bytes written.
+         */
+        void commitWrite(const size_t bytes)
+        {
+            m_size += std::min(bytes, getFreeSpace());
+        }
+
+        /**
+         * @brief Copy bytes into the ring, wrapping as needed.
+         * @param data Source bytes.
+         * @param size Number of bytes; the caller must have reserved enough free space.
+         * @return Number of bytes written.
+         */
+        size_t write(const uint8_t* data, const size_t size)
+        {
+            size_t written = 0;
+            while (written < size)
+            {
+                const std::span<uint8_t> target = getWritableSpan();
+                if (target.empty())
+                {
+                    break;
+                }
+                const size_t chunk = std::min(target.size(), size - written);
+                std::memcpy(target.data(), data + written, chunk);
+                commitWrite(chunk);
+                written += chunk;
+            }
+            return written;
+        }
+
+        /**
+         * @brief Read a byte relative to the front without consuming it.
+         * @param offset Offset from the front; must be less than getSize().
+         */
+        [[nodiscard]] uint8_t peek(const size_t offset) const
+        {
+            return m_storage[(m_readIndex + offset) & (m_capacity - 1)];
+        }
+
+        /**
+         * @brief Copy bytes from the front without consuming them.
+         * @param destination Buffer for up to size bytes.
+         * @param size Most bytes to copy.
+         * @param offset Readable bytes to skip first; must not exceed getSize().
+         * @return Number of bytes copied: size, or fewer if fewer are buffered past offset.
+         */
+        size_t peekInto(uint8_t* destination, const size_t size, const size_t offset = 0) const
+        {
+            const size_t count = std::min(size, m_size - offset);
+            copyOut(destination, count, offset);
+            return count;
+        }
+
+        /**
+         * @brief View size bytes starting offset bytes from the front as one contiguous range.
+         * Points straight into the ring unless the range wraps, in which case the bytes are copied into scratch.
+         * Consuming the bytes does not move or overwrite them, so the view outlives consume() until the next write.
+         * @param size Number of bytes; offset + size must not exceed getSize().
+         * @param scratch Reusable fallback storage for wrapped ranges.
+         * @param offset Readable bytes to skip first.
+         * @return View valid until the next write or scratch modification.
+         */
+        [[nodiscard]] std::span<const uint8_t> getContiguousView(
+            const size_t size,
+            std::vector<uint8_t>& scratch,
+            const size_t offset = 0) const
+        {
+            const size_t begin = (m_readIndex + offset) & (m_capacity - 1);
+            if (begin + size <= m_capacity)
+            {
+                return { m_storage.get() + begin, size };
+            }
+
+            scratch.resize(size);
+            copyOut(scratch.data(), size, offset);
+            return { scratch.data(), size };
+        }
+
+        /**
+         * @brief Drop bytes from the front.
+         * @param bytes Number of bytes to drop.
+         */
+        void consume(const size_t bytes)
+        {
+            const size_t count = std::min(bytes, m_size);
+            m_size -= count;
+            // Rewind when drained so the next write starts at the beginning and stays contiguous.
+            m_readIndex = m_size == 0 ? 0 : (m_readIndex + count) & (m_capacity - 1);
+        }
+
+        /**
+         * @brief Keep readable bytes alive past consume(), without copying them.
+         * @param bytes Bytes inside the readable region, e.g. a span from getContiguousView() that did not need the
+         * scratch copy.
+         * @return Owner of bytes.data(), sharing the ring's storage; empty when bytes are not in the storage, or are
+         * smaller than an eighth of the capacity, so a small payload kept for long does not pin a large buffer.
+         */
+        [[nodiscard]] std::shared_ptr<const uint8_t> share(const std::span<const uint8_t> bytes) const
+        {
+            const uint8_t* const begin = m_storage.get();
+            if (nullptr == begin || bytes.empty() || bytes.size() * 8 < m_capacity)
+            {
+                return nullptr;
+            }
+            if (std::less<>{}(bytes.data(), begin) || std::greater<>{}(bytes.data() + bytes.size(), begin + m_capacity))
+            {
+                return nullptr;
+            }
+            return { m_storage, bytes.data() };
+        }
+
+        /// @brief Drop all readable bytes, keeping the storage.
+        void clear()
+        {
+            m_size = 0;
+            m_readIndex = 0;
+        }
+
+    private:
+        using Storage = std::shared_ptr<uint8_t[]>;
+
+        [[nodiscard]] Storage allocate(const size_t size) const
+        {
+            // Falls back to the heap if the pool cannot map more memory.
+            if (m_memory.isPooled())
+            {
+                system::BufferPool& pool = system::BufferPool::getForCurrentThread(m_memory);
+                if (uint8_t* storage = pool.allocate(size); nullptr != storage)
+                {
+                    return Storage(storage, RingStorageDeleter{ &pool, size });
+                }
+            }
+            return Storage(new uint8_t[size], RingStorageDeleter{});
+        }
+
+        /// @brief Move the unread bytes off storage that share() handed out, to the spare if it is free again.
+        void detach()
+        {
+            Storage storage = m_spare.use_count() == 1 ? std::move(m_spare) : allocate(m_capacity);
+            copyOut(storage.get(), m_size);
+            m_spare = std::exchange(m_storage, std::move(storage));
+            m_readIndex = 0;
+        }
+
+        void copyOut(uint8_t* destination, const size_t size, const size_t offset = 0) const
+        {
+            if (size == 0)
+            {
+                return;
+            }
+            const size_t begin = (m_readIndex + offset) & (m_capacity - 1);
+            const size_t firstPart = std::min(size, m_capacity - begin);
+            std::memcpy(destination, m_storage.get() + begin, firstPart);
+            if (firstPart < size)
+            {
+                std::memcpy(destination + firstPart, m_storage.get(), size - firstPart);
+            }
+        }
+
+        static constexpr size_t kMinCapacity = 4 * 1024;
+
+        reactormq::mqtt::BufferMemoryOptions m_memory;
+        Storage m_storage;
+        Storage m_spare; ///< Storage left by detach(), reused once nothing shares it.
+        size_t m_capacity = 0;
+        size_t m_readIndex = 0;
+        size_t m_size = 0;
+    };
+} // namespace reactormq::serialize
\ No newline at end of file
@@ -0,0 +1,191 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "serialize/utf8.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define REACTORMQ_UTF8_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REACTORMQ_UTF8_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define REACTORMQ_UTF8_NEON 1
+#endif
+
+namespace reactormq::serialize
+{
+    namespace
+    {
+        /// @return Length of the leading run of ASCII bytes other than NUL, the bytes that need no further checks.
+        size_t countPlainAscii(const std::uint8_t* data, const size_t size)
+        {
+            size_t i = 0;
+#if REACTORMQ_UTF8_AVX2
+            for (; i + 32 <= size; i += 32)
+            {
+                // A NUL byte compares to 0xFF, so after the OR both it and a non-ASCII byte have the top bit set.
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                const __m256i flagged = _mm256_or_si256(block, _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+                if (const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(flagged)); mask != 0)
+                {
+                    return i + static_cast<size_t>(std::countr_zero(mask));
+                }
+            }
+#endif // REACTORMQ_UTF8_AVX2
+#if REACTORMQ_UTF8_SSE2
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i flagged = _mm_or_si128(block, _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+                if (const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(flagged)); mask != 0)
+                {
+                    return i + static_cast<size_t>(std::countr_zero(mask));
+                }
+            }
+#elif REACTORMQ_UTF8_NEON
+            for (; i + 16 <= size; i += 16)
+            {
+                // Subtracting one wraps NUL to 0xFF, so NUL and every non-ASCII byte end up at 0x7F or above.
+                const uint8x16_t shifted = vsubq_u8(vld1q_u8(data + i), vdupq_n_u8(1));
+                const uint8x16_t flagged = vcgeq_u8(shifted, vdupq_n_u8(0x7F));
+                const uint8x8_t folded = vorr_u8(vget_low_u8(flagged), vget_high_u8(flagged));
+                if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) != 0)
+                {
+                    break;
+                }
+            }
+#endif // REACTORMQ_UTF8_SSE2
+            while (i < size && data[i] != 0 && data[i] < 0x80)
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        /**
+         * @brief Check one multi-byte sequence against Unicode table 3-7 (well-formed UTF-8 byte sequences).
+         * @return Its length, or 0 if it is malformed, truncated or a lone NUL.
+         */
+        size_t checkSequence(const std::uint8_t* data, const size_t size)
+        {
+            const std::uint8_t lead = data[0];
+            size_t length = 0;
+            std::uint8_t low = 0x80;
+            std::uint8_t high = 0xBF;
+            if (lead >= 0xC2 && lead <= 0xDF)
+            {
+                length = 2;
+            }
+            else if (lead == 0xE0)
+            {
+                length = 3;
+                low = 0xA0; // Overlong below U+0800.
+            }
+            else if (lead == 0xED)
+            {
+                length = 3;
+                high = 0x9F; // U+D800..U+DFFF are surrogates.
+            }
+            else if (lead >= 0xE1 && lead <= 0xEF)
+            {
+                length = 3;
+            }
+            else if (lead == 0xF0)
+            {
+                length = 4;
+                low = 0x90; // Overlong below U+10000.
+            }
+            else if (lead >= 0xF1 && lead <= 0xF3)
+            {
+                length = 4;
+            }
+            else if (lead == 0xF4)
+            {
+                length = 4;
+                high = 0x8F; // Past U+10FFFF.
+            }
+            else
+            {
+                return 0;
+            }
+
+            if (size < length || data[1] < low || data[1] > high)
+            {
+                return 0;
+            }
+            for (size_t i = 2; i < length; ++i)
+            {
+                if ((data[i] & 0xC0) != 0x80)
+                {
+                    return 0;
+                }
+            }
+            return length;
+        }
+    } // namespace
+
+    bool isValidMqttString(const std::string_view text)
+    {
+        const auto* data = reinterpret_cast<const std::uint8_t*>(text.data());
+        const size_t size = text.size();
+        size_t i = 0;
+        while (true)
+        {
+            i += countPlainAscii(data + i, size - i);
+            if (i == size)
+            {
+                return true;
+            }
+
+            const size_t length = checkSequence(data + i, size - i);
+            if (length == 0)
+            {
+                return false;
+            }
+            i += length;
+        }
+    }
+
+    bool isValidTopicName(const std::string_view topic)
+    {
+        return !topic.empty() && topic.find_first_of("+#") == std::string_view::npos && isValidMqttString(topic);
+    }
+
+    bool isValidTopicFilter(const std::string_view filter)
+    {
+        if (filter.empty() || !isValidMqttString(filter))
+        {
+            return false;
+        }
+
+        size_t levelStart = 0;
+        for (size_t i = 0; i < filter.size(); ++i)
+        {
+            const char c = filter[i];
+            if (c == '/')
+            {
+                levelStart = i + 1;
+                continue;
+            }
+            if (c != '+' && c != '#')
+            {
+                continue;
+            }
+
+            const bool fillsLevel = i == levelStart && (i + 1 == filter.size() || filter[i + 1] == '/');
+            if (!fillsLevel || (c == '#' && i + 1 != filter.size()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace reactormq::serialize
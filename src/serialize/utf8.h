@@ -0,0 +1,34 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <string_view>
+
+namespace reactormq::serialize
+{
+    /**
+     * @brief Whether text is a valid MQTT UTF-8 Encoded String body (MQTT 5 section 1.5.4, MQTT 3.1.1 section 1.5.3).
+     * Well-formed UTF-8 as Unicode defines it, so no overlong forms, surrogates or code points past U+10FFFF, and no
+     * U+0000. ASCII is checked 16 bytes at a time (32 with AVX2) on SSE2 and NEON targets.
+     * @param text Bytes to check; the length prefix is not part of it.
+     * @return True if the bytes may be sent or accepted as an MQTT string.
+     */
+    [[nodiscard]] bool isValidMqttString(std::string_view text);
+
+    /**
+     * @brief Whether topic is a valid Topic Name to publish to (MQTT 5 section 4.7).
+     * @param topic Topic Name.
+     * @return True if it is a non-empty MQTT string without the '+' and '#' wildcards.
+     */
+    [[nodiscard]] bool isValidTopicName(std::string_view topic);
+
+    /**
+     * @brief Whether filter is a valid Topic Filter to subscribe with (MQTT 5 section 4.7.1).
+     * '+' must fill a whole level, and '#' the last one.
+     * @param filter Topic Filter, possibly a "$share/{group}/" shared subscription.
+     * @return True if it is a non-empty MQTT string that uses its wildcards correctly.
+     */
+    [[nodiscard]] bool isValidTopicFilter(std::string_view filter);
+} // namespace reactormq::serialize
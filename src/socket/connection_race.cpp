@@ -0,0 +1,97 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/connection_race.h"
+
+#include "util/logging/logging.h"
+
+#include <utility>
+
+namespace reactormq::socket
+{
+    ConnectionRace::ConnectionRace(
+        std::vector<std::string> addresses,
+        const std::uint16_t port,
+        const std::chrono::milliseconds attemptDelay,
+        const mqtt::SocketOptions& options)
+        : m_addresses(std::move(addresses))
+        , m_port(port)
+        , m_attemptDelay(attemptDelay)
+        , m_options(options)
+    {
+    }
+
+    ConnectionRace::Status ConnectionRace::poll(const std::chrono::steady_clock::time_point now)
+    {
+        if (!m_winningAddress.empty())
+        {
+            return Status::Connected;
+        }
+
+        for (auto it = m_attempts.begin(); it != m_attempts.end();)
+        {
+            if (it->socket->isConnected())
+            {
+                m_winningAddress = m_addresses[it->addressIndex];
+                m_winner = std::move(it->socket);
+                REACTORMQ_LOG(
+                    logging::LogLevel::Debug,
+                    "ConnectionRace::poll() connected (address=%s, attempt=%zu of %zu)",
+                    m_winningAddress.c_str(),
+                    it->addressIndex + 1,
+                    m_addresses.size());
+                m_attempts.clear();
+                return Status::Connected;
+            }
+
+            if (it->socket->hasConnectFailed())
+            {
+                REACTORMQ_LOG(logging::LogLevel::Debug, "ConnectionRace::poll() attempt failed (address=%s)", m_addresses[it->addressIndex].c_str());
+                it = m_attempts.erase(it);
+                // A failure starts the next attempt without waiting out the delay.
+                m_nextAttemptAt = now;
+                continue;
+            }
+            ++it;
+        }
+
+        if ((m_attempts.empty() || now >= m_nextAttemptAt) && !startNextAttempt(now) && m_attempts.empty())
+        {
+            return Status::Failed;
+        }
+        return Status::Racing;
+    }
+
+    std::unique_ptr<PlatformSocket> ConnectionRace::takeWinner()
+    {
+        return std::move(m_winner);
+    }
+
+    bool ConnectionRace::startNextAttempt(const std::chrono::steady_clock::time_point now)
+    {
+        while (m_nextAddressIndex < m_addresses.size())
+        {
+            const size_t index = m_nextAddressIndex++;
+            auto socket = std::make_unique<PlatformSocket>();
+            socket->setOptions(m_options);
+            if (const int result = socket->connect(m_addresses[index], m_port); result != 0)
+            {
+                const int32_t error = PlatformSocket::getLastErrorCode();
+                REACTORMQ_LOG(
+                    logging::LogLevel::Debug,
+                    "ConnectionRace::startNextAttempt() connect failed (address=%s, error=%d: %s)",
+                    m_addresses[index].c_str(),
+                    error,
+                    PlatformSocket::getNetworkErrorDescription(error));
+                continue;
+            }
+
+            REACTORMQ_LOG(logging::LogLevel::Debug, "ConnectionRace::startNextAttempt() connecting (address=%s)", m_addresses[index].c_str());
+            m_attempts.push_back(Attempt{ std::move(socket), index });
+            m_nextAttemptAt = now + m_attemptDelay;
+            return true;
+        }
+        return false;
+    }
+} // namespace reactormq::socket
@@ -0,0 +1,97 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "socket/platform/platform_socket.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Staggered TCP connects to every address of a host, in the style of Happy Eyeballs (RFC 8305).
+     *
+     * The first address is tried at once. Each later one starts when the previous attempt fails or has been running for
+     * the attempt delay, whichever comes first, and the first attempt to connect wins; the others are closed. Only TCP
+     * is raced: the winner is handed to the transport, which starts TLS on it. Driven by poll() from the thread that
+     * owns the socket.
+     */
+    class ConnectionRace final
+    {
+    public:
+        enum class Status : std::uint8_t
+        {
+            Racing,
+            Connected,
+            Failed
+        };
+
+        /// RFC 8305 section 5: recommended wait before starting the next attempt.
+        static constexpr std::chrono::milliseconds kDefaultAttemptDelay{ 250 };
+
+        /**
+         * @brief Prepare a race; no attempt starts before the first poll().
+         * @param addresses Numeric addresses in the order to try them, as from HostLookup::getAddresses().
+         * @param port Remote port.
+         * @param attemptDelay How long an attempt runs before the next one starts alongside it.
+         * @param options TCP options for every attempt's socket.
+         */
+        ConnectionRace(
+            std::vector<std::string> addresses,
+            std::uint16_t port,
+            std::chrono::milliseconds attemptDelay = kDefaultAttemptDelay,
+            const mqtt::SocketOptions& options = {});
+
+        /**
+         * @brief Start attempts that are due and check the ones in flight.
+         * @param now Current time.
+         * @return Connected once an attempt has won, Failed once every address has failed, Racing otherwise.
+         */
+        Status poll(std::chrono::steady_clock::time_point now);
+
+        /// @brief Attempts started so far, including finished ones.
+        [[nodiscard]] size_t getAttemptCount() const
+        {
+            return m_nextAddressIndex;
+        }
+
+        /// @brief Address of the winning attempt; empty until poll() returns Connected.
+        [[nodiscard]] const std::string& getWinningAddress() const
+        {
+            return m_winningAddress;
+        }
+
+        /**
+         * @brief Hand over the connected socket of the winning attempt.
+         * @return The socket, or nullptr unless poll() returned Connected and it was not taken yet.
+         */
+        [[nodiscard]] std::unique_ptr<PlatformSocket> takeWinner();
+
+    private:
+        struct Attempt
+        {
+            std::unique_ptr<PlatformSocket> socket;
+            size_t addressIndex = 0;
+        };
+
+        /// Start the next address, skipping any whose connect() fails outright; false once every address was tried.
+        bool startNextAttempt(std::chrono::steady_clock::time_point now);
+
+        std::vector<std::string> m_addresses;
+        std::uint16_t m_port;
+        std::chrono::milliseconds m_attemptDelay;
+        mqtt::SocketOptions m_options;
+        std::vector<Attempt> m_attempts; ///< Attempts still in flight.
+        size_t m_nextAddressIndex = 0; ///< Index of the next address to try.
+        std::chrono::steady_clock::time_point m_nextAttemptAt; ///< When the next attempt starts if none fails first.
+        std::unique_ptr<PlatformSocket> m_winner;
+        std::string m_winningAddress;
+    };
+} // namespace reactormq::socket
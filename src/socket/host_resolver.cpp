@@ -0,0 +1,194 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+#include "socket/host_resolver.h"
+
+#include "socket/platform/platform.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <array>
+
+namespace reactormq::socket
+{
+    HostResolver& HostResolver::instance()
+    {
+        static HostResolver resolver;
+        return resolver;
+    }
+
+    HostLookupPtr HostResolver::resolve(const std::string& host, const std::chrono::seconds ttl)
+    {
+        // A numeric address needs no lookup and is not worth a cache slot.
+        in6_addr address{};
+        if (inet_pton(AF_INET, host.c_str(), &address) == 1 || inet_pton(AF_INET6, host.c_str(), &address) == 1)
+        {
+            auto lookup = std::make_shared<HostLookup>();
+            lookup->m_addresses.push_back(host);
+            lookup->m_status.store(HostLookup::Status::Resolved, std::memory_order_release);
+            return lookup;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        std::scoped_lock lock(m_mutex);
+        if (const auto it = m_entries.find(host); it != m_entries.end())
+        {
+            const HostLookup::Status status = it->second.lookup->getStatus();
+            if (status == HostLookup::Status::Pending || (status == HostLookup::Status::Resolved && now - it->second.resolvedAt < ttl))
+            {
+                return it->second.lookup;
+            }
+            m_entries.erase(it);
+        }
+
+        if (m_entries.size() >= kMaxHosts)
+        {
+            m_entries.erase(m_entries.begin());
+        }
+
+        auto lookup = std::make_shared<HostLookup>();
+        m_entries.emplace(host, Entry{ lookup, {} });
+        m_queue.emplace_back(host, lookup);
+        if (!m_worker.joinable())
+        {
+            m_worker = std::jthread([this](const std::stop_token& stopToken) { run(stopToken); });
+        }
+        m_queueCondition.notify_one();
+
+        REACTORMQ_LOG(logging::LogLevel::Debug, "HostResolver::resolve() queued lookup (host=%s)", host.c_str());
+        return lookup;
+    }
+
+    void HostResolver::forget(const std::string& host)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (const auto it = m_entries.find(host); it != m_entries.end() && it->second.lookup->getStatus() != HostLookup::Status::Pending)
+        {
+            m_entries.erase(it);
+        }
+    }
+
+    size_t HostResolver::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_entries.size();
+    }
+
+    void HostResolver::run(const std::stop_token& stopToken)
+    {
+        while (true)
+        {
+            std::pair<std::string, std::shared_ptr<HostLookup>> request;
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_queueCondition.wait(lock, stopToken, [this] { return !m_queue.empty(); }))
+                {
+                    return;
+                }
+                request = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            const auto& [host, lookup] = request;
+            const bool isResolved = lookUp(host, lookup->m_addresses);
+            complete(host, lookup, isResolved);
+        }
+    }
+
+    void HostResolver::complete(const std::string& host, const std::shared_ptr<HostLookup>& lookup, const bool isResolved)
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            if (const auto it = m_entries.find(host); it != m_entries.end() && it->second.lookup == lookup)
+            {
+                if (isResolved)
+                {
+                    it->second.resolvedAt = std::chrono::steady_clock::now();
+                }
+                else
+                {
+                    m_entries.erase(it);
+                }
+            }
+        }
+
+        lookup->m_status.store(isResolved ? HostLookup::Status::Resolved : HostLookup::Status::Failed, std::memory_order_release);
+    }
+
+    bool HostResolver::lookUp(const std::string& host, std::vector<std::string>& outAddresses)
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+
+        addrinfo* result = nullptr;
+        if (const int gaiErr = getaddrinfo(host.c_str(), nullptr, &hints, &result); gaiErr != 0 || nullptr == result)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "HostResolver::lookUp() getaddrinfo failed (host=%s, gaiErr=%d)", host.c_str(), gaiErr);
+            return false;
+        }
+
+        // getaddrinfo() already sorts by RFC 6724 preference; keep that order within each family.
+        std::vector<std::string> preferred;
+        std::vector<std::string> other;
+        const int preferredFamily = result->ai_family;
+        for (const addrinfo* rp = result; rp != nullptr; rp = rp->ai_next)
+        {
+            std::array<char, INET6_ADDRSTRLEN> buffer{};
+            const void* address = nullptr;
+            if (rp->ai_family == AF_INET)
+            {
+                address = &reinterpret_cast<const sockaddr_in*>(rp->ai_addr)->sin_addr;
+            }
+            else if (rp->ai_family == AF_INET6)
+            {
+                address = &reinterpret_cast<const sockaddr_in6*>(rp->ai_addr)->sin6_addr;
+            }
+
+            if (nullptr == address || inet_ntop(rp->ai_family, address, buffer.data(), static_cast<socklen_t>(buffer.size())) == nullptr)
+            {
+                continue;
+            }
+
+            std::vector<std::string>& family = rp->ai_family == preferredFamily ? preferred : other;
+            if (std::ranges::find(family, buffer.data()) == family.end())
+            {
+                family.emplace_back(buffer.data());
+            }
+        }
+        freeaddrinfo(result);
+
+        outAddresses.clear();
+        outAddresses.reserve(preferred.size() + other.size());
+        for (size_t i = 0; i < std::max(preferred.size(), other.size()); ++i)
+        {
+            if (i < preferred.size())
+            {
+                outAddresses.push_back(std::move(preferred[i]));
+            }
+            if (i < other.size())
+            {
+                outAddresses.push_back(std::move(other[i]));
+            }
+        }
+
+        if (outAddresses.empty())
+        {
+            return false;
+        }
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "HostResolver::lookUp() resolved (host=%s, addresses=%zu, first=%s)",
+            host.c_str(),
+            outAddresses.size(),
+            outAddresses.front().c_str());
+        return true;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
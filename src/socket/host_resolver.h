@@ -0,0 +1,133 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief One host name lookup handed out by HostResolver::resolve().
+     * Completed by the resolver thread; poll getStatus() from the thread that asked.
+     */
+    class HostLookup final
+    {
+    public:
+        enum class Status : std::uint8_t
+        {
+            Pending,
+            Resolved,
+            Failed
+        };
+
+        [[nodiscard]] Status getStatus() const
+        {
+            return m_status.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Numeric addresses of the host in the order to try them; only meaningful once getStatus() is Resolved.
+         * The resolver's preferred address comes first, then the families alternate (RFC 8305 section 4).
+         */
+        [[nodiscard]] const std::vector<std::string>& getAddresses() const
+        {
+            return m_addresses;
+        }
+
+    private:
+        friend class HostResolver;
+
+        std::atomic<Status> m_status{ Status::Pending };
+        std::vector<std::string> m_addresses;
+    };
+
+    using HostLookupPtr = std::shared_ptr<const HostLookup>;
+
+    /**
+     * @brief Process-wide resolver that runs getaddrinfo() on its own thread and caches the answers.
+     *
+     * A reactor thread never waits on DNS: resolve() returns at once with a lookup that is either already complete
+     * (a numeric address, or a cached answer young enough for the caller's TTL) or pending on the resolver thread.
+     * Callers asking for a host that is already being looked up share that lookup. Failed lookups are not cached.
+     * getaddrinfo() does not report record TTLs, so each caller states how old an answer it accepts. Safe to call from
+     * any thread.
+     */
+    class HostResolver final
+    {
+    public:
+        /// Hosts remembered at once; one is forgotten to make room for another.
+        static constexpr size_t kMaxHosts = 256;
+
+        static HostResolver& instance();
+
+        HostResolver(const HostResolver&) = delete;
+
+        HostResolver& operator=(const HostResolver&) = delete;
+
+        /**
+         * @brief Look up @p host, from the cache when possible.
+         * @param host Host name or numeric IPv4 or IPv6 address.
+         * @param ttl Oldest cached answer the caller accepts; zero always starts or joins a fresh lookup.
+         * @return The lookup; never nullptr.
+         */
+        [[nodiscard]] HostLookupPtr resolve(const std::string& host, std::chrono::seconds ttl);
+
+        /**
+         * @brief Drop the cached answer for @p host, for example after connecting to it failed.
+         * A lookup still in flight is left to finish for the callers waiting on it.
+         * @param host Host name passed to resolve().
+         */
+        void forget(const std::string& host);
+
+        /// @brief Hosts with a cached answer or a lookup in flight.
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<HostLookup> lookup;
+            std::chrono::steady_clock::time_point resolvedAt;
+        };
+
+        HostResolver() = default;
+
+        /// Resolver thread: takes queued hosts one at a time until the resolver is destroyed.
+        void run(const std::stop_token& stopToken);
+
+        /// Publish the outcome of @p lookup; a failed lookup leaves the cache so the next resolve() tries again.
+        void complete(const std::string& host, const std::shared_ptr<HostLookup>& lookup, bool isResolved);
+
+        /**
+         * @brief Blocking getaddrinfo() lookup of the IPv4 and IPv6 addresses of @p host.
+         * @param host Host name to resolve.
+         * @param outAddresses Receives the numeric addresses, interleaved by family.
+         * @return False if the host has no address or the resolver failed.
+         */
+        static bool lookUp(const std::string& host, std::vector<std::string>& outAddresses);
+
+        mutable std::mutex m_mutex;
+        std::condition_variable_any m_queueCondition;
+        std::deque<std::pair<std::string, std::shared_ptr<HostLookup>>> m_queue;
+        std::unordered_map<std::string, Entry> m_entries;
+        /// Last member, so it is joined before the queue and cache it uses are destroyed.
+        std::jthread m_worker;
+    };
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
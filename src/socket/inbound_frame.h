@@ -0,0 +1,91 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "serialize/mqtt_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief One complete MQTT control packet cut from the inbound stream, with its fixed header already decoded.
+     * The bytes point into storage owned by the socket; they are only valid for the duration of the data callback.
+     *
+     * A PUBLISH over the inbound streaming threshold comes as a run of fragments instead, in order and with nothing
+     * in between: each holds the next bytes of the packet as they arrived, and repeats the packet's fixed header
+     * fields. The first starts at offset 0, so it begins with the fixed header.
+     */
+    struct InboundFrame
+    {
+        /// @brief The whole packet, fixed header included.
+        std::span<const std::uint8_t> bytes;
+
+        /// @brief First byte of the fixed header: packet type in the high nibble, flags in the low one.
+        std::uint8_t typeAndFlags = 0;
+
+        /// @brief Remaining Length from the fixed header.
+        std::uint32_t remainingLength = 0;
+
+        /// @brief Fixed header size in bytes: the type byte plus the Remaining Length field.
+        std::uint8_t headerSize = 0;
+
+        /// @brief Set when bytes is only part of the packet; see fragmentOffset.
+        bool isFragment = false;
+
+        /// @brief Fragments only: offset of bytes within the packet.
+        std::uint32_t fragmentOffset = 0;
+
+        /// @brief Size of the whole packet, fixed header included.
+        [[nodiscard]] size_t getPacketSize() const
+        {
+            return headerSize + static_cast<size_t>(remainingLength);
+        }
+
+        /// @brief Fragments only: whether bytes ends the packet.
+        [[nodiscard]] bool isLastFragment() const
+        {
+            return fragmentOffset + bytes.size() == getPacketSize();
+        }
+
+        /// @brief The variable header and payload, i.e. the bytes the Remaining Length covers.
+        [[nodiscard]] std::span<const std::uint8_t> getBody() const
+        {
+            return bytes.subspan(headerSize);
+        }
+
+        /**
+         * @brief Frame a buffer that holds exactly one packet, the way the socket frames its inbound stream.
+         * Used where bytes do not come through a socket, e.g. tests feeding a state directly.
+         * @param bytes The packet.
+         * @return The frame. When the fixed header is malformed or does not match the buffer size, only bytes is set,
+         * so the reserved packet type 0 makes decoding fail.
+         */
+        [[nodiscard]] static InboundFrame fromBytes(const std::span<const std::uint8_t> bytes)
+        {
+            InboundFrame frame{ bytes };
+            if (bytes.size() < 2)
+            {
+                return frame;
+            }
+
+            std::uint32_t remainingLength = 0;
+            size_t lengthSize = 0;
+            const serialize::VariableByteIntegerStatus status
+                = serialize::scanVariableByteInteger(bytes.subspan(1), remainingLength, lengthSize);
+            if (status != serialize::VariableByteIntegerStatus::Complete || 1U + lengthSize + remainingLength != bytes.size())
+            {
+                return frame;
+            }
+
+            frame.typeAndFlags = bytes[0];
+            frame.remainingLength = remainingLength;
+            frame.headerSize = static_cast<std::uint8_t>(1U + lengthSize);
+            return frame;
+        }
+    };
+} // namespace reactormq::socket
@@ -24,6 +24,9 @@ UE_POP_MACRO("UI")
 
 namespace reactormq::socket
 {
+    /// Size of the buffer OpenSSL reads ciphertext ahead into: room for four full records.
+    static constexpr int kReadAheadBytes = 64 * 1024;
+
     static int socketBioWrite(BIO* bio, const char* buffer, int length);
 
     static int socketBioRead(BIO* bio, char* buffer, int length);
@@ -178,7 +181,12 @@ namespace reactormq::socket
             return tcpResult;
         }
 
-        if (!initializeSslCommon())
+        return startTls(host, port);
+    }
+
+    int PlatformSecureSocket::startTls(const std::string& host, const std::uint16_t port)
+    {
+        if (!initializeSslCommon(host, port))
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: initializeSsl() failed");
             m_state.store(SocketState::Disconnected, std::memory_order_release);
@@ -196,6 +204,16 @@ namespace reactormq::socket
 
         BIO_set_data(m_bio, this);
         SSL_set_bio(m_ssl, m_bio, m_bio);
+        // Each BIO read takes whatever ciphertext the kernel has into OpenSSL's own read buffer, which it keeps and
+        // reuses, rather than a record header and then its body in two reads. SSL_read() then decrypts from there
+        // straight into the inbound ring.
+        SSL_set_default_read_buffer_len(m_ssl, kReadAheadBytes);
+        SSL_set_read_ahead(m_ssl, 1);
+        if (m_settings && m_settings->shouldOffloadTlsToKernel())
+        {
+            // The kernel can only encrypt for a descriptor OpenSSL writes to directly, not through this BIO.
+            REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSecureSocket: kernel TLS offload is not available with the BIO backend");
+        }
         SSL_set_connect_state(m_ssl);
 
         m_state.store(SocketState::SslConnecting, std::memory_order_release);
@@ -0,0 +1,172 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
+
+#include "socket/platform/poller.h"
+#include "util/logging/logging.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        constexpr size_t kMaxEventsPerWait = 256;
+
+        uint32_t toEpollEvents(const PollEvents interest)
+        {
+            uint32_t events = EPOLLRDHUP;
+            if (hasAnyEvent(interest, PollEvents::Readable))
+            {
+                events |= EPOLLIN;
+            }
+            if (hasAnyEvent(interest, PollEvents::Writable))
+            {
+                events |= EPOLLOUT;
+            }
+            return events;
+        }
+
+        PollEvents fromEpollEvents(const uint32_t events)
+        {
+            PollEvents result = PollEvents::None;
+            if ((events & (EPOLLIN | EPOLLRDHUP)) != 0)
+            {
+                result |= PollEvents::Readable;
+            }
+            if ((events & EPOLLOUT) != 0)
+            {
+                result |= PollEvents::Writable;
+            }
+            if ((events & (EPOLLERR | EPOLLHUP)) != 0)
+            {
+                result |= PollEvents::Error;
+            }
+            return result;
+        }
+    } // namespace
+
+    /**
+     * @brief Level-triggered epoll backend; readiness cost scales with ready handles, not registered ones.
+     */
+    class EpollPoller final : public Poller
+    {
+    public:
+        EpollPoller()
+            : m_epollDescriptor(epoll_create1(EPOLL_CLOEXEC))
+        {
+            if (m_epollDescriptor == -1)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "EpollPoller::EpollPoller() epoll_create1 failed (errno=%d)", errno);
+            }
+        }
+
+        ~EpollPoller() override
+        {
+            if (m_epollDescriptor != -1)
+            {
+                ::close(m_epollDescriptor);
+            }
+        }
+
+        EpollPoller(const EpollPoller&) = delete;
+
+        EpollPoller& operator=(const EpollPoller&) = delete;
+
+        [[nodiscard]] bool isValid() const
+        {
+            return m_epollDescriptor != -1;
+        }
+
+        size_t wait(const std::span<PollEvent> outEvents, const std::chrono::milliseconds timeout) override
+        {
+            if (outEvents.empty())
+            {
+                return 0;
+            }
+
+            m_events.resize(std::min(outEvents.size(), kMaxEventsPerWait));
+            const int ready = epoll_wait(m_epollDescriptor, m_events.data(), static_cast<int>(m_events.size()), static_cast<int>(timeout.count()));
+            if (ready < 0)
+            {
+                if (errno != EINTR)
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "EpollPoller::wait() epoll_wait failed (errno=%d)", errno);
+                }
+                return 0;
+            }
+
+            for (size_t i = 0; i < static_cast<size_t>(ready); ++i)
+            {
+                outEvents[i] = PollEvent{ m_events[i].data.u64, fromEpollEvents(m_events[i].events) };
+            }
+            return static_cast<size_t>(ready);
+        }
+
+        [[nodiscard]] const char* getBackendName() const override
+        {
+            return "epoll";
+        }
+
+    protected:
+        bool addHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            return control(EPOLL_CTL_ADD, handle, interest, token);
+        }
+
+        bool modifyHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            // The kernel drops closed descriptors on its own, so a reused handle must be added again.
+            if (control(EPOLL_CTL_MOD, handle, interest, token))
+            {
+                return true;
+            }
+            return errno == ENOENT && control(EPOLL_CTL_ADD, handle, interest, token);
+        }
+
+        void removeHandle(const SocketHandle handle) override
+        {
+            epoll_ctl(m_epollDescriptor, EPOLL_CTL_DEL, handle, nullptr);
+        }
+
+    private:
+        bool control(const int operation, const SocketHandle handle, const PollEvents interest, const std::uint64_t token) const
+        {
+            epoll_event event{};
+            event.events = toEpollEvents(interest);
+            event.data.u64 = token;
+            if (epoll_ctl(m_epollDescriptor, operation, handle, &event) == 0)
+            {
+                return true;
+            }
+
+            if (operation != EPOLL_CTL_MOD || errno != ENOENT)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Warn, "EpollPoller::control() epoll_ctl(op=%d, handle=%d) failed (errno=%d)", operation, handle, errno);
+            }
+            return false;
+        }
+
+        int m_epollDescriptor;
+        std::vector<epoll_event> m_events;
+    };
+
+    std::unique_ptr<Poller> createEpollPoller()
+    {
+        auto poller = std::make_unique<EpollPoller>();
+        if (!poller->isValid())
+        {
+            return nullptr;
+        }
+        return poller;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
@@ -0,0 +1,442 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
+
+#include "socket/platform/poller.h"
+#include "util/logging/logging.h"
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        constexpr std::uint32_t kSubmissionEntries = 256;
+        constexpr std::uint32_t kCompletionEntries = 4096;
+
+        /// @brief user_data of POLL_REMOVE requests; their completions carry no readiness.
+        constexpr std::uint64_t kRemoveUserData = ~std::uint64_t{ 0 };
+
+        int enterRing(const int ringDescriptor, const std::uint32_t toSubmit, const std::uint32_t minComplete, const std::uint32_t flags, void* arg, const size_t argSize)
+        {
+            return static_cast<int>(syscall(__NR_io_uring_enter, ringDescriptor, toSubmit, minComplete, flags, arg, argSize));
+        }
+
+        std::uint32_t toPollMask(const PollEvents interest)
+        {
+            std::uint32_t mask = POLLRDHUP;
+            if (hasAnyEvent(interest, PollEvents::Readable))
+            {
+                mask |= POLLIN;
+            }
+            if (hasAnyEvent(interest, PollEvents::Writable))
+            {
+                mask |= POLLOUT;
+            }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            mask = (mask << 16) | (mask >> 16); // the kernel reads poll32_events as little-endian halves
+#endif
+            return mask;
+        }
+
+        PollEvents fromPollResult(const std::int32_t result)
+        {
+            if (result < 0)
+            {
+                return PollEvents::Error;
+            }
+
+            PollEvents events = PollEvents::None;
+            if ((result & (POLLIN | POLLRDHUP)) != 0)
+            {
+                events |= PollEvents::Readable;
+            }
+            if ((result & POLLOUT) != 0)
+            {
+                events |= PollEvents::Writable;
+            }
+            if ((result & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+            {
+                events |= PollEvents::Error;
+            }
+            return events;
+        }
+    } // namespace
+
+    /**
+     * @brief io_uring backend built on one-shot POLL_ADD requests.
+     *
+     * Interest changes and re-arms are only queued in the submission ring; wait() submits the whole batch and reaps
+     * completions in a single io_uring_enter, so one syscall per loop iteration serves every registered socket.
+     * Each completion re-arms its handle on the next wait, which keeps the level-triggered contract of Poller.
+     * A generation number in user_data discards completions from requests that were replaced or cancelled.
+     */
+    class IoUringPoller final : public Poller
+    {
+    public:
+        IoUringPoller()
+        {
+            io_uring_params params{};
+            params.flags = IORING_SETUP_CQSIZE;
+            params.cq_entries = kCompletionEntries;
+
+            m_ringDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, kSubmissionEntries, &params));
+            if (m_ringDescriptor < 0)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Info, "IoUringPoller::IoUringPoller() io_uring_setup failed (errno=%d)", errno);
+                m_ringDescriptor = -1;
+                return;
+            }
+
+            if ((params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_NODROP) == 0)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Info, "IoUringPoller::IoUringPoller() kernel lacks EXT_ARG/NODROP (features=0x%x)", params.features);
+                closeRing();
+                return;
+            }
+
+            if (!mapRings(params))
+            {
+                closeRing();
+            }
+        }
+
+        ~IoUringPoller() override
+        {
+            closeRing();
+        }
+
+        IoUringPoller(const IoUringPoller&) = delete;
+
+        IoUringPoller& operator=(const IoUringPoller&) = delete;
+
+        [[nodiscard]] bool isValid() const
+        {
+            return m_ringDescriptor != -1;
+        }
+
+        size_t wait(const std::span<PollEvent> outEvents, const std::chrono::milliseconds timeout) override
+        {
+            for (const SocketHandle handle : m_pendingArms)
+            {
+                armHandle(handle);
+            }
+            m_pendingArms.clear();
+
+            const auto timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+            __kernel_timespec ts{ timeoutNs / 1000000000, timeoutNs % 1000000000 };
+            io_uring_getevents_arg arg{};
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+
+            const std::uint32_t minComplete = timeout > std::chrono::milliseconds::zero() && getReadyCompletions() == 0 ? 1 : 0;
+            if (const int result = enterRing(m_ringDescriptor, getUnsubmitted(), minComplete, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+                result < 0 && errno != ETIME && errno != EINTR && errno != EBUSY)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Warn, "IoUringPoller::wait() io_uring_enter failed (errno=%d)", errno);
+            }
+
+            return reapCompletions(outEvents);
+        }
+
+        [[nodiscard]] const char* getBackendName() const override
+        {
+            return "io_uring";
+        }
+
+    protected:
+        bool addHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            HandleState& state = m_handles[handle];
+            state.token = token;
+            state.interest = interest;
+            state.generation = m_nextGeneration++;
+            m_pendingArms.push_back(handle);
+            return true;
+        }
+
+        bool modifyHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            HandleState& state = m_handles[handle];
+            cancelHandle(handle, state);
+            state.token = token;
+            state.interest = interest;
+            m_pendingArms.push_back(handle);
+            return true;
+        }
+
+        void removeHandle(const SocketHandle handle) override
+        {
+            if (const auto it = m_handles.find(handle); it != m_handles.end())
+            {
+                cancelHandle(handle, it->second);
+                m_handles.erase(it);
+            }
+        }
+
+    private:
+        struct HandleState
+        {
+            std::uint64_t token = 0;
+            PollEvents interest = PollEvents::None;
+            std::uint32_t generation = 0; ///< Matches user_data of the live request; never reused by the poller.
+            bool isArmed = false;
+        };
+
+        static std::uint64_t makeUserData(const SocketHandle handle, const std::uint32_t generation)
+        {
+            return (static_cast<std::uint64_t>(generation) << 32) | static_cast<std::uint32_t>(handle);
+        }
+
+        bool mapRings(const io_uring_params& params)
+        {
+            m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+            m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (isSingleMap)
+            {
+                m_submissionRingSize = std::max(m_submissionRingSize, m_completionRingSize);
+            }
+
+            m_submissionRing = mmap(nullptr, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_SQ_RING);
+            if (m_submissionRing == MAP_FAILED)
+            {
+                m_submissionRing = nullptr;
+                return false;
+            }
+
+            if (isSingleMap)
+            {
+                m_completionRing = m_submissionRing;
+                m_completionRingSize = 0;
+            }
+            else
+            {
+                m_completionRing = mmap(nullptr, m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_CQ_RING);
+                if (m_completionRing == MAP_FAILED)
+                {
+                    m_completionRing = nullptr;
+                    return false;
+                }
+            }
+
+            m_entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+            void* entries = mmap(nullptr, m_entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringDescriptor, IORING_OFF_SQES);
+            if (entries == MAP_FAILED)
+            {
+                return false;
+            }
+            m_submissionEntries = static_cast<io_uring_sqe*>(entries);
+
+            auto* submissionBase = static_cast<std::uint8_t*>(m_submissionRing);
+            m_submissionHead = reinterpret_cast<std::uint32_t*>(submissionBase + params.sq_off.head);
+            m_submissionTail = reinterpret_cast<std::uint32_t*>(submissionBase + params.sq_off.tail);
+            m_submissionMask = *reinterpret_cast<std::uint32_t*>(submissionBase + params.sq_off.ring_mask);
+            m_submissionCapacity = params.sq_entries;
+            auto* submissionArray = reinterpret_cast<std::uint32_t*>(submissionBase + params.sq_off.array);
+            for (std::uint32_t i = 0; i < params.sq_entries; ++i)
+            {
+                submissionArray[i] = i;
+            }
+            m_localTail = *m_submissionTail;
+
+            auto* completionBase = static_cast<std::uint8_t*>(m_completionRing);
+            m_completionHead = reinterpret_cast<std::uint32_t*>(completionBase + params.cq_off.head);
+            m_completionTail = reinterpret_cast<std::uint32_t*>(completionBase + params.cq_off.tail);
+            m_completionMask = *reinterpret_cast<std::uint32_t*>(completionBase + params.cq_off.ring_mask);
+            m_completions = reinterpret_cast<io_uring_cqe*>(completionBase + params.cq_off.cqes);
+            return true;
+        }
+
+        void closeRing()
+        {
+            if (nullptr != m_submissionEntries)
+            {
+                munmap(m_submissionEntries, m_entriesSize);
+                m_submissionEntries = nullptr;
+            }
+            if (nullptr != m_completionRing && m_completionRing != m_submissionRing)
+            {
+                munmap(m_completionRing, m_completionRingSize);
+            }
+            m_completionRing = nullptr;
+            if (nullptr != m_submissionRing)
+            {
+                munmap(m_submissionRing, m_submissionRingSize);
+                m_submissionRing = nullptr;
+            }
+            if (m_ringDescriptor != -1)
+            {
+                ::close(m_ringDescriptor);
+                m_ringDescriptor = -1;
+            }
+        }
+
+        [[nodiscard]] std::uint32_t getUnsubmitted() const
+        {
+            return m_localTail - std::atomic_ref(*m_submissionHead).load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] std::uint32_t getReadyCompletions() const
+        {
+            return std::atomic_ref(*m_completionTail).load(std::memory_order_acquire) - *m_completionHead;
+        }
+
+        io_uring_sqe* acquireEntry()
+        {
+            if (getUnsubmitted() == m_submissionCapacity)
+            {
+                // Ring full: flush the batch early rather than dropping the request.
+                enterRing(m_ringDescriptor, m_submissionCapacity, 0, 0, nullptr, 0);
+                if (getUnsubmitted() == m_submissionCapacity)
+                {
+                    return nullptr;
+                }
+            }
+
+            io_uring_sqe* entry = &m_submissionEntries[m_localTail & m_submissionMask];
+            std::memset(entry, 0, sizeof(*entry));
+            return entry;
+        }
+
+        void publishEntry()
+        {
+            ++m_localTail;
+            std::atomic_ref(*m_submissionTail).store(m_localTail, std::memory_order_release);
+        }
+
+        void armHandle(const SocketHandle handle)
+        {
+            const auto it = m_handles.find(handle);
+            if (it == m_handles.end() || it->second.isArmed)
+            {
+                return;
+            }
+
+            io_uring_sqe* entry = acquireEntry();
+            if (nullptr == entry)
+            {
+                m_retryArms.push_back(handle);
+                return;
+            }
+
+            HandleState& state = it->second;
+            entry->opcode = IORING_OP_POLL_ADD;
+            entry->fd = handle;
+            entry->poll32_events = toPollMask(state.interest);
+            entry->user_data = makeUserData(handle, state.generation);
+            publishEntry();
+            state.isArmed = true;
+        }
+
+        void cancelHandle(const SocketHandle handle, HandleState& state)
+        {
+            const std::uint32_t generation = state.generation;
+            state.generation = m_nextGeneration++;
+            if (!state.isArmed)
+            {
+                return;
+            }
+            state.isArmed = false;
+
+            if (io_uring_sqe* entry = acquireEntry(); nullptr != entry)
+            {
+                entry->opcode = IORING_OP_POLL_REMOVE;
+                entry->fd = -1;
+                entry->addr = makeUserData(handle, generation);
+                entry->user_data = kRemoveUserData;
+                publishEntry();
+            }
+        }
+
+        size_t reapCompletions(const std::span<PollEvent> outEvents)
+        {
+            size_t count = 0;
+            std::uint32_t head = *m_completionHead;
+            const std::uint32_t tail = std::atomic_ref(*m_completionTail).load(std::memory_order_acquire);
+            while (head != tail && count < outEvents.size())
+            {
+                const io_uring_cqe& completion = m_completions[head & m_completionMask];
+                ++head;
+
+                if (completion.user_data == kRemoveUserData)
+                {
+                    continue;
+                }
+
+                const auto handle = static_cast<SocketHandle>(static_cast<std::uint32_t>(completion.user_data));
+                const auto generation = static_cast<std::uint32_t>(completion.user_data >> 32);
+                const auto it = m_handles.find(handle);
+                if (it == m_handles.end() || it->second.generation != generation)
+                {
+                    continue; // completion of a request that was cancelled or replaced
+                }
+
+                it->second.isArmed = false;
+                m_pendingArms.push_back(handle);
+                if (completion.res == -ECANCELED)
+                {
+                    continue;
+                }
+                outEvents[count++] = PollEvent{ it->second.token, fromPollResult(completion.res) };
+            }
+            std::atomic_ref(*m_completionHead).store(head, std::memory_order_release);
+
+            m_pendingArms.insert(m_pendingArms.end(), m_retryArms.begin(), m_retryArms.end());
+            m_retryArms.clear();
+            return count;
+        }
+
+        int m_ringDescriptor = -1;
+
+        void* m_submissionRing = nullptr;
+        size_t m_submissionRingSize = 0;
+        void* m_completionRing = nullptr;
+        size_t m_completionRingSize = 0;
+        io_uring_sqe* m_submissionEntries = nullptr;
+        size_t m_entriesSize = 0;
+
+        std::uint32_t* m_submissionHead = nullptr;
+        std::uint32_t* m_submissionTail = nullptr;
+        std::uint32_t m_submissionMask = 0;
+        std::uint32_t m_submissionCapacity = 0;
+        std::uint32_t m_localTail = 0;
+
+        std::uint32_t* m_completionHead = nullptr;
+        std::uint32_t* m_completionTail = nullptr;
+        std::uint32_t m_completionMask = 0;
+        io_uring_cqe* m_completions = nullptr;
+
+        std::unordered_map<SocketHandle, HandleState> m_handles;
+        std::uint32_t m_nextGeneration = 0;
+        std::vector<SocketHandle> m_pendingArms; ///< Handles to (re-)arm before the next submission.
+        std::vector<SocketHandle> m_retryArms; ///< Arms that did not fit in a full submission ring.
+    };
+
+    std::unique_ptr<Poller> createIoUringPoller()
+    {
+        auto poller = std::make_unique<IoUringPoller>();
+        if (!poller->isValid())
+        {
+            return nullptr;
+        }
+        return poller;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
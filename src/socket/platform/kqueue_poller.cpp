@@ -0,0 +1,168 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_DARWIN_FAMILY
+
+#include "socket/platform/poller.h"
+#include "util/logging/logging.h"
+
+#include <sys/event.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        constexpr size_t kMaxEventsPerWait = 256;
+
+        void* toUserData(const std::uint64_t token)
+        {
+            return reinterpret_cast<void*>(static_cast<uintptr_t>(token));
+        }
+    } // namespace
+
+    /**
+     * @brief Level-triggered kqueue backend; read and write interest are separate filters on the same handle.
+     */
+    class KqueuePoller final : public Poller
+    {
+    public:
+        KqueuePoller()
+            : m_queueDescriptor(kqueue())
+        {
+            if (m_queueDescriptor == -1)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "KqueuePoller::KqueuePoller() kqueue failed (errno=%d)", errno);
+            }
+        }
+
+        ~KqueuePoller() override
+        {
+            if (m_queueDescriptor != -1)
+            {
+                ::close(m_queueDescriptor);
+            }
+        }
+
+        KqueuePoller(const KqueuePoller&) = delete;
+
+        KqueuePoller& operator=(const KqueuePoller&) = delete;
+
+        [[nodiscard]] bool isValid() const
+        {
+            return m_queueDescriptor != -1;
+        }
+
+        size_t wait(const std::span<PollEvent> outEvents, const std::chrono::milliseconds timeout) override
+        {
+            if (outEvents.empty())
+            {
+                return 0;
+            }
+
+            m_events.resize(std::min(outEvents.size(), kMaxEventsPerWait));
+            const auto timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+            const timespec ts{ static_cast<time_t>(timeoutNs / 1000000000), static_cast<decltype(timespec::tv_nsec)>(timeoutNs % 1000000000) };
+
+            const int ready = kevent(m_queueDescriptor, nullptr, 0, m_events.data(), static_cast<int>(m_events.size()), &ts);
+            if (ready < 0)
+            {
+                if (errno != EINTR)
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "KqueuePoller::wait() kevent failed (errno=%d)", errno);
+                }
+                return 0;
+            }
+
+            for (size_t i = 0; i < static_cast<size_t>(ready); ++i)
+            {
+                const struct kevent& event = m_events[i];
+                PollEvents events = PollEvents::None;
+                if (event.filter == EVFILT_READ)
+                {
+                    events |= PollEvents::Readable;
+                }
+                else if (event.filter == EVFILT_WRITE)
+                {
+                    events |= PollEvents::Writable;
+                }
+                if ((event.flags & EV_ERROR) != 0)
+                {
+                    events |= PollEvents::Error;
+                }
+                outEvents[i] = PollEvent{ static_cast<std::uint64_t>(reinterpret_cast<uintptr_t>(event.udata)), events };
+            }
+            return static_cast<size_t>(ready);
+        }
+
+        [[nodiscard]] const char* getBackendName() const override
+        {
+            return "kqueue";
+        }
+
+    protected:
+        bool addHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            return apply(handle, interest, token);
+        }
+
+        bool modifyHandle(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) override
+        {
+            return apply(handle, interest, token);
+        }
+
+        void removeHandle(const SocketHandle handle) override
+        {
+            struct kevent changes[2];
+            EV_SET(&changes[0], handle, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+            EV_SET(&changes[1], handle, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+            // ENOENT for a filter that was never added is expected; each change is applied independently.
+            for (struct kevent& change : changes)
+            {
+                kevent(m_queueDescriptor, &change, 1, nullptr, 0, nullptr);
+            }
+        }
+
+    private:
+        bool apply(const SocketHandle handle, const PollEvents interest, const std::uint64_t token) const
+        {
+            bool isApplied = true;
+            for (const auto [filter, flag] : { std::pair{ EVFILT_READ, PollEvents::Readable }, std::pair{ EVFILT_WRITE, PollEvents::Writable } })
+            {
+                const bool isWanted = hasAnyEvent(interest, flag);
+                struct kevent change;
+                EV_SET(&change, handle, filter, isWanted ? EV_ADD | EV_ENABLE : EV_DELETE, 0, 0, toUserData(token));
+                if (kevent(m_queueDescriptor, &change, 1, nullptr, 0, nullptr) == -1 && (isWanted || errno != ENOENT))
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "KqueuePoller::apply() kevent(handle=%d, filter=%d) failed (errno=%d)", handle, filter, errno);
+                    isApplied = isApplied && !isWanted;
+                }
+            }
+            return isApplied;
+        }
+
+        int m_queueDescriptor;
+        std::vector<struct kevent> m_events;
+    };
+
+    std::unique_ptr<Poller> createKqueuePoller()
+    {
+        auto poller = std::make_unique<KqueuePoller>();
+        if (!poller->isValid())
+        {
+            return nullptr;
+        }
+        return poller;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_DARWIN_FAMILY
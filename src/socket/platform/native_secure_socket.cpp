@@ -40,7 +40,12 @@ namespace reactormq::socket
             return tcpResult;
         }
 
-        if (!initializeSslCommon())
+        return startTls(host, port);
+    }
+
+    int PlatformSecureSocket::startTls(const std::string& host, const std::uint16_t port)
+    {
+        if (!initializeSslCommon(host, port))
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: initializeSsl() failed");
             m_state.store(SocketState::Disconnected, std::memory_order_release);
@@ -55,6 +60,17 @@ namespace reactormq::socket
             return -1;
         }
 
+        if (m_settings && m_settings->shouldOffloadTlsToKernel())
+        {
+#if defined(SSL_OP_ENABLE_KTLS)
+            // OpenSSL installs the keys in the kernel once the handshake is done, and keeps encrypting in user space
+            // itself if the kernel or the negotiated cipher cannot take them.
+            SSL_set_options(m_ssl, SSL_OP_ENABLE_KTLS);
+#else
+            REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSecureSocket: kernel TLS offload requested, but OpenSSL has no kTLS support");
+#endif // SSL_OP_ENABLE_KTLS
+        }
+
         SSL_set_connect_state(m_ssl);
         m_state.store(SocketState::SslConnecting, std::memory_order_release);
 
@@ -8,8 +8,10 @@
 
 #include "reactormq/mqtt/connection_settings.h"
 #include "socket/platform/platform_socket.h"
-#include "socket/platform/trust_anchor_set.h"
+#include "socket/platform/tls_context_cache.h"
+#include "socket/tls_tuning.h"
 #include "util/logging/logging.h"
+#include "util/trace/trace.h"
 
 #include <algorithm>
 
@@ -78,6 +80,26 @@ namespace reactormq::socket
          */
         int connect(const std::string& host, std::uint16_t port) override;
 
+        /**
+         * @brief Take over a TCP connection that won a connection race and begin the TLS handshake on it.
+         * @param connected Socket whose TCP connect was started; left without a handle.
+         * @param host The broker's host name.
+         * @param port Remote port.
+         * @return 0 on success (TLS initialized), negative on failure.
+         */
+        int adoptConnection(PlatformSocket& connected, const std::string& host, const std::uint16_t port) override
+        {
+            if (m_state.load(std::memory_order_acquire) != SocketState::Disconnected)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSecureSocket::adoptConnection() called but already connecting/connected");
+                return -1;
+            }
+
+            PlatformSocket::adoptConnection(connected, host, port);
+            m_state.store(SocketState::Connecting, std::memory_order_release);
+            return startTls(host, port);
+        }
+
         /**
          * @brief Close the secure connection and free SSL resources.
          *
@@ -112,6 +134,12 @@ namespace reactormq::socket
 
                 if (hasSslHandshakeComplete())
                 {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Debug,
+                        "PlatformSecureSocket: handshake complete (%s, session %s, kTLS %s)",
+                        SSL_get_version(m_ssl),
+                        SSL_session_reused(m_ssl) == 1 ? "resumed" : "new",
+                        getKernelTlsDescription());
                     m_state.store(SocketState::Connected, std::memory_order_release);
                     return true;
                 }
@@ -142,7 +170,8 @@ namespace reactormq::socket
                 return false;
             }
 
-            const int result = SSL_read(m_ssl, outData, static_cast<int>(bufferSize));
+            const int result = readSsl(outData, bufferSize);
+            m_isReadBlocked = result <= 0;
             if (result > 0)
             {
                 bytesRead = result;
@@ -211,9 +240,20 @@ namespace reactormq::socket
                 return false;
             }
 
-            const int result = SSL_write(m_ssl, data, static_cast<int>(size));
+            TlsRecordSizer::Clock::time_point now{};
+            if (m_recordSizer.isEnabled())
+            {
+                now = TlsRecordSizer::Clock::now();
+                setRecordSize(m_recordSizer.getRecordSize(now));
+            }
+
+            const int result = writeSsl(data, static_cast<int>(size));
             if (result > 0)
             {
+                if (m_recordSizer.isEnabled())
+                {
+                    m_recordSizer.onSent(static_cast<size_t>(result), now);
+                }
                 bytesSent = result;
                 return true;
             }
@@ -229,6 +269,21 @@ namespace reactormq::socket
             return false;
         }
 
+        /**
+         * @brief Send several plaintext buffers through the secure connection.
+         *
+         * OpenSSL has no gathered write, so each buffer goes through SSL_write() in turn; the TLS layer copies the
+         * plaintext into its record buffer either way.
+         *
+         * @param buffers Regions to send, in order.
+         * @param bytesSent Reference that will be set to the number of plaintext bytes accepted.
+         * @return true if successful (may send fewer bytes than requested), false on error.
+         */
+        bool trySendVectored(const std::span<const SendBuffer> buffers, size_t& bytesSent) const override
+        {
+            return trySendSequentially(buffers, bytesSent);
+        }
+
         /**
          * @brief Get the number of bytes available to read without blocking.
          *
@@ -257,9 +312,97 @@ namespace reactormq::socket
             return static_cast<int>(pendingData);
         }
 
+        /**
+         * @brief Whether a read would return data without the socket becoming readable.
+         * True for decrypted bytes, and for ciphertext read ahead from the socket but not decrypted yet unless the
+         * last read stopped for want of more: then what is buffered is part of a record, which waits on the socket.
+         */
+        [[nodiscard]] bool hasBufferedInput() const override
+        {
+            return nullptr != m_ssl && (SSL_pending(m_ssl) > 0 || (!m_isReadBlocked && SSL_has_pending(m_ssl) == 1));
+        }
+
     private:
         mutable std::atomic<SocketState> m_state = SocketState::Disconnected;
 
+        /// SSL_read(); until the handshake finishes OpenSSL runs it from inside this call, so it is traced as such.
+        int readSsl(std::uint8_t* data, const int size) const
+        {
+            if (SSL_is_init_finished(m_ssl) == 0)
+            {
+                REACTORMQ_TRACE_SCOPE("PlatformSecureSocket::handshake");
+                return SSL_read(m_ssl, data, size);
+            }
+            return SSL_read(m_ssl, data, size);
+        }
+
+        /// SSL_write(), traced like readSsl() while the handshake is still running.
+        int writeSsl(const std::uint8_t* data, const int size) const
+        {
+            if (SSL_is_init_finished(m_ssl) == 0)
+            {
+                REACTORMQ_TRACE_SCOPE("PlatformSecureSocket::handshake");
+                return SSL_write(m_ssl, data, size);
+            }
+            return SSL_write(m_ssl, data, size);
+        }
+
+        /// Cap the plaintext of the records the next writes make; OpenSSL also keeps under a negotiated fragment length.
+        void setRecordSize(const std::uint32_t recordSize) const
+        {
+            if (recordSize != m_recordSize)
+            {
+                SSL_set_max_send_fragment(m_ssl, recordSize);
+                m_recordSize = recordSize;
+            }
+        }
+
+        /**
+         * @brief Apply the settings' TlsTuningOptions to the new SSL: cipher order, the Maximum Fragment Length
+         * request and the record sizer. A setting the library rejects is logged and left at the context's value.
+         */
+        void applyTlsTuning()
+        {
+            m_recordSizer = TlsRecordSizer{};
+            m_recordSize = kMaxTlsRecordSize;
+            if (!m_settings)
+            {
+                return;
+            }
+
+            const mqtt::TlsTuningOptions& tuning = m_settings->getTlsTuning();
+            if (const mqtt::TlsCipherPreference preference = resolveCipherPreference(tuning.cipherPreference);
+                preference != mqtt::TlsCipherPreference::LibraryDefault)
+            {
+                if (SSL_set_ciphersuites(m_ssl, getTls13CipherSuites(preference)) != 1
+                    || SSL_set_cipher_list(m_ssl, getTls12CipherList(preference)) != 1)
+                {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Warn,
+                        "PlatformSecureSocket: cipher order not applied: %s",
+                        getLastSslErrorString().c_str());
+                }
+            }
+
+            if (tuning.maxFragmentLength != 0)
+            {
+                bool isRequested = false;
+#if defined(TLSEXT_max_fragment_length_512)
+                const std::uint8_t code = getMaxFragmentLengthCode(tuning.maxFragmentLength);
+                isRequested = code != 0 && SSL_set_tlsext_max_fragment_length(m_ssl, code) == 1;
+#endif // TLSEXT_max_fragment_length_512
+                if (!isRequested)
+                {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Warn,
+                        "PlatformSecureSocket: maximum fragment length %u not requested (512, 1024, 2048 or 4096)",
+                        static_cast<unsigned>(tuning.maxFragmentLength));
+                }
+            }
+
+            m_recordSizer = TlsRecordSizer{ tuning };
+        }
+
         /**
          * @brief OpenSSL certificate verification callback.
          *
@@ -304,20 +447,7 @@ namespace reactormq::socket
                 return result;
             }
 
-            const SSL_CTX* sslCtx = SSL_get_SSL_CTX(ssl);
-            if (sslCtx == nullptr)
-            {
-                REACTORMQ_LOG(
-                    logging::LogLevel::Warn,
-                    "verifyCertificateCallback: no SSL_CTX (depth %d, subject %s, err %d: %s)",
-                    depth,
-                    subjectName.c_str(),
-                    err,
-                    X509_verify_cert_error_string(err));
-                return result;
-            }
-
-            const auto* optsPtr = static_cast<mqtt::ConnectionSettingsPtr*>(SSL_CTX_get_ex_data(sslCtx, s_settingsExDataIndex));
+            const auto* optsPtr = static_cast<mqtt::ConnectionSettingsPtr*>(SSL_get_ex_data(ssl, getSettingsExDataIndex()));
 
             if (optsPtr == nullptr || nullptr == *optsPtr)
             {
@@ -410,88 +540,56 @@ namespace reactormq::socket
             return result;
         }
 
-        bool initializeSslCommon()
+        /**
+         * @brief Create the SSL object for a connection to @p host:@p port from the shared context.
+         *
+         * Offers the session saved by an earlier connection to the same peer, so a reconnect can skip the full
+         * handshake.
+         */
+        bool initializeSslCommon(const std::string& host, const std::uint16_t port)
         {
-            OPENSSL_init_ssl(OPENSSL_INIT_LOAD_SSL_STRINGS | OPENSSL_INIT_LOAD_CRYPTO_STRINGS, nullptr);
-
-            m_sslCtx = SSL_CTX_new(TLS_client_method());
+            const bool verify = m_settings && m_settings->shouldVerifyServerCertificate();
+            m_sslCtx = TlsContextCache::instance().acquire(TlsContextKey{ verify });
             if (nullptr == m_sslCtx)
             {
-                REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: SSL_CTX_new failed: %s", getLastSslErrorString().c_str());
+                REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: no SSL_CTX: %s", getLastSslErrorString().c_str());
                 return false;
             }
 
-            SSL_CTX_set_mode(m_sslCtx, SSL_MODE_AUTO_RETRY);
-            SSL_CTX_set_min_proto_version(m_sslCtx, TLS1_2_VERSION);
-
-            if (m_settings && m_settings->shouldVerifyServerCertificate())
+            m_ssl = SSL_new(m_sslCtx.get());
+            if (nullptr == m_ssl)
             {
-                if (s_settingsExDataIndex < 0)
-                {
-                    s_settingsExDataIndex = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
-                }
+                REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: SSL_new failed: %s", getLastSslErrorString().c_str());
+                cleanupSsl();
+                return false;
+            }
+
+            applyTlsTuning();
+
+            // Keyed by the broker's name rather than the resolved address @p host, which may change between connects.
+            m_sessionPeer = (m_settings ? m_settings->getHost() : host) + ":" + std::to_string(port);
+            TlsContextCache::instance().prepareResumption(m_ssl, m_sessionPeer);
 
-                if (s_settingsExDataIndex >= 0)
+            // The context is shared with every other client, so anything specific to this connection goes on the SSL.
+            if (verify)
+            {
+                if (const int index = getSettingsExDataIndex(); index >= 0)
                 {
-                    SSL_CTX_set_ex_data(m_sslCtx, s_settingsExDataIndex, &m_settings);
+                    SSL_set_ex_data(m_ssl, index, &m_settings);
                 }
 
                 REACTORMQ_LOG(logging::LogLevel::Info, "PlatformSecureSocket: should verify certs");
+                SSL_set_verify(m_ssl, SSL_VERIFY_PEER, verifyCertificateCallback);
 
-                if (const TrustAnchorSet trustAnchors; !trustAnchors.empty())
-                {
-                    if (!trustAnchors.attachTo(m_sslCtx))
-                    {
-                        REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSecureSocket: failed to attach trust anchors to SSL_CTX");
-                    }
-                }
-                else
+                // A reconnect presenting a leaf this client accepted recently skips chain building and the user callback.
+                m_chainVerifier.reset();
+                if (m_settings && nullptr != m_settings->getSslVerifyCallback())
                 {
-                    if (SSL_CTX_set_default_verify_paths(m_sslCtx) != 1)
-                    {
-                        REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSecureSocket: failed to set default verify paths");
-                    }
+                    m_chainVerifier = m_settings;
                 }
-                SSL_CTX_set_verify(m_sslCtx, SSL_VERIFY_PEER, verifyCertificateCallback);
-            }
-            // If verification flags are not modified explicitly by SSL_CTX_set_verify()
-            // or SSL_set_verify(), the default value will be SSL_VERIFY_NONE
-            // else
-            // {
-            //     SSL_CTX_set_verify(m_sslCtx, SSL_VERIFY_NONE, nullptr);
-            // }
-
-            const auto cipherList
-                = "HIGH:"
-                  "!aNULL:"
-                  "!eNULL:"
-                  "!EXPORT:"
-                  "!DES:"
-                  "!RC4:"
-                  "!MD5:"
-                  "!PSK:"
-                  "!SRP:"
-                  "!CAMELLIA:"
-                  "!SEED:"
-                  "!IDEA:"
-                  "!3DES";
-
-            SSL_CTX_set_cipher_list(m_sslCtx, cipherList);
-
-            const auto cipherSuites
-                = "TLS_AES_256_GCM_SHA384:"
-                  "TLS_CHACHA20_POLY1305_SHA256:"
-                  "TLS_AES_128_GCM_SHA256";
-
-            SSL_CTX_set_ciphersuites(m_sslCtx, cipherSuites);
-
-            m_ssl = SSL_new(m_sslCtx);
-            if (nullptr == m_ssl)
-            {
-                REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSecureSocket: SSL_new failed: %s", getLastSslErrorString().c_str());
-                cleanupSsl();
-                return false;
+                TlsContextCache::prepareVerification(m_ssl, m_chainVerifier);
             }
+            // Without SSL_set_verify() the mode stays SSL_VERIFY_NONE.
 
             return true;
         }
@@ -506,11 +604,7 @@ namespace reactormq::socket
                 m_bio = nullptr;
             }
 
-            if (nullptr != m_sslCtx)
-            {
-                SSL_CTX_free(m_sslCtx);
-                m_sslCtx = nullptr;
-            }
+            m_sslCtx.reset();
         }
 
         static std::string getLastSslErrorString() noexcept
@@ -527,18 +621,55 @@ namespace reactormq::socket
             return buf;
         }
 
+        /**
+         * @brief Create the SSL object for the TCP connection in progress and put it in client handshake mode.
+         * @return 0 on success, negative on failure; the state is left Disconnected on failure.
+         */
+        int startTls(const std::string& host, std::uint16_t port);
+
         [[nodiscard]] bool hasSslHandshakeComplete() const;
 
+        /// @brief Which directions the kernel encrypts for this connection: "off", "tx", "rx" or "tx+rx".
+        [[nodiscard]] const char* getKernelTlsDescription() const
+        {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+            const bool send = BIO_get_ktls_send(SSL_get_wbio(m_ssl)) != 0;
+            const bool receive = BIO_get_ktls_recv(SSL_get_rbio(m_ssl)) != 0;
+            if (send || receive)
+            {
+                return send && receive ? "tx+rx" : send ? "tx" : "rx";
+            }
+#endif // SSL_OP_ENABLE_KTLS && !OPENSSL_NO_KTLS
+            return "off";
+        }
+
+        /// @brief SSL ex_data slot holding a pointer to the socket's settings, for verifyCertificateCallback.
+        static int getSettingsExDataIndex()
+        {
+            static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+        }
+
         static constexpr int32_t kPreverifyFailed{ 0 };
         static constexpr int32_t kPreverifySuccess{ 1 };
         mqtt::ConnectionSettingsPtr m_settings;
-        SSL_CTX* m_sslCtx{ nullptr };
+        SslContextPtr m_sslCtx;
+        /// "host:port" the connection's TLS sessions are saved under; referenced by the SSL, so outlives it.
+        std::string m_sessionPeer;
+        /// Verifier the connection's chain verifications are remembered under: the settings when they carry a user
+        /// verify callback, else none; referenced by the SSL, so outlives it.
+        std::shared_ptr<const void> m_chainVerifier;
         SSL* m_ssl{ nullptr };
+        /// Record sizes of the connection's writes; off unless the settings ask for dynamic record sizing.
+        mutable TlsRecordSizer m_recordSizer;
+        /// Record size last handed to SSL_set_max_send_fragment().
+        mutable std::uint32_t m_recordSize{ kMaxTlsRecordSize };
+        /// The last SSL_read() returned nothing, so whatever OpenSSL still buffers is an incomplete record.
+        mutable bool m_isReadBlocked{ false };
 #if defined(REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS)
         BIO* m_bio{ nullptr };
 #endif
 
-        static inline int32_t s_settingsExDataIndex{ -1 };
     };
 } // namespace reactormq::socket
 
@@ -4,16 +4,31 @@
 
 #pragma once
 
+#include "reactormq/mqtt/socket_options.h"
 #include "socket/platform/platform.h"
+#include "socket/send_buffer.h"
 #include "socket/socket_state.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <span>
 #include <string>
+#include <utility>
 
 namespace reactormq::socket
 {
     enum class ReceiveFlags : std::uint32_t;
     enum class SocketError;
+    class WakeupHandle;
+
+    /// @brief IP version of a socket and of the addresses it can connect to.
+    enum class AddressFamily : std::uint8_t
+    {
+        IPv4,
+        IPv6,
+        Local ///< Unix domain socket, for a broker on the same host; POSIX platforms only.
+    };
 
     /**
      * @brief Thin wrapper around a platform socket handle.
@@ -29,17 +44,72 @@ namespace reactormq::socket
             PlatformSocket::close();
         }
 
-        virtual bool createSocket();
+        /**
+         * @brief Create the non-blocking TCP socket handle.
+         * @param family Family of the addresses the socket will connect to; platforms without IPv6 ignore it. TCP options
+         * are not applied to a Local socket.
+         * @return False if the handle could not be created.
+         */
+        virtual bool createSocket(AddressFamily family = AddressFamily::IPv4);
+
+        /**
+         * @brief Set the TCP options the next createSocket() applies; a handle that already exists keeps its own.
+         * @param options Socket options, usually ConnectionSettings::getSocketOptions().
+         */
+        void setOptions(const mqtt::SocketOptions& options)
+        {
+            m_options = options;
+        }
 
         /**
          * @brief Initiate connection to the remote host.
          *
+         * A handle created up front is replaced if the host's address is of the other family.
+         *
          * @param host The remote host address or hostname.
          * @param port The remote port number.
          * @return 0 on success, or a negative value on failure.
          */
         virtual int connect(const std::string& host, std::uint16_t port);
 
+        /**
+         * @brief Initiate a connection to a broker's Unix domain socket, which skips the TCP/IP stack entirely.
+         * Replaces any handle created up front. Platforms without Unix domain sockets fail with EAFNOSUPPORT.
+         * @param path Filesystem path of the broker's socket.
+         * @return 0 on success, or a non-zero value on failure.
+         */
+        int connectLocal(const std::string& path);
+
+        /**
+         * @brief Take over the handle of a socket whose TCP connect won a connection race, then start this transport
+         * on it as connect() would.
+         *
+         * @param connected Socket whose connect() was started; left without a handle.
+         * @param host The broker's host name, for transports that need it.
+         * @param port The remote port number.
+         * @return 0 on success, or a negative value on failure.
+         */
+        virtual int adoptConnection(PlatformSocket& connected, const std::string& host, std::uint16_t port)
+        {
+            (void)host;
+            (void)port;
+            PlatformSocket::close();
+            m_socket = std::exchange(connected.m_socket, kInvalidSocketHandle);
+            m_addressFamily = connected.m_addressFamily;
+            m_state.store(connected.m_state.exchange(SocketState::Disconnected, std::memory_order_acq_rel), std::memory_order_release);
+            return 0;
+        }
+
+        /**
+         * @brief Whether the connect() in progress is known to have failed, as seen by the last isConnected() call.
+         * Platforms that cannot tell keep reporting false until the caller's own timeout gives up.
+         * @return True once the attempt failed or the socket was closed.
+         */
+        [[nodiscard]] bool hasConnectFailed() const
+        {
+            return m_state.load(std::memory_order_acquire) == SocketState::Disconnected;
+        }
+
         /**
          * @brief Close the socket connection.
          *
@@ -84,6 +154,30 @@ namespace reactormq::socket
          */
         virtual bool trySend(const uint8_t* data, uint32_t size, size_t& bytesSent) const;
 
+        /**
+         * @brief Send several buffers with a single gathered write (sendmsg/WSASend) where the platform has one.
+         *
+         * Platforms without a gathered write send the buffers in order and stop at the first short write.
+         *
+         * @param buffers Regions to send, in order; at most kMaxSendBuffers are written per call.
+         * @param bytesSent Set to the total number of bytes written to the socket.
+         * @return True if the call completed (bytesSent may be less than the total); false on error or closed connection.
+         */
+        virtual bool trySendVectored(std::span<const SendBuffer> buffers, size_t& bytesSent) const;
+
+        /**
+         * @brief Block until the socket is readable (or writable, if requested), the wakeup is signalled, or the
+         * timeout elapses.
+         *
+         * Where the wakeup exposes a selectable descriptor it is waited on together with the socket; otherwise the
+         * wait is taken in short slices and the wakeup is checked between them.
+         *
+         * @param wakeup Cross-thread wakeup that ends the wait early.
+         * @param wantWrite Also return when the socket becomes writable (pending output or connect in progress).
+         * @param timeout Maximum time to block.
+         */
+        virtual void waitForIo(const WakeupHandle& wakeup, bool wantWrite, std::chrono::milliseconds timeout) const;
+
         /**
          * @brief Get the last socket error in normalized form.
          *
@@ -158,12 +252,10 @@ namespace reactormq::socket
          */
         static void shutdownNetworking();
 
-    protected:
         /**
          * @brief Get the underlying socket handle.
          *
-         * This method is protected to allow derived classes (e.g., PlatformSecureSocket)
-         * direct access to the socket descriptor for TLS operations.
+         * Used by PlatformSecureSocket for TLS operations and by readiness pollers to register the socket.
          *
          * @return The platform-specific socket handle.
          */
@@ -172,11 +264,59 @@ namespace reactormq::socket
             return m_socket;
         }
 
+        /**
+         * @brief Whether bytes are buffered above the kernel socket (for example decrypted TLS records).
+         * Such bytes never make the handle readable, so pollers must not wait on a socket that has them.
+         * @return True if a read would return data without the handle becoming readable.
+         */
+        [[nodiscard]] virtual bool hasBufferedInput() const
+        {
+            return false;
+        }
+
+    protected:
+        /**
+         * @brief Vectored send built from trySend(), for transports without a gathered write.
+         * @param buffers Regions to send, in order.
+         * @param bytesSent Set to the total number of bytes written.
+         * @return False if a trySend() call failed before anything was written.
+         */
+        bool trySendSequentially(const std::span<const SendBuffer> buffers, size_t& bytesSent) const
+        {
+            bytesSent = 0;
+            for (const SendBuffer& buffer : buffers)
+            {
+                if (buffer.size == 0)
+                {
+                    continue;
+                }
+
+                const auto chunkSize = static_cast<uint32_t>(std::min(buffer.size, static_cast<size_t>(UINT32_MAX)));
+                size_t sent = 0;
+                if (!trySend(buffer.data, chunkSize, sent))
+                {
+                    // Report the bytes that did go out; the caller sees the error on its next call.
+                    return bytesSent > 0;
+                }
+
+                bytesSent += sent;
+                if (sent < chunkSize || chunkSize < buffer.size)
+                {
+                    break;
+                }
+            }
+            return true;
+        }
+
     private:
         mutable std::atomic<SocketState> m_state = SocketState::Disconnected;
 
         SocketHandle m_socket{ kInvalidSocketHandle };
 
+        AddressFamily m_addressFamily = AddressFamily::IPv4; ///< Family the current handle was created for.
+
+        mqtt::SocketOptions m_options; ///< Applied by createSocket().
+
         /**
          * @brief Convert a platform error code to a normalized SocketError.
          * @param platformCode Platform-specific error code.
@@ -0,0 +1,166 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/platform/platform.h"
+
+#if REACTORMQ_SOCKET_WITH_WINSOCKET || (REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_SOCKET_WITH_POLL)
+
+#include "socket/platform/poller.h"
+#include "util/logging/logging.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+#include <cerrno>
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
+namespace reactormq::socket
+{
+    namespace
+    {
+#if REACTORMQ_SOCKET_WITH_WINSOCKET
+        using PollDescriptor = WSAPOLLFD;
+        constexpr short kReadEvents = POLLRDNORM;
+        constexpr short kWriteEvents = POLLWRNORM;
+        constexpr const char* kBackendName = "WSAPoll";
+
+        int pollDescriptors(PollDescriptor* descriptors, const size_t count, const int timeoutMs)
+        {
+            return WSAPoll(descriptors, static_cast<ULONG>(count), timeoutMs);
+        }
+
+        bool isInterrupted()
+        {
+            return false;
+        }
+
+        int32_t getLastPollError()
+        {
+            return WSAGetLastError();
+        }
+#else
+        using PollDescriptor = pollfd;
+        constexpr short kReadEvents = POLLIN;
+        constexpr short kWriteEvents = POLLOUT;
+        constexpr const char* kBackendName = "poll";
+
+        int pollDescriptors(PollDescriptor* descriptors, const size_t count, const int timeoutMs)
+        {
+            return ::poll(descriptors, static_cast<nfds_t>(count), timeoutMs);
+        }
+
+        bool isInterrupted()
+        {
+            return errno == EINTR;
+        }
+
+        int32_t getLastPollError()
+        {
+            return errno;
+        }
+#endif // REACTORMQ_SOCKET_WITH_WINSOCKET
+    } // namespace
+
+    /**
+     * @brief Portable poll()/WSAPoll() backend. The descriptor set is rebuilt from the registrations on every wait,
+     * so cost is linear in registered handles; used where neither epoll nor kqueue exist. IOCP is not used on
+     * Windows because it reports completions, not readiness, and the sockets here are non-blocking readiness-driven.
+     */
+    class PollPoller final : public Poller
+    {
+    public:
+        size_t wait(const std::span<PollEvent> outEvents, const std::chrono::milliseconds timeout) override
+        {
+            const auto& registrations = getRegistrations();
+            if (outEvents.empty() || registrations.empty())
+            {
+                // WSAPoll rejects an empty set, so both backends just sleep out the timeout.
+                std::this_thread::sleep_for(timeout);
+                return 0;
+            }
+
+            m_descriptors.clear();
+            m_tokens.clear();
+            for (const auto& [handle, registration] : registrations)
+            {
+                PollDescriptor descriptor{};
+                descriptor.fd = handle;
+                descriptor.events = static_cast<short>((hasAnyEvent(registration.interest, PollEvents::Readable) ? kReadEvents : 0)
+                                                       | (hasAnyEvent(registration.interest, PollEvents::Writable) ? kWriteEvents : 0));
+                m_descriptors.push_back(descriptor);
+                m_tokens.push_back(registration.token);
+            }
+
+            const int ready = pollDescriptors(m_descriptors.data(), m_descriptors.size(), static_cast<int>(timeout.count()));
+            if (ready <= 0)
+            {
+                if (ready < 0 && !isInterrupted())
+                {
+                    const int32_t code = getLastPollError();
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "PollPoller::wait() %s failed (errorCode=%d)", kBackendName, code);
+                }
+                return 0;
+            }
+
+            size_t count = 0;
+            for (size_t i = 0; i < m_descriptors.size() && count < outEvents.size(); ++i)
+            {
+                const short revents = m_descriptors[i].revents;
+                if (revents == 0)
+                {
+                    continue;
+                }
+
+                PollEvents events = PollEvents::None;
+                if ((revents & (kReadEvents | POLLHUP)) != 0)
+                {
+                    events |= PollEvents::Readable;
+                }
+                if ((revents & kWriteEvents) != 0)
+                {
+                    events |= PollEvents::Writable;
+                }
+                if ((revents & (POLLERR | POLLNVAL)) != 0)
+                {
+                    events |= PollEvents::Error;
+                }
+                outEvents[count++] = PollEvent{ m_tokens[i], events };
+            }
+            return count;
+        }
+
+        [[nodiscard]] const char* getBackendName() const override
+        {
+            return kBackendName;
+        }
+
+    protected:
+        bool addHandle(SocketHandle /*handle*/, PollEvents /*interest*/, std::uint64_t /*token*/) override
+        {
+            return true;
+        }
+
+        bool modifyHandle(SocketHandle /*handle*/, PollEvents /*interest*/, std::uint64_t /*token*/) override
+        {
+            return true;
+        }
+
+        void removeHandle(SocketHandle /*handle*/) override
+        {
+        }
+
+    private:
+        std::vector<PollDescriptor> m_descriptors;
+        std::vector<std::uint64_t> m_tokens;
+    };
+
+    std::unique_ptr<Poller> createPollPoller()
+    {
+        return std::make_unique<PollPoller>();
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SOCKET_WITH_WINSOCKET || (REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_SOCKET_WITH_POLL)
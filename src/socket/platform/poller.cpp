@@ -0,0 +1,77 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/platform/poller.h"
+
+#include "util/logging/logging.h"
+
+namespace reactormq::socket
+{
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
+    std::unique_ptr<Poller> createEpollPoller();
+#elif REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_DARWIN_FAMILY
+    std::unique_ptr<Poller> createKqueuePoller();
+#endif
+
+    bool Poller::setInterest(const SocketHandle handle, const PollEvents interest, const std::uint64_t token)
+    {
+        const auto it = m_registrations.find(handle);
+        if (it == m_registrations.end())
+        {
+            if (!addHandle(handle, interest, token))
+            {
+                return false;
+            }
+            m_registrations.emplace(handle, Registration{ interest, token });
+            return true;
+        }
+
+        if (it->second.token == token && it->second.interest == interest)
+        {
+            return true;
+        }
+
+        // A different token means the previous owner's handle was closed and the value reused; the backend has
+        // already dropped it, so modifyHandle() re-adds as needed.
+        if (!modifyHandle(handle, interest, token))
+        {
+            m_registrations.erase(it);
+            return false;
+        }
+        it->second = Registration{ interest, token };
+        return true;
+    }
+
+    void Poller::remove(const SocketHandle handle, const std::uint64_t token)
+    {
+        const auto it = m_registrations.find(handle);
+        if (it == m_registrations.end() || it->second.token != token)
+        {
+            return;
+        }
+
+        removeHandle(handle);
+        m_registrations.erase(it);
+    }
+
+    std::unique_ptr<Poller> createPoller()
+    {
+        std::unique_ptr<Poller> poller;
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
+        poller = createIoUringPoller();
+        if (nullptr == poller)
+        {
+            poller = createEpollPoller();
+        }
+#elif REACTORMQ_SOCKET_WITH_POSIX_SOCKET && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
+        poller = createEpollPoller();
+#elif REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_DARWIN_FAMILY
+        poller = createKqueuePoller();
+#elif REACTORMQ_SOCKET_WITH_WINSOCKET || (REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_SOCKET_WITH_POLL)
+        poller = createPollPoller();
+#endif
+        REACTORMQ_LOG(logging::LogLevel::Debug, "createPoller() backend=%s", poller ? poller->getBackendName() : "none");
+        return poller;
+    }
+} // namespace reactormq::socket
@@ -0,0 +1,172 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "socket/platform/platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Readiness conditions a poller can wait for or report.
+     */
+    enum class PollEvents : std::uint8_t
+    {
+        None = 0,
+        Readable = 1 << 0, ///< Data (or EOF) can be read without blocking.
+        Writable = 1 << 1, ///< Data can be written without blocking; also signals connect completion.
+        Error = 1 << 2, ///< Error or hang-up; reported only, never requested.
+    };
+
+    /**
+     * @brief Bitwise OR operator for PollEvents.
+     */
+    constexpr PollEvents operator|(PollEvents lhs, PollEvents rhs)
+    {
+        return static_cast<PollEvents>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+    }
+
+    /**
+     * @brief Bitwise AND operator for PollEvents.
+     */
+    constexpr PollEvents operator&(PollEvents lhs, PollEvents rhs)
+    {
+        return static_cast<PollEvents>(static_cast<std::uint8_t>(lhs) & static_cast<std::uint8_t>(rhs));
+    }
+
+    /**
+     * @brief Bitwise OR assignment operator for PollEvents.
+     */
+    constexpr PollEvents& operator|=(PollEvents& lhs, const PollEvents rhs)
+    {
+        lhs = lhs | rhs;
+        return lhs;
+    }
+
+    /**
+     * @brief Check if any of the given events are set.
+     */
+    constexpr bool hasAnyEvent(const PollEvents events, const PollEvents mask)
+    {
+        return (events & mask) != PollEvents::None;
+    }
+
+    /**
+     * @brief One readiness notification returned by Poller::wait().
+     */
+    struct PollEvent
+    {
+        std::uint64_t token = 0; ///< Caller-supplied token from setInterest().
+        PollEvents events = PollEvents::None; ///< Conditions that are ready.
+    };
+
+    /**
+     * @brief What a socket wants a poller to watch, as reported by Socket::getPollRegistration().
+     */
+    struct PollRegistration
+    {
+        SocketHandle handle = kInvalidSocketHandle; ///< Handle to poll; invalid when the socket cannot be polled.
+        PollEvents interest = PollEvents::None; ///< Conditions the socket is waiting for.
+        bool hasBufferedInput = false; ///< Input is already buffered in user space; do not wait on the handle.
+    };
+
+    /**
+     * @brief Readiness poller over many socket handles (io_uring, epoll, kqueue, WSAPoll or poll, depending on platform).
+     *
+     * Registrations are level-triggered and identified by a caller-chosen token. The poller remembers which token
+     * owns each handle, so a stale remove() for a handle that was closed and reused by another owner is ignored.
+     * A poller is not thread-safe; it belongs to the one thread that waits on it.
+     */
+    class Poller
+    {
+    public:
+        virtual ~Poller() = default;
+
+        /**
+         * @brief Register a handle or change what it is polled for.
+         * @param handle Socket (or wakeup) handle.
+         * @param interest Conditions to wait for (Readable and/or Writable).
+         * @param token Value reported back in PollEvent::token.
+         * @return False if the backend rejected the handle.
+         */
+        bool setInterest(SocketHandle handle, PollEvents interest, std::uint64_t token);
+
+        /**
+         * @brief Stop polling a handle, if it is still registered to the given token.
+         * @param handle Handle passed to setInterest().
+         * @param token Token that registered it.
+         */
+        void remove(SocketHandle handle, std::uint64_t token);
+
+        /**
+         * @brief Block until at least one registered handle is ready or the timeout elapses.
+         * @param outEvents Destination for ready events.
+         * @param timeout Maximum time to block; zero polls without blocking.
+         * @return Number of events written to outEvents.
+         */
+        [[nodiscard]] virtual size_t wait(std::span<PollEvent> outEvents, std::chrono::milliseconds timeout) = 0;
+
+        /// @brief Number of registered handles.
+        [[nodiscard]] size_t getRegisteredCount() const
+        {
+            return m_registrations.size();
+        }
+
+        /// @brief Backend name for diagnostics ("io_uring", "epoll", "kqueue", "poll", "WSAPoll").
+        [[nodiscard]] virtual const char* getBackendName() const = 0;
+
+    protected:
+        struct Registration
+        {
+            PollEvents interest = PollEvents::None;
+            std::uint64_t token = 0;
+        };
+
+        /// @brief Add a handle not currently known to the backend.
+        virtual bool addHandle(SocketHandle handle, PollEvents interest, std::uint64_t token) = 0;
+
+        /// @brief Change interest or owner of a handle already known to the poller.
+        virtual bool modifyHandle(SocketHandle handle, PollEvents interest, std::uint64_t token) = 0;
+
+        /// @brief Remove a handle from the backend; errors (for example an already-closed handle) are ignored.
+        virtual void removeHandle(SocketHandle handle) = 0;
+
+        /// @brief Current registrations, for backends that rebuild their wait set on every call.
+        [[nodiscard]] const std::unordered_map<SocketHandle, Registration>& getRegistrations() const
+        {
+            return m_registrations;
+        }
+
+    private:
+        std::unordered_map<SocketHandle, Registration> m_registrations;
+    };
+
+    /**
+     * @brief Create the best readiness poller for this platform.
+     * @return Poller, or nullptr where sockets cannot be polled collectively (UE5 FSocket, Sony).
+     */
+    [[nodiscard]] std::unique_ptr<Poller> createPoller();
+
+#if REACTORMQ_SOCKET_WITH_WINSOCKET || (REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_SOCKET_WITH_POLL)
+    /**
+     * @brief Create the portable poll()/WSAPoll() backend regardless of what createPoller() would pick.
+     * @return Poller; never nullptr.
+     */
+    [[nodiscard]] std::unique_ptr<Poller> createPollPoller();
+#endif
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET && REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
+    /**
+     * @brief Create the io_uring backend regardless of what createPoller() would pick.
+     * @return Poller, or nullptr if the kernel does not support (or a sandbox blocks) io_uring.
+     */
+    [[nodiscard]] std::unique_ptr<Poller> createIoUringPoller();
+#endif
+} // namespace reactormq::socket
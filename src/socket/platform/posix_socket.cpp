@@ -7,17 +7,55 @@
 #include "platform_socket.h"
 #include "socket/platform/receive_flags.h"
 #include "socket/platform/socket_error.h"
+#include "socket/platform/wakeup_handle.h"
 #include "socket/socket.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
 #include <csignal>
 #include <cstring>
 
+#if !REACTORMQ_WITH_SOCKET_POLYFILL
+#include <sys/uio.h>
+#include <sys/un.h>
+#endif
+
 namespace reactormq::socket
 {
-    bool PlatformSocket::createSocket()
+    namespace
     {
-        m_socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        /// Set an integer socket option, clamped to int; a rejection is logged and otherwise ignored.
+        void setIntOption(const int handle, const int level, const int name, const uint32_t requested, const char* optionName)
+        {
+            const int value = static_cast<int>(std::min<uint32_t>(requested, INT_MAX));
+            if (setsockopt(handle, level, name, &value, sizeof(value)) != 0)
+            {
+                const int32_t error = PlatformSocket::getLastErrorCode();
+                REACTORMQ_LOG(
+                    logging::LogLevel::Warn,
+                    "PlatformSocket::createSocket() setsockopt(%s=%d) failed (error=%d: %s)",
+                    optionName,
+                    value,
+                    error,
+                    PlatformSocket::getNetworkErrorDescription(error));
+            }
+        }
+    } // namespace
+
+    bool PlatformSocket::createSocket(const AddressFamily family)
+    {
+#if REACTORMQ_WITH_SOCKET_POLYFILL
+        const bool isLocal = false;
+        m_socket = ::socket(family == AddressFamily::IPv6 ? AF_INET6 : AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#else
+        const bool isLocal = family == AddressFamily::Local;
+        m_socket = isLocal ? ::socket(AF_UNIX, SOCK_STREAM, 0)
+                           : ::socket(family == AddressFamily::IPv6 ? AF_INET6 : AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#endif // REACTORMQ_WITH_SOCKET_POLYFILL
+        m_addressFamily = family;
 
         if (!isHandleValid())
         {
@@ -27,16 +65,46 @@ namespace reactormq::socket
             return false;
         }
 
-        constexpr int param = 1;
+        if (m_options.noDelay && !isLocal)
+        {
+            setIntOption(m_socket, IPPROTO_TCP, TCP_NODELAY, 1, "TCP_NODELAY");
+        }
+        // Buffer sizes must be set before connecting, while the window scale is still to be negotiated.
+        if (m_options.sendBufferBytes != 0)
+        {
+            setIntOption(m_socket, SOL_SOCKET, SO_SNDBUF, m_options.sendBufferBytes, "SO_SNDBUF");
+        }
+        if (m_options.receiveBufferBytes != 0)
+        {
+            setIntOption(m_socket, SOL_SOCKET, SO_RCVBUF, m_options.receiveBufferBytes, "SO_RCVBUF");
+        }
+#ifdef SO_BUSY_POLL
+        if (m_options.busyPollMicroseconds != 0)
+        {
+            setIntOption(m_socket, SOL_SOCKET, SO_BUSY_POLL, m_options.busyPollMicroseconds, "SO_BUSY_POLL");
+        }
+#endif // SO_BUSY_POLL
+#ifdef TCP_QUICKACK
+        if (m_options.quickAck && !isLocal)
+        {
+            setIntOption(m_socket, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+        }
+#endif // TCP_QUICKACK
+#ifdef TCP_USER_TIMEOUT
+        if (m_options.userTimeoutMs != 0 && !isLocal)
+        {
+            setIntOption(m_socket, IPPROTO_TCP, TCP_USER_TIMEOUT, m_options.userTimeoutMs, "TCP_USER_TIMEOUT");
+        }
+#endif // TCP_USER_TIMEOUT
 
-        setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, &param, sizeof(param));
         if (const int flags = fcntl(m_socket, F_GETFL, 0); flags != -1)
         {
             fcntl(m_socket, F_SETFL, flags | O_NONBLOCK);
         }
 
 #ifdef SO_REUSEPORT
-        if (const int result = setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &param, sizeof(param)); result == 0)
+        constexpr int param = 1;
+        if (!isLocal && setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &param, sizeof(param)) == 0)
         {
             return setsockopt(m_socket, SOL_SOCKET, SO_REUSEPORT, &param, sizeof(param)) == 0;
         }
@@ -54,19 +122,8 @@ namespace reactormq::socket
     {
         m_state.store(SocketState::Connecting, std::memory_order_release);
 
-        if (m_socket == kInvalidSocketHandle)
-        {
-            createSocket();
-        }
-
-        if (!isHandleValid())
-        {
-            m_state.store(SocketState::Disconnected, std::memory_order_release);
-            return ENOTSOCK;
-        }
-
         addrinfo hints{};
-        hints.ai_family = AF_INET;
+        hints.ai_family = AF_UNSPEC;
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_protocol = IPPROTO_TCP;
 
@@ -84,6 +141,24 @@ namespace reactormq::socket
 
         for (const addrinfo* rp = result; rp != nullptr; rp = rp->ai_next)
         {
+            if (rp->ai_family != AF_INET && rp->ai_family != AF_INET6)
+            {
+                continue;
+            }
+
+            // A handle created up front, or used by a failed attempt, is only reused for an address of its own family.
+            const AddressFamily family = rp->ai_family == AF_INET6 ? AddressFamily::IPv6 : AddressFamily::IPv4;
+            if (isHandleValid() && (family != m_addressFamily || lastErr != 0))
+            {
+                ::close(m_socket);
+                m_socket = kInvalidSocketHandle;
+            }
+            if (!isHandleValid() && !createSocket(family))
+            {
+                lastErr = ENOTSOCK;
+                continue;
+            }
+
             ret = ::connect(m_socket, rp->ai_addr, rp->ai_addrlen);
             if (ret != 0)
             {
@@ -97,7 +172,7 @@ namespace reactormq::socket
         }
 
         freeaddrinfo(result);
-        if (ret != 0 && errno == 0 && lastErr != 0)
+        if (ret != 0 && lastErr != 0)
         {
             errno = lastErr;
         }
@@ -116,6 +191,51 @@ namespace reactormq::socket
         m_state.store(SocketState::Disconnected, std::memory_order_release);
         return ret;
     }
+
+    int PlatformSocket::connectLocal(const std::string& path)
+    {
+#if REACTORMQ_WITH_SOCKET_POLYFILL
+        (void)path;
+        errno = EAFNOSUPPORT;
+        return -1;
+#else
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+        {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.data(), path.size());
+
+        if (isHandleValid())
+        {
+            ::close(m_socket);
+            m_socket = kInvalidSocketHandle;
+        }
+        m_state.store(SocketState::Connecting, std::memory_order_release);
+        if (!createSocket(AddressFamily::Local))
+        {
+            m_state.store(SocketState::Disconnected, std::memory_order_release);
+            return -1;
+        }
+
+        // A local connect completes or fails at once; a full listen backlog fails with EAGAIN rather than waiting.
+        const int ret = ::connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        if (ret == 0)
+        {
+            m_state.store(SocketState::Connected, std::memory_order_release);
+            return 0;
+        }
+        if (errno == EINPROGRESS)
+        {
+            return 0;
+        }
+
+        m_state.store(SocketState::Disconnected, std::memory_order_release);
+        return ret;
+#endif // REACTORMQ_WITH_SOCKET_POLYFILL
+    }
     bool PlatformSocket::isConnected() const
     {
         if (!isHandleValid())
@@ -135,20 +255,25 @@ namespace reactormq::socket
         FD_SET(m_socket, &writeSet);
         FD_SET(m_socket, &exceptSet);
 
-        timeval tv{ 0, 1000 };
+        // Only look: the caller waits for writability on its poller or in waitForIo(), never here.
+        timeval tv{ 0, 0 };
 
-        if (const int ready = select(m_socket + 1, nullptr, &writeSet, &exceptSet, &tv); ready <= 0 || FD_ISSET(m_socket, &exceptSet))
+        const int ready = select(m_socket + 1, nullptr, &writeSet, &exceptSet, &tv);
+        if (ready <= 0)
         {
             return false;
         }
 
         int soError = 0;
-        if (socklen_t optLen = sizeof(soError); getsockopt(m_socket, SOL_SOCKET, SO_ERROR, &soError, &optLen) != 0 || soError != 0)
+        if (socklen_t optLen = sizeof(soError);
+            FD_ISSET(m_socket, &exceptSet) || getsockopt(m_socket, SOL_SOCKET, SO_ERROR, &soError, &optLen) != 0 || soError != 0)
         {
             if (soError != 0)
             {
                 REACTORMQ_LOG(logging::LogLevel::Trace, "PlatformSocket::isConnected() SO_ERROR=%d", soError);
             }
+            // The attempt is over; hasConnectFailed() reports it so a connection race can move on.
+            m_state.store(SocketState::Disconnected, std::memory_order_release);
             return false;
         }
 
@@ -180,8 +305,25 @@ namespace reactormq::socket
             return false;
         }
 
-        if (const ssize_t result = recv(m_socket, outData, static_cast<size_t>(bufferSize), 0); result >= 0)
+        const ssize_t result = recv(m_socket, outData, static_cast<size_t>(bufferSize), 0);
+        if (result == 0)
+        {
+            // The peer shut the connection down. errno is cleared so callers do not read a stale EAGAIN as would-block.
+            errno = 0;
+            bytesRead = 0;
+            REACTORMQ_LOG(logging::LogLevel::Debug, "PlatformSocket::tryReceive() peer closed the connection");
+            return false;
+        }
+        if (result > 0)
         {
+#ifdef TCP_QUICKACK
+            // Linux leaves quick-ACK mode on its own, so re-arm it after every read.
+            if (m_options.quickAck && result > 0)
+            {
+                constexpr int enable = 1;
+                setsockopt(m_socket, IPPROTO_TCP, TCP_QUICKACK, &enable, sizeof(enable));
+            }
+#endif // TCP_QUICKACK
             bytesRead = static_cast<size_t>(result);
             REACTORMQ_LOG_HEX(logging::LogLevel::Trace, outData, bytesRead, "PlatformSocket::tryReceive()");
             return true;
@@ -288,6 +430,102 @@ namespace reactormq::socket
 
         return false;
     }
+
+    bool PlatformSocket::trySendVectored(const std::span<const SendBuffer> buffers, size_t& bytesSent) const
+    {
+#if REACTORMQ_WITH_SOCKET_POLYFILL
+        return trySendSequentially(buffers, bytesSent);
+#else
+        bytesSent = 0;
+        if (!isHandleValid())
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSocket::trySendVectored() cannot send: invalid or closed handle");
+            return false;
+        }
+
+        std::array<iovec, kMaxSendBuffers> vectors{};
+        size_t count = 0;
+        for (const SendBuffer& buffer : buffers)
+        {
+            if (count == vectors.size())
+            {
+                break;
+            }
+            if (buffer.size == 0)
+            {
+                continue;
+            }
+            REACTORMQ_LOG_HEX(logging::LogLevel::Trace, buffer.data, buffer.size, "PlatformSocket::trySendVectored()");
+            vectors[count].iov_base = const_cast<uint8_t*>(buffer.data);
+            vectors[count].iov_len = buffer.size;
+            ++count;
+        }
+
+        if (count == 0)
+        {
+            return true;
+        }
+
+        msghdr message{};
+        message.msg_iov = vectors.data();
+        message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(count);
+
+        if (const ssize_t result = sendmsg(m_socket, &message, 0); result >= 0)
+        {
+            bytesSent = static_cast<size_t>(result);
+            REACTORMQ_LOG(logging::LogLevel::Trace, "PlatformSocket::trySendVectored() bytesSent=%zu", bytesSent);
+            return true;
+        }
+
+        const SocketError err = getLastError();
+        const int32_t code = getLastErrorCode();
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "PlatformSocket::trySendVectored() failed (errorEnum=%d, errorCode=%d: %s)",
+            err,
+            code,
+            getNetworkErrorDescription(code));
+
+        return false;
+#endif
+    }
+
+    void PlatformSocket::waitForIo(const WakeupHandle& wakeup, const bool wantWrite, const std::chrono::milliseconds timeout) const
+    {
+        if (!isHandleValid() || wakeup.isSignalled())
+        {
+            return;
+        }
+
+        fd_set readSet;
+        fd_set writeSet;
+        fd_set exceptSet;
+        FD_ZERO(&readSet);
+        FD_ZERO(&writeSet);
+        FD_ZERO(&exceptSet);
+        FD_SET(m_socket, &readSet);
+        FD_SET(m_socket, &exceptSet);
+        if (wantWrite)
+        {
+            FD_SET(m_socket, &writeSet);
+        }
+
+        SocketHandle maxHandle = m_socket;
+        if (const int wakeupDescriptor = wakeup.getReadDescriptor(); wakeupDescriptor != -1)
+        {
+            FD_SET(wakeupDescriptor, &readSet);
+            maxHandle = std::max(maxHandle, wakeupDescriptor);
+        }
+
+        const auto timeoutUs = std::chrono::duration_cast<std::chrono::microseconds>(timeout).count();
+        timeval tv{ static_cast<time_t>(timeoutUs / 1000000), static_cast<suseconds_t>(timeoutUs % 1000000) };
+
+        if (const int ready = select(maxHandle + 1, &readSet, wantWrite ? &writeSet : nullptr, &exceptSet, &tv); ready < 0 && errno != EINTR)
+        {
+            const int32_t code = getLastErrorCode();
+            REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSocket::waitForIo() select failed (errorCode=%d: %s)", code, getNetworkErrorDescription(code));
+        }
+    }
     SocketError PlatformSocket::getLastError()
     {
         return getErrorFromPlatformCode(static_cast<uint32_t>(getLastErrorCode()));
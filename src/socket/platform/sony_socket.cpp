@@ -6,18 +6,35 @@
 #include "platform_socket.h"
 #include "socket/platform/receive_flags.h"
 #include "socket/platform/socket_error.h"
+#include "socket/platform/wakeup_handle.h"
 #include "socket/socket.h"
 #include "util/logging/logging.h"
 
 #include "netinet/in.h"
 #include <libnetctl.h>
 #include <net.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
 #include <utility>
 
 namespace reactormq::socket
 {
-    bool PlatformSocket::createSocket()
+    namespace
     {
+        /// Socket buffer size asked for when SocketOptions leaves it at 0. Every libnet call costs more than its POSIX
+        /// counterpart, so the stack should hold enough for the reader to drain it in a few large reads rather than
+        /// many small ones; the memory comes from the libnet pool, which bounds it.
+        constexpr int32_t kDefaultSocketBufferBytes = 128 * 1024;
+
+        /// Largest batch of small packets gathered into one sceNetSend() by trySendVectored().
+        constexpr size_t kSendSlabBytes = 16 * 1024;
+    } // namespace
+
+    bool PlatformSocket::createSocket(const AddressFamily /*family*/)
+    {
+        // IPv4 only: connect() is handed host names here, never the IPv6 addresses a connection race would try.
         m_socket = sceNetSocket("reactormq", SCE_NET_AF_INET, SCE_NET_SOCK_STREAM, SCE_NET_IPPROTO_TCP);
 
         if (!isHandleValid())
@@ -29,7 +46,23 @@ namespace reactormq::socket
         }
 
         constexpr int32_t param = 1;
-        sceNetSetsockopt(m_socket, SCE_NET_IPPROTO_TCP, SCE_NET_TCP_NODELAY, &param, sizeof(param));
+        if (m_options.noDelay)
+        {
+            sceNetSetsockopt(m_socket, SCE_NET_IPPROTO_TCP, SCE_NET_TCP_NODELAY, &param, sizeof(param));
+        }
+        // Only the buffer sizes have a libnet equivalent; the Linux-only options are ignored.
+        {
+            const auto size = m_options.sendBufferBytes != 0
+                ? static_cast<int32_t>(std::min<uint32_t>(m_options.sendBufferBytes, INT32_MAX))
+                : kDefaultSocketBufferBytes;
+            sceNetSetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_SNDBUF, &size, sizeof(size));
+        }
+        {
+            const auto size = m_options.receiveBufferBytes != 0
+                ? static_cast<int32_t>(std::min<uint32_t>(m_options.receiveBufferBytes, INT32_MAX))
+                : kDefaultSocketBufferBytes;
+            sceNetSetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_RCVBUF, &size, sizeof(size));
+        }
         sceNetSetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_NBIO, &param, sizeof(param));
         const int result = sceNetSetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_REUSEADDR, &param, sizeof(param));
 #ifdef SCE_NET_SO_REUSEPORT
@@ -107,8 +140,15 @@ namespace reactormq::socket
         }
 
         const int result = sceNetRecv(m_socket, outData, static_cast<size_t>(bufferSize), 0);
+        if (result == 0)
+        {
+            // The peer shut the connection down. errno is cleared so callers do not read a stale EAGAIN as would-block.
+            errno = 0;
+            REACTORMQ_LOG(logging::LogLevel::Debug, "PlatformSocket::tryReceive() peer closed the connection");
+            return false;
+        }
 
-        if (result >= 0)
+        if (result > 0)
         {
             bytesRead = static_cast<size_t>(result);
             REACTORMQ_LOG_HEX(logging::LogLevel::Trace, outData, bytesRead, "PlatformSocket::tryReceive()");
@@ -219,6 +259,93 @@ namespace reactormq::socket
 
         return false;
     }
+
+    bool PlatformSocket::trySendVectored(const std::span<const SendBuffer> buffers, size_t& bytesSent) const
+    {
+        // libnet has no gather send, and a call per packet is what costs on console: copy runs of small buffers into
+        // one slab and send each run with a single call. A buffer too large for the slab goes out on its own.
+        thread_local std::array<uint8_t, kSendSlabBytes> slab;
+
+        bytesSent = 0;
+        size_t index = 0;
+        while (index < buffers.size())
+        {
+            size_t gathered = 0;
+            size_t next = index;
+            while (next < buffers.size() && gathered + buffers[next].size <= slab.size())
+            {
+                if (buffers[next].size > 0)
+                {
+                    std::memcpy(slab.data() + gathered, buffers[next].data, buffers[next].size);
+                }
+                gathered += buffers[next].size;
+                ++next;
+            }
+
+            const uint8_t* data = slab.data();
+            size_t size = gathered;
+            if (next == index)
+            {
+                data = buffers[index].data;
+                size = std::min(buffers[index].size, static_cast<size_t>(UINT32_MAX));
+                ++next;
+            }
+
+            if (size > 0)
+            {
+                size_t sent = 0;
+                if (!trySend(data, static_cast<uint32_t>(size), sent))
+                {
+                    // Report the bytes that did go out; the caller sees the error on its next call.
+                    return bytesSent > 0;
+                }
+
+                bytesSent += sent;
+                if (sent < size || (data != slab.data() && size < buffers[index].size))
+                {
+                    return true;
+                }
+            }
+            index = next;
+        }
+        return true;
+    }
+
+    void PlatformSocket::waitForIo(const WakeupHandle& wakeup, const bool wantWrite, const std::chrono::milliseconds timeout) const
+    {
+        // No selectable wakeup descriptor on this platform; wait in short slices and check the wakeup between them.
+        constexpr std::chrono::milliseconds kWakeupPollSlice{ 2 };
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (isHandleValid() && !wakeup.isSignalled())
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+            {
+                return;
+            }
+            const auto slice = std::min(remaining, kWakeupPollSlice);
+
+            fd_set readSet;
+            fd_set writeSet;
+            fd_set exceptSet;
+            FD_ZERO(&readSet);
+            FD_ZERO(&writeSet);
+            FD_ZERO(&exceptSet);
+            FD_SET(m_socket, &readSet);
+            FD_SET(m_socket, &exceptSet);
+            if (wantWrite)
+            {
+                FD_SET(m_socket, &writeSet);
+            }
+
+            timeval tv{ 0, static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(slice).count()) };
+            if (const int ready = select(m_socket + 1, &readSet, wantWrite ? &writeSet : nullptr, &exceptSet, &tv); ready != 0)
+            {
+                return;
+            }
+        }
+    }
     SocketError PlatformSocket::getLastError()
     {
         return getErrorFromPlatformCode(getLastErrorCode());
@@ -249,6 +376,15 @@ namespace reactormq::socket
         m_socket = kInvalidSocketHandle;
         m_state.store(SocketState::Disconnected, std::memory_order_release);
     }
+    int PlatformSocket::connectLocal(const std::string& path)
+    {
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "PlatformSocket::connectLocal() Unix domain sockets are not supported (path=%s)",
+            path.c_str());
+        return -1;
+    }
+
     bool PlatformSocket::isConnected() const
     {
         if (!isHandleValid())
@@ -269,22 +405,26 @@ namespace reactormq::socket
         FD_SET(m_socket, &writeSet);
         FD_SET(m_socket, &exceptSet);
 
-        timeval tv{ 0, 1000 };
+        // Only look: the caller waits for writability on its poller or in waitForIo(), never here.
+        timeval tv{ 0, 0 };
 
         const int ready = select(m_socket + 1, nullptr, &writeSet, &exceptSet, &tv);
-        if (ready <= 0 || FD_ISSET(m_socket, &exceptSet))
+        if (ready <= 0)
         {
             return false;
         }
 
         int soError = 0;
         SceNetSocklen_t optLen = sizeof(soError);
-        if (sceNetGetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_ERROR, &soError, &optLen) != 0 || soError != 0)
+        if (FD_ISSET(m_socket, &exceptSet) || sceNetGetsockopt(m_socket, SCE_NET_SOL_SOCKET, SCE_NET_SO_ERROR, &soError, &optLen) != 0
+            || soError != 0)
         {
             if (soError != 0)
             {
                 REACTORMQ_LOG(logging::LogLevel::Trace, "PlatformSocket::isConnected() SO_ERROR=%d", soError);
             }
+            // The attempt is over; hasConnectFailed() reports it.
+            m_state.store(SocketState::Disconnected, std::memory_order_release);
             return false;
         }
 
@@ -0,0 +1,367 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+
+#include "socket/platform/tls_context_cache.h"
+
+#include "socket/platform/trust_anchor_set.h"
+#include "socket/tls_tuning.h"
+#include "util/logging/logging.h"
+
+#if REACTORMQ_WITH_QUIC
+#include <openssl/quic.h>
+#endif // REACTORMQ_WITH_QUIC
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <iterator>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        /// Read on first use and kept for the life of the process; constructed after OpenSSL is initialised, so it
+        /// is destroyed before OpenSSL's own exit-time cleanup runs.
+        const TrustAnchorSet& getSystemTrustAnchors()
+        {
+            static const TrustAnchorSet anchors;
+            return anchors;
+        }
+
+        /// SSL_CTX ex_data slot holding the context's TlsContextCache entry.
+        int getEntryExDataIndex()
+        {
+            static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+        }
+
+        /// SSL ex_data slot holding the "host:port" a connection's sessions are saved under.
+        int getPeerExDataIndex()
+        {
+            static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+        }
+
+        /// SSL ex_data slot holding the verifier a connection's chain verifications are remembered under.
+        int getVerifierExDataIndex()
+        {
+            static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+        }
+
+        /// Verify parameters under which a remembered verification says nothing about this handshake.
+        constexpr unsigned long kFullVerificationFlags = X509_V_FLAG_CRL_CHECK | X509_V_FLAG_CRL_CHECK_ALL | X509_V_FLAG_USE_CHECK_TIME;
+
+        bool isWorthOffering(const SSL_SESSION* session)
+        {
+            const std::uint64_t expiresAt = static_cast<std::uint64_t>(SSL_SESSION_get_time(session))
+                + static_cast<std::uint64_t>(SSL_SESSION_get_timeout(session));
+            return SSL_SESSION_is_resumable(session) == 1 && expiresAt > static_cast<std::uint64_t>(std::time(nullptr));
+        }
+    } // namespace
+
+    TlsSessionStore::~TlsSessionStore()
+    {
+        for (const auto& [peer, session] : m_sessions)
+        {
+            SSL_SESSION_free(session);
+        }
+    }
+
+    void TlsSessionStore::save(const std::string& peer, SSL_SESSION* session)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (const auto it = m_sessions.find(peer); it != m_sessions.end())
+        {
+            SSL_SESSION_free(it->second);
+            it->second = session;
+            return;
+        }
+
+        if (m_sessions.size() >= kMaxPeers)
+        {
+            SSL_SESSION_free(m_sessions.begin()->second);
+            m_sessions.erase(m_sessions.begin());
+        }
+        m_sessions.emplace(peer, session);
+    }
+
+    SSL_SESSION* TlsSessionStore::take(const std::string& peer)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_sessions.find(peer);
+        if (it == m_sessions.end())
+        {
+            return nullptr;
+        }
+
+        SSL_SESSION* session = it->second;
+        if (!isWorthOffering(session))
+        {
+            SSL_SESSION_free(session);
+            m_sessions.erase(it);
+            return nullptr;
+        }
+
+        if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION)
+        {
+            m_sessions.erase(it);
+            return session;
+        }
+
+        SSL_SESSION_up_ref(session);
+        return session;
+    }
+
+    size_t TlsSessionStore::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_sessions.size();
+    }
+
+    void VerifiedChainCache::remember(
+        const std::string& peer,
+        const Fingerprint& leaf,
+        const std::shared_ptr<const void>& verifier,
+        const std::time_t notAfter,
+        const std::time_t now)
+    {
+        const std::time_t expiresAt = std::min<std::time_t>(notAfter, now + static_cast<std::time_t>(kMaxAge.count()));
+        if (expiresAt <= now)
+        {
+            return;
+        }
+
+        std::scoped_lock lock(m_mutex);
+        std::string key = makeKey(peer, leaf);
+        if (const auto it = m_verified.find(key); it == m_verified.end() && m_verified.size() >= kMaxEntries)
+        {
+            m_verified.erase(m_verified.begin());
+        }
+        m_verified.insert_or_assign(std::move(key), Verified{ expiresAt, verifier });
+    }
+
+    bool VerifiedChainCache::contains(
+        const std::string& peer,
+        const Fingerprint& leaf,
+        const std::shared_ptr<const void>& verifier,
+        const std::time_t now) const
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_verified.find(makeKey(peer, leaf));
+        if (it == m_verified.end() || it->second.expiresAt <= now)
+        {
+            return false;
+        }
+
+        const std::weak_ptr<const void>& accepted = it->second.verifier;
+        return !accepted.owner_before(verifier) && !verifier.owner_before(accepted);
+    }
+
+    size_t VerifiedChainCache::size() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_verified.size();
+    }
+
+    std::string VerifiedChainCache::makeKey(const std::string& peer, const Fingerprint& leaf)
+    {
+        std::string key;
+        key.reserve(peer.size() + 1 + leaf.size());
+        key.append(peer).push_back('\0');
+        key.append(reinterpret_cast<const char*>(leaf.data()), leaf.size());
+        return key;
+    }
+
+    TlsContextCache::TlsContextCache()
+    {
+        // Initialise OpenSSL before this cache finishes constructing, so its exit-time cleanup is registered first and
+        // runs after the cache has freed its sessions.
+        OPENSSL_init_ssl(OPENSSL_INIT_LOAD_SSL_STRINGS | OPENSSL_INIT_LOAD_CRYPTO_STRINGS, nullptr);
+    }
+
+    TlsContextCache& TlsContextCache::instance()
+    {
+        static TlsContextCache cache;
+        return cache;
+    }
+
+    SslContextPtr TlsContextCache::acquire(const TlsContextKey& key)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        auto it = std::find_if(
+            m_entries.begin(),
+            m_entries.end(),
+            [&key](const std::unique_ptr<Entry>& entry)
+            {
+                return entry->key == key;
+            });
+        if (it == m_entries.end())
+        {
+            auto entry = std::make_unique<Entry>();
+            entry->key = key;
+            m_entries.push_back(std::move(entry));
+            it = std::prev(m_entries.end());
+        }
+
+        Entry& entry = **it;
+        if (SslContextPtr context = entry.context.lock())
+        {
+            return context;
+        }
+
+        SslContextPtr context = createContext(entry);
+        entry.context = context;
+        return context;
+    }
+
+    bool TlsContextCache::prepareResumption(SSL* ssl, const std::string& peer)
+    {
+        const SSL_CTX* context = ssl != nullptr ? SSL_get_SSL_CTX(ssl) : nullptr;
+        auto* entry = context != nullptr ? static_cast<Entry*>(SSL_CTX_get_ex_data(context, getEntryExDataIndex())) : nullptr;
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        SSL_set_ex_data(ssl, getPeerExDataIndex(), const_cast<std::string*>(&peer));
+
+        SSL_SESSION* session = entry->sessions.take(peer);
+        if (session == nullptr)
+        {
+            return false;
+        }
+
+        // SSL_set_session takes its own reference.
+        const bool offered = SSL_set_session(ssl, session) == 1;
+        SSL_SESSION_free(session);
+        REACTORMQ_LOG(logging::LogLevel::Debug, "TlsContextCache: offering saved session to %s", peer.c_str());
+        return offered;
+    }
+
+    void TlsContextCache::prepareVerification(SSL* ssl, const std::shared_ptr<const void>& verifier)
+    {
+        if (ssl != nullptr)
+        {
+            SSL_set_ex_data(ssl, getVerifierExDataIndex(), const_cast<std::shared_ptr<const void>*>(&verifier));
+        }
+    }
+
+    int TlsContextCache::onNewSession(SSL* ssl, SSL_SESSION* session)
+    {
+        auto* entry = static_cast<Entry*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), getEntryExDataIndex()));
+        const auto* peer = static_cast<const std::string*>(SSL_get_ex_data(ssl, getPeerExDataIndex()));
+        if (entry == nullptr || peer == nullptr)
+        {
+            return 0;
+        }
+
+        entry->sessions.save(*peer, session);
+        // Returning 1 keeps the reference OpenSSL passed in; the store frees it.
+        return 1;
+    }
+
+    int TlsContextCache::verifyChain(X509_STORE_CTX* storeContext, void* arg)
+    {
+        auto* entry = static_cast<Entry*>(arg);
+        const auto* ssl = static_cast<const SSL*>(X509_STORE_CTX_get_ex_data(storeContext, SSL_get_ex_data_X509_STORE_CTX_idx()));
+        const auto* peer = ssl != nullptr ? static_cast<const std::string*>(SSL_get_ex_data(ssl, getPeerExDataIndex())) : nullptr;
+        const auto* verifier
+            = ssl != nullptr ? static_cast<const std::shared_ptr<const void>*>(SSL_get_ex_data(ssl, getVerifierExDataIndex())) : nullptr;
+        X509* leaf = X509_STORE_CTX_get0_cert(storeContext);
+        const unsigned long flags = X509_VERIFY_PARAM_get_flags(X509_STORE_CTX_get0_param(storeContext));
+
+        VerifiedChainCache::Fingerprint fingerprint{};
+        unsigned int fingerprintLength = 0;
+        const bool isCacheable = entry != nullptr && peer != nullptr && verifier != nullptr && leaf != nullptr
+            && (flags & kFullVerificationFlags) == 0 && X509_digest(leaf, EVP_sha256(), fingerprint.data(), &fingerprintLength) == 1
+            && fingerprintLength == fingerprint.size();
+        if (!isCacheable)
+        {
+            return X509_verify_cert(storeContext);
+        }
+
+        const std::time_t now = std::time(nullptr);
+        if (entry->verifiedChains.contains(*peer, fingerprint, *verifier, now))
+        {
+            X509_STORE_CTX_set_error(storeContext, X509_V_OK);
+            REACTORMQ_LOG(
+                logging::LogLevel::Debug,
+                "TlsContextCache: certificate of %s verified recently; chain not rebuilt",
+                peer->c_str());
+            return 1;
+        }
+
+        const int result = X509_verify_cert(storeContext);
+        int days = 0;
+        int seconds = 0;
+        if (result == 1 && ASN1_TIME_diff(&days, &seconds, nullptr, X509_get0_notAfter(leaf)) == 1)
+        {
+            const std::time_t notAfter = now + static_cast<std::time_t>(days) * 86400 + seconds;
+            entry->verifiedChains.remember(*peer, fingerprint, *verifier, notAfter, now);
+        }
+        return result;
+    }
+
+    SslContextPtr TlsContextCache::createContext(Entry& entry)
+    {
+        const TlsContextKey& key = entry.key;
+#if REACTORMQ_WITH_QUIC
+        SSL_CTX* raw = SSL_CTX_new(key.isQuic ? OSSL_QUIC_client_method() : TLS_client_method());
+#else // REACTORMQ_WITH_QUIC
+        SSL_CTX* raw = SSL_CTX_new(TLS_client_method());
+#endif // REACTORMQ_WITH_QUIC
+        if (nullptr == raw)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "TlsContextCache: SSL_CTX_new failed (0x%lx)", ERR_peek_last_error());
+            return nullptr;
+        }
+        SslContextPtr context(raw, SSL_CTX_free);
+
+        // Unsent bytes are retried from SecureSocket's outbound queue, so the buffer address may change between attempts.
+        SSL_CTX_set_mode(raw, SSL_MODE_AUTO_RETRY | SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+        SSL_CTX_set_min_proto_version(raw, TLS1_2_VERSION);
+
+        // Sessions live in the entry rather than OpenSSL's internal cache, which a client never looks up.
+        SSL_CTX_set_ex_data(raw, getEntryExDataIndex(), &entry);
+        SSL_CTX_set_session_cache_mode(raw, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(raw, onNewSession);
+
+        if (key.verifyServerCertificate)
+        {
+            SSL_CTX_set_cert_verify_callback(raw, verifyChain, &entry);
+
+            if (const TrustAnchorSet& trustAnchors = getSystemTrustAnchors(); !trustAnchors.empty())
+            {
+                if (!trustAnchors.attachTo(raw))
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "TlsContextCache: failed to attach trust anchors to SSL_CTX");
+                }
+            }
+            else
+            {
+                if (SSL_CTX_set_default_verify_paths(raw) != 1)
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Warn, "TlsContextCache: failed to set default verify paths");
+                }
+            }
+        }
+
+        // Connections whose settings ask for another cipher order replace these on their SSL.
+        SSL_CTX_set_cipher_list(raw, getTls12CipherList(mqtt::TlsCipherPreference::LibraryDefault));
+        SSL_CTX_set_ciphersuites(raw, getTls13CipherSuites(mqtt::TlsCipherPreference::LibraryDefault));
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "TlsContextCache: built SSL_CTX (verify=%d, quic=%d)",
+            key.verifyServerCertificate ? 1 : 0,
+            key.isQuic ? 1 : 0);
+        return context;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
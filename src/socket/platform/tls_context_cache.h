@@ -0,0 +1,228 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+
+#if REACTORMQ_WITH_UE5
+#if WITH_SSL
+UE_PUSH_MACRO("UI")
+#define UI UI_ST
+#include <openssl/ssl.h>
+#undef UI
+UE_POP_MACRO("UI")
+#endif // WITH_SSL
+#else // REACTORMQ_WITH_UE5
+#include <openssl/ssl.h>
+#endif // REACTORMQ_WITH_UE5
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace reactormq::socket
+{
+    /// @brief The connection settings that shape an SSL_CTX; clients with equal keys share one context.
+    struct TlsContextKey
+    {
+        bool verifyServerCertificate = true;
+        bool isQuic = false; ///< QUIC client context (OSSL_QUIC_client_method) rather than TLS over TCP.
+
+        bool operator==(const TlsContextKey&) const = default;
+    };
+
+    /// @brief Shared reference to a client SSL_CTX; the context is freed with its last reference.
+    using SslContextPtr = std::shared_ptr<SSL_CTX>;
+
+    /**
+     * @brief Client TLS sessions of one TLS configuration, by peer ("host:port"), for abbreviated reconnects.
+     *
+     * Holds one reference to each session. TLS 1.3 tickets are handed out once, as RFC 8446 advises; the server
+     * sends a fresh one after every handshake. TLS 1.2 sessions stay until replaced, since a resumed 1.2 handshake
+     * issues no new session. Expired and non-resumable sessions are dropped instead of offered. Safe to use from any
+     * thread.
+     */
+    class TlsSessionStore final
+    {
+    public:
+        /// Peers remembered at once; one is forgotten to make room for another.
+        static constexpr size_t kMaxPeers = 256;
+
+        TlsSessionStore() = default;
+
+        ~TlsSessionStore();
+
+        TlsSessionStore(const TlsSessionStore&) = delete;
+
+        TlsSessionStore& operator=(const TlsSessionStore&) = delete;
+
+        /**
+         * @brief Remember @p session for @p peer, replacing the previous one.
+         * @param peer Peer the session was negotiated with.
+         * @param session Session; the store takes over one reference.
+         */
+        void save(const std::string& peer, SSL_SESSION* session);
+
+        /**
+         * @brief Session to offer when connecting to @p peer.
+         * @param peer Peer about to be connected to.
+         * @return A session the caller owns one reference to, or nullptr when there is none worth offering.
+         */
+        [[nodiscard]] SSL_SESSION* take(const std::string& peer);
+
+        /// @brief Peers with a remembered session.
+        [[nodiscard]] size_t size() const;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, SSL_SESSION*> m_sessions;
+    };
+
+    /**
+     * @brief Leaf certificates of one TLS configuration whose chains verified recently, by peer, so that a reconnect
+     * presenting the same leaf can skip chain building and the user verify callback.
+     *
+     * A verification is remembered under the verifier that accepted it: the settings carrying a user verify callback,
+     * or none when OpenSSL decided alone, so a connection never inherits another callback's verdict. Entries last
+     * until the leaf's notAfter or kMaxAge, whichever comes first, which bounds how long a revoked certificate that
+     * no CRL is checked for stays trusted. Safe to use from any thread.
+     */
+    class VerifiedChainCache final
+    {
+    public:
+        /// SHA-256 of the leaf certificate's DER encoding.
+        using Fingerprint = std::array<unsigned char, 32>;
+
+        /// Verifications remembered at once; one is forgotten to make room for another.
+        static constexpr size_t kMaxEntries = 256;
+
+        /// Longest a verification is trusted for, however long the certificate is valid.
+        static constexpr std::chrono::seconds kMaxAge{ 600 };
+
+        /**
+         * @brief Remember that @p leaf verified for @p peer.
+         * @param peer Peer that presented the certificate.
+         * @param leaf Fingerprint of the leaf certificate.
+         * @param verifier Identity of the user verify callback that accepted the chain, or nullptr for none.
+         * @param notAfter End of the leaf's validity period.
+         * @param now Time of the verification.
+         */
+        void remember(
+            const std::string& peer,
+            const Fingerprint& leaf,
+            const std::shared_ptr<const void>& verifier,
+            std::time_t notAfter,
+            std::time_t now);
+
+        /**
+         * @brief Whether @p leaf verified for @p peer under @p verifier and the verification has not expired.
+         * @param peer Peer presenting the certificate.
+         * @param leaf Fingerprint of the leaf certificate.
+         * @param verifier Identity of the connection's user verify callback, or nullptr for none.
+         * @param now Time of the handshake.
+         */
+        [[nodiscard]] bool contains(
+            const std::string& peer,
+            const Fingerprint& leaf,
+            const std::shared_ptr<const void>& verifier,
+            std::time_t now) const;
+
+        /// @brief Verifications remembered, including expired ones not yet looked up.
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct Verified
+        {
+            std::time_t expiresAt = 0;
+            /// Compared by owner, so settings freed and reallocated at the same address never match.
+            std::weak_ptr<const void> verifier;
+        };
+
+        static std::string makeKey(const std::string& peer, const Fingerprint& leaf);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Verified> m_verified;
+    };
+
+    /**
+     * @brief Process-wide cache of client SSL_CTX objects, one per TlsContextKey.
+     *
+     * A context lives while any socket holds it and is rebuilt by the next acquire() once the last one has closed.
+     * The system trust anchors are read once per process, when the first verifying context is built, and added to
+     * every verifying context after it, so a reconnect storm across many clients parses the CA store once instead of
+     * once per connection. Per-connection behaviour (the settings seen by the verify callback) belongs on the SSL
+     * object, never on the shared context.
+     *
+     * Each configuration also keeps a TlsSessionStore, which outlives its contexts so that the only client of a
+     * broker can still resume after its socket, and with it the context, has gone. Verifying configurations likewise
+     * keep a VerifiedChainCache, consulted by the context's chain verification for connections passed to
+     * prepareVerification(). Safe to call from any thread.
+     */
+    class TlsContextCache final
+    {
+    public:
+        static TlsContextCache& instance();
+
+        /**
+         * @brief Get the shared context for @p key, building it on first use.
+         * @param key TLS-relevant settings of the connection.
+         * @return The context, or nullptr if OpenSSL could not create one.
+         */
+        [[nodiscard]] SslContextPtr acquire(const TlsContextKey& key);
+
+        /**
+         * @brief Offer @p ssl the session saved for @p peer and save the sessions it negotiates under @p peer.
+         * Call before the handshake starts, on an SSL created from a context returned by acquire().
+         * @param ssl Connection about to start its handshake.
+         * @param peer "host:port" of the broker; must outlive @p ssl.
+         * @return True if a session was offered; the server may still decline it.
+         */
+        bool prepareResumption(SSL* ssl, const std::string& peer);
+
+        /**
+         * @brief Let handshakes of @p ssl accept a leaf certificate that verified for the same peer and verifier
+         * before without building its chain again, and remember the leaves that verify in full.
+         *
+         * Call after prepareResumption(), on an SSL from a verifying context. Chains are always built in full while
+         * the verify parameters ask for CRL checks or a fixed verification time. A connection accepted from the cache
+         * has no verified chain for SSL_get0_verified_chain().
+         * @param ssl Connection about to start its handshake.
+         * @param verifier Identity of the connection's user verify callback, or nullptr for none; must outlive @p ssl.
+         */
+        static void prepareVerification(SSL* ssl, const std::shared_ptr<const void>& verifier);
+
+    private:
+        /// A TLS configuration: its live context, if any, and its sessions.
+        struct Entry
+        {
+            TlsContextKey key;
+            std::weak_ptr<SSL_CTX> context;
+            TlsSessionStore sessions;
+            VerifiedChainCache verifiedChains;
+        };
+
+        TlsContextCache();
+
+        static SslContextPtr createContext(Entry& entry);
+
+        /// OpenSSL callback for sessions and TLS 1.3 tickets received on a connection prepared for resumption.
+        static int onNewSession(SSL* ssl, SSL_SESSION* session);
+
+        /// OpenSSL chain verification of verifying contexts: the VerifiedChainCache, else X509_verify_cert().
+        static int verifyChain(X509_STORE_CTX* storeContext, void* arg);
+
+        std::mutex m_mutex;
+        /// Never shrinks, so the Entry pointers stored in contexts stay valid.
+        std::vector<std::unique_ptr<Entry>> m_entries;
+    };
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
@@ -7,11 +7,16 @@
 #include "platform_socket.h"
 #include "socket/platform/receive_flags.h"
 #include "socket/platform/socket_error.h"
+#include "socket/platform/wakeup_handle.h"
 #include "util/logging/logging.h"
 
 #include "SocketSubsystem.h"
 #include "Sockets.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 namespace reactormq::socket
 {
     namespace
@@ -30,13 +35,28 @@ namespace reactormq::socket
             // DontWait is implicit since we set the socket to non-blocking
             return static_cast<ESocketReceiveFlags::Type>(bits);
         }
+
+        /// ISocketSubsystem::Get() looks the subsystem up by name on every call, which is most of the cost of a
+        /// would-block receive; the platform subsystem lives as long as the engine, so the first one found is kept.
+        ISocketSubsystem* getSocketSubsystem()
+        {
+            static std::atomic<ISocketSubsystem*> cached{ nullptr };
+            ISocketSubsystem* subsystem = cached.load(std::memory_order_acquire);
+            if (nullptr == subsystem)
+            {
+                subsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+                cached.store(subsystem, std::memory_order_release);
+            }
+            return subsystem;
+        }
     } // namespace
 
-    bool PlatformSocket::createSocket()
+    bool PlatformSocket::createSocket(const AddressFamily /*family*/)
     {
+        // IPv4 only: connect() is handed host names here, never the IPv6 addresses a connection race would try.
         REACTORMQ_LOG(logging::LogLevel::Debug, "UE5 PlatformSocket::createSocket() creating FSocket TCP");
 
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         if (!Subsys)
         {
             REACTORMQ_LOG(logging::LogLevel::Error, "UE5 PlatformSocket::createSocket() no socket subsystem");
@@ -56,7 +76,18 @@ namespace reactormq::socket
         m_socket->SetNonBlocking(true);
 
         // No delay (Nagle off)
-        m_socket->SetNoDelay(true);
+        m_socket->SetNoDelay(m_options.noDelay);
+
+        // Only the buffer sizes have an FSocket equivalent; the Linux-only options are ignored.
+        int32 actualSize = 0;
+        if (m_options.sendBufferBytes != 0)
+        {
+            m_socket->SetSendBufferSize(static_cast<int32>(std::min<uint32_t>(m_options.sendBufferBytes, INT32_MAX)), actualSize);
+        }
+        if (m_options.receiveBufferBytes != 0)
+        {
+            m_socket->SetReceiveBufferSize(static_cast<int32>(std::min<uint32_t>(m_options.receiveBufferBytes, INT32_MAX)), actualSize);
+        }
 
         // Reuse address if supported
         m_socket->SetReuseAddr(true);
@@ -80,7 +111,7 @@ namespace reactormq::socket
             }
         }
 
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         if (!Subsys)
         {
             m_state.store(SocketState::Disconnected, std::memory_order_release);
@@ -124,7 +155,7 @@ namespace reactormq::socket
         {
             return;
         }
-        if (ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM))
+        if (ISocketSubsystem* Subsys = getSocketSubsystem())
         {
             Subsys->DestroySocket(m_socket);
         }
@@ -170,7 +201,7 @@ namespace reactormq::socket
             return true;
         }
 
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         const ESocketErrors se = Subsys ? Subsys->GetLastErrorCode() : SE_NO_ERROR;
         if (se == SE_EWOULDBLOCK)
         {
@@ -194,7 +225,7 @@ namespace reactormq::socket
             bytesRead = static_cast<size_t>(Read);
             return true;
         }
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         const ESocketErrors se = Subsys ? Subsys->GetLastErrorCode() : SE_NO_ERROR;
         if (se == SE_EWOULDBLOCK || se == SE_EINPROGRESS)
         {
@@ -218,7 +249,7 @@ namespace reactormq::socket
             return true;
         }
 
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         const ESocketErrors se = Subsys ? Subsys->GetLastErrorCode() : SE_NO_ERROR;
         if (se == SE_EWOULDBLOCK || se == SE_EINPROGRESS)
         {
@@ -228,16 +259,44 @@ namespace reactormq::socket
         return false;
     }
 
+    bool PlatformSocket::trySendVectored(const std::span<const SendBuffer> buffers, size_t& bytesSent) const
+    {
+        return trySendSequentially(buffers, bytesSent);
+    }
+
+    void PlatformSocket::waitForIo(const WakeupHandle& wakeup, const bool wantWrite, const std::chrono::milliseconds timeout) const
+    {
+        // FSocket has no way to wait on an external handle; wait in short slices and check the wakeup between them.
+        constexpr std::chrono::milliseconds kWakeupPollSlice{ 2 };
+
+        const ESocketWaitConditions::Type condition = wantWrite ? ESocketWaitConditions::WaitForReadOrWrite : ESocketWaitConditions::WaitForRead;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (isHandleValid() && !wakeup.isSignalled())
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+            {
+                return;
+            }
+            const auto slice = std::min(remaining, kWakeupPollSlice);
+
+            if (m_socket->Wait(condition, FTimespan::FromMilliseconds(static_cast<double>(slice.count()))))
+            {
+                return;
+            }
+        }
+    }
+
     SocketError PlatformSocket::getLastError()
     {
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         const ESocketErrors se = Subsys ? Subsys->GetLastErrorCode() : SE_NO_ERROR;
         return getErrorFromPlatformCode(static_cast<uint32>(se));
     }
 
     int32_t PlatformSocket::getLastErrorCode()
     {
-        ISocketSubsystem* Subsys = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        ISocketSubsystem* Subsys = getSocketSubsystem();
         return Subsys ? static_cast<int32_t>(Subsys->GetLastErrorCode()) : 0;
     }
 
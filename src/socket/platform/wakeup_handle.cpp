@@ -0,0 +1,99 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/platform/wakeup_handle.h"
+
+#include "util/logging/logging.h"
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+#include <fcntl.h>
+#include <unistd.h>
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
+#include <cerrno>
+#include <cstdint>
+
+namespace reactormq::socket
+{
+    WakeupHandle::WakeupHandle()
+    {
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+        if (int descriptors[2]; pipe(descriptors) == 0)
+        {
+            for (const int descriptor : descriptors)
+            {
+                if (const int flags = fcntl(descriptor, F_GETFL, 0); flags != -1)
+                {
+                    fcntl(descriptor, F_SETFL, flags | O_NONBLOCK);
+                }
+                fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+            }
+            m_readDescriptor = descriptors[0];
+            m_writeDescriptor = descriptors[1];
+        }
+        else
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "WakeupHandle::WakeupHandle() pipe() failed (errno=%d); falling back to condition wait", errno);
+        }
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+    }
+
+    WakeupHandle::~WakeupHandle()
+    {
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+        if (m_readDescriptor != -1)
+        {
+            ::close(m_readDescriptor);
+        }
+        if (m_writeDescriptor != -1)
+        {
+            ::close(m_writeDescriptor);
+        }
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+    }
+
+    void WakeupHandle::signal()
+    {
+        if (m_isSignalled.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+        if (m_writeDescriptor != -1)
+        {
+            constexpr uint8_t kWakeByte = 1;
+            // A full pipe already guarantees the reader wakes, so a failed write is harmless.
+            [[maybe_unused]] const auto written = ::write(m_writeDescriptor, &kWakeByte, sizeof(kWakeByte));
+        }
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
+        std::scoped_lock lock(m_mutex);
+        m_condition.notify_all();
+    }
+
+    bool WakeupHandle::waitFor(const std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_condition.wait_for(lock, timeout, [this] { return isSignalled(); });
+    }
+
+    void WakeupHandle::reset()
+    {
+        // Clear before draining: a signal racing with the drain re-latches the flag, and waiters check the flag
+        // before blocking on the descriptor.
+        m_isSignalled.store(false, std::memory_order_release);
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+        if (m_readDescriptor != -1)
+        {
+            uint8_t drain[64];
+            while (::read(m_readDescriptor, drain, sizeof(drain)) > 0)
+            {
+                // keep draining
+            }
+        }
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+    }
+} // namespace reactormq::socket
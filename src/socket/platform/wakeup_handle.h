@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Cross-thread wakeup for a reactor blocked waiting for I/O.
+     * signal() may be called from any thread. The waiting thread either blocks in waitFor(), or, on platforms with a
+     * selectable pipe, includes getReadDescriptor() in its readiness wait so socket I/O and wakeups are awaited together.
+     * The signal stays latched until reset(), so a signal raised before the wait begins is never lost.
+     */
+    class WakeupHandle final
+    {
+    public:
+        WakeupHandle();
+
+        ~WakeupHandle();
+
+        WakeupHandle(const WakeupHandle&) = delete;
+
+        WakeupHandle& operator=(const WakeupHandle&) = delete;
+
+        /// @brief Latch the signal and wake any waiter. Thread-safe.
+        void signal();
+
+        /// @brief Whether signal() was called since the last reset().
+        [[nodiscard]] bool isSignalled() const
+        {
+            return m_isSignalled.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Block until signalled or the timeout elapses.
+         * @param timeout Maximum time to wait.
+         * @return True if signalled.
+         */
+        bool waitFor(std::chrono::milliseconds timeout);
+
+        /// @brief Clear the latched signal and drain the selectable descriptor.
+        void reset();
+
+        /**
+         * @brief Descriptor that becomes readable while the handle is signalled.
+         * @return Read end of the wakeup pipe, or -1 on platforms without a selectable wakeup.
+         */
+        [[nodiscard]] int getReadDescriptor() const
+        {
+            return m_readDescriptor;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<bool> m_isSignalled{ false };
+
+        int m_readDescriptor = -1;
+        int m_writeDescriptor = -1;
+    };
+} // namespace reactormq::socket
@@ -7,21 +7,28 @@
 #include "platform_socket.h"
 #include "socket/platform/receive_flags.h"
 #include "socket/platform/socket_error.h"
+#include "socket/platform/wakeup_handle.h"
 #include "socket/socket.h"
 #include "util/logging/logging.h"
 
 #include <WS2tcpip.h>
 #include <WinSock2.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
 #include <format>
+#include <tuple>
 #include <utility>
 
 namespace reactormq::socket
 {
-    bool PlatformSocket::createSocket()
+    bool PlatformSocket::createSocket(const AddressFamily family)
     {
         REACTORMQ_LOG(logging::LogLevel::Debug, "PlatformSocket::createSocket() creating TCP socket");
 
-        m_socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        m_socket = ::socket(family == AddressFamily::IPv6 ? AF_INET6 : AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        m_addressFamily = family;
 
         if (!isHandleValid())
         {
@@ -35,6 +42,7 @@ namespace reactormq::socket
             return false;
         }
 
+        if (m_options.noDelay)
         {
             constexpr BOOL param = TRUE;
             const int r = setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&param), sizeof(param));
@@ -49,6 +57,30 @@ namespace reactormq::socket
             }
         }
 
+        // Buffer sizes must be set before connecting, while the window scale is still to be negotiated. SO_BUSY_POLL,
+        // TCP_QUICKACK and TCP_USER_TIMEOUT have no Winsock equivalent and are ignored.
+        for (const auto& [name, optionName, requested] :
+             { std::tuple{ SO_SNDBUF, "SO_SNDBUF", m_options.sendBufferBytes }, std::tuple{ SO_RCVBUF, "SO_RCVBUF", m_options.receiveBufferBytes } })
+        {
+            if (requested == 0)
+            {
+                continue;
+            }
+
+            const int size = static_cast<int>(std::min<uint32_t>(requested, INT_MAX));
+            if (setsockopt(m_socket, SOL_SOCKET, name, reinterpret_cast<const char*>(&size), sizeof(size)) != 0)
+            {
+                const int32_t error = getLastErrorCode();
+                REACTORMQ_LOG(
+                    logging::LogLevel::Warn,
+                    "PlatformSocket::createSocket() setsockopt(%s=%d) failed (error=%d: %s)",
+                    optionName,
+                    size,
+                    error,
+                    getNetworkErrorDescription(error));
+            }
+        }
+
         {
             u_long nonBlocking = 1;
             const int r = ioctlsocket(m_socket, FIONBIO, &nonBlocking);
@@ -103,24 +135,8 @@ namespace reactormq::socket
 
         m_state.store(SocketState::Connecting, std::memory_order_release);
 
-        if (m_socket == kInvalidSocketHandle)
-        {
-            if (!createSocket())
-            {
-                m_state.store(SocketState::Disconnected, std::memory_order_release);
-                return WSAENOTSOCK;
-            }
-        }
-
-        if (!isHandleValid())
-        {
-            REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSocket::connect() invalid socket handle");
-            m_state.store(SocketState::Disconnected, std::memory_order_release);
-            return WSAENOTSOCK;
-        }
-
         addrinfo hints{};
-        hints.ai_family = AF_INET;
+        hints.ai_family = AF_UNSPEC;
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_protocol = IPPROTO_TCP;
 
@@ -153,6 +169,25 @@ namespace reactormq::socket
 
         for (const addrinfo* rp = result; rp != nullptr; rp = rp->ai_next)
         {
+            if (rp->ai_family != AF_INET && rp->ai_family != AF_INET6)
+            {
+                continue;
+            }
+
+            // A handle created up front, or used by a failed attempt, is only reused for an address of its own family.
+            const AddressFamily family = rp->ai_family == AF_INET6 ? AddressFamily::IPv6 : AddressFamily::IPv4;
+            if (isHandleValid() && (family != m_addressFamily || lastErr != 0))
+            {
+                closesocket(m_socket);
+                m_socket = kInvalidSocketHandle;
+            }
+            if (!isHandleValid() && !createSocket(family))
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "PlatformSocket::connect() invalid socket handle");
+                lastErr = WSAENOTSOCK;
+                continue;
+            }
+
             ret = ::connect(m_socket, rp->ai_addr, static_cast<int>(rp->ai_addrlen));
             if (ret != 0)
             {
@@ -210,8 +245,16 @@ namespace reactormq::socket
         }
 
         const int result = recv(m_socket, reinterpret_cast<char*>(outData), bufferSize, 0);
+        if (result == 0)
+        {
+            // The peer shut the connection down. The error is cleared so callers do not read a stale one as would-block.
+            WSASetLastError(0);
+            bytesRead = 0;
+            REACTORMQ_LOG(logging::LogLevel::Debug, "PlatformSocket::tryReceive() peer closed the connection");
+            return false;
+        }
 
-        if (result >= 0)
+        if (result > 0)
         {
             bytesRead = static_cast<size_t>(result);
             REACTORMQ_LOG_HEX(logging::LogLevel::Trace, outData, bytesRead, "PlatformSocket::tryReceive()");
@@ -322,6 +365,100 @@ namespace reactormq::socket
 
         return false;
     }
+
+    bool PlatformSocket::trySendVectored(const std::span<const SendBuffer> buffers, size_t& bytesSent) const
+    {
+        bytesSent = 0;
+        if (!isHandleValid())
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "PlatformSocket::trySendVectored() cannot send: invalid or closed handle");
+            return false;
+        }
+
+        std::array<WSABUF, kMaxSendBuffers> vectors{};
+        DWORD count = 0;
+        for (const SendBuffer& buffer : buffers)
+        {
+            if (count == vectors.size())
+            {
+                break;
+            }
+            if (buffer.size == 0)
+            {
+                continue;
+            }
+            REACTORMQ_LOG_HEX(logging::LogLevel::Trace, buffer.data, buffer.size, "PlatformSocket::trySendVectored()");
+            const auto length = static_cast<ULONG>(std::min(buffer.size, static_cast<size_t>(ULONG_MAX)));
+            vectors[count].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(buffer.data));
+            vectors[count].len = length;
+            ++count;
+            if (length < buffer.size)
+            {
+                // A short region must be the last one, or bytes after it would be sent out of order.
+                break;
+            }
+        }
+
+        if (count == 0)
+        {
+            return true;
+        }
+
+        DWORD sent = 0;
+        if (WSASend(m_socket, vectors.data(), count, &sent, 0, nullptr, nullptr) == 0)
+        {
+            bytesSent = static_cast<size_t>(sent);
+            REACTORMQ_LOG(logging::LogLevel::Trace, "PlatformSocket::trySendVectored() bytesSent=%zu", bytesSent);
+            return true;
+        }
+
+        const SocketError err = getLastError();
+        const int32_t code = getLastErrorCode();
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "PlatformSocket::trySendVectored() failed (errorEnum=%d, errorCode=%d: %s)",
+            err,
+            code,
+            getNetworkErrorDescription(code));
+
+        return false;
+    }
+
+    void PlatformSocket::waitForIo(const WakeupHandle& wakeup, const bool wantWrite, const std::chrono::milliseconds timeout) const
+    {
+        // Winsock cannot select on a pipe, so wait in short slices and check the wakeup between them.
+        constexpr std::chrono::milliseconds kWakeupPollSlice{ 2 };
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (isHandleValid() && !wakeup.isSignalled())
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0)
+            {
+                return;
+            }
+            const auto slice = std::min(remaining, kWakeupPollSlice);
+
+            fd_set readSet;
+            fd_set writeSet;
+            fd_set exceptSet;
+            FD_ZERO(&readSet);
+            FD_ZERO(&writeSet);
+            FD_ZERO(&exceptSet);
+            FD_SET(m_socket, &readSet);
+            FD_SET(m_socket, &exceptSet);
+            if (wantWrite)
+            {
+                FD_SET(m_socket, &writeSet);
+            }
+
+            const timeval tv{ 0, static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(slice).count()) };
+            if (const int ready = select(0, &readSet, wantWrite ? &writeSet : nullptr, &exceptSet, &tv); ready != 0)
+            {
+                return;
+            }
+        }
+    }
     SocketError PlatformSocket::getLastError()
     {
         return getErrorFromPlatformCode(static_cast<uint32_t>(getLastErrorCode()));
@@ -371,6 +508,16 @@ namespace reactormq::socket
         m_socket = kInvalidSocketHandle;
         m_state.store(SocketState::Disconnected, std::memory_order_release);
     }
+    int PlatformSocket::connectLocal(const std::string& path)
+    {
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "PlatformSocket::connectLocal() Unix domain sockets are not supported (path=%s)",
+            path.c_str());
+        WSASetLastError(WSAEAFNOSUPPORT);
+        return -1;
+    }
+
     bool PlatformSocket::isConnected() const
     {
         if (!isHandleValid())
@@ -391,22 +538,26 @@ namespace reactormq::socket
         FD_SET(m_socket, &writeSet);
         FD_SET(m_socket, &exceptSet);
 
-        constexpr timeval tv{ 0, 1000 };
+        // Only look: the caller waits for writability on its poller or in waitForIo(), never here.
+        constexpr timeval tv{ 0, 0 };
 
         const int ready = select(0, nullptr, &writeSet, &exceptSet, &tv);
-        if (ready <= 0 || FD_ISSET(m_socket, &exceptSet))
+        if (ready <= 0)
         {
             return false;
         }
 
         int soError = 0;
         int optLen = sizeof(soError);
-        if (getsockopt(m_socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&soError), &optLen) != 0 || soError != 0)
+        if (FD_ISSET(m_socket, &exceptSet) || getsockopt(m_socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&soError), &optLen) != 0
+            || soError != 0)
         {
             if (soError != 0)
             {
                 REACTORMQ_LOG(logging::LogLevel::Trace, "PlatformSocket::isConnected() SO_ERROR=%d", soError);
             }
+            // The attempt is over; hasConnectFailed() reports it so a connection race can move on.
+            m_state.store(SocketState::Disconnected, std::memory_order_release);
             return false;
         }
 
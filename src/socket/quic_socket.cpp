@@ -0,0 +1,563 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_WITH_QUIC
+
+#include "socket/quic_socket.h"
+
+#include "socket/platform/wakeup_handle.h"
+#include "util/logging/logging.h"
+#include "util/trace/memory_tags.h"
+#include "util/trace/trace.h"
+
+#include <openssl/err.h>
+#include <openssl/quic.h>
+
+#include <algorithm>
+#include <array>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        /// ALPN protocol list in wire format: MQTT over QUIC is identified as "mqtt".
+        constexpr std::array<unsigned char, 5> kAlpn{ 4, 'm', 'q', 't', 't' };
+
+        /// @brief Close the UDP socket and free the address info of an address that could not be used.
+        int abandonAddress(const int udpSocket, addrinfo* info)
+        {
+            if (udpSocket >= 0)
+            {
+                ::close(udpSocket);
+            }
+            freeaddrinfo(info);
+            return -1;
+        }
+
+        /**
+         * @brief Open a connected, non-blocking UDP socket to @p address and describe the peer for OpenSSL.
+         * @param address Numeric IPv4 or IPv6 address.
+         * @param port Broker port.
+         * @param outPeer Receives the peer address; the caller frees it with BIO_ADDR_free().
+         * @return The socket, or -1 if the address could not be used.
+         */
+        int openUdpSocket(const std::string& address, const std::uint16_t port, BIO_ADDR*& outPeer)
+        {
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_DGRAM;
+            hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+            addrinfo* info = nullptr;
+            if (getaddrinfo(address.c_str(), std::to_string(port).c_str(), &hints, &info) != 0 || nullptr == info)
+            {
+                return -1;
+            }
+
+            const int udpSocket = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+            if (udpSocket < 0 || ::connect(udpSocket, info->ai_addr, info->ai_addrlen) != 0
+                || fcntl(udpSocket, F_SETFL, fcntl(udpSocket, F_GETFL, 0) | O_NONBLOCK) != 0)
+            {
+                return abandonAddress(udpSocket, info);
+            }
+
+            outPeer = BIO_ADDR_new();
+            bool isPeerSet = false;
+            if (info->ai_family == AF_INET)
+            {
+                const auto* ipv4 = reinterpret_cast<const sockaddr_in*>(info->ai_addr);
+                isPeerSet = BIO_ADDR_rawmake(outPeer, AF_INET, &ipv4->sin_addr, sizeof(ipv4->sin_addr), ipv4->sin_port) == 1;
+            }
+            else if (info->ai_family == AF_INET6)
+            {
+                const auto* ipv6 = reinterpret_cast<const sockaddr_in6*>(info->ai_addr);
+                isPeerSet = BIO_ADDR_rawmake(outPeer, AF_INET6, &ipv6->sin6_addr, sizeof(ipv6->sin6_addr), ipv6->sin6_port) == 1;
+            }
+
+            if (!isPeerSet)
+            {
+                BIO_ADDR_free(outPeer);
+                outPeer = nullptr;
+                return abandonAddress(udpSocket, info);
+            }
+
+            freeaddrinfo(info);
+            return udpSocket;
+        }
+    } // namespace
+
+    QuicSocket::QuicSocket(mqtt::ConnectionSettingsPtr settings)
+        : Socket(std::move(settings))
+    {
+        if (getSettings() && getSettings()->getFixedCapacity().isEnabled)
+        {
+            m_sendBuffer.reserve(getSettings()->getMaxOutboundQueueBytes());
+        }
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "QuicSocket::QuicSocket created (host=%s, port=%u)",
+            getSettings() ? getSettings()->getHost().c_str() : "<null>",
+            getSettings() ? static_cast<unsigned>(getSettings()->getPort()) : 0U);
+    }
+
+    QuicSocket::~QuicSocket()
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        releaseConnection();
+    }
+
+    void QuicSocket::connect()
+    {
+        auto self = shared_from_this();
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        std::scoped_lock lock(m_resourceMutex);
+        if (m_state != State::Idle)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "QuicSocket::connect() called, but a connection is already open or opening");
+            return;
+        }
+
+        if (!settings)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::connect() called with null settings");
+            invokeOnConnect(false);
+            return;
+        }
+
+        const std::chrono::seconds connectTimeout{ settings->getSocketConnectionTimeoutSeconds() };
+        m_connectDeadline = connectTimeout.count() > 0 ? std::chrono::steady_clock::now() + connectTimeout
+                                                       : std::chrono::steady_clock::time_point::max();
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Info,
+            "QuicSocket::connect() starting (host=%s, port=%u, clientId=%s)",
+            settings->getHost().c_str(),
+            settings->getPort(),
+            settings->getClientId().c_str());
+
+        m_hostLookup = HostResolver::instance().resolve(settings->getHost(), std::chrono::seconds{ settings->getDnsCacheTtlSeconds() });
+        m_state = State::Resolving;
+        if (m_hostLookup->getStatus() != HostLookup::Status::Pending && !openConnection(*settings))
+        {
+            failPendingConnect(*settings, "could not open the QUIC connection");
+        }
+    }
+
+    bool QuicSocket::openConnection(const mqtt::ConnectionSettings& settings)
+    {
+        const HostLookupPtr lookup = std::exchange(m_hostLookup, nullptr);
+        if (!lookup || lookup->getStatus() == HostLookup::Status::Failed)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::connect() could not resolve host (host=%s)", settings.getHost().c_str());
+            return false;
+        }
+
+        BIO_ADDR* peer = nullptr;
+        for (const std::string& address : lookup->getAddresses())
+        {
+            m_udpSocket = openUdpSocket(address, settings.getPort(), peer);
+            if (m_udpSocket >= 0)
+            {
+                break;
+            }
+        }
+        if (m_udpSocket < 0)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::connect() no usable address (host=%s)", settings.getHost().c_str());
+            return false;
+        }
+
+        const bool verify = settings.shouldVerifyServerCertificate();
+        m_sslCtx = TlsContextCache::instance().acquire(TlsContextKey{ verify, true });
+        m_ssl = m_sslCtx ? SSL_new(m_sslCtx.get()) : nullptr;
+        BIO* bio = m_ssl ? BIO_new_dgram(m_udpSocket, BIO_NOCLOSE) : nullptr;
+        if (nullptr == bio)
+        {
+            BIO_ADDR_free(peer);
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::connect() OpenSSL setup failed (0x%lx)", ERR_peek_last_error());
+            return false;
+        }
+        SSL_set_bio(m_ssl, bio, bio);
+
+        const std::string& host = settings.getHost();
+        const bool isConfigured = SSL_set_tlsext_host_name(m_ssl, host.c_str()) == 1
+            && SSL_set_alpn_protos(m_ssl, kAlpn.data(), kAlpn.size()) == 0 && SSL_set1_initial_peer_addr(m_ssl, peer) == 1
+            && SSL_set_blocking_mode(m_ssl, 0) == 1 && (!verify || SSL_set1_host(m_ssl, host.c_str()) == 1);
+        BIO_ADDR_free(peer);
+        if (!isConfigured)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::connect() could not configure QUIC (0x%lx)", ERR_peek_last_error());
+            return false;
+        }
+        SSL_set_verify(m_ssl, verify ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+
+        // Keyed by the broker's name rather than the address, which may change between connects.
+        m_sessionPeer = host + ":" + std::to_string(settings.getPort());
+        TlsContextCache::instance().prepareResumption(m_ssl, m_sessionPeer);
+
+        m_state = State::Handshaking;
+        m_hasFailed = false;
+        return true;
+    }
+
+    bool QuicSocket::advanceHandshake()
+    {
+        if (SSL_connect(m_ssl) == 1)
+        {
+            return true;
+        }
+
+        const int error = SSL_get_error(m_ssl, 0);
+        if (error != SSL_ERROR_WANT_READ && error != SSL_ERROR_WANT_WRITE)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket handshake failed (ssl error %d, 0x%lx)", error, ERR_peek_last_error());
+            m_hasFailed = true;
+        }
+        return false;
+    }
+
+    void QuicSocket::failPendingConnect(const mqtt::ConnectionSettings& settings, const char* reason)
+    {
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "QuicSocket::tick() connect did not complete (host=%s, port=%u, reason=%s)",
+            settings.getHost().c_str(),
+            settings.getPort(),
+            reason);
+        HostResolver::instance().forget(settings.getHost());
+        releaseConnection();
+        invokeOnConnect(false);
+    }
+
+    void QuicSocket::releaseConnection()
+    {
+        m_hostLookup.reset();
+        if (nullptr != m_ssl)
+        {
+            SSL_free(m_ssl);
+            m_ssl = nullptr;
+        }
+        m_sslCtx.reset();
+        if (m_udpSocket >= 0)
+        {
+            ::close(m_udpSocket);
+            m_udpSocket = -1;
+        }
+        m_sendBuffer.clear();
+        m_sendBufferReadOffset = 0;
+        m_state = State::Idle;
+    }
+
+    void QuicSocket::disconnect()
+    {
+        bool shouldInvokeCallback = false;
+        {
+            std::scoped_lock lock(m_resourceMutex);
+            if (m_state == State::Idle)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Debug, "QuicSocket::disconnect() called, but no connection is open");
+                return;
+            }
+
+            // Best effort: write anything still queued (for example a DISCONNECT) and start closing the connection.
+            if (m_state == State::Connected)
+            {
+                flushSendBuffer();
+                SSL_shutdown(m_ssl);
+            }
+            shouldInvokeCallback = m_state != State::Resolving;
+            releaseConnection();
+        }
+
+        if (shouldInvokeCallback)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "QuicSocket::disconnect() invoking disconnect callback");
+            invokeOnDisconnect();
+        }
+    }
+
+    void QuicSocket::close(int32_t /*code*/, const std::string& reason)
+    {
+        REACTORMQ_LOG(logging::LogLevel::Info, "QuicSocket::close() called (reason=%s)", reason.c_str());
+        disconnect();
+    }
+
+    bool QuicSocket::isConnected() const
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        return m_state == State::Connected;
+    }
+
+    void QuicSocket::send(const uint8_t* data, const uint32_t size)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Socket);
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        if (data == nullptr || size == 0 || !settings)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "QuicSocket::send() called with empty data or null settings");
+            return;
+        }
+
+        bool shouldDisconnect = false;
+        {
+            std::scoped_lock lock(m_resourceMutex);
+            if (m_state != State::Connected)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket::send() called while not connected");
+                return;
+            }
+
+            recordSent(size);
+            const SendBuffer buffer{ data, size };
+            tapSent(std::span{ &buffer, 1 }, size);
+            const size_t pendingBytes = m_sendBuffer.size() - m_sendBufferReadOffset;
+            if (pendingBytes + size > settings->getMaxBufferSize())
+            {
+                REACTORMQ_LOG(
+                    logging::LogLevel::Error,
+                    "QuicSocket::send(): outbound buffer limit exceeded (pending=%zu, incoming=%u, max=%u)",
+                    pendingBytes,
+                    size,
+                    settings->getMaxBufferSize());
+                shouldDisconnect = true;
+            }
+            else
+            {
+                m_sendBuffer.insert(m_sendBuffer.end(), data, data + size);
+                shouldDisconnect = !flushSendBuffer();
+            }
+        }
+
+        if (shouldDisconnect)
+        {
+            disconnect();
+        }
+    }
+
+    bool QuicSocket::flushSendBuffer()
+    {
+        while (m_sendBufferReadOffset < m_sendBuffer.size())
+        {
+            const size_t remaining = m_sendBuffer.size() - m_sendBufferReadOffset;
+            size_t bytesWritten = 0;
+            if (SSL_write_ex(m_ssl, m_sendBuffer.data() + m_sendBufferReadOffset, remaining, &bytesWritten) != 1)
+            {
+                const int error = SSL_get_error(m_ssl, 0);
+                if (error == SSL_ERROR_WANT_WRITE || error == SSL_ERROR_WANT_READ)
+                {
+                    return true;
+                }
+                REACTORMQ_LOG(logging::LogLevel::Error, "QuicSocket write failed (ssl error %d, 0x%lx)", error, ERR_peek_last_error());
+                return false;
+            }
+            m_sendBufferReadOffset += bytesWritten;
+        }
+
+        m_sendBuffer.clear();
+        m_sendBufferReadOffset = 0;
+        return true;
+    }
+
+    bool QuicSocket::readAvailableData()
+    {
+        REACTORMQ_TRACE_SCOPE("QuicSocket::readAvailableData");
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Socket);
+        if (isReceivePaused())
+        {
+            return true;
+        }
+
+        if (hasInboundBacklog())
+        {
+            return commitReceiveBuffer(0);
+        }
+
+        for (int reads = 0; reads < kMaxReadsPerTick; ++reads)
+        {
+            // A data callback may have disconnected, paused receiving, or left frames over the inbound budget.
+            if (nullptr == m_ssl || isReceivePaused() || hasInboundBacklog())
+            {
+                return true;
+            }
+
+            const size_t chunkSize = std::min(kMaxChunkSize, std::max<size_t>(getReceiveBufferRoom(), 1));
+            const std::span<uint8_t> target = prepareReceiveBuffer(chunkSize);
+            if (target.empty())
+            {
+                return false;
+            }
+
+            size_t bytesRead = 0;
+            if (SSL_read_ex(m_ssl, target.data(), target.size(), &bytesRead) != 1)
+            {
+                const int error = SSL_get_error(m_ssl, 0);
+                if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE)
+                {
+                    return true;
+                }
+                REACTORMQ_LOG(logging::LogLevel::Info, "QuicSocket stream closed (ssl error %d, 0x%lx)", error, ERR_peek_last_error());
+                return false;
+            }
+
+            if (!commitReceiveBuffer(bytesRead))
+            {
+                return false;
+            }
+            if (bytesRead < target.size())
+            {
+                return true;
+            }
+        }
+        return true;
+    }
+
+    void QuicSocket::tick()
+    {
+        bool shouldInvokeConnect = false;
+        bool shouldDisconnect = false;
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        {
+            std::scoped_lock lock(m_resourceMutex);
+            if (!settings || m_state == State::Idle)
+            {
+                return;
+            }
+
+            if (m_state != State::Connected && std::chrono::steady_clock::now() >= m_connectDeadline)
+            {
+                failPendingConnect(*settings, "timed out");
+                return;
+            }
+
+            if (m_state == State::Resolving)
+            {
+                if (m_hostLookup && m_hostLookup->getStatus() == HostLookup::Status::Pending)
+                {
+                    return;
+                }
+                if (!openConnection(*settings))
+                {
+                    failPendingConnect(*settings, "could not open the QUIC connection");
+                    return;
+                }
+            }
+
+            if (m_state == State::Handshaking)
+            {
+                if (!advanceHandshake())
+                {
+                    if (m_hasFailed)
+                    {
+                        failPendingConnect(*settings, "QUIC handshake failed");
+                    }
+                    return;
+                }
+
+                REACTORMQ_LOG(
+                    logging::LogLevel::Info,
+                    "QuicSocket::tick() connection established (host=%s, resumed=%s)",
+                    settings->getHost().c_str(),
+                    SSL_session_reused(m_ssl) == 1 ? "true" : "false");
+                m_state = State::Connected;
+                shouldInvokeConnect = true;
+            }
+            else
+            {
+                // Runs QUIC's timers: retransmission, acknowledgements and idle keep-alive.
+                SSL_handle_events(m_ssl);
+                shouldDisconnect = !flushSendBuffer() || !readAvailableData();
+            }
+        }
+
+        if (shouldInvokeConnect)
+        {
+            invokeOnConnect(true);
+        }
+
+        if (shouldDisconnect)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Info, "QuicSocket::tick() connection closed or failed");
+            disconnect();
+        }
+    }
+
+    size_t QuicSocket::getPendingSendBytes() const
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        return m_sendBuffer.size() - m_sendBufferReadOffset;
+    }
+
+    void QuicSocket::waitForActivity(WakeupHandle& wakeup, const std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock(m_resourceMutex);
+        if (nullptr == m_ssl || isReceivePaused())
+        {
+            const bool isResolving = m_state == State::Resolving;
+            lock.unlock();
+            wakeup.waitFor(isResolving ? std::min(timeout, kConnectPollInterval) : timeout);
+            return;
+        }
+
+        if (hasInboundBacklog() || SSL_pending(m_ssl) > 0)
+        {
+            return;
+        }
+
+        std::chrono::milliseconds wait = timeout;
+        timeval eventTimeout{};
+        if (int isInfinite = 0; SSL_get_event_timeout(m_ssl, &eventTimeout, &isInfinite) == 1 && isInfinite == 0)
+        {
+            const auto untilEvent = std::chrono::seconds{ eventTimeout.tv_sec } + std::chrono::microseconds{ eventTimeout.tv_usec };
+            wait = std::min(wait, std::chrono::ceil<std::chrono::milliseconds>(untilEvent));
+        }
+
+        std::array<pollfd, 2> descriptors{};
+        descriptors[0] = pollfd{ m_udpSocket, static_cast<short>(POLLIN | (SSL_net_write_desired(m_ssl) == 1 ? POLLOUT : 0)), 0 };
+        nfds_t count = 1;
+        if (const int wakeupDescriptor = wakeup.getReadDescriptor(); wakeupDescriptor != -1)
+        {
+            descriptors[count++] = pollfd{ wakeupDescriptor, POLLIN, 0 };
+        }
+        lock.unlock();
+
+        if (wakeup.isSignalled())
+        {
+            return;
+        }
+        if (count == 1)
+        {
+            // No selectable wakeup on this platform: keep the wait short so signals are noticed.
+            wait = std::min(wait, kConnectPollInterval);
+        }
+        ::poll(descriptors.data(), count, static_cast<int>(wait.count()));
+    }
+
+    PollRegistration QuicSocket::getPollRegistration() const
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        if (nullptr == m_ssl)
+        {
+            return {};
+        }
+
+        PollRegistration registration;
+        registration.handle = m_udpSocket;
+        registration.interest = isReceivePaused() ? PollEvents::None : PollEvents::Readable;
+        if (SSL_net_write_desired(m_ssl) == 1)
+        {
+            registration.interest |= PollEvents::Writable;
+        }
+        registration.hasBufferedInput = !isReceivePaused() && (hasInboundBacklog() || SSL_pending(m_ssl) > 0);
+        return registration;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_WITH_QUIC
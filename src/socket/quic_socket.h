@@ -0,0 +1,153 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#if REACTORMQ_WITH_QUIC
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "socket/host_resolver.h"
+#include "socket/platform/tls_context_cache.h"
+#include "socket/socket.h"
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Socket that carries MQTT over QUIC (ALPN "mqtt"), using OpenSSL's QUIC client.
+     *
+     * The MQTT stream runs on one client-initiated bidirectional QUIC stream over a non-blocking UDP socket. The
+     * handshake is TLS 1.3 and, like SecureSocket's, offers the session saved by the previous connection to the same
+     * broker, so a reconnect resumes without a certificate exchange. OpenSSL drives QUIC's timers from
+     * SSL_handle_events(), which tick() calls; waitForActivity() never sleeps past the next timer.
+     */
+    class QuicSocket final
+        : public Socket
+        , public std::enable_shared_from_this<QuicSocket>
+    {
+    public:
+        explicit QuicSocket(mqtt::ConnectionSettingsPtr settings);
+
+        ~QuicSocket() override;
+
+        const char* getImplementationId() const override
+        {
+            return "QuicSocket";
+        }
+
+        OnConnectCallback& getOnConnectCallback() override
+        {
+            return m_onConnect;
+        }
+
+        OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return m_onDisconnect;
+        }
+
+        OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return m_onDataReceived;
+        }
+
+        [[nodiscard]] size_t getPendingSendBytes() const override;
+
+        void waitForActivity(WakeupHandle& wakeup, std::chrono::milliseconds timeout) override;
+
+        [[nodiscard]] PollRegistration getPollRegistration() const override;
+
+    private:
+        /// @brief Where the connection is; guarded by the resource mutex.
+        enum class State : std::uint8_t
+        {
+            Idle,
+            Resolving,
+            Handshaking,
+            Connected,
+        };
+
+        void connect() override;
+
+        void disconnect() override;
+
+        void close(int32_t code, const std::string& reason) override;
+
+        [[nodiscard]] bool isConnected() const override;
+
+        void send(const uint8_t* data, uint32_t size) override;
+
+        void tick() override;
+
+        /**
+         * @brief Open the UDP socket to the first usable resolved address and start the QUIC handshake.
+         * Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         * @return False if no address could be used or OpenSSL refused the connection object.
+         */
+        bool openConnection(const mqtt::ConnectionSettings& settings);
+
+        /**
+         * @brief Advance the handshake.
+         * @return True once it has finished; false while it is in progress. Sets m_hasFailed when it failed.
+         */
+        bool advanceHandshake();
+
+        /**
+         * @brief Give up on the connect in progress and report it through the connect callback.
+         * Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         * @param reason Why the connect was given up, for the log.
+         */
+        void failPendingConnect(const mqtt::ConnectionSettings& settings, const char* reason);
+
+        /// @brief Free the QUIC connection and UDP socket and drop any unsent bytes. Called with the resource mutex held.
+        void releaseConnection();
+
+        /**
+         * @brief Read what the stream has into the receive buffer and dispatch the packets it completes.
+         * @return False once the broker closed the stream or the connection failed.
+         */
+        bool readAvailableData();
+
+        /**
+         * @brief Write queued bytes to the stream until it stops taking them.
+         * @return False on a connection error; flow control holding the bytes back is not an error.
+         */
+        bool flushSendBuffer();
+
+        /// Reads per readAvailableData() call, so one busy connection cannot hold its reactor thread.
+        static constexpr int kMaxReadsPerTick = 4;
+
+        static constexpr size_t kMaxChunkSize = 64 * 1024;
+
+        /// Longest blocking wait while the broker's host name is being resolved.
+        static constexpr std::chrono::milliseconds kConnectPollInterval{ 5 };
+
+        State m_state = State::Idle;
+        bool m_hasFailed = false; ///< Set by advanceHandshake() when the handshake failed.
+        HostLookupPtr m_hostLookup; ///< Lookup of the broker's address while connect() waits for it; null otherwise.
+        SslContextPtr m_sslCtx; ///< Shared QUIC client context from TlsContextCache.
+        SSL* m_ssl = nullptr; ///< QUIC connection; its default stream carries MQTT.
+        int m_udpSocket = -1; ///< Non-blocking UDP socket; owned here, the datagram BIO does not close it.
+        std::string m_sessionPeer; ///< "host:port" sessions are saved under; must outlive m_ssl.
+        /// When a connect still in progress is given up, from ConnectionSettings::getSocketConnectionTimeoutSeconds().
+        std::chrono::steady_clock::time_point m_connectDeadline = std::chrono::steady_clock::time_point::max();
+
+        std::vector<uint8_t> m_sendBuffer; ///< Bytes accepted by send() but not yet taken by the stream.
+        size_t m_sendBufferReadOffset = 0; ///< Offset into the send buffer for already-written bytes.
+
+        mutable std::recursive_mutex m_resourceMutex;
+
+        OnConnectCallback m_onConnect;
+        OnDisconnectCallback m_onDisconnect;
+        OnDataReceivedCallback m_onDataReceived;
+    };
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_WITH_QUIC
@@ -4,19 +4,32 @@
 
 #include "socket/secure_socket.h"
 
+#include "socket/connection_race.h"
+#include "socket/host_resolver.h"
 #include "socket/platform/socket_error.h"
+#include "util/trace/memory_tags.h"
+#include "util/trace/trace.h"
 
 #if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
 #include "socket/platform/platform_secure_socket.h"
 #endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
 
 namespace reactormq::socket
 {
     SecureSocket::SecureSocket(mqtt::ConnectionSettingsPtr settings)
         : Socket(std::move(settings))
     {
+        if (getSettings() && getSettings()->getFixedCapacity().isEnabled)
+        {
+            m_sendBuffer.reserve(getSettings()->getMaxOutboundQueueBytes());
+        }
+
         if (settings)
         {
             REACTORMQ_LOG(
@@ -46,7 +59,7 @@ namespace reactormq::socket
     {
         auto self = shared_from_this();
         {
-            mqtt::ConnectionSettingsPtr settings = getSettings();
+            const mqtt::ConnectionSettingsPtr& settings = getSettings();
             std::scoped_lock lock(m_resourceMutex);
             if (m_socketPtr && m_socketPtr->isConnected())
             {
@@ -67,62 +80,292 @@ namespace reactormq::socket
                 return;
             }
 
-            const std::string host = settings->getHost();
-            const std::uint16_t port = settings->getPort();
+            const std::string& host = settings->getHost();
+            const mqtt::ConnectionProtocol protocol = settings->getProtocol();
+            m_webSocket = protocol == mqtt::ConnectionProtocol::Ws || protocol == mqtt::ConnectionProtocol::Wss
+                              ? std::make_unique<WebSocketCodec>(settings->getWebSocketDeflate(), settings->getMaxBufferSize())
+                              : nullptr;
+            const std::chrono::seconds connectTimeout{ settings->getSocketConnectionTimeoutSeconds() };
+            m_connectDeadline = connectTimeout.count() > 0 ? std::chrono::steady_clock::now() + connectTimeout
+                                                           : std::chrono::steady_clock::time_point::max();
 
             REACTORMQ_LOG(
                 logging::LogLevel::Info,
                 "SecureSocket::connect() starting (host=%s, port=%u, clientId=%s)",
                 host.c_str(),
-                port,
+                settings->getPort(),
                 settings->getClientId().c_str());
 
-#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
-            if (const mqtt::ConnectionProtocol protocol = settings->getProtocol();
-                protocol == mqtt::ConnectionProtocol::Tls || protocol == mqtt::ConnectionProtocol::Wss)
-            {
-                REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::connect() using PlatformSecureSocket (protocol=%d)", protocol);
-                m_socketPtr = std::make_unique<PlatformSecureSocket>(settings);
-            }
-            else
-#endif
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+            // A Unix domain socket is named by its path, which is not resolved.
+            if (protocol != mqtt::ConnectionProtocol::Unix)
             {
-                REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::connect() using PlatformSocket (non-TLS)");
-                m_socketPtr = std::make_unique<PlatformSocket>();
+                m_hostLookup = HostResolver::instance().resolve(host, std::chrono::seconds{ settings->getDnsCacheTtlSeconds() });
+                if (m_hostLookup->getStatus() == HostLookup::Status::Pending)
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::connect() waiting for DNS (host=%s)", host.c_str());
+                    return;
+                }
             }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+            openTransport(*settings);
+        }
+    }
 
-            if (const int result = m_socketPtr->connect(host, port); result != 0)
+    void SecureSocket::openTransport(const mqtt::ConnectionSettings& settings)
+    {
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+        if (const HostLookupPtr lookup = std::exchange(m_hostLookup, nullptr); lookup)
+        {
+            if (lookup->getStatus() == HostLookup::Status::Failed)
             {
-                const int32_t error = PlatformSocket::getLastErrorCode();
                 REACTORMQ_LOG(
                     logging::LogLevel::Error,
-                    "SecureSocket::connect() failed (host=%s, port=%u, result=%d, error=%d: %s)",
-                    host.c_str(),
-                    port,
-                    result,
-                    error,
-                    PlatformSocket::getNetworkErrorDescription(error));
+                    "SecureSocket::connect() could not resolve host (host=%s, port=%u)",
+                    settings.getHost().c_str(),
+                    settings.getPort());
                 m_connectCallbackInvoked.store(true, std::memory_order_release);
                 invokeOnConnect(false);
                 return;
             }
 
-            if (m_socketPtr->isConnected())
-            {
-                REACTORMQ_LOG(
-                    logging::LogLevel::Info,
-                    "SecureSocket::connect() succeeded (host=%s, port=%u, clientId=%s)",
-                    host.c_str(),
-                    port,
-                    settings->getClientId().c_str());
-                m_connectCallbackInvoked.store(true, std::memory_order_release);
-                invokeOnConnect(true);
-            }
-            else
+            m_connectionRace = std::make_unique<ConnectionRace>(
+                lookup->getAddresses(),
+                settings.getPort(),
+                ConnectionRace::kDefaultAttemptDelay,
+                settings.getSocketOptions());
+            pollConnectionRace(settings);
+            return;
+        }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+        m_socketPtr = createTransport(settings);
+        const int result = settings.getProtocol() == mqtt::ConnectionProtocol::Unix
+                               ? m_socketPtr->connectLocal(settings.getHost())
+                               : m_socketPtr->connect(settings.getHost(), settings.getPort());
+        finishConnect(settings, result, settings.getHost());
+    }
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+    void SecureSocket::pollConnectionRace(const mqtt::ConnectionSettings& settings)
+    {
+        const ConnectionRace::Status status = m_connectionRace->poll(std::chrono::steady_clock::now());
+        if (status == ConnectionRace::Status::Racing)
+        {
+            return;
+        }
+
+        const std::unique_ptr<ConnectionRace> race = std::move(m_connectionRace);
+        if (status == ConnectionRace::Status::Failed)
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "SecureSocket::connect() failed on every address (host=%s, port=%u, attempts=%zu)",
+                settings.getHost().c_str(),
+                settings.getPort(),
+                race->getAttemptCount());
+            HostResolver::instance().forget(settings.getHost());
+            m_connectCallbackInvoked.store(true, std::memory_order_release);
+            invokeOnConnect(false);
+            return;
+        }
+
+        const std::unique_ptr<PlatformSocket> winner = race->takeWinner();
+        m_socketPtr = createTransport(settings);
+        finishConnect(settings, m_socketPtr->adoptConnection(*winner, settings.getHost(), settings.getPort()), race->getWinningAddress());
+    }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+    std::unique_ptr<PlatformSocket> SecureSocket::createTransport(const mqtt::ConnectionSettings& settings) const
+    {
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+        if (const mqtt::ConnectionProtocol protocol = settings.getProtocol();
+            protocol == mqtt::ConnectionProtocol::Tls || protocol == mqtt::ConnectionProtocol::Wss)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::connect() using PlatformSecureSocket (protocol=%d)", protocol);
+            auto transport = std::make_unique<PlatformSecureSocket>(getSettings());
+            transport->setOptions(settings.getSocketOptions());
+            return transport;
+        }
+#endif
+        REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::connect() using PlatformSocket (non-TLS)");
+        auto transport = std::make_unique<PlatformSocket>();
+        transport->setOptions(settings.getSocketOptions());
+        return transport;
+    }
+
+    void SecureSocket::finishConnect(const mqtt::ConnectionSettings& settings, const int result, const std::string& address)
+    {
+        const std::string& host = settings.getHost();
+        const std::uint16_t port = settings.getPort();
+        if (result != 0)
+        {
+            const int32_t error = PlatformSocket::getLastErrorCode();
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "SecureSocket::connect() failed (host=%s, address=%s, port=%u, result=%d, error=%d: %s)",
+                host.c_str(),
+                address.c_str(),
+                port,
+                result,
+                error,
+                PlatformSocket::getNetworkErrorDescription(error));
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+            HostResolver::instance().forget(host);
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+            m_connectCallbackInvoked.store(true, std::memory_order_release);
+            invokeOnConnect(false);
+            return;
+        }
+
+        if (m_socketPtr->isConnected())
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Info,
+                "SecureSocket::connect() succeeded (host=%s, address=%s, port=%u, clientId=%s)",
+                host.c_str(),
+                address.c_str(),
+                port,
+                settings.getClientId().c_str());
+            if (m_webSocket)
             {
-                REACTORMQ_LOG(logging::LogLevel::Warn, "SecureSocket::connect() returned success but socket not reported as connected");
+                startWebSocketUpgrade(settings);
+                return;
             }
+            m_connectCallbackInvoked.store(true, std::memory_order_release);
+            invokeOnConnect(true);
+        }
+        else
+        {
+            REACTORMQ_LOG(logging::LogLevel::Warn, "SecureSocket::connect() returned success but socket not reported as connected");
+        }
+    }
+
+    void SecureSocket::startWebSocketUpgrade(const mqtt::ConnectionSettings& settings)
+    {
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "SecureSocket::connect() requesting WebSocket upgrade (host=%s, path=%s)",
+            settings.getHost().c_str(),
+            settings.getPath().c_str());
+
+        // The request rides the control lane, which is empty this early and written before any data packet.
+        const std::string request = m_webSocket->createUpgradeRequest(settings.getHost(), settings.getPort(), settings.getPath());
+        m_controlBuffer.insert(m_controlBuffer.end(), request.begin(), request.end());
+    }
+
+    WebSocketCodec::UpgradeStatus SecureSocket::readUpgradeResponse()
+    {
+        const std::span<uint8_t> target = prepareReceiveBuffer(kMaxChunkSize);
+        if (target.empty())
+        {
+            return WebSocketCodec::UpgradeStatus::Rejected;
         }
+
+        size_t bytesRead = 0;
+        if (!m_socketPtr->tryReceive(target.data(), kMaxChunkSize, bytesRead))
+        {
+            return PlatformSocket::getLastError() == SocketError::WouldBlock ? WebSocketCodec::UpgradeStatus::Pending
+                                                                              : WebSocketCodec::UpgradeStatus::Rejected;
+        }
+        if (bytesRead == 0)
+        {
+            return WebSocketCodec::UpgradeStatus::Pending;
+        }
+
+        size_t consumed = 0;
+        const WebSocketCodec::UpgradeStatus status = m_webSocket->readUpgradeResponse(target.first(bytesRead), consumed);
+        if (status != WebSocketCodec::UpgradeStatus::Accepted || consumed == bytesRead)
+        {
+            return status;
+        }
+
+        // Frames that arrived together with the response are already in the receive buffer; move them to its front.
+        const size_t frameBytes = bytesRead - consumed;
+        std::memmove(target.data(), target.data() + consumed, frameBytes);
+        size_t payloadSize = 0;
+        if (!decodeWebSocketFrames(target.first(frameBytes), payloadSize) || !commitWebSocketPayload(payloadSize))
+        {
+            return WebSocketCodec::UpgradeStatus::Rejected;
+        }
+        return status;
+    }
+
+    bool SecureSocket::decodeWebSocketFrames(const std::span<uint8_t> data, size_t& outPayloadSize)
+    {
+        const bool isOpen = m_webSocket->decode(data, outPayloadSize);
+
+        // Pongs and the close reply are control frames; they may only go out between data frames, like PINGREQ.
+        if (std::vector<uint8_t>& replies = m_webSocket->getPendingControlFrames(); !replies.empty())
+        {
+            m_controlBuffer.insert(m_controlBuffer.end(), replies.begin(), replies.end());
+            replies.clear();
+        }
+
+        if (!isOpen)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Info, "SecureSocket::readAvailableData() WebSocket closed");
+        }
+        return isOpen;
+    }
+
+    bool SecureSocket::commitWebSocketPayload(const size_t payloadSize)
+    {
+        if (!commitReceiveBuffer(payloadSize))
+        {
+            return false;
+        }
+
+        // Inflated bytes do not fit where the frames were read, so they are appended behind them.
+        std::vector<uint8_t>& decoded = m_webSocket->getDecodedPayload();
+        const bool isValid = processPacketData(decoded.data(), decoded.size());
+        decoded.clear();
+        return isValid;
+    }
+
+    bool SecureSocket::wantsWritable() const
+    {
+        const bool isUpgrading = m_webSocket && m_webSocket->getState() == WebSocketCodec::State::Upgrading;
+        if ((!m_connectCallbackInvoked.load(std::memory_order_acquire) && !isUpgrading) || getPendingSendBytes() != 0)
+        {
+            return true;
+        }
+
+        std::scoped_lock lock(m_resourceMutex);
+        return !m_sendStreams.empty();
+    }
+
+    bool SecureSocket::isConnectPending() const
+    {
+        if (m_connectCallbackInvoked.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+        if (m_hostLookup || m_connectionRace)
+        {
+            return true;
+        }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+        return m_socketPtr != nullptr;
+    }
+
+    void SecureSocket::failPendingConnect(const mqtt::ConnectionSettings& settings, const char* reason)
+    {
+        REACTORMQ_LOG(
+            logging::LogLevel::Error,
+            "SecureSocket::tick() connect did not complete (host=%s, port=%u, reason=%s)",
+            settings.getHost().c_str(),
+            settings.getPort(),
+            reason);
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+        m_hostLookup.reset();
+        m_connectionRace.reset();
+        HostResolver::instance().forget(settings.getHost());
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+        m_connectCallbackInvoked.store(true, std::memory_order_release);
+        invokeOnConnect(false);
     }
 
     void SecureSocket::disconnect()
@@ -131,21 +374,52 @@ namespace reactormq::socket
 
         {
             std::scoped_lock lock(m_resourceMutex);
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+            m_hostLookup.reset();
+            m_connectionRace.reset();
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
             if (nullptr == m_socketPtr)
             {
                 REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::disconnect() called, but socket pointer is null");
             }
             else
             {
-                const mqtt::ConnectionSettingsPtr settings = getSettings();
+                const mqtt::ConnectionSettingsPtr& settings = getSettings();
                 REACTORMQ_LOG(
                     logging::LogLevel::Info,
                     "SecureSocket::disconnect() closing connection (host=%s, clientId=%s)",
                     settings ? settings->getHost().c_str() : "<null>",
                     settings ? settings->getClientId().c_str() : "<null>");
 
+                // Best effort: write anything still gathered (for example a DISCONNECT) before the handle goes away.
+                if (m_socketPtr->isConnected())
+                {
+                    if (m_webSocket && m_webSocket->getState() == WebSocketCodec::State::Open)
+                    {
+                        m_webSocket->appendCloseFrame(WebSocketCodec::kCloseNormal, m_controlBuffer);
+                    }
+                    flushSendBuffer();
+                }
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+                else if (!m_connectCallbackInvoked.load(std::memory_order_acquire) && settings)
+                {
+                    // The cached address may be the reason the connect never completed; resolve afresh next time.
+                    HostResolver::instance().forget(settings->getHost());
+                }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+
                 shouldInvokeCallback = true;
                 m_socketPtr.reset();
+                m_sendBuffer.clear();
+                m_sendBufferReadOffset = 0;
+                m_sendBufferPacketEnds.clear();
+                m_isSendBufferMidPacket = false;
+                m_sendStreams.clear();
+                m_streamChunk.clear();
+                m_streamChunkOffset = 0;
+                m_controlBuffer.clear();
+                m_controlBufferReadOffset = 0;
+                m_webSocket.reset();
                 m_connectCallbackInvoked.store(false, std::memory_order_release);
             }
         }
@@ -159,7 +433,7 @@ namespace reactormq::socket
 
     void SecureSocket::close(int32_t /*code*/, const std::string& reason)
     {
-        const mqtt::ConnectionSettingsPtr settings = getSettings();
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
         REACTORMQ_LOG(
             logging::LogLevel::Info,
             "SecureSocket::close() called (reason=%s, host=%s, clientId=%s)",
@@ -178,91 +452,685 @@ namespace reactormq::socket
 
     void SecureSocket::send(const uint8_t* data, const uint32_t size)
     {
-        const mqtt::ConnectionSettingsPtr settings = getSettings();
         if (data == nullptr || size == 0)
         {
             REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::send() called with empty or null data");
             return;
         }
+
+        const SendBuffer buffer{ data, size };
+        sendVectored(std::span{ &buffer, 1 });
+    }
+
+    void SecureSocket::sendVectored(std::span<const SendBuffer> buffers, const size_t packetCount)
+    {
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Socket);
+        size_t totalSize = 0;
+        for (const SendBuffer& buffer : buffers)
+        {
+            totalSize += buffer.size;
+        }
+
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        if (totalSize == 0)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::sendVectored() called with empty data");
+            return;
+        }
         if (!settings)
         {
-            REACTORMQ_LOG(logging::LogLevel::Error, "SecureSocket::send() called while settings are null");
+            REACTORMQ_LOG(logging::LogLevel::Error, "SecureSocket::sendVectored() called while settings are null");
             return;
         }
-        if (nullptr == m_socketPtr)
+
+        bool shouldDisconnect = false;
         {
-            REACTORMQ_LOG(
-                logging::LogLevel::Error,
-                "SecureSocket::send() called with null socket (host=%s, clientId=%s)",
-                settings->getHost().c_str(),
-                settings->getClientId().c_str());
+            std::scoped_lock lock(m_resourceMutex);
+            if (nullptr == m_socketPtr)
+            {
+                REACTORMQ_LOG(
+                    logging::LogLevel::Error,
+                    "SecureSocket::sendVectored() called with null socket (host=%s, clientId=%s)",
+                    settings->getHost().c_str(),
+                    settings->getClientId().c_str());
+                return;
+            }
+
+            recordSent(totalSize, packetCount);
+            tapSent(buffers, totalSize);
+
+            // One binary frame per send, which only ever holds whole packets, so the control lane still only cuts in at
+            // packet (and frame) boundaries.
+            SendBuffer frame;
+            if (m_webSocket)
+            {
+                frame = m_webSocket->encodeBinaryFrame(buffers);
+                buffers = std::span{ &frame, 1 };
+                totalSize = frame.size;
+            }
+
+            if (m_isCoalescing)
+            {
+                if (canCoalesce(m_sendBuffer.size() - m_sendBufferReadOffset, totalSize, *settings))
+                {
+                    if (m_sendBufferReadOffset == m_sendBuffer.size())
+                    {
+                        m_coalesceStartTime = std::chrono::steady_clock::now();
+                    }
+                    queueUnsent(buffers, 0);
+                    return;
+                }
+
+                // A cap was hit: write what has been gathered so far, then handle this send normally.
+                shouldDisconnect = !flushSendBuffer();
+            }
+
+            size_t bytesWritten = 0;
+            const size_t pendingBytes = getPendingSendBytes();
+            const bool canWriteDirectly = pendingBytes == 0 && m_sendStreams.empty();
+            if (shouldDisconnect || (canWriteDirectly && !writeToSocket(buffers, bytesWritten)))
+            {
+                shouldDisconnect = true;
+            }
+            else if (const size_t remaining = totalSize - bytesWritten; remaining > 0)
+            {
+                if (pendingBytes + remaining > settings->getMaxBufferSize())
+                {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Error,
+                        "SecureSocket::sendVectored(): outbound buffer limit exceeded (pending=%zu, incoming=%zu, max=%u)",
+                        pendingBytes,
+                        remaining,
+                        settings->getMaxBufferSize());
+                    shouldDisconnect = true;
+                }
+                else
+                {
+                    REACTORMQ_LOG_RATELIMITED(
+                        logging::LogLevel::Trace,
+                        100,
+                        "SecureSocket::sendVectored(): queueing %zu bytes (pending=%zu)",
+                        remaining,
+                        pendingBytes);
+                    queueUnsent(buffers, bytesWritten);
+                }
+            }
+        }
+
+        if (shouldDisconnect)
+        {
+            disconnect();
+        }
+    }
+
+    bool SecureSocket::sendStream(const std::span<const std::byte> header, const mqtt::PayloadSourcePtr& source)
+    {
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        if (header.empty() || !source)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::sendStream() called with empty header or null source");
+            return false;
+        }
+        if (!settings)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "SecureSocket::sendStream() called while settings are null");
+            return false;
+        }
+
+        bool shouldDisconnect = false;
+        {
+            std::scoped_lock lock(m_resourceMutex);
+            if (nullptr == m_socketPtr)
+            {
+                REACTORMQ_LOG(
+                    logging::LogLevel::Error,
+                    "SecureSocket::sendStream() called with null socket (host=%s, clientId=%s)",
+                    settings->getHost().c_str(),
+                    settings->getClientId().c_str());
+                return false;
+            }
+
+            const size_t payloadSize = source->getSize();
+            recordSent(header.size() + payloadSize, 1);
+            const SendBuffer headerBuffer{ reinterpret_cast<const uint8_t*>(header.data()), header.size() };
+            tapSent(std::span{ &headerBuffer, 1 }, header.size() + payloadSize);
+            if (m_isCoalescing && m_sendBufferReadOffset == m_sendBuffer.size())
+            {
+                m_coalesceStartTime = std::chrono::steady_clock::now();
+            }
+
+            // Only the header is queued; the payload is read from the source once the transport has taken everything ahead
+            // of it, so however large it is, it never sits in the send buffer.
+            if (m_webSocket)
+            {
+                m_webSocket->appendBinaryFrame(std::span{ &headerBuffer, 1 }, m_sendBuffer);
+            }
+            else
+            {
+                m_sendBuffer.insert(m_sendBuffer.end(), headerBuffer.data, headerBuffer.data + headerBuffer.size);
+            }
+            m_sendStreams.push_back(PendingStream{ m_sendBuffer.size(), source, payloadSize });
+            m_sendBufferPacketEnds.push_back(m_sendBuffer.size());
+
+            shouldDisconnect = !m_isCoalescing && !flushSendBuffer();
+        }
+
+        if (shouldDisconnect)
+        {
+            disconnect();
+        }
+        return true;
+    }
+
+    void SecureSocket::sendControl(const std::span<const std::byte> data, const size_t packetCount)
+    {
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        if (data.empty())
+        {
+            REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::sendControl() called with empty data");
+            return;
+        }
+        if (!settings)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "SecureSocket::sendControl() called while settings are null");
             return;
         }
 
-        size_t totalBytesSent = 0;
-        while (totalBytesSent < static_cast<size_t>(size))
+        bool shouldDisconnect = false;
         {
-            size_t bytesSent = 0;
-            if (const auto remaining = size - static_cast<uint32_t>(totalBytesSent);
-                !m_socketPtr->trySend(data + totalBytesSent, remaining, bytesSent))
+            std::scoped_lock lock(m_resourceMutex);
+            if (nullptr == m_socketPtr)
             {
-                const int32_t errorCode = PlatformSocket::getLastErrorCode();
                 REACTORMQ_LOG(
                     logging::LogLevel::Error,
-                    "SecureSocket::send(): trySend failed (error=%d: %s)",
-                    errorCode,
-                    PlatformSocket::getNetworkErrorDescription(errorCode));
-                disconnect();
+                    "SecureSocket::sendControl() called with null socket (host=%s, clientId=%s)",
+                    settings->getHost().c_str(),
+                    settings->getClientId().c_str());
                 return;
             }
-            if (bytesSent == 0)
+
+            recordSent(data.size(), packetCount);
+            tapSent(data);
+
+            // The control lane has its own limit so a full data backlog cannot turn a PINGREQ into a disconnect.
+            if (const size_t pendingBytes = m_controlBuffer.size() - m_controlBufferReadOffset;
+                pendingBytes + data.size() > settings->getMaxBufferSize())
+            {
+                REACTORMQ_LOG(
+                    logging::LogLevel::Error,
+                    "SecureSocket::sendControl(): control buffer limit exceeded (pending=%zu, incoming=%zu, max=%u)",
+                    pendingBytes,
+                    data.size(),
+                    settings->getMaxBufferSize());
+                shouldDisconnect = true;
+            }
+            else
+            {
+                const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+                if (m_webSocket)
+                {
+                    const SendBuffer payload{ bytes, data.size() };
+                    m_webSocket->appendBinaryFrame(std::span{ &payload, 1 }, m_controlBuffer);
+                }
+                else
+                {
+                    m_controlBuffer.insert(m_controlBuffer.end(), bytes, bytes + data.size());
+                }
+
+                // While coalescing the lane is written by flushCoalesced(), still ahead of the gathered data.
+                shouldDisconnect = !m_isCoalescing && !flushSendBuffer();
+            }
+        }
+
+        if (shouldDisconnect)
+        {
+            disconnect();
+        }
+    }
+
+    void SecureSocket::beginCoalescing()
+    {
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        std::scoped_lock lock(m_resourceMutex);
+        m_isCoalescing = settings && settings->getOutboundCoalesceMaxBytes() > 0;
+    }
+
+    void SecureSocket::flushCoalesced()
+    {
+        bool shouldDisconnect = false;
+        {
+            std::scoped_lock lock(m_resourceMutex);
+            if (!m_isCoalescing)
+            {
+                return;
+            }
+
+            m_isCoalescing = false;
+            if (m_socketPtr && m_socketPtr->isConnected())
+            {
+                shouldDisconnect = !flushSendBuffer();
+            }
+        }
+
+        if (shouldDisconnect)
+        {
+            disconnect();
+        }
+    }
+
+    bool SecureSocket::canCoalesce(const size_t pendingBytes, const size_t incomingBytes, const mqtt::ConnectionSettings& settings) const
+    {
+        if (pendingBytes + incomingBytes > settings.getOutboundCoalesceMaxBytes())
+        {
+            return false;
+        }
+
+        const auto maxDelay = std::chrono::milliseconds(settings.getOutboundCoalesceMaxDelayMs());
+        return pendingBytes == 0 || std::chrono::steady_clock::now() - m_coalesceStartTime < maxDelay;
+    }
+
+    size_t SecureSocket::getPendingSendBytes() const
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        // Bytes a stream has yet to read from its source are not counted: they take no memory until the transport drains.
+        return m_sendBuffer.size() - m_sendBufferReadOffset + m_streamChunk.size() - m_streamChunkOffset + m_controlBuffer.size()
+            - m_controlBufferReadOffset;
+    }
+
+    void SecureSocket::waitForActivity(WakeupHandle& wakeup, const std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock(m_resourceMutex);
+        if (nullptr == m_socketPtr)
+        {
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+            // Neither the resolver thread nor the racing attempts signal the wakeup, so look at them again soon.
+            const bool isConnecting = m_hostLookup != nullptr || m_connectionRace != nullptr;
+#else
+            constexpr bool isConnecting = false;
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+            lock.unlock();
+            wakeup.waitFor(isConnecting ? std::min(timeout, kConnectPollInterval) : timeout);
+            return;
+        }
+
+        // A paused receive leaves its bytes unread, which would end a wait on readability at once; the wakeup that
+        // resumes it ends this one instead.
+        if (isReceivePaused())
+        {
+            lock.unlock();
+            wakeup.waitFor(timeout);
+            return;
+        }
+
+        // Bytes already decrypted by TLS or held back by the inbound budget will not make the socket readable again;
+        // bytes still in the kernel do, so they need no probe.
+        if (hasInboundBacklog() || m_socketPtr->hasBufferedInput())
+        {
+            return;
+        }
+
+        m_socketPtr->waitForIo(wakeup, wantsWritable(), timeout);
+    }
+
+    PollRegistration SecureSocket::getPollRegistration() const
+    {
+        std::scoped_lock lock(m_resourceMutex);
+        if (nullptr == m_socketPtr)
+        {
+            return {};
+        }
+
+        PollRegistration registration;
+        registration.handle = m_socketPtr->getSocketDescriptor();
+        registration.interest = isReceivePaused() ? PollEvents::None : PollEvents::Readable;
+        if (wantsWritable())
+        {
+            registration.interest |= PollEvents::Writable;
+        }
+        registration.hasBufferedInput = !isReceivePaused() && (hasInboundBacklog() || m_socketPtr->hasBufferedInput());
+        return registration;
+    }
+
+    bool SecureSocket::writeToSocket(const std::span<const SendBuffer> buffers, size_t& outBytesWritten)
+    {
+        outBytesWritten = 0;
+        size_t index = 0;
+        size_t offset = 0;
+        while (index < buffers.size())
+        {
+            std::array<SendBuffer, kMaxSendBuffers> pending{};
+            size_t count = 0;
+            for (size_t i = index; i < buffers.size() && count < pending.size(); ++i)
+            {
+                const size_t skip = i == index ? offset : 0;
+                pending[count++] = SendBuffer{ buffers[i].data + skip, buffers[i].size - skip };
+            }
+
+            size_t bytesSent = 0;
+            if (!m_socketPtr->trySendVectored(std::span{ pending.data(), count }, bytesSent))
             {
                 if (const SocketError err = PlatformSocket::getLastError(); err == SocketError::WouldBlock)
                 {
-                    REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::send(): WouldBlock, deferring");
-                    return;
+                    REACTORMQ_LOG_RATELIMITED(
+                        logging::LogLevel::Trace, 100, "SecureSocket::writeToSocket(): WouldBlock after %zu bytes", outBytesWritten);
+                    return true;
                 }
                 const int32_t errorCode = PlatformSocket::getLastErrorCode();
                 REACTORMQ_LOG(
                     logging::LogLevel::Error,
-                    "SecureSocket::send(): zero bytes sent (error=%d: %s)",
+                    "SecureSocket::writeToSocket(): trySendVectored failed (error=%d: %s)",
                     errorCode,
                     PlatformSocket::getNetworkErrorDescription(errorCode));
-                disconnect();
-                return;
+                return false;
+            }
+
+            outBytesWritten += bytesSent;
+            offset += bytesSent;
+            while (index < buffers.size() && offset >= buffers[index].size)
+            {
+                offset -= buffers[index].size;
+                ++index;
+            }
+
+            if (bytesSent == 0)
+            {
+                // Transport accepted nothing (kernel buffer full or TLS wants I/O); retry on a later tick.
+                return true;
+            }
+        }
+        return true;
+    }
+
+    void SecureSocket::queueUnsent(const std::span<const SendBuffer> buffers, size_t bytesWritten)
+    {
+        // Only a send that found the buffer empty is written directly, so a partial write leaves its tail at the front.
+        m_isSendBufferMidPacket = m_isSendBufferMidPacket || bytesWritten > 0;
+        for (const SendBuffer& buffer : buffers)
+        {
+            if (bytesWritten >= buffer.size)
+            {
+                bytesWritten -= buffer.size;
+                continue;
             }
-            totalBytesSent += bytesSent;
+            m_sendBuffer.insert(m_sendBuffer.end(), buffer.data + bytesWritten, buffer.data + buffer.size);
+            bytesWritten = 0;
         }
+        m_sendBufferPacketEnds.push_back(m_sendBuffer.size());
+    }
+
+    bool SecureSocket::flushSendBuffer()
+    {
+        // The control lane may only cut in between data packets, so first finish the one the transport stopped in.
+        if (m_isSendBufferMidPacket)
+        {
+            if (!writeSendBuffer(m_sendBufferPacketEnds.front()))
+            {
+                return false;
+            }
+            if (m_isSendBufferMidPacket)
+            {
+                return true;
+            }
+        }
+
+        if (!writeControlBuffer())
+        {
+            return false;
+        }
+        if (m_controlBufferReadOffset != m_controlBuffer.size())
+        {
+            return true;
+        }
+
+        return writeSendBuffer(m_sendBuffer.size());
+    }
+
+    bool SecureSocket::writeSendBuffer(const size_t end)
+    {
+        while (true)
+        {
+            if (!m_sendStreams.empty() && m_sendStreams.front().offset == m_sendBufferReadOffset && m_sendBufferReadOffset <= end)
+            {
+                bool isFinished = false;
+                if (!writeStream(isFinished))
+                {
+                    return false;
+                }
+                if (!isFinished)
+                {
+                    break;
+                }
+                m_sendStreams.pop_front();
+                advanceSendBuffer(0);
+                continue;
+            }
+
+            const size_t stop = m_sendStreams.empty() ? end : std::min(end, m_sendStreams.front().offset);
+            if (m_sendBufferReadOffset >= stop)
+            {
+                break;
+            }
+
+            size_t bytesWritten = 0;
+            const SendBuffer pending{ m_sendBuffer.data() + m_sendBufferReadOffset, stop - m_sendBufferReadOffset };
+            if (!writeToSocket(std::span{ &pending, 1 }, bytesWritten))
+            {
+                return false;
+            }
+            advanceSendBuffer(bytesWritten);
+            if (bytesWritten < pending.size)
+            {
+                break;
+            }
+        }
+
+        compactSendBuffer();
+        return true;
+    }
+
+    void SecureSocket::advanceSendBuffer(const size_t bytesWritten)
+    {
+        m_sendBufferReadOffset += bytesWritten;
+
+        // A streamed packet ends where its payload goes in, so reaching that offset is not a boundary until the payload is out.
+        const bool isAtStream = !m_sendStreams.empty() && m_sendStreams.front().offset == m_sendBufferReadOffset;
+        bool isAtPacketBoundary = false;
+        while (!m_sendBufferPacketEnds.empty() && m_sendBufferPacketEnds.front() <= m_sendBufferReadOffset)
+        {
+            if (isAtStream && m_sendBufferPacketEnds.front() == m_sendBufferReadOffset)
+            {
+                break;
+            }
+            isAtPacketBoundary = m_sendBufferPacketEnds.front() == m_sendBufferReadOffset;
+            m_sendBufferPacketEnds.pop_front();
+        }
+        if (bytesWritten > 0 || isAtPacketBoundary)
+        {
+            m_isSendBufferMidPacket = isAtStream || !isAtPacketBoundary;
+        }
+    }
+
+    void SecureSocket::compactSendBuffer()
+    {
+        constexpr size_t compactMinBytes = 256 * 1024;
+        const bool isDrained = m_sendBufferReadOffset == m_sendBuffer.size();
+        if (m_sendBufferReadOffset == 0
+            || (!isDrained && (m_sendBufferReadOffset < compactMinBytes || m_sendBufferReadOffset < m_sendBuffer.size() / 2)))
+        {
+            return;
+        }
+
+        m_sendBuffer.erase(m_sendBuffer.begin(), m_sendBuffer.begin() + static_cast<std::ptrdiff_t>(m_sendBufferReadOffset));
+        for (size_t& packetEnd : m_sendBufferPacketEnds)
+        {
+            packetEnd -= m_sendBufferReadOffset;
+        }
+        for (PendingStream& stream : m_sendStreams)
+        {
+            stream.offset -= m_sendBufferReadOffset;
+        }
+        m_sendBufferReadOffset = 0;
+    }
+
+    bool SecureSocket::writeStream(bool& outIsFinished)
+    {
+        PendingStream& stream = m_sendStreams.front();
+        outIsFinished = false;
+        while (true)
+        {
+            if (m_streamChunkOffset == m_streamChunk.size())
+            {
+                if (stream.remaining == 0)
+                {
+                    m_streamChunk.clear();
+                    m_streamChunkOffset = 0;
+                    outIsFinished = true;
+                    return true;
+                }
+
+                const size_t chunkSize = std::min(stream.remaining, kStreamChunkSize);
+                m_streamChunk.resize(chunkSize);
+                if (stream.source->read(std::span{ m_streamChunk.data(), chunkSize }) != chunkSize)
+                {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Error,
+                        "SecureSocket::writeStream(): payload source fell short (size=%zu, remaining=%zu)",
+                        stream.source->getSize(),
+                        stream.remaining);
+                    return false;
+                }
+                stream.remaining -= chunkSize;
+
+                if (m_webSocket)
+                {
+                    const SendBuffer payload{ m_streamChunk.data(), chunkSize };
+                    const SendBuffer frame = m_webSocket->encodeBinaryFrame(std::span{ &payload, 1 });
+                    m_streamChunk.assign(frame.data, frame.data + frame.size);
+                }
+                m_streamChunkOffset = 0;
+            }
+
+            size_t bytesWritten = 0;
+            const SendBuffer pending{ m_streamChunk.data() + m_streamChunkOffset, m_streamChunk.size() - m_streamChunkOffset };
+            if (!writeToSocket(std::span{ &pending, 1 }, bytesWritten))
+            {
+                return false;
+            }
+            m_streamChunkOffset += bytesWritten;
+            if (m_streamChunkOffset != m_streamChunk.size())
+            {
+                return true;
+            }
+        }
+    }
+
+    bool SecureSocket::writeControlBuffer()
+    {
+        if (m_controlBufferReadOffset == m_controlBuffer.size())
+        {
+            return true;
+        }
+
+        size_t bytesWritten = 0;
+        const SendBuffer pending{ m_controlBuffer.data() + m_controlBufferReadOffset, m_controlBuffer.size() - m_controlBufferReadOffset };
+        if (!writeToSocket(std::span{ &pending, 1 }, bytesWritten))
+        {
+            return false;
+        }
+
+        m_controlBufferReadOffset += bytesWritten;
+        if (m_controlBufferReadOffset == m_controlBuffer.size())
+        {
+            m_controlBuffer.clear();
+            m_controlBufferReadOffset = 0;
+        }
+
+        return true;
     }
 
     void SecureSocket::tick()
     {
         bool shouldDisconnect = false;
         bool shouldInvokeConnect = false;
-        const mqtt::ConnectionSettingsPtr settings = getSettings();
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
 
         {
             std::scoped_lock lock(m_resourceMutex);
+            if (settings && isConnectPending() && std::chrono::steady_clock::now() >= m_connectDeadline)
+            {
+                failPendingConnect(*settings, "timed out");
+                return;
+            }
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+            if (nullptr == m_socketPtr && m_hostLookup && settings)
+            {
+                if (m_hostLookup->getStatus() == HostLookup::Status::Pending)
+                {
+                    return;
+                }
+                openTransport(*settings);
+            }
+            else if (nullptr == m_socketPtr && m_connectionRace && settings)
+            {
+                pollConnectionRace(*settings);
+            }
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
             if (nullptr == m_socketPtr)
             {
                 REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::tick() called with null socket");
                 return;
             }
 
-            if (!m_connectCallbackInvoked.load(std::memory_order_acquire) && m_socketPtr->isConnected())
+            const bool isUpgrading = m_webSocket && m_webSocket->getState() == WebSocketCodec::State::Upgrading;
+            if (!m_connectCallbackInvoked.load(std::memory_order_acquire) && !isUpgrading && m_socketPtr->isConnected())
             {
                 REACTORMQ_LOG(
                     logging::LogLevel::Info,
                     "SecureSocket::tick() detected connection established (host=%s, clientId=%s)",
                     settings ? settings->getHost().c_str() : "<null>",
                     settings ? settings->getClientId().c_str() : "<null>");
+                if (m_webSocket && settings)
+                {
+                    startWebSocketUpgrade(*settings);
+                }
+                else
+                {
+                    m_connectCallbackInvoked.store(true, std::memory_order_release);
+                    shouldInvokeConnect = true;
+                }
+            }
+            else if (settings && !m_connectCallbackInvoked.load(std::memory_order_acquire) && m_socketPtr->hasConnectFailed())
+            {
+                failPendingConnect(*settings, "refused or unreachable");
+                return;
+            }
+
+            if (settings && m_webSocket && m_webSocket->getState() == WebSocketCodec::State::Upgrading && m_socketPtr->isConnected())
+            {
+                const WebSocketCodec::UpgradeStatus status
+                    = flushSendBuffer() ? readUpgradeResponse() : WebSocketCodec::UpgradeStatus::Rejected;
+                if (status == WebSocketCodec::UpgradeStatus::Rejected)
+                {
+                    failPendingConnect(*settings, "WebSocket upgrade failed");
+                    return;
+                }
+                if (status == WebSocketCodec::UpgradeStatus::Pending)
+                {
+                    return;
+                }
+
+                REACTORMQ_LOG(
+                    logging::LogLevel::Info,
+                    "SecureSocket::tick() WebSocket upgrade accepted (host=%s, clientId=%s)",
+                    settings->getHost().c_str(),
+                    settings->getClientId().c_str());
                 m_connectCallbackInvoked.store(true, std::memory_order_release);
                 shouldInvokeConnect = true;
             }
-
-            if (m_socketPtr && m_socketPtr->isConnected())
+            else if (m_socketPtr && m_socketPtr->isConnected())
             {
-                shouldDisconnect = !readAvailableData();
+                shouldDisconnect = !flushSendBuffer() || !readAvailableData();
             }
         }
 
@@ -281,49 +1149,95 @@ namespace reactormq::socket
 
     bool SecureSocket::readAvailableData()
     {
+        REACTORMQ_TRACE_SCOPE("SecureSocket::readAvailableData");
+        REACTORMQ_MEMORY_SCOPE(ReactorMQ_Socket);
         if (nullptr == m_socketPtr)
         {
             REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::readAvailableData() called with null socket");
             return false;
         }
 
-        const int pendingData = m_socketPtr->getPendingData();
-
-        int chunkSize = pendingData > 0 ? std::min(pendingData, kMaxChunkSize) : kMaxChunkSize;
+        // Leave new bytes with the kernel while paused, so the receive window closes on the broker.
+        if (isReceivePaused())
+        {
+            return true;
+        }
 
-        std::vector<uint8_t> tempBuffer(chunkSize);
-        size_t bytesRead = 0;
+        // Frames held back by the inbound budget go first; reading more now would only grow the backlog.
+        if (hasInboundBacklog())
+        {
+            return commitReceiveBuffer(0);
+        }
 
-        if (!m_socketPtr->tryReceive(tempBuffer.data(), chunkSize, bytesRead))
+        // Read optimistically instead of asking FIONREAD first: a short read shows the kernel buffer was drained, and
+        // anything left after the last read keeps the handle readable for the next tick.
+        for (int reads = 0; reads < kMaxReadsPerTick; ++reads)
         {
-            if (const SocketError err = PlatformSocket::getLastError(); err == SocketError::WouldBlock)
+            // A data callback may have disconnected, paused receiving, or left frames over the inbound budget.
+            if (nullptr == m_socketPtr || isReceivePaused() || hasInboundBacklog())
             {
                 return true;
             }
 
-            if (const int32_t errorCode = PlatformSocket::getLastErrorCode(); errorCode != 0)
+            const size_t chunkSize = std::min(static_cast<size_t>(kMaxChunkSize), std::max<size_t>(getReceiveBufferRoom(), 1));
+            const std::span<uint8_t> target = prepareReceiveBuffer(chunkSize);
+            if (target.empty())
             {
-                REACTORMQ_LOG(
-                    logging::LogLevel::Error,
-                    "SecureSocket::readAvailableData() tryReceive failed (chunkSize=%u, error=%d: %s)",
-                    chunkSize,
-                    errorCode,
-                    PlatformSocket::getNetworkErrorDescription(errorCode));
+                return false;
             }
-            else
+
+            size_t bytesRead = 0;
+
+            const auto receiveSize = static_cast<int>(std::min(target.size(), chunkSize));
+            if (!m_socketPtr->tryReceive(target.data(), receiveSize, bytesRead))
             {
-                REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::readAvailableData() detected socket closure (EOF)");
+                if (const SocketError err = PlatformSocket::getLastError(); err == SocketError::WouldBlock)
+                {
+                    return true;
+                }
+
+                if (const int32_t errorCode = PlatformSocket::getLastErrorCode(); errorCode != 0)
+                {
+                    REACTORMQ_LOG(
+                        logging::LogLevel::Error,
+                        "SecureSocket::readAvailableData() tryReceive failed (chunkSize=%zu, error=%d: %s)",
+                        chunkSize,
+                        errorCode,
+                        PlatformSocket::getNetworkErrorDescription(errorCode));
+                }
+                else
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Debug, "SecureSocket::readAvailableData() detected socket closure (EOF)");
+                }
+
+                return false;
             }
 
-            return false;
-        }
+            if (bytesRead == 0)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::readAvailableData() bytesRead=0");
+                return true;
+            }
 
-        if (bytesRead == 0)
-        {
-            REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::readAvailableData() bytesRead=0");
-            return true;
+            // WebSocket frames are stripped in place, leaving only their payload in the receive buffer.
+            size_t payloadSize = bytesRead;
+            if (m_webSocket && !decodeWebSocketFrames(target.first(bytesRead), payloadSize))
+            {
+                return false;
+            }
+
+            if (m_webSocket ? !commitWebSocketPayload(payloadSize) : !commitReceiveBuffer(payloadSize))
+            {
+                return false;
+            }
+
+            // TLS reads stop at a record boundary, so only its own buffer (SSL_pending) says whether more is waiting.
+            if (bytesRead < static_cast<size_t>(receiveSize) && (nullptr == m_socketPtr || !m_socketPtr->hasBufferedInput()))
+            {
+                return true;
+            }
         }
 
-        return processPacketData(tempBuffer.data(), bytesRead);
+        return true;
     }
 } // namespace reactormq::socket
\ No newline at end of file
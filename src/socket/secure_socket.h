@@ -5,18 +5,25 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "socket/connection_race.h"
+#include "socket/host_resolver.h"
 #include "socket/platform/platform_socket.h"
 #include "socket/socket.h"
+#include "socket/websocket_codec.h"
 #include "util/logging/logging.h"
 
 namespace reactormq::socket
 {
     /**
-     * @brief Socket that selects TCP or TLS based on connection settings.
-     * Delegates work to PlatformSocket (TCP) or PlatformSecureSocket (TLS).
+     * @brief Socket that selects TCP, TLS or a Unix domain socket based on connection settings.
+     * Delegates work to PlatformSocket (TCP and Unix) or PlatformSecureSocket (TLS). For Ws and Wss it runs the WebSocket
+     * upgrade over that transport before reporting the connection, and frames the MQTT stream with WebSocketCodec.
      */
     class SecureSocket final
         : public Socket
@@ -47,9 +54,86 @@ namespace reactormq::socket
             return m_onDataReceived;
         }
 
+        [[nodiscard]] size_t getPendingSendBytes() const override;
+
+        void waitForActivity(WakeupHandle& wakeup, std::chrono::milliseconds timeout) override;
+
+        [[nodiscard]] PollRegistration getPollRegistration() const override;
+
     private:
         void connect() override;
 
+        /**
+         * @brief Start connecting once the broker's addresses are known: race them where a lookup ran, otherwise
+         * connect the transport to the host directly.
+         * Reports a failed host lookup or connect through the connect callback. Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         */
+        void openTransport(const mqtt::ConnectionSettings& settings);
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+        /**
+         * @brief Advance the connection race and, once an attempt wins, hand its socket to a new transport.
+         * Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         */
+        void pollConnectionRace(const mqtt::ConnectionSettings& settings);
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+        /// @brief Create the TLS or plain transport the settings ask for.
+        [[nodiscard]] std::unique_ptr<PlatformSocket> createTransport(const mqtt::ConnectionSettings& settings) const;
+
+        /**
+         * @brief Report the outcome of starting the transport through the connect callback.
+         * @param settings Settings of the connection being opened.
+         * @param result Return value of PlatformSocket::connect() or PlatformSocket::adoptConnection().
+         * @param address Address the transport was connected to, for the log.
+         */
+        void finishConnect(const mqtt::ConnectionSettings& settings, int result, const std::string& address);
+
+        /// @brief Whether connect() was called and has neither succeeded nor been reported as failed yet.
+        [[nodiscard]] bool isConnectPending() const;
+
+        /**
+         * @brief Give up on the connect in progress and report it through the connect callback.
+         * Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         * @param reason Why the connect was given up, for the log.
+         */
+        void failPendingConnect(const mqtt::ConnectionSettings& settings, const char* reason);
+
+        /**
+         * @brief Queue the WebSocket upgrade request once the transport is connected.
+         * Called with the resource mutex held.
+         * @param settings Settings of the connection being opened.
+         */
+        void startWebSocketUpgrade(const mqtt::ConnectionSettings& settings);
+
+        /**
+         * @brief Read the server's answer to the upgrade request; bytes after it are decoded as frames.
+         * Called with the resource mutex held.
+         * @return Accepted once the upgrade succeeded, Rejected if it failed or the transport did, Pending otherwise.
+         */
+        WebSocketCodec::UpgradeStatus readUpgradeResponse();
+
+        /**
+         * @brief Strip WebSocket framing from bytes just read into the receive buffer and queue any control replies.
+         * @param data Bytes just read; compacted in place to the MQTT bytes they carry.
+         * @param outPayloadSize Receives the number of MQTT bytes left at the front of data.
+         * @return False on a protocol error or once the server closed the WebSocket.
+         */
+        bool decodeWebSocketFrames(std::span<uint8_t> data, size_t& outPayloadSize);
+
+        /**
+         * @brief Commit the MQTT bytes decodeWebSocketFrames() left in place, then append the ones it inflated.
+         * @param payloadSize Number of MQTT bytes at the front of the receive buffer's writable span.
+         * @return False if the receive buffer overflowed or a packet was invalid.
+         */
+        bool commitWebSocketPayload(size_t payloadSize);
+
+        /// @brief Whether the poller should wake on writability: a TCP connect in flight or bytes or a stream waiting to go out.
+        [[nodiscard]] bool wantsWritable() const;
+
         void disconnect() override;
 
         void close(int32_t code, const std::string& reason) override;
@@ -58,14 +142,121 @@ namespace reactormq::socket
 
         void send(const uint8_t* data, uint32_t size) override;
 
+        void sendVectored(std::span<const SendBuffer> buffers, size_t packetCount = 1) override;
+
+        bool sendStream(std::span<const std::byte> header, const mqtt::PayloadSourcePtr& source) override;
+
+        void sendControl(std::span<const std::byte> data, size_t packetCount = 1) override;
+
+        void beginCoalescing() override;
+
+        void flushCoalesced() override;
+
         void tick() override;
 
         bool readAvailableData();
 
+        /**
+         * @brief Write as much of the given buffers as the transport accepts without blocking.
+         * @param buffers Regions to write, in order.
+         * @param outBytesWritten Receives the number of bytes accepted by the transport.
+         * @return False on a hard socket error; WouldBlock is not an error.
+         */
+        bool writeToSocket(std::span<const SendBuffer> buffers, size_t& outBytesWritten);
+
+        /**
+         * @brief Append the part of the buffers the transport did not take to the send buffer.
+         * @param buffers Regions passed to writeToSocket().
+         * @param bytesWritten Number of leading bytes already written.
+         */
+        void queueUnsent(std::span<const SendBuffer> buffers, size_t bytesWritten);
+
+        /**
+         * @brief Whether an outgoing write of the given size may be gathered rather than written now.
+         * @param pendingBytes Bytes already waiting in the send buffer.
+         * @param incomingBytes Bytes about to be sent.
+         * @param settings Connection settings holding the coalescing caps.
+         * @return True while coalescing and both the size and delay caps leave room.
+         */
+        [[nodiscard]] bool canCoalesce(size_t pendingBytes, size_t incomingBytes, const mqtt::ConnectionSettings& settings) const;
+
+        /**
+         * @brief Drain queued outbound bytes into the transport: the rest of a partly written data packet, then the
+         * control lane, then the remaining data packets.
+         * @return False on a hard socket error.
+         */
+        bool flushSendBuffer();
+
+        /**
+         * @brief Write queued data bytes up to the given offset into the send buffer.
+         * @param end Offset one past the last byte to write.
+         * @return False on a hard socket error.
+         */
+        bool writeSendBuffer(size_t end);
+
+        /**
+         * @brief Account for bytes of the send buffer the transport took, noting whether they end on a packet boundary.
+         * A streamed packet's boundary is only reached once its payload has been written too.
+         * @param bytesWritten Number of bytes written from the read offset.
+         */
+        void advanceSendBuffer(size_t bytesWritten);
+
+        /// @brief Drop written bytes from the front of the send buffer once they are all or most of it.
+        void compactSendBuffer();
+
+        /**
+         * @brief Write the payload of the front stream, reading chunks from its source as the transport takes them.
+         * @param outIsFinished Set once the whole payload has been written.
+         * @return False on a hard socket error or if the source fell short.
+         */
+        bool writeStream(bool& outIsFinished);
+
+        /**
+         * @brief Write queued control packets.
+         * @return False on a hard socket error.
+         */
+        bool writeControlBuffer();
+
         static constexpr int kMaxChunkSize = 64 * 1024;
 
+        /// Payload bytes read from a stream's source at a time.
+        static constexpr size_t kStreamChunkSize = 64 * 1024;
+
+        /// @brief A data packet whose payload is read from its source once the send buffer is written up to offset.
+        struct PendingStream
+        {
+            size_t offset = 0; ///< Send buffer offset the payload goes at, after the packet's header; the packet ends there.
+            mqtt::PayloadSourcePtr source;
+            size_t remaining = 0; ///< Payload bytes not yet read from the source.
+        };
+
+        /// Reads per readAvailableData() call, so one busy connection cannot hold its reactor thread.
+        static constexpr int kMaxReadsPerTick = 4;
+
+        /// Longest blocking wait while the broker's host name is being resolved or its addresses raced.
+        static constexpr std::chrono::milliseconds kConnectPollInterval{ 5 };
+
         std::unique_ptr<PlatformSocket> m_socketPtr;
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+        HostLookupPtr m_hostLookup; ///< Lookup of the broker's address while connect() waits for it; null otherwise.
+        std::unique_ptr<ConnectionRace> m_connectionRace; ///< TCP attempts to the resolved addresses; null otherwise.
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
+        std::unique_ptr<WebSocketCodec> m_webSocket; ///< Upgrade and framing for Ws and Wss; null for Tcp and Tls.
         std::atomic<bool> m_connectCallbackInvoked{ false };
+        /// When a connect still in progress is given up, from ConnectionSettings::getSocketConnectionTimeoutSeconds().
+        std::chrono::steady_clock::time_point m_connectDeadline = std::chrono::steady_clock::time_point::max();
+
+        std::vector<uint8_t> m_sendBuffer; ///< Bytes accepted by send() but not yet written to the transport.
+        size_t m_sendBufferReadOffset = 0; ///< Offset into the send buffer for already-written bytes.
+        std::deque<size_t> m_sendBufferPacketEnds; ///< Offset one past each data packet still in the send buffer.
+        bool m_isSendBufferMidPacket = false; ///< Set while the transport has taken part of the next queued data packet.
+        std::deque<PendingStream> m_sendStreams; ///< Streamed packets in the send buffer, in offset order.
+        std::vector<uint8_t> m_streamChunk; ///< Chunk of the front stream (framed for WebSocket) not yet fully written.
+        size_t m_streamChunkOffset = 0; ///< Offset into the stream chunk for already-written bytes.
+        std::vector<uint8_t> m_controlBuffer; ///< Control packets waiting to be written ahead of queued data packets.
+        size_t m_controlBufferReadOffset = 0; ///< Offset into the control buffer for already-written bytes.
+        bool m_isCoalescing = false; ///< Set between beginCoalescing() and flushCoalesced().
+        std::chrono::steady_clock::time_point m_coalesceStartTime; ///< When the oldest gathered byte was queued.
 
         mutable std::recursive_mutex m_resourceMutex;
 
@@ -0,0 +1,24 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief One contiguous region of a vectored send.
+     * Points into storage owned by the caller; it must stay valid for the duration of the send call only.
+     */
+    struct SendBuffer
+    {
+        const std::uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    /// @brief Maximum number of regions handed to the transport in a single vectored write.
+    inline constexpr size_t kMaxSendBuffers = 8;
+} // namespace reactormq::socket
@@ -8,13 +8,17 @@
 #include "secure_socket.h"
 #include "util/logging/logging.h"
 
+#if REACTORMQ_WITH_QUIC
+#include "socket/quic_socket.h"
+#endif // REACTORMQ_WITH_QUIC
+
 using SelectedSocket = reactormq::socket::SecureSocket;
 
 #if REACTORMQ_SOCKET_WITH_WEBSOCKET_UE5
 #include "socket/ue5_websocket.h"
 using SelectedWebSocket = reactormq::socket::Ue5WebSocket;
 #else // REACTORMQ_SOCKET_WITH_WEBSOCKET_UE5
-// TODO: replace with real native websocket if we add Libwebsockets or similar
+// SecureSocket runs the WebSocket upgrade and framing itself (see WebSocketCodec).
 using SelectedWebSocket = reactormq::socket::SecureSocket;
 #endif // REACTORMQ_SOCKET_WITH_WEBSOCKET_UE5
 
@@ -35,12 +39,21 @@ namespace reactormq::socket
             using enum mqtt::ConnectionProtocol;
         case Tcp:
         case Tls:
+        case Unix:
             return std::make_shared<SelectedSocket>(settings);
 
         case Ws:
         case Wss:
             return std::make_shared<SelectedWebSocket>(settings);
 
+        case Quic:
+#if REACTORMQ_WITH_QUIC
+            return std::make_shared<QuicSocket>(settings);
+#else // REACTORMQ_WITH_QUIC
+            REACTORMQ_LOG(logging::LogLevel::Error, "QUIC requested, but this build has no QUIC support (REACTORMQ_WITH_QUIC)");
+            return nullptr;
+#endif // REACTORMQ_WITH_QUIC
+
         default:
             REACTORMQ_LOG(logging::LogLevel::Error, "Unknown protocol");
             return nullptr;
@@ -51,46 +64,61 @@ namespace reactormq::socket
     {
         if (size == 0)
         {
-            REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::appendAndProcess() called with size=0");
+            REACTORMQ_LOG(logging::LogLevel::Trace, "Socket::processPacketData() called with size=0");
             return true;
         }
-        const mqtt::ConnectionSettingsPtr settings = getSettings();
 
-        bool shouldDisconnect = false;
-        size_t curSize = 0;
-        uint32_t capBytes = 0;
+        REACTORMQ_LOG(logging::LogLevel::Trace, "Socket::processPacketData() appending size=%zu", size);
 
+        if (prepareReceiveBuffer(size).empty())
         {
-            REACTORMQ_LOG(logging::LogLevel::Trace, "SecureSocket::appendAndProcess() appending size=%zd", size);
+            return false;
+        }
 
-            m_dataBuffer.insert(m_dataBuffer.end(), data, data + size);
-            curSize = m_dataBuffer.size();
+        m_dataBuffer.write(data, size);
+        return commitReceiveBuffer(0);
+    }
 
-            constexpr uint32_t defaultCap = 4 * 1024 * 1024;
-            capBytes = settings ? settings->getMaxBufferSize() : defaultCap;
+    namespace
+    {
+        constexpr uint32_t kDefaultReceiveBufferCap = 4 * 1024 * 1024;
+    } // namespace
 
-            if (curSize > static_cast<size_t>(capBytes))
-            {
-                shouldDisconnect = true;
-            }
-        }
+    std::span<uint8_t> Socket::prepareReceiveBuffer(const size_t minBytes)
+    {
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        const uint32_t capBytes = settings ? settings->getMaxBufferSize() : kDefaultReceiveBufferCap;
 
-        if (shouldDisconnect)
+        if (const size_t requiredBytes = m_dataBuffer.getSize() + minBytes; requiredBytes > static_cast<size_t>(capBytes))
         {
-            const auto curSizeAsSizeT = curSize;
             REACTORMQ_LOG(
                 logging::LogLevel::Error,
-                "SecureSocket::appendAndProcess() inbound buffer exceeded cap; disconnecting (size=%zu, cap=%u)",
-                curSizeAsSizeT,
+                "Socket::prepareReceiveBuffer() inbound buffer exceeded cap; disconnecting (size=%zu, cap=%u)",
+                requiredBytes,
                 capBytes);
-            return false;
+            return {};
         }
 
+        m_dataBuffer.reserve(minBytes);
+        return m_dataBuffer.getWritableSpan();
+    }
+
+    size_t Socket::getReceiveBufferRoom() const
+    {
+        const mqtt::ConnectionSettingsPtr& settings = getSettings();
+        const size_t capBytes = settings ? settings->getMaxBufferSize() : kDefaultReceiveBufferCap;
+        return capBytes > m_dataBuffer.getSize() ? capBytes - m_dataBuffer.getSize() : 0;
+    }
+
+    bool Socket::commitReceiveBuffer(const size_t size)
+    {
+        m_dataBuffer.commitWrite(size);
+
         if (!readPacketsFromBuffer())
         {
             REACTORMQ_LOG(
                 logging::LogLevel::Error,
-                "SecureSocket::appendAndProcess() readPacketsFromBuffer() reported oversized/invalid packet; disconnecting");
+                "Socket::commitReceiveBuffer() readPacketsFromBuffer() reported oversized/invalid packet; disconnecting");
             return false;
         }
 
@@ -6,7 +6,19 @@
 
 #include "reactormq/mqtt/connection_settings.h"
 #include "reactormq/mqtt/delegates.h"
-
+#include "reactormq/mqtt/payload_source.h"
+#include "serialize/mqtt_codec.h"
+#include "serialize/ring_buffer.h"
+#include "socket/inbound_frame.h"
+#include "socket/platform/poller.h"
+#include "socket/platform/wakeup_handle.h"
+#include "socket/send_buffer.h"
+#include "socket/traffic_counters.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <span>
 #include <string>
@@ -31,11 +43,18 @@ namespace reactormq::socket
     using OnDisconnectCallback = mqtt::MulticastDelegate<void()>;
 
     /**
-     * @brief Event fired when raw bytes arrive from the peer.
-     * @param data Pointer to the received buffer.
-     * @param size Number of bytes in the buffer.
+     * @brief Event fired for each complete MQTT control packet received from the peer.
+     * @param frame The packet, with the fixed header the framing already decoded.
+     */
+    using OnDataReceivedCallback = mqtt::MulticastDelegate<void(const InboundFrame& frame)>;
+
+    /**
+     * @brief Event fired with the packets the framing cut from a read, up to a batch at a time and in order.
+     * @param frames The packets; never empty, and their bytes stay valid until the callback returns.
+     * @param handled Starts at frames.size(). A listener that pauses receiving part way through sets it to the number
+     * of packets it took, at least one; the rest stay buffered and come again once receiving resumes.
      */
-    using OnDataReceivedCallback = mqtt::MulticastDelegate<void(const uint8_t* data, uint32_t size)>;
+    using OnDataReceivedBatchCallback = mqtt::MulticastDelegate<void(std::span<const InboundFrame> frames, size_t& handled)>;
 
     [[nodiscard]] SocketPtr CreateSocket(const mqtt::ConnectionSettingsPtr& settings);
 
@@ -53,8 +72,13 @@ namespace reactormq::socket
          *
          */
         explicit Socket(mqtt::ConnectionSettingsPtr settings)
-            : m_settings(std::move(settings))
+            : m_dataBuffer(nullptr != settings ? settings->getBufferMemory() : mqtt::BufferMemoryOptions{})
+            , m_settings(std::move(settings))
         {
+            if (nullptr != m_settings && m_settings->getFixedCapacity().isEnabled)
+            {
+                m_dataBuffer.reserve(m_settings->getMaxBufferSize());
+            }
         }
 
         virtual ~Socket() = default;
@@ -126,6 +150,191 @@ namespace reactormq::socket
             send(reinterpret_cast<const uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
         }
 
+        /**
+         * @brief Send several buffers back to back as one logical write, without joining them first.
+         * The default implementation forwards each buffer to send(); transports with a gathered write override it.
+         * @param buffers Regions to transmit, in order; only borrowed for the duration of the call.
+         * @param packetCount Number of complete MQTT packets the regions hold, for the traffic counters.
+         */
+        virtual void sendVectored(const std::span<const SendBuffer> buffers, [[maybe_unused]] const size_t packetCount = 1)
+        {
+            for (const SendBuffer& buffer : buffers)
+            {
+                if (buffer.size > 0)
+                {
+                    send(buffer.data, static_cast<uint32_t>(buffer.size));
+                }
+            }
+        }
+
+        /**
+         * @brief Send one data packet whose payload is pulled from a source as the transport takes it.
+         * Data sent afterwards queues behind the whole packet, and control packets wait for its last byte.
+         * The default implementation reads the whole payload and forwards it to sendVectored().
+         * @param header Encoded packet up to its payload; only borrowed for the duration of the call.
+         * @param source Payload; read on the reactor thread until getSize() bytes have been sent.
+         * @return False if the source did not deliver its whole payload.
+         */
+        virtual bool sendStream(const std::span<const std::byte> header, const mqtt::PayloadSourcePtr& source)
+        {
+            std::vector<uint8_t> payload(source->getSize());
+            if (source->read(payload) != payload.size())
+            {
+                return false;
+            }
+
+            const std::array buffers{
+                SendBuffer{ reinterpret_cast<const uint8_t*>(header.data()), header.size() },
+                SendBuffer{ payload.data(), payload.size() },
+            };
+            sendVectored(buffers);
+            return true;
+        }
+
+        /**
+         * @brief Send a control packet (an acknowledgement, PINGREQ or DISCONNECT) ahead of queued data packets.
+         * Queued data is only overtaken at a packet boundary, so a keepalive is not held behind a large PUBLISH backlog.
+         * The default implementation writes synchronously and forwards to send().
+         * @param data One or more complete encoded packets.
+         * @param packetCount Number of packets in data, for the traffic counters.
+         */
+        virtual void sendControl(const std::span<const std::byte> data, [[maybe_unused]] const size_t packetCount = 1)
+        {
+            send(data);
+        }
+
+        /**
+         * @brief Number of bytes accepted by send() that have not yet been written to the transport.
+         * @return Pending outbound bytes; 0 for implementations that write synchronously.
+         */
+        [[nodiscard]] virtual size_t getPendingSendBytes() const
+        {
+            return 0;
+        }
+
+        /**
+         * @brief Start gathering outbound bytes instead of writing each send() to the transport.
+         * Gathered bytes are written by flushCoalesced(), or earlier once the configured size or delay cap is hit.
+         * The default implementation writes synchronously and ignores this.
+         */
+        virtual void beginCoalescing()
+        {
+        }
+
+        /**
+         * @brief Stop gathering and write everything gathered since beginCoalescing().
+         */
+        virtual void flushCoalesced()
+        {
+        }
+
+        /**
+         * @brief Report whether new data would be written straight to the transport rather than queued.
+         * @return True if connected and no outbound bytes are waiting.
+         */
+        [[nodiscard]] virtual bool isWritable() const
+        {
+            return isConnected() && getPendingSendBytes() == 0;
+        }
+
+        /**
+         * @brief Block until the transport has I/O to service, the wakeup is signalled, or the timeout elapses.
+         * Used by the reactor's blocking run mode; the default implementation only waits on the wakeup.
+         * @param wakeup Cross-thread wakeup that ends the wait early.
+         * @param timeout Maximum time to block.
+         */
+        virtual void waitForActivity(WakeupHandle& wakeup, const std::chrono::milliseconds timeout)
+        {
+            wakeup.waitFor(timeout);
+        }
+
+        /**
+         * @brief Describe the handle and readiness this socket is waiting for, so one poller can watch many sockets.
+         * The default reports an invalid handle, which tells callers to fall back to periodic ticking.
+         * @return Current poll registration.
+         */
+        [[nodiscard]] virtual PollRegistration getPollRegistration() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Whether complete frames were left buffered because the last dispatch ran out of its inbound budget.
+         * Transports should dispatch the backlog before reading more, so flow control pushes back on the broker.
+         */
+        [[nodiscard]] bool hasInboundBacklog() const
+        {
+            return m_hasInboundBacklog;
+        }
+
+        /**
+         * @brief Stop or resume dispatching and reading inbound data, as when the application cannot keep up.
+         * While paused, buffered frames stay in the backlog and transports leave new bytes unread, so TCP flow control
+         * pushes back on the broker. Reactor thread only.
+         * @param isPaused True to pause, false to resume.
+         */
+        void setReceivePaused(const bool isPaused)
+        {
+            m_isReceivePaused = isPaused;
+        }
+
+        /// @brief Whether inbound data is paused by setReceivePaused().
+        [[nodiscard]] bool isReceivePaused() const
+        {
+            return m_isReceivePaused;
+        }
+
+        /**
+         * @brief Stop or resume applying ConnectionSettings::getMaxInboundPacketsPerTick() to dispatch, for a listener
+         * that spends the budget on its own deliveries instead; the time budget still applies. Reactor thread only.
+         * @param isLimited False to dispatch every complete frame each tick.
+         */
+        void setInboundPacketLimited(const bool isLimited)
+        {
+            m_isInboundPacketLimited = isLimited;
+        }
+
+        /**
+         * @brief Bytes buffered behind the inbound budget, waiting for a later tick.
+         * @return Backlog size in bytes; 0 when the last dispatch drained every complete frame. Safe from any thread.
+         */
+        [[nodiscard]] size_t getInboundBacklogBytes() const
+        {
+            return m_inboundBacklogBytes.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Keep bytes of a frame being delivered alive after the callback returns, without copying them.
+         * Reactor thread only, from within the data callback.
+         * @param bytes Bytes of the frame, e.g. a PUBLISH payload.
+         * @return Owner of bytes.data(); empty when the bytes are not in the inbound ring, such as a frame that wrapped
+         * around it or a WebSocket payload, or are too small to be worth pinning the ring's storage for.
+         */
+        [[nodiscard]] std::shared_ptr<const uint8_t> shareInbound(const std::span<const uint8_t> bytes) const
+        {
+            return m_dataBuffer.share(bytes);
+        }
+
+        /**
+         * @brief Count traffic into counters owned by the caller, as the client does for its metrics.
+         * Only the bytes of complete received frames and of accepted sends are counted. Reactor thread only.
+         * @param counters Counters to add to; nullptr stops counting.
+         */
+        void setTrafficCounters(std::shared_ptr<TrafficCounters> counters)
+        {
+            m_trafficCounters = std::move(counters);
+        }
+
+        /**
+         * @brief Show the packets crossing this socket to a tap, as the client does for ConnectionSettings::getPacketTap().
+         * Received packets are tapped as the framing dispatches them, and sends where they are counted. Reactor thread only.
+         * @param tap Tap to call; nullptr stops tapping.
+         */
+        void setPacketTap(mqtt::PacketTapPtr tap)
+        {
+            m_packetTap = std::move(tap);
+        }
+
         /// @brief Access the connection event.
         virtual OnConnectCallback& getOnConnectCallback() = 0;
 
@@ -135,6 +344,15 @@ namespace reactormq::socket
         /// @brief Access the data-received event.
         virtual OnDataReceivedCallback& getOnDataReceivedCallback() = 0;
 
+        /**
+         * @brief Access the batched data-received event, which the client listens to.
+         * While it has listeners, received packets go to them a batch at a time instead of to getOnDataReceivedCallback().
+         */
+        OnDataReceivedBatchCallback& getOnDataReceivedBatchCallback()
+        {
+            return m_onDataReceivedBatch;
+        }
+
     protected:
         /**
          * @brief processes the packet data received from the socket and dispatches to callbacks via
@@ -145,101 +363,144 @@ namespace reactormq::socket
          */
         bool processPacketData(const uint8_t* data, size_t size);
 
+        /**
+         * @brief Reserve writable space at the tail of the inbound ring so a transport can receive into it directly.
+         * The ring grows as needed; no bytes are zero-filled or copied on the fast path.
+         * @param minBytes Amount of free space to guarantee.
+         * @return Contiguous writable region, shorter than minBytes only when the free space wraps; empty if the
+         * configured buffer cap would be exceeded.
+         */
+        std::span<uint8_t> prepareReceiveBuffer(size_t minBytes);
+
+        /// @brief Bytes that may still be buffered before the configured inbound cap; the most a read should ask for.
+        [[nodiscard]] size_t getReceiveBufferRoom() const;
+
+        /**
+         * @brief Commit bytes written into the region returned by prepareReceiveBuffer and dispatch complete packets.
+         * @param size Number of bytes written.
+         * @return false on error
+         */
+        bool commitReceiveBuffer(size_t size);
+
         /**
          * @brief Parse buffered bytes into complete MQTT packets and emit data callbacks.
-         * @return True if parsing succeeded; false if a packet exceeds the configured maximum size.
+         * Frames are dispatched in place, in batches of up to kMaxFrameBatch: the bytes passed to listeners refer into
+         * the inbound ring (or a scratch copy for the one frame per call that may wrap) and are only valid for the
+         * duration of the callback. A batch is consumed once delivered, and only as far as the listeners took it.
+         * Dispatch stops once the settings' per-tick packet count or time budget is used up, or once receiving is
+         * paused, including by a listener part way through a batch; the remaining frames stay buffered as backlog. A
+         * PUBLISH over the inbound streaming threshold is passed on as fragments of whatever has arrived, one per
+         * batch, so it never has to fit the buffer; see InboundFrame.
+         * @return True if parsing succeeded; false if a packet exceeds the configured maximum size or its remaining length
+         * takes more than four bytes.
          *
          */
         bool readPacketsFromBuffer()
         {
-            std::vector<std::vector<uint8_t>> packetsToDispatch;
+            const uint32_t maxPacketSize = nullptr != m_settings ? m_settings->getMaxPacketSize() : 268435455u;
+            const uint32_t streamingThreshold = nullptr != m_settings ? m_settings->getInboundStreamingThreshold() : 0U;
+            const uint32_t maxPackets
+                = nullptr != m_settings && m_isInboundPacketLimited ? m_settings->getMaxInboundPacketsPerTick() : 0U;
+            const std::chrono::microseconds maxTime{ nullptr != m_settings ? m_settings->getMaxInboundProcessingTimeUs() : 0U };
+            const auto start = maxTime.count() > 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+            uint32_t dispatched = 0U;
+
+            const auto isOverBudget = [&]
             {
-                const uint32_t maxPacketSize = nullptr != m_settings ? m_settings->getMaxPacketSize() : 268435455u;
+                return m_isReceivePaused || (maxPackets != 0U && dispatched >= maxPackets)
+                    || (maxTime.count() > 0 && std::chrono::steady_clock::now() - start >= maxTime);
+            };
 
-                size_t available = m_dataBuffer.size() - m_dataBufferReadOffset;
+            bool keepParsing = true;
+            m_hasInboundBacklog = false;
 
-                bool keepParsing = true;
+            // Frames in the batch are not consumed yet, so parsing continues m_frameBatchBytes past the front.
+            while (m_dataBuffer.getSize() - m_frameBatchBytes > (m_streamedFrameRemaining > 0U ? 0U : 1U) && keepParsing == true)
+            {
+                const size_t available = m_dataBuffer.getSize() - m_frameBatchBytes;
 
-                while (available > 1U && keepParsing == true)
+                if (m_streamedFrameRemaining > 0U)
                 {
-                    const uint8_t* base = m_dataBuffer.data() + m_dataBufferReadOffset;
-                    uint32_t remainingLength = 0U;
-                    uint32_t multiplier = 1U;
-                    size_t index = 1U;
-                    bool haveRemainingLength = false;
-                    while (index < 5U && index < available && haveRemainingLength == false)
+                    if (isOverBudget())
                     {
-                        constexpr uint8_t remainingLengthValueMask = 0x7FU;
+                        keepParsing = false;
+                        m_hasInboundBacklog = true;
+                        continue;
+                    }
 
-                        const uint8_t encodedByte = base[index];
+                    // The next fragment of a streamed PUBLISH: whatever of it has arrived. The batch is empty here, as
+                    // it was delivered before the stream started and every fragment is delivered on its own.
+                    const size_t fragmentSize = std::min(available, m_streamedFrameRemaining);
+                    m_streamedFrame.bytes = m_dataBuffer.getContiguousView(fragmentSize, m_wrappedFrameScratch);
+                    queueFrame(m_streamedFrame);
+                    (void)flushFrames();
+                    m_streamedFrame.fragmentOffset += static_cast<uint32_t>(fragmentSize);
+                    m_streamedFrameRemaining -= fragmentSize;
+                    ++dispatched;
+                    continue;
+                }
 
-                        remainingLength += static_cast<uint32_t>(encodedByte & remainingLengthValueMask) * multiplier;
-                        multiplier *= 128U;
+                // The type byte and at most four length bytes; enough to size any frame.
+                std::array<uint8_t, 1U + serialize::mqtt::kMaxVariableByteSize> header{};
+                const size_t headerBytes = m_dataBuffer.peekInto(header.data(), header.size(), m_frameBatchBytes);
+                uint32_t remainingLength = 0U;
+                size_t lengthSize = 0U;
+                const serialize::VariableByteIntegerStatus lengthStatus =
+                    serialize::scanVariableByteInteger({ header.data() + 1U, headerBytes - 1U }, remainingLength, lengthSize);
 
-                        ++index;
+                if (lengthStatus == serialize::VariableByteIntegerStatus::Incomplete)
+                {
+                    keepParsing = false; // not enough bytes to finish remaining length field
+                }
+                else if (lengthStatus == serialize::VariableByteIntegerStatus::Malformed || remainingLength > maxPacketSize)
+                {
+                    (void)flushFrames(); // the packets ahead of the bad one are still delivered
+                    return false;
+                }
+                else
+                {
+                    const size_t fixedHeaderSize = 1U + lengthSize;
+                    const size_t remainingLengthSz = remainingLength;
+                    const size_t totalPacketSize = fixedHeaderSize + remainingLengthSz;
 
-                        if (constexpr uint8_t remainingLengthContinueBit = 0x80u; (encodedByte & remainingLengthContinueBit) == 0U)
+                    if (streamingThreshold != 0U && totalPacketSize > streamingThreshold && (header[0] >> 4) == kPublishPacketType)
+                    {
+                        if (!flushFrames())
                         {
-                            haveRemainingLength = true;
+                            keepParsing = false; // paused by a listener; the PUBLISH waits behind the rest of the batch
+                            m_hasInboundBacklog = true;
+                            continue;
                         }
-                    }
 
-                    if (haveRemainingLength == false)
-                    {
-                        keepParsing = false; // not enough bytes to finish remaining length field
+                        // Too large to wait for: pass it on in fragments from the next iteration.
+                        m_streamedFrame = InboundFrame{
+                            {}, header[0], remainingLength, static_cast<uint8_t>(fixedHeaderSize), true, 0U };
+                        m_streamedFrameRemaining = totalPacketSize;
                     }
-                    else if (remainingLength > maxPacketSize)
-                    {
-                        return false;
-                    }
-                    else
+                    else if (available < totalPacketSize)
                     {
-                        const size_t fixedHeaderSize = index;
-                        const size_t remainingLengthSz = remainingLength;
-                        const size_t totalPacketSize = fixedHeaderSize + remainingLengthSz;
-
-                        if (available < totalPacketSize)
-                        {
-                            keepParsing = false; // incomplete packet in buffer
-                        }
-                        else
-                        {
-                            packetsToDispatch.emplace_back(base, base + totalPacketSize);
-
-                            m_dataBufferReadOffset += totalPacketSize;
-                            available -= totalPacketSize;
-                        }
+                        keepParsing = false; // incomplete packet in buffer
                     }
-                }
-
-                if (m_dataBufferReadOffset > 0)
-                {
-                    if (m_dataBufferReadOffset == m_dataBuffer.size())
+                    else if ((m_frameBatchSize == m_frameBatch.size() && !flushFrames()) || isOverBudget())
                     {
-                        m_dataBuffer.clear();
-                        m_dataBufferReadOffset = 0;
+                        keepParsing = false; // budget used up or paused; the frame waits for a later tick
+                        m_hasInboundBacklog = true;
                     }
                     else
                     {
-                        constexpr size_t compactMinBytes = 256 * 1024;
-                        constexpr float compactFraction = 0.75f;
-                        const auto thresholdByFraction = static_cast<size_t>(compactFraction * static_cast<float>(m_dataBuffer.size()));
-
-                        if (m_dataBufferReadOffset >= compactMinBytes && m_dataBufferReadOffset >= thresholdByFraction)
-                        {
-                            m_dataBuffer
-                                .erase(m_dataBuffer.begin(), m_dataBuffer.begin() + static_cast<std::ptrdiff_t>(m_dataBufferReadOffset));
-                            m_dataBufferReadOffset = 0;
-                        }
+                        const std::span<const uint8_t> frame
+                            = m_dataBuffer.getContiguousView(totalPacketSize, m_wrappedFrameScratch, m_frameBatchBytes);
+                        queueFrame(InboundFrame{ frame, header[0], remainingLength, static_cast<uint8_t>(fixedHeaderSize) });
+                        ++dispatched;
                     }
                 }
             }
 
-            for (const auto& p : packetsToDispatch)
+            if (!flushFrames())
             {
-                invokeOnDataReceived(p.data(), static_cast<uint32_t>(p.size()));
+                m_hasInboundBacklog = true;
             }
-
+            m_inboundBacklogBytes.store(m_hasInboundBacklog ? m_dataBuffer.getSize() : 0U, std::memory_order_relaxed);
             return true;
         }
 
@@ -255,22 +516,133 @@ namespace reactormq::socket
             getOnDisconnectCallback().broadcast();
         }
 
-        /// @brief Internal helper to deliver received bytes to listeners.
-        void invokeOnDataReceived(const uint8_t* data, const uint32_t size)
+        /// @brief Show a received packet to the packet tap; only called when one is attached.
+        void tapReceived(const std::span<const uint8_t> bytes) const
+        {
+            const std::span<const uint8_t> parts[] = { bytes };
+            m_packetTap->onPacket(mqtt::PacketDirection::Received, parts, bytes.size());
+        }
+
+        /// @brief Add a parsed packet to the batch; the caller makes room first.
+        void queueFrame(const InboundFrame& frame)
         {
-            getOnDataReceivedCallback().broadcast(data, size);
+            m_frameBatch[m_frameBatchSize++] = frame;
+            m_frameBatchBytes += frame.bytes.size();
         }
 
-        /// @return get the settings ptr
-        mqtt::ConnectionSettingsPtr getSettings() const
+        /**
+         * @brief Deliver the batch to the batch listeners or, when there are none, packet by packet to the per-packet
+         * listeners. Then count, tap and consume the packets they took.
+         * @return False when a listener paused receiving before taking every packet; the rest stay buffered.
+         */
+        bool flushFrames()
+        {
+            if (m_frameBatchSize == 0U)
+            {
+                return true;
+            }
+
+            const std::span<const InboundFrame> frames{ m_frameBatch.data(), m_frameBatchSize };
+            m_frameBatchSize = 0U;
+            m_frameBatchBytes = 0U;
+
+            size_t handled = frames.size();
+            if (m_onDataReceivedBatch.getSize() != 0U)
+            {
+                m_onDataReceivedBatch.broadcast(frames, handled);
+                handled = std::clamp<size_t>(handled, 1U, frames.size());
+            }
+            else
+            {
+                OnDataReceivedCallback& onDataReceived = getOnDataReceivedCallback();
+                handled = 0U;
+                do
+                {
+                    onDataReceived.broadcast(frames[handled++]);
+                } while (handled < frames.size() && !m_isReceivePaused);
+            }
+
+            size_t handledBytes = 0U;
+            for (const InboundFrame& frame : frames.first(handled))
+            {
+                handledBytes += frame.bytes.size();
+                if (m_trafficCounters)
+                {
+                    m_trafficCounters->recordReceived(frame.bytes.size(), frame.fragmentOffset == 0U ? 1U : 0U);
+                }
+                if (m_packetTap)
+                {
+                    tapReceived(frame.bytes);
+                }
+            }
+            m_dataBuffer.consume(handledBytes);
+            return handled == frames.size();
+        }
+
+        /// @brief Count one packet of @p bytes handed to the transport, if counters are attached.
+        void recordSent(const size_t bytes, const size_t packets = 1) const
+        {
+            if (m_trafficCounters)
+            {
+                m_trafficCounters->recordSent(bytes, packets);
+            }
+        }
+
+        /**
+         * @brief Show bytes handed to the transport to the packet tap, if one is attached.
+         * @param buffers The bytes, before any TLS or WebSocket framing.
+         * @param originalSize Size of the write; more than the buffers hold when a streamed payload follows them.
+         */
+        void tapSent(const std::span<const SendBuffer> buffers, const size_t originalSize)
+        {
+            if (!m_packetTap)
+            {
+                return;
+            }
+
+            m_tapParts.clear();
+            for (const SendBuffer& buffer : buffers)
+            {
+                m_tapParts.emplace_back(buffer.data, buffer.size);
+            }
+            m_packetTap->onPacket(mqtt::PacketDirection::Sent, m_tapParts, originalSize);
+        }
+
+        /// @brief Show bytes handed to the transport to the packet tap, if one is attached.
+        void tapSent(const std::span<const std::byte> data)
+        {
+            const SendBuffer buffer{ reinterpret_cast<const uint8_t*>(data.data()), data.size() };
+            tapSent(std::span{ &buffer, 1 }, data.size());
+        }
+
+        /// @return The settings; set once at construction, so the reference stays valid for the socket's life.
+        [[nodiscard]] const mqtt::ConnectionSettingsPtr& getSettings() const
         {
             return m_settings;
         }
 
     private:
-        std::vector<uint8_t> m_dataBuffer; ///< Internal buffer for accumulating received packet bytes.
-        size_t m_dataBufferReadOffset = 0; ///< Offset into the buffer for already-consumed bytes.
-
-        mqtt::ConnectionSettingsPtr m_settings;
+        /// Most packets delivered in one batch.
+        static constexpr size_t kMaxFrameBatch = 32;
+
+        serialize::RingBuffer m_dataBuffer; ///< Internal ring for accumulating received packet bytes.
+        std::vector<uint8_t> m_wrappedFrameScratch; ///< Contiguous copy of a frame that wraps the ring.
+        bool m_hasInboundBacklog = false; ///< The last dispatch stopped on its budget with complete frames left.
+        bool m_isReceivePaused = false; ///< Set while the application is not keeping up with delivered messages.
+        bool m_isInboundPacketLimited = true; ///< Dispatch stops at the settings' per-tick packet count.
+        std::atomic<size_t> m_inboundBacklogBytes{ 0 }; ///< Mirror of the backlog size for other threads.
+        std::shared_ptr<TrafficCounters> m_trafficCounters; ///< Owner's traffic totals; null when not counted.
+        mqtt::PacketTapPtr m_packetTap; ///< Tap shown every packet; null when not tapped.
+        std::vector<std::span<const uint8_t>> m_tapParts; ///< Reused by tapSent() so tapping a send does not allocate.
+        InboundFrame m_streamedFrame; ///< Fixed header fields and progress of the PUBLISH being passed on in fragments.
+        size_t m_streamedFrameRemaining = 0; ///< Bytes of that PUBLISH not passed on yet; 0 when none is.
+        OnDataReceivedBatchCallback m_onDataReceivedBatch; ///< Listeners given each read's packets at once.
+        std::array<InboundFrame, kMaxFrameBatch> m_frameBatch{}; ///< Packets parsed but not delivered or consumed yet.
+        size_t m_frameBatchSize = 0; ///< Number of m_frameBatch entries in use.
+        size_t m_frameBatchBytes = 0; ///< Bytes those packets span at the front of m_dataBuffer.
+
+        static constexpr uint8_t kPublishPacketType = 3U;
+
+        const mqtt::ConnectionSettingsPtr m_settings;
     };
 } // namespace reactormq::socket
\ No newline at end of file
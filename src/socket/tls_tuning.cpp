@@ -0,0 +1,115 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/tls_tuning.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__) && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
+#include <sys/auxv.h>
+#endif
+
+// Suites left out of every TLS 1.2 list, the same as the shared SSL_CTX's.
+#define REACTORMQ_TLS12_HIGH_CIPHERS "HIGH:!aNULL:!eNULL:!EXPORT:!DES:!RC4:!MD5:!PSK:!SRP:!CAMELLIA:!SEED:!IDEA:!3DES"
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        bool detectHardwareAes()
+        {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int registers[4] = {};
+            __cpuid(registers, 1);
+            return (registers[2] & (1 << 25)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+            unsigned int eax = 0;
+            unsigned int ebx = 0;
+            unsigned int ecx = 0;
+            unsigned int edx = 0;
+            return __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_AES) != 0;
+#elif defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+            return true;
+#elif defined(__aarch64__) && (REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID)
+            constexpr unsigned long kHwcapAes = 1UL << 3; // HWCAP_AES in <asm/hwcap.h>.
+            return (getauxval(AT_HWCAP) & kHwcapAes) != 0;
+#elif defined(_M_ARM64) || (defined(__aarch64__) && REACTORMQ_PLATFORM_DARWIN_FAMILY)
+            // Every Apple silicon and Windows on Arm device has the ARMv8 crypto extensions.
+            return true;
+#else
+            return false;
+#endif
+        }
+    } // namespace
+
+    bool hasHardwareAes()
+    {
+        static const bool hasAes = detectHardwareAes();
+        return hasAes;
+    }
+
+    mqtt::TlsCipherPreference resolveCipherPreference(const mqtt::TlsCipherPreference preference)
+    {
+        if (preference != mqtt::TlsCipherPreference::Auto)
+        {
+            return preference;
+        }
+        return hasHardwareAes() ? mqtt::TlsCipherPreference::AesGcm : mqtt::TlsCipherPreference::ChaCha20;
+    }
+
+    const char* getTls13CipherSuites(const mqtt::TlsCipherPreference preference)
+    {
+        switch (preference)
+        {
+        case mqtt::TlsCipherPreference::LibraryDefault:
+            return "TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256:TLS_AES_128_GCM_SHA256";
+        case mqtt::TlsCipherPreference::ChaCha20:
+            return "TLS_CHACHA20_POLY1305_SHA256:TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384";
+        case mqtt::TlsCipherPreference::Auto:
+        case mqtt::TlsCipherPreference::AesGcm:
+            break;
+        }
+        return "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256";
+    }
+
+    const char* getTls12CipherList(const mqtt::TlsCipherPreference preference)
+    {
+        switch (preference)
+        {
+        case mqtt::TlsCipherPreference::LibraryDefault:
+            return REACTORMQ_TLS12_HIGH_CIPHERS;
+        case mqtt::TlsCipherPreference::ChaCha20:
+            return "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:"
+                   "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:"
+                   "ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384:" REACTORMQ_TLS12_HIGH_CIPHERS;
+        case mqtt::TlsCipherPreference::Auto:
+        case mqtt::TlsCipherPreference::AesGcm:
+            break;
+        }
+        return "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:"
+               "ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384:"
+               "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:" REACTORMQ_TLS12_HIGH_CIPHERS;
+    }
+
+    std::uint8_t getMaxFragmentLengthCode(const std::uint16_t maxFragmentLength)
+    {
+        switch (maxFragmentLength)
+        {
+        case 512:
+            return 1;
+        case 1024:
+            return 2;
+        case 2048:
+            return 3;
+        case 4096:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+} // namespace reactormq::socket
+
+#undef REACTORMQ_TLS12_HIGH_CIPHERS
@@ -0,0 +1,95 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/tls_tuning_options.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace reactormq::socket
+{
+    /// Largest plaintext a TLS record carries (2^14 bytes), and the smallest size OpenSSL lets a sender cap records at.
+    inline constexpr std::uint32_t kMaxTlsRecordSize = 16384;
+    inline constexpr std::uint32_t kMinTlsRecordSize = 512;
+
+    /// @return True when the CPU has AES instructions: AES-NI on x86, the crypto extensions on ARMv8.
+    [[nodiscard]] bool hasHardwareAes();
+
+    /// @return @p preference with Auto replaced by AesGcm or ChaCha20 according to hasHardwareAes().
+    [[nodiscard]] mqtt::TlsCipherPreference resolveCipherPreference(mqtt::TlsCipherPreference preference);
+
+    /// @return TLS 1.3 suites for SSL_set_ciphersuites(), in the order @p preference asks for (Auto counts as AesGcm).
+    [[nodiscard]] const char* getTls13CipherSuites(mqtt::TlsCipherPreference preference);
+
+    /// @return TLS 1.2 cipher list for SSL_set_cipher_list(): the preferred AEAD suites, then the rest of HIGH.
+    [[nodiscard]] const char* getTls12CipherList(mqtt::TlsCipherPreference preference);
+
+    /// @return RFC 6066 code of a Maximum Fragment Length (1 for 512 up to 4 for 4096), or 0 for any other length.
+    [[nodiscard]] std::uint8_t getMaxFragmentLengthCode(std::uint16_t maxFragmentLength);
+
+    /**
+     * @brief Dynamic TLS record sizing: small records at the start of a burst, so the first bytes decrypt as soon as
+     * one TCP segment has arrived, and full-size records once the burst has lasted long enough for the per-record
+     * cost to matter more than the latency. Called by the socket around each write.
+     */
+    class TlsRecordSizer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// A sizer that is off and leaves record sizes to the TLS library.
+        TlsRecordSizer() = default;
+
+        explicit TlsRecordSizer(const mqtt::TlsTuningOptions& options)
+            : m_isEnabled(options.dynamicRecordSizing)
+            , m_growAfterBytes(options.growAfterBytes)
+            , m_idleReset(std::chrono::milliseconds(options.idleResetMs))
+        {
+            const std::uint32_t fragmentCode = getMaxFragmentLengthCode(options.maxFragmentLength);
+            m_fullRecordSize = fragmentCode != 0 ? options.maxFragmentLength : kMaxTlsRecordSize;
+            m_smallRecordSize = std::clamp<std::uint32_t>(options.initialRecordSize, kMinTlsRecordSize, m_fullRecordSize);
+        }
+
+        [[nodiscard]] bool isEnabled() const
+        {
+            return m_isEnabled;
+        }
+
+        /**
+         * @brief Get the record size for a write starting at @p now; a gap of idleResetMs since the last write starts
+         * a new burst.
+         * @return Plaintext bytes per record.
+         */
+        [[nodiscard]] std::uint32_t getRecordSize(const Clock::time_point now)
+        {
+            if (m_hasSent && now - m_lastSend >= m_idleReset)
+            {
+                m_burstBytes = 0;
+            }
+            return m_burstBytes >= m_growAfterBytes ? m_fullRecordSize : m_smallRecordSize;
+        }
+
+        /// @brief Count @p bytes accepted by a write made at @p now towards the current burst.
+        void onSent(const std::size_t bytes, const Clock::time_point now)
+        {
+            m_burstBytes += bytes;
+            m_lastSend = now;
+            m_hasSent = true;
+        }
+
+    private:
+        bool m_isEnabled = false;
+        bool m_hasSent = false;
+        std::uint32_t m_smallRecordSize = kMaxTlsRecordSize;
+        std::uint32_t m_fullRecordSize = kMaxTlsRecordSize;
+        std::uint64_t m_growAfterBytes = 0;
+        std::uint64_t m_burstBytes = 0;
+        Clock::duration m_idleReset{};
+        Clock::time_point m_lastSend{};
+    };
+} // namespace reactormq::socket
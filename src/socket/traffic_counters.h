@@ -0,0 +1,35 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Bytes and packets crossing a socket, shared with its owner so totals survive the socket being replaced.
+     * Written by the reactor thread with relaxed atomics; readable from any thread.
+     */
+    struct TrafficCounters
+    {
+        std::atomic<std::uint64_t> bytesSent{ 0 };
+        std::atomic<std::uint64_t> packetsSent{ 0 };
+        std::atomic<std::uint64_t> bytesReceived{ 0 };
+        std::atomic<std::uint64_t> packetsReceived{ 0 };
+
+        void recordSent(const std::uint64_t bytes, const std::uint64_t packets = 1)
+        {
+            bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+            packetsSent.fetch_add(packets, std::memory_order_relaxed);
+        }
+
+        void recordReceived(const std::uint64_t bytes, const std::uint64_t packets = 1)
+        {
+            bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+            packetsReceived.fetch_add(packets, std::memory_order_relaxed);
+        }
+    };
+} // namespace reactormq::socket
@@ -0,0 +1,871 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/websocket_codec.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REACTORMQ_WEBSOCKET_MASK_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define REACTORMQ_WEBSOCKET_MASK_NEON 1
+#endif
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        /// RFC 6455 section 1.3: appended to the client's key before hashing.
+        constexpr std::string_view kAcceptGuid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+        constexpr std::uint8_t kFinalFrameBit = 0x80;
+        constexpr std::uint8_t kReservedBits = 0x70;
+        constexpr std::uint8_t kCompressedBit = 0x40; ///< RSV1, the "Per-Message Compressed" bit of RFC 7692.
+        constexpr std::uint8_t kOpcodeBits = 0x0F;
+        constexpr std::uint8_t kMaskBit = 0x80;
+        constexpr std::uint8_t kLengthBits = 0x7F;
+        constexpr std::uint8_t kLength16 = 126;
+        constexpr std::uint8_t kLength64 = 127;
+        constexpr size_t kMaxControlPayload = 125;
+        constexpr std::uint8_t kMinWindowBits = 9; ///< zlib cannot write raw DEFLATE with a 256-byte window.
+        constexpr std::uint8_t kMaxWindowBits = 15;
+
+        std::array<std::uint8_t, 20> sha1(const std::string_view input)
+        {
+            std::array<std::uint32_t, 5> state{ 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+            std::vector<std::uint8_t> message(input.begin(), input.end());
+            const std::uint64_t bitLength = static_cast<std::uint64_t>(input.size()) * 8;
+            message.push_back(0x80);
+            while (message.size() % 64 != 56)
+            {
+                message.push_back(0);
+            }
+            for (int shift = 56; shift >= 0; shift -= 8)
+            {
+                message.push_back(static_cast<std::uint8_t>(bitLength >> shift));
+            }
+
+            for (size_t block = 0; block < message.size(); block += 64)
+            {
+                std::array<std::uint32_t, 80> words{};
+                for (size_t i = 0; i < 16; ++i)
+                {
+                    const std::uint8_t* bytes = &message[block + i * 4];
+                    words[i] = static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16
+                               | static_cast<std::uint32_t>(bytes[2]) << 8 | static_cast<std::uint32_t>(bytes[3]);
+                }
+                for (size_t i = 16; i < words.size(); ++i)
+                {
+                    words[i] = std::rotl(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+                }
+
+                std::uint32_t a = state[0];
+                std::uint32_t b = state[1];
+                std::uint32_t c = state[2];
+                std::uint32_t d = state[3];
+                std::uint32_t e = state[4];
+                for (size_t i = 0; i < words.size(); ++i)
+                {
+                    std::uint32_t f;
+                    std::uint32_t k;
+                    if (i < 20)
+                    {
+                        f = (b & c) | (~b & d);
+                        k = 0x5A827999;
+                    }
+                    else if (i < 40)
+                    {
+                        f = b ^ c ^ d;
+                        k = 0x6ED9EBA1;
+                    }
+                    else if (i < 60)
+                    {
+                        f = (b & c) | (b & d) | (c & d);
+                        k = 0x8F1BBCDC;
+                    }
+                    else
+                    {
+                        f = b ^ c ^ d;
+                        k = 0xCA62C1D6;
+                    }
+
+                    const std::uint32_t next = std::rotl(a, 5) + f + e + k + words[i];
+                    e = d;
+                    d = c;
+                    c = std::rotl(b, 30);
+                    b = a;
+                    a = next;
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+                state[4] += e;
+            }
+
+            std::array<std::uint8_t, 20> digest{};
+            for (size_t i = 0; i < digest.size(); ++i)
+            {
+                digest[i] = static_cast<std::uint8_t>(state[i / 4] >> (24 - (i % 4) * 8));
+            }
+            return digest;
+        }
+
+        std::string base64Encode(const std::span<const std::uint8_t> data)
+        {
+            constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+            std::string encoded;
+            encoded.reserve((data.size() + 2) / 3 * 4);
+            size_t i = 0;
+            for (; i + 2 < data.size(); i += 3)
+            {
+                const std::uint32_t triple = static_cast<std::uint32_t>(data[i]) << 16 | static_cast<std::uint32_t>(data[i + 1]) << 8 | data[i + 2];
+                encoded.push_back(alphabet[triple >> 18 & 0x3F]);
+                encoded.push_back(alphabet[triple >> 12 & 0x3F]);
+                encoded.push_back(alphabet[triple >> 6 & 0x3F]);
+                encoded.push_back(alphabet[triple & 0x3F]);
+            }
+
+            if (const size_t remaining = data.size() - i; remaining > 0)
+            {
+                std::uint32_t triple = static_cast<std::uint32_t>(data[i]) << 16;
+                if (remaining == 2)
+                {
+                    triple |= static_cast<std::uint32_t>(data[i + 1]) << 8;
+                }
+                encoded.push_back(alphabet[triple >> 18 & 0x3F]);
+                encoded.push_back(alphabet[triple >> 12 & 0x3F]);
+                encoded.push_back(remaining == 2 ? alphabet[triple >> 6 & 0x3F] : '=');
+                encoded.push_back('=');
+            }
+            return encoded;
+        }
+
+        bool equalsIgnoreCase(const std::string_view left, const std::string_view right)
+        {
+            return std::ranges::equal(
+                left,
+                right,
+                [](const char a, const char b)
+                {
+                    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                });
+        }
+
+        /// Whether a comma-separated header value lists the token, ignoring case.
+        bool hasToken(std::string_view value, const std::string_view token)
+        {
+            while (!value.empty())
+            {
+                const size_t comma = value.find(',');
+                std::string_view item = value.substr(0, comma);
+                while (!item.empty() && (item.front() == ' ' || item.front() == '\t'))
+                {
+                    item.remove_prefix(1);
+                }
+                while (!item.empty() && (item.back() == ' ' || item.back() == '\t'))
+                {
+                    item.remove_suffix(1);
+                }
+                if (equalsIgnoreCase(item, token))
+                {
+                    return true;
+                }
+                value = comma == std::string_view::npos ? std::string_view{} : value.substr(comma + 1);
+            }
+            return false;
+        }
+
+        bool isControlOpcode(const std::uint8_t opcode)
+        {
+            return (opcode & 0x08) != 0;
+        }
+
+        std::string_view trim(std::string_view value)
+        {
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+            {
+                value.remove_prefix(1);
+            }
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+            {
+                value.remove_suffix(1);
+            }
+            return value;
+        }
+
+        /// Window bits from an extension parameter value, quoted or not; 0 if it is not 8..15.
+        std::uint8_t parseWindowBits(std::string_view value)
+        {
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            {
+                value = value.substr(1, value.size() - 2);
+            }
+            if (value.size() == 1 && value[0] >= '8' && value[0] <= '9')
+            {
+                return static_cast<std::uint8_t>(value[0] - '0');
+            }
+            if (value.size() == 2 && value[0] == '1' && value[1] >= '0' && value[1] <= '5')
+            {
+                return static_cast<std::uint8_t>(10 + value[1] - '0');
+            }
+            return 0;
+        }
+    } // namespace
+
+    WebSocketCodec::WebSocketCodec(const mqtt::WebSocketDeflateOptions& deflateOptions, const size_t maxDecodedSize)
+        : m_deflateOptions(deflateOptions)
+        , m_maxDecodedSize(maxDecodedSize)
+        , m_random(std::random_device{}())
+    {
+#if !REACTORMQ_WITH_ZLIB
+        if (m_deflateOptions.enabled)
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Warn,
+                "WebSocketCodec permessage-deflate needs a build with REACTORMQ_WITH_ZLIB; not offering it");
+            m_deflateOptions.enabled = false;
+        }
+#endif // !REACTORMQ_WITH_ZLIB
+        m_deflateOptions.clientMaxWindowBits = std::clamp(m_deflateOptions.clientMaxWindowBits, kMinWindowBits, kMaxWindowBits);
+        m_deflateOptions.serverMaxWindowBits = std::clamp(m_deflateOptions.serverMaxWindowBits, kMinWindowBits, kMaxWindowBits);
+    }
+
+    WebSocketCodec::~WebSocketCodec() = default;
+
+    WebSocketCodec::WebSocketCodec(WebSocketCodec&&) noexcept = default;
+
+    WebSocketCodec& WebSocketCodec::operator=(WebSocketCodec&&) noexcept = default;
+
+    std::string WebSocketCodec::createUpgradeRequest(const std::string& host, const std::uint16_t port, const std::string& path)
+    {
+        std::array<std::uint8_t, 16> nonce{};
+        for (size_t i = 0; i < nonce.size(); i += 4)
+        {
+            const auto value = static_cast<std::uint32_t>(m_random());
+            std::memcpy(&nonce[i], &value, sizeof(value));
+        }
+        const std::string key = base64Encode(nonce);
+        m_expectedAccept = computeAcceptKey(key);
+        m_upgradeResponse.clear();
+        m_isDeflateNegotiated = false;
+        m_state = State::Upgrading;
+
+        // An IPv6 literal needs brackets to keep its colons apart from the port.
+        const bool isIpv6Literal = host.find(':') != std::string::npos;
+
+        std::string request;
+        request.reserve(256 + host.size() + path.size());
+        request.append("GET ");
+        if (path.empty() || path.front() != '/')
+        {
+            request.push_back('/');
+        }
+        request.append(path).append(" HTTP/1.1\r\nHost: ");
+        request.append(isIpv6Literal ? "[" : "").append(host).append(isIpv6Literal ? "]:" : ":").append(std::to_string(port));
+        request.append("\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: ").append(key);
+        request.append("\r\nSec-WebSocket-Version: 13\r\nSec-WebSocket-Protocol: mqtt\r\n");
+        if (m_deflateOptions.enabled)
+        {
+            // A bare client_max_window_bits tells the server it may ask for a smaller client window.
+            request.append("Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits");
+            if (m_deflateOptions.clientMaxWindowBits < kMaxWindowBits)
+            {
+                request.push_back('=');
+                request.append(std::to_string(m_deflateOptions.clientMaxWindowBits));
+            }
+            if (m_deflateOptions.serverMaxWindowBits < kMaxWindowBits)
+            {
+                request.append("; server_max_window_bits=").append(std::to_string(m_deflateOptions.serverMaxWindowBits));
+            }
+            if (!m_deflateOptions.clientContextTakeover)
+            {
+                request.append("; client_no_context_takeover");
+            }
+            if (!m_deflateOptions.serverContextTakeover)
+            {
+                request.append("; server_no_context_takeover");
+            }
+            request.append("\r\n");
+        }
+        request.append("\r\n");
+        return request;
+    }
+
+    WebSocketCodec::UpgradeStatus WebSocketCodec::readUpgradeResponse(const std::span<const std::uint8_t> data, size_t& outConsumed)
+    {
+        outConsumed = 0;
+        if (m_state != State::Upgrading)
+        {
+            return UpgradeStatus::Rejected;
+        }
+
+        const size_t previousSize = m_upgradeResponse.size();
+        m_upgradeResponse.append(reinterpret_cast<const char*>(data.data()), data.size());
+        const size_t headEnd = m_upgradeResponse.find("\r\n\r\n", previousSize >= 3 ? previousSize - 3 : 0);
+        if (headEnd == std::string::npos)
+        {
+            if (m_upgradeResponse.size() > kMaxUpgradeResponseSize)
+            {
+                fail("upgrade response head too large");
+                return UpgradeStatus::Rejected;
+            }
+            outConsumed = data.size();
+            return UpgradeStatus::Pending;
+        }
+
+        outConsumed = headEnd + 4 - previousSize;
+        m_upgradeResponse.resize(headEnd);
+
+        std::string_view head = m_upgradeResponse;
+        const std::string_view statusLine = head.substr(0, head.find("\r\n"));
+        if (!statusLine.starts_with("HTTP/1.") || statusLine.substr(8, 4) != " 101" || (statusLine.size() > 12 && statusLine[12] != ' '))
+        {
+            REACTORMQ_LOG(
+                logging::LogLevel::Error,
+                "WebSocketCodec::readUpgradeResponse() server refused the upgrade (status=%.*s)",
+                static_cast<int>(statusLine.size()),
+                statusLine.data());
+            fail("upgrade refused");
+            return UpgradeStatus::Rejected;
+        }
+
+        bool hasUpgrade = false;
+        bool hasConnection = false;
+        bool hasAccept = false;
+        const char* problem = nullptr;
+        head.remove_prefix(std::min(head.size(), statusLine.size() + 2));
+        while (!head.empty() && problem == nullptr)
+        {
+            const size_t lineEnd = head.find("\r\n");
+            const std::string_view line = head.substr(0, lineEnd);
+            head = lineEnd == std::string_view::npos ? std::string_view{} : head.substr(lineEnd + 2);
+
+            const size_t colon = line.find(':');
+            if (colon == std::string_view::npos)
+            {
+                continue;
+            }
+            const std::string_view name = line.substr(0, colon);
+            std::string_view value = line.substr(colon + 1);
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+            {
+                value.remove_prefix(1);
+            }
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+            {
+                value.remove_suffix(1);
+            }
+
+            if (equalsIgnoreCase(name, "Upgrade"))
+            {
+                hasUpgrade = equalsIgnoreCase(value, "websocket");
+            }
+            else if (equalsIgnoreCase(name, "Connection"))
+            {
+                hasConnection = hasToken(value, "upgrade");
+            }
+            else if (equalsIgnoreCase(name, "Sec-WebSocket-Accept"))
+            {
+                hasAccept = value == m_expectedAccept;
+            }
+            else if (equalsIgnoreCase(name, "Sec-WebSocket-Protocol") && !equalsIgnoreCase(value, "mqtt"))
+            {
+                problem = "server chose a subprotocol other than mqtt";
+            }
+            else if (equalsIgnoreCase(name, "Sec-WebSocket-Extensions"))
+            {
+                problem = acceptExtensions(value);
+            }
+        }
+
+        if (problem == nullptr && !(hasUpgrade && hasConnection))
+        {
+            problem = "Upgrade or Connection header missing";
+        }
+        if (problem == nullptr && !hasAccept)
+        {
+            problem = "Sec-WebSocket-Accept does not match the key";
+        }
+        if (problem != nullptr)
+        {
+            fail(problem);
+            return UpgradeStatus::Rejected;
+        }
+
+        std::string{}.swap(m_upgradeResponse);
+        m_state = State::Open;
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "WebSocketCodec::readUpgradeResponse() upgrade accepted (deflate=%s)",
+            m_isDeflateNegotiated ? "true" : "false");
+        return UpgradeStatus::Accepted;
+    }
+
+    SendBuffer WebSocketCodec::encodeBinaryFrame(const std::span<const SendBuffer> payload)
+    {
+        m_frameBuffer.clear();
+        appendBinaryFrame(payload, m_frameBuffer);
+        return SendBuffer{ m_frameBuffer.data(), m_frameBuffer.size() };
+    }
+
+    void WebSocketCodec::appendBinaryFrame(const std::span<const SendBuffer> payload, std::vector<std::uint8_t>& out)
+    {
+        size_t payloadSize = 0;
+        for (const SendBuffer& buffer : payload)
+        {
+            payloadSize += buffer.size;
+        }
+
+#if REACTORMQ_WITH_ZLIB
+        // Once a packet went into the compressor it has to be sent compressed: with context takeover the server's
+        // inflater needs it in its window.
+        if (m_deflate && payloadSize >= m_deflateOptions.minCompressBytes && m_deflate->compress(payload, m_compressBuffer))
+        {
+            const std::array<std::uint8_t, 4> key = appendHeader(Opcode::Binary, m_compressBuffer.size(), out, true);
+            const size_t offset = out.size();
+            out.resize(offset + m_compressBuffer.size());
+            maskCopy(out.data() + offset, m_compressBuffer.data(), m_compressBuffer.size(), key);
+            return;
+        }
+#endif // REACTORMQ_WITH_ZLIB
+
+        const std::array<std::uint8_t, 4> key = appendHeader(Opcode::Binary, payloadSize, out);
+        size_t offset = out.size();
+        out.resize(offset + payloadSize);
+        size_t keyOffset = 0;
+        for (const SendBuffer& buffer : payload)
+        {
+            maskCopy(out.data() + offset, buffer.data, buffer.size, key, keyOffset);
+            offset += buffer.size;
+            keyOffset += buffer.size;
+        }
+    }
+
+    void WebSocketCodec::appendCloseFrame(const std::uint16_t code, std::vector<std::uint8_t>& out)
+    {
+        if (m_hasSentClose)
+        {
+            return;
+        }
+        m_hasSentClose = true;
+
+        const std::array payload{ static_cast<std::uint8_t>(code >> 8), static_cast<std::uint8_t>(code & 0xFF) };
+        appendControlFrame(Opcode::Close, payload, out);
+    }
+
+    bool WebSocketCodec::decode(const std::span<std::uint8_t> data, size_t& outPayloadSize)
+    {
+        outPayloadSize = 0;
+        if (m_state != State::Open)
+        {
+            return false;
+        }
+
+        // Payload bytes are moved down over the headers in front of them, so write never overtakes read.
+        size_t read = 0;
+        size_t write = 0;
+        while (read < data.size())
+        {
+            if (!m_isInFrame)
+            {
+                while (m_headerSize < getHeaderSize() && read < data.size())
+                {
+                    m_header[m_headerSize++] = data[read++];
+                }
+                if (m_headerSize < getHeaderSize())
+                {
+                    break;
+                }
+                if (!beginFrame() || (m_payloadRemaining == 0 && !finishFrame()))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const auto take = static_cast<size_t>(std::min<std::uint64_t>(m_payloadRemaining, data.size() - read));
+            if (isControlOpcode(static_cast<std::uint8_t>(m_frameOpcode)))
+            {
+                m_controlPayload.insert(m_controlPayload.end(), data.data() + read, data.data() + read + take);
+            }
+            else if (m_isDeflateNegotiated)
+            {
+                if (!takeDataPayload(data.subspan(read, take)))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                if (write != read)
+                {
+                    std::memmove(data.data() + write, data.data() + read, take);
+                }
+                write += take;
+            }
+            read += take;
+            m_payloadRemaining -= take;
+
+            if (m_payloadRemaining == 0 && !finishFrame())
+            {
+                return false;
+            }
+        }
+
+        outPayloadSize = write;
+        return true;
+    }
+
+    std::string WebSocketCodec::computeAcceptKey(const std::string_view key)
+    {
+        std::string input;
+        input.reserve(key.size() + kAcceptGuid.size());
+        input.append(key).append(kAcceptGuid);
+        return base64Encode(sha1(input));
+    }
+
+    void WebSocketCodec::maskCopy(
+        std::uint8_t* dst,
+        const std::uint8_t* src,
+        const size_t size,
+        const std::array<std::uint8_t, 4>& key,
+        const size_t keyOffset)
+    {
+        // Sixteen bytes of key starting at keyOffset; 16 is a multiple of 4, so the same pattern lines up with every block.
+        std::array<std::uint8_t, 16> pattern{};
+        for (size_t i = 0; i < pattern.size(); ++i)
+        {
+            pattern[i] = key[(keyOffset + i) & 3];
+        }
+
+        size_t i = 0;
+#if REACTORMQ_WEBSOCKET_MASK_SSE2
+        const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.data()));
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(block, mask));
+        }
+#elif REACTORMQ_WEBSOCKET_MASK_NEON
+        const uint8x16_t mask = vld1q_u8(pattern.data());
+        for (; i + 16 <= size; i += 16)
+        {
+            vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), mask));
+        }
+#endif // REACTORMQ_WEBSOCKET_MASK_SSE2
+        for (; i < size; ++i)
+        {
+            dst[i] = src[i] ^ pattern[i & 15];
+        }
+    }
+
+    std::array<std::uint8_t, 4> WebSocketCodec::appendHeader(
+        const Opcode opcode,
+        const size_t payloadSize,
+        std::vector<std::uint8_t>& out,
+        const bool isCompressed)
+    {
+        out.push_back(static_cast<std::uint8_t>(kFinalFrameBit | (isCompressed ? kCompressedBit : 0) | static_cast<std::uint8_t>(opcode)));
+        if (payloadSize < kLength16)
+        {
+            out.push_back(static_cast<std::uint8_t>(kMaskBit | payloadSize));
+        }
+        else if (payloadSize <= 0xFFFF)
+        {
+            out.push_back(kMaskBit | kLength16);
+            out.push_back(static_cast<std::uint8_t>(payloadSize >> 8));
+            out.push_back(static_cast<std::uint8_t>(payloadSize & 0xFF));
+        }
+        else
+        {
+            out.push_back(kMaskBit | kLength64);
+            for (int shift = 56; shift >= 0; shift -= 8)
+            {
+                out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(payloadSize) >> shift));
+            }
+        }
+
+        const auto value = static_cast<std::uint32_t>(m_random());
+        const std::array key{ static_cast<std::uint8_t>(value >> 24),
+                              static_cast<std::uint8_t>(value >> 16),
+                              static_cast<std::uint8_t>(value >> 8),
+                              static_cast<std::uint8_t>(value) };
+        out.insert(out.end(), key.begin(), key.end());
+        return key;
+    }
+
+    const char* WebSocketCodec::acceptExtensions(const std::string_view value)
+    {
+        if (!m_deflateOptions.enabled)
+        {
+            return "server enabled an extension that was not offered";
+        }
+        if (m_isDeflateNegotiated || value.find(',') != std::string_view::npos)
+        {
+            return "server enabled more than one extension";
+        }
+
+        size_t separator = value.find(';');
+        if (!equalsIgnoreCase(trim(value.substr(0, separator)), "permessage-deflate"))
+        {
+            return "server enabled an extension that was not offered";
+        }
+
+        std::uint8_t clientWindowBits = m_deflateOptions.clientMaxWindowBits;
+        std::uint8_t serverWindowBits = kMaxWindowBits;
+        bool clientContextTakeover = m_deflateOptions.clientContextTakeover;
+        bool serverContextTakeover = true;
+        std::uint8_t seen = 0;
+        while (separator != std::string_view::npos)
+        {
+            const size_t next = value.find(';', separator + 1);
+            const size_t length = next == std::string_view::npos ? std::string_view::npos : next - separator - 1;
+            const std::string_view parameter = trim(value.substr(separator + 1, length));
+            separator = next;
+
+            const size_t equals = parameter.find('=');
+            const std::string_view name = trim(parameter.substr(0, equals));
+            const std::string_view argument = equals == std::string_view::npos ? std::string_view{} : trim(parameter.substr(equals + 1));
+
+            std::uint8_t flag = 0;
+            if (equalsIgnoreCase(name, "server_no_context_takeover") && argument.empty())
+            {
+                flag = 1;
+                serverContextTakeover = false;
+            }
+            else if (equalsIgnoreCase(name, "client_no_context_takeover") && argument.empty())
+            {
+                flag = 2;
+                clientContextTakeover = false;
+            }
+            else if (equalsIgnoreCase(name, "server_max_window_bits"))
+            {
+                flag = 4;
+                const std::uint8_t bits = parseWindowBits(argument);
+                if (bits == 0 || bits > m_deflateOptions.serverMaxWindowBits)
+                {
+                    return "server_max_window_bits missing, invalid or larger than offered";
+                }
+                // Inflating with a larger window than the sender used is fine.
+                serverWindowBits = std::max(bits, kMinWindowBits);
+            }
+            else if (equalsIgnoreCase(name, "client_max_window_bits"))
+            {
+                flag = 8;
+                const std::uint8_t bits = parseWindowBits(argument);
+                if (bits < kMinWindowBits)
+                {
+                    return "client_max_window_bits missing or below 9";
+                }
+                clientWindowBits = std::min(clientWindowBits, bits);
+            }
+            else
+            {
+                return "unknown permessage-deflate parameter";
+            }
+
+            if ((seen & flag) != 0)
+            {
+                return "repeated permessage-deflate parameter";
+            }
+            seen |= flag;
+        }
+
+        // RFC 7692 section 7.1.2.1: a server that accepts a window limit says so in the response.
+        if (m_deflateOptions.serverMaxWindowBits < kMaxWindowBits && (seen & 4) == 0)
+        {
+            return "server_max_window_bits offered but not answered";
+        }
+
+#if REACTORMQ_WITH_ZLIB
+        m_deflate = std::make_unique<WebSocketDeflate>(clientWindowBits, clientContextTakeover, serverWindowBits, serverContextTakeover);
+        if (!m_deflate->isValid())
+        {
+            m_deflate.reset();
+            return "zlib could not set up permessage-deflate";
+        }
+#endif // REACTORMQ_WITH_ZLIB
+
+        REACTORMQ_LOG(
+            logging::LogLevel::Debug,
+            "WebSocketCodec permessage-deflate negotiated (clientWindowBits=%u, serverWindowBits=%u, clientContextTakeover=%s, "
+            "serverContextTakeover=%s)",
+            clientWindowBits,
+            serverWindowBits,
+            clientContextTakeover ? "true" : "false",
+            serverContextTakeover ? "true" : "false");
+        m_isDeflateNegotiated = true;
+        return nullptr;
+    }
+
+    bool WebSocketCodec::takeDataPayload(const std::span<const std::uint8_t> data)
+    {
+#if REACTORMQ_WITH_ZLIB
+        if (m_isMessageCompressed)
+        {
+            return m_deflate->decompress(data, false, m_decodedPayload, m_maxDecodedSize)
+                   || fail("corrupt or oversized compressed message");
+        }
+#endif // REACTORMQ_WITH_ZLIB
+        m_decodedPayload.insert(m_decodedPayload.end(), data.begin(), data.end());
+        return true;
+    }
+
+    void WebSocketCodec::appendControlFrame(const Opcode opcode, const std::span<const std::uint8_t> payload, std::vector<std::uint8_t>& out)
+    {
+        const std::array<std::uint8_t, 4> key = appendHeader(opcode, payload.size(), out);
+        const size_t offset = out.size();
+        out.resize(offset + payload.size());
+        maskCopy(out.data() + offset, payload.data(), payload.size(), key);
+    }
+
+    size_t WebSocketCodec::getHeaderSize() const
+    {
+        if (m_headerSize < 2)
+        {
+            return 2;
+        }
+
+        const std::uint8_t length = m_header[1] & kLengthBits;
+        size_t size = 2;
+        if (length == kLength16)
+        {
+            size += 2;
+        }
+        else if (length == kLength64)
+        {
+            size += 8;
+        }
+        if ((m_header[1] & kMaskBit) != 0)
+        {
+            size += 4;
+        }
+        return size;
+    }
+
+    bool WebSocketCodec::beginFrame()
+    {
+        const bool isFinal = (m_header[0] & kFinalFrameBit) != 0;
+        const std::uint8_t opcode = m_header[0] & kOpcodeBits;
+        const std::uint8_t reservedBits = m_header[0] & kReservedBits;
+        // RSV1 marks a compressed message on its first frame only (RFC 7692 section 6.1).
+        const bool isCompressed
+            = reservedBits == kCompressedBit && m_isDeflateNegotiated && opcode == static_cast<std::uint8_t>(Opcode::Binary);
+        if (reservedBits != 0 && !isCompressed)
+        {
+            return fail("reserved bits set without a negotiated extension");
+        }
+        if ((m_header[1] & kMaskBit) != 0)
+        {
+            return fail("masked frame from the server");
+        }
+
+        std::uint64_t length = m_header[1] & kLengthBits;
+        if (length == kLength16)
+        {
+            length = static_cast<std::uint64_t>(m_header[2]) << 8 | m_header[3];
+        }
+        else if (length == kLength64)
+        {
+            length = 0;
+            for (size_t i = 2; i < 10; ++i)
+            {
+                length = length << 8 | m_header[i];
+            }
+            if ((length >> 63) != 0)
+            {
+                return fail("frame length out of range");
+            }
+        }
+
+        switch (static_cast<Opcode>(opcode))
+        {
+        case Opcode::Continuation:
+            if (!m_isInMessage)
+            {
+                return fail("continuation frame outside a fragmented message");
+            }
+            break;
+        case Opcode::Binary:
+            if (m_isInMessage)
+            {
+                return fail("new message before the fragmented one finished");
+            }
+            m_isMessageCompressed = isCompressed;
+            break;
+        case Opcode::Close:
+        case Opcode::Ping:
+        case Opcode::Pong:
+            if (!isFinal || length > kMaxControlPayload)
+            {
+                return fail("fragmented or oversized control frame");
+            }
+            break;
+        case Opcode::Text:
+            return fail("text frame; MQTT is carried in binary frames");
+        default:
+            return fail("unknown opcode");
+        }
+
+        m_frameOpcode = static_cast<Opcode>(opcode);
+        m_isFinalFrame = isFinal;
+        m_payloadRemaining = length;
+        m_isInFrame = true;
+        m_headerSize = 0;
+        m_controlPayload.clear();
+        return true;
+    }
+
+    bool WebSocketCodec::finishFrame()
+    {
+        m_isInFrame = false;
+        switch (m_frameOpcode)
+        {
+        case Opcode::Ping:
+            appendControlFrame(Opcode::Pong, m_controlPayload, m_pendingControlFrames);
+            return true;
+        case Opcode::Pong:
+            return true;
+        case Opcode::Close:
+            {
+                const std::uint16_t code = m_controlPayload.size() >= 2
+                                               ? static_cast<std::uint16_t>(m_controlPayload[0] << 8 | m_controlPayload[1])
+                                               : kCloseNormal;
+                REACTORMQ_LOG(logging::LogLevel::Info, "WebSocketCodec::decode() server closed the connection (code=%u)", code);
+                appendCloseFrame(code, m_pendingControlFrames);
+                m_state = State::Closed;
+                return false;
+            }
+        default:
+            m_isInMessage = !m_isFinalFrame;
+#if REACTORMQ_WITH_ZLIB
+            if (m_isFinalFrame && m_isMessageCompressed)
+            {
+                m_isMessageCompressed = false;
+                return m_deflate->decompress({}, true, m_decodedPayload, m_maxDecodedSize)
+                       || fail("corrupt or oversized compressed message");
+            }
+#endif // REACTORMQ_WITH_ZLIB
+            return true;
+        }
+    }
+
+    bool WebSocketCodec::fail(const char* reason)
+    {
+        REACTORMQ_LOG(logging::LogLevel::Error, "WebSocketCodec closing the connection (reason=%s)", reason);
+        m_state = State::Closed;
+        return false;
+    }
+} // namespace reactormq::socket
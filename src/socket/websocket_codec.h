@@ -0,0 +1,241 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/websocket_deflate_options.h"
+#include "socket/send_buffer.h"
+#include "socket/websocket_deflate.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief Client side of RFC 6455 for MQTT over WebSocket: the HTTP upgrade and the framing after it.
+     *
+     * Each outbound MQTT packet becomes one masked binary frame. Inbound frames are stripped in place, so their
+     * payloads stay in the receive buffer they were read into and join up into the MQTT byte stream there; fragmented
+     * messages need no reassembly buffer of their own. Pings are answered, and a close from the server ends the
+     * connection. Not thread-safe; the owning socket calls it under its own lock.
+     *
+     * With permessage-deflate negotiated (RFC 7692; builds with REACTORMQ_WITH_ZLIB), outbound packets are
+     * compressed into their frames and inbound payloads are inflated into getDecodedPayload() instead, since they
+     * no longer fit where they were read.
+     */
+    class WebSocketCodec final
+    {
+    public:
+        enum class State : std::uint8_t
+        {
+            Idle, ///< createUpgradeRequest() not called yet.
+            Upgrading, ///< Waiting for the server's 101 response.
+            Open, ///< Upgrade accepted; frames flow.
+            Closed ///< Upgrade rejected, close frame seen, or protocol error.
+        };
+
+        enum class UpgradeStatus : std::uint8_t
+        {
+            Pending,
+            Accepted,
+            Rejected
+        };
+
+        /// Close status for a normal closure (RFC 6455 section 7.4.1).
+        static constexpr std::uint16_t kCloseNormal = 1000;
+
+        /// Largest HTTP response head accepted during the upgrade.
+        static constexpr size_t kMaxUpgradeResponseSize = 8 * 1024;
+
+        /// Default cap on the bytes inflated by one decode() call.
+        static constexpr size_t kDefaultMaxDecodedSize = 4 * 1024 * 1024;
+
+        /**
+         * @brief Create a codec for one connection.
+         * @param deflateOptions permessage-deflate offer; ignored in builds without REACTORMQ_WITH_ZLIB.
+         * @param maxDecodedSize Most bytes one decode() call may inflate, normally the receive buffer cap.
+         */
+        explicit WebSocketCodec(
+            const mqtt::WebSocketDeflateOptions& deflateOptions = {},
+            size_t maxDecodedSize = kDefaultMaxDecodedSize);
+
+        ~WebSocketCodec();
+
+        WebSocketCodec(const WebSocketCodec&) = delete;
+        WebSocketCodec& operator=(const WebSocketCodec&) = delete;
+        WebSocketCodec(WebSocketCodec&&) noexcept;
+        WebSocketCodec& operator=(WebSocketCodec&&) noexcept;
+
+        /// @brief Current stage of the connection.
+        [[nodiscard]] State getState() const
+        {
+            return m_state;
+        }
+
+        /// @brief Whether the server accepted permessage-deflate; known once the upgrade is accepted.
+        [[nodiscard]] bool isDeflateNegotiated() const
+        {
+            return m_isDeflateNegotiated;
+        }
+
+        /**
+         * @brief Build the HTTP upgrade request asking for the "mqtt" subprotocol, and offering permessage-deflate when
+         * configured, and move to Upgrading.
+         * @param host Broker host name, sent in the Host header.
+         * @param port Broker port, sent in the Host header.
+         * @param path Request path from ConnectionSettings::getPath(); empty means "/".
+         * @return The request, to be written to the transport before anything else.
+         */
+        [[nodiscard]] std::string createUpgradeRequest(const std::string& host, std::uint16_t port, const std::string& path);
+
+        /**
+         * @brief Feed bytes read while Upgrading.
+         * @param data Bytes just read from the transport.
+         * @param outConsumed Receives how many leading bytes belonged to the response; the rest are already frames.
+         * @return Accepted once a valid 101 response is complete, Rejected if it is not one, Pending until then.
+         */
+        UpgradeStatus readUpgradeResponse(std::span<const std::uint8_t> data, size_t& outConsumed);
+
+        /**
+         * @brief Frame an outbound MQTT packet as one masked binary frame, compressed if deflate was negotiated.
+         * Masking and copying the payload are a single pass into a buffer the codec reuses.
+         * @param payload Regions of the packet, in order.
+         * @return The whole frame; valid until the next encodeBinaryFrame() call.
+         */
+        [[nodiscard]] SendBuffer encodeBinaryFrame(std::span<const SendBuffer> payload);
+
+        /**
+         * @brief Append an outbound MQTT packet as one masked binary frame.
+         * @param payload Regions of the packet, in order.
+         * @param out Buffer the frame is appended to.
+         */
+        void appendBinaryFrame(std::span<const SendBuffer> payload, std::vector<std::uint8_t>& out);
+
+        /**
+         * @brief Append a close frame, unless one was sent already.
+         * @param code Close status code.
+         * @param out Buffer the frame is appended to.
+         */
+        void appendCloseFrame(std::uint16_t code, std::vector<std::uint8_t>& out);
+
+        /**
+         * @brief Strip frame headers and control frames from received bytes in place.
+         * @param data Bytes just read; on return its first outPayloadSize bytes are MQTT stream bytes.
+         * @param outPayloadSize Receives the number of payload bytes left at the front of data.
+         * @return False on a protocol error or once the server sent a close frame.
+         */
+        bool decode(std::span<std::uint8_t> data, size_t& outPayloadSize);
+
+        /**
+         * @brief MQTT stream bytes decode() produced outside data: every payload once deflate is negotiated.
+         * They follow the in-place bytes of the same call; the caller takes and clears them.
+         */
+        [[nodiscard]] std::vector<std::uint8_t>& getDecodedPayload()
+        {
+            return m_decodedPayload;
+        }
+
+        /// @brief Control frames (pongs, the close reply) produced by decode(); the caller writes and clears them.
+        [[nodiscard]] std::vector<std::uint8_t>& getPendingControlFrames()
+        {
+            return m_pendingControlFrames;
+        }
+
+        /**
+         * @brief Sec-WebSocket-Accept value a server must answer the given key with (RFC 6455 section 4.2.2).
+         * @param key Sec-WebSocket-Key sent in the request.
+         * @return Base64 of the SHA-1 of the key and the protocol GUID.
+         */
+        [[nodiscard]] static std::string computeAcceptKey(std::string_view key);
+
+        /**
+         * @brief XOR bytes with a repeating 4-byte masking key, 16 bytes at a time with SSE2 or NEON where available.
+         * @param dst Destination; may be the same as src.
+         * @param src Source bytes.
+         * @param size Number of bytes.
+         * @param key Masking key.
+         * @param keyOffset Index into the key of the byte that masks src[0].
+         */
+        static void maskCopy(
+            std::uint8_t* dst,
+            const std::uint8_t* src,
+            size_t size,
+            const std::array<std::uint8_t, 4>& key,
+            size_t keyOffset = 0);
+
+    private:
+        enum class Opcode : std::uint8_t
+        {
+            Continuation = 0x0,
+            Text = 0x1,
+            Binary = 0x2,
+            Close = 0x8,
+            Ping = 0x9,
+            Pong = 0xA
+        };
+
+        /// Write a frame header with a fresh masking key; returns the key.
+        std::array<std::uint8_t, 4> appendHeader(
+            Opcode opcode,
+            size_t payloadSize,
+            std::vector<std::uint8_t>& out,
+            bool isCompressed = false);
+
+        /// Check the server's Sec-WebSocket-Extensions answer against the offer; nullptr if acceptable.
+        const char* acceptExtensions(std::string_view value);
+
+        /// Pass the payload bytes of a data frame on, inflating them for a compressed message; false on error.
+        bool takeDataPayload(std::span<const std::uint8_t> data);
+
+        void appendControlFrame(Opcode opcode, std::span<const std::uint8_t> payload, std::vector<std::uint8_t>& out);
+
+        /// Header bytes needed for the frame being read, as far as the bytes collected so far tell.
+        [[nodiscard]] size_t getHeaderSize() const;
+
+        /// Validate the collected header and start its frame; false on a protocol error.
+        bool beginFrame();
+
+        /// Act on a frame whose payload has been read in full; false on close.
+        bool finishFrame();
+
+        /// Mark the codec closed and log why; returns false for the caller to pass on.
+        bool fail(const char* reason);
+
+        State m_state = State::Idle;
+        mqtt::WebSocketDeflateOptions m_deflateOptions;
+        size_t m_maxDecodedSize;
+        std::mt19937 m_random;
+        std::string m_expectedAccept; ///< Sec-WebSocket-Accept the server must send back.
+        std::string m_upgradeResponse; ///< Response head collected so far.
+
+        std::vector<std::uint8_t> m_frameBuffer; ///< Reused by encodeBinaryFrame().
+        std::vector<std::uint8_t> m_pendingControlFrames;
+        bool m_hasSentClose = false;
+
+        std::array<std::uint8_t, 14> m_header{}; ///< Header of the inbound frame, collected across reads.
+        size_t m_headerSize = 0;
+        bool m_isInFrame = false; ///< Set from a complete header until the end of its payload.
+        bool m_isInMessage = false; ///< Set while a fragmented data message waits for its final frame.
+        Opcode m_frameOpcode = Opcode::Continuation;
+        bool m_isFinalFrame = false;
+        std::uint64_t m_payloadRemaining = 0;
+        std::vector<std::uint8_t> m_controlPayload; ///< Payload of the inbound control frame being read.
+
+        bool m_isDeflateNegotiated = false;
+        bool m_isMessageCompressed = false; ///< RSV1 was set on the first frame of the inbound message.
+        std::vector<std::uint8_t> m_decodedPayload;
+#if REACTORMQ_WITH_ZLIB
+        std::unique_ptr<WebSocketDeflate> m_deflate;
+        std::vector<std::uint8_t> m_compressBuffer; ///< Reused for each outbound compressed packet.
+#endif // REACTORMQ_WITH_ZLIB
+    };
+} // namespace reactormq::socket
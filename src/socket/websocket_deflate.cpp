@@ -0,0 +1,175 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/websocket_deflate.h"
+
+#if REACTORMQ_WITH_ZLIB
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <array>
+
+namespace reactormq::socket
+{
+    namespace
+    {
+        /// RFC 7692 section 7.2.1: the empty stored block a sync flush ends with, left off the wire.
+        constexpr std::array<std::uint8_t, 4> kFlushTail{ 0x00, 0x00, 0xFF, 0xFF };
+
+        constexpr size_t kMinInflateChunk = 4096;
+    } // namespace
+
+    WebSocketDeflate::WebSocketDeflate(
+        const int clientWindowBits, const bool clientContextTakeover, const int serverWindowBits, const bool serverContextTakeover)
+        : m_clientContextTakeover(clientContextTakeover)
+        , m_serverContextTakeover(serverContextTakeover)
+    {
+        // Negative window bits select raw DEFLATE, without the zlib header and checksum.
+        if (deflateInit2(&m_deflater, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -clientWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "WebSocketDeflate deflateInit2 failed (windowBits=%d)", clientWindowBits);
+            return;
+        }
+        if (inflateInit2(&m_inflater, -serverWindowBits) != Z_OK)
+        {
+            REACTORMQ_LOG(logging::LogLevel::Error, "WebSocketDeflate inflateInit2 failed (windowBits=%d)", serverWindowBits);
+            deflateEnd(&m_deflater);
+            return;
+        }
+        m_isValid = true;
+    }
+
+    WebSocketDeflate::~WebSocketDeflate()
+    {
+        if (m_isValid)
+        {
+            deflateEnd(&m_deflater);
+            inflateEnd(&m_inflater);
+        }
+    }
+
+    bool WebSocketDeflate::compress(const std::span<const SendBuffer> payload, std::vector<std::uint8_t>& out)
+    {
+        size_t totalSize = 0;
+        for (const SendBuffer& buffer : payload)
+        {
+            totalSize += buffer.size;
+        }
+
+        // Room for the whole message in one go; the sync flush adds a few bytes past deflateBound() at most.
+        out.resize(deflateBound(&m_deflater, static_cast<uLong>(totalSize)) + 16);
+        size_t used = 0;
+
+        for (size_t i = 0; i <= payload.size(); ++i)
+        {
+            const bool isLast = i == payload.size();
+            m_deflater.next_in = isLast ? nullptr : const_cast<Bytef*>(payload[i].data);
+            m_deflater.avail_in = isLast ? 0 : static_cast<uInt>(payload[i].size);
+            const int flush = isLast ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+            do
+            {
+                if (used == out.size())
+                {
+                    out.resize(out.size() * 2);
+                }
+                m_deflater.next_out = out.data() + used;
+                m_deflater.avail_out = static_cast<uInt>(out.size() - used);
+                if (deflate(&m_deflater, flush) == Z_STREAM_ERROR)
+                {
+                    out.clear();
+                    return false;
+                }
+                used = out.size() - m_deflater.avail_out;
+            } while (m_deflater.avail_in > 0 || (isLast && m_deflater.avail_out == 0));
+        }
+
+        if (used >= kFlushTail.size()
+            && std::equal(kFlushTail.begin(), kFlushTail.end(), out.begin() + static_cast<std::ptrdiff_t>(used - kFlushTail.size())))
+        {
+            used -= kFlushTail.size();
+        }
+        out.resize(used);
+
+        if (!m_clientContextTakeover)
+        {
+            deflateReset(&m_deflater);
+        }
+        return true;
+    }
+
+    bool WebSocketDeflate::decompress(
+        const std::span<const std::uint8_t> data, const bool isEndOfMessage, std::vector<std::uint8_t>& out, const size_t maxSize)
+    {
+        if (!inflateInto(data, out, maxSize))
+        {
+            return false;
+        }
+        if (!isEndOfMessage)
+        {
+            return true;
+        }
+
+        if (!inflateInto(kFlushTail, out, maxSize))
+        {
+            return false;
+        }
+        if (!m_serverContextTakeover)
+        {
+            inflateReset(&m_inflater);
+        }
+        return true;
+    }
+
+    bool WebSocketDeflate::inflateInto(const std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, const size_t maxSize)
+    {
+        m_inflater.next_in = const_cast<Bytef*>(data.data());
+        m_inflater.avail_in = static_cast<uInt>(data.size());
+        size_t used = out.size();
+        while (true)
+        {
+            if (used == out.size())
+            {
+                if (used >= maxSize)
+                {
+                    REACTORMQ_LOG(logging::LogLevel::Error, "WebSocketDeflate inflated data exceeds the limit (max=%zu)", maxSize);
+                    return false;
+                }
+                out.resize(std::min(maxSize, used + std::max<size_t>(kMinInflateChunk, static_cast<size_t>(m_inflater.avail_in) * 4)));
+            }
+            m_inflater.next_out = out.data() + used;
+            m_inflater.avail_out = static_cast<uInt>(out.size() - used);
+
+            const int result = inflate(&m_inflater, Z_SYNC_FLUSH);
+            used = out.size() - m_inflater.avail_out;
+
+            // A sender may end a message with a final block; the next message then starts a new stream.
+            if (result == Z_STREAM_END)
+            {
+                inflateReset(&m_inflater);
+                if (m_inflater.avail_in == 0)
+                {
+                    break;
+                }
+                continue;
+            }
+            if (result != Z_OK && result != Z_BUF_ERROR)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "WebSocketDeflate inflate failed (result=%d)", result);
+                out.resize(used);
+                return false;
+            }
+            // With output room left over, zlib has nothing more for now.
+            if (m_inflater.avail_out != 0)
+            {
+                break;
+            }
+        }
+
+        out.resize(used);
+        return m_inflater.avail_in == 0;
+    }
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_WITH_ZLIB
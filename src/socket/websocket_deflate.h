@@ -0,0 +1,78 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#if REACTORMQ_WITH_ZLIB
+
+#include "socket/send_buffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <zlib.h>
+
+namespace reactormq::socket
+{
+    /**
+     * @brief The two raw DEFLATE streams of a permessage-deflate connection (RFC 7692 section 7).
+     *
+     * Messages are compressed with a sync flush and sent without the trailing empty block, which the receiving side
+     * puts back before inflating. Without context takeover a stream starts over at every message.
+     */
+    class WebSocketDeflate final
+    {
+    public:
+        /**
+         * @brief Set up both streams.
+         * @param clientWindowBits Window the client compresses with, 9..15.
+         * @param clientContextTakeover Keep the compression window across outbound messages.
+         * @param serverWindowBits Window the server compresses with, 9..15.
+         * @param serverContextTakeover Whether the server keeps its window across inbound messages.
+         */
+        WebSocketDeflate(int clientWindowBits, bool clientContextTakeover, int serverWindowBits, bool serverContextTakeover);
+
+        ~WebSocketDeflate();
+
+        WebSocketDeflate(const WebSocketDeflate&) = delete;
+        WebSocketDeflate& operator=(const WebSocketDeflate&) = delete;
+
+        /// @brief Whether zlib accepted both streams.
+        [[nodiscard]] bool isValid() const
+        {
+            return m_isValid;
+        }
+
+        /**
+         * @brief Compress one outbound message.
+         * @param payload Regions of the message, in order.
+         * @param out Cleared, then receives the compressed message.
+         * @return False if zlib failed.
+         */
+        bool compress(std::span<const SendBuffer> payload, std::vector<std::uint8_t>& out);
+
+        /**
+         * @brief Inflate part of an inbound compressed message.
+         * @param data Compressed bytes, as found in the frame.
+         * @param isEndOfMessage The message ends with these bytes.
+         * @param out Buffer the plain bytes are appended to.
+         * @param maxSize Size out may not grow past.
+         * @return False on corrupt data or past maxSize.
+         */
+        bool decompress(std::span<const std::uint8_t> data, bool isEndOfMessage, std::vector<std::uint8_t>& out, size_t maxSize);
+
+    private:
+        bool inflateInto(std::span<const std::uint8_t> data, std::vector<std::uint8_t>& out, size_t maxSize);
+
+        z_stream m_deflater{};
+        z_stream m_inflater{};
+        bool m_clientContextTakeover;
+        bool m_serverContextTakeover;
+        bool m_isValid = false;
+    };
+} // namespace reactormq::socket
+
+#endif // REACTORMQ_WITH_ZLIB
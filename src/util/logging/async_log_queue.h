@@ -0,0 +1,252 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "util/logging/log_level.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace reactormq::logging
+{
+    /**
+     * @brief Compact log event as it sits in the async queue.
+     * Function and file names point at the static strings of the call's source_location, so they are not copied;
+     * text up to kInlineTextSize bytes is copied into the slot, longer text is kept on the heap. A deferred record
+     * holds the format string and its raw arguments instead, and is formatted by whoever reads it.
+     */
+    struct LogRecord
+    {
+        static constexpr size_t kInlineTextSize = 256;
+        static constexpr size_t kDeferredArgsSize = 64;
+
+        /// Formats a deferred record's arguments, stored at @p args, into @p out.
+        using DeferredFormatter = void (*)(const char* format, const std::byte* args, std::string& out);
+
+        std::chrono::system_clock::time_point timestamp;
+        std::thread::id threadId;
+        LogLevel level = LogLevel::Info;
+        const char* function = "";
+        const char* file = "";
+        std::uint_least32_t line = 0;
+
+        void setText(const std::string_view text)
+        {
+            m_formatter = nullptr;
+            if (text.size() <= kInlineTextSize)
+            {
+                std::memcpy(m_inlineText.data(), text.data(), text.size());
+                m_inlineSize = text.size();
+                m_heapText.clear();
+                m_isHeap = false;
+                return;
+            }
+
+            m_heapText.assign(text);
+            m_isHeap = true;
+        }
+
+        /**
+         * @brief Keep the format string and the arguments written to getDeferredArgs() instead of formatted text.
+         * @param format Format string; must outlive the record, as a string literal does.
+         * @param formatter Knows the types of the stored arguments.
+         */
+        void setDeferred(const char* format, const DeferredFormatter formatter)
+        {
+            m_format = format;
+            m_formatter = formatter;
+        }
+
+        /// @brief Storage for a deferred record's arguments.
+        [[nodiscard]] std::byte* getDeferredArgs()
+        {
+            return m_deferredArgs.data();
+        }
+
+        /// @brief Whether the record still has to be formatted.
+        [[nodiscard]] bool isDeferred() const
+        {
+            return m_formatter != nullptr;
+        }
+
+        /// @brief Text of a record that is not deferred.
+        [[nodiscard]] std::string_view getText() const
+        {
+            return m_isHeap ? std::string_view{ m_heapText } : std::string_view{ m_inlineText.data(), m_inlineSize };
+        }
+
+        /// @brief Write the record's text, formatting it first if it is deferred.
+        void formatTextTo(std::string& out) const
+        {
+            if (m_formatter != nullptr)
+            {
+                m_formatter(m_format, m_deferredArgs.data(), out);
+                return;
+            }
+
+            out.assign(getText());
+        }
+
+    private:
+        alignas(std::max_align_t) std::array<std::byte, kDeferredArgsSize> m_deferredArgs{};
+        const char* m_format = nullptr;
+        DeferredFormatter m_formatter = nullptr;
+        std::array<char, kInlineTextSize> m_inlineText{};
+        size_t m_inlineSize = 0;
+        bool m_isHeap = false;
+        std::string m_heapText;
+    };
+
+    /**
+     * @brief Bounded lock-free multi-producer single-consumer ring of log records (Vyukov bounded queue).
+     *
+     * tryPush() may be called from any thread; it claims a slot with one compare-exchange and copies the record into
+     * it, so logging never allocates for short messages and never blocks. When the ring is full the record is
+     * rejected rather than waited for, so a stalled sink cannot stall the caller. drain() must only be called from
+     * the single consumer thread.
+     */
+    class AsyncLogQueue final
+    {
+    public:
+        /// @param capacity Number of slots; rounded up to a power of two, at least 2.
+        explicit AsyncLogQueue(const size_t capacity)
+            : m_mask(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity) - 1)
+            , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+        {
+            for (size_t i = 0; i <= m_mask; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        AsyncLogQueue(const AsyncLogQueue&) = delete;
+
+        AsyncLogQueue& operator=(const AsyncLogQueue&) = delete;
+
+        /**
+         * @brief Copy a log event into the ring. Thread-safe for any number of producers.
+         * @return False if the ring is full and the event was dropped.
+         */
+        bool tryPush(const LogLevel level, const std::source_location& location, const std::string_view text)
+        {
+            return tryPush(
+                level,
+                location,
+                [text](LogRecord& record)
+                {
+                    record.setText(text);
+                });
+        }
+
+        /**
+         * @brief Claim a slot and let @p fill write the record's text or deferred arguments into it.
+         * Thread-safe for any number of producers.
+         * @param fill Called as `fill(LogRecord&)` before the record is published to the consumer.
+         * @return False if the ring is full and the event was dropped.
+         */
+        template<typename Fill>
+            requires std::invocable<Fill&, LogRecord&>
+        bool tryPush(const LogLevel level, const std::source_location& location, Fill&& fill)
+        {
+            size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;)
+            {
+                slot = &m_slots[position & m_mask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto distance = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                if (distance == 0)
+                {
+                    if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (distance < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            LogRecord& record = slot->record;
+            record.timestamp = std::chrono::system_clock::now();
+            record.threadId = std::this_thread::get_id();
+            record.level = level;
+            record.function = location.function_name();
+            record.file = location.file_name();
+            record.line = location.line();
+            fill(record);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Hand queued records, oldest first, to a consumer. Consumer thread only.
+         * A record is only valid for the duration of the call it is passed to.
+         * @param consume Called with each record as `consume(const LogRecord&)`.
+         * @param maxRecords Most records consumed by this call.
+         * @return Number of records consumed.
+         */
+        template<typename Consume>
+        size_t drain(Consume&& consume, const size_t maxRecords)
+        {
+            size_t consumed = 0;
+            while (consumed < maxRecords)
+            {
+                Slot& slot = m_slots[m_dequeuePosition & m_mask];
+                if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+                {
+                    break; // empty, or a producer is still copying its record in
+                }
+
+                consume(static_cast<const LogRecord&>(slot.record));
+                slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+                ++m_dequeuePosition;
+                ++consumed;
+            }
+
+            return consumed;
+        }
+
+        /// @brief Whether a record is ready for the consumer. Consumer thread only.
+        [[nodiscard]] bool hasReadyRecord() const
+        {
+            return m_slots[m_dequeuePosition & m_mask].sequence.load(std::memory_order_acquire) == m_dequeuePosition + 1;
+        }
+
+        /// @brief Number of slots.
+        [[nodiscard]] size_t getCapacity() const
+        {
+            return m_mask + 1;
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence{ 0 };
+            LogRecord record;
+        };
+
+        const size_t m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+        alignas(64) std::atomic<size_t> m_enqueuePosition{ 0 };
+        alignas(64) size_t m_dequeuePosition = 0; ///< Consumer-owned.
+    };
+} // namespace reactormq::logging
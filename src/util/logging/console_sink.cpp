@@ -6,8 +6,10 @@
 #if REACTORMQ_WITH_CONSOLE_SINK
 #include "util/logging/log_message.h"
 
-#include <iostream>
-#include <sstream>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <string_view>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -15,11 +17,36 @@
 
 namespace reactormq::logging
 {
-    static std::string basename(const std::string& path)
+    namespace
     {
-        const size_t pos = path.find_last_of("/\\");
-        return pos == std::string::npos ? path : path.substr(pos + 1);
-    }
+        constexpr std::string_view kColorReset = "\x1b[0m";
+
+        /// Lines are built here; a buffer grown past this by one long message is given back afterwards.
+        constexpr size_t kRetainedLineCapacity = 16 * 1024;
+
+        std::string_view basename(const std::string_view path)
+        {
+            const size_t pos = path.find_last_of("/\\");
+            return pos == std::string_view::npos ? path : path.substr(pos + 1);
+        }
+
+        std::string& lineBuffer()
+        {
+            thread_local std::string buffer;
+            buffer.clear();
+            return buffer;
+        }
+
+        /// One fwrite per line, so lines from several sinks or processes sharing the console do not interleave.
+        void writeLine(std::FILE* stream, std::string& line)
+        {
+            (void)std::fwrite(line.data(), 1, line.size(), stream);
+            if (line.capacity() > kRetainedLineCapacity)
+            {
+                std::string().swap(line);
+            }
+        }
+    } // namespace
 
     ConsoleSink::ConsoleSink(const bool enable_colors)
         : colors_(enable_colors)
@@ -66,18 +93,27 @@ namespace reactormq::logging
         return "";
     }
 
-    const char* ConsoleSink::streamFor(const LogLevel lvl)
+    std::FILE* ConsoleSink::streamFor(const LogLevel lvl)
     {
-        return lvl >= LogLevel::Warn ? "err" : "out";
+        return lvl >= LogLevel::Warn ? stderr : stdout;
     }
 
-    std::string ConsoleSink::formatPrefix(const LogMessage& msg)
+    void ConsoleSink::appendLocation(std::string& out, const LogMessage& msg)
     {
-        std::ostringstream oss;
-
-        oss << toIso8601ms(msg.timestamp) << " | " << threadIdStr(msg.thread_id) << " | " << levelToString(msg.level) << " | "
-            << msg.function << " | " << basename(msg.file) << ':' << msg.line << " | ";
-        return oss.str();
+        out += " | ";
+        appendThreadId(out, msg.thread_id);
+        out += " | ";
+        out += levelToString(msg.level);
+        out += " | ";
+        out += msg.function;
+        out += " | ";
+        out += basename(msg.file);
+        out += ':';
+        std::array<char, 16> digits{};
+        const auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), msg.line);
+        (void)ec;
+        out.append(digits.data(), end);
+        out += " | ";
     }
 
     void ConsoleSink::ensureVtEnabledOnce()
@@ -160,33 +196,20 @@ namespace reactormq::logging
 
     void ConsoleSink::writeMessage(const LogMessage& msg) const
     {
-        const auto prefix = formatPrefix(msg);
-        const bool use_err = streamFor(msg.level) == std::string("err");
-
+        std::string& line = lineBuffer();
         if (colors_)
         {
-            const char* color = colorFor(msg.level);
-            const auto reset = "\x1b[0m";
-            if (use_err)
-            {
-                std::cerr << color << prefix << msg.text << reset << '\n';
-            }
-            else
-            {
-                std::cout << color << prefix << msg.text << reset << '\n';
-            }
+            line += colorFor(msg.level);
         }
-        else
+        appendIso8601ms(line, msg.timestamp);
+        appendLocation(line, msg);
+        line += msg.text;
+        if (colors_)
         {
-            if (use_err)
-            {
-                std::cerr << prefix << msg.text << '\n';
-            }
-            else
-            {
-                std::cout << prefix << msg.text << '\n';
-            }
+            line += kColorReset;
         }
+        line += '\n';
+        writeLine(streamFor(msg.level), line);
     }
 
     void ConsoleSink::writeDuplicateSummary(
@@ -195,41 +218,28 @@ namespace reactormq::logging
         const std::chrono::system_clock::time_point& firstTime,
         const std::chrono::system_clock::time_point& lastTime) const
     {
-        const auto firstTs = toIso8601ms(firstTime);
-        const auto lastTs = toIso8601ms(lastTime);
-        const auto tid = threadIdStr(msg.thread_id);
-        const bool use_err = streamFor(msg.level) == std::string("err");
-
-        std::ostringstream oss;
-        oss << firstTs << " to " << lastTs << " | " << tid << " | " << levelToString(msg.level) << " | " << msg.function << " | "
-            << basename(msg.file) << ':' << msg.line << " | " << msg.text << " (repeated " << count << " times)";
-
-        const std::string output = oss.str();
-
+        std::string& line = lineBuffer();
         if (colors_)
         {
-            const char* color = colorFor(msg.level);
-            const auto reset = "\x1b[0m";
-            if (use_err)
-            {
-                std::cerr << color << output << reset << '\n';
-            }
-            else
-            {
-                std::cout << color << output << reset << '\n';
-            }
-        }
-        else
+            line += colorFor(msg.level);
+        }
+        appendIso8601ms(line, firstTime);
+        line += " to ";
+        appendIso8601ms(line, lastTime);
+        appendLocation(line, msg);
+        line += msg.text;
+        line += " (repeated ";
+        std::array<char, 24> digits{};
+        const auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), count);
+        (void)ec;
+        line.append(digits.data(), end);
+        line += " times)";
+        if (colors_)
         {
-            if (use_err)
-            {
-                std::cerr << output << '\n';
-            }
-            else
-            {
-                std::cout << output << '\n';
-            }
+            line += kColorReset;
         }
+        line += '\n';
+        writeLine(streamFor(msg.level), line);
     }
 
     bool ConsoleSink::isDuplicate(const LogMessage& msg, const LastMessageInfo& last)
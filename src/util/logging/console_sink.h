@@ -10,6 +10,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -106,15 +107,15 @@ namespace reactormq::logging
         std::chrono::system_clock::time_point m_lastTimestamp;
 
         /**
-         * @brief Format the non-message prefix for a log line.
+         * @brief Append the part of a log line between the timestamp and the message text.
          *
-         * The prefix typically contains timestamp, log level, thread id and
-         * source location information.
+         * That is the thread id, log level and source location, each preceded by a separator, and the separator
+         * before the text.
          *
-         * @param msg The message to format prefix for.
-         * @return Formatted prefix string.
+         * @param out Line being built.
+         * @param msg The message to format.
          */
-        static std::string formatPrefix(const LogMessage& msg);
+        static void appendLocation(std::string& out, const LogMessage& msg);
 
         /**
          * @brief Map a log level to its ANSI color escape sequence.
@@ -134,9 +135,9 @@ namespace reactormq::logging
          * errors go to stderr.
          *
          * @param lvl The log level.
-         * @return "out" if the message should go to stdout, "err" for stderr.
+         * @return stderr for warnings and above, stdout otherwise.
          */
-        static const char* streamFor(LogLevel lvl);
+        static std::FILE* streamFor(LogLevel lvl);
 
         /**
          * @brief Ensure Windows VT processing is enabled once for colored output.
@@ -155,6 +156,8 @@ namespace reactormq::logging
         /**
          * @brief Write a single log message to output.
          *
+         * The line is built in a buffer reused by the calling thread and written with a single fwrite.
+         *
          * @param msg The message to write.
          */
         void writeMessage(const LogMessage& msg) const;
@@ -11,6 +11,8 @@
 #include "util/logging/log_message.h"
 
 #include <chrono>
+#include <cstdio>
+#include <format>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -18,8 +20,27 @@
 namespace reactormq::logging
 {
     FileSink::FileSink(const std::string& path)
+        : FileSink(path, FileSinkOptions{})
+    {
+    }
+
+    FileSink::FileSink(const std::string& path, const FileSinkOptions& options)
+        : m_path(path)
+        , m_options(options)
+        , m_lastFlush(std::chrono::steady_clock::now())
     {
         out_.open(path, std::ios::out | std::ios::app);
+        if (out_.is_open())
+        {
+            out_.seekp(0, std::ios::end);
+            const std::streamoff size = out_.tellp();
+            m_fileBytes = size > 0 ? static_cast<size_t>(size) : 0;
+        }
+
+        if (m_options.isBuffered)
+        {
+            m_buffer.reserve(m_options.bufferBytes);
+        }
     }
 
     FileSink::~FileSink()
@@ -33,7 +54,7 @@ namespace reactormq::logging
             flushPendingDuplicate();
             if (out_.is_open())
             {
-                out_.flush();
+                flushBuffer();
                 out_.close();
             }
         }
@@ -53,6 +74,117 @@ namespace reactormq::logging
             return;
         }
 
+        append(msg);
+        flushIfDue();
+    }
+
+    void FileSink::logBatch(const std::span<const LogMessage> msgs)
+    {
+        std::scoped_lock lock(mtx_);
+        if (!out_.is_open())
+        {
+            return;
+        }
+
+        for (const LogMessage& msg : msgs)
+        {
+            append(msg);
+        }
+        flushIfDue();
+    }
+
+    void FileSink::flush()
+    {
+        std::scoped_lock lock(mtx_);
+        if (out_.is_open())
+        {
+            flushBuffer();
+        }
+    }
+
+    void FileSink::writeLine(const std::string_view line, const LogLevel level)
+    {
+        if (m_options.isBuffered && !m_buffer.empty() && m_buffer.size() + line.size() > m_options.bufferBytes)
+        {
+            flushBuffer();
+        }
+
+        m_buffer.append(line);
+        if (static_cast<int>(level) > static_cast<int>(m_bufferedLevel))
+        {
+            m_bufferedLevel = level;
+        }
+    }
+
+    void FileSink::flushIfDue()
+    {
+        if (m_buffer.empty())
+        {
+            return;
+        }
+
+        const bool isDue = !m_options.isBuffered || m_buffer.size() >= m_options.bufferBytes
+                           || static_cast<int>(m_bufferedLevel) >= static_cast<int>(m_options.flushLevel)
+                           || std::chrono::steady_clock::now() - m_lastFlush >= m_options.flushInterval;
+        if (isDue)
+        {
+            flushBuffer();
+        }
+    }
+
+    void FileSink::flushBuffer()
+    {
+        m_lastFlush = std::chrono::steady_clock::now();
+        if (m_buffer.empty())
+        {
+            return;
+        }
+
+        if (m_options.maxFileBytes != 0 && m_fileBytes != 0 && m_fileBytes + m_buffer.size() > m_options.maxFileBytes)
+        {
+            rotate();
+            if (!out_.is_open())
+            {
+                m_buffer.clear();
+                return;
+            }
+        }
+
+        out_.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        out_.flush();
+        m_fileBytes += m_buffer.size();
+        m_buffer.clear();
+        m_bufferedLevel = LogLevel::Trace;
+    }
+
+    void FileSink::rotate()
+    {
+        out_.close();
+        if (m_options.maxRotatedFiles == 0)
+        {
+            (void)std::remove(m_path.c_str());
+        }
+        else
+        {
+            for (size_t index = m_options.maxRotatedFiles; index > 1; --index)
+            {
+                const std::string from = m_path + '.' + std::to_string(index - 1);
+                const std::string to = m_path + '.' + std::to_string(index);
+                (void)std::remove(to.c_str());
+                (void)std::rename(from.c_str(), to.c_str());
+            }
+
+            const std::string newest = m_path + ".1";
+            (void)std::remove(newest.c_str());
+            (void)std::rename(m_path.c_str(), newest.c_str());
+        }
+
+        out_.open(m_path, std::ios::out | std::ios::trunc);
+        m_fileBytes = 0;
+    }
+
+    void FileSink::append(const LogMessage& msg)
+    {
         if (m_lastMessage.has_value() && isDuplicate(msg, *m_lastMessage))
         {
             ++m_duplicateCount;
@@ -103,9 +235,9 @@ namespace reactormq::logging
         const auto ts = toIso8601ms(msg.timestamp);
         const auto tid = threadIdStr(msg.thread_id);
 
-        out_ << ts << " | " << tid << " | " << levelToString(msg.level) << " | " << msg.function << " | " << msg.file << ':' << msg.line
-             << " | " << msg.text << '\n';
-        out_.flush();
+        writeLine(
+            std::format("{} | {} | {} | {} | {}:{} | {}\n", ts, tid, levelToString(msg.level), msg.function, msg.file, msg.line, msg.text),
+            msg.level);
     }
 
     void FileSink::writeDuplicateSummary(
@@ -118,9 +250,19 @@ namespace reactormq::logging
         const auto lastTs = toIso8601ms(lastTime);
         const auto tid = threadIdStr(msg.thread_id);
 
-        out_ << firstTs << " to " << lastTs << " | " << tid << " | " << levelToString(msg.level) << " | " << msg.function << " | "
-             << msg.file << ':' << msg.line << " | " << msg.text << " (repeated " << count << " times)\n";
-        out_.flush();
+        writeLine(
+            std::format(
+                "{} to {} | {} | {} | {} | {}:{} | {} (repeated {} times)\n",
+                firstTs,
+                lastTs,
+                tid,
+                levelToString(msg.level),
+                msg.function,
+                msg.file,
+                msg.line,
+                msg.text,
+                count),
+            msg.level);
     }
 
     bool FileSink::isDuplicate(const LogMessage& msg, const LastMessageInfo& last)
@@ -13,10 +13,37 @@
 #include <fstream>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace reactormq::logging
 {
+    /**
+     * @brief How a FileSink buffers and rotates its output.
+     * The defaults write and flush every line, as an unbuffered sink always has.
+     */
+    struct FileSinkOptions
+    {
+        /// Collect lines in memory and write them in large chunks instead of flushing each one.
+        bool isBuffered = false;
+
+        /// Buffered lines that trigger a write once reached.
+        size_t bufferBytes = 64 * 1024;
+
+        /// Longest a buffered line waits, checked whenever a message is logged.
+        std::chrono::milliseconds flushInterval{ 1000 };
+
+        /// Lines at or above this level are written at once, so they survive a crash.
+        LogLevel flushLevel = LogLevel::Error;
+
+        /// Rotate before a write would take the file past this many bytes; 0 disables rotation.
+        size_t maxFileBytes = 0;
+
+        /// Rotated files kept as path.1 (newest) to path.N; 0 truncates the file instead.
+        size_t maxRotatedFiles = 3;
+    };
+
     /**
      * @brief Sink that writes log messages to a file.
      * The file is opened in append mode and all messages are written in a
@@ -35,6 +62,14 @@ namespace reactormq::logging
          */
         explicit FileSink(const std::string& path = "reactormq.log");
 
+        /**
+         * @brief Construct a FileSink with explicit buffering and rotation.
+         *
+         * @param path Path to the log file.
+         * @param options Buffering and rotation settings.
+         */
+        FileSink(const std::string& path, const FileSinkOptions& options);
+
         /**
          * @brief Destructor.
          *
@@ -49,12 +84,54 @@ namespace reactormq::logging
          */
         void log(const LogMessage& msg) override;
 
+        /**
+         * @brief Write a batch of log messages to the file, flushing once.
+         *
+         * @param msgs The log messages to be written.
+         */
+        void logBatch(std::span<const LogMessage> msgs) override;
+
+        /**
+         * @brief Write any buffered lines to the file now.
+         */
+        void flush();
+
     private:
         /**
          * @brief Output file stream used to write log data.
          */
         std::ofstream out_;
 
+        /**
+         * @brief Path of the current log file, kept for rotation.
+         */
+        std::string m_path;
+
+        /**
+         * @brief Buffering and rotation settings.
+         */
+        FileSinkOptions m_options;
+
+        /**
+         * @brief Lines not yet written to the file.
+         */
+        std::string m_buffer;
+
+        /**
+         * @brief Highest level among the buffered lines.
+         */
+        LogLevel m_bufferedLevel = LogLevel::Trace;
+
+        /**
+         * @brief Bytes in the current log file.
+         */
+        size_t m_fileBytes = 0;
+
+        /**
+         * @brief When the buffer was last written out.
+         */
+        std::chrono::steady_clock::time_point m_lastFlush;
+
         /**
          * @brief Mutex protecting concurrent file write operations.
          */
@@ -98,6 +175,36 @@ namespace reactormq::logging
          */
         void flushPendingDuplicate();
 
+        /**
+         * @brief Record a message for output without flushing the stream.
+         *
+         * @param msg The message to record.
+         */
+        void append(const LogMessage& msg);
+
+        /**
+         * @brief Add a formatted line to the buffer, writing it out first if the buffer is full.
+         *
+         * @param line The line, including its newline.
+         * @param level Level of the message the line belongs to.
+         */
+        void writeLine(std::string_view line, LogLevel level);
+
+        /**
+         * @brief Write the buffer out if unbuffered, or if its size, age or level calls for it.
+         */
+        void flushIfDue();
+
+        /**
+         * @brief Write the buffer to the file and flush the stream, rotating first if needed.
+         */
+        void flushBuffer();
+
+        /**
+         * @brief Shift path.1..path.N-1 up by one, move the current file to path.1 and reopen it empty.
+         */
+        void rotate();
+
         /**
          * @brief Write a single log message to output.
          *
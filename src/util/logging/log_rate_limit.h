@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace reactormq::logging
+{
+    /**
+     * @brief Token bucket for one log call site: up to @c perSecond messages in a burst, refilled at @c perSecond a
+     * second.
+     *
+     * Kept as a single atomic "theoretical arrival time" (the GCRA form of a token bucket), so admitting a message
+     * costs one clock read and one compare-exchange and needs no lock. REACTORMQ_LOG_RATELIMITED holds one of these
+     * as a function-local static per call site, so there is no registry or map lookup.
+     */
+    class LogRateLimit final
+    {
+    public:
+        /// @brief Outcome of tryAcquire().
+        struct Admission
+        {
+            bool isAllowed = false; ///< Whether this message may be logged.
+            std::uint32_t suppressed = 0; ///< Messages dropped since the last allowed one; only set when allowed.
+        };
+
+        /// @param perSecond Messages allowed per second, and the burst size; 0 is treated as 1.
+        explicit LogRateLimit(const std::uint32_t perSecond)
+            : m_interval(std::chrono::nanoseconds(std::chrono::seconds(1)).count() / (perSecond == 0 ? 1 : perSecond))
+            , m_burst(m_interval * static_cast<std::int64_t>(perSecond == 0 ? 1 : perSecond))
+        {
+        }
+
+        /// @brief Take a token if one is available, or count the message as suppressed.
+        [[nodiscard]] Admission tryAcquire()
+        {
+            const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count();
+            std::int64_t arrival = m_arrival.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const std::int64_t base = arrival > now ? arrival : now;
+                if (base + m_interval - now > m_burst)
+                {
+                    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                    return {};
+                }
+
+                if (m_arrival.compare_exchange_weak(arrival, base + m_interval, std::memory_order_relaxed))
+                {
+                    return { true, m_suppressed.exchange(0, std::memory_order_relaxed) };
+                }
+            }
+        }
+
+    private:
+        const std::int64_t m_interval; ///< Nanoseconds one token is worth.
+        const std::int64_t m_burst; ///< Furthest the arrival time may run ahead of now.
+        std::atomic<std::int64_t> m_arrival{ 0 };
+        std::atomic<std::uint32_t> m_suppressed{ 0 };
+    };
+} // namespace reactormq::logging
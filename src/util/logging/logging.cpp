@@ -4,29 +4,85 @@
 
 #include "util/logging/logging.h"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 namespace reactormq::logging
 {
-    std::string toIso8601ms(const std::chrono::system_clock::time_point& tp)
+    namespace
     {
-        using namespace std::chrono;
-        auto t_c = system_clock::to_time_t(tp);
-        std::tm tm_buf{};
+        /// Calendar part of the last second this thread formatted, and the full text of its last millisecond.
+        struct TimestampCache
+        {
+            std::int64_t second = std::numeric_limits<std::int64_t>::min();
+            std::int64_t millisecond = std::numeric_limits<std::int64_t>::min();
+            std::array<char, 32> text{};
+            size_t size = 0; ///< Length of text, milliseconds included.
+        };
+
+        /// The last few thread ids this thread rendered, replaced round-robin.
+        struct ThreadIdCache
+        {
+            static constexpr size_t kEntries = 8;
+            std::array<std::jthread::id, kEntries> ids{};
+            std::array<std::string, kEntries> texts{};
+            size_t size = 0;
+            size_t next = 0;
+        };
+
+        thread_local TimestampCache t_timestamp;
+        thread_local ThreadIdCache t_threadIds;
+
+        std::tm toLocalTime(const std::time_t time)
+        {
+            std::tm tm_buf{};
 #ifdef _WIN32
-        (void)localtime_s(&tm_buf, &t_c);
+            (void)localtime_s(&tm_buf, &time);
 #elif REACTORMQ_PLATFORM_PROSPERO
-        (void)localtime_s(&t_c, &tm_buf);
+            (void)localtime_s(&time, &tm_buf);
 #else
-        (void)localtime_r(&t_c, &tm_buf);
+            (void)localtime_r(&time, &tm_buf);
 #endif // _WIN32
-        const auto ms = duration_cast<milliseconds>(tp.time_since_epoch()) % 1000;
+            return tm_buf;
+        }
+    } // namespace
 
-        std::ostringstream oss;
-        oss << std::put_time(&tm_buf, "%Y-%m-%dT%H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << ms.count();
-        return oss.str();
+    void appendIso8601ms(std::string& out, const std::chrono::system_clock::time_point& tp)
+    {
+        using namespace std::chrono;
+        TimestampCache& cache = t_timestamp;
+        const std::int64_t millisecond = duration_cast<milliseconds>(tp.time_since_epoch()).count();
+        if (millisecond != cache.millisecond)
+        {
+            const std::int64_t second = floor<seconds>(tp).time_since_epoch().count();
+            if (second != cache.second)
+            {
+                const std::tm tm_buf = toLocalTime(static_cast<std::time_t>(second));
+                const size_t length = std::strftime(cache.text.data(), cache.text.size() - 4, "%Y-%m-%dT%H:%M:%S", &tm_buf);
+                cache.text[length] = '.';
+                cache.size = length + 4;
+                cache.second = second;
+            }
+
+            const auto fraction = static_cast<int>(millisecond - second * 1000);
+            cache.text[cache.size - 3] = static_cast<char>('0' + fraction / 100);
+            cache.text[cache.size - 2] = static_cast<char>('0' + fraction / 10 % 10);
+            cache.text[cache.size - 1] = static_cast<char>('0' + fraction % 10);
+            cache.millisecond = millisecond;
+        }
+        out.append(cache.text.data(), cache.size);
+    }
+
+    std::string toIso8601ms(const std::chrono::system_clock::time_point& tp)
+    {
+        std::string out;
+        appendIso8601ms(out, tp);
+        return out;
     }
 
     std::string threadIdStr(const std::thread::id& id)
@@ -36,6 +92,26 @@ namespace reactormq::logging
         return oss.str();
     }
 
+    void appendThreadId(std::string& out, const std::jthread::id& id)
+    {
+        ThreadIdCache& cache = t_threadIds;
+        for (size_t i = 0; i < cache.size; ++i)
+        {
+            if (cache.ids[i] == id)
+            {
+                out += cache.texts[i];
+                return;
+            }
+        }
+
+        const size_t slot = cache.next;
+        cache.next = (cache.next + 1) % ThreadIdCache::kEntries;
+        cache.size = std::max(cache.size, slot + 1);
+        cache.ids[slot] = id;
+        cache.texts[slot] = threadIdStr(id);
+        out += cache.texts[slot];
+    }
+
     std::string toHex(const std::span<const std::uint8_t> data)
     {
         std::ostringstream oss;
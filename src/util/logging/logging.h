@@ -7,6 +7,8 @@
 // Inspired by Roku's rostd::printx approach (traits-based argument forwarding for printf-family calls).
 
 #include "log_level.h"
+#include "util/logging/async_log_queue.h"
+#include "util/logging/log_rate_limit.h"
 #include "util/logging/registry.h"
 
 #include <array>
@@ -14,6 +16,7 @@
 #include <concepts>
 #include <cstdio>
 #include <cstring>
+#include <new>
 #include <source_location>
 #include <span>
 #include <string>
@@ -27,6 +30,17 @@ namespace reactormq::logging
 {
     std::string toIso8601ms(const std::chrono::system_clock::time_point& tp);
     std::string threadIdStr(const std::jthread::id& id);
+
+    /**
+     * @brief Append the toIso8601ms() text of @p tp to @p out without allocating beyond @p out.
+     * Each thread keeps the text of the last millisecond it formatted and the calendar part of the last second, so
+     * lines logged close together skip both localtime and strftime.
+     */
+    void appendIso8601ms(std::string& out, const std::chrono::system_clock::time_point& tp);
+
+    /// @brief Append threadIdStr(@p id) to @p out, from a small per-thread cache of the ids most recently rendered.
+    void appendThreadId(std::string& out, const std::jthread::id& id);
+
     std::string toHex(std::span<const std::uint8_t> data);
     const char* levelToString(LogLevel lvl);
 
@@ -131,7 +145,8 @@ namespace reactormq::logging
         {
             static auto forwardArgs(const T& value)
             {
-                return std::forward_as_tuple(value.c_str());
+                // By value: a reference to the temporary pointer would dangle once this returns.
+                return std::make_tuple(value.c_str());
             }
         };
 
@@ -260,6 +275,16 @@ namespace reactormq::logging
                 return formatSnprintfWithTuple(m_fmt, argsTuple);
             }
 
+            [[nodiscard]] const char* getFormat() const noexcept
+            {
+                return m_fmt;
+            }
+
+            [[nodiscard]] const std::tuple<Args...>& getArgs() const noexcept
+            {
+                return m_args;
+            }
+
         private:
             const char* m_fmt = nullptr;
             std::tuple<Args...> m_args;
@@ -287,6 +312,11 @@ namespace reactormq::logging
                 return m_fmt ? std::string{ m_fmt } : std::string{};
             }
 
+            [[nodiscard]] const char* getFormat() const noexcept
+            {
+                return m_fmt;
+            }
+
         private:
             const char* m_fmt = nullptr;
         };
@@ -333,6 +363,43 @@ namespace reactormq::logging
             bool m_isHeap = false;
             std::string m_heap{};
         };
+
+        /**
+         * @brief Argument types an async record can carry by value and format later with the same result: numbers,
+         * enums and non-string pointers (printed with %p). Strings are formatted on the calling thread instead,
+         * since the caller's buffer may be gone by the time the record is read.
+         */
+        template<class T>
+        concept DeferrableArg = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                                (std::is_pointer_v<T> && !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>);
+
+        template<class... Args>
+        inline constexpr bool kIsDeferrable = (DeferrableArg<RemoveCvRef<Args>> && ...) &&
+                                              sizeof(std::tuple<RemoveCvRef<Args>...>) <= LogRecord::kDeferredArgsSize &&
+                                              alignof(std::tuple<RemoveCvRef<Args>...>) <= alignof(std::max_align_t);
+
+        /**
+         * @brief LogRecord::DeferredFormatter for arguments stored as a std::tuple<Ts...>.
+         * Matches LazyFormat: a call without arguments prints its format string as is.
+         */
+        template<class... Ts>
+        void formatDeferred(const char* formatCstr, const std::byte* args, std::string& out)
+        {
+            if (formatCstr == nullptr)
+            {
+                out = "[log format error]";
+                return;
+            }
+
+            if constexpr (sizeof...(Ts) == 0)
+            {
+                out.assign(formatCstr);
+            }
+            else
+            {
+                out = formatSnprintfWithTuple(formatCstr, *std::launder(reinterpret_cast<const std::tuple<Ts...>*>(args)));
+            }
+        }
     } // namespace detail
 
     template<class... Args>
@@ -376,6 +443,27 @@ namespace reactormq::logging
     template<class... Args>
     void Registry::log(const LogLevel level, const std::source_location& location, const detail::LazyFormat<Args...>& lazyMsg) const
     {
+        if constexpr (detail::kIsDeferrable<Args...>)
+        {
+            // Async mode with plain-value arguments: store them raw and let the background thread format.
+            if (AsyncLogQueue* queue = m_asyncQueue.load(std::memory_order_acquire))
+            {
+                const bool isQueued = queue->tryPush(
+                    level,
+                    location,
+                    [&lazyMsg](LogRecord& record)
+                    {
+                        if constexpr (sizeof...(Args) > 0)
+                        {
+                            ::new (record.getDeferredArgs()) std::tuple<detail::RemoveCvRef<Args>...>(lazyMsg.getArgs());
+                        }
+                        record.setDeferred(lazyMsg.getFormat(), &detail::formatDeferred<detail::RemoveCvRef<Args>...>);
+                    });
+                onAsyncPush(isQueued);
+                return;
+            }
+        }
+
         detail::SmallLogString owned;
 
         const detail::FormatView r = lazyMsg.tryFormatTo(owned.inlineBuffer());
@@ -406,25 +494,63 @@ namespace reactormq::logging
         log(level, location, "[log format error]");
     }
 
+// Lowest LogLevel whose calls are compiled in, as its enumerator value; the build sets it from REACTORMQ_LOG_MIN_LEVEL.
+// Calls below it are discarded by `if constexpr`, so neither the level check nor the argument formatting is emitted.
+#ifndef REACTORMQ_LOG_MIN_LEVEL
+#define REACTORMQ_LOG_MIN_LEVEL 0
+#endif
+
 #define REACTORMQ_LOG(level, fmt, ...)                                                                                                     \
     do                                                                                                                                     \
     {                                                                                                                                      \
-        if (::reactormq::logging::Registry::instance().shouldLog((level)))                                                                 \
+        if constexpr (static_cast<int>((level)) >= REACTORMQ_LOG_MIN_LEVEL)                                                                \
+        {                                                                                                                                  \
+            if (::reactormq::logging::Registry::instance().shouldLog((level)))                                                             \
+            {                                                                                                                              \
+                const auto lazyMsg = ::reactormq::logging::detail::LazyFormat((fmt)__VA_OPT__(, ) __VA_ARGS__);                            \
+                ::reactormq::logging::Registry::instance().log((level), std::source_location::current(), lazyMsg);                         \
+            }                                                                                                                              \
+        }                                                                                                                                  \
+    } while (0)
+
+// Like REACTORMQ_LOG, but at most perSecond messages a second (with bursts of the same size) from this call site.
+// The limiter is a static local, so each expansion has its own bucket. The first message let through after a run of
+// suppressed ones is preceded by a line with the number suppressed.
+#define REACTORMQ_LOG_RATELIMITED(level, perSecond, fmt, ...)                                                                              \
+    do                                                                                                                                     \
+    {                                                                                                                                      \
+        if constexpr (static_cast<int>((level)) >= REACTORMQ_LOG_MIN_LEVEL)                                                                \
         {                                                                                                                                  \
-            const auto lazyMsg = ::reactormq::logging::detail::LazyFormat((fmt)__VA_OPT__(, ) __VA_ARGS__);                                \
-            ::reactormq::logging::Registry::instance().log((level), std::source_location::current(), lazyMsg);                             \
+            if (::reactormq::logging::Registry::instance().shouldLog((level)))                                                             \
+            {                                                                                                                              \
+                static ::reactormq::logging::LogRateLimit reactormqLogRateLimit{ (perSecond) };                                            \
+                if (const auto admission = reactormqLogRateLimit.tryAcquire(); admission.isAllowed)                                        \
+                {                                                                                                                          \
+                    if (admission.suppressed > 0)                                                                                          \
+                    {                                                                                                                      \
+                        const auto summary =                                                                                               \
+                            ::reactormq::logging::detail::LazyFormat("%u similar messages suppressed", admission.suppressed);              \
+                        ::reactormq::logging::Registry::instance().log((level), std::source_location::current(), summary);                 \
+                    }                                                                                                                      \
+                    const auto lazyMsg = ::reactormq::logging::detail::LazyFormat((fmt)__VA_OPT__(, ) __VA_ARGS__);                        \
+                    ::reactormq::logging::Registry::instance().log((level), std::source_location::current(), lazyMsg);                     \
+                }                                                                                                                          \
+            }                                                                                                                              \
         }                                                                                                                                  \
     } while (0)
 
 #define REACTORMQ_LOG_HEX(level, data, length, fmt, ...)                                                                                   \
     do                                                                                                                                     \
     {                                                                                                                                      \
-        if (::reactormq::logging::Registry::instance().shouldLog((level)))                                                                 \
+        if constexpr (static_cast<int>((level)) >= REACTORMQ_LOG_MIN_LEVEL)                                                                \
         {                                                                                                                                  \
-            ::reactormq::logging::Registry::instance().log(                                                                                \
-                (level),                                                                                                                   \
-                std::source_location::current(),                                                                                           \
-                ::reactormq::logging::formatHexMessage((data), static_cast<size_t>(length), (fmt)__VA_OPT__(, ) __VA_ARGS__));             \
+            if (::reactormq::logging::Registry::instance().shouldLog((level)))                                                             \
+            {                                                                                                                              \
+                ::reactormq::logging::Registry::instance().log(                                                                            \
+                    (level),                                                                                                               \
+                    std::source_location::current(),                                                                                       \
+                    ::reactormq::logging::formatHexMessage((data), static_cast<size_t>(length), (fmt)__VA_OPT__(, ) __VA_ARGS__));         \
+            }                                                                                                                              \
         }                                                                                                                                  \
     } while (0)
 } // namespace reactormq::logging
\ No newline at end of file
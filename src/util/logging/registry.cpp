@@ -8,9 +8,12 @@
 #include "file_sink.h"
 #include "ue_log_sink.h"
 #include "util/logging/log_message.h"
+#include "util/logging/logging.h"
+#include "util/system/thread_placement.h"
 
 #include <format>
 #include <mutex>
+#include <span>
 
 namespace reactormq::logging
 {
@@ -38,6 +41,11 @@ namespace reactormq::logging
         return inst;
     }
 
+    Registry::~Registry()
+    {
+        stopAsync();
+    }
+
     void Registry::addSink(std::shared_ptr<Sink> sink)
     {
         std::scoped_lock lock(mtx_);
@@ -69,8 +77,169 @@ namespace reactormq::logging
 #endif // REACTORMQ_WITH_UE5 && REACTORMQ_WITH_UE_LOG_SINK
     }
 
+    void Registry::startAsync(const size_t capacity, const mqtt::ThreadPlacement& placement)
+    {
+        std::scoped_lock lock(m_asyncMutex);
+        if (m_asyncWorker.joinable())
+        {
+            return;
+        }
+
+        if (!m_asyncStorage)
+        {
+            m_asyncStorage = std::make_unique<AsyncLogQueue>(capacity);
+        }
+
+        m_asyncQueue.store(m_asyncStorage.get(), std::memory_order_release);
+        m_asyncWorker = std::jthread(
+            [this, placement](const std::stop_token& stopToken)
+            {
+                if (!placement.isDefault() && !system::applyThreadPlacement(placement))
+                {
+                    REACTORMQ_LOG(LogLevel::Warn, "Registry::startAsync() could not apply all of the thread placement");
+                }
+                runAsyncWorker(stopToken);
+            });
+    }
+
+    void Registry::stopAsync()
+    {
+        std::scoped_lock lock(m_asyncMutex);
+        if (!m_asyncWorker.joinable())
+        {
+            return;
+        }
+
+        m_asyncQueue.store(nullptr, std::memory_order_release);
+        m_asyncWorker.request_stop();
+        m_asyncWakeSignal.fetch_add(1, std::memory_order_release);
+        m_asyncWakeSignal.notify_one();
+        m_asyncWorker.join();
+    }
+
+    bool Registry::isAsync() const
+    {
+        return m_asyncQueue.load(std::memory_order_acquire) != nullptr;
+    }
+
+    std::uint64_t Registry::getDroppedCount() const
+    {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    void Registry::pushAsync(
+        AsyncLogQueue& queue, const LogLevel level, const std::source_location& location, const std::string_view text) const
+    {
+        onAsyncPush(queue.tryPush(level, location, text));
+    }
+
+    void Registry::onAsyncPush(const bool isQueued) const
+    {
+        if (!isQueued)
+        {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Pairs with the fence in runAsyncWorker(): either the worker sees the record before it sleeps, or this
+        // thread sees the worker idle and wakes it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isAsyncWorkerIdle.load(std::memory_order_relaxed))
+        {
+            m_asyncWakeSignal.fetch_add(1, std::memory_order_release);
+            m_asyncWakeSignal.notify_one();
+        }
+    }
+
+    void Registry::runAsyncWorker(const std::stop_token& stopToken)
+    {
+        while (!stopToken.stop_requested())
+        {
+            if (deliverAsyncBatch() > 0 || m_asyncStorage->hasReadyRecord())
+            {
+                continue;
+            }
+
+            const std::uint32_t signal = m_asyncWakeSignal.load(std::memory_order_acquire);
+            m_isAsyncWorkerIdle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_asyncStorage->hasReadyRecord() && !stopToken.stop_requested())
+            {
+                m_asyncWakeSignal.wait(signal, std::memory_order_acquire);
+            }
+            m_isAsyncWorkerIdle.store(false, std::memory_order_relaxed);
+        }
+
+        while (deliverAsyncBatch() > 0)
+        {
+            // deliver what was queued before the stop
+        }
+    }
+
+    size_t Registry::deliverAsyncBatch()
+    {
+        constexpr size_t kBatchSize = 256;
+        if (m_asyncBatch.size() < kBatchSize + 1)
+        {
+            m_asyncBatch.resize(kBatchSize + 1);
+        }
+
+        size_t count = m_asyncStorage->drain(
+            [this, index = size_t{ 0 }](const LogRecord& record) mutable
+            {
+                LogMessage& msg = m_asyncBatch[index++];
+                msg.timestamp = record.timestamp;
+                msg.thread_id = record.threadId;
+                msg.level = record.level;
+                msg.function = record.function;
+                msg.file = record.file;
+                msg.line = record.line;
+                record.formatTextTo(msg.text);
+            },
+            kBatchSize);
+
+        const std::uint64_t dropped = m_droppedCount.load(std::memory_order_relaxed);
+        if (dropped != m_reportedDropCount)
+        {
+            const std::source_location location = std::source_location::current();
+            m_asyncBatch[count++] = makeMessage(
+                LogLevel::Warn,
+                location,
+                std::format("{} log messages dropped: async queue full", dropped - m_reportedDropCount));
+            m_reportedDropCount = dropped;
+        }
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        std::vector<std::shared_ptr<Sink>> sinks_copy;
+        {
+            std::scoped_lock lock(mtx_);
+            sinks_copy = sinks_;
+        }
+
+        const std::span<const LogMessage> batch{ m_asyncBatch.data(), count };
+        for (auto const& s : sinks_copy)
+        {
+            if (s)
+            {
+                s->logBatch(batch);
+            }
+        }
+
+        return count;
+    }
+
     void Registry::log(const LogLevel level, const std::source_location& location, const std::string_view text) const
     {
+        if (AsyncLogQueue* queue = m_asyncQueue.load(std::memory_order_acquire))
+        {
+            pushAsync(*queue, level, location, text);
+            return;
+        }
+
         LogMessage msg;
         msg.timestamp = std::chrono::system_clock::now();
         msg.thread_id = std::this_thread::get_id();
@@ -3,14 +3,19 @@
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
 #pragma once
+#include "reactormq/mqtt/thread_placement.h"
+#include "util/logging/async_log_queue.h"
 #include "util/logging/log_level.h"
 #include "util/logging/sink.h"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <source_location>
 #include <string>
+#include <thread>
 #include <vector>
 
 #if REACTORMQ_WITH_UE5 && REACTORMQ_WITH_UE_LOG_SINK
@@ -37,6 +42,11 @@ namespace reactormq::logging
     class Registry
     {
     public:
+        /// Default number of slots in the async queue.
+        static constexpr size_t kDefaultAsyncCapacity = 8192;
+
+        ~Registry();
+
         /**
          * @brief Access the singleton instance.
          * @return Reference to the global registry.
@@ -73,6 +83,29 @@ namespace reactormq::logging
          */
         bool shouldLog(LogLevel level) const;
 
+        /**
+         * @brief Switch to async mode: log calls copy a compact record into a lock-free ring and return, and a
+         * background thread builds the messages and hands them to the sinks in batches.
+         * When the ring is full a message is dropped and counted rather than waited for; the background thread
+         * reports the drops as a warning. Does nothing if async mode is already on.
+         * @param capacity Ring slots; only the first start sizes the ring, which is kept for the registry's lifetime
+         * so a log call racing with stopAsync() never touches freed memory.
+         * @param placement Name, cores and priority of the background thread, e.g. to keep it off the I/O cores.
+         */
+        void startAsync(size_t capacity = kDefaultAsyncCapacity, const mqtt::ThreadPlacement& placement = {});
+
+        /**
+         * @brief Leave async mode: deliver every queued message, stop the background thread and log synchronously
+         * again. A call racing with this one may leave its message queued until the next startAsync().
+         */
+        void stopAsync();
+
+        /// @brief Whether log calls are queued for the background thread.
+        [[nodiscard]] bool isAsync() const;
+
+        /// @brief Messages dropped because the async queue was full, since the registry was created.
+        [[nodiscard]] std::uint64_t getDroppedCount() const;
+
         /**
          * @brief Dispatch a formatted log message to all sinks.
          * @param level Severity level.
@@ -110,8 +143,45 @@ namespace reactormq::logging
          */
         void logToSinks(const LogMessage& msg) const;
 
+        /**
+         * @brief Queue a log event for the background thread, waking it if it is idle.
+         * @param queue Active async queue.
+         * @param level Severity level.
+         * @param location location of the call
+         * @param text Formatted message text
+         */
+        void pushAsync(AsyncLogQueue& queue, LogLevel level, const std::source_location& location, std::string_view text) const;
+
+        /**
+         * @brief Count a dropped record, or wake the background thread if it is idle.
+         * @param isQueued Whether the record made it into the queue.
+         */
+        void onAsyncPush(bool isQueued) const;
+
+        /**
+         * @brief Background thread body: drain the queue in batches until asked to stop, then drain what is left.
+         * @param stopToken Stop request from stopAsync().
+         */
+        void runAsyncWorker(const std::stop_token& stopToken);
+
+        /**
+         * @brief Move up to one batch of queued records to the sinks.
+         * @return Number of records delivered.
+         */
+        size_t deliverAsyncBatch();
+
         mutable std::mutex mtx_;
         std::vector<std::shared_ptr<Sink>> sinks_;
         std::atomic<LogLevel> level_{ LogLevel::Trace };
+
+        std::mutex m_asyncMutex; ///< Serializes startAsync() and stopAsync().
+        std::unique_ptr<AsyncLogQueue> m_asyncStorage; ///< Ring kept once created; see startAsync().
+        std::atomic<AsyncLogQueue*> m_asyncQueue{ nullptr }; ///< Set while async mode is on.
+        std::jthread m_asyncWorker;
+        std::vector<LogMessage> m_asyncBatch; ///< Worker-owned; reused so message strings keep their capacity.
+        mutable std::atomic<bool> m_isAsyncWorkerIdle{ false };
+        mutable std::atomic<std::uint32_t> m_asyncWakeSignal{ 0 };
+        mutable std::atomic<std::uint64_t> m_droppedCount{ 0 };
+        std::uint64_t m_reportedDropCount = 0; ///< Worker-owned.
     };
 } // namespace reactormq::logging
\ No newline at end of file
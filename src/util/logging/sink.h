@@ -4,14 +4,12 @@
 
 #pragma once
 
+#include "util/logging/log_message.h"
+
+#include <span>
+
 namespace reactormq::logging
 {
-    /**
-     * @brief Forward declaration of the log message structure.
-     * Defined in @c log_message.h.
-     */
-    struct LogMessage;
-
     /**
      * @brief Abstract base class for log message sinks.
      *
@@ -34,5 +32,22 @@ namespace reactormq::logging
          * @param msg Fully populated log message to be handled.
          */
         virtual void log(const LogMessage& msg) = 0;
+
+        /**
+         * @brief Process a batch of log messages, oldest first.
+         *
+         * Called by the registry's async mode. The default forwards each
+         * message to @ref log; sinks that buffer output override it to flush
+         * once per batch rather than once per message.
+         *
+         * @param msgs Messages to be handled.
+         */
+        virtual void logBatch(const std::span<const LogMessage> msgs)
+        {
+            for (const LogMessage& msg : msgs)
+            {
+                log(msg);
+            }
+        }
     };
 } // namespace reactormq::logging
\ No newline at end of file
@@ -0,0 +1,786 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/perf/perf_report.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace reactormq::perf
+{
+    namespace
+    {
+        /// A parsed JSON value. Objects keep their members in document order, as parallel key and value lists.
+        struct JsonValue
+        {
+            enum class Kind : uint8_t
+            {
+                Null,
+                Bool,
+                Number,
+                String,
+                Array,
+                Object,
+            };
+
+            Kind kind = Kind::Null;
+            bool boolean = false;
+            double number = 0.0;
+            std::string text;
+            std::vector<JsonValue> items; ///< Array elements, or object member values.
+            std::vector<std::string> keys; ///< Object member names, one per entry of items.
+
+            [[nodiscard]] const JsonValue* find(const std::string_view key) const
+            {
+                if (kind != Kind::Object)
+                {
+                    return nullptr;
+                }
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    if (keys[i] == key)
+                    {
+                        return &items[i];
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        /// Recursive descent over RFC 8259 JSON. Result files are small, so everything is parsed into a JsonValue tree.
+        class JsonParser final
+        {
+        public:
+            explicit JsonParser(const std::string_view text)
+                : m_text(text)
+            {
+            }
+
+            bool parse(JsonValue& out, std::string& error)
+            {
+                skipWhitespace();
+                bool isValid = parseValue(out, 0);
+                if (isValid)
+                {
+                    skipWhitespace();
+                    isValid = m_pos == m_text.size() || fail("trailing characters");
+                }
+                if (!isValid)
+                {
+                    error = m_error;
+                }
+                return isValid;
+            }
+
+        private:
+            // Deep enough for any result file; a hostile one cannot exhaust the stack.
+            static constexpr int kMaxDepth = 32;
+
+            bool fail(const std::string_view what)
+            {
+                m_error = std::format("{} at offset {}", what, m_pos);
+                return false;
+            }
+
+            void skipWhitespace()
+            {
+                while (m_pos < m_text.size()
+                       && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r'))
+                {
+                    ++m_pos;
+                }
+            }
+
+            bool consume(const char expected)
+            {
+                if (m_pos < m_text.size() && m_text[m_pos] == expected)
+                {
+                    ++m_pos;
+                    return true;
+                }
+                return false;
+            }
+
+            bool parseValue(JsonValue& out, const int depth)
+            {
+                if (depth > kMaxDepth)
+                {
+                    return fail("nesting too deep");
+                }
+                if (m_pos >= m_text.size())
+                {
+                    return fail("unexpected end of input");
+                }
+
+                switch (m_text[m_pos])
+                {
+                    case '{':
+                        return parseObject(out, depth);
+                    case '[':
+                        return parseArray(out, depth);
+                    case '"':
+                        out.kind = JsonValue::Kind::String;
+                        return parseString(out.text);
+                    case 't':
+                        out.kind = JsonValue::Kind::Bool;
+                        out.boolean = true;
+                        return parseLiteral("true");
+                    case 'f':
+                        out.kind = JsonValue::Kind::Bool;
+                        return parseLiteral("false");
+                    case 'n':
+                        return parseLiteral("null");
+                    default:
+                        out.kind = JsonValue::Kind::Number;
+                        return parseNumber(out.number);
+                }
+            }
+
+            bool parseObject(JsonValue& out, const int depth)
+            {
+                out.kind = JsonValue::Kind::Object;
+                ++m_pos;
+                skipWhitespace();
+                if (consume('}'))
+                {
+                    return true;
+                }
+                while (true)
+                {
+                    if (m_pos >= m_text.size() || m_text[m_pos] != '"')
+                    {
+                        return fail("expected a member name");
+                    }
+                    if (!parseString(out.keys.emplace_back()))
+                    {
+                        return false;
+                    }
+                    skipWhitespace();
+                    if (!consume(':'))
+                    {
+                        return fail("expected ':'");
+                    }
+                    skipWhitespace();
+                    if (!parseValue(out.items.emplace_back(), depth + 1))
+                    {
+                        return false;
+                    }
+                    skipWhitespace();
+                    if (consume('}'))
+                    {
+                        return true;
+                    }
+                    if (!consume(','))
+                    {
+                        return fail("expected ',' or '}'");
+                    }
+                    skipWhitespace();
+                }
+            }
+
+            bool parseArray(JsonValue& out, const int depth)
+            {
+                out.kind = JsonValue::Kind::Array;
+                ++m_pos;
+                skipWhitespace();
+                if (consume(']'))
+                {
+                    return true;
+                }
+                while (true)
+                {
+                    if (!parseValue(out.items.emplace_back(), depth + 1))
+                    {
+                        return false;
+                    }
+                    skipWhitespace();
+                    if (consume(']'))
+                    {
+                        return true;
+                    }
+                    if (!consume(','))
+                    {
+                        return fail("expected ',' or ']'");
+                    }
+                    skipWhitespace();
+                }
+            }
+
+            bool parseLiteral(const std::string_view literal)
+            {
+                if (m_text.substr(m_pos, literal.size()) != literal)
+                {
+                    return fail("unexpected character");
+                }
+                m_pos += literal.size();
+                return true;
+            }
+
+            bool parseNumber(double& out)
+            {
+                const size_t start = m_pos;
+                while (m_pos < m_text.size() && std::string_view("+-0123456789.eE").find(m_text[m_pos]) != std::string_view::npos)
+                {
+                    ++m_pos;
+                }
+                const std::string copy(m_text.substr(start, m_pos - start));
+                char* end = nullptr;
+                out = std::strtod(copy.c_str(), &end);
+                if (copy.empty() || end != copy.c_str() + copy.size())
+                {
+                    m_pos = start;
+                    return fail("invalid number");
+                }
+                return true;
+            }
+
+            bool parseHex4(uint32_t& out)
+            {
+                out = 0;
+                for (int i = 0; i < 4; ++i, ++m_pos)
+                {
+                    if (m_pos >= m_text.size())
+                    {
+                        return fail("unexpected end of input");
+                    }
+                    const char c = m_text[m_pos];
+                    const int digit = c >= '0' && c <= '9' ? c - '0'
+                        : c >= 'a' && c <= 'f'             ? c - 'a' + 10
+                        : c >= 'A' && c <= 'F'             ? c - 'A' + 10
+                                                           : -1;
+                    if (digit < 0)
+                    {
+                        return fail("invalid \\u escape");
+                    }
+                    out = out << 4 | static_cast<uint32_t>(digit);
+                }
+                return true;
+            }
+
+            static void appendUtf8(std::string& out, const uint32_t codePoint)
+            {
+                if (codePoint < 0x80)
+                {
+                    out += static_cast<char>(codePoint);
+                }
+                else if (codePoint < 0x800)
+                {
+                    out += static_cast<char>(0xC0 | codePoint >> 6);
+                    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else if (codePoint < 0x10000)
+                {
+                    out += static_cast<char>(0xE0 | codePoint >> 12);
+                    out += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+                else
+                {
+                    out += static_cast<char>(0xF0 | codePoint >> 18);
+                    out += static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+                    out += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+                    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+            }
+
+            bool parseString(std::string& out)
+            {
+                ++m_pos;
+                while (m_pos < m_text.size())
+                {
+                    const char c = m_text[m_pos++];
+                    if (c == '"')
+                    {
+                        return true;
+                    }
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        --m_pos;
+                        return fail("control character in string");
+                    }
+                    if (c != '\\')
+                    {
+                        out += c;
+                        continue;
+                    }
+                    if (m_pos >= m_text.size())
+                    {
+                        break;
+                    }
+
+                    constexpr std::string_view kEscapes = "\"\\/bfnrt";
+                    constexpr std::string_view kEscaped = "\"\\/\b\f\n\r\t";
+                    const char escape = m_text[m_pos++];
+                    if (const size_t index = kEscapes.find(escape); index != std::string_view::npos)
+                    {
+                        out += kEscaped[index];
+                        continue;
+                    }
+                    if (escape != 'u')
+                    {
+                        --m_pos;
+                        return fail("invalid escape");
+                    }
+
+                    uint32_t codePoint = 0;
+                    if (!parseHex4(codePoint))
+                    {
+                        return false;
+                    }
+                    // A high surrogate followed by a low one is a single code point outside the BMP.
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && m_text.substr(m_pos, 2) == "\\u")
+                    {
+                        m_pos += 2;
+                        uint32_t low = 0;
+                        if (!parseHex4(low))
+                        {
+                            return false;
+                        }
+                        if (low < 0xDC00 || low >= 0xE000)
+                        {
+                            return fail("invalid surrogate pair");
+                        }
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, codePoint);
+                }
+                return fail("unterminated string");
+            }
+
+            std::string_view m_text;
+            size_t m_pos = 0;
+            std::string m_error;
+        };
+
+        void appendJsonString(std::string& out, const std::string_view text)
+        {
+            out += '"';
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    case '\r':
+                        out += "\\r";
+                        break;
+                    case '\t':
+                        out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                        }
+                        else
+                        {
+                            out += c;
+                        }
+                        break;
+                }
+            }
+            out += '"';
+        }
+
+        /// Append `"key": value` after @p separator, unless the value is not finite; returns whether it was written.
+        bool appendNumberMember(std::string& out, const std::string_view separator, const std::string_view key, const double value)
+        {
+            if (!std::isfinite(value))
+            {
+                return false;
+            }
+            out += separator;
+            appendJsonString(out, key);
+            out += std::format(": {}", value);
+            return true;
+        }
+
+        std::optional<double> getNumber(const JsonValue& object, const std::string_view key)
+        {
+            const JsonValue* value = object.find(key);
+            if (value == nullptr || value->kind != JsonValue::Kind::Number)
+            {
+                return std::nullopt;
+            }
+            return value->number;
+        }
+
+        bool parseResult(const JsonValue& value, const size_t index, PerfResult& out, std::string& error)
+        {
+            const JsonValue* name = value.find("name");
+            if (name == nullptr || name->kind != JsonValue::Kind::String || name->text.empty())
+            {
+                error = std::format("result {} has no name", index);
+                return false;
+            }
+            out.name = name->text;
+
+            const std::optional<double> opsPerSecond = getNumber(value, "ops_per_sec");
+            if (!opsPerSecond)
+            {
+                error = std::format("result '{}' has no ops_per_sec", out.name);
+                return false;
+            }
+            out.opsPerSecond = *opsPerSecond;
+
+            if (const JsonValue* latency = value.find("latency_us"))
+            {
+                out.p50Us = getNumber(*latency, "p50");
+                out.p99Us = getNumber(*latency, "p99");
+                out.p999Us = getNumber(*latency, "p999");
+            }
+            out.allocsPerOp = getNumber(value, "allocs_per_op");
+            out.bytesPerOp = getNumber(value, "bytes_per_op");
+
+            if (const JsonValue* counters = value.find("counters"); counters != nullptr && counters->kind == JsonValue::Kind::Object)
+            {
+                for (size_t i = 0; i < counters->keys.size(); ++i)
+                {
+                    if (counters->items[i].kind == JsonValue::Kind::Number)
+                    {
+                        out.counters[counters->keys[i]] = counters->items[i].number;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// The compared figures of a result, in schema order; empty optionals where the result does not measure one.
+        std::array<std::pair<std::string_view, std::optional<double>>, 6> getFigures(const PerfResult& result)
+        {
+            return { {
+                { "ops_per_sec", result.opsPerSecond },
+                { "latency_us.p50", result.p50Us },
+                { "latency_us.p99", result.p99Us },
+                { "latency_us.p999", result.p999Us },
+                { "allocs_per_op", result.allocsPerOp },
+                { "bytes_per_op", result.bytesPerOp },
+            } };
+        }
+    } // namespace
+
+    std::string toJson(const PerfReport& report)
+    {
+        std::string out = std::format("{{\n  \"schema\": \"{}\",\n  \"version\": {},\n  \"tool\": ", kSchemaName, kSchemaVersion);
+        appendJsonString(out, report.tool);
+        out += ",\n  \"results\": [";
+
+        const char* resultSeparator = "\n";
+        for (const PerfResult& result : report.results)
+        {
+            out += resultSeparator;
+            resultSeparator = ",\n";
+            out += "    {\n      \"name\": ";
+            appendJsonString(out, result.name);
+            (void)appendNumberMember(out, ",\n      ", "ops_per_sec", std::isfinite(result.opsPerSecond) ? result.opsPerSecond : 0.0);
+
+            if (result.p50Us || result.p99Us || result.p999Us)
+            {
+                out += ",\n      \"latency_us\": {";
+                std::string_view separator = " ";
+                const std::array<std::pair<std::string_view, std::optional<double>>, 3> percentiles{ {
+                    { "p50", result.p50Us },
+                    { "p99", result.p99Us },
+                    { "p999", result.p999Us },
+                } };
+                for (const auto& [key, value] : percentiles)
+                {
+                    if (value && appendNumberMember(out, separator, key, *value))
+                    {
+                        separator = ", ";
+                    }
+                }
+                out += " }";
+            }
+            if (result.allocsPerOp)
+            {
+                (void)appendNumberMember(out, ",\n      ", "allocs_per_op", *result.allocsPerOp);
+            }
+            if (result.bytesPerOp)
+            {
+                (void)appendNumberMember(out, ",\n      ", "bytes_per_op", *result.bytesPerOp);
+            }
+            if (!result.counters.empty())
+            {
+                out += ",\n      \"counters\": {";
+                std::string_view separator = " ";
+                for (const auto& [key, value] : result.counters)
+                {
+                    if (appendNumberMember(out, separator, key, value))
+                    {
+                        separator = ", ";
+                    }
+                }
+                out += " }";
+            }
+            out += "\n    }";
+        }
+        out += report.results.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return out;
+    }
+
+    bool parsePerfReport(const std::string_view json, PerfReport& out, std::string& error)
+    {
+        JsonValue root;
+        if (!JsonParser(json).parse(root, error))
+        {
+            return false;
+        }
+
+        const JsonValue* schema = root.find("schema");
+        if (schema == nullptr || schema->kind != JsonValue::Kind::String || schema->text != kSchemaName)
+        {
+            error = std::format("not a {} document", kSchemaName);
+            return false;
+        }
+        const std::optional<double> version = getNumber(root, "version");
+        if (!version || *version < 1 || *version != std::floor(*version))
+        {
+            error = "missing or invalid version";
+            return false;
+        }
+        if (*version > kSchemaVersion)
+        {
+            error = std::format("version {} is newer than this build reads ({})", *version, kSchemaVersion);
+            return false;
+        }
+
+        PerfReport report;
+        if (const JsonValue* tool = root.find("tool"); tool != nullptr && tool->kind == JsonValue::Kind::String)
+        {
+            report.tool = tool->text;
+        }
+        const JsonValue* results = root.find("results");
+        if (results == nullptr || results->kind != JsonValue::Kind::Array)
+        {
+            error = "missing results";
+            return false;
+        }
+        report.results.resize(results->items.size());
+        for (size_t i = 0; i < results->items.size(); ++i)
+        {
+            if (!parseResult(results->items[i], i, report.results[i], error))
+            {
+                return false;
+            }
+        }
+
+        out = std::move(report);
+        return true;
+    }
+
+    bool savePerfReport(const std::string& path, const PerfReport& report, std::string& error)
+    {
+        const std::string json = toJson(report);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(json.data(), static_cast<std::streamsize>(json.size())))
+        {
+            error = std::format("cannot write {}", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool loadPerfReport(const std::string& path, PerfReport& out, std::string& error)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            error = std::format("cannot open {}", path);
+            return false;
+        }
+        const std::string json{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        if (!parsePerfReport(json, out, error))
+        {
+            error = std::format("{}: {}", path, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool parseCompareThresholds(const std::string_view text, CompareThresholds& out)
+    {
+        CompareThresholds thresholds = out;
+        size_t start = 0;
+        while (start <= text.size())
+        {
+            const size_t comma = std::min(text.find(',', start), text.size());
+            const std::string_view pair = text.substr(start, comma - start);
+            const size_t colon = pair.find(':');
+            if (colon == std::string_view::npos)
+            {
+                return false;
+            }
+
+            const std::string percent(pair.substr(colon + 1));
+            char* end = nullptr;
+            const double value = std::strtod(percent.c_str(), &end);
+            if (percent.empty() || end != percent.c_str() + percent.size() || !(value >= 0.0))
+            {
+                return false;
+            }
+
+            const std::string_view metric = pair.substr(0, colon);
+            if (metric == "ops")
+            {
+                thresholds.throughput = value / 100.0;
+            }
+            else if (metric == "latency")
+            {
+                thresholds.latency = value / 100.0;
+            }
+            else if (metric == "allocs")
+            {
+                thresholds.allocations = value / 100.0;
+            }
+            else
+            {
+                return false;
+            }
+            start = comma + 1;
+        }
+
+        out = thresholds;
+        return true;
+    }
+
+    bool PerfComparison::hasRegressed() const
+    {
+        return std::ranges::any_of(
+            deltas,
+            [](const PerfDelta& delta)
+            {
+                return delta.isRegression;
+            });
+    }
+
+    PerfComparison comparePerfReports(const PerfReport& baseline, const PerfReport& candidate, const CompareThresholds& thresholds)
+    {
+        // Averaged figures of identical runs can differ in the last bits; a millionth is noise, not a regression.
+        constexpr double kTolerance = 1e-6;
+
+        const auto findResult = [](const PerfReport& report, const std::string& name) -> const PerfResult*
+        {
+            const auto it = std::ranges::find(report.results, name, &PerfResult::name);
+            return it == report.results.end() ? nullptr : &*it;
+        };
+
+        PerfComparison comparison;
+        for (const PerfResult& before : baseline.results)
+        {
+            const PerfResult* after = findResult(candidate, before.name);
+            if (after == nullptr)
+            {
+                comparison.missing.push_back(before.name);
+                continue;
+            }
+
+            const auto beforeFigures = getFigures(before);
+            const auto afterFigures = getFigures(*after);
+            for (size_t i = 0; i < beforeFigures.size(); ++i)
+            {
+                const auto& [metric, beforeValue] = beforeFigures[i];
+                const std::optional<double>& afterValue = afterFigures[i].second;
+                if (!beforeValue || !afterValue)
+                {
+                    continue;
+                }
+
+                PerfDelta delta;
+                delta.name = before.name;
+                delta.metric = metric;
+                delta.baseline = *beforeValue;
+                delta.candidate = *afterValue;
+                delta.change = delta.baseline != 0.0 ? (delta.candidate - delta.baseline) / delta.baseline : 0.0;
+                const double slack = kTolerance * std::max(1.0, std::abs(delta.baseline));
+                if (i == 0)
+                {
+                    delta.isRegression = delta.candidate < delta.baseline * (1.0 - thresholds.throughput) - slack;
+                }
+                else
+                {
+                    const double allowed = metric.starts_with("latency") ? thresholds.latency : thresholds.allocations;
+                    delta.isRegression = delta.candidate > delta.baseline * (1.0 + allowed) + slack;
+                }
+                comparison.deltas.push_back(std::move(delta));
+            }
+        }
+
+        for (const PerfResult& after : candidate.results)
+        {
+            if (findResult(baseline, after.name) == nullptr)
+            {
+                comparison.added.push_back(after.name);
+            }
+        }
+        return comparison;
+    }
+
+    std::string formatComparison(const PerfComparison& comparison)
+    {
+        size_t nameWidth = 6;
+        for (const PerfDelta& delta : comparison.deltas)
+        {
+            nameWidth = std::max(nameWidth, delta.name.size());
+        }
+
+        std::string out
+            = std::format("{:<{}}  {:<16} {:>14} {:>14} {:>9}\n", "result", nameWidth, "metric", "baseline", "candidate", "change");
+        size_t regressions = 0;
+        for (const PerfDelta& delta : comparison.deltas)
+        {
+            out += std::format(
+                "{:<{}}  {:<16} {:>14.6g} {:>14.6g} {:>+8.1f}%{}\n",
+                delta.name,
+                nameWidth,
+                delta.metric,
+                delta.baseline,
+                delta.candidate,
+                delta.change * 100.0,
+                delta.isRegression ? "  REGRESSION" : "");
+            regressions += delta.isRegression ? 1 : 0;
+        }
+        for (const std::string& name : comparison.missing)
+        {
+            out += std::format("missing from candidate: {}\n", name);
+        }
+        for (const std::string& name : comparison.added)
+        {
+            out += std::format("new in candidate: {}\n", name);
+        }
+        out += regressions == 0 ? std::format("No regressions in {} figures.\n", comparison.deltas.size())
+                                : std::format("{} of {} figures regressed.\n", regressions, comparison.deltas.size());
+        return out;
+    }
+
+    int runComparison(const std::string& baselinePath, const std::string& candidatePath, const CompareThresholds& thresholds)
+    {
+        PerfReport baseline;
+        PerfReport candidate;
+        std::string error;
+        if (!loadPerfReport(baselinePath, baseline, error) || !loadPerfReport(candidatePath, candidate, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 2;
+        }
+
+        const PerfComparison comparison = comparePerfReports(baseline, candidate, thresholds);
+        std::fputs(formatComparison(comparison).c_str(), stdout);
+        return comparison.hasRegressed() ? 1 : 0;
+    }
+} // namespace reactormq::perf
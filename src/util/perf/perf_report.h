@@ -0,0 +1,142 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+// Machine-readable results for reactormq_bench and reactormq_loadgen, and the comparison of two result files.
+//
+// Both tools write the same JSON document, version 1 of the "reactormq.perf" schema:
+//
+//   {
+//     "schema": "reactormq.perf",
+//     "version": 1,
+//     "tool": "reactormq_bench",
+//     "results": [
+//       {
+//         "name": "BM_LoopbackPublishThroughput/qos:1/payload:64",
+//         "ops_per_sec": 182311.4,
+//         "latency_us": { "p50": 41, "p99": 230, "p999": 612 },
+//         "allocs_per_op": 3.02,
+//         "bytes_per_op": 412.5,
+//         "counters": { "bytes_per_second": 11667929.6 }
+//       }
+//     ]
+//   }
+//
+// "name" and "ops_per_sec" are always present. The latency, allocation and byte figures are present only for results
+// that measure them, and "counters" holds anything else a result reports; counters are informational and never
+// compared. Readers ignore fields they do not know, so fields may be added without a version change; renaming or
+// removing one, or changing its meaning, needs a new version.
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reactormq::perf
+{
+    /// Name of the schema, written to and required in every result file.
+    inline constexpr std::string_view kSchemaName = "reactormq.perf";
+
+    /// Version of the schema this build writes, and the newest one it reads.
+    inline constexpr int kSchemaVersion = 1;
+
+    /// One measured operation: a benchmark run, or a kind of traffic in a load test.
+    struct PerfResult
+    {
+        std::string name; ///< Unique within a report; results of two reports are matched by it.
+        double opsPerSecond = 0.0;
+        std::optional<double> p50Us;
+        std::optional<double> p99Us;
+        std::optional<double> p999Us;
+        std::optional<double> allocsPerOp; ///< Heap allocations per operation.
+        std::optional<double> bytesPerOp; ///< Heap bytes requested per operation.
+        std::map<std::string, double> counters; ///< Anything else the result reports, by name; never compared.
+    };
+
+    /// Results of one run of one tool.
+    struct PerfReport
+    {
+        std::string tool;
+        std::vector<PerfResult> results;
+    };
+
+    /**
+     * @brief Serialise a report as a version 1 document, pretty-printed, with a trailing newline.
+     * Figures that are not finite are left out, as JSON has no way to write them.
+     */
+    [[nodiscard]] std::string toJson(const PerfReport& report);
+
+    /**
+     * @brief Parse a result file.
+     * @param json Document text.
+     * @param out Report filled on success.
+     * @param error Set to what is wrong on failure.
+     * @return False if the text is not JSON, not a reactormq.perf document, or of a newer version.
+     */
+    [[nodiscard]] bool parsePerfReport(std::string_view json, PerfReport& out, std::string& error);
+
+    /// Write @p report to @p path, replacing the file; false with @p error set if it cannot be written.
+    [[nodiscard]] bool savePerfReport(const std::string& path, const PerfReport& report, std::string& error);
+
+    /// Read and parse the file at @p path; false with @p error set if it cannot be read or parsed.
+    [[nodiscard]] bool loadPerfReport(const std::string& path, PerfReport& out, std::string& error);
+
+    /// How much worse a candidate may be than its baseline, as fractions of the baseline figure, before it regresses.
+    struct CompareThresholds
+    {
+        double throughput = 0.05; ///< Largest allowed drop in ops_per_sec.
+        double latency = 0.10; ///< Largest allowed growth of each latency percentile.
+        double allocations = 0.0; ///< Largest allowed growth in allocs_per_op and bytes_per_op.
+    };
+
+    /**
+     * @brief Parse thresholds written as comma-separated "metric:percent" pairs, for example "ops:5,latency:10,allocs:0".
+     * Metrics not named keep the value already in @p out.
+     * @return False if a pair is malformed, names an unknown metric or gives a negative percentage.
+     */
+    [[nodiscard]] bool parseCompareThresholds(std::string_view text, CompareThresholds& out);
+
+    /// One figure of one result, in both reports.
+    struct PerfDelta
+    {
+        std::string name; ///< Result name.
+        std::string metric; ///< Field name as in the schema, with latency percentiles written "latency_us.p99".
+        double baseline = 0.0;
+        double candidate = 0.0;
+        double change = 0.0; ///< (candidate - baseline) / baseline; 0 when the baseline is 0.
+        bool isRegression = false;
+    };
+
+    /// Every figure two reports have in common, and the results only one of them has.
+    struct PerfComparison
+    {
+        std::vector<PerfDelta> deltas; ///< In baseline result order, then schema field order.
+        std::vector<std::string> missing; ///< Results in the baseline but not in the candidate.
+        std::vector<std::string> added; ///< Results in the candidate but not in the baseline.
+
+        [[nodiscard]] bool hasRegressed() const;
+    };
+
+    /**
+     * @brief Compare each figure of each result present in both reports.
+     * Throughput regresses when it falls below the baseline by more than its threshold, and every other figure when
+     * it rises above the baseline by more than its. A figure only one report has is not compared, and a missing result
+     * is listed but is not a regression, so renaming a benchmark does not fail a comparison.
+     */
+    [[nodiscard]] PerfComparison comparePerfReports(
+        const PerfReport& baseline, const PerfReport& candidate, const CompareThresholds& thresholds);
+
+    /// Render a comparison as a table, one line per figure, with regressions marked.
+    [[nodiscard]] std::string formatComparison(const PerfComparison& comparison);
+
+    /**
+     * @brief The compare mode of both tools: load two result files, print the comparison to stdout and any error to
+     * stderr.
+     * @return 0 if nothing regressed, 1 if something did, 2 if a file could not be read.
+     */
+    int runComparison(const std::string& baselinePath, const std::string& candidatePath, const CompareThresholds& thresholds);
+} // namespace reactormq::perf
@@ -0,0 +1,193 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/system/buffer_pool.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <map>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if REACTORMQ_PLATFORM_LINUX
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace reactormq::system
+{
+    BufferPool& BufferPool::getForCurrentThread(const mqtt::BufferMemoryOptions& options)
+    {
+        // Pools are never destroyed: a ring may release its block during static destruction.
+        static std::mutex mutex;
+        static auto* const pools = new std::map<std::pair<bool, std::optional<std::uint32_t>>, std::unique_ptr<BufferPool>>();
+
+        const std::optional<std::uint32_t> node = options.numaLocal ? std::optional{ getCurrentNumaNode() } : std::nullopt;
+        std::scoped_lock lock(mutex);
+        std::unique_ptr<BufferPool>& pool = (*pools)[{ options.hugePages, node }];
+        if (!pool)
+        {
+            pool = std::make_unique<BufferPool>(options.hugePages, node);
+        }
+        return *pool;
+    }
+
+    std::uint32_t BufferPool::getCurrentNumaNode()
+    {
+#if REACTORMQ_PLATFORM_LINUX
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        {
+            return node;
+        }
+#endif
+        return 0;
+    }
+
+    BufferPool::BufferPool(const bool hugePages, const std::optional<std::uint32_t> numaNode)
+        : m_hugePages(hugePages)
+        , m_numaNode(numaNode)
+    {
+    }
+
+    std::uint8_t* BufferPool::allocate(size_t size)
+    {
+        size = std::max(size, kMinBlockSize);
+        std::scoped_lock lock(m_mutex);
+        if (size >= kChunkSize)
+        {
+            std::uint8_t* block = map(size);
+            m_mappedBytes += nullptr != block ? size : 0;
+            return block;
+        }
+
+        std::vector<std::uint8_t*>& freeBlocks = m_freeBlocks[getSizeClass(size)];
+        if (freeBlocks.empty())
+        {
+            std::uint8_t* chunk = map(kChunkSize);
+            if (nullptr == chunk)
+            {
+                return nullptr;
+            }
+            m_mappedBytes += kChunkSize;
+
+            // Pushed last block first, so blocks are handed out from the start of the chunk.
+            freeBlocks.reserve(freeBlocks.size() + kChunkSize / size);
+            for (size_t offset = kChunkSize; offset > 0; offset -= size)
+            {
+                freeBlocks.push_back(chunk + offset - size);
+            }
+        }
+
+        std::uint8_t* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        return block;
+    }
+
+    void BufferPool::release(std::uint8_t* block, size_t size)
+    {
+        if (nullptr == block)
+        {
+            return;
+        }
+
+        size = std::max(size, kMinBlockSize);
+        std::scoped_lock lock(m_mutex);
+        if (size >= kChunkSize)
+        {
+            unmap(block, size);
+            m_mappedBytes -= size;
+            return;
+        }
+        m_freeBlocks[getSizeClass(size)].push_back(block);
+    }
+
+    size_t BufferPool::getMappedBytes() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_mappedBytes;
+    }
+
+    size_t BufferPool::getSizeClass(const size_t size)
+    {
+        return static_cast<size_t>(std::countr_zero(size) - std::countr_zero(kMinBlockSize));
+    }
+
+#if REACTORMQ_PLATFORM_LINUX
+    std::uint8_t* BufferPool::map(const size_t size)
+    {
+        constexpr int kProtection = PROT_READ | PROT_WRITE;
+        void* block = MAP_FAILED;
+        if (m_hugePages)
+        {
+            block = mmap(nullptr, size, kProtection, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+
+        if (block == MAP_FAILED)
+        {
+            // Transparent huge pages need a 2 MiB aligned range, so map one chunk more and trim both ends.
+            const size_t padded = size + kChunkSize;
+            void* raw = mmap(nullptr, padded, kProtection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Error, "BufferPool::map() mmap of %zu bytes failed", padded);
+                return nullptr;
+            }
+
+            const auto start = reinterpret_cast<std::uintptr_t>(raw);
+            const std::uintptr_t aligned = (start + kChunkSize - 1) & ~static_cast<std::uintptr_t>(kChunkSize - 1);
+            if (aligned != start)
+            {
+                munmap(raw, aligned - start);
+            }
+            if (const std::uintptr_t end = aligned + size; end != start + padded)
+            {
+                munmap(reinterpret_cast<void*>(end), start + padded - end);
+            }
+            block = reinterpret_cast<void*>(aligned);
+
+            if (m_hugePages)
+            {
+                (void)madvise(block, size, MADV_HUGEPAGE);
+            }
+        }
+
+        if (m_numaNode)
+        {
+            // Bound before the first touch, so every page is placed on the node.
+            constexpr size_t kBitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+            std::vector<unsigned long> nodeMask(*m_numaNode / kBitsPerWord + 1, 0);
+            nodeMask[*m_numaNode / kBitsPerWord] |= 1UL << (*m_numaNode % kBitsPerWord);
+            if (syscall(SYS_mbind, block, size, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * kBitsPerWord + 1, 0) != 0)
+            {
+                REACTORMQ_LOG(logging::LogLevel::Debug, "BufferPool::map() mbind to node %u failed", *m_numaNode);
+            }
+        }
+
+        return static_cast<std::uint8_t*>(block);
+    }
+
+    void BufferPool::unmap(std::uint8_t* block, const size_t size)
+    {
+        munmap(block, size);
+    }
+#else
+    std::uint8_t* BufferPool::map(const size_t size)
+    {
+        return static_cast<std::uint8_t*>(::operator new(size, std::align_val_t{ kChunkSize }, std::nothrow));
+    }
+
+    void BufferPool::unmap(std::uint8_t* block, const size_t size)
+    {
+        ::operator delete(block, size, std::align_val_t{ kChunkSize });
+    }
+#endif
+} // namespace reactormq::system
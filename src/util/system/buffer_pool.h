@@ -0,0 +1,88 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/buffer_memory_options.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace reactormq::system
+{
+    /**
+     * @brief Pool of power-of-two byte blocks carved from 2 MiB page-aligned chunks, for socket ring storage.
+     *
+     * Blocks from 4 KiB to 1 MiB come from per-size free lists; a chunk is split into blocks of one size when its list
+     * runs dry, and released blocks go back on the list rather than to the operating system. Larger blocks are mapped
+     * on their own and unmapped on release. Chunks may be huge pages and bound to one NUMA node. Rings only take or
+     * return a block when they grow or close, so one mutex covers the pool. Pools live for the whole process.
+     */
+    class BufferPool final
+    {
+    public:
+        /// @brief Size of a pool chunk, and of a huge page.
+        static constexpr size_t kChunkSize = 2 * 1024 * 1024;
+
+        /// @brief Smallest block; smaller requests are rounded up to it.
+        static constexpr size_t kMinBlockSize = 4 * 1024;
+
+        /**
+         * @brief Pool for the calling thread: the one for its NUMA node when options ask for NUMA-local memory.
+         * @param options Buffer memory options; isPooled() must be true.
+         * @return Pool shared by every thread with the same options on the same node.
+         */
+        static BufferPool& getForCurrentThread(const mqtt::BufferMemoryOptions& options);
+
+        /**
+         * @brief NUMA node of the CPU the calling thread is running on.
+         * @return Node index; 0 where the platform does not say.
+         */
+        [[nodiscard]] static std::uint32_t getCurrentNumaNode();
+
+        /**
+         * @param hugePages Back chunks with huge pages.
+         * @param numaNode Node to bind chunks to; empty leaves placement to the kernel.
+         */
+        BufferPool(bool hugePages, std::optional<std::uint32_t> numaNode);
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /**
+         * @brief Take a block.
+         * @param size Requested size; must be a power of two.
+         * @return Block of size bytes (at least kMinBlockSize), or nullptr if the memory could not be mapped.
+         */
+        [[nodiscard]] std::uint8_t* allocate(size_t size);
+
+        /**
+         * @brief Give a block back.
+         * @param block Block from allocate().
+         * @param size Size it was allocated with.
+         */
+        void release(std::uint8_t* block, size_t size);
+
+        /// @brief Bytes mapped from the operating system, chunks and large blocks alike.
+        [[nodiscard]] size_t getMappedBytes() const;
+
+    private:
+        static constexpr size_t kSizeClasses = 9; ///< 4 KiB to 1 MiB.
+
+        [[nodiscard]] static size_t getSizeClass(size_t size);
+
+        [[nodiscard]] std::uint8_t* map(size_t size);
+        static void unmap(std::uint8_t* block, size_t size);
+
+        const bool m_hugePages;
+        const std::optional<std::uint32_t> m_numaNode;
+        mutable std::mutex m_mutex;
+        std::array<std::vector<std::uint8_t*>, kSizeClasses> m_freeBlocks;
+        size_t m_mappedBytes = 0;
+    };
+} // namespace reactormq::system
@@ -0,0 +1,261 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/system/thread_placement.h"
+
+#include <cstdint>
+#include <string>
+
+#if REACTORMQ_WITH_UE5
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#elif REACTORMQ_PLATFORM_WINDOWS_FAMILY
+#include <Windows.h>
+#elif REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif REACTORMQ_PLATFORM_DARWIN_FAMILY
+#include <pthread.h>
+#include <pthread/qos.h>
+#endif
+
+namespace reactormq::system
+{
+    namespace
+    {
+        using mqtt::ThreadPriority;
+
+        /// Affinity as a bit mask, for the platforms that take one; false if a core does not fit in 64 bits.
+        [[maybe_unused]] bool toAffinityMask(const mqtt::ThreadPlacement& placement, std::uint64_t& outMask)
+        {
+            outMask = 0;
+            for (const std::uint32_t core : placement.cores)
+            {
+                if (core >= 64)
+                {
+                    return false;
+                }
+                outMask |= std::uint64_t{ 1 } << core;
+            }
+            return true;
+        }
+
+#if REACTORMQ_WITH_UE5
+        EThreadPriority toUePriority(const ThreadPriority priority)
+        {
+            switch (priority)
+            {
+            case ThreadPriority::BelowNormal:
+                return TPri_BelowNormal;
+            case ThreadPriority::AboveNormal:
+                return TPri_AboveNormal;
+            case ThreadPriority::Highest:
+                return TPri_Highest;
+            case ThreadPriority::TimeCritical:
+                return TPri_TimeCritical;
+            default:
+                return TPri_Normal;
+            }
+        }
+
+        bool applyName(const std::string& name)
+        {
+            FPlatformProcess::SetThreadName(UTF8_TO_TCHAR(name.c_str()));
+            return true;
+        }
+
+        bool applyAffinity(const mqtt::ThreadPlacement& placement)
+        {
+            std::uint64_t mask = 0;
+            if (!toAffinityMask(placement, mask))
+            {
+                return false;
+            }
+            FPlatformProcess::SetThreadAffinityMask(mask);
+            return true;
+        }
+
+        bool applyPriority(const ThreadPriority priority)
+        {
+            // Only threads the engine started have an FRunnableThread to carry the priority.
+            FRunnableThread* thread = FRunnableThread::GetRunnableThread();
+            if (thread == nullptr)
+            {
+                return false;
+            }
+            thread->SetThreadPriority(toUePriority(priority));
+            return true;
+        }
+#elif REACTORMQ_PLATFORM_WINDOWS_FAMILY
+        bool applyName(const std::string& name)
+        {
+            const int length = MultiByteToWideChar(CP_UTF8, 0, name.data(), static_cast<int>(name.size()), nullptr, 0);
+            std::wstring wide(static_cast<size_t>(length), L'\0');
+            MultiByteToWideChar(CP_UTF8, 0, name.data(), static_cast<int>(name.size()), wide.data(), length);
+            return SUCCEEDED(SetThreadDescription(GetCurrentThread(), wide.c_str()));
+        }
+
+        bool applyAffinity(const mqtt::ThreadPlacement& placement)
+        {
+            std::uint64_t mask = 0;
+            return toAffinityMask(placement, mask) && SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+        }
+
+        bool applyPriority(const ThreadPriority priority)
+        {
+            int level = THREAD_PRIORITY_NORMAL;
+            switch (priority)
+            {
+            case ThreadPriority::BelowNormal:
+                level = THREAD_PRIORITY_BELOW_NORMAL;
+                break;
+            case ThreadPriority::AboveNormal:
+                level = THREAD_PRIORITY_ABOVE_NORMAL;
+                break;
+            case ThreadPriority::Highest:
+                level = THREAD_PRIORITY_HIGHEST;
+                break;
+            case ThreadPriority::TimeCritical:
+                level = THREAD_PRIORITY_TIME_CRITICAL;
+                break;
+            default:
+                break;
+            }
+            return SetThreadPriority(GetCurrentThread(), level) != 0;
+        }
+#elif REACTORMQ_PLATFORM_LINUX || REACTORMQ_PLATFORM_ANDROID
+        bool applyName(const std::string& name)
+        {
+            // The kernel keeps 15 characters and the terminator.
+            return pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) == 0;
+        }
+
+        bool applyAffinity(const mqtt::ThreadPlacement& placement)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (const std::uint32_t core : placement.cores)
+            {
+                if (core >= CPU_SETSIZE)
+                {
+                    return false;
+                }
+                CPU_SET(core, &set);
+            }
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+        }
+
+        bool applyPriority(const ThreadPriority priority)
+        {
+            if (priority == ThreadPriority::TimeCritical)
+            {
+                sched_param param{};
+                param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+                return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+            }
+
+            // Linux keeps a nice value per thread; raising it above the default needs CAP_SYS_NICE or RLIMIT_NICE.
+            int nice = 0;
+            switch (priority)
+            {
+            case ThreadPriority::BelowNormal:
+                nice = 5;
+                break;
+            case ThreadPriority::AboveNormal:
+                nice = -5;
+                break;
+            case ThreadPriority::Highest:
+                nice = -10;
+                break;
+            default:
+                break;
+            }
+            return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) == 0;
+        }
+#elif REACTORMQ_PLATFORM_DARWIN_FAMILY
+        bool applyName(const std::string& name)
+        {
+            return pthread_setname_np(name.c_str()) == 0;
+        }
+
+        bool applyAffinity(const mqtt::ThreadPlacement&)
+        {
+            // Darwin has affinity tags, not cores; there is nothing to pin to.
+            return false;
+        }
+
+        bool applyPriority(const ThreadPriority priority)
+        {
+            qos_class_t qos = QOS_CLASS_DEFAULT;
+            switch (priority)
+            {
+            case ThreadPriority::BelowNormal:
+                qos = QOS_CLASS_UTILITY;
+                break;
+            case ThreadPriority::AboveNormal:
+                qos = QOS_CLASS_USER_INITIATED;
+                break;
+            case ThreadPriority::Highest:
+            case ThreadPriority::TimeCritical:
+                qos = QOS_CLASS_USER_INTERACTIVE;
+                break;
+            default:
+                break;
+            }
+            return pthread_set_qos_class_self_np(qos, 0) == 0;
+        }
+#else
+        bool applyName(const std::string&)
+        {
+            return false;
+        }
+
+        bool applyAffinity(const mqtt::ThreadPlacement&)
+        {
+            return false;
+        }
+
+        bool applyPriority(ThreadPriority)
+        {
+            return false;
+        }
+#endif
+    } // namespace
+
+    bool applyThreadPlacement(const mqtt::ThreadPlacement& placement)
+    {
+        bool isComplete = true;
+        if (!placement.name.empty())
+        {
+            isComplete = applyName(placement.name) && isComplete;
+        }
+        if (!placement.cores.empty())
+        {
+            isComplete = applyAffinity(placement) && isComplete;
+        }
+        if (placement.priority != ThreadPriority::Normal)
+        {
+            isComplete = applyPriority(placement.priority) && isComplete;
+        }
+        return isComplete;
+    }
+
+    mqtt::ThreadPlacement getPoolThreadPlacement(const mqtt::ThreadPlacement& placement, const size_t index)
+    {
+        mqtt::ThreadPlacement thread;
+        if (!placement.name.empty())
+        {
+            thread.name = placement.name + "-" + std::to_string(index);
+        }
+        if (!placement.cores.empty())
+        {
+            thread.cores.push_back(placement.cores[index % placement.cores.size()]);
+        }
+        thread.priority = placement.priority;
+        return thread;
+    }
+} // namespace reactormq::system
@@ -0,0 +1,29 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "reactormq/mqtt/thread_placement.h"
+
+#include <cstddef>
+
+namespace reactormq::system
+{
+    /**
+     * @brief Apply a placement to the calling thread: name, core affinity and priority, each only if asked for.
+     * Settings the platform refuses are skipped; the others still apply.
+     * @param placement What to apply.
+     * @return True if every requested setting took effect.
+     */
+    bool applyThreadPlacement(const mqtt::ThreadPlacement& placement);
+
+    /**
+     * @brief Placement of one thread of a pool: the name gets a "-<index>" suffix and the thread is pinned to one
+     * core, taken from the list in order and wrapping around.
+     * @param placement Placement given for the pool.
+     * @param index Thread index within the pool.
+     * @return Placement for that thread.
+     */
+    mqtt::ThreadPlacement getPoolThreadPlacement(const mqtt::ThreadPlacement& placement, size_t index);
+} // namespace reactormq::system
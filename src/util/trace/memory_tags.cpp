@@ -0,0 +1,12 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/trace/memory_tags.h"
+
+#if REACTORMQ_WITH_UE5
+LLM_DEFINE_TAG(ReactorMQ);
+LLM_DEFINE_TAG(ReactorMQ_Socket, TEXT("Socket"), TEXT("ReactorMQ"));
+LLM_DEFINE_TAG(ReactorMQ_Payload, TEXT("Payload"), TEXT("ReactorMQ"));
+LLM_DEFINE_TAG(ReactorMQ_InFlight, TEXT("InFlight"), TEXT("ReactorMQ"));
+#endif
@@ -0,0 +1,34 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+// Memory tags, so a UE build can attribute the client's allocations in the Low-Level Memory tracker.
+//
+// REACTORMQ_MEMORY_SCOPE(tag) charges allocations made on the current thread to tag until the end of the enclosing
+// block; an inner scope overrides an outer one. The tags are:
+//   ReactorMQ           everything the client allocates that no sub-tag claims (commands, state, callbacks)
+//   ReactorMQ_Socket    socket and TLS buffers
+//   ReactorMQ_Payload   received message topics and payloads
+//   ReactorMQ_InFlight  publishes, subscribes and unsubscribes waiting for their acknowledgement
+//
+// UE routes every allocation in the module through FMemory, so a scope is enough and no allocator adapter is needed.
+// Outside UE, or in UE builds with LLM compiled out, the macro expands to nothing.
+
+#if REACTORMQ_WITH_UE5
+
+#include "HAL/LowLevelMemTracker.h"
+
+LLM_DECLARE_TAG(ReactorMQ);
+LLM_DECLARE_TAG(ReactorMQ_Socket);
+LLM_DECLARE_TAG(ReactorMQ_Payload);
+LLM_DECLARE_TAG(ReactorMQ_InFlight);
+
+#define REACTORMQ_MEMORY_SCOPE(tag) LLM_SCOPE_BYTAG(tag)
+
+#else
+
+#define REACTORMQ_MEMORY_SCOPE(tag) static_cast<void>(0)
+
+#endif
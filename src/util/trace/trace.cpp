@@ -0,0 +1,22 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/trace_categories.h"
+#include "util/trace/trace.h"
+
+#if REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_PERFETTO
+PERFETTO_TRACK_EVENT_STATIC_STORAGE_IN_NAMESPACE(reactormq);
+#elif REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_UNREAL
+UE_TRACE_CHANNEL_DEFINE(ReactorMQChannel)
+#endif
+
+namespace reactormq::mqtt
+{
+    void registerTraceCategories()
+    {
+#if REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_PERFETTO
+        reactormq::TrackEvent::Register();
+#endif
+    }
+} // namespace reactormq::mqtt
@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+// Scoped trace markers for frame profilers, so a game can see how much of its frame the client takes.
+//
+// REACTORMQ_TRACE_BACKEND picks the backend at build time:
+//   0 (none, the default): the macros expand to nothing.
+//   1 (Tracy): zones through tracy/Tracy.hpp; the application links TracyClient built with TRACY_ENABLE.
+//   2 (Unreal Insights): CPU profiler events on ReactorMQChannel, which costs one branch per scope while the channel is
+//     off; enable it with -trace=cpu,ReactorMQ.
+//   3 (Perfetto): track events in the "reactormq" category; the application calls reactormq::registerTraceCategories()
+//     after perfetto::Tracing::Initialize().
+//
+// Both macros open a scope that lasts until the end of the enclosing block, so use them as a statement at block
+// scope. Names must be string literals; REACTORMQ_TRACE_SCOPE_TEXT also attaches a runtime string (a state name, say)
+// where the backend can show one.
+
+#define REACTORMQ_TRACE_BACKEND_NONE 0
+#define REACTORMQ_TRACE_BACKEND_TRACY 1
+#define REACTORMQ_TRACE_BACKEND_UNREAL 2
+#define REACTORMQ_TRACE_BACKEND_PERFETTO 3
+
+#ifndef REACTORMQ_TRACE_BACKEND
+#define REACTORMQ_TRACE_BACKEND REACTORMQ_TRACE_BACKEND_NONE
+#endif
+
+#if REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_TRACY
+
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+#define REACTORMQ_TRACE_SCOPE(name) ZoneScopedN(name)
+#define REACTORMQ_TRACE_SCOPE_TEXT(name, text)                                                                                             \
+    ZoneScopedN(name);                                                                                                                     \
+    ZoneText((text), std::strlen((text)))
+
+#elif REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_UNREAL
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+UE_TRACE_CHANNEL_EXTERN(ReactorMQChannel)
+
+// CPU profiler events carry only a name, so the text is dropped.
+#define REACTORMQ_TRACE_SCOPE(name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(name, ReactorMQChannel)
+#define REACTORMQ_TRACE_SCOPE_TEXT(name, text) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(name, ReactorMQChannel)
+
+#elif REACTORMQ_TRACE_BACKEND == REACTORMQ_TRACE_BACKEND_PERFETTO
+
+#include <perfetto.h>
+
+// Defined in namespace reactormq rather than perfetto so the application's own categories do not collide with ours;
+// code anywhere under reactormq:: finds them by ordinary lookup.
+PERFETTO_DEFINE_CATEGORIES_IN_NAMESPACE(reactormq, perfetto::Category("reactormq").SetDescription("ReactorMQ MQTT client"));
+
+#define REACTORMQ_TRACE_SCOPE(name) TRACE_EVENT("reactormq", name)
+#define REACTORMQ_TRACE_SCOPE_TEXT(name, text) TRACE_EVENT("reactormq", name, "text", (text))
+
+#else
+
+#define REACTORMQ_TRACE_SCOPE(name) static_cast<void>(0)
+#define REACTORMQ_TRACE_SCOPE_TEXT(name, text) static_cast<void>(0)
+
+#endif
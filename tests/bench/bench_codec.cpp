@@ -0,0 +1,121 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/packets/properties/properties.h"
+#include "serialize/bytes.h"
+#include "serialize/mqtt_codec.h"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace reactormq::mqtt::packets::properties;
+using namespace reactormq::serialize;
+
+namespace
+{
+    /// One value per encoded width: 1, 2, 3 and 4 bytes.
+    constexpr std::uint32_t kVariableByteValues[] = { 100u, 16'000u, 2'000'000u, 268'000'000u };
+
+    void BM_EncodeVariableByteInteger(benchmark::State& state)
+    {
+        const std::uint32_t value = kVariableByteValues[state.range(0)];
+        std::vector<std::byte> buffer;
+        buffer.reserve(8);
+        for (auto _ : state)
+        {
+            buffer.clear();
+            const ByteWriter writer(buffer);
+            encodeVariableByteInteger(value, writer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    BENCHMARK(BM_EncodeVariableByteInteger)->DenseRange(0, 3);
+
+    void BM_DecodeVariableByteInteger(benchmark::State& state)
+    {
+        std::vector<std::byte> buffer;
+        const ByteWriter writer(buffer);
+        encodeVariableByteInteger(kVariableByteValues[state.range(0)], writer);
+        for (auto _ : state)
+        {
+            ByteReader reader(buffer.data(), buffer.size());
+            benchmark::DoNotOptimize(decodeVariableByteInteger(reader));
+        }
+    }
+    BENCHMARK(BM_DecodeVariableByteInteger)->DenseRange(0, 3);
+
+    void BM_EncodeString(benchmark::State& state)
+    {
+        const std::string text(static_cast<size_t>(state.range(0)), 'a');
+        std::vector<std::byte> buffer;
+        buffer.reserve(text.size() + 2);
+        for (auto _ : state)
+        {
+            buffer.clear();
+            const ByteWriter writer(buffer);
+            benchmark::DoNotOptimize(encodeString(text, writer));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(BM_EncodeString)->Arg(8)->Arg(64)->Arg(1024);
+
+    void BM_DecodeString(benchmark::State& state)
+    {
+        std::vector<std::byte> buffer;
+        const ByteWriter writer(buffer);
+        encodeString(std::string(static_cast<size_t>(state.range(0)), 'a'), writer);
+        std::string out;
+        for (auto _ : state)
+        {
+            ByteReader reader(buffer.data(), buffer.size());
+            benchmark::DoNotOptimize(decodeString(reader, out));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(BM_DecodeString)->Arg(8)->Arg(64)->Arg(1024);
+
+    /// Properties typical of a MQTT 5 PUBLISH: content type, message expiry and two user properties.
+    Properties makePublishProperties()
+    {
+        return Properties{ {
+            Property::create<PropertyIdentifier::ContentType, std::string>("application/json"),
+            Property::create<PropertyIdentifier::MessageExpiryInterval>(std::uint32_t{ 3600 }),
+            Property::create<PropertyIdentifier::UserProperty, std::pair<std::string, std::string>>({ "trace-id", "0af7651916cd43dd" }),
+            Property::create<PropertyIdentifier::UserProperty, std::pair<std::string, std::string>>({ "origin", "sensor-17" }),
+        } };
+    }
+
+    void BM_EncodeProperties(benchmark::State& state)
+    {
+        const Properties properties = makePublishProperties();
+        std::vector<std::byte> buffer;
+        buffer.reserve(properties.getLength(true));
+        for (auto _ : state)
+        {
+            buffer.clear();
+            ByteWriter writer(buffer);
+            properties.encode(writer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    BENCHMARK(BM_EncodeProperties);
+
+    void BM_DecodeProperties(benchmark::State& state)
+    {
+        std::vector<std::byte> buffer;
+        ByteWriter writer(buffer);
+        makePublishProperties().encode(writer);
+        for (auto _ : state)
+        {
+            ByteReader reader(buffer.data(), buffer.size());
+            const Properties properties(reader);
+            benchmark::DoNotOptimize(properties.getProperties().data());
+        }
+    }
+    BENCHMARK(BM_DecodeProperties);
+} // namespace
@@ -0,0 +1,58 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "bench/bench_report.h"
+#include "fixtures/allocation_counter.h"
+#include "mqtt/client/context.h"
+#include "mqtt/client/reactor.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using reactormq::mqtt::client::createClient;
+using reactormq::tests::AllocationScope;
+
+namespace
+{
+    /**
+     * Create idle clients that never connect, as a rig simulating many devices does, and report what each one costs:
+     * its heap bytes and allocations, and the size of its context and reactor. Heap bytes stand in for resident memory:
+     * an in-process RSS delta mostly measures how much the allocator reuses.
+     * Argument: number of clients.
+     */
+    void BM_IdleClientFootprint(benchmark::State& state)
+    {
+        const auto clientCount = static_cast<size_t>(state.range(0));
+        const ConnectionSettingsPtr settings = ConnectionSettingsBuilder("127.0.0.1").setClientId("reactormq-bench").build();
+
+        reactormq::tests::AllocationCounts total;
+        for (auto _ : state)
+        {
+            std::vector<std::shared_ptr<IClient>> clients;
+            clients.reserve(clientCount);
+
+            const AllocationScope scope;
+            for (size_t i = 0; i < clientCount; ++i)
+            {
+                clients.push_back(createClient(settings));
+            }
+            total.allocations += scope.getCounts().allocations;
+            total.bytes += scope.getCounts().bytes;
+            benchmark::DoNotOptimize(clients.data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * clientCount));
+        state.counters["sizeof_context"] = static_cast<double>(sizeof(client::Context));
+        state.counters["sizeof_reactor"] = static_cast<double>(sizeof(client::Reactor));
+        reactormq::tests::setAllocationCounters(state, total, state.iterations() * clientCount);
+    }
+    BENCHMARK(BM_IdleClientFootprint)->Arg(1000)->ArgName("clients")->Unit(benchmark::kMillisecond);
+} // namespace
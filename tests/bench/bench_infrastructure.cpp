@@ -0,0 +1,210 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/command.h"
+#include "mqtt/client/reactor.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/delegates.h"
+#include "util/logging/console_sink.h"
+#include "util/logging/logging.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::logging::LogLevel;
+using reactormq::logging::LogMessage;
+using reactormq::logging::Registry;
+using reactormq::logging::Sink;
+
+namespace
+{
+    /// Broadcast to N listeners that each add the argument to a counter. Argument: listener count.
+    void BM_DelegateBroadcast(benchmark::State& state)
+    {
+        const auto listenerCount = static_cast<size_t>(state.range(0));
+        MulticastDelegate<void(int)> delegate;
+        std::vector<DelegateHandle> handles;
+        std::int64_t sum = 0;
+        for (size_t i = 0; i < listenerCount; ++i)
+        {
+            handles.push_back(delegate.add(
+                [&sum](const int value)
+                {
+                    sum += value;
+                }));
+        }
+
+        int value = 0;
+        for (auto _ : state)
+        {
+            delegate.broadcast(++value);
+        }
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * listenerCount));
+    }
+
+    BENCHMARK(BM_DelegateBroadcast)->Arg(1)->Arg(4)->Arg(64);
+
+    /**
+     * Connect a listener and disconnect it through its DelegateHandle, from several threads on one delegate that
+     * already has 64 listeners, so the changes contend for the delegate's lock alongside a realistic slot count.
+     */
+    void BM_DelegateHandleDisconnectContended(benchmark::State& state)
+    {
+        static std::unique_ptr<MulticastDelegate<void(int)>> s_delegate;
+        static std::vector<DelegateHandle> s_standing;
+        if (state.thread_index() == 0)
+        {
+            s_delegate = std::make_unique<MulticastDelegate<void(int)>>();
+            for (int i = 0; i < 64; ++i)
+            {
+                s_standing.push_back(s_delegate->add([](int) {}));
+            }
+        }
+
+        for (auto _ : state)
+        {
+            DelegateHandle handle = s_delegate->add([](int) {});
+            handle.disconnect();
+        }
+
+        if (state.thread_index() == 0)
+        {
+            s_standing.clear();
+            s_delegate.reset();
+        }
+    }
+
+    BENCHMARK(BM_DelegateHandleDisconnectContended)->ThreadRange(1, 8)->UseRealTime();
+
+    /// Takes every message and does nothing with it, so only the registry's own work is measured.
+    class NullSink final : public Sink
+    {
+    public:
+        void log(const LogMessage& msg) override
+        {
+            benchmark::DoNotOptimize(msg.text.data());
+        }
+    };
+
+    /// Swaps the registry's sinks for N null sinks at a level, and puts a console sink back at Error afterwards.
+    class ScopedNullSinks final
+    {
+    public:
+        ScopedNullSinks(const size_t sinkCount, const LogLevel level)
+        {
+            Registry& registry = Registry::instance();
+            registry.removeAllSinks();
+            for (size_t i = 0; i < sinkCount; ++i)
+            {
+                registry.addSink(std::make_shared<NullSink>());
+            }
+            registry.setLevel(level);
+        }
+
+        ~ScopedNullSinks()
+        {
+            Registry& registry = Registry::instance();
+            registry.removeAllSinks();
+            registry.addSink(std::make_shared<reactormq::logging::ConsoleSink>());
+            registry.setLevel(LogLevel::Error);
+        }
+
+        ScopedNullSinks(const ScopedNullSinks&) = delete;
+        ScopedNullSinks& operator=(const ScopedNullSinks&) = delete;
+    };
+
+    /// A call below the registry's level: the cost every filtered-out log line in the hot paths pays.
+    void BM_LogDisabled(benchmark::State& state)
+    {
+        const ScopedNullSinks sinks(1, LogLevel::Error);
+        int value = 0;
+        for (auto _ : state)
+        {
+            REACTORMQ_LOG(LogLevel::Warn, "Reactor::tick() queued command (queueSize=%d)", ++value);
+        }
+    }
+
+    BENCHMARK(BM_LogDisabled);
+
+    /// A call that passes the level, formatted and handed to each sink on the calling thread. Argument: sink count.
+    void BM_LogEnabledSync(benchmark::State& state)
+    {
+        const ScopedNullSinks sinks(static_cast<size_t>(state.range(0)), LogLevel::Warn);
+        int value = 0;
+        for (auto _ : state)
+        {
+            REACTORMQ_LOG(LogLevel::Warn, "Reactor::tick() queued command (queueSize=%d)", ++value);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    BENCHMARK(BM_LogEnabledSync)->Arg(1)->Arg(4);
+
+    /**
+     * A call that passes the level in async mode: the calling thread only copies a record into the ring. Argument:
+     * sink count, which only the background thread pays for. Drops when the ring is full are reported, not waited on.
+     */
+    void BM_LogEnabledAsync(benchmark::State& state)
+    {
+        const ScopedNullSinks sinks(static_cast<size_t>(state.range(0)), LogLevel::Warn);
+        Registry& registry = Registry::instance();
+        const std::uint64_t droppedBefore = registry.getDroppedCount();
+        registry.startAsync();
+        int value = 0;
+        for (auto _ : state)
+        {
+            REACTORMQ_LOG(LogLevel::Warn, "Reactor::tick() queued command (queueSize=%d)", ++value);
+        }
+        registry.stopAsync();
+        state.counters["dropped"] = static_cast<double>(registry.getDroppedCount() - droppedBefore);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    BENCHMARK(BM_LogEnabledAsync)->Arg(1)->Arg(4);
+
+    /**
+     * Reactor::enqueueCommand from 1 to 16 producer threads while the reactor thread drains the queue, as API calls
+     * from many application threads do. The command is a DISCONNECT with no one waiting, which allocates nothing, so
+     * the queue's own cost is what is measured.
+     */
+    void BM_ReactorEnqueueCommand(benchmark::State& state)
+    {
+        static std::shared_ptr<Reactor> s_reactor;
+        static std::jthread s_consumer;
+        if (state.thread_index() == 0)
+        {
+            s_reactor = std::make_shared<Reactor>(ConnectionSettingsBuilder("localhost").build());
+            s_consumer = std::jthread(
+                [reactor = s_reactor](const std::stop_token& stopToken)
+                {
+                    while (!stopToken.stop_requested())
+                    {
+                        reactor->tick();
+                    }
+                });
+        }
+
+        for (auto _ : state)
+        {
+            s_reactor->enqueueCommand(DisconnectCommand{});
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+        if (state.thread_index() == 0)
+        {
+            s_consumer = std::jthread();
+            s_reactor.reset();
+        }
+    }
+
+    BENCHMARK(BM_ReactorEnqueueCommand)->ThreadRange(1, 16)->UseRealTime();
+} // namespace
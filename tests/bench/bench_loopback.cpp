@@ -0,0 +1,210 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "bench/bench_report.h"
+#include "fixtures/allocation_counter.h"
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using reactormq::mqtt::client::createClient;
+using reactormq::tests::AllocationScope;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    constexpr auto kTopic = "bench/loopback";
+
+    /// Tick until @p isDone holds; false after 10 s, which only a broken broker or client takes.
+    template<typename Predicate>
+    bool tickUntil(IClient& client, Predicate&& isDone)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!isDone())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            client.waitAndTick(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /// A broker and a client connected to it, torn down with the benchmark.
+    struct LoopbackSession
+    {
+        LoopbackBroker broker;
+        std::shared_ptr<IClient> client;
+
+        bool connect()
+        {
+            const uint16_t port = broker.start(0);
+            if (port == 0)
+            {
+                return false;
+            }
+
+            client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                      .setPort(port)
+                                      .setProtocol(ConnectionProtocol::Tcp)
+                                      .setClientId("reactormq-bench")
+                                      .build());
+            auto connected = client->connectAsync(true);
+            return tickUntil(
+                       *client,
+                       [&connected]
+                       {
+                           return connected.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                       })
+                && connected.get().hasSucceeded();
+        }
+
+        ~LoopbackSession()
+        {
+            if (client)
+            {
+                auto disconnected = client->disconnectAsync();
+                (void)tickUntil(
+                    *client,
+                    [&disconnected]
+                    {
+                        return disconnected.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                    });
+            }
+        }
+    };
+
+    /// Report the client's own publish latency percentiles for @p qos alongside the benchmark's timings.
+    void reportLatency(benchmark::State& state, const IClient& client, const QualityOfService qos)
+    {
+        const ClientMetrics metrics = client.getMetrics();
+        const LatencyHistogram& total = metrics.publishLatency[static_cast<size_t>(qos)].total;
+        state.counters["p50_us"] = static_cast<double>(total.getValueAtPercentile(50.0));
+        state.counters["p99_us"] = static_cast<double>(total.getValueAtPercentile(99.0));
+        state.counters["p999_us"] = static_cast<double>(total.getValueAtPercentile(99.9));
+    }
+
+    /**
+     * Publish a window of messages and wait for all of them to complete: sent for QoS 0, acknowledged for QoS 1/2.
+     * Arguments: QoS, payload size.
+     */
+    void BM_LoopbackPublishThroughput(benchmark::State& state)
+    {
+        constexpr size_t kWindow = 256;
+        const auto qos = static_cast<QualityOfService>(state.range(0));
+        const auto payloadSize = static_cast<size_t>(state.range(1));
+
+        LoopbackSession session;
+        if (!session.connect())
+        {
+            state.SkipWithError("Could not connect to the loopback broker");
+            return;
+        }
+
+        const Message::Payload payload(payloadSize, 0x5A);
+        const AllocationScope allocations;
+        for (auto _ : state)
+        {
+            size_t completed = 0;
+            for (size_t i = 0; i < kWindow; ++i)
+            {
+                session.client->publish(
+                    Message(kTopic, Message::Payload(payload), false, qos),
+                    [&completed](const Result<void>&)
+                    {
+                        ++completed;
+                    });
+            }
+            if (!tickUntil(
+                    *session.client,
+                    [&completed]
+                    {
+                        return completed == kWindow;
+                    }))
+            {
+                state.SkipWithError("Publishes did not complete");
+                return;
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kWindow));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kWindow * payloadSize));
+        // Includes building each Message and its completion callback, which the unit test budgets leave out.
+        reactormq::tests::setAllocationCounters(state, allocations.getCounts(), state.iterations() * kWindow);
+        reportLatency(state, *session.client, qos);
+    }
+    BENCHMARK(BM_LoopbackPublishThroughput)
+        ->ArgsProduct({ { 0, 1, 2 }, { 64, 4096 } })
+        ->ArgNames({ "qos", "bytes" })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    /// Publish one message to a topic the client subscribes to and wait for it to come back. Argument: QoS.
+    void BM_LoopbackRoundTrip(benchmark::State& state)
+    {
+        const auto qos = static_cast<QualityOfService>(state.range(0));
+
+        LoopbackSession session;
+        if (!session.connect())
+        {
+            state.SkipWithError("Could not connect to the loopback broker");
+            return;
+        }
+
+        size_t received = 0;
+        auto handle = session.client->onMessage().add(
+            [&received](const Message&)
+            {
+                ++received;
+            });
+        auto subscribed = session.client->subscribeAsync(TopicFilter(kTopic, qos, false));
+        if (!tickUntil(
+                *session.client,
+                [&subscribed]
+                {
+                    return subscribed.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                }))
+        {
+            state.SkipWithError("Subscribe did not complete");
+            return;
+        }
+
+        const Message::Payload payload(64, 0x5A);
+        for (auto _ : state)
+        {
+            const size_t expected = received + 1;
+            session.client->publish(Message(kTopic, Message::Payload(payload), false, qos));
+            if (!tickUntil(
+                    *session.client,
+                    [&received, expected]
+                    {
+                        return received >= expected;
+                    }))
+            {
+                state.SkipWithError("Echo did not arrive");
+                return;
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        reportLatency(state, *session.client, qos);
+    }
+    BENCHMARK(BM_LoopbackRoundTrip)->DenseRange(0, 2)->ArgName("qos")->Unit(benchmark::kMicrosecond)->UseRealTime();
+} // namespace
@@ -0,0 +1,240 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/logging/registry.h"
+#include "util/perf/perf_report.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace reactormq::perf;
+
+namespace
+{
+    /// Whether a run was skipped or failed; the field was renamed in Google Benchmark 1.8.
+    template<typename Run>
+    bool isSkipped(const Run& run)
+    {
+        if constexpr (requires { run.skipped; })
+        {
+            return static_cast<bool>(run.skipped);
+        }
+        else
+        {
+            return run.error_occurred;
+        }
+    }
+
+    /**
+     * Passes every run on to the reporter --benchmark_format picks and keeps it as a PerfResult. A later run of the
+     * same benchmark replaces an earlier one, so with --benchmark_repetitions what is kept is the median, under the
+     * name a single run would have had.
+     */
+    class PerfReportCollector final : public benchmark::BenchmarkReporter
+    {
+    public:
+        PerfReportCollector()
+            : m_display(benchmark::CreateDefaultDisplayReporter())
+        {
+            m_report.tool = "reactormq_bench";
+        }
+
+        bool ReportContext(const Context& context) override
+        {
+            return m_display->ReportContext(context);
+        }
+
+        void ReportRuns(const std::vector<Run>& runs) override
+        {
+            m_display->ReportRuns(runs);
+            for (const Run& run : runs)
+            {
+                if (run.run_type == Run::RT_Iteration)
+                {
+                    add(run, run.benchmark_name());
+                }
+                else if (run.aggregate_name == "median")
+                {
+                    add(run, run.run_name.str());
+                }
+            }
+        }
+
+        void Finalize() override
+        {
+            m_display->Finalize();
+        }
+
+        [[nodiscard]] const PerfReport& getReport() const
+        {
+            return m_report;
+        }
+
+    private:
+        /**
+         * Throughput is items_per_second when the benchmark calls SetItemsProcessed, and iterations per second of wall
+         * time otherwise, summed over its threads. Latency and allocations come from the p50_us, p99_us, p999_us,
+         * allocs_per_op and bytes_per_op counters; every other counter is kept as it is.
+         */
+        void add(const Run& run, std::string name)
+        {
+            if (isSkipped(run))
+            {
+                return;
+            }
+
+            PerfResult result;
+            result.name = std::move(name);
+            const double secondsPerIteration = run.GetAdjustedRealTime() / benchmark::GetTimeUnitMultiplier(run.time_unit);
+            result.opsPerSecond = secondsPerIteration > 0.0 ? 1.0 / secondsPerIteration : 0.0;
+            for (const auto& [counterName, counter] : run.counters)
+            {
+                const double value = counter.value;
+                if (counterName == "items_per_second")
+                {
+                    result.opsPerSecond = value;
+                }
+                else if (counterName == "p50_us")
+                {
+                    result.p50Us = value;
+                }
+                else if (counterName == "p99_us")
+                {
+                    result.p99Us = value;
+                }
+                else if (counterName == "p999_us")
+                {
+                    result.p999Us = value;
+                }
+                else if (counterName == "allocs_per_op")
+                {
+                    result.allocsPerOp = value;
+                }
+                else if (counterName == "bytes_per_op")
+                {
+                    result.bytesPerOp = value;
+                }
+                else
+                {
+                    result.counters[counterName] = value;
+                }
+            }
+            const auto existing = std::ranges::find(m_report.results, result.name, &PerfResult::name);
+            if (existing != m_report.results.end())
+            {
+                *existing = std::move(result);
+            }
+            else
+            {
+                m_report.results.push_back(std::move(result));
+            }
+        }
+
+        BenchmarkReporter* m_display; ///< Owned by Google Benchmark.
+        PerfReport m_report;
+    };
+
+    struct PerfOptions
+    {
+        std::string jsonPath; ///< --reactormq_json: where to write the results.
+        std::string baselinePath; ///< --reactormq_compare: compare two result files instead of running benchmarks.
+        std::string candidatePath;
+        CompareThresholds thresholds; ///< --reactormq_thresholds.
+    };
+
+    void printHelp()
+    {
+        benchmark::PrintDefaultHelp();
+        std::fputs(
+            "          [--reactormq_json=<file>]\n"
+            "          [--reactormq_compare=<baseline.json>,<candidate.json>]\n"
+            "          [--reactormq_thresholds=ops:<pct>,latency:<pct>,allocs:<pct>]\n",
+            stdout);
+    }
+
+    /// Take the --reactormq_* flags out of argv, so that Google Benchmark does not reject them.
+    bool parsePerfOptions(int& argc, char** argv, PerfOptions& options)
+    {
+        int kept = 1;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument = argv[i];
+            if (argument.starts_with("--reactormq_json="))
+            {
+                options.jsonPath = argument.substr(argument.find('=') + 1);
+            }
+            else if (argument.starts_with("--reactormq_compare="))
+            {
+                const std::string_view paths = argument.substr(argument.find('=') + 1);
+                const size_t comma = paths.find(',');
+                if (comma == std::string_view::npos || comma == 0 || comma + 1 == paths.size())
+                {
+                    std::fprintf(stderr, "--reactormq_compare takes <baseline.json>,<candidate.json>\n");
+                    return false;
+                }
+                options.baselinePath = paths.substr(0, comma);
+                options.candidatePath = paths.substr(comma + 1);
+            }
+            else if (argument.starts_with("--reactormq_thresholds="))
+            {
+                if (!parseCompareThresholds(argument.substr(argument.find('=') + 1), options.thresholds))
+                {
+                    std::fprintf(stderr, "--reactormq_thresholds takes ops:<pct>,latency:<pct>,allocs:<pct>\n");
+                    return false;
+                }
+            }
+            else
+            {
+                argv[kept++] = argv[i];
+            }
+        }
+        argc = kept;
+        return true;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    PerfOptions options;
+    if (!parsePerfOptions(argc, argv, options))
+    {
+        return 1;
+    }
+    if (!options.baselinePath.empty())
+    {
+        return runComparison(options.baselinePath, options.candidatePath, options.thresholds);
+    }
+
+    // Trace and debug lines on every decode would be most of what gets measured.
+    reactormq::logging::Registry::instance().setLevel(reactormq::logging::LogLevel::Error);
+
+    benchmark::Initialize(&argc, argv, printHelp);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    if (options.jsonPath.empty())
+    {
+        benchmark::RunSpecifiedBenchmarks();
+    }
+    else
+    {
+        PerfReportCollector collector;
+        benchmark::RunSpecifiedBenchmarks(&collector);
+        std::string error;
+        if (!savePerfReport(options.jsonPath, collector.getReport(), error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            benchmark::Shutdown();
+            return 1;
+        }
+    }
+    benchmark::Shutdown();
+    return 0;
+}
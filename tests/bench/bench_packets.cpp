@@ -0,0 +1,207 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "bench/bench_report.h"
+#include "fixtures/allocation_counter.h"
+#include "mqtt/client/context.h"
+#include "mqtt/packets/fixed_header.h"
+#include "mqtt/packets/publish.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "serialize/bytes.h"
+#include "socket/socket.h"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::packets;
+using namespace reactormq::serialize;
+using reactormq::tests::AllocationScope;
+using reactormq::tests::setAllocationCounters;
+
+namespace
+{
+    constexpr auto kTopic = "building/7/floor/3/sensor/temperature";
+
+    template<ProtocolVersion V>
+    Publish<V> makePublish(const size_t payloadSize)
+    {
+        std::vector<uint8_t> payload(payloadSize, 0x5A);
+        if constexpr (V == ProtocolVersion::V5)
+        {
+            return Publish<V>(kTopic, std::move(payload), QualityOfService::AtLeastOnce, false, 42, properties::Properties{});
+        }
+        else
+        {
+            return Publish<V>(kTopic, std::move(payload), QualityOfService::AtLeastOnce, false, 42);
+        }
+    }
+
+    template<ProtocolVersion V>
+    std::vector<std::byte> encodePublish(const size_t payloadSize)
+    {
+        std::vector<std::byte> buffer;
+        ByteWriter writer(buffer);
+        makePublish<V>(payloadSize).encode(writer);
+        return buffer;
+    }
+
+    template<ProtocolVersion V>
+    void BM_EncodePublish(benchmark::State& state)
+    {
+        const auto payloadSize = static_cast<size_t>(state.range(0));
+        const Publish<V> packet = makePublish<V>(payloadSize);
+        std::vector<std::byte> buffer;
+        buffer.reserve(payloadSize + 64);
+        const AllocationScope allocations;
+        for (auto _ : state)
+        {
+            buffer.clear();
+            ByteWriter writer(buffer);
+            packet.encode(writer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        setAllocationCounters(state, allocations.getCounts(), state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(BM_EncodePublish, ProtocolVersion::V311)->RangeMultiplier(16)->Range(16, 65536);
+    BENCHMARK_TEMPLATE(BM_EncodePublish, ProtocolVersion::V5)->RangeMultiplier(16)->Range(16, 65536);
+
+    template<ProtocolVersion V>
+    void BM_DecodePublish(benchmark::State& state)
+    {
+        const std::vector<std::byte> buffer = encodePublish<V>(static_cast<size_t>(state.range(0)));
+        const AllocationScope allocations;
+        for (auto _ : state)
+        {
+            ByteReader reader(buffer.data(), buffer.size());
+            const FixedHeader header = FixedHeader::create(reader);
+            const Publish<V> packet(reader, header);
+            benchmark::DoNotOptimize(packet.getPayload().data());
+        }
+        setAllocationCounters(state, allocations.getCounts(), state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(BM_DecodePublish, ProtocolVersion::V311)->RangeMultiplier(16)->Range(16, 65536);
+    BENCHMARK_TEMPLATE(BM_DecodePublish, ProtocolVersion::V5)->RangeMultiplier(16)->Range(16, 65536);
+
+    ConnectionSettingsPtr makeSettings()
+    {
+        ConnectionSettingsBuilder builder;
+        builder.setHost("localhost");
+        return builder.build();
+    }
+
+    void BM_ContextParsePacket(benchmark::State& state)
+    {
+        const client::Context context(makeSettings());
+        const std::vector<std::byte> buffer = encodePublish<ProtocolVersion::V5>(static_cast<size_t>(state.range(0)));
+        const AllocationScope allocations;
+        for (auto _ : state)
+        {
+            const auto packet = context.parsePacket(buffer);
+            benchmark::DoNotOptimize(packet.get());
+        }
+        setAllocationCounters(state, allocations.getCounts(), state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+    BENCHMARK(BM_ContextParsePacket)->RangeMultiplier(16)->Range(16, 65536);
+
+    /// Socket with no transport; feed() pushes bytes through the same framing a real read does.
+    class FramingSocket final : public socket::Socket
+    {
+    public:
+        explicit FramingSocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        bool feed(const std::vector<std::byte>& bytes)
+        {
+            return processPacketData(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* /*data*/, uint32_t /*size*/) override
+        {
+        }
+
+        socket::OnConnectCallback& getOnConnectCallback() override
+        {
+            return m_onConnect;
+        }
+
+        socket::OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return m_onDisconnect;
+        }
+
+        socket::OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return m_onData;
+        }
+
+        void tick() override
+        {
+        }
+
+    private:
+        socket::OnConnectCallback m_onConnect;
+        socket::OnDisconnectCallback m_onDisconnect;
+        socket::OnDataReceivedCallback m_onData;
+    };
+
+    /// Frames a read holding many small packets back to back, as a busy subscription delivers them.
+    void BM_SocketReadPacketsFromBuffer(benchmark::State& state)
+    {
+        const auto packetsPerRead = static_cast<size_t>(state.range(0));
+        const std::vector<std::byte> packet = encodePublish<ProtocolVersion::V5>(64);
+        std::vector<std::byte> read;
+        read.reserve(packet.size() * packetsPerRead);
+        for (size_t i = 0; i < packetsPerRead; ++i)
+        {
+            read.insert(read.end(), packet.begin(), packet.end());
+        }
+
+        FramingSocket sock(makeSettings());
+        size_t framed = 0;
+        auto handle = sock.getOnDataReceivedBatchCallback().add(
+            [&framed](const std::span<const socket::InboundFrame> frames, size_t& /*handled*/)
+            {
+                framed += frames.size();
+            });
+        const AllocationScope allocations;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(sock.feed(read));
+        }
+        setAllocationCounters(state, allocations.getCounts(), state.iterations() * packetsPerRead);
+        benchmark::DoNotOptimize(framed);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * packetsPerRead));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * read.size()));
+    }
+    BENCHMARK(BM_SocketReadPacketsFromBuffer)->Arg(1)->Arg(16)->Arg(256);
+} // namespace
@@ -0,0 +1,319 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "bench/bench_report.h"
+#include "fixtures/allocation_counter.h"
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/performance_profile.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+
+using namespace reactormq::mqtt;
+using reactormq::mqtt::client::createClient;
+using reactormq::tests::AllocationScope;
+using reactormq::tests::LoopbackBroker;
+
+/*
+ * Each profile on the workload it claims to suit, with Default beside it. Argument: the PerformanceProfile, 0 being
+ * Default, which runs first; every other profile reports its figure as a ratio to Default's as vs_default:
+ * - LowLatency: a 64-byte QoS 0 echo round trip takes less time (vs_default below 1).
+ * - HighThroughput: a window of 4 KiB QoS 1 publishes completes at a higher rate (vs_default above 1).
+ * - Embedded: connecting and exchanging messages allocates fewer heap bytes (vs_default below 1).
+ * - GameThread: the longest tick while a burst of publishes drains is shorter (vs_default below 1).
+ * Compare result files across changes with --reactormq_compare to keep the claims true.
+ */
+namespace
+{
+    constexpr auto kTopic = "bench/profile";
+
+    /// Tick until @p isDone holds; false after 10 s, which only a broken broker or client takes.
+    template<typename Predicate>
+    bool tickUntil(IClient& client, Predicate&& isDone)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!isDone())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            client.waitAndTick(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    template<typename T>
+    bool tickUntilReady(IClient& client, std::future<T>& future)
+    {
+        return tickUntil(
+            client,
+            [&future]
+            {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+    }
+
+    /// A broker and a client with a profile connected to it, torn down with the benchmark.
+    struct ProfileSession
+    {
+        LoopbackBroker broker;
+        std::shared_ptr<IClient> client;
+
+        bool connect(const PerformanceProfile profile, const bool shouldEcho = false)
+        {
+            const uint16_t port = broker.start(0);
+            if (port == 0)
+            {
+                return false;
+            }
+
+            client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                      .applyProfile(profile)
+                                      .setPort(port)
+                                      .setProtocol(ConnectionProtocol::Tcp)
+                                      .setClientId("reactormq-bench")
+                                      .build());
+            auto connected = client->connectAsync(true);
+            if (!tickUntilReady(*client, connected) || !connected.get().hasSucceeded())
+            {
+                return false;
+            }
+            if (!shouldEcho)
+            {
+                return true;
+            }
+
+            auto subscribed = client->subscribeAsync(TopicFilter(kTopic, QualityOfService::AtMostOnce, false));
+            return tickUntilReady(*client, subscribed);
+        }
+
+        ~ProfileSession()
+        {
+            if (client)
+            {
+                auto disconnected = client->disconnectAsync();
+                (void)tickUntilReady(*client, disconnected);
+            }
+        }
+    };
+
+    PerformanceProfile getProfile(const benchmark::State& state)
+    {
+        return static_cast<PerformanceProfile>(state.range(0));
+    }
+
+    /// Remember Default's figure, or report this profile's as a ratio to it once Default has run.
+    void reportVsDefault(benchmark::State& state, double& defaultValue, const double value)
+    {
+        if (getProfile(state) == PerformanceProfile::Default)
+        {
+            defaultValue = value;
+        }
+        else if (defaultValue > 0)
+        {
+            state.counters["vs_default"] = value / defaultValue;
+        }
+        state.SetLabel(performanceProfileToString(getProfile(state)));
+    }
+
+    /// Publish one 64-byte QoS 0 message to a subscribed topic and wait for it to come back.
+    void BM_ProfileRoundTrip(benchmark::State& state)
+    {
+        static double defaultUs = 0;
+
+        ProfileSession session;
+        if (!session.connect(getProfile(state), true))
+        {
+            state.SkipWithError("Could not subscribe on the loopback broker");
+            return;
+        }
+
+        size_t received = 0;
+        auto handle = session.client->onMessage().add(
+            [&received](const Message&)
+            {
+                ++received;
+            });
+
+        const Message::Payload payload(64, 0x5A);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+        {
+            const size_t expected = received + 1;
+            session.client->publish(Message(kTopic, Message::Payload(payload), false, QualityOfService::AtMostOnce));
+            if (!tickUntil(
+                    *session.client,
+                    [&received, expected]
+                    {
+                        return received >= expected;
+                    }))
+            {
+                state.SkipWithError("Echo did not arrive");
+                return;
+            }
+        }
+
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        reportVsDefault(state, defaultUs, elapsed.count() / static_cast<double>(state.iterations()));
+    }
+    BENCHMARK(BM_ProfileRoundTrip)->DenseRange(0, 4)->ArgName("profile")->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+    /// Publish a window of 4 KiB QoS 1 messages and wait for every acknowledgement.
+    void BM_ProfilePublishThroughput(benchmark::State& state)
+    {
+        constexpr size_t kWindow = 256;
+        static double defaultRate = 0;
+
+        ProfileSession session;
+        if (!session.connect(getProfile(state)))
+        {
+            state.SkipWithError("Could not connect to the loopback broker");
+            return;
+        }
+
+        const Message::Payload payload(4096, 0x5A);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+        {
+            size_t completed = 0;
+            for (size_t i = 0; i < kWindow; ++i)
+            {
+                session.client->publish(
+                    Message(kTopic, Message::Payload(payload), false, QualityOfService::AtLeastOnce),
+                    [&completed](const Result<void>&)
+                    {
+                        ++completed;
+                    });
+            }
+            if (!tickUntil(
+                    *session.client,
+                    [&completed]
+                    {
+                        return completed == kWindow;
+                    }))
+            {
+                state.SkipWithError("Publishes did not complete");
+                return;
+            }
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const auto published = static_cast<double>(state.iterations() * kWindow);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kWindow));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kWindow * payload.size()));
+        reportVsDefault(state, defaultRate, published / elapsed.count());
+    }
+    BENCHMARK(BM_ProfilePublishThroughput)->DenseRange(0, 4)->ArgName("profile")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    /// Connect, subscribe and echo 64 messages of 1 KiB; reports the heap bytes and allocations that took.
+    void BM_ProfileConnectedFootprint(benchmark::State& state)
+    {
+        constexpr size_t kMessages = 64;
+        static double defaultBytes = 0;
+
+        const Message::Payload payload(1024, 0x5A);
+        reactormq::tests::AllocationCounts total;
+        for (auto _ : state)
+        {
+            const AllocationScope scope;
+            ProfileSession session;
+            if (!session.connect(getProfile(state), true))
+            {
+                state.SkipWithError("Could not subscribe on the loopback broker");
+                return;
+            }
+
+            size_t received = 0;
+            auto handle = session.client->onMessage().add(
+                [&received](const Message&)
+                {
+                    ++received;
+                });
+            for (size_t i = 0; i < kMessages; ++i)
+            {
+                session.client->publish(Message(kTopic, Message::Payload(payload), false, QualityOfService::AtMostOnce));
+            }
+            if (!tickUntil(
+                    *session.client,
+                    [&received]
+                    {
+                        return received == kMessages;
+                    }))
+            {
+                state.SkipWithError("Echoes did not arrive");
+                return;
+            }
+            total.allocations += scope.getCounts().allocations;
+            total.bytes += scope.getCounts().bytes;
+        }
+
+        reactormq::tests::setAllocationCounters(state, total, state.iterations());
+        if (reactormq::tests::isAllocationCountingEnabled())
+        {
+            reportVsDefault(state, defaultBytes, static_cast<double>(total.bytes) / static_cast<double>(state.iterations()));
+        }
+    }
+    BENCHMARK(BM_ProfileConnectedFootprint)->DenseRange(0, 4)->ArgName("profile")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    /// Queue a burst of 512 QoS 0 publishes and tick until they are all sent; reports the longest tick as max_tick_us.
+    void BM_ProfileLongestTickUnderBurst(benchmark::State& state)
+    {
+        constexpr size_t kBurst = 512;
+        static double defaultMaxUs = 0;
+
+        ProfileSession session;
+        if (!session.connect(getProfile(state)))
+        {
+            state.SkipWithError("Could not connect to the loopback broker");
+            return;
+        }
+
+        const Message::Payload payload(256, 0x5A);
+        std::chrono::steady_clock::duration longest{ 0 };
+        for (auto _ : state)
+        {
+            size_t completed = 0;
+            for (size_t i = 0; i < kBurst; ++i)
+            {
+                session.client->publish(
+                    Message(kTopic, Message::Payload(payload), false, QualityOfService::AtMostOnce),
+                    [&completed](const Result<void>&)
+                    {
+                        ++completed;
+                    });
+            }
+
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (completed < kBurst)
+            {
+                const auto tickStart = std::chrono::steady_clock::now();
+                if (tickStart >= deadline)
+                {
+                    state.SkipWithError("Publishes did not complete");
+                    return;
+                }
+                session.client->tick();
+                longest = std::max(longest, std::chrono::steady_clock::now() - tickStart);
+            }
+        }
+
+        const std::chrono::duration<double, std::micro> longestUs = longest;
+        state.counters["max_tick_us"] = longestUs.count();
+        reportVsDefault(state, defaultMaxUs, longestUs.count());
+    }
+    BENCHMARK(BM_ProfileLongestTickUnderBurst)->DenseRange(0, 4)->ArgName("profile")->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
@@ -0,0 +1,67 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/allocation_counter.h"
+#include "fixtures/reconnect_storm.h"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+using reactormq::tests::getPeakResidentBytes;
+using reactormq::tests::isAllocationCountingEnabled;
+using reactormq::tests::ReconnectStorm;
+using reactormq::tests::StormResult;
+
+namespace
+{
+    /**
+     * Drop every connection of a fleet of clients at once, keep the broker down for 100 ms, and time how long the
+     * slowest client takes to be connected again once it is back. Argument: client count.
+     * Counters per storm: median recovery, connection attempts per client (each a handshake, TLS included on a TLS
+     * link), and heap allocations per client when the build counts them; plus the process's peak resident set.
+     */
+    void BM_ReconnectStorm(benchmark::State& state)
+    {
+        constexpr auto kOutage = std::chrono::milliseconds(100);
+        const auto clientCount = static_cast<size_t>(state.range(0));
+
+        ReconnectStorm storm;
+        if (!storm.start(clientCount))
+        {
+            state.SkipWithError("Could not connect the clients to the loopback broker");
+            return;
+        }
+
+        double medianRecoveryMs = 0;
+        std::uint64_t connectAttempts = 0;
+        std::uint64_t allocations = 0;
+        for (auto _ : state)
+        {
+            const StormResult result = storm.run(kOutage);
+            if (!result.hasRecovered)
+            {
+                state.SkipWithError("Clients were still disconnected 10 s after the broker came back");
+                return;
+            }
+            state.SetIterationTime(std::chrono::duration<double>(result.slowestRecovery).count());
+            medianRecoveryMs += std::chrono::duration<double, std::milli>(result.medianRecovery).count();
+            connectAttempts += result.connectAttempts;
+            allocations += result.allocations.allocations;
+        }
+
+        const auto storms = static_cast<double>(state.iterations());
+        const auto perClient = storms * static_cast<double>(clientCount);
+        state.counters["median_recovery_ms"] = medianRecoveryMs / storms;
+        state.counters["attempts_per_client"] = static_cast<double>(connectAttempts) / perClient;
+        if (isAllocationCountingEnabled())
+        {
+            state.counters["allocs_per_client"] = static_cast<double>(allocations) / perClient;
+        }
+        state.counters["peak_rss_mib"] = static_cast<double>(getPeakResidentBytes()) / (1024.0 * 1024.0);
+    }
+
+    BENCHMARK(BM_ReconnectStorm)->Arg(64)->Arg(256)->Iterations(5)->UseManualTime()->Unit(benchmark::kMillisecond);
+} // namespace
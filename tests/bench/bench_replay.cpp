@@ -0,0 +1,280 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/command.h"
+#include "mqtt/client/reactor.h"
+#include "mqtt/client/traffic_recording.h"
+#include "mqtt/packets/conn_ack.h"
+#include "mqtt/packets/publish.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "serialize/bytes.h"
+#include "socket/socket.h"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using namespace reactormq::mqtt::packets;
+
+namespace
+{
+    /// Socket with no transport; feed() pushes recorded bytes through the same framing a real read does.
+    class ReplaySocket final : public socket::Socket
+    {
+    public:
+        explicit ReplaySocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        bool feed(const std::span<const std::uint8_t> bytes)
+        {
+            return processPacketData(bytes.data(), bytes.size());
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* /*data*/, uint32_t /*size*/) override
+        {
+        }
+
+        socket::OnConnectCallback& getOnConnectCallback() override
+        {
+            return m_onConnect;
+        }
+
+        socket::OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return m_onDisconnect;
+        }
+
+        socket::OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return m_onData;
+        }
+
+        void tick() override
+        {
+        }
+
+    private:
+        socket::OnConnectCallback m_onConnect;
+        socket::OnDisconnectCallback m_onDisconnect;
+        socket::OnDataReceivedCallback m_onData;
+    };
+
+    constexpr std::uint8_t kConnectType = 1;
+    constexpr std::uint8_t kConnAckType = 2;
+    constexpr std::uint8_t kPublishType = 3;
+    constexpr std::uint8_t kPubRelType = 6;
+    constexpr std::uint8_t kPingRespType = 13;
+
+    std::uint8_t getPacketType(const RecordedPacket& packet)
+    {
+        return packet.bytes.empty() ? 0 : static_cast<std::uint8_t>(packet.bytes[0] >> 4);
+    }
+
+    template<typename Packet>
+    RecordedPacket record(const Packet& packet, const std::int64_t timestampUs)
+    {
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        packet.encode(writer);
+
+        RecordedPacket recorded;
+        recorded.timestampUs = timestampUs;
+        recorded.bytes.resize(buffer.size());
+        std::memcpy(recorded.bytes.data(), buffer.data(), buffer.size());
+        recorded.originalSize = static_cast<std::uint32_t>(recorded.bytes.size());
+        return recorded;
+    }
+
+    /**
+     * A gateway's inbound mix when no recording is given: a CONNACK, then PUBLISHes every 50 us across many topics,
+     * payloads of 16 B to 2 KiB, and one in four at QoS 1.
+     */
+    std::vector<RecordedPacket> makeSyntheticTraffic()
+    {
+        constexpr size_t kPublishCount = 4096;
+        std::vector<RecordedPacket> traffic;
+        traffic.push_back(record(ConnAck<ProtocolVersion::V5>(false, ReasonCode::Success, properties::Properties{}), 0));
+        for (size_t i = 0; i < kPublishCount; ++i)
+        {
+            const bool isQos1 = i % 4 == 0;
+            const std::string topic
+                = "sites/site" + std::to_string(i % 64) + "/devices/dev" + std::to_string(i % 500) + "/m" + std::to_string(i % 8);
+            const Publish<ProtocolVersion::V5> publish(
+                topic,
+                std::vector<uint8_t>(size_t{ 16 } << (i % 8), 0x5A),
+                isQos1 ? QualityOfService::AtLeastOnce : QualityOfService::AtMostOnce,
+                false,
+                isQos1 ? static_cast<std::uint16_t>(i % 65535 + 1) : 0,
+                properties::Properties{});
+            traffic.push_back(record(publish, static_cast<std::int64_t>(i + 1) * 50));
+        }
+        return traffic;
+    }
+
+    /// The traffic to replay: REACTORMQ_REPLAY names a recording or a corpus directory; otherwise a synthetic mix.
+    const std::vector<RecordedPacket>& getTraffic()
+    {
+        static const std::vector<RecordedPacket> traffic = []
+        {
+            std::vector<RecordedPacket> loaded;
+            if (const char* path = std::getenv("REACTORMQ_REPLAY"); path != nullptr && loadTrafficRecording(path, loaded))
+            {
+                return loaded;
+            }
+            return makeSyntheticTraffic();
+        }();
+        return traffic;
+    }
+
+    /// Whether the client can take a received packet without the state that led to it in the recording.
+    bool isReplayable(const RecordedPacket& packet)
+    {
+        const std::uint8_t type = getPacketType(packet);
+        return packet.direction == PacketDirection::Received && packet.isComplete()
+            && (type == kPublishType || type == kPubRelType || type == kPingRespType);
+    }
+
+    /// A reactor connected through a ReplaySocket with the recording's own CONNACK, if it has one.
+    struct ReplayClient
+    {
+        std::shared_ptr<Reactor> reactor;
+        std::shared_ptr<ReplaySocket> socket;
+    };
+
+    bool connectReplayClient(const std::vector<RecordedPacket>& traffic, ReplayClient& client)
+    {
+        ConnectionSettingsBuilder builder;
+        builder.setHost("localhost");
+        const ConnectionSettingsPtr settings = builder.build();
+        client.reactor = std::make_shared<Reactor>(settings);
+        client.socket = std::make_shared<ReplaySocket>(settings);
+        client.reactor->getContext().setSocket(client.socket);
+
+        std::promise<Result<void>> connected;
+        client.reactor->enqueueCommand(ConnectCommand{ true, std::move(connected) });
+        client.reactor->tick();
+        client.socket->getOnConnectCallback().broadcast(true);
+
+        // The CONNECT the recorded client sent says which protocol version its CONNACK is in.
+        RecordedPacket connAck = record(ConnAck<ProtocolVersion::V5>(false, ReasonCode::Success, properties::Properties{}), 0);
+        for (const RecordedPacket& packet : traffic)
+        {
+            constexpr size_t kProtocolLevelOffset = 8; // type, one length byte, then "\0\4MQTT"
+            if (packet.direction == PacketDirection::Sent && getPacketType(packet) == kConnectType
+                && packet.bytes.size() > kProtocolLevelOffset && packet.bytes[kProtocolLevelOffset] == 4)
+            {
+                client.reactor->getContext().setProtocolVersion(ProtocolVersion::V311);
+            }
+            if (packet.direction == PacketDirection::Received && getPacketType(packet) == kConnAckType)
+            {
+                connAck = packet;
+                break;
+            }
+        }
+
+        client.socket->feed(connAck.bytes);
+        client.reactor->tick();
+        return client.reactor->isConnected();
+    }
+
+    /**
+     * Replay recorded inbound traffic through framing, the reactor's state machine and the message callback, one read
+     * per tick. Packets that only make sense against the recorded client's own requests (acks of its publishes and
+     * subscribes) are skipped. Argument: 0 replays as fast as possible, 1 at the recording's pacing.
+     * Set REACTORMQ_REPLAY to a PacketCaptureFormat::Recording file, or to a corpus directory such as
+     * tests/fuzz/corpus/fuzz_mqtt_codec, to replay real traffic instead of the synthetic mix.
+     */
+    void BM_ReplayTraffic(benchmark::State& state)
+    {
+        const bool isPaced = state.range(0) != 0;
+        const std::vector<RecordedPacket>& traffic = getTraffic();
+
+        ReplayClient client;
+        if (!connectReplayClient(traffic, client))
+        {
+            state.SkipWithError("the replayed CONNACK did not connect the client");
+            return;
+        }
+
+        std::vector<const RecordedPacket*> replayed;
+        for (const RecordedPacket& packet : traffic)
+        {
+            if (isReplayable(packet))
+            {
+                replayed.push_back(&packet);
+            }
+        }
+        if (replayed.empty())
+        {
+            state.SkipWithError("the recording has no replayable received packets");
+            return;
+        }
+
+        size_t delivered = 0;
+        size_t bytes = 0;
+        auto handle = client.reactor->getContext().getOnMessage().add(
+            [&delivered](const Message&)
+            {
+                ++delivered;
+            });
+
+        for (auto _ : state)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const std::int64_t firstTimestampUs = replayed.front()->timestampUs;
+            for (const RecordedPacket* packet : replayed)
+            {
+                if (isPaced)
+                {
+                    std::this_thread::sleep_until(start + std::chrono::microseconds(packet->timestampUs - firstTimestampUs));
+                }
+                client.socket->feed(packet->bytes);
+                client.reactor->tick();
+                bytes += packet->bytes.size();
+            }
+        }
+
+        if (!client.reactor->isConnected())
+        {
+            state.SkipWithError("the client disconnected during the replay");
+        }
+        state.counters["messages"] = benchmark::Counter(static_cast<double>(delivered), benchmark::Counter::kIsRate);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * replayed.size()));
+        state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    }
+
+    BENCHMARK(BM_ReplayTraffic)->Arg(0)->Arg(1)->ArgName("paced")->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,31 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "fixtures/allocation_counter.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+
+namespace reactormq::tests
+{
+    /**
+     * @brief Report heap calls as the allocs_per_op and bytes_per_op counters, which --reactormq_json writes as the
+     * schema's allocation figures. Nothing is set when the build does not count allocations.
+     * @param state Benchmark state.
+     * @param counts Heap calls made over the measured operations.
+     * @param operations Operations measured: the items of SetItemsProcessed when the benchmark sets them, so the figures
+     * share the unit of ops_per_sec, and otherwise the iterations.
+     */
+    inline void setAllocationCounters(benchmark::State& state, const AllocationCounts& counts, const std::uint64_t operations)
+    {
+        if (!isAllocationCountingEnabled() || operations == 0)
+        {
+            return;
+        }
+        state.counters["allocs_per_op"] = static_cast<double>(counts.allocations) / static_cast<double>(operations);
+        state.counters["bytes_per_op"] = static_cast<double>(counts.bytes) / static_cast<double>(operations);
+    }
+} // namespace reactormq::tests
@@ -0,0 +1,94 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/topic_router.h"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using reactormq::mqtt::client::TopicRouter;
+
+namespace
+{
+    /// Distinct topics matched in turn; more than the router caches, so most lookups walk the filters.
+    constexpr size_t kTopicCount = 4096;
+
+    /**
+     * Gateway-shaped filters: sites/<site>/devices/<device>/<metric>, with '+' in place of the device for one in eight,
+     * of the site for most others in three, and a '#' tail for a few.
+     */
+    std::string makeFilter(const size_t index)
+    {
+        const bool anyDevice = index % 8 == 0;
+        const std::string site = !anyDevice && index % 3 == 0 ? "+" : "site" + std::to_string(index % 64);
+        const std::string device = anyDevice ? "+" : "dev" + std::to_string(index % 5000);
+        if (index % 64 == 1)
+        {
+            return "sites/" + site + "/devices/" + device + "/#";
+        }
+        return "sites/" + site + "/devices/" + device + "/m" + std::to_string(index % 50);
+    }
+
+    std::string makeTopic(const size_t index)
+    {
+        return "sites/site" + std::to_string(index % 64) + "/devices/dev" + std::to_string(index % 5000) + "/m"
+            + std::to_string(index % 50);
+    }
+
+    /**
+     * Match distinct topics against a router holding many wildcard-heavy filters, as a gateway's dispatch does.
+     * Argument: number of filters. Reports matched handlers per topic.
+     */
+    void BM_TopicRouterMatch(benchmark::State& state)
+    {
+        TopicRouter router;
+        for (size_t i = 0; i < static_cast<size_t>(state.range(0)); ++i)
+        {
+            router.add(makeFilter(i), [](const Message&) {});
+        }
+
+        std::vector<std::string> topics;
+        topics.reserve(kTopicCount);
+        for (size_t i = 0; i < kTopicCount; ++i)
+        {
+            topics.push_back(makeTopic(i * 7919));
+        }
+
+        size_t next = 0;
+        size_t matched = 0;
+        for (auto _ : state)
+        {
+            const auto handlers = router.match(topics[next]);
+            matched += handlers ? handlers->size() : 0;
+            next = (next + 1) % kTopicCount;
+        }
+        state.counters["handlers/topic"] = benchmark::Counter(static_cast<double>(matched) / static_cast<double>(state.iterations()));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    BENCHMARK(BM_TopicRouterMatch)->Arg(100)->Arg(2000)->Arg(20000)->ArgName("filters");
+
+    /// Subscribe and unsubscribe one filter against a router holding many, as a gateway does when devices come and go.
+    void BM_TopicRouterChurn(benchmark::State& state)
+    {
+        TopicRouter router;
+        for (size_t i = 0; i < static_cast<size_t>(state.range(0)); ++i)
+        {
+            router.add(makeFilter(i), [](const Message&) {});
+        }
+
+        const std::string filter = "sites/+/devices/churn/+";
+        for (auto _ : state)
+        {
+            router.add(filter, [](const Message&) {});
+            benchmark::DoNotOptimize(router.remove(filter));
+        }
+    }
+
+    BENCHMARK(BM_TopicRouterChurn)->Arg(20000)->ArgName("filters");
+} // namespace
@@ -0,0 +1,211 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/allocation_counter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifndef REACTORMQ_TEST_COUNT_ALLOCATIONS
+#define REACTORMQ_TEST_COUNT_ALLOCATIONS 0
+#endif
+
+namespace reactormq::tests
+{
+    namespace
+    {
+        // Constant-initialised, so it is usable from operator new on any thread, including during thread start-up.
+        thread_local AllocationCounts t_counts;
+    } // namespace
+
+    bool isAllocationCountingEnabled()
+    {
+        return REACTORMQ_TEST_COUNT_ALLOCATIONS != 0;
+    }
+
+    AllocationScope::AllocationScope()
+        : m_start(t_counts)
+    {
+    }
+
+    AllocationCounts AllocationScope::getCounts() const
+    {
+        return {
+            t_counts.allocations - m_start.allocations,
+            t_counts.deallocations - m_start.deallocations,
+            t_counts.bytes - m_start.bytes,
+        };
+    }
+
+#if REACTORMQ_TEST_COUNT_ALLOCATIONS
+    namespace
+    {
+        void* allocate(const std::size_t size) noexcept
+        {
+            ++t_counts.allocations;
+            t_counts.bytes += size;
+            return std::malloc(size == 0 ? 1 : size);
+        }
+
+        void* allocateAligned(const std::size_t size, const std::align_val_t alignment) noexcept
+        {
+            ++t_counts.allocations;
+            t_counts.bytes += size;
+            const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+            return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+            void* memory = nullptr;
+            return posix_memalign(&memory, align < sizeof(void*) ? sizeof(void*) : align, size == 0 ? 1 : size) == 0 ? memory : nullptr;
+#endif // _WIN32
+        }
+
+        void deallocate(void* memory) noexcept
+        {
+            if (memory != nullptr)
+            {
+                ++t_counts.deallocations;
+                std::free(memory);
+            }
+        }
+
+        void deallocateAligned(void* memory) noexcept
+        {
+            if (memory != nullptr)
+            {
+                ++t_counts.deallocations;
+#ifdef _WIN32
+                _aligned_free(memory);
+#else
+                std::free(memory);
+#endif // _WIN32
+            }
+        }
+
+        void* allocateOrThrow(const std::size_t size)
+        {
+            void* memory = allocate(size);
+            if (memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+
+        void* allocateAlignedOrThrow(const std::size_t size, const std::align_val_t alignment)
+        {
+            void* memory = allocateAligned(size, alignment);
+            if (memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+    } // namespace
+#endif // REACTORMQ_TEST_COUNT_ALLOCATIONS
+} // namespace reactormq::tests
+
+#if REACTORMQ_TEST_COUNT_ALLOCATIONS
+// Every replaceable form, so nothing reaches the default allocator uncounted and no pointer is freed by the wrong one.
+void* operator new(const std::size_t size)
+{
+    return reactormq::tests::allocateOrThrow(size);
+}
+
+void* operator new[](const std::size_t size)
+{
+    return reactormq::tests::allocateOrThrow(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return reactormq::tests::allocate(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return reactormq::tests::allocate(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return reactormq::tests::allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return reactormq::tests::allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return reactormq::tests::allocateAligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return reactormq::tests::allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    reactormq::tests::deallocate(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    reactormq::tests::deallocateAligned(memory);
+}
+#endif // REACTORMQ_TEST_COUNT_ALLOCATIONS
@@ -0,0 +1,44 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include <cstdint>
+
+namespace reactormq::tests
+{
+    /// Heap calls seen by the replaced global operator new/delete on one thread.
+    struct AllocationCounts
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t deallocations = 0;
+        std::uint64_t bytes = 0; ///< Bytes requested by the allocations.
+    };
+
+    /**
+     * @brief Whether the test binary replaces global operator new/delete to count allocations.
+     * Set by REACTORMQ_TEST_COUNT_ALLOCATIONS; without it every count stays zero, so tests asserting on them should
+     * GTEST_SKIP() instead.
+     */
+    bool isAllocationCountingEnabled();
+
+    /**
+     * @brief Counts the global operator new/delete calls made on the constructing thread during its lifetime.
+     *
+     * Only the calling thread is counted, so a broker thread or a callback lane running alongside does not show up in
+     * a client's numbers. Tick the client on the test thread to count the reactor. The packet arena and other pools
+     * take their memory through operator new, so their overflows are counted too. Scopes may nest.
+     */
+    class AllocationScope final
+    {
+    public:
+        AllocationScope();
+
+        /// @brief Calls made on this thread since construction.
+        [[nodiscard]] AllocationCounts getCounts() const;
+
+    private:
+        AllocationCounts m_start;
+    };
+} // namespace reactormq::tests
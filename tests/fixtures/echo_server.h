@@ -6,7 +6,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -22,9 +27,11 @@ static constexpr SocketHandle kInvalidSocket = INVALID_SOCKET;
 #include <cerrno>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 using SocketHandle = int;
 static constexpr SocketHandle kInvalidSocket = -1;
@@ -32,6 +39,11 @@ static constexpr SocketHandle kInvalidSocket = -1;
 
 namespace reactormq::tests
 {
+    /**
+     * @brief Loopback TCP server that accepts one client at a time and echoes its bytes back.
+     * Subclasses replace serveClient() to speak a protocol over the same accept loop. setServesConcurrently() serves
+     * each client on its own thread instead, and dropClients() and setRefusing() stage outages for many clients at once.
+     */
     class EchoServer
     {
     public:
@@ -43,7 +55,7 @@ namespace reactormq::tests
         {
         }
 
-        ~EchoServer()
+        virtual ~EchoServer()
         {
             stop();
         }
@@ -92,7 +104,7 @@ namespace reactormq::tests
                 return 0;
             }
 
-            if (::listen(listenSocket, 1) != 0)
+            if (::listen(listenSocket, getListenBacklog()) != 0)
             {
                 closeSocket(listenSocket);
                 return 0;
@@ -116,6 +128,42 @@ namespace reactormq::tests
             return m_port;
         }
 
+#ifndef _WIN32
+        /**
+         * @brief Listen on a Unix domain socket instead of a TCP port.
+         * @param path Socket path; an existing file there is replaced, and the file is removed by stop().
+         * @return True if the server is listening.
+         */
+        bool startLocal(const std::string& path)
+        {
+            stop();
+            m_shouldStop.store(false, std::memory_order_release);
+
+            sockaddr_un addr{};
+            if (path.size() >= sizeof(addr.sun_path))
+            {
+                return false;
+            }
+            addr.sun_family = AF_UNIX;
+            std::memcpy(addr.sun_path, path.c_str(), path.size());
+            ::unlink(path.c_str());
+
+            const SocketHandle listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listenSocket == kInvalidSocket || ::bind(listenSocket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+                || ::listen(listenSocket, getListenBacklog()) != 0)
+            {
+                closeSocket(listenSocket);
+                return false;
+            }
+
+            m_localPath = path;
+            m_port = 0;
+            m_listenSocket.store(listenSocket, std::memory_order_release);
+            m_thread = std::jthread(&EchoServer::run, this);
+            return true;
+        }
+#endif // _WIN32
+
         void stop()
         {
             m_shouldStop.store(true, std::memory_order_release);
@@ -135,11 +183,41 @@ namespace reactormq::tests
                     closeSocket(s);
                 }
             }
+#ifndef _WIN32
+            else if (listen != kInvalidSocket && !m_localPath.empty())
+            {
+                if (const SocketHandle s = ::socket(AF_UNIX, SOCK_STREAM, 0); s != kInvalidSocket)
+                {
+                    sockaddr_un addr{};
+                    addr.sun_family = AF_UNIX;
+                    std::memcpy(addr.sun_path, m_localPath.c_str(), m_localPath.size());
+                    ::connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+                    closeSocket(s);
+                }
+            }
+#endif // _WIN32
 
             if (m_thread.joinable() && std::this_thread::get_id() != m_thread.get_id())
             {
                 m_thread.join();
             }
+
+#ifndef _WIN32
+            if (!m_localPath.empty())
+            {
+                ::unlink(m_localPath.c_str());
+                m_localPath.clear();
+            }
+#endif // _WIN32
+        }
+
+        /**
+         * @brief Stop reading from the accepted client so its data backs up in the kernel buffers.
+         * @param isPaused True to stop reading, false to resume echoing.
+         */
+        void setPaused(const bool isPaused)
+        {
+            m_isPaused.store(isPaused, std::memory_order_release);
         }
 
         [[nodiscard]] uint16_t getPort() const
@@ -147,7 +225,59 @@ namespace reactormq::tests
             return m_port;
         }
 
-    private:
+        /**
+         * @brief Serve every accepted client on its own thread rather than one after another. Call before start().
+         * @param isConcurrent True to serve clients concurrently.
+         */
+        void setServesConcurrently(const bool isConcurrent)
+        {
+            m_servesConcurrently = isConcurrent;
+        }
+
+        /// @brief Shut down every accepted connection at once, as a broker restart or a dropped link would.
+        void dropClients()
+        {
+            std::scoped_lock lock(m_clientsMutex);
+            for (const SocketHandle client : m_clients)
+            {
+#ifdef _WIN32
+                ::shutdown(client, SD_BOTH);
+#else
+                ::shutdown(client, SHUT_RDWR);
+#endif // _WIN32
+            }
+        }
+
+        /**
+         * @brief Close new connections as soon as they are accepted, so clients find the broker reachable but down.
+         * @param isRefusing True to refuse, false to serve again.
+         */
+        void setRefusing(const bool isRefusing)
+        {
+            m_isRefusing.store(isRefusing, std::memory_order_release);
+        }
+
+    protected:
+        /**
+         * @brief Serve one accepted client until it disconnects or the server stops; the default echoes.
+         * Runs on the server thread. A subclass that overrides this must call stop() in its own destructor.
+         * @param client Accepted socket; closed by the caller afterwards.
+         */
+        virtual void serveClient(const SocketHandle client)
+        {
+            echoLoop(client);
+        }
+
+        [[nodiscard]] bool shouldStop() const
+        {
+            return m_shouldStop.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool isReadingPaused() const
+        {
+            return m_isPaused.load(std::memory_order_acquire);
+        }
+
         static void setNonBlocking(SocketHandle s)
         {
 #ifdef _WIN32
@@ -184,6 +314,129 @@ namespace reactormq::tests
 #endif // _WIN32
         }
 
+        /**
+         * @brief Write all of @p size bytes to a non-blocking socket, waiting while it would block.
+         * @return False if the socket failed.
+         */
+        static bool sendAll(const SocketHandle client, const uint8_t* data, size_t size)
+        {
+            while (size > 0)
+            {
+#ifdef _WIN32
+                const int sent = ::send(client, reinterpret_cast<const char*>(data), static_cast<int>(size), 0);
+                if (sent < 0)
+                {
+                    if (isWouldBlock())
+                    {
+                        fd_set writefds;
+                        FD_ZERO(&writefds);
+                        FD_SET(client, &writefds);
+                        timeval wtv{};
+                        wtv.tv_usec = 10000;
+                        ::select(0, nullptr, &writefds, nullptr, &wtv);
+                        continue;
+                    }
+                    return false;
+                }
+#else
+                const ssize_t sent = ::send(client, data, size, 0);
+                if (sent < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (isWouldBlock())
+                    {
+                        fd_set writefds;
+                        FD_ZERO(&writefds);
+                        FD_SET(client, &writefds);
+                        timeval wtv{};
+                        wtv.tv_usec = 10000;
+                        ::select(client + 1, nullptr, &writefds, nullptr, &wtv);
+                        continue;
+                    }
+                    return false;
+                }
+#endif // _WIN32
+                size -= static_cast<size_t>(sent);
+                data += sent;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Read what is available from a non-blocking socket.
+         * @return Bytes read; 0 if nothing was ready; -1 once the peer closed or the socket failed.
+         */
+        static std::ptrdiff_t receive(const SocketHandle client, uint8_t* data, const size_t size)
+        {
+#ifdef _WIN32
+            const int received = ::recv(client, reinterpret_cast<char*>(data), static_cast<int>(size), 0);
+            if (received < 0 && isWouldBlock())
+            {
+                return 0;
+            }
+#else
+            const ssize_t received = ::recv(client, data, size, 0);
+            if (received < 0 && (errno == EINTR || isWouldBlock()))
+            {
+                return 0;
+            }
+#endif // _WIN32
+            return received > 0 ? static_cast<std::ptrdiff_t>(received) : -1;
+        }
+
+        /**
+         * @brief Wait up to 10 ms for @p client to become readable.
+         * @return 1 if readable, 0 on timeout, negative on error.
+         */
+        static int waitReadable(const SocketHandle client)
+        {
+            fd_set readfds;
+            FD_ZERO(&readfds);
+            FD_SET(client, &readfds);
+
+            timeval tv{};
+            tv.tv_usec = 10000; // 10ms
+
+#ifdef _WIN32
+            return ::select(0, &readfds, nullptr, nullptr, &tv);
+#else
+            return ::select(client + 1, &readfds, nullptr, nullptr, &tv);
+#endif
+        }
+
+    private:
+        /// A concurrently served client; done once serveClient() has returned and the socket is closed.
+        struct ClientThread
+        {
+            std::atomic<bool> isDone{ false };
+            std::jthread thread;
+        };
+
+        [[nodiscard]] int getListenBacklog() const
+        {
+            return m_servesConcurrently ? SOMAXCONN : 1;
+        }
+
+        void serveTracked(const SocketHandle client)
+        {
+            {
+                std::scoped_lock lock(m_clientsMutex);
+                m_clients.push_back(client);
+            }
+
+            serveClient(client);
+
+            // Forgotten before it is closed, so dropClients() never shuts down a handle the system has reused.
+            {
+                std::scoped_lock lock(m_clientsMutex);
+                std::erase(m_clients, client);
+            }
+            closeSocket(client);
+        }
+
         void run()
         {
             const SocketHandle listen = m_listenSocket.load(std::memory_order_acquire);
@@ -215,14 +468,45 @@ namespace reactormq::tests
                     continue;
                 }
 
-                m_clientSocket.store(client, std::memory_order_release);
+                if (m_isRefusing.load(std::memory_order_acquire))
+                {
+                    closeSocket(client);
+                    continue;
+                }
 
-                echoLoop(client);
+                // Brokers turn Nagle off; left on, each small reply waits out the client's delayed ACK.
+                constexpr int noDelay = 1;
+#ifdef _WIN32
+                ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+#else
+                ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+#endif // _WIN32
 
-                closeSocket(client);
+                if (m_servesConcurrently)
+                {
+                    m_clientThreads.remove_if(
+                        [](const ClientThread& served)
+                        {
+                            return served.isDone.load(std::memory_order_acquire);
+                        });
+                    ClientThread& served = m_clientThreads.emplace_back();
+                    served.thread = std::jthread(
+                        [this, client, &served]
+                        {
+                            serveTracked(client);
+                            served.isDone.store(true, std::memory_order_release);
+                        });
+                    continue;
+                }
+
+                m_clientSocket.store(client, std::memory_order_release);
+                serveTracked(client);
                 m_clientSocket.store(kInvalidSocket, std::memory_order_release);
             }
 
+            // Each serving thread sees shouldStop() within one wait and returns.
+            m_clientThreads.clear();
+
             const SocketHandle toClose = m_listenSocket.exchange(kInvalidSocket, std::memory_order_acq_rel);
             closeSocket(toClose);
         }
@@ -233,20 +517,15 @@ namespace reactormq::tests
             constexpr size_t kBufferSize = 64 * 1024;
             std::vector<uint8_t> buffer(kBufferSize);
 
-            while (!m_shouldStop.load(std::memory_order_acquire))
+            while (!shouldStop())
             {
-                fd_set readfds;
-                FD_ZERO(&readfds);
-                FD_SET(client, &readfds);
-
-                timeval tv{};
-                tv.tv_usec = 10000; // 10ms
+                if (isReadingPaused())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
 
-#ifdef _WIN32
-                const int ret = ::select(0, &readfds, nullptr, nullptr, &tv);
-#else
-                const int ret = ::select(client + 1, &readfds, nullptr, nullptr, &tv);
-#endif
+                const int ret = waitReadable(client);
                 if (ret < 0)
                 {
                     break;
@@ -256,83 +535,15 @@ namespace reactormq::tests
                     continue;
                 }
 
-                if (FD_ISSET(client, &readfds))
+                const std::ptrdiff_t received = receive(client, buffer.data(), buffer.size());
+                if (received < 0)
                 {
-#ifdef _WIN32
-                    const int received = ::recv(client, reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0);
-                    if (received == 0)
-                    {
-                        break;
-                    }
-                    if (received < 0)
-                    {
-                        if (isWouldBlock())
-                        {
-                            continue;
-                        }
-                        break;
-                    }
-                    int remaining = received;
-#else
-                    const ssize_t received = ::recv(client, buffer.data(), buffer.size(), 0);
-                    if (received == 0)
-                    {
-                        break;
-                    }
-                    if (received < 0)
-                    {
-                        if (errno == EINTR || isWouldBlock())
-                        {
-                            continue;
-                        }
-                        break;
-                    }
-                    int remaining = static_cast<int>(received);
-#endif // _WIN32
+                    break;
+                }
 
-                    const uint8_t* outPtr = buffer.data();
-                    while (remaining > 0)
-                    {
-#ifdef _WIN32
-                        const int sent = ::send(client, reinterpret_cast<const char*>(outPtr), remaining, 0);
-                        if (sent < 0)
-                        {
-                            if (isWouldBlock())
-                            {
-                                fd_set writefds;
-                                FD_ZERO(&writefds);
-                                FD_SET(client, &writefds);
-                                timeval wtv{};
-                                wtv.tv_usec = 10000;
-                                ::select(0, nullptr, &writefds, nullptr, &wtv);
-                                continue;
-                            }
-                            return;
-                        }
-#else
-                        const ssize_t sent = ::send(client, outPtr, static_cast<size_t>(remaining), 0);
-                        if (sent < 0)
-                        {
-                            if (errno == EINTR)
-                            {
-                                continue;
-                            }
-                            if (isWouldBlock())
-                            {
-                                fd_set writefds;
-                                FD_ZERO(&writefds);
-                                FD_SET(client, &writefds);
-                                timeval wtv{};
-                                wtv.tv_usec = 10000;
-                                ::select(client + 1, nullptr, &writefds, nullptr, &wtv);
-                                continue;
-                            }
-                            return;
-                        }
-#endif // _WIN32
-                        remaining -= static_cast<int>(sent);
-                        outPtr += sent;
-                    }
+                if (received > 0 && !sendAll(client, buffer.data(), static_cast<size_t>(received)))
+                {
+                    return;
                 }
             }
         }
@@ -341,6 +552,13 @@ namespace reactormq::tests
         std::atomic<SocketHandle> m_clientSocket;
         uint16_t m_port;
         std::atomic<bool> m_shouldStop;
+        std::atomic<bool> m_isPaused{ false };
+        std::atomic<bool> m_isRefusing{ false };
+        bool m_servesConcurrently = false;
+        std::mutex m_clientsMutex;
+        std::vector<SocketHandle> m_clients; ///< Accepted connections still being served; guarded by m_clientsMutex.
+        std::list<ClientThread> m_clientThreads; ///< Touched only by the accept thread.
+        std::string m_localPath; ///< Path of the Unix domain socket from startLocal(); empty when listening on TCP.
         std::jthread m_thread;
     };
 } // namespace reactormq::tests
\ No newline at end of file
@@ -0,0 +1,503 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "fixtures/echo_server.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace reactormq::tests
+{
+    /**
+     * @brief Minimal in-process MQTT broker on the loopback interface, for tests and benchmarks that must not depend
+     * on Docker.
+     *
+     * Speaks just enough MQTT 3.1.1 and 5 to serve one client at a time: CONNECT is always accepted, QoS 1/2
+     * publishes are acknowledged, SUBSCRIBE and UNSUBSCRIBE are granted as asked, PINGREQ is answered, and every
+     * PUBLISH is sent back to the client if it matches one of its subscriptions (at the lower of the two QoS levels).
+     * There are no sessions, retained messages, authentication, topic aliases or keepalive enforcement.
+     */
+    class LoopbackBroker final : public EchoServer
+    {
+    public:
+        ~LoopbackBroker() override
+        {
+            stop();
+        }
+
+        /// @brief PUBLISH packets received from clients since the broker started.
+        [[nodiscard]] std::uint64_t getPublishesReceived() const
+        {
+            return m_publishesReceived.load(std::memory_order_relaxed);
+        }
+
+        /// @brief CONNECT packets accepted since the broker started.
+        [[nodiscard]] std::uint64_t getConnectionsAccepted() const
+        {
+            return m_connectionsAccepted.load(std::memory_order_relaxed);
+        }
+
+        /// @brief PINGREQ packets received from clients since the broker started.
+        [[nodiscard]] std::uint64_t getPingsReceived() const
+        {
+            return m_pingsReceived.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::uint8_t kConnect = 1;
+        static constexpr std::uint8_t kPublish = 3;
+        static constexpr std::uint8_t kPubAck = 4;
+        static constexpr std::uint8_t kPubRec = 5;
+        static constexpr std::uint8_t kPubRel = 6;
+        static constexpr std::uint8_t kPubComp = 7;
+        static constexpr std::uint8_t kSubscribe = 8;
+        static constexpr std::uint8_t kUnsubscribe = 10;
+        static constexpr std::uint8_t kPingReq = 12;
+        static constexpr std::uint8_t kDisconnect = 14;
+        static constexpr std::uint8_t kMqtt5 = 5;
+
+        struct Subscription
+        {
+            std::string filter;
+            std::uint8_t qos = 0;
+        };
+
+        /// Per-connection state; reset for every accepted client.
+        struct Session
+        {
+            std::uint8_t protocolLevel = 4;
+            std::vector<Subscription> subscriptions;
+            std::uint16_t nextPacketId = 0;
+            std::vector<uint8_t> out;
+
+            [[nodiscard]] bool isMqtt5() const
+            {
+                return protocolLevel == kMqtt5;
+            }
+        };
+
+        /// Bounds-checked reader over one packet's variable header and payload.
+        class Reader
+        {
+        public:
+            explicit Reader(const std::span<const uint8_t> data)
+                : m_data(data)
+            {
+            }
+
+            [[nodiscard]] bool isOk() const
+            {
+                return m_isOk;
+            }
+
+            [[nodiscard]] size_t getRemaining() const
+            {
+                return m_isOk ? m_data.size() - m_offset : 0;
+            }
+
+            std::uint8_t readByte()
+            {
+                if (getRemaining() < 1)
+                {
+                    m_isOk = false;
+                    return 0;
+                }
+                return m_data[m_offset++];
+            }
+
+            std::uint16_t readUint16()
+            {
+                const auto high = static_cast<std::uint16_t>(readByte());
+                return static_cast<std::uint16_t>(high << 8 | readByte());
+            }
+
+            std::string_view readString()
+            {
+                const std::uint16_t length = readUint16();
+                if (getRemaining() < length)
+                {
+                    m_isOk = false;
+                    return {};
+                }
+                const std::string_view text(reinterpret_cast<const char*>(m_data.data() + m_offset), length);
+                m_offset += length;
+                return text;
+            }
+
+            std::uint32_t readVariableByteInteger()
+            {
+                std::uint32_t value = 0;
+                for (std::uint32_t shift = 0; shift < 28; shift += 7)
+                {
+                    const std::uint8_t encoded = readByte();
+                    value |= static_cast<std::uint32_t>(encoded & 0x7F) << shift;
+                    if ((encoded & 0x80) == 0)
+                    {
+                        return value;
+                    }
+                }
+                m_isOk = false;
+                return 0;
+            }
+
+            void skip(const size_t count)
+            {
+                if (getRemaining() < count)
+                {
+                    m_isOk = false;
+                    return;
+                }
+                m_offset += count;
+            }
+
+            void skipProperties()
+            {
+                skip(readVariableByteInteger());
+            }
+
+            [[nodiscard]] std::span<const uint8_t> getRest() const
+            {
+                return m_isOk ? m_data.subspan(m_offset) : std::span<const uint8_t>{};
+            }
+
+        private:
+            std::span<const uint8_t> m_data;
+            size_t m_offset = 0;
+            bool m_isOk = true;
+        };
+
+        static void appendVariableByteInteger(std::vector<uint8_t>& out, std::uint32_t value)
+        {
+            do
+            {
+                auto encoded = static_cast<uint8_t>(value & 0x7F);
+                value >>= 7;
+                if (value > 0)
+                {
+                    encoded |= 0x80;
+                }
+                out.push_back(encoded);
+            } while (value > 0);
+        }
+
+        static void appendUint16(std::vector<uint8_t>& out, const std::uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value >> 8));
+            out.push_back(static_cast<uint8_t>(value & 0xFF));
+        }
+
+        /// PUBACK, PUBREC, PUBREL and PUBCOMP are the same two-byte packet; MQTT 5 lets a success omit its reason.
+        static void appendIdOnlyAck(std::vector<uint8_t>& out, const std::uint8_t firstByte, const std::uint16_t packetId)
+        {
+            out.push_back(firstByte);
+            out.push_back(2);
+            appendUint16(out, packetId);
+        }
+
+        static bool matchesFilter(const std::string_view filter, const std::string_view topic)
+        {
+            size_t f = 0;
+            size_t t = 0;
+            while (f <= filter.size())
+            {
+                const size_t filterEnd = std::min(filter.find('/', f), filter.size());
+                const std::string_view level = filter.substr(f, filterEnd - f);
+                if (level == "#")
+                {
+                    return true;
+                }
+                if (t > topic.size())
+                {
+                    return false;
+                }
+
+                const size_t topicEnd = std::min(topic.find('/', t), topic.size());
+                if (level != "+" && level != topic.substr(t, topicEnd - t))
+                {
+                    return false;
+                }
+
+                f = filterEnd + 1;
+                t = topicEnd + 1;
+            }
+            return t > topic.size();
+        }
+
+        void serveClient(const SocketHandle client) override
+        {
+            setNonBlocking(client);
+            Session session;
+            std::vector<uint8_t> in;
+            std::vector<uint8_t> buffer(64 * 1024);
+
+            while (!shouldStop())
+            {
+                const int ready = waitReadable(client);
+                if (ready < 0)
+                {
+                    return;
+                }
+                if (ready == 0)
+                {
+                    continue;
+                }
+
+                const std::ptrdiff_t received = receive(client, buffer.data(), buffer.size());
+                if (received < 0)
+                {
+                    return;
+                }
+                in.insert(in.end(), buffer.begin(), buffer.begin() + received);
+
+                // Answer everything that arrived in one write, as a broker under load would.
+                size_t consumed = 0;
+                bool isOpen = true;
+                while (isOpen)
+                {
+                    const auto frameLength = getFrameLength(std::span<const uint8_t>(in).subspan(consumed));
+                    if (frameLength.first == 0)
+                    {
+                        break;
+                    }
+
+                    const std::span<const uint8_t> frame(in.data() + consumed, frameLength.first + frameLength.second);
+                    isOpen = handlePacket(session, frame[0], frame.subspan(frameLength.first));
+                    consumed += frame.size();
+                }
+                in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(consumed));
+
+                if (!session.out.empty())
+                {
+                    if (!sendAll(client, session.out.data(), session.out.size()))
+                    {
+                        return;
+                    }
+                    session.out.clear();
+                }
+
+                if (!isOpen)
+                {
+                    return;
+                }
+            }
+        }
+
+        /// Fixed header size and remaining length of the first complete frame in @p data, or {0, 0} if none.
+        static std::pair<size_t, size_t> getFrameLength(const std::span<const uint8_t> data)
+        {
+            size_t remainingLength = 0;
+            for (size_t index = 1; index < 5 && index < data.size(); ++index)
+            {
+                remainingLength |= static_cast<size_t>(data[index] & 0x7F) << (7 * (index - 1));
+                if ((data[index] & 0x80) == 0)
+                {
+                    const size_t headerSize = index + 1;
+                    if (data.size() < headerSize + remainingLength)
+                    {
+                        return { 0, 0 };
+                    }
+                    return { headerSize, remainingLength };
+                }
+            }
+            return { 0, 0 };
+        }
+
+        /// @return False when the connection should be closed.
+        bool handlePacket(Session& session, const std::uint8_t firstByte, const std::span<const uint8_t> body)
+        {
+            Reader reader(body);
+            switch (firstByte >> 4)
+            {
+            case kConnect:
+                (void)reader.readString(); // protocol name
+                session.protocolLevel = reader.readByte();
+                m_connectionsAccepted.fetch_add(1, std::memory_order_relaxed);
+                session.out.push_back(0x20);
+                session.out.push_back(session.isMqtt5() ? 3 : 2);
+                session.out.push_back(0); // session present
+                session.out.push_back(0); // success
+                if (session.isMqtt5())
+                {
+                    session.out.push_back(0); // no properties
+                }
+                return reader.isOk();
+            case kPublish:
+                return handlePublish(session, firstByte, reader);
+            case kPubRec:
+                appendIdOnlyAck(session.out, 0x62, reader.readUint16());
+                return reader.isOk();
+            case kPubRel:
+                appendIdOnlyAck(session.out, 0x70, reader.readUint16());
+                return reader.isOk();
+            case kPubAck:
+            case kPubComp:
+                return true;
+            case kSubscribe:
+                return handleSubscribe(session, reader);
+            case kUnsubscribe:
+                return handleUnsubscribe(session, reader);
+            case kPingReq:
+                m_pingsReceived.fetch_add(1, std::memory_order_relaxed);
+                session.out.push_back(0xD0);
+                session.out.push_back(0);
+                return true;
+            case kDisconnect:
+                return false;
+            default:
+                return true;
+            }
+        }
+
+        bool handlePublish(Session& session, const std::uint8_t firstByte, Reader& reader)
+        {
+            const auto qos = static_cast<std::uint8_t>(firstByte >> 1 & 0x03);
+            const std::string_view topic = reader.readString();
+            const std::uint16_t packetId = qos > 0 ? reader.readUint16() : 0;
+            if (session.isMqtt5())
+            {
+                reader.skipProperties();
+            }
+            const std::span<const uint8_t> payload = reader.getRest();
+            if (!reader.isOk())
+            {
+                return false;
+            }
+
+            m_publishesReceived.fetch_add(1, std::memory_order_relaxed);
+            if (qos == 1)
+            {
+                appendIdOnlyAck(session.out, 0x40, packetId);
+            }
+            else if (qos == 2)
+            {
+                appendIdOnlyAck(session.out, 0x50, packetId);
+            }
+
+            int grantedQos = -1;
+            for (const Subscription& subscription : session.subscriptions)
+            {
+                if (matchesFilter(subscription.filter, topic))
+                {
+                    grantedQos = std::max<int>(grantedQos, subscription.qos);
+                }
+            }
+            if (grantedQos >= 0)
+            {
+                forward(session, topic, payload, static_cast<std::uint8_t>(std::min<int>(grantedQos, qos)));
+            }
+            return true;
+        }
+
+        static void forward(Session& session, const std::string_view topic, const std::span<const uint8_t> payload, const std::uint8_t qos)
+        {
+            const size_t remainingLength = 2 + topic.size() + (qos > 0 ? 2 : 0) + (session.isMqtt5() ? 1 : 0) + payload.size();
+            session.out.push_back(static_cast<uint8_t>(kPublish << 4 | qos << 1));
+            appendVariableByteInteger(session.out, static_cast<std::uint32_t>(remainingLength));
+            appendUint16(session.out, static_cast<std::uint16_t>(topic.size()));
+            session.out.insert(session.out.end(), topic.begin(), topic.end());
+            if (qos > 0)
+            {
+                session.nextPacketId = static_cast<std::uint16_t>(session.nextPacketId % 65535 + 1);
+                appendUint16(session.out, session.nextPacketId);
+            }
+            if (session.isMqtt5())
+            {
+                session.out.push_back(0); // no properties
+            }
+            session.out.insert(session.out.end(), payload.begin(), payload.end());
+        }
+
+        static bool handleSubscribe(Session& session, Reader& reader)
+        {
+            const std::uint16_t packetId = reader.readUint16();
+            if (session.isMqtt5())
+            {
+                reader.skipProperties();
+            }
+
+            std::vector<uint8_t> codes;
+            while (reader.isOk() && reader.getRemaining() > 0)
+            {
+                std::string_view filter = reader.readString();
+                const auto qos = static_cast<std::uint8_t>(reader.readByte() & 0x03);
+
+                // A shared subscription matches like its filter part; one client at a time has nobody to share with.
+                if (filter.starts_with("$share/"))
+                {
+                    filter.remove_prefix(std::min(filter.find('/', 7) + 1, filter.size()));
+                }
+                session.subscriptions.push_back(Subscription{ std::string(filter), qos });
+                codes.push_back(qos);
+            }
+            if (!reader.isOk())
+            {
+                return false;
+            }
+
+            session.out.push_back(0x90);
+            appendVariableByteInteger(session.out, static_cast<std::uint32_t>(2 + (session.isMqtt5() ? 1 : 0) + codes.size()));
+            appendUint16(session.out, packetId);
+            if (session.isMqtt5())
+            {
+                session.out.push_back(0); // no properties
+            }
+            session.out.insert(session.out.end(), codes.begin(), codes.end());
+            return true;
+        }
+
+        static bool handleUnsubscribe(Session& session, Reader& reader)
+        {
+            const std::uint16_t packetId = reader.readUint16();
+            if (session.isMqtt5())
+            {
+                reader.skipProperties();
+            }
+
+            size_t count = 0;
+            while (reader.isOk() && reader.getRemaining() > 0)
+            {
+                const std::string_view filter = reader.readString();
+                std::erase_if(
+                    session.subscriptions,
+                    [filter](const Subscription& subscription)
+                    {
+                        return subscription.filter == filter;
+                    });
+                ++count;
+            }
+            if (!reader.isOk())
+            {
+                return false;
+            }
+
+            session.out.push_back(0xB0);
+            if (session.isMqtt5())
+            {
+                appendVariableByteInteger(session.out, static_cast<std::uint32_t>(3 + count));
+                appendUint16(session.out, packetId);
+                session.out.push_back(0); // no properties
+                session.out.insert(session.out.end(), count, 0); // success for every filter
+            }
+            else
+            {
+                session.out.push_back(2);
+                appendUint16(session.out, packetId);
+            }
+            return true;
+        }
+
+        std::atomic<std::uint64_t> m_publishesReceived{ 0 };
+        std::atomic<std::uint64_t> m_connectionsAccepted{ 0 };
+        std::atomic<std::uint64_t> m_pingsReceived{ 0 };
+    };
+} // namespace reactormq::tests
@@ -0,0 +1,236 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "fixtures/allocation_counter.h"
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif // _WIN32
+
+namespace reactormq::tests
+{
+    /// What one outage cost the clients of a ReconnectStorm.
+    struct StormResult
+    {
+        bool hasRecovered = false; ///< Every client was connected again before the deadline.
+        std::chrono::microseconds medianRecovery{ 0 }; ///< From the broker coming back to a client being ready again.
+        std::chrono::microseconds slowestRecovery{ 0 };
+        /// Connection attempts by all clients; each is a TCP handshake, plus a TLS one on a TLS link.
+        std::uint64_t connectAttempts = 0;
+        AllocationCounts allocations; ///< Heap calls by the clients while they dropped, retried and recovered.
+    };
+
+    /**
+     * @brief Peak resident set size of the process so far, in bytes; 0 where the platform does not report it.
+     * A high-water mark, so it only says something when it grows.
+     */
+    inline std::uint64_t getPeakResidentBytes()
+    {
+#ifdef _WIN32
+        return 0;
+#else
+        rusage usage{};
+        if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#ifdef __APPLE__
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif // __APPLE__
+#endif // _WIN32
+    }
+
+    /**
+     * @brief Many auto-reconnecting clients on one LoopbackBroker, and outages that drop all of them at once.
+     *
+     * The clients are ticked on the calling thread, so an AllocationScope there counts them and not the broker. During
+     * an outage the broker accepts and closes every connection, so retries fail the way they do against a broker that
+     * is restarting behind a load balancer.
+     */
+    class ReconnectStorm final
+    {
+    public:
+        ~ReconnectStorm()
+        {
+            std::vector<mqtt::DisconnectFuture> disconnects;
+            for (const auto& client : m_clients)
+            {
+                disconnects.push_back(client->disconnectAsync());
+            }
+            (void)tickUntil(
+                [&disconnects]
+                {
+                    return std::ranges::all_of(
+                        disconnects,
+                        [](const mqtt::DisconnectFuture& future)
+                        {
+                            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                        });
+                });
+        }
+
+        /**
+         * @brief Start the broker and connect @p clientCount clients to it.
+         * @return False if the broker did not start or the clients were not all connected within the deadline.
+         */
+        bool start(const size_t clientCount)
+        {
+            m_broker.setServesConcurrently(true);
+            const uint16_t port = m_broker.start(0);
+            if (port == 0)
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < clientCount; ++i)
+            {
+                m_clients.push_back(mqtt::client::createClient(mqtt::ConnectionSettingsBuilder("127.0.0.1")
+                                                                   .setPort(port)
+                                                                   .setProtocol(mqtt::ConnectionProtocol::Tcp)
+                                                                   .setClientId("reactormq-storm-" + std::to_string(i))
+                                                                   .setAutoReconnectEnabled(true)
+                                                                   .setAutoReconnectInitialDelayMs(kInitialRetryDelayMs)
+                                                                   .setAutoReconnectMaxDelayMs(kMaxRetryDelayMs)
+                                                                   .build()));
+                (void)m_clients.back()->connectAsync(true);
+            }
+            return tickUntil(
+                [this]
+                {
+                    return areAllConnected();
+                });
+        }
+
+        /**
+         * @brief Drop every connection, keep the broker down for @p outage, then bring it back and tick until every
+         * client is connected again.
+         */
+        StormResult run(const std::chrono::milliseconds outage)
+        {
+            StormResult result;
+            const std::uint64_t attemptsBefore = getConnectAttempts();
+            const AllocationScope allocations;
+
+            m_broker.setRefusing(true);
+            m_broker.dropClients();
+            const auto restoreAt = std::chrono::steady_clock::now() + outage;
+            while (std::chrono::steady_clock::now() < restoreAt)
+            {
+                tickAll();
+            }
+            m_broker.setRefusing(false);
+
+            const auto restoredAt = std::chrono::steady_clock::now();
+            std::vector<std::chrono::microseconds> recoveries(m_clients.size(), std::chrono::microseconds::max());
+            result.hasRecovered = tickUntil(
+                [this, restoredAt, &recoveries]
+                {
+                    bool isDone = true;
+                    for (size_t i = 0; i < m_clients.size(); ++i)
+                    {
+                        if (recoveries[i] == std::chrono::microseconds::max() && m_clients[i]->isConnected())
+                        {
+                            recoveries[i] = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - restoredAt);
+                        }
+                        isDone = isDone && recoveries[i] != std::chrono::microseconds::max();
+                    }
+                    return isDone;
+                });
+
+            result.allocations = allocations.getCounts();
+            result.connectAttempts = getConnectAttempts() - attemptsBefore;
+            std::ranges::sort(recoveries);
+            if (!recoveries.empty())
+            {
+                result.medianRecovery = recoveries[recoveries.size() / 2];
+                result.slowestRecovery = recoveries.back();
+            }
+            return result;
+        }
+
+        [[nodiscard]] const LoopbackBroker& getBroker() const
+        {
+            return m_broker;
+        }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<mqtt::IClient>>& getClients() const
+        {
+            return m_clients;
+        }
+
+    private:
+        // Short enough that recovery is measured in milliseconds, long enough that retries during an outage back off.
+        static constexpr uint32_t kInitialRetryDelayMs = 10;
+        static constexpr uint32_t kMaxRetryDelayMs = 500;
+
+        void tickAll() const
+        {
+            for (const auto& client : m_clients)
+            {
+                client->tick();
+            }
+            // Hundreds of idle ticks in a row would only spin; the broker and the kernel need the core too.
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        /// Tick every client until @p isDone holds; false after 10 s, which only a broken broker or client takes.
+        template<typename Predicate>
+        bool tickUntil(Predicate&& isDone) const
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!isDone())
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                tickAll();
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool areAllConnected() const
+        {
+            return std::ranges::all_of(
+                m_clients,
+                [](const auto& client)
+                {
+                    return client->isConnected();
+                });
+        }
+
+        [[nodiscard]] std::uint64_t getConnectAttempts() const
+        {
+            std::uint64_t attempts = 0;
+            for (const auto& client : m_clients)
+            {
+                attempts += client->getMetrics().connectAttempts;
+            }
+            return attempts;
+        }
+
+        LoopbackBroker m_broker;
+        std::vector<std::shared_ptr<mqtt::IClient>> m_clients;
+    };
+} // namespace reactormq::tests
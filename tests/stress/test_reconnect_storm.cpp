@@ -0,0 +1,47 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/reconnect_storm.h"
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+using reactormq::tests::ReconnectStorm;
+using reactormq::tests::StormResult;
+
+TEST(ReconnectStormTest, HundredsOfClientsRecoverFromRepeatedOutages)
+{
+    constexpr size_t kClientCount = 256;
+    constexpr int kStormCount = 3;
+
+    ReconnectStorm storm;
+    ASSERT_TRUE(storm.start(kClientCount));
+
+    for (int i = 0; i < kStormCount; ++i)
+    {
+        const StormResult result = storm.run(std::chrono::milliseconds(200));
+        ASSERT_TRUE(result.hasRecovered) << "storm " << i;
+
+        // Every client retried at least once against the refusing broker before it came back.
+        EXPECT_GT(result.connectAttempts, kClientCount) << "storm " << i;
+        EXPECT_LT(result.slowestRecovery, std::chrono::seconds(2)) << "storm " << i;
+
+        const std::string prefix = "storm" + std::to_string(i) + "_";
+        testing::Test::RecordProperty(prefix + "median_recovery_us", std::to_string(result.medianRecovery.count()));
+        testing::Test::RecordProperty(prefix + "slowest_recovery_us", std::to_string(result.slowestRecovery.count()));
+        testing::Test::RecordProperty(prefix + "connect_attempts", std::to_string(result.connectAttempts));
+        testing::Test::RecordProperty(prefix + "allocations", std::to_string(result.allocations.allocations));
+    }
+
+    for (const auto& client : storm.getClients())
+    {
+        const auto metrics = client->getMetrics();
+        EXPECT_EQ(metrics.connections, static_cast<std::uint64_t>(kStormCount + 1));
+        EXPECT_EQ(metrics.disconnects, static_cast<std::uint64_t>(kStormCount));
+        EXPECT_EQ(metrics.parseFailures, 0u);
+    }
+    EXPECT_EQ(storm.getBroker().getConnectionsAccepted(), kClientCount * (kStormCount + 1));
+}
@@ -0,0 +1,191 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/loopback_broker.h"
+#include "mqtt/client/async_result.h"
+#include "reactormq/mqtt/caching_credentials_provider.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+using namespace std::chrono_literals;
+
+namespace
+{
+    /// Hands out credentials only when the test releases them, from the test's own thread.
+    class DeferredCredentialsProvider final : public ICredentialsProvider
+    {
+    public:
+        Credentials getCredentials() override
+        {
+            ADD_FAILURE() << "the client must not ask for credentials synchronously";
+            return {};
+        }
+
+        void getCredentialsAsync(CredentialsCallback onReady) override
+        {
+            const std::lock_guard lock(m_mutex);
+            m_onReady = std::move(onReady);
+        }
+
+        [[nodiscard]] bool isAsked()
+        {
+            const std::lock_guard lock(m_mutex);
+            return static_cast<bool>(m_onReady);
+        }
+
+        void release()
+        {
+            CredentialsCallback onReady;
+            {
+                const std::lock_guard lock(m_mutex);
+                onReady = std::exchange(m_onReady, nullptr);
+            }
+            std::thread([onReady = std::move(onReady)] { onReady(Credentials{ "user", "token" }); }).join();
+        }
+
+    private:
+        std::mutex m_mutex;
+        CredentialsCallback m_onReady;
+    };
+} // namespace
+
+TEST(AsyncResultTest, FirstValueWinsAndRaisesTheSignal)
+{
+    const auto signal = std::make_shared<AsyncSignal>();
+    const auto result = std::make_shared<AsyncResult<int>>(signal);
+    EXPECT_FALSE(result->take().has_value());
+
+    const auto setter = AsyncResult<int>::makeSetter(result);
+    setter(1);
+    setter(2);
+    EXPECT_TRUE(signal->isRaised.load());
+    EXPECT_EQ(result->take(), 1);
+    EXPECT_FALSE(result->take().has_value());
+}
+
+TEST(AsyncResultTest, AValueArrivingAfterTheResultIsGoneIsDropped)
+{
+    const auto signal = std::make_shared<AsyncSignal>();
+    auto result = std::make_shared<AsyncResult<int>>(signal);
+    const auto setter = AsyncResult<int>::makeSetter(result);
+    result.reset();
+
+    setter(1);
+    EXPECT_FALSE(signal->isRaised.load());
+}
+
+TEST(CachingCredentialsProviderTest, ConcurrentRequestsShareOneFetchAndThenHitTheCache)
+{
+    std::atomic<int> fetches{ 0 };
+    CachingCredentialsProvider provider(
+        [&fetches]
+        {
+            std::this_thread::sleep_for(20ms);
+            ++fetches;
+            return CachingCredentialsProvider::Token{ Credentials{ "user", "token" }, 1h };
+        });
+
+    std::atomic<int> delivered{ 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+        provider.getCredentialsAsync(
+            [&delivered](const Credentials& credentials)
+            {
+                EXPECT_EQ(credentials.password, "token");
+                ++delivered;
+            });
+    }
+    EXPECT_EQ(provider.getCredentials().username, "user");
+    EXPECT_EQ(delivered.load(), 4);
+    EXPECT_EQ(fetches.load(), 1);
+
+    // A valid token is delivered inline.
+    bool wasInline = false;
+    provider.getCredentialsAsync([&wasInline](const Credentials&) { wasInline = true; });
+    EXPECT_TRUE(wasInline);
+    EXPECT_EQ(fetches.load(), 1);
+}
+
+TEST(CachingCredentialsProviderTest, ATokenNearExpiryIsServedWhileItRefreshes)
+{
+    std::atomic<int> fetches{ 0 };
+    CachingCredentialsProvider provider(
+        [&fetches]
+        {
+            const int fetch = ++fetches;
+            return CachingCredentialsProvider::Token{ Credentials{ "user", "token" + std::to_string(fetch) }, 1h };
+        },
+        2h);
+
+    EXPECT_EQ(provider.getCredentials().password, "token1");
+
+    // Every token is inside the refresh window, so each request serves the cached one and refreshes behind it.
+    std::optional<Credentials> served;
+    provider.getCredentialsAsync([&served](Credentials credentials) { served = std::move(credentials); });
+    ASSERT_TRUE(served.has_value());
+    EXPECT_EQ(served->password, "token1");
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (fetches.load() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(fetches.load(), 2);
+
+    provider.invalidate();
+    EXPECT_EQ(provider.getCredentials().password, "token3");
+}
+
+TEST(AsyncCredentialsTest, ConnectWaitsForCredentialsWithoutBlockingTheClient)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto provider = std::make_shared<DeferredCredentialsProvider>();
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("async-credentials-test")
+                                         .setCredentialsProvider(provider)
+                                         .build());
+
+    const auto tickUntil = [&client](const auto& isDone)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!isDone() && std::chrono::steady_clock::now() < deadline)
+        {
+            client->waitAndTick(5ms);
+        }
+    };
+
+    (void)client->connectAsync(true);
+    tickUntil([&provider] { return provider->isAsked(); });
+    ASSERT_TRUE(provider->isAsked());
+
+    // The socket is open, but no CONNECT goes out until the provider delivers.
+    const auto idleUntil = std::chrono::steady_clock::now() + 50ms;
+    tickUntil([idleUntil] { return std::chrono::steady_clock::now() >= idleUntil; });
+    EXPECT_FALSE(client->isConnected());
+    EXPECT_EQ(broker.getConnectionsAccepted(), 0u);
+
+    provider->release();
+    tickUntil([&client] { return client->isConnected(); });
+    EXPECT_TRUE(client->isConnected());
+    EXPECT_EQ(broker.getConnectionsAccepted(), 1u);
+    broker.stop();
+}
@@ -7,6 +7,7 @@
 #include "mqtt/client/backoff.h"
 
 #include <algorithm>
+#include <vector>
 
 using reactormq::mqtt::client::BackoffCalculator;
 
@@ -95,4 +96,45 @@ TEST(BackoffCalculatorTest, ResetAffectsNextDelayAsFirstAttemptAgain)
     calc.reset();
     const auto d = calc.calculateNextDelay();
     expectWithinJitter(static_cast<uint32_t>(d.count()), 250u);
-}
\ No newline at end of file
+}
+TEST(BackoffCalculatorTest, DecorrelatedDelaysStayBetweenInitialAndThreeTimesThePrevious)
+{
+    BackoffCalculator calc(100, 5000, 2.0, reactormq::mqtt::ReconnectJitter::Decorrelated);
+    uint32_t previous = 100;
+    for (int i = 0; i < 200; ++i)
+    {
+        const auto delay = static_cast<uint32_t>(calc.calculateNextDelay().count());
+        EXPECT_GE(delay, 100u);
+        EXPECT_LE(delay, std::min(previous * 3, 5000u));
+        previous = delay;
+    }
+    EXPECT_EQ(calc.getAttemptCount(), 200u);
+}
+
+TEST(BackoffCalculatorTest, DecorrelatedDelaysSpreadAcrossClients)
+{
+    // Clients that fail together should not all pick the same delay, as a ±10% jitter around one base would.
+    std::vector<uint32_t> thirdDelays;
+    for (int client = 0; client < 50; ++client)
+    {
+        BackoffCalculator calc(100, 60'000, 2.0, reactormq::mqtt::ReconnectJitter::Decorrelated);
+        (void)calc.calculateNextDelay();
+        (void)calc.calculateNextDelay();
+        thirdDelays.push_back(static_cast<uint32_t>(calc.calculateNextDelay().count()));
+    }
+    const auto [minIt, maxIt] = std::minmax_element(thirdDelays.begin(), thirdDelays.end());
+    EXPECT_GT(*maxIt, *minIt * 2);
+}
+
+TEST(BackoffCalculatorTest, DecorrelatedResetStartsFromTheInitialDelayAgain)
+{
+    BackoffCalculator calc(100, 100'000, 2.0, reactormq::mqtt::ReconnectJitter::Decorrelated);
+    for (int i = 0; i < 20; ++i)
+    {
+        (void)calc.calculateNextDelay();
+    }
+    calc.reset();
+    const auto delay = static_cast<uint32_t>(calc.calculateNextDelay().count());
+    EXPECT_GE(delay, 100u);
+    EXPECT_LE(delay, 300u);
+}
@@ -0,0 +1,129 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/chunked_transfer.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    class RecordingSink final : public IPayloadSink
+    {
+    public:
+        void onBegin(const MessageView& header, const size_t size) override
+        {
+            topic = header.getTopic();
+            payloadSize = size;
+            ++begun;
+        }
+
+        void onChunk(const std::span<const std::uint8_t> chunk) override
+        {
+            payload.insert(payload.end(), chunk.begin(), chunk.end());
+        }
+
+        void onEnd(const bool isComplete) override
+        {
+            ended.push_back(isComplete);
+        }
+
+        std::string topic;
+        size_t payloadSize = 0;
+        int begun = 0;
+        std::vector<std::uint8_t> payload;
+        std::vector<bool> ended;
+    };
+
+    std::vector<std::uint8_t> makeChunk(const ChunkHeader& header, const std::vector<std::uint8_t>& body)
+    {
+        std::vector<std::uint8_t> chunk(kChunkHeaderSize);
+        header.encode(std::span(chunk).first<kChunkHeaderSize>());
+        chunk.insert(chunk.end(), body.begin(), body.end());
+        return chunk;
+    }
+
+    bool deliver(ChunkAssemblers& assemblers, const std::string& topic, const std::vector<std::uint8_t>& payload)
+    {
+        return assemblers.deliver(MessageView(topic, payload, false, QualityOfService::AtLeastOnce));
+    }
+} // namespace
+
+TEST(ChunkedTransferTest, HeaderRoundTripsAndRejectsOtherPayloads)
+{
+    const ChunkHeader header{ 0x0102030405060708ULL, 2, 3, 0x1'0000'0001ULL };
+    const std::vector<std::uint8_t> chunk = makeChunk(header, { 9 });
+    EXPECT_EQ(std::string(chunk.begin(), chunk.begin() + 4), "RMQC");
+    EXPECT_EQ(chunk[8], 0x01);
+    EXPECT_EQ(chunk[15], 0x08);
+
+    const auto decoded = ChunkHeader::decode(chunk);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->transferId, header.transferId);
+    EXPECT_EQ(decoded->sequence, 2u);
+    EXPECT_EQ(decoded->chunkCount, 3u);
+    EXPECT_EQ(decoded->totalSize, header.totalSize);
+
+    EXPECT_FALSE(ChunkHeader::decode(std::span(chunk).first(kChunkHeaderSize - 1)).has_value());
+    std::vector<std::uint8_t> otherVersion = chunk;
+    otherVersion[4] = 2;
+    EXPECT_FALSE(ChunkHeader::decode(otherVersion).has_value());
+    EXPECT_FALSE(ChunkHeader::decode(makeChunk(ChunkHeader{ 1, 3, 3, 0 }, {})).has_value());
+    EXPECT_FALSE(ChunkHeader::decode(std::vector<std::uint8_t>(kChunkHeaderSize, 0)).has_value());
+}
+
+TEST(ChunkedTransferTest, AssemblerPassesChunksOnInOrderAndSkipsDuplicates)
+{
+    ChunkAssemblers assemblers;
+    const auto sink = std::make_shared<RecordingSink>();
+    assemblers.add("files/+", sink);
+
+    EXPECT_FALSE(deliver(assemblers, "other", makeChunk(ChunkHeader{ 7, 0, 2, 3 }, { 1, 2 })));
+    EXPECT_FALSE(deliver(assemblers, "files/a", { 1, 2, 3 }));
+
+    EXPECT_TRUE(deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 7, 0, 2, 3 }, { 1, 2 })));
+    EXPECT_TRUE(deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 7, 0, 2, 3 }, { 1, 2 })));
+    EXPECT_TRUE(deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 7, 1, 2, 3 }, { 3 })));
+    EXPECT_EQ(sink->topic, "files/a");
+    EXPECT_EQ(sink->payloadSize, 3u);
+    EXPECT_EQ(sink->payload, (std::vector<std::uint8_t>{ 1, 2, 3 }));
+    EXPECT_EQ(sink->ended, (std::vector<bool>{ true }));
+
+    // A late copy of a chunk of the finished transfer is consumed without starting it again.
+    EXPECT_TRUE(deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 7, 0, 2, 3 }, { 1, 2 })));
+    EXPECT_EQ(sink->begun, 1);
+}
+
+TEST(ChunkedTransferTest, AssemblerEndsTransfersWithAGapOrCutShort)
+{
+    ChunkAssemblers assemblers;
+    const auto sink = std::make_shared<RecordingSink>();
+    assemblers.add("files/#", sink);
+
+    deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 1, 0, 3, 3 }, { 1 }));
+    EXPECT_TRUE(deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 1, 2, 3, 3 }, { 3 })));
+    EXPECT_EQ(sink->ended, (std::vector<bool>{ false }));
+
+    // A new transfer on the topic ends the one in progress; a transfer joined part way through is dropped.
+    deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 2, 0, 2, 2 }, { 1 }));
+    deliver(assemblers, "files/a", makeChunk(ChunkHeader{ 3, 0, 1, 1 }, { 1 }));
+    EXPECT_EQ(sink->ended, (std::vector<bool>{ false, false, true }));
+    EXPECT_TRUE(deliver(assemblers, "files/b", makeChunk(ChunkHeader{ 4, 1, 2, 2 }, { 1 })));
+    EXPECT_EQ(sink->begun, 3);
+
+    // Unsubscribing ends a transfer in progress.
+    deliver(assemblers, "files/c", makeChunk(ChunkHeader{ 5, 0, 2, 2 }, { 1 }));
+    EXPECT_EQ(assemblers.remove("files/#"), 1u);
+    EXPECT_TRUE(assemblers.isEmpty());
+    EXPECT_EQ(sink->ended, (std::vector<bool>{ false, false, true, false }));
+}
@@ -0,0 +1,240 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/allocation_counter.h"
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/topic_filter.h"
+#include "util/logging/registry.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::AllocationCounts;
+using reactormq::tests::AllocationScope;
+using reactormq::logging::LogLevel;
+using reactormq::logging::Registry;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    constexpr size_t kWarmUp = 256;
+    constexpr size_t kMeasured = 256;
+
+    // Steady-state budgets, per message. Lower them as allocations are removed; never raise them to make a test pass.
+    // Outbound: the PUBLISH header is encoded into a freshly reserved ByteWriter buffer.
+    constexpr uint64_t kQos0PublishBudget = 1;
+    // Inbound: the payload is copied out of the receive buffer and wrapped in a SharedPayload.
+    constexpr uint64_t kQos0DeliveryBudget = 2;
+    // Queue and buffer growth amortised over a window, not charged to any one message.
+    constexpr uint64_t kWindowSlack = 16;
+    // Heap bytes of a client that is created and never connects; the in-flight tables come with the first use.
+    constexpr uint64_t kIdleClientBytesBudget = 8 * 1024;
+
+    template<typename Predicate>
+    bool tickUntil(IClient& client, Predicate&& isDone)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!isDone())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            client.waitAndTick(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /// Messages built before the measured window, so constructing them is not charged to the client.
+    std::vector<Message> makeMessages(const char* topic, const size_t count)
+    {
+        std::vector<Message> messages;
+        messages.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            messages.emplace_back(topic, Message::Payload(64, 0x5A), false, QualityOfService::AtMostOnce);
+        }
+        return messages;
+    }
+
+    /**
+     * The client ticks on the test thread while the broker runs on its own, so an AllocationScope around the ticks counts
+     * only the client.
+     */
+    class ClientAllocationTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!reactormq::tests::isAllocationCountingEnabled())
+            {
+                GTEST_SKIP() << "Built without REACTORMQ_TEST_COUNT_ALLOCATIONS";
+            }
+
+            // Trace logging formats strings on every tick; the budgets cover the client, not its diagnostics.
+            m_previousLevel = Registry::instance().level();
+            Registry::instance().setLevel(LogLevel::Warn);
+
+            const uint16_t port = m_broker.start(0);
+            ASSERT_NE(port, 0);
+
+            m_client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                        .setPort(port)
+                                        .setProtocol(ConnectionProtocol::Tcp)
+                                        .setClientId("allocation-test")
+                                        .build());
+            auto connected = m_client->connectAsync(true);
+            ASSERT_TRUE(tickUntil(
+                *m_client,
+                [&connected]
+                {
+                    return connected.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                }));
+            ASSERT_TRUE(connected.get().hasSucceeded());
+        }
+
+        void TearDown() override
+        {
+            if (m_client)
+            {
+                auto disconnected = m_client->disconnectAsync();
+                (void)tickUntil(
+                    *m_client,
+                    [&disconnected]
+                    {
+                        return disconnected.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                    });
+            }
+            m_broker.stop();
+            Registry::instance().setLevel(m_previousLevel);
+        }
+
+        /// Publish @p messages fire-and-forget and tick until the broker has seen @p expected publishes in total.
+        bool publishAll(std::vector<Message>& messages, const uint64_t expected)
+        {
+            for (Message& message : messages)
+            {
+                m_client->publish(std::move(message));
+            }
+            return tickUntil(
+                *m_client,
+                [this, expected]
+                {
+                    return m_broker.getPublishesReceived() >= expected;
+                });
+        }
+
+        LoopbackBroker m_broker;
+        std::shared_ptr<IClient> m_client;
+        LogLevel m_previousLevel = LogLevel::Info;
+    };
+} // namespace
+
+TEST(ClientFootprintTest, IdleClientStaysWithinItsHeapBudget)
+{
+    if (!reactormq::tests::isAllocationCountingEnabled())
+    {
+        GTEST_SKIP() << "Built without REACTORMQ_TEST_COUNT_ALLOCATIONS";
+    }
+
+    const LogLevel previousLevel = Registry::instance().level();
+    Registry::instance().setLevel(LogLevel::Warn);
+    const ConnectionSettingsPtr settings = ConnectionSettingsBuilder("127.0.0.1").setClientId("footprint-test").build();
+
+    constexpr size_t kClients = 16;
+    std::vector<std::shared_ptr<IClient>> clients;
+    clients.reserve(kClients);
+    const AllocationScope scope;
+    for (size_t i = 0; i < kClients; ++i)
+    {
+        clients.push_back(createClient(settings));
+    }
+    const AllocationCounts counts = scope.getCounts();
+    Registry::instance().setLevel(previousLevel);
+
+    EXPECT_LE(counts.bytes, kIdleClientBytesBudget * kClients);
+}
+
+TEST_F(ClientAllocationTest, IdleTicksDoNotAllocate)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        m_client->waitAndTick(std::chrono::milliseconds(1));
+    }
+
+    const AllocationScope scope;
+    for (int i = 0; i < 100; ++i)
+    {
+        m_client->waitAndTick(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(scope.getCounts().allocations, 0u);
+}
+
+TEST_F(ClientAllocationTest, Qos0PublishAllocationsStayWithinBudget)
+{
+    std::vector<Message> warmUp = makeMessages("alloc/out", kWarmUp);
+    std::vector<Message> measured = makeMessages("alloc/out", kMeasured);
+    ASSERT_TRUE(publishAll(warmUp, kWarmUp));
+
+    AllocationCounts counts;
+    {
+        const AllocationScope scope;
+        ASSERT_TRUE(publishAll(measured, kWarmUp + kMeasured));
+        counts = scope.getCounts();
+    }
+    EXPECT_LE(counts.allocations, kQos0PublishBudget * kMeasured + kWindowSlack);
+}
+
+TEST_F(ClientAllocationTest, Qos0DeliveryAllocationsStayWithinBudget)
+{
+    size_t received = 0;
+    auto handle = m_client->onMessage().add(
+        [&received](const Message&)
+        {
+            ++received;
+        });
+    auto subscribed = m_client->subscribeAsync(TopicFilter("alloc/echo", QualityOfService::AtMostOnce, false));
+    ASSERT_TRUE(tickUntil(
+        *m_client,
+        [&subscribed]
+        {
+            return subscribed.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }));
+
+    std::vector<Message> warmUp = makeMessages("alloc/echo", kWarmUp);
+    std::vector<Message> measured = makeMessages("alloc/echo", kMeasured);
+    ASSERT_TRUE(publishAll(warmUp, kWarmUp));
+    ASSERT_TRUE(tickUntil(
+        *m_client,
+        [&received]
+        {
+            return received == kWarmUp;
+        }));
+
+    AllocationCounts counts;
+    {
+        const AllocationScope scope;
+        ASSERT_TRUE(publishAll(measured, kWarmUp + kMeasured));
+        ASSERT_TRUE(tickUntil(
+            *m_client,
+            [&received]
+            {
+                return received == kWarmUp + kMeasured;
+            }));
+        counts = scope.getCounts();
+    }
+    // The echo is published by this client too, so the round trip pays for both directions.
+    EXPECT_LE(counts.allocations, (kQos0PublishBudget + kQos0DeliveryBudget) * kMeasured + kWindowSlack);
+}
@@ -3,11 +3,15 @@
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
 #include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/completion_handler.h"
 #include "reactormq/mqtt/connection_settings_builder.h"
 #include "reactormq/mqtt/message.h"
 
+#include <coroutine>
+#include <functional>
 #include <future>
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace reactormq::mqtt;
 using namespace reactormq::mqtt::client;
@@ -20,6 +24,43 @@ namespace
         b.setHost("localhost");
         return b.build();
     }
+
+    /// @brief Minimal eagerly started coroutine type for awaiting completions in tests.
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {
+            }
+
+            void unhandled_exception()
+            {
+            }
+        };
+    };
+
+    Detached disconnectThenRecord(IClient& client, bool& succeeded, bool& finished)
+    {
+        const auto result = co_await awaitCompletion<void>([&client](auto onComplete) { client.disconnectAsync(onComplete); });
+        succeeded = result.isSuccess();
+        finished = true;
+    }
 } // namespace
 
 TEST(ClientImplTest, ConnectAsyncEnqueuesConnectCommandAndReturnsFuture)
@@ -55,6 +96,64 @@ TEST(ClientImplTest, PublishAsyncMovesMessageIntoCommandQueue)
     EXPECT_FALSE(result.isSuccess());
 }
 
+TEST(ClientImplTest, PublishWithCallbackReportsOutcomeOnTick)
+{
+    const auto client = createClient(makeSettings());
+
+    int calls = 0;
+    bool succeeded = true;
+    client->publish(
+        Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtMostOnce },
+        [&](const Result<void>& result)
+        {
+            ++calls;
+            succeeded = result.isSuccess();
+        });
+    client->publish(Message{ "a/b", Message::Payload{ 2 }, false, QualityOfService::AtMostOnce });
+    EXPECT_EQ(calls, 0);
+
+    client->tick();
+    EXPECT_EQ(calls, 1);
+    EXPECT_FALSE(succeeded);
+}
+
+TEST(ClientImplTest, CompletionHandlersRunThroughCallbackExecutor)
+{
+    std::vector<std::function<void()>> deferred;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost");
+    b.setCallbackExecutor([&deferred](std::function<void()> callback) { deferred.push_back(std::move(callback)); });
+    const auto client = createClient(b.build());
+
+    int calls = 0;
+    client->disconnectAsync([&](const Result<void>& result) { calls += result.isSuccess() ? 1 : 0; });
+    client->unsubscribeAsync({ "a/b" }, [&](const Result<std::vector<UnsubscribeResult>>&) { ++calls; });
+
+    client->tick();
+    EXPECT_EQ(calls, 0);
+    ASSERT_EQ(deferred.size(), 2u);
+
+    for (const auto& callback : deferred)
+    {
+        callback();
+    }
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(ClientImplTest, CoroutineResumesWhenCompletionArrives)
+{
+    const auto client = createClient(makeSettings());
+
+    bool succeeded = false;
+    bool finished = false;
+    disconnectThenRecord(*client, succeeded, finished);
+    EXPECT_FALSE(finished);
+
+    client->tick();
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(succeeded);
+}
+
 TEST(ClientImplTest, SubscribeAsyncVectorEnqueuesSubscribesCommand)
 {
     const auto client = createClient(makeSettings());
@@ -0,0 +1,368 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/topic_filter.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    template<typename T>
+    bool tickUntilReady(IClient& client, std::future<T>& future)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            client.waitAndTick(std::chrono::milliseconds(5));
+            if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    class ClientLoopbackTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            const uint16_t port = m_broker.start(0);
+            ASSERT_NE(port, 0);
+
+            m_client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                        .setPort(port)
+                                        .setProtocol(ConnectionProtocol::Tcp)
+                                        .setClientId("loopback-test")
+                                        .build());
+            auto connected = m_client->connectAsync(true);
+            ASSERT_TRUE(tickUntilReady(*m_client, connected));
+            ASSERT_TRUE(connected.get().hasSucceeded());
+        }
+
+        void TearDown() override
+        {
+            if (m_client)
+            {
+                auto disconnected = m_client->disconnectAsync();
+                (void)tickUntilReady(*m_client, disconnected);
+            }
+            m_broker.stop();
+        }
+
+        LoopbackBroker m_broker;
+        std::shared_ptr<IClient> m_client;
+    };
+} // namespace
+
+TEST_F(ClientLoopbackTest, PublishesAreAcknowledgedAndEchoedAtEveryQos)
+{
+    std::atomic<int> received{ 0 };
+    auto handle = m_client->onMessage().add(
+        [&received](const Message& message)
+        {
+            if (message.getTopic() == "bench/echo")
+            {
+                received.fetch_add(1);
+            }
+        });
+
+    auto subscribed = m_client->subscribeAsync(TopicFilter("bench/+", QualityOfService::ExactlyOnce, false));
+    ASSERT_TRUE(tickUntilReady(*m_client, subscribed));
+    ASSERT_TRUE(subscribed.get().hasSucceeded());
+
+    for (const QualityOfService qos : { QualityOfService::AtMostOnce, QualityOfService::AtLeastOnce, QualityOfService::ExactlyOnce })
+    {
+        auto published = m_client->publishAsync(Message("bench/echo", { 'h', 'i' }, false, qos));
+        ASSERT_TRUE(tickUntilReady(*m_client, published));
+        EXPECT_TRUE(published.get().hasSucceeded());
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.load() < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        m_client->waitAndTick(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(received.load(), 3);
+    EXPECT_EQ(m_broker.getPublishesReceived(), 3u);
+    EXPECT_EQ(m_broker.getConnectionsAccepted(), 1u);
+}
+
+TEST_F(ClientLoopbackTest, UnsubscribedTopicsAreNotEchoed)
+{
+    std::atomic<int> received{ 0 };
+    auto handle = m_client->onMessage().add(
+        [&received](const Message&)
+        {
+            received.fetch_add(1);
+        });
+
+    auto subscribed = m_client->subscribeAsync(TopicFilter("bench/#", QualityOfService::AtLeastOnce, false));
+    ASSERT_TRUE(tickUntilReady(*m_client, subscribed));
+    auto unsubscribed = m_client->unsubscribeAsync({ "bench/#" });
+    ASSERT_TRUE(tickUntilReady(*m_client, unsubscribed));
+    ASSERT_TRUE(unsubscribed.get().hasSucceeded());
+
+    auto published = m_client->publishAsync(Message("bench/quiet", { 'x' }, false, QualityOfService::AtLeastOnce));
+    ASSERT_TRUE(tickUntilReady(*m_client, published));
+    EXPECT_TRUE(published.get().hasSucceeded());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        m_client->waitAndTick(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(received.load(), 0);
+}
+
+TEST(ClientKeepaliveTest, PingsOnlyOnceTheClientStopsSending)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("keepalive-test")
+                                         .setKeepAliveIntervalSeconds(1)
+                                         .build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    // Outbound traffic well inside the interval keeps the keepalive quiet.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+    auto nextPublish = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (std::chrono::steady_clock::now() >= nextPublish)
+        {
+            (void)client->publishAsync(Message("keepalive/busy", { 'x' }, false, QualityOfService::AtMostOnce));
+            nextPublish += std::chrono::milliseconds(200);
+        }
+        client->waitAndTick(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(broker.getPingsReceived(), 0u);
+
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+    while (broker.getPingsReceived() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        client->waitAndTick(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(broker.getPingsReceived(), 1u);
+    EXPECT_TRUE(client->isConnected());
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+
+TEST(ClientBusyPollTest, WaitAndTickSpinsInsteadOfSleeping)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("busy-poll-test")
+                                         .setBusyPoll(BusyPollOptions::spin())
+                                         .build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    // An idle busy-polling client returns after a backoff, not after the wait it was given.
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+    {
+        client->waitAndTick(std::chrono::seconds(1));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    auto published = client->publishAsync(Message("busy/poll", { 'x' }, false, QualityOfService::AtLeastOnce));
+    ASSERT_TRUE(tickUntilReady(*client, published));
+    EXPECT_TRUE(published.get().hasSucceeded());
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+
+TEST(ClientPublishDedupTest, UnchangedRetainedStateIsSentOnce)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    PublishDedupOptions dedup;
+    dedup.isEnabled = true;
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("dedup-test")
+                                         .setPublishDedup(dedup)
+                                         .build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    for (const char state : { '1', '1', '1', '0' })
+    {
+        Message::Payload payload{ static_cast<std::uint8_t>(state) };
+        auto published = client->publishAsync(Message("device/state", std::move(payload), true, QualityOfService::AtLeastOnce));
+        ASSERT_TRUE(tickUntilReady(*client, published));
+        EXPECT_TRUE(published.get().hasSucceeded());
+    }
+
+    EXPECT_EQ(broker.getPublishesReceived(), 2u);
+    EXPECT_EQ(client->getMetrics().messagesDeduplicated, 2u);
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+
+TEST(ClientProducerEncodingTest, PublishesEncodedOnProducerThreadsAllArrive)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("producer-encoding-test")
+                                         .setEncodePublishesOnCallingThread(true)
+                                         .build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50;
+    std::atomic<int> succeeded{ 0 };
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducers; ++producer)
+    {
+        producers.emplace_back(
+            [&client, &succeeded, producer]
+            {
+                const std::string topic = "producers/" + std::to_string(producer);
+                for (int i = 0; i < kPerProducer; ++i)
+                {
+                    // Alternating QoS makes some packets carry an identifier for the reactor to patch in and some not.
+                    const QualityOfService qos = i % 2 == 0 ? QualityOfService::AtLeastOnce : QualityOfService::AtMostOnce;
+                    Message message(topic, Message::Payload(16, static_cast<std::uint8_t>(i)), false, qos);
+                    client->publish(
+                        std::move(message),
+                        [&succeeded](const Result<void>& result)
+                        {
+                            if (result.hasSucceeded())
+                            {
+                                succeeded.fetch_add(1);
+                            }
+                        });
+                }
+            });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((succeeded.load() < kProducers * kPerProducer || broker.getPublishesReceived() < kProducers * kPerProducer)
+           && std::chrono::steady_clock::now() < deadline)
+    {
+        client->waitAndTick(std::chrono::milliseconds(5));
+    }
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(succeeded.load(), kProducers * kPerProducer);
+    EXPECT_EQ(broker.getPublishesReceived(), static_cast<size_t>(kProducers * kPerProducer));
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+
+TEST(ClientPublishRateLimitTest, PublishesOverTheRateAreCoalescedToTheLatest)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    PublishRateLimit limit;
+    limit.topicPrefix = "gauge/";
+    limit.messagesPerSecond = 20;
+    limit.burstMs = 50;
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(port)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("rate-limit-test")
+                                         .addPublishRateLimit(limit)
+                                         .build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    auto first = client->publishAsync(Message("gauge/level", { '1' }, false, QualityOfService::AtLeastOnce));
+    auto stale = client->publishAsync(Message("gauge/level", { '2' }, false, QualityOfService::AtLeastOnce));
+    auto latest = client->publishAsync(Message("gauge/level", { '3' }, false, QualityOfService::AtLeastOnce));
+    ASSERT_TRUE(tickUntilReady(*client, latest));
+    EXPECT_TRUE(latest.get().hasSucceeded());
+    ASSERT_TRUE(tickUntilReady(*client, first));
+    EXPECT_TRUE(first.get().hasSucceeded());
+    ASSERT_TRUE(tickUntilReady(*client, stale));
+    EXPECT_FALSE(stale.get().hasSucceeded());
+
+    EXPECT_EQ(broker.getPublishesReceived(), 2u);
+    EXPECT_EQ(client->getMetrics().messagesRateLimited, 1u);
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+TEST(ClientUnixSocketTest, ConnectsAndPublishesOverAUnixDomainSocket)
+{
+    LoopbackBroker broker;
+    const std::string path = "/tmp/reactormq-loopback-" + std::to_string(getpid()) + ".sock";
+    ASSERT_TRUE(broker.startLocal(path));
+
+    const auto client = createClient(
+        ConnectionSettingsBuilder(path).setProtocol(ConnectionProtocol::Unix).setClientId("unix-socket-test").build());
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+
+    auto published = client->publishAsync(Message("unix/a", { 'x' }, false, QualityOfService::AtLeastOnce));
+    ASSERT_TRUE(tickUntilReady(*client, published));
+    EXPECT_TRUE(published.get().hasSucceeded());
+    EXPECT_EQ(broker.getPublishesReceived(), 1u);
+
+    auto disconnected = client->disconnectAsync();
+    (void)tickUntilReady(*client, disconnected);
+    broker.stop();
+}
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
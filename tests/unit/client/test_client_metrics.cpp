@@ -0,0 +1,107 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/client_metric_counters.h"
+#include "reactormq/mqtt/client_metrics.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+TEST(ClientMetricsTest, TickDurationsAreBucketedByPowerOfTwoMicroseconds)
+{
+    ClientMetricCounters counters;
+    counters.recordTick(std::chrono::nanoseconds(500));
+    counters.recordTick(std::chrono::microseconds(1));
+    counters.recordTick(std::chrono::microseconds(3));
+    counters.recordTick(std::chrono::seconds(10));
+
+    ClientMetrics metrics;
+    counters.fill(metrics);
+    EXPECT_EQ(metrics.tickDurationsUs[0], 1u);
+    EXPECT_EQ(metrics.tickDurationsUs[1], 1u);
+    EXPECT_EQ(metrics.tickDurationsUs[2], 1u);
+    EXPECT_EQ(metrics.tickDurationsUs.back(), 1u);
+    EXPECT_EQ(metrics.tickDurationSumUs, 10'000'004u);
+}
+
+TEST(ClientMetricsTest, LatencyBucketsStayWithinOneSubBucketOfTheValue)
+{
+    for (const std::uint64_t us : { 0ull, 7ull, 8ull, 9ull, 100ull, 1'000ull, 123'456ull, 4'000'000'000ull })
+    {
+        const size_t index = LatencyHistogram::getBucketIndex(us);
+        const std::uint64_t upper = LatencyHistogram::getBucketUpperBound(index);
+        EXPECT_GE(upper, us);
+        EXPECT_LE(upper - us, us / LatencyHistogram::kSubBucketCount);
+        if (index > 0)
+        {
+            EXPECT_LT(LatencyHistogram::getBucketUpperBound(index - 1), us);
+        }
+    }
+
+    EXPECT_EQ(LatencyHistogram::getBucketIndex(~std::uint64_t{ 0 }), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(ClientMetricsTest, LatencyPercentilesWalkTheRecordedValues)
+{
+    AtomicLatencyHistogram live;
+    for (int i = 1; i <= 100; ++i)
+    {
+        live.record(std::chrono::microseconds(i * 10));
+    }
+
+    LatencyHistogram histogram;
+    live.fill(histogram);
+    EXPECT_EQ(histogram.count, 100u);
+    EXPECT_EQ(histogram.maxUs, 1000u);
+    EXPECT_EQ(histogram.sumUs, 50'500u);
+
+    const std::uint64_t median = histogram.getValueAtPercentile(50.0);
+    EXPECT_GE(median, 500u);
+    EXPECT_LE(median, 500u + 500u / LatencyHistogram::kSubBucketCount);
+    EXPECT_EQ(histogram.getValueAtPercentile(100.0), 1000u);
+    EXPECT_EQ(LatencyHistogram{}.getValueAtPercentile(99.0), 0u);
+}
+
+TEST(ClientMetricsTest, TrafficIsReadThroughTheSharedCounters)
+{
+    ClientMetricCounters counters;
+    counters.traffic->recordSent(10);
+    counters.traffic->recordSent(5);
+    counters.traffic->recordReceived(7);
+
+    ClientMetrics metrics;
+    counters.fill(metrics);
+    EXPECT_EQ(metrics.bytesSent, 15u);
+    EXPECT_EQ(metrics.packetsSent, 2u);
+    EXPECT_EQ(metrics.bytesReceived, 7u);
+    EXPECT_EQ(metrics.packetsReceived, 1u);
+}
+
+TEST(ClientMetricsTest, PrometheusTextLabelsEverySampleAndAccumulatesBuckets)
+{
+    ClientMetrics metrics;
+    metrics.connections = 2;
+    metrics.commandQueueDepth = 4;
+    metrics.tickDurationsUs[0] = 3;
+    metrics.tickDurationsUs[2] = 1;
+    metrics.tickDurationsUs.back() = 1;
+    metrics.tickDurationSumUs = 40000;
+
+    const std::string text = formatPrometheusMetrics(metrics, "dev\"1");
+    EXPECT_NE(text.find("# TYPE reactormq_connections_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_connections_total{client_id=\"dev\\\"1\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_command_queue_depth{client_id=\"dev\\\"1\"} 4\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_tick_duration_microseconds_bucket{client_id=\"dev\\\"1\",le=\"0\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_tick_duration_microseconds_bucket{client_id=\"dev\\\"1\",le=\"3\"} 4\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_tick_duration_microseconds_bucket{client_id=\"dev\\\"1\",le=\"+Inf\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_tick_duration_microseconds_sum{client_id=\"dev\\\"1\"} 40000\n"), std::string::npos);
+    EXPECT_NE(text.find("reactormq_tick_duration_microseconds_count{client_id=\"dev\\\"1\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE reactormq_publish_latency_microseconds summary\n"), std::string::npos);
+    EXPECT_NE(
+        text.find("reactormq_publish_latency_microseconds_count{client_id=\"dev\\\"1\",qos=\"2\",stage=\"total\"} 0\n"), std::string::npos);
+}
@@ -53,6 +53,28 @@ TEST(CommandVariantTest, HoldsUnsubscribeCommand)
     EXPECT_TRUE(std::holds_alternative<UnsubscribeCommand>(v));
 }
 
+TEST(CommandVariantTest, HoldsSetSubscriptionsCommand)
+{
+    SetSubscriptionsCommand c{ { TopicFilter{ "a/b", QualityOfService::AtLeastOnce } },
+                               std::promise<Result<std::vector<SubscribeResult>>>{} };
+    const Command v = std::move(c);
+    EXPECT_TRUE(std::holds_alternative<SetSubscriptionsCommand>(v));
+}
+
+TEST(CommandVariantTest, HoldsPublishChunkedCommand)
+{
+    PublishChunkedCommand c{ std::make_shared<ChunkedTransfer>() };
+    const Command v = std::move(c);
+    EXPECT_TRUE(std::holds_alternative<PublishChunkedCommand>(v));
+}
+
+TEST(CommandVariantTest, HoldsRequestCommand)
+{
+    RequestCommand c{ "svc/echo", { 1 }, std::chrono::seconds(1), std::promise<Result<Message>>{} };
+    const Command v = std::move(c);
+    EXPECT_TRUE(std::holds_alternative<RequestCommand>(v));
+}
+
 TEST(CommandVariantTest, HoldsDisconnectCommand)
 {
     DisconnectCommand c{ std::promise<Result<void>>{} };
@@ -0,0 +1,68 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/conflated_handlers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    TopicRouter::Handler makeHandler()
+    {
+        return std::make_shared<const MessageHandler>(
+            [](const Message&)
+            {
+            });
+    }
+
+    std::shared_ptr<const Message> makeMessage(const std::uint8_t value)
+    {
+        return std::make_shared<const Message>("a/b", std::vector<std::uint8_t>{ value }, false, QualityOfService::AtMostOnce);
+    }
+} // namespace
+
+TEST(ConflatedHandlersTest, KeepsOnePendingSlotPerHandlerAndTopic)
+{
+    ConflatedHandlers conflated;
+    const auto handler = makeHandler();
+    const auto other = makeHandler();
+    conflated.add("a/+", handler);
+
+    EXPECT_EQ(conflated.findPending(other.get(), "a/b"), nullptr);
+
+    const auto slot = conflated.findPending(handler.get(), "a/b");
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(conflated.findPending(handler.get(), "a/b"), slot);
+    EXPECT_NE(conflated.findPending(handler.get(), "a/c"), slot);
+
+    // Only the store that finds the slot empty should queue a call; the call takes the newest.
+    EXPECT_EQ(slot->exchange(makeMessage(1)), nullptr);
+    EXPECT_NE(slot->exchange(makeMessage(2)), nullptr);
+    const auto taken = slot->exchange(nullptr);
+    ASSERT_NE(taken, nullptr);
+    EXPECT_EQ(taken->getPayloadView()[0], 2);
+}
+
+TEST(ConflatedHandlersTest, RemoveDropsTheHandlersOfAFilter)
+{
+    ConflatedHandlers conflated;
+    const auto first = makeHandler();
+    const auto second = makeHandler();
+    conflated.add("a/+", first);
+    conflated.add("b/#", second);
+
+    EXPECT_EQ(conflated.remove("a/+"), 1u);
+    EXPECT_EQ(conflated.findPending(first.get(), "a/b"), nullptr);
+    EXPECT_NE(conflated.findPending(second.get(), "b/c"), nullptr);
+
+    EXPECT_EQ(conflated.remove("b/#"), 1u);
+    EXPECT_TRUE(conflated.isEmpty());
+}
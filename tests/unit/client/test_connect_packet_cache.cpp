@@ -0,0 +1,71 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/connect_packet_cache.h"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    ConnectPacketCache::Fields makeFields(const char* password = "secret")
+    {
+        ConnectPacketCache::Fields fields;
+        fields.protocolVersion = packets::ProtocolVersion::V5;
+        fields.clientId = "device-1";
+        fields.keepAliveSeconds = 30;
+        fields.credentials = Credentials("user", password);
+        fields.cleanSession = false;
+        fields.receiveMaximum = 100;
+        return fields;
+    }
+
+    std::vector<std::byte> toVector(const std::span<const std::byte> bytes)
+    {
+        return { bytes.begin(), bytes.end() };
+    }
+} // namespace
+
+TEST(ConnectPacketCacheTest, EncodesTheSameBytesAsTheEncoder)
+{
+    ConnectPacketCache cache;
+    const std::vector<std::byte> cached = toVector(cache.get(makeFields()));
+
+    std::vector<std::byte> expected;
+    reactormq::serialize::ByteWriter writer(expected);
+    packets::encodeConnectToWriter<packets::ProtocolVersion::V5>(writer, "device-1", 30, "user", "secret", false, "", {}, 0, 100);
+    EXPECT_EQ(cached, expected);
+}
+
+TEST(ConnectPacketCacheTest, ReconnectWithTheSameFieldsReusesTheBytes)
+{
+    ConnectPacketCache cache;
+    const std::span<const std::byte> first = cache.get(makeFields());
+    const std::vector<std::byte> firstBytes = toVector(first);
+
+    const std::span<const std::byte> second = cache.get(makeFields());
+    EXPECT_EQ(second.data(), first.data());
+    EXPECT_EQ(toVector(second), firstBytes);
+    EXPECT_EQ(cache.getEncodeCount(), 1u);
+}
+
+TEST(ConnectPacketCacheTest, NewCredentialsOrClientIdReencode)
+{
+    ConnectPacketCache cache;
+    const std::vector<std::byte> original = toVector(cache.get(makeFields()));
+
+    const std::vector<std::byte> rotated = toVector(cache.get(makeFields("rotated")));
+    EXPECT_NE(rotated, original);
+    EXPECT_EQ(cache.getEncodeCount(), 2u);
+
+    ConnectPacketCache::Fields assigned = makeFields("rotated");
+    assigned.clientId = "broker-assigned";
+    (void)cache.get(std::move(assigned));
+    EXPECT_EQ(cache.getEncodeCount(), 3u);
+}
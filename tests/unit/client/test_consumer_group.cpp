@@ -0,0 +1,156 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    ConnectionSettingsPtr makeSettings(const uint16_t port)
+    {
+        return ConnectionSettingsBuilder("127.0.0.1").setPort(port).setProtocol(ConnectionProtocol::Tcp).setClientId("consumers").build();
+    }
+
+    /// @brief Collects what the group's OnMessage handlers see, per topic in arrival order.
+    struct Received
+    {
+        std::mutex mutex;
+        std::map<std::string, std::vector<std::string>> payloadsByTopic;
+        size_t count = 0;
+
+        void add(const Message& message)
+        {
+            const std::scoped_lock lock(mutex);
+            payloadsByTopic[message.getTopic()].emplace_back(message.getPayload().begin(), message.getPayload().end());
+            ++count;
+        }
+
+        [[nodiscard]] size_t waitFor(const size_t expected)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                {
+                    const std::scoped_lock lock(mutex);
+                    if (count >= expected)
+                    {
+                        return count;
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            const std::scoped_lock lock(mutex);
+            return count;
+        }
+    };
+} // namespace
+
+TEST(ConsumerGroupTest, SharesTheFilterOverTheRequestedConnections)
+{
+    const auto consumers
+        = createConsumerGroup(makeSettings(1883), "workers", TopicFilter("jobs/#", QualityOfService::AtLeastOnce, true), 3);
+
+    EXPECT_EQ(consumers->getSharedFilter(), "$share/workers/jobs/#");
+    ASSERT_EQ(consumers->getConsumerCount(), 3u);
+    EXPECT_NE(consumers->getConsumer(0), consumers->getConsumer(1));
+    EXPECT_FALSE(consumers->isConnected());
+    EXPECT_EQ(createConsumerGroup(makeSettings(1883), "workers", TopicFilter("jobs/#"), 0)->getConsumerCount(), 1u);
+}
+
+TEST(ConsumerGroupTest, MessagesReachOnMessageInOrderPerTopic)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto group = createReactorGroup(1);
+    const auto consumers
+        = createConsumerGroup(makeSettings(port), "workers", TopicFilter("jobs/+", QualityOfService::AtLeastOnce), 1, group, 2);
+    Received received;
+    auto handle = consumers->onMessage().add([&received](const Message& message) { received.add(message); });
+
+    auto connected = consumers->connectAsync(true);
+    ASSERT_EQ(connected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_TRUE(connected.get().isSuccess());
+
+    constexpr int kPerTopic = 20;
+    for (int i = 0; i < kPerTopic; ++i)
+    {
+        for (const char* topic : { "jobs/a", "jobs/b" })
+        {
+            const std::string payload = std::to_string(i);
+            (void)consumers->getConsumer(0)->publishAsync(
+                Message(topic, std::vector<uint8_t>(payload.begin(), payload.end()), false, QualityOfService::AtLeastOnce));
+        }
+    }
+
+    EXPECT_EQ(received.waitFor(2 * kPerTopic), 2u * kPerTopic);
+    {
+        const std::scoped_lock lock(received.mutex);
+        for (const char* topic : { "jobs/a", "jobs/b" })
+        {
+            const auto& payloads = received.payloadsByTopic[topic];
+            ASSERT_EQ(payloads.size(), static_cast<size_t>(kPerTopic));
+            for (int i = 0; i < kPerTopic; ++i)
+            {
+                EXPECT_EQ(payloads[i], std::to_string(i));
+            }
+        }
+    }
+
+    auto disconnected = consumers->disconnectAsync();
+    EXPECT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    handle.disconnect();
+    broker.stop();
+}
+
+TEST(ConsumerGroupTest, ReconnectingDoesNotSubscribeAgain)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto group = createReactorGroup(1);
+    const auto consumers
+        = createConsumerGroup(makeSettings(port), "workers", TopicFilter("jobs/+", QualityOfService::AtLeastOnce), 1, group);
+    Received received;
+    auto handle = consumers->onMessage().add([&received](const Message& message) { received.add(message); });
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        auto connected = consumers->connectAsync(false);
+        ASSERT_EQ(connected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        ASSERT_TRUE(connected.get().isSuccess());
+        if (attempt == 0)
+        {
+            auto disconnected = consumers->disconnectAsync();
+            ASSERT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        }
+    }
+
+    (void)consumers->getConsumer(0)->publishAsync(Message("jobs/once", { 'x' }, false, QualityOfService::AtLeastOnce));
+    EXPECT_EQ(received.waitFor(1), 1u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        const std::scoped_lock lock(received.mutex);
+        EXPECT_EQ(received.count, 1u);
+    }
+
+    handle.disconnect();
+    broker.stop();
+}
@@ -4,17 +4,34 @@
 
 #include "mqtt/client/command.h"
 #include "mqtt/client/context.h"
+#include "mqtt/client/mqtt_version_mapping.h"
+#include "mqtt/client/state/connecting_state.h"
+#include "mqtt/client/state/disconnected_state.h"
+#include "mqtt/client/state/ready_state.h"
 #include "mqtt/packets/conn_ack.h"
 #include "mqtt/packets/connect.h"
 #include "mqtt/packets/interface/control_packet.h"
+#include "mqtt/packets/pre_encoded_packets.h"
 #include "mqtt/packets/properties/properties.h"
 #include "mqtt/packets/publish.h"
 #include "reactormq/mqtt/connection_settings_builder.h"
 #include "reactormq/mqtt/reason_code.h"
 #include "serialize/bytes.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace reactormq;
 using namespace reactormq::mqtt;
@@ -22,12 +39,84 @@ using namespace reactormq::mqtt::client;
 
 namespace
 {
+    class PendingSendSocket final : public socket::Socket
+    {
+    public:
+        explicit PendingSendSocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* data, const uint32_t size) override
+        {
+            pendingSendBytes += size;
+            sent.insert(sent.end(), reinterpret_cast<const std::byte*>(data), reinterpret_cast<const std::byte*>(data) + size);
+        }
+
+        [[nodiscard]] size_t getPendingSendBytes() const override
+        {
+            return pendingSendBytes;
+        }
+
+        socket::OnConnectCallback& getOnConnectCallback() override
+        {
+            return onConnect;
+        }
+
+        socket::OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return onDisconnect;
+        }
+
+        socket::OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return onData;
+        }
+
+        void tick() override
+        {
+        }
+
+        size_t pendingSendBytes = 0;
+        std::vector<std::byte> sent;
+
+    private:
+        socket::OnConnectCallback onConnect;
+        socket::OnDisconnectCallback onDisconnect;
+        socket::OnDataReceivedCallback onData;
+    };
+
     ConnectionSettingsPtr makeSettings()
     {
         ConnectionSettingsBuilder b;
         b.setHost("localhost");
         return b.build();
     }
+
+    void publishQos1(Context& ctx, const std::string& topic)
+    {
+        Command command = PublishCommand{ Message{ topic, Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce },
+                                          std::promise<Result<void>>{} };
+        ReadyState state;
+        (void)state.handleCommand(ctx, command);
+    }
 } // namespace
 
 TEST(ContextTest, AllocatePacketIdReturnsValuesInRange1To65535)
@@ -82,6 +171,23 @@ TEST(ContextTest, IsPacketIdInUseReflectsReleasedIds)
     EXPECT_FALSE(ctx.isPacketIdInUse(id));
 }
 
+TEST(ContextTest, FixedCapacityLimitsPacketIdsToTheCommandBound)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost");
+    b.setMaxPendingCommands(100);
+    b.setFixedCapacity(FixedCapacityOptions{ true, 8 });
+    Context ctx(b.build());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto id = ctx.allocatePacketId();
+        ASSERT_GE(id, 1u);
+        ASSERT_LE(id, 100u);
+    }
+    EXPECT_EQ(ctx.allocatePacketId(), 0u);
+}
+
 TEST(ContextTest, OutboundQueueStartsAtZero)
 {
     const Context ctx(makeSettings());
@@ -107,6 +213,22 @@ TEST(ContextTest, CanAddToOutboundQueueReturnsFalseWhenExceedingLimit)
     EXPECT_FALSE(ctx.canAddToOutboundQueue(20));
 }
 
+TEST(ContextTest, CanAddToOutboundQueueCountsBytesQueuedInSocket)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxOutboundQueueBytes(100);
+    const auto settings = b.build();
+    Context ctx(settings);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    EXPECT_TRUE(ctx.canAddToOutboundQueue(60));
+    sock->pendingSendBytes = 50;
+    EXPECT_FALSE(ctx.canAddToOutboundQueue(60));
+    sock->pendingSendBytes = 0;
+    EXPECT_TRUE(ctx.canAddToOutboundQueue(60));
+}
+
 TEST(ContextTest, SubtractOutboundQueueSizeDoesNotUnderflow)
 {
     Context ctx(makeSettings());
@@ -205,6 +327,229 @@ TEST(ContextTest, InvokeCallbackUsesExecutorWhenProvided)
     EXPECT_TRUE(ran);
 }
 
+TEST(ContextTest, BatchedCallbacksReachTheExecutorAsOneTask)
+{
+    std::vector<std::function<void()>> tasks;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setBatchCallbacks(true)
+        .setCallbackExecutor(
+            [&tasks](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            });
+    Context ctx(b.build());
+
+    std::vector<int> order;
+    for (int i = 0; i < 3; ++i)
+    {
+        ctx.invokeCallback(
+            [&order, i]
+            {
+                order.push_back(i);
+            });
+    }
+    EXPECT_TRUE(tasks.empty());
+
+    ctx.flushCallbacks();
+    ASSERT_EQ(tasks.size(), 1u);
+    tasks.front()();
+    EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2 }));
+
+    ctx.flushCallbacks();
+    EXPECT_EQ(tasks.size(), 1u);
+}
+
+TEST(ContextTest, DispatchLanesDeliverMessagesOffTheReactorThread)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMessageDispatchLanes(2);
+
+    std::mutex mutex;
+    std::vector<std::string> payloads;
+    std::thread::id handlerThread;
+    {
+        Context ctx(b.build());
+        auto handle = ctx.getOnMessage().add(
+            [&](const Message& message)
+            {
+                std::scoped_lock lock(mutex);
+                handlerThread = std::this_thread::get_id();
+                payloads.emplace_back(message.getPayloadView().begin(), message.getPayloadView().end());
+            });
+
+        for (const char* payload : { "1", "2", "3" })
+        {
+            const std::string text(payload);
+            ctx.deliverMessage(Message{ "a/b", Message::Payload(text.begin(), text.end()), false, QualityOfService::AtMostOnce });
+        }
+    } // destroying the context runs the queued handlers
+
+    EXPECT_EQ(payloads, (std::vector<std::string>{ "1", "2", "3" }));
+    EXPECT_NE(handlerThread, std::this_thread::get_id());
+}
+
+TEST(ContextTest, FullDeliveryQueuePausesReadsAndDefersPubAckUntilHandled)
+{
+    std::vector<std::function<void()>> tasks;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setMaxPendingDeliveries(2)
+        .setCallbackExecutor(
+            [&tasks](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            });
+    const auto settings = b.build();
+    Context ctx(settings);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    auto handle = ctx.getOnMessage().add(
+        [](const Message&)
+        {
+        });
+
+    ASSERT_TRUE(ctx.trackIncomingPacketId(7));
+    EXPECT_TRUE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, {}, 7));
+    EXPECT_FALSE(sock->isReceivePaused());
+    EXPECT_FALSE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ 2 }, false, QualityOfService::AtMostOnce }));
+    EXPECT_TRUE(sock->isReceivePaused());
+    EXPECT_EQ(ctx.getPendingDeliveryCount(), 2u);
+    EXPECT_FALSE(ctx.hasCompletedDeliveries());
+
+    ctx.completeDeliveries();
+    EXPECT_TRUE(sock->sent.empty());
+    EXPECT_TRUE(ctx.hasIncomingPacketId(7));
+
+    tasks.front()();
+    EXPECT_TRUE(ctx.hasCompletedDeliveries());
+    ctx.completeDeliveries();
+
+    const auto pubAck = packets::encodeIdOnlyAck<packets::PacketType::PubAck>(7);
+    EXPECT_TRUE(std::equal(sock->sent.begin(), sock->sent.end(), pubAck.begin(), pubAck.end()));
+    EXPECT_FALSE(ctx.hasIncomingPacketId(7));
+    EXPECT_FALSE(sock->isReceivePaused());
+    EXPECT_EQ(ctx.getPendingDeliveryCount(), 1u);
+    EXPECT_FALSE(ctx.hasCompletedDeliveries());
+
+    tasks.back()();
+    EXPECT_EQ(ctx.getPendingDeliveryCount(), 0u);
+}
+
+TEST(ContextTest, ConflatedHandlerGetsOnlyTheNewestMessagePerTopic)
+{
+    std::vector<std::function<void()>> tasks;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setMaxPendingDeliveries(8)
+        .setCallbackExecutor(
+            [&tasks](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            });
+    Context ctx(b.build());
+
+    std::vector<std::pair<std::string, std::uint8_t>> seen;
+    auto handler = std::make_shared<const MessageHandler>(
+        [&seen](const Message& message)
+        {
+            seen.emplace_back(message.getTopic(), message.getPayloadView()[0]);
+        });
+    ctx.getConflatedHandlers().add("a/+", handler);
+    ctx.getTopicRouter().add("a/+", handler);
+
+    // Conflated messages are acknowledged without waiting for the handler.
+    for (const std::uint8_t value : { 1, 2, 3 })
+    {
+        ASSERT_TRUE(ctx.trackIncomingPacketId(value));
+        EXPECT_FALSE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ value }, false, QualityOfService::AtLeastOnce }, {}, value));
+    }
+    EXPECT_FALSE(ctx.deliverMessage(Message{ "a/c", Message::Payload{ 4 }, false, QualityOfService::AtMostOnce }));
+    EXPECT_EQ(ctx.getPendingDeliveryCount(), 0u);
+    ASSERT_EQ(tasks.size(), 2u);
+
+    for (const auto& task : tasks)
+    {
+        task();
+    }
+    EXPECT_EQ(seen, (std::vector<std::pair<std::string, std::uint8_t>>{ { "a/b", 3 }, { "a/c", 4 } }));
+
+    // Once the queued call has run, the next message queues another.
+    EXPECT_FALSE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ 5 }, false, QualityOfService::AtMostOnce }));
+    ASSERT_EQ(tasks.size(), 3u);
+    tasks.back()();
+    EXPECT_EQ(seen.back(), (std::pair<std::string, std::uint8_t>{ "a/b", 5 }));
+}
+
+TEST(ContextTest, TrafficAccountingCountsConflatedReplacementsAsDropped)
+{
+    std::vector<std::function<void()>> tasks;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setTrafficAccounting(TrafficAccountingOptions{ true, 4, 1 })
+        .setCallbackExecutor(
+            [&tasks](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            });
+    Context ctx(b.build());
+    ASSERT_NE(ctx.getTrafficAccounting(), nullptr);
+
+    auto handler = std::make_shared<const MessageHandler>([](const Message&) {});
+    ctx.getTrafficAccounting()->addSubscription("a/+", handler.get());
+    ctx.getConflatedHandlers().add("a/+", handler);
+    ctx.getTopicRouter().add("a/+", handler);
+
+    for (const std::uint8_t value : { 1, 2, 3 })
+    {
+        EXPECT_FALSE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ value }, false, QualityOfService::AtMostOnce }));
+    }
+    EXPECT_FALSE(ctx.deliverMessage(Message{ "other", Message::Payload{ 4 }, false, QualityOfService::AtMostOnce }));
+
+    const InboundTraffic report = ctx.getTrafficAccounting()->getReport();
+    ASSERT_EQ(report.subscriptions.size(), 1u);
+    EXPECT_EQ(report.subscriptions[0].messages, 3u);
+    EXPECT_EQ(report.subscriptions[0].bytes, 12u);
+    EXPECT_EQ(report.subscriptions[0].dropped, 2u);
+    ASSERT_EQ(report.topPrefixes.size(), 2u);
+    EXPECT_EQ(report.topPrefixes[0].prefix, "a");
+    EXPECT_EQ(report.topPrefixes[0].messages, 3u);
+    EXPECT_EQ(report.topPrefixes[1].prefix, "other");
+}
+
+TEST(ContextTest, DeferredPubAckIsDroppedWithItsConnection)
+{
+    std::vector<std::function<void()>> tasks;
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setMaxPendingDeliveryBytes(1024)
+        .setCallbackExecutor(
+            [&tasks](std::function<void()> task)
+            {
+                tasks.push_back(std::move(task));
+            });
+    const auto settings = b.build();
+    Context ctx(settings);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    auto handle = ctx.getOnMessage().add(
+        [](const Message&)
+        {
+        });
+
+    ASSERT_TRUE(ctx.trackIncomingPacketId(7));
+    ASSERT_TRUE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, {}, 7));
+
+    // The broker resends the publish on the next connection, so its packet ID must not look like a duplicate.
+    ctx.abandonDeferredAcks();
+    EXPECT_FALSE(ctx.hasIncomingPacketId(7));
+
+    tasks.front()();
+    ctx.completeDeliveries();
+    EXPECT_TRUE(sock->sent.empty());
+    EXPECT_EQ(ctx.getPendingDeliveryCount(), 0u);
+}
+
 // Pending command maps (publish/subscribe/unsubscribe)
 TEST(ContextTest, StoreAndTakePendingPublishByPacketId)
 {
@@ -249,14 +594,29 @@ TEST(ContextTest, StoreAndTakePendingUnsubscribesByPacketId)
     EXPECT_TRUE(out.has_value());
 }
 
-TEST(ContextTest, GetPendingPublishesReturnsConstMapWithStoredEntries)
+TEST(ContextTest, FindPendingPublishReturnsStoredEntry)
 {
     Context ctx(makeSettings());
     PublishCommand cmd{ Message{ "t", Message::Payload{ 1 }, false, QualityOfService::AtMostOnce }, std::promise<Result<void>>{} };
     ctx.storePendingPublish(5, std::move(cmd));
-    const auto& m = ctx.getPendingPublishes();
-    const auto it = m.find(5);
-    EXPECT_NE(it, m.end());
+    const auto* found = ctx.findPendingPublish(5);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->message.getTopic(), "t");
+    EXPECT_EQ(ctx.findPendingPublish(6), nullptr);
+    EXPECT_EQ(ctx.getPendingPublishCount(), 1u);
+}
+
+TEST(ContextTest, InFlightCommandsShareOnePacketIdSpace)
+{
+    Context ctx(makeSettings());
+    ctx.storePendingSubscribe(8, SubscribeCommand{});
+    ctx.storePendingPublish(8, PublishCommand{ Message{}, std::promise<Result<void>>{} });
+
+    EXPECT_EQ(ctx.getPendingCommandCount(), 1u);
+    EXPECT_EQ(ctx.getPendingPublishCount(), 0u);
+    EXPECT_FALSE(ctx.takePendingPublish(8).has_value());
+    EXPECT_TRUE(ctx.takePendingSubscribe(8).has_value());
+    EXPECT_EQ(ctx.getPendingCommandCount(), 0u);
 }
 
 // Incoming QoS2 messages tracking
@@ -309,6 +669,45 @@ TEST(ContextTest, SetPingPendingUpdatesFlag)
     EXPECT_TRUE(ctx.isPingPending());
 }
 
+TEST(ContextTest, RecordTrafficStampsOnlyTheDirectionThatCarriedAPacket)
+{
+    Context ctx(makeSettings());
+    const auto start = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    ctx.recordTraffic(start);
+    const auto lastSend = ctx.getLastSendTime();
+
+    ctx.getMetricCounters().traffic->recordReceived(2);
+    ctx.recordTraffic(start + std::chrono::seconds(1));
+    EXPECT_EQ(ctx.getLastSendTime(), lastSend);
+    EXPECT_EQ(ctx.getLastReceiveTime(), start + std::chrono::seconds(1));
+
+    ctx.getMetricCounters().traffic->recordSent(2);
+    ctx.recordTraffic(start + std::chrono::seconds(2));
+    EXPECT_EQ(ctx.getLastSendTime(), start + std::chrono::seconds(2));
+    EXPECT_EQ(ctx.getLastReceiveTime(), start + std::chrono::seconds(1));
+    EXPECT_EQ(ctx.getLastActivityTime(), start + std::chrono::seconds(2));
+}
+
+TEST(ContextTest, DeadlinesCountFromTheTickTime)
+{
+    Context ctx(makeSettings());
+    const auto tickStart = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    ctx.setNow(tickStart);
+    EXPECT_EQ(ctx.getNow(), tickStart);
+
+    ctx.recordPublishSent(80);
+    EXPECT_EQ(ctx.getTimers().getFireTime(TimerKey{ TimerKind::PublishTimeout, 80 }), tickStart + ctx.getPublishRetryInterval(0));
+}
+
+TEST(ContextTest, RecordPingSentMarksThePingPending)
+{
+    Context ctx(makeSettings());
+    const auto sentAt = std::chrono::steady_clock::now();
+    ctx.recordPingSent(sentAt);
+    EXPECT_TRUE(ctx.isPingPending());
+    EXPECT_EQ(ctx.getPingSentTime(), sentAt);
+}
+
 // Publish timeout tracking
 TEST(ContextTest, RecordPublishSentStoresTimestampPerPacketId)
 {
@@ -329,7 +728,7 @@ TEST(ContextTest, GetPublishElapsedTimeIsPositiveAfterDelay)
 {
     Context ctx(makeSettings());
     ctx.recordPublishSent(78);
-    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    ctx.setNow(ctx.getNow() + std::chrono::milliseconds(2));
     const auto elapsed = ctx.getPublishElapsedTime(78);
     EXPECT_GT(elapsed.count(), 0);
 }
@@ -470,4 +869,668 @@ TEST(ContextTest, ParsePacketParsesPublishPacket)
     const auto pkt = ctx.parsePacket(std::span{ buffer.data(), buffer.size() });
     ASSERT_NE(pkt, nullptr);
     EXPECT_EQ(pkt->getPacketType(), packets::PacketType::Publish);
-}
\ No newline at end of file
+}
+
+TEST(ContextTest, ParsePacketRejectsAuthOnlyForV311)
+{
+    // AUTH with Remaining Length 0 (reason Success, no properties).
+    const std::vector<std::byte> frame{ std::byte{ 0xF0 }, std::byte{ 0x00 } };
+
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    EXPECT_EQ(ctx.parsePacket(std::span{ frame.data(), frame.size() }), nullptr);
+
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto pkt = ctx.parsePacket(std::span{ frame.data(), frame.size() });
+    ASSERT_NE(pkt, nullptr);
+    EXPECT_EQ(pkt->getPacketType(), packets::PacketType::Auth);
+}
+
+TEST(ContextTest, PacketDecoderTableCoversEveryTypeOfEachVersion)
+{
+    using enum packets::PacketType;
+    for (const auto version : { packets::ProtocolVersion::V311, packets::ProtocolVersion::V5 })
+    {
+        EXPECT_EQ(getPacketDecoder(version, None), nullptr);
+        EXPECT_EQ(getPacketDecoder(version, Max), nullptr);
+        for (auto type = Connect; type != Auth; type = static_cast<packets::PacketType>(static_cast<int>(type) + 1))
+        {
+            EXPECT_NE(getPacketDecoder(version, type), nullptr) << static_cast<int>(type);
+        }
+    }
+    EXPECT_EQ(getPacketDecoder(packets::ProtocolVersion::V311, Auth), nullptr);
+    EXPECT_NE(getPacketDecoder(packets::ProtocolVersion::V5, Auth), nullptr);
+}
+
+TEST(ContextTest, ParsePacketDecodesIntoArenaAndResetReclaimsIt)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setPacketArenaSize(4096);
+    Context ctx(b.build());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+
+    std::vector<std::byte> buffer;
+    serialize::ByteWriter writer(buffer);
+    const packets::Publish<packets::ProtocolVersion::V311> publish("a/b", { 1, 2, 3 }, QualityOfService::AtMostOnce, false);
+    publish.encode(writer);
+
+    {
+        auto pkt = ctx.parsePacket(std::span{ buffer.data(), buffer.size() });
+        ASSERT_NE(pkt, nullptr);
+        EXPECT_TRUE(pkt.get_deleter().isArenaOwned);
+        EXPECT_GT(ctx.getPacketArena().getBytesUsed(), 0u);
+
+        auto& parsed = static_cast<packets::IPublishPacket&>(*pkt);
+        EXPECT_EQ(parsed.takeTopicName(), "a/b");
+        EXPECT_EQ(parsed.takePayload(), (std::vector<uint8_t>{ 1, 2, 3 }));
+        EXPECT_TRUE(parsed.getPayload().empty());
+    }
+
+    ctx.resetPacketArena();
+    EXPECT_EQ(ctx.getPacketArena().getBytesUsed(), 0u);
+}
+
+TEST(ContextTest, RetransmitEncodingMatchesDuplicatePublish)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+
+    const Message message(std::string("a/b"), Message::Payload{ 1, 2, 3 }, true, QualityOfService::AtLeastOnce);
+    std::vector<std::byte> retransmit;
+    serialize::ByteWriter retransmitWriter(retransmit);
+    ctx.encodePublishForCurrentVersion(message, 9, retransmitWriter);
+
+    const packets::Publish5 publish("a/b", { 1, 2, 3 }, QualityOfService::AtLeastOnce, true, 9, {}, true);
+    std::vector<std::byte> expected;
+    serialize::ByteWriter expectedWriter(expected);
+    publish.encode(expectedWriter);
+
+    EXPECT_EQ(retransmit, expected);
+}
+
+TEST(ContextTest, SendQuotaFollowsReceiveMaximumAndInFlightPublishes)
+{
+    Context ctx(makeSettings());
+    EXPECT_EQ(ctx.getReceiveMaximum(), 65535u);
+
+    ctx.setReceiveMaximum(2);
+    EXPECT_EQ(ctx.getSendQuota(), 2u);
+    ctx.storePendingPublish(1, PublishCommand{ Message{}, std::promise<Result<void>>{} });
+    EXPECT_EQ(ctx.getSendQuota(), 1u);
+    ctx.storePendingPublish(2, PublishCommand{ Message{}, std::promise<Result<void>>{} });
+    EXPECT_EQ(ctx.getSendQuota(), 0u);
+
+    ctx.setReceiveMaximum(1);
+    EXPECT_EQ(ctx.getSendQuota(), 0u);
+}
+
+TEST(ContextTest, PublishesBeyondReceiveMaximumAreHeldUntilAcknowledged)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ctx.setReceiveMaximum(2);
+
+    publishQos1(ctx, "a");
+    publishQos1(ctx, "b");
+    const size_t bytesForTwo = sock->pendingSendBytes;
+    publishQos1(ctx, "c");
+
+    EXPECT_EQ(sock->pendingSendBytes, bytesForTwo);
+    EXPECT_EQ(ctx.getPendingPublishCount(), 2u);
+    EXPECT_EQ(ctx.getHeldPublishCount(), 1u);
+    EXPECT_EQ(ctx.getPendingCommandCount(), 3u);
+
+    const std::uint16_t firstId = 1;
+    ASSERT_NE(ctx.findPendingPublish(firstId), nullptr);
+    ASSERT_EQ(ctx.findPendingPublish(firstId)->message.getTopic(), "a");
+    const auto pubAck = packets::encodeIdOnlyAck<packets::PacketType::PubAck>(firstId);
+    ReadyState ready;
+    (void)ready.onDataReceived(ctx, reinterpret_cast<const uint8_t*>(pubAck.data()), static_cast<uint32_t>(pubAck.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_GT(sock->pendingSendBytes, bytesForTwo);
+    EXPECT_EQ(ctx.getPendingPublishCount(), 2u);
+    EXPECT_EQ(ctx.getHeldPublishCount(), 0u);
+    EXPECT_EQ(ctx.findPendingPublish(firstId), nullptr);
+    ASSERT_NE(ctx.findPendingPublish(3), nullptr);
+    EXPECT_EQ(ctx.findPendingPublish(3)->message.getTopic(), "c");
+}
+
+TEST(ContextTest, PubAcksCompletePublishesWithOrWithoutAReasonCodeAndProperties)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    publishQos1(ctx, "a");
+    publishQos1(ctx, "b");
+    publishQos1(ctx, "c");
+    ASSERT_EQ(ctx.getPendingPublishCount(), 3u);
+
+    // Packet ID only, reason code only (read straight from the frame), and reason code with a Reason String property.
+    constexpr std::array<uint8_t, 4> bare{ 0x40, 0x02, 0x00, 0x01 };
+    constexpr std::array<uint8_t, 5> withReasonCode{ 0x40, 0x03, 0x00, 0x02, 0x10 };
+    constexpr std::array<uint8_t, 9> withProperties{ 0x40, 0x07, 0x00, 0x03, 0x10, 0x03, 0x1F, 0x00, 0x00 };
+    ReadyState ready;
+    (void)ready.onDataReceived(ctx, bare.data(), static_cast<uint32_t>(bare.size()));
+    (void)ready.onDataReceived(ctx, withReasonCode.data(), static_cast<uint32_t>(withReasonCode.size()));
+    (void)ready.onDataReceived(ctx, withProperties.data(), static_cast<uint32_t>(withProperties.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(ctx.getPendingPublishCount(), 0u);
+    EXPECT_EQ(ctx.getMetricCounters().parseFailures.load(), 0u);
+}
+
+TEST(ContextTest, ConnAckReceiveMaximumSetsSendQuota)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+
+    using namespace packets::properties;
+    std::vector<std::byte> buffer;
+    serialize::ByteWriter writer(buffer);
+    const packets::ConnAck<packets::ProtocolVersion::V5> ack(
+        false, ReasonCode::Success, Properties{ { Property::create<PropertyIdentifier::ReceiveMaximum>(std::uint16_t{ 10 }) } });
+    ack.encode(writer);
+
+    ConnectingState connecting(true, std::promise<Result<void>>{});
+    (void)connecting.onDataReceived(ctx, reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<uint32_t>(buffer.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(ctx.getReceiveMaximum(), 10u);
+    EXPECT_EQ(ctx.getSendQuota(), 10u);
+}
+
+TEST(ContextTest, PublishRetryIntervalBacksOffUpToMaximum)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setPacketRetryIntervalSeconds(2).setPacketRetryBackoffMultiplier(2.0).setMaxPacketRetryIntervalSeconds(5);
+    const Context ctx(b.build());
+
+    EXPECT_EQ(ctx.getPublishRetryInterval(0), std::chrono::milliseconds(2000));
+    EXPECT_EQ(ctx.getPublishRetryInterval(1), std::chrono::milliseconds(4000));
+    EXPECT_EQ(ctx.getPublishRetryInterval(2), std::chrono::milliseconds(5000));
+    EXPECT_EQ(ctx.getPublishRetryInterval(200), std::chrono::milliseconds(5000));
+}
+
+TEST(ContextTest, AdaptiveTimeoutsFollowTheMeasuredRoundTripTime)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost")
+        .setPacketRetryIntervalSeconds(5)
+        .setPacketRetryBackoffMultiplier(2.0)
+        .setMaxPacketRetryIntervalSeconds(60)
+        .setMaxPacketRetries(3)
+        .setAdaptiveTimeouts(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    ctx.setSocket(std::make_shared<PendingSendSocket>(settings));
+    const auto start = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    ctx.setNow(start);
+
+    // Until a round trip is measured the fixed values apply.
+    EXPECT_EQ(ctx.getPublishRetryInterval(0), std::chrono::milliseconds(5000));
+    EXPECT_EQ(ctx.getPingTimeout(std::chrono::seconds(10)), std::chrono::milliseconds(15000));
+
+    // A 3 s PINGREQ round trip: 3 s smoothed plus four times 1.5 s of variance.
+    ctx.recordPingSent(start);
+    ctx.setNow(start + std::chrono::seconds(3));
+    ctx.recordPingResponse();
+    EXPECT_EQ(ctx.getRttEstimator().getSmoothedRtt(), std::chrono::seconds(3));
+    EXPECT_EQ(ctx.getPublishRetryInterval(0), std::chrono::milliseconds(9000));
+    EXPECT_EQ(ctx.getPublishRetryInterval(1), std::chrono::milliseconds(18000));
+    EXPECT_EQ(ctx.getPingTimeout(std::chrono::seconds(10)), std::chrono::milliseconds(9000));
+    EXPECT_EQ(ctx.getPingTimeout(std::chrono::seconds(4)), std::chrono::milliseconds(6000));
+
+    // The PUBACK of a publish resent on the same connection could answer either send, so it is not timed.
+    publishQos1(ctx, "a/b");
+    ASSERT_TRUE(ctx.retryPendingPublish(1));
+    ctx.setNow(start + std::chrono::seconds(4));
+    ctx.recordPublishResponse(1);
+    EXPECT_EQ(ctx.getRttEstimator().getSmoothedRtt(), std::chrono::seconds(3));
+
+    publishQos1(ctx, "a/b");
+    ctx.setNow(start + std::chrono::seconds(5));
+    ctx.recordPublishResponse(2);
+    EXPECT_EQ(ctx.getRttEstimator().getSmoothedRtt(), std::chrono::milliseconds(2750));
+    EXPECT_EQ(ctx.getRttEstimator().getRttVariance(), std::chrono::milliseconds(1625));
+}
+
+TEST(ContextTest, FixedTimeoutsIgnoreTheMeasuredRoundTripTime)
+{
+    Context ctx(makeSettings());
+    const auto start = std::chrono::steady_clock::now();
+    const auto retryInterval = ctx.getPublishRetryInterval(0);
+
+    ctx.recordPingSent(start);
+    ctx.setNow(start + std::chrono::milliseconds(20));
+    ctx.recordPingResponse();
+    EXPECT_TRUE(ctx.getRttEstimator().hasSample());
+    EXPECT_EQ(ctx.getPublishRetryInterval(0), retryInterval);
+    EXPECT_EQ(ctx.getPingTimeout(std::chrono::seconds(10)), std::chrono::milliseconds(15000));
+}
+
+TEST(ContextTest, RetryPendingPublishResendsDupPublishUntilRetriesRunOut)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxPacketRetries(2);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    publishQos1(ctx, "a/b");
+    const std::uint16_t packetId = 1;
+    ASSERT_NE(ctx.findPendingPublish(packetId), nullptr);
+
+    std::vector<std::byte> expected;
+    serialize::ByteWriter writer(expected);
+    ctx.encodePublishForCurrentVersion(ctx.findPendingPublish(packetId)->message, packetId, writer);
+
+    const size_t sentBefore = sock->pendingSendBytes;
+    EXPECT_TRUE(ctx.retryPendingPublish(packetId));
+    EXPECT_EQ(sock->pendingSendBytes - sentBefore, expected.size());
+    EXPECT_TRUE(ctx.getTimers().isScheduled(TimerKey{ TimerKind::PublishTimeout, packetId }));
+
+    EXPECT_TRUE(ctx.retryPendingPublish(packetId));
+    EXPECT_EQ(sock->pendingSendBytes - sentBefore, 2 * expected.size());
+    EXPECT_FALSE(ctx.retryPendingPublish(packetId));
+}
+
+TEST(ContextTest, RetryPendingPublishDoesNotResendWhileConnectedOnV5)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    publishQos1(ctx, "a/b");
+    const size_t sentBefore = sock->pendingSendBytes;
+    EXPECT_TRUE(ctx.retryPendingPublish(1));
+    EXPECT_EQ(sock->pendingSendBytes, sentBefore);
+    EXPECT_FALSE(ctx.retryPendingPublish(2));
+}
+
+TEST(ContextTest, RetransmitReusesSentHeaderWithDupSet)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    publishQos1(ctx, "a/b");
+    sock->sent.clear();
+    ctx.retransmitPendingPublishes();
+
+    const packets::Publish3 publish("a/b", { 1 }, QualityOfService::AtLeastOnce, false, 1, true);
+    std::vector<std::byte> expected;
+    serialize::ByteWriter writer(expected);
+    publish.encode(writer);
+    EXPECT_EQ(sock->sent, expected);
+}
+
+TEST(ContextTest, RetransmitResumesAReleasedQos2PublishWithItsPubRelWhenTheSessionIsPresent)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    Command exactlyOnce = PublishCommand{ Message{ "a/b", Message::Payload{ 2 }, false, QualityOfService::ExactlyOnce },
+                                          std::promise<Result<void>>{} };
+    ReadyState state;
+    (void)state.handleCommand(ctx, exactlyOnce);
+    publishQos1(ctx, "a/b");
+    ctx.markPublishReleased(1);
+    ctx.setSessionPresent(true);
+    sock->sent.clear();
+    ctx.retransmitPendingPublishes();
+
+    const auto pubRel = packets::encodeIdOnlyAck<packets::PacketType::PubRel>(1);
+    std::vector<std::byte> expected(pubRel.begin(), pubRel.end());
+    serialize::ByteWriter writer(expected);
+    packets::Publish3("a/b", { 1 }, QualityOfService::AtLeastOnce, false, 2, true).encode(writer);
+    EXPECT_EQ(sock->sent, expected);
+    EXPECT_TRUE(ctx.getTimers().isScheduled(TimerKey{ TimerKind::PublishTimeout, 1 }));
+}
+
+TEST(ContextTest, RetransmitCompletesAReleasedQos2PublishWhenTheSessionIsGone)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    std::promise<Result<void>> promise;
+    auto released = promise.get_future();
+    Command exactlyOnce
+        = PublishCommand{ Message{ "a/b", Message::Payload{ 2 }, false, QualityOfService::ExactlyOnce }, std::move(promise) };
+    ReadyState state;
+    (void)state.handleCommand(ctx, exactlyOnce);
+    publishQos1(ctx, "a/b");
+    ctx.markPublishReleased(1);
+    ctx.setSessionPresent(false);
+    sock->sent.clear();
+    ctx.retransmitPendingPublishes();
+
+    ASSERT_EQ(released.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(released.get().hasSucceeded());
+    EXPECT_FALSE(ctx.isPacketIdInUse(1));
+
+    std::vector<std::byte> expected;
+    serialize::ByteWriter writer(expected);
+    packets::Publish3("a/b", { 1 }, QualityOfService::AtLeastOnce, false, 2, true).encode(writer);
+    EXPECT_EQ(sock->sent, expected);
+}
+
+TEST(ContextTest, HeldIncomingQos2MessagesAreDeliveredWhenTheSessionIsGone)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    std::vector<std::string> delivered;
+    auto handle = ctx.getOnMessage().add([&delivered](const Message& message) { delivered.emplace_back(message.getTopic()); });
+
+    ctx.storePendingIncomingQos2Message(10, Message{ "t", Message::Payload{ 1, 2 }, false, QualityOfService::ExactlyOnce });
+    ASSERT_TRUE(ctx.trackIncomingPacketId(11));
+    ctx.releaseHeldIncomingQos2Messages();
+
+    EXPECT_EQ(delivered, std::vector<std::string>{ "t" });
+    EXPECT_FALSE(ctx.hasIncomingPacketId(10));
+    EXPECT_TRUE(ctx.hasIncomingPacketId(11));
+    EXPECT_TRUE(sock->sent.empty());
+}
+
+TEST(ContextTest, OfflinePublishesAreSentInOrderOnReady)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxOfflinePublishes(8);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    ctx.setReceiveMaximum(1);
+
+    DisconnectedState disconnected(false);
+    for (const char* topic : { "a", "b", "c" })
+    {
+        Command command = PublishCommand{ Message{ topic, Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce },
+                                          std::promise<Result<void>>{} };
+        (void)disconnected.handleCommand(ctx, command);
+    }
+    EXPECT_EQ(ctx.getOfflinePublishes().size(), 3u);
+
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ReadyState ready;
+    (void)ready.onEnter(ctx);
+
+    EXPECT_EQ(ctx.getOfflinePublishes().size(), 0u);
+    EXPECT_EQ(ctx.getPendingPublishCount(), 1u);
+    EXPECT_EQ(ctx.getHeldPublishCount(), 2u);
+    ASSERT_NE(ctx.findPendingPublish(1), nullptr);
+    EXPECT_EQ(ctx.findPendingPublish(1)->message.getTopic(), "a");
+    ready.onExit(ctx);
+}
+
+TEST(ContextTest, PipelinedSubscribeIsSentRightBehindConnect)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setPipelineSubscribesOnConnect(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+
+    ConnectingState connecting(true, std::promise<Result<void>>{});
+    Command command = SubscribeCommand{ TopicFilter{ "a/#", QualityOfService::AtLeastOnce }, std::promise<Result<SubscribeResult>>{} };
+    (void)connecting.handleCommand(ctx, command);
+    EXPECT_TRUE(sock->sent.empty());
+
+    (void)connecting.onSocketConnected(ctx);
+    ASSERT_GT(sock->sent.size(), 2u);
+    EXPECT_EQ(sock->sent[0], std::byte{ 0x10 });
+    const size_t connectSize = 2 + static_cast<size_t>(sock->sent[1]);
+    ASSERT_GT(sock->sent.size(), connectSize);
+    EXPECT_EQ(sock->sent[connectSize], std::byte{ 0x82 });
+    EXPECT_TRUE(ctx.isPacketIdInUse(1));
+}
+
+TEST(ContextTest, RefusedConnAckFailsPipelinedSubscribes)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setPipelineSubscribesOnConnect(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.setSocket(std::make_shared<PendingSendSocket>(settings));
+
+    ConnectingState connecting(true, std::promise<Result<void>>{});
+    (void)connecting.onSocketConnected(ctx);
+
+    std::promise<Result<SubscribeResult>> promise;
+    auto future = promise.get_future();
+    Command command = SubscribeCommand{ TopicFilter{ "a/#" }, std::move(promise) };
+    (void)connecting.handleCommand(ctx, command);
+    EXPECT_TRUE(ctx.isPacketIdInUse(1));
+
+    std::vector<std::byte> buffer;
+    serialize::ByteWriter writer(buffer);
+    const packets::ConnAck<packets::ProtocolVersion::V5> ack(false, ReasonCode::NotAuthorized, packets::properties::Properties{});
+    ack.encode(writer);
+    (void)connecting.onDataReceived(ctx, reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<uint32_t>(buffer.size()));
+    ctx.resetPacketArena();
+    connecting.onExit(ctx);
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(future.get().isSuccess());
+    EXPECT_FALSE(ctx.isPacketIdInUse(1));
+    EXPECT_EQ(ctx.getPendingCommandCount(), 0u);
+}
+
+TEST(ContextTest, SubscriptionHandlerReceivesMatchingMessagesUntilUnsubscribed)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    ctx.setSocket(std::make_shared<PendingSendSocket>(settings));
+    ReadyState ready;
+
+    std::vector<std::string> received;
+    Command subscribe = SubscribeCommand{ TopicFilter{ "room/+/temp" },
+                                          std::promise<Result<SubscribeResult>>{},
+                                          [&received](const Message& message)
+                                          {
+                                              received.push_back(message.getTopic());
+                                          } };
+    (void)ready.handleCommand(ctx, subscribe);
+
+    const auto deliver = [&ctx, &ready](const char* topic)
+    {
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish3 publish(topic, { 1 }, QualityOfService::AtMostOnce, false, 0, false);
+        publish.encode(writer);
+        (void)ready.onDataReceived(ctx, reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<uint32_t>(buffer.size()));
+        ctx.resetPacketArena();
+    };
+
+    deliver("room/kitchen/temp");
+    deliver("room/kitchen/humidity");
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "room/kitchen/temp");
+
+    Command unsubscribe = UnsubscribesCommand{ { "room/+/temp" }, std::promise<Result<std::vector<UnsubscribeResult>>>{} };
+    (void)ready.handleCommand(ctx, unsubscribe);
+    deliver("room/hall/temp");
+    EXPECT_EQ(received.size(), 1u);
+}
+
+namespace
+{
+    void receive(Context& ctx, ReadyState& ready, const std::vector<std::byte>& frame)
+    {
+        (void)ready.onDataReceived(ctx, reinterpret_cast<const uint8_t*>(frame.data()), static_cast<uint32_t>(frame.size()));
+        ctx.resetPacketArena();
+    }
+
+    std::vector<std::byte> encodeReceivedPublish(const QualityOfService qos, const std::uint16_t packetId)
+    {
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish3 publish("a/b", { 1 }, qos, false, packetId, false);
+        publish.encode(writer);
+        return buffer;
+    }
+
+    template<packets::PacketType TAckType>
+    std::vector<std::byte> encodedAck(const std::uint16_t packetId)
+    {
+        const auto ack = packets::encodeIdOnlyAck<TAckType>(packetId);
+        return { ack.begin(), ack.end() };
+    }
+} // namespace
+
+TEST(ContextTest, ManualAckHoldsPubAckUntilTheApplicationAcknowledges)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setManualAcknowledgement(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ReadyState ready;
+
+    std::vector<Message> held;
+    auto handle = ctx.getOnMessage().add(
+        [&held](const Message& message)
+        {
+            held.push_back(message);
+        });
+
+    receive(ctx, ready, encodeReceivedPublish(QualityOfService::AtLeastOnce, 3));
+    receive(ctx, ready, encodeReceivedPublish(QualityOfService::AtMostOnce, 0));
+    ASSERT_EQ(held.size(), 2u);
+    EXPECT_TRUE(held[0].getAckToken().isPending());
+    EXPECT_FALSE(held[1].getAckToken().isPending());
+    EXPECT_TRUE(sock->sent.empty());
+    EXPECT_TRUE(ctx.hasIncomingPacketId(3));
+
+    std::thread([&held] { EXPECT_TRUE(held[0].acknowledge()); }).join();
+    EXPECT_FALSE(held[0].acknowledge());
+    EXPECT_TRUE(ctx.hasCompletedDeliveries());
+
+    ctx.completeDeliveries();
+    EXPECT_EQ(sock->sent, encodedAck<packets::PacketType::PubAck>(3));
+    EXPECT_FALSE(ctx.hasIncomingPacketId(3));
+}
+
+TEST(ContextTest, ManualAckHoldsPubCompOfExactlyOnceMessage)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setManualAcknowledgement(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ReadyState ready;
+
+    std::vector<Message> held;
+    auto handle = ctx.getOnMessage().add(
+        [&held](const Message& message)
+        {
+            held.push_back(message);
+        });
+
+    receive(ctx, ready, encodeReceivedPublish(QualityOfService::ExactlyOnce, 9));
+    EXPECT_EQ(sock->sent, encodedAck<packets::PacketType::PubRec>(9));
+    sock->sent.clear();
+
+    const auto pubRel = encodedAck<packets::PacketType::PubRel>(9);
+    receive(ctx, ready, pubRel);
+    ASSERT_EQ(held.size(), 1u);
+
+    // A resent PUBREL is answered by the PUBCOMP still owed, not straight away.
+    receive(ctx, ready, pubRel);
+    EXPECT_TRUE(sock->sent.empty());
+
+    EXPECT_TRUE(held[0].acknowledge());
+    ctx.completeDeliveries();
+    EXPECT_EQ(sock->sent, encodedAck<packets::PacketType::PubComp>(9));
+    EXPECT_FALSE(ctx.hasIncomingPacketId(9));
+}
+
+TEST(ContextTest, PubRelForUnknownPacketIdIsAnsweredWithPubComp)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ReadyState ready;
+
+    receive(ctx, ready, encodedAck<packets::PacketType::PubRel>(4));
+    EXPECT_EQ(sock->sent, encodedAck<packets::PacketType::PubComp>(4));
+}
+
+TEST(ContextTest, AckTokenOutlivingItsContextDoesNothing)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setManualAcknowledgement(true);
+    std::optional<Message> held;
+    {
+        Context ctx(b.build());
+        auto handle = ctx.getOnMessage().add(
+            [&held](const Message& message)
+            {
+                held.emplace(message);
+            });
+        ASSERT_TRUE(ctx.trackIncomingPacketId(2));
+        EXPECT_TRUE(ctx.deliverMessage(Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, {}, 2));
+    }
+
+    ASSERT_TRUE(held.has_value());
+    EXPECT_TRUE(held->acknowledge());
+    EXPECT_FALSE(held->getAckToken().isPending());
+}
+
+TEST(ContextTest, StrictModeFailsCommandsWithMalformedTopics)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setStrictMode(true);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto sock = std::make_shared<PendingSendSocket>(settings);
+    ctx.setSocket(sock);
+    ReadyState ready;
+
+    std::promise<Result<void>> publishPromise;
+    auto published = publishPromise.get_future();
+    Command publish = PublishCommand{ Message{ "a/+", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, std::move(publishPromise) };
+    (void)ready.handleCommand(ctx, publish);
+    EXPECT_FALSE(published.get().isSuccess());
+
+    std::promise<Result<SubscribeResult>> subscribePromise;
+    auto subscribed = subscribePromise.get_future();
+    Command subscribe = SubscribeCommand{ TopicFilter{ "a/#/b" }, std::move(subscribePromise) };
+    (void)ready.handleCommand(ctx, subscribe);
+    EXPECT_FALSE(subscribed.get().isSuccess());
+
+    EXPECT_TRUE(sock->sent.empty());
+    EXPECT_EQ(ctx.getPendingCommandCount(), 0u);
+}
@@ -0,0 +1,244 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/loopback_broker.h"
+#include "fixtures/port_utils.h"
+#include "mqtt/client/endpoint_selector.h"
+#include "mqtt/client/standby_connection.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    using Clock = EndpointSelector::Clock;
+
+    ConnectionSettingsPtr makeSettings()
+    {
+        return ConnectionSettingsBuilder("primary")
+            .setPort(1883)
+            .setAutoReconnectInitialDelayMs(1000)
+            .setAutoReconnectMaxDelayMs(8000)
+            .addFailoverEndpoint("secondary")
+            .addFailoverEndpoint("tertiary", 1884)
+            .build();
+    }
+} // namespace
+
+TEST(EndpointSelectorTest, WithoutFailoverEndpointsTheClientSettingsAreUsed)
+{
+    const auto settings = ConnectionSettingsBuilder("primary").build();
+    EndpointSelector selector(settings);
+    ASSERT_EQ(selector.getEndpointCount(), 1u);
+
+    EXPECT_EQ(selector.beginAttempt(Clock::now()), settings);
+    EXPECT_FALSE(selector.recordFailure(Clock::now()));
+    EXPECT_EQ(selector.getHealth(0).consecutiveFailures, 0u);
+}
+
+TEST(EndpointSelectorTest, FailoverEndpointsInheritThePrimaryPort)
+{
+    EndpointSelector selector(makeSettings());
+    ASSERT_EQ(selector.getEndpointCount(), 3u);
+
+    const auto now = Clock::now();
+    const auto primary = selector.beginAttempt(now);
+    EXPECT_EQ(primary->getHost(), "primary");
+    ASSERT_TRUE(selector.recordFailure(now));
+
+    const auto secondary = selector.beginAttempt(now);
+    EXPECT_EQ(secondary->getHost(), "secondary");
+    EXPECT_EQ(secondary->getPort(), 1883);
+    ASSERT_TRUE(selector.recordFailure(now));
+
+    const auto tertiary = selector.beginAttempt(now);
+    EXPECT_EQ(tertiary->getHost(), "tertiary");
+    EXPECT_EQ(tertiary->getPort(), 1884);
+}
+
+TEST(EndpointSelectorTest, FailedEndpointsCoolDownWithGrowingDelays)
+{
+    EndpointSelector selector(makeSettings());
+    auto now = Clock::now();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        (void)selector.beginAttempt(now);
+        const bool another = selector.recordFailure(now);
+        EXPECT_EQ(another, i < 2);
+    }
+
+    // Every node failed once; the first to cool down is tried, and the backoff applies.
+    EXPECT_EQ(selector.getHealth(0).retryAfter, now + std::chrono::milliseconds(1000));
+    EXPECT_EQ(selector.beginAttempt(now)->getHost(), "primary");
+    EXPECT_FALSE(selector.recordFailure(now));
+    EXPECT_EQ(selector.getHealth(0).consecutiveFailures, 2u);
+    EXPECT_EQ(selector.getHealth(0).retryAfter, now + std::chrono::milliseconds(2000));
+
+    now += std::chrono::milliseconds(1500);
+    EXPECT_EQ(selector.beginAttempt(now)->getHost(), "secondary");
+}
+
+TEST(EndpointSelectorTest, ASuccessfulConnectClearsFailuresAndRecordsLatency)
+{
+    EndpointSelector selector(makeSettings());
+    const auto start = Clock::now();
+
+    (void)selector.beginAttempt(start);
+    ASSERT_TRUE(selector.recordFailure(start));
+
+    EXPECT_EQ(selector.beginAttempt(start)->getHost(), "secondary");
+    selector.recordConnected(start + std::chrono::milliseconds(40));
+    EXPECT_EQ(selector.getHealth(1).connectLatencyMs, 40u);
+    EXPECT_EQ(selector.getHealth(1).consecutiveFailures, 0u);
+
+    // A graceful reconnect stays off the failed primary while it has a failure on record.
+    selector.endConnection();
+    EXPECT_EQ(selector.beginAttempt(start + std::chrono::seconds(5))->getHost(), "secondary");
+}
+
+TEST(EndpointSelectorTest, HeavierEndpointsArePreferred)
+{
+    EndpointSelector selector(
+        ConnectionSettingsBuilder("primary").addFailoverEndpoint("standby", 0, 1).addFailoverEndpoint("big", 0, 4).build());
+    EXPECT_EQ(selector.beginAttempt(Clock::now())->getHost(), "big");
+}
+
+TEST(EndpointSelectorTest, ClientFailsOverToTheNextEndpointWithoutWaitingForTheBackoff)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+    const auto deadPort = reactormq::test::findAvailablePort(20000, 30000);
+    ASSERT_TRUE(deadPort.has_value());
+
+    // The backoff is far longer than the test waits, so only an immediate failover can connect in time.
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(*deadPort)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("failover-test")
+                                         .setAutoReconnectEnabled(true)
+                                         .setAutoReconnectInitialDelayMs(60000)
+                                         .addFailoverEndpoint("127.0.0.1", port)
+                                         .build());
+
+    (void)client->connectAsync(true);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!client->isConnected() && std::chrono::steady_clock::now() < deadline)
+    {
+        client->waitAndTick(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_TRUE(client->isConnected());
+    EXPECT_EQ(broker.getConnectionsAccepted(), 1u);
+    broker.stop();
+}
+
+TEST(EndpointSelectorTest, StandbyGoesToTheBestOtherAvailableNode)
+{
+    EndpointSelector selector(makeSettings());
+    const auto now = Clock::now();
+
+    EXPECT_EQ(selector.beginAttempt(now)->getHost(), "primary");
+    EXPECT_EQ(selector.pickStandby(now), 1u);
+
+    selector.recordStandbyFailure(1, now);
+    EXPECT_EQ(selector.getHealth(1).consecutiveFailures, 1u);
+    EXPECT_EQ(selector.pickStandby(now), 2u);
+    EXPECT_EQ(selector.getCurrentIndex(), 0u);
+
+    EXPECT_FALSE(EndpointSelector(ConnectionSettingsBuilder("primary").build()).pickStandby(now).has_value());
+}
+
+TEST(EndpointSelectorTest, StandbyConnectsAheadAndIsPromotedToTheCurrentNode)
+{
+    LoopbackBroker primary;
+    LoopbackBroker standby;
+    const uint16_t primaryPort = primary.start(0);
+    const uint16_t standbyPort = standby.start(0);
+    ASSERT_NE(primaryPort, 0);
+    ASSERT_NE(standbyPort, 0);
+
+    EndpointSelector selector(ConnectionSettingsBuilder("127.0.0.1")
+                                  .setPort(primaryPort)
+                                  .setProtocol(ConnectionProtocol::Tcp)
+                                  .addFailoverEndpoint("127.0.0.1", standbyPort)
+                                  .build());
+    (void)selector.beginAttempt(Clock::now());
+
+    StandbyConnection connection;
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (!connection.isReady() && Clock::now() < deadline)
+    {
+        connection.maintain(selector, Clock::now());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(connection.isReady());
+    EXPECT_EQ(connection.getIndex(), 1u);
+
+    const auto socket = connection.promote(selector, Clock::now());
+    ASSERT_NE(socket, nullptr);
+    EXPECT_TRUE(socket->isConnected());
+    EXPECT_EQ(selector.getCurrentIndex(), 1u);
+    EXPECT_FALSE(connection.isReady());
+
+    // Nothing was sent on the standby, so the broker has not seen a CONNECT yet.
+    EXPECT_EQ(standby.getConnectionsAccepted(), 0u);
+    socket->close();
+    primary.stop();
+    standby.stop();
+}
+
+TEST(EndpointSelectorTest, ClientWithAWarmStandbyMovesToItWhenThePrimaryDrops)
+{
+    LoopbackBroker primary;
+    LoopbackBroker standby;
+    const uint16_t primaryPort = primary.start(0);
+    const uint16_t standbyPort = standby.start(0);
+    ASSERT_NE(primaryPort, 0);
+    ASSERT_NE(standbyPort, 0);
+
+    const auto client = createClient(ConnectionSettingsBuilder("127.0.0.1")
+                                         .setPort(primaryPort)
+                                         .setProtocol(ConnectionProtocol::Tcp)
+                                         .setClientId("standby-test")
+                                         .setKeepAliveIntervalSeconds(1)
+                                         .setAutoReconnectEnabled(true)
+                                         .setAutoReconnectInitialDelayMs(60000)
+                                         .addFailoverEndpoint("127.0.0.1", standbyPort)
+                                         .setWarmStandby(true)
+                                         .build());
+
+    const auto tickFor = [&client](const auto duration, const auto& isDone)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + duration;
+        while (!isDone() && std::chrono::steady_clock::now() < deadline)
+        {
+            client->waitAndTick(std::chrono::milliseconds(5));
+        }
+    };
+
+    (void)client->connectAsync(true);
+    tickFor(std::chrono::seconds(5), [&client] { return client->isConnected(); });
+    ASSERT_TRUE(client->isConnected());
+    EXPECT_EQ(primary.getConnectionsAccepted(), 1u);
+
+    // Long enough for the standby to finish connecting.
+    tickFor(std::chrono::milliseconds(200), [] { return false; });
+
+    // The unanswered keepalive ends the connection to the stopped primary.
+    primary.stop();
+    tickFor(std::chrono::seconds(5), [&standby] { return standby.getConnectionsAccepted() > 0; });
+    tickFor(std::chrono::seconds(1), [&client] { return client->isConnected(); });
+    EXPECT_TRUE(client->isConnected());
+    EXPECT_EQ(standby.getConnectionsAccepted(), 1u);
+    standby.stop();
+}
@@ -0,0 +1,98 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/inbound_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    InboundScheduler::Deferred makeDeferred(const std::string& topic, const std::uint16_t packetId = 0)
+    {
+        return InboundScheduler::Deferred{ Message(topic, std::vector<std::uint8_t>{}, false, QualityOfService::AtLeastOnce), {}, packetId };
+    }
+} // namespace
+
+TEST(InboundSchedulerTest, TopicTakesTheHighestPriorityOfItsFilters)
+{
+    InboundScheduler scheduler;
+    EXPECT_FALSE(scheduler.isEnabled());
+
+    scheduler.setPriority("alerts/#", 5);
+    scheduler.setPriority("alerts/fire", 9);
+    scheduler.setPriority("$share/group/telemetry/+", 2);
+    EXPECT_TRUE(scheduler.isEnabled());
+    EXPECT_EQ(scheduler.getPriority("alerts/fire"), 9);
+    EXPECT_EQ(scheduler.getPriority("alerts/flood"), 5);
+    EXPECT_EQ(scheduler.getPriority("telemetry/a"), 2);
+    EXPECT_EQ(scheduler.getPriority("other"), 0);
+
+    scheduler.setPriority("alerts/fire", 1);
+    EXPECT_EQ(scheduler.getPriority("alerts/fire"), 5);
+    scheduler.setPriority("alerts/#", 0);
+    scheduler.setPriority("alerts/fire", 0);
+    scheduler.setPriority("$share/group/telemetry/+", 0);
+    EXPECT_FALSE(scheduler.isEnabled());
+}
+
+TEST(InboundSchedulerTest, WaitingMessagesGoHighestPriorityFirstWithinTheBudget)
+{
+    InboundScheduler scheduler;
+    scheduler.setPriority("critical", 3);
+    scheduler.setBudget(2);
+
+    EXPECT_TRUE(scheduler.tryAdmit(0));
+    EXPECT_TRUE(scheduler.tryAdmit(0));
+    EXPECT_FALSE(scheduler.tryAdmit(3));
+    scheduler.defer(0, makeDeferred("bulk", 1));
+    scheduler.defer(0, makeDeferred("bulk", 2));
+    scheduler.defer(3, makeDeferred("critical", 3));
+    EXPECT_FALSE(scheduler.takeNext().has_value());
+
+    scheduler.beginTick();
+    // A new message waits behind the waiting ones of its priority or higher.
+    EXPECT_FALSE(scheduler.tryAdmit(0));
+    EXPECT_FALSE(scheduler.tryAdmit(3));
+    auto next = scheduler.takeNext();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->ackPacketId, 3);
+    next = scheduler.takeNext();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->ackPacketId, 1);
+    EXPECT_FALSE(scheduler.takeNext().has_value());
+    EXPECT_EQ(scheduler.getWaitingCount(), 1u);
+
+    // Only bulk messages wait, so a critical one goes ahead of them.
+    scheduler.beginTick();
+    EXPECT_TRUE(scheduler.tryAdmit(3));
+    next = scheduler.takeNext();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->ackPacketId, 2);
+    EXPECT_EQ(scheduler.getWaitingCount(), 0u);
+    EXPECT_FALSE(scheduler.tryAdmit(0));
+}
+
+TEST(InboundSchedulerTest, IsFullOnceManyTicksOfBudgetWait)
+{
+    InboundScheduler scheduler;
+    scheduler.setPriority("critical", 1);
+    for (size_t i = 0; i < InboundScheduler::kMaxWaitingTicks; ++i)
+    {
+        scheduler.defer(0, makeDeferred("bulk"));
+    }
+    EXPECT_FALSE(scheduler.isFull());
+
+    scheduler.setBudget(1);
+    EXPECT_TRUE(scheduler.isFull());
+    scheduler.beginTick();
+    EXPECT_TRUE(scheduler.takeNext().has_value());
+    EXPECT_FALSE(scheduler.isFull());
+}
@@ -0,0 +1,385 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/context.h"
+#include "mqtt/client/state/processing/incoming_publish.h"
+#include "mqtt/client/state/ready_state.h"
+#include "mqtt/packets/publish.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/message_view.h"
+#include "serialize/bytes.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    std::vector<std::uint8_t> encodePublish(const QualityOfService qos, const std::uint16_t packetId)
+    {
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish3 publish("cam/frame", { 9, 8, 7 }, qos, false, packetId);
+        publish.encode(writer);
+
+        std::vector<std::uint8_t> bytes(buffer.size());
+        std::memcpy(bytes.data(), buffer.data(), buffer.size());
+        return bytes;
+    }
+
+    std::vector<std::uint8_t> encodeAliasedPublish(const std::string& topic, const std::uint16_t alias)
+    {
+        using namespace packets::properties;
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish5 publish(
+            topic,
+            { 1, 2 },
+            QualityOfService::AtMostOnce,
+            false,
+            0,
+            Properties{ { Property::create<PropertyIdentifier::TopicAlias>(alias) } });
+        publish.encode(writer);
+
+        std::vector<std::uint8_t> bytes(buffer.size());
+        std::memcpy(bytes.data(), buffer.data(), buffer.size());
+        return bytes;
+    }
+
+    std::vector<std::uint8_t> encodePublishWithProperties()
+    {
+        using namespace packets::properties;
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish5 publish(
+            "cam/frame",
+            { 1, 2 },
+            QualityOfService::AtMostOnce,
+            false,
+            0,
+            Properties{ { Property::create<PropertyIdentifier::MessageExpiryInterval>(std::uint32_t{ 30 }),
+                          Property::create<PropertyIdentifier::UserProperty>(std::pair<std::string, std::string>{ "trace", "abc" }),
+                          Property::create<PropertyIdentifier::CorrelationData>(std::vector<std::uint8_t>{ 0xC0, 0xDE }) } });
+        publish.encode(writer);
+
+        std::vector<std::uint8_t> bytes(buffer.size());
+        std::memcpy(bytes.data(), buffer.data(), buffer.size());
+        return bytes;
+    }
+
+    ConnectionSettingsPtr makeSettings()
+    {
+        ConnectionSettingsBuilder b;
+        b.setHost("localhost");
+        return b.build();
+    }
+} // namespace
+
+TEST(IncomingPublishTest, ViewHandlerSeesReceiveBufferWithoutCopy)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::AtMostOnce, 0);
+
+    const void* seenTopic = nullptr;
+    std::string topic;
+    auto viewHandle = ctx.getOnMessageView().add(
+        [&](const MessageView& view)
+        {
+            seenTopic = view.getTopic().data();
+            topic = std::string{ view.getTopic() };
+        });
+    ASSERT_TRUE(ctx.shouldDecodePublishViews());
+
+    ReadyState state;
+    {
+        const auto transition = state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+        EXPECT_FALSE(transition.newState.has_value());
+    }
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(topic, "cam/frame");
+    EXPECT_GE(static_cast<const std::uint8_t*>(seenTopic), frame.data());
+    EXPECT_LT(static_cast<const std::uint8_t*>(seenTopic), frame.data() + frame.size());
+}
+
+TEST(IncomingPublishTest, ViewHandlerReadsPropertiesFromReceiveBuffer)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto frame = encodePublishWithProperties();
+
+    std::optional<std::uint32_t> expiry;
+    std::optional<std::string_view> trace;
+    std::vector<std::uint8_t> identifiers;
+    std::vector<std::uint8_t> correlation;
+    bool wellFormed = false;
+    auto viewHandle = ctx.getOnMessageView().add(
+        [&](const MessageView& view)
+        {
+            expiry = view.getMessageExpiryInterval();
+            trace = view.findUserProperty("trace");
+            wellFormed = view.forEachProperty(
+                [&](const MessageProperty& property)
+                {
+                    identifiers.push_back(property.identifier);
+                    correlation.insert(correlation.end(), property.binary.begin(), property.binary.end());
+                });
+        });
+
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_TRUE(wellFormed);
+    EXPECT_EQ(expiry, 30u);
+    ASSERT_TRUE(trace.has_value());
+    EXPECT_EQ(trace.value(), "abc");
+    EXPECT_GE(reinterpret_cast<const std::uint8_t*>(trace->data()), frame.data());
+    EXPECT_LT(reinterpret_cast<const std::uint8_t*>(trace->data()), frame.data() + frame.size());
+    EXPECT_EQ(identifiers, (std::vector<std::uint8_t>{ 0x02, 0x26, 0x09 }));
+    EXPECT_EQ(correlation, (std::vector<std::uint8_t>{ 0xC0, 0xDE }));
+}
+
+TEST(IncomingPublishTest, PublishIsDecodedWithoutThePacketArena)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::AtMostOnce, 0);
+
+    std::vector<std::uint8_t> payload;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { payload = message.getPayload(); });
+
+    ASSERT_TRUE(ctx.getPacketArena().isEnabled());
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+
+    EXPECT_EQ(payload, (std::vector<std::uint8_t>{ 9, 8, 7 }));
+    EXPECT_EQ(ctx.getPacketArena().getBytesUsed(), 0u);
+    EXPECT_EQ(ctx.getMetricCounters().messagesReceived.load(), 1u);
+}
+
+TEST(IncomingPublishTest, MalformedPublishCountsAParseFailure)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+
+    // The topic length is cut short.
+    constexpr std::array<std::uint8_t, 3> truncated{ 0x30, 0x01, 0x00 };
+    ReadyState state;
+    const auto transition = state.onDataReceived(ctx, truncated.data(), static_cast<std::uint32_t>(truncated.size()));
+
+    EXPECT_FALSE(transition.newState.has_value());
+    EXPECT_EQ(ctx.getMetricCounters().parseFailures.load(), 1u);
+    EXPECT_EQ(ctx.getMetricCounters().messagesReceived.load(), 0u);
+}
+
+TEST(IncomingPublishTest, OwningHandlerStillReceivesCopyAlongsideViewHandler)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::AtLeastOnce, 3);
+
+    int views = 0;
+    std::vector<std::uint8_t> payload;
+    auto viewHandle = ctx.getOnMessageView().add([&](const MessageView&) { ++views; });
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { payload = message.getPayload(); });
+
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(views, 1);
+    EXPECT_EQ(payload, (std::vector<std::uint8_t>{ 9, 8, 7 }));
+    EXPECT_FALSE(ctx.hasIncomingPacketId(3));
+}
+
+TEST(IncomingPublishTest, ExactlyOnceViewIsDeliveredOnPubRel)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::ExactlyOnce, 5);
+
+    std::string topic;
+    auto viewHandle = ctx.getOnMessageView().add([&](const MessageView& view) { topic = std::string{ view.getTopic() }; });
+
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_TRUE(topic.empty());
+
+    const std::vector<std::uint8_t> pubRel{ 0x62, 0x02, 0x00, 0x05 };
+    (void)state.onDataReceived(ctx, pubRel.data(), static_cast<std::uint32_t>(pubRel.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(topic, "cam/frame");
+}
+
+TEST(IncomingPublishTest, ExactlyOnceCanBeDeliveredOnPublishOnce)
+{
+    ConnectionSettingsBuilder builder;
+    builder.setHost("localhost").setDeliverQos2OnPublish(true);
+    Context ctx(builder.build());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::ExactlyOnce, 5);
+
+    int views = 0;
+    int messages = 0;
+    auto viewHandle = ctx.getOnMessageView().add([&](const MessageView&) { ++views; });
+    auto messageHandle = ctx.getOnMessage().add([&](const Message&) { ++messages; });
+
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(views, 1);
+    EXPECT_EQ(messages, 1);
+    EXPECT_FALSE(ctx.hasIncomingPacketId(5));
+
+    // Resent before PUBREL: acknowledged again, not delivered again.
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(views, 1);
+    EXPECT_EQ(messages, 1);
+
+    const std::vector<std::uint8_t> pubRel{ 0x62, 0x02, 0x00, 0x05 };
+    (void)state.onDataReceived(ctx, pubRel.data(), static_cast<std::uint32_t>(pubRel.size()));
+    ctx.resetPacketArena();
+    EXPECT_FALSE(ctx.releaseDeliveredQos2PacketId(5));
+
+    // The packet ID is free again once PUBREL has released it.
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(views, 2);
+    EXPECT_EQ(messages, 2);
+}
+
+TEST(IncomingPublishTest, OwningPathMovesDecodedPayloadIntoMessage)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    const auto frame = encodePublish(QualityOfService::AtLeastOnce, 4);
+
+    const void* delivered = nullptr;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { delivered = message.getPayload().data(); });
+
+    {
+        const auto packet = ctx.parsePacket(frame.data(), static_cast<std::uint32_t>(frame.size()));
+        ASSERT_NE(packet, nullptr);
+        const void* decoded = static_cast<const packets::IPublishPacket&>(*packet).getPayload().data();
+
+        (void)incoming::publish::broadcast(ctx, *packet);
+        EXPECT_EQ(delivered, decoded);
+    }
+    ctx.resetPacketArena();
+}
+
+TEST(IncomingPublishTest, MovingMessageKeepsPayloadBuffer)
+{
+    Message original(std::string(64, 't'), Message::Payload(64 * 1024, 0x5A), false, QualityOfService::AtMostOnce);
+    const void* payload = original.getPayload().data();
+    const void* topic = original.getTopic().data();
+
+    const Message moved(std::move(original));
+
+    EXPECT_EQ(moved.getPayload().data(), payload);
+    EXPECT_EQ(moved.getTopic().data(), topic);
+}
+
+TEST(IncomingPublishTest, AliasOnlyPublishResolvesTopicFromAliasTable)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.getInboundTopicAliases().reset(4);
+
+    std::vector<std::string> topics;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { topics.push_back(message.getTopic()); });
+
+    ReadyState state;
+    for (const auto& frame : { encodeAliasedPublish("telemetry/a", 2), encodeAliasedPublish("", 2) })
+    {
+        (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+        ctx.resetPacketArena();
+    }
+
+    EXPECT_EQ(topics, (std::vector<std::string>{ "telemetry/a", "telemetry/a" }));
+}
+
+TEST(IncomingPublishTest, AliasOnlyViewPointsIntoAliasTable)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.getInboundTopicAliases().reset(4);
+
+    std::vector<std::string> topics;
+    auto viewHandle = ctx.getOnMessageView().add([&](const MessageView& view) { topics.emplace_back(view.getTopic()); });
+
+    ReadyState state;
+    for (const auto& frame : { encodeAliasedPublish("telemetry/b", 1), encodeAliasedPublish("", 1) })
+    {
+        (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+        ctx.resetPacketArena();
+    }
+
+    EXPECT_EQ(topics, (std::vector<std::string>{ "telemetry/b", "telemetry/b" }));
+}
+
+TEST(IncomingPublishTest, UnknownOrOutOfRangeAliasIsDropped)
+{
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.getInboundTopicAliases().reset(2);
+
+    int delivered = 0;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message&) { ++delivered; });
+
+    ReadyState state;
+    for (const auto& frame : { encodeAliasedPublish("", 1), encodeAliasedPublish("telemetry/c", 3) })
+    {
+        (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+        ctx.resetPacketArena();
+    }
+
+    EXPECT_EQ(delivered, 0);
+}
+
+TEST(IncomingPublishTest, SubscriptionIdentifierRoutesWithoutMatchingTheTopic)
+{
+    using namespace packets::properties;
+    Context ctx(makeSettings());
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+
+    int routed = 0;
+    const std::uint32_t identifier = ctx.getTopicRouter().add("telemetry/+", [&](const Message&) { ++routed; }, true);
+    ASSERT_NE(identifier, 0u);
+
+    std::vector<std::byte> buffer;
+    serialize::ByteWriter writer(buffer);
+    const packets::Publish5 publish(
+        "elsewhere",
+        { 1 },
+        QualityOfService::AtMostOnce,
+        false,
+        0,
+        Properties{ { Property::create<PropertyIdentifier::SubscriptionIdentifier>(identifier) } });
+    publish.encode(writer);
+    std::vector<std::uint8_t> frame(buffer.size());
+    std::memcpy(frame.data(), buffer.data(), buffer.size());
+
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(routed, 1);
+}
@@ -0,0 +1,94 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/last_value_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    Message makeMessage(const std::string& topic, const std::uint8_t value)
+    {
+        return Message{ topic, std::vector<std::uint8_t>{ value }, false, QualityOfService::AtMostOnce };
+    }
+} // namespace
+
+TEST(LastValueCacheTest, KeepsTheLatestMessagePerTopic)
+{
+    LastValueCache cache(4);
+    EXPECT_EQ(cache.find("a"), nullptr);
+
+    cache.store(makeMessage("a", 1));
+    cache.store(makeMessage("b", 2));
+    const auto first = cache.find("a");
+    cache.store(makeMessage("a", 3));
+
+    ASSERT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.find("a")->getPayloadView()[0], 3);
+    EXPECT_EQ(cache.find("b")->getPayloadView()[0], 2);
+    EXPECT_EQ(cache.find("a/+"), nullptr);
+
+    // A value already loaded is not changed by later stores.
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->getPayloadView()[0], 1);
+}
+
+TEST(LastValueCacheTest, IgnoresNewTopicsOnceFull)
+{
+    LastValueCache cache(2);
+    cache.store(makeMessage("a", 1));
+    cache.store(makeMessage("b", 2));
+    cache.store(makeMessage("c", 3));
+    cache.store(makeMessage("b", 4));
+
+    EXPECT_EQ(cache.find("c"), nullptr);
+    EXPECT_EQ(cache.find("b")->getPayloadView()[0], 4);
+}
+
+TEST(LastValueCacheTest, ReadersOnOtherThreadsSeeWholeValues)
+{
+    constexpr int kTopics = 64;
+    constexpr int kRounds = 200;
+    LastValueCache cache(kTopics);
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> mismatches{ 0 };
+    std::thread reader(
+        [&cache, &done, &mismatches]
+        {
+            while (!done.load(std::memory_order_acquire))
+            {
+                for (int i = 0; i < kTopics; ++i)
+                {
+                    const std::string topic = "t/" + std::to_string(i);
+                    if (const auto message = cache.find(topic); message && message->getTopic() != topic)
+                    {
+                        mismatches.fetch_add(1);
+                    }
+                }
+            }
+        });
+
+    for (int round = 0; round < kRounds; ++round)
+    {
+        for (int i = 0; i < kTopics; ++i)
+        {
+            cache.store(makeMessage("t/" + std::to_string(i), static_cast<std::uint8_t>(round)));
+        }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(cache.find("t/63")->getPayloadView()[0], static_cast<std::uint8_t>(kRounds - 1));
+}
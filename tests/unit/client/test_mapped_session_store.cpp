@@ -0,0 +1,161 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_PLATFORM_POSIX_FAMILY && !REACTORMQ_PLATFORM_WINDOWS_FAMILY
+
+#include "mqtt/client/context.h"
+#include "mqtt/client/mapped_session_store.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    class MappedSessionStoreTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+            m_path = std::filesystem::temp_directory_path()
+                / (std::string("reactormq_") + info->name() + "_" + std::to_string(getpid()) + ".session");
+            std::filesystem::remove(m_path);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_path);
+        }
+
+        std::filesystem::path m_path;
+    };
+
+    Message makeMessage(const std::string& topic, const std::uint8_t fill, const QualityOfService qos = QualityOfService::AtLeastOnce)
+    {
+        return Message{ topic, Message::Payload(4, fill), false, qos };
+    }
+} // namespace
+
+TEST_F(MappedSessionStoreTest, ReopenedStoreHoldsWhatWasNotRemoved)
+{
+    {
+        MappedSessionStore store(m_path.string(), 4096);
+        ASSERT_TRUE(store.isOpen());
+        store.addOutboundPublish(1, makeMessage("a/1", 1));
+        store.addOutboundPublish(2, makeMessage("a/2", 2));
+        store.addOutboundPublish(3, Message{ "a/3", Message::Payload{ 3 }, true, QualityOfService::ExactlyOnce });
+        store.removeOutboundPublish(2);
+        store.addInboundQos2(7, makeMessage("b/7", 7, QualityOfService::ExactlyOnce));
+        store.commit();
+    }
+
+    const MappedSessionStore store(m_path.string(), 4096);
+    const auto outbound = store.loadOutboundPublishes();
+    ASSERT_EQ(outbound.size(), 2u);
+    EXPECT_EQ(outbound[0].packetId, 1u);
+    EXPECT_EQ(outbound[0].message.getTopic(), "a/1");
+    EXPECT_EQ(outbound[0].message.getPayload(), Message::Payload(4, 1));
+    EXPECT_EQ(outbound[1].packetId, 3u);
+    EXPECT_TRUE(outbound[1].message.shouldRetain());
+    EXPECT_EQ(outbound[1].message.getQualityOfService(), QualityOfService::ExactlyOnce);
+
+    const auto inbound = store.loadInboundQos2();
+    ASSERT_EQ(inbound.size(), 1u);
+    EXPECT_EQ(inbound[0].packetId, 7u);
+    EXPECT_EQ(inbound[0].message.getTopic(), "b/7");
+}
+
+TEST_F(MappedSessionStoreTest, RecoveryStopsAtACorruptRecord)
+{
+    {
+        MappedSessionStore store(m_path.string(), 4096);
+        store.addOutboundPublish(1, makeMessage("a/1", 1));
+        store.addOutboundPublish(2, makeMessage("a/2", 2));
+        store.commit();
+    }
+
+    // Flip the last payload byte of the second record, as a write torn by a crash would leave it.
+    {
+        std::fstream file(m_path, std::ios::in | std::ios::out | std::ios::binary);
+        const std::streamoff firstRecord = 16 + 8 + 6 + 3 + 4;
+        file.seekp(firstRecord + 8 + 6 + 3 + 3);
+        file.put(static_cast<char>(0x55));
+    }
+
+    {
+        MappedSessionStore store(m_path.string(), 4096);
+        const auto outbound = store.loadOutboundPublishes();
+        ASSERT_EQ(outbound.size(), 1u);
+        EXPECT_EQ(outbound[0].packetId, 1u);
+
+        store.addOutboundPublish(9, makeMessage("c", 9));
+        store.commit();
+    }
+
+    const MappedSessionStore store(m_path.string(), 4096);
+    const auto outbound = store.loadOutboundPublishes();
+    ASSERT_EQ(outbound.size(), 2u);
+    EXPECT_EQ(outbound[1].packetId, 9u);
+}
+
+TEST_F(MappedSessionStoreTest, FullLogIsCompactedToTheLiveRecords)
+{
+    {
+        MappedSessionStore store(m_path.string(), 4096);
+        store.addOutboundPublish(1, makeMessage("keep", 1));
+        for (std::uint16_t i = 0; i < 2000; ++i)
+        {
+            const auto packetId = static_cast<std::uint16_t>(2 + i % 10);
+            store.addOutboundPublish(packetId, makeMessage("churn/topic", static_cast<std::uint8_t>(i)));
+            store.removeOutboundPublish(packetId);
+        }
+        store.addInboundQos2(5, makeMessage("in", 5, QualityOfService::ExactlyOnce));
+        store.commit();
+    }
+
+    EXPECT_LE(std::filesystem::file_size(m_path), 8192u);
+
+    const MappedSessionStore store(m_path.string(), 4096);
+    const auto outbound = store.loadOutboundPublishes();
+    ASSERT_EQ(outbound.size(), 1u);
+    EXPECT_EQ(outbound[0].message.getTopic(), "keep");
+    ASSERT_EQ(store.loadInboundQos2().size(), 1u);
+}
+
+TEST_F(MappedSessionStoreTest, ContextResumesStoredSession)
+{
+    {
+        const auto store = std::make_shared<MappedSessionStore>(m_path.string(), 4096);
+        store->addOutboundPublish(4, makeMessage("out", 1));
+        store->addInboundQos2(9, makeMessage("in", 2, QualityOfService::ExactlyOnce));
+        store->commit();
+    }
+
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setSessionStore(std::make_shared<MappedSessionStore>(m_path.string(), 4096));
+    Context ctx(b.build());
+
+    EXPECT_TRUE(ctx.isPacketIdInUse(4));
+    EXPECT_EQ(ctx.getPendingPublishCount(), 1u);
+    ASSERT_NE(ctx.findPendingPublish(4), nullptr);
+    EXPECT_EQ(ctx.findPendingPublish(4)->message.getTopic(), "out");
+
+    EXPECT_TRUE(ctx.hasIncomingPacketId(9));
+    const auto message = ctx.takePendingIncomingQos2Message(9);
+    ASSERT_TRUE(message.has_value());
+    EXPECT_EQ(message->getTopic(), "in");
+
+    // Acknowledged state is forgotten by the store as well.
+    EXPECT_TRUE(ctx.takePendingPublish(4).has_value());
+    EXPECT_TRUE(ctx.getSettings()->getSessionStore()->loadOutboundPublishes().empty());
+    EXPECT_TRUE(ctx.getSettings()->getSessionStore()->loadInboundQos2().empty());
+}
+
+#endif // REACTORMQ_PLATFORM_POSIX_FAMILY && !REACTORMQ_PLATFORM_WINDOWS_FAMILY
@@ -0,0 +1,54 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/message_dispatcher.h"
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt::client;
+
+TEST(MessageDispatcherTest, TasksWithTheSameKeyRunInDispatchOrder)
+{
+    std::vector<int> order;
+    {
+        MessageDispatcher dispatcher(4);
+        for (int i = 0; i < 1000; ++i)
+        {
+            dispatcher.dispatch(7, [&order, i] { order.push_back(i); });
+        }
+    }
+
+    ASSERT_EQ(order.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+TEST(MessageDispatcherTest, DifferentLanesRunOnDifferentThreads)
+{
+    std::mutex mutex;
+    std::vector<std::thread::id> threads(2);
+    {
+        MessageDispatcher dispatcher(2);
+        EXPECT_EQ(dispatcher.getLaneCount(), 2u);
+        for (size_t key = 0; key < 2; ++key)
+        {
+            dispatcher.dispatch(
+                key,
+                [&mutex, &threads, key]
+                {
+                    std::scoped_lock lock(mutex);
+                    threads[key] = std::this_thread::get_id();
+                });
+        }
+    }
+
+    EXPECT_NE(threads[0], std::thread::id{});
+    EXPECT_NE(threads[0], threads[1]);
+    EXPECT_NE(threads[0], std::this_thread::get_id());
+}
@@ -0,0 +1,164 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "mqtt/client/mpsc_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt::client;
+
+TEST(MpscQueueTest, EmptyQueuePopsNothing)
+{
+    MpscQueue<int> queue;
+    EXPECT_EQ(queue.getDepth(), 0u);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(MpscQueueTest, SingleProducerIsFifo)
+{
+    MpscQueue<int> queue;
+    for (int i = 0; i < 5; ++i)
+    {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.getDepth(), 5u);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto value = queue.tryPop();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(value.value(), i);
+    }
+    EXPECT_FALSE(queue.tryPop().has_value());
+    EXPECT_EQ(queue.getDepth(), 0u);
+}
+
+TEST(MpscQueueTest, ReusableAfterDrain)
+{
+    MpscQueue<int> queue;
+    queue.push(1);
+    EXPECT_EQ(queue.tryPop().value_or(-1), 1);
+    EXPECT_FALSE(queue.tryPop().has_value());
+
+    queue.push(2);
+    queue.push(3);
+    EXPECT_EQ(queue.tryPop().value_or(-1), 2);
+    EXPECT_EQ(queue.tryPop().value_or(-1), 3);
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(MpscQueueTest, MoveOnlyValuesAreReleasedOnDestruction)
+{
+    const auto tracker = std::make_shared<int>(0);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(tracker);
+        queue.push(tracker);
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(MpscQueueTest, PoppedNodesAreRecycledUpToTheCap)
+{
+    const auto tracker = std::make_shared<int>(0);
+    MpscQueue<std::shared_ptr<int>> queue(2);
+    for (int i = 0; i < 3; ++i)
+    {
+        queue.push(tracker);
+    }
+    EXPECT_EQ(queue.getRecycledNodeCount(), 0u);
+
+    while (queue.tryPop().has_value())
+    {
+    }
+    EXPECT_EQ(queue.getRecycledNodeCount(), 2u);
+    // A recycled node holds no value.
+    EXPECT_EQ(tracker.use_count(), 1);
+
+    queue.push(tracker);
+    EXPECT_EQ(queue.getRecycledNodeCount(), 1u);
+    EXPECT_EQ(queue.tryPop().value_or(nullptr), tracker);
+    EXPECT_EQ(queue.getRecycledNodeCount(), 2u);
+}
+
+TEST(MpscQueueTest, PreallocatedNodesServePushesAndRaiseTheCap)
+{
+    MpscQueue<int> queue(2);
+    queue.preallocate(5);
+    EXPECT_EQ(queue.getRecycledNodeCount(), 5u);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.getRecycledNodeCount(), 0u);
+
+    while (queue.tryPop().has_value())
+    {
+    }
+    EXPECT_EQ(queue.getRecycledNodeCount(), 5u);
+}
+
+TEST(MpscQueueTest, ConcurrentProducersPreservePerProducerOrder)
+{
+    constexpr int kProducerCount = 8;
+    constexpr int kItemsPerProducer = 20000;
+
+    struct Item
+    {
+        int producer;
+        int sequence;
+    };
+
+    MpscQueue<Item> queue;
+    std::atomic<bool> isStarted{ false };
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducerCount; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, &isStarted, producer]
+            {
+                while (!isStarted.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                for (int sequence = 0; sequence < kItemsPerProducer; ++sequence)
+                {
+                    queue.push(Item{ producer, sequence });
+                }
+            });
+    }
+
+    isStarted.store(true, std::memory_order_release);
+
+    std::vector<int> nextSequence(kProducerCount, 0);
+    int received = 0;
+    while (received < kProducerCount * kItemsPerProducer)
+    {
+        if (const auto item = queue.tryPop())
+        {
+            ASSERT_EQ(item->sequence, nextSequence[item->producer]);
+            ++nextSequence[item->producer];
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_FALSE(queue.tryPop().has_value());
+    EXPECT_EQ(queue.getDepth(), 0u);
+}
@@ -0,0 +1,155 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/offline_publish_queue.h"
+
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    struct QueuedPublish
+    {
+        PublishCommand command;
+        std::future<Result<void>> future;
+    };
+
+    QueuedPublish makePublish(const std::string& topic, const size_t payloadSize = 4, const std::uint32_t expirySeconds = 0)
+    {
+        std::promise<Result<void>> promise;
+        auto future = promise.get_future();
+        Message message{ topic, Message::Payload(payloadSize, 0x42), false, QualityOfService::AtLeastOnce };
+        message.setMessageExpiryInterval(expirySeconds);
+        return { PublishCommand{ std::move(message), std::move(promise) }, std::move(future) };
+    }
+
+    bool hasFailed(std::future<Result<void>>& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !future.get().hasSucceeded();
+    }
+
+    bool isPending(const std::future<Result<void>>& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout;
+    }
+} // namespace
+
+TEST(OfflinePublishQueueTest, DisabledQueueFailsEveryPublish)
+{
+    OfflinePublishQueue queue(0, 1024, OfflineQueuePolicy::DropOldest);
+    auto publish = makePublish("a");
+    queue.push(std::move(publish.command));
+
+    EXPECT_TRUE(hasFailed(publish.future));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(OfflinePublishQueueTest, PopsInArrivalOrderAndTracksBytes)
+{
+    OfflinePublishQueue queue(4, 1024, OfflineQueuePolicy::Reject);
+    auto a = makePublish("a");
+    auto b = makePublish("bb");
+    queue.push(std::move(a.command));
+    queue.push(std::move(b.command));
+    EXPECT_EQ(queue.getBytes(), 1u + 4u + 2u + 4u);
+
+    EXPECT_EQ(queue.pop()->message.getTopic(), "a");
+    EXPECT_EQ(queue.pop()->message.getTopic(), "bb");
+    EXPECT_FALSE(queue.pop().has_value());
+    EXPECT_EQ(queue.getBytes(), 0u);
+}
+
+TEST(OfflinePublishQueueTest, RejectFailsTheNewPublish)
+{
+    OfflinePublishQueue queue(1, 1024, OfflineQueuePolicy::Reject);
+    auto first = makePublish("first");
+    auto second = makePublish("second");
+    queue.push(std::move(first.command));
+    queue.push(std::move(second.command));
+
+    EXPECT_TRUE(isPending(first.future));
+    EXPECT_TRUE(hasFailed(second.future));
+    EXPECT_EQ(queue.pop()->message.getTopic(), "first");
+}
+
+TEST(OfflinePublishQueueTest, DropOldestMakesRoomByByteLimit)
+{
+    OfflinePublishQueue queue(8, 20, OfflineQueuePolicy::DropOldest);
+    auto a = makePublish("a", 8);
+    auto b = makePublish("b", 8);
+    auto c = makePublish("c", 8);
+    queue.push(std::move(a.command));
+    queue.push(std::move(b.command));
+    queue.push(std::move(c.command));
+
+    EXPECT_TRUE(hasFailed(a.future));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.pop()->message.getTopic(), "b");
+    EXPECT_EQ(queue.pop()->message.getTopic(), "c");
+}
+
+TEST(OfflinePublishQueueTest, DropNewestReplacesTheLastQueuedPublish)
+{
+    OfflinePublishQueue queue(2, 1024, OfflineQueuePolicy::DropNewest);
+    auto a = makePublish("a");
+    auto b = makePublish("b");
+    auto c = makePublish("c");
+    queue.push(std::move(a.command));
+    queue.push(std::move(b.command));
+    queue.push(std::move(c.command));
+
+    EXPECT_TRUE(hasFailed(b.future));
+    EXPECT_EQ(queue.pop()->message.getTopic(), "a");
+    EXPECT_EQ(queue.pop()->message.getTopic(), "c");
+}
+
+TEST(OfflinePublishQueueTest, PublishLargerThanTheQueueIsRejected)
+{
+    OfflinePublishQueue queue(8, 10, OfflineQueuePolicy::DropOldest);
+    auto small = makePublish("a");
+    auto large = makePublish("b", 64);
+    queue.push(std::move(small.command));
+    queue.push(std::move(large.command));
+
+    EXPECT_TRUE(isPending(small.future));
+    EXPECT_TRUE(hasFailed(large.future));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(OfflinePublishQueueTest, ExpiredPublishesMakeRoomBeforeThePolicyApplies)
+{
+    OfflinePublishQueue queue(2, 1024, OfflineQueuePolicy::Reject);
+    auto stale = makePublish("stale", 4, 1);
+    auto fresh = makePublish("fresh");
+    auto next = makePublish("next");
+    stale.command.enqueuedAt -= std::chrono::seconds(2);
+    queue.push(std::move(stale.command));
+    queue.push(std::move(fresh.command));
+    queue.push(std::move(next.command));
+
+    ASSERT_EQ(stale.future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(stale.future.get().hasExpired());
+    EXPECT_TRUE(isPending(fresh.future));
+    EXPECT_TRUE(isPending(next.future));
+    EXPECT_EQ(queue.pop()->message.getTopic(), "fresh");
+    EXPECT_EQ(queue.pop()->message.getTopic(), "next");
+}
+
+TEST(OfflinePublishQueueTest, RemainingExpiryIsRoundedUpAndNeverZero)
+{
+    auto publish = makePublish("a", 4, 10);
+    const auto start = publish.command.enqueuedAt;
+
+    EXPECT_EQ(publish.command.getRemainingExpiryInterval(start), 10u);
+    EXPECT_EQ(publish.command.getRemainingExpiryInterval(start + std::chrono::milliseconds(2500)), 8u);
+    EXPECT_EQ(publish.command.getRemainingExpiryInterval(start + std::chrono::seconds(20)), 1u);
+    EXPECT_FALSE(publish.command.hasExpired(start + std::chrono::milliseconds(9999)));
+    EXPECT_TRUE(publish.command.hasExpired(start + std::chrono::seconds(10)));
+    EXPECT_EQ(makePublish("b").command.getRemainingExpiryInterval(start), 0u);
+}
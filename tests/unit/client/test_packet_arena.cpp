@@ -0,0 +1,169 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "mqtt/client/packet_arena.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    class TrackingPacket final : public packets::IControlPacket
+    {
+    public:
+        explicit TrackingPacket(int& destroyed)
+            : m_destroyed(destroyed)
+        {
+        }
+
+        ~TrackingPacket() override
+        {
+            ++m_destroyed;
+        }
+
+        [[nodiscard]] std::uint32_t getLength() const override
+        {
+            return 0;
+        }
+
+        [[nodiscard]] packets::PacketType getPacketType() const override
+        {
+            return packets::PacketType::PingResp;
+        }
+
+        [[nodiscard]] bool isValid() const override
+        {
+            return true;
+        }
+
+        void encode(reactormq::serialize::ByteWriter& /*w*/) const override
+        {
+        }
+
+        bool decode(reactormq::serialize::ByteReader& /*r*/) override
+        {
+            return true;
+        }
+
+    private:
+        int& m_destroyed;
+    };
+
+    class CountingResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocations = 0;
+        size_t outstandingBytes = 0;
+
+    private:
+        void* do_allocate(const size_t bytes, const size_t alignment) override
+        {
+            ++allocations;
+            outstandingBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, const size_t bytes, const size_t alignment) override
+        {
+            outstandingBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace
+
+TEST(PacketArenaTest, DisabledArenaAllocatesOnHeap)
+{
+    PacketArena arena(0);
+    int destroyed = 0;
+    {
+        const PacketPtr packet = arena.create<TrackingPacket>(destroyed);
+        EXPECT_FALSE(arena.isEnabled());
+        EXPECT_FALSE(packet.get_deleter().isArenaOwned);
+        EXPECT_EQ(arena.getBytesUsed(), 0u);
+    }
+    EXPECT_EQ(destroyed, 1);
+}
+
+TEST(PacketArenaTest, PacketsAreBumpAllocatedAndDestroyed)
+{
+    PacketArena arena(1024);
+    int destroyed = 0;
+    {
+        const PacketPtr first = arena.create<TrackingPacket>(destroyed);
+        const PacketPtr second = arena.create<TrackingPacket>(destroyed);
+        EXPECT_TRUE(first.get_deleter().isArenaOwned);
+        EXPECT_GE(arena.getBytesUsed(), 2 * sizeof(TrackingPacket));
+        EXPECT_EQ(arena.getOverflowCount(), 0u);
+    }
+    EXPECT_EQ(destroyed, 2);
+
+    arena.reset();
+    EXPECT_EQ(arena.getBytesUsed(), 0u);
+}
+
+TEST(PacketArenaTest, ResetRewindsToTheSameStorage)
+{
+    PacketArena arena(1024);
+    int destroyed = 0;
+    const void* firstAddress = nullptr;
+    {
+        const PacketPtr packet = arena.create<TrackingPacket>(destroyed);
+        firstAddress = packet.get();
+    }
+    arena.reset();
+
+    const PacketPtr packet = arena.create<TrackingPacket>(destroyed);
+    EXPECT_EQ(packet.get(), firstAddress);
+}
+
+TEST(PacketArenaTest, OverflowFallsBackToHeapUntilReset)
+{
+    PacketArena arena(sizeof(TrackingPacket));
+    int destroyed = 0;
+    {
+        const PacketPtr first = arena.create<TrackingPacket>(destroyed);
+        const PacketPtr second = arena.create<TrackingPacket>(destroyed);
+        EXPECT_TRUE(second.get_deleter().isArenaOwned);
+        EXPECT_EQ(arena.getOverflowCount(), 1u);
+    }
+    EXPECT_EQ(destroyed, 2);
+
+    arena.reset();
+    EXPECT_EQ(arena.getOverflowCount(), 0u);
+}
+
+TEST(PacketArenaTest, BlockAndOverflowComeFromTheMemoryResource)
+{
+    CountingResource resource;
+    {
+        PacketArena arena(sizeof(TrackingPacket), &resource);
+        EXPECT_EQ(resource.allocations, 0u);
+
+        int destroyed = 0;
+        size_t withOverflow = 0;
+        {
+            const PacketPtr first = arena.create<TrackingPacket>(destroyed);
+            EXPECT_EQ(resource.allocations, 1u);
+            EXPECT_EQ(resource.outstandingBytes, sizeof(TrackingPacket));
+            const PacketPtr second = arena.create<TrackingPacket>(destroyed);
+            withOverflow = resource.outstandingBytes;
+            EXPECT_GE(withOverflow, 2 * sizeof(TrackingPacket));
+        }
+        arena.reset();
+        EXPECT_EQ(resource.outstandingBytes, withOverflow - sizeof(TrackingPacket));
+    }
+    EXPECT_EQ(resource.outstandingBytes, 0u);
+}
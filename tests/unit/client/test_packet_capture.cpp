@@ -0,0 +1,142 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/packet_tap.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+
+namespace
+{
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+    }
+
+    std::uint32_t readU32(const std::string& bytes, const size_t offset)
+    {
+        std::uint32_t value = 0;
+        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+        return value;
+    }
+
+    std::filesystem::path capturePath(const char* name)
+    {
+        return std::filesystem::temp_directory_path() / name;
+    }
+} // namespace
+
+TEST(PacketCaptureTest, JsonLinesHoldDirectionLengthAndHexOfEachPacket)
+{
+    const auto path = capturePath("reactormq_capture_test.jsonl");
+    {
+        const PacketCapturePtr capture = createPacketCapture({ path.string(), PacketCaptureFormat::JsonLines });
+        ASSERT_NE(capture, nullptr);
+
+        // A PINGREQ sent as one part and a PUBACK received.
+        const std::uint8_t pingReq[] = { 0xC0, 0x00 };
+        const std::span<const std::uint8_t> sent[] = { pingReq };
+        capture->onPacket(PacketDirection::Sent, sent, sizeof(pingReq));
+
+        const std::uint8_t pubAckHeader[] = { 0x40, 0x02 };
+        const std::uint8_t pubAckId[] = { 0x00, 0x2A };
+        const std::span<const std::uint8_t> received[] = { pubAckHeader, pubAckId };
+        capture->onPacket(PacketDirection::Received, received, 4);
+    }
+
+    const std::string text = readFile(path);
+    std::filesystem::remove(path);
+    const size_t firstEnd = text.find('\n');
+    ASSERT_NE(firstEnd, std::string::npos);
+    const std::string first = text.substr(0, firstEnd);
+    const std::string second = text.substr(firstEnd + 1);
+
+    EXPECT_NE(first.find("\"dir\":\"out\",\"len\":2,\"hex\":\"c000\"}"), std::string::npos) << first;
+    EXPECT_NE(second.find("\"dir\":\"in\",\"len\":4,\"hex\":\"4002002a\"}\n"), std::string::npos) << second;
+    EXPECT_EQ(first.rfind("{\"ts_us\":", 0), 0u);
+}
+
+TEST(PacketCaptureTest, PcapngRecordsDirectionAndCutsPacketsAtTheSnapLength)
+{
+    const auto path = capturePath("reactormq_capture_test.pcapng");
+    std::uint64_t written = 0;
+    {
+        PacketCaptureOptions options{ path.string() };
+        options.snapLength = 4;
+        const PacketCapturePtr capture = createPacketCapture(options);
+        ASSERT_NE(capture, nullptr);
+
+        const std::uint8_t publish[] = { 0x30, 0x05, 0x00, 0x01, 'a', 'h', 'i' };
+        const std::span<const std::uint8_t> parts[] = { publish };
+        capture->onPacket(PacketDirection::Received, parts, sizeof(publish) + 100);
+
+        // The writer thread formats in the background; wait for it rather than racing the destructor.
+        for (int i = 0; i < 200 && capture->getWrittenCount() == 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        written = capture->getWrittenCount();
+        EXPECT_EQ(capture->getDroppedCount(), 0u);
+    }
+    EXPECT_EQ(written, 1u);
+
+    const std::string bytes = readFile(path);
+    std::filesystem::remove(path);
+    ASSERT_EQ(bytes.size(), 28u + 20u + 48u);
+    EXPECT_EQ(readU32(bytes, 0), 0x0A0D0D0Au);
+    EXPECT_EQ(readU32(bytes, 8), 0x1A2B3C4Du);
+    EXPECT_EQ(readU32(bytes, 28), 1u);
+    EXPECT_EQ(readU32(bytes, 28 + 8), 147u); // link type USER0, then the reserved half
+
+    const size_t packet = 48;
+    EXPECT_EQ(readU32(bytes, packet), 6u);
+    EXPECT_EQ(readU32(bytes, packet + 4), 48u);
+    EXPECT_EQ(readU32(bytes, packet + 20), 4u);
+    EXPECT_EQ(readU32(bytes, packet + 24), 107u);
+    EXPECT_EQ(std::memcmp(bytes.data() + packet + 28, "\x30\x05\x00\x01", 4), 0);
+    EXPECT_EQ(readU32(bytes, packet + 36), 1u); // epb_flags: inbound
+    EXPECT_EQ(readU32(bytes, packet + 44), 48u);
+}
+
+TEST(PacketCaptureTest, FullRingDropsAndCountsInsteadOfWaiting)
+{
+    const auto path = capturePath("reactormq_capture_drop_test.jsonl");
+    {
+        PacketCaptureOptions options{ path.string(), PacketCaptureFormat::JsonLines };
+        options.ringSlots = 2;
+        const PacketCapturePtr capture = createPacketCapture(options);
+        ASSERT_NE(capture, nullptr);
+
+        const std::uint8_t pingReq[] = { 0xC0, 0x00 };
+        const std::span<const std::uint8_t> parts[] = { pingReq };
+        for (int i = 0; i < 10000; ++i)
+        {
+            capture->onPacket(PacketDirection::Sent, parts, sizeof(pingReq));
+        }
+        for (int i = 0; i < 200 && capture->getWrittenCount() + capture->getDroppedCount() < 10000; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        EXPECT_EQ(capture->getWrittenCount() + capture->getDroppedCount(), 10000u);
+        EXPECT_GT(capture->getDroppedCount(), 0u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(PacketCaptureTest, UnopenableFileGivesNoCapture)
+{
+    EXPECT_EQ(createPacketCapture({ "/nonexistent-directory/capture.pcapng" }), nullptr);
+}
@@ -0,0 +1,103 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/packet_id_pool.h"
+
+#include <gtest/gtest.h>
+
+using namespace reactormq::mqtt::client;
+
+TEST(PacketIdPoolTest, HandsOutIdsInOrderWithoutReusingReleasedOnesImmediately)
+{
+    PacketIdPool pool;
+    EXPECT_EQ(pool.allocate(), 1u);
+    EXPECT_EQ(pool.allocate(), 2u);
+    pool.release(1);
+    EXPECT_EQ(pool.allocate(), 3u);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(PacketIdPoolTest, SkipsIdsInUseAcrossWordBoundaries)
+{
+    PacketIdPool pool;
+    for (int i = 0; i < 200; ++i)
+    {
+        (void)pool.allocate();
+    }
+    for (std::uint16_t id = 1; id <= 200; ++id)
+    {
+        if (id != 130)
+        {
+            pool.release(id);
+        }
+    }
+
+    // Drain the rest of the ID space so the cursor wraps back over the bitmap's first words.
+    for (std::uint32_t id = 201; id <= 65535; ++id)
+    {
+        ASSERT_EQ(pool.allocate(), id);
+    }
+    EXPECT_EQ(pool.allocate(), 1u);
+
+    for (std::uint16_t id = 2; id <= 129; ++id)
+    {
+        EXPECT_EQ(pool.allocate(), id);
+    }
+    EXPECT_EQ(pool.allocate(), 131u);
+}
+
+TEST(PacketIdPoolTest, ExhaustedPoolReturnsZeroUntilAnIdIsReleased)
+{
+    PacketIdPool pool;
+    for (int i = 0; i < 65535; ++i)
+    {
+        ASSERT_NE(pool.allocate(), 0u);
+    }
+    EXPECT_EQ(pool.allocate(), 0u);
+
+    pool.release(40000);
+    EXPECT_FALSE(pool.isInUse(40000));
+    EXPECT_EQ(pool.allocate(), 40000u);
+    EXPECT_EQ(pool.allocate(), 0u);
+}
+
+TEST(PacketIdPoolTest, ReleasingZeroOrAFreeIdIsIgnored)
+{
+    PacketIdPool pool;
+    pool.release(0);
+    pool.release(7);
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_FALSE(pool.isInUse(0));
+    EXPECT_EQ(pool.allocate(), 1u);
+}
+
+TEST(PacketIdPoolTest, ReservedIdsAreSkippedByAllocate)
+{
+    PacketIdPool pool;
+    EXPECT_TRUE(pool.reserve(2));
+    EXPECT_FALSE(pool.reserve(2));
+    EXPECT_FALSE(pool.reserve(0));
+    EXPECT_EQ(pool.allocate(), 1u);
+    EXPECT_EQ(pool.allocate(), 3u);
+    EXPECT_EQ(pool.size(), 3u);
+}
+
+TEST(PacketIdPoolTest, MaxIdNarrowsTheRangeAndWrapsTheCursor)
+{
+    PacketIdPool pool;
+    pool.setMaxId(70);
+    for (std::uint16_t expected = 1; expected <= 70; ++expected)
+    {
+        ASSERT_EQ(pool.allocate(), expected);
+    }
+    EXPECT_EQ(pool.allocate(), 0u);
+    EXPECT_FALSE(pool.reserve(71));
+    EXPECT_FALSE(pool.isInUse(71));
+
+    pool.release(3);
+    pool.release(69);
+    EXPECT_EQ(pool.allocate(), 3u);
+    EXPECT_EQ(pool.allocate(), 69u);
+    EXPECT_EQ(pool.size(), 70u);
+}
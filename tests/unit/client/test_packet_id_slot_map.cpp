@@ -0,0 +1,80 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/packet_id_slot_map.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace reactormq::mqtt::client;
+
+TEST(PacketIdSlotMapTest, EmplaceFindAndTake)
+{
+    PacketIdSlotMap<std::string> map;
+    ASSERT_NE(map.tryEmplace(42, "a"), nullptr);
+    EXPECT_TRUE(map.contains(42));
+    EXPECT_EQ(*map.find(42), "a");
+    EXPECT_EQ(map.find(43), nullptr);
+
+    EXPECT_EQ(map.take(42), "a");
+    EXPECT_FALSE(map.contains(42));
+    EXPECT_FALSE(map.take(42).has_value());
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(PacketIdSlotMapTest, RejectsDuplicateAndZeroIds)
+{
+    PacketIdSlotMap<std::string> map;
+    ASSERT_NE(map.tryEmplace(7, "first"), nullptr);
+    EXPECT_EQ(map.tryEmplace(7, "second"), nullptr);
+    EXPECT_EQ(map.tryEmplace(0, "zero"), nullptr);
+    EXPECT_EQ(*map.find(7), "first");
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(PacketIdSlotMapTest, EraseKeepsOtherEntriesReachable)
+{
+    PacketIdSlotMap<std::unique_ptr<int>> map;
+    for (int id = 1; id <= 600; ++id)
+    {
+        map.tryEmplace(static_cast<std::uint16_t>(id * 100), std::make_unique<int>(id));
+    }
+
+    for (int id = 1; id <= 600; id += 2)
+    {
+        map.erase(static_cast<std::uint16_t>(id * 100));
+    }
+    map.erase(11);
+
+    EXPECT_EQ(map.size(), 300u);
+    for (int id = 2; id <= 600; id += 2)
+    {
+        const auto* value = map.find(static_cast<std::uint16_t>(id * 100));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(**value, id);
+    }
+
+    size_t visited = 0;
+    for (const auto& [packetId, value] : map)
+    {
+        EXPECT_EQ(packetId, *value * 100);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 300u);
+}
+
+TEST(PacketIdSlotMapTest, ReservedMapDoesNotMoveItsValuesWhileFilling)
+{
+    PacketIdSlotMap<std::string> map;
+    map.reserve(300, 300);
+    ASSERT_NE(map.tryEmplace(1, "first"), nullptr);
+    const std::string* first = map.find(1);
+    for (std::uint16_t id = 2; id <= 300; ++id)
+    {
+        ASSERT_NE(map.tryEmplace(id, "value"), nullptr);
+    }
+    EXPECT_EQ(map.find(1), first);
+    EXPECT_EQ(map.size(), 300u);
+}
@@ -0,0 +1,336 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/command.h"
+#include "mqtt/client/context.h"
+#include "mqtt/client/payload_codecs.h"
+#include "mqtt/client/state/ready_state.h"
+#include "mqtt/packets/fixed_header.h"
+#include "mqtt/packets/publish.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/message_view.h"
+#include "serialize/bytes.h"
+
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    /// Run-length pairs (count, byte): tiny for repeated bytes, double the size for anything else.
+    class RunLengthCodec final : public IPayloadCodec
+    {
+    public:
+        [[nodiscard]] std::string_view getName() const override
+        {
+            return "rle";
+        }
+
+        bool encode(const std::span<const std::uint8_t> payload, std::vector<std::uint8_t>& out) const override
+        {
+            out.clear();
+            for (size_t i = 0; i < payload.size();)
+            {
+                size_t run = 1;
+                while (i + run < payload.size() && payload[i + run] == payload[i] && run < 255)
+                {
+                    ++run;
+                }
+                out.push_back(static_cast<std::uint8_t>(run));
+                out.push_back(payload[i]);
+                i += run;
+            }
+            return true;
+        }
+
+        bool decode(const std::span<const std::uint8_t> payload, const size_t maxSize, std::vector<std::uint8_t>& out) const override
+        {
+            out.clear();
+            if (payload.size() % 2 != 0)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < payload.size(); i += 2)
+            {
+                if (out.size() + payload[i] > maxSize)
+                {
+                    return false;
+                }
+                out.insert(out.end(), payload[i], payload[i + 1]);
+            }
+            return true;
+        }
+    };
+
+    class CapturingSocket final : public socket::Socket
+    {
+    public:
+        explicit CapturingSocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* data, const uint32_t size) override
+        {
+            sent.insert(sent.end(), reinterpret_cast<const std::byte*>(data), reinterpret_cast<const std::byte*>(data) + size);
+        }
+
+        socket::OnConnectCallback& getOnConnectCallback() override
+        {
+            return onConnect;
+        }
+
+        socket::OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return onDisconnect;
+        }
+
+        socket::OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return onData;
+        }
+
+        void tick() override
+        {
+        }
+
+        std::vector<std::byte> sent;
+
+    private:
+        socket::OnConnectCallback onConnect;
+        socket::OnDisconnectCallback onDisconnect;
+        socket::OnDataReceivedCallback onData;
+    };
+
+    ConnectionSettingsPtr makeSettings()
+    {
+        ConnectionSettingsBuilder b;
+        b.setHost("localhost").addPayloadCodec("sensors/#", std::make_shared<RunLengthCodec>());
+        return b.build();
+    }
+
+    std::vector<std::byte> publishAndCapture(Context& ctx, CapturingSocket& sock, const std::string& topic, Message::Payload payload)
+    {
+        sock.sent.clear();
+        Command command = PublishCommand{ Message{ topic, std::move(payload), false, QualityOfService::AtLeastOnce },
+                                          std::promise<Result<void>>{} };
+        ReadyState state;
+        (void)state.handleCommand(ctx, command);
+        return sock.sent;
+    }
+
+    std::vector<std::uint8_t> encodeCodecPublish(const std::string& codecName, const std::vector<std::uint8_t>& payload)
+    {
+        using namespace packets::properties;
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::Publish5 publish(
+            "sensors/t",
+            payload,
+            QualityOfService::AtLeastOnce,
+            false,
+            7,
+            Properties{ { Property::create<PropertyIdentifier::UserProperty, std::pair<std::string, std::string>>(
+                { std::string{ kPayloadCodecPropertyKey }, codecName }) } });
+        publish.encode(writer);
+
+        std::vector<std::uint8_t> bytes(buffer.size());
+        std::memcpy(bytes.data(), buffer.data(), buffer.size());
+        return bytes;
+    }
+} // namespace
+
+TEST(PayloadCodecsTest, FiltersFollowMqttWildcardRules)
+{
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("sensors/#", "sensors"));
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("sensors/#", "sensors/a/b"));
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("sensors/+/t", "sensors/a/t"));
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("+/+", "a/"));
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("#", "a/b"));
+
+    EXPECT_FALSE(PayloadCodecs::matchesFilter("sensors/+", "sensors/a/b"));
+    EXPECT_FALSE(PayloadCodecs::matchesFilter("sensors/+/t", "sensors/t"));
+    EXPECT_FALSE(PayloadCodecs::matchesFilter("sensors", "sensors/a"));
+    EXPECT_FALSE(PayloadCodecs::matchesFilter("#", "$SYS/uptime"));
+    EXPECT_FALSE(PayloadCodecs::matchesFilter("+/uptime", "$SYS/uptime"));
+    EXPECT_TRUE(PayloadCodecs::matchesFilter("$SYS/#", "$SYS/uptime"));
+}
+
+TEST(PayloadCodecsTest, FirstMatchingBindingWinsAndNamesResolve)
+{
+    const auto first = std::make_shared<RunLengthCodec>();
+    const auto second = std::make_shared<RunLengthCodec>();
+    const PayloadCodecs codecs({ { "a/#", first }, { "#", second } });
+
+    EXPECT_EQ(codecs.findForTopic("a/b"), first.get());
+    EXPECT_EQ(codecs.findForTopic("b"), second.get());
+    EXPECT_EQ(codecs.findByName("rle"), first.get());
+    EXPECT_EQ(codecs.findByName("zstd"), nullptr);
+    EXPECT_TRUE(PayloadCodecs{}.isEmpty());
+}
+
+TEST(PayloadCodecsTest, ShrunkPayloadIsSentWithTheCodecProperty)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<CapturingSocket>(settings);
+    ctx.setSocket(sock);
+
+    const auto sent = publishAndCapture(ctx, *sock, "sensors/t", Message::Payload(64, 0x42));
+    serialize::ByteReader reader(sent);
+    const auto header = packets::FixedHeader::create(reader);
+    const packets::Publish5 decoded(reader, header);
+    ASSERT_TRUE(decoded.isValid());
+    EXPECT_EQ(decoded.getPayloadCodec(), "rle");
+    EXPECT_EQ(decoded.getPayload(), (std::vector<std::uint8_t>{ 64, 0x42 }));
+
+    // The retransmit carries the same encoded payload and property.
+    sock->sent.clear();
+    ctx.retransmitPendingPublishes();
+    serialize::ByteReader retransmitReader(sock->sent);
+    const auto retransmitHeader = packets::FixedHeader::create(retransmitReader);
+    const packets::Publish5 retransmit(retransmitReader, retransmitHeader);
+    ASSERT_TRUE(retransmit.isValid());
+    EXPECT_TRUE(retransmit.getIsDuplicate());
+    EXPECT_EQ(retransmit.getPayloadCodec(), "rle");
+    EXPECT_EQ(retransmit.getPayload(), (std::vector<std::uint8_t>{ 64, 0x42 }));
+}
+
+TEST(PayloadCodecsTest, PayloadsThatDoNotShrinkOrDoNotMatchAreSentAsTheyAre)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<CapturingSocket>(settings);
+    ctx.setSocket(sock);
+
+    for (const std::string topic : { "sensors/t", "other/t" })
+    {
+        const Message::Payload payload = topic == "other/t" ? Message::Payload(64, 0x42) : Message::Payload{ 1, 2, 3, 4 };
+        const auto sent = publishAndCapture(ctx, *sock, topic, payload);
+        serialize::ByteReader reader(sent);
+        const auto header = packets::FixedHeader::create(reader);
+        const packets::Publish5 decoded(reader, header);
+        ASSERT_TRUE(decoded.isValid());
+        EXPECT_TRUE(decoded.getPayloadCodec().empty()) << topic;
+        EXPECT_EQ(decoded.getPayload(), payload) << topic;
+    }
+}
+
+TEST(PayloadCodecsTest, ReceivedPayloadIsDecodedOnBothDeliveryPaths)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.setSocket(std::make_shared<CapturingSocket>(settings));
+    const auto frame = encodeCodecPublish("rle", { 3, 'a', 2, 'b' });
+    const std::vector<std::uint8_t> expected{ 'a', 'a', 'a', 'b', 'b' };
+
+    std::vector<std::uint8_t> owned;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { owned = message.getPayload(); });
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(owned, expected);
+
+    std::vector<std::uint8_t> viewed;
+    auto viewHandle = ctx.getOnMessageView().add(
+        [&](const MessageView& view)
+        {
+            viewed.assign(view.getPayload().begin(), view.getPayload().end());
+        });
+    ASSERT_TRUE(ctx.shouldDecodePublishViews());
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(viewed, expected);
+}
+
+TEST(PayloadCodecsTest, UndecodablePayloadIsAcknowledgedAndDropped)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<CapturingSocket>(settings);
+    ctx.setSocket(sock);
+    const auto frame = encodeCodecPublish("rle", { 3 });
+
+    int delivered = 0;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message&) { ++delivered; });
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(delivered, 0);
+    EXPECT_FALSE(ctx.hasIncomingPacketId(7));
+    const std::vector<std::byte> pubAck{ std::byte{ 0x40 }, std::byte{ 0x02 }, std::byte{ 0x00 }, std::byte{ 0x07 } };
+    EXPECT_EQ(sock->sent, pubAck);
+}
+
+TEST(PayloadCodecsTest, UnknownCodecNameIsDeliveredAsReceived)
+{
+    const auto settings = makeSettings();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ctx.setSocket(std::make_shared<CapturingSocket>(settings));
+    const auto frame = encodeCodecPublish("zstd", { 3, 'a' });
+
+    std::vector<std::uint8_t> owned;
+    auto messageHandle = ctx.getOnMessage().add([&](const Message& message) { owned = message.getPayload(); });
+    ReadyState state;
+    (void)state.onDataReceived(ctx, frame.data(), static_cast<std::uint32_t>(frame.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(owned, (std::vector<std::uint8_t>{ 3, 'a' }));
+}
+
+#if REACTORMQ_WITH_ZLIB
+TEST(PayloadCodecsTest, DeflateCodecRoundTripsAndEnforcesTheLimit)
+{
+    const PayloadCodecPtr codec = createDeflatePayloadCodec();
+    ASSERT_NE(codec, nullptr);
+    EXPECT_EQ(codec->getName(), "deflate");
+
+    const std::vector<std::uint8_t> payload(10000, 'x');
+    std::vector<std::uint8_t> encoded;
+    ASSERT_TRUE(codec->encode(payload, encoded));
+    EXPECT_LT(encoded.size(), payload.size());
+
+    std::vector<std::uint8_t> decoded;
+    ASSERT_TRUE(codec->decode(encoded, payload.size(), decoded));
+    EXPECT_EQ(decoded, payload);
+    EXPECT_FALSE(codec->decode(encoded, payload.size() - 1, decoded));
+}
+#else
+TEST(PayloadCodecsTest, DeflateCodecNeedsZlib)
+{
+    EXPECT_EQ(createDeflatePayloadCodec(), nullptr);
+}
+#endif // REACTORMQ_WITH_ZLIB
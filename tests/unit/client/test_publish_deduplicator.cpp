@@ -0,0 +1,107 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/payload_hash.h"
+#include "mqtt/client/publish_deduplicator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    using Clock = PublishDeduplicator::Clock;
+
+    std::uint64_t hashText(const std::string_view text)
+    {
+        return hashPayload(std::span(reinterpret_cast<const std::uint8_t*>(text.data()), text.size()));
+    }
+
+    Message makeMessage(const std::string& topic, const std::string_view payload, const bool shouldRetain = true)
+    {
+        return Message(topic, Message::Payload(payload.begin(), payload.end()), shouldRetain, QualityOfService::AtLeastOnce);
+    }
+
+    PublishDedupOptions makeOptions(const std::uint32_t refreshIntervalMs = 1000)
+    {
+        PublishDedupOptions options;
+        options.isEnabled = true;
+        options.refreshIntervalMs = refreshIntervalMs;
+        return options;
+    }
+
+    /// Check a publish and record it as sent unless it was suppressed; true if it would have been sent.
+    bool send(PublishDeduplicator& deduplicator, const Message& message, const Clock::time_point now)
+    {
+        const auto hash = deduplicator.check(message, now);
+        if (hash.has_value())
+        {
+            deduplicator.record(message, *hash, now);
+        }
+        return hash.has_value();
+    }
+} // namespace
+
+TEST(PayloadHashTest, MatchesReferenceXxh64)
+{
+    EXPECT_EQ(hashText(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashText("a"), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(hashText("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashText("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(PublishDeduplicatorTest, UnchangedRetainedPayloadIsSuppressedUntilTheRefresh)
+{
+    PublishDeduplicator deduplicator(makeOptions(1000));
+    const auto start = Clock::now();
+
+    EXPECT_TRUE(send(deduplicator, makeMessage("state/a", "on"), start));
+    EXPECT_FALSE(send(deduplicator, makeMessage("state/a", "on"), start + std::chrono::milliseconds(500)));
+    EXPECT_TRUE(send(deduplicator, makeMessage("state/b", "on"), start + std::chrono::milliseconds(500)));
+    EXPECT_TRUE(send(deduplicator, makeMessage("state/a", "off"), start + std::chrono::milliseconds(600)));
+    EXPECT_FALSE(send(deduplicator, makeMessage("state/a", "off"), start + std::chrono::milliseconds(1500)));
+
+    // The refresh counts from the last publish that went out.
+    EXPECT_TRUE(send(deduplicator, makeMessage("state/a", "off"), start + std::chrono::milliseconds(1600)));
+}
+
+TEST(PublishDeduplicatorTest, OnlyRetainedPublishesAreComparedByDefault)
+{
+    PublishDeduplicator deduplicator(makeOptions());
+    const auto now = Clock::now();
+
+    EXPECT_TRUE(send(deduplicator, makeMessage("events", "tick", false), now));
+    EXPECT_TRUE(send(deduplicator, makeMessage("events", "tick", false), now));
+    EXPECT_EQ(deduplicator.size(), 0u);
+
+    PublishDedupOptions everything = makeOptions();
+    everything.isRetainedOnly = false;
+    PublishDeduplicator strict(everything);
+    EXPECT_TRUE(send(strict, makeMessage("events", "tick", false), now));
+    EXPECT_FALSE(send(strict, makeMessage("events", "tick", false), now));
+    EXPECT_TRUE(send(strict, makeMessage("events", "tick", true), now));
+}
+
+TEST(PublishDeduplicatorTest, ClearSendsEveryTopicAgainAndTheMapIsBounded)
+{
+    PublishDedupOptions options = makeOptions(0);
+    options.maxTopics = 2;
+    PublishDeduplicator deduplicator(options);
+    const auto now = Clock::now();
+
+    EXPECT_TRUE(send(deduplicator, makeMessage("a", "1"), now));
+    EXPECT_FALSE(send(deduplicator, makeMessage("a", "1"), now + std::chrono::hours(1)));
+    deduplicator.clear();
+    EXPECT_TRUE(send(deduplicator, makeMessage("a", "1"), now));
+
+    EXPECT_TRUE(send(deduplicator, makeMessage("b", "1"), now));
+    EXPECT_TRUE(send(deduplicator, makeMessage("c", "1"), now));
+    EXPECT_LE(deduplicator.size(), 2u);
+}
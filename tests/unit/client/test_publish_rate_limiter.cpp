@@ -0,0 +1,145 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/publish_rate_limiter.h"
+
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    using Clock = PublishRateLimiter::Clock;
+    using Verdict = PublishRateLimiter::Verdict;
+
+    struct Publish
+    {
+        PublishCommand command;
+        std::future<Result<void>> future;
+    };
+
+    Publish makePublish(const std::string& topic, const std::uint8_t value = 0, const size_t payloadSize = 1)
+    {
+        std::promise<Result<void>> promise;
+        auto future = promise.get_future();
+        return { PublishCommand{ Message{ topic, Message::Payload(payloadSize, value), false, QualityOfService::AtMostOnce },
+                                 std::move(promise) },
+                 std::move(future) };
+    }
+
+    PublishRateLimit makeLimit(
+        std::string prefix,
+        const std::uint32_t messagesPerSecond,
+        const std::uint32_t bytesPerSecond = 0,
+        const RateLimitAction action = RateLimitAction::CoalesceLatest)
+    {
+        PublishRateLimit limit;
+        limit.topicPrefix = std::move(prefix);
+        limit.messagesPerSecond = messagesPerSecond;
+        limit.bytesPerSecond = bytesPerSecond;
+        limit.action = action;
+        return limit;
+    }
+
+    bool hasFailed(std::future<Result<void>>& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !future.get().hasSucceeded();
+    }
+} // namespace
+
+TEST(PublishRateLimiterTest, HoldsPublishesOverTheRateUntilTheBucketRefills)
+{
+    PublishRateLimiter limiter({ makeLimit("", 2) }, 100);
+    const auto start = Clock::now();
+
+    auto first = makePublish("a");
+    auto second = makePublish("b");
+    auto third = makePublish("c");
+    EXPECT_EQ(limiter.admit(first.command, start), Verdict::Send);
+    EXPECT_EQ(limiter.admit(second.command, start), Verdict::Send);
+    EXPECT_EQ(limiter.admit(third.command, start), Verdict::Held);
+    EXPECT_EQ(limiter.getHeldCount(), 1u);
+
+    const auto release = limiter.getNextRelease(start);
+    ASSERT_TRUE(release.has_value());
+    EXPECT_EQ(*release - start, std::chrono::milliseconds(500));
+    EXPECT_FALSE(limiter.takeReleasable(start + std::chrono::milliseconds(400)).has_value());
+
+    const auto released = limiter.takeReleasable(*release);
+    ASSERT_TRUE(released.has_value());
+    EXPECT_EQ(released->message.getTopic(), "c");
+    EXPECT_FALSE(limiter.getNextRelease(*release).has_value());
+}
+
+TEST(PublishRateLimiterTest, NewerPublishReplacesTheHeldOneOnItsTopic)
+{
+    PublishRateLimiter limiter({ makeLimit("sensors/", 1) }, 100);
+    const auto now = Clock::now();
+
+    auto sent = makePublish("sensors/t", 1);
+    auto stale = makePublish("sensors/t", 2);
+    auto latest = makePublish("sensors/t", 3);
+    EXPECT_EQ(limiter.admit(sent.command, now), Verdict::Send);
+    EXPECT_EQ(limiter.admit(stale.command, now), Verdict::Held);
+    EXPECT_EQ(limiter.admit(latest.command, now), Verdict::Replaced);
+
+    EXPECT_TRUE(hasFailed(stale.future));
+    EXPECT_EQ(limiter.getHeldCount(), 1u);
+    const auto released = limiter.takeReleasable(now + std::chrono::seconds(1));
+    ASSERT_TRUE(released.has_value());
+    EXPECT_EQ(released->message.getPayloadView()[0], 3);
+}
+
+TEST(PublishRateLimiterTest, RejectFailsPublishesOverTheRate)
+{
+    PublishRateLimiter limiter({ makeLimit("", 1, 0, RateLimitAction::Reject) }, 100);
+    const auto now = Clock::now();
+
+    auto first = makePublish("a");
+    auto second = makePublish("a");
+    EXPECT_EQ(limiter.admit(first.command, now), Verdict::Send);
+    EXPECT_EQ(limiter.admit(second.command, now), Verdict::Rejected);
+    EXPECT_TRUE(hasFailed(second.future));
+    EXPECT_EQ(limiter.getHeldCount(), 0u);
+}
+
+TEST(PublishRateLimiterTest, PrefixLimitsOnlyCoverTheirTopicsAndTheClientLimitCoversAll)
+{
+    PublishRateLimiter limiter({ makeLimit("", 3), makeLimit("noisy/", 1), makeLimit("noisy/very/", 0, 4) }, 100);
+    const auto now = Clock::now();
+
+    auto noisy = makePublish("noisy/a");
+    auto noisyAgain = makePublish("noisy/b");
+    auto quiet = makePublish("quiet/a");
+    auto veryNoisy = makePublish("noisy/very/x", 0, 8);
+    auto overClient = makePublish("quiet/b");
+    EXPECT_EQ(limiter.admit(noisy.command, now), Verdict::Send);
+    EXPECT_EQ(limiter.admit(noisyAgain.command, now), Verdict::Held);
+    EXPECT_EQ(limiter.admit(quiet.command, now), Verdict::Send);
+
+    // The longest prefix governs: a byte limit with no count limit, and the publish is larger than its burst.
+    EXPECT_EQ(limiter.admit(veryNoisy.command, now), Verdict::Send);
+    EXPECT_EQ(limiter.admit(overClient.command, now), Verdict::Held);
+}
+
+TEST(PublishRateLimiterTest, HeldPublishesAreBounded)
+{
+    PublishRateLimiter limiter({ makeLimit("", 1) }, 1);
+    const auto now = Clock::now();
+
+    std::vector<Publish> publishes;
+    for (const char* topic : { "a", "b", "c" })
+    {
+        publishes.push_back(makePublish(topic));
+    }
+    EXPECT_EQ(limiter.admit(publishes[0].command, now), Verdict::Send);
+    EXPECT_EQ(limiter.admit(publishes[1].command, now), Verdict::Held);
+    EXPECT_EQ(limiter.admit(publishes[2].command, now), Verdict::Rejected);
+    EXPECT_TRUE(hasFailed(publishes[2].future));
+}
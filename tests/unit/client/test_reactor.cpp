@@ -6,13 +6,29 @@
 
 #include "mqtt/client/command.h"
 #include "mqtt/client/reactor.h"
+#include "mqtt/packets/auth.h"
 #include "mqtt/packets/conn_ack.h"
+#include "mqtt/packets/fixed_header.h"
+#include "mqtt/packets/publish.h"
+#include "mqtt/packets/sub_ack.h"
+#include "mqtt/packets/unsub_ack.h"
+#include "reactormq/mqtt/payload_sink.h"
 #include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/credentials_provider.h"
 #include "serialize/bytes.h"
 #include "socket/socket.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <future>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace reactormq;
 using namespace reactormq::mqtt;
@@ -49,9 +65,9 @@ namespace
             return isConnectedFlag;
         }
 
-        void send(const uint8_t* /*data*/, uint32_t /*size*/) override
+        void send(const uint8_t* data, const uint32_t size) override
         {
-            /* no-op for tests */
+            sent.insert(sent.end(), data, data + size);
         }
 
         OnConnectCallback& getOnConnectCallback() override
@@ -71,9 +87,23 @@ namespace
 
         void tick() override
         {
-            /* no-op */
+            for (const auto& packet : std::exchange(queued, {}))
+            {
+                receive(InboundFrame::fromBytes(packet));
+            }
         }
 
+        /// Deliver one packet the way the framing does, as a batch.
+        void receive(const InboundFrame& frame)
+        {
+            size_t handled = 1;
+            getOnDataReceivedBatchCallback().broadcast(std::span{ &frame, 1 }, handled);
+        }
+
+        std::vector<uint8_t> sent;
+        /// Packets the next tick() reads, as the socket read phase does.
+        std::vector<std::vector<uint8_t>> queued;
+
     private:
         bool isConnectedFlag = false;
         OnConnectCallback onConnect;
@@ -81,6 +111,30 @@ namespace
         OnDataReceivedCallback onData;
     };
 
+    /// Enhanced auth whose data is a new token every time it is asked for.
+    class RotatingTokenProvider final : public ICredentialsProvider
+    {
+    public:
+        Credentials getCredentials() override
+        {
+            return {};
+        }
+
+        std::string getAuthMethod() override
+        {
+            return "token";
+        }
+
+        std::vector<uint8_t> getInitialAuthData() override
+        {
+            const std::string token = "token-" + std::to_string(++m_issued);
+            return { token.begin(), token.end() };
+        }
+
+    private:
+        int m_issued = 0;
+    };
+
     ConnectionSettingsPtr makeSettings()
     {
         ConnectionSettingsBuilder b;
@@ -159,8 +213,1124 @@ TEST(ReactorTest, IsConnectedTrueOnlyInReadyState)
     const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
     ack.encode(w);
 
-    fake->getOnDataReceivedCallback().broadcast(reinterpret_cast<const uint8_t*>(buf.data()), static_cast<uint32_t>(buf.size()));
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
 
     EXPECT_TRUE(r->isConnected());
     EXPECT_STREQ(r->getCurrentStateName(), "Ready");
-}
\ No newline at end of file
+}
+
+TEST(ReactorTest, StateCanBePolledFromAnotherThread)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    // Stands in for a UI thread polling every frame while the reactor thread connects.
+    std::atomic<bool> sawConnecting{ false };
+    std::atomic<bool> sawReady{ false };
+    std::thread poller(
+        [&]
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!r->isConnected() && std::chrono::steady_clock::now() < deadline)
+            {
+                sawConnecting = sawConnecting || r->getStateId() == StateId::Connecting;
+            }
+            sawReady = r->isConnected();
+        });
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+
+    poller.join();
+    EXPECT_TRUE(sawConnecting);
+    EXPECT_TRUE(sawReady);
+    EXPECT_EQ(r->getStateId(), StateId::Ready);
+}
+
+TEST(ReactorTest, MetricsCountConnectionsParseFailuresAndTicks)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+
+    constexpr std::array<uint8_t, 2> reservedType{ 0x00, 0x00 };
+    fake->receive(InboundFrame::fromBytes(reservedType));
+    r->tick();
+
+    const ClientMetrics metrics = r->getMetrics();
+    EXPECT_EQ(metrics.connectAttempts, 1u);
+    EXPECT_EQ(metrics.connections, 1u);
+    EXPECT_EQ(metrics.disconnects, 0u);
+    EXPECT_EQ(metrics.parseFailures, 1u);
+    EXPECT_EQ(metrics.commandQueueDepth, 0u);
+
+    std::uint64_t ticks = 0;
+    for (const std::uint64_t count : metrics.tickDurationsUs)
+    {
+        ticks += count;
+    }
+    EXPECT_EQ(ticks, 2u);
+}
+
+TEST(ReactorTest, MetricsRecordPublishLatencyByQosUntilThePubAck)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    r->enqueueCommand(PublishCommand{ Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtMostOnce }, {} });
+    std::promise<Result<void>> published;
+    auto future = published.get_future();
+    r->enqueueCommand(
+        PublishCommand{ Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, std::move(published) });
+    r->tick();
+
+    ClientMetrics metrics = r->getMetrics();
+    EXPECT_EQ(metrics.publishLatency[0].queued.count, 1u);
+    EXPECT_EQ(metrics.publishLatency[0].total.count, 1u);
+    EXPECT_EQ(metrics.publishLatency[0].acknowledged.count, 0u);
+    EXPECT_EQ(metrics.publishLatency[1].queued.count, 1u);
+    EXPECT_EQ(metrics.publishLatency[1].total.count, 0u);
+
+    constexpr std::array<uint8_t, 4> pubAck{ 0x40, 0x02, 0x00, 0x01 };
+    fake->receive(InboundFrame::fromBytes(pubAck));
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+    metrics = r->getMetrics();
+    EXPECT_EQ(metrics.publishLatency[1].acknowledged.count, 1u);
+    EXPECT_EQ(metrics.publishLatency[1].total.count, 1u);
+    EXPECT_GE(metrics.publishLatency[1].total.sumUs, metrics.publishLatency[1].queued.sumUs);
+    EXPECT_EQ(metrics.publishLatency[2].total.count, 0u);
+}
+
+TEST(ReactorTest, StreamedPublishSendsTheHeaderThenTheSourcePayload)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    std::promise<Result<void>> published;
+    auto future = published.get_future();
+    PublishCommand streamed{ Message{ "a/b", SharedPayload{}, false, QualityOfService::AtMostOnce }, std::move(published) };
+    streamed.stream = createPayloadSource(SharedPayload::copyOf(std::array<uint8_t, 5>{ 1, 2, 3, 4, 5 }));
+    r->enqueueCommand(std::move(streamed));
+    r->tick();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(future.get().hasSucceeded());
+    EXPECT_EQ(fake->sent, (std::vector<uint8_t>{ 0x30, 11, 0x00, 0x03, 'a', '/', 'b', 0x00, 1, 2, 3, 4, 5 }));
+}
+
+TEST(ReactorTest, StreamedPublishTooLargeForOnePacketFails)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    std::promise<Result<void>> published;
+    auto future = published.get_future();
+    PublishCommand streamed{ Message{ "a/b", SharedPayload{}, false, QualityOfService::AtMostOnce }, std::move(published) };
+    streamed.stream = createPayloadSource(size_t{ 268435455 }, [](std::span<uint8_t> out) { return out.size(); });
+    r->enqueueCommand(std::move(streamed));
+    r->tick();
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(future.get().hasSucceeded());
+    EXPECT_TRUE(fake->sent.empty());
+}
+
+TEST(ReactorTest, FragmentedPublishIsStreamedToTheSubscriptionSinkAndAcknowledged)
+{
+    class RecordingSink final : public IPayloadSink
+    {
+    public:
+        void onBegin(const MessageView& header, const size_t size) override
+        {
+            topic = header.getTopic();
+            payloadSize = size;
+        }
+
+        void onChunk(const std::span<const std::uint8_t> chunk) override
+        {
+            payload.insert(payload.end(), chunk.begin(), chunk.end());
+            ++chunks;
+        }
+
+        void onEnd(const bool isComplete) override
+        {
+            ended = isComplete ? 1 : -1;
+        }
+
+        std::string topic;
+        size_t payloadSize = 0;
+        std::vector<uint8_t> payload;
+        int chunks = 0;
+        int ended = 0;
+    };
+
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    const auto sink = std::make_shared<RecordingSink>();
+    r->enqueueCommand(SubscribeCommand{ TopicFilter{ "a/+", QualityOfService::AtLeastOnce }, {}, nullptr, sink });
+    r->tick();
+    fake->sent.clear();
+
+    // QoS 1 PUBLISH to a/b, packet ID 7, no properties, payload 1..5; cut inside the header and inside the payload.
+    constexpr std::array<uint8_t, 15> publish{ 0x32, 13, 0x00, 0x03, 'a', '/', 'b', 0x00, 0x07, 0x00, 1, 2, 3, 4, 5 };
+    for (const auto [offset, size] : { std::pair{ 0u, 4u }, std::pair{ 4u, 8u }, std::pair{ 12u, 3u } })
+    {
+        InboundFrame fragment{ std::span{ publish }.subspan(offset, size), 0x32, 13, 2, true, offset };
+        fake->receive(fragment);
+    }
+
+    EXPECT_EQ(sink->topic, "a/b");
+    EXPECT_EQ(sink->payloadSize, 5u);
+    EXPECT_EQ(sink->payload, (std::vector<uint8_t>{ 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(sink->chunks, 2);
+    EXPECT_EQ(sink->ended, 1);
+    EXPECT_EQ(fake->sent, (std::vector<uint8_t>{ 0x40, 0x02, 0x00, 0x07 }));
+}
+
+TEST(ReactorTest, ChunkedTransferKeepsAWindowOfChunksInFlightAndIsReassembledByTheSubscriber)
+{
+    class RecordingSink final : public IPayloadSink
+    {
+    public:
+        void onBegin(const MessageView& /*header*/, const size_t size) override
+        {
+            payloadSize = size;
+        }
+
+        void onChunk(const std::span<const std::uint8_t> chunk) override
+        {
+            payload.insert(payload.end(), chunk.begin(), chunk.end());
+        }
+
+        void onEnd(const bool isComplete) override
+        {
+            ended = isComplete ? 1 : -1;
+        }
+
+        size_t payloadSize = 0;
+        std::vector<uint8_t> payload;
+        int ended = 0;
+    };
+
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    const auto sink = std::make_shared<RecordingSink>();
+    SubscribeCommand subscribe{ TopicFilter{ "f", QualityOfService::AtLeastOnce }, {}, nullptr, sink };
+    subscribe.isChunked = true;
+    r->enqueueCommand(std::move(subscribe));
+    r->tick();
+    fake->sent.clear();
+
+    const auto publishChunked = [&r](const std::uint32_t chunkSize)
+    {
+        std::promise<Result<void>> published;
+        auto future = published.get_future();
+        auto transfer = std::make_shared<ChunkedTransfer>();
+        transfer->topic = "f";
+        transfer->source = createPayloadSource(SharedPayload::copyOf(std::array<uint8_t, 10>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+        transfer->options = ChunkedTransferOptions{ chunkSize, 2, QualityOfService::AtLeastOnce };
+        transfer->promise = std::move(published);
+        r->enqueueCommand(PublishChunkedCommand{ std::move(transfer) });
+        r->tick();
+        return future;
+    };
+    // Too small a Maximum Packet Size for the chunk header fails the transfer before anything is sent.
+    r->getContext().setBrokerMaximumPacketSize(64);
+    auto tooLarge = publishChunked(4);
+    ASSERT_EQ(tooLarge.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(tooLarge.get().getError(), ResultError::PacketTooLarge);
+    EXPECT_TRUE(fake->sent.empty());
+
+    // Ten bytes in chunks of four, two at a time: the third chunk waits for the first PUBACK.
+    r->getContext().setBrokerMaximumPacketSize(1024);
+    auto future = publishChunked(4);
+    const auto takePublishes = [&fake]
+    {
+        std::vector<std::vector<uint8_t>> packets;
+        for (size_t offset = 0; offset < fake->sent.size(); offset += 2 + fake->sent[offset + 1])
+        {
+            EXPECT_EQ(fake->sent[offset], 0x32);
+            const auto begin = fake->sent.begin() + static_cast<std::ptrdiff_t>(offset);
+            packets.emplace_back(begin, begin + 2 + fake->sent[offset + 1]);
+        }
+        fake->sent.clear();
+        return packets;
+    };
+    auto publishes = takePublishes();
+    ASSERT_EQ(publishes.size(), 2u);
+
+    constexpr std::array<uint8_t, 4> firstAck{ 0x40, 0x02, 0x00, 0x02 };
+    fake->receive(InboundFrame::fromBytes(firstAck));
+    EXPECT_TRUE(fake->sent.empty());
+    r->tick();
+    auto third = takePublishes();
+    ASSERT_EQ(third.size(), 1u);
+    publishes.push_back(std::move(third[0]));
+
+    for (const uint8_t packetId : { uint8_t{ 3 }, uint8_t{ 4 } })
+    {
+        EXPECT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        const std::array<uint8_t, 4> pubAck{ 0x40, 0x02, 0x00, packetId };
+        fake->receive(InboundFrame::fromBytes(pubAck));
+    }
+    r->tick();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(future.get().hasSucceeded());
+    EXPECT_TRUE(fake->sent.empty());
+
+    // The broker echoes the chunks to the subscription, the first one twice.
+    publishes.insert(publishes.begin() + 1, publishes[0]);
+    for (const auto& publish : publishes)
+    {
+        fake->receive(InboundFrame::fromBytes(publish));
+    }
+    EXPECT_EQ(sink->payloadSize, 10u);
+    EXPECT_EQ(sink->payload, (std::vector<uint8_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_EQ(sink->ended, 1);
+}
+
+TEST(ReactorTest, HigherPriorityTopicsAreDeliveredFirstWithinTheInboundBudget)
+{
+    ConnectionSettingsBuilder builder;
+    builder.setHost("localhost").setMaxInboundPacketsPerTick(2);
+    const auto settings = builder.build();
+    auto r = std::make_shared<Reactor>(settings);
+    const auto fake = std::make_shared<FakeSocket>(settings);
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    std::vector<uint16_t> delivered;
+    const auto record = [&delivered](const Message& message)
+    {
+        delivered.push_back(static_cast<uint16_t>(message.getPayload()[0]));
+    };
+    TopicFilter critical{ "critical", QualityOfService::AtLeastOnce };
+    critical.setDeliveryPriority(5);
+    r->enqueueCommand(SubscribeCommand{ TopicFilter{ "bulk/#", QualityOfService::AtLeastOnce }, {}, record });
+    r->enqueueCommand(SubscribeCommand{ critical, {}, record });
+    r->tick();
+    fake->sent.clear();
+
+    // A QoS 1 PUBLISH whose one-byte payload is its packet ID, read on the next tick.
+    const auto queuePublish = [&fake](const std::string& topic, const uint8_t packetId)
+    {
+        std::vector<uint8_t> publish{ 0x32, static_cast<uint8_t>(topic.size() + 6), 0x00, static_cast<uint8_t>(topic.size()) };
+        publish.insert(publish.end(), topic.begin(), topic.end());
+        publish.insert(publish.end(), { 0x00, packetId, 0x00, packetId });
+        fake->queued.push_back(std::move(publish));
+    };
+    const auto takePubAcks = [&fake]
+    {
+        std::vector<uint16_t> packetIds;
+        for (size_t offset = 0; offset + 4 <= fake->sent.size(); offset += 4)
+        {
+            EXPECT_EQ(fake->sent[offset], 0x40);
+            packetIds.push_back(fake->sent[offset + 3]);
+        }
+        fake->sent.clear();
+        return packetIds;
+    };
+
+    // Two deliveries a tick: the rest wait, unacknowledged, and the critical message goes first once budget frees up.
+    for (const uint8_t packetId : { uint8_t{ 1 }, uint8_t{ 2 }, uint8_t{ 3 }, uint8_t{ 4 } })
+    {
+        queuePublish("bulk/a", packetId);
+    }
+    queuePublish("critical", 5);
+    r->tick();
+    EXPECT_EQ(delivered, (std::vector<uint16_t>{ 1, 2 }));
+    EXPECT_EQ(takePubAcks(), (std::vector<uint16_t>{ 1, 2 }));
+    EXPECT_TRUE(r->hasCompletedDeliveries());
+
+    r->tick();
+    EXPECT_EQ(delivered, (std::vector<uint16_t>{ 1, 2, 5, 3 }));
+    EXPECT_EQ(takePubAcks(), (std::vector<uint16_t>{ 5, 3 }));
+
+    // A critical message arriving behind waiting bulk ones goes straight ahead of them; a bulk one waits its turn.
+    queuePublish("bulk/a", 6);
+    queuePublish("critical", 7);
+    r->tick();
+    EXPECT_EQ(delivered, (std::vector<uint16_t>{ 1, 2, 5, 3, 7, 4 }));
+    r->tick();
+    EXPECT_EQ(delivered, (std::vector<uint16_t>{ 1, 2, 5, 3, 7, 4, 6 }));
+    EXPECT_EQ(takePubAcks(), (std::vector<uint16_t>{ 7, 4, 6 }));
+    EXPECT_FALSE(r->hasCompletedDeliveries());
+}
+
+TEST(ReactorTest, SubscribeOverTheBrokerMaximumPacketSizeIsSplitIntoSeveralPackets)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    using namespace reactormq::mqtt::packets::properties;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(
+        true,
+        ReasonCode::Success,
+        Properties{ { Property::create<PropertyIdentifier::MaximumPacketSize, uint32_t>(30) } });
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    // Each "t/N" filter takes 6 bytes, so a 30-byte SUBSCRIBE (2 fixed header + 3 packet ID and properties) holds 4.
+    std::vector<TopicFilter> filters;
+    for (int i = 0; i < 9; ++i)
+    {
+        filters.emplace_back("t/" + std::to_string(i), QualityOfService::AtLeastOnce);
+    }
+    std::promise<Result<std::vector<SubscribeResult>>> subscribed;
+    auto future = subscribed.get_future();
+    r->enqueueCommand(SubscribesCommand{ filters, std::move(subscribed) });
+    r->tick();
+
+    std::vector<std::pair<uint16_t, size_t>> packets;
+    for (size_t offset = 0; offset < fake->sent.size(); offset += 2 + fake->sent[offset + 1])
+    {
+        ASSERT_EQ(fake->sent[offset], 0x82);
+        ASSERT_LE(2u + fake->sent[offset + 1], 30u);
+        const auto packetId = static_cast<uint16_t>(fake->sent[offset + 2] << 8 | fake->sent[offset + 3]);
+        packets.emplace_back(packetId, (fake->sent[offset + 1] - 3u) / 6u);
+    }
+    ASSERT_EQ(packets.size(), 3u);
+    EXPECT_EQ(packets[0].second, 4u);
+    EXPECT_EQ(packets[1].second, 4u);
+    EXPECT_EQ(packets[2].second, 1u);
+
+    // Acknowledge out of order, refusing the last filter of the first packet.
+    for (const size_t index : { size_t{ 2 }, size_t{ 0 }, size_t{ 1 } })
+    {
+        std::vector<ReasonCode> codes(packets[index].second, ReasonCode::GrantedQualityOfService1);
+        if (index == 0)
+        {
+            codes.back() = ReasonCode::NotAuthorized;
+        }
+        ASSERT_NE(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+        buf.clear();
+        const SubAck<ProtocolVersion::V5> subAck(packets[index].first, std::move(codes));
+        subAck.encode(w);
+        fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    }
+
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    const auto result = future.get();
+    ASSERT_TRUE(result.hasSucceeded());
+    const auto& results = *result.getResult();
+    ASSERT_EQ(results.size(), filters.size());
+    for (size_t i = 0; i < filters.size(); ++i)
+    {
+        EXPECT_EQ(results[i].getFilter().getFilter(), filters[i].getFilter());
+        EXPECT_EQ(results[i].wasSuccessful(), i != 3);
+    }
+}
+
+TEST(ReactorTest, ReconnectWithoutASessionResubscribesToTheGrantedFilters)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+
+    using namespace reactormq::mqtt::packets;
+    const auto receive = [&fake](const IControlPacket& packet)
+    {
+        std::vector<std::byte> buf;
+        serialize::ByteWriter w(buf);
+        packet.encode(w);
+        fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    };
+    const auto connect = [&r, &fake, &receive](const bool isSessionPresent)
+    {
+        r->getContext().setSocket(fake);
+        r->enqueueCommand(ConnectCommand{ true, std::promise<Result<void>>{} });
+        r->tick();
+        fake->getOnConnectCallback().broadcast(true);
+        fake->sent.clear();
+        receive(ConnAck<ProtocolVersion::V5>(isSessionPresent, ReasonCode::Success, properties::Properties{}));
+    };
+
+    connect(false);
+    ASSERT_TRUE(r->isConnected());
+    EXPECT_TRUE(fake->sent.empty());
+
+    r->enqueueCommand(SubscribesCommand{ { TopicFilter{ "a", QualityOfService::AtLeastOnce }, TopicFilter{ "b", QualityOfService::AtLeastOnce } }, {} });
+    r->tick();
+    const auto packetId = static_cast<uint16_t>(fake->sent[2] << 8 | fake->sent[3]);
+    receive(SubAck<ProtocolVersion::V5>(packetId, { ReasonCode::GrantedQualityOfService1, ReasonCode::NotAuthorized }));
+
+    r->enqueueCommand(DisconnectCommand{ std::promise<Result<void>>{} });
+    r->tick();
+    fake->getOnDisconnectCallback().broadcast();
+    ASSERT_FALSE(r->isConnected());
+
+    // No session on the broker: the granted filter is sent again, the refused one is not.
+    connect(false);
+    ASSERT_TRUE(r->isConnected());
+    ASSERT_GE(fake->sent.size(), 4u);
+    const std::vector<uint8_t> resubscribe(fake->sent.begin() + 4, fake->sent.end());
+    EXPECT_EQ(fake->sent[0], 0x82);
+    EXPECT_EQ(resubscribe, (std::vector<uint8_t>{ 0x00, 0x00, 0x01, 'a', 0x0D }));
+
+    r->enqueueCommand(DisconnectCommand{ std::promise<Result<void>>{} });
+    r->tick();
+    fake->getOnDisconnectCallback().broadcast();
+
+    // The broker kept the session, and the subscriptions with it.
+    connect(true);
+    ASSERT_TRUE(r->isConnected());
+    EXPECT_TRUE(fake->sent.empty());
+}
+
+TEST(ReactorTest, SetSubscriptionsSendsOnlyTheDifference)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+
+    using namespace reactormq::mqtt::packets;
+    const auto receive = [&fake](const IControlPacket& packet)
+    {
+        std::vector<std::byte> buf;
+        serialize::ByteWriter w(buf);
+        packet.encode(w);
+        fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    };
+
+    // Each packet sent since the last call, as its first byte, packet ID and topic filters.
+    struct SentPacket
+    {
+        uint8_t type = 0;
+        uint16_t packetId = 0;
+        std::vector<std::string> filters;
+    };
+    const auto takeSent = [&fake]
+    {
+        std::vector<SentPacket> packets;
+        for (size_t offset = 0; offset < fake->sent.size(); offset += 2 + fake->sent[offset + 1])
+        {
+            SentPacket packet{ fake->sent[offset], static_cast<uint16_t>(fake->sent[offset + 2] << 8 | fake->sent[offset + 3]), {} };
+            const size_t end = offset + 2 + fake->sent[offset + 1];
+            for (size_t at = offset + 5; at < end;)
+            {
+                const size_t length = static_cast<size_t>(fake->sent[at] << 8 | fake->sent[at + 1]);
+                const auto name = fake->sent.begin() + static_cast<std::ptrdiff_t>(at + 2);
+                packet.filters.emplace_back(name, name + static_cast<std::ptrdiff_t>(length));
+                at += 2 + length + (packet.type == 0x82 ? 1 : 0);
+            }
+            packets.push_back(std::move(packet));
+        }
+        fake->sent.clear();
+        return packets;
+    };
+    const auto setSubscriptions = [&r](std::vector<TopicFilter> filters)
+    {
+        std::promise<Result<std::vector<SubscribeResult>>> promise;
+        auto future = promise.get_future();
+        r->enqueueCommand(SetSubscriptionsCommand{ std::move(filters), std::move(promise) });
+        r->tick();
+        return future;
+    };
+
+    auto offline = setSubscriptions({ TopicFilter{ "a", QualityOfService::AtLeastOnce } });
+    ASSERT_EQ(offline.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(offline.get().getError(), ResultError::NotConnected);
+
+    r->getContext().setSocket(fake);
+    r->enqueueCommand(ConnectCommand{ true, std::promise<Result<void>>{} });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+    receive(ConnAck<ProtocolVersion::V5>(false, ReasonCode::Success, properties::Properties{}));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    auto first = setSubscriptions({ TopicFilter{ "a", QualityOfService::AtLeastOnce }, TopicFilter{ "b", QualityOfService::AtLeastOnce } });
+    auto packets = takeSent();
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(packets[0].type, 0x82);
+    EXPECT_EQ(packets[0].filters, (std::vector<std::string>{ "a", "b" }));
+    const uint16_t firstId = packets[0].packetId;
+
+    // Filters in flight count as subscribed, so only the new one goes out.
+    auto second = setSubscriptions({ TopicFilter{ "a", QualityOfService::AtLeastOnce },
+                                     TopicFilter{ "b", QualityOfService::AtLeastOnce },
+                                     TopicFilter{ "c", QualityOfService::AtLeastOnce } });
+    packets = takeSent();
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(packets[0].filters, (std::vector<std::string>{ "c" }));
+    receive(SubAck<ProtocolVersion::V5>(firstId, { ReasonCode::GrantedQualityOfService1, ReasonCode::GrantedQualityOfService1 }));
+    receive(SubAck<ProtocolVersion::V5>(packets[0].packetId, { ReasonCode::GrantedQualityOfService1 }));
+    ASSERT_EQ(first.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_EQ(second.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_TRUE(first.get().hasSucceeded());
+    const auto secondResult = second.get();
+    ASSERT_TRUE(secondResult.hasSucceeded());
+    ASSERT_EQ(secondResult.getResult()->size(), 1u);
+    EXPECT_EQ(secondResult.getResult()->front().getFilter().getFilter(), "c");
+
+    // The same set again sends nothing.
+    auto unchanged = setSubscriptions({ TopicFilter{ "c", QualityOfService::AtLeastOnce },
+                                        TopicFilter{ "b", QualityOfService::AtLeastOnce },
+                                        TopicFilter{ "a", QualityOfService::AtLeastOnce } });
+    EXPECT_TRUE(fake->sent.empty());
+    ASSERT_EQ(unchanged.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    const auto unchangedResult = unchanged.get();
+    ASSERT_TRUE(unchangedResult.hasSucceeded());
+    EXPECT_TRUE(unchangedResult.getResult()->empty());
+
+    // A changed QoS and a new filter share one SUBSCRIBE; the dropped filters share one UNSUBSCRIBE after it.
+    auto third = setSubscriptions({ TopicFilter{ "b", QualityOfService::ExactlyOnce }, TopicFilter{ "d", QualityOfService::AtLeastOnce } });
+    packets = takeSent();
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(packets[0].type, 0x82);
+    EXPECT_EQ(packets[0].filters, (std::vector<std::string>{ "b", "d" }));
+    EXPECT_EQ(packets[1].type, 0xA2);
+    std::ranges::sort(packets[1].filters);
+    EXPECT_EQ(packets[1].filters, (std::vector<std::string>{ "a", "c" }));
+
+    receive(SubAck<ProtocolVersion::V5>(
+        packets[0].packetId, { ReasonCode::GrantedQualityOfService2, ReasonCode::GrantedQualityOfService1 }));
+    ASSERT_NE(third.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    receive(UnsubAck<ProtocolVersion::V5>(packets[1].packetId, { ReasonCode::Success, ReasonCode::Success }));
+    ASSERT_EQ(third.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    ASSERT_TRUE(third.get().hasSucceeded());
+
+    std::vector<std::string> subscribed;
+    for (const TopicFilter& filter : r->getContext().getSubscriptionCache().getFilters())
+    {
+        subscribed.push_back(filter.getFilter());
+    }
+    std::ranges::sort(subscribed);
+    EXPECT_EQ(subscribed, (std::vector<std::string>{ "b", "d" }));
+}
+
+TEST(ReactorTest, LastValueCacheKeepsMessagesNoHandlerSubscribedTo)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setLastValueCacheSize(8);
+    auto r = std::make_shared<Reactor>(b.build());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    EXPECT_EQ(r->getLastValue("a/b"), nullptr);
+
+    // QoS 0 PUBLISHes to a/b, no properties, payloads 1 then 2.
+    for (const uint8_t value : { uint8_t{ 1 }, uint8_t{ 2 } })
+    {
+        const std::array<uint8_t, 9> publish{ 0x30, 7, 0x00, 0x03, 'a', '/', 'b', 0x00, value };
+        fake->receive(InboundFrame::fromBytes(publish));
+    }
+
+    const auto last = r->getLastValue("a/b");
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(last->getTopic(), "a/b");
+    EXPECT_EQ(last->getPayloadView().size(), 1u);
+    EXPECT_EQ(last->getPayloadView()[0], 2);
+}
+
+TEST(ReactorTest, RequestIsAnsweredOnTheSharedResponseTopicAndTimesOutWithoutAResponse)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    using namespace reactormq::mqtt::packets::properties;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    int broadcastCount = 0;
+    auto handle = r->getContext().getOnMessage().add(
+        [&broadcastCount](const Message&)
+        {
+            ++broadcastCount;
+        });
+
+    std::promise<Result<Message>> answered;
+    auto answer = answered.get_future();
+    r->enqueueCommand(RequestCommand{ "svc/echo", { 7 }, std::chrono::seconds(30), std::move(answered) });
+    r->tick();
+
+    // The response topic's SUBSCRIBE goes out first, then the request.
+    ASSERT_GE(fake->sent.size(), 2u);
+    ASSERT_EQ(fake->sent[0], 0x82);
+    const size_t offset = 2 + fake->sent[1];
+    ASSERT_LT(offset + 2, fake->sent.size());
+    ASSERT_EQ(fake->sent[offset], 0x30);
+
+    const auto* bytes = reinterpret_cast<const std::byte*>(fake->sent.data() + offset);
+    serialize::ByteReader headerReader(bytes, 2);
+    const FixedHeader header = FixedHeader::create(headerReader);
+    serialize::ByteReader bodyReader(bytes + 2, fake->sent.size() - offset - 2);
+    const Publish<ProtocolVersion::V5> request(bodyReader, header);
+    EXPECT_EQ(request.getTopicName(), "svc/echo");
+    ASSERT_EQ(request.getPayload(), (std::vector<uint8_t>{ 7 }));
+
+    std::string responseTopic;
+    for (const Property& property : request.getProperties().getProperties())
+    {
+        if (const auto* value = property.getValueIf<std::string>(); property.getIdentifier() == PropertyIdentifier::ResponseTopic && value)
+        {
+            responseTopic = *value;
+        }
+    }
+    ASSERT_FALSE(responseTopic.empty());
+    const std::vector<uint8_t> correlationData(request.getCorrelationData().begin(), request.getCorrelationData().end());
+    ASSERT_FALSE(correlationData.empty());
+
+    buf.clear();
+    const Publish<ProtocolVersion::V5> response(
+        responseTopic,
+        { 42 },
+        QualityOfService::AtMostOnce,
+        false,
+        0,
+        Properties{ { Property::create<PropertyIdentifier::CorrelationData>(correlationData) } },
+        false);
+    response.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+
+    ASSERT_EQ(answer.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    const auto result = answer.get();
+    ASSERT_TRUE(result.hasSucceeded());
+    EXPECT_EQ(result.getResult()->getTopic(), responseTopic);
+    EXPECT_EQ(result.getResult()->getPayload(), (std::vector<uint8_t>{ 42 }));
+    EXPECT_EQ(broadcastCount, 0);
+
+    // A second request reuses the subscription; with no response it fails once its timeout passes.
+    fake->sent.clear();
+    std::promise<Result<Message>> unanswered;
+    auto timeout = unanswered.get_future();
+    r->enqueueCommand(RequestCommand{ "svc/echo", { 8 }, std::chrono::milliseconds(0), std::move(unanswered) });
+    r->tick();
+    ASSERT_FALSE(fake->sent.empty());
+    EXPECT_EQ(fake->sent[0], 0x30);
+    r->tick();
+
+    ASSERT_EQ(timeout.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(timeout.get().hasSucceeded());
+    EXPECT_EQ(r->getContext().getRequests().size(), 0u);
+}
+
+TEST(ReactorTest, WaitAndTickWakesWhenCommandEnqueuedFromAnotherThread)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+
+    std::promise<Result<void>> p;
+    auto f = p.get_future();
+
+    std::thread producer(
+        [r, promise = std::move(p)]() mutable
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            r->enqueueCommand(DisconnectCommand{ std::move(promise) });
+        });
+
+    const auto start = std::chrono::steady_clock::now();
+    r->waitAndTick(std::chrono::seconds(5));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+    EXPECT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+}
+
+TEST(ReactorTest, WaitAndTickSleepsUntilMaxWaitWhenIdle)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+
+    const auto start = std::chrono::steady_clock::now();
+    r->waitAndTick(std::chrono::milliseconds(50));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(40));
+    EXPECT_STREQ(r->getCurrentStateName(), "Disconnected");
+}
+
+TEST(ReactorTest, WaitAndTickDoesNotBlockWhenCommandAlreadyQueued)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+
+    std::promise<Result<void>> p;
+    auto f = p.get_future();
+    r->enqueueCommand(DisconnectCommand{ std::move(p) });
+
+    const auto start = std::chrono::steady_clock::now();
+    r->waitAndTick(std::chrono::seconds(5));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+    EXPECT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+}
+
+TEST(ReactorTest, CommandQueueDepthTracksPendingCommands)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    EXPECT_EQ(r->getCommandQueueDepth(), 0u);
+
+    std::vector<std::future<Result<void>>> futures;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::promise<Result<void>> p;
+        futures.push_back(p.get_future());
+        r->enqueueCommand(DisconnectCommand{ std::move(p) });
+    }
+    EXPECT_EQ(r->getCommandQueueDepth(), 3u);
+
+    r->tick();
+    EXPECT_EQ(r->getCommandQueueDepth(), 0u);
+    for (auto& f : futures)
+    {
+        EXPECT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    }
+}
+TEST(ReactorTest, PublishBatchResolvesOnceEveryPublishHasCompleted)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+
+    std::vector<Message> messages;
+    for (int i = 0; i < 3; ++i)
+    {
+        messages.emplace_back("t", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce);
+    }
+
+    std::promise<Result<void>> p;
+    auto f = p.get_future();
+    r->enqueueCommand(PublishBatchCommand{ std::move(messages), std::move(p) });
+    EXPECT_EQ(r->getCommandQueueDepth(), 1u);
+    r->tick();
+
+    // The offline queue is disabled by default, so every publish of the batch fails while disconnected.
+    ASSERT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_FALSE(f.get().isSuccess());
+}
+
+TEST(ReactorTest, PublishBatchIsQueuedOfflinePublishByPublish)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost");
+    b.setMaxOfflinePublishes(8);
+    auto r = std::make_shared<Reactor>(b.build());
+
+    std::vector<Message> messages;
+    messages.emplace_back("a", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce);
+    messages.emplace_back("b", Message::Payload{ 2 }, false, QualityOfService::AtLeastOnce);
+
+    std::promise<Result<void>> p;
+    auto f = p.get_future();
+    r->enqueueCommand(PublishBatchCommand{ std::move(messages), std::move(p) });
+    r->tick();
+
+    EXPECT_EQ(r->getContext().getOfflinePublishes().size(), 2u);
+    EXPECT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+}
+
+TEST(ReactorTest, EmptyPublishBatchSucceeds)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+
+    std::promise<Result<void>> p;
+    auto f = p.get_future();
+    r->enqueueCommand(PublishBatchCommand{ {}, std::move(p) });
+    r->tick();
+
+    ASSERT_EQ(f.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_TRUE(f.get().isSuccess());
+}
+
+TEST(ReactorTest, CommandBudgetLeavesTheRestQueuedForLaterTicks)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost");
+    b.setMaxCommandsPerTick(2);
+    auto r = std::make_shared<Reactor>(b.build());
+
+    std::vector<std::future<Result<void>>> futures;
+    for (int i = 0; i < 5; ++i)
+    {
+        std::promise<Result<void>> p;
+        futures.push_back(p.get_future());
+        r->enqueueCommand(DisconnectCommand{ std::move(p) });
+    }
+
+    r->tick();
+    EXPECT_EQ(r->getCommandQueueDepth(), 3u);
+    EXPECT_EQ(futures[1].wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_EQ(futures[2].wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+
+    r->tick();
+    r->tick();
+    EXPECT_EQ(r->getCommandQueueDepth(), 0u);
+    EXPECT_EQ(futures[4].wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+}
+
+TEST(ReactorTest, ReauthenticatesWithAuthWhileStayingReady)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost");
+    b.setCredentialsProvider(std::make_shared<RotatingTokenProvider>());
+    b.setReauthenticateIntervalMs(1);
+    const auto settings = b.build();
+    auto r = std::make_shared<Reactor>(settings);
+    const auto fake = std::make_shared<FakeSocket>(settings);
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+    fake->sent.clear();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    r->tick();
+
+    // AUTH, Re-authenticate, carrying the method and the token CONNECT did not use.
+    ASSERT_GE(fake->sent.size(), 3u);
+    EXPECT_EQ(fake->sent[0], 0xF0);
+    EXPECT_EQ(fake->sent[2], static_cast<uint8_t>(ReasonCode::ReAuthenticate));
+    const std::string sent(fake->sent.begin(), fake->sent.end());
+    EXPECT_NE(sent.find("token"), std::string::npos);
+    EXPECT_NE(sent.find("token-2"), std::string::npos);
+
+    // A second interval passing while the broker has yet to answer starts nothing new.
+    fake->sent.clear();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    r->tick();
+    EXPECT_TRUE(fake->sent.empty());
+
+    buf.clear();
+    const Auth success(ReasonCode::Success);
+    success.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    EXPECT_TRUE(r->isConnected());
+    EXPECT_EQ(r->getMetrics().reauthentications, 1u);
+}
+
+TEST(ReactorTest, DrainingDisconnectWaitsForThePubAckBeforeSendingDisconnect)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    std::promise<Result<void>> published;
+    auto publishFuture = published.get_future();
+    r->enqueueCommand(
+        PublishCommand{ Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, std::move(published) });
+    std::promise<Result<void>> disconnected;
+    auto disconnectFuture = disconnected.get_future();
+    r->enqueueCommand(DisconnectCommand{ std::move(disconnected), DrainOptions{ true, 60000 } });
+    std::promise<Result<void>> late;
+    auto lateFuture = late.get_future();
+    r->enqueueCommand(PublishCommand{ Message{ "a/b", Message::Payload{ 2 }, false, QualityOfService::AtMostOnce }, std::move(late) });
+    fake->sent.clear();
+    r->tick();
+
+    // The PUBLISH went out, the publish made after the disconnect was refused, and no DISCONNECT yet.
+    ASSERT_FALSE(fake->sent.empty());
+    EXPECT_EQ(fake->sent[0] >> 4, static_cast<uint8_t>(PacketType::Publish));
+    EXPECT_EQ(std::find(fake->sent.begin(), fake->sent.end(), 0xE0), fake->sent.end());
+    EXPECT_STREQ(r->getCurrentStateName(), "Ready");
+    ASSERT_EQ(lateFuture.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_FALSE(lateFuture.get().hasSucceeded());
+
+    fake->sent.clear();
+    constexpr std::array<uint8_t, 4> pubAck{ 0x40, 0x02, 0x00, 0x01 };
+    fake->receive(InboundFrame::fromBytes(pubAck));
+    ASSERT_EQ(publishFuture.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(publishFuture.get().hasSucceeded());
+    EXPECT_STREQ(r->getCurrentStateName(), "Closing");
+    ASSERT_EQ(fake->sent.size(), 2u);
+    EXPECT_EQ(fake->sent[0], 0xE0);
+
+    fake->getOnDisconnectCallback().broadcast();
+    r->tick();
+    ASSERT_EQ(disconnectFuture.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(disconnectFuture.get().hasSucceeded());
+}
+
+TEST(ReactorTest, DrainingDisconnectSendsDisconnectAtItsDeadline)
+{
+    auto r = std::make_shared<Reactor>(makeSettings());
+    const auto fake = std::make_shared<FakeSocket>(makeSettings());
+    r->getContext().setSocket(fake);
+
+    std::promise<Result<void>> p;
+    r->enqueueCommand(ConnectCommand{ true, std::move(p) });
+    r->tick();
+    fake->getOnConnectCallback().broadcast(true);
+
+    using namespace reactormq::mqtt::packets;
+    std::vector<std::byte> buf;
+    serialize::ByteWriter w(buf);
+    const ConnAck<ProtocolVersion::V5> ack(true, ReasonCode::Success, properties::Properties{});
+    ack.encode(w);
+    fake->receive(InboundFrame::fromBytes({ reinterpret_cast<const uint8_t*>(buf.data()), buf.size() }));
+    ASSERT_TRUE(r->isConnected());
+
+    r->enqueueCommand(PublishCommand{ Message{ "a/b", Message::Payload{ 1 }, false, QualityOfService::AtLeastOnce }, {} });
+    r->enqueueCommand(DisconnectCommand{ std::promise<Result<void>>{}, DrainOptions{ true, 1 } });
+    r->tick();
+    EXPECT_STREQ(r->getCurrentStateName(), "Ready");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    r->tick();
+    EXPECT_STREQ(r->getCurrentStateName(), "Closing");
+}
@@ -0,0 +1,268 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "fixtures/loopback_broker.h"
+#include "mqtt/client/client_impl.h"
+#include "mqtt/client/reactor_group.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "util/system/thread_placement.h"
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if REACTORMQ_PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif // REACTORMQ_PLATFORM_LINUX
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    ConnectionSettingsPtr makeSettings()
+    {
+        ConnectionSettingsBuilder b;
+        b.setHost("localhost");
+        return b.build();
+    }
+} // namespace
+
+TEST(ReactorGroupTest, UsesRequestedThreadCount)
+{
+    const auto group = createReactorGroup(3);
+    ASSERT_NE(group, nullptr);
+    EXPECT_EQ(group->getThreadCount(), 3u);
+}
+
+TEST(ReactorGroupTest, ZeroThreadCountUsesAtLeastOneThread)
+{
+    const auto group = createReactorGroup(0);
+    EXPECT_GE(group->getThreadCount(), 1u);
+}
+
+TEST(ReactorGroupTest, TracksLiveClients)
+{
+    const auto group = createReactorGroup(2);
+
+    std::vector<std::shared_ptr<IClient>> clients;
+    for (int i = 0; i < 5; ++i)
+    {
+        clients.push_back(group->createClient(makeSettings()));
+        ASSERT_NE(clients.back(), nullptr);
+    }
+    EXPECT_EQ(group->getClientCount(), 5u);
+
+    clients.resize(2);
+    EXPECT_EQ(group->getClientCount(), 2u);
+}
+
+TEST(ReactorGroupTest, ShardForgetsReleasedReactors)
+{
+    ReactorShard shard;
+    auto first = shard.createReactor(makeSettings());
+    const auto second = shard.createReactor(makeSettings());
+    EXPECT_EQ(shard.getReactorCount(), 2u);
+
+    first.reset();
+    EXPECT_EQ(shard.getReactorCount(), 1u);
+}
+
+TEST(ReactorGroupTest, CommandsRunWithoutManualTick)
+{
+    const auto group = createReactorGroup(2);
+
+    std::vector<std::shared_ptr<IClient>> clients;
+    std::vector<DisconnectFuture> futures;
+    for (int i = 0; i < 4; ++i)
+    {
+        clients.push_back(group->createClient(makeSettings()));
+        futures.push_back(clients.back()->disconnectAsync());
+    }
+
+    for (auto& future : futures)
+    {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+        EXPECT_TRUE(future.get().isSuccess());
+    }
+}
+
+TEST(ReactorGroupTest, StopLeavesClientsValid)
+{
+    const auto group = createReactorGroup(1);
+    const auto client = group->createClient(makeSettings());
+
+    group->stop();
+
+    EXPECT_FALSE(client->isConnected());
+    EXPECT_EQ(client->getCommandQueueDepth(), 0u);
+}
+
+TEST(ReactorGroupTest, PoolThreadsGetNumberedNamesAndOneCoreEach)
+{
+    ThreadPlacement placement;
+    placement.name = "mq-io";
+    placement.cores = { 2, 3 };
+    placement.priority = ThreadPriority::AboveNormal;
+
+    const auto third = reactormq::system::getPoolThreadPlacement(placement, 2);
+    EXPECT_EQ(third.name, "mq-io-2");
+    EXPECT_EQ(third.cores, std::vector<std::uint32_t>{ 2 });
+    EXPECT_EQ(third.priority, ThreadPriority::AboveNormal);
+
+    EXPECT_TRUE(reactormq::system::getPoolThreadPlacement(ThreadPlacement{}, 1).isDefault());
+}
+
+#if REACTORMQ_PLATFORM_LINUX
+TEST(ReactorGroupTest, PlacementNamesAndPinsTheThreadThatAppliesIt)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    std::uint32_t core = 0;
+    while (!CPU_ISSET(core, &allowed))
+    {
+        ++core;
+    }
+
+    ThreadPlacement placement;
+    placement.name = "placement-test";
+    placement.cores = { core };
+
+    std::thread(
+        [&placement, core]
+        {
+            EXPECT_TRUE(reactormq::system::applyThreadPlacement(placement));
+
+            char name[16] = {};
+            ASSERT_EQ(pthread_getname_np(pthread_self(), name, sizeof(name)), 0);
+            EXPECT_EQ(std::string(name), "placement-test");
+
+            cpu_set_t pinned;
+            CPU_ZERO(&pinned);
+            ASSERT_EQ(sched_getaffinity(0, sizeof(pinned), &pinned), 0);
+            EXPECT_EQ(CPU_COUNT(&pinned), 1);
+            EXPECT_TRUE(CPU_ISSET(core, &pinned));
+        })
+        .join();
+}
+#endif // REACTORMQ_PLATFORM_LINUX
+
+TEST(ReactorGroupTest, PlacedGroupStillRunsCommands)
+{
+    ThreadPlacement placement;
+    placement.name = "mq-group";
+    const auto group = createReactorGroup(2, placement);
+    const auto client = group->createClient(makeSettings());
+    auto disconnected = client->disconnectAsync();
+    EXPECT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST(ReactorGroupTest, BusyPollingGroupRunsCommands)
+{
+    const auto group = createReactorGroup(1, {}, BusyPollOptions::spinThenYield());
+    const auto client = group->createClient(makeSettings());
+    auto disconnected = client->disconnectAsync();
+    EXPECT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST(ReactorGroupTest, MovedReactorSignalsItsNewWakeup)
+{
+    const auto before = std::make_shared<reactormq::socket::WakeupHandle>();
+    const auto after = std::make_shared<reactormq::socket::WakeupHandle>();
+    const auto reactor = std::make_shared<Reactor>(makeSettings(), before);
+
+    reactor->setWakeup(after);
+    EXPECT_TRUE(after->isSignalled());
+    after->reset();
+    before->reset();
+
+    reactor->enqueueCommand(DisconnectCommand{});
+    EXPECT_TRUE(after->isSignalled());
+    EXPECT_FALSE(before->isSignalled());
+}
+
+TEST(ReactorGroupTest, BusyShardHandsClientsToAnIdlePeer)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    RebalanceOptions rebalance;
+    rebalance.windowMs = 20;
+    rebalance.imbalancedWindows = 2;
+    ReactorShard busy({}, {}, rebalance);
+    ReactorShard idle({}, {}, rebalance);
+    busy.setPeers({ &idle });
+    idle.setPeers({ &busy });
+    busy.start();
+    idle.start();
+
+    // Every client starts on the busy shard; the first keeps its thread busy handling its own messages.
+    std::vector<std::shared_ptr<IClient>> clients;
+    clients.push_back(std::make_shared<ClientImpl>(busy.createReactor(ConnectionSettingsBuilder("127.0.0.1")
+                                                                          .setPort(port)
+                                                                          .setProtocol(ConnectionProtocol::Tcp)
+                                                                          .setClientId("rebalance-hot")
+                                                                          .build())));
+    clients.push_back(std::make_shared<ClientImpl>(busy.createReactor(makeSettings())));
+    clients.push_back(std::make_shared<ClientImpl>(busy.createReactor(makeSettings())));
+
+    const auto& hot = clients.front();
+    auto connected = hot->connectAsync(true);
+    ASSERT_EQ(connected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_TRUE(connected.get().isSuccess());
+    auto handle = hot->onMessage().add(
+        [&hot](const Message&)
+        {
+            const auto spinUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+            while (std::chrono::steady_clock::now() < spinUntil)
+            {
+            }
+            (void)hot->publishAsync(Message("rebalance/hot", { 'x' }, false, QualityOfService::AtMostOnce));
+        });
+    auto subscribed = hot->subscribeAsync(TopicFilter("rebalance/hot", QualityOfService::AtMostOnce, false));
+    ASSERT_EQ(subscribed.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    (void)hot->publishAsync(Message("rebalance/hot", { 'x' }, false, QualityOfService::AtMostOnce));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (busy.getMigrationCount() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(busy.getMigrationCount(), 1u);
+    EXPECT_GE(idle.getReactorCount(), 1u);
+    EXPECT_EQ(busy.getReactorCount() + idle.getReactorCount(), 3u);
+
+    // Moved clients keep running commands on their new thread.
+    handle.disconnect();
+    for (const auto& client : clients)
+    {
+        auto disconnected = client->disconnectAsync();
+        ASSERT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        EXPECT_TRUE(disconnected.get().isSuccess());
+    }
+
+    busy.stop();
+    idle.stop();
+    broker.stop();
+}
+
+TEST(ReactorGroupTest, RebalancingCanBeTurnedOff)
+{
+    RebalanceOptions rebalance;
+    rebalance.isEnabled = false;
+    const auto group = createReactorGroup(2, {}, {}, rebalance);
+    const auto client = group->createClient(makeSettings());
+    auto disconnected = client->disconnectAsync();
+    EXPECT_EQ(disconnected.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(group->getMigrationCount(), 0u);
+}
@@ -0,0 +1,101 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/context.h"
+#include "mqtt/client/state/disconnected_state.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/reconnect_throttle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using namespace std::chrono_literals;
+
+TEST(ReconnectThrottleTest, BurstIsAdmittedAtOnceAndTheRestAreSpaced)
+{
+    ReconnectThrottle throttle(10.0, 3);
+    const auto now = ReconnectThrottle::Clock::now();
+
+    EXPECT_EQ(throttle.reserve(now), now);
+    EXPECT_EQ(throttle.reserve(now), now);
+    EXPECT_EQ(throttle.reserve(now), now);
+    EXPECT_EQ(throttle.reserve(now), now + 100ms);
+    EXPECT_EQ(throttle.reserve(now), now + 200ms);
+}
+
+TEST(ReconnectThrottleTest, AQuietPeriodRefillsNoMoreThanTheBurst)
+{
+    ReconnectThrottle throttle(10.0, 2);
+    const auto start = ReconnectThrottle::Clock::now();
+    (void)throttle.reserve(start);
+
+    const auto later = start + 10s;
+    EXPECT_EQ(throttle.reserve(later), later);
+    EXPECT_EQ(throttle.reserve(later), later);
+    EXPECT_EQ(throttle.reserve(later), later + 100ms);
+}
+
+TEST(ReconnectThrottleTest, ConcurrentReservationsGetDistinctSlots)
+{
+    ReconnectThrottle throttle(1000.0, 1);
+    const auto now = ReconnectThrottle::Clock::now();
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 50;
+
+    std::vector<std::vector<ReconnectThrottle::Clock::time_point>> slots(kThreads);
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back(
+                [&throttle, &slots, now, t]
+                {
+                    for (int i = 0; i < kPerThread; ++i)
+                    {
+                        slots[t].push_back(throttle.reserve(now));
+                    }
+                });
+        }
+    }
+
+    std::vector<ReconnectThrottle::Clock::time_point> all;
+    for (const auto& perThread : slots)
+    {
+        all.insert(all.end(), perThread.begin(), perThread.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+    EXPECT_EQ(all.back() - all.front(), throttle.getInterval() * (kThreads * kPerThread - 1));
+}
+
+TEST(ReconnectThrottleTest, ReconnectWaitsForItsSlotBeforeConnecting)
+{
+    const auto throttle = std::make_shared<ReconnectThrottle>(1.0, 1);
+    const auto settings = ConnectionSettingsBuilder("localhost").setAutoReconnectEnabled(true).setReconnectThrottle(throttle).build();
+    Context context(settings);
+
+    // Another client of the fleet took the only slot of this second.
+    (void)throttle->reserve(std::chrono::steady_clock::now());
+
+    DisconnectedState disconnected(false);
+    (void)disconnected.onEnter(context);
+    auto [deferred] = disconnected.onTimer(context, TimerKey{ TimerKind::RetryBackoff });
+    EXPECT_FALSE(deferred.has_value());
+
+    const auto fireTime = context.getTimers().getFireTime(TimerKey{ TimerKind::RetryBackoff });
+    ASSERT_TRUE(fireTime.has_value());
+    EXPECT_GT(*fireTime, std::chrono::steady_clock::now() + 500ms);
+
+    // Once the slot is due the attempt goes ahead without reserving another.
+    auto [connecting] = disconnected.onTimer(context, TimerKey{ TimerKind::RetryBackoff });
+    ASSERT_TRUE(connecting.has_value());
+    EXPECT_EQ(connecting->id, StateId::Connecting);
+    disconnected.onExit(context);
+}
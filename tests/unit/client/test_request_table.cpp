@@ -0,0 +1,57 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/request_table.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+TEST(RequestTableTest, TakeCompletesEachRequestOnce)
+{
+    RequestTable requests;
+    std::promise<Result<Message>> first;
+    auto firstFuture = first.get_future();
+    const std::uint32_t firstId = requests.add(std::move(first));
+    const std::uint32_t secondId = requests.add({});
+    ASSERT_NE(firstId, 0u);
+    ASSERT_NE(secondId, firstId);
+    EXPECT_EQ(requests.size(), 2u);
+
+    auto completion = requests.take(firstId);
+    ASSERT_TRUE(completion.has_value());
+    completion->set_value(Result<Message>::failure("test"));
+    EXPECT_EQ(firstFuture.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+
+    EXPECT_FALSE(requests.take(firstId).has_value());
+    EXPECT_FALSE(requests.take(0).has_value());
+    EXPECT_EQ(requests.size(), 1u);
+}
+
+TEST(RequestTableTest, AReusedSlotIgnoresTheIdOfTheRequestBeforeIt)
+{
+    RequestTable requests;
+    const std::uint32_t stale = requests.add({});
+    ASSERT_TRUE(requests.take(stale).has_value());
+
+    const std::uint32_t reused = requests.add({});
+    EXPECT_NE(reused, stale);
+    EXPECT_EQ(reused & 0xFFFF, stale & 0xFFFF);
+    EXPECT_FALSE(requests.take(stale).has_value());
+    EXPECT_TRUE(requests.take(reused).has_value());
+}
+
+TEST(RequestTableTest, CorrelationDataRoundTrips)
+{
+    const std::vector<std::uint8_t> data = RequestTable::toCorrelationData(0x01020304);
+    EXPECT_EQ(data, (std::vector<std::uint8_t>{ 1, 2, 3, 4 }));
+    EXPECT_EQ(RequestTable::fromCorrelationData(data), 0x01020304u);
+    EXPECT_EQ(RequestTable::fromCorrelationData(std::vector<std::uint8_t>{ 1, 2, 3 }), 0u);
+}
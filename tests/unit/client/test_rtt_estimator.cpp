@@ -0,0 +1,47 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/rtt_estimator.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+using reactormq::mqtt::client::RttEstimator;
+
+TEST(RttEstimatorTest, FirstSampleSetsTheSmoothedTimeAndHalfOfItAsVariance)
+{
+    RttEstimator estimator;
+    EXPECT_FALSE(estimator.hasSample());
+    EXPECT_EQ(estimator.getRetransmitTimeout(60s), RttEstimator::kMinRetransmitTimeout);
+
+    estimator.addSample(400ms);
+    EXPECT_TRUE(estimator.hasSample());
+    EXPECT_EQ(estimator.getSmoothedRtt(), 400ms);
+    EXPECT_EQ(estimator.getRttVariance(), 200ms);
+    EXPECT_EQ(estimator.getRetransmitTimeout(60s), 1200ms);
+    EXPECT_EQ(estimator.getRetransmitTimeout(1100ms), 1100ms);
+}
+
+TEST(RttEstimatorTest, SamplesMoveTheEstimateGraduallyAndSteadyOnesNarrowTheVariance)
+{
+    RttEstimator estimator;
+    estimator.addSample(800ms);
+    estimator.addSample(1600ms);
+    EXPECT_EQ(estimator.getSmoothedRtt(), 900ms);
+    EXPECT_EQ(estimator.getRttVariance(), 500ms);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        estimator.addSample(100ms);
+    }
+    EXPECT_LT(estimator.getSmoothedRtt(), 101ms);
+    EXPECT_LT(estimator.getRttVariance(), 1ms);
+    // A fast, steady link still waits the minimum before a retransmit.
+    EXPECT_EQ(estimator.getRetransmitTimeout(60s), RttEstimator::kMinRetransmitTimeout);
+
+    estimator.addSample(-5ms);
+    EXPECT_LT(estimator.getSmoothedRtt(), 100ms);
+}
@@ -0,0 +1,187 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "fixtures/loopback_broker.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/session_store.h"
+#include "reactormq/mqtt/sharded_client.h"
+
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+using reactormq::tests::LoopbackBroker;
+
+namespace
+{
+    class NullSessionStore final : public ISessionStore
+    {
+    public:
+        void addOutboundPublish(std::uint16_t, const Message&) override
+        {
+        }
+
+        void removeOutboundPublish(std::uint16_t) override
+        {
+        }
+
+        void addInboundQos2(std::uint16_t, const Message&) override
+        {
+        }
+
+        void removeInboundQos2(std::uint16_t) override
+        {
+        }
+
+        void commit() override
+        {
+        }
+
+        [[nodiscard]] std::vector<StoredPublish> loadOutboundPublishes() const override
+        {
+            return {};
+        }
+
+        [[nodiscard]] std::vector<StoredPublish> loadInboundQos2() const override
+        {
+            return {};
+        }
+    };
+
+    template<typename T>
+    bool tickUntilReady(IShardedClient& client, std::future<T>& future)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            client.tick();
+            if (future.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+TEST(ShardedClientTest, ZeroShardsMeansOne)
+{
+    const auto client = createShardedClient(ConnectionSettingsBuilder("localhost").build(), 0);
+    ASSERT_EQ(client->getShardCount(), 1u);
+    EXPECT_EQ(client->getShardIndex("any/topic"), 0u);
+    EXPECT_NE(client->getShard(0), nullptr);
+}
+
+TEST(ShardedClientTest, TopicsMapToOneShardAndSpreadOverAll)
+{
+    const auto client = createShardedClient(ConnectionSettingsBuilder("localhost").setClientId("ingest").build(), 4);
+    ASSERT_EQ(client->getShardCount(), 4u);
+
+    std::set<size_t> used;
+    for (int i = 0; i < 64; ++i)
+    {
+        const std::string topic = "devices/" + std::to_string(i) + "/telemetry";
+        const size_t index = client->getShardIndex(topic);
+        ASSERT_LT(index, 4u);
+        EXPECT_EQ(client->getShardIndex(topic), index);
+        used.insert(index);
+    }
+    EXPECT_EQ(used.size(), 4u);
+
+    for (size_t i = 0; i < client->getShardCount(); ++i)
+    {
+        EXPECT_NE(client->getShard(i), nullptr);
+    }
+    EXPECT_NE(client->getShard(0), client->getShard(1));
+    EXPECT_FALSE(client->isConnected());
+}
+
+TEST(ShardedClientTest, WithClientIdCopiesEverythingButTheSession)
+{
+    const auto settings = ConnectionSettingsBuilder("broker.example.com")
+                              .setPort(8883)
+                              .setClientId("ingest")
+                              .setSessionStore(std::make_shared<NullSessionStore>())
+                              .build();
+
+    const auto copy = settings->withClientId("ingest-1");
+    EXPECT_EQ(copy->getClientId(), "ingest-1");
+    EXPECT_EQ(copy->getHost(), "broker.example.com");
+    EXPECT_EQ(copy->getPort(), 8883);
+    EXPECT_EQ(copy->getSessionStore(), nullptr);
+    EXPECT_EQ(settings->getClientId(), "ingest");
+    EXPECT_NE(settings->getSessionStore(), nullptr);
+}
+
+TEST(ShardedClientTest, MergedMetricsAddCountersAndHistograms)
+{
+    ClientMetrics first;
+    first.messagesPublished = 3;
+    first.commandQueueDepth = 1;
+    first.tickDurationsUs[2] = 5;
+    first.publishLatency[1].total.counts[4] = 2;
+    first.publishLatency[1].total.count = 2;
+    first.publishLatency[1].total.maxUs = 4;
+
+    ClientMetrics second;
+    second.messagesPublished = 4;
+    second.commandQueueDepth = 2;
+    second.tickDurationsUs[2] = 1;
+    second.publishLatency[1].total.counts[4] = 1;
+    second.publishLatency[1].total.count = 1;
+    second.publishLatency[1].total.maxUs = 9;
+
+    first.merge(second);
+    EXPECT_EQ(first.messagesPublished, 7u);
+    EXPECT_EQ(first.commandQueueDepth, 3u);
+    EXPECT_EQ(first.tickDurationsUs[2], 6u);
+    EXPECT_EQ(first.publishLatency[1].total.counts[4], 3u);
+    EXPECT_EQ(first.publishLatency[1].total.count, 3u);
+    EXPECT_EQ(first.publishLatency[1].total.maxUs, 9u);
+}
+
+TEST(ShardedClientTest, PublishesAndBatchesCompleteThroughTheShards)
+{
+    LoopbackBroker broker;
+    const uint16_t port = broker.start(0);
+    ASSERT_NE(port, 0);
+
+    // The loopback broker serves one connection at a time, so this drives the facade over a single shard.
+    const auto client = createShardedClient(
+        ConnectionSettingsBuilder("127.0.0.1").setPort(port).setProtocol(ConnectionProtocol::Tcp).setClientId("sharded").build(),
+        1);
+
+    auto connected = client->connectAsync(true);
+    ASSERT_TRUE(tickUntilReady(*client, connected));
+    ASSERT_TRUE(connected.get().hasSucceeded());
+    EXPECT_TRUE(client->isConnected());
+
+    auto published = client->publishAsync(Message("ingest/a", { 1 }, false, QualityOfService::AtLeastOnce));
+    ASSERT_TRUE(tickUntilReady(*client, published));
+    EXPECT_TRUE(published.get().hasSucceeded());
+
+    std::vector<Message> batch;
+    batch.emplace_back("ingest/a", std::vector<uint8_t>{ 2 }, false, QualityOfService::AtLeastOnce);
+    batch.emplace_back("ingest/b", std::vector<uint8_t>{ 3 }, false, QualityOfService::AtLeastOnce);
+    auto batched = client->publishBatchAsync(std::move(batch));
+    ASSERT_TRUE(tickUntilReady(*client, batched));
+    EXPECT_TRUE(batched.get().hasSucceeded());
+
+    EXPECT_EQ(client->getMetrics().messagesPublished, 3u);
+
+    auto disconnected = client->disconnectAsync();
+    ASSERT_TRUE(tickUntilReady(*client, disconnected));
+    EXPECT_TRUE(disconnected.get().hasSucceeded());
+    broker.stop();
+}
@@ -0,0 +1,43 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/spin_backoff.h"
+
+#include <gtest/gtest.h>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+TEST(SpinBackoffTest, DisabledByDefault)
+{
+    EXPECT_FALSE(SpinBackoff{}.isEnabled());
+    EXPECT_TRUE(SpinBackoff{ BusyPollOptions::spin() }.isEnabled());
+    EXPECT_EQ(BusyPollOptions::spin().yieldAfterIdlePolls, 0u);
+}
+
+TEST(SpinBackoffTest, CountsIdlePollsUntilWorkResetsIt)
+{
+    SpinBackoff backoff(BusyPollOptions::spinThenYield());
+    for (int i = 0; i < 40; ++i)
+    {
+        backoff.idle();
+    }
+    EXPECT_EQ(backoff.getIdlePolls(), 40u);
+
+    backoff.reset();
+    EXPECT_EQ(backoff.getIdlePolls(), 0u);
+}
+
+TEST(SpinBackoffTest, YieldingBackoffStillReturns)
+{
+    BusyPollOptions options = BusyPollOptions::spinThenYield();
+    options.yieldAfterIdlePolls = 1;
+    options.maxPauseIterations = 4;
+    SpinBackoff backoff(options);
+    for (int i = 0; i < 100; ++i)
+    {
+        backoff.idle();
+    }
+    EXPECT_EQ(backoff.getIdlePolls(), 100u);
+}
@@ -39,7 +39,7 @@ namespace
             return StateTransition::noTransition();
         }
 
-        StateTransition onDataReceived(Context&, const uint8_t*, uint32_t) override
+        StateTransition onDataReceived(Context&, const reactormq::socket::InboundFrame&) override
         {
             return StateTransition::noTransition();
         }
@@ -65,6 +65,20 @@ TEST(StateTransitionTest, DefaultNoTransitionBuilderWorks)
 
 TEST(StateTransitionTest, TransitionToStoresNewState)
 {
-    const auto [newState] = StateTransition::transitionTo(std::make_unique<DummyState>());
-    EXPECT_TRUE(newState.has_value());
+    const auto [newState] = StateTransition::toReady();
+    ASSERT_TRUE(newState.has_value());
+    EXPECT_EQ(newState->id, StateId::Ready);
+}
+
+TEST(StateTransitionTest, TransitionCarriesTheNewStateArguments)
+{
+    const auto [disconnected] = StateTransition::toDisconnected(true);
+    ASSERT_TRUE(disconnected.has_value());
+    EXPECT_EQ(disconnected->id, StateId::Disconnected);
+    EXPECT_TRUE(disconnected->wasGracefulDisconnect);
+
+    const auto [connecting] = StateTransition::toConnecting(true, Completion<void>{});
+    ASSERT_TRUE(connecting.has_value());
+    EXPECT_EQ(connecting->id, StateId::Connecting);
+    EXPECT_TRUE(connecting->cleanSession);
 }
\ No newline at end of file
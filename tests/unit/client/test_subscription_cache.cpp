@@ -0,0 +1,94 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/subscription_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    std::vector<std::string> sortedFilters(const SubscriptionCache& cache)
+    {
+        std::vector<std::string> filters;
+        for (const TopicFilter& filter : cache.getFilters())
+        {
+            filters.push_back(filter.getFilter());
+        }
+        std::ranges::sort(filters);
+        return filters;
+    }
+} // namespace
+
+TEST(SubscriptionCacheTest, RememberReplacesTheOptionsOfAKnownFilter)
+{
+    SubscriptionCache cache;
+    EXPECT_TRUE(cache.isEmpty());
+
+    cache.remember(TopicFilter{ "a/+", QualityOfService::AtMostOnce });
+    cache.remember(TopicFilter{ "b/#", QualityOfService::AtLeastOnce });
+    cache.remember(TopicFilter{ "a/+", QualityOfService::ExactlyOnce, false });
+
+    ASSERT_EQ(cache.getFilters().size(), 2u);
+    const auto it = std::ranges::find(cache.getFilters(), std::string("a/+"), &TopicFilter::getFilter);
+    ASSERT_NE(it, cache.getFilters().end());
+    EXPECT_EQ(it->getQualityOfService(), QualityOfService::ExactlyOnce);
+    EXPECT_FALSE(it->getIsNoLocal());
+}
+
+TEST(SubscriptionCacheTest, ForgetKeepsTheOtherFiltersReachable)
+{
+    SubscriptionCache cache;
+    for (const char* filter : { "a", "b", "c", "d" })
+    {
+        cache.remember(TopicFilter{ filter, QualityOfService::AtLeastOnce });
+    }
+
+    cache.forget("b");
+    cache.forget("unknown");
+    EXPECT_EQ(sortedFilters(cache), (std::vector<std::string>{ "a", "c", "d" }));
+
+    // The filter moved into b's slot is still found by its own name.
+    cache.forget("d");
+    cache.forget("a");
+    EXPECT_EQ(sortedFilters(cache), (std::vector<std::string>{ "c" }));
+
+    cache.forget("c");
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(SubscriptionCacheTest, DiffFindsTheFiltersToSubscribeAndUnsubscribe)
+{
+    SubscriptionCache cache;
+    cache.remember(TopicFilter{ "keep", QualityOfService::AtLeastOnce });
+    cache.remember(TopicFilter{ "upgrade", QualityOfService::AtMostOnce });
+    cache.remember(TopicFilter{ "drop", QualityOfService::AtLeastOnce });
+
+    const std::vector<TopicFilter> desired{ TopicFilter{ "new", QualityOfService::AtMostOnce },
+                                            TopicFilter{ "upgrade", QualityOfService::ExactlyOnce },
+                                            TopicFilter{ "keep", QualityOfService::AtLeastOnce },
+                                            TopicFilter{ "new", QualityOfService::AtLeastOnce } };
+    std::vector<TopicFilter> toSubscribe;
+    std::vector<std::string> toUnsubscribe;
+    cache.diff(desired, toSubscribe, toUnsubscribe);
+
+    // A filter listed twice is subscribed once, with its last options.
+    ASSERT_EQ(toSubscribe.size(), 2u);
+    EXPECT_EQ(toSubscribe[0], TopicFilter("upgrade", QualityOfService::ExactlyOnce));
+    EXPECT_EQ(toSubscribe[1], TopicFilter("new", QualityOfService::AtLeastOnce));
+    EXPECT_EQ(toUnsubscribe, (std::vector<std::string>{ "drop" }));
+
+    toSubscribe.clear();
+    toUnsubscribe.clear();
+    cache.diff({}, toSubscribe, toUnsubscribe);
+    EXPECT_TRUE(toSubscribe.empty());
+    std::ranges::sort(toUnsubscribe);
+    EXPECT_EQ(toUnsubscribe, (std::vector<std::string>{ "drop", "keep", "upgrade" }));
+}
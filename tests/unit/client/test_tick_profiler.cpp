@@ -0,0 +1,94 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/tick_profiler.h"
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+TEST(TickProfilerTest, NestedScopesChargeOnlyTheirOwnTime)
+{
+    TickProfiler profiler;
+    {
+        const TickPhaseScope read(&profiler, TickPhase::SocketRead);
+        {
+            const TickPhaseScope parse(&profiler, TickPhase::Parse);
+            {
+                const TickPhaseScope dispatch(&profiler, TickPhase::Dispatch);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        }
+    }
+    profiler.endTick(std::chrono::milliseconds(25));
+
+    const TickProfile profile = profiler.getProfile();
+    ASSERT_EQ(profile.windowTicks, 1u);
+    const std::uint64_t dispatchNs = profile.getPhase(TickPhase::Dispatch).maxNs;
+    EXPECT_GE(dispatchNs, 20'000'000u);
+    EXPECT_LT(profile.getPhase(TickPhase::Parse).maxNs, dispatchNs / 2);
+    EXPECT_LT(profile.getPhase(TickPhase::SocketRead).maxNs, dispatchNs / 2);
+    EXPECT_EQ(profile.getPhase(TickPhase::Commands).maxNs, 0u);
+    EXPECT_EQ(profile.getPhase(TickPhase::Total).maxNs, 25'000'000u);
+}
+
+TEST(TickProfilerTest, StatisticsCoverOnlyTheLastWindowOfTicks)
+{
+    TickProfiler profiler;
+    for (int i = 0; i < 100; ++i)
+    {
+        profiler.endTick(std::chrono::seconds(1));
+    }
+    for (size_t i = 1; i <= TickProfile::kWindowTicks; ++i)
+    {
+        profiler.endTick(std::chrono::microseconds(i));
+    }
+
+    const TickProfile profile = profiler.getProfile();
+    EXPECT_EQ(profile.ticksRecorded, 100u + TickProfile::kWindowTicks);
+    EXPECT_EQ(profile.windowTicks, TickProfile::kWindowTicks);
+
+    const TickPhaseStats& total = profile.getPhase(TickPhase::Total);
+    EXPECT_EQ(total.maxNs, 1'024'000u);
+    EXPECT_EQ(total.meanNs, 512'500u);
+    // Nearest rank: the 1014th of 1024 samples.
+    EXPECT_EQ(total.p99Ns, 1'014'000u);
+    EXPECT_EQ(profile.slowestTickNs[static_cast<size_t>(TickPhase::Total)], 1'024'000u);
+}
+
+TEST(TickProfilerTest, SamplesSaturateInsteadOfWrapping)
+{
+    TickProfiler profiler;
+    profiler.endTick(std::chrono::seconds(10));
+    EXPECT_EQ(profiler.getProfile().getPhase(TickPhase::Total).maxNs, 4'294'967'295u);
+}
+
+TEST(TickProfilerTest, ScopesWithoutAProfilerDoNothing)
+{
+    const TickPhaseScope scope(nullptr, TickPhase::Commands);
+    EXPECT_EQ(TickProfiler{}.getProfile().ticksRecorded, 0u);
+}
+
+TEST(TickProfilerTest, ClientReportsTicksOnlyWhenProfilingIsEnabled)
+{
+    const auto profiled = createClient(ConnectionSettingsBuilder("127.0.0.1").setTickProfiling(true).build());
+    const auto plain = createClient(ConnectionSettingsBuilder("127.0.0.1").build());
+    for (int i = 0; i < 5; ++i)
+    {
+        profiled->tick();
+        plain->tick();
+    }
+
+    const TickProfile profile = profiled->getTickProfile();
+    EXPECT_EQ(profile.ticksRecorded, 5u);
+    EXPECT_EQ(profile.windowTicks, 5u);
+    EXPECT_GE(profile.getPhase(TickPhase::Total).maxNs, profile.getPhase(TickPhase::StateTick).maxNs);
+    EXPECT_EQ(plain->getTickProfile().ticksRecorded, 0u);
+}
@@ -51,4 +51,94 @@ TEST(TimerTest, RescheduleOneShotDeactivatesTimer)
 
     t.reschedule();
     EXPECT_FALSE(t.isActive);
-}
\ No newline at end of file
+}
+
+TEST(TimerQueueTest, PopsExpiredTimersInDeadlineOrder)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 2 }, now - std::chrono::milliseconds(1));
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 1 }, now - std::chrono::milliseconds(5));
+    queue.schedule(TimerKey{ TimerKind::Keepalive }, now + std::chrono::seconds(10));
+
+    EXPECT_EQ(queue.popExpired(now), (TimerKey{ TimerKind::PublishTimeout, 1 }));
+    EXPECT_EQ(queue.popExpired(now), (TimerKey{ TimerKind::PublishTimeout, 2 }));
+    EXPECT_FALSE(queue.popExpired(now).has_value());
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(TimerQueueTest, RescheduleReplacesPreviousDeadline)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    const TimerKey key{ TimerKind::Keepalive };
+    queue.schedule(key, now - std::chrono::milliseconds(1));
+    queue.schedule(key, now + std::chrono::seconds(1));
+
+    EXPECT_FALSE(queue.popExpired(now).has_value());
+    EXPECT_EQ(queue.getNextDeadline(), now + std::chrono::seconds(1));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(TimerQueueTest, CancelledTimerNeverFiresAndNextDeadlineSkipsIt)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    queue.schedule(TimerKey{ TimerKind::ConnectTimeout }, now - std::chrono::milliseconds(1));
+    queue.schedule(TimerKey{ TimerKind::RetryBackoff }, now + std::chrono::seconds(2));
+
+    queue.cancel(TimerKey{ TimerKind::ConnectTimeout });
+
+    EXPECT_FALSE(queue.isScheduled(TimerKey{ TimerKind::ConnectTimeout }));
+    EXPECT_EQ(queue.getNextDeadline(), now + std::chrono::seconds(2));
+    EXPECT_FALSE(queue.popExpired(now).has_value());
+}
+
+TEST(TimerQueueTest, ManyInFlightTimersOnlyExpiredOnesArePopped)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    for (std::uint32_t id = 1; id <= 10000; ++id)
+    {
+        queue.schedule(TimerKey{ TimerKind::PublishTimeout, id }, now + std::chrono::seconds(30));
+    }
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 20000 }, now - std::chrono::milliseconds(1));
+
+    EXPECT_EQ(queue.popExpired(now), (TimerKey{ TimerKind::PublishTimeout, 20000 }));
+    EXPECT_FALSE(queue.popExpired(now).has_value());
+    EXPECT_EQ(queue.size(), 10000u);
+}
+
+TEST(TimerQueueTest, ChurnDoesNotGrowHeapUnbounded)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100000; ++i)
+    {
+        queue.schedule(TimerKey{ TimerKind::PublishTimeout, static_cast<std::uint32_t>(i % 8) }, now + std::chrono::milliseconds(i));
+        queue.cancel(TimerKey{ TimerKind::PublishTimeout, static_cast<std::uint32_t>((i + 4) % 8) });
+    }
+    EXPECT_LE(queue.size(), 8u);
+    EXPECT_TRUE(queue.getNextDeadline().has_value());
+}
+
+TEST(TimerQueueTest, PublishTimeoutsOutOfSendOrderStillFireInDeadlineOrder)
+{
+    TimerQueue queue;
+    const auto now = std::chrono::steady_clock::now();
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 1 }, now + std::chrono::seconds(10));
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 2 }, now + std::chrono::seconds(20));
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 3 }, now + std::chrono::seconds(5));
+    queue.schedule(TimerKey{ TimerKind::Keepalive }, now + std::chrono::seconds(15));
+    queue.schedule(TimerKey{ TimerKind::PublishTimeout, 4 }, now + std::chrono::seconds(25));
+    queue.cancel(TimerKey{ TimerKind::PublishTimeout, 2 });
+
+    EXPECT_EQ(queue.getNextDeadline(), now + std::chrono::seconds(5));
+    const auto later = now + std::chrono::minutes(1);
+    EXPECT_EQ(queue.popExpired(later), (TimerKey{ TimerKind::PublishTimeout, 3 }));
+    EXPECT_EQ(queue.popExpired(later), (TimerKey{ TimerKind::PublishTimeout, 1 }));
+    EXPECT_EQ(queue.popExpired(later), (TimerKey{ TimerKind::Keepalive }));
+    EXPECT_EQ(queue.popExpired(later), (TimerKey{ TimerKind::PublishTimeout, 4 }));
+    EXPECT_FALSE(queue.popExpired(later).has_value());
+    EXPECT_EQ(queue.size(), 0u);
+}
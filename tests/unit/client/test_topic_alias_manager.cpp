@@ -0,0 +1,297 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/command.h"
+#include "mqtt/client/context.h"
+#include "mqtt/client/inbound_topic_aliases.h"
+#include "mqtt/client/state/connecting_state.h"
+#include "mqtt/client/state/ready_state.h"
+#include "mqtt/client/topic_alias_manager.h"
+#include "mqtt/packets/conn_ack.h"
+#include "mqtt/packets/publish.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "serialize/bytes.h"
+
+#include <cstring>
+#include <future>
+#include <span>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace reactormq;
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    class CapturingSocket final : public socket::Socket
+    {
+    public:
+        explicit CapturingSocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* data, const uint32_t size) override
+        {
+            sent.insert(sent.end(), reinterpret_cast<const std::byte*>(data), reinterpret_cast<const std::byte*>(data) + size);
+        }
+
+        socket::OnConnectCallback& getOnConnectCallback() override
+        {
+            return onConnect;
+        }
+
+        socket::OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return onDisconnect;
+        }
+
+        socket::OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return onData;
+        }
+
+        void tick() override
+        {
+        }
+
+        std::vector<std::byte> sent;
+
+    private:
+        socket::OnConnectCallback onConnect;
+        socket::OnDisconnectCallback onDisconnect;
+        socket::OnDataReceivedCallback onData;
+    };
+
+    std::vector<std::uint8_t> encodeConnAckWithTopicAliasMaximum(const std::uint16_t maximum)
+    {
+        using namespace packets::properties;
+        std::vector<std::byte> buffer;
+        serialize::ByteWriter writer(buffer);
+        const packets::ConnAck<packets::ProtocolVersion::V5> ack(
+            false, ReasonCode::Success, Properties{ { Property::create<PropertyIdentifier::TopicAliasMaximum>(maximum) } });
+        ack.encode(writer);
+
+        std::vector<std::uint8_t> bytes(buffer.size());
+        std::memcpy(bytes.data(), buffer.data(), buffer.size());
+        return bytes;
+    }
+
+    std::vector<std::byte> publishAndCapture(
+        Context& ctx, CapturingSocket& sock, const std::string& topic, const QualityOfService qos = QualityOfService::AtMostOnce)
+    {
+        sock.sent.clear();
+        Command command = PublishCommand{ Message{ topic, Message::Payload(16, 0x42), false, qos }, std::promise<Result<void>>{} };
+        ReadyState state;
+        (void)state.handleCommand(ctx, command);
+        return sock.sent;
+    }
+} // namespace
+
+TEST(TopicAliasManagerTest, DisabledManagerNeverAssignsAliases)
+{
+    TopicAliasManager aliases;
+    const auto choice = aliases.choose("sensors/temperature");
+    EXPECT_EQ(choice.alias, 0u);
+    EXPECT_FALSE(choice.isNew);
+}
+
+TEST(TopicAliasManagerTest, AssignsSequentialAliasesAndReusesThemOnceCommitted)
+{
+    TopicAliasManager aliases;
+    aliases.reset(4);
+
+    const auto first = aliases.choose("a");
+    EXPECT_EQ(first.alias, 1u);
+    EXPECT_TRUE(first.isNew);
+
+    // Not committed yet, so the topic still has no alias.
+    EXPECT_TRUE(aliases.choose("a").isNew);
+    aliases.commit("a", first.alias);
+
+    const auto again = aliases.choose("a");
+    EXPECT_EQ(again.alias, 1u);
+    EXPECT_FALSE(again.isNew);
+    EXPECT_EQ(aliases.choose("b").alias, 2u);
+}
+
+TEST(TopicAliasManagerTest, EvictsLeastRecentlyUsedTopicWhenFull)
+{
+    TopicAliasManager aliases;
+    aliases.reset(2);
+    aliases.commit("a", aliases.choose("a").alias);
+    aliases.commit("b", aliases.choose("b").alias);
+
+    // Touch "a" so "b" becomes the least recently used.
+    EXPECT_FALSE(aliases.choose("a").isNew);
+
+    const auto c = aliases.choose("c");
+    EXPECT_EQ(c.alias, 2u);
+    EXPECT_TRUE(c.isNew);
+    aliases.commit("c", c.alias);
+
+    EXPECT_EQ(aliases.size(), 2u);
+    EXPECT_TRUE(aliases.choose("b").isNew);
+    EXPECT_EQ(aliases.choose("a").alias, 1u);
+    EXPECT_FALSE(aliases.choose("c").isNew);
+}
+
+TEST(TopicAliasManagerTest, ResetDropsEveryMapping)
+{
+    TopicAliasManager aliases;
+    aliases.reset(8);
+    aliases.commit("a", aliases.choose("a").alias);
+    aliases.reset(8);
+
+    EXPECT_EQ(aliases.size(), 0u);
+    EXPECT_TRUE(aliases.choose("a").isNew);
+}
+
+TEST(TopicAliasManagerTest, ConnAckCapsAliasesAndRepeatPublishOmitsTopic)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxOutboundTopicAliases(8);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<CapturingSocket>(settings);
+    ctx.setSocket(sock);
+
+    ConnectingState connecting(true, std::promise<Result<void>>{});
+    const auto connAck = encodeConnAckWithTopicAliasMaximum(2);
+    (void)connecting.onDataReceived(ctx, connAck.data(), static_cast<std::uint32_t>(connAck.size()));
+    ctx.resetPacketArena();
+    EXPECT_EQ(ctx.getTopicAliases().getMaximum(), 2u);
+
+    const std::string topic = "plant/line-7/cell-3/station-12/sensor/temperature/celsius";
+    const auto first = publishAndCapture(ctx, *sock, topic);
+    const auto second = publishAndCapture(ctx, *sock, topic);
+    ASSERT_FALSE(first.empty());
+    EXPECT_EQ(first.size() - second.size(), topic.size());
+
+    serialize::ByteReader reader(second);
+    const auto header = packets::FixedHeader::create(reader);
+    const packets::Publish5 decoded(reader, header);
+    ASSERT_TRUE(decoded.isValid());
+    EXPECT_TRUE(decoded.getTopicName().empty());
+    EXPECT_EQ(decoded.getPayload().size(), 16u);
+
+    std::uint16_t alias = 0;
+    for (const auto& prop : decoded.getProperties().getProperties())
+    {
+        if (prop.getIdentifier() == packets::properties::PropertyIdentifier::TopicAlias)
+        {
+            prop.tryGetValue(alias);
+        }
+    }
+    EXPECT_EQ(alias, 1u);
+}
+
+TEST(TopicAliasManagerTest, RetransmitOfAliasedPublishCarriesFullTopic)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxOutboundTopicAliases(8);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    const auto sock = std::make_shared<CapturingSocket>(settings);
+    ctx.setSocket(sock);
+    ctx.getTopicAliases().reset(8);
+
+    (void)publishAndCapture(ctx, *sock, "a/b", QualityOfService::AtLeastOnce);
+    (void)publishAndCapture(ctx, *sock, "a/b", QualityOfService::AtLeastOnce);
+    ASSERT_EQ(ctx.getPendingPublishCount(), 2u);
+
+    // Aliases do not survive a reconnect, so both copies must name the topic.
+    sock->sent.clear();
+    ctx.retransmitPendingPublishes();
+    const size_t frameSize = sock->sent.size() / 2;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        serialize::ByteReader reader(std::span<const std::byte>(sock->sent).subspan(i * frameSize, frameSize));
+        const auto header = packets::FixedHeader::create(reader);
+        const packets::Publish5 decoded(reader, header);
+        ASSERT_TRUE(decoded.isValid());
+        EXPECT_EQ(decoded.getTopicName(), "a/b");
+        EXPECT_TRUE(decoded.getIsDuplicate());
+        EXPECT_TRUE(decoded.getProperties().getProperties().empty());
+    }
+}
+
+TEST(TopicAliasManagerTest, V311ConnAckDisablesAliases)
+{
+    Context ctx(ConnectionSettingsBuilder{}.setHost("localhost").build());
+    ctx.getTopicAliases().reset(4);
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+
+    ConnectingState connecting(true, std::promise<Result<void>>{});
+    const std::vector<std::uint8_t> connAck{ 0x20, 0x02, 0x00, 0x00 };
+    (void)connecting.onDataReceived(ctx, connAck.data(), static_cast<std::uint32_t>(connAck.size()));
+    ctx.resetPacketArena();
+
+    EXPECT_EQ(ctx.getTopicAliases().getMaximum(), 0u);
+}
+
+TEST(InboundTopicAliasesTest, ResolvesAliasSetByEarlierPublish)
+{
+    InboundTopicAliases aliases;
+    aliases.reset(3);
+
+    EXPECT_EQ(aliases.resolve(3, "a/b"), "a/b");
+    EXPECT_EQ(aliases.resolve(3, ""), "a/b");
+    EXPECT_EQ(aliases.resolve(3, "c"), "c");
+    EXPECT_EQ(aliases.resolve(3, ""), "c");
+}
+
+TEST(InboundTopicAliasesTest, RejectsUnsetAndOutOfRangeAliases)
+{
+    InboundTopicAliases aliases;
+    aliases.reset(2);
+
+    EXPECT_FALSE(aliases.resolve(1, "").has_value());
+    EXPECT_FALSE(aliases.resolve(0, "a").has_value());
+    EXPECT_FALSE(aliases.resolve(3, "a").has_value());
+
+    aliases.resolve(1, "a").value();
+    aliases.reset(2);
+    EXPECT_FALSE(aliases.resolve(1, "").has_value());
+}
+
+TEST(InboundTopicAliasesTest, ConnectSizesTableFromSettingsForV5Only)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("localhost").setMaxInboundTopicAliases(5);
+    const auto settings = b.build();
+    Context ctx(settings);
+    ctx.setSocket(std::make_shared<CapturingSocket>(settings));
+
+    ctx.setProtocolVersion(packets::ProtocolVersion::V5);
+    ConnectingState v5(true, std::promise<Result<void>>{});
+    (void)v5.onSocketConnected(ctx);
+    EXPECT_EQ(ctx.getInboundTopicAliases().getMaximum(), 5u);
+
+    ctx.setProtocolVersion(packets::ProtocolVersion::V311);
+    ConnectingState v311(true, std::promise<Result<void>>{});
+    (void)v311.onSocketConnected(ctx);
+    EXPECT_EQ(ctx.getInboundTopicAliases().getMaximum(), 0u);
+}
@@ -0,0 +1,55 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/topic_intern_table.h"
+#include "reactormq/mqtt/message.h"
+
+#include <gtest/gtest.h>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+TEST(TopicInternTableTest, DisabledTableHandsOutNothing)
+{
+    TopicInternTable table;
+    EXPECT_FALSE(table.isEnabled());
+    EXPECT_TRUE(table.intern("sensors/1").isEmpty());
+    EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(TopicInternTableTest, RepeatedTopicsShareOneString)
+{
+    TopicInternTable table(8);
+    const SharedTopic first = table.intern("sensors/1");
+    const SharedTopic again = table.intern(std::string("sensors/1"));
+    const SharedTopic other = table.intern("sensors/2");
+
+    EXPECT_EQ(first.get(), "sensors/1");
+    EXPECT_TRUE(first.isSameAs(again));
+    EXPECT_FALSE(first.isSameAs(other));
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(TopicInternTableTest, FullTableStartsOverAndKeepsHandedOutTopics)
+{
+    TopicInternTable table(2);
+    const SharedTopic first = table.intern("a");
+    (void)table.intern("b");
+    const SharedTopic third = table.intern("c");
+
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(first.get(), "a");
+    EXPECT_FALSE(first.isSameAs(table.intern("a")));
+    EXPECT_TRUE(third.isSameAs(table.intern("c")));
+}
+
+TEST(TopicInternTableTest, MessageOnAnInternedTopicReadsItsString)
+{
+    TopicInternTable table(4);
+    const Message message(table.intern("sensors/1"), SharedPayload{}, false, QualityOfService::AtMostOnce);
+
+    EXPECT_EQ(message.getTopic(), "sensors/1");
+    EXPECT_TRUE(message.getSharedTopic().isSameAs(table.intern("sensors/1")));
+    EXPECT_TRUE(Message{}.getSharedTopic().isEmpty());
+}
@@ -0,0 +1,266 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/topic_router.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    /// @brief Number of handlers routed for a topic.
+    size_t matchCount(TopicRouter& router, const std::string_view topic)
+    {
+        const auto handlers = router.match(topic);
+        return handlers ? handlers->size() : 0;
+    }
+
+    MessageHandler noop()
+    {
+        return [](const Message&) {};
+    }
+
+    /// @brief Whether a filter matches a topic, level by level, as a reference for the router.
+    bool filterMatches(const std::string_view filter, const std::string_view topic)
+    {
+        std::vector<TopicLevel> filterLevels;
+        std::vector<TopicLevel> topicLevels;
+        splitTopicLevels(filter, filterLevels);
+        splitTopicLevels(topic, topicLevels);
+        for (size_t i = 0; i < filterLevels.size(); ++i)
+        {
+            const bool wildcard = filterLevels[i].text == "+" || filterLevels[i].text == "#";
+            if (wildcard && i == 0 && topic.starts_with('$'))
+            {
+                return false;
+            }
+            if (filterLevels[i].text == "#")
+            {
+                return true;
+            }
+            if (i == topicLevels.size() || (filterLevels[i].text != "+" && filterLevels[i].text != topicLevels[i].text))
+            {
+                return false;
+            }
+        }
+        return filterLevels.size() == topicLevels.size();
+    }
+} // namespace
+
+TEST(TopicRouterTest, MatchesExactAndWildcardFilters)
+{
+    TopicRouter router;
+    router.add("sensors/kitchen/temp", noop());
+    router.add("sensors/+/temp", noop());
+    router.add("sensors/#", noop());
+    router.add("#", noop());
+    router.add("other/+", noop());
+
+    EXPECT_EQ(matchCount(router, "sensors/kitchen/temp"), 4u);
+    EXPECT_EQ(matchCount(router, "sensors/hall/temp"), 3u);
+    EXPECT_EQ(matchCount(router, "sensors"), 2u);
+    EXPECT_EQ(matchCount(router, "sensors/hall/humidity"), 2u);
+    EXPECT_EQ(matchCount(router, "other/x"), 2u);
+    EXPECT_EQ(matchCount(router, "other/x/y"), 1u);
+}
+
+TEST(TopicRouterTest, WildcardsAtTheFirstLevelSkipDollarTopics)
+{
+    TopicRouter router;
+    router.add("#", noop());
+    router.add("+/info", noop());
+    router.add("$SYS/#", noop());
+
+    EXPECT_EQ(matchCount(router, "$SYS/info"), 1u);
+    EXPECT_EQ(matchCount(router, "app/info"), 2u);
+}
+
+TEST(TopicRouterTest, SharedSubscriptionsRouteOnTheirFilter)
+{
+    TopicRouter router;
+    router.add("$share/workers/jobs/+", noop());
+
+    EXPECT_EQ(matchCount(router, "jobs/1"), 1u);
+    EXPECT_EQ(router.remove("$share/workers/jobs/+"), 1u);
+    EXPECT_EQ(matchCount(router, "jobs/1"), 0u);
+}
+
+TEST(TopicRouterTest, RemoveDropsEveryHandlerOfAFilterAndInvalidatesTheCache)
+{
+    TopicRouter router;
+    int calls = 0;
+    router.add("a/+", [&calls](const Message&) { ++calls; });
+    router.add("a/+", [&calls](const Message&) { ++calls; });
+    router.add("a/#", noop());
+
+    const auto first = router.match("a/b");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->size(), 3u);
+    EXPECT_EQ(router.match("a/b"), first);
+
+    for (const auto& handler : *first)
+    {
+        (*handler)(Message{});
+    }
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_EQ(router.remove("a/+"), 2u);
+    EXPECT_EQ(router.remove("x/y"), 0u);
+    EXPECT_EQ(matchCount(router, "a/b"), 1u);
+    EXPECT_EQ(router.size(), 1u);
+}
+
+TEST(TopicRouterTest, IdentifiedFiltersShareAndRecycleIdentifiers)
+{
+    TopicRouter router;
+    const std::uint32_t first = router.add("a/+", noop(), true);
+    const std::uint32_t again = router.add("a/+", noop(), true);
+    const std::uint32_t second = router.add("b/#", noop(), true);
+
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(second, 2u);
+    EXPECT_EQ(router.add("c", noop()), 0u);
+
+    EXPECT_EQ(router.remove("a/+"), 2u);
+    EXPECT_EQ(router.add("d/+", noop(), true), first);
+}
+
+TEST(TopicRouterTest, MatchIdentifiersIgnoresTheTopic)
+{
+    TopicRouter router;
+    const std::uint32_t a = router.add("a/+", noop(), true);
+    const std::uint32_t b = router.add("b/#", noop(), true);
+
+    const std::uint32_t single[] = { a };
+    const auto one = router.matchIdentifiers(single);
+    ASSERT_NE(one, nullptr);
+    EXPECT_EQ(one->size(), 1u);
+
+    const std::uint32_t both[] = { a, b, 99 };
+    const auto two = router.matchIdentifiers(both);
+    ASSERT_NE(two, nullptr);
+    EXPECT_EQ(two->size(), 2u);
+
+    const std::uint32_t unknown[] = { 99 };
+    const auto none = router.matchIdentifiers(unknown);
+    EXPECT_TRUE(nullptr == none || none->empty());
+}
+
+TEST(TopicRouterTest, InternedTopicRepeatsTheLastMatchUntilRoutesChange)
+{
+    TopicRouter router;
+    router.add("a/+", noop());
+
+    const SharedTopic topic{ std::string("a/b") };
+    const auto first = router.match(topic);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(router.match(topic), first);
+    EXPECT_EQ(router.match(SharedTopic{ std::string("a/c") })->size(), 1u);
+
+    router.add("a/b", noop());
+    EXPECT_EQ(router.match(topic)->size(), 2u);
+}
+
+TEST(TopicRouterTest, SplitTopicLevelsFindsEverySeparatorAcrossBlocks)
+{
+    std::vector<TopicLevel> levels;
+    splitTopicLevels("", levels);
+    ASSERT_EQ(levels.size(), 1u);
+    EXPECT_TRUE(levels[0].text.empty());
+
+    // Longer than two 16-byte blocks, with separators at both ends, doubled, and on a block boundary.
+    const std::string topic = "/sites/site-0001/devices//device-0042-of-many/metric/temperature/";
+    splitTopicLevels(topic, levels);
+    const std::vector<std::string_view> expected
+        = { "", "sites", "site-0001", "devices", "", "device-0042-of-many", "metric", "temperature", "" };
+    ASSERT_EQ(levels.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(levels[i].text, expected[i]);
+        EXPECT_EQ(levels[i].hash, hashTopicLevel(expected[i]));
+    }
+
+    splitTopicLevels("0123456789abcdef/", levels);
+    ASSERT_EQ(levels.size(), 2u);
+    EXPECT_EQ(levels[0].text, "0123456789abcdef");
+    EXPECT_TRUE(levels[1].text.empty());
+}
+
+TEST(TopicRouterTest, ManyFiltersMatchLikeAReferenceThroughSubscribeAndUnsubscribeChurn)
+{
+    const std::vector<std::string> levelChoices = { "a", "b", "c", "+", "" };
+    std::mt19937 random(1234);
+    const auto makeFilter = [&]
+    {
+        std::string filter;
+        const size_t depth = 1 + random() % 4;
+        for (size_t i = 0; i < depth; ++i)
+        {
+            filter += (i == 0 ? "" : "/") + levelChoices[random() % levelChoices.size()];
+        }
+        return random() % 6 == 0 ? filter + "/#" : filter;
+    };
+
+    std::vector<std::string> topics;
+    for (const std::string& first : { "a", "b", "$SYS", "" })
+    {
+        for (const std::string& second : { "a", "b", "c", "" })
+        {
+            topics.push_back(first);
+            topics.push_back(first + "/" + second);
+            topics.push_back(first + "/" + second + "/c");
+            topics.push_back(first + "/" + second + "/a/b");
+        }
+    }
+
+    TopicRouter router;
+    std::map<std::string, size_t> reference;
+    for (int round = 0; round < 2000; ++round)
+    {
+        const std::string filter = makeFilter();
+        if (random() % 3 == 0)
+        {
+            const auto it = reference.find(filter);
+            EXPECT_EQ(router.remove(filter), it == reference.end() ? 0u : it->second);
+            if (it != reference.end())
+            {
+                reference.erase(it);
+            }
+        }
+        else
+        {
+            router.add(filter, noop());
+            ++reference[filter];
+        }
+
+        if (round % 50 != 0)
+        {
+            continue;
+        }
+        for (const std::string& topic : topics)
+        {
+            size_t expected = 0;
+            for (const auto& [added, count] : reference)
+            {
+                expected += filterMatches(added, topic) ? count : 0;
+            }
+            ASSERT_EQ(matchCount(router, topic), expected) << "topic '" << topic << "' after round " << round;
+        }
+    }
+
+    for (const auto& [filter, count] : reference)
+    {
+        EXPECT_EQ(router.remove(filter), count);
+    }
+    EXPECT_EQ(router.size(), 0u);
+    router.add("a/b", noop());
+    EXPECT_EQ(matchCount(router, "a/b"), 1u);
+}
@@ -0,0 +1,101 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/traffic_accounting.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    TopicRouter::Handler makeHandler()
+    {
+        return std::make_shared<const MessageHandler>([](const Message&) {});
+    }
+} // namespace
+
+TEST(TrafficAccountingTest, CountsMessagesBytesAndDropsPerSubscription)
+{
+    TrafficAccounting accounting(TrafficAccountingOptions{ true, 0, 2 });
+    const auto sensors = makeHandler();
+    const auto alerts = makeHandler();
+    accounting.addSubscription("sensors/#", sensors.get());
+    accounting.addSubscription("alerts/+", alerts.get());
+
+    const TopicRouter::HandlerList both{ sensors, alerts };
+    const TopicRouter::HandlerList onlySensors{ sensors };
+    accounting.recordMessage("sensors/a", 10, &onlySensors);
+    accounting.recordMessage("sensors/b", 20, &onlySensors);
+    accounting.recordMessage("alerts/x", 5, &both);
+    accounting.recordMessage("unmatched", 7, nullptr);
+    accounting.recordDropped(sensors.get());
+
+    InboundTraffic report = accounting.getReport();
+    ASSERT_EQ(report.subscriptions.size(), 2u);
+    EXPECT_EQ(report.subscriptions[0].filter, "sensors/#");
+    EXPECT_EQ(report.subscriptions[0].messages, 3u);
+    EXPECT_EQ(report.subscriptions[0].bytes, 35u);
+    EXPECT_EQ(report.subscriptions[0].dropped, 1u);
+    EXPECT_EQ(report.subscriptions[1].filter, "alerts/+");
+    EXPECT_EQ(report.subscriptions[1].messages, 1u);
+    EXPECT_EQ(report.subscriptions[1].bytes, 5u);
+    EXPECT_TRUE(report.topPrefixes.empty());
+
+    accounting.removeSubscription("sensors/#");
+    accounting.recordMessage("sensors/a", 10, &onlySensors);
+    report = accounting.getReport();
+    ASSERT_EQ(report.subscriptions.size(), 1u);
+    EXPECT_EQ(report.subscriptions[0].filter, "alerts/+");
+}
+
+TEST(TrafficAccountingTest, KeepsTheBusiestPrefixesInFixedSlots)
+{
+    TrafficAccounting accounting(TrafficAccountingOptions{ true, 2, 2 });
+    for (int i = 0; i < 5; ++i)
+    {
+        accounting.recordMessage("home/kitchen/temp", 4, nullptr);
+    }
+    accounting.recordMessage("home/garage/door", 3, nullptr);
+    accounting.recordMessage("home/garage", 2, nullptr);
+    accounting.recordMessage("plant", 1, nullptr);
+
+    // "plant" takes over the garage's slot and inherits its two messages.
+    const InboundTraffic report = accounting.getReport();
+    ASSERT_EQ(report.topPrefixes.size(), 2u);
+    EXPECT_EQ(report.topPrefixes[0].prefix, "home/kitchen");
+    EXPECT_EQ(report.topPrefixes[0].messages, 5u);
+    EXPECT_EQ(report.topPrefixes[0].bytes, 20u);
+    EXPECT_EQ(report.topPrefixes[0].overcount, 0u);
+    EXPECT_EQ(report.topPrefixes[1].prefix, "plant");
+    EXPECT_EQ(report.topPrefixes[1].messages, 3u);
+    EXPECT_EQ(report.topPrefixes[1].bytes, 1u);
+    EXPECT_EQ(report.topPrefixes[1].overcount, 2u);
+}
+
+TEST(TrafficAccountingTest, MergeSumsSharedFiltersAndPrefixes)
+{
+    InboundTraffic total;
+    total.subscriptions.push_back(SubscriptionTraffic{ "a/#", 2, 20, 1 });
+    total.topPrefixes.push_back(TopicPrefixTraffic{ "a/b", 2, 20, 0 });
+
+    InboundTraffic other;
+    other.subscriptions.push_back(SubscriptionTraffic{ "a/#", 3, 30, 0 });
+    other.subscriptions.push_back(SubscriptionTraffic{ "c", 1, 1, 0 });
+    other.topPrefixes.push_back(TopicPrefixTraffic{ "c", 4, 4, 1 });
+    other.topPrefixes.push_back(TopicPrefixTraffic{ "a/b", 3, 30, 0 });
+    total.merge(other);
+
+    ASSERT_EQ(total.subscriptions.size(), 2u);
+    EXPECT_EQ(total.subscriptions[0].messages, 5u);
+    EXPECT_EQ(total.subscriptions[0].bytes, 50u);
+    EXPECT_EQ(total.subscriptions[0].dropped, 1u);
+    ASSERT_EQ(total.topPrefixes.size(), 2u);
+    EXPECT_EQ(total.topPrefixes[0].prefix, "a/b");
+    EXPECT_EQ(total.topPrefixes[0].messages, 5u);
+    EXPECT_EQ(total.topPrefixes[1].prefix, "c");
+}
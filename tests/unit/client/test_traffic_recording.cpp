@@ -0,0 +1,138 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/client/traffic_recording.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    std::vector<std::uint8_t> toBytes(const std::vector<char>& buffer)
+    {
+        return { buffer.begin(), buffer.end() };
+    }
+} // namespace
+
+TEST(TrafficRecordingTest, RoundTripsDirectionTimingAndCutPackets)
+{
+    std::vector<char> buffer;
+    TrafficRecordingEncoder encoder;
+    TrafficRecordingEncoder::appendHeader(buffer);
+
+    const std::vector<std::uint8_t> pingReq = { 0xC0, 0x00 };
+    const std::vector<std::uint8_t> publishHead = { 0x30, 0x05, 0x00, 0x01 };
+    encoder.appendPacket(buffer, 1'700'000'000'000'000, PacketDirection::Sent, 2, pingReq);
+    encoder.appendPacket(buffer, 1'700'000'000'000'250, PacketDirection::Received, 7, publishHead);
+    // A timestamp that goes backwards is recorded as no time passing.
+    encoder.appendPacket(buffer, 1'699'999'999'999'000, PacketDirection::Received, 2, pingReq);
+
+    std::vector<RecordedPacket> packets;
+    ASSERT_TRUE(decodeTrafficRecording(toBytes(buffer), packets));
+    ASSERT_EQ(packets.size(), 3u);
+
+    EXPECT_EQ(packets[0].timestampUs, 1'700'000'000'000'000);
+    EXPECT_EQ(packets[0].direction, PacketDirection::Sent);
+    EXPECT_EQ(packets[0].bytes, pingReq);
+    EXPECT_TRUE(packets[0].isComplete());
+
+    EXPECT_EQ(packets[1].timestampUs, 1'700'000'000'000'250);
+    EXPECT_EQ(packets[1].direction, PacketDirection::Received);
+    EXPECT_EQ(packets[1].originalSize, 7u);
+    EXPECT_EQ(packets[1].bytes, publishHead);
+    EXPECT_FALSE(packets[1].isComplete());
+
+    EXPECT_EQ(packets[2].timestampUs, 1'700'000'000'000'250);
+}
+
+TEST(TrafficRecordingTest, RejectsMissingMagicAndMalformedRecords)
+{
+    std::vector<RecordedPacket> packets;
+    const std::vector<std::uint8_t> noMagic = { 'R', 'M', 'Q' };
+    EXPECT_FALSE(decodeTrafficRecording(noMagic, packets));
+
+    std::vector<char> buffer;
+    TrafficRecordingEncoder encoder;
+    TrafficRecordingEncoder::appendHeader(buffer);
+    const std::vector<std::uint8_t> pingReq = { 0xC0, 0x00 };
+    encoder.appendPacket(buffer, 10, PacketDirection::Sent, 2, pingReq);
+    const size_t firstRecordEnd = buffer.size();
+    encoder.appendPacket(buffer, 20, PacketDirection::Sent, 2, pingReq);
+
+    std::vector<std::uint8_t> truncated = toBytes(buffer);
+    truncated.pop_back();
+    EXPECT_FALSE(decodeTrafficRecording(truncated, packets));
+    EXPECT_EQ(packets.size(), 1u);
+
+    std::vector<std::uint8_t> badDirection = toBytes(buffer);
+    badDirection[firstRecordEnd] = 7;
+    EXPECT_FALSE(decodeTrafficRecording(badDirection, packets));
+
+    // More bytes recorded than the packet had.
+    std::vector<std::uint8_t> oversized = toBytes(buffer);
+    oversized[firstRecordEnd + 2] = 1;
+    EXPECT_FALSE(decodeTrafficRecording(oversized, packets));
+}
+
+TEST(TrafficRecordingTest, CaptureInRecordingFormatLoadsBack)
+{
+    const auto path = std::filesystem::temp_directory_path() / "reactormq_traffic_test.rmqtraf";
+    {
+        const PacketCapturePtr capture = createPacketCapture({ path.string(), PacketCaptureFormat::Recording });
+        ASSERT_NE(capture, nullptr);
+
+        const std::uint8_t header[] = { 0x40, 0x02 };
+        const std::uint8_t packetId[] = { 0x00, 0x2A };
+        const std::span<const std::uint8_t> parts[] = { header, packetId };
+        capture->onPacket(PacketDirection::Received, parts, 4);
+        capture->onPacket(PacketDirection::Sent, parts, 4);
+        for (int i = 0; i < 200 && capture->getWrittenCount() < 2; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    std::vector<RecordedPacket> packets;
+    ASSERT_TRUE(loadTrafficRecording(path.string(), packets));
+    std::filesystem::remove(path);
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(packets[0].direction, PacketDirection::Received);
+    EXPECT_EQ(packets[1].direction, PacketDirection::Sent);
+    EXPECT_EQ(packets[0].bytes, (std::vector<std::uint8_t>{ 0x40, 0x02, 0x00, 0x2A }));
+    EXPECT_GT(packets[0].timestampUs, 0);
+    EXPECT_LE(packets[0].timestampUs, packets[1].timestampUs);
+}
+
+TEST(TrafficRecordingTest, CorpusDirectoryLoadsAsReceivedChunksInNameOrder)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "reactormq_traffic_corpus_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "nested");
+    std::ofstream(directory / "b", std::ios::binary).write("\xD0\x00", 2);
+    std::ofstream(directory / "a", std::ios::binary).write("\xC0\x00", 2);
+
+    std::vector<RecordedPacket> packets;
+    ASSERT_TRUE(loadTrafficRecording(directory.string(), packets));
+    std::filesystem::remove_all(directory);
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(packets[0].bytes, (std::vector<std::uint8_t>{ 0xC0, 0x00 }));
+    EXPECT_EQ(packets[1].bytes, (std::vector<std::uint8_t>{ 0xD0, 0x00 }));
+    EXPECT_EQ(packets[0].direction, PacketDirection::Received);
+    EXPECT_TRUE(packets[1].isComplete());
+}
+
+TEST(TrafficRecordingTest, MissingPathFailsToLoad)
+{
+    std::vector<RecordedPacket> packets;
+    EXPECT_FALSE(loadTrafficRecording("/nonexistent-directory/traffic.rmqtraf", packets));
+}
@@ -2,14 +2,22 @@
 //  Copyright 2025 Simon Balarabe
 //  Project: ReactorMQ — https://github.com/Naragato/reactormq
 
+#include "util/logging/async_log_queue.h"
 #include "util/logging/console_sink.h"
 #include "util/logging/file_sink.h"
 #include "util/logging/log_message.h"
+#include "util/logging/log_rate_limit.h"
 #include "util/logging/logging.h"
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 using namespace reactormq::logging;
 
@@ -33,6 +41,86 @@ TEST(Logging, HexHelperSpacing)
     EXPECT_EQ(hex, std::string("00 ab 7f ff "));
 }
 
+TEST(Logging, AppendedTimestampFollowsMillisecondsAndSeconds)
+{
+    using namespace std::chrono;
+    const auto base = system_clock::time_point{ floor<seconds>(system_clock::now()) } + milliseconds{ 7 };
+
+    std::string first;
+    appendIso8601ms(first, base);
+    ASSERT_EQ(first.size(), 23u);
+    EXPECT_EQ(first.substr(19), ".007");
+    EXPECT_EQ(toIso8601ms(base), first);
+
+    // Same second: only the milliseconds change.
+    std::string next = "prefix ";
+    appendIso8601ms(next, base + milliseconds{ 1 });
+    EXPECT_EQ(next, "prefix " + first.substr(0, 19) + ".008");
+
+    // Next second: the calendar part is formatted again.
+    const std::string later = toIso8601ms(base + milliseconds{ 1250 });
+    EXPECT_EQ(later.substr(19), ".257");
+    EXPECT_NE(later.substr(0, 19), first.substr(0, 19));
+
+    EXPECT_EQ(toIso8601ms(base), first);
+}
+
+TEST(Logging, AppendedThreadIdMatchesThreadIdStrPastTheCache)
+{
+    std::vector<std::jthread::id> ids;
+    for (int i = 0; i < 12; ++i)
+    {
+        std::jthread worker(
+            [&ids]
+            {
+                ids.push_back(std::this_thread::get_id());
+            });
+        worker.join();
+    }
+    ids.push_back(std::jthread::id{});
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const auto& id : ids)
+        {
+            std::string text;
+            appendThreadId(text, id);
+            EXPECT_EQ(text, threadIdStr(id));
+        }
+    }
+}
+
+#if REACTORMQ_WITH_CONSOLE_SINK
+TEST(Logging, ConsoleSinkWritesOneLinePerMessage)
+{
+    LogMessage first;
+    first.timestamp = std::chrono::system_clock::now();
+    first.thread_id = std::this_thread::get_id();
+    first.function = "fn";
+    first.file = "src/dir/file.cpp";
+    first.line = 42;
+    first.text = "hello";
+    LogMessage second = first;
+    second.text = "world";
+
+    testing::internal::CaptureStdout();
+    {
+        ConsoleSink sink(false);
+        sink.log(first);
+        sink.log(second);
+        sink.log(second);
+    }
+    std::fflush(stdout);
+    const std::string output = testing::internal::GetCapturedStdout();
+
+    const std::string location = " | " + threadIdStr(first.thread_id) + " | INFO | fn | file.cpp:42 | ";
+    const std::string timestamp = toIso8601ms(first.timestamp);
+    EXPECT_EQ(
+        output,
+        timestamp + location + "hello\n" + timestamp + " to " + timestamp + location + "world (repeated 2 times)\n");
+}
+#endif // REACTORMQ_WITH_CONSOLE_SINK
+
 TEST(Logging, RegistryLevelFilter)
 {
     auto& reg = Registry::instance();
@@ -48,6 +136,160 @@ TEST(Logging, RegistryLevelFilter)
     EXPECT_EQ(sink->messages[0].level, LogLevel::Info);
 }
 
+TEST(Logging, AsyncModeDeliversMessagesInOrderFromTheBackgroundThread)
+{
+    auto& reg = Registry::instance();
+    reg.removeAllSinks();
+    const auto sink = std::make_shared<MemorySink>();
+    reg.addSink(sink);
+    reg.setLevel(LogLevel::Trace);
+
+    reg.startAsync();
+    EXPECT_TRUE(reg.isAsync());
+    for (int i = 0; i < 100; ++i)
+    {
+        REACTORMQ_LOG(LogLevel::Debug, "message %d", i);
+    }
+    const std::string longText(1000, 'x');
+    REACTORMQ_LOG(LogLevel::Info, "%s", longText.c_str());
+    reg.stopAsync();
+    EXPECT_FALSE(reg.isAsync());
+
+    ASSERT_EQ(sink->messages.size(), 101u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(sink->messages[static_cast<size_t>(i)].text, "message " + std::to_string(i));
+    }
+    EXPECT_EQ(sink->messages[100].text, longText);
+    EXPECT_EQ(sink->messages[0].thread_id, std::this_thread::get_id());
+    EXPECT_NE(sink->messages[0].line, 0u);
+
+    REACTORMQ_LOG(LogLevel::Info, "sync again");
+    ASSERT_EQ(sink->messages.size(), 102u);
+    reg.removeAllSinks();
+}
+
+TEST(Logging, AsyncQueueRejectsRecordsWhenFull)
+{
+    AsyncLogQueue queue(2);
+    const auto location = std::source_location::current();
+    EXPECT_TRUE(queue.tryPush(LogLevel::Info, location, "a"));
+    EXPECT_TRUE(queue.tryPush(LogLevel::Info, location, "b"));
+    EXPECT_FALSE(queue.tryPush(LogLevel::Info, location, "c"));
+
+    std::string drained;
+    EXPECT_EQ(queue.drain(
+                  [&](const LogRecord& record)
+                  {
+                      drained += record.getText();
+                  },
+                  1),
+        1u);
+    EXPECT_TRUE(queue.tryPush(LogLevel::Info, location, "d"));
+    EXPECT_EQ(queue.drain(
+                  [&](const LogRecord& record)
+                  {
+                      drained += record.getText();
+                  },
+                  10),
+        2u);
+    EXPECT_EQ(drained, "abd");
+    EXPECT_FALSE(queue.hasReadyRecord());
+}
+
+TEST(Logging, AsyncModeFormatsPlainArgumentsOnTheBackgroundThread)
+{
+    auto& reg = Registry::instance();
+    reg.removeAllSinks();
+    const auto sink = std::make_shared<MemorySink>();
+    reg.addSink(sink);
+    reg.setLevel(LogLevel::Trace);
+
+    reg.startAsync();
+    {
+        int packetId = 7;
+        std::string topic = "a/b";
+        REACTORMQ_LOG(LogLevel::Debug, "packet %d of %.1f%%", packetId, 2.5);
+        REACTORMQ_LOG(LogLevel::Debug, "topic %s", topic);
+        REACTORMQ_LOG(LogLevel::Debug, "100%% literal");
+        packetId = 8;
+        topic = "changed";
+    }
+    reg.stopAsync();
+
+    ASSERT_EQ(sink->messages.size(), 3u);
+    EXPECT_EQ(sink->messages[0].text, "packet 7 of 2.5%");
+    EXPECT_EQ(sink->messages[1].text, "topic a/b");
+    EXPECT_EQ(sink->messages[2].text, "100%% literal");
+    reg.removeAllSinks();
+}
+
+TEST(Logging, DeferredRecordIsFormattedWhenRead)
+{
+    static_assert(detail::kIsDeferrable<int&, double, const void*>);
+    static_assert(!detail::kIsDeferrable<int, const char*>);
+    static_assert(!detail::kIsDeferrable<const std::string&>);
+
+    AsyncLogQueue queue(2);
+    ASSERT_TRUE(queue.tryPush(
+        LogLevel::Info,
+        std::source_location::current(),
+        [](LogRecord& record)
+        {
+            ::new (record.getDeferredArgs()) std::tuple<int, unsigned>(-3, 4u);
+            record.setDeferred("%d/%u", &detail::formatDeferred<int, unsigned>);
+        }));
+
+    std::string text;
+    EXPECT_EQ(queue.drain(
+                  [&](const LogRecord& record)
+                  {
+                      EXPECT_TRUE(record.isDeferred());
+                      record.formatTextTo(text);
+                  },
+                  1),
+        1u);
+    EXPECT_EQ(text, "-3/4");
+}
+
+TEST(Logging, RateLimitAllowsABurstThenRefillsAndReportsSuppressed)
+{
+    LogRateLimit limit(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(limit.tryAcquire().isAllowed);
+    }
+    EXPECT_FALSE(limit.tryAcquire().isAllowed);
+    EXPECT_FALSE(limit.tryAcquire().isAllowed);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    const LogRateLimit::Admission admission = limit.tryAcquire();
+    EXPECT_TRUE(admission.isAllowed);
+    EXPECT_EQ(admission.suppressed, 2u);
+    EXPECT_EQ(limit.tryAcquire().suppressed, 0u);
+}
+
+TEST(Logging, RateLimitedMacroLimitsEachCallSite)
+{
+    auto& reg = Registry::instance();
+    reg.removeAllSinks();
+    const auto sink = std::make_shared<MemorySink>();
+    reg.addSink(sink);
+    reg.setLevel(LogLevel::Trace);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        REACTORMQ_LOG_RATELIMITED(LogLevel::Warn, 5, "storm %d", i);
+        REACTORMQ_LOG_RATELIMITED(LogLevel::Warn, 5, "other %d", i);
+    }
+
+    ASSERT_EQ(sink->messages.size(), 10u);
+    EXPECT_EQ(sink->messages[0].text, "storm 0");
+    EXPECT_EQ(sink->messages[1].text, "other 0");
+    EXPECT_EQ(sink->messages[8].text, "storm 4");
+    reg.removeAllSinks();
+}
+
 TEST(Logging, MacroHexAppendsDump)
 {
     auto& reg = Registry::instance();
@@ -88,4 +330,84 @@ TEST(Logging, FileSinkWrites)
     EXPECT_GT(sz, 0u);
     std::remove("reactormq_test.log");
 }
+
+namespace
+{
+    long fileSize(const char* path)
+    {
+        std::FILE* f = std::fopen(path, "rb");
+        if (f == nullptr)
+        {
+            return -1;
+        }
+        std::fseek(f, 0, SEEK_END);
+        const long pos = std::ftell(f);
+        std::fclose(f);
+        return pos;
+    }
+
+    LogMessage makeFileMessage(const LogLevel level, const std::string& text)
+    {
+        LogMessage msg;
+        msg.level = level;
+        msg.text = text;
+        msg.function = "fn";
+        msg.file = "file.cpp";
+        return msg;
+    }
+} // namespace
+
+TEST(Logging, BufferedFileSinkHoldsLinesUntilAnErrorIsWritten)
+{
+    std::remove("reactormq_buffered.log");
+    {
+        FileSinkOptions options;
+        options.isBuffered = true;
+        options.bufferBytes = 1024 * 1024;
+        options.flushInterval = std::chrono::hours(1);
+        FileSink sink("reactormq_buffered.log", options);
+
+        // A line is written once the next, different message shows it is not repeated.
+        sink.log(makeFileMessage(LogLevel::Info, "first"));
+        sink.log(makeFileMessage(LogLevel::Info, "second"));
+        sink.log(makeFileMessage(LogLevel::Info, "third"));
+        EXPECT_EQ(fileSize("reactormq_buffered.log"), 0);
+
+        sink.log(makeFileMessage(LogLevel::Error, "failed"));
+        sink.log(makeFileMessage(LogLevel::Info, "after"));
+        EXPECT_GT(fileSize("reactormq_buffered.log"), 0);
+
+        const long flushed = fileSize("reactormq_buffered.log");
+        sink.log(makeFileMessage(LogLevel::Info, "more"));
+        EXPECT_EQ(fileSize("reactormq_buffered.log"), flushed);
+        sink.flush();
+        EXPECT_GT(fileSize("reactormq_buffered.log"), flushed);
+    }
+    std::remove("reactormq_buffered.log");
+}
+
+TEST(Logging, FileSinkRotatesWhenTheFileWouldOutgrowItsLimit)
+{
+    std::remove("reactormq_rotating.log");
+    std::remove("reactormq_rotating.log.1");
+    std::remove("reactormq_rotating.log.2");
+    {
+        FileSinkOptions options;
+        options.maxFileBytes = 300;
+        options.maxRotatedFiles = 2;
+        FileSink sink("reactormq_rotating.log", options);
+        for (int i = 0; i < 20; ++i)
+        {
+            sink.log(makeFileMessage(LogLevel::Info, "rotating line " + std::to_string(i)));
+        }
+    }
+
+    EXPECT_GT(fileSize("reactormq_rotating.log"), 0);
+    EXPECT_LE(fileSize("reactormq_rotating.log"), 300);
+    EXPECT_GT(fileSize("reactormq_rotating.log.1"), 0);
+    EXPECT_GT(fileSize("reactormq_rotating.log.2"), 0);
+    std::remove("reactormq_rotating.log");
+    std::remove("reactormq_rotating.log.1");
+    std::remove("reactormq_rotating.log.2");
+}
 #endif // REACTORMQ_WITH_FILE_SINK
\ No newline at end of file
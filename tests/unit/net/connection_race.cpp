@@ -0,0 +1,90 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/connection_race.h"
+#include "fixtures/echo_server.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace reactormq::socket;
+using namespace reactormq::tests;
+
+namespace
+{
+    ConnectionRace::Status runRace(ConnectionRace& race)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+        ConnectionRace::Status status = race.poll(std::chrono::steady_clock::now());
+        while (status == ConnectionRace::Status::Racing && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            status = race.poll(std::chrono::steady_clock::now());
+        }
+        return status;
+    }
+} // namespace
+
+TEST(ConnectionRace, FirstAddressThatConnectsWins)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    ConnectionRace race({ "127.0.0.1" }, port);
+
+    ASSERT_EQ(runRace(race), ConnectionRace::Status::Connected);
+    EXPECT_EQ(race.getWinningAddress(), "127.0.0.1");
+    EXPECT_EQ(race.getAttemptCount(), 1U);
+
+    const std::unique_ptr<PlatformSocket> winner = race.takeWinner();
+    ASSERT_NE(winner, nullptr);
+    EXPECT_TRUE(winner->isConnected());
+    EXPECT_EQ(race.takeWinner(), nullptr);
+}
+
+TEST(ConnectionRace, RefusedAddressFallsBackToTheNext)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    // The server only listens on IPv4, so the IPv6 loopback is refused or, without IPv6, cannot be tried at all.
+    ConnectionRace race({ "::1", "127.0.0.1" }, port, std::chrono::seconds{ 5 });
+
+    ASSERT_EQ(runRace(race), ConnectionRace::Status::Connected);
+    EXPECT_EQ(race.getWinningAddress(), "127.0.0.1");
+    EXPECT_EQ(race.getAttemptCount(), 2U);
+}
+
+TEST(ConnectionRace, StalledAttemptIsOvertakenAfterTheDelay)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    // 192.0.2.1 (TEST-NET-1) never answers; the second attempt must start without waiting for it to time out.
+    ConnectionRace race({ "192.0.2.1", "127.0.0.1" }, port, std::chrono::milliseconds{ 20 });
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(runRace(race), ConnectionRace::Status::Connected);
+    EXPECT_EQ(race.getWinningAddress(), "127.0.0.1");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{ 5 });
+}
+
+TEST(ConnectionRace, FailsOnceEveryAddressIsRefused)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+    server.stop();
+
+    ConnectionRace race({ "127.0.0.1", "127.0.0.1" }, port);
+
+    EXPECT_EQ(runRace(race), ConnectionRace::Status::Failed);
+    EXPECT_EQ(race.getAttemptCount(), 2U);
+    EXPECT_TRUE(race.getWinningAddress().empty());
+    EXPECT_EQ(race.takeWinner(), nullptr);
+}
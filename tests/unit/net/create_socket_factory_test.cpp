@@ -43,6 +43,7 @@ namespace
             using enum ConnectionProtocol;
         case Tcp:
         case Tls:
+        case Unix:
             {
 #if REACTORMQ_WITH_O3DE
                 return "O3deSocket";
@@ -61,6 +62,8 @@ namespace
                 return "SecureSocket";
 #endif // REACTORMQ_SOCKET_WITH_WEBSOCKET_UE5
             }
+        case Quic:
+            return "QuicSocket";
         default:
             return "Unknown";
         }
@@ -97,4 +100,24 @@ TEST(SocketFactory_CreateSocket, Wss_ReturnsExpectedType)
     const auto sock = CreateSocket(settings);
     ASSERT_NE(sock, nullptr);
     EXPECT_STREQ(sock->getImplementationId(), expectedImplId(ConnectionProtocol::Wss));
-}
\ No newline at end of file
+}
+
+TEST(SocketFactory_CreateSocket, Quic_ReturnsExpectedTypeOrNothingWithoutQuicSupport)
+{
+    const auto settings = makeSettings(ConnectionProtocol::Quic);
+    const auto sock = CreateSocket(settings);
+#if REACTORMQ_WITH_QUIC
+    ASSERT_NE(sock, nullptr);
+    EXPECT_STREQ(sock->getImplementationId(), expectedImplId(ConnectionProtocol::Quic));
+#else
+    EXPECT_EQ(sock, nullptr);
+#endif // REACTORMQ_WITH_QUIC
+}
+
+TEST(SocketFactory_CreateSocket, Unix_ReturnsExpectedType)
+{
+    const auto settings = makeSettings(ConnectionProtocol::Unix);
+    const auto sock = CreateSocket(settings);
+    ASSERT_NE(sock, nullptr);
+    EXPECT_STREQ(sock->getImplementationId(), expectedImplId(ConnectionProtocol::Unix));
+}
@@ -0,0 +1,88 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SOCKET_WITH_GETADDRINFO
+
+#include "socket/host_resolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace reactormq::socket;
+
+namespace
+{
+    constexpr std::chrono::seconds kTtl{ 60 };
+
+    HostLookup::Status waitForLookup(const HostLookupPtr& lookup)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+        while (lookup->getStatus() == HostLookup::Status::Pending && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+        return lookup->getStatus();
+    }
+} // namespace
+
+TEST(HostResolver, NumericAddressResolvesWithoutALookup)
+{
+    const size_t cachedBefore = HostResolver::instance().size();
+
+    const HostLookupPtr lookup = HostResolver::instance().resolve("127.0.0.1", kTtl);
+
+    ASSERT_EQ(lookup->getStatus(), HostLookup::Status::Resolved);
+    ASSERT_EQ(lookup->getAddresses().size(), 1U);
+    EXPECT_EQ(lookup->getAddresses().front(), "127.0.0.1");
+    EXPECT_EQ(HostResolver::instance().size(), cachedBefore);
+}
+
+TEST(HostResolver, LaterResolvesReuseTheCachedAnswer)
+{
+    HostResolver::instance().forget("localhost");
+
+    const HostLookupPtr first = HostResolver::instance().resolve("localhost", kTtl);
+    ASSERT_EQ(waitForLookup(first), HostLookup::Status::Resolved);
+    EXPECT_NE(std::ranges::find(first->getAddresses(), "127.0.0.1"), first->getAddresses().end());
+
+    const HostLookupPtr second = HostResolver::instance().resolve("localhost", kTtl);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->getStatus(), HostLookup::Status::Resolved);
+}
+
+TEST(HostResolver, AnswerOlderThanTheCallersTtlIsLookedUpAgain)
+{
+    const HostLookupPtr cached = HostResolver::instance().resolve("localhost", kTtl);
+    ASSERT_EQ(waitForLookup(cached), HostLookup::Status::Resolved);
+
+    const HostLookupPtr fresh = HostResolver::instance().resolve("localhost", std::chrono::seconds::zero());
+    EXPECT_NE(fresh, cached);
+    EXPECT_EQ(waitForLookup(fresh), HostLookup::Status::Resolved);
+}
+
+TEST(HostResolver, ForgetDropsTheCachedAnswer)
+{
+    const HostLookupPtr cached = HostResolver::instance().resolve("localhost", kTtl);
+    ASSERT_EQ(waitForLookup(cached), HostLookup::Status::Resolved);
+
+    HostResolver::instance().forget("localhost");
+
+    const HostLookupPtr fresh = HostResolver::instance().resolve("localhost", kTtl);
+    EXPECT_NE(fresh, cached);
+    EXPECT_EQ(waitForLookup(fresh), HostLookup::Status::Resolved);
+}
+
+TEST(HostResolver, FailedLookupIsNotCached)
+{
+    const HostLookupPtr failed = HostResolver::instance().resolve("reactormq-test.invalid", kTtl);
+    ASSERT_EQ(waitForLookup(failed), HostLookup::Status::Failed);
+
+    const HostLookupPtr retry = HostResolver::instance().resolve("reactormq-test.invalid", kTtl);
+    EXPECT_NE(retry, failed);
+    EXPECT_EQ(waitForLookup(retry), HostLookup::Status::Failed);
+}
+
+#endif // REACTORMQ_SOCKET_WITH_GETADDRINFO
@@ -6,14 +6,22 @@
 #include "fixtures/echo_server.h"
 #include "fixtures/test_utils.h"
 #include "socket/platform/receive_flags.h"
+#include "socket/platform/wakeup_handle.h"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <string>
 #include <thread>
 #include <vector>
 
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+#include <sys/un.h>
+#include <unistd.h>
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
 using namespace reactormq::socket;
 using namespace reactormq::tests;
 
@@ -23,6 +31,88 @@ TEST(PlatformSocket, CreateAndDestroy)
     EXPECT_TRUE(socket.createSocket());
 }
 
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+TEST(PlatformSocket, CreateSocketAppliesOptions)
+{
+    reactormq::mqtt::SocketOptions options;
+    options.noDelay = false;
+    options.receiveBufferBytes = 64 * 1024;
+
+    PlatformSocket socket;
+    socket.setOptions(options);
+    ASSERT_TRUE(socket.createSocket());
+
+    int noDelay = -1;
+    socklen_t length = sizeof(noDelay);
+    ASSERT_EQ(getsockopt(socket.getSocketDescriptor(), IPPROTO_TCP, TCP_NODELAY, &noDelay, &length), 0);
+    EXPECT_EQ(noDelay, 0);
+
+    int receiveBuffer = 0;
+    length = sizeof(receiveBuffer);
+    ASSERT_EQ(getsockopt(socket.getSocketDescriptor(), SOL_SOCKET, SO_RCVBUF, &receiveBuffer, &length), 0);
+    EXPECT_GE(receiveBuffer, 64 * 1024);
+}
+
+TEST(PlatformSocket, ConnectLocalExchangesBytesOverAUnixDomainSocket)
+{
+    const std::string path = "/tmp/reactormq-test-" + std::to_string(getpid()) + ".sock";
+    ::unlink(path.c_str());
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(listener, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    ASSERT_EQ(::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(::listen(listener, 1), 0);
+
+    reactormq::mqtt::SocketOptions options;
+    options.noDelay = true;
+    PlatformSocket socket;
+    socket.setOptions(options);
+    ASSERT_EQ(socket.connectLocal(path), 0);
+    EXPECT_TRUE(socket.isConnected());
+    const int peer = ::accept(listener, nullptr, nullptr);
+    ASSERT_GE(peer, 0);
+
+    constexpr std::array<uint8_t, 4> kRequest{ 0x10, 0x02, 0x00, 0x04 };
+    size_t bytesSent = 0;
+    ASSERT_TRUE(socket.trySend(kRequest.data(), static_cast<uint32_t>(kRequest.size()), bytesSent));
+    EXPECT_EQ(bytesSent, kRequest.size());
+    std::array<uint8_t, 4> received{};
+    ASSERT_EQ(::recv(peer, received.data(), received.size(), MSG_WAITALL), static_cast<ssize_t>(received.size()));
+    EXPECT_EQ(received, kRequest);
+
+    constexpr std::array<uint8_t, 2> kReply{ 0xd0, 0x00 };
+    ASSERT_EQ(::send(peer, kReply.data(), kReply.size(), 0), static_cast<ssize_t>(kReply.size()));
+    std::array<uint8_t, 16> buffer{};
+    size_t bytesRead = 0;
+    for (int i = 0; i < 100 && bytesRead == 0; ++i)
+    {
+        ASSERT_TRUE(socket.tryReceive(buffer.data(), static_cast<int>(buffer.size()), bytesRead));
+        if (bytesRead == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    ASSERT_EQ(bytesRead, kReply.size());
+    EXPECT_EQ(std::memcmp(buffer.data(), kReply.data(), kReply.size()), 0);
+
+    socket.close();
+    ::close(peer);
+    ::close(listener);
+    ::unlink(path.c_str());
+}
+
+TEST(PlatformSocket, ConnectLocalFailsWithoutAListener)
+{
+    PlatformSocket socket;
+    EXPECT_NE(socket.connectLocal("/tmp/reactormq-test-missing.sock"), 0);
+    EXPECT_FALSE(socket.isConnected());
+    EXPECT_TRUE(socket.hasConnectFailed());
+    EXPECT_NE(socket.connectLocal(std::string(200, 'x')), 0);
+}
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
 TEST(PlatformSocket, ConnectToLocalEchoServer)
 {
     EchoServer server;
@@ -359,6 +449,54 @@ TEST(PlatformSocket, IsConnectedAfterServerDisconnect)
     socket.close();
 }
 
+TEST(PlatformSocket, TryReceiveFailsOnceThePeerClosesTheConnection)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    PlatformSocket socket;
+    ASSERT_TRUE(socket.createSocket());
+    ASSERT_EQ(socket.connect("127.0.0.1", port), 0);
+    for (int i = 0; i < 100 && !socket.isConnected(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(socket.isConnected());
+
+    // Nothing to read yet is not a failure.
+    std::vector<uint8_t> buffer(64);
+    size_t bytesRead = 0;
+    ASSERT_TRUE(socket.tryReceive(buffer.data(), static_cast<int32_t>(buffer.size()), bytesRead));
+
+    // An echo shows the server has accepted the connection, so there is one to drop.
+    const uint8_t ping = 0x2A;
+    size_t bytesSent = 0;
+    ASSERT_TRUE(socket.trySend(&ping, 1, bytesSent));
+    bytesRead = 0;
+    for (int i = 0; i < 100 && bytesRead == 0; ++i)
+    {
+        ASSERT_TRUE(socket.tryReceive(buffer.data(), static_cast<int32_t>(buffer.size()), bytesRead));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(bytesRead, 1u);
+
+    server.dropClients();
+    bool isOpen = true;
+    for (int i = 0; i < 100 && isOpen; ++i)
+    {
+        isOpen = socket.tryReceive(buffer.data(), static_cast<int32_t>(buffer.size()), bytesRead);
+        if (isOpen)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    EXPECT_FALSE(isOpen) << "An orderly close should fail the read, not look like an idle connection";
+    EXPECT_EQ(PlatformSocket::getLastErrorCode(), 0) << "An orderly close is not an error";
+    socket.close();
+}
+
 TEST(PlatformSocket, NonBlockingBehavior)
 {
     PlatformSocket socket;
@@ -506,6 +644,130 @@ TEST(PlatformSocket, LargeDataTransfer)
     EXPECT_EQ(totalBytesRead, largeSize);
     EXPECT_EQ(std::memcmp(receiveBuffer.data(), largeData.data(), largeSize), 0) << "Received data should match sent data";
 
+    socket.close();
+    server.stop();
+}
+
+TEST(PlatformSocket, SendVectoredDeliversBuffersInOrder)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    PlatformSocket socket;
+    EXPECT_TRUE(socket.createSocket());
+    EXPECT_EQ(socket.connect("127.0.0.1", port), 0);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (socket.isConnected())
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_TRUE(socket.isConnected());
+
+    const std::vector<uint8_t> header = { 0x30, 0x05, 0x00, 0x01, 't' };
+    const std::vector<uint8_t> payload = { 'a', 'b', 'c' };
+    const std::array buffers{
+        SendBuffer{ header.data(), header.size() },
+        SendBuffer{ nullptr, 0 },
+        SendBuffer{ payload.data(), payload.size() },
+    };
+
+    size_t bytesSent = 0;
+    EXPECT_TRUE(socket.trySendVectored(buffers, bytesSent));
+    EXPECT_EQ(bytesSent, header.size() + payload.size());
+
+    std::vector<uint8_t> received;
+    std::vector<uint8_t> receiveBuffer(64);
+    for (int attempt = 0; attempt < 100 && received.size() < bytesSent; ++attempt)
+    {
+        if (size_t bytesRead = 0;
+            socket.tryReceive(receiveBuffer.data(), static_cast<int32_t>(receiveBuffer.size()), bytesRead) && bytesRead > 0)
+        {
+            received.insert(received.end(), receiveBuffer.begin(), receiveBuffer.begin() + static_cast<std::ptrdiff_t>(bytesRead));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<uint8_t> expected = header;
+    expected.insert(expected.end(), payload.begin(), payload.end());
+    EXPECT_EQ(received, expected);
+
+    socket.close();
+    server.stop();
+}
+
+TEST(PlatformSocket, WaitForIoReturnsWhenWakeupSignalled)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    PlatformSocket socket;
+    EXPECT_TRUE(socket.createSocket());
+    EXPECT_EQ(socket.connect("127.0.0.1", port), 0);
+
+    for (int i = 0; i < 100 && !socket.isConnected(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(socket.isConnected());
+
+    WakeupHandle wakeup;
+    std::thread signaller(
+        [&wakeup]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            wakeup.signal();
+        });
+
+    const auto start = std::chrono::steady_clock::now();
+    socket.waitForIo(wakeup, false, std::chrono::seconds(5));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    signaller.join();
+
+    EXPECT_TRUE(wakeup.isSignalled());
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+    wakeup.reset();
+    EXPECT_FALSE(wakeup.isSignalled());
+
+    socket.close();
+    server.stop();
+}
+
+TEST(PlatformSocket, WaitForIoReturnsWhenDataArrives)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    PlatformSocket socket;
+    EXPECT_TRUE(socket.createSocket());
+    EXPECT_EQ(socket.connect("127.0.0.1", port), 0);
+
+    for (int i = 0; i < 100 && !socket.isConnected(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(socket.isConnected());
+
+    const auto testMessage = "wake";
+    size_t bytesSent = 0;
+    ASSERT_TRUE(socket.trySend(reinterpret_cast<const uint8_t*>(testMessage), 4, bytesSent));
+
+    const WakeupHandle wakeup;
+    const auto start = std::chrono::steady_clock::now();
+    socket.waitForIo(wakeup, false, std::chrono::seconds(5));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+    EXPECT_GT(socket.getPendingData(), 0);
+
     socket.close();
     server.stop();
 }
\ No newline at end of file
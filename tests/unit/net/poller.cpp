@@ -0,0 +1,184 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/platform/poller.h"
+#include "fixtures/echo_server.h"
+#include "socket/platform/platform_socket.h"
+#include "socket/platform/wakeup_handle.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace reactormq::socket;
+using namespace reactormq::tests;
+
+#if REACTORMQ_SOCKET_WITH_POSIX_SOCKET
+
+namespace
+{
+    using PollerFactory = std::function<std::unique_ptr<Poller>()>;
+
+    constexpr std::uint64_t kSocketToken = 42;
+    constexpr std::uint64_t kWakeupToken = 7;
+
+    bool connectToEchoServer(PlatformSocket& socket, const uint16_t port)
+    {
+        if (!socket.createSocket() || socket.connect("127.0.0.1", port) != 0)
+        {
+            return false;
+        }
+        for (int i = 0; i < 100 && !socket.isConnected(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return socket.isConnected();
+    }
+
+    bool hasEventFor(const std::span<const PollEvent> events, const std::uint64_t token, const PollEvents mask)
+    {
+        for (const PollEvent& event : events)
+        {
+            if (event.token == token && hasAnyEvent(event.events, mask))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+class PollerBackendTest : public ::testing::TestWithParam<PollerFactory>
+{
+protected:
+    void SetUp() override
+    {
+        m_poller = GetParam()();
+        if (nullptr == m_poller)
+        {
+            GTEST_SKIP() << "No poller backend on this platform";
+        }
+    }
+
+    std::unique_ptr<Poller> m_poller;
+    std::array<PollEvent, 16> m_events{};
+};
+
+TEST_P(PollerBackendTest, TimesOutWhenNothingIsReady)
+{
+    WakeupHandle wakeup;
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kWakeupToken));
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(m_poller->wait(m_events, std::chrono::milliseconds(20)), 0u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));
+}
+
+TEST_P(PollerBackendTest, WakeupFromAnotherThreadEndsWait)
+{
+    WakeupHandle wakeup;
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kWakeupToken));
+
+    std::thread signaller(
+        [&wakeup]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            wakeup.signal();
+        });
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t count = m_poller->wait(m_events, std::chrono::seconds(5));
+    signaller.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kWakeupToken, PollEvents::Readable));
+
+    wakeup.reset();
+    EXPECT_EQ(m_poller->wait(m_events, std::chrono::milliseconds::zero()), 0u);
+}
+
+TEST_P(PollerBackendTest, ReportsSocketReadinessWithToken)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    PlatformSocket socket;
+    ASSERT_TRUE(connectToEchoServer(socket, port));
+
+    ASSERT_TRUE(m_poller->setInterest(socket.getSocketDescriptor(), PollEvents::Writable, kSocketToken));
+    size_t count = m_poller->wait(m_events, std::chrono::seconds(2));
+    EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kSocketToken, PollEvents::Writable));
+
+    ASSERT_TRUE(m_poller->setInterest(socket.getSocketDescriptor(), PollEvents::Readable, kSocketToken));
+    EXPECT_EQ(m_poller->wait(m_events, std::chrono::milliseconds(10)), 0u);
+
+    const std::string message = "ping";
+    size_t bytesSent = 0;
+    ASSERT_TRUE(socket.trySend(reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint32_t>(message.size()), bytesSent));
+
+    count = m_poller->wait(m_events, std::chrono::seconds(2));
+    EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kSocketToken, PollEvents::Readable));
+
+    socket.close();
+    server.stop();
+}
+
+TEST_P(PollerBackendTest, UnreadDataIsReportedAgain)
+{
+    WakeupHandle wakeup;
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kWakeupToken));
+    wakeup.signal();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const size_t count = m_poller->wait(m_events, std::chrono::milliseconds(100));
+        EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kWakeupToken, PollEvents::Readable)) << "iteration " << i;
+    }
+}
+
+TEST_P(PollerBackendTest, RemoveIgnoresStaleToken)
+{
+    WakeupHandle wakeup;
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kWakeupToken));
+    wakeup.signal();
+
+    m_poller->remove(wakeup.getReadDescriptor(), kSocketToken);
+    EXPECT_EQ(m_poller->getRegisteredCount(), 1u);
+    size_t count = m_poller->wait(m_events, std::chrono::milliseconds(100));
+    EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kWakeupToken, PollEvents::Readable));
+
+    m_poller->remove(wakeup.getReadDescriptor(), kWakeupToken);
+    EXPECT_EQ(m_poller->getRegisteredCount(), 0u);
+    count = m_poller->wait(m_events, std::chrono::milliseconds(10));
+    EXPECT_FALSE(hasEventFor(std::span{ m_events.data(), count }, kWakeupToken, PollEvents::Readable));
+}
+
+TEST_P(PollerBackendTest, ReRegisteringUnderNewTokenReportsNewToken)
+{
+    WakeupHandle wakeup;
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kWakeupToken));
+    ASSERT_TRUE(m_poller->setInterest(wakeup.getReadDescriptor(), PollEvents::Readable, kSocketToken));
+    wakeup.signal();
+
+    const size_t count = m_poller->wait(m_events, std::chrono::milliseconds(100));
+    EXPECT_TRUE(hasEventFor(std::span{ m_events.data(), count }, kSocketToken, PollEvents::Readable));
+    EXPECT_FALSE(hasEventFor(std::span{ m_events.data(), count }, kWakeupToken, PollEvents::Readable));
+}
+
+INSTANTIATE_TEST_SUITE_P(Default, PollerBackendTest, ::testing::Values(PollerFactory{ &createPoller }));
+
+#if REACTORMQ_SOCKET_WITH_POLL
+INSTANTIATE_TEST_SUITE_P(Poll, PollerBackendTest, ::testing::Values(PollerFactory{ &createPollPoller }));
+#endif // REACTORMQ_SOCKET_WITH_POLL
+
+#if REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
+INSTANTIATE_TEST_SUITE_P(IoUring, PollerBackendTest, ::testing::Values(PollerFactory{ &createIoUringPoller }));
+#endif // REACTORMQ_PLATFORM_LINUX && REACTORMQ_SOCKET_WITH_IO_URING
+
+#endif // REACTORMQ_SOCKET_WITH_POSIX_SOCKET
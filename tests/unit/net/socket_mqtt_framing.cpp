@@ -8,10 +8,15 @@
 #include "reactormq/mqtt/credentials.h"
 #include "socket/socket.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <span>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -29,6 +34,71 @@ namespace
             return Credentials{};
         }
     };
+
+    /// Socket with no transport; feed() pushes bytes through the same framing a real read does.
+    class FramingSocket final : public Socket
+    {
+    public:
+        explicit FramingSocket(ConnectionSettingsPtr settings)
+            : Socket(std::move(settings))
+        {
+        }
+
+        bool feed(const std::vector<uint8_t>& bytes)
+        {
+            return processPacketData(bytes.data(), bytes.size());
+        }
+
+        bool dispatchBacklog()
+        {
+            return commitReceiveBuffer(0);
+        }
+
+        void connect() override
+        {
+        }
+
+        void disconnect() override
+        {
+        }
+
+        void close(int32_t /*code*/, const std::string& /*reason*/) override
+        {
+        }
+
+        [[nodiscard]] bool isConnected() const override
+        {
+            return true;
+        }
+
+        void send(const uint8_t* /*data*/, uint32_t /*size*/) override
+        {
+        }
+
+        OnConnectCallback& getOnConnectCallback() override
+        {
+            return m_onConnect;
+        }
+
+        OnDisconnectCallback& getOnDisconnectCallback() override
+        {
+            return m_onDisconnect;
+        }
+
+        OnDataReceivedCallback& getOnDataReceivedCallback() override
+        {
+            return m_onData;
+        }
+
+        void tick() override
+        {
+        }
+
+    private:
+        OnConnectCallback m_onConnect;
+        OnDisconnectCallback m_onDisconnect;
+        OnDataReceivedCallback m_onData;
+    };
 } // namespace
 
 TEST(NativeSocket_MqttFraming, SingleCompletePacket)
@@ -57,10 +127,10 @@ TEST(NativeSocket_MqttFraming, SingleCompletePacket)
             connected.store(success);
         });
     auto dataHandle = sock->getOnDataReceivedCallback().add(
-        [&recvMutex, &receivedPackets](const uint8_t* data, const uint32_t size)
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
         {
             std::scoped_lock lock(recvMutex);
-            receivedPackets.emplace_back(data, data + size);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
         });
 
     sock->connect();
@@ -92,6 +162,76 @@ TEST(NativeSocket_MqttFraming, SingleCompletePacket)
     server.stop();
 }
 
+TEST(NativeSocket_MqttFraming, FrameCarriesDecodedFixedHeader)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<InboundFrame> headers;
+    std::vector<std::vector<uint8_t>> bodies;
+    std::mutex recvMutex;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&recvMutex, &headers, &bodies](const InboundFrame& frame)
+        {
+            std::scoped_lock lock(recvMutex);
+            headers.push_back(InboundFrame{ {}, frame.typeAndFlags, frame.remainingLength, frame.headerSize });
+            bodies.emplace_back(frame.getBody().begin(), frame.getBody().end());
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    // QoS 1 PUBLISH whose 200-byte Remaining Length takes two bytes.
+    std::vector<uint8_t> packet{ 0x32, 0xC8, 0x01 };
+    for (int i = 0; i < 200; ++i)
+    {
+        packet.push_back(static_cast<uint8_t>(i));
+    }
+    sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+
+    for (int i = 0; i < 50; ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::scoped_lock lock(recvMutex);
+        if (!headers.empty())
+        {
+            break;
+        }
+    }
+
+    {
+        std::scoped_lock lock(recvMutex);
+        ASSERT_EQ(headers.size(), 1u);
+        EXPECT_EQ(headers[0].typeAndFlags, 0x32);
+        EXPECT_EQ(headers[0].remainingLength, 200u);
+        EXPECT_EQ(headers[0].headerSize, 3u);
+        EXPECT_TRUE(std::equal(bodies[0].begin(), bodies[0].end(), packet.begin() + 3, packet.end()));
+    }
+
+    sock->disconnect();
+    server.stop();
+}
+
 TEST(NativeSocket_MqttFraming, TwoConsecutivePackets)
 {
     EchoServer server;
@@ -118,10 +258,10 @@ TEST(NativeSocket_MqttFraming, TwoConsecutivePackets)
             connected.store(success);
         });
     auto dataHandle = sock->getOnDataReceivedCallback().add(
-        [&recvMutex, &receivedPackets](const uint8_t* data, const uint32_t size)
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
         {
             std::scoped_lock lock(recvMutex);
-            receivedPackets.emplace_back(data, data + size);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
         });
 
     sock->connect();
@@ -187,10 +327,10 @@ TEST(NativeSocket_MqttFraming, FragmentedPacket)
             connected.store(success);
         });
     auto dataHandle = sock->getOnDataReceivedCallback().add(
-        [&recvMutex, &receivedPackets](const uint8_t* data, const uint32_t size)
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
         {
             std::scoped_lock lock(recvMutex);
-            receivedPackets.emplace_back(data, data + size);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
         });
 
     sock->connect();
@@ -233,4 +373,640 @@ TEST(NativeSocket_MqttFraming, FragmentedPacket)
 
     sock->disconnect();
     server.stop();
-}
\ No newline at end of file
+}
+TEST(NativeSocket_MqttFraming, BurstLargerThanKernelBufferIsQueuedAndDelivered)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<std::vector<uint8_t>> receivedPackets;
+    std::mutex recvMutex;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
+        {
+            std::scoped_lock lock(recvMutex);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    constexpr size_t kPacketCount = 32;
+    constexpr uint32_t kRemainingLength = 256 * 1024;
+
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < kPacketCount; ++i)
+    {
+        std::vector<uint8_t> packet;
+        packet.push_back(0x30);
+        uint32_t value = kRemainingLength;
+        do
+        {
+            uint8_t encodedByte = value % 128;
+            value /= 128;
+            if (value > 0)
+            {
+                encodedByte |= 0x80;
+            }
+            packet.push_back(encodedByte);
+        }
+        while (value > 0);
+        packet.resize(packet.size() + kRemainingLength, static_cast<uint8_t>(i));
+        packets.push_back(std::move(packet));
+    }
+
+    // Hold the peer so the kernel buffers fill and the remainder of the burst has to be queued.
+    server.setPaused(true);
+    for (const auto& packet : packets)
+    {
+        sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+    }
+
+    ASSERT_TRUE(sock->isConnected());
+    EXPECT_GT(sock->getPendingSendBytes(), 0u);
+    EXPECT_FALSE(sock->isWritable());
+    server.setPaused(false);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        sock->tick();
+        std::scoped_lock lock(recvMutex);
+        if (receivedPackets.size() == kPacketCount)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(sock->getPendingSendBytes(), 0u);
+    {
+        std::scoped_lock lock(recvMutex);
+        ASSERT_EQ(receivedPackets.size(), kPacketCount);
+        for (size_t i = 0; i < kPacketCount; ++i)
+        {
+            ASSERT_EQ(receivedPackets[i].size(), packets[i].size());
+            EXPECT_TRUE(std::memcmp(receivedPackets[i].data(), packets[i].data(), packets[i].size()) == 0);
+        }
+    }
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, ControlPacketOvertakesQueuedDataPackets)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<std::vector<uint8_t>> receivedPackets;
+    std::mutex recvMutex;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
+        {
+            std::scoped_lock lock(recvMutex);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    constexpr size_t kPacketCount = 32;
+    constexpr uint32_t kRemainingLength = 256 * 1024;
+
+    std::vector<uint8_t> packet{ 0x30, 0x80, 0x80, 0x10 };
+    packet.resize(packet.size() + kRemainingLength, 0xAB);
+
+    server.setPaused(true);
+    for (size_t i = 0; i < kPacketCount; ++i)
+    {
+        sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+    }
+    ASSERT_GT(sock->getPendingSendBytes(), kRemainingLength);
+
+    constexpr std::array pingReq{ std::byte{ 0xC0 }, std::byte{ 0x00 } };
+    sock->sendControl(pingReq);
+    server.setPaused(false);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        sock->tick();
+        std::scoped_lock lock(recvMutex);
+        if (receivedPackets.size() == kPacketCount + 1)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    {
+        std::scoped_lock lock(recvMutex);
+        ASSERT_EQ(receivedPackets.size(), kPacketCount + 1);
+        const auto ping = std::ranges::find(receivedPackets, std::vector<uint8_t>{ 0xC0, 0x00 });
+        ASSERT_NE(ping, receivedPackets.end());
+        EXPECT_LT(ping - receivedPackets.begin(), static_cast<std::ptrdiff_t>(kPacketCount));
+        EXPECT_EQ(std::ranges::count(receivedPackets, packet), static_cast<std::ptrdiff_t>(kPacketCount));
+    }
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, CoalescedSendsAreHeldUntilFlushed)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .setOutboundCoalesceMaxDelayMs(60000)
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<std::vector<uint8_t>> receivedPackets;
+    std::mutex recvMutex;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
+        {
+            std::scoped_lock lock(recvMutex);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    const auto packet = buildMqttConnectPacket();
+    sock->beginCoalescing();
+    sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+    sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+    EXPECT_EQ(sock->getPendingSendBytes(), 2 * packet.size());
+
+    sock->flushCoalesced();
+    EXPECT_EQ(sock->getPendingSendBytes(), 0u);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::scoped_lock lock(recvMutex);
+        if (receivedPackets.size() >= 2)
+        {
+            break;
+        }
+    }
+
+    {
+        std::scoped_lock lock(recvMutex);
+        ASSERT_EQ(receivedPackets.size(), 2u);
+        EXPECT_EQ(receivedPackets[0], packet);
+        EXPECT_EQ(receivedPackets[1], packet);
+    }
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, SendLargerThanCoalescingCapIsWrittenImmediately)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .setOutboundCoalesceMaxBytes(4)
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    const auto packet = buildMqttConnectPacket();
+    ASSERT_GT(packet.size(), 4u);
+    sock->beginCoalescing();
+    sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+    EXPECT_EQ(sock->getPendingSendBytes(), 0u);
+    sock->flushCoalesced();
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, InboundBudgetLeavesFramesForLaterTicks)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .setMaxInboundPacketsPerTick(2)
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    size_t received = 0;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&received](const InboundFrame& /*frame*/)
+        {
+            ++received;
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    constexpr size_t kPacketCount = 5;
+    std::vector<uint8_t> combined;
+    for (size_t i = 0; i < kPacketCount; ++i)
+    {
+        const auto packet = buildMqttConnectPacket();
+        combined.insert(combined.end(), packet.begin(), packet.end());
+    }
+    sock->send(combined.data(), static_cast<uint32_t>(combined.size()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    size_t mostPerTick = 0;
+    bool sawBacklog = false;
+    for (int i = 0; i < 100 && received < kPacketCount; ++i)
+    {
+        const size_t before = received;
+        sock->tick();
+        mostPerTick = std::max(mostPerTick, received - before);
+        sawBacklog = sawBacklog || sock->getInboundBacklogBytes() > 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_EQ(received, kPacketCount);
+    EXPECT_LE(mostPerTick, 2u);
+    EXPECT_TRUE(sawBacklog);
+    EXPECT_EQ(sock->getInboundBacklogBytes(), 0u);
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, PausedReceiveHoldsFramesUntilResumed)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings = ConnectionSettingsBuilder{}
+                              .setHost("127.0.0.1")
+                              .setPort(port)
+                              .setProtocol(ConnectionProtocol::Tcp)
+                              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+                              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    size_t received = 0;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    // Pause from inside the handler, as a full delivery queue does; the frames behind it stay buffered.
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&received, &sock](const InboundFrame& /*frame*/)
+        {
+            ++received;
+            sock->setReceivePaused(true);
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    constexpr size_t kPacketCount = 3;
+    std::vector<uint8_t> combined;
+    for (size_t i = 0; i < kPacketCount; ++i)
+    {
+        const auto packet = buildMqttConnectPacket();
+        combined.insert(combined.end(), packet.begin(), packet.end());
+    }
+    sock->send(combined.data(), static_cast<uint32_t>(combined.size()));
+
+    for (int i = 0; i < 100 && received == 0; ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(received, 1u);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        sock->tick();
+    }
+    EXPECT_EQ(received, 1u);
+    EXPECT_FALSE(sock->getPollRegistration().hasBufferedInput);
+
+    for (int i = 0; i < 100 && received < kPacketCount; ++i)
+    {
+        sock->setReceivePaused(false);
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(received, kPacketCount);
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, PublishOverStreamingThresholdArrivesInFragments)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings = ConnectionSettingsBuilder{}
+                              .setHost("127.0.0.1")
+                              .setPort(port)
+                              .setProtocol(ConnectionProtocol::Tcp)
+                              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+                              .setInboundStreamingThreshold(1024)
+                              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<InboundFrame> fragments;
+    std::vector<uint8_t> streamed;
+    std::vector<std::vector<uint8_t>> wholePackets;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&fragments, &streamed, &wholePackets](const InboundFrame& frame)
+        {
+            if (!frame.isFragment)
+            {
+                wholePackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
+                return;
+            }
+            fragments.push_back(frame);
+            fragments.back().bytes = {};
+            EXPECT_EQ(frame.fragmentOffset, streamed.size());
+            streamed.insert(streamed.end(), frame.bytes.begin(), frame.bytes.end());
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    // QoS 0 PUBLISH of 100000 bytes, then a CONNECT small enough to come whole.
+    constexpr uint32_t kRemainingLength = 100000;
+    std::vector<uint8_t> publish{ 0x30, 0xA0, 0x8D, 0x06, 0x00, 0x01, 'a' };
+    while (publish.size() < 4 + kRemainingLength)
+    {
+        publish.push_back(static_cast<uint8_t>(publish.size()));
+    }
+    const auto connect = buildMqttConnectPacket();
+    std::vector<uint8_t> combined = publish;
+    combined.insert(combined.end(), connect.begin(), connect.end());
+    sock->send(combined.data(), static_cast<uint32_t>(combined.size()));
+
+    for (int i = 0; i < 200 && wholePackets.empty(); ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_FALSE(fragments.empty());
+    EXPECT_EQ(streamed, publish);
+    EXPECT_EQ(fragments.front().typeAndFlags, 0x30);
+    EXPECT_EQ(fragments.front().remainingLength, kRemainingLength);
+    EXPECT_EQ(fragments.front().headerSize, 4u);
+    ASSERT_EQ(wholePackets.size(), 1u);
+    EXPECT_EQ(wholePackets[0], connect);
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, PacketTapSeesEachWriteAndEachReceivedPacket)
+{
+    class RecordingTap final : public IPacketTap
+    {
+    public:
+        void onPacket(const PacketDirection direction, const std::span<const std::span<const uint8_t>> parts, const size_t originalSize)
+            override
+        {
+            std::vector<uint8_t> bytes;
+            for (const auto part : parts)
+            {
+                bytes.insert(bytes.end(), part.begin(), part.end());
+            }
+            EXPECT_EQ(bytes.size(), originalSize);
+            std::scoped_lock lock(mutex);
+            (direction == PacketDirection::Sent ? sent : received).push_back(std::move(bytes));
+        }
+
+        std::mutex mutex;
+        std::vector<std::vector<uint8_t>> sent;
+        std::vector<std::vector<uint8_t>> received;
+    };
+
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+    const auto tap = std::make_shared<RecordingTap>();
+    sock->setPacketTap(tap);
+
+    std::atomic connected{ false };
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+
+    sock->connect();
+    tickUntilConnected(sock, 100);
+    ASSERT_TRUE(connected.load());
+
+    // Two packets in one write: one tapped send, two tapped received packets once they are echoed back.
+    const auto packet = buildMqttConnectPacket();
+    std::vector<uint8_t> combined(packet.begin(), packet.end());
+    combined.insert(combined.end(), packet.begin(), packet.end());
+    sock->send(combined.data(), static_cast<uint32_t>(combined.size()));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::scoped_lock lock(tap->mutex);
+        if (tap->received.size() >= 2)
+        {
+            break;
+        }
+    }
+
+    {
+        std::scoped_lock lock(tap->mutex);
+        ASSERT_EQ(tap->sent.size(), 1u);
+        EXPECT_EQ(tap->sent[0], combined);
+        ASSERT_EQ(tap->received.size(), 2u);
+        EXPECT_TRUE(std::equal(packet.begin(), packet.end(), tap->received[0].begin(), tap->received[0].end()));
+        EXPECT_TRUE(std::equal(packet.begin(), packet.end(), tap->received[1].begin(), tap->received[1].end()));
+    }
+
+    sock->disconnect();
+    server.stop();
+}
+
+TEST(NativeSocket_MqttFraming, ReadIsDeliveredInBatchesThatAPauseCanCutShort)
+{
+    FramingSocket sock(ConnectionSettingsBuilder{}.setHost("127.0.0.1").build());
+
+    // 40 PUBACKs with packet IDs 1..40.
+    std::vector<uint8_t> read;
+    for (uint8_t id = 1; id <= 40; ++id)
+    {
+        read.insert(read.end(), { 0x40, 0x02, 0x00, id });
+    }
+
+    std::vector<size_t> batchSizes;
+    std::vector<uint8_t> packetIds;
+    size_t pauseAfter = 0;
+    auto batchHandle = sock.getOnDataReceivedBatchCallback().add(
+        [&](const std::span<const InboundFrame> frames, size_t& handled)
+        {
+            batchSizes.push_back(frames.size());
+            for (const InboundFrame& frame : frames)
+            {
+                packetIds.push_back(frame.bytes[3]);
+                if (packetIds.size() == pauseAfter)
+                {
+                    sock.setReceivePaused(true);
+                    handled = static_cast<size_t>(&frame - frames.data()) + 1;
+                    return;
+                }
+            }
+        });
+    auto dataHandle = sock.getOnDataReceivedCallback().add(
+        [](const InboundFrame& /*frame*/)
+        {
+            ADD_FAILURE() << "per-packet listeners are skipped while a batch listener is attached";
+        });
+
+    ASSERT_TRUE(sock.feed(read));
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{ 32, 8 }));
+    ASSERT_EQ(packetIds.size(), 40u);
+    for (uint8_t id = 1; id <= 40; ++id)
+    {
+        EXPECT_EQ(packetIds[id - 1], id);
+    }
+
+    // Pausing after the third packet leaves the other 37 buffered until receiving resumes.
+    batchSizes.clear();
+    packetIds.clear();
+    pauseAfter = 3;
+    ASSERT_TRUE(sock.feed(read));
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{ 32 }));
+    EXPECT_TRUE(sock.hasInboundBacklog());
+    EXPECT_EQ(sock.getInboundBacklogBytes(), 37u * 4u);
+
+    sock.setReceivePaused(false);
+    ASSERT_TRUE(sock.dispatchBacklog());
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{ 32, 32, 5 }));
+    ASSERT_EQ(packetIds.size(), 40u);
+    EXPECT_EQ(packetIds[3], 4u);
+    EXPECT_EQ(packetIds.back(), 40u);
+    EXPECT_FALSE(sock.hasInboundBacklog());
+
+    // The packets ahead of a malformed Remaining Length are still delivered before the read fails.
+    batchSizes.clear();
+    EXPECT_FALSE(sock.feed({ 0xC0, 0x00, 0x30, 0xFF, 0xFF, 0xFF, 0xFF }));
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{ 1 }));
+}
@@ -100,10 +100,10 @@ TEST(SocketRunnable, SendsAndReceivesData)
             connected.store(success);
         });
     auto dataHandle = socket->getOnDataReceivedCallback().add(
-        [&recvMutex, &receivedPackets](const uint8_t* data, const uint32_t size)
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
         {
             std::scoped_lock lock(recvMutex);
-            receivedPackets.emplace_back(data, data + size);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
         });
 
     socket->connect();
@@ -162,10 +162,10 @@ TEST(SocketRunnable, HandlesMultiplePackets)
             connected.store(success);
         });
     auto dataHandle = socket->getOnDataReceivedCallback().add(
-        [&recvMutex, &receivedPackets](const uint8_t* data, const uint32_t size)
+        [&recvMutex, &receivedPackets](const InboundFrame& frame)
         {
             std::scoped_lock lock(recvMutex);
-            receivedPackets.emplace_back(data, data + size);
+            receivedPackets.emplace_back(frame.bytes.begin(), frame.bytes.end());
         });
 
     socket->connect();
@@ -324,4 +324,85 @@ TEST(SocketRunnable, StopsThreadAutomatically)
     EXPECT_FALSE(runnable.isRunning());
 
     server.stop();
-}
\ No newline at end of file
+}
+TEST(SocketRunnable, ReportsRefusedConnect)
+{
+    EchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+    server.stop();
+
+    auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    std::atomic reported{ false };
+    std::atomic connected{ false };
+
+    SocketRunnable runnable(settings);
+    auto socket = runnable.getSocket();
+
+    auto connectHandle = socket->getOnConnectCallback().add(
+        [&reported, &connected](const bool success)
+        {
+            connected.store(success);
+            reported.store(true);
+        });
+    socket->connect();
+
+    // Well inside the 30 second socket connection timeout: the refusal itself ends the connect.
+    waitForCondition(
+        [&reported]
+        {
+            return reported.load();
+        },
+        300);
+
+    EXPECT_TRUE(reported.load());
+    EXPECT_FALSE(connected.load());
+
+    runnable.stop();
+}
+
+TEST(SocketRunnable, GivesUpOnConnectAfterTheSocketConnectionTimeout)
+{
+    // 192.0.2.1 (TEST-NET-1) never answers, so only the timeout (or an unreachable network) ends the connect.
+    auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("192.0.2.1")
+              .setPort(1883)
+              .setProtocol(ConnectionProtocol::Tcp)
+              .setSocketConnectionTimeoutSeconds(1)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    std::atomic reported{ false };
+    std::atomic connected{ false };
+
+    SocketRunnable runnable(settings);
+    auto socket = runnable.getSocket();
+
+    auto connectHandle = socket->getOnConnectCallback().add(
+        [&reported, &connected](const bool success)
+        {
+            connected.store(success);
+            reported.store(true);
+        });
+    socket->connect();
+
+    waitForCondition(
+        [&reported]
+        {
+            return reported.load();
+        },
+        300);
+
+    EXPECT_TRUE(reported.load());
+    EXPECT_FALSE(connected.load());
+
+    runnable.stop();
+}
@@ -0,0 +1,240 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+
+#include "socket/platform/tls_context_cache.h"
+
+#include <ctime>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+using namespace reactormq::socket;
+
+namespace
+{
+    SSL_SESSION* makeSession(const int version, const unsigned char id, const long lifetimeSeconds = 300)
+    {
+        SSL_SESSION* session = SSL_SESSION_new();
+        const unsigned char sessionId[1] = { id };
+        SSL_SESSION_set1_id(session, sessionId, sizeof(sessionId));
+        SSL_SESSION_set_protocol_version(session, version);
+        SSL_SESSION_set_time(session, static_cast<long>(std::time(nullptr)));
+        SSL_SESSION_set_timeout(session, lifetimeSeconds);
+        return session;
+    }
+
+    unsigned char getSessionId(const SSL_SESSION* session)
+    {
+        unsigned int length = 0;
+        const unsigned char* id = SSL_SESSION_get_id(session, &length);
+        return length == 1 ? id[0] : 0;
+    }
+} // namespace
+
+TEST(TlsContextCache, ClientsWithTheSameSettingsShareOneContext)
+{
+    const SslContextPtr first = TlsContextCache::instance().acquire(TlsContextKey{ true });
+    const SslContextPtr second = TlsContextCache::instance().acquire(TlsContextKey{ true });
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST(TlsContextCache, DifferentSettingsGetDifferentContexts)
+{
+    const SslContextPtr verifying = TlsContextCache::instance().acquire(TlsContextKey{ true });
+    const SslContextPtr trusting = TlsContextCache::instance().acquire(TlsContextKey{ false });
+    ASSERT_NE(verifying, nullptr);
+    ASSERT_NE(trusting, nullptr);
+    EXPECT_NE(verifying.get(), trusting.get());
+}
+
+TEST(TlsContextCache, ContextIsFreedWithItsLastUserAndRebuiltOnDemand)
+{
+    std::weak_ptr<SSL_CTX> released;
+    {
+        const SslContextPtr context = TlsContextCache::instance().acquire(TlsContextKey{ false });
+        ASSERT_NE(context, nullptr);
+        released = context;
+    }
+    EXPECT_TRUE(released.expired());
+
+    const SslContextPtr rebuilt = TlsContextCache::instance().acquire(TlsContextKey{ false });
+    EXPECT_NE(rebuilt, nullptr);
+}
+
+TEST(TlsContextCache, SslObjectsKeepTheSharedContextAlive)
+{
+    std::weak_ptr<SSL_CTX> shared;
+    SSL* ssl = nullptr;
+    {
+        const SslContextPtr context = TlsContextCache::instance().acquire(TlsContextKey{ false });
+        ASSERT_NE(context, nullptr);
+        shared = context;
+        ssl = SSL_new(context.get());
+        ASSERT_NE(ssl, nullptr);
+    }
+
+    // OpenSSL holds its own reference for the SSL, so the context outlives the cache's last shared_ptr.
+    EXPECT_TRUE(shared.expired());
+    EXPECT_NE(SSL_get_SSL_CTX(ssl), nullptr);
+    SSL_free(ssl);
+}
+
+TEST(TlsSessionStore, SessionsAreKeptPerPeer)
+{
+    TlsSessionStore store;
+    store.save("a:8883", makeSession(TLS1_2_VERSION, 1));
+    store.save("b:8883", makeSession(TLS1_2_VERSION, 2));
+    EXPECT_EQ(store.take("c:8883"), nullptr);
+
+    SSL_SESSION* session = store.take("b:8883");
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(getSessionId(session), 2);
+    SSL_SESSION_free(session);
+}
+
+TEST(TlsSessionStore, Tls12SessionIsOfferedUntilReplaced)
+{
+    TlsSessionStore store;
+    store.save("broker:8883", makeSession(TLS1_2_VERSION, 1));
+    for (int i = 0; i < 2; ++i)
+    {
+        SSL_SESSION* session = store.take("broker:8883");
+        ASSERT_NE(session, nullptr);
+        EXPECT_EQ(getSessionId(session), 1);
+        SSL_SESSION_free(session);
+    }
+
+    store.save("broker:8883", makeSession(TLS1_2_VERSION, 2));
+    SSL_SESSION* session = store.take("broker:8883");
+    ASSERT_NE(session, nullptr);
+    EXPECT_EQ(getSessionId(session), 2);
+    SSL_SESSION_free(session);
+    EXPECT_EQ(store.size(), 1u);
+}
+
+TEST(TlsSessionStore, Tls13TicketIsOfferedOnce)
+{
+    TlsSessionStore store;
+    store.save("broker:8883", makeSession(TLS1_3_VERSION, 1));
+
+    SSL_SESSION* session = store.take("broker:8883");
+    ASSERT_NE(session, nullptr);
+    SSL_SESSION_free(session);
+    EXPECT_EQ(store.take("broker:8883"), nullptr);
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST(TlsSessionStore, ExpiredSessionIsDropped)
+{
+    TlsSessionStore store;
+    SSL_SESSION* expired = makeSession(TLS1_2_VERSION, 1);
+    SSL_SESSION_set_time(expired, static_cast<long>(std::time(nullptr)) - 600);
+    store.save("broker:8883", expired);
+
+    EXPECT_EQ(store.take("broker:8883"), nullptr);
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST(TlsSessionStore, SessionWithoutIdOrTicketIsDropped)
+{
+    TlsSessionStore store;
+    SSL_SESSION* unresumable = SSL_SESSION_new();
+    SSL_SESSION_set_protocol_version(unresumable, TLS1_2_VERSION);
+    SSL_SESSION_set_time(unresumable, static_cast<long>(std::time(nullptr)));
+    SSL_SESSION_set_timeout(unresumable, 300);
+    store.save("broker:8883", unresumable);
+
+    EXPECT_EQ(store.take("broker:8883"), nullptr);
+}
+
+TEST(TlsSessionStore, NumberOfPeersIsCapped)
+{
+    TlsSessionStore store;
+    for (size_t i = 0; i < TlsSessionStore::kMaxPeers + 10; ++i)
+    {
+        store.save("broker-" + std::to_string(i) + ":8883", makeSession(TLS1_2_VERSION, 1));
+    }
+    EXPECT_EQ(store.size(), TlsSessionStore::kMaxPeers);
+}
+
+TEST(VerifiedChainCache, VerificationsAreKeptPerPeerAndLeaf)
+{
+    VerifiedChainCache cache;
+    const std::time_t now = std::time(nullptr);
+    const VerifiedChainCache::Fingerprint leaf{ 1 };
+    const VerifiedChainCache::Fingerprint otherLeaf{ 2 };
+    cache.remember("broker-a:8883", leaf, nullptr, now + 86400, now);
+
+    EXPECT_TRUE(cache.contains("broker-a:8883", leaf, nullptr, now));
+    EXPECT_FALSE(cache.contains("broker-a:8883", otherLeaf, nullptr, now));
+    EXPECT_FALSE(cache.contains("broker-b:8883", leaf, nullptr, now));
+}
+
+TEST(VerifiedChainCache, VerificationCountsOnlyForTheVerifierThatAcceptedIt)
+{
+    VerifiedChainCache cache;
+    const std::time_t now = std::time(nullptr);
+    const VerifiedChainCache::Fingerprint leaf{ 1 };
+    auto verifier = std::make_shared<int>(1);
+    cache.remember("broker:8883", leaf, verifier, now + 86400, now);
+
+    EXPECT_TRUE(cache.contains("broker:8883", leaf, verifier, now));
+    EXPECT_FALSE(cache.contains("broker:8883", leaf, nullptr, now));
+    EXPECT_FALSE(cache.contains("broker:8883", leaf, std::make_shared<int>(1), now));
+
+    // Settings freed and replaced by new ones, even at the same address, never inherit the verdict.
+    verifier.reset();
+    verifier = std::make_shared<int>(1);
+    EXPECT_FALSE(cache.contains("broker:8883", leaf, verifier, now));
+
+    cache.remember("broker:8883", leaf, nullptr, now + 86400, now);
+    EXPECT_FALSE(cache.contains("broker:8883", leaf, verifier, now));
+    EXPECT_TRUE(cache.contains("broker:8883", leaf, nullptr, now));
+}
+
+TEST(VerifiedChainCache, VerificationExpiresWithTheCertificateOrTheMaximumAge)
+{
+    VerifiedChainCache cache;
+    const std::time_t now = std::time(nullptr);
+    const std::time_t maxAge = VerifiedChainCache::kMaxAge.count();
+    const VerifiedChainCache::Fingerprint shortLived{ 1 };
+    const VerifiedChainCache::Fingerprint longLived{ 2 };
+    const VerifiedChainCache::Fingerprint expired{ 3 };
+    cache.remember("broker:8883", shortLived, nullptr, now + 30, now);
+    cache.remember("broker:8883", longLived, nullptr, now + 86400, now);
+    cache.remember("broker:8883", expired, nullptr, now, now);
+
+    EXPECT_TRUE(cache.contains("broker:8883", shortLived, nullptr, now + 29));
+    EXPECT_FALSE(cache.contains("broker:8883", shortLived, nullptr, now + 30));
+    EXPECT_TRUE(cache.contains("broker:8883", longLived, nullptr, now + maxAge - 1));
+    EXPECT_FALSE(cache.contains("broker:8883", longLived, nullptr, now + maxAge));
+    EXPECT_FALSE(cache.contains("broker:8883", expired, nullptr, now));
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(VerifiedChainCache, NumberOfVerificationsIsCapped)
+{
+    VerifiedChainCache cache;
+    const std::time_t now = std::time(nullptr);
+    for (size_t i = 0; i < VerifiedChainCache::kMaxEntries + 10; ++i)
+    {
+        cache.remember("broker-" + std::to_string(i) + ":8883", VerifiedChainCache::Fingerprint{ 1 }, nullptr, now + 86400, now);
+    }
+    EXPECT_EQ(cache.size(), VerifiedChainCache::kMaxEntries);
+}
+
+TEST(TlsContextCache, ResumptionNeedsACachedContext)
+{
+    SSL_CTX* foreign = SSL_CTX_new(TLS_client_method());
+    SSL* ssl = SSL_new(foreign);
+    const std::string peer = "broker:8883";
+    EXPECT_FALSE(TlsContextCache::instance().prepareResumption(ssl, peer));
+    SSL_free(ssl);
+    SSL_CTX_free(foreign);
+}
+
+#endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
@@ -0,0 +1,133 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/tls_tuning.h"
+
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+#include "socket/platform/tls_context_cache.h"
+#endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace reactormq::socket;
+using reactormq::mqtt::TlsCipherPreference;
+using reactormq::mqtt::TlsTuningOptions;
+
+namespace
+{
+    TlsTuningOptions makeDynamicSizing()
+    {
+        TlsTuningOptions options;
+        options.dynamicRecordSizing = true;
+        options.initialRecordSize = 1400;
+        options.growAfterBytes = 10000;
+        options.idleResetMs = 1000;
+        return options;
+    }
+} // namespace
+
+TEST(TlsTuning, RecordsStartSmallAndGrowOnceTheBurstHasSentEnough)
+{
+    TlsRecordSizer sizer{ makeDynamicSizing() };
+    ASSERT_TRUE(sizer.isEnabled());
+
+    auto now = TlsRecordSizer::Clock::time_point{} + std::chrono::hours(1);
+    EXPECT_EQ(sizer.getRecordSize(now), 1400u);
+    for (int i = 0; i < 9; ++i)
+    {
+        sizer.onSent(1000, now);
+        now += std::chrono::milliseconds(10);
+        EXPECT_EQ(sizer.getRecordSize(now), 1400u);
+    }
+    sizer.onSent(1000, now);
+    EXPECT_EQ(sizer.getRecordSize(now), kMaxTlsRecordSize);
+}
+
+TEST(TlsTuning, IdleConnectionStartsSmallAgain)
+{
+    TlsRecordSizer sizer{ makeDynamicSizing() };
+    auto now = TlsRecordSizer::Clock::time_point{} + std::chrono::hours(1);
+    sizer.onSent(20000, now);
+    EXPECT_EQ(sizer.getRecordSize(now + std::chrono::milliseconds(999)), kMaxTlsRecordSize);
+
+    now += std::chrono::milliseconds(1000);
+    EXPECT_EQ(sizer.getRecordSize(now), 1400u);
+    sizer.onSent(100, now);
+    EXPECT_EQ(sizer.getRecordSize(now), 1400u);
+}
+
+TEST(TlsTuning, RecordSizesStayWithinTheFragmentLengthAndTheProtocolLimits)
+{
+    TlsTuningOptions options = makeDynamicSizing();
+    options.maxFragmentLength = 1024;
+    TlsRecordSizer capped{ options };
+    const auto now = TlsRecordSizer::Clock::time_point{} + std::chrono::hours(1);
+    EXPECT_EQ(capped.getRecordSize(now), 1024u);
+    capped.onSent(20000, now);
+    EXPECT_EQ(capped.getRecordSize(now), 1024u);
+
+    options = makeDynamicSizing();
+    options.initialRecordSize = 100;
+    EXPECT_EQ(TlsRecordSizer{ options }.getRecordSize(now), kMinTlsRecordSize);
+
+    options.maxFragmentLength = 3000; // Not a length RFC 6066 defines, so records keep the full size.
+    options.initialRecordSize = 60000;
+    EXPECT_EQ(TlsRecordSizer{ options }.getRecordSize(now), kMaxTlsRecordSize);
+
+    EXPECT_FALSE(TlsRecordSizer{ TlsTuningOptions{} }.isEnabled());
+    EXPECT_FALSE(TlsRecordSizer{}.isEnabled());
+}
+
+TEST(TlsTuning, MapsFragmentLengthsToTheirExtensionCodes)
+{
+    EXPECT_EQ(getMaxFragmentLengthCode(512), 1u);
+    EXPECT_EQ(getMaxFragmentLengthCode(1024), 2u);
+    EXPECT_EQ(getMaxFragmentLengthCode(2048), 3u);
+    EXPECT_EQ(getMaxFragmentLengthCode(4096), 4u);
+    EXPECT_EQ(getMaxFragmentLengthCode(0), 0u);
+    EXPECT_EQ(getMaxFragmentLengthCode(8192), 0u);
+}
+
+TEST(TlsTuning, CipherOrderFollowsThePreference)
+{
+    const TlsCipherPreference forThisCpu = hasHardwareAes() ? TlsCipherPreference::AesGcm : TlsCipherPreference::ChaCha20;
+    EXPECT_EQ(resolveCipherPreference(TlsCipherPreference::Auto), forThisCpu);
+    EXPECT_EQ(resolveCipherPreference(TlsCipherPreference::ChaCha20), TlsCipherPreference::ChaCha20);
+    EXPECT_EQ(resolveCipherPreference(TlsCipherPreference::LibraryDefault), TlsCipherPreference::LibraryDefault);
+
+    EXPECT_TRUE(std::string(getTls13CipherSuites(TlsCipherPreference::AesGcm)).starts_with("TLS_AES_128_GCM"));
+    EXPECT_TRUE(std::string(getTls13CipherSuites(TlsCipherPreference::ChaCha20)).starts_with("TLS_CHACHA20"));
+    EXPECT_TRUE(std::string(getTls12CipherList(TlsCipherPreference::AesGcm)).starts_with("ECDHE-ECDSA-AES128-GCM"));
+    EXPECT_TRUE(std::string(getTls12CipherList(TlsCipherPreference::ChaCha20)).starts_with("ECDHE-ECDSA-CHACHA20"));
+
+    // Every list keeps the shared context's exclusions after the preferred suites.
+    const std::string highCiphers = getTls12CipherList(TlsCipherPreference::LibraryDefault);
+    EXPECT_TRUE(std::string(getTls12CipherList(TlsCipherPreference::ChaCha20)).ends_with(highCiphers));
+}
+
+#if REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
+TEST(TlsTuning, OpenSslAcceptsEveryCipherOrder)
+{
+    const SslContextPtr context = TlsContextCache::instance().acquire(TlsContextKey{ false });
+    ASSERT_NE(context, nullptr);
+    SSL* ssl = SSL_new(context.get());
+    ASSERT_NE(ssl, nullptr);
+
+    for (const TlsCipherPreference preference : { TlsCipherPreference::AesGcm, TlsCipherPreference::ChaCha20 })
+    {
+        EXPECT_EQ(SSL_set_ciphersuites(ssl, getTls13CipherSuites(preference)), 1);
+        EXPECT_EQ(SSL_set_cipher_list(ssl, getTls12CipherList(preference)), 1);
+        const char* first = SSL_get_cipher_list(ssl, 0);
+        ASSERT_NE(first, nullptr);
+        const char* expected = preference == TlsCipherPreference::AesGcm ? "TLS_AES_128_GCM_SHA256" : "TLS_CHACHA20_POLY1305_SHA256";
+        EXPECT_STREQ(first, expected);
+    }
+#if defined(TLSEXT_max_fragment_length_512)
+    EXPECT_EQ(SSL_set_tlsext_max_fragment_length(ssl, getMaxFragmentLengthCode(1024)), 1);
+#endif // TLSEXT_max_fragment_length_512
+    SSL_free(ssl);
+}
+#endif // REACTORMQ_SECURE_SOCKET_WITH_TLS || REACTORMQ_SECURE_SOCKET_WITH_BIO_TLS
@@ -0,0 +1,647 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "socket/websocket_codec.h"
+#include "fixtures/echo_server.h"
+#include "fixtures/test_utils.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/credentials.h"
+#include "socket/socket.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if REACTORMQ_WITH_ZLIB
+#include <zlib.h>
+#endif // REACTORMQ_WITH_ZLIB
+
+using namespace reactormq::socket;
+using namespace reactormq::mqtt;
+using namespace reactormq::tests;
+
+namespace
+{
+    class NoOpCredentialsProvider final : public ICredentialsProvider
+    {
+    public:
+        Credentials getCredentials() override
+        {
+            return Credentials{};
+        }
+    };
+
+    std::vector<uint8_t> serverFrame(const uint8_t firstByte, const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> frame{ firstByte };
+        if (payload.size() < 126)
+        {
+            frame.push_back(static_cast<uint8_t>(payload.size()));
+        }
+        else
+        {
+            frame.push_back(126);
+            frame.push_back(static_cast<uint8_t>(payload.size() >> 8));
+            frame.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+        }
+        frame.insert(frame.end(), payload.begin(), payload.end());
+        return frame;
+    }
+
+    std::string headerValue(const std::string& request, const std::string& name)
+    {
+        const size_t start = request.find(name + ": ");
+        if (start == std::string::npos)
+        {
+            return {};
+        }
+        const size_t valueStart = start + name.size() + 2;
+        return request.substr(valueStart, request.find("\r\n", valueStart) - valueStart);
+    }
+
+    std::string acceptResponse(const std::string& request, const std::string& extensions = {})
+    {
+        return "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: "
+               + WebSocketCodec::computeAcceptKey(headerValue(request, "Sec-WebSocket-Key")) + "\r\nSec-WebSocket-Protocol: mqtt\r\n"
+               + (extensions.empty() ? std::string{} : "Sec-WebSocket-Extensions: " + extensions + "\r\n") + "\r\n";
+    }
+
+    WebSocketCodec openCodec()
+    {
+        WebSocketCodec codec;
+        const std::string request = codec.createUpgradeRequest("broker.example", 8080, "/mqtt");
+        const std::string response = acceptResponse(request);
+        size_t consumed = 0;
+        codec.readUpgradeResponse({ reinterpret_cast<const uint8_t*>(response.data()), response.size() }, consumed);
+        return codec;
+    }
+
+    /// Unmask a client frame; returns its opcode byte and payload.
+    std::pair<uint8_t, std::vector<uint8_t>> unmaskClientFrame(const std::vector<uint8_t>& frame, size_t& outFrameSize)
+    {
+        outFrameSize = 0;
+        if (frame.size() < 2)
+        {
+            return {};
+        }
+        size_t offset = 2;
+        uint64_t length = frame[1] & 0x7F;
+        if (length == 126)
+        {
+            if (frame.size() < 4)
+            {
+                return {};
+            }
+            length = static_cast<uint64_t>(frame[2]) << 8 | frame[3];
+            offset = 4;
+        }
+        else if (length == 127)
+        {
+            if (frame.size() < 10)
+            {
+                return {};
+            }
+            length = 0;
+            for (size_t i = 2; i < 10; ++i)
+            {
+                length = length << 8 | frame[i];
+            }
+            offset = 10;
+        }
+        if (frame.size() < offset + 4 + length)
+        {
+            return {};
+        }
+
+        const std::array key{ frame[offset], frame[offset + 1], frame[offset + 2], frame[offset + 3] };
+        offset += 4;
+        std::vector<uint8_t> payload(frame.begin() + static_cast<std::ptrdiff_t>(offset), frame.begin() + static_cast<std::ptrdiff_t>(offset + length));
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] ^= key[i % 4];
+        }
+        outFrameSize = offset + length;
+        return { frame[0], payload };
+    }
+
+    /**
+     * Accepts the upgrade, pings the client once, then echoes each binary frame's payload back split across two
+     * fragments.
+     */
+    class WebSocketEchoServer final : public EchoServer
+    {
+    public:
+        ~WebSocketEchoServer() override
+        {
+            stop();
+        }
+
+        std::string getRequest()
+        {
+            std::scoped_lock lock(m_mutex);
+            return m_request;
+        }
+
+        [[nodiscard]] bool hasReceivedPong() const
+        {
+            return m_hasReceivedPong.load();
+        }
+
+        [[nodiscard]] bool hasReceivedClose() const
+        {
+            return m_hasReceivedClose.load();
+        }
+
+    protected:
+        void serveClient(const SocketHandle client) override
+        {
+            setNonBlocking(client);
+            std::vector<uint8_t> pending;
+            std::array<uint8_t, 4096> buffer{};
+            bool isUpgraded = false;
+            while (!shouldStop())
+            {
+                if (const int ready = waitReadable(client); ready < 0)
+                {
+                    return;
+                }
+                else if (ready == 0)
+                {
+                    continue;
+                }
+                const std::ptrdiff_t received = receive(client, buffer.data(), buffer.size());
+                if (received < 0)
+                {
+                    return;
+                }
+                pending.insert(pending.end(), buffer.begin(), buffer.begin() + received);
+
+                if (!isUpgraded)
+                {
+                    const std::string text(pending.begin(), pending.end());
+                    const size_t headEnd = text.find("\r\n\r\n");
+                    if (headEnd == std::string::npos)
+                    {
+                        continue;
+                    }
+                    {
+                        std::scoped_lock lock(m_mutex);
+                        m_request = text.substr(0, headEnd + 4);
+                    }
+                    const std::string response = acceptResponse(text);
+                    const std::vector<uint8_t> ping = serverFrame(0x89, { 'h', 'i' });
+                    sendAll(client, reinterpret_cast<const uint8_t*>(response.data()), response.size());
+                    sendAll(client, ping.data(), ping.size());
+                    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(headEnd + 4));
+                    isUpgraded = true;
+                }
+
+                while (true)
+                {
+                    size_t frameSize = 0;
+                    const auto [opcode, payload] = unmaskClientFrame(pending, frameSize);
+                    if (frameSize == 0)
+                    {
+                        break;
+                    }
+                    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(frameSize));
+                    if (opcode == 0x8A)
+                    {
+                        m_hasReceivedPong.store(payload == std::vector<uint8_t>{ 'h', 'i' });
+                    }
+                    else if (opcode == 0x88)
+                    {
+                        m_hasReceivedClose.store(true);
+                        return;
+                    }
+                    else if (opcode == 0x82)
+                    {
+                        const auto half = static_cast<std::ptrdiff_t>(payload.size() / 2);
+                        const std::vector<uint8_t> first = serverFrame(0x02, { payload.begin(), payload.begin() + half });
+                        const std::vector<uint8_t> second = serverFrame(0x80, { payload.begin() + half, payload.end() });
+                        sendAll(client, first.data(), first.size());
+                        sendAll(client, second.data(), second.size());
+                    }
+                }
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::string m_request;
+        std::atomic<bool> m_hasReceivedPong{ false };
+        std::atomic<bool> m_hasReceivedClose{ false };
+    };
+} // namespace
+
+TEST(WebSocketCodec, AcceptKeyMatchesTheRfcExample)
+{
+    EXPECT_EQ(WebSocketCodec::computeAcceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(WebSocketCodec, MaskCopyMatchesBytewiseXor)
+{
+    const std::array<uint8_t, 4> key{ 0x12, 0x34, 0x56, 0x78 };
+    std::vector<uint8_t> source(100);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    for (size_t keyOffset = 0; keyOffset < 4; ++keyOffset)
+    {
+        for (size_t size = 0; size <= source.size(); ++size)
+        {
+            std::vector<uint8_t> masked(size);
+            WebSocketCodec::maskCopy(masked.data(), source.data(), size, key, keyOffset);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(masked[i], source[i] ^ key[(keyOffset + i) % 4]) << "size=" << size << " offset=" << keyOffset;
+            }
+        }
+    }
+}
+
+TEST(WebSocketCodec, UpgradeRequestAsksForMqtt)
+{
+    WebSocketCodec codec;
+    const std::string request = codec.createUpgradeRequest("::1", 8080, "mqtt");
+
+    EXPECT_EQ(codec.getState(), WebSocketCodec::State::Upgrading);
+    EXPECT_TRUE(request.starts_with("GET /mqtt HTTP/1.1\r\n"));
+    EXPECT_NE(request.find("Host: [::1]:8080\r\n"), std::string::npos);
+    EXPECT_NE(request.find("Sec-WebSocket-Version: 13\r\n"), std::string::npos);
+    EXPECT_NE(request.find("Sec-WebSocket-Protocol: mqtt\r\n"), std::string::npos);
+    EXPECT_EQ(headerValue(request, "Sec-WebSocket-Key").size(), 24U);
+    EXPECT_TRUE(request.ends_with("\r\n\r\n"));
+}
+
+TEST(WebSocketCodec, UpgradeResponseIsAcceptedAcrossReads)
+{
+    WebSocketCodec codec;
+    const std::string request = codec.createUpgradeRequest("broker.example", 80, "");
+    const std::string response = acceptResponse(request) + "\x82\x01X";
+
+    size_t consumed = 0;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(response.data());
+    EXPECT_EQ(codec.readUpgradeResponse({ bytes, 20 }, consumed), WebSocketCodec::UpgradeStatus::Pending);
+    EXPECT_EQ(consumed, 20U);
+    EXPECT_EQ(codec.readUpgradeResponse({ bytes + 20, response.size() - 20 }, consumed), WebSocketCodec::UpgradeStatus::Accepted);
+    EXPECT_EQ(consumed, response.size() - 20 - 3);
+    EXPECT_EQ(codec.getState(), WebSocketCodec::State::Open);
+}
+
+TEST(WebSocketCodec, UpgradeWithTheWrongAcceptIsRejected)
+{
+    WebSocketCodec codec;
+    (void)codec.createUpgradeRequest("broker.example", 80, "/mqtt");
+    const std::string response
+        = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: bm9wZQ==\r\n\r\n";
+
+    size_t consumed = 0;
+    EXPECT_EQ(
+        codec.readUpgradeResponse({ reinterpret_cast<const uint8_t*>(response.data()), response.size() }, consumed),
+        WebSocketCodec::UpgradeStatus::Rejected);
+    EXPECT_EQ(codec.getState(), WebSocketCodec::State::Closed);
+}
+
+TEST(WebSocketCodec, UpgradeRefusedByTheServerIsRejected)
+{
+    WebSocketCodec codec;
+    (void)codec.createUpgradeRequest("broker.example", 80, "/mqtt");
+    const std::string response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+
+    size_t consumed = 0;
+    EXPECT_EQ(
+        codec.readUpgradeResponse({ reinterpret_cast<const uint8_t*>(response.data()), response.size() }, consumed),
+        WebSocketCodec::UpgradeStatus::Rejected);
+}
+
+TEST(WebSocketCodec, BinaryFramesUseTheShortestLengthEncoding)
+{
+    WebSocketCodec codec = openCodec();
+
+    for (const size_t size : { size_t{ 5 }, size_t{ 200 }, size_t{ 70000 } })
+    {
+        std::vector<uint8_t> packet(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            packet[i] = static_cast<uint8_t>(i);
+        }
+        const std::array buffers{ SendBuffer{ packet.data(), 3 }, SendBuffer{ packet.data() + 3, size - 3 } };
+
+        const SendBuffer frame = codec.encodeBinaryFrame(buffers);
+        const std::vector<uint8_t> bytes(frame.data, frame.data + frame.size);
+        const size_t expectedHeader = size < 126 ? 6 : size <= 0xFFFF ? 8 : 14;
+        EXPECT_EQ(bytes.size(), expectedHeader + size);
+
+        size_t frameSize = 0;
+        const auto [opcode, payload] = unmaskClientFrame(bytes, frameSize);
+        EXPECT_EQ(opcode, 0x82);
+        EXPECT_EQ(frameSize, bytes.size());
+        EXPECT_EQ(payload, packet);
+    }
+}
+
+TEST(WebSocketCodec, DecodeStripsHeadersInPlaceAcrossReads)
+{
+    WebSocketCodec codec = openCodec();
+
+    std::vector<uint8_t> stream = serverFrame(0x02, { 'a', 'b', 'c' });
+    const std::vector<uint8_t> tail = serverFrame(0x80, std::vector<uint8_t>(300, 'd'));
+    stream.insert(stream.end(), tail.begin(), tail.end());
+    const std::vector<uint8_t> next = serverFrame(0x82, { 'e' });
+    stream.insert(stream.end(), next.begin(), next.end());
+
+    std::vector<uint8_t> expected{ 'a', 'b', 'c' };
+    expected.insert(expected.end(), 300, 'd');
+    expected.push_back('e');
+
+    // Every split point, so headers and payloads are cut at each possible byte.
+    for (size_t split = 0; split <= stream.size(); ++split)
+    {
+        WebSocketCodec splitCodec = openCodec();
+        std::vector<uint8_t> bytes = stream;
+        size_t first = 0;
+        size_t second = 0;
+        ASSERT_TRUE(splitCodec.decode({ bytes.data(), split }, first));
+        std::vector<uint8_t> decoded(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(first));
+        ASSERT_TRUE(splitCodec.decode({ bytes.data() + split, bytes.size() - split }, second));
+        decoded.insert(decoded.end(), bytes.begin() + static_cast<std::ptrdiff_t>(split), bytes.begin() + static_cast<std::ptrdiff_t>(split + second));
+        ASSERT_EQ(decoded, expected) << "split=" << split;
+    }
+
+    size_t payloadSize = 0;
+    ASSERT_TRUE(codec.decode(stream, payloadSize));
+    EXPECT_EQ(std::vector<uint8_t>(stream.begin(), stream.begin() + static_cast<std::ptrdiff_t>(payloadSize)), expected);
+}
+
+TEST(WebSocketCodec, PingIsAnsweredWithAPong)
+{
+    WebSocketCodec codec = openCodec();
+    std::vector<uint8_t> bytes = serverFrame(0x89, { 'p' });
+
+    size_t payloadSize = 0;
+    ASSERT_TRUE(codec.decode(bytes, payloadSize));
+    EXPECT_EQ(payloadSize, 0U);
+
+    size_t frameSize = 0;
+    const auto [opcode, payload] = unmaskClientFrame(codec.getPendingControlFrames(), frameSize);
+    EXPECT_EQ(opcode, 0x8A);
+    EXPECT_EQ(payload, std::vector<uint8_t>{ 'p' });
+}
+
+TEST(WebSocketCodec, CloseFromTheServerIsEchoedAndEndsTheConnection)
+{
+    WebSocketCodec codec = openCodec();
+    std::vector<uint8_t> bytes = serverFrame(0x88, { 0x03, 0xE9 });
+
+    size_t payloadSize = 0;
+    EXPECT_FALSE(codec.decode(bytes, payloadSize));
+    EXPECT_EQ(codec.getState(), WebSocketCodec::State::Closed);
+
+    size_t frameSize = 0;
+    const auto [opcode, payload] = unmaskClientFrame(codec.getPendingControlFrames(), frameSize);
+    EXPECT_EQ(opcode, 0x88);
+    EXPECT_EQ(payload, (std::vector<uint8_t>{ 0x03, 0xE9 }));
+}
+
+TEST(WebSocketCodec, TextAndMaskedFramesAreProtocolErrors)
+{
+    size_t payloadSize = 0;
+
+    WebSocketCodec textCodec = openCodec();
+    std::vector<uint8_t> text = serverFrame(0x81, { 'x' });
+    EXPECT_FALSE(textCodec.decode(text, payloadSize));
+
+    WebSocketCodec maskedCodec = openCodec();
+    std::vector<uint8_t> masked{ 0x82, 0x81, 0, 0, 0, 0, 'x' };
+    EXPECT_FALSE(maskedCodec.decode(masked, payloadSize));
+}
+
+TEST(WebSocketCodec, CompressedFramesWithoutDeflateAreProtocolErrors)
+{
+    WebSocketCodec codec = openCodec();
+    EXPECT_FALSE(codec.isDeflateNegotiated());
+
+    std::vector<uint8_t> bytes = serverFrame(0xC2, { 'x' });
+    size_t payloadSize = 0;
+    EXPECT_FALSE(codec.decode(bytes, payloadSize));
+}
+
+#if REACTORMQ_WITH_ZLIB
+namespace
+{
+    WebSocketDeflateOptions deflateOffer()
+    {
+        WebSocketDeflateOptions options;
+        options.enabled = true;
+        options.serverMaxWindowBits = 12;
+        options.clientContextTakeover = false;
+        options.minCompressBytes = 16;
+        return options;
+    }
+
+    WebSocketCodec::UpgradeStatus upgradeWithExtensions(WebSocketCodec& codec, const std::string& extensions)
+    {
+        const std::string request = codec.createUpgradeRequest("broker.example", 8080, "/mqtt");
+        const std::string response = acceptResponse(request, extensions);
+        size_t consumed = 0;
+        return codec.readUpgradeResponse({ reinterpret_cast<const uint8_t*>(response.data()), response.size() }, consumed);
+    }
+
+    /// Raw DEFLATE with a sync flush and without the trailing empty block, as a permessage-deflate peer sends it.
+    std::vector<uint8_t> deflateMessage(const std::vector<uint8_t>& message)
+    {
+        z_stream stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -12, 8, Z_DEFAULT_STRATEGY);
+        std::vector<uint8_t> out(deflateBound(&stream, static_cast<uLong>(message.size())) + 16);
+        stream.next_in = const_cast<Bytef*>(message.data());
+        stream.avail_in = static_cast<uInt>(message.size());
+        stream.next_out = out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream, Z_SYNC_FLUSH);
+        out.resize(out.size() - stream.avail_out - 4);
+        deflateEnd(&stream);
+        return out;
+    }
+
+    std::vector<uint8_t> inflateMessage(std::vector<uint8_t> compressed)
+    {
+        compressed.insert(compressed.end(), { 0x00, 0x00, 0xFF, 0xFF });
+        z_stream stream{};
+        inflateInit2(&stream, -15);
+        std::vector<uint8_t> out(64 * 1024);
+        stream.next_in = compressed.data();
+        stream.avail_in = static_cast<uInt>(compressed.size());
+        stream.next_out = out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        inflate(&stream, Z_SYNC_FLUSH);
+        out.resize(out.size() - stream.avail_out);
+        inflateEnd(&stream);
+        return out;
+    }
+} // namespace
+
+TEST(WebSocketCodec, UpgradeRequestOffersPermessageDeflate)
+{
+    WebSocketCodec codec(deflateOffer());
+    const std::string request = codec.createUpgradeRequest("broker.example", 8080, "/mqtt");
+
+    EXPECT_EQ(
+        headerValue(request, "Sec-WebSocket-Extensions"),
+        "permessage-deflate; client_max_window_bits; server_max_window_bits=12; client_no_context_takeover");
+}
+
+TEST(WebSocketCodec, DeflateRoundTripsBothDirections)
+{
+    WebSocketCodec codec(deflateOffer());
+    ASSERT_EQ(
+        upgradeWithExtensions(codec, "permessage-deflate; server_max_window_bits=12; client_no_context_takeover"),
+        WebSocketCodec::UpgradeStatus::Accepted);
+    ASSERT_TRUE(codec.isDeflateNegotiated());
+
+    const std::vector<uint8_t> packet(1000, 'z');
+    const std::array buffers{ SendBuffer{ packet.data(), packet.size() } };
+    const SendBuffer frame = codec.encodeBinaryFrame(buffers);
+    size_t frameSize = 0;
+    const auto [opcode, payload] = unmaskClientFrame({ frame.data, frame.data + frame.size }, frameSize);
+    EXPECT_EQ(opcode, 0xC2);
+    EXPECT_LT(payload.size(), packet.size());
+    EXPECT_EQ(inflateMessage(payload), packet);
+
+    // A compressed message split over two frames, then a plain one.
+    const std::vector<uint8_t> message(3000, 'm');
+    const std::vector<uint8_t> compressed = deflateMessage(message);
+    const size_t half = compressed.size() / 2;
+    std::vector<uint8_t> stream = serverFrame(0x42, { compressed.begin(), compressed.begin() + static_cast<std::ptrdiff_t>(half) });
+    const std::vector<uint8_t> rest = serverFrame(0x80, { compressed.begin() + static_cast<std::ptrdiff_t>(half), compressed.end() });
+    stream.insert(stream.end(), rest.begin(), rest.end());
+    const std::vector<uint8_t> plain = serverFrame(0x82, { 'p' });
+    stream.insert(stream.end(), plain.begin(), plain.end());
+
+    size_t payloadSize = 0;
+    ASSERT_TRUE(codec.decode(stream, payloadSize));
+    EXPECT_EQ(payloadSize, 0U);
+    std::vector<uint8_t> expected = message;
+    expected.push_back('p');
+    EXPECT_EQ(codec.getDecodedPayload(), expected);
+}
+
+TEST(WebSocketCodec, SmallPacketsAreSentUncompressed)
+{
+    WebSocketCodec codec(deflateOffer());
+    ASSERT_EQ(upgradeWithExtensions(codec, "permessage-deflate; server_max_window_bits=10"), WebSocketCodec::UpgradeStatus::Accepted);
+
+    const std::vector<uint8_t> packet{ 0xC0, 0x00 };
+    const std::array buffers{ SendBuffer{ packet.data(), packet.size() } };
+    const SendBuffer frame = codec.encodeBinaryFrame(buffers);
+    size_t frameSize = 0;
+    const auto [opcode, payload] = unmaskClientFrame({ frame.data, frame.data + frame.size }, frameSize);
+    EXPECT_EQ(opcode, 0x82);
+    EXPECT_EQ(payload, packet);
+}
+
+TEST(WebSocketCodec, InvalidDeflateResponsesAreRejected)
+{
+    for (const std::string& extensions : {
+             std::string{ "permessage-deflate" },
+             std::string{ "permessage-deflate; server_max_window_bits=12; foo" },
+             std::string{ "permessage-deflate; server_max_window_bits=14" },
+             std::string{ "permessage-deflate; server_max_window_bits=12; client_max_window_bits=8" },
+             std::string{ "permessage-deflate; server_max_window_bits=12; server_max_window_bits=12" },
+             std::string{ "x-webkit-deflate-frame" },
+         })
+    {
+        WebSocketCodec codec(deflateOffer());
+        EXPECT_EQ(upgradeWithExtensions(codec, extensions), WebSocketCodec::UpgradeStatus::Rejected) << extensions;
+    }
+}
+
+TEST(WebSocketCodec, InflatedMessagesPastTheLimitAreProtocolErrors)
+{
+    WebSocketCodec codec(deflateOffer(), 1024);
+    ASSERT_EQ(
+        upgradeWithExtensions(codec, "permessage-deflate; server_max_window_bits=12"), WebSocketCodec::UpgradeStatus::Accepted);
+
+    std::vector<uint8_t> bytes = serverFrame(0xC2, deflateMessage(std::vector<uint8_t>(4096, 'b')));
+    size_t payloadSize = 0;
+    EXPECT_FALSE(codec.decode(bytes, payloadSize));
+}
+#endif // REACTORMQ_WITH_ZLIB
+
+TEST(NativeSocket_WebSocket, CarriesMqttPacketsInBinaryFrames)
+{
+    WebSocketEchoServer server;
+    const uint16_t port = server.start(0);
+    ASSERT_NE(port, 0);
+
+    const auto settings
+        = ConnectionSettingsBuilder{}
+              .setHost("127.0.0.1")
+              .setPort(port)
+              .setPath("/mqtt")
+              .setProtocol(ConnectionProtocol::Ws)
+              .setCredentialsProvider(std::make_shared<NoOpCredentialsProvider>())
+              .build();
+
+    SocketPtr sock = CreateSocket(settings);
+
+    std::atomic connected{ false };
+    std::vector<uint8_t> received;
+    std::mutex recvMutex;
+
+    auto connectHandle = sock->getOnConnectCallback().add(
+        [&connected](const bool success)
+        {
+            connected.store(success);
+        });
+    auto dataHandle = sock->getOnDataReceivedCallback().add(
+        [&recvMutex, &received](const InboundFrame& frame)
+        {
+            std::scoped_lock lock(recvMutex);
+            received.insert(received.end(), frame.bytes.begin(), frame.bytes.end());
+        });
+
+    sock->connect();
+    for (int i = 0; i < 200 && !connected.load(); ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(connected.load());
+    EXPECT_TRUE(server.getRequest().starts_with("GET /mqtt HTTP/1.1\r\n"));
+
+    const auto packet = buildMqttConnectPacket();
+    sock->send(packet.data(), static_cast<uint32_t>(packet.size()));
+
+    for (int i = 0; i < 200; ++i)
+    {
+        sock->tick();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::scoped_lock lock(recvMutex);
+        if (received.size() >= packet.size() && server.hasReceivedPong())
+        {
+            break;
+        }
+    }
+
+    {
+        std::scoped_lock lock(recvMutex);
+        EXPECT_EQ(received, packet);
+    }
+    EXPECT_TRUE(server.hasReceivedPong());
+
+    sock->disconnect();
+    for (int i = 0; i < 200 && !server.hasReceivedClose(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(server.hasReceivedClose());
+}
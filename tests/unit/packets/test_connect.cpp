@@ -500,7 +500,7 @@ TEST(Connect5AuthProps, EncodeDecode_AuthenticationMethodAndData)
     ASSERT_TRUE(decoded.isValid());
 
     const Properties& decodedProps = decoded.getProperties();
-    const std::vector<Property> props = decodedProps.getProperties();
+    const std::span<const Property> props = decodedProps.getProperties();
 
     bool foundMethod = false;
     bool foundData = false;
@@ -529,4 +529,48 @@ TEST(Connect5AuthProps, EncodeDecode_AuthenticationMethodAndData)
 
     EXPECT_TRUE(foundMethod);
     EXPECT_TRUE(foundData);
-}
\ No newline at end of file
+}
+
+TEST(Connect5, EncodeToWriter_AdvertisesTopicAliasMaximum)
+{
+    std::vector<std::byte> buffer;
+    ByteWriter writer(buffer);
+    encodeConnectToWriter<ProtocolVersion::V5>(writer, "client-1", 30, "", "", true, "", {}, 12);
+
+    ByteReader headerReader(buffer.data(), buffer.size());
+    const FixedHeader header = FixedHeader::create(headerReader);
+    const Connect5 decoded(headerReader, header);
+    ASSERT_TRUE(decoded.isValid());
+
+    uint16_t topicAliasMaximum = 0;
+    for (const Property& p : decoded.getProperties().getProperties())
+    {
+        if (p.getIdentifier() == PropertyIdentifier::TopicAliasMaximum)
+        {
+            EXPECT_TRUE(p.tryGetValue(topicAliasMaximum));
+        }
+    }
+    EXPECT_EQ(topicAliasMaximum, 12u);
+}
+
+TEST(Connect5, EncodeToWriter_AdvertisesReceiveMaximum)
+{
+    std::vector<std::byte> buffer;
+    ByteWriter writer(buffer);
+    encodeConnectToWriter<ProtocolVersion::V5>(writer, "client-1", 30, "", "", true, "", {}, 0, 8);
+
+    ByteReader headerReader(buffer.data(), buffer.size());
+    const FixedHeader header = FixedHeader::create(headerReader);
+    const Connect5 decoded(headerReader, header);
+    ASSERT_TRUE(decoded.isValid());
+
+    uint16_t receiveMaximum = 0;
+    for (const Property& p : decoded.getProperties().getProperties())
+    {
+        if (p.getIdentifier() == PropertyIdentifier::ReceiveMaximum)
+        {
+            EXPECT_TRUE(p.tryGetValue(receiveMaximum));
+        }
+    }
+    EXPECT_EQ(receiveMaximum, 8u);
+}
@@ -0,0 +1,144 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/packets/packet_batch.h"
+#include "mqtt/packets/pre_encoded_packets.h"
+#include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_template.h"
+#include "reactormq/mqtt/publish_reservation.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/shared_payload.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt::packets;
+using namespace reactormq::mqtt;
+using namespace reactormq::serialize;
+
+namespace
+{
+    std::vector<std::byte> encodeDirect(const std::string& topic, const std::vector<std::uint8_t>& payload, const std::uint16_t packetId)
+    {
+        std::vector<std::byte> packet;
+        ByteWriter writer(packet);
+        encodePublishToWriter<ProtocolVersion::V311>(writer, topic, payload, QualityOfService::AtLeastOnce, false, packetId, false);
+        return packet;
+    }
+
+    std::vector<std::byte> flatten(const PacketBatch& batch, size_t* segments = nullptr)
+    {
+        std::vector<std::byte> out;
+        size_t count = 0;
+        batch.forEachSegment(
+            [&out, &count](const std::span<const std::byte> segment)
+            {
+                out.insert(out.end(), segment.begin(), segment.end());
+                ++count;
+            });
+        if (nullptr != segments)
+        {
+            *segments = count;
+        }
+        return out;
+    }
+} // namespace
+
+TEST(PacketBatch, PublishesAndAcksEncodeBackToBack)
+{
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V311>("a/b", QualityOfService::AtLeastOnce, false);
+    const std::vector<std::uint8_t> small(16, 0x11);
+    const std::vector<std::uint8_t> large(PacketBatch::kInlinePayloadBytes * 2, 0x22);
+
+    PacketBatch batch;
+    batch.appendPublish(publishTemplate, 1, SharedPayload{ std::vector<std::uint8_t>(small) }, false);
+    batch.appendIdOnlyAck<PacketType::PubAck>(9);
+    batch.appendPublish(publishTemplate, 2, SharedPayload{ std::vector<std::uint8_t>(large) }, false);
+    batch.appendPublish(publishTemplate, 3, SharedPayload{ std::vector<std::uint8_t>(small) }, false);
+
+    std::vector<std::byte> expected = encodeDirect("a/b", small, 1);
+    const auto ack = encodeIdOnlyAck<PacketType::PubAck>(9);
+    expected.insert(expected.end(), ack.begin(), ack.end());
+    for (const auto& part : { encodeDirect("a/b", large, 2), encodeDirect("a/b", small, 3) })
+    {
+        expected.insert(expected.end(), part.begin(), part.end());
+    }
+
+    size_t segments = 0;
+    EXPECT_EQ(flatten(batch, &segments), expected);
+    EXPECT_EQ(segments, 3u);
+    EXPECT_LE(segments, batch.getSegmentCount());
+    EXPECT_EQ(batch.getPacketCount(), 4u);
+    EXPECT_EQ(batch.getSize(), expected.size());
+}
+
+TEST(PacketBatch, LargePayloadsAreReferencedNotCopied)
+{
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V311>("t", QualityOfService::AtMostOnce, false);
+    const SharedPayload payload{ std::vector<std::uint8_t>(PacketBatch::kInlinePayloadBytes, 0x5A) };
+
+    PacketBatch batch;
+    batch.appendPublish(publishTemplate, 0, payload, false);
+    EXPECT_EQ(payload.getUseCount(), 2);
+    EXPECT_EQ(batch.getContiguousBytes().size(), PacketBatch::measurePublish(publishTemplate, payload.getSize()));
+
+    batch.clear();
+    EXPECT_TRUE(batch.isEmpty());
+    EXPECT_EQ(payload.getUseCount(), 1);
+    EXPECT_EQ(flatten(batch).size(), 0u);
+}
+
+TEST(PacketBatch, ReservedPayloadCarriesItsHeaderInItsHeadroom)
+{
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V311>("a/b", QualityOfService::AtLeastOnce, false);
+    const std::vector<std::uint8_t> bytes(PacketBatch::kInlinePayloadBytes * 2, 0x33);
+    PublishReservation reservation("a/b", bytes.size() + 10, QualityOfService::AtLeastOnce, false);
+    std::memcpy(reservation.getPayload().data(), bytes.data(), bytes.size());
+    const Message message = reservation.commit(bytes.size());
+
+    PacketBatch batch;
+    batch.appendPublish(publishTemplate, 4, message.getSharedPayload(), false);
+
+    // The header sits in the headroom, so the whole packet is one region and nothing was copied into the batch.
+    size_t segments = 0;
+    EXPECT_EQ(flatten(batch, &segments), encodeDirect("a/b", bytes, 4));
+    EXPECT_EQ(segments, 1u);
+    EXPECT_TRUE(batch.getContiguousBytes().empty());
+
+    // The headroom is claimed until the batch is cleared, so the same payload queued again gets its own header.
+    batch.appendPublish(publishTemplate, 5, message.getSharedPayload(), false);
+    std::vector<std::byte> expected = encodeDirect("a/b", bytes, 4);
+    const std::vector<std::byte> second = encodeDirect("a/b", bytes, 5);
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(flatten(batch, &segments), expected);
+    EXPECT_EQ(segments, 3u);
+
+    batch.clear();
+    batch.appendPublish(publishTemplate, 6, message.getSharedPayload(), false);
+    EXPECT_EQ(flatten(batch, &segments), encodeDirect("a/b", bytes, 6));
+    EXPECT_EQ(segments, 1u);
+}
+
+TEST(PacketBatch, ClearKeepsTheBufferCapacity)
+{
+    PacketBatch batch;
+    for (std::uint16_t id = 1; id <= 64; ++id)
+    {
+        batch.appendIdOnlyAck<PacketType::PubComp>(id);
+    }
+    const std::byte* storage = batch.getContiguousBytes().data();
+    batch.clear();
+
+    for (std::uint16_t id = 1; id <= 64; ++id)
+    {
+        batch.appendIdOnlyAck<PacketType::PubComp>(id);
+    }
+    EXPECT_EQ(batch.getContiguousBytes().data(), storage);
+    EXPECT_EQ(batch.getContiguousBytes().size(), 64 * kIdOnlyAckPacketSize);
+}
@@ -0,0 +1,88 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/packets/disconnect.h"
+#include "mqtt/packets/ping_req.h"
+#include "mqtt/packets/ping_resp.h"
+#include "mqtt/packets/pre_encoded_packets.h"
+#include "mqtt/packets/pub_ack.h"
+#include "mqtt/packets/pub_comp.h"
+#include "mqtt/packets/pub_rec.h"
+#include "mqtt/packets/pub_rel.h"
+#include "serialize/bytes.h"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+
+using namespace reactormq::mqtt::packets;
+using namespace reactormq::serialize;
+
+static_assert(kHeaderOnlyPacket<PacketType::PingReq>[0] == std::byte{ 0xC0 });
+static_assert(encodeIdOnlyAck<PacketType::PubRel>(0x1234)[0] == std::byte{ 0x62 });
+static_assert(encodeIdOnlyAck<PacketType::PubAck>(0x1234)[2] == std::byte{ 0x12 });
+static_assert(encodeIdOnlyAck<PacketType::PubAck>(0x1234)[3] == std::byte{ 0x34 });
+
+namespace
+{
+    std::vector<std::byte> toVec(const std::span<const std::byte> bytes)
+    {
+        return { bytes.begin(), bytes.end() };
+    }
+
+    template<typename TEncode>
+    std::vector<std::byte> encodeWith(TEncode&& encode)
+    {
+        std::vector<std::byte> buffer;
+        ByteWriter writer(buffer);
+        encode(writer);
+        return buffer;
+    }
+
+    template<ProtocolVersion V>
+    void expectAcksMatchEncoders(const std::uint16_t packetId)
+    {
+        EXPECT_EQ(
+            toVec(encodeIdOnlyAck<PacketType::PubAck>(packetId)),
+            encodeWith([packetId](ByteWriter& w) { encodePubAckToWriter<V>(w, packetId); }));
+        EXPECT_EQ(
+            toVec(encodeIdOnlyAck<PacketType::PubRec>(packetId)),
+            encodeWith([packetId](ByteWriter& w) { encodePubRecToWriter<V>(w, packetId); }));
+        EXPECT_EQ(
+            toVec(encodeIdOnlyAck<PacketType::PubRel>(packetId)),
+            encodeWith([packetId](ByteWriter& w) { encodePubRelToWriter<V>(w, packetId); }));
+        EXPECT_EQ(
+            toVec(encodeIdOnlyAck<PacketType::PubComp>(packetId)),
+            encodeWith([packetId](ByteWriter& w) { encodePubCompToWriter<V>(w, packetId); }));
+    }
+} // namespace
+
+TEST(PreEncodedPackets, IdOnlyAcksMatchV311Encoders)
+{
+    for (const std::uint16_t packetId : { 1, 0x00FF, 0x0100, 0xABCD, 0xFFFF })
+    {
+        expectAcksMatchEncoders<ProtocolVersion::V311>(packetId);
+    }
+}
+
+TEST(PreEncodedPackets, IdOnlyAcksMatchV5SuccessEncoders)
+{
+    for (const std::uint16_t packetId : { 1, 0x00FF, 0x0100, 0xABCD, 0xFFFF })
+    {
+        expectAcksMatchEncoders<ProtocolVersion::V5>(packetId);
+    }
+}
+
+TEST(PreEncodedPackets, HeaderOnlyPacketsMatchEncoders)
+{
+    EXPECT_EQ(toVec(kHeaderOnlyPacket<PacketType::PingReq>), encodeWith([](ByteWriter& w) { PingReq{}.encode(w); }));
+    EXPECT_EQ(toVec(kHeaderOnlyPacket<PacketType::PingResp>), encodeWith([](ByteWriter& w) { PingResp{}.encode(w); }));
+    EXPECT_EQ(
+        toVec(kHeaderOnlyPacket<PacketType::Disconnect>),
+        encodeWith([](ByteWriter& w) { encodeDisconnectToWriter<ProtocolVersion::V311>(w); }));
+    EXPECT_EQ(
+        toVec(kHeaderOnlyPacket<PacketType::Disconnect>),
+        encodeWith([](ByteWriter& w) { encodeDisconnectToWriter<ProtocolVersion::V5>(w); }));
+}
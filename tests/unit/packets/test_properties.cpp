@@ -5,10 +5,13 @@
 #include "mqtt/packets/properties/properties.h"
 #include "mqtt/packets/properties/property.h"
 #include "mqtt/packets/properties/property_identifier.h"
+#include "mqtt/packets/properties/property_view.h"
 #include "serialize/bytes.h"
 
 #include <cstddef>
 #include <gtest/gtest.h>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace reactormq::mqtt::packets::properties;
@@ -334,4 +337,97 @@ TEST(Properties, LargePropertiesLength)
 
     const uint32_t totalLength = props.getLength(true);
     EXPECT_EQ(totalLength, contentLength + variableByteIntegerSize(contentLength));
-}
\ No newline at end of file
+}
+TEST(Properties, ListSpillsPastInlineCapacityAndKeepsOrder)
+{
+    PropertyList list;
+    for (uint16_t i = 1; i <= 6; ++i)
+    {
+        list.add(Property::create<PropertyIdentifier::ReceiveMaximum>(i));
+    }
+    ASSERT_EQ(list.size(), 6u);
+
+    PropertyList copy = list;
+    const PropertyList moved = std::move(list);
+    EXPECT_EQ(copy, moved);
+    for (uint16_t i = 0; i < 6; ++i)
+    {
+        uint16_t value = 0;
+        ASSERT_TRUE(moved.getSpan()[i].tryGetValue(value));
+        EXPECT_EQ(value, i + 1);
+    }
+
+    copy.clear();
+    copy.add(Property::create<PropertyIdentifier::TopicAlias>(uint16_t{ 3 }));
+    EXPECT_EQ(copy.size(), 1u);
+}
+
+TEST(Properties, FindReturnsTypedValueWithoutCopying)
+{
+    const Properties props(std::vector{
+        Property::create<PropertyIdentifier::MessageExpiryInterval>(uint32_t{ 90 }),
+        Property::create<PropertyIdentifier::TopicAlias>(uint16_t{ 7 }),
+    });
+
+    const uint16_t* alias = props.find<PropertyIdentifier::TopicAlias>();
+    ASSERT_NE(alias, nullptr);
+    EXPECT_EQ(*alias, 7u);
+    const uint32_t* expiry = props.find<PropertyIdentifier::MessageExpiryInterval>();
+    ASSERT_NE(expiry, nullptr);
+    EXPECT_EQ(*expiry, 90u);
+    EXPECT_EQ(props.find<PropertyIdentifier::ReasonString>(), nullptr);
+}
+
+TEST(PropertiesView, ReadsValuesInPlace)
+{
+    const Properties props(std::vector{
+        Property::create<PropertyIdentifier::TopicAlias>(uint16_t{ 12 }),
+        Property::create<PropertyIdentifier::MessageExpiryInterval>(uint32_t{ 3600 }),
+        Property::create<PropertyIdentifier::SubscriptionIdentifier>(uint32_t{ 300 }),
+        Property::create<PropertyIdentifier::CorrelationData>(std::vector<uint8_t>{ 1, 2, 3 }),
+        Property::create<PropertyIdentifier::UserProperty>(std::pair<std::string, std::string>{ "k", "value" }),
+    });
+    std::vector<std::byte> buffer;
+    ByteWriter writer(buffer);
+    props.encode(writer);
+
+    const PropertiesView view(buffer);
+    EXPECT_EQ(view.getTopicAlias(), 12u);
+    EXPECT_EQ(view.getMessageExpiryInterval(), 3600u);
+    EXPECT_EQ(view.findUserProperty("k"), "value");
+    EXPECT_FALSE(view.findUserProperty("missing").has_value());
+
+    const auto subscription = view.find(PropertyIdentifier::SubscriptionIdentifier);
+    ASSERT_TRUE(subscription.has_value());
+    EXPECT_EQ(subscription->getInteger(), 300u);
+
+    const auto correlation = view.find(PropertyIdentifier::CorrelationData);
+    ASSERT_TRUE(correlation.has_value());
+    EXPECT_EQ(std::vector<uint8_t>(correlation->getBinary().begin(), correlation->getBinary().end()), (std::vector<uint8_t>{ 1, 2, 3 }));
+    // Views point into the buffer rather than into copies.
+    EXPECT_GE(reinterpret_cast<const std::byte*>(correlation->getBinary().data()), buffer.data());
+    EXPECT_LT(reinterpret_cast<const std::byte*>(correlation->getBinary().data()), buffer.data() + buffer.size());
+
+    size_t count = 0;
+    EXPECT_TRUE(view.forEach(
+        [&count](const PropertyView&)
+        {
+            ++count;
+        }));
+    EXPECT_EQ(count, 5u);
+}
+
+TEST(PropertiesView, RejectsMalformedBlocks)
+{
+    // Property Length 3, but the Topic Alias value is cut short.
+    const auto truncated = toVec({ 0x03, 0x23, 0x00 });
+    EXPECT_FALSE(PropertiesView(truncated).forEach([](const PropertyView&) {}));
+
+    // Unknown identifier 0x7F.
+    const auto unknown = toVec({ 0x02, 0x7F, 0x00 });
+    EXPECT_FALSE(PropertiesView(unknown).forEach([](const PropertyView&) {}));
+    EXPECT_EQ(PropertiesView(unknown).getTopicAlias(), 0u);
+
+    EXPECT_TRUE(PropertiesView{}.forEach([](const PropertyView&) {}));
+    EXPECT_TRUE(PropertiesView(toVec({ 0x00 })).forEach([](const PropertyView&) {}));
+}
@@ -7,8 +7,11 @@
 #include "reactormq/mqtt/reason_code.h"
 #include "serialize/bytes.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <gtest/gtest.h>
+#include <span>
 #include <vector>
 
 using namespace reactormq::mqtt::packets;
@@ -348,4 +351,19 @@ TEST(PubAck, MultiplePackets_Consistency)
         EXPECT_EQ(packet3.getPacketType(), PacketType::PubAck);
         EXPECT_EQ(packet5.getPacketType(), PacketType::PubAck);
     }
-}
\ No newline at end of file
+}
+TEST(PubAck5, EncodeToWriter_FitsSmallStackBuffer)
+{
+    std::array<std::byte, kSmallPacketBufferSize> storage{};
+    ByteWriter writer{ std::span<std::byte>{ storage } };
+
+    encodePubAckToWriter<ProtocolVersion::V5>(writer, 0x1234);
+
+    std::vector<std::byte> expected;
+    ByteWriter expectedWriter(expected);
+    encodePubAckToWriter<ProtocolVersion::V5>(expectedWriter, 0x1234);
+
+    EXPECT_FALSE(writer.hasOverflowed());
+    ASSERT_EQ(writer.getSize(), expected.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), storage.begin()));
+}
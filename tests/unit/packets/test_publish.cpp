@@ -7,7 +7,9 @@
 #include "reactormq/mqtt/quality_of_service.h"
 #include "serialize/bytes.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <string>
 #include <vector>
@@ -187,6 +189,26 @@ TEST(Publish3, Encode_WithDuplicateFlag)
     EXPECT_EQ(static_cast<uint8_t>(buffer[0]), 0x3A);
 }
 
+TEST(Publish3, EncodeHeader_PlusPayloadMatchesEncode)
+{
+    const std::string topic = "sensor/data";
+    const std::vector<uint8_t> payload(300, 0x5A);
+
+    const Publish3 packet(topic, payload, QualityOfService::AtLeastOnce, true, 0x1234, true);
+    std::vector<std::byte> expected;
+    ByteWriter expectedWriter(expected);
+    packet.encode(expectedWriter);
+
+    std::vector<std::byte> header;
+    ByteWriter headerWriter(header);
+    encodePublishHeaderToWriter<ProtocolVersion::V311>(
+        headerWriter, topic, static_cast<uint32_t>(payload.size()), QualityOfService::AtLeastOnce, true, 0x1234, true);
+
+    ASSERT_EQ(header.size() + payload.size(), expected.size());
+    EXPECT_TRUE(std::equal(header.begin(), header.end(), expected.begin()));
+    EXPECT_EQ(std::memcmp(expected.data() + header.size(), payload.data(), payload.size()), 0);
+}
+
 TEST(Publish3, Decode_QoS0)
 {
     const auto data = toVec({ 0x30, 0x06, 0x00, 0x02, 't', '1', 0xAA, 0xBB });
@@ -205,6 +227,22 @@ TEST(Publish3, Decode_QoS0)
     EXPECT_EQ(packet.getPayload()[1], 0xBB);
 }
 
+TEST(Publish3, Decode_RejectsWildcardsAndMalformedUtf8InTopic)
+{
+    for (const unsigned int bad : { 0x2Bu, 0x23u, 0x00u, 0xC0u })
+    {
+        const auto data = toVec({ 0x30, 0x06, 0x00, 0x02, 't', bad, 0xAA, 0xBB });
+
+        ByteReader headerReader(data.data(), 2);
+        const FixedHeader header = FixedHeader::create(headerReader);
+
+        ByteReader payloadReader(data.data() + 2, data.size() - 2);
+        const Publish3 packet(payloadReader, header);
+
+        EXPECT_FALSE(packet.isValid()) << static_cast<int>(bad);
+    }
+}
+
 TEST(Publish3, Decode_QoS1WithPacketId)
 {
     const auto data = toVec({ 0x32, 0x08, 0x00, 0x02, 't', '2', 0x00, 0x2A, 0x11, 0x22 });
@@ -390,6 +428,26 @@ TEST(Publish5, Encode_QoS1WithPacketId)
     EXPECT_EQ(static_cast<uint8_t>(buffer[8]), 0xCD);
 }
 
+TEST(Publish5, EncodeHeader_PlusPayloadMatchesEncode)
+{
+    const std::string topic = "t";
+    const std::vector<uint8_t> payload = { 0xCD, 0xEF };
+
+    const Publish5 packet(topic, payload, QualityOfService::AtMostOnce, false, 0, Properties{}, false);
+    std::vector<std::byte> expected;
+    ByteWriter expectedWriter(expected);
+    packet.encode(expectedWriter);
+
+    std::vector<std::byte> header;
+    ByteWriter headerWriter(header);
+    encodePublishHeaderToWriter<ProtocolVersion::V5>(
+        headerWriter, topic, static_cast<uint32_t>(payload.size()), QualityOfService::AtMostOnce, false, 0, false);
+
+    ASSERT_EQ(header.size() + payload.size(), expected.size());
+    EXPECT_TRUE(std::equal(header.begin(), header.end(), expected.begin()));
+    EXPECT_EQ(std::memcmp(expected.data() + header.size(), payload.data(), payload.size()), 0);
+}
+
 TEST(Publish5, Decode_QoS0)
 {
     const auto data = toVec({ 0x30, 0x07, 0x00, 0x02, 't', '1', 0x00, 0xAA, 0xBB });
@@ -474,4 +532,26 @@ TEST(Publish5, RoundTrip_QoS2WithRetainAndDup)
     EXPECT_EQ(packet2.getShouldRetain(), packet1.getShouldRetain());
     EXPECT_EQ(packet2.getIsDuplicate(), packet1.getIsDuplicate());
     EXPECT_TRUE(packet2.isValid());
+}
+
+TEST(Publish5, Encode_ReservesExactPacketSizeUpFront)
+{
+    const Publish5 packet("sensors/cam", std::vector<uint8_t>(4096, 0x42), QualityOfService::AtLeastOnce, false, 3);
+    std::vector<std::byte> buffer;
+    ByteWriter writer(buffer);
+
+    packet.encode(writer);
+
+    EXPECT_EQ(buffer.capacity(), buffer.size());
+}
+
+TEST(Publish5, EncodeHeader_ReservesOnlyTheHeader)
+{
+    const Publish5 packet("sensors/cam", {}, QualityOfService::AtMostOnce, false);
+    std::vector<std::byte> buffer;
+    ByteWriter writer(buffer);
+
+    packet.encodeHeader(writer, 4096);
+
+    EXPECT_EQ(buffer.capacity(), buffer.size());
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/packets/pre_encoded_publish.h"
+#include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_template.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "serialize/bytes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt::packets;
+using namespace reactormq::mqtt;
+using namespace reactormq::serialize;
+
+namespace
+{
+    template<ProtocolVersion V>
+    std::vector<std::byte> encodeDirect(
+        const std::string& topic,
+        const std::uint32_t payloadSize,
+        const QualityOfService qos,
+        const bool shouldRetain,
+        const std::uint16_t packetId,
+        const bool isDuplicate,
+        const std::uint16_t topicAlias = 0,
+        const std::string_view payloadCodec = {},
+        const std::uint32_t messageExpiryInterval = 0)
+    {
+        std::vector<std::byte> header;
+        ByteWriter writer(header);
+        encodePublishHeaderToWriter<V>(
+            writer, topic, payloadSize, qos, shouldRetain, packetId, isDuplicate, topicAlias, payloadCodec, messageExpiryInterval);
+        return header;
+    }
+
+    std::vector<std::byte> encodeTemplated(
+        const PublishTemplate& publishTemplate,
+        const std::uint16_t packetId,
+        const std::uint32_t payloadSize,
+        const bool isDuplicate)
+    {
+        std::vector<std::byte> header;
+        const ByteWriter writer(header);
+        publishTemplate.encodeHeader(writer, packetId, payloadSize, isDuplicate);
+        EXPECT_EQ(header.size(), publishTemplate.getHeaderSize(payloadSize));
+        return header;
+    }
+} // namespace
+
+TEST(PublishTemplate, MatchesDirectEncodingForMqtt311)
+{
+    const std::string topic = "sensors/kitchen/temp";
+    for (const QualityOfService qos : { QualityOfService::AtMostOnce, QualityOfService::AtLeastOnce, QualityOfService::ExactlyOnce })
+    {
+        const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V311>(topic, qos, true);
+        for (const std::uint32_t payloadSize : { 0u, 64u, 100u, 20000u })
+        {
+            EXPECT_EQ(
+                encodeTemplated(publishTemplate, 42, payloadSize, false),
+                encodeDirect<ProtocolVersion::V311>(topic, payloadSize, qos, true, qos == QualityOfService::AtMostOnce ? 0 : 42, false));
+        }
+    }
+}
+
+TEST(PublishTemplate, MatchesDirectEncodingForMqtt5WithProperties)
+{
+    const std::string topic = "telemetry/1";
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V5>(topic, QualityOfService::AtLeastOnce, false, 7, "zstd");
+    for (const std::uint32_t payloadSize : { 0u, 90u, 200000u })
+    {
+        EXPECT_EQ(
+            encodeTemplated(publishTemplate, 513, payloadSize, true),
+            encodeDirect<ProtocolVersion::V5>(topic, payloadSize, QualityOfService::AtLeastOnce, false, 513, true, 7, "zstd"));
+    }
+}
+
+TEST(PublishTemplate, CarriesTheMessageExpiryIntervalForMqtt5)
+{
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V5>("a/b", QualityOfService::AtLeastOnce, false, 0, {}, 30);
+    const auto header = encodeTemplated(publishTemplate, 9, 4, false);
+    EXPECT_EQ(header, encodeDirect<ProtocolVersion::V5>("a/b", 4, QualityOfService::AtLeastOnce, false, 9, false, 0, {}, 30));
+
+    // Property block after the packet identifier: length 5, then Message Expiry Interval (0x02) as a four-byte integer.
+    const std::vector properties{ std::byte{ 5 }, std::byte{ 0x02 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 30 } };
+    ASSERT_GE(header.size(), properties.size());
+    EXPECT_TRUE(std::equal(properties.begin(), properties.end(), header.end() - static_cast<std::ptrdiff_t>(properties.size())));
+
+    EXPECT_TRUE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, false, 0, {}, 30));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, false, 0, {}, 29));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, false, 0, {}));
+}
+
+TEST(PublishTemplate, MatchesOnlyTheSettingsItWasCreatedFor)
+{
+    const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V5>("a/b", QualityOfService::AtLeastOnce, false);
+
+    EXPECT_TRUE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, false, 0, {}));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V311, "a/b", QualityOfService::AtLeastOnce, false, 0, {}));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "", QualityOfService::AtLeastOnce, false, 0, {}));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::ExactlyOnce, false, 0, {}));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, true, 0, {}));
+    EXPECT_FALSE(publishTemplate.matches(ProtocolVersion::V5, "a/b", QualityOfService::AtLeastOnce, false, 3, {}));
+    EXPECT_FALSE(PublishTemplate{}.matches(ProtocolVersion::V311, "", QualityOfService::AtMostOnce, false, 0, {}));
+}
+
+TEST(PublishTemplate, PreEncodedPublishPatchesThePacketIdIntoTheWholePacket)
+{
+    const std::string topic = "producers/3";
+    const std::vector<std::uint8_t> payload{ 1, 2, 3, 4, 5 };
+    for (const QualityOfService qos : { QualityOfService::AtMostOnce, QualityOfService::AtLeastOnce, QualityOfService::ExactlyOnce })
+    {
+        const auto publishTemplate = PublishTemplate::create<ProtocolVersion::V5>(topic, qos, false, 0, {}, 30);
+        PreEncodedPublish preEncoded(publishTemplate, payload, std::pmr::new_delete_resource());
+        ASSERT_FALSE(preEncoded.isEmpty());
+        EXPECT_TRUE(preEncoded.matches(ProtocolVersion::V5, 30));
+        EXPECT_FALSE(preEncoded.matches(ProtocolVersion::V5, 29));
+        EXPECT_FALSE(preEncoded.matches(ProtocolVersion::V311, 30));
+
+        const std::uint16_t packetId = qos == QualityOfService::AtMostOnce ? 0 : 0x1234;
+        std::vector<std::byte> expected = encodeDirect<ProtocolVersion::V5>(
+            topic, static_cast<std::uint32_t>(payload.size()), qos, false, packetId, false, 0, {}, 30);
+        for (const std::uint8_t byte : payload)
+        {
+            expected.push_back(static_cast<std::byte>(byte));
+        }
+
+        const std::span<const std::byte> packet = preEncoded.patchPacketId(0x1234);
+        EXPECT_EQ(std::vector<std::byte>(packet.begin(), packet.end()), expected);
+        EXPECT_EQ(preEncoded.getSize(), expected.size());
+
+        preEncoded.reset();
+        EXPECT_TRUE(preEncoded.isEmpty());
+    }
+}
@@ -0,0 +1,187 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "mqtt/packets/fixed_header.h"
+#include "mqtt/packets/properties/property_view.h"
+#include "mqtt/packets/publish.h"
+#include "mqtt/packets/publish_view.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "serialize/bytes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace reactormq::mqtt::packets;
+using namespace reactormq::mqtt::packets::properties;
+using namespace reactormq::mqtt;
+using namespace reactormq::serialize;
+
+static std::vector<std::byte> toVec(const std::initializer_list<unsigned int> bytes)
+{
+    std::vector<std::byte> v;
+    v.reserve(bytes.size());
+    for (const auto b : bytes)
+    {
+        v.push_back(std::byte{ static_cast<unsigned char>(b) });
+    }
+    return v;
+}
+
+TEST(PublishView3, Decode_QoS1ViewsTopicAndPayloadInPlace)
+{
+    const auto data = toVec({ 0x32, 0x08, 0x00, 0x02, 't', '2', 0x00, 0x2A, 0x11, 0x22 });
+
+    ByteReader headerReader(data.data(), 2);
+    const FixedHeader header = FixedHeader::create(headerReader);
+
+    ByteReader bodyReader(data.data() + 2, data.size() - 2);
+    const PublishView3 packet(bodyReader, header);
+
+    EXPECT_TRUE(packet.isValid());
+    EXPECT_EQ(packet.getTopicName(), "t2");
+    EXPECT_EQ(packet.getQualityOfService(), QualityOfService::AtLeastOnce);
+    EXPECT_EQ(packet.getPacketId(), 42u);
+    ASSERT_EQ(packet.getPayload().size(), 2u);
+    EXPECT_EQ(packet.getPayload()[0], 0x11);
+    EXPECT_EQ(packet.getPayload()[1], 0x22);
+    EXPECT_EQ(static_cast<const void*>(packet.getTopicName().data()), static_cast<const void*>(data.data() + 4));
+    EXPECT_EQ(static_cast<const void*>(packet.getPayload().data()), static_cast<const void*>(data.data() + 8));
+    EXPECT_TRUE(packet.getRawProperties().empty());
+}
+
+TEST(PublishView3, Decode_QoS2WithRetainAndDuplicate)
+{
+    const auto data = toVec({ 0x3D, 0x08, 0x00, 0x02, 't', '3', 0x00, 0x64, 0xFF, 0xEE });
+
+    ByteReader headerReader(data.data(), 2);
+    const FixedHeader header = FixedHeader::create(headerReader);
+
+    ByteReader bodyReader(data.data() + 2, data.size() - 2);
+    const PublishView3 packet(bodyReader, header);
+
+    EXPECT_TRUE(packet.isValid());
+    EXPECT_EQ(packet.getQualityOfService(), QualityOfService::ExactlyOnce);
+    EXPECT_TRUE(packet.getShouldRetain());
+    EXPECT_TRUE(packet.getIsDuplicate());
+    EXPECT_EQ(packet.getPacketId(), 100u);
+}
+
+TEST(PublishView3, Decode_TruncatedPayloadIsInvalid)
+{
+    const auto data = toVec({ 0x30, 0x08, 0x00, 0x02, 't', '1', 0xAA });
+
+    ByteReader headerReader(data.data(), 2);
+    const FixedHeader header = FixedHeader::create(headerReader);
+
+    ByteReader bodyReader(data.data() + 2, data.size() - 2);
+    const PublishView3 packet(bodyReader, header);
+
+    EXPECT_FALSE(packet.isValid());
+}
+
+TEST(PublishView5, Decode_SkipsPropertiesWithoutParsing)
+{
+    // Properties: length 5, Message Expiry Interval (0x02) = 60.
+    const auto data = toVec({ 0x30, 0x0C, 0x00, 0x02, 't', '1', 0x05, 0x02, 0x00, 0x00, 0x00, 0x3C, 0xAA, 0xBB });
+
+    ByteReader headerReader(data.data(), 2);
+    const FixedHeader header = FixedHeader::create(headerReader);
+
+    ByteReader bodyReader(data.data() + 2, data.size() - 2);
+    const PublishView5 packet(bodyReader, header);
+
+    EXPECT_TRUE(packet.isValid());
+    EXPECT_EQ(packet.getTopicName(), "t1");
+    EXPECT_EQ(packet.getRawProperties().size(), 6u);
+    ASSERT_EQ(packet.getPayload().size(), 2u);
+    EXPECT_EQ(packet.getPayload()[0], 0xAA);
+    EXPECT_EQ(packet.getPayload()[1], 0xBB);
+}
+
+TEST(PublishView5, Encode_RoundTripsOwningPublish)
+{
+    const Publish5 publish("sensors/cam", { 1, 2, 3, 4 }, QualityOfService::AtLeastOnce, true, 7);
+    std::vector<std::byte> encoded;
+    ByteWriter writer(encoded);
+    publish.encode(writer);
+
+    ByteReader reader(encoded.data(), encoded.size());
+    const FixedHeader header = FixedHeader::create(reader);
+    const PublishView5 view(reader, header);
+
+    ASSERT_TRUE(view.isValid());
+    EXPECT_EQ(view.getTopicName(), "sensors/cam");
+    EXPECT_EQ(view.getPacketId(), 7u);
+    EXPECT_TRUE(view.getShouldRetain());
+    EXPECT_EQ(view.getLength(), publish.getLength());
+
+    std::vector<std::byte> reencoded;
+    ByteWriter reencodedWriter(reencoded);
+    view.encode(reencodedWriter);
+    EXPECT_EQ(reencoded, encoded);
+}
+
+TEST(PublishView5, Decode_ReadsSubscriptionIdentifiers)
+{
+    const Publish5 publish(
+        "sensors/cam",
+        { 1 },
+        QualityOfService::AtMostOnce,
+        false,
+        0,
+        Properties{ { Property::create<PropertyIdentifier::SubscriptionIdentifier>(std::uint32_t{ 3 }),
+                      Property::create<PropertyIdentifier::SubscriptionIdentifier>(std::uint32_t{ 200 }) } });
+    std::vector<std::byte> encoded;
+    ByteWriter writer(encoded);
+    publish.encode(writer);
+
+    ByteReader reader(encoded.data(), encoded.size());
+    const FixedHeader header = FixedHeader::create(reader);
+    const PublishView5 view(reader, header);
+
+    ASSERT_TRUE(view.isValid());
+    const SubscriptionIdentifiers viewIdentifiers = view.getSubscriptionIdentifiers();
+    const auto identifiers = viewIdentifiers.get();
+    ASSERT_EQ(identifiers.size(), 2u);
+    EXPECT_EQ(identifiers[0], 3u);
+    EXPECT_EQ(identifiers[1], 200u);
+
+    const SubscriptionIdentifiers ownedIdentifiers = publish.getSubscriptionIdentifiers();
+    const auto owned = ownedIdentifiers.get();
+    EXPECT_TRUE(std::equal(owned.begin(), owned.end(), identifiers.begin(), identifiers.end()));
+}
+
+TEST(PublishView5, Decode_LooksUpPropertiesOnDemand)
+{
+    const Publish5 publish(
+        "sensors/cam",
+        { 1 },
+        QualityOfService::AtMostOnce,
+        false,
+        0,
+        Properties{ { Property::create<PropertyIdentifier::UserProperty>(std::pair<std::string, std::string>{ "unit", "lux" }),
+                      Property::create<PropertyIdentifier::TopicAlias>(std::uint16_t{ 5 }) } });
+    std::vector<std::byte> encoded;
+    ByteWriter writer(encoded);
+    publish.encode(writer);
+
+    ByteReader reader(encoded.data(), encoded.size());
+    const FixedHeader header = FixedHeader::create(reader);
+    const PublishView5 view(reader, header);
+
+    ASSERT_TRUE(view.isValid());
+    EXPECT_EQ(view.getTopicAlias(), 5u);
+    EXPECT_TRUE(view.getPayloadCodec().empty());
+    EXPECT_TRUE(view.getSubscriptionIdentifiers().get().empty());
+
+    const auto value = PropertiesView(view.getRawProperties()).findUserProperty("unit");
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(value.value(), "lux");
+    EXPECT_GE(reinterpret_cast<const std::byte*>(value->data()), encoded.data());
+    EXPECT_LT(reinterpret_cast<const std::byte*>(value->data()), encoded.data() + encoded.size());
+}
@@ -0,0 +1,117 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/client_coroutines.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+
+#include <coroutine>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+using namespace reactormq::mqtt::client;
+
+namespace
+{
+    /// @brief Minimal eagerly started coroutine type.
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void()
+            {
+            }
+
+            void unhandled_exception()
+            {
+            }
+        };
+    };
+
+    ConnectionSettingsPtr makeSettings()
+    {
+        ConnectionSettingsBuilder b;
+        b.setHost("localhost");
+        return b.build();
+    }
+
+    Detached readAll(MessageStream stream, std::vector<std::string>& topics, bool& ended)
+    {
+        while (auto message = co_await stream.next())
+        {
+            topics.push_back(message->getTopic());
+        }
+        ended = true;
+    }
+
+    Detached publishOnce(IClient& client, int& outcome)
+    {
+        Message message{ std::string("a/b"), Message::Payload{ 1 }, false, QualityOfService::AtMostOnce };
+        const auto result = co_await awaitPublish(client, std::move(message));
+        outcome = result.isSuccess() ? 1 : 0;
+    }
+} // namespace
+
+TEST(ClientCoroutinesTest, StreamYieldsQueuedAndLiveMessagesUntilClosed)
+{
+    MessageStream stream;
+    const auto handler = stream.getHandler();
+    handler(Message{ "early", Message::Payload{}, false, QualityOfService::AtMostOnce });
+
+    std::vector<std::string> topics;
+    bool ended = false;
+    readAll(stream, topics, ended);
+    EXPECT_EQ(topics, (std::vector<std::string>{ "early" }));
+
+    handler(Message{ "live", Message::Payload{}, false, QualityOfService::AtMostOnce });
+    EXPECT_EQ(topics, (std::vector<std::string>{ "early", "live" }));
+    EXPECT_FALSE(ended);
+
+    stream.close();
+    EXPECT_TRUE(ended);
+
+    handler(Message{ "late", Message::Payload{}, false, QualityOfService::AtMostOnce });
+    EXPECT_EQ(topics.size(), 2u);
+}
+
+TEST(ClientCoroutinesTest, RefusedSubscriptionEndsStream)
+{
+    const auto client = createClient(makeSettings());
+    std::vector<std::string> topics;
+    bool ended = false;
+    readAll(subscribeStream(*client, TopicFilter("a/#")), topics, ended);
+    EXPECT_FALSE(ended);
+
+    client->tick();
+    EXPECT_TRUE(ended);
+    EXPECT_TRUE(topics.empty());
+}
+
+TEST(ClientCoroutinesTest, AwaitPublishResumesOnTick)
+{
+    const auto client = createClient(makeSettings());
+    int outcome = -1;
+    publishOnce(*client, outcome);
+    EXPECT_EQ(outcome, -1);
+
+    client->tick();
+    EXPECT_EQ(outcome, 0);
+}
@@ -5,9 +5,11 @@
 #include <gtest/gtest.h>
 
 #include "reactormq/mqtt/connection_settings.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
 #include "reactormq/mqtt/credentials_provider.h"
 
 #include <memory>
+#include <memory_resource>
 #include <string>
 
 using namespace reactormq::mqtt;
@@ -58,4 +60,167 @@ TEST(MqttTypes_ConnectionSettings, DefaultsAndGetters)
     EXPECT_EQ(s.getMaxPacketRetries(), 3);
     EXPECT_TRUE(s.shouldVerifyServerCertificate());
     EXPECT_EQ(s.getSessionExpiryInterval(), 0u);
-}
\ No newline at end of file
+    EXPECT_EQ(s.getOutboundCoalesceMaxBytes(), 64u * 1024u);
+    EXPECT_EQ(s.getOutboundCoalesceMaxDelayMs(), 1u);
+    EXPECT_EQ(s.getPacketArenaSize(), 16u * 1024u);
+    EXPECT_EQ(s.getMaxOutboundTopicAliases(), 32u);
+    EXPECT_EQ(s.getMaxInboundTopicAliases(), 16u);
+    EXPECT_EQ(s.getMaxOfflinePublishes(), 0u);
+    EXPECT_EQ(s.getMaxOfflineQueueBytes(), 4u * 1024u * 1024u);
+    EXPECT_EQ(s.getOfflineQueuePolicy(), OfflineQueuePolicy::DropOldest);
+    EXPECT_EQ(s.getSessionStore(), nullptr);
+    EXPECT_FALSE(s.shouldPipelineSubscribesOnConnect());
+    EXPECT_EQ(s.getMaxInboundProcessingTimeUs(), 0u);
+    EXPECT_EQ(s.getMaxCommandsPerTick(), 0u);
+    EXPECT_EQ(s.getMaxCommandProcessingTimeUs(), 0u);
+    EXPECT_FALSE(s.shouldBatchCallbacks());
+    EXPECT_EQ(s.getMessageDispatchLanes(), 0u);
+    EXPECT_EQ(s.getMaxPendingDeliveries(), 0u);
+    EXPECT_EQ(s.getMaxPendingDeliveryBytes(), 0u);
+    EXPECT_FALSE(s.shouldAcknowledgeManually());
+    EXPECT_EQ(s.getReceiveMaximum(), 0u);
+    EXPECT_TRUE(s.getSocketOptions().noDelay);
+    EXPECT_EQ(s.getSocketOptions().sendBufferBytes, 0u);
+    EXPECT_EQ(s.getSocketOptions().receiveBufferBytes, 0u);
+    EXPECT_FALSE(s.getSocketOptions().quickAck);
+    EXPECT_FALSE(s.getWebSocketDeflate().enabled);
+    EXPECT_TRUE(s.getPayloadCodecs().empty());
+    EXPECT_EQ(s.getMaxInternedTopics(), 0u);
+    EXPECT_EQ(s.getMemoryResource(), std::pmr::new_delete_resource());
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesCompressionSettings)
+{
+    WebSocketDeflateOptions deflate;
+    deflate.enabled = true;
+    deflate.serverMaxWindowBits = 10;
+    ConnectionSettingsBuilder b;
+    b.setHost("h").setWebSocketDeflate(deflate).addPayloadCodec("a/#", nullptr);
+    const auto configured = b.build();
+    EXPECT_TRUE(configured->getWebSocketDeflate().enabled);
+    EXPECT_EQ(configured->getWebSocketDeflate().serverMaxWindowBits, 10u);
+    EXPECT_TRUE(configured->getPayloadCodecs().empty());
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesMaxInternedTopics)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("h").setMaxInternedTopics(512);
+    EXPECT_EQ(b.build()->getMaxInternedTopics(), 512u);
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesInboundStreamingThreshold)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("h");
+    EXPECT_EQ(b.build()->getInboundStreamingThreshold(), 0u);
+    b.setInboundStreamingThreshold(64 * 1024);
+    EXPECT_EQ(b.build()->getInboundStreamingThreshold(), 64u * 1024u);
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesResubscribeOnReconnect)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("h");
+    EXPECT_TRUE(b.build()->shouldResubscribeOnReconnect());
+    b.setResubscribeOnReconnect(false);
+    EXPECT_FALSE(b.build()->shouldResubscribeOnReconnect());
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesLastValueCacheSize)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("h");
+    EXPECT_EQ(b.build()->getLastValueCacheSize(), 0u);
+    b.setLastValueCacheSize(256);
+    EXPECT_EQ(b.build()->getLastValueCacheSize(), 256u);
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesMemoryResource)
+{
+    const auto pool = std::make_shared<std::pmr::unsynchronized_pool_resource>();
+    ConnectionSettingsBuilder b;
+    b.setHost("h").setMemoryResource(pool);
+    EXPECT_EQ(b.build()->getMemoryResource(), pool.get());
+}
+
+TEST(MqttTypes_ConnectionSettings, SocketOptionPresets)
+{
+    const SocketOptions lowLatency = SocketOptions::lowLatency();
+    EXPECT_TRUE(lowLatency.noDelay);
+    EXPECT_TRUE(lowLatency.quickAck);
+    EXPECT_GT(lowLatency.busyPollMicroseconds, 0u);
+    EXPECT_GT(lowLatency.userTimeoutMs, 0u);
+    EXPECT_EQ(lowLatency.sendBufferBytes, 0u);
+
+    const SocketOptions highThroughput = SocketOptions::highThroughput();
+    EXPECT_GT(highThroughput.sendBufferBytes, 0u);
+    EXPECT_GT(highThroughput.receiveBufferBytes, 0u);
+    EXPECT_FALSE(highThroughput.quickAck);
+    EXPECT_EQ(highThroughput.busyPollMicroseconds, 0u);
+}
+
+TEST(MqttTypes_ConnectionSettings, BuilderCarriesTlsTuning)
+{
+    ConnectionSettingsBuilder b;
+    b.setHost("h");
+    EXPECT_EQ(b.build()->getTlsTuning().cipherPreference, TlsCipherPreference::LibraryDefault);
+    EXPECT_FALSE(b.build()->getTlsTuning().dynamicRecordSizing);
+
+    TlsTuningOptions tuning = TlsTuningOptions::lowLatency();
+    tuning.maxFragmentLength = 2048;
+    b.setTlsTuning(tuning);
+    const auto settings = b.build();
+    EXPECT_EQ(settings->getTlsTuning().cipherPreference, TlsCipherPreference::Auto);
+    EXPECT_TRUE(settings->getTlsTuning().dynamicRecordSizing);
+    EXPECT_EQ(settings->getTlsTuning().maxFragmentLength, 2048u);
+
+    const TlsTuningOptions highThroughput = TlsTuningOptions::highThroughput();
+    EXPECT_EQ(highThroughput.cipherPreference, TlsCipherPreference::Auto);
+    EXPECT_FALSE(highThroughput.dynamicRecordSizing);
+}
+
+TEST(MqttTypes_ConnectionSettings, ProfileSetsItsKnobsAndSettersOverrideThem)
+{
+    ConnectionSettingsBuilder b("h");
+    b.setKeepAliveIntervalSeconds(15).applyProfile(PerformanceProfile::GameThread).setMaxCommandsPerTick(8);
+    auto settings = b.build();
+    EXPECT_EQ(settings->getHost(), "h");
+    EXPECT_EQ(settings->getKeepAliveIntervalSeconds(), 15u);
+    EXPECT_EQ(settings->getMaxInboundPacketsPerTick(), 64u);
+    EXPECT_EQ(settings->getMaxCommandsPerTick(), 8u);
+    EXPECT_TRUE(settings->shouldBatchCallbacks());
+
+    b.applyProfile(PerformanceProfile::Embedded);
+    settings = b.build();
+    EXPECT_EQ(settings->getMaxInboundPacketsPerTick(), 16u);
+    EXPECT_EQ(settings->getMaxCommandsPerTick(), 16u);
+    EXPECT_FALSE(settings->shouldBatchCallbacks());
+    EXPECT_LE(settings->getMaxPacketSize(), settings->getMaxBufferSize());
+    EXPECT_EQ(settings->getTlsTuning().maxFragmentLength, 2048u);
+
+    b.applyProfile(PerformanceProfile::LowLatency);
+    settings = b.build();
+    EXPECT_EQ(settings->getOutboundCoalesceMaxBytes(), 0u);
+    EXPECT_TRUE(settings->getSocketOptions().quickAck);
+    EXPECT_FALSE(settings->getBusyPoll().isEnabled);
+    EXPECT_EQ(settings->getTlsTuning().maxFragmentLength, 0u);
+
+    b.applyProfile(PerformanceProfile::HighThroughput);
+    settings = b.build();
+    EXPECT_GT(settings->getOutboundCoalesceMaxBytes(), ConnectionSettingsBuilder("h").build()->getOutboundCoalesceMaxBytes());
+    EXPECT_GT(settings->getSocketOptions().receiveBufferBytes, 0u);
+    EXPECT_FALSE(settings->getSocketOptions().quickAck);
+    EXPECT_TRUE(settings->shouldEncodePublishesOnCallingThread());
+
+    // Default puts every knob a profile covers back, and only those.
+    b.applyProfile(PerformanceProfile::Default);
+    settings = b.build();
+    const auto defaults = ConnectionSettingsBuilder("h").build();
+    EXPECT_EQ(settings->getOutboundCoalesceMaxBytes(), defaults->getOutboundCoalesceMaxBytes());
+    EXPECT_EQ(settings->getMaxInboundPacketsPerTick(), defaults->getMaxInboundPacketsPerTick());
+    EXPECT_EQ(settings->getPacketArenaSize(), defaults->getPacketArenaSize());
+    EXPECT_FALSE(settings->shouldEncodePublishesOnCallingThread());
+    EXPECT_EQ(settings->getKeepAliveIntervalSeconds(), 15u);
+    EXPECT_STREQ(performanceProfileToString(PerformanceProfile::GameThread), "GameThread");
+}
@@ -0,0 +1,72 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "reactormq/mqtt/inline_function.h"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace reactormq::mqtt;
+
+TEST(InlineFunctionTest, SmallCallableIsStoredInlineAndInvoked)
+{
+    int calls = 0;
+    const auto increment = [&calls](const int by)
+    {
+        calls += by;
+        return calls;
+    };
+    static_assert(InlineFunction<int(int)>::isStoredInline<decltype(increment)>());
+
+    const InlineFunction<int(int)> fn = increment;
+    ASSERT_TRUE(fn);
+    EXPECT_EQ(fn(2), 2);
+    EXPECT_EQ(fn(3), 5);
+}
+
+TEST(InlineFunctionTest, LargeCallableFallsBackToTheHeap)
+{
+    std::array<int, 32> values{};
+    values[31] = 7;
+    const auto sum = [values]
+    {
+        return values[31];
+    };
+    static_assert(!InlineFunction<int()>::isStoredInline<decltype(sum)>());
+
+    const InlineFunction<int()> fn = sum;
+    EXPECT_EQ(fn(), 7);
+}
+
+TEST(InlineFunctionTest, MoveTransfersOwnershipAndEmptiesTheSource)
+{
+    auto owned = std::make_shared<int>(4);
+    const std::weak_ptr<int> watch = owned;
+
+    InlineFunction<int()> source = [captured = std::move(owned)]
+    {
+        return *captured;
+    };
+    InlineFunction<int()> target = std::move(source);
+    EXPECT_FALSE(source);
+    ASSERT_TRUE(target);
+    EXPECT_EQ(target(), 4);
+
+    target = nullptr;
+    EXPECT_FALSE(target);
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(InlineFunctionTest, AcceptsMoveOnlyCallables)
+{
+    InlineFunction<int()> fn = [value = std::make_unique<int>(9)]
+    {
+        return *value;
+    };
+    EXPECT_EQ(fn(), 9);
+
+    InlineFunction<void()> empty = static_cast<void (*)()>(nullptr);
+    EXPECT_FALSE(empty);
+}
@@ -0,0 +1,49 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "reactormq/mqtt/message.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace reactormq::mqtt;
+
+static_assert(std::is_nothrow_move_assignable_v<Message>);
+static_assert(std::is_copy_assignable_v<Message>);
+
+TEST(MqttTypes_Message, AssignmentTakesTheWholeMessage)
+{
+    Message message(std::string("a"), Message::Payload{ 1, 2 }, false, QualityOfService::AtMostOnce);
+    const Message other(std::string("b"), Message::Payload{ 3 }, true, QualityOfService::ExactlyOnce);
+
+    message = other;
+    EXPECT_EQ(message.getTopic(), "b");
+    EXPECT_EQ(message.getPayload(), (Message::Payload{ 3 }));
+    EXPECT_TRUE(message.shouldRetain());
+    EXPECT_EQ(message.getQualityOfService(), QualityOfService::ExactlyOnce);
+    EXPECT_EQ(message.getPayloadView().data(), other.getPayloadView().data());
+
+    std::vector<Message> messages;
+    for (int i = 0; i < 64; ++i)
+    {
+        messages.emplace_back(std::to_string(i), Message::Payload{ static_cast<std::uint8_t>(i) }, false, QualityOfService::AtMostOnce);
+    }
+    messages.erase(messages.begin());
+    EXPECT_EQ(messages.front().getTopic(), "1");
+    EXPECT_EQ(messages.back().getPayload(), (Message::Payload{ 63 }));
+}
+
+TEST(MqttTypes_Message, TimestampIsOnlySetWhenStamped)
+{
+    Message message(std::string("a"), Message::Payload{}, false, QualityOfService::AtMostOnce);
+    EXPECT_EQ(message.getTimestampUtc(), Message::Clock::time_point{});
+
+    const auto receivedAt = Message::Clock::time_point{ std::chrono::seconds(1700000000) };
+    const Message stamped(std::move(message), receivedAt);
+    EXPECT_EQ(stamped.getTimestampUtc(), receivedAt);
+    EXPECT_EQ(stamped.getTopic(), "a");
+}
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -562,6 +563,147 @@ TEST(Delegates_MulticastDelegate, ThreadSafety_ConcurrentAddRemoveBroadcast)
     SUCCEED();
 }
 
+TEST(Delegates_MulticastDelegate, RemovedCallableIsFreedOnceNoBroadcastIsReadingIt)
+{
+    MulticastDelegate<void(int)> delegate;
+
+    auto sentinel = std::make_shared<int>(0);
+    const std::weak_ptr<int> watch = sentinel;
+    bool aliveDuringCall = false;
+    DelegateHandle handle;
+
+    handle = delegate.add(
+        [&handle, &aliveDuringCall, &watch, sentinel = std::move(sentinel)](int)
+        {
+            ++*sentinel;
+            handle.disconnect();
+            aliveDuringCall = !watch.expired();
+        });
+
+    delegate.broadcast(1);
+    EXPECT_TRUE(aliveDuringCall);
+    EXPECT_EQ(delegate.getSize(), 0u);
+    EXPECT_FALSE(watch.expired()) << "The callable the broadcast was running is only freed by the next change";
+
+    auto other = delegate.add(
+        [](int)
+        {
+        });
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(Delegates_MulticastDelegate, LoneListenerIsCalledAsListenersComeAndGo)
+{
+    MulticastDelegate<int(int)> delegate;
+
+    auto first = delegate.add(
+        [](const int x)
+        {
+            return x + 1;
+        });
+    EXPECT_EQ(delegate.broadcast(1), std::vector<int>{ 2 });
+
+    auto second = delegate.add(
+        [](const int x)
+        {
+            return x + 2;
+        });
+    EXPECT_EQ(delegate.broadcast(1), (std::vector<int>{ 2, 3 }));
+
+    first.disconnect();
+    EXPECT_EQ(delegate.broadcast(1), std::vector<int>{ 3 });
+
+    // A lone callable held by weak reference still goes through the expiry check.
+    second.disconnect();
+    auto callable = std::make_shared<std::function<int(int)>>(
+        [](const int x)
+        {
+            return x + 3;
+        });
+    auto weak = delegate.addCallable(callable);
+    EXPECT_EQ(delegate.broadcast(1), std::vector<int>{ 4 });
+    callable.reset();
+    EXPECT_TRUE(delegate.broadcast(1).empty());
+    EXPECT_EQ(delegate.getSize(), 0u);
+
+    delegate.clear();
+    EXPECT_TRUE(delegate.broadcast(1).empty());
+}
+
+TEST(Delegates_MulticastDelegate, StaleHandleMissesSlotThatReusedItsIndex)
+{
+    MulticastDelegate<void()> delegate;
+    int firstCalls = 0;
+    int secondCalls = 0;
+
+    auto stale = delegate.add(
+        [&firstCalls]
+        {
+            ++firstCalls;
+        });
+    delegate.clear();
+    EXPECT_FALSE(stale.isValid());
+
+    auto current = delegate.add(
+        [&secondCalls]
+        {
+            ++secondCalls;
+        });
+    stale.disconnect();
+    delegate.broadcast();
+
+    EXPECT_EQ(firstCalls, 0);
+    EXPECT_EQ(secondCalls, 1);
+    EXPECT_TRUE(current.isValid());
+    EXPECT_EQ(delegate.getSize(), 1u);
+}
+
+TEST(Delegates_MulticastDelegate, OrderSurvivesChurnAndCompaction)
+{
+    MulticastDelegate<int()> delegate;
+    std::vector<DelegateHandle> handles;
+    for (int i = 0; i < 40; ++i)
+    {
+        handles.push_back(delegate.add(
+            [i]
+            {
+                return i;
+            }));
+    }
+
+    // Removing most slots and cycling others through the freed indices compacts the array several times over.
+    std::vector<int> expected;
+    for (int i = 0; i < 40; ++i)
+    {
+        if (i % 5 == 0)
+        {
+            expected.push_back(i);
+        }
+        else
+        {
+            handles[static_cast<size_t>(i)].disconnect();
+        }
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        auto transient = delegate.add(
+            []
+            {
+                return -1;
+            });
+        transient.disconnect();
+    }
+    auto last = delegate.add(
+        []
+        {
+            return 40;
+        });
+    expected.push_back(40);
+
+    EXPECT_EQ(delegate.broadcast(), expected);
+    EXPECT_EQ(delegate.getSize(), expected.size());
+}
+
 TEST(Delegates_MulticastDelegate, OrderPreserved)
 {
     MulticastDelegate<void(int)> delegate;
@@ -0,0 +1,110 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "reactormq/mqtt/payload_source.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <vector>
+
+using namespace reactormq::mqtt;
+
+namespace
+{
+    std::vector<std::uint8_t> readAll(IPayloadSource& source, const size_t chunkSize)
+    {
+        std::vector<std::uint8_t> result;
+        std::vector<std::uint8_t> chunk(chunkSize);
+        while (result.size() < source.getSize())
+        {
+            const size_t count = std::min(chunkSize, source.getSize() - result.size());
+            if (source.read(std::span{ chunk.data(), count }) != count)
+            {
+                break;
+            }
+            result.insert(result.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+        return result;
+    }
+} // namespace
+
+TEST(MqttTypes_PayloadSource, MemorySourceReadsInChunksAndRewinds)
+{
+    std::vector<std::uint8_t> bytes(1000);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t{ 0 });
+    const PayloadSourcePtr source = createPayloadSource(SharedPayload::copyOf(bytes));
+
+    ASSERT_EQ(source->getSize(), bytes.size());
+    EXPECT_EQ(readAll(*source, 64), bytes);
+    ASSERT_TRUE(source->rewind());
+    EXPECT_EQ(readAll(*source, 333), bytes);
+}
+
+TEST(MqttTypes_PayloadSource, CallbackSourceForwardsReadsAndOnlyRewindsWhenAsked)
+{
+    size_t produced = 0;
+    const auto reader = [&produced](const std::span<std::uint8_t> out)
+    {
+        for (std::uint8_t& byte : out)
+        {
+            byte = static_cast<std::uint8_t>(produced++);
+        }
+        return out.size();
+    };
+
+    const PayloadSourcePtr oneShot = createPayloadSource(10, reader);
+    EXPECT_EQ(oneShot->getSize(), 10u);
+    EXPECT_EQ(readAll(*oneShot, 4), (std::vector<std::uint8_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_FALSE(oneShot->rewind());
+
+    produced = 0;
+    const PayloadSourcePtr rewindable = createPayloadSource(
+        3,
+        reader,
+        [&produced]
+        {
+            produced = 0;
+            return true;
+        });
+    EXPECT_EQ(readAll(*rewindable, 3), (std::vector<std::uint8_t>{ 0, 1, 2 }));
+    ASSERT_TRUE(rewindable->rewind());
+    EXPECT_EQ(readAll(*rewindable, 1), (std::vector<std::uint8_t>{ 0, 1, 2 }));
+}
+
+TEST(MqttTypes_PayloadSource, CallbackSourceReportsAShortRead)
+{
+    const PayloadSourcePtr source = createPayloadSource(8, [](std::span<std::uint8_t> /*out*/) { return size_t{ 2 }; });
+    std::array<std::uint8_t, 8> out{};
+    EXPECT_EQ(source->read(out), 2u);
+}
+
+TEST(MqttTypes_PayloadSource, FileSourceReadsTheFileAsItIsSent)
+{
+    const auto path = std::filesystem::temp_directory_path() / "reactormq_payload_source_test.bin";
+    std::vector<std::uint8_t> bytes(70000);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t{ 7 });
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    {
+        const PayloadSourcePtr source = createFilePayloadSource(path.string());
+        ASSERT_NE(source, nullptr);
+        ASSERT_EQ(source->getSize(), bytes.size());
+        EXPECT_EQ(readAll(*source, 16384), bytes);
+        ASSERT_TRUE(source->rewind());
+        EXPECT_EQ(readAll(*source, 65536), bytes);
+    }
+
+    std::filesystem::remove(path);
+    EXPECT_EQ(createFilePayloadSource(path.string()), nullptr);
+}
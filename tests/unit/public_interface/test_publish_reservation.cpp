@@ -0,0 +1,88 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "reactormq/mqtt/publish_reservation.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+using namespace reactormq::mqtt;
+
+namespace
+{
+    class CountingResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t outstanding = 0;
+
+    private:
+        void* do_allocate(const size_t bytes, const size_t alignment) override
+        {
+            ++outstanding;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, const size_t bytes, const size_t alignment) override
+        {
+            --outstanding;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace
+
+TEST(MqttTypes_PublishReservation, CommittedMessageSharesTheWrittenBytes)
+{
+    PublishReservation reservation("sensors/t", 64, QualityOfService::AtLeastOnce, true);
+    const auto payload = reservation.getPayload();
+    ASSERT_EQ(payload.size(), 64u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(payload.data()) % PublishReservation::kPayloadAlignment, 0u);
+    std::memcpy(payload.data(), "hello", 5);
+
+    const Message message = reservation.commit(5);
+    EXPECT_EQ(message.getTopic(), "sensors/t");
+    EXPECT_EQ(message.getQualityOfService(), QualityOfService::AtLeastOnce);
+    EXPECT_TRUE(message.shouldRetain());
+    EXPECT_EQ(message.getPayloadView().data(), payload.data());
+    EXPECT_EQ(message.getPayloadView().size(), 5u);
+    EXPECT_TRUE(reservation.getPayload().empty());
+}
+
+TEST(MqttTypes_PublishReservation, ReservesHeadroomForTheHeaderAndClampsTheCommit)
+{
+    EXPECT_GE(PublishReservation::getHeadroom(3), 1u + 4u + 2u + 3u + 2u);
+    EXPECT_EQ(PublishReservation::getHeadroom(100) % PublishReservation::kPayloadAlignment, 0u);
+
+    PublishReservation reservation("t", 8, QualityOfService::AtMostOnce, false);
+    const Message message = reservation.commit(100);
+    EXPECT_EQ(message.getPayloadView().size(), 8u);
+    EXPECT_NE(message.getSharedPayload().claimHeadroom(PublishReservation::getHeadroom(1)), nullptr);
+    EXPECT_EQ(message.getSharedPayload().claimHeadroom(1), nullptr);
+}
+
+TEST(MqttTypes_PublishReservation, BufferGoesBackToItsResource)
+{
+    CountingResource resource;
+    {
+        PublishReservation reservation("t", 32, QualityOfService::AtMostOnce, false, &resource);
+        EXPECT_GT(resource.outstanding, 0u);
+        const Message message = reservation.commit(32);
+        const Message copy = message;
+        EXPECT_GT(resource.outstanding, 0u);
+    }
+    EXPECT_EQ(resource.outstanding, 0u);
+
+    {
+        const PublishReservation unused("t", 32, QualityOfService::AtMostOnce, false, &resource);
+    }
+    EXPECT_EQ(resource.outstanding, 0u);
+}
@@ -6,6 +6,7 @@
 
 #include "reactormq/mqtt/result.h"
 
+#include <cstdint>
 #include <memory>
 
 using namespace reactormq::mqtt;
@@ -26,4 +27,43 @@ TEST(MqttTypes_Result, GenericAndVoid)
     EXPECT_TRUE(voidOk.hasSucceeded());
     const Result<void> voidFail{ false };
     EXPECT_FALSE(voidFail.hasSucceeded());
-}
\ No newline at end of file
+}
+TEST(MqttTypes_Result, FailureCarriesErrorAndStaticDetail)
+{
+    const auto ok = Result<void>::success();
+    EXPECT_EQ(ok.getError(), ResultError::None);
+    EXPECT_EQ(ok.getErrorDetail(), nullptr);
+
+    const auto full = Result<void>::failure(ResultError::OutboundQueueFull);
+    EXPECT_FALSE(full.hasSucceeded());
+    EXPECT_EQ(full.getError(), ResultError::OutboundQueueFull);
+    EXPECT_EQ(full.getErrorDetail(), nullptr);
+    EXPECT_STREQ(resultErrorToString(full.getError()), "Outbound queue full");
+    EXPECT_FALSE(full.hasExpired());
+
+    const auto malformed = Result<int>::failure(ResultError::MalformedPacket, "Empty SUBACK");
+    EXPECT_FALSE(malformed.hasSucceeded());
+    EXPECT_EQ(malformed.getResult(), nullptr);
+    EXPECT_EQ(malformed.getError(), ResultError::MalformedPacket);
+    EXPECT_STREQ(malformed.getErrorDetail(), "Empty SUBACK");
+
+    const auto expired = Result<void>::expired();
+    EXPECT_TRUE(expired.hasExpired());
+    EXPECT_EQ(expired.getError(), ResultError::Expired);
+
+    // The string overload predates ResultError and still does not keep its reason.
+    const auto legacy = Result<int>::failure("reason");
+    EXPECT_EQ(legacy.getError(), ResultError::Unspecified);
+    EXPECT_EQ(legacy.getErrorDetail(), nullptr);
+    EXPECT_EQ(Result<int>{ false }.getError(), ResultError::Unspecified);
+    EXPECT_EQ((Result<int>{ true, 1 }).getError(), ResultError::None);
+}
+
+TEST(MqttTypes_Result, EveryErrorHasADescription)
+{
+    for (auto value = static_cast<std::uint8_t>(ResultError::None); value <= static_cast<std::uint8_t>(ResultError::PartialFailure);
+         ++value)
+    {
+        EXPECT_STRNE(resultErrorToString(static_cast<ResultError>(value)), "Unknown error") << static_cast<int>(value);
+    }
+}
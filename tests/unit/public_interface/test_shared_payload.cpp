@@ -0,0 +1,133 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/shared_payload.h"
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace reactormq::mqtt;
+
+TEST(MqttTypes_SharedPayload, DefaultIsEmpty)
+{
+    const SharedPayload payload;
+    EXPECT_TRUE(payload.isEmpty());
+    EXPECT_EQ(payload.getData(), nullptr);
+    EXPECT_TRUE(payload.asVector().empty());
+}
+
+TEST(MqttTypes_SharedPayload, AdoptsVectorWithoutCopy)
+{
+    std::vector<std::uint8_t> bytes{ 1, 2, 3 };
+    const std::uint8_t* data = bytes.data();
+
+    const SharedPayload payload(std::move(bytes));
+
+    EXPECT_EQ(payload.getData(), data);
+    EXPECT_EQ(payload.getSize(), 3u);
+    EXPECT_EQ(payload.asVector().data(), data);
+}
+
+TEST(MqttTypes_SharedPayload, CopiesShareOneBuffer)
+{
+    const SharedPayload payload = SharedPayload::copyOf(std::array<std::uint8_t, 4>{ 4, 5, 6, 7 });
+    const SharedPayload copy = payload;
+
+    EXPECT_EQ(copy.getData(), payload.getData());
+    EXPECT_EQ(payload.getUseCount(), 2);
+}
+
+TEST(MqttTypes_SharedPayload, AdoptedMemoryIsReleasedOnceWhenLastCopyGoes)
+{
+    static constexpr std::array<std::uint8_t, 3> kFrame{ 9, 8, 7 };
+    int releases = 0;
+    {
+        const SharedPayload payload = SharedPayload::adopt(kFrame.data(), kFrame.size(), [&releases](const std::uint8_t*) { ++releases; });
+        const Message first("cam/a", payload, false, QualityOfService::AtMostOnce);
+        const Message second = first;
+
+        EXPECT_EQ(first.getPayloadView().data(), kFrame.data());
+        EXPECT_EQ(second.getPayloadView().data(), kFrame.data());
+        EXPECT_EQ(releases, 0);
+    }
+    EXPECT_EQ(releases, 1);
+}
+
+TEST(MqttTypes_SharedPayload, AsVectorMaterializesAdoptedMemoryOnce)
+{
+    static constexpr std::array<std::uint8_t, 2> kFrame{ 0xAA, 0xBB };
+    const SharedPayload payload = SharedPayload::adopt(kFrame.data(), kFrame.size(), [](const std::uint8_t*) {});
+    const SharedPayload copy = payload;
+
+    const auto& bytes = payload.asVector();
+    EXPECT_EQ(bytes, (std::vector<std::uint8_t>{ 0xAA, 0xBB }));
+    EXPECT_EQ(&copy.asVector(), &bytes);
+    EXPECT_EQ(payload.getData(), kFrame.data());
+}
+
+TEST(MqttTypes_SharedPayload, CopiedMessageSharesPayload)
+{
+    const Message original(std::string("t"), Message::Payload(1024, 0x11), false, QualityOfService::AtLeastOnce);
+    const Message copy = original;
+
+    EXPECT_EQ(copy.getPayload().data(), original.getPayload().data());
+    EXPECT_EQ(original.getSharedPayload().getUseCount(), 2);
+}
+
+TEST(MqttTypes_SharedPayload, CopyFromResourceReturnsEverythingToIt)
+{
+    class CountingResource final : public std::pmr::memory_resource
+    {
+    public:
+        size_t outstanding = 0;
+
+    private:
+        void* do_allocate(const size_t bytes, const size_t alignment) override
+        {
+            ++outstanding;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, const size_t bytes, const size_t alignment) override
+        {
+            --outstanding;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    CountingResource resource;
+    static constexpr std::array<std::uint8_t, 4> kBytes{ 1, 2, 3, 4 };
+    {
+        const SharedPayload payload = SharedPayload::copyOf(kBytes, &resource);
+        const SharedPayload copy = payload;
+        EXPECT_GT(resource.outstanding, 0u);
+        EXPECT_EQ(std::vector<std::uint8_t>(copy.getView().begin(), copy.getView().end()), (std::vector<std::uint8_t>{ 1, 2, 3, 4 }));
+        EXPECT_NE(payload.getData(), kBytes.data());
+    }
+    EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(MqttTypes_SharedPayload, SharedOwnerIsHeldUntilLastCopyGoes)
+{
+    const auto frame = std::make_shared<std::array<std::uint8_t, 4>>(std::array<std::uint8_t, 4>{ 1, 2, 3, 4 });
+    {
+        const SharedPayload payload = SharedPayload::share(std::shared_ptr<const std::uint8_t>(frame, frame->data() + 1), 2);
+        const SharedPayload copy = payload;
+        EXPECT_EQ(copy.getData(), frame->data() + 1);
+        EXPECT_EQ(copy.getSize(), 2u);
+        EXPECT_EQ(frame.use_count(), 2);
+    }
+    EXPECT_EQ(frame.use_count(), 1);
+}
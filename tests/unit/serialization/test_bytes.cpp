@@ -4,6 +4,8 @@
 
 #include <array>
 #include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
 
 #include "serialize/bytes.h"
 #include "serialize/endian.h"
@@ -96,4 +98,79 @@ TEST(Serialize_Bytes, ReaderBoundsChecks_NoExceptions)
     EXPECT_TRUE(r.tryReadUint16(a));
     EXPECT_TRUE(r.tryReadUint16(b));
     EXPECT_FALSE(r.tryReadUint8(c));
+}
+
+TEST(Serialize_Bytes, ReaderStringViewPointsIntoBuffer)
+{
+    const std::vector buf = { std::byte{ 'a' }, std::byte{ 'b' }, std::byte{ 'c' } };
+    ByteReader r(buf.data(), buf.size());
+
+    std::string_view text;
+    EXPECT_TRUE(r.tryReadStringView(2, text));
+    EXPECT_EQ(text, "ab");
+    EXPECT_EQ(static_cast<const void*>(text.data()), static_cast<const void*>(buf.data()));
+    EXPECT_FALSE(r.tryReadStringView(2, text));
+    EXPECT_EQ(text, "ab");
+    EXPECT_EQ(r.getRemaining(), 1u);
+}
+
+TEST(Serialize_Bytes, ByteWriterReserveAvoidsReallocation)
+{
+    std::vector<std::byte> buf;
+    const ByteWriter w(buf);
+
+    w.reserve(14);
+    const std::byte* data = buf.data();
+    w.writeUint16(0x0102u);
+    w.writeUint32(0x03040506u);
+    w.writeUint64(0x0708090A0B0C0D0Eull);
+
+    EXPECT_EQ(buf.data(), data);
+    EXPECT_EQ(buf.size(), 14u);
+    EXPECT_EQ(static_cast<unsigned int>(buf[0]), 0x01u);
+    EXPECT_EQ(static_cast<unsigned int>(buf[13]), 0x0Eu);
+}
+
+TEST(Serialize_Bytes, ByteWriterReserveGrowsGeometrically)
+{
+    std::vector<std::byte> buf;
+    const ByteWriter w(buf);
+
+    w.reserve(100);
+    const size_t initial = buf.capacity();
+    std::array<std::byte, 100> blob{};
+    w.writeBytes(blob.data(), blob.size());
+
+    w.reserve(1);
+    EXPECT_GE(buf.capacity(), 2 * initial);
+}
+
+TEST(Serialize_Bytes, SpanWriterWritesIntoFixedStorage)
+{
+    std::array<std::byte, 8> storage{};
+    const ByteWriter w{ std::span<std::byte>{ storage } };
+
+    w.writeUint8(0x40u);
+    w.writeUint8(0x02u);
+    w.writeUint16(0x1234u);
+
+    EXPECT_FALSE(w.hasOverflowed());
+    EXPECT_EQ(w.getSize(), 4u);
+    EXPECT_EQ(static_cast<unsigned int>(storage[0]), 0x40u);
+    EXPECT_EQ(static_cast<unsigned int>(storage[2]), 0x12u);
+    EXPECT_EQ(static_cast<unsigned int>(storage[3]), 0x34u);
+}
+
+TEST(Serialize_Bytes, SpanWriterReportsOverflowAndStopsWriting)
+{
+    std::array<std::byte, 4> storage{};
+    const ByteWriter w{ std::span<std::byte>{ storage } };
+
+    w.writeUint16(0xAAAAu);
+    w.writeUint32(0xBBBBBBBBu);
+    w.writeUint8(0xCCu);
+
+    EXPECT_TRUE(w.hasOverflowed());
+    EXPECT_EQ(w.getSize(), 2u);
+    EXPECT_EQ(static_cast<unsigned int>(storage[2]), 0x00u);
 }
\ No newline at end of file
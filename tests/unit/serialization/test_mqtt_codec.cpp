@@ -5,6 +5,8 @@
 #include "serialize/mqtt_codec.h"
 
 #include <gtest/gtest.h>
+#include <span>
+#include <string_view>
 #include <vector>
 
 using namespace reactormq::serialize;
@@ -235,6 +237,35 @@ TEST(MqttCodec, DecodeString_InsufficientData)
     EXPECT_FALSE(result);
 }
 
+TEST(MqttCodec, DecodeStringView_PointsIntoBuffer)
+{
+    std::vector<std::byte> buffer;
+    const ByteWriter writer(buffer);
+    ASSERT_TRUE(encodeString("topic/a", writer));
+
+    ByteReader reader(buffer.data(), buffer.size());
+    std::string_view decoded;
+    ASSERT_TRUE(decodeStringView(reader, decoded));
+    EXPECT_EQ(decoded, "topic/a");
+    EXPECT_EQ(static_cast<const void*>(decoded.data()), static_cast<const void*>(buffer.data() + 2));
+    EXPECT_TRUE(reader.isEof());
+}
+
+TEST(MqttCodec, DecodeBinaryDataView_PointsIntoBufferAndChecksLength)
+{
+    const std::vector buffer = { std::byte{ 0x00 }, std::byte{ 0x02 }, std::byte{ 0x00 }, std::byte{ 0xFF }, std::byte{ 0x00 } };
+
+    ByteReader reader(buffer.data(), buffer.size());
+    std::span<const std::byte> decoded;
+    ASSERT_TRUE(decodeBinaryDataView(reader, decoded));
+    EXPECT_EQ(decoded.data(), buffer.data() + 2);
+    EXPECT_EQ(decoded.size(), 2u);
+    EXPECT_EQ(reader.getRemaining(), 1u);
+
+    ByteReader truncated(buffer.data() + 3, buffer.size() - 3);
+    EXPECT_FALSE(decodeBinaryDataView(truncated, decoded));
+}
+
 // Payload Encoding Tests
 TEST(MqttCodec, EncodeDecodePayload_Empty)
 {
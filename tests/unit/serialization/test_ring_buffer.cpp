@@ -0,0 +1,202 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include <gtest/gtest.h>
+
+#include "serialize/ring_buffer.h"
+#include "util/system/buffer_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace reactormq::serialize;
+
+TEST(Serialize_RingBuffer, StartsEmptyAndUnallocated)
+{
+    const RingBuffer ring;
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.getSize(), 0u);
+    EXPECT_EQ(ring.getCapacity(), 0u);
+}
+
+TEST(Serialize_RingBuffer, ReserveRoundsCapacityUpToPowerOfTwo)
+{
+    RingBuffer ring;
+    ring.reserve(5000);
+    EXPECT_EQ(ring.getCapacity(), 8192u);
+    EXPECT_GE(ring.getWritableSpan().size(), 5000u);
+}
+
+TEST(Serialize_RingBuffer, WriteDirectlyIntoWritableSpanAndConsume)
+{
+    RingBuffer ring;
+    ring.reserve(4);
+    const std::span<uint8_t> target = ring.getWritableSpan();
+    ASSERT_GE(target.size(), 4u);
+    target[0] = 0x10;
+    target[1] = 0x02;
+    target[2] = 0xAA;
+    target[3] = 0xBB;
+    ring.commitWrite(4);
+
+    EXPECT_EQ(ring.getSize(), 4u);
+    EXPECT_EQ(ring.peek(0), 0x10);
+    EXPECT_EQ(ring.peek(3), 0xBB);
+
+    ring.consume(4);
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(Serialize_RingBuffer, ContiguousViewPointsIntoStorageWhenNotWrapped)
+{
+    RingBuffer ring;
+    ring.reserve(16);
+    const std::vector<uint8_t> data{ 1, 2, 3, 4, 5 };
+    ring.write(data.data(), data.size());
+
+    std::vector<uint8_t> scratch;
+    const std::span<const uint8_t> view = ring.getContiguousView(data.size(), scratch);
+    EXPECT_TRUE(scratch.empty());
+    ASSERT_EQ(view.size(), data.size());
+    EXPECT_EQ(std::memcmp(view.data(), data.data(), data.size()), 0);
+}
+
+TEST(Serialize_RingBuffer, WrappedRangeFallsBackToScratchCopy)
+{
+    RingBuffer ring;
+    ring.reserve(1);
+    const size_t capacity = ring.getCapacity();
+
+    // Move the read position near the end so the next write wraps.
+    std::vector<uint8_t> filler(capacity - 4, 0xFF);
+    ring.write(filler.data(), filler.size());
+    ring.consume(capacity - 8);
+
+    std::vector<uint8_t> data(10);
+    std::iota(data.begin(), data.end(), static_cast<uint8_t>(1));
+    ring.write(data.data(), data.size());
+    ring.consume(4);
+    ASSERT_EQ(ring.getSize(), data.size());
+
+    std::vector<uint8_t> scratch;
+    const std::span<const uint8_t> view = ring.getContiguousView(data.size(), scratch);
+    EXPECT_EQ(view.data(), scratch.data());
+    ASSERT_EQ(view.size(), data.size());
+    EXPECT_EQ(std::memcmp(view.data(), data.data(), data.size()), 0);
+}
+
+TEST(Serialize_RingBuffer, GrowingPreservesWrappedContentsInOrder)
+{
+    RingBuffer ring;
+    ring.reserve(1);
+    const size_t capacity = ring.getCapacity();
+
+    std::vector<uint8_t> filler(capacity - 2, 0xFF);
+    ring.write(filler.data(), filler.size());
+    ring.consume(filler.size());
+    ASSERT_TRUE(ring.isEmpty());
+
+    std::vector<uint8_t> data(capacity - 16);
+    std::iota(data.begin(), data.end(), static_cast<uint8_t>(0));
+    ring.write(data.data(), 8);
+    ring.write(data.data() + 8, data.size() - 8);
+    ASSERT_EQ(ring.getSize(), data.size());
+
+    ring.reserve(capacity);
+    EXPECT_EQ(ring.getCapacity(), capacity * 2);
+
+    std::vector<uint8_t> scratch;
+    const std::span<const uint8_t> view = ring.getContiguousView(data.size(), scratch);
+    EXPECT_TRUE(scratch.empty());
+    ASSERT_EQ(view.size(), data.size());
+    EXPECT_EQ(std::memcmp(view.data(), data.data(), data.size()), 0);
+}
+
+TEST(Serialize_RingBuffer, ConsumeToEmptyRewindsToStart)
+{
+    RingBuffer ring;
+    ring.reserve(64);
+    const std::vector<uint8_t> data(32, 0x42);
+    ring.write(data.data(), data.size());
+    ring.consume(data.size());
+
+    EXPECT_EQ(ring.getWritableSpan().size(), ring.getCapacity());
+}
+
+TEST(Serialize_RingBuffer, PooledStorageKeepsContentsAcrossGrowth)
+{
+    reactormq::mqtt::BufferMemoryOptions memory;
+    memory.numaLocal = true;
+    RingBuffer ring(memory);
+
+    std::vector<uint8_t> data(6000);
+    std::iota(data.begin(), data.end(), uint8_t{ 0 });
+    ring.reserve(1000);
+    ring.write(data.data(), 1000);
+    ring.reserve(data.size());
+    ring.write(data.data() + 1000, data.size() - 1000);
+
+    EXPECT_EQ(ring.getCapacity(), 8192u);
+    std::vector<uint8_t> out(data.size());
+    ASSERT_EQ(ring.peekInto(out.data(), out.size()), data.size());
+    EXPECT_EQ(out, data);
+}
+
+TEST(Serialize_BufferPool, ReleasedBlocksAreReusedAndLargeBlocksAreUnmapped)
+{
+    using reactormq::system::BufferPool;
+    BufferPool pool(false, std::nullopt);
+
+    uint8_t* first = pool.allocate(BufferPool::kMinBlockSize);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(pool.getMappedBytes(), BufferPool::kChunkSize);
+    uint8_t* second = pool.allocate(BufferPool::kMinBlockSize);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    std::memset(first, 0xAB, BufferPool::kMinBlockSize);
+    pool.release(first, BufferPool::kMinBlockSize);
+    EXPECT_EQ(pool.allocate(BufferPool::kMinBlockSize), first);
+
+    uint8_t* large = pool.allocate(2 * BufferPool::kChunkSize);
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % BufferPool::kChunkSize, 0u);
+    EXPECT_EQ(pool.getMappedBytes(), 3 * BufferPool::kChunkSize);
+    pool.release(large, 2 * BufferPool::kChunkSize);
+    EXPECT_EQ(pool.getMappedBytes(), BufferPool::kChunkSize);
+}
+
+TEST(Serialize_RingBuffer, SharedBytesSurviveLaterWritesAndTheSpareIsReused)
+{
+    RingBuffer ring;
+    std::vector<uint8_t> first(1024, 0x11);
+    ring.reserve(first.size());
+    ring.write(first.data(), first.size());
+
+    std::vector<uint8_t> scratch;
+    const std::span<const uint8_t> view = ring.getContiguousView(first.size(), scratch);
+    std::shared_ptr<const uint8_t> shared = ring.share(view);
+    ASSERT_NE(shared, nullptr);
+    EXPECT_EQ(shared.get(), view.data());
+    EXPECT_EQ(ring.share(view.first(16)), nullptr);
+    ring.consume(first.size());
+
+    // Writing now must not land on the shared bytes.
+    const std::vector<uint8_t> second(1024, 0x22);
+    ring.reserve(second.size());
+    ring.write(second.data(), second.size());
+    EXPECT_TRUE(std::all_of(shared.get(), shared.get() + first.size(), [](const uint8_t b) { return b == 0x11; }));
+    const uint8_t* const detached = ring.getContiguousView(second.size(), scratch).data();
+    EXPECT_NE(detached, view.data());
+
+    // The first storage is free again, so the next detach writes into it instead of allocating.
+    const std::shared_ptr<const uint8_t> pinned = ring.share(ring.getContiguousView(second.size(), scratch));
+    ASSERT_NE(pinned, nullptr);
+    shared.reset();
+    ring.consume(second.size());
+    EXPECT_EQ(ring.getWritableSpan().data(), view.data());
+}
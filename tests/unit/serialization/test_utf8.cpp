@@ -0,0 +1,125 @@
+﻿//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "serialize/mqtt_codec.h"
+#include "serialize/utf8.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace reactormq::serialize;
+
+namespace
+{
+    std::vector<std::byte> lengthPrefixed(const std::string_view text)
+    {
+        std::vector<std::byte> buffer;
+        const ByteWriter writer(buffer);
+        writer.writeUint16(static_cast<uint16_t>(text.size()));
+        writer.writeBytes(reinterpret_cast<const std::byte*>(text.data()), text.size());
+        return buffer;
+    }
+} // namespace
+
+TEST(Utf8, AcceptsWellFormedStrings)
+{
+    EXPECT_TRUE(isValidMqttString(""));
+    EXPECT_TRUE(isValidMqttString("sensors/temperature"));
+    EXPECT_TRUE(isValidMqttString("caf\xC3\xA9"));                 // U+00E9
+    EXPECT_TRUE(isValidMqttString("\xE0\xA0\x80"));               // U+0800, the smallest 3-byte form
+    EXPECT_TRUE(isValidMqttString("\xED\x9F\xBF"));               // U+D7FF, just below the surrogates
+    EXPECT_TRUE(isValidMqttString("\xEF\xBB\xBF"));               // U+FEFF is allowed and not stripped
+    EXPECT_TRUE(isValidMqttString("\xF0\x9F\x98\x80"));           // U+1F600
+    EXPECT_TRUE(isValidMqttString("\xF4\x8F\xBF\xBF"));           // U+10FFFF
+}
+
+TEST(Utf8, RejectsMalformedSequencesAndNul)
+{
+    using namespace std::string_view_literals;
+    EXPECT_FALSE(isValidMqttString("a\0b"sv));
+    EXPECT_FALSE(isValidMqttString("\xC0\x80"));                   // Overlong NUL
+    EXPECT_FALSE(isValidMqttString("\xC1\xBF"));                   // Overlong ASCII
+    EXPECT_FALSE(isValidMqttString("\xE0\x9F\xBF"));               // Overlong 3-byte
+    EXPECT_FALSE(isValidMqttString("\xF0\x8F\xBF\xBF"));           // Overlong 4-byte
+    EXPECT_FALSE(isValidMqttString("\xED\xA0\x80"));               // U+D800
+    EXPECT_FALSE(isValidMqttString("\xF4\x90\x80\x80"));           // U+110000
+    EXPECT_FALSE(isValidMqttString("\xF5\x80\x80\x80"));
+    EXPECT_FALSE(isValidMqttString("\x80"));                       // Lone continuation byte
+    EXPECT_FALSE(isValidMqttString("\xC3"));                       // Truncated
+    EXPECT_FALSE(isValidMqttString("\xE2\x82"));
+    EXPECT_FALSE(isValidMqttString("\xC3\x28"));                   // Continuation byte missing
+    EXPECT_FALSE(isValidMqttString("\xFF"));
+}
+
+TEST(Utf8, FindsTheBadByteAtEveryOffsetOfALongString)
+{
+    // Long enough to cross several vector blocks, so each position lands in the SIMD loops and the scalar tail alike.
+    for (size_t position = 0; position < 80; ++position)
+    {
+        std::string text(80, 'a');
+        EXPECT_TRUE(isValidMqttString(text));
+
+        text[position] = '\0';
+        EXPECT_FALSE(isValidMqttString(text)) << "NUL at " << position;
+
+        text[position] = static_cast<char>(0x80);
+        EXPECT_FALSE(isValidMqttString(text)) << "continuation at " << position;
+
+        if (position + 2 <= text.size())
+        {
+            text[position] = static_cast<char>(0xC3);
+            text[position + 1] = static_cast<char>(0xA9);
+            EXPECT_TRUE(isValidMqttString(text)) << "two-byte sequence at " << position;
+        }
+    }
+}
+
+TEST(Utf8, TopicNamesHaveNoWildcards)
+{
+    EXPECT_TRUE(isValidTopicName("a/b/c"));
+    EXPECT_TRUE(isValidTopicName("/"));
+    EXPECT_TRUE(isValidTopicName("$SYS/uptime"));
+    EXPECT_FALSE(isValidTopicName(""));
+    EXPECT_FALSE(isValidTopicName("a/+/c"));
+    EXPECT_FALSE(isValidTopicName("a/#"));
+    EXPECT_FALSE(isValidTopicName("a\xC3"));
+}
+
+TEST(Utf8, TopicFiltersUseWildcardsForWholeLevels)
+{
+    EXPECT_TRUE(isValidTopicFilter("#"));
+    EXPECT_TRUE(isValidTopicFilter("+"));
+    EXPECT_TRUE(isValidTopicFilter("a/+/c"));
+    EXPECT_TRUE(isValidTopicFilter("+/+/#"));
+    EXPECT_TRUE(isValidTopicFilter("a//#"));
+    EXPECT_TRUE(isValidTopicFilter("$share/group/a/+"));
+    EXPECT_FALSE(isValidTopicFilter(""));
+    EXPECT_FALSE(isValidTopicFilter("a/#/c"));
+    EXPECT_FALSE(isValidTopicFilter("a#"));
+    EXPECT_FALSE(isValidTopicFilter("a/b#"));
+    EXPECT_FALSE(isValidTopicFilter("a+/c"));
+    EXPECT_FALSE(isValidTopicFilter("a/+b"));
+    EXPECT_FALSE(isValidTopicFilter("##"));
+}
+
+TEST(Utf8, DecodeRejectsInvalidStringsButNotBinaryData)
+{
+    const std::vector<std::byte> bad = lengthPrefixed("\xC0\x80");
+
+    std::string text = "old";
+    ByteReader stringReader(bad.data(), bad.size());
+    EXPECT_FALSE(decodeString(stringReader, text));
+    EXPECT_TRUE(text.empty());
+
+    std::string_view view;
+    ByteReader viewReader(bad.data(), bad.size());
+    EXPECT_FALSE(decodeStringView(viewReader, view));
+
+    std::string binary;
+    ByteReader binaryReader(bad.data(), bad.size());
+    ASSERT_TRUE(decodeBinaryData(binaryReader, binary));
+    EXPECT_EQ(binary, "\xC0\x80");
+}
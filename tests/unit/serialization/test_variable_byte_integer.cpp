@@ -72,4 +72,41 @@ TEST(VariableByteInteger, DecodeExamplesFromSpec)
     chk({ 0xFF, 0xFF, 0x7F }, 2097151u, 3u);
     chk({ 0x80, 0x80, 0x80, 0x01 }, 2097152u, 4u);
     chk({ 0xFF, 0xFF, 0xFF, 0x7F }, 268435455u, 4u);
-}
\ No newline at end of file
+}
+TEST(VariableByteInteger, ScanMatchesEncodeForEverySizeBoundary)
+{
+    for (const uint32_t value : { 0u, 1u, 127u, 128u, 300u, 16383u, 16384u, 2097151u, 2097152u, 268435455u })
+    {
+        std::vector<std::byte> out;
+        const ByteWriter writer(out);
+        encodeVariableByteInteger(value, writer);
+        // Trailing bytes with the continuation bit set must not leak into the value.
+        out.insert(out.end(), 4, std::byte{ 0xFF });
+
+        uint32_t decoded = 0;
+        size_t size = 0;
+        const std::span bytes{ reinterpret_cast<const uint8_t*>(out.data()), out.size() };
+        ASSERT_EQ(scanVariableByteInteger(bytes, decoded, size), VariableByteIntegerStatus::Complete) << value;
+        EXPECT_EQ(decoded, value);
+        EXPECT_EQ(size, variableByteIntegerSize(value));
+
+        // Every strict prefix only asks for more bytes.
+        for (size_t prefix = 0; prefix < size; ++prefix)
+        {
+            EXPECT_EQ(scanVariableByteInteger(bytes.first(prefix), decoded, size), VariableByteIntegerStatus::Incomplete) << value;
+            size = variableByteIntegerSize(value);
+        }
+    }
+}
+
+TEST(VariableByteInteger, ScanRejectsFiveByteEncodings)
+{
+    const std::vector<uint8_t> data{ 0x80, 0x80, 0x80, 0x80, 0x01 };
+    uint32_t value = 0;
+    size_t size = 0;
+    EXPECT_EQ(scanVariableByteInteger(data, value, size), VariableByteIntegerStatus::Malformed);
+
+    const auto bytes = toVec({ 0x80, 0x80, 0x80, 0x80, 0x01 });
+    ByteReader reader(bytes.data(), bytes.size());
+    EXPECT_EQ(decodeVariableByteInteger(reader), 0u);
+}
@@ -0,0 +1,174 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "util/perf/perf_report.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace reactormq::perf;
+
+namespace
+{
+    PerfResult makeResult(const std::string& name, const double opsPerSecond)
+    {
+        PerfResult result;
+        result.name = name;
+        result.opsPerSecond = opsPerSecond;
+        return result;
+    }
+
+    PerfReport makeBaseline()
+    {
+        PerfReport report;
+        report.tool = "reactormq_bench";
+        PerfResult publish = makeResult("BM_LoopbackPublishThroughput/qos:1", 100000.0);
+        publish.p50Us = 40.0;
+        publish.p99Us = 200.0;
+        publish.p999Us = 600.0;
+        publish.allocsPerOp = 3.0;
+        publish.bytesPerOp = 400.0;
+        publish.counters["bytes_per_second"] = 6400000.0;
+        report.results.push_back(publish);
+        report.results.push_back(makeResult("BM_DecodePublish<V5>/1024", 2.5e7));
+        return report;
+    }
+} // namespace
+
+TEST(PerfReportTest, RoundTripsEveryFieldThroughJson)
+{
+    const PerfReport report = makeBaseline();
+    const std::string json = toJson(report);
+    EXPECT_NE(json.find("\"schema\": \"reactormq.perf\""), std::string::npos);
+    EXPECT_NE(json.find("\"version\": 1"), std::string::npos);
+    // A result that does not measure latency or allocations leaves the fields out rather than writing zeros.
+    EXPECT_EQ(json.find("latency_us"), json.rfind("latency_us"));
+
+    PerfReport parsed;
+    std::string error;
+    ASSERT_TRUE(parsePerfReport(json, parsed, error)) << error;
+    EXPECT_EQ(parsed.tool, "reactormq_bench");
+    ASSERT_EQ(parsed.results.size(), 2u);
+
+    const PerfResult& publish = parsed.results[0];
+    EXPECT_EQ(publish.name, "BM_LoopbackPublishThroughput/qos:1");
+    EXPECT_DOUBLE_EQ(publish.opsPerSecond, 100000.0);
+    EXPECT_EQ(publish.p50Us, 40.0);
+    EXPECT_EQ(publish.p99Us, 200.0);
+    EXPECT_EQ(publish.p999Us, 600.0);
+    EXPECT_EQ(publish.allocsPerOp, 3.0);
+    EXPECT_EQ(publish.bytesPerOp, 400.0);
+    EXPECT_EQ(publish.counters.at("bytes_per_second"), 6400000.0);
+
+    const PerfResult& decode = parsed.results[1];
+    EXPECT_EQ(decode.name, "BM_DecodePublish<V5>/1024");
+    EXPECT_DOUBLE_EQ(decode.opsPerSecond, 2.5e7);
+    EXPECT_FALSE(decode.p50Us.has_value());
+    EXPECT_FALSE(decode.allocsPerOp.has_value());
+}
+
+TEST(PerfReportTest, ReadsEscapesAndIgnoresUnknownFields)
+{
+    const std::string json = R"({
+        "schema": "reactormq.perf", "version": 1, "tool": "tést", "host": { "cpus": [8, null, true] },
+        "results": [ { "name": "a\"b\\c", "ops_per_sec": 1.5e3, "note": "later field", "counters": { "x": 2, "y": "z" } } ]
+    })";
+    PerfReport parsed;
+    std::string error;
+    ASSERT_TRUE(parsePerfReport(json, parsed, error)) << error;
+    EXPECT_EQ(parsed.tool, "t\xC3\xA9st");
+    ASSERT_EQ(parsed.results.size(), 1u);
+    EXPECT_EQ(parsed.results[0].name, "a\"b\\c");
+    EXPECT_DOUBLE_EQ(parsed.results[0].opsPerSecond, 1500.0);
+    EXPECT_EQ(parsed.results[0].counters.size(), 1u);
+}
+
+TEST(PerfReportTest, RejectsOtherDocumentsNewerVersionsAndIncompleteResults)
+{
+    PerfReport parsed;
+    std::string error;
+    EXPECT_FALSE(parsePerfReport("", parsed, error));
+    EXPECT_FALSE(parsePerfReport(R"({"schema": "reactormq.perf", "version": 1, "results": [})", parsed, error));
+    EXPECT_FALSE(parsePerfReport(R"({"benchmarks": []})", parsed, error));
+    EXPECT_FALSE(parsePerfReport(R"({"schema": "reactormq.perf", "version": 2, "results": []})", parsed, error));
+    EXPECT_NE(error.find("newer"), std::string::npos);
+    EXPECT_FALSE(parsePerfReport(R"({"schema": "reactormq.perf", "version": 1, "results": [{"name": "a"}]})", parsed, error));
+    EXPECT_NE(error.find("ops_per_sec"), std::string::npos);
+    EXPECT_FALSE(parsePerfReport(R"({"schema": "reactormq.perf", "version": 1, "results": []} x)", parsed, error));
+    EXPECT_FALSE(parsePerfReport(std::string(100, '[') + std::string(100, ']'), parsed, error));
+}
+
+TEST(PerfReportTest, ParsesThresholdsAsPercentages)
+{
+    CompareThresholds thresholds;
+    ASSERT_TRUE(parseCompareThresholds("ops:10,allocs:2.5", thresholds));
+    EXPECT_DOUBLE_EQ(thresholds.throughput, 0.10);
+    EXPECT_DOUBLE_EQ(thresholds.latency, CompareThresholds{}.latency);
+    EXPECT_DOUBLE_EQ(thresholds.allocations, 0.025);
+
+    EXPECT_FALSE(parseCompareThresholds("", thresholds));
+    EXPECT_FALSE(parseCompareThresholds("ops", thresholds));
+    EXPECT_FALSE(parseCompareThresholds("ops:-1", thresholds));
+    EXPECT_FALSE(parseCompareThresholds("cpu:5", thresholds));
+    EXPECT_FALSE(parseCompareThresholds("ops:5,", thresholds));
+    EXPECT_DOUBLE_EQ(thresholds.throughput, 0.10);
+}
+
+TEST(PerfReportTest, FlagsOnlyChangesBeyondTheThresholds)
+{
+    const PerfReport baseline = makeBaseline();
+    PerfReport candidate = makeBaseline();
+    candidate.results[0].opsPerSecond = 96000.0; // -4%, within the 5% default.
+    candidate.results[0].p99Us = 230.0; // +15%, over the 10% default.
+    candidate.results[0].allocsPerOp = 3.0;
+    candidate.results[0].bytesPerOp = 401.0; // Any growth is over the 0% default.
+    candidate.results[1].opsPerSecond = 2.0e7; // -20%.
+
+    const PerfComparison comparison = comparePerfReports(baseline, candidate, CompareThresholds{});
+    ASSERT_EQ(comparison.deltas.size(), 7u);
+    EXPECT_TRUE(comparison.hasRegressed());
+    EXPECT_TRUE(comparison.missing.empty());
+    EXPECT_TRUE(comparison.added.empty());
+
+    std::vector<std::string> regressed;
+    for (const PerfDelta& delta : comparison.deltas)
+    {
+        if (delta.isRegression)
+        {
+            regressed.push_back(delta.name + " " + delta.metric);
+        }
+    }
+    EXPECT_EQ(
+        regressed,
+        (std::vector<std::string>{
+            "BM_LoopbackPublishThroughput/qos:1 latency_us.p99",
+            "BM_LoopbackPublishThroughput/qos:1 bytes_per_op",
+            "BM_DecodePublish<V5>/1024 ops_per_sec",
+        }));
+    EXPECT_NEAR(comparison.deltas[0].change, -0.04, 1e-12);
+
+    const std::string table = formatComparison(comparison);
+    EXPECT_NE(table.find("REGRESSION"), std::string::npos);
+    EXPECT_NE(table.find("3 of 7 figures regressed"), std::string::npos);
+
+    CompareThresholds loose;
+    ASSERT_TRUE(parseCompareThresholds("ops:25,latency:20,allocs:1", loose));
+    EXPECT_FALSE(comparePerfReports(baseline, candidate, loose).hasRegressed());
+}
+
+TEST(PerfReportTest, ListsResultsOnlyOneReportHasWithoutFailing)
+{
+    const PerfReport baseline = makeBaseline();
+    PerfReport candidate;
+    candidate.results.push_back(makeResult("BM_DecodePublish<V5>/1024", 2.6e7));
+    candidate.results.push_back(makeResult("BM_EncodePublish<V5>/1024", 3.0e7));
+
+    const PerfComparison comparison = comparePerfReports(baseline, candidate, CompareThresholds{});
+    EXPECT_FALSE(comparison.hasRegressed());
+    ASSERT_EQ(comparison.deltas.size(), 1u);
+    EXPECT_EQ(comparison.missing, std::vector<std::string>{ "BM_LoopbackPublishThroughput/qos:1" });
+    EXPECT_EQ(comparison.added, std::vector<std::string>{ "BM_EncodePublish<V5>/1024" });
+    EXPECT_NE(formatComparison(comparison).find("No regressions in 1 figures."), std::string::npos);
+}
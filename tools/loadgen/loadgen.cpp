@@ -0,0 +1,848 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+// reactormq_loadgen: many-connection load generator for soak and capacity testing against a real broker.
+//
+// Clients are created through the public client_factory.h API and driven by one IReactorGroup. Client i publishes to
+// <prefix>/<i> at a fixed rate and subscribes to the topics of the --fanout clients after it, so every message is
+// delivered --fanout times. At the end it prints throughput, publish latency per QoS (from the clients' own metrics),
+// end-to-end delivery latency (from a timestamp carried in the payload), and CPU and RSS per connection. --json also
+// writes them as a reactormq.perf result file, and --compare diffs two such files instead of running.
+
+#include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/connection_protocol.h"
+#include "reactormq/mqtt/connection_settings_builder.h"
+#include "reactormq/mqtt/delegates.h"
+#include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/quality_of_service.h"
+#include "reactormq/mqtt/reactor_group.h"
+#include "reactormq/mqtt/result.h"
+#include "reactormq/mqtt/subscribe_result.h"
+#include "reactormq/mqtt/topic_filter.h"
+#include "util/logging/registry.h"
+#include "util/perf/perf_report.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif // _WIN32
+
+using namespace reactormq::mqtt;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// Bytes at the start of each payload that carry the publish time; smaller payloads go without delivery latency.
+    constexpr size_t kTimestampBytes = sizeof(std::int64_t);
+
+    struct Options
+    {
+        std::string host = "127.0.0.1";
+        uint16_t port = 1883;
+        ConnectionProtocol protocol = ConnectionProtocol::Tcp;
+        std::string path = "/mqtt";
+        bool shouldVerifyServerCertificate = true;
+        uint32_t clients = 10;
+        uint32_t threads = 0;
+        double rate = 10.0; ///< Publishes per second per client.
+        uint32_t payloadBytes = 64;
+        std::array<double, 3> qosWeights{ 1.0, 0.0, 0.0 };
+        uint32_t fanout = 0;
+        uint32_t durationSeconds = 10;
+        uint32_t maxInFlight = 1000; ///< Per client; publishes over it are skipped and counted, not queued.
+        uint32_t connectTimeoutSeconds = 30;
+        std::string topicPrefix = "reactormq/loadgen";
+        std::string clientIdPrefix = "reactormq-loadgen";
+        reactormq::logging::LogLevel logLevel = reactormq::logging::LogLevel::Error;
+        std::string jsonPath; ///< Where to write the results as a reactormq.perf file; empty for none.
+        std::string baselinePath; ///< With candidatePath, compare two result files instead of running.
+        std::string candidatePath;
+        reactormq::perf::CompareThresholds thresholds;
+    };
+
+    void printUsage()
+    {
+        std::fputs(
+            "Usage: reactormq_loadgen [--option=value ...]\n"
+            "\n"
+            "  --host=HOST              Broker host, or socket path for --protocol=unix (127.0.0.1)\n"
+            "  --port=PORT              Broker port (1883)\n"
+            "  --protocol=P             tcp, tls, ws, wss, quic or unix (tcp)\n"
+            "  --path=PATH              WebSocket path (/mqtt)\n"
+            "  --insecure               Do not verify the server certificate\n"
+            "  --clients=N              Connections to open (10)\n"
+            "  --threads=N              Reactor threads; 0 uses one per hardware thread (0)\n"
+            "  --rate=R                 Publishes per second per client (10)\n"
+            "  --payload=BYTES          Payload size; 8 or more also measures delivery latency (64)\n"
+            "  --qos-mix=W0,W1,W2       Relative weights of QoS 0, 1 and 2 publishes (1,0,0)\n"
+            "  --fanout=N               Subscribers per published topic (0)\n"
+            "  --duration=SECONDS       Publishing time (10)\n"
+            "  --max-in-flight=N        Unfinished publishes per client before new ones are skipped (1000)\n"
+            "  --connect-timeout=SECONDS Time allowed for all clients to connect and subscribe (30)\n"
+            "  --topic-prefix=PREFIX    Topic prefix; client i publishes to PREFIX/i (reactormq/loadgen)\n"
+            "  --client-id-prefix=ID    Client id prefix; client i is ID-i (reactormq-loadgen)\n"
+            "  --log-level=LEVEL        trace, debug, info, warn, error, critical or off (error)\n"
+            "  --json=FILE              Also write the results to FILE as JSON (reactormq.perf schema)\n"
+            "  --compare=BASE,NEW       Compare two result files and exit: 0 if nothing regressed, 1 if something did\n"
+            "  --thresholds=T           Allowed regression for --compare, in percent (ops:5,latency:10,allocs:0)\n"
+            "  --help                   Show this text\n",
+            stdout);
+    }
+
+    template<typename T>
+    bool parseInteger(const std::string_view text, T& out)
+    {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return error == std::errc{} && end == text.data() + text.size();
+    }
+
+    bool parseDouble(const std::string_view text, double& out)
+    {
+        const std::string copy(text);
+        char* end = nullptr;
+        out = std::strtod(copy.c_str(), &end);
+        return !copy.empty() && end == copy.c_str() + copy.size() && out >= 0.0;
+    }
+
+    bool parseProtocol(const std::string_view text, ConnectionProtocol& out)
+    {
+        constexpr std::array<std::pair<std::string_view, ConnectionProtocol>, 6> kProtocols{ {
+            { "tcp", ConnectionProtocol::Tcp },
+            { "tls", ConnectionProtocol::Tls },
+            { "ws", ConnectionProtocol::Ws },
+            { "wss", ConnectionProtocol::Wss },
+            { "quic", ConnectionProtocol::Quic },
+            { "unix", ConnectionProtocol::Unix },
+        } };
+        for (const auto& [name, protocol] : kProtocols)
+        {
+            if (text == name)
+            {
+                out = protocol;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseLogLevel(const std::string_view text, reactormq::logging::LogLevel& out)
+    {
+        using reactormq::logging::LogLevel;
+        constexpr std::array<std::pair<std::string_view, LogLevel>, 7> kLevels{ {
+            { "trace", LogLevel::Trace },
+            { "debug", LogLevel::Debug },
+            { "info", LogLevel::Info },
+            { "warn", LogLevel::Warn },
+            { "error", LogLevel::Error },
+            { "critical", LogLevel::Critical },
+            { "off", LogLevel::Off },
+        } };
+        for (const auto& [name, level] : kLevels)
+        {
+            if (text == name)
+            {
+                out = level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseQosMix(const std::string_view text, std::array<double, 3>& out)
+    {
+        size_t start = 0;
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            const size_t comma = text.find(',', start);
+            const bool isLast = i + 1 == out.size();
+            if (isLast != (comma == std::string_view::npos))
+            {
+                return false;
+            }
+            if (!parseDouble(text.substr(start, isLast ? std::string_view::npos : comma - start), out[i]))
+            {
+                return false;
+            }
+            start = comma + 1;
+        }
+        return out[0] + out[1] + out[2] > 0.0;
+    }
+
+    /// Parse --name=value and --name value arguments; on failure @p error names the offending argument.
+    bool parseOptions(const int argc, char** argv, Options& options, std::string& error, bool& shouldShowHelp)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view argument = argv[i];
+            if (!argument.starts_with("--"))
+            {
+                error = std::format("unexpected argument '{}'", argument);
+                return false;
+            }
+            argument.remove_prefix(2);
+
+            if (argument == "help")
+            {
+                shouldShowHelp = true;
+                return true;
+            }
+            if (argument == "insecure")
+            {
+                options.shouldVerifyServerCertificate = false;
+                continue;
+            }
+
+            std::string_view name = argument;
+            std::string_view value;
+            if (const size_t equals = argument.find('='); equals != std::string_view::npos)
+            {
+                name = argument.substr(0, equals);
+                value = argument.substr(equals + 1);
+            }
+            else if (i + 1 < argc)
+            {
+                value = argv[++i];
+            }
+
+            bool isValid = false;
+            if (name == "host")
+            {
+                options.host = value;
+                isValid = !value.empty();
+            }
+            else if (name == "port")
+            {
+                isValid = parseInteger(value, options.port) && options.port != 0;
+            }
+            else if (name == "protocol")
+            {
+                isValid = parseProtocol(value, options.protocol);
+            }
+            else if (name == "path")
+            {
+                options.path = value;
+                isValid = true;
+            }
+            else if (name == "clients")
+            {
+                isValid = parseInteger(value, options.clients) && options.clients != 0;
+            }
+            else if (name == "threads")
+            {
+                isValid = parseInteger(value, options.threads);
+            }
+            else if (name == "rate")
+            {
+                isValid = parseDouble(value, options.rate);
+            }
+            else if (name == "payload")
+            {
+                isValid = parseInteger(value, options.payloadBytes);
+            }
+            else if (name == "qos-mix")
+            {
+                isValid = parseQosMix(value, options.qosWeights);
+            }
+            else if (name == "fanout")
+            {
+                isValid = parseInteger(value, options.fanout);
+            }
+            else if (name == "duration")
+            {
+                isValid = parseInteger(value, options.durationSeconds);
+            }
+            else if (name == "max-in-flight")
+            {
+                isValid = parseInteger(value, options.maxInFlight) && options.maxInFlight != 0;
+            }
+            else if (name == "connect-timeout")
+            {
+                isValid = parseInteger(value, options.connectTimeoutSeconds);
+            }
+            else if (name == "topic-prefix")
+            {
+                options.topicPrefix = value;
+                isValid = !value.empty();
+            }
+            else if (name == "client-id-prefix")
+            {
+                options.clientIdPrefix = value;
+                isValid = !value.empty();
+            }
+            else if (name == "log-level")
+            {
+                isValid = parseLogLevel(value, options.logLevel);
+            }
+            else if (name == "json")
+            {
+                options.jsonPath = value;
+                isValid = !value.empty();
+            }
+            else if (name == "compare")
+            {
+                const size_t comma = value.find(',');
+                isValid = comma != std::string_view::npos && comma != 0 && comma + 1 != value.size();
+                if (isValid)
+                {
+                    options.baselinePath = value.substr(0, comma);
+                    options.candidatePath = value.substr(comma + 1);
+                }
+            }
+            else if (name == "thresholds")
+            {
+                isValid = reactormq::perf::parseCompareThresholds(value, options.thresholds);
+            }
+            else
+            {
+                error = std::format("unknown option '--{}'", name);
+                return false;
+            }
+
+            if (!isValid)
+            {
+                error = std::format("invalid value '{}' for --{}", value, name);
+                return false;
+            }
+        }
+
+        // A client may subscribe to its own topic only when every other client's is already taken.
+        options.fanout = std::min(options.fanout, options.clients);
+        return true;
+    }
+
+    void recordLatency(LatencyHistogram& histogram, const std::uint64_t us)
+    {
+        ++histogram.counts[LatencyHistogram::getBucketIndex(us)];
+        ++histogram.count;
+        histogram.sumUs += us;
+        histogram.maxUs = std::max(histogram.maxUs, us);
+    }
+
+    void mergeLatency(LatencyHistogram& into, const LatencyHistogram& from)
+    {
+        for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i)
+        {
+            into.counts[i] += from.counts[i];
+        }
+        into.count += from.count;
+        into.sumUs += from.sumUs;
+        into.maxUs = std::max(into.maxUs, from.maxUs);
+    }
+
+    std::int64_t nowNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * One client and its counters. The main thread publishes; the reactor thread that drives the client runs the
+     * completion and message callbacks, so everything they touch is atomic or behind the mutex.
+     */
+    struct Connection
+    {
+        std::shared_ptr<IClient> client;
+        std::string topic;
+        DelegateHandle messageHandle;
+        uint64_t scheduled = 0; ///< Publishes due so far, sent or skipped; main thread only.
+        uint32_t subscribers = 0; ///< Connected clients subscribed to this topic; main thread only.
+
+        std::atomic<bool> isConnected{ false };
+        std::atomic<bool> isSetUp{ false }; ///< Connected and, with a fanout, subscribed; or failed trying.
+        std::atomic<uint64_t> published{ 0 };
+        std::atomic<uint64_t> completed{ 0 };
+        std::atomic<uint64_t> failed{ 0 };
+        std::atomic<uint64_t> skipped{ 0 };
+        std::atomic<uint64_t> received{ 0 };
+
+        std::mutex deliveryMutex;
+        LatencyHistogram delivery; ///< Publish call to message callback, for messages this client received.
+    };
+
+    /// Process-wide CPU time and memory, sampled before and after the run.
+    struct ResourceUsage
+    {
+        double cpuSeconds = 0.0; ///< User plus system time.
+        std::uint64_t rssBytes = 0; ///< Current resident set; 0 where the platform does not report it.
+        std::uint64_t peakRssBytes = 0;
+    };
+
+    ResourceUsage sampleResourceUsage()
+    {
+        ResourceUsage usage;
+#ifdef _WIN32
+        FILETIME creation{};
+        FILETIME exit{};
+        FILETIME kernel{};
+        FILETIME user{};
+        if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        {
+            const auto toSeconds = [](const FILETIME& time)
+            {
+                return static_cast<double>((static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1e7;
+            };
+            usage.cpuSeconds = toSeconds(kernel) + toSeconds(user);
+        }
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            usage.rssBytes = counters.WorkingSetSize;
+            usage.peakRssBytes = counters.PeakWorkingSetSize;
+        }
+#else
+        rusage self{};
+        if (getrusage(RUSAGE_SELF, &self) == 0)
+        {
+            const auto toSeconds = [](const timeval& time)
+            {
+                return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+            };
+            usage.cpuSeconds = toSeconds(self.ru_utime) + toSeconds(self.ru_stime);
+#ifdef __APPLE__
+            usage.peakRssBytes = static_cast<std::uint64_t>(self.ru_maxrss);
+#else
+            usage.peakRssBytes = static_cast<std::uint64_t>(self.ru_maxrss) * 1024;
+#endif // __APPLE__
+        }
+#ifdef __linux__
+        // The second field of statm is the resident set in pages.
+        if (std::FILE* statm = std::fopen("/proc/self/statm", "r"))
+        {
+            unsigned long long sizePages = 0;
+            unsigned long long residentPages = 0;
+            if (std::fscanf(statm, "%llu %llu", &sizePages, &residentPages) == 2)
+            {
+                usage.rssBytes = residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+            }
+            std::fclose(statm);
+        }
+#endif // __linux__
+#endif // _WIN32
+        usage.peakRssBytes = std::max(usage.peakRssBytes, usage.rssBytes);
+        return usage;
+    }
+
+    /// Poll @p isDone every 10 ms until it holds or @p timeout passes.
+    template<typename Predicate>
+    bool waitFor(const Clock::duration timeout, Predicate&& isDone)
+    {
+        const auto deadline = Clock::now() + timeout;
+        while (!isDone())
+        {
+            if (Clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+
+    void print(const std::string& text)
+    {
+        std::fputs(text.c_str(), stdout);
+    }
+
+    void printLatencyRow(const std::string_view label, const LatencyHistogram& histogram)
+    {
+        print(std::format(
+            "  {:<12} {:>10} {:>9} {:>9} {:>9} {:>9} {:>9}\n",
+            label,
+            histogram.count,
+            histogram.getValueAtPercentile(50.0),
+            histogram.getValueAtPercentile(90.0),
+            histogram.getValueAtPercentile(99.0),
+            histogram.getValueAtPercentile(99.9),
+            histogram.maxUs));
+    }
+
+    /// A result file entry for @p operations done in @p seconds, with percentiles when @p latency has samples.
+    reactormq::perf::PerfResult makeResult(
+        std::string name, const uint64_t operations, const double seconds, const LatencyHistogram& latency = LatencyHistogram{})
+    {
+        reactormq::perf::PerfResult result;
+        result.name = std::move(name);
+        result.opsPerSecond = seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+        if (latency.count > 0)
+        {
+            result.p50Us = static_cast<double>(latency.getValueAtPercentile(50.0));
+            result.p99Us = static_cast<double>(latency.getValueAtPercentile(99.0));
+            result.p999Us = static_cast<double>(latency.getValueAtPercentile(99.9));
+        }
+        return result;
+    }
+
+    ConnectionSettingsPtr makeSettings(const Options& options, const uint32_t index)
+    {
+        return ConnectionSettingsBuilder(options.host)
+            .setPort(options.port)
+            .setProtocol(options.protocol)
+            .setPath(options.path)
+            .setShouldVerifyServerCertificate(options.shouldVerifyServerCertificate)
+            .setClientId(std::format("{}-{}", options.clientIdPrefix, index))
+            .setAutoReconnectEnabled(false)
+            .build();
+    }
+
+    /// Connect @p connection and, once connected, subscribe it to the topics of the @c fanout clients after it.
+    void setUp(
+        Connection& connection,
+        const std::vector<std::unique_ptr<Connection>>& connections,
+        const uint32_t index,
+        const uint32_t fanout)
+    {
+        connection.messageHandle = connection.client->onMessage().add(
+            [&connection](const Message& message)
+            {
+                connection.received.fetch_add(1, std::memory_order_relaxed);
+                const std::span<const std::uint8_t> payload = message.getPayloadView();
+                if (payload.size() < kTimestampBytes)
+                {
+                    return;
+                }
+
+                std::int64_t publishedAt = 0;
+                std::memcpy(&publishedAt, payload.data(), kTimestampBytes);
+                const std::int64_t elapsedNs = nowNanoseconds() - publishedAt;
+                const std::scoped_lock lock(connection.deliveryMutex);
+                recordLatency(connection.delivery, static_cast<std::uint64_t>(std::max<std::int64_t>(elapsedNs, 0) / 1000));
+            });
+
+        std::vector<TopicFilter> filters;
+        filters.reserve(fanout);
+        for (uint32_t offset = 1; offset <= fanout; ++offset)
+        {
+            const Connection& publisher = *connections[(index + offset) % connections.size()];
+            filters.emplace_back(publisher.topic, QualityOfService::ExactlyOnce, false);
+        }
+
+        connection.client->connectAsync(
+            true,
+            [&connection, filters = std::move(filters)](const Result<void>& connected)
+            {
+                if (!connected.hasSucceeded() || filters.empty())
+                {
+                    connection.isConnected.store(connected.hasSucceeded());
+                    connection.isSetUp.store(true);
+                    return;
+                }
+
+                connection.client->subscribeAsync(
+                    filters,
+                    [&connection](const Result<std::vector<SubscribeResult>>& subscribed)
+                    {
+                        connection.isConnected.store(subscribed.hasSucceeded());
+                        connection.isSetUp.store(true);
+                    });
+            });
+    }
+
+    void publishOne(Connection& connection, const Message::Payload& payloadTemplate, const QualityOfService qos, const uint32_t maxInFlight)
+    {
+        const uint64_t finished = connection.completed.load(std::memory_order_relaxed) + connection.failed.load(std::memory_order_relaxed);
+        if (connection.published.load(std::memory_order_relaxed) - finished >= maxInFlight)
+        {
+            connection.skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Message::Payload payload(payloadTemplate);
+        if (payload.size() >= kTimestampBytes)
+        {
+            const std::int64_t publishedAt = nowNanoseconds();
+            std::memcpy(payload.data(), &publishedAt, kTimestampBytes);
+        }
+
+        connection.published.fetch_add(1, std::memory_order_relaxed);
+        connection.client->publish(
+            Message(std::string(connection.topic), std::move(payload), false, qos),
+            [&connection](const Result<void>& result)
+            {
+                (result.hasSucceeded() ? connection.completed : connection.failed).fetch_add(1, std::memory_order_relaxed);
+            });
+    }
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    Options options;
+    std::string error;
+    bool shouldShowHelp = false;
+    if (!parseOptions(argc, argv, options, error, shouldShowHelp))
+    {
+        std::fprintf(stderr, "reactormq_loadgen: %s\n\n", error.c_str());
+        printUsage();
+        return 1;
+    }
+    if (shouldShowHelp)
+    {
+        printUsage();
+        return 0;
+    }
+    if (!options.baselinePath.empty())
+    {
+        return reactormq::perf::runComparison(options.baselinePath, options.candidatePath, options.thresholds);
+    }
+
+    // Trace output from hundreds of connections would be most of what gets measured.
+    reactormq::logging::Registry::instance().setLevel(options.logLevel);
+
+    const ResourceUsage baseline = sampleResourceUsage();
+    const std::shared_ptr<IReactorGroup> group = client::createReactorGroup(options.threads);
+    std::vector<std::unique_ptr<Connection>> connections;
+    connections.reserve(options.clients);
+    for (uint32_t i = 0; i < options.clients; ++i)
+    {
+        auto connection = std::make_unique<Connection>();
+        connection->topic = std::format("{}/{}", options.topicPrefix, i);
+        connection->client = group->createClient(makeSettings(options, i));
+        connections.push_back(std::move(connection));
+    }
+
+    print(std::format(
+        "Connecting {} clients to {}:{} on {} threads (fanout {})...\n",
+        options.clients,
+        options.host,
+        options.port,
+        group->getThreadCount(),
+        options.fanout));
+    const auto connectStart = Clock::now();
+    for (uint32_t i = 0; i < options.clients; ++i)
+    {
+        setUp(*connections[i], connections, i, options.fanout);
+    }
+    const bool isAllSetUp = waitFor(
+        std::chrono::seconds(options.connectTimeoutSeconds),
+        [&connections]
+        {
+            return std::ranges::all_of(
+                connections,
+                [](const std::unique_ptr<Connection>& connection)
+                {
+                    return connection->isSetUp.load();
+                });
+        });
+    const auto connectElapsed = std::chrono::duration<double>(Clock::now() - connectStart).count();
+
+    std::vector<Connection*> active;
+    for (uint32_t i = 0; i < options.clients; ++i)
+    {
+        if (!connections[i]->isConnected.load())
+        {
+            continue;
+        }
+        active.push_back(connections[i].get());
+        for (uint32_t offset = 1; offset <= options.fanout; ++offset)
+        {
+            ++connections[(i + offset) % options.clients]->subscribers;
+        }
+    }
+    print(std::format(
+        "Connected {}/{} in {:.2f} s{}\n",
+        active.size(),
+        options.clients,
+        connectElapsed,
+        isAllSetUp ? "" : " (timed out waiting for the rest)"));
+    if (active.empty())
+    {
+        group->stop();
+        return 2;
+    }
+
+    // Publishing is paced against the start time, and each client is offset by a fraction of the interval so the
+    // connections do not all publish in the same millisecond.
+    std::mt19937 random(0x5EED);
+    std::discrete_distribution<int> pickQos(options.qosWeights.begin(), options.qosWeights.end());
+    const Message::Payload payloadTemplate(options.payloadBytes, 0x5A);
+    const ResourceUsage usageBefore = sampleResourceUsage();
+    const auto publishStart = Clock::now();
+    const auto publishEnd = publishStart + std::chrono::seconds(options.durationSeconds);
+    while (options.rate > 0.0)
+    {
+        const auto now = Clock::now();
+        if (now >= publishEnd)
+        {
+            break;
+        }
+
+        const double elapsed = std::chrono::duration<double>(now - publishStart).count();
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            Connection& connection = *active[i];
+            const double phase = static_cast<double>(i) / static_cast<double>(active.size());
+            const auto due = static_cast<uint64_t>(elapsed * options.rate + phase);
+            for (; connection.scheduled < due; ++connection.scheduled)
+            {
+                publishOne(connection, payloadTemplate, static_cast<QualityOfService>(pickQos(random)), options.maxInFlight);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto publishElapsed = std::chrono::duration<double>(Clock::now() - publishStart).count();
+
+    // Let in-flight publishes and their deliveries finish, so the tail of the run is not counted as lost.
+    const bool isDrained = waitFor(
+        std::chrono::seconds(10),
+        [&active]
+        {
+            return std::ranges::all_of(
+                active,
+                [](const Connection* connection)
+                {
+                    return connection->published.load() == connection->completed.load() + connection->failed.load();
+                });
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const ResourceUsage usageAfter = sampleResourceUsage();
+
+    uint64_t published = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t skipped = 0;
+    uint64_t received = 0;
+    uint64_t expected = 0;
+    std::array<LatencyHistogram, 3> publishLatency{};
+    LatencyHistogram deliveryLatency;
+    for (Connection* connection : active)
+    {
+        published += connection->published.load();
+        completed += connection->completed.load();
+        failed += connection->failed.load();
+        skipped += connection->skipped.load();
+        received += connection->received.load();
+        expected += connection->completed.load() * connection->subscribers;
+
+        const ClientMetrics metrics = connection->client->getMetrics();
+        for (size_t qos = 0; qos < publishLatency.size(); ++qos)
+        {
+            mergeLatency(publishLatency[qos], metrics.publishLatency[qos].total);
+        }
+        const std::scoped_lock lock(connection->deliveryMutex);
+        mergeLatency(deliveryLatency, connection->delivery);
+    }
+
+    std::atomic<size_t> disconnected{ 0 };
+    for (Connection* connection : active)
+    {
+        connection->client->disconnectAsync(
+            [&disconnected](const Result<void>&)
+            {
+                disconnected.fetch_add(1);
+            });
+    }
+    (void)waitFor(
+        std::chrono::seconds(5),
+        [&disconnected, &active]
+        {
+            return disconnected.load() == active.size();
+        });
+    group->stop();
+
+    const double connectionCount = static_cast<double>(active.size());
+    print(std::format(
+        "\nPublished for {:.2f} s{}\n", publishElapsed, isDrained ? "" : " (some publishes were still unfinished after 10 s)"));
+    print(std::format("  published    {:>10}  {:>12.1f} msg/s\n", published, static_cast<double>(published) / publishElapsed));
+    print(std::format("  completed    {:>10}\n", completed));
+    print(std::format("  failed       {:>10}\n", failed));
+    print(std::format("  skipped      {:>10}  (over --max-in-flight)\n", skipped));
+    print(std::format("  received     {:>10}  {:>12.1f} msg/s", received, static_cast<double>(received) / publishElapsed));
+    if (options.fanout > 0)
+    {
+        print(std::format("  ({} expected)", expected));
+    }
+    print("\n\nLatency (us)      count       p50       p90       p99     p99.9       max\n");
+    for (size_t qos = 0; qos < publishLatency.size(); ++qos)
+    {
+        if (publishLatency[qos].count > 0)
+        {
+            printLatencyRow(std::format("publish qos{}", qos), publishLatency[qos]);
+        }
+    }
+    if (deliveryLatency.count > 0)
+    {
+        printLatencyRow("delivery", deliveryLatency);
+    }
+
+    const double cpuSeconds = usageAfter.cpuSeconds - usageBefore.cpuSeconds;
+    const double cpuMsPerSecondPerConnection = cpuSeconds * 1000.0 / publishElapsed / connectionCount;
+    // Per connection is the growth since before the first client was created, so the process baseline is not shared out.
+    const std::uint64_t rssGrowth = usageAfter.rssBytes > baseline.rssBytes ? usageAfter.rssBytes - baseline.rssBytes : 0;
+    const double rssKibPerConnection = static_cast<double>(rssGrowth) / 1024.0 / connectionCount;
+    print(std::format("\nResources ({} connections)\n", active.size()));
+    print(std::format("  cpu          {:>10.2f} s   {:>10.3f} ms/s per connection\n", cpuSeconds, cpuMsPerSecondPerConnection));
+    if (usageAfter.rssBytes > 0)
+    {
+        print(std::format(
+            "  rss          {:>10.1f} MiB {:>10.1f} KiB per connection\n",
+            static_cast<double>(usageAfter.rssBytes) / (1024.0 * 1024.0),
+            rssKibPerConnection));
+    }
+    print(std::format("  peak rss     {:>10.1f} MiB\n", static_cast<double>(usageAfter.peakRssBytes) / (1024.0 * 1024.0)));
+
+    if (!options.jsonPath.empty())
+    {
+        // Publishes are counted once they complete, so a broker that stops acknowledging shows up as lost throughput.
+        reactormq::perf::PerfReport report;
+        report.tool = "reactormq_loadgen";
+        reactormq::perf::PerfResult& publish = report.results.emplace_back(makeResult("publish", completed, publishElapsed));
+        publish.counters = {
+            { "connections", connectionCount },
+            { "failed", static_cast<double>(failed) },
+            { "skipped", static_cast<double>(skipped) },
+            { "cpu_ms_per_sec_per_connection", cpuMsPerSecondPerConnection },
+            { "peak_rss_mib", static_cast<double>(usageAfter.peakRssBytes) / (1024.0 * 1024.0) },
+        };
+        if (usageAfter.rssBytes > 0)
+        {
+            publish.counters["rss_kib_per_connection"] = rssKibPerConnection;
+        }
+        for (size_t qos = 0; qos < publishLatency.size(); ++qos)
+        {
+            if (publishLatency[qos].count > 0)
+            {
+                report.results.push_back(
+                    makeResult(std::format("publish_qos{}", qos), publishLatency[qos].count, publishElapsed, publishLatency[qos]));
+            }
+        }
+        if (options.fanout > 0)
+        {
+            reactormq::perf::PerfResult& delivery
+                = report.results.emplace_back(makeResult("delivery", received, publishElapsed, deliveryLatency));
+            delivery.counters["expected"] = static_cast<double>(expected);
+        }
+
+        if (std::string saveError; !reactormq::perf::savePerfReport(options.jsonPath, report, saveError))
+        {
+            std::fprintf(stderr, "reactormq_loadgen: %s\n", saveError.c_str());
+            return 3;
+        }
+    }
+
+    return failed == 0 && isDrained ? 0 : 3;
+}
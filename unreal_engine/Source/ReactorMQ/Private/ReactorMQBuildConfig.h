@@ -15,4 +15,25 @@ constexpr EReactorMQThreadMode GReactorMQThreadMode = EReactorMQThreadMode::Back
 constexpr EReactorMQThreadMode GReactorMQThreadMode = EReactorMQThreadMode::BackgroundThread;
 #else
 constexpr EReactorMQThreadMode GReactorMQThreadMode = EReactorMQThreadMode::GameThread;
-#endif
\ No newline at end of file
+#endif
+
+#ifndef REACTORMQ_POOL_THREADS
+#define REACTORMQ_POOL_THREADS 1
+#endif
+
+// Threads the client pool shards its clients across in the background thread modes; 0 uses one per core
+constexpr uint32 GReactorMQPoolThreadCount = REACTORMQ_POOL_THREADS;
+
+#ifndef REACTORMQ_CALLBACK_BUDGET_US
+#define REACTORMQ_CALLBACK_BUDGET_US 2000
+#endif
+
+// Game thread time per frame spent running marshalled callbacks; the rest carry over to the next frame
+constexpr double GReactorMQCallbackBudgetSeconds = REACTORMQ_CALLBACK_BUDGET_US / 1000000.0;
+
+#ifndef REACTORMQ_FRAME_BUDGET_US
+#define REACTORMQ_FRAME_BUDGET_US 2000
+#endif
+
+// Game thread time per frame spent ticking clients in game thread mode; 0 ticks every client every frame
+constexpr double GReactorMQFrameBudgetSeconds = REACTORMQ_FRAME_BUDGET_US / 1000000.0;
@@ -0,0 +1,40 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "ReactorMQCallbackQueue.h"
+#include "ReactorMQStats.h"
+
+#include "HAL/PlatformTime.h"
+
+FReactorMQCallbackQueue::FReactorMQCallbackQueue(const double InBudgetSeconds)
+    : BudgetSeconds(InBudgetSeconds)
+{
+}
+
+void FReactorMQCallbackQueue::Enqueue(std::function<void()>&& Callback)
+{
+    Callbacks.push(std::move(Callback));
+}
+
+void FReactorMQCallbackQueue::Drain()
+{
+    check(IsInGameThread());
+    SCOPE_CYCLE_COUNTER(STAT_ReactorMQ_CallbackDrain);
+
+    const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+    while (std::optional<std::function<void()>> Callback = Callbacks.tryPop())
+    {
+        (*Callback)();
+
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+}
+
+int32 FReactorMQCallbackQueue::Num() const
+{
+    return static_cast<int32>(Callbacks.getDepth());
+}
@@ -0,0 +1,49 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "mqtt/client/mpsc_queue.h"
+
+#include <functional>
+
+/**
+ * @brief Callbacks marshalled to the game thread, run in one batch per frame.
+ *
+ * Reactor threads push onto a lock-free MPSC queue, so a burst of messages costs one atomic exchange each instead of
+ * a task graph task each. The game thread drains the queue once per frame until it is empty or the frame's budget
+ * is spent; whatever is left runs first on the next frame, in the order it was queued.
+ */
+class FReactorMQCallbackQueue final
+{
+public:
+    /**
+     * @brief Create a queue.
+     * @param InBudgetSeconds Longest time one Drain() spends running callbacks; at least one always runs.
+     */
+    explicit FReactorMQCallbackQueue(double InBudgetSeconds);
+
+    FReactorMQCallbackQueue(const FReactorMQCallbackQueue&) = delete;
+    FReactorMQCallbackQueue& operator=(const FReactorMQCallbackQueue&) = delete;
+
+    /**
+     * @brief Queue a callback for the game thread. Safe to call from any thread.
+     */
+    void Enqueue(std::function<void()>&& Callback);
+
+    /**
+     * @brief Run queued callbacks until the queue is empty or the budget is spent. Game thread only.
+     */
+    void Drain();
+
+    /**
+     * @brief Callbacks waiting for a later Drain().
+     */
+    int32 Num() const;
+
+private:
+    reactormq::mqtt::client::MpscQueue<std::function<void()>> Callbacks;
+    const double BudgetSeconds;
+};
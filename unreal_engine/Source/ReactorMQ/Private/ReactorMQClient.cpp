@@ -8,21 +8,30 @@
 
 #include "Async/Async.h"
 #include "reactormq/mqtt/client.h"
+#include "reactormq/mqtt/client_metrics.h"
 #include "reactormq/mqtt/client_factory.h"
 #include "reactormq/mqtt/connection_settings.h"
 #include "reactormq/mqtt/credentials_provider.h"
 #include "reactormq/mqtt/message.h"
+#include "reactormq/mqtt/reactor_group.h"
 
 #include <functional>
 #include <string>
 #include <vector>
 
-FReactorMQClient::FReactorMQClient(const FReactorMQConnectionSettings& InSettings)
+FReactorMQClient::FReactorMQClient(
+    const FReactorMQConnectionSettings& InSettings,
+    const std::shared_ptr<reactormq::mqtt::IReactorGroup>& InReactorGroup,
+    std::function<void(std::function<void()>)> InCallbackExecutor)
     : Settings(InSettings)
 {
     reactormq::mqtt::CallbackExecutor CallbackExec;
 
-    if (GReactorMQThreadMode == EReactorMQThreadMode::BackgroundThreadMarshalled)
+    if (InCallbackExecutor)
+    {
+        CallbackExec = std::move(InCallbackExecutor);
+    }
+    else if (GReactorMQThreadMode == EReactorMQThreadMode::BackgroundThreadMarshalled)
     {
         CallbackExec = [](std::function<void()> Callback)
         {
@@ -69,7 +78,9 @@ FReactorMQClient::FReactorMQClient(const FReactorMQConnectionSettings& InSetting
         nullptr
         );
 
-    NativeClient = reactormq::mqtt::client::createClient(NativeSettings);
+    NativeClient = InReactorGroup
+        ? InReactorGroup->createClient(NativeSettings)
+        : reactormq::mqtt::client::createClient(NativeSettings);
 
     NativeClient->onConnect().add(
         [this](bool bConnected)
@@ -129,8 +140,16 @@ FReactorMQClient::FReactorMQClient(const FReactorMQConnectionSettings& InSetting
     NativeClient->onMessage().add(
         [this](const reactormq::mqtt::Message& Message)
         {
-            FReactorMQMessage UEMessage = FReactorMQTypeMappings::FromNative(Message);
-            OnMessageDelegate.Broadcast(UEMessage);
+            if (OnSharedMessageDelegate.IsBound())
+            {
+                OnSharedMessageDelegate.Broadcast(FReactorMQTypeMappings::FromNativeShared(Message));
+            }
+
+            if (OnMessageDelegate.IsBound())
+            {
+                FReactorMQMessage UEMessage = FReactorMQTypeMappings::FromNative(Message);
+                OnMessageDelegate.Broadcast(UEMessage);
+            }
         });
 }
 
@@ -205,6 +224,30 @@ TFuture<TReactorMQResult<void>> FReactorMQClient::PublishAsync(
     return Future;
 }
 
+TFuture<TReactorMQResult<void>> FReactorMQClient::PublishAsync(
+    FUtf8StringView Topic,
+    TArray<uint8>&& Payload,
+    EReactorMQQualityOfService QoS,
+    bool bRetain)
+{
+    TPromise<TReactorMQResult<void>> Promise;
+    TFuture<TReactorMQResult<void>> Future = Promise.GetFuture();
+
+    auto NativeMessage = FReactorMQTypeMappings::ToNative(Topic, MoveTemp(Payload), QoS, bRetain);
+    auto NativeFuture = NativeClient->publishAsync(std::move(NativeMessage));
+
+    AsyncTask(
+        ENamedThreads::AnyBackgroundThreadNormalTask,
+        [Promise = MoveTemp(Promise), NativeFuture = std::move(NativeFuture)]() mutable
+        {
+            auto NativeResult = NativeFuture.get();
+            TReactorMQResult<void> UEResult(NativeResult.hasSucceeded());
+            Promise.SetValue(MoveTemp(UEResult));
+        });
+
+    return Future;
+}
+
 TFuture<TReactorMQResult<TArray<FReactorMQSubscribeResult>>> FReactorMQClient::SubscribeAsync(
     const TArray<FReactorMQTopicFilter>& TopicFilters)
 {
@@ -370,4 +413,9 @@ void FReactorMQClient::Tick() const
     {
         NativeClient->tick();
     }
+}
+
+reactormq::mqtt::ClientMetrics FReactorMQClient::GetNativeMetrics() const
+{
+    return NativeClient ? NativeClient->getMetrics() : reactormq::mqtt::ClientMetrics{};
 }
\ No newline at end of file
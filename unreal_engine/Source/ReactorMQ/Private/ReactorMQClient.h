@@ -6,17 +6,30 @@
 #include "CoreMinimal.h"
 #include "IReactorMQClient.h"
 #include "ReactorMQConnectionSettings.h"
+#include <atomic>
+#include <functional>
 #include <memory>
 
 namespace reactormq::mqtt
 {
     class IClient;
+    class IReactorGroup;
+    struct ClientMetrics;
 }
 
 class FReactorMQClient : public IReactorMQClient
 {
 public:
-    explicit FReactorMQClient(const FReactorMQConnectionSettings& InSettings);
+    /**
+     * @brief Create a client.
+     * @param InSettings Connection settings.
+     * @param InReactorGroup Group whose thread drives the client; null if the owner calls Tick() itself.
+     * @param InCallbackExecutor Where callbacks run; null picks one from the thread mode.
+     */
+    explicit FReactorMQClient(
+        const FReactorMQConnectionSettings& InSettings,
+        const std::shared_ptr<reactormq::mqtt::IReactorGroup>& InReactorGroup = nullptr,
+        std::function<void(std::function<void()>)> InCallbackExecutor = nullptr);
     virtual ~FReactorMQClient() override;
 
     virtual TFuture<TReactorMQResult<void>> ConnectAsync(bool bCleanSession) override;
@@ -26,6 +39,11 @@ public:
         const TArray<uint8>& Payload,
         EReactorMQQualityOfService QoS,
         bool bRetain) override;
+    virtual TFuture<TReactorMQResult<void>> PublishAsync(
+        FUtf8StringView Topic,
+        TArray<uint8>&& Payload,
+        EReactorMQQualityOfService QoS,
+        bool bRetain) override;
     virtual TFuture<TReactorMQResult<TArray<FReactorMQSubscribeResult>>>
     SubscribeAsync(const TArray<FReactorMQTopicFilter>& TopicFilters) override;
     virtual TFuture<TReactorMQResult<FReactorMQSubscribeResult>> SubscribeAsync(const FReactorMQTopicFilter& TopicFilter) override;
@@ -62,6 +80,11 @@ public:
         return OnMessageDelegate;
     }
 
+    virtual FOnReactorMQSharedMessage& OnSharedMessage() override
+    {
+        return OnSharedMessageDelegate;
+    }
+
     virtual const FReactorMQConnectionSettings& GetConnectionSettings() const override
     {
         return Settings;
@@ -70,8 +93,22 @@ public:
     virtual bool IsConnected() const override;
     virtual void CloseSocket(int32 Code = 1000, const FString& Reason = TEXT("")) override;
 
+    virtual uint32 GetFrameBudgetOverruns() const override
+    {
+        return FrameBudgetOverruns.load(std::memory_order_relaxed);
+    }
+
     void Tick() const;
 
+    /** Count a frame in which Tick() ran past this client's share of the game thread budget. */
+    void RecordFrameBudgetOverrun()
+    {
+        FrameBudgetOverruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Snapshot of the native client's counters and gauges; safe to call from any thread. */
+    reactormq::mqtt::ClientMetrics GetNativeMetrics() const;
+
 private:
     FReactorMQConnectionSettings Settings;
     std::shared_ptr<reactormq::mqtt::IClient> NativeClient;
@@ -82,4 +119,7 @@ private:
     FOnReactorMQSubscribe OnSubscribeDelegate;
     FOnReactorMQUnsubscribe OnUnsubscribeDelegate;
     FOnReactorMQMessage OnMessageDelegate;
+    FOnReactorMQSharedMessage OnSharedMessageDelegate;
+
+    std::atomic<uint32> FrameBudgetOverruns{ 0 };
 };
\ No newline at end of file
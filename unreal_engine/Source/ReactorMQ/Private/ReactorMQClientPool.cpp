@@ -5,19 +5,48 @@
 #include "ReactorMQClientPool.h"
 
 #include "ReactorMQBuildConfig.h"
+#include "ReactorMQCallbackQueue.h"
 #include "ReactorMQClient.h"
+#include "ReactorMQStats.h"
 #include "Containers/BackgroundableTicker.h"
 #include "Containers/Ticker.h"
 #include "HAL/PlatformTime.h"
-#include "HAL/RunnableThread.h"
+#include "reactormq/mqtt/client_factory.h"
+#include "reactormq/mqtt/client_metrics.h"
+#include "reactormq/mqtt/reactor_group.h"
 
 using namespace UE;
 
+DEFINE_STAT(STAT_ReactorMQ_GameThreadTick);
+DEFINE_STAT(STAT_ReactorMQ_CallbackDrain);
+DEFINE_STAT(STAT_ReactorMQ_MessagesReceivedPerSecond);
+DEFINE_STAT(STAT_ReactorMQ_MessagesPublishedPerSecond);
+DEFINE_STAT(STAT_ReactorMQ_BytesReceivedPerSecond);
+DEFINE_STAT(STAT_ReactorMQ_BytesSentPerSecond);
+DEFINE_STAT(STAT_ReactorMQ_CommandQueueDepth);
+DEFINE_STAT(STAT_ReactorMQ_InFlightCommands);
+DEFINE_STAT(STAT_ReactorMQ_PendingCallbacks);
+DEFINE_STAT(STAT_ReactorMQ_FrameBudgetOverrunsPerSecond);
+DEFINE_STAT(STAT_ReactorMQ_ClientsDeferred);
+
+CSV_DEFINE_CATEGORY(ReactorMQ, true);
+
 TSharedPtr<FReactorMQClient> FReactorMQClientPool::Create(
     const FReactorMQConnectionSettings& InConnectionSettings,
-    FDeleter&& InDeleter)
+    FDeleter&& InDeleter) const
 {
-    return MakeShareable(new FReactorMQClient(InConnectionSettings), MoveTemp(InDeleter));
+    reactormq::mqtt::CallbackExecutor CallbackExec;
+    if (GameThreadCallbacks)
+    {
+        CallbackExec = [Callbacks = GameThreadCallbacks](std::function<void()> Callback)
+        {
+            Callbacks->Enqueue(std::move(Callback));
+        };
+    }
+
+    return MakeShareable(
+        new FReactorMQClient(InConnectionSettings, ReactorGroup, std::move(CallbackExec)),
+        MoveTemp(InDeleter));
 }
 
 FReactorMQClientPool::FReactorMQClientPool()
@@ -27,6 +56,22 @@ FReactorMQClientPool::FReactorMQClientPool()
         const FTickerDelegate TickDelegate = FTickerDelegate::CreateRaw(this, &FReactorMQClientPool::GameThreadTick);
         TickHandle = FTSBackgroundableTicker::GetCoreTicker().AddTicker(TickDelegate, 0.0f);
     }
+    else
+    {
+        ReactorGroup = reactormq::mqtt::client::createReactorGroup(GReactorMQPoolThreadCount);
+    }
+
+    if constexpr (GReactorMQThreadMode == EReactorMQThreadMode::BackgroundThreadMarshalled)
+    {
+        GameThreadCallbacks = std::make_shared<FReactorMQCallbackQueue>(GReactorMQCallbackBudgetSeconds);
+        const FTickerDelegate DrainDelegate = FTickerDelegate::CreateRaw(this, &FReactorMQClientPool::DrainGameThreadCallbacks);
+        TickHandle = FTSBackgroundableTicker::GetCoreTicker().AddTicker(DrainDelegate, 0.0f);
+    }
+
+#if STATS || CSV_PROFILER
+    const FTickerDelegate StatsDelegate = FTickerDelegate::CreateRaw(this, &FReactorMQClientPool::UpdateStats);
+    StatsTickHandle = FTSBackgroundableTicker::GetCoreTicker().AddTicker(StatsDelegate, 1.0f);
+#endif
 }
 
 FReactorMQClientPool::~FReactorMQClientPool()
@@ -78,20 +123,6 @@ TSharedPtr<IReactorMQClient, ESPMode::ThreadSafe> FReactorMQClientPool::GetOrCre
         return nullptr;
     }
 
-    if constexpr (GReactorMQThreadMode != EReactorMQThreadMode::GameThread)
-    {
-        bool bExpected = false;
-        if (Thread == nullptr && bIsRunning.compare_exchange_strong(bExpected, true, std::memory_order_acq_rel))
-        {
-            Thread = FRunnableThread::Create(
-                this,
-                TEXT("FReactorMQClientPool"),
-                0,
-                TPri_Normal,
-                FPlatformAffinity::GetPoolThreadMask());
-        }
-    }
-
     {
         FScopeLock Lock(&ClientMapLock);
         Clients.Add(Hash, OutClient.ToSharedRef());
@@ -102,13 +133,9 @@ TSharedPtr<IReactorMQClient, ESPMode::ThreadSafe> FReactorMQClientPool::GetOrCre
 
 void FReactorMQClientPool::Kill()
 {
-    bIsRunning.store(false, std::memory_order_release);
-
-    if (Thread != nullptr)
+    if (ReactorGroup)
     {
-        Thread->Kill(true);
-        delete Thread;
-        Thread = nullptr;
+        ReactorGroup->stop();
     }
 
     if (TickHandle.IsValid())
@@ -117,50 +144,21 @@ void FReactorMQClientPool::Kill()
         TickHandle.Reset();
     }
 
-    FScopeLock Lock(&ClientMapLock);
-    Clients.Empty();
-}
-
-uint32 FReactorMQClientPool::Run()
-{
-    constexpr float MaxTickRate = 1.0f / 60.0f;
-    constexpr float MinWaitTime = 0.001f;
-
-    while (bIsRunning.load(std::memory_order_acquire))
+    if (StatsTickHandle.IsValid())
     {
-        const double StartTime = FPlatformTime::Seconds();
-        Tick();
-        const double EndTime = FPlatformTime::Seconds();
-        const float SleepTime = MaxTickRate - static_cast<float>(EndTime - StartTime);
-        FPlatformProcess::SleepNoStats(FMath::Max(MinWaitTime, SleepTime));
+        FTSBackgroundableTicker::GetCoreTicker().RemoveTicker(StatsTickHandle);
+        StatsTickHandle.Reset();
     }
 
-    return 0;
-}
-
-void FReactorMQClientPool::Exit()
-{
-    FRunnable::Exit();
-}
-
-bool FReactorMQClientPool::Init()
-{
-    return FRunnable::Init();
-}
-
-void FReactorMQClientPool::Stop()
-{
     FScopeLock Lock(&ClientMapLock);
     Clients.Empty();
 }
 
-FSingleThreadRunnable* FReactorMQClientPool::GetSingleThreadInterface()
+bool FReactorMQClientPool::GameThreadTick(float DeltaTime)
 {
-    return this;
-}
+    check(IsInGameThread());
+    SCOPE_CYCLE_COUNTER(STAT_ReactorMQ_GameThreadTick);
 
-void FReactorMQClientPool::TickInternal()
-{
     // Take a snapshot of the current clients under the lock, then tick them
     // without holding the lock to avoid modifying the container while it is
     // being iterated (which triggers SparseArray's safety ensures).
@@ -174,23 +172,120 @@ void FReactorMQClientPool::TickInternal()
         }
     }
 
-    for (const TWeakPtr<FReactorMQClient, ESPMode::ThreadSafe>& WeakClient : ClientsSnapshot)
+    const int32 NumClients = ClientsSnapshot.Num();
+    if (NumClients == 0)
     {
-        if (TSharedPtr<FReactorMQClient, ESPMode::ThreadSafe> Client = WeakClient.Pin())
+        return true;
+    }
+
+    // The budget is shared evenly for overrun accounting, but a client that needs less leaves the rest to the others.
+    constexpr bool bHasBudget = GReactorMQFrameBudgetSeconds > 0.0;
+    const double FairShareSeconds = GReactorMQFrameBudgetSeconds / NumClients;
+    double TickStart = FPlatformTime::Seconds();
+    const double Deadline = TickStart + GReactorMQFrameBudgetSeconds;
+
+    const int32 FirstIndex = NextClientIndex % NumClients;
+    int32 NumTicked = 0;
+    while (NumTicked < NumClients)
+    {
+        TSharedPtr<FReactorMQClient, ESPMode::ThreadSafe> Client = ClientsSnapshot[(FirstIndex + NumTicked) % NumClients].Pin();
+        ++NumTicked;
+        if (!Client.IsValid())
+        {
+            continue;
+        }
+
+        Client->Tick();
+
+        if constexpr (bHasBudget)
         {
-            Client->Tick();
+            const double Now = FPlatformTime::Seconds();
+            if (Now - TickStart > FairShareSeconds)
+            {
+                Client->RecordFrameBudgetOverrun();
+            }
+
+            TickStart = Now;
+            if (Now >= Deadline)
+            {
+                break;
+            }
         }
     }
+
+    NextClientIndex = (FirstIndex + NumTicked) % NumClients;
+    SET_DWORD_STAT(STAT_ReactorMQ_ClientsDeferred, NumClients - NumTicked);
+
+    return true;
 }
 
-void FReactorMQClientPool::Tick()
+bool FReactorMQClientPool::DrainGameThreadCallbacks(float DeltaTime)
 {
-    TickInternal();
+    GameThreadCallbacks->Drain();
+    return true;
 }
 
-bool FReactorMQClientPool::GameThreadTick(float DeltaTime)
+bool FReactorMQClientPool::UpdateStats(float DeltaTime)
 {
-    check(IsInGameThread());
-    TickInternal();
+    uint64 MessagesReceived = 0;
+    uint64 MessagesPublished = 0;
+    uint64 BytesReceived = 0;
+    uint64 BytesSent = 0;
+    uint64 CommandQueueDepth = 0;
+    uint64 InFlightCommands = 0;
+    uint64 FrameBudgetOverruns = 0;
+
+    {
+        FScopeLock Lock(&ClientMapLock);
+        for (const auto& Pair : Clients)
+        {
+            if (TSharedPtr<FReactorMQClient, ESPMode::ThreadSafe> Client = Pair.Value.Pin())
+            {
+                const reactormq::mqtt::ClientMetrics Metrics = Client->GetNativeMetrics();
+                MessagesReceived += Metrics.messagesReceived;
+                MessagesPublished += Metrics.messagesPublished;
+                BytesReceived += Metrics.bytesReceived;
+                BytesSent += Metrics.bytesSent;
+                CommandQueueDepth += Metrics.commandQueueDepth;
+                InFlightCommands += Metrics.inFlightCommands;
+                FrameBudgetOverruns += Client->GetFrameBudgetOverruns();
+            }
+        }
+    }
+
+    // A released client takes its counters with it, so a total can shrink; report no traffic rather than a wrap.
+    const float Seconds = FMath::Max(DeltaTime, UE_KINDA_SMALL_NUMBER);
+    auto PerSecond = [Seconds](const uint64 Current, uint64& Last)
+    {
+        const uint64 Delta = Current >= Last ? Current - Last : 0;
+        Last = Current;
+        return static_cast<uint32>(FMath::Min<double>(static_cast<double>(Delta) / Seconds, MAX_uint32));
+    };
+
+    const uint32 MessagesReceivedPerSecond = PerSecond(MessagesReceived, LastMessagesReceived);
+    const uint32 MessagesPublishedPerSecond = PerSecond(MessagesPublished, LastMessagesPublished);
+    const uint32 BytesReceivedPerSecond = PerSecond(BytesReceived, LastBytesReceived);
+    const uint32 BytesSentPerSecond = PerSecond(BytesSent, LastBytesSent);
+    const uint32 FrameBudgetOverrunsPerSecond = PerSecond(FrameBudgetOverruns, LastFrameBudgetOverruns);
+    const int32 PendingCallbacks = GameThreadCallbacks ? GameThreadCallbacks->Num() : 0;
+
+    SET_DWORD_STAT(STAT_ReactorMQ_MessagesReceivedPerSecond, MessagesReceivedPerSecond);
+    SET_DWORD_STAT(STAT_ReactorMQ_MessagesPublishedPerSecond, MessagesPublishedPerSecond);
+    SET_DWORD_STAT(STAT_ReactorMQ_BytesReceivedPerSecond, BytesReceivedPerSecond);
+    SET_DWORD_STAT(STAT_ReactorMQ_BytesSentPerSecond, BytesSentPerSecond);
+    SET_DWORD_STAT(STAT_ReactorMQ_CommandQueueDepth, CommandQueueDepth);
+    SET_DWORD_STAT(STAT_ReactorMQ_InFlightCommands, InFlightCommands);
+    SET_DWORD_STAT(STAT_ReactorMQ_PendingCallbacks, PendingCallbacks);
+    SET_DWORD_STAT(STAT_ReactorMQ_FrameBudgetOverrunsPerSecond, FrameBudgetOverrunsPerSecond);
+
+    CSV_CUSTOM_STAT(ReactorMQ, MessagesReceivedPerSecond, static_cast<int32>(MessagesReceivedPerSecond), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, MessagesPublishedPerSecond, static_cast<int32>(MessagesPublishedPerSecond), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, BytesReceivedPerSecond, static_cast<int32>(BytesReceivedPerSecond), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, BytesSentPerSecond, static_cast<int32>(BytesSentPerSecond), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, CommandQueueDepth, static_cast<int32>(CommandQueueDepth), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, InFlightCommands, static_cast<int32>(InFlightCommands), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, PendingCallbacks, PendingCallbacks, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(ReactorMQ, FrameBudgetOverrunsPerSecond, static_cast<int32>(FrameBudgetOverrunsPerSecond), ECsvCustomStatOp::Set);
+
     return true;
 }
\ No newline at end of file
@@ -7,30 +7,40 @@
 #include "CoreMinimal.h"
 #include "ReactorMQConnectionSettings.h"
 #include "Containers/Ticker.h"
-#include "HAL/Runnable.h"
-#include "Misc/SingleThreadRunnable.h"
 
-#include <atomic>
+#include <memory>
 
+class FReactorMQCallbackQueue;
 class FReactorMQClient;
 class IReactorMQClient;
 
+namespace reactormq::mqtt
+{
+    class IReactorGroup;
+}
+
 /**
  * @brief Pool of ReactorMQ clients with optional background ticking.
+ *
+ * In the background thread modes the clients are driven by a reactor group of GReactorMQPoolThreadCount threads
+ * (REACTORMQ_POOL_THREADS). Each client is pinned to the least-loaded thread when it is created, and each thread
+ * sleeps until one of its sockets is readable, a command is issued or a timer is due rather than ticking at a fixed
+ * rate. With callbacks marshalled to the game thread, they are run in one batch per frame from the core ticker.
+ *
+ * In game thread mode the clients are ticked from the core ticker within GReactorMQFrameBudgetSeconds
+ * (REACTORMQ_FRAME_BUDGET_US). Each frame starts with the client after the last one ticked, so a client flooded with
+ * messages delays the others by at most a frame, and its unread packets stay behind its inbound budget until then.
  */
-class FReactorMQClientPool final
-    : public FRunnable
-      , public FSingleThreadRunnable
-      , public TSharedFromThis<FReactorMQClientPool>
+class FReactorMQClientPool final : public TSharedFromThis<FReactorMQClientPool>
 {
 private:
     using FDeleter = TFunction<void(FReactorMQClient*)>;
 
-    static TSharedPtr<FReactorMQClient> Create(const FReactorMQConnectionSettings& InConnectionSettings, FDeleter&& InDeleter);
+    TSharedPtr<FReactorMQClient> Create(const FReactorMQConnectionSettings& InConnectionSettings, FDeleter&& InDeleter) const;
 
 public:
     FReactorMQClientPool();
-    virtual ~FReactorMQClientPool() override;
+    ~FReactorMQClientPool();
 
     FReactorMQClientPool(const FReactorMQClientPool&) = delete;
     FReactorMQClientPool& operator=(const FReactorMQClientPool&) = delete;
@@ -42,25 +52,30 @@ public:
 
     void Kill();
 
-    // FRunnable
-    virtual uint32 Run() override;
-    virtual void Exit() override;
-    virtual bool Init() override;
-    virtual void Stop() override;
-    virtual FSingleThreadRunnable* GetSingleThreadInterface() override;
-
-    // FSingleThreadRunnable
-    virtual void Tick() override;
-
 private:
-    void TickInternal();
     bool GameThreadTick(float DeltaTime);
+    bool DrainGameThreadCallbacks(float DeltaTime);
+    bool UpdateStats(float DeltaTime);
 
     mutable FCriticalSection ClientMapLock;
     TMap<uint32, TWeakPtr<FReactorMQClient, ESPMode::ThreadSafe>> Clients;
 
-    FRunnableThread* Thread = nullptr;
-    std::atomic<bool> bIsRunning{ false };
+    /** Drives the clients in the background thread modes; null in game thread mode. */
+    std::shared_ptr<reactormq::mqtt::IReactorGroup> ReactorGroup;
+
+    /** Callbacks waiting for the game thread; null unless they are marshalled. Shared with the clients' executors. */
+    std::shared_ptr<FReactorMQCallbackQueue> GameThreadCallbacks;
 
     FTSTicker::FDelegateHandle TickHandle;
+    FTSTicker::FDelegateHandle StatsTickHandle;
+
+    /** Where the next game thread tick starts in the client list, so every client gets to go first in turn. */
+    int32 NextClientIndex = 0;
+
+    /** Pool-wide totals at the previous UpdateStats(), to turn the clients' counters into rates. */
+    uint64 LastMessagesReceived = 0;
+    uint64 LastMessagesPublished = 0;
+    uint64 LastBytesReceived = 0;
+    uint64 LastBytesSent = 0;
+    uint64 LastFrameBudgetOverruns = 0;
 };
\ No newline at end of file
@@ -0,0 +1,63 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#include "ReactorMQSharedMessage.h"
+#include "ReactorMQTypeMappings.h"
+
+#include "reactormq/mqtt/message.h"
+
+struct FReactorMQSharedMessage::FNative
+{
+    // Copying a message shares its payload buffer rather than duplicating it.
+    reactormq::mqtt::Message Message;
+};
+
+FReactorMQSharedMessage::FReactorMQSharedMessage(const reactormq::mqtt::Message& InMessage)
+    : Native(MakeShared<const FNative, ESPMode::ThreadSafe>(FNative{ InMessage }))
+{
+}
+
+FUtf8StringView FReactorMQSharedMessage::GetTopic() const
+{
+    if (!Native.IsValid())
+    {
+        return FUtf8StringView();
+    }
+
+    const std::string& Topic = Native->Message.getTopic();
+    return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Topic.data()), static_cast<int32>(Topic.size()));
+}
+
+TArrayView<const uint8> FReactorMQSharedMessage::GetPayload() const
+{
+    if (!Native.IsValid())
+    {
+        return TArrayView<const uint8>();
+    }
+
+    const std::span<const std::uint8_t> Payload = Native->Message.getPayloadView();
+    return TArrayView<const uint8>(Payload.data(), static_cast<int32>(Payload.size()));
+}
+
+EReactorMQQualityOfService FReactorMQSharedMessage::GetQualityOfService() const
+{
+    return Native.IsValid()
+        ? FReactorMQTypeMappings::FromNative(Native->Message.getQualityOfService())
+        : EReactorMQQualityOfService::AtMostOnce;
+}
+
+bool FReactorMQSharedMessage::ShouldRetain() const
+{
+    return Native.IsValid() && Native->Message.shouldRetain();
+}
+
+FDateTime FReactorMQSharedMessage::GetTimestampUtc() const
+{
+    return Native.IsValid() ? FReactorMQTypeMappings::TimestampFromNative(Native->Message) : FDateTime();
+}
+
+FReactorMQMessage FReactorMQSharedMessage::ToMessage() const
+{
+    return Native.IsValid() ? FReactorMQTypeMappings::FromNative(Native->Message) : FReactorMQMessage();
+}
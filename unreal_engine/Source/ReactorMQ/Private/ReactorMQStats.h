@@ -0,0 +1,27 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+// Shown by `stat ReactorMQ`. The rates and gauges are summed over the pool's clients once a second.
+DECLARE_STATS_GROUP(TEXT("ReactorMQ"), STATGROUP_ReactorMQ, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Game Thread Tick"), STAT_ReactorMQ_GameThreadTick, STATGROUP_ReactorMQ, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Callback Drain"), STAT_ReactorMQ_CallbackDrain, STATGROUP_ReactorMQ, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Messages Received/s"), STAT_ReactorMQ_MessagesReceivedPerSecond, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Messages Published/s"), STAT_ReactorMQ_MessagesPublishedPerSecond, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Received/s"), STAT_ReactorMQ_BytesReceivedPerSecond, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Sent/s"), STAT_ReactorMQ_BytesSentPerSecond, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Command Queue Depth"), STAT_ReactorMQ_CommandQueueDepth, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("In-Flight Commands"), STAT_ReactorMQ_InFlightCommands, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Callbacks"), STAT_ReactorMQ_PendingCallbacks, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Frame Budget Overruns/s"), STAT_ReactorMQ_FrameBudgetOverrunsPerSecond, STATGROUP_ReactorMQ, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Clients Deferred"), STAT_ReactorMQ_ClientsDeferred, STATGROUP_ReactorMQ, );
+
+CSV_DECLARE_CATEGORY_EXTERN(ReactorMQ);
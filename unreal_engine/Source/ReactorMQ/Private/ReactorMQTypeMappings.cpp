@@ -264,6 +264,30 @@ reactormq::mqtt::Message FReactorMQTypeMappings::ToNative(
         );
 }
 
+reactormq::mqtt::Message FReactorMQTypeMappings::ToNative(
+    FUtf8StringView Topic,
+    TArray<uint8>&& Payload,
+    EReactorMQQualityOfService QoS,
+    bool bRetain)
+{
+    // Keep the array alive inside the shared payload instead of copying its bytes.
+    TArray<uint8>* Owned = new TArray<uint8>(MoveTemp(Payload));
+    auto NativePayload = reactormq::mqtt::SharedPayload::adopt(
+        Owned->GetData(),
+        static_cast<size_t>(Owned->Num()),
+        [Owned](const std::uint8_t*)
+        {
+            delete Owned;
+        });
+
+    return reactormq::mqtt::Message(
+        std::string(reinterpret_cast<const char*>(Topic.GetData()), static_cast<size_t>(Topic.Len())),
+        std::move(NativePayload),
+        bRetain,
+        ToNative(QoS)
+        );
+}
+
 FReactorMQMessage FReactorMQTypeMappings::FromNative(const reactormq::mqtt::Message& Message)
 {
     FReactorMQMessage Result;
@@ -273,13 +297,20 @@ FReactorMQMessage FReactorMQTypeMappings::FromNative(const reactormq::mqtt::Mess
     FMemory::Memcpy(Result.Payload.GetData(), NativePayload.data(), NativePayload.size());
     Result.QualityOfService = FromNative(Message.getQualityOfService());
     Result.bShouldRetain = Message.shouldRetain();
+    Result.TimestampUtc = TimestampFromNative(Message);
+    return Result;
+}
 
-    const auto TimePoint = Message.getTimestampUtc();
-    const auto Duration = TimePoint.time_since_epoch();
-    const auto Microseconds = std::chrono::duration_cast<std::chrono::microseconds>(Duration).count();
-    Result.TimestampUtc = FDateTime(1970, 1, 1) + FTimespan::FromMicroseconds(Microseconds);
+FReactorMQSharedMessage FReactorMQTypeMappings::FromNativeShared(const reactormq::mqtt::Message& Message)
+{
+    return FReactorMQSharedMessage(Message);
+}
 
-    return Result;
+FDateTime FReactorMQTypeMappings::TimestampFromNative(const reactormq::mqtt::Message& Message)
+{
+    const auto Duration = Message.getTimestampUtc().time_since_epoch();
+    const auto Microseconds = std::chrono::duration_cast<std::chrono::microseconds>(Duration).count();
+    return FDateTime(1970, 1, 1) + FTimespan::FromMicroseconds(Microseconds);
 }
 
 reactormq::mqtt::TopicFilter FReactorMQTypeMappings::ToNative(const FReactorMQTopicFilter& Filter)
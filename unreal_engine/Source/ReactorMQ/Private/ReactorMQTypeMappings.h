@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "ReactorMQConnectionSettings.h"
 #include "ReactorMQMessage.h"
+#include "ReactorMQSharedMessage.h"
 #include "ReactorMQSubscribeResult.h"
 #include "ReactorMQTopicFilter.h"
 #include "ReactorMQTypes.h"
@@ -51,7 +52,15 @@ public:
         const TArray<uint8>& Payload,
         EReactorMQQualityOfService QoS,
         bool bRetain);
+    /** Adopts Payload as the message's buffer and takes the topic as UTF-8, so neither is converted or copied twice. */
+    static reactormq::mqtt::Message ToNative(
+        FUtf8StringView Topic,
+        TArray<uint8>&& Payload,
+        EReactorMQQualityOfService QoS,
+        bool bRetain);
     static FReactorMQMessage FromNative(const reactormq::mqtt::Message& Message);
+    static FReactorMQSharedMessage FromNativeShared(const reactormq::mqtt::Message& Message);
+    static FDateTime TimestampFromNative(const reactormq::mqtt::Message& Message);
 
     static reactormq::mqtt::TopicFilter ToNative(const FReactorMQTopicFilter& Filter);
     static FReactorMQTopicFilter FromNative(const reactormq::mqtt::TopicFilter& Filter);
@@ -5,5 +5,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "ReactorMQMessage.h"
+#include "ReactorMQSharedMessage.h"
 
-DECLARE_MULTICAST_DELEGATE_OneParam(FOnReactorMQMessage, const FReactorMQMessage&);
\ No newline at end of file
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnReactorMQMessage, const FReactorMQMessage&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnReactorMQSharedMessage, const FReactorMQSharedMessage&);
\ No newline at end of file
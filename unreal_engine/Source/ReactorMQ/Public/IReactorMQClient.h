@@ -27,6 +27,9 @@ public:
     virtual TFuture<TReactorMQResult<void>> DisconnectAsync() = 0;
     virtual TFuture<TReactorMQResult<void>> PublishAsync(
         const FString& Topic, const TArray<uint8>& Payload, EReactorMQQualityOfService QoS, bool bRetain) = 0;
+    /** Publish without copying: the payload array is handed to the client and the topic is already UTF-8. */
+    virtual TFuture<TReactorMQResult<void>> PublishAsync(
+        FUtf8StringView Topic, TArray<uint8>&& Payload, EReactorMQQualityOfService QoS, bool bRetain) = 0;
     virtual TFuture<TReactorMQResult<TArray<FReactorMQSubscribeResult>>> SubscribeAsync(const TArray<FReactorMQTopicFilter>& TopicFilters) =
     0;
     virtual TFuture<TReactorMQResult<FReactorMQSubscribeResult>> SubscribeAsync(const FReactorMQTopicFilter& TopicFilter) = 0;
@@ -39,8 +42,17 @@ public:
     virtual FOnReactorMQSubscribe& OnSubscribe() = 0;
     virtual FOnReactorMQUnsubscribe& OnUnsubscribe() = 0;
     virtual FOnReactorMQMessage& OnMessage() = 0;
+    /** Like OnMessage(), but the message shares the received buffers; no copy is made unless a listener asks for one. */
+    virtual FOnReactorMQSharedMessage& OnSharedMessage() = 0;
 
     virtual const FReactorMQConnectionSettings& GetConnectionSettings() const = 0;
     virtual bool IsConnected() const = 0;
     virtual void CloseSocket(int32 Code = 1000, const FString& Reason = TEXT("")) = 0;
+
+    /**
+     * @brief Frames in which this client's tick took more than its share of the game thread budget.
+     *
+     * Only counted in game thread mode, where the pool splits REACTORMQ_FRAME_BUDGET_US evenly across its clients.
+     */
+    virtual uint32 GetFrameBudgetOverruns() const = 0;
 };
\ No newline at end of file
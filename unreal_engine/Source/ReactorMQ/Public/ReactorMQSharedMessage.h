@@ -0,0 +1,47 @@
+//  SPDX-License-Identifier: MPL-2.0
+//  Copyright 2025 Simon Balarabe
+//  Project: ReactorMQ — https://github.com/Naragato/reactormq
+
+#pragma once
+#include "CoreMinimal.h"
+#include "ReactorMQMessage.h"
+#include "ReactorMQTypes.h"
+
+namespace reactormq::mqtt
+{
+    struct Message;
+}
+
+/**
+ * @brief A received message that shares the native client's buffers instead of copying them.
+ *
+ * The topic is the UTF-8 string the broker sent and the payload is the reference-counted buffer it was received
+ * into, so handing one to a delegate costs the same whatever the payload size. Copies share the same buffers, which
+ * stay valid for as long as any copy is alive. Call ToMessage() for an FReactorMQMessage that owns its data.
+ */
+class REACTORMQ_API FReactorMQSharedMessage
+{
+public:
+    FReactorMQSharedMessage() = default;
+
+    /** @brief Topic the message was published to, as UTF-8. Empty for a default-constructed message. */
+    FUtf8StringView GetTopic() const;
+
+    /** @brief Payload bytes. Empty for a default-constructed message. */
+    TArrayView<const uint8> GetPayload() const;
+
+    EReactorMQQualityOfService GetQualityOfService() const;
+    bool ShouldRetain() const;
+    FDateTime GetTimestampUtc() const;
+
+    /** @brief Copy the topic and payload into a message that owns them. */
+    FReactorMQMessage ToMessage() const;
+
+private:
+    friend class FReactorMQTypeMappings;
+
+    explicit FReactorMQSharedMessage(const reactormq::mqtt::Message& InMessage);
+
+    struct FNative;
+    TSharedPtr<const FNative, ESPMode::ThreadSafe> Native;
+};
@@ -46,7 +46,16 @@ public class ReactorMQ : ModuleRules
 			"REACTORMQ_WITH_CONSOLE_SINK=0",
 			"REACTORMQ_WITH_FILE_SINK=0",
 			"REACTORMQ_WITH_UE_LOG_SINK=1",
+			"REACTORMQ_WITH_ZLIB=0",
+			// Scoped trace markers as Unreal Insights CPU events (util/trace/trace.h)
+			"REACTORMQ_TRACE_BACKEND=2",
 			"REACTORMQ_THREAD=0",
+			// Pool threads in the background thread modes; 0 uses one per core
+			"REACTORMQ_POOL_THREADS=1",
+			// Game thread time per frame spent on marshalled callbacks (REACTORMQ_THREAD=1)
+			"REACTORMQ_CALLBACK_BUDGET_US=2000",
+			// Game thread time per frame spent ticking clients (REACTORMQ_THREAD=0); 0 ticks them all every frame
+			"REACTORMQ_FRAME_BUDGET_US=2000",
 
 			// UE5 context: OpenSSL handled by UBT's SSL module
 			"REACTORMQ_WITH_TLS=1",
@@ -62,6 +71,7 @@ public class ReactorMQ : ModuleRules
 			"REACTORMQ_SOCKET_WITH_SONY_SOCKET=0",
 			"REACTORMQ_SOCKET_WITH_IOCTL=0",
 			"REACTORMQ_SOCKET_WITH_POLL=0",
+			"REACTORMQ_SOCKET_WITH_IO_URING=0",
 			"REACTORMQ_SOCKET_WITH_SELECT=0",
 			"REACTORMQ_SOCKET_WITH_GETHOSTNAME=0",
 			"REACTORMQ_SOCKET_WITH_GETADDRINFO=0",
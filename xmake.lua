@@ -103,6 +103,13 @@ package_end()
 
 add_requires("libressl", {configs = {shared = false}})
 set_languages("cxx20")
+-- Tracy and Perfetto come from xmake-repo; the Unreal Insights backend is only used by UBT builds.
+local trace_backend = get_config("trace_backend")
+local has_trace_package = trace_backend == "tracy" or trace_backend == "perfetto"
+if has_trace_package then
+    add_requires(trace_backend)
+end
+
 target("reactormq")
     on_load(function (target)
         local helpers = import("xmake.modules.helpers", { anonymous = true })
@@ -136,12 +143,35 @@ target("reactormq")
 
     add_includedirs("$(projectdir)/include", {public = true})
     add_includedirs("$(projectdir)/src", {public = false})
+    if has_trace_package then
+        add_packages(trace_backend, {public = true})
+    end
 
     add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
 target_end()
 
+if has_config("build_tools") then
+    target("reactormq_loadgen")
+        set_kind("binary")
+        set_group("tools")
+        set_default(false)
+        add_deps("reactormq")
+        add_files("$(projectdir)/tools/loadgen/loadgen.cpp")
+        add_includedirs("$(projectdir)/src", "$(projectdir)/include")
+        if is_plat("windows") then
+            add_syslinks("psapi")
+        end
+        add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
+        on_load(function (target)
+            local helpers = import("xmake.modules.helpers", { anonymous = true })
+            helpers.configure(target)
+        end)
+    target_end()
+end
+
 local build_tests = get_config("build_tests")
 if build_tests ~= "off" then
+    local count_allocations = has_config("test_count_allocations") and "1" or "0"
     add_requires("llvm")
     add_requires("gtest")
     target("reactormq_tests")
@@ -150,8 +180,9 @@ if build_tests ~= "off" then
         set_default(false)
         add_deps("reactormq")
         add_packages("gtest")
-        add_files("$(projectdir)/tests/**.cpp")
+        add_files("$(projectdir)/tests/**.cpp|bench/*.cpp")
         add_includedirs("$(projectdir)/tests", "$(projectdir)/src", "$(projectdir)/include")
+        add_defines("REACTORMQ_TEST_COUNT_ALLOCATIONS=" .. count_allocations)
         add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
         on_load(function (target)
             local helpers = import("xmake.modules.helpers", { anonymous = true })
@@ -168,6 +199,7 @@ if build_tests ~= "off" then
         add_packages("gtest")
         add_files("$(projectdir)/tests/unit/**.cpp", "$(projectdir)/tests/fixtures/**.cpp", "$(projectdir)/tests/test_main.cpp")
         add_includedirs("$(projectdir)/tests", "$(projectdir)/src", "$(projectdir)/include")
+        add_defines("REACTORMQ_TEST_COUNT_ALLOCATIONS=" .. count_allocations)
         add_tests("unit")
         add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
         on_load(function (target)
@@ -185,6 +217,7 @@ if build_tests ~= "off" then
         add_packages("gtest")
         add_files("$(projectdir)/tests/integration/**.cpp", "$(projectdir)/tests/fixtures/**.cpp", "$(projectdir)/tests/test_main.cpp")
         add_includedirs("$(projectdir)/tests", "$(projectdir)/src", "$(projectdir)/include")
+        add_defines("REACTORMQ_TEST_COUNT_ALLOCATIONS=" .. count_allocations)
         add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
         on_load(function (target)
             local helpers = import("xmake.modules.helpers", { anonymous = true })
@@ -199,8 +232,9 @@ if build_tests ~= "off" then
         set_default(false)
         add_deps("reactormq")
         add_packages("gtest")
-        add_files("$(projectdir)/tests/stress/test_concurrent_commands.cpp", "$(projectdir)/tests/fixtures/**.cpp", "$(projectdir)/tests/test_main.cpp")
+        add_files("$(projectdir)/tests/stress/*.cpp", "$(projectdir)/tests/fixtures/**.cpp", "$(projectdir)/tests/test_main.cpp")
         add_includedirs("$(projectdir)/tests", "$(projectdir)/src", "$(projectdir)/include")
+        add_defines("REACTORMQ_TEST_COUNT_ALLOCATIONS=" .. count_allocations)
         add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
         on_load(function (target)
             local helpers = import("xmake.modules.helpers", { anonymous = true })
@@ -209,6 +243,25 @@ if build_tests ~= "off" then
         end)
     target_end()
 
+    if has_config("build_benchmarks") then
+        add_requires("benchmark")
+        target("reactormq_bench")
+            set_kind("binary")
+            set_group("tests")
+            set_default(false)
+            add_deps("reactormq")
+            add_packages("benchmark")
+            add_files("$(projectdir)/tests/bench/*.cpp", "$(projectdir)/tests/fixtures/allocation_counter.cpp")
+            add_includedirs("$(projectdir)/tests", "$(projectdir)/src", "$(projectdir)/include")
+            add_defines("REACTORMQ_TEST_COUNT_ALLOCATIONS=" .. count_allocations)
+            add_rules("mode.debug", "mode.release", "mode.releasedbg", "mode.minsizerel")
+            on_load(function (target)
+                local helpers = import("xmake.modules.helpers", { anonymous = true })
+                helpers.configure(target)
+            end)
+        target_end()
+    end
+
     target("fuzz_mqtt_codec")
         set_toolchains("@llvm")
         set_kind("binary")
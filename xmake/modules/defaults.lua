@@ -20,6 +20,7 @@ function main()
     cfg.socket_with_sony = false
     cfg.socket_with_ioctl = true
     cfg.socket_with_poll = false
+    cfg.socket_with_io_uring = false
     cfg.socket_with_select = true
     cfg.socket_with_gethostname = true
     cfg.socket_with_getaddrinfo = true
@@ -88,6 +88,7 @@ function apply_defines(cfg)
         add_bool_define("socket_with_sony", "REACTORMQ_SOCKET_WITH_SONY_SOCKET")
         add_bool_define("socket_with_ioctl", "REACTORMQ_SOCKET_WITH_IOCTL")
         add_bool_define("socket_with_poll", "REACTORMQ_SOCKET_WITH_POLL")
+        add_bool_define("socket_with_io_uring", "REACTORMQ_SOCKET_WITH_IO_URING")
         add_bool_define("socket_with_select", "REACTORMQ_SOCKET_WITH_SELECT")
         add_bool_define("socket_with_gethostname", "REACTORMQ_SOCKET_WITH_GETHOSTNAME")
         add_bool_define("socket_with_getaddrinfo", "REACTORMQ_SOCKET_WITH_GETADDRINFO")
@@ -99,6 +100,27 @@ function apply_defines(cfg)
         add_bool_define("socket_with_nodelay", "REACTORMQ_SOCKET_WITH_NODELAY")
         add_bool_define("platform_has_bsd_time", "REACTORMQ_PLATFORM_HAS_BSD_TIME")
         add_bool_define("platform_has_bsd_ipv6", "REACTORMQ_PLATFORM_HAS_BSD_IPV6_SOCKETS")
+        -- Read directly: the option resolver would turn "off" into a boolean.
+        local log_levels = { trace = 0, debug = 1, info = 2, warn = 3, error = 4, critical = 5, off = 6 }
+        local log_min_level = log_levels[get_config("log_min_level") or "trace"]
+        if log_min_level == nil then
+            raise("reactormq: log_min_level must be one of trace|debug|info|warn|error|critical|off")
+        end
+        target:add("defines", string.format("REACTORMQ_LOG_MIN_LEVEL=%d", log_min_level))
+        -- Protocol levels for mqtt/client/mqtt_version_mapping.h; 0 keeps both.
+        local mqtt_versions = { all = 0, ["3.1.1"] = 4, ["5"] = 5 }
+        local mqtt_version = mqtt_versions[get_config("mqtt_version") or "all"]
+        if mqtt_version == nil then
+            raise("reactormq: mqtt_version must be one of all|3.1.1|5")
+        end
+        target:add("defines", string.format("REACTORMQ_MQTT_VERSION=%d", mqtt_version))
+        -- Values follow REACTORMQ_TRACE_BACKEND_* in util/trace/trace.h; unreal is only set by UBT builds.
+        local trace_backends = { none = 0, tracy = 1, perfetto = 3 }
+        local trace_backend = trace_backends[get_config("trace_backend") or "none"]
+        if trace_backend == nil then
+            raise("reactormq: trace_backend must be one of none|tracy|perfetto")
+        end
+        target:add("defines", string.format("REACTORMQ_TRACE_BACKEND=%d", trace_backend))
         target:add("defines", string.format("_HAS_EXCEPTIONS=%d", cfg.with_exceptions and 1 or 0))
         add_bool_define("with_console_sink", "REACTORMQ_WITH_CONSOLE_SINK")
         add_bool_define("with_file_sink", "REACTORMQ_WITH_FILE_SINK")
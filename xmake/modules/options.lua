@@ -43,6 +43,12 @@ option("socket_with_poll")
 	set_values("auto", "on", "off")
 	set_default("auto")
 option_end()
+option("socket_with_io_uring")
+	set_showmenu(true)
+	set_description("Use io_uring for socket readiness on Linux (auto = off)")
+	set_values("auto", "on", "off")
+	set_default("auto")
+option_end()
 option("socket_with_select")
 	set_showmenu(true)
 	set_description("Enable select() support for sockets (auto = platform default)")
@@ -121,6 +127,21 @@ option("build_tests")
     set_values("auto", "on", "off")
     set_default("auto")
 option_end()
+option("build_benchmarks")
+    set_showmenu(true)
+    set_description("Build the Google Benchmark microbenchmarks (reactormq_bench)")
+    set_default(false)
+option_end()
+option("build_tools")
+    set_showmenu(true)
+    set_description("Build the reactormq_loadgen load generator")
+    set_default(false)
+option_end()
+option("test_count_allocations")
+    set_showmenu(true)
+    set_description("Replace global operator new/delete in tests and benchmarks to count allocations")
+    set_default(true)
+option_end()
 option("with_threads")
     set_showmenu(true)
     set_description("Enable threading support (auto = enabled)")
@@ -145,6 +166,24 @@ option("with_console_sink")
     set_values("auto", "on", "off")
     set_default("auto")
 option_end()
+option("log_min_level")
+    set_showmenu(true)
+    set_description("Lowest log level compiled in; calls below it compile to nothing")
+    set_values("trace", "debug", "info", "warn", "error", "critical", "off")
+    set_default("trace")
+option_end()
+option("mqtt_version")
+    set_showmenu(true)
+    set_description("MQTT version the client speaks; a single one is fixed at compile time")
+    set_values("all", "3.1.1", "5")
+    set_default("all")
+option_end()
+option("trace_backend")
+    set_showmenu(true)
+    set_description("Profiler that receives scoped trace markers; none compiles them out")
+    set_values("none", "tracy", "perfetto")
+    set_default("none")
+option_end()
 option("with_file_sink")
     set_showmenu(true)
     set_description("Enable file logging sink (auto = enabled)")
@@ -22,6 +22,7 @@ function collect_socket_sources(cfg, sources_dir)
     end
 
     if cfg.ssl_available then
+        table.insert(files, path.join(sources_dir, "socket/platform/tls_context_cache.cpp"))
         if cfg.family_darwin then
             table.insert(files, path.join(sources_dir, "socket/platform/darwin_trust_anchor_set.cpp"))
         elseif cfg.family_windows then